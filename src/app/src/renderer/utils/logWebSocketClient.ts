@@ -42,6 +42,10 @@ export async function connectLogStream(
       console.log('[LogStream] Received message type:', message.type, 'entries:', message.entries?.length ?? message.entry?.seq ?? 'n/a');
       if (message.type === 'logs.snapshot') {
         callbacks.onSnapshot(message.entries ?? []);
+      } else if (message.type === 'logs.batch' && Array.isArray(message.entries)) {
+        for (const entry of message.entries) {
+          callbacks.onEntry(entry);
+        }
       } else if (message.type === 'logs.entry' && message.entry) {
         callbacks.onEntry(message.entry);
       } else if (message.type === 'error') {
@@ -20,6 +20,9 @@ export class TranscriptionWebSocket {
   // Errors before the socket opens are connection probing (the main-port
   // attempt may fall back to the legacy port) — not user-facing errors
   private opened = false;
+  // Accumulated stable prefix of the current utterance; the server sends
+  // interim deltas as append-only stable text plus a volatile tail
+  private interimStable = '';
 
   /**
    * Create a new TranscriptionWebSocket.
@@ -56,6 +59,7 @@ export class TranscriptionWebSocket {
             // Session config updated, nothing to do
             break;
           case 'input_audio_buffer.speech_started':
+            this.interimStable = '';
             callbacks.onSpeechEvent('started');
             break;
           case 'input_audio_buffer.speech_stopped':
@@ -65,13 +69,17 @@ export class TranscriptionWebSocket {
             callbacks.onAudioBufferCleared?.();
             break;
           case 'conversation.item.input_audio_transcription.delta':
-            // Interim result - replaces previous interim text
+            // Interim result: append-only stable delta plus volatile tail;
+            // the rendered interim line still replaces the previous one
             if (typeof msg.delta === 'string') {
-              callbacks.onTranscription(msg.delta, false);
+              this.interimStable += msg.delta;
+              const volatileTail = typeof msg.volatile === 'string' ? msg.volatile : '';
+              callbacks.onTranscription(this.interimStable + volatileTail, false);
             }
             break;
           case 'conversation.item.input_audio_transcription.completed':
             // Final result for this utterance
+            this.interimStable = '';
             if (typeof msg.transcript === 'string') {
               callbacks.onTranscription(msg.transcript, true);
             }
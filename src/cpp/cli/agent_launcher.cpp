@@ -127,6 +127,7 @@ void configure_claude_agent(const std::string& base_url,
         {"CLAUDE_CODE_DISABLE_NONESSENTIAL_TRAFFIC", "1"}
     };
     config.extra_args = {};
+    config.prewarm_models = {model};
     config.install_instructions = "Install Claude Code CLI and ensure 'claude' is on PATH.";
 }
 
@@ -182,6 +183,7 @@ void configure_codex_agent(const std::string& base_url,
     config.extra_args.push_back("-m");
     config.extra_args.push_back(model);
 
+    config.prewarm_models = {model};
     config.install_instructions = "Install Codex CLI and ensure 'codex' is on PATH.";
 }
 
@@ -211,6 +213,7 @@ void configure_opencode_agent(const std::string& model,
         "-m",
         "Lemonade/" + model
     };
+    config.prewarm_models = {model};
     config.install_instructions =
         "Install OpenCode CLI:\n"
         "  curl -fsSL https://opencode.ai/install | bash\n"
@@ -246,6 +249,7 @@ void configure_pi_agent(const std::string& model,
         "--provider", "Lemonade",
         "--model", model
     };
+    config.prewarm_models = {model};
     config.install_instructions =
         "Install Pi coding agent:\n"
         "  npm i -g @earendil-works/pi-coding-agent";
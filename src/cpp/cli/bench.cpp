@@ -11,7 +11,9 @@
 #include <fstream>
 #include <iomanip>
 #include <iostream>
+#include <memory>
 #include <sstream>
+#include <thread>
 #include <unordered_map>
 #include <unordered_set>
 
@@ -128,6 +130,53 @@ double BenchScenarioResult::memory_peak_gb() const {
     return peak;
 }
 
+std::vector<double> BenchScenarioResult::all_token_gaps_ms() const {
+    std::vector<double> gaps;
+    for (const auto& run : runs) {
+        gaps.insert(gaps.end(), run.token_gap_ms.begin(), run.token_gap_ms.end());
+    }
+    return gaps;
+}
+
+bool BenchScenarioResult::has_token_gaps() const {
+    for (const auto& run : runs) {
+        if (!run.token_gap_ms.empty()) return true;
+    }
+    return false;
+}
+
+double BenchScenarioResult::itl_p50_ms() const { return percentile(all_token_gaps_ms(), 50.0); }
+double BenchScenarioResult::itl_p95_ms() const { return percentile(all_token_gaps_ms(), 95.0); }
+double BenchScenarioResult::itl_p99_ms() const { return percentile(all_token_gaps_ms(), 99.0); }
+
+int BenchScenarioResult::stall_count(double threshold_ms) const {
+    int count = 0;
+    for (const auto& run : runs) {
+        for (double gap : run.token_gap_ms) {
+            if (gap > threshold_ms) ++count;
+        }
+    }
+    return count;
+}
+
+json BenchScenarioResult::itl_histogram() const {
+    static const std::vector<double> edges = {10, 20, 30, 50, 75, 100, 150, 200, 300, 500, 1000};
+    std::vector<int> counts(edges.size(), 0);
+    int overflow = 0;
+    for (const auto& run : runs) {
+        for (double gap : run.token_gap_ms) {
+            size_t bucket = 0;
+            while (bucket < edges.size() && gap > edges[bucket]) ++bucket;
+            if (bucket < edges.size()) {
+                ++counts[bucket];
+            } else {
+                ++overflow;
+            }
+        }
+    }
+    return json{{"edges_ms", edges}, {"counts", counts}, {"overflow", overflow}};
+}
+
 int BenchScenarioResult::input_tokens() const {
     return runs.empty() ? 0 : runs[0].input_tokens;
 }
@@ -609,12 +658,15 @@ BenchRunResult run_single_bench(lemonade::LemonadeClient& client,
                                 const BenchScenario& scenario,
                                 bool memory_tracking,
                                 bool capture_response,
-                                int timeout) {
+                                int timeout,
+                                bool stream) {
     if (scenario.category == "embed")
         return run_single_bench_embed(client, model, scenario, memory_tracking, capture_response, timeout);
     if (scenario.category == "imagegen")
         return run_single_bench_imagegen(client, model, scenario, memory_tracking, capture_response, timeout);
     // default mode is text generation
+    if (stream)
+        return run_single_bench_textgen_stream(client, model, scenario, memory_tracking, capture_response, timeout);
     return run_single_bench_textgen(client, model, scenario, memory_tracking, capture_response, timeout);
 }
 
@@ -703,6 +755,109 @@ BenchRunResult run_single_bench_textgen(lemonade::LemonadeClient& client,
     return result;
 }
 
+BenchRunResult run_single_bench_textgen_stream(lemonade::LemonadeClient& client,
+                                const std::string& model,
+                                const BenchScenario& scenario,
+                                bool memory_tracking,
+                                bool capture_response,
+                                int timeout) {
+    BenchRunResult result;
+    result.success = false;
+
+    if (memory_tracking) {
+        double _vram, _mem;
+        query_system_stats(client, _vram, _mem);
+    }
+
+    json request_body;
+    request_body["model"] = model;
+    request_body["messages"] = scenario.messages;
+    request_body["max_completion_tokens"] = scenario.max_tokens;
+    request_body["temperature"] = 0;
+    request_body["stream"] = true;
+    request_body["stream_options"] = {{"include_usage", true}};
+
+    std::string body = request_body.dump();
+    auto start = steady_clock::now();
+    auto prev_token = start;
+    int token_count = 0;
+    std::string response_text;
+
+    try {
+        client.make_request("/api/v1/chat/completions", "POST", body, "application/json",
+            [&](const std::string&, const std::string& event_data) {
+                if (event_data == "[DONE]") {
+                    return;
+                }
+                const auto now = steady_clock::now();
+                json chunk;
+                try {
+                    chunk = json::parse(event_data);
+                } catch (const std::exception&) {
+                    return;
+                }
+
+                // Final usage-only chunk (and llama.cpp's trailing timings)
+                // carries no token — don't timestamp it as an arrival.
+                bool has_token = false;
+                if (chunk.contains("choices") && chunk["choices"].is_array() &&
+                    !chunk["choices"].empty()) {
+                    const auto& delta = chunk["choices"][0].value("delta", json::object());
+                    if (delta.contains("content") || delta.contains("reasoning_content") ||
+                        delta.contains("tool_calls")) {
+                        has_token = true;
+                        if (capture_response && delta.contains("content") &&
+                            delta["content"].is_string()) {
+                            response_text += delta["content"].get<std::string>();
+                        }
+                    }
+                }
+                if (has_token) {
+                    if (token_count == 0) {
+                        result.ttft_ms = duration<double, std::milli>(now - start).count();
+                    } else {
+                        result.token_gap_ms.push_back(
+                            duration<double, std::milli>(now - prev_token).count());
+                    }
+                    prev_token = now;
+                    ++token_count;
+                }
+
+                if (chunk.contains("timings") && chunk["timings"].is_object()) {
+                    extract_timings_into_result(chunk["timings"], result);
+                }
+                if (chunk.contains("usage") && chunk["usage"].is_object()) {
+                    extract_usage_into_result(chunk["usage"], result);
+                }
+            },
+            timeout, timeout);
+    } catch (const std::exception& e) {
+        std::cerr << "    Streaming benchmark run failed: " << e.what() << std::endl;
+        return result;
+    }
+
+    auto end = steady_clock::now();
+    result.total_time_ms = duration<double, std::milli>(end - start).count();
+    if (capture_response) {
+        result.response_text = response_text;
+    }
+    if (result.output_tokens <= 0) {
+        result.output_tokens = token_count;
+    }
+    compute_tps_from_tokens_and_time(result);
+
+    if (memory_tracking)
+        extract_mem_use_into_result(client, result);
+
+    if (token_count == 0) {
+        std::cerr << "    Streaming benchmark run failed (no tokens received)" << std::endl;
+        return result;
+    }
+
+    result.success = true;
+    return result;
+}
+
 BenchRunResult run_single_bench_embed(lemonade::LemonadeClient& client,
                                 const std::string& model,
                                 const BenchScenario& scenario,
@@ -874,7 +1029,8 @@ BenchScenarioResult run_scenario(lemonade::LemonadeClient& client,
                                  int timeout,
                                  const std::string& backend_args,
                                  const std::string& response_log_path,
-                                 const std::string& response_timestamp) {
+                                 const std::string& response_timestamp,
+                                 bool stream) {
     BenchScenarioResult result;
     result.scenario_name = scenario.name;
     result.category = scenario.category;
@@ -900,7 +1056,7 @@ BenchScenarioResult run_scenario(lemonade::LemonadeClient& client,
             }
         }
         std::cout << "    Warmup " << (i + 1) << "/" << warmup << "..." << std::flush;
-        run_single_bench(client, model, scenario, false, false, timeout);
+        run_single_bench(client, model, scenario, false, false, timeout, stream);
         std::cout << " done" << std::endl;
     }
 
@@ -916,7 +1072,7 @@ BenchScenarioResult run_scenario(lemonade::LemonadeClient& client,
         }
 
         std::cout << "    Run " << (i + 1) << "/" << runs << "..." << std::flush;
-        auto run_result = run_single_bench(client, model, scenario, memory_tracking, !response_log_path.empty(), timeout);
+        auto run_result = run_single_bench(client, model, scenario, memory_tracking, !response_log_path.empty(), timeout, stream);
         if (!run_result.success) {
             result.failed_runs++;
             std::cout << " FAILED (excluded from stats)" << std::endl;
@@ -956,6 +1112,13 @@ BenchScenarioResult run_scenario(lemonade::LemonadeClient& client,
         result.runs.push_back(run_result);
     }
 
+    if (result.has_token_gaps()) {
+        std::cout << "    Inter-token latency: p50=" << std::fixed << std::setprecision(1)
+                  << result.itl_p50_ms() << "ms p95=" << result.itl_p95_ms()
+                  << "ms p99=" << result.itl_p99_ms() << "ms, stalls(>500ms)="
+                  << result.stall_count() << std::endl;
+    }
+
     return result;
 }
 
@@ -1131,6 +1294,7 @@ json to_json(const std::vector<BenchBackendResult>& results,
     config_json["warmup_runs"] = config.warmup_runs;
     config_json["measurement_runs"] = config.measurement_runs;
     config_json["memory_tracking"] = config.memory_tracking;
+    config_json["stream"] = config.stream;
     output["config"] = config_json;
 
     json results_json = json::array();
@@ -1189,6 +1353,17 @@ json to_json(const std::vector<BenchBackendResult>& results,
                 tps_stats["p95"] = scenario.tps_p95();
                 s_json["tps"] = tps_stats;
 
+                if (scenario.has_token_gaps()) {
+                    json itl_stats;
+                    itl_stats["p50"] = scenario.itl_p50_ms();
+                    itl_stats["p95"] = scenario.itl_p95_ms();
+                    itl_stats["p99"] = scenario.itl_p99_ms();
+                    itl_stats["stall_count"] = scenario.stall_count();
+                    itl_stats["stall_threshold_ms"] = 500.0;
+                    itl_stats["histogram"] = scenario.itl_histogram();
+                    s_json["inter_token_ms"] = itl_stats;
+                }
+
                 double vram_peak = scenario.vram_peak_gb();
                 if (vram_peak >= 0) s_json["vram_peak_gb"] = vram_peak;
                 double mem_peak = scenario.memory_peak_gb();
@@ -1476,12 +1651,203 @@ json build_comparison_json(const std::vector<BenchBackendResult>& results,
 }
 
 
+namespace {
+
+struct FleetTarget {
+    std::string name;
+    lemonade::LemonadeClient* client;
+    std::shared_ptr<lemonade::LemonadeClient> owned;
+};
+
+struct FleetResult {
+    std::string host;
+    json bench;
+    std::string error;
+};
+
+json fleet_bench_params(const std::string& model, const BenchConfig& config) {
+    json params = {{"model", model},
+                   {"runs", std::max(1, config.measurement_runs)}};
+    if (!config.ctx_sizes.empty()) params["prompt_tokens"] = config.ctx_sizes;
+    return params;
+}
+
+void print_fleet_table(const std::string& model, const std::vector<FleetResult>& results) {
+    size_t host_width = 4;
+    for (const auto& r : results) host_width = std::max(host_width, r.host.size());
+
+    std::cout << "\nFleet benchmark: " << model << "\n";
+    std::cout << std::left << std::setw(static_cast<int>(host_width) + 2) << "Host"
+              << std::right << std::setw(8) << "Prompt"
+              << std::setw(10) << "TTFT ms"
+              << std::setw(13) << "Prefill t/s"
+              << std::setw(12) << "Decode t/s" << "\n";
+
+    const auto cell = [](const json& probe, const char* key) -> std::string {
+        if (!probe.contains(key) || !probe[key].is_number()) return "-";
+        std::ostringstream out;
+        out << std::fixed << std::setprecision(1) << probe[key].get<double>();
+        return out.str();
+    };
+
+    for (const auto& r : results) {
+        if (!r.error.empty()) {
+            std::cout << std::left << std::setw(static_cast<int>(host_width) + 2) << r.host
+                      << "error: " << r.error << "\n";
+            continue;
+        }
+        for (const auto& probe : r.bench.value("probes", json::array())) {
+            std::cout << std::left << std::setw(static_cast<int>(host_width) + 2) << r.host
+                      << std::right << std::setw(8) << probe.value("prompt_tokens_requested", 0)
+                      << std::setw(10) << cell(probe, "ttft_ms")
+                      << std::setw(13) << cell(probe, "prefill_tps")
+                      << std::setw(12) << cell(probe, "decode_tps") << "\n";
+        }
+    }
+
+    std::cout << "\nHardware:\n";
+    for (const auto& r : results) {
+        if (!r.error.empty()) continue;
+        const json hw = r.bench.value("hardware", json::object());
+        std::cout << "  " << r.host << ": " << hw.value("processor", "unknown");
+        for (const auto& gpu : hw.value("gpus", json::array()))
+            std::cout << " | " << gpu.value("name", "");
+        std::cout << "\n";
+    }
+}
+
+int handle_fleet_bench(lemonade::LemonadeClient& client, const BenchConfig& config) {
+    json federation = json::array();
+    try {
+        json health = json::parse(
+            client.make_request("/api/v1/health", "GET", "", "", 5000, 5000));
+        if (health.contains("federation") && health["federation"].is_array())
+            federation = health["federation"];
+    } catch (const std::exception& e) {
+        std::cerr << "Error: could not reach the local server: " << e.what() << std::endl;
+        return 1;
+    }
+
+    std::vector<FleetTarget> targets;
+    targets.push_back({"local", &client, nullptr});
+    for (const auto& peer : federation) {
+        if (!peer.value("reachable", false)) continue;
+        const std::string url = peer.value("url", "");
+        if (url.empty()) continue;
+        auto peer_client = std::make_shared<lemonade::LemonadeClient>(url, 0, "");
+        targets.push_back({peer.value("hostname", url), peer_client.get(), peer_client});
+    }
+    if (targets.size() == 1) {
+        std::cout << "No reachable federation peers; benchmarking the local server only."
+                  << " (Enable federation in config.json to include the fleet.)" << std::endl;
+    } else {
+        std::cout << "Benchmarking " << targets.size() << " servers (local + "
+                  << (targets.size() - 1) << " federation peers)..." << std::endl;
+    }
+
+    json aggregate = json::array();
+    bool any_success = false;
+    for (const auto& model : config.models) {
+        struct PendingJob {
+            const FleetTarget* target;
+            std::string job_id;
+            FleetResult result;
+        };
+        std::vector<PendingJob> pending;
+
+        // Submit everywhere before polling anywhere so the fleet benches
+        // concurrently.
+        for (const auto& target : targets) {
+            PendingJob entry{&target, "", {target.name, json(), ""}};
+            const json body = {
+                {"name", "fleet bench " + model},
+                {"steps", json::array({{{"id", "bench"},
+                                        {"op", "bench"},
+                                        {"params", fleet_bench_params(model, config)}}})}};
+            try {
+                json response = json::parse(target.client->make_request(
+                    "/api/v1/jobs", "POST", body.dump(), "application/json", 10000, 10000));
+                entry.job_id = response.value("id", "");
+                if (entry.job_id.empty()) entry.result.error = "no job id in response";
+            } catch (const std::exception& e) {
+                entry.result.error = e.what();
+            }
+            pending.push_back(std::move(entry));
+        }
+
+        // The job covers a model load plus every probe size and run, so allow
+        // several per-request timeouts of wall time.
+        const auto deadline = steady_clock::now() +
+                              milliseconds(static_cast<int64_t>(config.timeout) * 4);
+        for (auto& entry : pending) {
+            if (!entry.result.error.empty()) continue;
+            while (steady_clock::now() < deadline) {
+                try {
+                    json job = json::parse(entry.target->client->make_request(
+                        "/api/v1/jobs/" + entry.job_id, "GET", "", "", 10000, 10000));
+                    const std::string status = job.value("status", "");
+                    if (status == "completed") {
+                        entry.result.bench =
+                            job.value("context", json::object()).value("bench", json());
+                        break;
+                    }
+                    if (status == "failed" || status == "interrupted") {
+                        entry.result.error = job.value("error", "job " + status);
+                        break;
+                    }
+                } catch (const std::exception& e) {
+                    entry.result.error = e.what();
+                    break;
+                }
+                std::this_thread::sleep_for(seconds(2));
+            }
+            if (entry.result.error.empty() && entry.result.bench.is_null())
+                entry.result.error = "timed out waiting for the bench job";
+        }
+
+        std::vector<FleetResult> results;
+        for (auto& entry : pending) {
+            if (entry.result.error.empty()) any_success = true;
+            results.push_back(std::move(entry.result));
+        }
+
+        if (config.json_output) {
+            json model_entry = {{"model", model}, {"results", json::array()}};
+            for (const auto& r : results) {
+                json item = {{"host", r.host}};
+                if (r.error.empty()) item["bench"] = r.bench;
+                else item["error"] = r.error;
+                model_entry["results"].push_back(std::move(item));
+            }
+            aggregate.push_back(std::move(model_entry));
+        } else {
+            print_fleet_table(model, results);
+        }
+    }
+
+    if (config.json_output) {
+        const std::string dump = aggregate.dump(2);
+        std::cout << dump << std::endl;
+        if (!config.output_file.empty()) {
+            std::ofstream out(config.output_file);
+            out << dump << std::endl;
+        }
+    }
+    return any_success ? 0 : 1;
+}
+
+} // namespace
+
 int handle_bench_command(lemonade::LemonadeClient& client, const BenchConfig& config) {
     if (config.models.empty()) {
         std::cerr << "Error: At least one model must be provided." << std::endl;
         return 1;
     }
 
+    if (config.fleet) {
+        return handle_fleet_bench(client, config);
+    }
+
     // Deduplicate models while preserving order (first occurrence wins).
     std::vector<std::string> unique_models;
     std::unordered_set<std::string> seen_models;
@@ -1700,7 +2066,8 @@ int handle_bench_command(lemonade::LemonadeClient& client, const BenchConfig& co
                                                             config.memory_tracking, config.reload,
                                                             recipe, backend, ctx_size, config.timeout, recipe_args,
                                                             config.response_log,
-                                                            command_timestamp);
+                                                            command_timestamp,
+                                                            config.stream);
                         backend_result.scenarios.push_back(scenario_result);
                     }
 
@@ -1886,8 +2253,9 @@ CLI::App* register_bench_command(CLI::App& parent,
                                  std::string& output_file,
                                  BenchCliOptions& opts) {
     CLI::App* cmd = parent.add_subcommand("bench", "Benchmark model performance for different model types")->group("Model management");
+    // Not ->required(): --load-scenario names its models in the scenario file.
+    // handle_bench_command still rejects an empty model list.
     cmd->add_option("models", opts.models, "One or more model names to benchmark")
-        ->required()
         ->type_name("MODEL")
         ->expected(1, -1);
     cmd->add_option("--backend", opts.backends, "Backend to test (e.g., vulkan, metal, cpu). Repeat for multiple.")
@@ -1913,6 +2281,12 @@ CLI::App* register_bench_command(CLI::App& parent,
     cmd->add_flag("--no-memory", opts.no_memory, "Disable VRAM/RAM tracking");
     cmd->add_flag("--no-reload", opts.no_reload, "Skip model reload between scenarios (faster but prompt cache may skew results)");
     cmd->add_option("--response-log", opts.response_log, "Write captured responses to a JSONL logfile")->type_name("FILE");
+    cmd->add_flag("--stream", opts.stream,
+        "Stream completions over SSE and capture per-token arrival times "
+        "(inter-token latency p50/p95/p99, stall count, histogram)");
+    cmd->add_option("--load-scenario", opts.load_scenario,
+        "Run a concurrent load scenario from a JSON file (weighted request mix, "
+        "Poisson/burst arrivals) instead of per-model benchmarks")->type_name("FILE");
     cmd->add_option("--llamacpp-args", opts.llamacpp_args, "Custom args for llama-server (e.g. \"-b 2048 -ub 1024\"). Repeat for multiple.")
         ->type_name("ARGS")
         ->multi_option_policy(CLI::MultiOptionPolicy::TakeAll);
@@ -1930,6 +2304,9 @@ CLI::App* register_bench_command(CLI::App& parent,
         ->multi_option_policy(CLI::MultiOptionPolicy::TakeAll);
     cmd->add_option("--timeout", opts.timeout, "Timeout in seconds for individual requests (default: 300)")
         ->type_name("SECONDS");
+    cmd->add_flag("--fleet", opts.fleet,
+        "Run standardized probes as a server-side 'bench' job on this server and "
+        "every reachable federation peer, then print a comparison table");
     return cmd;
 }
 
@@ -1958,6 +2335,8 @@ BenchConfig build_bench_config(const std::string& output_file,
     if (!cli.sdcpp_args.empty()) config.backend_args["sd-cpp"] = cli.sdcpp_args;
     if (!cli.whispercpp_args.empty()) config.backend_args["whispercpp"] = cli.whispercpp_args;
     config.timeout = cli.timeout * 1000;
+    config.stream = cli.stream;
+    config.fleet = cli.fleet;
     return config;
 }
 
@@ -0,0 +1,395 @@
+#include "lemon_cli/bench_load.h"
+#include "lemon_cli/lemonade_client.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <condition_variable>
+#include <deque>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <mutex>
+#include <random>
+#include <thread>
+
+namespace lemon_cli {
+
+using json = nlohmann::json;
+using namespace std::chrono;
+
+static double load_percentile(std::vector<double> values, double p) {
+    if (values.empty()) return 0.0;
+    std::sort(values.begin(), values.end());
+    double rank = (p / 100.0) * (values.size() - 1);
+    size_t lo = static_cast<size_t>(rank);
+    size_t hi = (std::min)(lo + 1, values.size() - 1);
+    double frac = rank - lo;
+    return values[lo] * (1.0 - frac) + values[hi] * frac;
+}
+
+double LoadClassReport::latency_mean_ms() const {
+    if (latencies_ms.empty()) return 0.0;
+    double sum = 0.0;
+    for (double v : latencies_ms) sum += v;
+    return sum / latencies_ms.size();
+}
+
+double LoadClassReport::latency_p50_ms() const { return load_percentile(latencies_ms, 50.0); }
+double LoadClassReport::latency_p95_ms() const { return load_percentile(latencies_ms, 95.0); }
+double LoadClassReport::latency_p99_ms() const { return load_percentile(latencies_ms, 99.0); }
+
+static const std::vector<std::string> kLoadKinds = {
+    "chat", "completions", "embeddings", "reranking"
+};
+
+LoadScenario parse_load_scenario_file(const std::string& path) {
+    std::ifstream file(path);
+    if (!file.is_open()) {
+        throw std::runtime_error("Cannot open load scenario file: " + path);
+    }
+
+    json root;
+    try {
+        file >> root;
+    } catch (const std::exception& e) {
+        throw std::runtime_error("Invalid JSON in " + path + ": " + e.what());
+    }
+
+    LoadScenario scenario;
+    scenario.name = root.value("name", "load");
+    scenario.duration_seconds = root.value("duration_seconds", 30.0);
+    scenario.max_in_flight = root.value("max_in_flight", 8);
+    if (scenario.duration_seconds <= 0.0) {
+        throw std::runtime_error("'duration_seconds' must be > 0");
+    }
+    if (scenario.max_in_flight < 1) {
+        throw std::runtime_error("'max_in_flight' must be >= 1");
+    }
+
+    if (root.contains("arrival") && root["arrival"].is_object()) {
+        const auto& arrival = root["arrival"];
+        scenario.arrival.distribution = arrival.value("distribution", "poisson");
+        scenario.arrival.rate_per_second = arrival.value("rate_per_second", 1.0);
+        scenario.arrival.burst_size = arrival.value("burst_size", 4);
+        scenario.arrival.burst_interval_seconds = arrival.value("burst_interval_seconds", 2.0);
+    }
+    const auto& dist = scenario.arrival.distribution;
+    if (dist != "poisson" && dist != "uniform" && dist != "burst") {
+        throw std::runtime_error("'arrival.distribution' must be poisson, uniform, or burst");
+    }
+    if (scenario.arrival.rate_per_second <= 0.0) {
+        throw std::runtime_error("'arrival.rate_per_second' must be > 0");
+    }
+    if (dist == "burst" &&
+        (scenario.arrival.burst_size < 1 || scenario.arrival.burst_interval_seconds <= 0.0)) {
+        throw std::runtime_error("burst arrivals need 'burst_size' >= 1 and 'burst_interval_seconds' > 0");
+    }
+
+    if (!root.contains("classes") || !root["classes"].is_array() || root["classes"].empty()) {
+        throw std::runtime_error("'classes' must be a non-empty array");
+    }
+    for (const auto& entry : root["classes"]) {
+        LoadClass cls;
+        cls.kind = entry.value("kind", "chat");
+        cls.name = entry.value("name", cls.kind);
+        cls.model = entry.value("model", "");
+        cls.weight = entry.value("weight", 1.0);
+        cls.max_tokens = entry.value("max_tokens", 64);
+        cls.payload = entry;
+        if (std::find(kLoadKinds.begin(), kLoadKinds.end(), cls.kind) == kLoadKinds.end()) {
+            throw std::runtime_error("class '" + cls.name + "': unknown kind '" + cls.kind + "'");
+        }
+        if (cls.model.empty()) {
+            throw std::runtime_error("class '" + cls.name + "': 'model' is required");
+        }
+        if (cls.weight <= 0.0) {
+            throw std::runtime_error("class '" + cls.name + "': 'weight' must be > 0");
+        }
+        scenario.classes.push_back(std::move(cls));
+    }
+    return scenario;
+}
+
+static std::string endpoint_for_kind(const std::string& kind) {
+    if (kind == "completions") return "/api/v1/completions";
+    if (kind == "embeddings") return "/api/v1/embeddings";
+    if (kind == "reranking") return "/api/v1/reranking";
+    return "/api/v1/chat/completions";
+}
+
+static json build_request_body(const LoadClass& cls) {
+    json body;
+    body["model"] = cls.model;
+    if (cls.kind == "chat") {
+        if (cls.payload.contains("messages") && cls.payload["messages"].is_array()) {
+            body["messages"] = cls.payload["messages"];
+        } else {
+            body["messages"] = json::array({
+                {{"role", "user"}, {"content", "Summarize the benefits of local inference in two sentences."}}
+            });
+        }
+        body["max_completion_tokens"] = cls.max_tokens;
+        body["temperature"] = 0;
+    } else if (cls.kind == "completions") {
+        body["prompt"] = cls.payload.value("prompt", "Local inference is useful because");
+        body["max_tokens"] = cls.max_tokens;
+        body["temperature"] = 0;
+    } else if (cls.kind == "embeddings") {
+        body["input"] = cls.payload.contains("input")
+            ? cls.payload["input"]
+            : json("A short passage to embed for capacity planning.");
+    } else {
+        body["query"] = cls.payload.value("query", "capacity planning");
+        body["documents"] = cls.payload.contains("documents") && cls.payload["documents"].is_array()
+            ? cls.payload["documents"]
+            : json::array({"Routers route requests.", "Benchmarks measure latency.", "Models use VRAM."});
+    }
+    return body;
+}
+
+namespace {
+
+struct PendingRequest {
+    size_t class_index;
+    steady_clock::time_point enqueued;
+};
+
+struct LoadState {
+    std::mutex mutex;
+    std::condition_variable cv;
+    std::deque<PendingRequest> queue;
+    bool done = false;
+    size_t peak_queue_depth = 0;
+    std::vector<LoadClassReport> reports;
+};
+
+}  // namespace
+
+static void load_worker(lemonade::LemonadeClient& client, const LoadScenario& scenario,
+                        const std::vector<std::string>& bodies, int timeout_ms,
+                        LoadState& state) {
+    for (;;) {
+        PendingRequest pending;
+        {
+            std::unique_lock<std::mutex> lock(state.mutex);
+            state.cv.wait(lock, [&] { return state.done || !state.queue.empty(); });
+            if (state.queue.empty()) {
+                return;
+            }
+            pending = state.queue.front();
+            state.queue.pop_front();
+        }
+
+        const LoadClass& cls = scenario.classes[pending.class_index];
+        bool ok = false;
+        try {
+            std::string response = client.make_request(
+                endpoint_for_kind(cls.kind), "POST", bodies[pending.class_index],
+                "application/json", timeout_ms, timeout_ms);
+            auto resp_json = json::parse(response);
+            ok = !resp_json.contains("error");
+        } catch (const std::exception&) {
+            ok = false;
+        }
+        const double latency_ms =
+            duration<double, std::milli>(steady_clock::now() - pending.enqueued).count();
+
+        std::lock_guard<std::mutex> lock(state.mutex);
+        auto& report = state.reports[pending.class_index];
+        if (ok) {
+            ++report.completed;
+            report.latencies_ms.push_back(latency_ms);
+        } else {
+            ++report.failed;
+        }
+    }
+}
+
+static LoadReport run_load_scenario(lemonade::LemonadeClient& client,
+                                    const LoadScenario& scenario, int timeout_ms) {
+    std::vector<std::string> bodies;
+    std::vector<double> weights;
+    for (const auto& cls : scenario.classes) {
+        bodies.push_back(build_request_body(cls).dump());
+        weights.push_back(cls.weight);
+    }
+
+    LoadState state;
+    state.reports.resize(scenario.classes.size());
+    for (size_t i = 0; i < scenario.classes.size(); ++i) {
+        state.reports[i].name = scenario.classes[i].name;
+    }
+
+    std::vector<std::thread> workers;
+    for (int i = 0; i < scenario.max_in_flight; ++i) {
+        workers.emplace_back(load_worker, std::ref(client), std::cref(scenario),
+                             std::cref(bodies), timeout_ms, std::ref(state));
+    }
+
+    std::mt19937 rng(std::random_device{}());
+    std::discrete_distribution<size_t> pick_class(weights.begin(), weights.end());
+    std::exponential_distribution<double> poisson_gap(scenario.arrival.rate_per_second);
+
+    const auto start = steady_clock::now();
+    const auto deadline = start + duration_cast<steady_clock::duration>(
+                                      duration<double>(scenario.duration_seconds));
+
+    auto enqueue = [&](int count) {
+        std::lock_guard<std::mutex> lock(state.mutex);
+        for (int i = 0; i < count; ++i) {
+            const size_t index = pick_class(rng);
+            state.queue.push_back({index, steady_clock::now()});
+            ++state.reports[index].dispatched;
+        }
+        state.peak_queue_depth = (std::max)(state.peak_queue_depth, state.queue.size());
+        state.cv.notify_all();
+    };
+
+    while (steady_clock::now() < deadline) {
+        double gap_seconds;
+        int count;
+        if (scenario.arrival.distribution == "burst") {
+            count = scenario.arrival.burst_size;
+            gap_seconds = scenario.arrival.burst_interval_seconds;
+        } else if (scenario.arrival.distribution == "poisson") {
+            count = 1;
+            gap_seconds = poisson_gap(rng);
+        } else {
+            count = 1;
+            gap_seconds = 1.0 / scenario.arrival.rate_per_second;
+        }
+        enqueue(count);
+
+        const auto wake = steady_clock::now() + duration_cast<steady_clock::duration>(
+                                                    duration<double>(gap_seconds));
+        std::this_thread::sleep_until((std::min)(wake, deadline));
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(state.mutex);
+        state.done = true;
+    }
+    state.cv.notify_all();
+    for (auto& worker : workers) {
+        worker.join();
+    }
+
+    LoadReport report;
+    report.elapsed_seconds =
+        duration<double>(steady_clock::now() - start).count();
+    report.peak_queue_depth = state.peak_queue_depth;
+    report.classes = std::move(state.reports);
+    try {
+        report.router_stats = json::parse(client.make_request("/api/v1/stats"));
+    } catch (const std::exception&) {
+        report.router_stats = json::object();
+    }
+    return report;
+}
+
+static json load_report_to_json(const LoadScenario& scenario, const LoadReport& report) {
+    json out;
+    out["scenario"] = scenario.name;
+    out["duration_seconds"] = report.elapsed_seconds;
+    out["arrival"] = {
+        {"distribution", scenario.arrival.distribution},
+        {"rate_per_second", scenario.arrival.rate_per_second},
+    };
+    out["peak_queue_depth"] = report.peak_queue_depth;
+    out["classes"] = json::array();
+    for (const auto& cls : report.classes) {
+        out["classes"].push_back({
+            {"name", cls.name},
+            {"dispatched", cls.dispatched},
+            {"completed", cls.completed},
+            {"failed", cls.failed},
+            {"achieved_rps", report.elapsed_seconds > 0.0
+                                 ? cls.completed / report.elapsed_seconds
+                                 : 0.0},
+            {"latency_ms", {
+                {"mean", cls.latency_mean_ms()},
+                {"p50", cls.latency_p50_ms()},
+                {"p95", cls.latency_p95_ms()},
+                {"p99", cls.latency_p99_ms()},
+            }},
+        });
+    }
+    out["router_stats"] = report.router_stats;
+    return out;
+}
+
+static void print_load_report(const LoadScenario& scenario, const LoadReport& report) {
+    std::cout << "\nLoad scenario '" << scenario.name << "' — "
+              << std::fixed << std::setprecision(1) << report.elapsed_seconds << "s, "
+              << scenario.arrival.distribution << " @ "
+              << scenario.arrival.rate_per_second << " req/s, "
+              << scenario.max_in_flight << " worker(s)" << std::endl;
+
+    std::cout << std::left << std::setw(20) << "class"
+              << std::right << std::setw(8) << "sent"
+              << std::setw(8) << "ok"
+              << std::setw(8) << "err"
+              << std::setw(8) << "rps"
+              << std::setw(10) << "mean ms"
+              << std::setw(10) << "p50 ms"
+              << std::setw(10) << "p95 ms"
+              << std::setw(10) << "p99 ms" << std::endl;
+
+    for (const auto& cls : report.classes) {
+        const double rps = report.elapsed_seconds > 0.0
+                               ? cls.completed / report.elapsed_seconds
+                               : 0.0;
+        std::cout << std::left << std::setw(20) << cls.name
+                  << std::right << std::setw(8) << cls.dispatched
+                  << std::setw(8) << cls.completed
+                  << std::setw(8) << cls.failed
+                  << std::setw(8) << std::setprecision(2) << rps
+                  << std::setw(10) << std::setprecision(1) << cls.latency_mean_ms()
+                  << std::setw(10) << cls.latency_p50_ms()
+                  << std::setw(10) << cls.latency_p95_ms()
+                  << std::setw(10) << cls.latency_p99_ms() << std::endl;
+    }
+
+    std::cout << "Peak client queue depth: " << report.peak_queue_depth << std::endl;
+    if (report.router_stats.is_object() && !report.router_stats.empty()) {
+        std::cout << "Router stats: " << report.router_stats.dump() << std::endl;
+    }
+}
+
+int handle_bench_load_command(lemonade::LemonadeClient& client,
+                              const BenchLoadConfig& config) {
+    LoadScenario scenario;
+    try {
+        scenario = parse_load_scenario_file(config.scenario_file);
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return 1;
+    }
+
+    std::cout << "Running load scenario '" << scenario.name << "' ("
+              << scenario.classes.size() << " class(es), "
+              << std::fixed << std::setprecision(1) << scenario.duration_seconds
+              << "s)..." << std::endl;
+
+    LoadReport report = run_load_scenario(client, scenario, config.timeout_ms);
+
+    if (config.json_output) {
+        std::cout << load_report_to_json(scenario, report).dump(2) << std::endl;
+    } else {
+        print_load_report(scenario, report);
+    }
+
+    if (!config.output_file.empty()) {
+        std::ofstream out(config.output_file);
+        if (out.is_open()) {
+            out << load_report_to_json(scenario, report).dump(2) << std::endl;
+            std::cout << "Results written to " << config.output_file << std::endl;
+        } else {
+            std::cerr << "Warning: Could not write to " << config.output_file << std::endl;
+        }
+    }
+    return 0;
+}
+
+}  // namespace lemon_cli
@@ -8,6 +8,7 @@
 #include <cstdio>
 #include <iostream>
 #include <mutex>
+#include <random>
 #include <sstream>
 #include <string>
 #include <thread>
@@ -490,16 +491,29 @@ struct TurnResult {
     double seconds = 0.0;
 };
 
+// Pins the whole REPL conversation to one llama-server slot so each turn
+// prefills only its newest messages instead of re-running the full history
+// whenever slots shuffle. Backends without slot pinning ignore the id.
+std::string make_session_id() {
+    std::random_device rd;
+    std::mt19937_64 gen(rd());
+    std::ostringstream oss;
+    oss << "repl-" << std::hex << gen();
+    return oss.str();
+}
+
 // Non-streaming version: returns the full assistant text via assistant_out.
 TurnResult blocking_chat_turn(const TermUi& ui,
                               lemonade::LemonadeClient& client,
                               const std::string& model,
+                              const std::string& session_id,
                               const json& messages,
                               ReasoningMode reasoning,
                               std::string& assistant_out) {
     TurnResult result;
     json request_body;
     request_body["model"] = model;
+    request_body["session_id"] = session_id;
     request_body["messages"] = messages;
     request_body["stream"] = false;
     apply_reasoning_to_request(request_body, reasoning);
@@ -573,6 +587,7 @@ TurnResult blocking_chat_turn(const TermUi& ui,
 TurnResult stream_chat_turn_capture(const TermUi& ui,
                                     lemonade::LemonadeClient& client,
                                     const std::string& model,
+                                    const std::string& session_id,
                                     const json& messages,
                                     ReasoningMode reasoning,
                                     std::string& assistant_out) {
@@ -580,6 +595,7 @@ TurnResult stream_chat_turn_capture(const TermUi& ui,
 
     json request_body;
     request_body["model"] = model;
+    request_body["session_id"] = session_id;
     request_body["messages"] = messages;
     request_body["stream"] = true;
     request_body["stream_options"] = {{"include_usage", true}};
@@ -937,6 +953,8 @@ int run_chat_repl(lemonade::LemonadeClient& client, const ChatOptions& options)
         return 1;
     }
 
+    const std::string session_id = make_session_id();
+
     json messages;
     rebuild_messages(messages, system_prompt);
 
@@ -1115,9 +1133,9 @@ int run_chat_repl(lemonade::LemonadeClient& client, const ChatOptions& options)
 
         std::string assistant_text;
         TurnResult turn = stream
-            ? stream_chat_turn_capture(ui, client, active_model, messages,
+            ? stream_chat_turn_capture(ui, client, active_model, session_id, messages,
                                        reasoning_mode, assistant_text)
-            : blocking_chat_turn(ui, client, active_model, messages,
+            : blocking_chat_turn(ui, client, active_model, session_id, messages,
                                  reasoning_mode, assistant_text);
 
         if (turn.interrupted) {
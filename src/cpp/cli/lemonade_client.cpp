@@ -1,7 +1,10 @@
 #include "lemon_cli/lemonade_client.h"
 #include <httplib.h>
+#include <lemon/utils/path_utils.h>
 #include <iostream>
 #include <algorithm>
+#include <filesystem>
+#include <fstream>
 #include <iomanip>
 #include <regex>
 #include <sstream>
@@ -230,6 +233,57 @@ std::string LemonadeClient::make_request(const std::string& path, const std::str
 
 }
 
+static std::filesystem::path snapshot_file(const std::string& name) {
+    return std::filesystem::path(lemon::utils::get_cache_dir()) /
+           ("cli_snapshot_" + name + ".json");
+}
+
+std::string LemonadeClient::fetch_json_with_snapshot(const std::string& path,
+                                                     const std::string& snapshot_name) const {
+    const std::string normalized_host = normalize_host(host_);
+    const std::string server_key = normalized_host + ":" + std::to_string(port_);
+    const auto cache_path = snapshot_file(snapshot_name);
+
+    std::string cached_etag;
+    std::string cached_body;
+    try {
+        std::ifstream in(cache_path);
+        if (in.is_open()) {
+            json snapshot;
+            in >> snapshot;
+            if (snapshot.value("server", "") == server_key) {
+                cached_etag = snapshot.value("etag", "");
+                cached_body = snapshot.value("body", "");
+            }
+        }
+    } catch (const std::exception&) {
+        // Corrupt snapshot — treat as a cache miss.
+    }
+
+    httplib::Client cli = make_client(normalized_host, port_, api_key_, is_ssl_);
+    httplib::Headers headers;
+    if (!cached_etag.empty() && !cached_body.empty()) {
+        headers.emplace("If-None-Match", cached_etag);
+    }
+    auto res = cli.Get(path, headers);
+    if (res && res->status == 304) {
+        return cached_body;
+    }
+    assert_http_ok(res);
+
+    const std::string etag = res->get_header_value("ETag");
+    if (!etag.empty()) {
+        try {
+            json snapshot = {{"server", server_key}, {"etag", etag}, {"body", res->body}};
+            std::ofstream out(cache_path, std::ios::trunc);
+            out << snapshot.dump();
+        } catch (const std::exception&) {
+            // Best effort — the next invocation just refetches.
+        }
+    }
+    return res->body;
+}
+
 // Helper function to handle SSE streaming response. If `should_abort` is
 // non-null and returns true, the content receiver returns `false`, which makes
 // httplib close the connection and return immediately — used to stop streaming
@@ -354,6 +408,38 @@ int LemonadeClient::check_model_updates() const {
     }
 }
 
+static void render_loaded_models_table(const json& models) {
+    if (models.is_array() && !models.empty()) {
+        std::cout << std::endl;
+        std::cout << std::left
+                  << std::setw(30) << "Model"
+                  << std::setw(10) << "Type"
+                  << std::setw(10) << "Device"
+                  << std::setw(14) << "Recipe"
+                  << "Checkpoint" << std::endl;
+        std::cout << std::string(100, '-') << std::endl;
+
+        for (const auto& model : models) {
+            if (!model.is_object()) continue;
+
+            std::string model_name = model.value("model_name", "-");
+            if (model.value("pinned", false)) {
+                model_name += " (pinned)";
+            }
+
+            std::cout << std::left
+                      << std::setw(30) << model_name
+                      << std::setw(10) << model.value("type", "-")
+                      << std::setw(10) << model.value("device", "-")
+                      << std::setw(14) << model.value("recipe", "-")
+                      << model.value("checkpoint", "-") << std::endl;
+        }
+    } else {
+        std::cout << std::endl;
+        std::cout << "No models loaded." << std::endl;
+    }
+}
+
 int LemonadeClient::status(int display_port) const {
     try {
         std::string response = make_request("/api/v1/health", "GET", "", "", 500, 500);
@@ -380,37 +466,7 @@ int LemonadeClient::status(int display_port) const {
                       << json_response["max_models"]["llm"].get<int>() << std::endl;
         }
 
-        // Loaded models table
-        if (json_response.contains("all_models_loaded") && json_response["all_models_loaded"].is_array() &&
-            !json_response["all_models_loaded"].empty()) {
-            std::cout << std::endl;
-            std::cout << std::left
-                      << std::setw(30) << "Model"
-                      << std::setw(10) << "Type"
-                      << std::setw(10) << "Device"
-                      << std::setw(14) << "Recipe"
-                      << "Checkpoint" << std::endl;
-            std::cout << std::string(100, '-') << std::endl;
-
-            for (const auto& model : json_response["all_models_loaded"]) {
-                if (!model.is_object()) continue;
-
-                std::string model_name = model.value("model_name", "-");
-                if (model.value("pinned", false)) {
-                    model_name += " (pinned)";
-                }
-
-                std::cout << std::left
-                          << std::setw(30) << model_name
-                          << std::setw(10) << model.value("type", "-")
-                          << std::setw(10) << model.value("device", "-")
-                          << std::setw(14) << model.value("recipe", "-")
-                          << model.value("checkpoint", "-") << std::endl;
-            }
-        } else {
-            std::cout << std::endl;
-            std::cout << "No models loaded." << std::endl;
-        }
+        render_loaded_models_table(json_response.value("all_models_loaded", json::array()));
 
         return 0;
 
@@ -432,6 +488,39 @@ int LemonadeClient::status(int display_port) const {
     }
 }
 
+int LemonadeClient::status_from_beacon(const json& beacon, int display_port) const {
+    try {
+        const json& state = beacon.at("status");
+
+        int port = display_port > 0 ? display_port : port_;
+        std::cout << "Server is running on port " << port << std::endl;
+        std::cout << std::endl;
+
+        std::cout << std::left << std::setw(20) << "Property" << "Value" << std::endl;
+        std::cout << std::string(50, '-') << std::endl;
+
+        if (state.contains("version") && state["version"].is_string()) {
+            std::cout << std::left << std::setw(20) << "Version"
+                      << state["version"].get<std::string>() << std::endl;
+        }
+        if (state.contains("load_factor") && state["load_factor"].is_number()) {
+            std::ostringstream load;
+            load << std::fixed << std::setprecision(2)
+                 << state["load_factor"].get<double>();
+            std::cout << std::left << std::setw(20) << "Load Factor"
+                      << load.str() << std::endl;
+        }
+
+        render_loaded_models_table(state.value("loaded", json::array()));
+
+        return 0;
+
+    } catch (const json::exception& e) {
+        std::cerr << "Error parsing beacon status: " << e.what() << std::endl;
+        return 1;
+    }
+}
+
 //Helper functions to calculate the total size of the models in a collection.
 static double get_collection_component_size(const json& model) {
     if (model.contains("recipe") && model["recipe"].is_string() && model["recipe"].get<std::string>() == "cloud") {
@@ -487,7 +576,9 @@ std::vector<ModelInfo> LemonadeClient::get_models(bool show_all) const {
     std::vector<ModelInfo> models;
 
     try {
-        std::string response = make_request("/api/v1/models?show_all=" + std::string(show_all ? "true" : "false"));
+        std::string response = fetch_json_with_snapshot(
+            "/api/v1/models?show_all=" + std::string(show_all ? "true" : "false"),
+            show_all ? "models_all" : "models_downloaded");
         auto json_response = json::parse(response);
 
         if (!json_response.contains("data") || !json_response["data"].is_array()) {
@@ -3,6 +3,7 @@
 #include "lemon_cli/recipe_import.h"
 #include "lemon_cli/hf_pull.h"
 #include "lemon_cli/bench.h"
+#include "lemon_cli/bench_load.h"
 #include "lemon_cli/chat_repl.h"
 #include <lemon_cli/agent_config_file.h>
 #include <lemon/model_types.h>
@@ -14,10 +15,12 @@
 #include <lemon/utils/process_manager.h>
 #include <lemon/utils/path_utils.h>
 #include <lemon/utils/network_beacon.h>
+#include <lemon/utils/rendezvous_channel.h>
 #include <lemon/utils/custom_args.h>
 #include <CLI/CLI.hpp>
 #include <iostream>
 #include <string>
+#include <filesystem>
 #include <fstream>
 #include <nlohmann/json.hpp>
 #include <algorithm>
@@ -166,6 +169,7 @@ struct CliConfig {
     std::string agent;
     std::string repo_dir;
     std::string recipe_file;
+    int import_jobs = 0;
     bool skip_prompt = false;
     bool yes = false;
     int scan_duration = 30;
@@ -324,6 +328,11 @@ static bool handle_backend_operation(const std::string& spec, const std::string&
 
 static int handle_import_command(lemonade::LemonadeClient& client, const CliConfig& config) {
     if (!config.model.empty()) {
+        std::error_code ec;
+        if (std::filesystem::is_directory(lemon::utils::path_from_utf8(config.model), ec)) {
+            return lemon_cli::import_models_from_directory(client, config.model,
+                                                           config.import_jobs);
+        }
         return lemon_cli::import_model_from_json_file(client, config.model);
     }
 
@@ -753,21 +762,39 @@ static int handle_launch_command(lemonade::LemonadeClient& client, CliConfig& co
         return 1;
     }
 
-    std::cout << "Loading model in background: " << config.model << std::endl;
+    std::cout << "Prewarming model in background: " << config.model << std::endl;
 
-    // Trigger load asynchronously so launch is non-blocking for agent startup.
+    // Trigger prewarm asynchronously so launch is non-blocking for agent startup.
     std::thread([host = config.host,
                  port = config.port,
                  api_key = config.api_key,
                  is_ssl = config.is_ssl,
+                 agent = config.agent,
                  model = config.model,
+                 prewarm_models = agent_config.prewarm_models,
                  recipe_options = config.recipe_options]() {
         try {
             lemonade::LemonadeClient async_client(host, port, api_key, is_ssl);
+
+            nlohmann::json prewarm_body;
+            prewarm_body["models"] = prewarm_models.empty()
+                ? std::vector<std::string>{model}
+                : prewarm_models;
+            prewarm_body["source"] = "launch:" + agent;
+            if (!recipe_options.empty()) {
+                prewarm_body["options"] = recipe_options;
+            }
+            // Keep the calls silent to avoid disrupting interactive agent UIs.
+            const std::string prewarm_response = async_client.make_request(
+                "/api/v1/prewarm", "POST", prewarm_body.dump(), "application/json");
+            if (prewarm_response.find("\"accepted\"") != std::string::npos) {
+                return;
+            }
+
+            // Older servers without the prewarm endpoint: fall back to a plain load.
             nlohmann::json request_body = recipe_options;
             request_body["model_name"] = model;
             request_body["save_options"] = false;
-            // Keep async load silent to avoid disrupting interactive agent UIs.
             (void)async_client.make_request("/api/v1/load", "POST", request_body.dump(), "application/json");
         } catch (const std::exception& e) {
             (void)e;
@@ -863,8 +890,19 @@ struct BeaconListener {
     BeaconListener& operator=(const BeaconListener&) = delete;
 };
 
-// Listen for a UDP beacon from localhost and return the server's HTTP port, or 0 if none found
+// Return the local server's HTTP port, or 0 if none found. The rendezvous
+// channel answers in single-digit milliseconds in every server state; waiting
+// out the UDP beacon interval is the fallback for pre-channel servers.
 static int discover_local_server_port() {
+    {
+        nlohmann::json hello;
+        if (lemon::utils::RendezvousChannel::query(hello) &&
+            hello.value("state", "") != "stopping") {
+            int port = hello.value("port", 0);
+            if (port > 0) return port;
+        }
+    }
+
     BeaconListener listener(13305, 250);
     if (!listener.valid) return 0;
 
@@ -923,6 +961,62 @@ static int discover_local_server_port() {
     return 0;
 }
 
+// Beacon v2 passive status: solicit an immediate keyframe from lemond, then
+// assemble server state off the loopback push channel instead of polling
+// /health. Returns false (caller falls back to HTTP) for v1 servers, remote
+// servers, or when no status-bearing beacon arrives in time.
+static bool collect_local_beacon_status(int expected_port, int wait_ms, nlohmann::json& out_beacon) {
+    BeaconListener listener(13305, 250);
+    if (!listener.valid) return false;
+
+    {
+        sockaddr_in dest{};
+        dest.sin_family = AF_INET;
+        dest.sin_port = htons(13305);
+        dest.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        const std::string probe = "{\"service\": \"lemonade\", \"probe\": true}";
+        sendto(listener.fd, probe.c_str(), (int)probe.size(), 0, (sockaddr*)&dest, sizeof(dest));
+    }
+
+    auto start_time = std::chrono::steady_clock::now();
+    while (std::chrono::duration_cast<std::chrono::milliseconds>(
+               std::chrono::steady_clock::now() - start_time).count() < wait_ms) {
+        char buffer[4096];
+        sockaddr_in client_addr{};
+        socklen_t addr_size = sizeof(client_addr);
+
+        int bytes_received = recvfrom(listener.fd, buffer, sizeof(buffer) - 1, 0,
+                                      (sockaddr*)&client_addr, &addr_size);
+        if (bytes_received <= 0) {
+            continue;
+        }
+        if (client_addr.sin_addr.s_addr != htonl(INADDR_LOOPBACK)) {
+            continue;
+        }
+        buffer[bytes_received] = '\0';
+
+        try {
+            auto beacon = nlohmann::json::parse(buffer);
+            if (beacon.value("service", "") != "lemonade") continue;
+            if (beacon.value("probe", false)) continue;
+            if (!beacon.contains("status") || !beacon["status"].is_object()) continue;
+
+            // Only trust state from the server on the port being reported on.
+            const std::string url = beacon.value("url", "");
+            if (url.find(":" + std::to_string(expected_port) + "/") == std::string::npos) {
+                continue;
+            }
+
+            out_beacon = std::move(beacon);
+            return true;
+        } catch (const nlohmann::json::exception&) {
+            // Not a valid JSON beacon, ignore
+        }
+    }
+
+    return false;
+}
+
 static std::string json_value_to_string(const nlohmann::json& val) {
     if (val.is_string()) return val.get<std::string>();
     if (val.is_boolean()) return val.get<bool>() ? "true" : "false";
@@ -1344,7 +1438,10 @@ int main(int argc, char* argv[]) {
         "  https://lemonade-server.ai/docs/guide/configuration/custom-models/");
 
     // Import options
-    import_cmd->add_option("json_file", config.model, "Path to JSON file")->type_name("JSON_FILE");
+    import_cmd->add_option("json_file", config.model,
+        "Path to a JSON file, or a directory of JSON files for bulk import")->type_name("JSON_FILE");
+    import_cmd->add_option("--jobs", config.import_jobs,
+        "Parallel workers for bulk directory import (default: hardware threads)")->type_name("N");
     import_cmd->add_option("--directory", config.repo_dir,
         "Remote recipe directory to query (e.g., coding-agents)")->type_name("DIR");
     import_cmd->add_option("--recipe-file", config.recipe_file,
@@ -1518,6 +1615,12 @@ int main(int argc, char* argv[]) {
             std::cout << out.dump() << std::endl;
             return 0;
         }
+        if (config.host == "127.0.0.1" || config.host == "localhost") {
+            nlohmann::json beacon_state;
+            if (collect_local_beacon_status(config.port, 2300, beacon_state)) {
+                return client.status_from_beacon(beacon_state, config.port);
+            }
+        }
         return client.status(config.port);
     } else if (list_cmd->count() > 0) {
         return client.list_models(!config.downloaded, config.list_filter);
@@ -1631,6 +1734,14 @@ int main(int argc, char* argv[]) {
     } else if (cleanup_cmd->count() > 0) {
         return client.cleanup_cache(config.dry_run);
     } else if (bench_cmd->count() > 0) {
+        if (!config.bench.load_scenario.empty()) {
+            lemon_cli::BenchLoadConfig load_config;
+            load_config.scenario_file = config.bench.load_scenario;
+            load_config.json_output = config.bench.json_output;
+            load_config.output_file = config.output_file;
+            load_config.timeout_ms = config.bench.timeout * 1000;
+            return lemon_cli::handle_bench_load_command(client, load_config);
+        }
         auto bench_config = lemon_cli::build_bench_config(config.output_file, config.bench);
         return lemon_cli::handle_bench_command(client, bench_config);
     } else {
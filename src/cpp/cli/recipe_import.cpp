@@ -6,13 +6,16 @@
 #include "lemon/utils/path_utils.h"
 
 #include <algorithm>
+#include <atomic>
 #include <chrono>
 #include <filesystem>
 #include <fstream>
 #include <iostream>
 #include <map>
+#include <mutex>
 #include <random>
 #include <sstream>
+#include <thread>
 #include <vector>
 
 namespace lemon_cli {
@@ -350,6 +353,121 @@ int import_model_from_json_file(lemonade::LemonadeClient& client,
     return client.pull_model(model_data);
 }
 
+int import_models_from_directory(lemonade::LemonadeClient& client,
+                                 const std::string& dir_path,
+                                 int jobs) {
+    std::vector<std::filesystem::path> files;
+    std::error_code ec;
+    for (const auto& entry : std::filesystem::directory_iterator(
+             lemon::utils::path_from_utf8(dir_path), ec)) {
+        if (entry.is_regular_file() && entry.path().extension() == ".json") {
+            files.push_back(entry.path());
+        }
+    }
+    if (ec) {
+        std::cerr << "Error: Failed to read directory '" << dir_path << "': "
+                  << ec.message() << std::endl;
+        return 1;
+    }
+    if (files.empty()) {
+        std::cerr << "Error: No .json files found in '" << dir_path << "'" << std::endl;
+        return 1;
+    }
+    std::sort(files.begin(), files.end());
+
+    if (jobs <= 0) {
+        unsigned int hw = std::thread::hardware_concurrency();
+        jobs = hw == 0 ? 4 : static_cast<int>(hw);
+    }
+    jobs = static_cast<int>((std::min)(static_cast<size_t>(jobs), files.size()));
+
+    std::cout << "Importing " << files.size() << " model files with " << jobs
+              << (jobs == 1 ? " worker" : " workers") << std::endl;
+
+    std::atomic<size_t> next_file{0};
+    std::atomic<int> imported{0};
+    std::atomic<int> failed{0};
+    std::mutex io_mutex;
+
+    auto worker = [&]() {
+        for (;;) {
+            const size_t index = next_file.fetch_add(1);
+            if (index >= files.size()) {
+                return;
+            }
+            const std::filesystem::path& file = files[index];
+            const std::string file_name = lemon::utils::path_to_utf8(file.filename());
+
+            nlohmann::json model_data;
+            bool valid = false;
+            {
+                // Serialized so validation errors land next to their file name;
+                // the expensive part — the registration round trip — runs in
+                // parallel below.
+                std::lock_guard<std::mutex> lock(io_mutex);
+                std::ifstream in(file);
+                if (!in.good()) {
+                    std::cerr << "Error: Failed to open '" << file_name << "'" << std::endl;
+                } else {
+                    try {
+                        model_data = nlohmann::json::parse(in);
+                        valid = validate_and_transform_model_json(model_data);
+                    } catch (const nlohmann::json::exception& e) {
+                        std::cerr << "Error: Failed to parse '" << file_name << "': "
+                                  << e.what() << std::endl;
+                    }
+                }
+            }
+            if (!valid) {
+                failed.fetch_add(1);
+                continue;
+            }
+
+            const std::string model_name = model_data["model_name"].get<std::string>();
+            if (!model_data.contains("do_not_upgrade")) {
+                model_data["do_not_upgrade"] = true;
+            }
+
+            try {
+                // Synchronous /pull blocks for the duration of any download the
+                // registration still needs, hence the day-long read timeout.
+                client.make_request("/api/v1/pull", "POST", model_data.dump(),
+                                    "application/json", 30000, 86400000);
+                imported.fetch_add(1);
+                std::lock_guard<std::mutex> lock(io_mutex);
+                std::cout << "Imported " << model_name << " (" << file_name << ")"
+                          << std::endl;
+            } catch (const lemonade::HttpError& e) {
+                failed.fetch_add(1);
+                std::lock_guard<std::mutex> lock(io_mutex);
+                std::cerr << "Error: Import of '" << file_name << "' failed: "
+                          << lemonade::extract_server_error_message(e) << std::endl;
+            } catch (const std::exception& e) {
+                failed.fetch_add(1);
+                std::lock_guard<std::mutex> lock(io_mutex);
+                std::cerr << "Error: Import of '" << file_name << "' failed: "
+                          << e.what() << std::endl;
+            }
+        }
+    };
+
+    std::vector<std::thread> workers;
+    workers.reserve(static_cast<size_t>(jobs));
+    for (int i = 0; i < jobs; ++i) {
+        workers.emplace_back(worker);
+    }
+    for (auto& t : workers) {
+        t.join();
+    }
+
+    std::cout << "Imported " << imported.load() << " of " << files.size() << " models";
+    if (failed.load() > 0) {
+        std::cout << " (" << failed.load() << " failed)";
+    }
+    std::cout << std::endl;
+    return failed.load() > 0 ? 1 : 0;
+}
+
 bool list_remote_recipe_files(const std::string& repo_dir,
                               std::vector<std::string>& recipe_files_out,
                               std::string& error_out) {
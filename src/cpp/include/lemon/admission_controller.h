@@ -0,0 +1,89 @@
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <string>
+#include <utility>
+
+namespace lemon {
+
+enum class RequestPriority { Interactive, Batch };
+
+const char* request_priority_name(RequestPriority priority);
+
+/**
+ * Per-model admission gate with two priority classes. Interactive requests
+ * are admitted immediately; batch requests wait until the model has no
+ * interactive request in flight, so a background summarization job queues
+ * behind chat traffic instead of competing with it for backend slots. A
+ * batch request that waits out max_wait is admitted anyway (counted as
+ * forced) so batch work degrades to FIFO under sustained interactive load
+ * rather than starving forever.
+ */
+class AdmissionController {
+public:
+    class Ticket {
+    public:
+        Ticket() = default;
+        Ticket(const Ticket&) = delete;
+        Ticket& operator=(const Ticket&) = delete;
+        Ticket(Ticket&& other) noexcept { *this = std::move(other); }
+        Ticket& operator=(Ticket&& other) noexcept {
+            if (this != &other) {
+                release();
+                controller_ = other.controller_;
+                model_ = std::move(other.model_);
+                priority_ = other.priority_;
+                other.controller_ = nullptr;
+            }
+            return *this;
+        }
+        ~Ticket() { release(); }
+
+        void release();
+
+    private:
+        friend class AdmissionController;
+        Ticket(AdmissionController* controller, std::string model, RequestPriority priority)
+            : controller_(controller), model_(std::move(model)), priority_(priority) {}
+
+        AdmissionController* controller_ = nullptr;
+        std::string model_;
+        RequestPriority priority_ = RequestPriority::Interactive;
+    };
+
+    struct ClassStats {
+        uint64_t admitted = 0;
+        uint64_t waited = 0;  // admissions that had to wait for the gate
+        uint64_t forced = 0;  // batch admissions that waited out max_wait
+        int active = 0;
+        int waiting = 0;
+    };
+
+    Ticket admit(const std::string& model, RequestPriority priority,
+                 std::chrono::milliseconds max_wait = std::chrono::seconds(120));
+
+    ClassStats stats(RequestPriority priority) const;
+
+    static AdmissionController& instance();
+
+private:
+    struct ModelState {
+        int active_interactive = 0;
+        int active_batch = 0;
+        int waiting_batch = 0;
+    };
+
+    void release(const std::string& model, RequestPriority priority);
+    void erase_if_idle_locked(const std::string& model);
+
+    mutable std::mutex mutex_;
+    std::condition_variable cv_;
+    std::map<std::string, ModelState> models_;
+    ClassStats class_stats_[2];
+};
+
+}  // namespace lemon
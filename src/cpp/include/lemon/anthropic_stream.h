@@ -0,0 +1,65 @@
+#pragma once
+
+#include "json_repair.h"
+
+#include <cstddef>
+#include <nlohmann/json.hpp>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace lemon {
+namespace anthropic {
+
+using json = nlohmann::json;
+
+std::string generate_message_id();
+std::string map_finish_reason_to_stop_reason(const json& choice);
+std::string format_sse_event(const std::string& event, const json& data);
+
+// Incremental OpenAI SSE -> Anthropic SSE translation for /v1/messages.
+//
+// feed() consumes raw backend SSE bytes as they arrive and returns the
+// Anthropic events they map to, so text and tool-call arguments reach the
+// client chunk by chunk (input_json_delta carries partial tool arguments).
+// Only the current partial SSE line and per-block bookkeeping are retained
+// between calls; the message itself is never buffered. Content block indices
+// are assigned in order of first appearance, so a tool-only response puts its
+// first tool_use block at index 0 instead of reserving it for absent text.
+//
+// Tool-argument deltas stream through a structural JSON validator; when the
+// model stops mid-arguments, finish() emits one last input_json_delta with
+// the closers that balance the JSON so clients assemble a parseable input
+// instead of paying a full regeneration to repair it.
+class StreamTranslator {
+public:
+    explicit StreamTranslator(std::string model);
+
+    std::string feed(const char* data, size_t len);
+    std::string finish(const std::vector<std::string>& warnings);
+
+private:
+    std::string translate_chunk(json openai_chunk);
+
+    struct ToolBlock {
+        int index = -1;
+        bool started = false;
+        std::string id;
+        std::string name;
+        StreamingJsonValidator args_validator;
+    };
+
+    std::string model_;
+    std::string message_id_;
+    std::string sse_buffer_;
+    bool sent_message_start_ = false;
+    int text_index_ = -1;
+    int next_index_ = 0;
+    std::unordered_map<int, ToolBlock> tool_blocks_;
+    std::string stop_reason_ = "end_turn";
+    int input_tokens_ = 0;
+    int output_tokens_ = 0;
+};
+
+} // namespace anthropic
+} // namespace lemon
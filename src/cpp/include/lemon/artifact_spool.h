@@ -0,0 +1,67 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace lemon {
+
+// Bounded store for the large base64 media payloads produced during one
+// orchestrator turn. Payloads count against a fixed in-memory budget; once
+// the budget is exceeded the oldest resident payloads are spilled to a
+// per-spool temp file and read back only on demand, so a turn that produces
+// many images/audio clips holds at most budget_bytes of media at a time.
+// Not thread-safe; one spool serves one request.
+class ArtifactSpool {
+public:
+    struct Item {
+        std::string type;  // "image" | "audio"
+        std::string data;  // base64 payload
+        std::string mime;  // e.g. "image/png", "audio/mpeg"
+    };
+
+    explicit ArtifactSpool(size_t budget_bytes);
+    ~ArtifactSpool();
+    ArtifactSpool(const ArtifactSpool&) = delete;
+    ArtifactSpool& operator=(const ArtifactSpool&) = delete;
+
+    size_t add(Item item);
+    // Overwrites the entry in place. A previously spilled payload leaves dead
+    // bytes in the spill file; acceptable for a single turn's lifetime.
+    void replace(size_t index, Item item);
+
+    size_t size() const { return entries_.size(); }
+    bool empty() const { return entries_.empty(); }
+    const std::string& type(size_t index) const { return entries_[index].type; }
+    const std::string& mime(size_t index) const { return entries_[index].mime; }
+    // Index of the most recent image entry, or -1.
+    int last_image_index() const;
+
+    // Returns the full item, reading the payload back from the spill file
+    // when it is no longer resident.
+    Item get(size_t index) const;
+
+    size_t resident_bytes() const { return resident_bytes_; }
+    size_t spilled_bytes() const { return spilled_bytes_; }
+
+private:
+    struct Entry {
+        std::string type;
+        std::string mime;
+        std::string data;
+        bool spilled = false;
+        size_t offset = 0;
+        size_t length = 0;
+    };
+
+    void enforce_budget();
+    bool spill(Entry& entry);
+
+    std::vector<Entry> entries_;
+    size_t budget_bytes_;
+    size_t resident_bytes_ = 0;
+    size_t spilled_bytes_ = 0;
+    std::string spill_path_;
+};
+
+} // namespace lemon
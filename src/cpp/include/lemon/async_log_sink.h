@@ -0,0 +1,65 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "utils/aixlog.hpp"
+#include <nlohmann/json.hpp>
+
+namespace lemon {
+
+// Moves log writing off the calling thread: log() only copies the record into
+// a bounded queue, and a single writer thread dispatches to the wrapped sinks.
+// When the queue is full the line is dropped and counted; the writer emits one
+// synthesized warning per overflow episode so drops are visible in the logs
+// they fell out of.
+class AsyncLogSink : public AixLog::Sink {
+public:
+    AsyncLogSink(const AixLog::Filter& filter,
+                 std::vector<std::shared_ptr<AixLog::Sink>> downstream);
+    ~AsyncLogSink() override;
+
+    void log(const AixLog::Metadata& metadata, const std::string& message) override;
+
+    static constexpr size_t kMaxQueuedRecords = 8192;
+
+private:
+    struct Record {
+        AixLog::Metadata metadata;
+        std::string message;
+    };
+
+    void writer_loop();
+    void dispatch(const std::deque<Record>& records);
+
+    std::vector<std::shared_ptr<AixLog::Sink>> downstream_;
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    std::thread writer_;
+    std::deque<Record> queue_;
+    uint64_t dropped_ = 0;
+    uint64_t dropped_reported_ = 0;
+    bool shutdown_ = false;
+};
+
+// One JSON object per line with the same field names as the /logs/stream
+// records, so structured consumers never parse the formatted text.
+class JsonLinesSink : public AixLog::Sink {
+public:
+    JsonLinesSink(const AixLog::Filter& filter, const std::string& filename);
+
+    void log(const AixLog::Metadata& metadata, const std::string& message) override;
+
+private:
+    std::ofstream file_;
+};
+
+uint64_t async_log_dropped_lines();
+
+} // namespace lemon
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace lemon {
+namespace audio {
+
+/**
+ * Streaming polyphase sample-rate converter for PCM16 mono audio.
+ *
+ * The conversion ratio is reduced to a rational L/M and realized as a bank
+ * of L windowed-sinc FIR phases, so each output sample is a single short
+ * dot product against the input — no zero-stuffed intermediate signal. The
+ * dot product uses the same SSE2/NEON kernels as the VAD energy path.
+ *
+ * process() is streaming: filter history carries across calls, so feeding
+ * audio chunk by chunk produces bit-identical output to one large call.
+ * Scratch buffers are members and are reused, so steady-state operation
+ * allocates nothing.
+ */
+class Resampler {
+public:
+    static constexpr int DEFAULT_TAPS_PER_PHASE = 32;
+
+    Resampler(int input_rate, int output_rate,
+              int taps_per_phase = DEFAULT_TAPS_PER_PHASE);
+
+    /**
+     * Convert input samples, appending the produced samples to `out`
+     * (existing contents are replaced). Returns the number of samples
+     * produced. When input and output rates match this is a plain copy.
+     */
+    size_t process(const int16_t* input, size_t count, std::vector<int16_t>& out);
+
+    /** Drop filter history so the next call starts a fresh stream. */
+    void reset();
+
+    int input_rate() const { return input_rate_; }
+    int output_rate() const { return output_rate_; }
+    bool is_passthrough() const { return up_factor_ == 1 && down_factor_ == 1; }
+
+    static float dot(const float* a, const float* b, size_t count);
+    static float dot_scalar(const float* a, const float* b, size_t count);
+
+private:
+    void build_filter_bank();
+
+    int input_rate_;
+    int output_rate_;
+    int up_factor_;
+    int down_factor_;
+    int taps_per_phase_;
+
+    // phase_taps_[p * taps_per_phase_ + k], stored time-reversed per phase
+    // so each output is a forward dot product over the extended input
+    std::vector<float> phase_taps_;
+
+    std::vector<float> extended_;  // taps-1 history samples + current chunk
+    uint64_t consumed_ = 0;        // input samples consumed across calls
+    uint64_t next_output_ = 0;     // output sample counter across calls
+};
+
+}  // namespace audio
+}  // namespace lemon
@@ -4,6 +4,8 @@
 #include <cmath>
 #include <cstdint>
 #include <iomanip>
+#include <lemon/calibration_store.h>
+#include <lemon/kv_budget.h>
 #include <lemon/model_manager.h>
 #include <lemon/system_info.h>
 #include <lemon/system_metrics_platform.h>
@@ -205,13 +207,27 @@ inline int64_t compute_auto_context_size(const ModelInfo& model_info,
     double kv_bytes_per_token = 0;
     double kv_cache_scale = 1.0;
     bool estimated = false;
+    bool measured = false;
+    double measured_base_gb = 0.0;
+
+    // A curve measured on this machine beats any metadata-derived estimate
+    if (CalibrationStore* cal = CalibrationStore::global()) {
+        if (auto curve = cal->lookup(model_info.model_name);
+            curve && curve->kv_bytes_per_token > 0) {
+            kv_bytes_per_token = curve->kv_bytes_per_token;
+            measured_base_gb = curve->base_gb;
+            measured = true;
+        }
+    }
 
     // Try exact GGUF metadata first
     int64_t block_count = model_info.gguf.block_count;
     int64_t head_count_kv = model_info.gguf.head_count_kv;
     int64_t key_length = model_info.gguf.key_length;
 
-    if (block_count > 0 && head_count_kv > 0 && key_length > 0) {
+    if (measured) {
+        // keep the measured curve
+    } else if (block_count > 0 && head_count_kv > 0 && key_length > 0) {
         kv_bytes_per_token = compute_weighted_kv_cache_bytes_per_token(
             model_info.gguf, &kv_cache_scale);
         if (kv_cache_scale < 1.0) {
@@ -248,8 +264,11 @@ inline int64_t compute_auto_context_size(const ModelInfo& model_info,
     }
 
     // Available memory for KV cache = total - used - model weights
-    // (used is already subtracted in get_available_memory_gb)
-    double model_weight_gb = (std::max)(0.0, model_info.size);
+    // (used is already subtracted in get_available_memory_gb). A measured
+    // base includes runtime overhead the checkpoint size misses.
+    double model_weight_gb = measured_base_gb > 0
+                                 ? measured_base_gb
+                                 : (std::max)(0.0, model_info.size);
     double available_for_kv_gb = available_memory_gb - model_weight_gb;
 
     if (available_for_kv_gb <= 0) {
@@ -292,7 +311,7 @@ inline int64_t compute_auto_context_size(const ModelInfo& model_info,
                            << ", scale=" << std::fixed << std::setprecision(2) << kv_cache_scale
                            << " | kv_cache=" << std::fixed << std::setprecision(2)
                            << (kv_bytes_per_token / (1024.0 * 1024.0)) << " MB/token"
-                           << (estimated ? " (est)" : "")
+                           << (measured ? " (measured)" : estimated ? " (est)" : "")
                            << " | memory: " << available_memory_gb << " GB avail, "
                            << model_weight_gb << " GB weights → " << available_for_kv_gb << " GB for KV"
                            << " | ctx=" << max_ctx_from_memory << " → " << ctx_size
@@ -304,8 +323,13 @@ inline int64_t compute_auto_context_size(const ModelInfo& model_info,
 /// Returns the resolved context size, or -2 if no auto-resolution is needed
 /// (i.e. ctx_size was already set to an explicit non-negative value).
 /// The caller should check the return value and update RecipeOptions accordingly.
+///
+/// `future_slots` is the number of co-resident models the caller plans to
+/// admit after this one (see plan_kv_budget_gb); 0 budgets against all free
+/// memory, matching the single-model behavior.
 inline int64_t resolve_auto_ctx_size(const RecipeOptions& effective_options,
-                                      const ModelInfo& model_info) {
+                                      const ModelInfo& model_info,
+                                      int future_slots = 0) {
     json ctx_json = effective_options.get_option("ctx_size");
     int64_t ctx_size = ctx_json.is_number() ? ctx_json.get<int64_t>() : -1;
 
@@ -323,10 +347,49 @@ inline int64_t resolve_auto_ctx_size(const RecipeOptions& effective_options,
         return fallback;
     }
 
-    int64_t result = compute_auto_context_size(model_info, available_gb, is_embedding);
+    double budget_gb = plan_kv_budget_gb(available_gb, future_slots);
+    if (budget_gb < available_gb) {
+        LOG(DEBUG, "AutoTune") << "resolve_auto_ctx_size: " << model_info.model_name
+                               << " — reserving " << std::fixed << std::setprecision(2)
+                               << (available_gb - budget_gb) << " GB for "
+                               << future_slots << " future co-resident slot(s), budget="
+                               << budget_gb << " GB";
+    }
+
+    int64_t result = compute_auto_context_size(model_info, budget_gb, is_embedding);
     LOG(DEBUG, "AutoTune") << "resolve_auto_ctx_size: " << model_info.model_name
                            << " → ctx_size=" << result;
     return result;
 }
 
+/// Predicted resident footprint (GB) of a load about to launch: model weights
+/// plus the KV cache implied by the effective ctx_size.
+inline double predict_model_footprint_gb(const ModelInfo& model_info,
+                                         const RecipeOptions& effective_options) {
+    double kv_bytes_per_token = 0.0;
+    double base_gb = (std::max)(0.0, model_info.size);
+    if (CalibrationStore* cal = CalibrationStore::global()) {
+        if (auto curve = cal->lookup(model_info.model_name);
+            curve && curve->kv_bytes_per_token > 0) {
+            kv_bytes_per_token = curve->kv_bytes_per_token;
+            if (curve->base_gb > 0) base_gb = curve->base_gb;
+        }
+    }
+    if (kv_bytes_per_token <= 0) {
+        kv_bytes_per_token = compute_weighted_kv_cache_bytes_per_token(model_info.gguf);
+    }
+    if (kv_bytes_per_token <= 0) {
+        kv_bytes_per_token = estimate_kv_bytes_per_token_from_model_size(model_info.size);
+    }
+
+    json ctx_json = effective_options.get_option("ctx_size");
+    int64_t ctx_size = ctx_json.is_number() ? ctx_json.get<int64_t>() : -1;
+    if (ctx_size <= 0) {
+        ctx_size = AUTO_CTX_FALLBACK;
+    }
+
+    double kv_gb = (kv_bytes_per_token * static_cast<double>(ctx_size)) / BYTES_PER_GIB;
+    return base_gb + kv_gb;
+}
+
 } // namespace lemon
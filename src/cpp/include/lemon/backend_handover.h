@@ -0,0 +1,39 @@
+#pragma once
+
+#include <optional>
+#include <string>
+#include <vector>
+
+#include <nlohmann/json.hpp>
+
+namespace lemon {
+
+using json = nlohmann::json;
+
+// One running backend subprocess handed from an exiting lemond to its
+// replacement during a binary upgrade. Enough to rebuild the WrappedServer
+// wrapper and re-attach: the subprocess itself keeps the loaded model.
+struct HandoverRecord {
+    std::string model_name;
+    std::string checkpoint;
+    std::string recipe;
+    int port = 0;
+    int pid = 0;
+    json options = json::object();
+
+    json to_json() const;
+    static std::optional<HandoverRecord> from_json(const json& j);
+};
+
+// Persists handover records in the cache directory between the old process
+// exiting and the new one starting. take() deletes the file after reading so
+// a stale file can never be adopted twice.
+class BackendHandover {
+public:
+    static std::string state_path(const std::string& cache_dir);
+    static bool save(const std::string& cache_dir,
+                     const std::vector<HandoverRecord>& records);
+    static std::vector<HandoverRecord> take(const std::string& cache_dir);
+};
+
+} // namespace lemon
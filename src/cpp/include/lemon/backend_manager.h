@@ -62,6 +62,23 @@ public:
     std::string get_or_resolve_latest_tag(const std::string& recipe,
                                           const std::string& backend);
 
+    struct UpgradeRefreshReport {
+        int staged = 0;
+        int promoted = 0;
+    };
+
+    // One pass of zero-downtime backend upgrades. Promotes any staged upgrade
+    // whose recipe `recipe_is_idle` (atomic directory swap; the next subprocess
+    // launch picks it up), and with allow_fetch additionally stages the pinned
+    // version for every installed backend whose pin moved ahead of the
+    // installed binary — download and extraction happen while the current
+    // binary keeps serving. Concurrent passes coalesce into one.
+    // rocm-stable backends are skipped: their version is coupled to the shared
+    // TheRock runtime, which only the full install path upgrades.
+    UpgradeRefreshReport refresh_staged_upgrades(
+        const std::function<bool(const std::string& recipe)>& recipe_is_idle,
+        bool allow_fetch);
+
     /// Set/get the global BackendManager instance. Mirrors RuntimeConfig::global()
     /// so non-Server contexts (status helpers in system_info.cpp) can reach it.
     /// Set once from Server's constructor; null until then.
@@ -78,6 +95,12 @@ private:
     std::unordered_map<std::string, std::string> latest_version_cache_;
     std::mutex latest_version_cache_mutex_;
 
+    // Serializes shared runtime installs (TheRock SDK) so concurrent backend
+    // installs that need the same runtime don't race the same install dir.
+    std::mutex runtime_install_mutex_;
+
+    std::mutex upgrade_refresh_mutex_;
+
     // Get version for a recipe/backend from the cached config
     std::string get_version_from_config(const std::string& recipe, const std::string& backend);
 
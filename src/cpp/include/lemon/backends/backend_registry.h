@@ -5,6 +5,7 @@
 #include "lemon/backends/backend_descriptor.h"
 #include "lemon/backends/backend_descriptor_registry.h"
 #include "lemon/backends/backend_ops.h"
+#include "lemon/server_capabilities.h"
 
 namespace lemon {
 
@@ -29,11 +30,23 @@ struct BackendContext {
 
 using BackendCreateFn = std::unique_ptr<WrappedServer> (*)(const BackendContext&);
 
+// Stamp the class's precomputed capability bitmask onto a freshly
+// constructed instance so capability checks are a bit test instead of a
+// dynamic_cast. Every create() must route its instance through here.
+template <typename T>
+std::unique_ptr<WrappedServer> with_capability_mask(std::unique_ptr<T> server) {
+    static_assert(capability_mask_matches_inheritance<T>(),
+                  "capability mask out of sync with the inheritance graph");
+    server->set_capability_mask(capability_mask_of<T>());
+    return server;
+}
+
 // Convenience for the common create(): construct a server class from the
 // standard (log_level, model_manager, backend_manager) context fields.
 template <typename T>
 std::unique_ptr<WrappedServer> make_server(const BackendContext& ctx) {
-    return std::make_unique<T>(ctx.log_level, ctx.model_manager, ctx.backend_manager);
+    return with_capability_mask(std::make_unique<T>(
+        ctx.log_level, ctx.model_manager, ctx.backend_manager));
 }
 
 // Construct-on-first-use singleton for a stateless ops class, giving the
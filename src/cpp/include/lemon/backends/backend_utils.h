@@ -96,13 +96,32 @@ namespace lemon::backends {
         static bool extract_archive(const std::string& archive_path, const std::string& dest_dir, const std::string& backend_name);
 
         /** Download and install the specified version of the backend from github.
-         *  If progress_cb is provided, it receives download progress events instead of console output. */
+         *  If progress_cb is provided, it receives download progress events instead of console output.
+         *  With stage_only, the version is downloaded and extracted into the
+         *  staged-upgrade directory next to the install but the currently
+         *  installed binary is left serving; promote_staged_upgrade() performs
+         *  the swap later. The normal install path promotes a matching staged
+         *  upgrade instead of re-downloading. */
         static void install_from_github(const BackendSpec& spec,
                                         const std::string& expected_version,
                                         const std::string& repo,
                                         const std::string& filename,
                                         const std::string& backend,
-                                        DownloadProgressCallback progress_cb = nullptr);
+                                        DownloadProgressCallback progress_cb = nullptr,
+                                        bool stage_only = false);
+
+        /** Directory where a prefetched upgrade waits for promotion (a sibling
+         *  of install_dir so the promotion rename stays on one filesystem). */
+        static std::string get_staged_upgrade_dir(const std::string& install_dir);
+
+        /** Version staged for promotion next to install_dir, or "" when none. */
+        static std::string get_staged_upgrade_version(const std::string& install_dir);
+
+        /** Atomically swap a staged upgrade into install_dir (see
+         *  commit_staged_install for the crash-safety contract). Returns the
+         *  promoted executable path, or "" when nothing valid was staged. */
+        static std::string promote_staged_upgrade(const std::string& install_dir,
+                                                  const std::string& binary_name);
 
         /** Get the latest version number for the given recipe/backend */
         static std::string get_backend_version(const std::string& recipe, const std::string& backend);
@@ -165,6 +184,14 @@ namespace lemon::backends {
         /** Find the executable in the installation directory. Generally only used internally by BackendUtils */
         static std::string find_executable_in_install_dir(const std::string& install_dir, const std::string& binary_name);
 
+        /**
+         * Re-stat the executable manifest on a detached background thread and
+         * prune entries that no longer match disk. Lookups validate per-entry
+         * anyway; this keeps the manifest from accumulating dead entries
+         * without paying the install-tree walks on the startup path.
+         */
+        static void verify_exe_manifest_async();
+
         /** Checks the environment for a variable following the scheme LEMONADE_BACKEND_VARIANT_BIN and return its value, if available. Generally only used internally by BackendUtils */
         static std::string find_external_backend_binary(const std::string& recipe, const std::string& backend);
 
@@ -18,7 +18,12 @@ inline const BackendDescriptor descriptor = {
     /*selectable_backend*/ false,
     /*uses_ctx_size*/   false,
     /*dynamic_models*/  true,   // models discovered at runtime from the provider
-    /*options*/ {},
+    /*options*/ {
+        {"cloud_hedge_model", "", "", "MODEL",
+         "Local model raced against the provider when no token arrives within the hedge window", "Cloud Options"},
+        {"cloud_hedge_after_ms", "", 0, "SIZE",
+         "Milliseconds without a provider token before the local hedge starts (0 disables hedging)", "Cloud Options"},
+    },
     /*support*/ {},             // no local gating: install/support machinery skips cloud
     /*default_labels*/  {},
     /*required_checkpoints*/ {},  // no downloaded files
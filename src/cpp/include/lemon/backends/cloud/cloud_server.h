@@ -98,6 +98,12 @@ private:
     struct ResolvedCreds {
         std::string api_key;
         std::string base_url;
+        // Every usable endpoint for the provider (primary + fallbacks),
+        // ordered best-first by CloudEndpointTracker; base_url is the front.
+        // Plaintext http:// endpoints without the opt-in are filtered out —
+        // insecure_http_blocked is set only when that leaves none.
+        std::vector<std::string> base_urls;
+        bool allow_insecure_http = false;
         bool insecure_http_blocked = false;
         utils::HttpSecurityPolicy policy =
             utils::HttpSecurityPolicy::ExternalHttpsOnly;
@@ -0,0 +1,174 @@
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <mutex>
+#include <nlohmann/json.hpp>
+#include <string>
+#include <unordered_map>
+
+// Header-only, dependency-light like install_staging.h, so the staleness
+// invariant can be unit-tested in isolation (test/cpp/test_exe_manifest.cpp).
+namespace lemon::backends {
+
+    /**
+     * Persistent manifest of resolved backend executable paths.
+     *
+     * find_executable_in_dir() walks a backend's whole install tree
+     * (thousands of files for ROCm builds) and runs once per backend per
+     * status refresh, which dominates cold start with several backends
+     * installed. Each manifest entry records the size and mtime observed when
+     * the executable was resolved; a lookup trusts the entry only while the
+     * file on disk still matches them, so a swapped, upgraded, or removed
+     * install falls back to the full walk instead of resolving stale state.
+     */
+    class ExeManifest {
+    public:
+        explicit ExeManifest(const std::string& manifest_path)
+            : manifest_path_(manifest_path) {
+            load();
+        }
+
+        // Returns the recorded executable path if the file still matches the
+        // recorded size and mtime, otherwise "" (caller re-walks and records).
+        std::string lookup(const std::string& install_dir,
+                           const std::string& binary_name) {
+            std::lock_guard<std::mutex> lock(mutex_);
+            auto it = entries_.find(key(install_dir, binary_name));
+            if (it == entries_.end()) {
+                return "";
+            }
+            if (!entry_matches_disk(it->second)) {
+                entries_.erase(it);
+                save_locked();
+                return "";
+            }
+            return it->second.path;
+        }
+
+        void record(const std::string& install_dir,
+                    const std::string& binary_name,
+                    const std::string& exe_path) {
+            Entry entry;
+            entry.path = exe_path;
+            if (!stat_file(exe_path, entry.size, entry.mtime)) {
+                return;
+            }
+            std::lock_guard<std::mutex> lock(mutex_);
+            entries_[key(install_dir, binary_name)] = std::move(entry);
+            save_locked();
+        }
+
+        void erase(const std::string& install_dir,
+                   const std::string& binary_name) {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (entries_.erase(key(install_dir, binary_name)) > 0) {
+                save_locked();
+            }
+        }
+
+        // Re-stats every entry and drops the ones that no longer match disk.
+        // Lookups already guard per-entry, so this exists to keep the manifest
+        // from accumulating dead entries; returns how many were pruned.
+        size_t verify_all() {
+            std::lock_guard<std::mutex> lock(mutex_);
+            size_t pruned = 0;
+            for (auto it = entries_.begin(); it != entries_.end();) {
+                if (entry_matches_disk(it->second)) {
+                    ++it;
+                } else {
+                    it = entries_.erase(it);
+                    ++pruned;
+                }
+            }
+            if (pruned > 0) {
+                save_locked();
+            }
+            return pruned;
+        }
+
+        size_t size() {
+            std::lock_guard<std::mutex> lock(mutex_);
+            return entries_.size();
+        }
+
+    private:
+        struct Entry {
+            std::string path;
+            std::uint64_t size = 0;
+            std::int64_t mtime = 0;
+        };
+
+        static std::string key(const std::string& install_dir,
+                               const std::string& binary_name) {
+            return install_dir + "|" + binary_name;
+        }
+
+        static bool stat_file(const std::string& path, std::uint64_t& size,
+                              std::int64_t& mtime) {
+            namespace fs = std::filesystem;
+            std::error_code ec;
+            if (!fs::is_regular_file(path, ec)) {
+                return false;
+            }
+            size = fs::file_size(path, ec);
+            if (ec) {
+                return false;
+            }
+            const auto stamp = fs::last_write_time(path, ec);
+            if (ec) {
+                return false;
+            }
+            mtime = stamp.time_since_epoch().count();
+            return true;
+        }
+
+        static bool entry_matches_disk(const Entry& entry) {
+            std::uint64_t size = 0;
+            std::int64_t mtime = 0;
+            return stat_file(entry.path, size, mtime) && size == entry.size &&
+                   mtime == entry.mtime;
+        }
+
+        void load() {
+            std::ifstream file(manifest_path_);
+            if (!file.is_open()) {
+                return;
+            }
+            nlohmann::json doc = nlohmann::json::parse(file, nullptr, false);
+            if (!doc.is_object()) {
+                return;
+            }
+            for (const auto& [entry_key, value] : doc.items()) {
+                if (!value.is_object() || !value.contains("path") ||
+                    !value["path"].is_string()) {
+                    continue;
+                }
+                Entry entry;
+                entry.path = value["path"].get<std::string>();
+                entry.size = value.value("size", std::uint64_t{0});
+                entry.mtime = value.value("mtime", std::int64_t{0});
+                entries_.emplace(entry_key, std::move(entry));
+            }
+        }
+
+        void save_locked() {
+            nlohmann::json doc = nlohmann::json::object();
+            for (const auto& [entry_key, entry] : entries_) {
+                doc[entry_key] = {{"path", entry.path},
+                                  {"size", entry.size},
+                                  {"mtime", entry.mtime}};
+            }
+            std::ofstream file(manifest_path_);
+            if (file.is_open()) {
+                file << doc.dump();
+            }
+        }
+
+        std::string manifest_path_;
+        std::mutex mutex_;
+        std::unordered_map<std::string, Entry> entries_;
+    };
+
+}  // namespace lemon::backends
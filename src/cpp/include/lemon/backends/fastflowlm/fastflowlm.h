@@ -27,6 +27,10 @@ inline const BackendDescriptor descriptor = {
          "Safe flm serve tuning args: --pmode, --prefill-chunk-len, "
          "--img-pre-resize, --socket, --q-len, --preemption",
          "FastFlowLM Options"},
+        {"flm_pipeline_depth", "--flm-pipeline-depth", 2, "N",
+         "Requests kept in flight on the NPU across all FLM model types; raise "
+         "to hide client round-trip gaps on mixed workloads",
+         "FastFlowLM Options"},
     },
     /*support*/ {
         {"npu", {"windows", "linux"}, {{"amd_npu", {"XDNA2"}}}, "XDNA2 NPU"},
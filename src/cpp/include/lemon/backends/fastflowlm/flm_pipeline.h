@@ -0,0 +1,87 @@
+#pragma once
+
+#include "lemon/model_types.h"
+
+#include <array>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <set>
+
+namespace lemon {
+namespace backends {
+
+// Process-wide admission gate for flm-server requests. One NPU serves every
+// coexisting FLM type (LLM, embedding, reranking, ASR), so the gate is shared
+// across FastFlowLMServer instances: it keeps up to `depth` requests in flight
+// so the NPU is not left idle during client round-trip gaps, round-robins
+// admission across FLM types so a burst of one type cannot starve the others,
+// and bounds the per-type wait queue. Occupancy totals feed /metrics.
+class FlmPipeline {
+public:
+    static FlmPipeline& instance();
+
+    class Ticket {
+    public:
+        Ticket() = default;
+        Ticket(Ticket&& other) noexcept;
+        Ticket& operator=(Ticket&& other) noexcept;
+        Ticket(const Ticket&) = delete;
+        Ticket& operator=(const Ticket&) = delete;
+        ~Ticket();
+
+    private:
+        friend class FlmPipeline;
+        explicit Ticket(FlmPipeline* pipeline) : pipeline_(pipeline) {}
+        FlmPipeline* pipeline_ = nullptr;
+        std::chrono::steady_clock::time_point admitted_at_{};
+    };
+
+    // Blocks until a pipeline slot is free; admission is round-robin across
+    // types with waiters. Throws std::runtime_error when the type's wait queue
+    // is already at kMaxQueuedPerType.
+    Ticket acquire(ModelType type);
+
+    // Requests kept in flight across all FLM types (clamped to at least 1).
+    void set_depth(int depth);
+    int depth() const;
+
+    struct Stats {
+        std::uint64_t admitted = 0;
+        std::uint64_t rejected = 0;
+        std::uint64_t wait_ms_total = 0;
+        std::uint64_t busy_ms_total = 0;
+    };
+    Stats totals() const;
+
+    int in_flight() const;
+    int queued() const;
+
+    static constexpr int kDefaultDepth = 2;
+    static constexpr int kMaxQueuedPerType = 64;
+
+    FlmPipeline() = default;
+    FlmPipeline(const FlmPipeline&) = delete;
+    FlmPipeline& operator=(const FlmPipeline&) = delete;
+
+private:
+    void release(std::chrono::steady_clock::time_point admitted_at);
+    void pump_locked();
+
+    static constexpr int kTypeCount = static_cast<int>(ModelType::MESH) + 1;
+
+    mutable std::mutex mutex_;
+    std::condition_variable cv_;
+    std::array<std::deque<std::uint64_t>, kTypeCount> queues_;
+    std::set<std::uint64_t> granted_;
+    int depth_ = kDefaultDepth;
+    int in_flight_ = 0;
+    int rr_next_ = 0;
+    std::uint64_t next_id_ = 0;
+    Stats stats_;
+};
+
+}  // namespace backends
+}  // namespace lemon
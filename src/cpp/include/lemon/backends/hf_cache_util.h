@@ -1,6 +1,9 @@
 #pragma once
 
+#include <cstdint>
 #include <filesystem>
+#include <map>
+#include <mutex>
 #include <string>
 
 namespace lemon {
@@ -26,6 +29,43 @@ std::filesystem::path active_snapshot_path(const std::filesystem::path& model_ca
 std::string repo_id_to_cache_dir_name(const std::string& repo_id,
                                       const std::string& registry_source = "huggingface");
 
+// Persisted directory-size cache for snapshot trees. Full recursive walks of
+// a large (possibly NAS-backed) model cache are expensive, so sizes are keyed
+// by a cheap fingerprint - the path's own mtime plus name/mtime/size of its
+// top-level entries - and only trees whose fingerprint changed are rescanned.
+// The manifest survives restarts in the lemonade cache dir. A change buried
+// more than one level deep without touching any top-level mtime can go
+// unnoticed until the next download/delete; lemonade's own mutations always
+// bump a top-level entry.
+class ScanCache {
+public:
+    explicit ScanCache(const std::filesystem::path& manifest_path);
+
+    // Size in bytes of the file or directory tree at `path`, from the cache
+    // when the fingerprint still matches, from a recursive walk otherwise.
+    std::uint64_t tree_size_bytes(const std::filesystem::path& path);
+
+    void invalidate(const std::filesystem::path& path);
+
+    // Writes the manifest if anything changed, dropping entries whose path no
+    // longer exists.
+    void save();
+
+private:
+    struct Entry {
+        std::string fingerprint;
+        std::uint64_t bytes = 0;
+    };
+
+    void load_locked();
+
+    std::mutex mutex_;
+    std::filesystem::path manifest_path_;
+    std::map<std::string, Entry> entries_;
+    bool loaded_ = false;
+    bool dirty_ = false;
+};
+
 } // namespace hf_cache
 } // namespace backends
 } // namespace lemon
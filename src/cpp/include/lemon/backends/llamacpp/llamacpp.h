@@ -29,6 +29,12 @@ inline const BackendDescriptor descriptor = {
          "Comma-separated list of accelerator devices to use (e.g. Vulkan0)", "Llama.cpp Backend Options"},
         {"llamacpp_args", "--llamacpp-args", "", "ARGS",
          "Custom arguments to pass to llama-server", "Llama.cpp Backend Options"},
+        {"llamacpp_replicas", "--llamacpp-replicas", 1, "N",
+         "Number of identical llama-server replicas to launch and balance across", "Llama.cpp Backend Options"},
+        {"llamacpp_draft", "--llamacpp-draft", "", "PATH",
+         "Local draft-model GGUF to pair for speculative decoding", "Llama.cpp Backend Options"},
+        {"llamacpp_lora", "--llamacpp-lora", "", "PATHS",
+         "Comma-separated LoRA adapter GGUFs to load for runtime switching", "Llama.cpp Backend Options"},
     },
     /*support*/ {
         {"system", {"linux"}, {{"cpu", {"x86_64", "arm64"}}}, "x86_64/ARM64 CPU, GPU"},
@@ -4,12 +4,18 @@
 
 #include "lemon/wrapped_server.h"
 #include "lemon/backends/backend_utils.h"
+#include "lemon/slot_affinity.h"
+#include <atomic>
+#include <memory>
+#include <mutex>
 #include <string>
+#include <utility>
+#include <vector>
 
 namespace lemon {
 namespace backends {
 
-class LlamaCppServer : public WrappedServer, public IEmbeddingsServer, public IRerankingServer, public ISlotsServer, public ITokenizerServer {
+class LlamaCppServer : public WrappedServer, public IEmbeddingsServer, public IRerankingServer, public ISlotsServer, public ILoraAdapterServer, public ITokenizerServer {
 public:
     static InstallParams get_install_params(const std::string& backend, const std::string& version);
 
@@ -30,6 +36,11 @@ public:
     // Downsize the model on soft idle
     bool downsize() override;
 
+    // Hibernate on deep idle: stop llama-server (freeing GPU buffers) while the
+    // mmap'd weights stay warm in the OS page cache; resume relaunches in seconds.
+    bool hibernate() override;
+    void resume() override;
+
     // ICompletionServer implementation
     json chat_completion(const json& request) override;
     json completion(const json& request) override;
@@ -45,14 +56,89 @@ public:
     json get_slots() override;
     json slots_action(int slot_id, const std::string& action, const json& request_body) override;
 
+    // ILoraAdapterServer implementation
+    json get_lora_adapters() override;
+    json set_lora_adapters(const json& adapters) override;
+
     // ITokenizerServer implementation
     json tokenize(const json& request) override;
 
+    void forward_streaming_request(const std::string& endpoint,
+                                   const std::string& request_body,
+                                   httplib::DataSink& sink,
+                                   bool sse = true,
+                                   long timeout_seconds = 0,
+                                   TelemetryCallback telemetry_callback = nullptr) override;
+
+protected:
+    // Routes the current thread's forwarded requests to the replica selected
+    // by the active ReplicaLease; falls back to the primary instance.
+    std::string get_base_url() const override;
+
 private:
+    // One extra llama-server subprocess serving the same model as the primary.
+    // The primary keeps the base-class port/handle/watchdog machinery; replicas
+    // are owned here and health-checked at dispatch time.
+    struct Replica {
+        ProcessHandle handle{nullptr, 0};
+        int port = 0;
+        std::vector<std::string> args;
+        std::atomic<int> in_flight{0};
+        std::atomic<bool> restarting{false};
+        std::atomic<bool> retired{false};
+    };
+
+    // RAII dispatch token: checks out the least-loaded instance (primary or
+    // replica) for the enclosing request and releases it on scope exit.
+    class ReplicaLease {
+    public:
+        explicit ReplicaLease(LlamaCppServer& server);
+        ~ReplicaLease();
+        ReplicaLease(const ReplicaLease&) = delete;
+        ReplicaLease& operator=(const ReplicaLease&) = delete;
+
+    private:
+        LlamaCppServer& server_;
+        Replica* replica_;
+    };
+    friend class ReplicaLease;
+
+    void start_replicas(int replica_count);
+    void stop_replicas();
+    Replica* checkout_replica();
+    void checkin_replica(Replica* replica);
+    void restart_replica_async(std::shared_ptr<Replica> replica);
+    static bool wait_for_replica_ready(const ProcessHandle& handle, int port);
+
+    std::vector<std::shared_ptr<Replica>> replicas_;
+    // Shared so a detached replica-restart thread can keep it (and its own
+    // Replica) alive past unload() and server destruction.
+    std::shared_ptr<std::mutex> replicas_mutex_ = std::make_shared<std::mutex>();
+    Replica primary_slot_;
+    int replica_count_ = 1;
+
     // llama-server echoes the local .gguf path it was launched with (`-m <path>`)
     // in the OpenAI `model` field. Rewrite it to the client-facing model id so
     // responses don't leak absolute filesystem paths (and usernames).
     json normalize_response_model(json response, const json& request) const;
+
+    // Pins the request to the slot whose KV cache holds the longest matching
+    // prompt prefix (via llama-server's `id_slot` field). No-op when the
+    // server runs a single slot or the request already pins one.
+    json with_slot_affinity(json request);
+    static std::string prompt_signature(const json& request);
+
+    // Active only when `--parallel`/`-np` > 1 is passed via llamacpp_args.
+    std::unique_ptr<SlotAffinity> slot_affinity_;
+
+    // Launch parameters captured at load() time so resume() can relaunch the
+    // identical server without rerunning option resolution.
+    std::string launch_executable_;
+    std::vector<std::string> launch_args_;
+    std::string launch_working_dir_;
+    std::vector<std::pair<std::string, std::string>> launch_env_vars_;
+    bool launch_inherit_output_ = false;
+    int launch_port_ = 0;
 };
 
 namespace llamacpp {
@@ -21,6 +21,10 @@ inline const BackendDescriptor descriptor = {
     /*options*/ {
         {"moonshine_args", "--moonshine-args", "", "ARGS",
          "Custom arguments to pass to moonshine-server", "Moonshine Options"},
+        {"moonshine_sessions", "--moonshine-sessions", "", "COUNT",
+         "Parallel ONNX sessions for concurrent streaming transcription", "Moonshine Options"},
+        {"moonshine_cpu_set", "--moonshine-cpu-set", "", "CORES",
+         "CPU cores to pin moonshine-server to (e.g. 24-31 or 0,2,4)", "Moonshine Options"},
     },
     /*support*/ {
         {"cpu", {"windows"}, {{"cpu", {"x86_64"}}}, "x86_64/arm64 CPU"},
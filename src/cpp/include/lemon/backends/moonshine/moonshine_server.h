@@ -40,10 +40,12 @@ public:
     std::string get_streaming_address() override;
 
 private:
-    // Forward audio data directly (no file I/O) using multipart form-data
+    // Forward audio using multipart form-data: from memory (audio_data) or,
+    // when file_path is set, streamed from disk.
     json forward_multipart_audio_data(const std::string& audio_data,
                                       const std::string& filename,
-                                      const json& params);
+                                      const json& params,
+                                      const std::string& file_path = "");
 
     int tcp_port_ = 0;     // Port for line-delimited JSON streaming
 };
@@ -27,6 +27,8 @@ inline const BackendDescriptor descriptor = {
          "SD.cpp backend to use", "Stable Diffusion Options"},
         {"sdcpp_args", "--sdcpp-args", "", "ARGS",
          "Custom arguments to pass to sd-server (must not conflict with managed args)", "Stable Diffusion Options"},
+        {"sdcpp_stayalive", "--sdcpp-stayalive", "", "SECONDS",
+         "Seconds an evicted sd-server pipeline stays parked for instant checkpoint switches (default 300, 0 disables)", "Stable Diffusion Options"},
         // Image generation defaults (recipe-level only, not CLI flags).
         {"steps", "", 20, "SIZE", "Number of diffusion steps", "Stable Diffusion Options"},
         {"cfg_scale", "", 7.0, "SIZE", "Classifier-free guidance scale", "Stable Diffusion Options"},
@@ -10,6 +10,10 @@
 #include "lemon/backends/backend_utils.h"
 #include <string>
 #include <filesystem>
+#include <cstdint>
+#include <mutex>
+#include <utility>
+#include <vector>
 
 namespace lemon {
 namespace backends {
@@ -70,6 +74,26 @@ private:
     // OpenAI-style `size: "WxH"` field -- top-level width/height are ignored.
     // Returns "" if no size can be resolved.
     std::string resolve_size(const nlohmann::json& request) const;
+
+    // Base64-decode a source image, serving repeats from a small LRU keyed by
+    // a hash of the payload. Iterative edit/variation workflows resend the
+    // same multi-megabyte image dozens of times; the latents themselves never
+    // cross the subprocess boundary, so this decode is the repeated work the
+    // wrapper can actually skip.
+    std::string decoded_image(const std::string& b64);
+
+    static constexpr size_t DECODE_CACHE_ENTRIES = 4;
+    std::vector<std::pair<uint64_t, std::string>> decode_cache_;
+    std::mutex decode_cache_mutex_;
+
+    // Identity of the loaded pipeline for the stayalive slot: stat-based hashes
+    // of each component file (UNet, text encoder, VAE) plus backend and custom
+    // args. Only a fingerprint-identical parked process can be adopted; any
+    // component drift forces a cold start.
+    uint64_t pipeline_fingerprint_ = 0;
+    std::vector<uint64_t> component_hashes_;
+    int stayalive_seconds_ = 0;
+    bool parkable_ = false;
 };
 
 namespace sdcpp {
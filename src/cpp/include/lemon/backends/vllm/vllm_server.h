@@ -4,8 +4,10 @@
 
 #include "lemon/wrapped_server.h"
 #include "lemon/backends/backend_utils.h"
-#include <filesystem>
+#include <chrono>
 #include <cstdint>
+#include <filesystem>
+#include <mutex>
 #include <string>
 
 namespace lemon {
@@ -47,9 +49,15 @@ public:
     std::string get_additional_telemetry_url() const override;
     std::function<std::map<std::string, nlohmann::json>(const std::string&)> get_additional_telemetry_parser() const override;
 
+    json get_queue_stats() override;
+
 private:
     std::filesystem::path rocm_shim_dir_;
 
+    std::mutex queue_stats_mutex_;
+    json queue_stats_cache_;
+    std::chrono::steady_clock::time_point queue_stats_fetched_at_{};
+
     json prepare_openai_request(const json& request);
     json fit_openai_max_tokens_to_context(const json& request);
     int64_t count_openai_prompt_tokens(const json& request);
@@ -0,0 +1,92 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <httplib.h>
+
+namespace lemon {
+
+/// Fixed-size worker pool with a bounded accept queue, used in place of
+/// cpp-httplib's unbounded ThreadPool. Connections past the hard cap are
+/// rejected at enqueue (httplib closes the socket); the shared pending
+/// counter lets the server shed load with a proper 503 before that point.
+class BoundedTaskQueue : public httplib::TaskQueue {
+public:
+    BoundedTaskQueue(size_t thread_count, size_t max_queued,
+                     std::shared_ptr<std::atomic<size_t>> pending_counter)
+        : max_queued_(max_queued), pending_(std::move(pending_counter)) {
+        threads_.reserve(thread_count);
+        for (size_t i = 0; i < thread_count; i++) {
+            threads_.emplace_back([this] { worker_loop(); });
+        }
+    }
+
+    ~BoundedTaskQueue() override { shutdown(); }
+
+    bool enqueue(std::function<void()> fn) override {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (stopped_ || (max_queued_ > 0 && tasks_.size() >= max_queued_)) {
+                return false;
+            }
+            tasks_.push_back(std::move(fn));
+        }
+        if (pending_) {
+            pending_->fetch_add(1, std::memory_order_relaxed);
+        }
+        cond_.notify_one();
+        return true;
+    }
+
+    void shutdown() override {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (stopped_) {
+                return;
+            }
+            stopped_ = true;
+        }
+        cond_.notify_all();
+        for (auto& t : threads_) {
+            if (t.joinable()) {
+                t.join();
+            }
+        }
+    }
+
+private:
+    void worker_loop() {
+        for (;;) {
+            std::function<void()> task;
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                cond_.wait(lock, [this] { return stopped_ || !tasks_.empty(); });
+                if (stopped_ && tasks_.empty()) {
+                    return;
+                }
+                task = std::move(tasks_.front());
+                tasks_.pop_front();
+            }
+            if (pending_) {
+                pending_->fetch_sub(1, std::memory_order_relaxed);
+            }
+            task();
+        }
+    }
+
+    const size_t max_queued_;
+    std::shared_ptr<std::atomic<size_t>> pending_;
+    std::mutex mutex_;
+    std::condition_variable cond_;
+    std::deque<std::function<void()>> tasks_;
+    std::vector<std::thread> threads_;
+    bool stopped_ = false;
+};
+
+} // namespace lemon
@@ -0,0 +1,56 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+namespace lemon {
+
+// Process-wide pool of reusable byte buffers for transient response assembly
+// and streaming chunk staging. Buffers are bucketed by power-of-two capacity
+// (4 KiB..4 MiB) on thread-local free lists, so steady-state traffic reuses
+// warm allocations instead of hitting the allocator per chunk — over
+// multi-week uptimes that repeated large alloc/free churn fragments RSS.
+// Handles return their buffer to the pool on destruction.
+class BufferPool {
+public:
+    class Handle {
+    public:
+        Handle() = default;
+        ~Handle();
+        Handle(Handle&& other) noexcept;
+        Handle& operator=(Handle&& other) noexcept;
+        Handle(const Handle&) = delete;
+        Handle& operator=(const Handle&) = delete;
+
+        std::string& str() { return buffer_; }
+        const std::string& str() const { return buffer_; }
+
+        // Hands the buffer to the caller; it will not return to the pool.
+        std::string take();
+
+    private:
+        friend class BufferPool;
+        explicit Handle(std::string&& buffer) : buffer_(std::move(buffer)) {}
+
+        std::string buffer_;
+    };
+
+    // Returns an empty buffer with at least min_capacity reserved. Requests
+    // above the largest size class are plain allocations that never pool.
+    static Handle acquire(size_t min_capacity);
+
+    struct Totals {
+        uint64_t hits = 0;       // acquires served from a free list
+        uint64_t misses = 0;     // acquires that allocated fresh
+        uint64_t discarded = 0;  // returns dropped (full class or oversized)
+        uint64_t pooled_buffers = 0;
+        uint64_t pooled_bytes = 0;
+    };
+    static Totals totals();
+
+private:
+    friend class Handle;
+    static void release(std::string&& buffer);
+};
+
+} // namespace lemon
@@ -0,0 +1,80 @@
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <nlohmann/json.hpp>
+
+namespace lemon {
+
+/// Fitted memory/throughput curve measured on this machine for one model.
+/// kv_bytes_per_token is the slope of resident memory over configured
+/// context size; base_gb is the intercept (weights plus runtime overhead),
+/// so it can exceed the raw checkpoint size.
+struct CalibrationCurve {
+    double kv_bytes_per_token = 0.0;
+    double base_gb = 0.0;
+    double prefill_tps = 0.0;
+    double decode_tps = 0.0;
+    std::string measured_at;
+
+    nlohmann::json to_json() const;
+    static CalibrationCurve from_json(const nlohmann::json& j);
+};
+
+// Persisted measured curves keyed by (model, hardware fingerprint). GGUF-based
+// estimates in auto_tune.h can be off by 2x on some machines; when a measured
+// curve exists for the current hardware, auto-tune prefers it. Curves survive
+// restarts in the lemonade cache dir but are ignored on a different box
+// because the fingerprint no longer matches.
+class CalibrationStore {
+public:
+    /// Global instance set from Server's constructor; nullptr until then
+    /// (standalone tools and tests fall back to estimates). Mirrors
+    /// RuntimeConfig::global().
+    static CalibrationStore* global();
+    static void set_global(CalibrationStore* instance);
+
+    /// `fingerprint_provider` is evaluated once, on first use, so hardware
+    /// probing is deferred out of server startup.
+    CalibrationStore(const std::filesystem::path& store_path,
+                     std::function<std::string()> fingerprint_provider);
+
+    std::optional<CalibrationCurve> lookup(const std::string& model);
+    void store(const std::string& model, const CalibrationCurve& curve);
+
+    const std::string& fingerprint();
+
+    /// Least-squares line through (ctx_tokens, resident_gb) points. Returns
+    /// false with fewer than two distinct context sizes. The slope comes back
+    /// in bytes per token; the intercept in GB.
+    static bool fit_linear(const std::vector<std::pair<int64_t, double>>& points,
+                           double& kv_bytes_per_token, double& base_gb);
+
+    /// Stable digest of the fields that change a machine's performance
+    /// profile (processor, memory, GPUs/NPU), taken from a system_info JSON
+    /// snapshot. Pure so tests can exercise it without hardware probing.
+    static std::string compute_hardware_fingerprint(const nlohmann::json& system_info);
+
+private:
+    void load_locked();
+    void save_locked();
+    const std::string& fingerprint_locked();
+
+    std::mutex mutex_;
+    std::filesystem::path store_path_;
+    std::function<std::string()> fingerprint_provider_;
+    std::string fingerprint_;
+    // fingerprint → model → curve
+    std::map<std::string, std::map<std::string, CalibrationCurve>> entries_;
+    bool loaded_ = false;
+};
+
+}  // namespace lemon
@@ -0,0 +1,47 @@
+#pragma once
+
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace lemon {
+
+// Passive per-endpoint health for cloud providers with multiple base URLs.
+// Every forwarded request reports its outcome here; rank() orders a provider's
+// endpoints so the next request prefers the fastest healthy one and a degraded
+// region stops eating 30-second timeouts. EWMA smoothing means one slow or
+// failed call shifts preference without pinning an endpoint out forever —
+// recovery is observed as soon as traffic (or ranking decay) returns to it.
+class CloudEndpointTracker {
+public:
+    struct Snapshot {
+        double latency_ms = 0.0;     // EWMA of successful request latency
+        double error_rate = 0.0;     // EWMA of failure indicator (0..1)
+        uint64_t successes = 0;
+        uint64_t failures = 0;
+    };
+
+    void record_success(const std::string& endpoint, double latency_ms);
+    void record_failure(const std::string& endpoint);
+
+    // Orders endpoints best-first: an endpoint's score is its latency EWMA
+    // plus an error penalty that dominates latency differences. Endpoints
+    // without samples keep their given position (stable sort, score 0), so a
+    // newly configured endpoint gets probed rather than starved.
+    std::vector<std::string> rank(std::vector<std::string> endpoints) const;
+
+    Snapshot snapshot(const std::string& endpoint) const;
+    std::map<std::string, Snapshot> snapshot_all() const;
+
+    static CloudEndpointTracker& instance();
+
+private:
+    double score_locked(const std::string& endpoint) const;
+
+    mutable std::mutex mutex_;
+    std::map<std::string, Snapshot> endpoints_;
+};
+
+} // namespace lemon
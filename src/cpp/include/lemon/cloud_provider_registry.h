@@ -32,6 +32,9 @@ public:
         std::string name;                         // e.g. "fireworks", "openai"
         std::string base_url;                     // normalized: no trailing slash
         bool allow_insecure_http = false;         // explicit opt-in for http:// + API key
+        // Additional endpoints for the same provider (other regions); all
+        // normalized, tried after base_url subject to latency/error ranking.
+        std::vector<std::string> fallback_base_urls;
     };
 
     struct AuthState {
@@ -55,7 +58,8 @@ public:
     // record changed, false if it was already identical.
     bool install(const std::string& provider,
                  const std::string& base_url,
-                 bool allow_insecure_http = false);
+                 bool allow_insecure_http = false,
+                 std::vector<std::string> fallback_base_urls = {});
 
     // Removes the provider record AND its runtime key. Returns true if a
     // record was removed.
@@ -69,6 +73,10 @@ public:
     // Base URL for a registered provider, or empty if not installed.
     std::string base_url_for(const std::string& provider) const;
 
+    // All endpoints for a provider, primary first then fallbacks. Empty if
+    // not installed.
+    std::vector<std::string> base_urls_for(const std::string& provider) const;
+
     // Whether this provider has explicit opt-in to send API keys to an
     // http:// base URL. Irrelevant for https:// providers.
     bool allow_insecure_http_for(const std::string& provider) const;
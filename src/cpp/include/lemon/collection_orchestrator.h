@@ -2,10 +2,12 @@
 
 #include <functional>
 #include <map>
+#include <memory>
 #include <string>
 #include <vector>
 #include <httplib.h>
 #include <nlohmann/json.hpp>
+#include "artifact_spool.h"
 #include "model_manager.h"
 
 namespace lemon {
@@ -45,11 +47,7 @@ public:
     // A piece of media produced by a tool this turn. Public so non-OpenAI
     // surfaces (the MCP gateway) can render artifacts as their own native
     // content blocks instead of markdown/HTML data-URIs.
-    struct Artifact {
-        std::string type;  // "image" | "audio"
-        std::string data;  // base64 payload
-        std::string mime;  // e.g. "image/png", "audio/mpeg"
-    };
+    using Artifact = ArtifactSpool::Item;
 
     // Structured view of one orchestrator turn. For callers (MCP) that need
     // the artifacts as separate values instead of having them folded into a
@@ -90,7 +88,9 @@ private:
         bool ok = true;
         json error = nullptr;
         std::string final_text;
-        std::vector<Artifact> artifacts;
+        // Payloads past the spool's memory budget live in its spill file, so
+        // a media-heavy turn never holds every artifact in memory at once.
+        std::shared_ptr<ArtifactSpool> artifacts;
         json app_tool_calls = nullptr;  // non-null array => passthrough to caller
         std::string finish_reason = "stop";
         json base_response = json::object();
@@ -108,7 +108,7 @@ private:
     // `success_text` receives the role:"tool" content reported back to the model.
     // Returns true on success. Throws on backend error.
     bool execute_tool(const std::string& tool_name, const std::string& model,
-                      const json& args, std::vector<Artifact>& artifacts,
+                      const json& args, ArtifactSpool& artifacts,
                       const std::string& source_image_b64, const std::string& source_image_mime,
                       int& produced_index, std::string& success_text);
 
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <nlohmann/json.hpp>
+
+namespace lemon {
+
+/**
+ * Persistent disk cache for fully deterministic completions. Entries are keyed
+ * by a hash of the endpoint, the model's checkpoint revision, and the full
+ * request body, and stored as JSON files under <cache_dir>/completion-cache.
+ * Only non-streaming temperature-0 requests qualify, so a hit replays the
+ * exact bytes the backend would regenerate. Entries expire ttl_hours after
+ * they were written; past max_bytes the least recently used entries (by file
+ * mtime, refreshed on every hit) are evicted.
+ */
+class CompletionCache {
+public:
+    static constexpr uint64_t DEFAULT_MAX_BYTES = 64ull * 1024 * 1024;
+
+    struct Totals {
+        uint64_t hits = 0;
+        uint64_t misses = 0;
+        uint64_t stores = 0;
+        uint64_t expired = 0;
+    };
+
+    CompletionCache(const std::string& cache_dir, int ttl_hours,
+                    uint64_t max_bytes = DEFAULT_MAX_BYTES);
+
+    /** Whether a request is deterministic enough to cache at all. */
+    static bool cacheable(const nlohmann::json& request);
+
+    /** Cache key; `revision` pins the entry to the exact model weights. */
+    static std::string key_for(const std::string& endpoint,
+                               const nlohmann::json& request,
+                               const std::string& revision);
+
+    /** Fetch a cached response, dropping it instead when its TTL has lapsed. */
+    bool lookup(const std::string& key, nlohmann::json& response);
+
+    /** Persist a response and evict the oldest entries past the size bound. */
+    void store(const std::string& key, const nlohmann::json& response);
+
+    static Totals totals();
+
+private:
+    void evict_to_fit();
+
+    std::string dir_;
+    int ttl_hours_;
+    uint64_t max_bytes_;
+    mutable std::mutex mutex_;
+};
+
+}  // namespace lemon
@@ -0,0 +1,96 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+namespace lemon {
+
+// Policy for when large pulls run and how fast, so fleet model distribution
+// does not compete with interactive traffic. Config keys:
+//
+//   download_rate_limit_mbps           receive cap (megabits/sec) outside the
+//                                      off-hours window; 0 = unshaped
+//   download_offhours                  "HH:MM-HH:MM" local time; may wrap
+//                                      midnight (e.g. "22:00-06:00")
+//   download_offhours_rate_limit_mbps  cap inside the window; 0 = unshaped
+//
+// When a window is configured, background fetches (backend upgrade prefetch)
+// only start inside it; user-initiated pulls always run, shaped by whichever
+// cap is active. The window/cap arithmetic is pure and inline so it is
+// testable without config plumbing; the RuntimeConfig-driven helpers live in
+// download_scheduler.cpp.
+class DownloadScheduler {
+public:
+    // Parses "HH:MM-HH:MM" into minutes-of-day. Returns false (outputs
+    // untouched) on malformed input or out-of-range times.
+    static bool parse_window(const std::string& window, int& start_minute,
+                             int& end_minute) {
+        const auto dash = window.find('-');
+        if (dash == std::string::npos) {
+            return false;
+        }
+        int start = 0, end = 0;
+        if (!parse_hhmm(window.substr(0, dash), start) ||
+            !parse_hhmm(window.substr(dash + 1), end)) {
+            return false;
+        }
+        start_minute = start;
+        end_minute = end;
+        return true;
+    }
+
+    // An empty window (start == end) matches nothing; start > end wraps
+    // midnight.
+    static bool in_window(int minute_of_day, int start_minute, int end_minute) {
+        if (start_minute == end_minute) {
+            return false;
+        }
+        if (start_minute < end_minute) {
+            return minute_of_day >= start_minute && minute_of_day < end_minute;
+        }
+        return minute_of_day >= start_minute || minute_of_day < end_minute;
+    }
+
+    static size_t effective_rate_bytes_per_sec(double base_mbps,
+                                               double offhours_mbps,
+                                               bool offhours) {
+        const double mbps = offhours ? offhours_mbps : base_mbps;
+        if (mbps <= 0.0) {
+            return 0;
+        }
+        return static_cast<size_t>(mbps * 1000000.0 / 8.0);
+    }
+
+    static bool offhours_now();
+
+    // Cap for a transfer starting now, in bytes/sec (0 = unshaped). Sampled
+    // per file, so a multi-file pull picks up a window change at its next
+    // file rather than mid-transfer.
+    static size_t current_rate_limit_bytes_per_sec();
+
+    // True when no off-hours window is configured, or the window is active.
+    static bool background_pulls_allowed_now();
+
+private:
+    static bool parse_hhmm(const std::string& text, int& minute) {
+        const auto colon = text.find(':');
+        if (colon == std::string::npos || colon == 0 || colon > 2 ||
+            text.size() - colon - 1 != 2) {
+            return false;
+        }
+        for (size_t i = 0; i < text.size(); ++i) {
+            if (i != colon && (text[i] < '0' || text[i] > '9')) {
+                return false;
+            }
+        }
+        const int hour = std::stoi(text.substr(0, colon));
+        const int min = std::stoi(text.substr(colon + 1));
+        if (hour > 23 || min > 59) {
+            return false;
+        }
+        minute = hour * 60 + min;
+        return true;
+    }
+};
+
+} // namespace lemon
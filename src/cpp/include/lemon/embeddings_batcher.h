@@ -0,0 +1,60 @@
+#pragma once
+
+#include <condition_variable>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+#include <nlohmann/json.hpp>
+
+namespace lemon {
+
+using json = nlohmann::json;
+
+/// Coalesces concurrent embeddings requests for the same model into one
+/// backend call. The first request to arrive for a batch key becomes the
+/// leader: it waits up to the batch window for joiners, sends the merged
+/// input array to the backend once, then scatters the per-text results back
+/// to each caller. Requests whose input is not a string or array of strings
+/// bypass batching (token-array inputs are forwarded unmodified).
+class EmbeddingsBatcher {
+public:
+    using BackendCall = std::function<json(const json&)>;
+
+    EmbeddingsBatcher(size_t max_batch_texts, int batch_window_ms);
+
+    /// Blocking: returns this request's embeddings response. `call` is invoked
+    /// by exactly one thread per batch with the merged request.
+    json embeddings(const json& request, const BackendCall& call);
+
+private:
+    struct PendingRequest {
+        std::vector<std::string> inputs;
+        json result;
+        std::string error;
+        bool done = false;
+    };
+
+    struct Batch {
+        std::vector<std::shared_ptr<PendingRequest>> members;
+        size_t total_texts = 0;
+        bool leader_running = false;
+        std::condition_variable cond;
+    };
+
+    static std::string batch_key(const json& request);
+    static bool extract_inputs(const json& request, std::vector<std::string>& out);
+
+    void run_batch(const std::string& key, std::shared_ptr<Batch> batch,
+                   const json& request_template, const BackendCall& call,
+                   std::unique_lock<std::mutex>& lock);
+
+    const size_t max_batch_texts_;
+    const int batch_window_ms_;
+    std::mutex mutex_;
+    std::map<std::string, std::shared_ptr<Batch>> batches_;
+};
+
+} // namespace lemon
@@ -22,6 +22,7 @@ namespace ErrorType {
     constexpr const char* INTERNAL_ERROR = "internal_error";
     constexpr const char* SLOTS_PINNED = "slots_pinned_error";
     constexpr const char* ROUTER_RESIDENCY_CONFLICT = "router_residency_conflict";
+    constexpr const char* RESERVATION_VIOLATION = "reservation_violation";
 }
 
 // Base exception class for all Lemon errors
@@ -65,6 +66,18 @@ public:
                         ErrorType::SLOTS_PINNED) {}
 };
 
+class ReservationViolationException : public LemonException {
+public:
+    ReservationViolationException(const std::string& incoming_model,
+                                  const std::string& reserved_model,
+                                  const std::string& constraint)
+        : LemonException(
+              "Reservation violation: loading model '" + incoming_model +
+                  "' would require evicting reserved model '" + reserved_model +
+                  "' (" + constraint + "). Unload the reserved model explicitly to free its capacity.",
+              ErrorType::RESERVATION_VIOLATION) {}
+};
+
 class RouterResidencyConflictException : public LemonException {
 public:
     RouterResidencyConflictException(const std::string& incoming_model,
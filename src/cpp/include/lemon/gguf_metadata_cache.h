@@ -0,0 +1,56 @@
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <map>
+#include <mutex>
+#include <string>
+
+#include "lemon/gguf_reader.h"
+
+namespace lemon {
+
+// Persisted GgufMetadata cache keyed by (path, mtime, size). Header parsing
+// is cheap locally but costs seconds per file on network storage, and the
+// registry refresh re-reads every local GGUF; with this cache a file is
+// parsed once per content change. The manifest survives restarts in the
+// lemonade cache dir.
+class GgufMetadataCache {
+public:
+    // Process-wide cache backed by gguf_metadata_cache.json in the lemonade
+    // cache dir.
+    static GgufMetadataCache& global();
+
+    explicit GgufMetadataCache(const std::filesystem::path& manifest_path);
+
+    // Cached metadata when (mtime, size) still match, a fresh header parse
+    // otherwise. Returns false if the file cannot be parsed.
+    bool read(GgufMetadata& out, const std::string& path);
+
+    // Reconcile every GGUF under dir with the manifest: re-parse files whose
+    // (mtime, size) changed, record new ones, and drop records for files that
+    // disappeared. Unchanged files are only stat'ed; stale headers are parsed
+    // by a pool of I/O-oversubscribed workers. Returns the number of records
+    // added, refreshed, or removed.
+    int refresh_directory(const std::string& dir);
+
+    void save();
+
+private:
+    struct Entry {
+        std::int64_t mtime = 0;
+        std::uint64_t size = 0;
+        GgufMetadata metadata;
+    };
+
+    void load_locked();
+    void save_locked();
+
+    std::mutex mutex_;
+    std::filesystem::path manifest_path_;
+    std::map<std::string, Entry> entries_;
+    bool loaded_ = false;
+    bool dirty_ = false;
+};
+
+}  // namespace lemon
@@ -16,6 +16,7 @@
 #include <string>
 #include <vector>
 #include <lemon/gguf_capabilities.h>
+#include <lemon/utils/mmap_file.h>
 #include <lemon/utils/path_utils.h>
 
 namespace lemon {
@@ -191,14 +192,11 @@ inline bool has_gguf_magic(const std::string& path) {
 
 // ── Public API ────────────────────────────────────────────────────────
 
-/// Read GGUF metadata from a file in a single pass over the KV header.
+/// Read GGUF metadata in a single pass over the KV header of `in`.
 ///
-/// Returns true on success (out is populated).  Returns false if the file
-/// cannot be opened or does not have a valid GGUF header.
-inline bool read_gguf_metadata(GgufMetadata& out, const std::string& path) {
-    std::ifstream in(lemon::utils::path_from_utf8(path), std::ios::binary);
-    if (!in) return false;
-
+/// Returns true on success (out is populated).  Returns false if the stream
+/// does not start with a valid GGUF header.
+inline bool read_gguf_metadata(GgufMetadata& out, std::istream& in) {
     char magic[4] = {};
     in.read(magic, sizeof(magic));
     if (!in || std::memcmp(magic, "GGUF", 4) != 0) return false;
@@ -387,6 +385,25 @@ inline bool read_gguf_metadata(GgufMetadata& out, const std::string& path) {
     return true;
 }
 
+/// Read GGUF metadata from a file.
+///
+/// The file is memory-mapped when possible so only the header pages are
+/// faulted in - the tensor payload is never read, and there is no buffered
+/// read-ahead against slow (network) storage.  Falls back to a plain stream
+/// read when mapping fails.
+inline bool read_gguf_metadata(GgufMetadata& out, const std::string& path) {
+    utils::MappedFile map(path);
+    if (map.is_open()) {
+        utils::MemoryStreamBuf buf(map.data(), map.size());
+        std::istream in(&buf);
+        return read_gguf_metadata(out, in);
+    }
+
+    std::ifstream in(lemon::utils::path_from_utf8(path), std::ios::binary);
+    if (!in) return false;
+    return read_gguf_metadata(out, in);
+}
+
 /// Compute KV cache bytes-per-token using raw per-layer arrays from GGUF.
 ///
 /// When head_count_kv_per_layer and sliding_window_pattern are populated,
@@ -5,6 +5,9 @@
 #include <functional>
 #include <mutex>
 #include <string>
+#include <vector>
+
+#include "lemon/system_info.h"
 
 namespace lemon {
 
@@ -25,6 +28,12 @@ public:
     // Register a callback to be notified of the current VRAM usage
     void set_pressure_callback(VramPressureCallback callback);
 
+    // One-shot synchronous usage query (0.0 to 1.0; negative when unknown)
+    double current_usage() const { return poll_vram_usage(); }
+
+    // One-shot per-GPU occupancy snapshot for multi-GPU placement decisions.
+    std::vector<SystemInfo::GpuMemoryDevice> per_device_memory() const;
+
     // Test/admin hook: synchronously fire the pressure callback with a
     // simulated usage fraction, bypassing the hardware poll.
     void simulate_pressure(double pct) {
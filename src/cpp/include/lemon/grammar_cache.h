@@ -0,0 +1,60 @@
+#pragma once
+
+#include <nlohmann/json.hpp>
+
+#include <cstdint>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+
+namespace lemon {
+
+// Caches JSON-schema -> GBNF grammar compilation for structured-output
+// requests. llama-server compiles `response_format: json_schema` to a grammar
+// on every request even though function-calling traffic reuses the same few
+// schemas; lemond compiles the supported subset once, caches the grammar text
+// (bounded LRU), and sends the backend a ready `grammar` field instead.
+//
+// The compiler covers the schema shapes strict function calling emits:
+// typed primitives, enum/const literals, arrays with `items`, objects whose
+// properties are all required, and anyOf alternation. Anything else (refs,
+// patterns, optional properties, numeric bounds, ...) returns an empty
+// optional and the request passes through to the backend's own compiler.
+class GrammarCache {
+public:
+    static GrammarCache& instance();
+
+    // Grammar for `schema`, compiled at most once per distinct schema. Empty
+    // optional when the schema uses unsupported features (also cached, so an
+    // unsupported schema is walked only once).
+    std::optional<std::string> grammar_for(const nlohmann::json& schema);
+
+    // Stateless single compilation, exposed for tests.
+    static std::optional<std::string> compile(const nlohmann::json& schema);
+
+    size_t size() const;
+
+    struct Stats {
+        uint64_t hits = 0;
+        uint64_t compiles = 0;
+        uint64_t unsupported = 0;
+    };
+
+    // Process-wide totals, for /metrics.
+    static Stats totals();
+
+private:
+    static constexpr size_t kMaxEntries = 64;
+
+    struct Entry {
+        std::optional<std::string> grammar;
+        uint64_t last_used = 0;
+    };
+
+    mutable std::mutex mutex_;
+    std::unordered_map<std::string, Entry> entries_;
+    uint64_t use_counter_ = 0;
+};
+
+} // namespace lemon
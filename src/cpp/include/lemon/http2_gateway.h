@@ -0,0 +1,131 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <libwebsockets.h>
+
+namespace lemon {
+
+/**
+ * Per-stream data allocated by libwebsockets for each HTTP stream.
+ * Must be a POD type — libwebsockets uses malloc/free, not new/delete.
+ */
+struct PerStreamData {
+    char stream_id[32];
+};
+
+/**
+ * HTTP/2-capable front listener. The main cpp-httplib listener is HTTP/1.1
+ * only, so browser dashboards and proxy clients running many concurrent SSE
+ * streams pay per-connection overhead and head-of-line costs. This gateway
+ * accepts h2c (prior-knowledge cleartext, the form TLS-terminating reverse
+ * proxies and HTTP/2 clients use toward a plaintext upstream) as well as
+ * plain HTTP/1.1, multiplexes the streams over few TCP connections, and
+ * forwards each one to the main listener over loopback — the handler layer
+ * stays unchanged behind it. The port is OS-assigned by default and surfaced
+ * as `http2_port` in the /health response.
+ */
+class Http2Gateway {
+public:
+    Http2Gateway(const std::string& host, int requested_port, int upstream_port);
+    ~Http2Gateway();
+
+    // Non-copyable
+    Http2Gateway(const Http2Gateway&) = delete;
+    Http2Gateway& operator=(const Http2Gateway&) = delete;
+
+    bool start();
+    void stop();
+
+    bool is_running() const { return running_.load(); }
+
+    /**
+     * Get the listener port. Only valid after start() returns true.
+     */
+    int get_port() const { return port_; }
+
+    // libwebsockets callback (public — referenced by file-scope protocols array)
+    static int http_callback(struct lws* wsi, enum lws_callback_reasons reason,
+                             void* user, void* in, size_t len);
+
+private:
+    /**
+     * One proxied request/response stream. The libwebsockets service thread
+     * owns the wsi; a per-stream worker thread runs the loopback request and
+     * only touches this shared state, so the two sides meet exclusively under
+     * `mutex` plus a service wakeup.
+     */
+    struct StreamState {
+        std::string method;
+        std::string target;
+        std::multimap<std::string, std::string> request_headers;
+        std::string request_body;
+
+        std::mutex mutex;
+        int status = 0;
+        std::string response_content_type;
+        std::vector<std::pair<std::string, std::string>> response_headers;
+        std::string pending;
+        bool have_headers = false;
+        bool headers_sent = false;
+        bool upstream_done = false;
+        bool final_written = false;
+        bool needs_kick = false;
+        std::atomic<bool> cancelled{false};
+    };
+
+    /**
+     * Wake handle shared with worker threads. Workers outlive neither the
+     * process nor their stream state, but they may outlive the gateway during
+     * shutdown: the handle's context pointer is nulled under its mutex before
+     * the lws context is destroyed, so late wakeups become no-ops.
+     */
+    struct ServiceHandle {
+        std::mutex mutex;
+        struct lws_context* context = nullptr;
+
+        void kick() {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (context) {
+                lws_cancel_service(context);
+            }
+        }
+    };
+
+    int port_;
+    std::string host_;
+    int upstream_port_;
+    struct lws_context* context_{nullptr};
+    struct lws_vhost* vhost_{nullptr};
+    std::thread service_thread_;
+    std::atomic<bool> running_{false};
+    std::shared_ptr<ServiceHandle> service_handle_;
+    std::atomic<uint64_t> next_stream_id_{1};
+
+    std::unordered_map<std::string, std::shared_ptr<StreamState>> streams_;
+    std::unordered_map<std::string, struct lws*> stream_websockets_;
+    std::mutex streams_mutex_;
+
+    int handle_request(struct lws* wsi, PerStreamData* pss, const char* uri_path);
+    int handle_body(PerStreamData* pss, const char* data, size_t len);
+    void handle_body_completion(const std::string& stream_id);
+    int handle_writable(const std::string& stream_id, struct lws* wsi);
+    void handle_close(const std::string& stream_id);
+
+    void start_upstream(const std::string& stream_id);
+    void kick_pending_streams();
+
+    // Service loop run in background thread
+    void service_loop();
+};
+
+} // namespace lemon
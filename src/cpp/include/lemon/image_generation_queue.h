@@ -0,0 +1,86 @@
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace lemon {
+
+/**
+ * Admission queue in front of the image backend. sd-server processes one
+ * generation at a time, so without this, concurrent requests pile up inside
+ * the subprocess with no visibility and clients time out blind. Each request
+ * takes a Ticket and waits for its turn; callers can poll the ticket's queue
+ * position while waiting (and stream it to the client).
+ *
+ * Scheduling order: highest priority first, then tickets whose resolution
+ * matches the previous generation (sd.cpp reuses its compute buffers per
+ * resolution, so grouping same-size requests avoids reallocation between
+ * jobs), then FIFO.
+ *
+ * Completed generations feed a per-(resolution, steps) duration estimate so
+ * in-flight progress can be approximated for backends that expose no
+ * step-level callbacks.
+ */
+class ImageGenerationQueue {
+public:
+    struct Ticket {
+        int priority = 0;
+        std::string resolution;
+        uint64_t sequence = 0;
+        bool running = false;
+        bool cancelled = false;
+    };
+
+    explicit ImageGenerationQueue(size_t max_running = 1);
+
+    std::shared_ptr<Ticket> enqueue(int priority, const std::string& resolution);
+
+    /** 0 = running; N = number of generations ahead of this ticket. */
+    size_t position(const std::shared_ptr<Ticket>& ticket) const;
+
+    /** Tickets waiting or running. */
+    size_t depth() const;
+
+    /** Block until the ticket is scheduled or the timeout elapses. */
+    bool wait_for_turn(const std::shared_ptr<Ticket>& ticket,
+                       std::chrono::milliseconds timeout);
+
+    /** Abandon a ticket that is still waiting (client disconnected). */
+    void cancel(const std::shared_ptr<Ticket>& ticket);
+
+    /**
+     * Release the slot held by a running ticket and, when duration is
+     * positive, fold it into the duration estimate for estimate_key.
+     */
+    void complete(const std::shared_ptr<Ticket>& ticket,
+                  const std::string& estimate_key,
+                  std::chrono::milliseconds duration);
+
+    /**
+     * Fraction of the expected duration already elapsed, clamped to 0.95 so
+     * an estimate never claims completion. Negative when nothing with this
+     * key has completed yet.
+     */
+    double estimated_fraction(const std::string& estimate_key,
+                              std::chrono::milliseconds elapsed) const;
+
+private:
+    void schedule_locked();
+
+    size_t max_running_;
+    uint64_t next_sequence_ = 1;
+    size_t running_ = 0;
+    std::string last_resolution_;
+    std::vector<std::shared_ptr<Ticket>> waiting_;
+    std::map<std::string, double> expected_ms_;
+    mutable std::mutex mutex_;
+    std::condition_variable cv_;
+};
+
+}  // namespace lemon
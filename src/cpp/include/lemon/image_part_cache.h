@@ -0,0 +1,69 @@
+#pragma once
+
+#include <cstdint>
+#include <list>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include <nlohmann/json.hpp>
+
+namespace lemon {
+
+// Vision chat requests inline base64 screenshots that agents resend every
+// turn, often re-encoded along the way (different line wrapping, wrong or
+// missing mime label), which breaks byte-identical prefix matching in
+// llama-server's prompt cache and in slot-affinity routing. This cache
+// canonicalizes each image_url data URI once — whitespace-stripped base64,
+// mime taken from the magic bytes, dimensions probed from the header — and
+// replays the canonical form from an LRU keyed by content hash on later
+// turns, so a resent screenshot costs a hash lookup instead of a decode and
+// always produces the same bytes.
+class ImagePartCache {
+public:
+    static ImagePartCache& global();
+
+    explicit ImagePartCache(size_t budget_bytes);
+
+    // Rewrites image_url data URIs inside messages[].content[] parts to
+    // canonical form. Non-data URLs and undecodable payloads pass through
+    // untouched. Returns true when the request changed.
+    bool preprocess_chat_request(nlohmann::json& request);
+
+    // Pixel dimensions from the image header, without a full decode.
+    // Supports the formats sniff_image() recognizes; JPEG scans SOF markers.
+    static bool probe_dimensions(const std::string& bytes, const std::string& mime,
+                                 int& width, int& height);
+
+    struct Totals {
+        uint64_t images = 0;
+        uint64_t hits = 0;
+        uint64_t misses = 0;
+        uint64_t rejected = 0;
+        uint64_t cached_bytes = 0;
+        uint64_t cached_entries = 0;
+    };
+    Totals totals();
+
+private:
+    struct Entry {
+        std::string canonical_uri;
+        std::list<uint64_t>::iterator lru_it;
+    };
+
+    bool canonicalize_part(nlohmann::json& image_url);
+    void insert_locked(uint64_t key, std::string canonical_uri);
+
+    std::mutex mutex_;
+    size_t budget_bytes_;
+    size_t cached_bytes_ = 0;
+    std::unordered_map<uint64_t, Entry> entries_;
+    std::list<uint64_t> lru_;
+
+    uint64_t images_ = 0;
+    uint64_t hits_ = 0;
+    uint64_t misses_ = 0;
+    uint64_t rejected_ = 0;
+};
+
+} // namespace lemon
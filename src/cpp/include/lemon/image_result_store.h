@@ -0,0 +1,46 @@
+#pragma once
+
+#include <cstdint>
+#include <mutex>
+#include <string>
+
+namespace lemon {
+
+/**
+ * Content-addressed disk store for generated images. Entries are keyed by a
+ * hash of the image bytes themselves and stored under
+ * <cache_dir>/image-results, so regenerating the same image (grid variations,
+ * retries) dedups to one file, and the serving URL is immutable — browsers can
+ * cache it forever. Bounded like TtsCache: past max_bytes the least recently
+ * served entries (by file mtime, refreshed on every hit) are evicted.
+ */
+class ImageResultStore {
+public:
+    static constexpr uint64_t DEFAULT_MAX_BYTES = 512ull * 1024 * 1024;
+
+    explicit ImageResultStore(const std::string& cache_dir,
+                              uint64_t max_bytes = DEFAULT_MAX_BYTES);
+
+    /**
+     * Persist image bytes and return their content key; identical bytes reuse
+     * the existing entry. Returns "" when the entry cannot be written.
+     */
+    std::string store(const std::string& bytes, const std::string& format);
+
+    /**
+     * Fetch a stored image, refreshing its LRU position. The format the entry
+     * was stored with comes back in `format` for MIME selection.
+     */
+    bool lookup(const std::string& key, std::string& format, std::string& bytes);
+
+    uint64_t size_bytes() const;
+
+private:
+    void evict_to_fit();
+
+    std::string dir_;
+    uint64_t max_bytes_;
+    mutable std::mutex mutex_;
+};
+
+}  // namespace lemon
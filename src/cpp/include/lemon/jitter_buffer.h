@@ -0,0 +1,75 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <deque>
+#include <vector>
+
+namespace lemon {
+
+/**
+ * Adaptive jitter buffer for realtime audio ingest. WebSocket delivery is
+ * in-order but bursty: frames bunch up behind a congested link and arrive in
+ * clumps, which makes VAD and interim transcription react to transport timing
+ * instead of speech timing. Incoming frames are queued and released so that a
+ * target depth stays buffered; the target tracks an EWMA of inter-arrival
+ * jitter (RFC 3550 style), so a clean network converges to pass-through and a
+ * lossy one earns just enough depth to absorb its bursts.
+ *
+ * Frame vectors are recycled through a freelist, so the steady state does not
+ * allocate. Not thread-safe; callers drive it from the session's receive path.
+ */
+class JitterBuffer {
+public:
+    struct Config {
+        int sample_rate = 16000;
+        int min_depth_ms = 0;
+        int max_depth_ms = 320;
+        // Target depth = jitter estimate x this multiplier, clamped above.
+        double jitter_multiplier = 2.0;
+    };
+
+    struct Totals {
+        uint64_t frames = 0;
+        uint64_t late_frames = 0;
+        uint64_t released_frames = 0;
+    };
+
+    JitterBuffer();
+    explicit JitterBuffer(Config config);
+
+    /** Queue one frame of samples, updating the jitter estimate from now_ms. */
+    void push(const int16_t* samples, size_t count, int64_t now_ms);
+
+    /**
+     * Append every frame past the current target depth to `out`, oldest
+     * first. Returns the number of samples released.
+     */
+    size_t pull_ready(std::vector<int16_t>& out);
+
+    /** Append everything still queued to `out` and reset the queue. */
+    size_t flush(std::vector<int16_t>& out);
+
+    /** Drop queued audio and arrival history (session clear). */
+    void reset();
+
+    int target_depth_ms() const;
+    int queued_ms() const;
+    double jitter_ms() const { return jitter_ms_; }
+
+    static Totals totals();
+
+private:
+    std::vector<int16_t> take_frame();
+    void recycle_frame(std::vector<int16_t>&& frame);
+
+    Config config_;
+    std::deque<std::vector<int16_t>> queue_;
+    std::vector<std::vector<int16_t>> freelist_;
+    size_t queued_samples_ = 0;
+    int64_t last_arrival_ms_ = 0;
+    double interval_ms_ = 0.0;
+    double jitter_ms_ = 0.0;
+};
+
+}  // namespace lemon
@@ -5,7 +5,11 @@
 #include <cctype>
 #include <cmath>
 #include <cstdlib>
+#include <memory>
+#include <mutex>
 #include <string>
+#include <unordered_map>
+#include <utility>
 #include <vector>
 
 namespace lemon {
@@ -123,18 +127,28 @@ inline std::vector<Token> tokenize(const std::string& s) {
     return out;
 }
 
-class Parser {
+// Expressions compile once into this small tree; per-evaluation work is a
+// walk over it with the current context. All syntax errors surface at
+// compile time; reference, type, and division errors stay evaluation-time
+// because they depend on context values.
+struct Node {
+    enum class Kind { Const, Ref, Or, And, Not, Neg, Cmp, Arith };
+    Kind kind = Kind::Const;
+    json value;
+    std::string text;
+    std::vector<Node> kids;
+};
+
+class Compiler {
 public:
-    Parser(std::vector<Token> toks, const json& ctx) : toks_(std::move(toks)), ctx_(ctx) {}
+    explicit Compiler(std::vector<Token> toks) : toks_(std::move(toks)) {}
 
-    json parse() {
-        json v = parse_or();
+    Node compile() {
+        Node n = parse_or();
         if (peek().kind != Tok::End) throw JobError(400, "trailing tokens in expression");
-        return v;
+        return n;
     }
 
-    void set_syntax_only() { syntax_only_ = true; }
-
 private:
     const Token& peek() const { return toks_[pos_]; }
     const Token& advance() { return toks_[pos_++]; }
@@ -143,85 +157,89 @@ private:
         return false;
     }
 
-    double num(const json& v, const char* ctx) const {
-        if (!v.is_number()) {
-            if (syntax_only_) return 0.0;
-            throw JobError(400, std::string("expected a number for ") + ctx);
-        }
-        return v.get<double>();
+    static Node binary(Node::Kind kind, std::string op, Node l, Node r) {
+        Node n;
+        n.kind = kind;
+        n.text = std::move(op);
+        n.kids.push_back(std::move(l));
+        n.kids.push_back(std::move(r));
+        return n;
+    }
+    static Node unary(Node::Kind kind, Node kid) {
+        Node n;
+        n.kind = kind;
+        n.kids.push_back(std::move(kid));
+        return n;
+    }
+    static Node constant(json v) {
+        Node n;
+        n.value = std::move(v);
+        return n;
     }
 
-    json parse_or() {
-        json l = parse_and();
-        while (accept_op("||")) { json r = parse_and(); l = truthy(l) || truthy(r); }
+    Node parse_or() {
+        Node l = parse_and();
+        while (accept_op("||")) l = binary(Node::Kind::Or, "||", std::move(l), parse_and());
         return l;
     }
-    json parse_and() {
-        json l = parse_not();
-        while (accept_op("&&")) { json r = parse_not(); l = truthy(l) && truthy(r); }
+    Node parse_and() {
+        Node l = parse_not();
+        while (accept_op("&&")) l = binary(Node::Kind::And, "&&", std::move(l), parse_not());
         return l;
     }
-    json parse_not() {
-        if (accept_op("!")) return !truthy(parse_not());
+    Node parse_not() {
+        if (accept_op("!")) return unary(Node::Kind::Not, parse_not());
         return parse_cmp();
     }
-    json parse_cmp() {
-        json l = parse_add();
+    Node parse_cmp() {
+        Node l = parse_add();
         for (const char* op : {"==", "!=", "<=", ">=", "<", ">"}) {
             if (peek().kind == Tok::Op && peek().text == op) {
                 advance();
-                json r = parse_add();
-                return compare(op, l, r);
+                return binary(Node::Kind::Cmp, op, std::move(l), parse_add());
             }
         }
         return l;
     }
-    json parse_add() {
-        json l = parse_mul();
+    Node parse_add() {
+        Node l = parse_mul();
         while (peek().kind == Tok::Op && (peek().text == "+" || peek().text == "-")) {
             std::string op = advance().text;
-            json r = parse_mul();
-            l = op == "+" ? num(l, "+") + num(r, "+") : num(l, "-") - num(r, "-");
+            l = binary(Node::Kind::Arith, std::move(op), std::move(l), parse_mul());
         }
         return l;
     }
-    json parse_mul() {
-        json l = parse_unary();
+    Node parse_mul() {
+        Node l = parse_unary();
         while (peek().kind == Tok::Op && (peek().text == "*" || peek().text == "/")) {
             std::string op = advance().text;
-            json r = parse_unary();
-            if (op == "*") l = num(l, "*") * num(r, "*");
-            else {
-                double d = num(r, "/");
-                if (d == 0.0) {
-                    if (syntax_only_) { l = 0.0; continue; }
-                    throw JobError(400, "division by zero in expression");
-                }
-                l = num(l, "/") / d;
-            }
+            l = binary(Node::Kind::Arith, std::move(op), std::move(l), parse_unary());
         }
         return l;
     }
-    json parse_unary() {
-        if (accept_op("-")) return -num(parse_unary(), "unary -");
+    Node parse_unary() {
+        if (accept_op("-")) return unary(Node::Kind::Neg, parse_unary());
         return parse_primary();
     }
-    json parse_primary() {
+    Node parse_primary() {
         const Token& t = peek();
         switch (t.kind) {
-            case Tok::Num: advance(); return t.num;
-            case Tok::Str: advance(); return t.text;
-            case Tok::True: advance(); return true;
-            case Tok::False: advance(); return false;
-            case Tok::Null: advance(); return json(nullptr);
-            case Tok::Ref:
+            case Tok::Num: advance(); return constant(t.num);
+            case Tok::Str: advance(); return constant(t.text);
+            case Tok::True: advance(); return constant(true);
+            case Tok::False: advance(); return constant(false);
+            case Tok::Null: advance(); return constant(json(nullptr));
+            case Tok::Ref: {
                 advance();
-                if (syntax_only_) return json(nullptr);
-                return resolve_ref_path(t.text, ctx_);
+                Node n;
+                n.kind = Node::Kind::Ref;
+                n.text = t.text;
+                return n;
+            }
             case Tok::Op:
                 if (t.text == "(") {
                     advance();
-                    json v = parse_or();
+                    Node v = parse_or();
                     if (!accept_op(")")) throw JobError(400, "missing ) in expression");
                     return v;
                 }
@@ -231,34 +249,113 @@ private:
         throw JobError(400, "unexpected token in expression");
     }
 
-    json compare(const std::string& op, const json& l, const json& r) const {
-        if (op == "==") return l == r;
-        if (op == "!=") return l != r;
-        if (l.is_number() && r.is_number()) {
-            double a = l.get<double>(), b = r.get<double>();
-            if (op == "<") return a < b;
-            if (op == "<=") return a <= b;
-            if (op == ">") return a > b;
-            return a >= b;
+    std::vector<Token> toks_;
+    size_t pos_ = 0;
+};
+
+inline double expect_num(const json& v, const std::string& what) {
+    if (!v.is_number()) throw JobError(400, "expected a number for " + what);
+    return v.get<double>();
+}
+
+inline json compare(const std::string& op, const json& l, const json& r) {
+    if (op == "==") return l == r;
+    if (op == "!=") return l != r;
+    if (l.is_number() && r.is_number()) {
+        double a = l.get<double>(), b = r.get<double>();
+        if (op == "<") return a < b;
+        if (op == "<=") return a <= b;
+        if (op == ">") return a > b;
+        return a >= b;
+    }
+    if (l.is_string() && r.is_string()) {
+        const auto& a = l.get_ref<const std::string&>();
+        const auto& b = r.get_ref<const std::string&>();
+        if (op == "<") return a < b;
+        if (op == "<=") return a <= b;
+        if (op == ">") return a > b;
+        return a >= b;
+    }
+    throw JobError(400, "cannot order-compare these operand types");
+}
+
+inline json eval_node(const Node& n, const json& ctx) {
+    switch (n.kind) {
+        case Node::Kind::Const: return n.value;
+        case Node::Kind::Ref: return resolve_ref_path(n.text, ctx);
+        case Node::Kind::Or: {
+            const bool l = truthy(eval_node(n.kids[0], ctx));
+            const bool r = truthy(eval_node(n.kids[1], ctx));
+            return l || r;
         }
-        if (l.is_string() && r.is_string()) {
-            const auto& a = l.get_ref<const std::string&>();
-            const auto& b = r.get_ref<const std::string&>();
-            if (op == "<") return a < b;
-            if (op == "<=") return a <= b;
-            if (op == ">") return a > b;
-            return a >= b;
+        case Node::Kind::And: {
+            const bool l = truthy(eval_node(n.kids[0], ctx));
+            const bool r = truthy(eval_node(n.kids[1], ctx));
+            return l && r;
+        }
+        case Node::Kind::Not: return !truthy(eval_node(n.kids[0], ctx));
+        case Node::Kind::Neg: return -expect_num(eval_node(n.kids[0], ctx), "unary -");
+        case Node::Kind::Cmp:
+            return compare(n.text, eval_node(n.kids[0], ctx), eval_node(n.kids[1], ctx));
+        case Node::Kind::Arith: {
+            const double a = expect_num(eval_node(n.kids[0], ctx), n.text);
+            const double b = expect_num(eval_node(n.kids[1], ctx), n.text);
+            if (n.text == "+") return a + b;
+            if (n.text == "-") return a - b;
+            if (n.text == "*") return a * b;
+            if (b == 0.0) throw JobError(400, "division by zero in expression");
+            return a / b;
         }
-        if (syntax_only_) return false;
-        throw JobError(400, "cannot order-compare these operand types");
     }
+    throw JobError(400, "unexpected token in expression");
+}
 
-    std::vector<Token> toks_;
-    const json& ctx_;
-    size_t pos_ = 0;
-    bool syntax_only_ = false;
+}
+
+class CompiledExpr {
+public:
+    CompiledExpr() = default;
+
+    static CompiledExpr compile(const std::string& expr) {
+        CompiledExpr c;
+        if (!expr.empty())
+            c.root_ = std::make_shared<const expr_detail::Node>(
+                expr_detail::Compiler(expr_detail::tokenize(expr)).compile());
+        return c;
+    }
+
+    bool empty() const { return !root_; }
+
+    // An empty expression is unconditionally true, matching eval_condition.
+    bool eval(const json& ctx) const {
+        if (!root_) return true;
+        return expr_detail::truthy(expr_detail::eval_node(*root_, ctx));
+    }
+
+private:
+    std::shared_ptr<const expr_detail::Node> root_;
 };
 
+namespace expr_detail {
+
+// Process-wide compile cache keyed by source text. Validation at job
+// submission warms it, so steady-state evaluation never re-parses.
+inline CompiledExpr compiled_for(const std::string& expr) {
+    constexpr size_t kCacheCap = 512;
+    static std::mutex cache_mutex;
+    static std::unordered_map<std::string, CompiledExpr> cache;
+    {
+        std::lock_guard<std::mutex> lock(cache_mutex);
+        auto it = cache.find(expr);
+        if (it != cache.end()) return it->second;
+    }
+    CompiledExpr compiled = CompiledExpr::compile(expr);
+    std::lock_guard<std::mutex> lock(cache_mutex);
+    if (cache.size() >= kCacheCap) cache.clear();
+    cache.emplace(expr, compiled);
+    return compiled;
+}
+
 }
 
 inline json resolve_refs(const json& value, const json& ctx) {
@@ -300,16 +397,13 @@ inline json resolve_refs(const json& value, const json& ctx) {
 
 inline bool eval_condition(const std::string& expr, const json& ctx) {
     if (expr.empty()) return true;
-    return expr_detail::truthy(expr_detail::Parser(expr_detail::tokenize(expr), ctx).parse());
+    return expr_detail::compiled_for(expr).eval(ctx);
 }
 
 inline std::string check_expression_syntax(const std::string& expr) {
     if (expr.empty()) return "";
-    static const json placeholder = json(nullptr);
     try {
-        expr_detail::Parser parser(expr_detail::tokenize(expr), placeholder);
-        parser.set_syntax_only();
-        parser.parse();
+        expr_detail::compiled_for(expr);
     } catch (const JobError& e) {
         return e.what();
     }
@@ -11,8 +11,37 @@
 namespace lemon {
 namespace jobs {
 
+namespace graph_detail {
+
+// Root key of the first ${ref} in `value` (recursively) that names one of
+// `ids`, or "" when there is none.
+inline std::string find_ref_to(const json& value, const std::set<std::string>& ids) {
+    if (value.is_object() || value.is_array()) {
+        for (const auto& element : value) {
+            const std::string hit = find_ref_to(element, ids);
+            if (!hit.empty()) return hit;
+        }
+        return "";
+    }
+    if (!value.is_string()) return "";
+    const std::string& s = value.get_ref<const std::string&>();
+    size_t pos = 0;
+    while ((pos = s.find("${", pos)) != std::string::npos) {
+        const size_t start = pos + 2;
+        const size_t end = s.find_first_of(".}", start);
+        if (end == std::string::npos) break;
+        const std::string root = s.substr(start, end - start);
+        if (ids.count(root)) return root;
+        pos = end;
+    }
+    return "";
+}
+
+}  // namespace graph_detail
+
 inline std::string validate_steps(const std::vector<StepRecord>& steps,
-                                  const std::set<std::string>& known_ops) {
+                                  const std::set<std::string>& known_ops,
+                                  const std::set<std::string>& streaming_ops = {}) {
     if (steps.empty()) return "a job needs at least one step";
 
     std::unordered_map<std::string, int> index;
@@ -26,6 +55,78 @@ inline std::string validate_steps(const std::vector<StepRecord>& steps,
         index[id] = i;
     }
 
+    // Parallel groups: consecutive steps sharing a non-empty `group` execute
+    // concurrently, so their control flow must stay structured — no branching
+    // out of a member, no jumping into the middle of a group, and no data
+    // dependency between members.
+    std::unordered_map<std::string, int> group_first, group_last;
+    for (int i = 0; i < (int)steps.size(); ++i) {
+        const StepRecord& s = steps[i];
+        if (s.group.empty()) {
+            if (s.width > 0)
+                return "step '" + s.id + "' sets width but is not in a parallel group";
+            continue;
+        }
+        auto f = group_first.find(s.group);
+        if (f == group_first.end()) {
+            group_first[s.group] = i;
+        } else if (group_last[s.group] != i - 1) {
+            return "parallel group '" + s.group + "' must be a contiguous run of steps";
+        }
+        group_last[s.group] = i;
+        if (!s.on_done.empty() || !s.branch.empty())
+            return "step '" + s.id + "' is in parallel group '" + s.group
+                   + "' and cannot use on_done or branch";
+        if (s.on_fail != kOnFailAbort && s.on_fail != kOnFailContinue)
+            return "step '" + s.id + "' is in parallel group '" + s.group
+                   + "' and must use on_fail '" + kOnFailAbort + "' or '" + kOnFailContinue + "'";
+        if (s.width < 0 || s.width > 16)
+            return "step '" + s.id + "' width must be between 1 and 16";
+    }
+    for (const auto& kv : group_first) {
+        std::set<std::string> member_ids;
+        for (int i = kv.second; i <= group_last[kv.first]; ++i)
+            member_ids.insert(steps[i].id);
+        for (int i = kv.second; i <= group_last[kv.first]; ++i) {
+            std::set<std::string> siblings = member_ids;
+            siblings.erase(steps[i].id);
+            const std::string dep = graph_detail::find_ref_to(steps[i].params, siblings);
+            if (!dep.empty())
+                return "step '" + steps[i].id + "' references '" + dep
+                       + "' from the same parallel group '" + kv.first
+                       + "' (members must be independent)";
+        }
+    }
+
+    // `stream_from` is the one sanctioned data flow between group members: a
+    // sentence-buffered channel wired by the engine, not a `${ref}` (which
+    // would need the producer's output to exist before the group starts).
+    std::set<std::string> stream_producers;
+    for (int i = 0; i < (int)steps.size(); ++i) {
+        const StepRecord& s = steps[i];
+        if (!s.params.contains("stream_from")) continue;
+        if (!s.params["stream_from"].is_string())
+            return "stream_from in step '" + s.id + "' must be a step id string";
+        const std::string from = s.params["stream_from"].get<std::string>();
+        if (!stream_producers.insert(from).second)
+            return "stream_from '" + from + "' in step '" + s.id
+                   + "' is already consumed by another step (one consumer per stream)";
+        if (s.group.empty())
+            return "step '" + s.id + "' uses stream_from outside a parallel group";
+        if (!streaming_ops.count(s.op))
+            return "op '" + s.op + "' in step '" + s.id + "' cannot consume a stream";
+        auto it = index.find(from);
+        if (it == index.end() || steps[it->second].group != s.group)
+            return "stream_from '" + from + "' in step '" + s.id
+                   + "' must name a member of the same parallel group";
+        if (it->second >= i)
+            return "stream_from '" + from + "' in step '" + s.id
+                   + "' must reference an earlier member (no stream cycles)";
+        if (!streaming_ops.count(steps[it->second].op))
+            return "stream_from '" + from + "' in step '" + s.id
+                   + "' must name a streaming-capable step";
+    }
+
     auto forward_target = [&](int from, const std::string& target,
                               const char* field) -> std::string {
         auto it = index.find(target);
@@ -35,6 +136,10 @@ inline std::string validate_steps(const std::vector<StepRecord>& steps,
         if (it->second <= from)
             return std::string(field) + " target '" + target + "' in step '" + steps[from].id
                    + "' must reference a later step (no loops)";
+        const StepRecord& t = steps[it->second];
+        if (!t.group.empty() && group_first[t.group] != it->second)
+            return std::string(field) + " target '" + target + "' in step '" + steps[from].id
+                   + "' jumps into the middle of parallel group '" + t.group + "'";
         return "";
     };
 
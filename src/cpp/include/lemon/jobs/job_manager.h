@@ -4,12 +4,14 @@
 #include "lemon/jobs/job_types.h"
 
 #include <atomic>
+#include <chrono>
 #include <condition_variable>
 #include <deque>
 #include <map>
 #include <memory>
 #include <mutex>
 #include <optional>
+#include <set>
 #include <string>
 #include <thread>
 #include <vector>
@@ -22,9 +24,39 @@ public:
     JobManager(std::string cache_dir, OpRegistry registry);
     ~JobManager();
 
-    std::string create(const std::string& name, std::vector<StepRecord> steps, json inputs);
+    struct JobSpec {
+        std::string name;
+        std::vector<StepRecord> steps;
+        json inputs;
+        int priority = 0;
+        std::string window;
+    };
+
+    struct ListQuery {
+        std::string status;
+        std::string after;
+        size_t limit = 0;
+        std::vector<std::string> fields;
+    };
+
+    std::string create(const std::string& name, std::vector<StepRecord> steps, json inputs,
+                       int priority = 0, const std::string& window = "");
+    // Admits a whole batch under one lock and one persisted snapshot; every
+    // spec is validated (with its batch index in the error) before any job
+    // is created.
+    std::vector<std::string> create_many(std::vector<JobSpec> specs);
     json list() const;
+    // Cursor-paginated listing, newest first. Returns {"jobs", "has_more"}
+    // plus "next_cursor" when a further page exists; pass next_cursor back
+    // as `after`. `fields` trims each summary to the named keys (id always
+    // stays).
+    json list(const ListQuery& query) const;
     std::optional<json> get(const std::string& id) const;
+    // Blocks until the job's revision differs from last_revision, the job
+    // disappears, or the timeout elapses. Returns the job JSON (with a
+    // "revision" field) or nullopt when the job is gone.
+    std::optional<json> wait_for_update(const std::string& id, uint64_t last_revision,
+                                        std::chrono::milliseconds timeout) const;
     bool pause(const std::string& id);
     bool interrupt(const std::string& id);
     bool resume(const std::string& id);
@@ -39,18 +71,44 @@ private:
     };
 
     void worker_main();
-    void execute(const std::string& id, const std::shared_ptr<Control>& ctrl);
+    void execute(const std::string& id, const std::shared_ptr<Control>& ctrl,
+                 bool exclusive_held);
+    // Releases the exclusive slot between ops while interactive requests are
+    // queued behind it, then re-acquires and restores the job's models.
+    void yield_slot_for_traffic(const std::string& id, const std::shared_ptr<Control>& ctrl);
+    // Run every pending member of a parallel group concurrently. Returns false
+    // when the job reached a terminal, paused, or interrupted state.
+    bool run_group(const std::string& id, const std::shared_ptr<Control>& ctrl,
+                   const std::string& group);
     void persist_locked();
+    // Appends one delta entry (changed steps + context keys) to the journal
+    // instead of rewriting the whole document; compacts into a snapshot once
+    // the journal grows past its bound.
+    void journal_locked(Job& job, const std::vector<const StepRecord*>& steps = {},
+                        const json& context_patch = json::object());
+    void touch_locked(Job& job);
     void load_from_disk();
+    void replay_journal();
     void enqueue_locked(const std::string& id);
     std::shared_ptr<Control> control_for_locked(const std::string& id);
+    void index_locked(const Job& job);
+    void unindex_locked(const std::string& id);
 
     std::string storage_path_;
+    std::string journal_path_;
     OpRegistry registry_;
 
     mutable std::mutex mutex_;
     std::condition_variable cv_;
+    mutable std::condition_variable updates_cv_;
+    uint64_t journal_seq_ = 0;
+    size_t journal_bytes_ = 0;
     std::map<std::string, Job> jobs_;
+    // jobs_ is keyed by id, which sorts by creation time, so it doubles as
+    // the creation-time index; status_index_ keeps listings O(page) when
+    // filtered.
+    std::map<JobStatus, std::set<std::string>> status_index_;
+    std::map<std::string, JobStatus> indexed_;
     std::map<std::string, std::shared_ptr<Control>> controls_;
     std::vector<std::string> order_;
     std::deque<std::string> queue_;
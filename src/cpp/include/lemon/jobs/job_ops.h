@@ -1,10 +1,12 @@
 #pragma once
 
+#include "lemon/jobs/job_stream.h"
 #include "lemon/jobs/job_types.h"
 
 #include <atomic>
 #include <functional>
 #include <map>
+#include <memory>
 #include <set>
 #include <string>
 
@@ -13,9 +15,25 @@ namespace jobs {
 
 using CancelFlag = std::atomic<bool>;
 
+// Channels for one step execution inside a parallel group. `consume` is set
+// when the step's params name a producer via `stream_from`; `produce` is set
+// when a later member consumes this step's output.
+struct StepStreams {
+    std::shared_ptr<SentenceStream> produce;
+    std::shared_ptr<SentenceStream> consume;
+};
+
 struct OpHandler {
     std::function<json(const json& params, const json& context, CancelFlag& cancel)> run;
     bool exclusive = false;
+    // Whether instances may run concurrently inside a parallel group. Ops that
+    // mutate model residency (load/unload) must stay serialized.
+    bool parallel_safe = true;
+    // Streaming-aware variant used for group members wired with `stream_from`.
+    // Ops without one fall back to `run`; the engine closes a produce channel
+    // after the member finishes either way.
+    std::function<json(const json& params, const json& context, CancelFlag& cancel,
+                       const StepStreams& streams)> run_streamed;
 };
 
 class OpRegistry {
@@ -23,6 +41,7 @@ public:
     void register_op(const std::string& name, OpHandler handler);
     const OpHandler* find(const std::string& name) const;
     std::set<std::string> names() const;
+    std::set<std::string> streaming_names() const;
 
     std::function<bool(const std::string& job_id, CancelFlag*)> begin_exclusive;
     std::function<void()> end_exclusive;
@@ -30,6 +49,9 @@ public:
     std::function<void(const std::string& job_id)> reconcile_unload;
     std::function<bool(const std::string& job_id, const json& manifest, CancelFlag*)> restore_exclusive;
     std::function<void(const std::string& job_id)> discard_exclusive;
+    // Count of interactive requests currently blocked behind the exclusive
+    // slot; jobs yield the slot between ops while this is non-zero.
+    std::function<int()> interactive_pressure;
 
 private:
     std::map<std::string, OpHandler> handlers_;
@@ -44,12 +66,19 @@ struct OpProviders {
     std::function<json(const json& params, CancelFlag& cancel)> load_op;
     std::function<json(const json& params, CancelFlag& cancel)> unload_op;
     std::function<json(const json& params, CancelFlag& cancel)> chat_op;
+    std::function<json(const json& params, CancelFlag& cancel, const StepStreams& streams)>
+        chat_stream_op;
+    std::function<json(const json& params, CancelFlag& cancel)> bench_op;
+    std::function<json(const json& params, CancelFlag& cancel)> calibrate_op;
+    std::function<json(const json& params, CancelFlag& cancel)> model_gc_op;
+    std::function<json(CancelFlag& cancel)> cache_gc_op;
 
     std::function<bool(const std::string& job_id, CancelFlag*)> begin_exclusive;
     std::function<void()> end_exclusive;
     std::function<void(const std::string& job_id)> reconcile_unload;
     std::function<bool(const std::string& job_id, const json& manifest, CancelFlag*)> restore_exclusive;
     std::function<void(const std::string& job_id)> discard_exclusive;
+    std::function<int()> interactive_pressure;
 };
 
 OpRegistry build_op_registry(OpProviders providers);
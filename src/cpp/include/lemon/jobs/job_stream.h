@@ -0,0 +1,88 @@
+#pragma once
+
+#include <atomic>
+#include <cctype>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace lemon {
+namespace jobs {
+
+// Sentence-buffered text channel between two concurrently running steps of a
+// parallel group (`stream_from`). The producer appends raw token deltas; a
+// complete sentence is released as soon as its boundary arrives, so the
+// consumer can start its own generation while the producer is still running.
+// The buffer is unbounded: a fast producer never blocks, it only widens the
+// batch the consumer drains next.
+class SentenceStream {
+public:
+    void append(const std::string& text) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        pending_ += text;
+        size_t start = 0;
+        for (size_t i = 0; i < pending_.size(); ++i) {
+            const char c = pending_[i];
+            if (c == '\n') {
+                sentences_.push_back(pending_.substr(start, i + 1 - start));
+                start = i + 1;
+                continue;
+            }
+            // A sentence mark only closes the sentence once the following
+            // character has arrived and is whitespace, so "3.14" or a
+            // trailing "." at the buffer edge never splits early.
+            if ((c == '.' || c == '!' || c == '?') && i + 1 < pending_.size()
+                && std::isspace(static_cast<unsigned char>(pending_[i + 1]))) {
+                sentences_.push_back(pending_.substr(start, i + 1 - start));
+                start = i + 1;
+            }
+        }
+        if (start > 0) {
+            pending_.erase(0, start);
+            cv_.notify_all();
+        }
+    }
+
+    void close() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!pending_.empty()) {
+            sentences_.push_back(pending_);
+            pending_.clear();
+        }
+        closed_ = true;
+        cv_.notify_all();
+    }
+
+    // Blocks until at least one sentence is available, then drains everything
+    // buffered into `out` (batching amortizes per-chunk completions when the
+    // producer runs ahead). Returns false when the stream is closed and
+    // drained, or `cancel` becomes true.
+    bool pop(std::vector<std::string>& out, const std::atomic<bool>& cancel) {
+        std::unique_lock<std::mutex> lock(mutex_);
+        out.clear();
+        while (sentences_.empty() && !closed_) {
+            if (cancel.load()) return false;
+            cv_.wait_for(lock, std::chrono::milliseconds(100));
+        }
+        if (sentences_.empty()) return false;
+        out.swap(sentences_);
+        return true;
+    }
+
+    bool is_closed() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return closed_;
+    }
+
+private:
+    mutable std::mutex mutex_;
+    std::condition_variable cv_;
+    std::string pending_;
+    std::vector<std::string> sentences_;
+    bool closed_ = false;
+};
+
+}
+}
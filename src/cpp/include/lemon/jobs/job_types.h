@@ -87,6 +87,8 @@ struct StepRecord {
     std::string on_done;
     std::vector<Case> branch;
     std::string on_fail = kOnFailAbort;
+    std::string group;
+    int width = 0;
 
     StepStatus status = StepStatus::Pending;
     bool failure_handled = false;
@@ -107,6 +109,8 @@ struct StepRecord {
         if (!on_done.empty()) j["on_done"] = on_done;
         if (!b.empty()) j["branch"] = b;
         if (on_fail != kOnFailAbort) j["on_fail"] = on_fail;
+        if (!group.empty()) j["group"] = group;
+        if (width > 0) j["width"] = width;
         if (failure_handled) j["failure_handled"] = true;
         if (!error.empty()) j["error"] = error;
         if (!output.empty()) j["output"] = output;
@@ -124,6 +128,8 @@ struct StepRecord {
         if (j.contains("branch") && j["branch"].is_array())
             for (const auto& c : j["branch"]) s.branch.push_back(Case::from_json(c));
         s.on_fail = j.value("on_fail", std::string(kOnFailAbort));
+        s.group = j.value("group", "");
+        s.width = j.value("width", 0);
         s.failure_handled = j.value("failure_handled", false);
         if (j.contains("status")) s.status = step_status_from_string(j["status"].get<std::string>());
         s.duration_ms = j.value("duration_ms", (int64_t)0);
@@ -138,6 +144,10 @@ struct Job {
     std::string name;
     JobStatus status = JobStatus::Queued;
     bool deleted = false;
+    int priority = 0;
+    // Daily local-time execution window ("HH:MM-HH:MM", may wrap midnight).
+    // Empty means the job is always eligible.
+    std::string window;
     json inputs = json::object();
     json context = json::object();
     std::vector<StepRecord> steps;
@@ -148,6 +158,9 @@ struct Job {
     std::string summary;
     std::string error;
 
+    // In-memory change counter driving update streaming; never persisted.
+    uint64_t revision = 0;
+
     json to_summary_json() const {
         int completed = 0;
         for (const auto& s : steps)
@@ -160,6 +173,8 @@ struct Job {
                   {"progress", {{"cursor", cursor},
                                 {"completed", completed},
                                 {"step_count", (int)steps.size()}}}};
+        if (priority != 0) j["priority"] = priority;
+        if (!window.empty()) j["window"] = window;
         if (!finished_at.empty()) j["finished_at"] = finished_at;
         if (!summary.empty()) j["summary"] = summary;
         if (!error.empty()) j["error"] = error;
@@ -178,6 +193,8 @@ struct Job {
                   {"cursor", cursor},
                   {"created_at", created_at}};
         if (deleted) j["deleted"] = true;
+        if (priority != 0) j["priority"] = priority;
+        if (!window.empty()) j["window"] = window;
         if (!started_at.empty()) j["started_at"] = started_at;
         if (!finished_at.empty()) j["finished_at"] = finished_at;
         if (!summary.empty()) j["summary"] = summary;
@@ -191,6 +208,8 @@ struct Job {
         job.name = j.value("name", "");
         if (j.contains("status")) job.status = job_status_from_string(j["status"].get<std::string>());
         job.deleted = j.value("deleted", false);
+        job.priority = j.value("priority", 0);
+        job.window = j.value("window", "");
         if (j.contains("inputs")) job.inputs = j["inputs"];
         if (j.contains("context")) job.context = j["context"];
         if (j.contains("steps") && j["steps"].is_array())
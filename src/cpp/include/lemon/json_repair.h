@@ -0,0 +1,55 @@
+#pragma once
+
+#include <nlohmann/json.hpp>
+
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace lemon {
+
+// Incremental structural scanner for model-emitted JSON (tool-call
+// arguments). Tracks string/escape state and the open-container stack as
+// text streams in, so a truncated payload can be closed in place instead of
+// round-tripping the whole generation back to the model for repair.
+//
+// The scan is structural only — brackets, braces, and quotes. Token-level
+// errors (bad literals, stray colons) are left for the real parser to
+// reject; repair never loosens validation, it just produces a candidate.
+class StreamingJsonValidator {
+public:
+    void feed(const std::string& chunk);
+
+    // Structurally broken beyond repair: mismatched or extra closers,
+    // trailing garbage after the top-level value, or absurd nesting.
+    bool invalid() const { return invalid_; }
+
+    // The top-level container or string has closed.
+    bool complete() const { return complete_; }
+
+    bool in_string() const { return in_string_; }
+
+    // Closers that would balance everything fed so far (finish a pending
+    // escape, close the open string, then each open container
+    // innermost-first). Empty when there is nothing to close or the input is
+    // invalid.
+    std::string closing_suffix() const;
+
+    void reset();
+
+private:
+    std::vector<char> stack_;
+    bool in_string_ = false;
+    bool escape_ = false;
+    bool invalid_ = false;
+    bool complete_ = false;
+};
+
+// Parse `text`, falling back to one bounded repair pass when it fails:
+// strip trailing commas, then append the validator's closing suffix. Returns
+// the parsed value, or an empty optional if the text is broken beyond those
+// fixes. `repaired` reports whether the fallback ran.
+std::optional<nlohmann::json> parse_or_repair_json(const std::string& text,
+                                                   bool* repaired = nullptr);
+
+} // namespace lemon
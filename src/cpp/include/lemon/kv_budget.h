@@ -0,0 +1,31 @@
+#pragma once
+
+#include <algorithm>
+
+namespace lemon {
+
+// Free memory a future co-resident slot is expected to need: a typical
+// helper model (embedding, reranker, small audio) with its context.
+constexpr double KV_BUDGET_RESERVE_PER_SLOT_GB = 2.0;
+
+// Never hand more than this share of free memory to future slots, so a
+// large slot count cannot starve the model actually being loaded.
+constexpr double KV_BUDGET_MAX_RESERVE_FRACTION = 0.25;
+
+/// Split free memory across the planned resident set.
+///
+/// Resident peers already show up in the measured free-memory figure, so the
+/// plan only reserves room for slots that are not filled yet. Returns the
+/// share of `available_gb` the incoming model may budget its KV cache
+/// against: everything minus a bounded reserve per unfilled slot.
+inline double plan_kv_budget_gb(double available_gb, int future_slots) {
+    if (available_gb <= 0.0 || future_slots <= 0) {
+        return available_gb;
+    }
+    const double reserve =
+        (std::min)(available_gb * KV_BUDGET_MAX_RESERVE_FRACTION,
+                   future_slots * KV_BUDGET_RESERVE_PER_SLOT_GB);
+    return available_gb - reserve;
+}
+
+}  // namespace lemon
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace lemon {
+
+// Latency distributions exported from /metrics as Prometheus cumulative
+// histograms, so p50/p95/p99 per endpoint and model come from
+// histogram_quantile() instead of log scraping. Label cardinality is bounded:
+// once a metric reaches its series cap, new models fold into model="other" so
+// a registry's worth of one-off models cannot bloat the scrape.
+class LatencyHistograms {
+public:
+    struct Series {
+        std::string metric;
+        std::string endpoint;  // empty for metrics recorded below the endpoint layer
+        std::string model;
+        std::string backend;
+        const double* upper_bounds = nullptr;
+        size_t bound_count = 0;
+        std::vector<uint64_t> buckets;  // per-bucket counts; overflow is not bucketed
+        uint64_t observations = 0;
+        double sum = 0.0;
+    };
+
+    LatencyHistograms() = default;
+    LatencyHistograms(const LatencyHistograms&) = delete;
+    LatencyHistograms& operator=(const LatencyHistograms&) = delete;
+
+    static LatencyHistograms& instance();
+
+    void observe_queue_wait(const std::string& endpoint, const std::string& model,
+                            const std::string& backend, double seconds);
+    void observe_backend_duration(const std::string& endpoint, const std::string& model,
+                                  const std::string& backend, double seconds);
+    void observe_time_to_first_token(const std::string& model, const std::string& backend,
+                                     double seconds);
+    void observe_tokens_per_second(const std::string& model, const std::string& backend,
+                                   double tokens_per_second);
+
+    std::vector<Series> snapshot() const;
+
+private:
+    void observe(const char* metric, const double* bounds, size_t bound_count,
+                 const std::string& endpoint, const std::string& model,
+                 const std::string& backend, double value);
+
+    mutable std::mutex mutex_;
+    std::map<std::string, Series> series_;
+    std::map<std::string, size_t> series_per_metric_;
+};
+
+} // namespace lemon
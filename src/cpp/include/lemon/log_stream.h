@@ -1,12 +1,16 @@
 #pragma once
 
+#include <chrono>
+#include <condition_variable>
 #include <cstdint>
 #include <deque>
 #include <functional>
 #include <memory>
 #include <mutex>
 #include <optional>
+#include <regex>
 #include <string>
+#include <thread>
 #include <unordered_map>
 #include <vector>
 #include "utils/aixlog.hpp"
@@ -22,35 +26,70 @@ struct LogStreamEntry {
     std::string severity;
     std::string tag;
     std::string line;
+    AixLog::Severity severity_value = AixLog::Severity::trace;
 
     json to_json() const;
 };
 
+// Per-subscriber server-side filter, compiled once at subscribe time so a
+// DEBUG-heavy server never serializes lines a dashboard will just discard.
+struct LogStreamFilter {
+    std::optional<AixLog::Severity> min_severity;
+    std::optional<std::string> tag;
+    std::optional<std::regex> pattern;
+
+    bool matches(const LogStreamEntry& entry) const;
+};
+
+// Fan-out hub behind /logs/stream. Publishing appends to per-subscriber
+// pending batches; a batch is delivered when it reaches kBatchMaxEntries or
+// when the flusher thread sweeps it after kBatchMaxDelay, so attached
+// clients cost one frame per batch instead of one write per log line.
 class LogStreamHub {
 public:
-    using SubscriberCallback = std::function<void(const LogStreamEntry&)>;
+    using SubscriberCallback = std::function<void(const std::vector<LogStreamEntry>&)>;
+
+    static constexpr size_t kBatchMaxEntries = 64;
+    static constexpr std::chrono::milliseconds kBatchMaxDelay{50};
 
     static LogStreamHub& instance();
 
     std::string subscribe_with_snapshot(SubscriberCallback callback,
                                         std::optional<uint64_t> after_seq,
-                                        std::vector<LogStreamEntry>& out_snapshot);
+                                        std::vector<LogStreamEntry>& out_snapshot,
+                                        LogStreamFilter filter = {});
     void remove_subscriber(const std::string& subscriber_id);
 
     void publish(const AixLog::Metadata& metadata, const std::string& formatted_line);
 
+    // Approximate retained bytes (ring buffer plus per-subscriber pending
+    // batches), computed on demand for the /internal/memory accounting.
+    size_t approx_bytes() const;
+
 private:
     LogStreamHub() = default;
+    ~LogStreamHub();
+
+    struct Subscriber {
+        SubscriberCallback callback;
+        LogStreamFilter filter;
+        std::vector<LogStreamEntry> pending;
+    };
 
     std::string next_subscriber_id();
+    void ensure_flusher_locked();
+    void flusher_loop();
     static std::string resolve_tag(const AixLog::Metadata& metadata);
     static std::string resolve_timestamp(const AixLog::Metadata& metadata);
 
     static constexpr size_t kMaxRetainedEntries = 5000;
 
     mutable std::mutex mutex_;
+    std::condition_variable flusher_cv_;
+    std::thread flusher_;
+    bool shutdown_ = false;
     std::deque<LogStreamEntry> entries_;
-    std::unordered_map<std::string, SubscriberCallback> subscribers_;
+    std::unordered_map<std::string, Subscriber> subscribers_;
     uint64_t next_seq_{1};
     uint64_t next_subscriber_{1};
 };
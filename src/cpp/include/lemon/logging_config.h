@@ -15,6 +15,8 @@ struct LoggingTargets {
     bool stream_hub = true;
     bool file = false;
     std::optional<std::string> file_path;
+    bool json_file = false;
+    std::optional<std::string> json_file_path;
 };
 
 LoggingTargets resolve_logging_targets(LoggingMode mode);
@@ -0,0 +1,57 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace lemon {
+namespace audio {
+
+/**
+ * Helpers for chunked transcription of long recordings: parse the uploaded
+ * WAV, plan chunk boundaries on silence (using the VAD energy kernel), and
+ * stitch the per-chunk transcripts back together. Splitting at silence means
+ * no words straddle a boundary, so stitching is plain ordered concatenation;
+ * only a hard cut (no silence found within the window) can clip a word.
+ */
+
+struct WavInfo {
+    int sample_rate = 0;
+    int channels = 0;
+    size_t data_offset = 0;  // byte offset of the PCM payload
+    size_t num_samples = 0;  // samples per channel
+};
+
+/**
+ * Parse a RIFF/WAVE header for 16-bit PCM data. Returns false for any other
+ * encoding, for truncated files, or if the payload is not 2-byte aligned.
+ */
+bool parse_wav_pcm16(const uint8_t* bytes, size_t size, WavInfo& info);
+
+struct ChunkPolicy {
+    int target_seconds = 60;   // preferred chunk length
+    int max_seconds = 90;      // hard cut if no silence found by here
+    int min_seconds = 10;      // never emit a chunk shorter than this
+    int frame_ms = 20;         // energy analysis frame
+    int min_silence_ms = 300;  // quiet run that qualifies as a cut point
+    float silence_rms_threshold = 0.01f;  // matches SimpleVAD::Config
+};
+
+/**
+ * Plan [begin, end) sample ranges covering the whole recording, cutting at
+ * the silence run nearest each chunk's target length.
+ */
+std::vector<std::pair<size_t, size_t>> plan_chunks(
+    const int16_t* samples, size_t count, int sample_rate,
+    const ChunkPolicy& policy = ChunkPolicy{});
+
+/** Serialize mono PCM16 samples as a WAV file. */
+std::vector<uint8_t> make_wav(const int16_t* samples, size_t count, int sample_rate);
+
+/** Join per-chunk transcripts in order, trimming whitespace between them. */
+std::string stitch_transcripts(const std::vector<std::string>& pieces);
+
+}  // namespace audio
+}  // namespace lemon
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <chrono>
 #include <map>
 #include <memory>
 #include <mutex>
@@ -55,6 +56,9 @@ public:
     json upsert_server_json(const json& body);
     json remove_server_json(const std::string& id);
     json connect_server_json(const std::string& id);
+    // Connect every enabled server in parallel (one thread per upstream) and
+    // report per-server outcomes; already-connected servers are no-ops.
+    json connect_all_json();
     json disconnect_server_json(const std::string& id);
     json refresh_tools_json(const std::string& id);
     json call_tool_json(const std::string& id, const json& body);
@@ -70,14 +74,27 @@ private:
         const std::map<std::string, McpServerConfig>& configs) const;
     std::string next_id_locked(const std::string& seed) const;
 
+    void invalidate_tools_cache() const;
+
     std::string cache_dir_;
     std::string config_path_;
 
     mutable std::mutex mutex_;
     std::map<std::string, McpServerConfig> configs_;
     std::map<std::string, std::shared_ptr<Runtime>> runtimes_;
+
+    // Memoized tools/list aggregation; rebuilt after the TTL or any
+    // connection/config mutation.
+    mutable std::mutex tools_cache_mutex_;
+    mutable json tools_cache_;
+    mutable std::chrono::steady_clock::time_point tools_cache_at_{};
 };
 
+// One manager per cache directory, shared between the /internal/mcp routes
+// and in-process callers such as the responses tool loop.
+std::shared_ptr<McpClientManager> get_mcp_client_manager(
+    const std::string& cache_dir);
+
 void register_mcp_client_routes(httplib::Server& server,
                                 const std::string& cache_dir);
 
@@ -8,6 +8,7 @@
 #include <httplib.h>
 #include <nlohmann/json.hpp>
 
+#include "mcp_session.h"
 #include "model_manager.h"
 #include "router.h"
 
@@ -29,17 +30,44 @@ public:
     // Must be called on a shared_ptr instance — handlers capture shared_from_this().
     void register_routes(httplib::Server& server);
 
+    // Approximate bytes retained by gateway session caches, for the
+    // /internal/memory accounting.
+    size_t session_bytes() const { return sessions_.approx_bytes(); }
+
+    // Per-request session context. `session` is the resolved Mcp-Session-Id
+    // session (null for stateless clients); `assigned_session_id` is set when
+    // an initialize in the batch allocated a new session, and must be echoed
+    // back in the Mcp-Session-Id response header.
+    struct SessionContext {
+        std::shared_ptr<McpSessionManager::Session> session;
+        std::string assigned_session_id;
+    };
+
     std::string handle_request_body(const std::string& body);
+    std::string handle_request_body(const std::string& body, SessionContext& ctx);
 
 private:
-    json dispatch_message(const json& message);
+    using ProgressFn = std::function<void(const std::string& text_delta)>;
+
+    json dispatch_message(const json& message, SessionContext& ctx);
+
+    // Streamable HTTP progress streaming: when a single tools/call request for
+    // lemonade_chat carries `params._meta.progressToken` and the client accepts
+    // text/event-stream, the response is an SSE stream of notifications/progress
+    // messages (one per generated text fragment, partial text in `message`)
+    // followed by the final JSON-RPC response. Returns false when the request
+    // doesn't qualify, leaving the buffered JSON path to handle it.
+    bool try_stream_tools_call(const httplib::Request& req, httplib::Response& res);
 
-    json handle_initialize(const json& params, const json& id);
-    json handle_tools_list(const json& id);
+    json handle_initialize(const json& params, const json& id, SessionContext& ctx);
+    json handle_tools_list(const json& id, SessionContext& ctx);
     json handle_tools_call(const json& params, const json& id);
     json handle_ping(const json& id);
 
-    json tool_chat(const json& arguments);
+    json tool_chat(const json& arguments, const ProgressFn& on_delta = nullptr);
+    // Run a streaming chat completion and reassemble it into the non-streaming
+    // chat.completion shape, invoking on_delta for each text fragment.
+    json stream_chat_completion(json openai_request, const ProgressFn& on_delta);
     json tool_transcribe_audio(const json& arguments);
     json tool_generate_image(const json& arguments);
     json tool_omni(const json& arguments);
@@ -76,6 +104,7 @@ private:
     Router* router_;
     ModelManager* model_manager_;
     EnsureLoadedFn ensure_loaded_;
+    McpSessionManager sessions_;
 };
 
 }  // namespace lemon
@@ -0,0 +1,86 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <nlohmann/json.hpp>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace lemon {
+
+using json = nlohmann::json;
+
+// Session registry for the MCP gateway (Streamable HTTP transport).
+//
+// `initialize` allocates a session and hands its id back in the
+// Mcp-Session-Id response header; later requests presenting that header get
+// the same Session object, so per-session results (initialize payload, tools
+// descriptor) are built once instead of on every call. Sessions are opt-in:
+// requests without the header keep the stateless behavior, so existing
+// clients are unaffected.
+//
+// Expired or removed session objects are reset and parked on a free list for
+// reuse; idle sessions are swept lazily on create()/find(). An in-flight
+// request holds its session via shared_ptr, so expiry never invalidates a
+// session mid-call.
+class McpSessionManager {
+public:
+    struct Session {
+        std::string id;
+        std::atomic<uint64_t> calls{0};
+
+        json cached_value(const std::string& key) {
+            std::lock_guard<std::mutex> lock(mutex);
+            auto it = cache.find(key);
+            return it == cache.end() ? json(nullptr) : it->second;
+        }
+
+        void store_cached_value(const std::string& key, json value) {
+            std::lock_guard<std::mutex> lock(mutex);
+            cache[key] = std::move(value);
+        }
+
+    private:
+        friend class McpSessionManager;
+        std::mutex mutex;
+        std::unordered_map<std::string, json> cache;
+        std::chrono::steady_clock::time_point last_used;
+    };
+
+    explicit McpSessionManager(
+        std::chrono::milliseconds idle_timeout = std::chrono::minutes(30),
+        size_t max_sessions = 1024);
+
+    std::shared_ptr<Session> create();
+    // Returns nullptr for unknown or expired ids; refreshes the idle clock
+    // otherwise.
+    std::shared_ptr<Session> find(const std::string& id);
+    bool remove(const std::string& id);
+
+    size_t size() const;
+    size_t pooled() const;
+
+    // Approximate retained bytes across all session caches, computed on
+    // demand for the /internal/memory accounting.
+    size_t approx_bytes() const;
+
+private:
+    void expire_idle_locked(std::chrono::steady_clock::time_point now);
+    void park_locked(std::shared_ptr<Session> session);
+    std::string generate_id();
+
+    const std::chrono::milliseconds idle_timeout_;
+    const size_t max_sessions_;
+
+    mutable std::mutex mutex_;
+    std::unordered_map<std::string, std::shared_ptr<Session>> sessions_;
+    std::vector<std::shared_ptr<Session>> free_pool_;
+    std::chrono::steady_clock::time_point last_sweep_;
+};
+
+}  // namespace lemon
@@ -0,0 +1,67 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+
+#include <nlohmann/json.hpp>
+
+namespace lemon {
+
+// Process-wide memory accounting behind GET /internal/memory. Subsystems
+// register a gauge reporting their approximate tracked bytes; a watchdog
+// samples process RSS and, each time it grows past another step, logs the
+// subsystems that grew most since the previous crossing. That turns "RSS
+// crept up 2GB over three weeks" into a named suspect without restarting
+// the server or attaching tools. Gauges are only evaluated on snapshot()
+// and at threshold crossings, so they may compute their size on demand.
+class MemoryAccounting {
+public:
+    static constexpr std::uint64_t kDefaultWatchdogStepBytes =
+        256ull * 1024 * 1024;
+    static constexpr int kDefaultWatchdogIntervalSeconds = 60;
+
+    static MemoryAccounting& global();
+
+    // Registering an existing name replaces its gauge. Gauges live for the
+    // process lifetime; there is no unregister.
+    void register_gauge(const std::string& subsystem,
+                        std::function<std::uint64_t()> bytes);
+
+    // {"rss_bytes": N, "subsystems": {name: bytes, ...}}
+    nlohmann::json snapshot() const;
+
+    void start_watchdog(
+        std::uint64_t step_bytes = kDefaultWatchdogStepBytes,
+        int interval_seconds = kDefaultWatchdogIntervalSeconds);
+    void stop_watchdog();
+
+    // Resident set size of this process; 0 when the platform query fails.
+    static std::uint64_t process_rss_bytes();
+
+    // Subsystems ordered by growth since `previous` (a snapshot() result),
+    // largest first, shrunk or unchanged subsystems omitted:
+    // [{"subsystem": name, "bytes": now, "grew_bytes": delta}, ...]
+    static nlohmann::json growth_report(const nlohmann::json& previous,
+                                        const nlohmann::json& current);
+
+private:
+    MemoryAccounting() = default;
+    ~MemoryAccounting();
+
+    void watchdog_loop(std::uint64_t step_bytes, int interval_seconds);
+
+    mutable std::mutex mutex_;
+    std::map<std::string, std::function<std::uint64_t()>> gauges_;
+
+    std::mutex watchdog_mutex_;
+    std::condition_variable watchdog_cv_;
+    std::thread watchdog_;
+    bool watchdog_running_ = false;
+};
+
+}  // namespace lemon
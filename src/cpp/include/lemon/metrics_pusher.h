@@ -0,0 +1,58 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+
+namespace lemon {
+
+/**
+ * Push-gateway export for machines Prometheus cannot scrape (laptops behind
+ * NAT). Periodically builds the same text exposition served on /metrics and
+ * POSTs it to a Prometheus Pushgateway grouped by job/instance. While the
+ * gateway is unreachable, payloads are spooled to disk zstd-compressed and
+ * replayed oldest-first on reconnect so fleet dashboards backfill the gap.
+ * A configurable series cap bounds per-push cardinality.
+ *
+ * Configured via the `metrics_push` section of config.json; an empty URL
+ * (the default) disables pushing entirely.
+ */
+class MetricsPusher {
+public:
+    MetricsPusher(std::function<std::string()> build_payload,
+                  const std::string& cache_dir);
+    ~MetricsPusher();
+
+    MetricsPusher(const MetricsPusher&) = delete;
+    MetricsPusher& operator=(const MetricsPusher&) = delete;
+
+    void start();
+    void stop();
+
+    // Truncates the exposition text to at most max_series sample lines,
+    // keeping comment lines that precede the cut.
+    static std::string apply_series_limit(const std::string& payload,
+                                          int max_series);
+
+private:
+    void push_loop();
+    std::string resolve_push_url() const;
+    bool push_payload(const std::string& url, const std::string& payload);
+    void spool_payload(const std::string& payload);
+    bool replay_spool(const std::string& url);
+
+    std::function<std::string()> build_payload_;
+    std::string spool_dir_;
+    bool gateway_unreachable_ = false;
+    bool series_limit_logged_ = false;
+
+    std::atomic<bool> running_{false};
+    std::condition_variable wake_cv_;
+    std::mutex wake_mutex_;
+    std::thread push_thread_;
+};
+
+} // namespace lemon
@@ -0,0 +1,52 @@
+#pragma once
+
+#include <cstdint>
+#include <map>
+#include <shared_mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace lemon {
+
+// Precomputed model-name resolver rebuilt alongside the public alias map on
+// every cache mutation. Resolution runs on every OpenAI and Ollama request,
+// so queries are one hash probe into interned IDs under a shared lock instead
+// of an ordered-map walk under the registry mutex.
+//
+// The hash is computed over the case-folded name, so an exact entry and its
+// case variants land in the same bucket. Exact matches keep their old
+// semantics; a miss additionally accepts a case-insensitive match when it is
+// unambiguous, which turns "Qwen3-4B" vs "qwen3-4b" client drift into a hit
+// instead of a model-not-found error.
+class ModelAliasIndex {
+public:
+    void rebuild(const std::map<std::string, std::string>& aliases,
+                 const std::map<std::string, std::string>& public_names);
+
+    // Alias or case variant -> canonical cache key; identity when unknown.
+    std::string resolve(const std::string& name) const;
+
+    // Canonical cache key -> public name; identity when unknown.
+    std::string public_name(const std::string& name) const;
+
+    size_t size() const;
+
+private:
+    struct FoldedHash {
+        size_t operator()(const std::string& s) const;
+    };
+
+    uint32_t intern(const std::string& id,
+                    std::unordered_map<std::string, uint32_t>& seen);
+
+    mutable std::shared_mutex mutex_;
+    std::vector<std::string> pool_;
+    std::unordered_map<std::string, uint32_t, FoldedHash> forward_;
+    // Case-folded alias -> pool index, or kAmbiguous when two distinct
+    // entries collide after folding.
+    std::unordered_map<std::string, uint32_t> folded_;
+    std::unordered_map<std::string, uint32_t, FoldedHash> reverse_;
+};
+
+} // namespace lemon
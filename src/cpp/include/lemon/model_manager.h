@@ -1,6 +1,7 @@
 #pragma once
 
 #include <stdexcept>
+#include <atomic>
 #include <cstdint>
 #include <string>
 #include <map>
@@ -11,9 +12,12 @@
 #include <functional>
 #include <memory>
 #include <nlohmann/json.hpp>
+#include "backends/hf_cache_util.h"
 #include "canonical_id.h"
 #include "directory_watcher.h"
 #include "gguf_reader.h"
+#include "model_alias_index.h"
+#include "model_search_index.h"
 #include "model_types.h"
 #include "recipe_options.h"
 
@@ -176,12 +180,20 @@ public:
     // Invalidate the models cache (e.g. after backend install/uninstall)
     void invalidate_models_cache();
 
+    // Bumped on every cache invalidation; cheap change signal for clients
+    // that would otherwise re-fetch the full model list to detect changes.
+    uint64_t models_revision() const { return models_revision_.load(); }
+
     // Get all supported models from server_models.json
     std::map<std::string, ModelInfo> get_supported_models();
 
     // Get downloaded models
     std::map<std::string, ModelInfo> get_downloaded_models();
 
+    // Query the local registry search index (name tokens, labels, recipe,
+    // capability), ranked best-match-first.
+    std::vector<ModelInfo> search_models(const std::string& query, size_t limit);
+
     // Filter models by available backends
     std::map<std::string, ModelInfo> filter_models_by_backend(
         const std::map<std::string, ModelInfo>& models);
@@ -205,6 +217,30 @@ public:
     // Delete a model
     void delete_model(const std::string& model_name);
 
+    // One filesystem tree left behind by unlink_model. When cache_root is
+    // non-empty the path is a variant inside a repo shared with other models,
+    // so removal must also clean its HF blobs and empty parent directories.
+    struct PendingDelete {
+        std::string path;
+        std::string cache_root;
+
+        nlohmann::json to_json() const;
+        static PendingDelete from_json(const nlohmann::json& j);
+    };
+
+    // Remove a model from the registry (user_models.json, caches, aliases)
+    // without touching its multi-GB files, and return the trees whose removal
+    // can run off the request thread. Backend-managed (flm) and not-downloaded
+    // models are cleaned up synchronously and return no pending work.
+    std::vector<PendingDelete> unlink_model(const std::string& model_name);
+
+    // Remove one unlinked tree, pausing between file batches so a slow
+    // filesystem is not saturated. should_continue (may be null) is polled
+    // between batches; when it returns false the walk stops early and the
+    // remaining files are left for a later GC pass. Returns bytes freed.
+    uint64_t gc_pending_delete(const PendingDelete& pending,
+                               const std::function<bool()>& should_continue);
+
     // Clean up orphaned files from multi-repo models downloaded in old layout
     nlohmann::json cleanup_orphaned_cache(bool dry_run);
 
@@ -280,6 +316,17 @@ public:
     // removed in the directory.
     void set_extra_models_dir(const std::string& dir);
 
+    // Federation: callback returning the root URLs (scheme://host:port/) of
+    // reachable peers. When set, pulls try a peer's model-file cache over the
+    // LAN before going to the remote registry.
+    using PeerUrlProvider = std::function<std::vector<std::string>()>;
+    void set_peer_url_provider(PeerUrlProvider provider);
+
+    // Locate a complete already-downloaded file matching `filename` (manifest
+    // path, matched as a path suffix) and `size` in the local model caches,
+    // for serving to federation peers. Returns empty when no match exists.
+    std::string find_local_model_file(const std::string& filename, size_t size) const;
+
     // Per-architecture default recipe options (loaded from resources).
     // Override global config defaults but are overridden by model-level recipe_options.
     json get_architecture_defaults(const std::string& architecture) const;
@@ -353,6 +400,10 @@ private:
     // Download from a JSON manifest
     void download_from_manifest(const json& manifest, std::map<std::string, std::string>& headers, DownloadProgressCallback progress_callback);
 
+    // Fetch URL for `filename` on the first peer that reports a matching
+    // complete file, or empty when no peer has it (or federation is off).
+    std::string find_peer_file_url(const std::string& filename, size_t size) const;
+
     // Download from the model's configured remote registry
     void download_from_registry(const ModelInfo& info,
                                    DownloadProgressCallback progress_callback = nullptr);
@@ -365,6 +416,7 @@ private:
     json recipe_options_;
     json architecture_defaults_;  // Per-architecture recipe option overlays (from resources)
     std::string extra_models_dir_;  // Secondary directory for GGUF model discovery
+    PeerUrlProvider peer_url_provider_;
     CloudProviderRegistry* cloud_registry_ = nullptr;  // Not owned
     std::unique_ptr<DirectoryWatcher> directory_watcher_;
 
@@ -381,9 +433,22 @@ private:
 
     mutable std::map<std::string, ModelInfo> models_cache_;
     mutable std::map<std::string, std::string> public_model_aliases_;  // public name -> canonical name
+    // Rebuilt alongside the alias map on every cache mutation; has its own
+    // lock so queries never contend on models_cache_mutex_.
+    mutable ModelSearchIndex search_index_;
+    // Hash-probe resolver over the alias maps, same rebuild-on-mutation and
+    // own-lock scheme as search_index_ so per-request resolution never waits
+    // on a registry rebuild.
+    mutable ModelAliasIndex alias_index_;
+    // Persisted snapshot-size cache so listing models doesn't rescan every
+    // snapshot tree. Lazily constructed because the cache dir is configured
+    // after startup.
+    mutable std::unique_ptr<backends::hf_cache::ScanCache> scan_cache_;
+    backends::hf_cache::ScanCache& scan_cache();
     mutable std::map<std::string, std::string> canonical_public_names_;  // canonical name -> public name
     mutable std::map<std::string, std::string> filtered_out_models_;  // model_name -> filter reason
     mutable bool cache_valid_ = false;
+    std::atomic<uint64_t> models_revision_{0};
 
     // Refresh user_models.json on-demand when a user.* lookup misses the cache.
     // This keeps startup cache warmup / external registry writes from causing
@@ -0,0 +1,81 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace lemon {
+
+class ModelManager;
+class Router;
+
+/**
+ * Predictive model warming. Records which models serve requests in which hour
+ * of the day, persists the history under the cache dir, and warms the top
+ * scoring models for the current time of day at startup and on a schedule —
+ * as long as VRAM usage stays below the auto-evict threshold.
+ */
+class ModelPreloader {
+public:
+    ModelPreloader(Router* router,
+                   ModelManager* model_manager,
+                   const std::string& cache_dir,
+                   std::function<void(const std::string&)> load_model);
+    ~ModelPreloader();
+
+    // Non-copyable
+    ModelPreloader(const ModelPreloader&) = delete;
+    ModelPreloader& operator=(const ModelPreloader&) = delete;
+
+    void start();
+    void stop();
+
+    // Called for every inference request that names a model.
+    void record_use(const std::string& model_name);
+
+    struct UsageStat {
+        int64_t last_used = 0;
+        double total_uses = 0.0;
+    };
+
+    // Per-model usage snapshot from the persisted history; total_uses is the
+    // decayed sum across all hours of day.
+    std::map<std::string, UsageStat> usage_snapshot();
+
+private:
+    struct ModelHistory {
+        std::array<double, 24> hour_counts{};
+        int64_t last_used = 0;
+    };
+
+    void scheduler_loop();
+    void warm_top_models();
+    std::vector<std::string> pick_candidates(int top_n);
+    void load_history();
+    void save_history();
+    void decay_if_new_day_locked();
+
+    Router* router_;
+    ModelManager* model_manager_;
+    std::string history_path_;
+    std::function<void(const std::string&)> load_model_;
+
+    std::mutex mutex_;
+    std::map<std::string, ModelHistory> history_;
+    int64_t last_decay_day_ = 0;
+    bool dirty_ = false;
+
+    std::atomic<bool> running_{false};
+    std::condition_variable wake_cv_;
+    std::mutex wake_mutex_;
+    std::thread scheduler_thread_;
+};
+
+} // namespace lemon
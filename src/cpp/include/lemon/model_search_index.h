@@ -0,0 +1,44 @@
+#pragma once
+
+#include <cstdint>
+#include <map>
+#include <shared_mutex>
+#include <string>
+#include <vector>
+
+namespace lemon {
+
+struct ModelSearchEntry {
+    std::string name;
+    // Searchable text besides the name: labels, recipe, capability.
+    std::vector<std::string> fields;
+};
+
+// In-memory inverted index over the local model registry. Tokens from every
+// entry's name and fields map to sorted posting lists, so prefix lookups walk
+// a key range and substring lookups scan only the token set, never the
+// registry itself. Built once per cache rebuild; queries take a shared lock
+// and are cheap enough for search-as-you-type.
+class ModelSearchIndex {
+public:
+    void rebuild(std::vector<ModelSearchEntry> entries);
+
+    // Every whitespace-separated query token must match some indexed token by
+    // exact/prefix/substring, or the compacted query must be a substring of
+    // the entry's compacted text. Results are ranked best-match-first.
+    std::vector<std::string> search(const std::string& query, size_t limit) const;
+
+    size_t size() const;
+
+private:
+    struct Entry {
+        std::string name;
+        std::string compact;
+    };
+
+    mutable std::shared_mutex mutex_;
+    std::vector<Entry> entries_;
+    std::map<std::string, std::vector<uint32_t>> token_index_;
+};
+
+} // namespace lemon
@@ -27,6 +27,8 @@ enum class ModelState {
     IN_USE,
     DOWNSIZING,
     DOWNSIZED,
+    HIBERNATING,
+    HIBERNATED,
     EVICTING,
     UNLOADED
 };
@@ -38,6 +40,8 @@ inline std::string model_state_to_string(ModelState state) {
         case ModelState::IN_USE: return "in_use";
         case ModelState::DOWNSIZING: return "downsizing";
         case ModelState::DOWNSIZED: return "downsized";
+        case ModelState::HIBERNATING: return "hibernating";
+        case ModelState::HIBERNATED: return "hibernated";
         case ModelState::EVICTING: return "evicting";
         case ModelState::UNLOADED: return "unloaded";
         default: return "unknown";
@@ -0,0 +1,91 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include <lemon/gguf_reader.h>
+
+namespace lemon {
+
+// Fixed VRAM llama-server needs beyond weights and KV cache: compute
+// buffers, backend context, and the output tensor. Conservative so a plan
+// that "just fits" does not OOM once the compute graph is allocated.
+constexpr double OFFLOAD_VRAM_OVERHEAD_GB = 1.5;
+
+/// Plan how many transformer layers to offload to the GPU.
+///
+/// Costs each layer individually: an equal share of the model weights plus
+/// that layer's KV cache at `ctx_size`, computed from the raw per-layer GGUF
+/// arrays when present (so SWA layers and hybrid SSM layers are charged their
+/// reduced cost) and from the weighted per-token average otherwise. Layers
+/// are filled from the last block downward, matching llama-server's own
+/// assignment of the final `-ngl` blocks to the GPU.
+///
+/// @return Layers to pass as `--n-gpu-layers`: 0..block_count when only part
+///         of the model fits, block_count + 1 when everything (including the
+///         output layer) fits, or -1 when the metadata or the VRAM
+///         measurement is insufficient to plan.
+inline int plan_gpu_offload_layers(const GgufMetadata& gguf,
+                                   double model_size_gb,
+                                   int64_t ctx_size,
+                                   double available_vram_gb) {
+    if (gguf.block_count <= 0 || model_size_gb <= 0.0 || ctx_size <= 0
+        || available_vram_gb <= 0.0) {
+        return -1;
+    }
+
+    const size_t n = static_cast<size_t>(gguf.block_count);
+    const double gib = 1024.0 * 1024.0 * 1024.0;
+    const double weight_bytes_per_layer = model_size_gb * gib / static_cast<double>(n);
+
+    const bool has_arrays = gguf.head_count_kv_per_layer.size() == n && gguf.key_length > 0;
+    const bool has_swa = has_arrays
+        && gguf.key_length_swa > 0 && gguf.key_length_swa < gguf.key_length
+        && gguf.sliding_window_pattern.size() == n;
+
+    std::vector<double> kv_bytes(n, 0.0);
+    if (has_arrays) {
+        for (size_t i = 0; i < n; ++i) {
+            if (gguf.full_attention_interval > 1
+                && static_cast<int64_t>(i) % gguf.full_attention_interval != 0) {
+                continue;  // SSM layer: recurrent state, no per-token KV growth
+            }
+            const double kl = (has_swa && gguf.sliding_window_pattern[i])
+                ? static_cast<double>(gguf.key_length_swa)
+                : static_cast<double>(gguf.key_length);
+            kv_bytes[i] = static_cast<double>(gguf.head_count_kv_per_layer[i])
+                        * kl * 2.0 * 2.0  // F16, K+V
+                        * static_cast<double>(ctx_size);
+        }
+    } else {
+        const double per_token = compute_weighted_kv_cache_bytes_per_token(gguf);
+        if (per_token <= 0.0) {
+            return -1;
+        }
+        const double per_layer = per_token * static_cast<double>(ctx_size)
+                               / static_cast<double>(n);
+        kv_bytes.assign(n, per_layer);
+    }
+
+    const double budget_bytes = (available_vram_gb - OFFLOAD_VRAM_OVERHEAD_GB) * gib;
+    if (budget_bytes <= 0.0) {
+        return 0;
+    }
+
+    double used_bytes = 0.0;
+    int layers = 0;
+    for (size_t i = n; i-- > 0;) {
+        const double layer_bytes = weight_bytes_per_layer + kv_bytes[i];
+        if (used_bytes + layer_bytes > budget_bytes) {
+            break;
+        }
+        used_bytes += layer_bytes;
+        ++layers;
+    }
+
+    if (layers == static_cast<int>(n)) {
+        return layers + 1;  // room for every block — offload the output layer too
+    }
+    return layers;
+}
+
+}  // namespace lemon
@@ -1,7 +1,10 @@
 #pragma once
 
+#include <atomic>
+#include <cstdint>
 #include <string>
 #include <memory>
+#include <mutex>
 #include <functional>
 #include <vector>
 #include <nlohmann/json.hpp>
@@ -16,7 +19,8 @@ using json = nlohmann::json;
 
 class OllamaApi : public std::enable_shared_from_this<OllamaApi> {
 public:
-    OllamaApi(Router* router, ModelManager* model_manager);
+    OllamaApi(Router* router, ModelManager* model_manager,
+              std::atomic<uint64_t>* models_epoch);
 
     // Must be called on a shared_ptr instance (uses shared_from_this internally)
     void register_routes(httplib::Server& server);
@@ -25,6 +29,17 @@ private:
     Router* router_;
     ModelManager* model_manager_;
 
+    // Generation counter shared with Server's /v1/models cache; bumped on any
+    // pull/delete/load/unload so both views invalidate together. Ollama
+    // clients poll tags/ps continuously, so between bumps the serialized
+    // bodies below are served without touching ModelManager or Router.
+    std::atomic<uint64_t>* models_epoch_;
+    std::mutex snapshot_cache_mutex_;
+    std::string tags_cache_body_;
+    std::string ps_cache_body_;
+    uint64_t tags_cache_epoch_ = 0;
+    uint64_t ps_cache_epoch_ = 0;
+
     // Endpoint handlers
     void handle_chat(const httplib::Request& req, httplib::Response& res);
     void handle_generate(const httplib::Request& req, httplib::Response& res);
@@ -41,14 +56,11 @@ private:
     void register_anthropic_routes(httplib::Server& server, const std::shared_ptr<OllamaApi>& self);
 
     // Helpers
+    void bump_models_epoch();
     void auto_load_model(const std::string& model, const json& request_options = json::object());
     static json extract_auto_load_options(const json& request);
     std::string normalize_model_name(const std::string& name);
     json build_ollama_model_entry(const std::string& id, const ModelInfo& info);
-    json convert_openai_chat_to_ollama(const json& openai_response, const std::string& model);
-    json convert_openai_delta_to_ollama(const json& openai_chunk, const std::string& model);
-    json convert_ollama_to_openai_chat(const json& ollama_request);
-    json convert_ollama_to_openai_completion(const json& ollama_request);
     json convert_anthropic_to_openai_chat(const json& anthropic_request, std::vector<std::string>& warnings);
     json convert_openai_chat_to_anthropic(const json& openai_response, const std::string& model, const std::vector<std::string>& warnings);
     // Common SSE → NDJSON streaming adapter
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <string>
+
+#include <nlohmann/json.hpp>
+
+namespace lemon {
+namespace ollama {
+
+using json = nlohmann::json;
+
+// Pure Ollama <-> OpenAI request/response mapping. No router, HTTP, or model
+// manager dependencies, so the translation layer can be exercised directly.
+//
+// Every function takes its document by value so callers hand over the parsed
+// request and large subtrees (messages, tools, content strings) are moved
+// into the mapped document instead of deep-copied — the mapped request is the
+// only full JSON tree built between parse and backend dispatch.
+
+// Apply sampling-option mappings (temperature, top_p, seed, stop,
+// num_predict -> max_tokens, repeat_penalty -> frequency_penalty). Reads the
+// "options" sub-object first, then top-level keys (top-level wins).
+void map_options(const json& ollama_request, json& openai_req);
+
+// Parse stringified function arguments into objects (OpenAI -> Ollama).
+json normalize_ollama_tool_calls(json tool_calls);
+
+// Stringify function-argument objects and default "type" (Ollama -> OpenAI).
+json normalize_openai_tool_calls(json tool_calls);
+
+// Ollama /api/chat request -> OpenAI chat/completions request. `model` is the
+// already-normalized model name; "stream" is set false for the caller to
+// override.
+json chat_request_to_openai(json ollama_request, const std::string& model);
+
+// Ollama /api/generate request -> OpenAI completions request.
+json completion_request_to_openai(json ollama_request, const std::string& model);
+
+// OpenAI chat response -> Ollama /api/chat response.
+json chat_response_to_ollama(json openai_response, const std::string& model);
+
+// OpenAI streaming delta chunk -> Ollama NDJSON chunk.
+json delta_to_ollama(json openai_chunk, const std::string& model);
+
+} // namespace ollama
+} // namespace lemon
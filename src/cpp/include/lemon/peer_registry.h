@@ -0,0 +1,84 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <nlohmann/json.hpp>
+
+namespace lemon {
+
+/**
+ * PeerRegistry turns the one-way UDP presence beacon into a federation
+ * membership view. It listens on the beacon port for other lemond
+ * instances on the LAN, polls each peer's /health endpoint for its
+ * loaded-model set, and answers "which peer already has this model
+ * warm?" so a request can be forwarded instead of cold-loading locally.
+ *
+ * Everything is passive and reuses existing surfaces: membership comes
+ * from the beacon broadcasts lemond already sends, and the load signal is
+ * the /health round-trip time — a peer with a saturated HTTP queue
+ * answers slowly and ranks behind an idle one.
+ *
+ * v2 beacons carry the loaded-model set in their status block, so peers
+ * sending them are tracked entirely from broadcasts; /health is then only
+ * probed occasionally for the latency signal. v1 peers (no status in the
+ * beacon) keep the original polling cadence.
+ */
+class PeerRegistry {
+public:
+    struct Peer {
+        std::string hostname;
+        std::string base_url;  // versioned prefix from the beacon, e.g. "http://10.0.0.5:8000/api/v1/"
+        std::vector<std::string> loaded_models;
+        double poll_latency_ms = 0.0;
+        bool reachable = false;
+        bool passive_state = false;  // loaded-model set comes from v2 beacons
+        uint64_t state_seq = 0;
+        int beacon_interval_s = 2;
+        std::chrono::steady_clock::time_point last_seen{};
+        std::chrono::steady_clock::time_point last_probe{};
+    };
+
+    PeerRegistry();
+    ~PeerRegistry();
+
+    void start(int beacon_port);
+    void stop();
+
+    // Invoked when a discovery probe arrives on the beacon port, so the
+    // owner can trigger an immediate beacon keyframe. Set before start().
+    void set_probe_callback(std::function<void()> callback);
+
+    bool running() const { return running_.load(); }
+
+    /// Base URL of the best reachable peer with `model` warm (lowest
+    /// poll latency), or nullopt when no peer has it.
+    std::optional<std::string> peer_with_model(const std::string& model) const;
+
+    std::vector<Peer> peers() const;
+    nlohmann::json snapshot() const;
+
+private:
+    void listen_loop(int beacon_port);
+    void poll_loop();
+    void handle_beacon_payload(const std::string& payload);
+    void prune_expired_locked();
+
+    std::string self_hostname_;
+    std::function<void()> probe_callback_;
+    std::atomic<bool> running_{false};
+    std::thread listen_thread_;
+    std::thread poll_thread_;
+    mutable std::mutex mutex_;
+    std::map<std::string, Peer> peers_;  // keyed by base_url
+};
+
+}  // namespace lemon
@@ -3,6 +3,7 @@
 #include <string>
 
 #include "router.h"
+#include "system_stats_history.h"
 
 namespace lemon {
 
@@ -13,6 +14,7 @@ struct SystemMetrics {
     double npu_percent = -1.0;
 };
 
-std::string build_prometheus_metrics(Router& router, const SystemMetrics& system_metrics);
+std::string build_prometheus_metrics(Router& router, const SystemMetrics& system_metrics,
+                                     const SystemStatsHistory* stats_history = nullptr);
 
 } // namespace lemon
@@ -0,0 +1,109 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+
+namespace lemon {
+
+/// Per-client quota enforcement ahead of Router dispatch. Each distinct
+/// credential (bearer token, or remote address for unauthenticated clients)
+/// gets its own token buckets for request rate and inference tokens, plus a
+/// concurrent-stream counter. Limits apply uniformly to every key; a value of
+/// zero disables that limit. The fast path touches only atomics under a shared
+/// lock — the exclusive lock is taken once per key, on first sight.
+///
+/// The token-per-minute bucket is post-paid: admission only requires the
+/// bucket to be non-negative, and actual usage is debited after the response,
+/// so a large completion can push a key into debt that the refill works off.
+class RateLimiter {
+public:
+    struct Limits {
+        double requests_per_second = 0.0;
+        double tokens_per_minute = 0.0;
+        int max_concurrent_streams = 0;
+    };
+
+    struct Decision {
+        bool allowed = true;
+        double limit = 0.0;
+        double remaining = 0.0;
+        int retry_after_seconds = 0;
+    };
+
+    class StreamLease {
+    public:
+        StreamLease() = default;
+        StreamLease(StreamLease&& other) noexcept
+            : limiter_(other.limiter_), key_(std::move(other.key_)) {
+            other.limiter_ = nullptr;
+        }
+        StreamLease& operator=(StreamLease&& other) noexcept {
+            if (this != &other) {
+                release();
+                limiter_ = other.limiter_;
+                key_ = std::move(other.key_);
+                other.limiter_ = nullptr;
+            }
+            return *this;
+        }
+        StreamLease(const StreamLease&) = delete;
+        StreamLease& operator=(const StreamLease&) = delete;
+        ~StreamLease() { release(); }
+
+        void release();
+
+    private:
+        friend class RateLimiter;
+        StreamLease(RateLimiter* limiter, std::string key)
+            : limiter_(limiter), key_(std::move(key)) {}
+
+        RateLimiter* limiter_ = nullptr;
+        std::string key_;
+    };
+
+    void set_limits(const Limits& limits);
+    Limits limits() const;
+    bool enabled() const;
+
+    /// Charge one request against the key's rate bucket and check the token
+    /// bucket is not in debt. Never blocks.
+    Decision admit_request(const std::string& key);
+
+    /// Reserve a concurrent-stream slot. Returns false when the key is at its
+    /// stream limit; the lease releases the slot on destruction.
+    bool acquire_stream(const std::string& key, StreamLease& lease);
+
+    /// Debit actual inference tokens after a response completes.
+    void record_tokens(const std::string& key, double tokens);
+
+    int active_streams(const std::string& key) const;
+
+    static RateLimiter& instance();
+
+private:
+    struct Bucket {
+        std::atomic<int64_t> request_level_micro{0};
+        std::atomic<int64_t> request_stamp_us{0};
+        std::atomic<int64_t> token_level_micro{0};
+        std::atomic<int64_t> token_stamp_us{0};
+        std::atomic<int> streams{0};
+    };
+
+    Bucket& bucket_for(const std::string& key);
+    void release_stream(const std::string& key);
+    static void refill(Bucket& bucket, const Limits& limits, int64_t now_us);
+
+    mutable std::shared_mutex mutex_;
+    std::map<std::string, std::unique_ptr<Bucket>> buckets_;
+
+    mutable std::mutex limits_mutex_;
+    Limits limits_;
+    std::atomic<bool> enabled_{false};
+};
+
+}  // namespace lemon
@@ -5,10 +5,13 @@
 #include <unordered_map>
 #include <mutex>
 #include <functional>
-#include <future>
 #include <atomic>
 #include <nlohmann/json.hpp>
+#include "audio_resampler.h"
+#include "jitter_buffer.h"
 #include "streaming_audio_buffer.h"
+#include "transcript_stabilizer.h"
+#include "transcription_scheduler.h"
 #include "vad.h"
 #include "utils/tcp_jsonl_client.h"
 
@@ -34,8 +37,29 @@ struct RealtimeSession {
 
     std::string session_id;
     std::string model;
+
+    // Set when the client negotiates a non-16kHz input rate via
+    // session.update; scratch vectors are reused per audio chunk
+    std::unique_ptr<audio::Resampler> input_resampler;
+    std::vector<int16_t> resample_in;
+    std::vector<int16_t> resample_out;
+
     StreamingAudioBuffer audio_buffer;
+
+    // Smooths bursty WebSocket delivery before audio reaches the ring buffer
+    // and VAD; the release/decode vectors are reused per chunk.
+    JitterBuffer jitter_buffer;
+    std::vector<int16_t> jitter_release;
+    std::vector<int16_t> decode_scratch;
+
     SimpleVAD vad;
+    std::vector<float> vad_scratch;  // Reused per VAD tick to avoid per-frame allocations
+
+    // Interim hypotheses arrive as full re-decodes; the stabilizer converts
+    // them to stable-prefix deltas. stabilizer_mutex guards it across the
+    // interim worker, final worker, and streaming read threads.
+    TranscriptStabilizer interim_stabilizer;
+    std::mutex stabilizer_mutex;
     json turn_detection_config;
     std::atomic<bool> turn_detection_enabled{true};
     std::atomic<bool> session_active{true};
@@ -49,7 +73,6 @@ struct RealtimeSession {
 
     // Interim transcription state
     int64_t last_interim_transcription_ms = 0;  // When we last fired an interim transcription
-    std::atomic<bool> interim_in_flight{false};  // Guard against overlapping interim requests
 
     // Streaming backend connection (used when backend supports IStreamingTranscriptionServer).
     // streaming_mutex guards streaming_client against concurrent forward/disconnect.
@@ -73,6 +96,12 @@ public:
     // Lower values feel more "real-time" but increase Whisper load.
     static constexpr int INTERIM_TRANSCRIPTION_CHUNK_MS = 1000;
 
+    // Worker pool size for the shared transcription scheduler. The ASR
+    // backends are subprocesses that serialize decodes internally, so a
+    // couple of in-flight requests keep them saturated; extra workers only
+    // deepen the backend's own queue.
+    static constexpr size_t TRANSCRIPTION_WORKERS = 2;
+
     explicit RealtimeSessionManager(Router* router);
     ~RealtimeSessionManager();
 
@@ -105,6 +134,13 @@ public:
      */
     void append_audio(const std::string& session_id, const std::string& base64_audio);
 
+    /**
+     * Append raw PCM16 audio bytes to a session (binary transport path).
+     * @param session_id Session to append to
+     * @param pcm16 Little-endian PCM16 audio bytes
+     */
+    void append_audio_raw(const std::string& session_id, const std::string& pcm16);
+
     /**
      * Commit the current audio buffer (force transcription).
      * @param session_id Session to commit
@@ -133,9 +169,9 @@ private:
     std::unordered_map<std::string, std::shared_ptr<RealtimeSession>> sessions_;
     mutable std::mutex sessions_mutex_;
 
-    // Pending transcription futures for clean shutdown
-    std::vector<std::future<void>> pending_transcriptions_;
-    std::mutex transcriptions_mutex_;
+    // Shared worker pool multiplexing interim and final transcriptions
+    // across all sessions
+    TranscriptionScheduler transcription_scheduler_;
 
     // Generate unique session ID
     static std::string generate_session_id();
@@ -144,6 +180,16 @@ private:
     void apply_turn_detection_config(std::shared_ptr<RealtimeSession> session,
                                      const json& turn_detection);
 
+    // Install or drop the session input resampler per the config's
+    // input_audio_sample_rate field
+    static void apply_input_sample_rate(std::shared_ptr<RealtimeSession> session,
+                                        const json& config);
+
+    // Route one decoded chunk through the session jitter buffer into the
+    // ring buffer, then run VAD on whatever was released
+    void buffer_audio(std::shared_ptr<RealtimeSession> session,
+                      const std::vector<int16_t>& samples);
+
     // Snapshot audio buffer and dispatch transcription to worker thread
     void transcribe_and_send(std::shared_ptr<RealtimeSession> session);
 
@@ -153,6 +199,11 @@ private:
     // Check whether an interim transcription should fire and trigger it
     void maybe_interim_transcribe(std::shared_ptr<RealtimeSession> session);
 
+    // Convert a PCM16 byte chunk to 16kHz via the session's resampler,
+    // reusing the session scratch vectors
+    static const std::vector<int16_t>& resample_input(
+        std::shared_ptr<RealtimeSession> session, const std::string& pcm16);
+
     // Run Whisper transcription (executes on worker thread)
     // When is_interim is true the result is sent as a delta event.
     void transcribe_wav(std::shared_ptr<RealtimeSession> session,
@@ -27,6 +27,11 @@ public:
 #endif
     static std::vector<std::string> to_cli_options(const json& raw_options);
     static std::vector<std::string> known_keys();
+    /// Check option keys and value types against the recipe's descriptor
+    /// schema. Returns one message per problem (with a nearest-key suggestion
+    /// for typos); empty means valid. Recipes without a descriptor
+    /// (collections, unknown) are not validated.
+    static std::vector<std::string> validate(const std::string& recipe, const json& options);
 private:
     json options_ = json::object();
     std::string recipe_ = "";
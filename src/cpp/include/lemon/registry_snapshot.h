@@ -0,0 +1,42 @@
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <string>
+
+#include <nlohmann/json.hpp>
+
+namespace lemon {
+namespace registry_snapshot {
+
+// Binary snapshot of a parsed registry JSON document, validated against a
+// content hash of the source text. Loading the snapshot skips the text-JSON
+// parse on startups where the source file has not changed; any mismatch
+// (different hash, older format version, truncated or corrupt file) falls
+// back to parsing the source and rewriting the snapshot, so a stale or
+// damaged snapshot can never serve wrong data.
+
+std::uint64_t hash_bytes(const std::string& bytes);
+
+// Reads a snapshot written by write_snapshot. Returns false when the file is
+// missing, malformed, from a different format version, or recorded for a
+// source whose hash differs from expected_source_hash.
+bool read_snapshot(const std::filesystem::path& path,
+                   std::uint64_t expected_source_hash,
+                   nlohmann::json& out);
+
+// Writes doc and source_hash to path via a temp file + rename so readers
+// never observe a partial snapshot. Returns false (after logging) on failure.
+bool write_snapshot(const std::filesystem::path& path,
+                    std::uint64_t source_hash,
+                    const nlohmann::json& doc);
+
+// Parses the JSON document at source_path, preferring the snapshot at
+// snapshot_path when its recorded hash matches the current source text.
+// After a successful text parse the snapshot is refreshed best-effort.
+// Throws when the source itself cannot be read or parsed.
+nlohmann::json load(const std::string& source_path,
+                    const std::filesystem::path& snapshot_path);
+
+}  // namespace registry_snapshot
+}  // namespace lemon
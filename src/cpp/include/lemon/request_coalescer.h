@@ -0,0 +1,51 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include <nlohmann/json.hpp>
+
+namespace lemon {
+
+// Deduplicates identical deterministic requests that are in flight at the same
+// time: the first arrival computes, duplicates block on the same entry and
+// share the result. Attaching to another request's computation is only safe
+// when the caller guarantees byte-identical semantics, so callers opt in per
+// request (X-Lemonade-Coalesce header) and only temperature-0 non-streaming
+// requests qualify.
+class RequestCoalescer {
+public:
+    struct Totals {
+        uint64_t requests = 0;
+        uint64_t leaders = 0;
+        uint64_t coalesced = 0;
+        uint64_t bypassed = 0;
+    };
+
+    static bool is_deterministic(const nlohmann::json& request);
+
+    nlohmann::json run(const std::string& endpoint,
+                       const nlohmann::json& request,
+                       const std::function<nlohmann::json()>& compute);
+
+    static Totals totals();
+
+private:
+    struct Entry {
+        std::mutex mutex;
+        std::condition_variable cv;
+        bool done = false;
+        nlohmann::json result;
+        std::exception_ptr error;
+    };
+
+    std::mutex mutex_;
+    std::unordered_map<std::string, std::shared_ptr<Entry>> inflight_;
+};
+
+} // namespace lemon
@@ -0,0 +1,32 @@
+#pragma once
+
+#include <string>
+
+#include <nlohmann/json.hpp>
+
+namespace lemon {
+
+// Single parse seam for the hot request handlers (chat/completions,
+// completions, embeddings, reranking, and the Ollama inference endpoints).
+// Handlers keep nlohmann::json at the boundary, so swapping in a vectorized
+// parser later only means changing this function. The happy path parses
+// without exception machinery; the diagnostic re-parse only runs for
+// malformed bodies.
+inline bool parse_request_json(const std::string& body, nlohmann::json& out,
+                               std::string* error = nullptr) {
+    out = nlohmann::json::parse(body, nullptr, /*allow_exceptions=*/false);
+    if (!out.is_discarded()) {
+        return true;
+    }
+    if (error) {
+        try {
+            [[maybe_unused]] auto reparsed = nlohmann::json::parse(body);
+            *error = "invalid JSON";
+        } catch (const nlohmann::json::parse_error& e) {
+            *error = e.what();
+        }
+    }
+    return false;
+}
+
+} // namespace lemon
@@ -0,0 +1,36 @@
+#pragma once
+
+#include <functional>
+#include <nlohmann/json.hpp>
+
+namespace lemon {
+
+using json = nlohmann::json;
+
+/// Splits a large rerank document list into chunks scored in parallel against
+/// the backend, then merges the per-chunk scores into one response with the
+/// original document indices. Requests at or below the chunk size are
+/// forwarded unchanged, so small candidate sets keep the backend's native
+/// response byte-for-byte.
+///
+/// When the request carries `top_n` and opts in with `"early_stop": true`,
+/// chunks are scored in waves and scoring stops once the top-n membership is
+/// unchanged across two consecutive waves; the response then covers only the
+/// scored documents and carries `"early_stopped": true`. Early stop is
+/// opt-in because skipped documents get no score at all.
+class RerankBatcher {
+public:
+    using BackendCall = std::function<json(const json&)>;
+
+    RerankBatcher(int chunk_docs, int parallel_chunks);
+
+    /// Blocking: returns the merged rerank response. `call` may be invoked
+    /// from up to `parallel_chunks` threads at once and must be thread-safe.
+    json reranking(const json& request, const BackendCall& call);
+
+private:
+    const int chunk_docs_;
+    const int parallel_chunks_;
+};
+
+} // namespace lemon
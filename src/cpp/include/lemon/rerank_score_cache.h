@@ -0,0 +1,63 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <list>
+#include <mutex>
+#include <nlohmann/json.hpp>
+#include <string>
+#include <unordered_map>
+
+namespace lemon {
+
+using json = nlohmann::json;
+
+/// Bounded LRU cache of per-(query, document) rerank scores, keyed by content
+/// hash and scoped to the loaded model, so repeated pairs across query
+/// reformulations skip the backend. Partial hits forward only the uncached
+/// documents and merge cached entries back in at their original indices.
+/// Requests with `early_stop` bypass the cache: an early-stopped response
+/// deliberately leaves documents unscored, which a whole-set cache layer
+/// cannot represent.
+class RerankScoreCache {
+public:
+    using BackendCall = std::function<json(const json&)>;
+
+    explicit RerankScoreCache(size_t max_entries);
+
+    /// `model_key` scopes cached scores (a registry model name pins the
+    /// checkpoint, so a rename or variant switch naturally misses). Empty
+    /// `model_key` bypasses the cache. `call` receives the request with only
+    /// the uncached documents and without `top_n`; top-n truncation happens
+    /// here after the merge.
+    json reranking(const json& request, const std::string& model_key,
+                   const BackendCall& call);
+
+private:
+    struct PairKey {
+        uint64_t lo = 0;
+        uint64_t hi = 0;
+        bool operator==(const PairKey& other) const {
+            return lo == other.lo && hi == other.hi;
+        }
+    };
+    struct PairKeyHash {
+        size_t operator()(const PairKey& key) const {
+            return static_cast<size_t>(key.lo ^ (key.hi * 0x9e3779b97f4a7c15ULL));
+        }
+    };
+    struct Entry {
+        PairKey key;
+        json result;
+    };
+
+    bool lookup(const PairKey& key, json& result);
+    void store(const PairKey& key, json result);
+
+    const size_t max_entries_;
+    std::mutex mutex_;
+    std::list<Entry> lru_;
+    std::unordered_map<PairKey, std::list<Entry>::iterator, PairKeyHash> entries_;
+};
+
+} // namespace lemon
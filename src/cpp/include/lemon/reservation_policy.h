@@ -0,0 +1,28 @@
+#pragma once
+
+#include <nlohmann/json.hpp>
+
+namespace lemon {
+
+// Reservation semantics for guaranteed-capacity models. `reserved` comes from
+// the recipe options in config.json and grants stronger residency than runtime
+// pinning: a reserved model is never an LRU victim, is skipped by the eviction
+// engine, survives the evict-all retry after a failed peer load, and cannot be
+// unpinned over the API. `reserved_dedicated_slot` additionally keeps the
+// model's backend process outside the shared residency pool, so reserving the
+// flagship does not shrink the slot budget available to other models.
+
+inline bool reservation_enabled(const nlohmann::json& recipe_options) {
+    auto it = recipe_options.find("reserved");
+    return it != recipe_options.end() && it->is_boolean() && it->get<bool>();
+}
+
+inline bool reservation_has_dedicated_slot(const nlohmann::json& recipe_options) {
+    if (!reservation_enabled(recipe_options)) {
+        return false;
+    }
+    auto it = recipe_options.find("reserved_dedicated_slot");
+    return it != recipe_options.end() && it->is_boolean() && it->get<bool>();
+}
+
+} // namespace lemon
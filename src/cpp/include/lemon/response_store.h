@@ -0,0 +1,99 @@
+#pragma once
+
+#include <cstdint>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <nlohmann/json.hpp>
+#include <string>
+#include <vector>
+
+namespace lemon {
+
+using json = nlohmann::json;
+
+// Bounded on-disk store backing background /responses runs. A background
+// request gets an id up front; generation proceeds detached and appends its
+// SSE chunks here, so clients poll (GET /responses/{id}) or replay the stream
+// from a cursor without holding a connection across the whole generation.
+// Terminal records are persisted to <root>/<id>.json and survive restart;
+// in-flight runs are lost on crash, which polling reports as the record
+// simply never completing. Thread-safe.
+class ResponseStore {
+public:
+    static constexpr size_t kDefaultMaxRecords = 64;
+
+    ResponseStore(const std::string& root_dir,
+                  size_t max_records = kDefaultMaxRecords);
+
+    // Creates a "queued" record and returns its id ("resp_<hex>").
+    std::string create(const json& request);
+
+    void mark_in_progress(const std::string& id);
+
+    // Appends one raw SSE chunk. Returns false once cancellation was
+    // requested, so the producer's sink can stop the backend stream.
+    bool append_event(const std::string& id, const std::string& chunk);
+
+    // Terminal transitions. complete() stores the final response object;
+    // finalize_from_events() derives it from the captured SSE chunks (last
+    // parseable "data:" payload carrying a "response" object), used after a
+    // streamed background run ends.
+    void complete(const std::string& id, const json& response);
+    void fail(const std::string& id, const std::string& error);
+    void finalize_from_events(const std::string& id);
+
+    // Requests cancellation. A queued record becomes "cancelled" immediately;
+    // an in-progress one transitions when its producer observes the request.
+    // Returns false for unknown or already-terminal records.
+    bool cancel(const std::string& id);
+
+    bool remove(const std::string& id);
+
+    bool exists(const std::string& id) const;
+    bool is_terminal(const std::string& id) const;
+
+    // OpenAI-shaped response object: the stored final response for completed
+    // records (id/status normalized), otherwise id/object/created_at/status
+    // plus model and error when known.
+    json get(const std::string& id) const;
+
+    // Captured SSE chunks with index >= cursor; *next_cursor advances past
+    // what was returned.
+    std::vector<std::string> events_after(const std::string& id, size_t cursor,
+                                          size_t* next_cursor) const;
+
+    size_t size() const;
+
+    // Approximate retained bytes (captured SSE chunks plus serialized
+    // request/response objects), computed on demand for /internal/memory.
+    size_t approx_bytes() const;
+
+private:
+    struct Record {
+        std::string id;
+        std::string status;  // queued|in_progress|completed|failed|cancelled
+        std::int64_t created_at = 0;
+        std::string model;
+        json request;
+        json response;
+        std::string error;
+        std::vector<std::string> events;
+        bool cancel_requested = false;
+    };
+
+    static bool is_terminal_status(const std::string& status);
+    static std::string generate_id();
+    std::string record_path(const std::string& id) const;
+    void persist_locked(const Record& record) const;
+    void evict_over_budget_locked();
+    void load_from_disk();
+
+    mutable std::mutex mutex_;
+    std::string root_dir_;
+    size_t max_records_;
+    std::map<std::string, Record> records_;
+    std::deque<std::string> creation_order_;
+};
+
+} // namespace lemon
@@ -1,6 +1,8 @@
 #pragma once
 
 #include <atomic>
+#include <chrono>
+#include <deque>
 #include <string>
 #include <memory>
 #include <map>
@@ -12,9 +14,13 @@
 #include <optional>
 #include <nlohmann/json.hpp>
 #include <httplib.h>
+#include "backend_handover.h"
+#include "request_coalescer.h"
 #include "wrapped_server.h"
 #include "model_residency.h"
 #include "model_manager.h"
+#include "stats_store.h"
+#include "stats_windows.h"
 #include "backend_manager.h"
 #include "runtime_config.h"
 
@@ -47,6 +53,7 @@ struct ModelTelemetryIdentity {
 struct ModelTelemetryRecord {
     ModelTelemetryIdentity identity;
     Telemetry telemetry;
+    json last_load_profile;
 };
 
 class EvictionEngine;
@@ -89,6 +96,20 @@ public:
 
     void unload_model(const std::string& model_name = "");  // Empty = unload all
 
+    // Binary-upgrade handover. Export drains each ready backend (bounded),
+    // detaches its process handle so shutdown will not kill it, and returns
+    // the records to persist. Adopt re-attaches to the subprocesses a
+    // previous lemond left behind; unhealthy ones are killed and skipped.
+    // Returns the number of backends adopted.
+    std::vector<HandoverRecord> export_handover_records(int drain_timeout_seconds = 10);
+    size_t adopt_handover_records(const std::vector<HandoverRecord>& records);
+
+    // Post-resume recovery: probe all live backends in parallel, cold-restart
+    // the ones the suspend wedged, and re-warm the rest so the first request
+    // after resume is served normally instead of through the nuclear path.
+    // Returns the number of backends restarted.
+    size_t recover_after_resume();
+
     std::string get_loaded_model() const;
     std::string get_loaded_recipe() const;
 
@@ -114,6 +135,10 @@ public:
 
     bool is_model_loaded(const std::string& model_name) const;
 
+    // Whether any loaded server was started from this recipe. Lets the backend
+    // upgrade prefetcher treat "no server on this recipe" as an idle window.
+    bool is_recipe_loaded(const std::string& recipe) const;
+
     RecipeOptions get_model_recipe_options(const std::string& model_name) const;
 
     ModelType get_model_type(const std::string& model_name = "") const;
@@ -127,11 +152,15 @@ public:
 
     json chat_completion(const json& request, std::atomic<bool>* cancel = nullptr);
     json completion(const json& request);
+    json chat_completion_coalesced(const json& request);
+    json completion_coalesced(const json& request);
     json embeddings(const json& request);
     json reranking(const json& request);
     json classify(const json& request);
     json get_slots();
     json slots_action(int slot_id, const std::string& action, const json& request_body);
+    json get_lora_adapters();
+    json set_lora_adapters(const json& adapters);
     json tokenize(const json& request);
     json responses(const json& request);
 
@@ -153,6 +182,12 @@ public:
 
     json get_stats() const;
 
+    // Queue visibility for GET /queue: per-model count of requests blocked on
+    // a load or exclusive transition, the load in flight (with the profiler's
+    // completed phases so far), and a ready-time estimate from the last
+    // recorded load duration of the same model.
+    json get_queue_snapshot() const;
+
     // Get loaded backend metadata and per-model telemetry for metrics rendering.
     json get_metrics_snapshot() const;
 
@@ -164,13 +199,24 @@ public:
 
     bool begin_exclusive(std::atomic<bool>* cancel = nullptr);
     void end_exclusive();
+    // Number of request threads currently blocked behind the exclusive slot.
+    int exclusive_pressure() const;
 
     std::map<std::string, bool> snapshot_loaded_models() const;
+
+    // Live backend queue stats for one loaded model (null when the model is
+    // not loaded or its backend reports no queue), and for every loaded model
+    // that reports them (model name -> stats object).
+    json get_queue_stats(const std::string& model_name) const;
+    json snapshot_queue_stats() const;
     std::map<std::string, json> unload_job_models(const std::map<std::string, int>& owned_live,
                                                   const std::map<std::string, bool>& snapshot_pins);
     int loaded_model_pid(const std::string& model_name) const;
     std::string canonical_model_name(const std::string& model_name) const;
 
+    // One-shot VRAM usage query for warm-load budgeting (negative when unknown).
+    double current_vram_usage() const;
+
     // Test hooks
     void simulate_vram_pressure(double pct);
 
@@ -187,15 +233,46 @@ private:
     mutable std::mutex telemetry_mutex_;
     Telemetry aggregate_telemetry_;
     std::map<std::string, ModelTelemetryRecord> telemetry_by_model_;
+    StatsWindows stats_windows_;
+    std::unique_ptr<StatsStore> stats_store_;
 
     // Concurrency control for load operations
     mutable std::mutex load_mutex_;              // Protects loading state and loaded_servers_
-    bool is_loading_ = false;                    // True when a load operation is in progress
-    std::condition_variable load_cv_;            // Signals when load completes
+    // Loads of distinct models on distinct devices and residency pools run
+    // concurrently; conflicting loads wait on load_cv_.
+    struct InFlightLoad {
+        std::string model_name;
+        ModelType type;
+        DeviceType device;
+        ResidencyClass residency_class;
+    };
+    std::vector<InFlightLoad> loads_in_flight_;
+    std::condition_variable load_cv_;            // Signals when a load completes
+    bool load_conflicts_locked(const InFlightLoad& candidate) const;
+    bool model_load_in_flight_locked(const std::string& model_name) const;
+    void end_load_locked(const std::string& model_name);
+
+    // Warm standby for the nuclear option: the resident set snapshotted before
+    // an evict-all is restored in the background once the failing load
+    // succeeds, busiest models first.
+    struct StandbyReloadEntry {
+        std::string model_name;
+        RecipeOptions options;
+        bool pinned = false;
+        LoadPurpose load_purpose = LoadPurpose::UserInference;
+        uint64_t request_count = 0;
+    };
+    std::vector<StandbyReloadEntry> snapshot_residents_for_standby_locked(
+        const std::string& excluding_model);
+    void start_standby_reload(std::vector<StandbyReloadEntry> entries);
+    std::thread standby_reload_thread_;
+    std::atomic<bool> standby_reload_running_{false};
+    std::atomic<bool> standby_cancel_{false};
 
     bool exclusive_active_ = false;
     std::thread::id exclusive_owner_;
     std::condition_variable exclusive_cv_;
+    std::atomic<int> exclusive_waiters_{0};
     void wait_for_slot_clearance(std::unique_lock<std::mutex>& lock);
 
     std::unique_ptr<GlobalVramMonitor> vram_monitor_;
@@ -206,8 +283,44 @@ private:
     WrappedServer* find_server_by_model_name(const std::string& model_name) const;
     WrappedServer* get_most_recent_server() const;
     void prune_unavailable_servers_locked();
-    bool reload_model_after_watchdog_reset(const std::string& requested_model, const RecipeOptions& options);
+    bool reload_model_after_watchdog_reset(const std::string& requested_model, const RecipeOptions& options,
+                                           int* retry_after_seconds = nullptr);
     bool is_watchdog_reset_response(const json& response) const;
+
+    // Sliding-window budget on automatic restarts so a crash-looping backend
+    // costs at most kRestartBudgetMax cold loads per window instead of
+    // monopolizing the device. When the budget is spent, charge() reports how
+    // long until the next restart is allowed.
+    static constexpr int kRestartBudgetMax = 10;
+    static constexpr std::chrono::minutes kRestartBudgetWindow{10};
+    bool charge_restart_budget(const std::string& model_name, int& retry_after_seconds);
+    int estimate_reload_seconds(const std::string& model_name);
+    mutable std::mutex restart_budget_mutex_;
+    std::map<std::string, std::deque<std::chrono::steady_clock::time_point>> restart_attempts_;
+    std::map<std::string, long> last_load_duration_ms_;
+
+    // Queue-state bookkeeping behind get_queue_snapshot(). Tickets bracket the
+    // time an inference request spends blocked on the load mutex; the
+    // in-flight pointers stay valid because load_model() clears them before
+    // the server object can be destroyed. queue_state_mutex_ is a leaf lock —
+    // never take load_mutex_ while holding it.
+    class QueueWaitTicket {
+    public:
+        QueueWaitTicket(Router& router, const std::string& model);
+        ~QueueWaitTicket();
+    private:
+        Router& router_;
+        std::string model_;
+    };
+    void set_load_in_flight(const std::string& model, const std::string& recipe,
+                            WrappedServer* server);
+    void clear_load_in_flight(const WrappedServer* server);
+    mutable std::mutex queue_state_mutex_;
+    std::map<std::string, int> queue_waiting_;
+    std::string load_in_flight_model_;
+    std::string load_in_flight_recipe_;
+    std::chrono::steady_clock::time_point load_in_flight_started_;
+    WrappedServer* load_in_flight_server_ = nullptr;
     int count_servers_in_pool(ModelType type, ResidencyClass residency_class,
                               const std::string& model_name) const;
     int count_pinned_servers_in_pool(ModelType type,
@@ -216,6 +329,30 @@ private:
                                                   const std::string& model_name) const;
     void ensure_residency_capacity(ModelType type, ResidencyClass residency_class,
                                    const std::string& model_name);
+    void ensure_memory_headroom_locked(const ModelInfo& model_info,
+                                       const RecipeOptions& effective_options,
+                                       const std::string& model_name);
+    // Multi-GPU boxes: pick the least-occupied eligible GPU for the load and
+    // record it as the backend device option, unless the recipe pinned one.
+    void apply_gpu_placement_locked(const ModelInfo& model_info,
+                                    const std::string& backend,
+                                    RecipeOptions& effective_options) const;
+    // Hedged cloud streaming: race the provider stream against a local model
+    // when the provider yields no token within the hedge window; the first
+    // branch to produce payload wins the client sink and the loser is aborted.
+    void run_hedged_cloud_stream(WrappedServer* cloud_server,
+                                 const std::string& hedge_model,
+                                 int hedge_after_ms,
+                                 const std::string& endpoint,
+                                 const std::string& request_body,
+                                 httplib::DataSink& sink,
+                                 WrappedServer::TelemetryCallback telemetry_callback);
+    std::atomic<uint64_t> hedge_races_total_{0};
+    std::atomic<uint64_t> hedge_cloud_wins_total_{0};
+    std::atomic<uint64_t> hedge_local_wins_total_{0};
+    std::atomic<uint64_t> hedge_failures_total_{0};
+
+    RequestCoalescer request_coalescer_;
     void transition_server_residency_locked(
         WrappedServer* server,
         ResidencyClass requested_residency_class);
@@ -225,7 +362,7 @@ private:
     WrappedServer* find_coexisting_server_by_type(ModelType type) const;
     void evict_all_npu_servers();
     void evict_server(WrappedServer* server, int timeout_seconds = -1);
-    void evict_all_servers();
+    void evict_all_servers(bool spare_reserved = false);
     // Eviction-engine entry point: physically unload a model previously marked
     // EVICTING, but only if it has not been rescued by an in-flight request
     // (see WrappedServer::try_commit_eviction). Safe against request races.
@@ -233,6 +370,7 @@ private:
     std::unique_ptr<WrappedServer> create_backend_server(const ModelInfo& model_info);
     std::string resolve_model_name(const std::string& model_name) const;
     ModelTelemetryIdentity get_telemetry_identity(WrappedServer* server) const;
+    void record_load_profile(WrappedServer* server);
     void record_telemetry_for_model(const ModelTelemetryIdentity& identity,
                                     int input_tokens,
                                     int output_tokens,
@@ -241,10 +379,10 @@ private:
     void record_prompt_tokens_for_model(const ModelTelemetryIdentity& identity, int prompt_tokens);
 
     template<typename Func>
-    auto execute_inference(const json& request, Func&& inference_func) -> decltype(inference_func(nullptr));
+    auto execute_inference(const json& request, Func&& inference_func, const char* endpoint = "other") -> decltype(inference_func(nullptr));
 
     template<typename Func>
-    void execute_streaming(const std::string& request_body, httplib::DataSink& sink, Func&& streaming_func, std::shared_ptr<telemetry::InferenceSpan> span = nullptr);
+    void execute_streaming(const std::string& request_body, httplib::DataSink& sink, Func&& streaming_func, std::shared_ptr<telemetry::InferenceSpan> span = nullptr, const char* endpoint = "other");
 };
 
 } // namespace lemon
@@ -0,0 +1,96 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <nlohmann/json.hpp>
+
+namespace lemon {
+
+enum class RouterEventKind : std::uint8_t {
+    Load,
+    LoadFailed,
+    SlotEvict,
+    MemoryEvict,
+    NuclearEvict,
+};
+
+const char* router_event_kind_to_string(RouterEventKind kind);
+
+/// Structured journal of Router decisions: why a model was loaded, evicted,
+/// or nuked, with the VRAM headroom seen at decision time. Events land in a
+/// fixed-capacity seqlock ring — recording is one fetch_add plus a slot
+/// write, no lock and no allocation, so decision sites can journal freely.
+/// A background thread persists new events in batches to a JSONL file in the
+/// cache directory so the trail survives a restart; readers snapshot the
+/// ring without blocking writers (a slot overwritten mid-read is skipped).
+class RouterJournal {
+public:
+    static constexpr size_t kCapacity = 1024;
+    static constexpr size_t kTextBytes = 160;
+
+    struct Event {
+        std::uint64_t seq = 0;
+        std::int64_t timestamp_ms = 0;
+        RouterEventKind kind = RouterEventKind::Load;
+        double vram_free_gb = -1.0;  // negative when unknown
+        char model[kTextBytes];
+        char reason[kTextBytes];
+        char trigger[kTextBytes];
+    };
+
+    static RouterJournal& instance();
+
+    void record(RouterEventKind kind,
+                const std::string& model,
+                const std::string& reason,
+                const std::string& trigger = "",
+                double vram_free_gb = -1.0);
+
+    /// Events with timestamp >= since_ms, oldest first, capped to the most
+    /// recent `limit`.
+    std::vector<Event> snapshot(std::int64_t since_ms = 0,
+                                size_t limit = kCapacity) const;
+
+    static nlohmann::json to_json(const Event& event);
+
+    /// Starts the batch writer appending new events to `path`. Idempotent.
+    void enable_persistence(const std::string& path);
+
+    /// Flushes pending events and stops the writer thread.
+    void shutdown();
+
+    ~RouterJournal();
+
+private:
+    RouterJournal();
+    RouterJournal(const RouterJournal&) = delete;
+    RouterJournal& operator=(const RouterJournal&) = delete;
+
+    struct Slot {
+        // seq + 1 once the event is readable; 0 while being (re)written.
+        std::atomic<std::uint64_t> stamp{0};
+        Event event;
+    };
+
+    void writer_loop();
+    void flush_locked();
+
+    std::array<Slot, kCapacity> slots_;
+    std::atomic<std::uint64_t> next_{0};
+
+    std::mutex persist_mutex_;
+    std::condition_variable persist_cv_;
+    std::thread writer_thread_;
+    bool stop_ = false;
+    std::string persist_path_;
+    std::uint64_t persisted_seq_ = 0;
+};
+
+} // namespace lemon
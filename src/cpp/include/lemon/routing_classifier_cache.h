@@ -0,0 +1,62 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <map>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+namespace lemon {
+
+// Bounded LRU cache for routing classifier results. Templated agent traffic
+// re-sends byte-identical prompts, so the `classifier` leaf re-runs the same
+// model over the same text on most requests; memoizing label scores removes
+// that latency. Entries are keyed by a 64-bit FNV-1a hash of (model, text),
+// with the full key kept per entry so a hash collision reads as a miss rather
+// than someone else's scores.
+class ClassifierResultCache {
+public:
+    static constexpr size_t kDefaultCapacity = 512;
+
+    explicit ClassifierResultCache(size_t capacity = kDefaultCapacity);
+
+    // Refreshes the entry's LRU position on a hit. Thread safe.
+    bool lookup(const std::string& model, const std::string& text,
+                std::map<std::string, double>& scores);
+
+    void store(const std::string& model, const std::string& text,
+               std::map<std::string, double> scores);
+
+    struct Stats {
+        uint64_t hits = 0;
+        uint64_t misses = 0;
+        size_t entries = 0;
+        size_t capacity = 0;
+    };
+    Stats stats() const;
+
+    static uint64_t hash_features(const std::string& model, const std::string& text);
+
+    // Process-wide instance shared by every per-request engine; the production
+    // Router binding and /metrics both read it.
+    static ClassifierResultCache& instance();
+
+private:
+    struct Entry {
+        uint64_t hash;
+        std::string model;
+        std::string text;
+        std::map<std::string, double> scores;
+    };
+
+    const size_t capacity_;
+    mutable std::mutex mutex_;
+    std::list<Entry> lru_;
+    std::unordered_map<uint64_t, std::list<Entry>::iterator> index_;
+    uint64_t hits_ = 0;
+    uint64_t misses_ = 0;
+};
+
+} // namespace lemon
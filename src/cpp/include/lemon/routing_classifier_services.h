@@ -15,6 +15,7 @@ class Router;
 using EnsureClassifierModelLoaded = std::function<void(const std::string& model)>;
 using RouterJsonCall = std::function<json(const json& request)>;
 using RouterModelTypeCall = std::function<ModelType(const std::string& model)>;
+using RouterQueueStatsCall = std::function<json(const std::string& model)>;
 
 ClassifierServices make_router_classifier_services(
     Router& router,
@@ -33,7 +34,8 @@ ClassifierServices make_classifier_services_from_router_calls(
     RouterJsonCall chat_completion,
     EnsureClassifierModelLoaded ensure_loaded = {},
     RouterJsonCall classify = {},
-    RouterModelTypeCall get_model_type = {});
+    RouterModelTypeCall get_model_type = {},
+    RouterQueueStatsCall queue_stats = {});
 
 std::vector<float> parse_embedding_vector(const json& response);
 std::map<std::string, double> parse_classifier_scores(const json& response);
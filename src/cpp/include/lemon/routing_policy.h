@@ -156,6 +156,12 @@ struct ClassifierServices {
     std::function<std::string(const std::string& model,
                               const std::string& prompt,
                               const std::string& input)> chat;
+
+    // Snapshot a loaded model's live backend queue stats ({"running",
+    // "waiting", "kv_cache_usage", ...}); null when the model is not loaded or
+    // its backend reports no queue. Powers the `queue` leaf. Maps to
+    // Router::get_queue_stats.
+    std::function<json(const std::string& model)> queue_stats;
 };
 
 // ---------------------------------------------------------------------------
@@ -369,7 +375,9 @@ LeafFactory make_leaf_factory(const std::map<std::string, ClassifierPtr>& classi
 // Deterministic leaf conditions (#2380): keywords_any/keywords_all, regex,
 // min_chars/max_chars, has_tools/has_images, metadata. Pure CPU, no model, no
 // tokenizer; each implements the frozen v1 semantics pinned in
-// route_policy.schema.json. Pass the result as make_leaf_factory's
+// route_policy.schema.json. Also registers the `queue` leaf, which runs no
+// classifier model but does read live backend queue stats through
+// ClassifierServices::queue_stats. Pass the result as make_leaf_factory's
 // deterministic_factories so rules can use these ops.
 NamedLeafFactories make_deterministic_leaf_factories();
 
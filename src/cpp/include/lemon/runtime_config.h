@@ -25,6 +25,7 @@ public:
     int port() const;
     std::string host() const;
     int websocket_port() const;
+    int http2_port() const;
     std::string log_level() const;
     std::string extra_models_dir() const;
     bool no_broadcast() const;
@@ -35,6 +36,44 @@ public:
     bool auto_evict() const;
     double auto_evict_threshold_pct() const;
     bool inhibit_suspend() const;
+    bool nuclear_warm_standby() const;
+    bool federation() const;
+    int http_worker_threads() const;
+    int http_max_queued_requests() const;
+    int embeddings_batch_max_texts() const;
+    int embeddings_batch_window_ms() const;
+    int rerank_chunk_docs() const;
+    int rerank_parallel_chunks() const;
+    int rerank_score_cache_entries() const;
+    int streaming_high_water_mark_kb() const;
+    int preload_top_n() const;
+    int download_parallel_connections() const;
+    bool download_direct_io() const;
+    double download_rate_limit_mbps() const;
+    double download_offhours_rate_limit_mbps() const;
+    std::string download_offhours() const;
+    std::vector<std::string> download_mirrors() const;
+    bool differential_backend_upgrades() const;
+    bool backend_upgrade_prefetch() const;
+    double model_store_quota_gb() const;
+    int variant_cache_ttl_minutes() const;
+    double quota_requests_per_second() const;
+    double quota_tokens_per_minute() const;
+    int quota_max_concurrent_streams() const;
+    int max_chat_sessions() const;
+
+    // Metrics push settings (Prometheus Pushgateway export)
+    std::string metrics_push_url() const;
+    int metrics_push_interval_s() const;
+    std::string metrics_push_job() const;
+    std::string metrics_push_instance() const;
+    int metrics_push_max_series() const;
+    int metrics_push_spool_max_files() const;
+
+    // Deterministic completion cache settings
+    bool completion_cache_enabled() const;
+    int completion_cache_ttl_hours() const;
+    int completion_cache_max_mb() const;
 
     // Telemetry settings
     bool telemetry_enabled() const;
@@ -0,0 +1,36 @@
+#pragma once
+
+#include <string>
+
+namespace lemon {
+
+// On-demand CPU profiler behind GET /internal/profile. Samples whichever
+// thread the kernel bills CPU time to (SIGPROF via ITIMER_PROF), aggregates
+// the captured stacks, and serializes them as an uncompressed pprof
+// profile.proto payload. Frames are pre-symbolized where dladdr can resolve
+// them; unresolved frames keep their address and module mapping so `pprof`
+// can symbolize offline against the lemond binary. POSIX only.
+class SamplingProfiler {
+public:
+    enum class Error {
+        None,
+        BadRequest,
+        Busy,
+        Unsupported,
+        Internal
+    };
+
+    struct Result {
+        Error error = Error::None;
+        std::string message;
+        std::string profile;
+        int samples = 0;
+        int dropped = 0;
+    };
+
+    // Blocks the calling thread for `seconds` while sampling at `hz`.
+    // Only one collection may run per process; concurrent calls fail fast.
+    static Result collect(int seconds, int hz);
+};
+
+} // namespace lemon
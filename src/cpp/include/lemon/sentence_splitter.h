@@ -0,0 +1,62 @@
+#pragma once
+
+#include <cctype>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace lemon {
+
+/**
+ * Split text into sentence-sized segments for TTS pipelining. Boundaries are
+ * sentence-ending punctuation followed by whitespace, or a newline; segments
+ * shorter than min_chars are merged forward (so "Dr." or "1." doesn't become
+ * its own synthesis request) and unbroken runs longer than max_chars are
+ * split at the last whitespace. Segments are trimmed; joining them with
+ * spaces preserves every word of the input.
+ */
+inline std::vector<std::string> split_sentences(const std::string& text,
+                                                size_t min_chars = 20,
+                                                size_t max_chars = 400) {
+    std::vector<std::string> segments;
+    std::string current;
+
+    auto flush = [&segments, &current]() {
+        const size_t begin = current.find_first_not_of(" \t\r\n");
+        if (begin != std::string::npos) {
+            const size_t end = current.find_last_not_of(" \t\r\n");
+            segments.push_back(current.substr(begin, end - begin + 1));
+        }
+        current.clear();
+    };
+
+    for (size_t i = 0; i < text.size(); ++i) {
+        const char c = text[i];
+        current.push_back(c);
+
+        const bool at_end = i + 1 >= text.size();
+        const bool next_is_space =
+            !at_end && std::isspace(static_cast<unsigned char>(text[i + 1]));
+        const bool sentence_end =
+            (c == '.' || c == '!' || c == '?' || c == ';') &&
+            (at_end || next_is_space);
+
+        if ((sentence_end || c == '\n') && current.size() >= min_chars) {
+            flush();
+        } else if (current.size() >= max_chars) {
+            const size_t split = current.find_last_of(" \t\n");
+            if (split != std::string::npos && split > 0) {
+                std::string carry = current.substr(split + 1);
+                current.erase(split);
+                flush();
+                current = std::move(carry);
+            } else {
+                flush();
+            }
+        }
+    }
+    flush();
+    return segments;
+}
+
+}  // namespace lemon
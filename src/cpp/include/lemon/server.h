@@ -7,6 +7,7 @@
 #define CPPHTTPLIB_THREAD_POOL_COUNT 64
 #endif
 
+#include <array>
 #include <string>
 #include <thread>
 #include <memory>
@@ -16,22 +17,44 @@
 #include <map>
 #include <mutex>
 #include <optional>
+#include <unordered_map>
+#include <utility>
 #include <vector>
 #include <httplib.h>
+#include "admission_controller.h"
+#include "completion_cache.h"
+#include "embeddings_batcher.h"
+#include "metrics_pusher.h"
+#include "model_preloader.h"
+#include "rerank_batcher.h"
+#include "rerank_score_cache.h"
 #include "runtime_config.h"
 #include "router.h"
 #include "routing_policy.h"
 #include "model_manager.h"
 #include "backend_manager.h"
+#include "calibration_store.h"
 #include "cloud_provider_registry.h"
+#include "image_generation_queue.h"
+#include "image_result_store.h"
+#include "peer_registry.h"
+#include "response_store.h"
+#include "session_store.h"
+#include "system_stats_history.h"
+#include "token_count_cache.h"
+#include "tts_cache.h"
 #include "upgradable_http_server.h"
+#include "http2_gateway.h"
+#include "variant_cache.h"
 #include "websocket_server.h"
 #include "lemon/utils/network_beacon.h"
+#include "lemon/utils/origin_utils.h"
 #include "lemon/system_metrics_platform.h"
 
 namespace lemon {
 
 // Forward declaration
+class McpClientManager;
 class SystemMetricsPlatform;
 
 namespace jobs {
@@ -81,6 +104,9 @@ private:
     // Setup HTTP servers (create httplib::Server instances, routes, CORS, thread pool)
     void setup_http_servers();
 
+    // Heavy startup (registry, router, backends, caches) run off the listener path
+    void initialize_components();
+
     // Stop the main-port listeners (fronts) and detach the routed servers
     void stop_http_listeners();
 
@@ -107,8 +133,14 @@ private:
     void handle_models(const httplib::Request& req, httplib::Response& res);
     void handle_model_by_id(const httplib::Request& req, httplib::Response& res);
     void handle_model_update_check(const httplib::Request& req, httplib::Response& res);
+    void handle_model_capabilities(const httplib::Request& req, httplib::Response& res);
     void handle_model_files(const httplib::Request& req, httplib::Response& res);
     void handle_chat_completions(const httplib::Request& req, httplib::Response& res);
+    // Returns the persistent cache key for a deterministic completion request,
+    // or "" when the request should not touch the cache.
+    std::string completion_cache_key_for(const std::string& endpoint,
+                                         const httplib::Request& req,
+                                         const nlohmann::json& request_json);
     // Server-side tool-calling orchestration for Omni "collection" models.
     void handle_collection_chat_completions(const nlohmann::json& request_json,
                                             const ModelInfo& collection_info,
@@ -119,6 +151,11 @@ private:
     std::optional<RouterDispatchResult> route_collection_request(
         const nlohmann::json& request_json,
         const ModelInfo& collection_info);
+    // The compiled engine for a collection.router model, served from
+    // routing_engines_ and recompiled only when the collection's parsed policy
+    // object changes. Null when the collection has no parsed policy.
+    std::shared_ptr<const RoutingPolicyEngine> compiled_routing_engine(
+        const ModelInfo& collection_info);
     // If request_json addresses a collection.router model, rewrite its "model"
     // field in place to the engine-selected candidate and return the Decision.
     // No-op otherwise.
@@ -126,20 +163,61 @@ private:
         nlohmann::json& request_json);
     void handle_completions(const httplib::Request& req, httplib::Response& res);
     void handle_embeddings(const httplib::Request& req, httplib::Response& res);
+
+    // Document ingestion: chunks whole documents server-side, schedules the
+    // chunks through the backend at full batch size, and streams one NDJSON
+    // line per chunk with its (id, chunk, offset, embedding).
+    void handle_embeddings_ingest(const httplib::Request& req, httplib::Response& res);
+
     void handle_reranking(const httplib::Request& req, httplib::Response& res);
     void handle_classify(const httplib::Request& req, httplib::Response& res);
     void handle_slots(const httplib::Request& req, httplib::Response& res);
     void handle_slots_by_id(const httplib::Request& req, httplib::Response& res);
+    void handle_adapters(const httplib::Request& req, httplib::Response& res);
+    void handle_adapters_load(const httplib::Request& req, httplib::Response& res);
     void handle_tokenize(const httplib::Request& req, httplib::Response& res);
     void handle_responses(const httplib::Request& req, httplib::Response& res);
+
+    // Server-side MCP tool execution for /responses. A {"type": "mcp"} tools
+    // entry (optionally scoped with "server_id") opts in: the entry is
+    // replaced with function tools for the registered MCP servers' tools, and
+    // non-streaming requests run a loop that executes the model's MCP tool
+    // calls against the upstream servers and continues generation without a
+    // client round trip. chat_tools maps each injected function-tool name to
+    // its (server_id, tool name) pair.
+    bool expand_mcp_request_tools(
+        nlohmann::json& request_json,
+        std::map<std::string, std::pair<std::string, std::string>>& chat_tools);
+    nlohmann::json run_responses_mcp_tool_loop(
+        nlohmann::json request_json,
+        const std::map<std::string, std::pair<std::string, std::string>>& chat_tools);
+
+    // Background /responses mode: "background": true returns the queued
+    // response object immediately, runs generation on a detached thread into
+    // response_store_, and clients poll GET /responses/{id} (or replay the
+    // captured SSE stream with ?stream=true&starting_after=N).
+    void handle_responses_background(nlohmann::json request_json,
+                                     httplib::Response& res);
+    void run_background_response(const std::string& id,
+                                 nlohmann::json request_json);
+    void handle_response_get(const httplib::Request& req, httplib::Response& res);
+    void handle_response_cancel(const httplib::Request& req, httplib::Response& res);
+    void handle_response_delete(const httplib::Request& req, httplib::Response& res);
     void handle_pull(const httplib::Request& req, httplib::Response& res);
     void handle_registry_search(const httplib::Request& req, httplib::Response& res);
     void handle_pull_variants(const httplib::Request& req, httplib::Response& res);
     void handle_load(const httplib::Request& req, httplib::Response& res);
     void handle_unload(const httplib::Request& req, httplib::Response& res);
+    void handle_prewarm(const httplib::Request& req, httplib::Response& res);
     void handle_pin(const httplib::Request& req, httplib::Response& res);
     void handle_delete(const httplib::Request& req, httplib::Response& res);
     void handle_cleanup_cache(const httplib::Request& req, httplib::Response& res);
+    void handle_store_gc(const httplib::Request& req, httplib::Response& res);
+    // Evicts least-valuable downloaded models until the store fits under the
+    // model_store_quota_gb config (no-op when the quota is 0). Deletion runs
+    // through model_gc jobs; only the registry unlink happens inline.
+    nlohmann::json enforce_store_quota(bool dry_run);
+    void maybe_enforce_store_quota();
 
     // Cloud auth (public, all four prefixes).
     //   POST /v1/cloud/auth   body: {provider, api_key}
@@ -156,12 +234,24 @@ private:
     void handle_params(const httplib::Request& req, httplib::Response& res);
     void handle_metrics(const httplib::Request& req, httplib::Response& res);
     void handle_stats(const httplib::Request& req, httplib::Response& res);
+    void handle_queue(const httplib::Request& req, httplib::Response& res);
     void handle_system_info(const httplib::Request& req, httplib::Response& res);
     void handle_system_stats(const httplib::Request& req, httplib::Response& res);
+    void handle_system_stats_history(const httplib::Request& req, httplib::Response& res);
+    void handle_router_events(const httplib::Request& req, httplib::Response& res);
     void handle_log_level(const httplib::Request& req, httplib::Response& res);
     void handle_shutdown(const httplib::Request& req, httplib::Response& res);
     void handle_simulate_vram_pressure(const httplib::Request& req, httplib::Response& res);
 
+    // Session API: lemond stores the conversation so clients send only new
+    // messages per turn; forwarded completions carry the session id that pins
+    // the conversation's KV cache to one llama-server slot.
+    void handle_sessions_create(const httplib::Request& req, httplib::Response& res);
+    void handle_sessions_list(const httplib::Request& req, httplib::Response& res);
+    void handle_sessions_get(const httplib::Request& req, httplib::Response& res);
+    void handle_sessions_delete(const httplib::Request& req, httplib::Response& res);
+    void handle_sessions_chat(const httplib::Request& req, httplib::Response& res);
+
     // Generic job-engine endpoint handlers
     void handle_jobs_create(const httplib::Request& req, httplib::Response& res);
     void handle_jobs_list(const httplib::Request& req, httplib::Response& res);
@@ -234,8 +324,24 @@ private:
         const json& model_data,
         const std::string& hf_cache);
 
-    // Audio endpoint handlers (OpenAI /v1/audio/* compatible)
-    void handle_audio_transcriptions(const httplib::Request& req, httplib::Response& res);
+    // Audio endpoint handlers (OpenAI /v1/audio/* compatible). Transcriptions
+    // take the streaming content reader so uploads spill to a temp file
+    // chunk-by-chunk instead of being buffered whole in memory.
+    void handle_audio_transcriptions(const httplib::Request& req, httplib::Response& res,
+                                     const httplib::ContentReader& content_reader);
+
+    // Long-audio fast path: split a long PCM16 WAV upload at silence, run
+    // the chunks through the backend in parallel, and stitch the results
+    // (optionally streaming per-chunk deltas as SSE). Returns false when the
+    // upload doesn't qualify, leaving the single-request path to handle it.
+    bool try_long_audio_transcription(const nlohmann::json& request_json,
+                                      bool stream, httplib::Response& res);
+
+    // Batch transcription: a JSON manifest of server-visible audio paths,
+    // fed to the backend back-to-back with per-file results streamed as
+    // NDJSON lines in manifest order.
+    void handle_audio_transcriptions_batch(const httplib::Request& req, httplib::Response& res);
+
     void handle_audio_speech(const httplib::Request& req, httplib::Response& res);
 
     // Image endpoint handlers (OpenAI /v1/images/* compatible)
@@ -244,6 +350,15 @@ private:
     void handle_image_variations(const httplib::Request& req, httplib::Response& res);
     void handle_image_upscale(const httplib::Request& req, httplib::Response& res);
 
+    // Serves stored results from GET images/{hash}; URLs are content-addressed
+    // and therefore immutable-cacheable.
+    void handle_image_get(const httplib::Request& req, httplib::Response& res);
+
+    // When the request asked for response_format "url", move each data[i]
+    // b64_json payload into the image result store and answer with its URL.
+    void externalize_image_response(const nlohmann::json& request_json,
+                                    nlohmann::json& response);
+
     // Generative-audio endpoint handler (text -> audio clip: music, SFX)
     void handle_audio_generations(const httplib::Request& req, httplib::Response& res);
     void handle_3d_generations(const httplib::Request& req, httplib::Response& res);
@@ -251,7 +366,8 @@ private:
     // Run a media generation into a buffer and respond: the bytes on success, or an
     // HTTP error if the backend produced nothing (it crashed / OOM'd / failed). This
     // avoids returning a 200 with an empty body that looks like a successful empty file.
-    void serve_media_or_error(httplib::Response& res, const std::string& mime_type,
+    // Returns true when the media was served (res.body holds the bytes).
+    bool serve_media_or_error(httplib::Response& res, const std::string& mime_type,
                               const std::function<void(httplib::DataSink&)>& generate);
 
     // Shared helpers for image multipart handlers
@@ -273,6 +389,25 @@ private:
         const json& request_options = json::object(),
         LoadPurpose load_purpose = LoadPurpose::UserInference);
 
+    // Federation: when the model is not warm locally but a discovered peer has
+    // it loaded, forward the request there instead of cold-loading. Returns
+    // true when the response was served by the peer. Non-streaming failures
+    // fall back to the local load path; a streaming forward commits once the
+    // content provider is installed.
+    bool try_peer_forward(const std::string& model,
+                          const std::string& endpoint,
+                          const nlohmann::json& request_json,
+                          bool is_streaming,
+                          httplib::Response& res);
+
+    // Federation model-file cache endpoints (/internal/model-files/*).
+    void handle_model_file_locate(const httplib::Request& req, httplib::Response& res);
+    void handle_model_file_get(const httplib::Request& req, httplib::Response& res);
+
+    // Priority class for admission: X-Lemonade-Priority header first, then the
+    // LEMONADE_BATCH_API_KEY credential mapping, defaulting to interactive.
+    RequestPriority resolve_request_priority(const httplib::Request& req) const;
+
     // Helper: persist the registry's installed-providers list into config.json
     // by overlaying onto the current runtime-config snapshot. Called after
     // install/uninstall. Errors are logged and swallowed — a failure to
@@ -294,6 +429,22 @@ private:
     // Warm model list cache in the background after startup dependencies are initialized
     void start_model_cache_warmup();
 
+    // Poll config.json for out-of-band edits and apply them live through
+    // RuntimeConfig::set, so hand-edited changes get the same validation and
+    // side effects as POST config
+    void start_config_watcher();
+    void reload_config_from_disk();
+
+    // Detect system suspend/resume via wall-clock gaps and kick off
+    // Router::recover_after_resume so post-resume requests don't hit a
+    // wedged GPU context
+    void start_resume_watcher();
+
+    // Stage new backend pins in the background and swap them in when their
+    // recipe has no loaded server, so pin bumps never interrupt serving.
+    // Gated on the backend_upgrade_prefetch config key.
+    void start_backend_upgrade_watcher();
+
     // Helper function to generate detailed model error responses (not found, not supported, load failure)
     nlohmann::json create_model_error(const std::string& requested_model, const std::string& exception_msg);
     // System stats helper methods
@@ -309,6 +460,16 @@ private:
     std::thread http_v4_thread_;
     std::thread http_v6_thread_;
     std::thread model_cache_warmup_thread_;
+    std::thread init_thread_;
+    std::thread config_watcher_thread_;
+    std::atomic<bool> config_watcher_stop_{false};
+    std::thread resume_watcher_thread_;
+    std::atomic<bool> resume_watcher_stop_{false};
+    std::atomic<bool> resume_recovery_running_{false};
+    std::thread backend_upgrade_thread_;
+    std::atomic<bool> backend_upgrade_stop_{false};
+    std::atomic<bool> backend_upgrade_check_requested_{false};
+    std::atomic<bool> components_ready_{false};
 
 
     // Routed servers (all routes/handlers; never listen) and the main-port
@@ -318,16 +479,69 @@ private:
     std::unique_ptr<UpgradableFrontServer> http_front_;
     std::unique_ptr<UpgradableFrontServer> http_front_v6_;
 
+    // Shared across the v4/v6 listeners' BoundedTaskQueues; drives overload
+    // shedding in the pre-routing handler.
+    std::shared_ptr<std::atomic<size_t>> http_pending_;
+    size_t http_queue_depth_ = 0;
+
     std::unique_ptr<Router> router_;
+    std::unique_ptr<EmbeddingsBatcher> embeddings_batcher_;
+    std::unique_ptr<RerankBatcher> rerank_batcher_;
+    std::unique_ptr<RerankScoreCache> rerank_score_cache_;
+    std::unique_ptr<ModelPreloader> model_preloader_;
     std::unique_ptr<ModelManager> model_manager_;
     std::unique_ptr<BackendManager> backend_manager_;
     std::unique_ptr<CloudProviderRegistry> cloud_registry_;
+    std::shared_ptr<McpClientManager> mcp_client_manager_;
     std::unique_ptr<WebSocketServer> websocket_server_;
+    std::unique_ptr<Http2Gateway> http2_gateway_;
+    std::unique_ptr<ImageGenerationQueue> image_queue_;
+    std::unique_ptr<ImageResultStore> image_result_store_;
+    std::unique_ptr<TtsCache> tts_cache_;
+    std::unique_ptr<CompletionCache> completion_cache_;
+    std::unique_ptr<ResponseStore> response_store_;
+    std::unique_ptr<VariantCache> variant_cache_;
+    std::unique_ptr<CalibrationStore> calibration_store_;
+    std::unique_ptr<SystemStatsHistory> stats_history_;
+    std::unique_ptr<MetricsPusher> metrics_pusher_;
     std::unique_ptr<lemon::jobs::JobManager> job_manager_;
+    SessionStore session_store_;
+    TokenCountCache token_count_cache_;
 
     std::mutex downloads_mutex_;
     std::map<std::string, std::shared_ptr<DownloadJob>> download_jobs_;
 
+    // Pre-serialized /models response per variant (index 0: downloaded only,
+    // 1: show_all). A cached entry is valid while its epoch matches
+    // models_cache_epoch_; anything that changes the model list bumps the
+    // epoch via invalidate_models_cache().
+    void invalidate_models_cache();
+    std::mutex models_cache_mutex_;
+    std::array<std::string, 2> models_cache_body_;
+    std::array<std::string, 2> models_cache_etag_;
+    std::array<uint64_t, 2> models_cache_epoch_cached_{{0, 0}};
+    std::atomic<uint64_t> models_cache_epoch_{1};
+
+    // Compiled routing engine per collection.router model. The engine compiles
+    // every rule's match tree (pre-lowered keywords, pre-built regexes,
+    // resolved classifiers) and is immutable and shareable after construction,
+    // so it's built once per policy rather than per request. ModelManager
+    // allocates a fresh RoutePolicy on every cache rebuild, so pointer
+    // identity of the shared policy is the recompile trigger.
+    struct CompiledRoutingEngine {
+        std::shared_ptr<const RoutePolicy> policy;
+        std::shared_ptr<const RoutingPolicyEngine> engine;
+    };
+    std::mutex routing_engines_mutex_;
+    std::map<std::string, CompiledRoutingEngine> routing_engines_;
+
+    // Exact-path routes under the four version prefixes. A single catch-all
+    // per method strips the prefix and does one hash lookup instead of
+    // httplib scanning four route entries per endpoint.
+    void dispatch_versioned_route(const httplib::Request& req, httplib::Response& res, bool is_get);
+    std::unordered_map<std::string, httplib::Server::Handler> versioned_get_routes_;
+    std::unordered_map<std::string, httplib::Server::Handler> versioned_post_routes_;
+
     bool running_;
     bool startup_failed_ = false;
     std::atomic<bool> shutdown_requested_{false};
@@ -336,7 +550,10 @@ private:
 
     std::string api_key_;
     std::string admin_api_key_;
+    std::string batch_api_key_;
+    utils::OriginAllowCache origin_allow_cache_;
     NetworkBeacon udp_beacon_;
+    std::unique_ptr<PeerRegistry> peer_registry_;
 
     // CPU usage tracking
 #if defined(__linux__) || defined(_WIN32)
@@ -1,5 +1,8 @@
 #pragma once
 
+#include <cstdint>
+#include <type_traits>
+
 #include <nlohmann/json.hpp>
 #include <httplib.h>
 
@@ -10,6 +13,15 @@ using json = nlohmann::json;
 class ICapability {
 public:
     virtual ~ICapability() = default;
+
+    // Precomputed capability bitmask (see capability_mask_of below). Stamped
+    // by the backend registry at create(); zero for instances built outside
+    // it, which fall back to dynamic_cast in supports_capability.
+    uint32_t capability_mask() const { return capability_mask_; }
+    void set_capability_mask(uint32_t mask) { capability_mask_ = mask; }
+
+private:
+    uint32_t capability_mask_ = 0;
 };
 
 class ICompletionServer : public virtual ICapability {
@@ -97,15 +109,111 @@ public:
     virtual json slots_action(int slot_id, const std::string& action, const json& request_body) = 0;
 };
 
+// Runtime LoRA adapter control. Adapters are declared at load time; switching
+// only rescales them, so the base weights never reload.
+class ILoraAdapterServer : public virtual ICapability {
+public:
+    virtual ~ILoraAdapterServer() = default;
+    virtual json get_lora_adapters() = 0;
+    virtual json set_lora_adapters(const json& adapters) = 0;
+};
+
 class ITokenizerServer : public virtual ICapability {
 public:
     virtual ~ITokenizerServer() = default;
     virtual json tokenize(const json& request_body) = 0;
 };
 
+// One bit per capability interface. Extending: add the specialization here
+// and the interface to detail::AllCapabilities; the static_asserts below
+// catch a bit collision or a list entry without a bit.
+template <typename T> struct CapabilityBit;
+template <> struct CapabilityBit<ICompletionServer>             { static constexpr uint32_t value = 1u << 0; };
+template <> struct CapabilityBit<IEmbeddingsServer>             { static constexpr uint32_t value = 1u << 1; };
+template <> struct CapabilityBit<IRerankingServer>              { static constexpr uint32_t value = 1u << 2; };
+template <> struct CapabilityBit<ITranscriptionServer>          { static constexpr uint32_t value = 1u << 3; };
+template <> struct CapabilityBit<IStreamingTranscriptionServer> { static constexpr uint32_t value = 1u << 4; };
+template <> struct CapabilityBit<ITextToSpeechServer>           { static constexpr uint32_t value = 1u << 5; };
+template <> struct CapabilityBit<IClassificationServer>         { static constexpr uint32_t value = 1u << 6; };
+template <> struct CapabilityBit<IImageServer>                  { static constexpr uint32_t value = 1u << 7; };
+template <> struct CapabilityBit<IAudioGenerationServer>        { static constexpr uint32_t value = 1u << 8; };
+template <> struct CapabilityBit<IModel3DServer>                { static constexpr uint32_t value = 1u << 9; };
+template <> struct CapabilityBit<ISlotsServer>                  { static constexpr uint32_t value = 1u << 10; };
+template <> struct CapabilityBit<ILoraAdapterServer>            { static constexpr uint32_t value = 1u << 11; };
+template <> struct CapabilityBit<ITokenizerServer>              { static constexpr uint32_t value = 1u << 12; };
+
+namespace detail {
+
+template <typename... Is> struct CapabilityList {};
+
+using AllCapabilities = CapabilityList<
+    ICompletionServer, IEmbeddingsServer, IRerankingServer,
+    ITranscriptionServer, IStreamingTranscriptionServer, ITextToSpeechServer,
+    IClassificationServer, IImageServer, IAudioGenerationServer,
+    IModel3DServer, ISlotsServer, ILoraAdapterServer, ITokenizerServer>;
+
+template <typename Class, typename... Is>
+constexpr uint32_t capability_mask_impl(CapabilityList<Is...>) {
+    return ((std::is_base_of_v<Is, Class> ? CapabilityBit<Is>::value : 0u) |
+            ... | 0u);
+}
+
+template <typename Class, typename... Is>
+constexpr bool mask_matches_impl(CapabilityList<Is...>) {
+    return ((((capability_mask_impl<Class>(CapabilityList<Is...>{}) &
+               CapabilityBit<Is>::value) != 0) ==
+             std::is_base_of_v<Is, Class>) &&
+            ...);
+}
+
+template <typename... Is>
+constexpr bool bits_distinct_impl(CapabilityList<Is...>) {
+    uint32_t seen = 0;
+    bool distinct = true;
+    ((distinct = distinct && CapabilityBit<Is>::value != 0 &&
+                 (seen & CapabilityBit<Is>::value) == 0,
+      seen |= CapabilityBit<Is>::value),
+     ...);
+    return distinct;
+}
+
+static_assert(bits_distinct_impl(AllCapabilities{}),
+              "capability bits must be non-zero and pairwise distinct");
+
+} // namespace detail
+
+// Capability bitmask of a concrete server class, derived from its
+// inheritance graph at compile time.
+template <typename Class>
+constexpr uint32_t capability_mask_of() {
+    return detail::capability_mask_impl<Class>(detail::AllCapabilities{});
+}
+
+// Per-class harness: every bit in the mask corresponds to an inherited
+// capability interface and vice versa. Asserted at registration so the mask
+// derivation can never drift from the inheritance graph.
+template <typename Class>
+constexpr bool capability_mask_matches_inheritance() {
+    return detail::mask_matches_impl<Class>(detail::AllCapabilities{});
+}
+
 template<typename T>
 bool supports_capability(ICapability* server) {
+    if (server == nullptr) {
+        return false;
+    }
+    if (const uint32_t mask = server->capability_mask()) {
+        return (mask & CapabilityBit<T>::value) != 0;
+    }
     return dynamic_cast<T*>(server) != nullptr;
 }
 
+// dynamic_cast that consults the mask first. A negative dynamic_cast walks
+// the whole RTTI graph, so ruling it out with one bit test keeps
+// per-request capability dispatch flat.
+template<typename T>
+T* capability_cast(ICapability* server) {
+    return supports_capability<T>(server) ? dynamic_cast<T*>(server) : nullptr;
+}
+
 } // namespace lemon
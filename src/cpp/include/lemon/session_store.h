@@ -0,0 +1,66 @@
+#pragma once
+
+#include <nlohmann/json.hpp>
+
+#include <cstdint>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+
+namespace lemon {
+
+// In-memory conversation store behind the /sessions API. lemond keeps the
+// history so clients send only their newest messages each turn; every
+// forwarded completion carries the session id that SlotAffinity uses to pin
+// the conversation's KV cache to one llama-server slot.
+class SessionStore {
+public:
+    struct Snapshot {
+        std::string id;
+        std::string model;
+        nlohmann::json messages;
+        uint64_t turns = 0;
+    };
+
+    // Creates a session and evicts least recently used sessions beyond
+    // `budget` (values below 1 are treated as 1). Returns the new id.
+    std::string create(const std::string& model,
+                       const nlohmann::json& initial_messages,
+                       int budget);
+
+    std::optional<Snapshot> get(const std::string& id);
+
+    // Appends `new_messages` (array of message objects) and returns the full
+    // history snapshot, refreshing the session's LRU position. Empty optional
+    // for an unknown id.
+    std::optional<Snapshot> append(const std::string& id,
+                                   const nlohmann::json& new_messages);
+
+    bool remove(const std::string& id);
+
+    // Summaries (id, model, message_count, turns) ordered most recent first.
+    nlohmann::json list() const;
+
+    size_t size() const;
+
+    // Approximate retained bytes (serialized history sizes), computed on
+    // demand for the /internal/memory accounting.
+    size_t approx_bytes() const;
+
+private:
+    struct Session {
+        std::string model;
+        nlohmann::json messages;
+        uint64_t turns = 0;
+        uint64_t last_used = 0;
+    };
+
+    static Snapshot snapshot_of(const std::string& id, const Session& session);
+
+    mutable std::mutex mutex_;
+    std::unordered_map<std::string, Session> sessions_;
+    uint64_t use_counter_ = 0;
+};
+
+} // namespace lemon
@@ -0,0 +1,67 @@
+#pragma once
+
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace lemon {
+
+// Steers requests toward the llama-server slot whose KV cache holds the
+// longest prefix of the incoming prompt. llama-server keeps one KV cache per
+// slot but picks slots without looking at cache contents, so agentic
+// workloads (shared long system prompt, many concurrent conversations)
+// re-prefill constantly once `--parallel` > 1. The tracker remembers a
+// rolling-hash fingerprint of the prompt last resident in each slot and
+// returns the slot id to pin via the request's `id_slot` field.
+class SlotAffinity {
+public:
+    explicit SlotAffinity(int slot_count);
+
+    // Picks the slot with the longest cached prompt prefix (least recently
+    // used on a tie or a miss) and records `prompt_signature` as resident
+    // there. Thread safe.
+    int pick_slot(const std::string& prompt_signature);
+
+    // Sticky variant: the first request carrying `session_id` is placed via
+    // prefix matching and pins its slot; later requests reuse that slot no
+    // matter how the prompt grew, so a multi-turn conversation re-prefills
+    // only its newest turn. The pin survives until another request steals
+    // the slot. Thread safe.
+    int pick_slot_for_session(const std::string& session_id,
+                              const std::string& prompt_signature);
+
+    // Forgets all slot contents. Call whenever the backend's KV caches are
+    // gone (process restart, slot erase).
+    void reset();
+
+    int slot_count() const { return slot_count_; }
+
+    struct Stats {
+        uint64_t requests = 0;
+        uint64_t prefix_hits = 0;
+        uint64_t prefix_chars_reused = 0;
+    };
+
+    // Process-wide totals across all tracker instances, for /metrics.
+    static Stats totals();
+
+private:
+    struct Slot {
+        std::vector<uint64_t> block_hashes;
+        std::string session;
+        uint64_t last_used = 0;
+    };
+
+    static std::vector<uint64_t> fingerprint(const std::string& prompt_signature);
+
+    // Longest-prefix / LRU selection plus hit accounting. Caller holds mutex_.
+    size_t choose_slot_locked(const std::vector<uint64_t>& hashes);
+
+    const int slot_count_;
+    mutable std::mutex mutex_;
+    std::vector<Slot> slots_;
+    uint64_t use_counter_ = 0;
+};
+
+} // namespace lemon
@@ -0,0 +1,25 @@
+#pragma once
+
+#include <cstdint>
+#include <nlohmann/json.hpp>
+
+namespace lemon {
+
+// Process-wide speculative-decoding counters. llama-server reports per-request
+// draft totals in the response `timings` block (`draft_n` drafted,
+// `draft_n_accepted` kept); both the non-streaming forward path and the
+// streaming proxy feed them here so /metrics can expose the acceptance rate.
+class SpeculativeStats {
+public:
+    static void record(uint64_t drafted, uint64_t accepted);
+    static void record_from_timings(const nlohmann::json& timings);
+
+    struct Totals {
+        uint64_t drafted = 0;
+        uint64_t accepted = 0;
+    };
+
+    static Totals totals();
+};
+
+} // namespace lemon
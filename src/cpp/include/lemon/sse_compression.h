@@ -0,0 +1,52 @@
+#pragma once
+
+#include <cstdint>
+
+#include <httplib.h>
+
+namespace lemon {
+
+/**
+ * Streaming zstd compression for SSE responses. httplib negotiates encodings
+ * for buffered responses on its own, but excludes text/event-stream, so
+ * streamed token traffic to remote clients goes uncompressed. When the client
+ * advertises zstd in Accept-Encoding, wrap() swaps the response body for a
+ * compressed stream: every chunk is flushed as a complete zstd block so events
+ * still arrive token-by-token. Compression contexts are pooled and reused
+ * across requests; totals() reports the CPU-vs-bytes tradeoff for /metrics.
+ */
+class SseCompression {
+public:
+    static bool client_accepts_zstd(const httplib::Request& req);
+
+    // Returns a sink that compresses into `downstream`. The wrapper frame is
+    // finished when the caller invokes done()/done_with_trailer(); the caller
+    // must keep `downstream` and the returned context alive for the duration
+    // of the stream, which set_sse_headers-style provider lambdas already do.
+    class Stream {
+    public:
+        Stream();
+        ~Stream();
+        Stream(const Stream&) = delete;
+        Stream& operator=(const Stream&) = delete;
+
+        bool write(httplib::DataSink& downstream, const char* data, size_t length);
+        bool finish(httplib::DataSink& downstream);
+
+    private:
+        void* cctx_ = nullptr;
+        bool finished_ = false;
+    };
+
+    struct Totals {
+        uint64_t streams = 0;
+        uint64_t bytes_in = 0;
+        uint64_t bytes_out = 0;
+        uint64_t cpu_micros = 0;
+        uint64_t ctx_pool_hits = 0;
+        uint64_t ctx_pool_misses = 0;
+    };
+    static Totals totals();
+};
+
+} // namespace lemon
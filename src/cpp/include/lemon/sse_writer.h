@@ -0,0 +1,95 @@
+#pragma once
+
+#include <string>
+
+#include <httplib.h>
+#include <nlohmann/json.hpp>
+
+namespace lemon {
+
+// Shared SSE framing. Streaming endpoints used to rebuild
+// "data: " + payload + "\n\n" with fresh temporaries per event; these helpers
+// append into a caller-provided buffer instead, so a buffer reused across
+// events stops allocating once it has grown to the largest frame seen.
+
+inline void append_sse_data(std::string& out, const std::string& payload) {
+    out.reserve(out.size() + payload.size() + 8);
+    out.append("data: ");
+    out.append(payload);
+    out.append("\n\n");
+}
+
+inline void append_sse_data(std::string& out, const nlohmann::json& payload) {
+    append_sse_data(out, payload.dump());
+}
+
+inline void append_sse_event(std::string& out, const std::string& event,
+                             const std::string& payload) {
+    out.reserve(out.size() + event.size() + payload.size() + 16);
+    out.append("event: ");
+    out.append(event);
+    out.append("\ndata: ");
+    out.append(payload);
+    out.append("\n\n");
+}
+
+inline void append_sse_event(std::string& out, const std::string& event,
+                             const nlohmann::json& payload) {
+    append_sse_event(out, event, payload.dump());
+}
+
+inline void append_sse_comment(std::string& out, const std::string& text) {
+    out.append(": ");
+    out.append(text);
+    out.append("\n\n");
+}
+
+inline void append_sse_done(std::string& out) {
+    out.append("data: [DONE]\n\n");
+}
+
+// Frames each event into one reusable buffer and hands it to the sink as a
+// single coalesced write. httplib's DataSink takes one contiguous span, so
+// coalescing into the reused buffer plays the role of vectored I/O.
+class SseWriter {
+public:
+    explicit SseWriter(httplib::DataSink& sink) : sink_(sink) {}
+
+    bool write_data(const std::string& payload) {
+        buffer_.clear();
+        append_sse_data(buffer_, payload);
+        return flush();
+    }
+
+    bool write_data(const nlohmann::json& payload) {
+        buffer_.clear();
+        append_sse_data(buffer_, payload);
+        return flush();
+    }
+
+    bool write_event(const std::string& event, const nlohmann::json& payload) {
+        buffer_.clear();
+        append_sse_event(buffer_, event, payload);
+        return flush();
+    }
+
+    bool write_comment(const std::string& text) {
+        buffer_.clear();
+        append_sse_comment(buffer_, text);
+        return flush();
+    }
+
+    bool write_done() {
+        buffer_.clear();
+        append_sse_done(buffer_);
+        return flush();
+    }
+
+private:
+    bool flush() { return sink_.write(buffer_.data(), buffer_.size()); }
+
+    httplib::DataSink& sink_;
+    std::string buffer_;
+};
+
+}  // namespace lemon
@@ -0,0 +1,98 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <filesystem>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <nlohmann/json.hpp>
+
+namespace lemon {
+
+/// Log-structured persistence for the cumulative counters behind /stats.
+/// Request totals accumulate in memory and a background thread appends one
+/// JSONL delta record per flush interval, so each flush costs the size of
+/// what changed since the last one instead of the whole store, and nothing
+/// is written on the request path. Startup replays the log; once it grows
+/// past the record budget the flush thread compacts it back to a single
+/// snapshot record (temp file + rename). A torn trailing record from a
+/// crash is skipped on replay.
+class StatsStore {
+public:
+    struct ModelIdentity {
+        std::string model_name;
+        std::string checkpoint;
+        std::string type;
+        std::string device;
+        std::string recipe;
+
+        std::string key() const {
+            return model_name + "\n" + checkpoint + "\n" + type + "\n" + device +
+                   "\n" + recipe;
+        }
+    };
+
+    struct Totals {
+        uint64_t request_count_total = 0;
+        uint64_t input_tokens_total = 0;
+        uint64_t output_tokens_total = 0;
+        uint64_t prompt_tokens_total = 0;
+    };
+
+    struct ModelTotals {
+        ModelIdentity identity;
+        Totals totals;
+    };
+
+    explicit StatsStore(const std::filesystem::path& log_path,
+                        size_t max_log_records = 512);
+    ~StatsStore();
+
+    StatsStore(const StatsStore&) = delete;
+    StatsStore& operator=(const StatsStore&) = delete;
+
+    /// Totals reconstructed from the log, one entry per model identity.
+    /// The aggregate is the sum over entries; every recorded request carries
+    /// a model identity.
+    std::vector<ModelTotals> replay();
+
+    void record_request(const ModelIdentity& identity, int input_tokens,
+                        int output_tokens);
+    void record_prompt_tokens(const ModelIdentity& identity, int prompt_tokens);
+
+    /// Appends pending deltas now (and compacts if the log is over budget).
+    /// Called by the background thread on its interval and from the
+    /// destructor; public so tests can flush deterministically.
+    void flush();
+
+private:
+    struct Entry {
+        ModelIdentity identity;
+        Totals cumulative;
+        Totals pending;
+    };
+
+    void flush_locked();
+    void compact_locked();
+    Entry& entry_for(const ModelIdentity& identity);
+
+    static constexpr int kFlushIntervalSeconds = 5;
+
+    const std::filesystem::path log_path_;
+    const size_t max_log_records_;
+
+    std::mutex mutex_;
+    std::map<std::string, Entry> entries_;
+    bool dirty_ = false;
+    size_t log_records_ = 0;
+
+    std::condition_variable stop_cv_;
+    bool stopping_ = false;
+    std::thread flush_thread_;
+};
+
+} // namespace lemon
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <nlohmann/json.hpp>
+
+namespace lemon {
+
+// Continuously maintained per-model sliding windows behind /stats: request
+// and token counts plus a TTFT distribution over the last minute, hour, and
+// day. Each request lands in a fixed ring of time slots at record time, so
+// serving /stats is a read of precomputed state whose cost never grows with
+// history. TTFT quantiles come from the same log-spaced buckets as the
+// /metrics latency histograms, interpolated within the matching bucket.
+class StatsWindows {
+public:
+    void record(const std::string& model, int input_tokens, int output_tokens,
+                double ttft_seconds,
+                std::chrono::steady_clock::time_point now =
+                    std::chrono::steady_clock::now());
+
+    // {"1m": {"<model>": {requests, input_tokens, output_tokens, ttft?}}, ...}
+    // Models with no traffic inside a window are omitted from it.
+    nlohmann::json to_json(std::chrono::steady_clock::time_point now =
+                               std::chrono::steady_clock::now()) const;
+
+private:
+    static constexpr size_t kWindowCount = 3;
+    static constexpr size_t kTtftBucketCount = 10;
+
+    struct Slot {
+        uint64_t epoch = 0;
+        uint64_t requests = 0;
+        uint64_t input_tokens = 0;
+        uint64_t output_tokens = 0;
+        uint64_t ttft_count = 0;
+        double ttft_sum = 0.0;
+        uint64_t ttft_buckets[kTtftBucketCount + 1] = {};
+    };
+
+    struct Window {
+        std::vector<Slot> slots;
+    };
+
+    struct ModelWindows {
+        Window windows[kWindowCount];
+    };
+
+    mutable std::mutex mutex_;
+    std::map<std::string, ModelWindows> by_model_;
+};
+
+} // namespace lemon
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace lemon {
+
+struct StoreCandidate {
+    std::string model;
+    uint64_t size_bytes = 0;
+    // Epoch seconds of the last inference that named this model; 0 when no
+    // use has been recorded since tracking began.
+    int64_t last_used = 0;
+    double use_count = 0.0;
+    // Never evicted (currently loaded, or otherwise protected). Still counts
+    // toward the store total.
+    bool pinned = false;
+};
+
+/**
+ * Disk-budget eviction for the model store. A candidate's eviction score is
+ *
+ *     (1 + age_days) * size_gb / ((1 + use_count) * (1 + log2(1 + size_gb)))
+ *
+ * so stale and large models go first, while frequently used models and very
+ * large ones (whose re-download costs the most bandwidth and time) are kept
+ * longer at equal staleness. Models with no recorded use age from a fixed
+ * far-past point so they lose ties against anything actually used.
+ */
+class StoreEvictionPolicy {
+public:
+    static double eviction_score(const StoreCandidate& candidate, int64_t now);
+
+    // Selects candidates to evict, highest score first, until the store total
+    // fits under quota_bytes. Pinned candidates are never selected. Returns an
+    // empty plan when the store already fits; the plan stops short of quota
+    // when only pinned data remains above it.
+    static std::vector<StoreCandidate> plan(std::vector<StoreCandidate> candidates,
+                                            uint64_t quota_bytes,
+                                            int64_t now);
+};
+
+} // namespace lemon
@@ -1,15 +1,18 @@
 #pragma once
 
-#include <vector>
-#include <string>
-#include <mutex>
+#include <atomic>
 #include <cstdint>
+#include <string>
+#include <vector>
 
 namespace lemon {
 
 /**
- * Thread-safe audio buffer for streaming transcription.
- * Accumulates PCM audio chunks and exports as WAV for whisper.cpp.
+ * Audio buffer for streaming transcription, built as a lock-free
+ * single-producer single-consumer ring: the WebSocket receive thread
+ * appends, the session processing thread reads and clears. Capacity is
+ * preallocated per session; when the ring is full, new samples are dropped
+ * and counted in overflow_samples().
  */
 class StreamingAudioBuffer {
 public:
@@ -17,7 +20,11 @@ public:
     static constexpr int CHANNELS = 1;          // Mono
     static constexpr int BITS_PER_SAMPLE = 16;  // PCM16
 
-    StreamingAudioBuffer() = default;
+    // ~2 minutes of 16kHz mono PCM16 (3.7 MB per session). Utterances are
+    // bounded well below this by VAD silence detection and interim commits.
+    static constexpr size_t CAPACITY_SAMPLES = static_cast<size_t>(SAMPLE_RATE) * 120;
+
+    StreamingAudioBuffer();
     ~StreamingAudioBuffer() = default;
 
     // Non-copyable
@@ -25,13 +32,13 @@ public:
     StreamingAudioBuffer& operator=(const StreamingAudioBuffer&) = delete;
 
     /**
-     * Append base64-encoded PCM16 audio data to the buffer.
+     * Append base64-encoded PCM16 audio data to the buffer. Producer side.
      * @param base64_audio Base64-encoded PCM16 mono 16kHz audio
      */
     void append(const std::string& base64_audio);
 
     /**
-     * Append raw PCM16 audio samples directly.
+     * Append raw PCM16 audio samples directly. Producer side.
      * @param samples Raw int16 samples at 16kHz mono
      */
     void append_raw(const std::vector<int16_t>& samples);
@@ -64,7 +71,15 @@ public:
     std::vector<float> get_recent_samples(int ms) const;
 
     /**
-     * Clear the audio buffer.
+     * Copy the most recent N milliseconds of audio into a caller-owned
+     * buffer, reusing its capacity. Returns the number of samples written.
+     * Avoids the per-call allocation of get_recent_samples() on the
+     * realtime VAD path.
+     */
+    size_t copy_recent_samples(int ms, std::vector<float>& out) const;
+
+    /**
+     * Clear the audio buffer. Consumer side.
      */
     void clear();
 
@@ -83,11 +98,27 @@ public:
      */
     bool empty() const;
 
+    /**
+     * Total samples dropped because the ring was full.
+     */
+    uint64_t overflow_samples() const;
+
 private:
-    std::vector<int16_t> samples_;
-    mutable std::mutex mutex_;
+    std::vector<int16_t> ring_;
+
+    // Monotonic sample counters; position in the ring is counter % capacity.
+    // Cache-line separation keeps producer tail stores from bouncing the
+    // line the consumer polls for head.
+    alignas(64) std::atomic<uint64_t> head_{0};      // consumer read position
+    alignas(64) std::atomic<uint64_t> tail_{0};      // producer write position
+    alignas(64) std::atomic<uint64_t> overflow_{0};  // dropped sample count
+
+    // Producer-side ring write; drops what does not fit.
+    void push_samples(const int16_t* data, size_t count);
+
+    // Consumer-side copy of [head, tail) into a contiguous buffer.
+    std::vector<int16_t> snapshot() const;
 
-    // Helper to build WAV from samples (no locking — caller must hold mutex_)
     static std::vector<uint8_t> build_wav(const std::vector<int16_t>& samples);
 };
 
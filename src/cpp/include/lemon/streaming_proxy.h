@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstdint>
 #include <string>
 #include <functional>
 #include <nlohmann/json.hpp>
@@ -41,13 +42,17 @@ public:
         }
     };
 
+    // idle_timeout_seconds bounds the gap between backend chunks instead of
+    // total stream duration; when exceeded the stream is treated as a backend
+    // failure so the caller can health-flag and reset the backend.
     static void forward_sse_stream(
         const std::string& backend_url,
         const std::string& request_body,
         httplib::DataSink& sink,
         std::function<void(const TelemetryData&)> on_complete = nullptr,
         long timeout_seconds = 300,
-        std::function<void()> on_chunk = nullptr
+        std::function<void()> on_chunk = nullptr,
+        long idle_timeout_seconds = 0
     );
 
     static void forward_byte_stream(
@@ -64,6 +69,12 @@ public:
 
     static void accumulate_responses_delta(const nlohmann::json& parsed, std::string& accumulated_text);
 
+    // Bounded buffering between the backend socket and the client sink. When a
+    // slow client leaves more than the high-water mark queued, backend reads
+    // pause until the writer drains below it.
+    static void set_high_water_mark(size_t bytes);
+    static uint64_t sink_blocked_ms_total();
+
 private:
 };
 
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstdint>
 #include <string>
 #include <vector>
 #include <nlohmann/json.hpp>
@@ -157,6 +158,20 @@ public:
     // Global GPU memory pressure across all processes (used/total in [0,1]),
     // or -1.0 if no source is available. Used by the dynamic VRAM eviction engine.
     static double get_global_vram_usage_pct();
+
+    // Per-GPU memory occupancy for multi-GPU placement. `index` is the device
+    // ordinal within its vendor (nvidia-smi index for NVIDIA; amdgpu card order
+    // for AMD), which is the ordinal the single-vendor llama.cpp backends use
+    // for device names like CUDA1/ROCm1. Empty when no per-device source is
+    // available.
+    struct GpuMemoryDevice {
+        int index = -1;
+        std::string vendor;  // "nvidia" or "amd"
+        bool integrated = false;
+        uint64_t total_bytes = 0;
+        uint64_t used_bytes = 0;
+    };
+    static std::vector<GpuMemoryDevice> get_gpu_memory_per_device();
 };
 
 // Windows implementation
@@ -3,9 +3,20 @@
 #include <cstdint>
 #include <memory>
 #include <mutex>
+#include <string>
+#include <vector>
 
 namespace lemon {
 
+// One sampled accelerator. `device` is a device class ("gpu", "npu"),
+// suffixed with the platform's device name when it can tell several apart
+// (e.g. "gpu:card1", "npu:accel0").
+struct DeviceUtilization {
+    std::string device;
+    double busy_percent = -1.0;  // -1 if not available
+    double memory_gb = -1.0;     // -1 if not available
+};
+
 // Platform-specific system metrics collection
 class SystemMetricsPlatform {
 public:
@@ -31,6 +42,22 @@ public:
 
     // NPU utilization percentage (0-100), -1 if not available or unsupported
     virtual double get_npu_utilization() = 0;
+
+    // Per-device utilization. The default derives one entry per device class
+    // from the aggregate getters; platforms with per-device counters override
+    // it to report each accelerator separately.
+    virtual std::vector<DeviceUtilization> get_device_utilization() {
+        std::vector<DeviceUtilization> out;
+        const double gpu = get_gpu_usage();
+        if (gpu >= 0) {
+            out.push_back({"gpu", gpu, get_vram_usage_gb()});
+        }
+        const double npu = get_npu_utilization();
+        if (npu >= 0) {
+            out.push_back({"npu", npu, -1.0});
+        }
+        return out;
+    }
 };
 
 // Factory function to create platform-specific implementation
@@ -0,0 +1,81 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "lemon/system_metrics_platform.h"
+
+namespace lemon {
+
+/// Continuous host telemetry: a fixed-capacity ring of periodic
+/// CPU / GPU / VRAM / RAM / NPU samples.
+///
+/// A background thread samples once per second; the ring holds four hours
+/// before the oldest samples are overwritten, so memory use is constant.
+/// Snapshots back the `system-stats/history` endpoint, `/system-stats`
+/// serves the latest sample instead of querying the platform per request,
+/// and /metrics reads it too, letting eviction events be correlated with
+/// memory pressure after the fact.
+class SystemStatsHistory {
+public:
+    struct Sample {
+        int64_t timestamp = 0;     // unix seconds
+        float vram_gb = -1.0f;     // -1 when not measurable
+        float memory_gb = -1.0f;
+        float npu_percent = -1.0f;
+        float cpu_percent = -1.0f;
+        float gpu_percent = -1.0f;
+        // Per-accelerator readings; empty on platforms without any. Served by
+        // /system-stats and /metrics but left out of the history payload.
+        std::vector<DeviceUtilization> devices;
+    };
+
+    static constexpr size_t kCapacity = 4 * 60 * 60;  // 4 h at 1 Hz
+    static constexpr int kDefaultIntervalMs = 1000;
+
+    SystemStatsHistory();
+    ~SystemStatsHistory();
+
+    SystemStatsHistory(const SystemStatsHistory&) = delete;
+    SystemStatsHistory& operator=(const SystemStatsHistory&) = delete;
+
+    void start(int interval_ms = kDefaultIntervalMs);
+    void stop();
+
+    /// Samples with timestamp >= since_timestamp, oldest first.
+    /// Pass 0 for the full retained window.
+    std::vector<Sample> snapshot(int64_t since_timestamp = 0) const;
+
+    /// Most recent sample; false when nothing has been recorded yet.
+    bool latest(Sample& out) const;
+
+    /// Samples recorded since start, including ones already overwritten.
+    uint64_t total_samples() const;
+
+    void record(const Sample& sample);
+
+private:
+    void sampler_loop();
+
+    std::vector<Sample> ring_;
+    size_t head_ = 0;
+    size_t count_ = 0;
+    uint64_t total_ = 0;
+    mutable std::mutex mutex_;
+
+    std::unique_ptr<SystemMetricsPlatform> metrics_platform_;
+    std::mutex cpu_stats_mutex_;
+    uint64_t cpu_last_total_ = 0;
+    uint64_t cpu_last_idle_ = 0;
+    std::thread sampler_thread_;
+    std::condition_variable cv_;
+    std::mutex cv_mutex_;
+    bool stop_requested_ = false;
+    int interval_ms_ = kDefaultIntervalMs;
+};
+
+} // namespace lemon
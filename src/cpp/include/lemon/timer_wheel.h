@@ -0,0 +1,75 @@
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+
+namespace lemon {
+
+/**
+ * Process-wide recurring-timer service. Periodic maintenance work (backend
+ * health probes, idle-timeout checks) registers a tick callback here instead
+ * of owning a thread; one worker drives every task, and deadlines are
+ * quantized so tasks with similar periods fire in the same wakeup. With many
+ * resident models this replaces one polling thread per backend with a single
+ * thread and coalesced timer interrupts.
+ *
+ * Tick callbacks run on the worker thread and must be brief relative to their
+ * period (a bounded HTTP probe is fine; inference is not). A callback returns
+ * false to deschedule itself.
+ */
+class TimerWheel {
+public:
+    using TaskId = std::uint64_t;
+
+    static TimerWheel& shared();
+
+    TimerWheel() = default;
+    ~TimerWheel();
+
+    TimerWheel(const TimerWheel&) = delete;
+    TimerWheel& operator=(const TimerWheel&) = delete;
+
+    /// Schedule `tick` every `interval`, first firing one interval from now.
+    /// `name` appears in logs. Returns an id for cancel().
+    TaskId schedule_recurring(const std::string& name,
+                              std::chrono::milliseconds interval,
+                              std::function<bool()> tick);
+
+    /// Remove a task. Blocks until any in-flight tick for it has returned, so
+    /// callers can safely destroy state the callback captures. No-op for ids
+    /// that are unknown or already descheduled. Must not be called from inside
+    /// the task's own tick — return false from the tick instead.
+    void cancel(TaskId id);
+
+    size_t task_count() const;
+
+private:
+    struct Task {
+        std::string name;
+        std::chrono::milliseconds interval{0};
+        std::function<bool()> tick;
+    };
+
+    using Clock = std::chrono::steady_clock;
+
+    Clock::time_point quantize(Clock::time_point deadline) const;
+    void worker_loop();
+
+    mutable std::mutex mutex_;
+    std::condition_variable cv_;
+    std::thread worker_;
+    bool running_ = false;
+    TaskId next_id_ = 1;
+    TaskId executing_id_ = 0;
+    std::unordered_map<TaskId, Task> tasks_;
+    std::multimap<Clock::time_point, TaskId> deadlines_;
+};
+
+} // namespace lemon
@@ -0,0 +1,38 @@
+#pragma once
+
+#include <cstdint>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+
+namespace lemon {
+
+// Caches (model, text) -> token count for /tokenize count_only requests.
+// Clients budgeting context call tokenize repeatedly on the same prompt
+// prefixes; a hit answers from memory instead of a round trip to the
+// backend subprocess. Entries key on a 64-bit content hash plus length, not
+// the text itself, so cached multi-kilobyte prompts cost bytes, not copies.
+class TokenCountCache {
+public:
+    std::optional<int64_t> lookup(const std::string& model, const std::string& text);
+    void store(const std::string& model, const std::string& text, int64_t count);
+
+    size_t size() const;
+
+private:
+    static constexpr size_t kMaxEntries = 1024;
+
+    static std::string key_for(const std::string& model, const std::string& text);
+
+    struct Entry {
+        int64_t count = 0;
+        uint64_t last_used = 0;
+    };
+
+    mutable std::mutex mutex_;
+    std::unordered_map<std::string, Entry> entries_;
+    uint64_t use_counter_ = 0;
+};
+
+}  // namespace lemon
@@ -0,0 +1,72 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <string>
+
+namespace lemon {
+
+struct TranscriptUpdate {
+    std::string stable_delta;     // newly committed text, append-only
+    std::string volatile_suffix;  // uncommitted tail, replaced on every update
+};
+
+/**
+ * Splits the full hypothesis an ASR backend re-decodes on every audio delta
+ * into an append-only stable stream plus a volatile tail. Text becomes
+ * stable once two consecutive hypotheses agree on it up to a word boundary;
+ * committed text never retracts, even if a later hypothesis rewrites it.
+ * Interim event payloads stay bounded by the volatile tail instead of
+ * growing with the utterance.
+ */
+class TranscriptStabilizer {
+public:
+    TranscriptUpdate update(const std::string& hypothesis) {
+        TranscriptUpdate out;
+
+        size_t agreed = common_prefix(previous_, hypothesis);
+        size_t boundary = (agreed == hypothesis.size() && agreed == previous_.size())
+                              ? agreed
+                              : word_boundary(hypothesis, agreed);
+        if (boundary > committed_) {
+            out.stable_delta = hypothesis.substr(committed_, boundary - committed_);
+            committed_ = boundary;
+        }
+        if (committed_ < hypothesis.size()) {
+            out.volatile_suffix = hypothesis.substr(committed_);
+        }
+
+        previous_ = hypothesis;
+        return out;
+    }
+
+    void reset() {
+        previous_.clear();
+        committed_ = 0;
+    }
+
+    size_t committed_length() const { return committed_; }
+
+private:
+    static size_t common_prefix(const std::string& a, const std::string& b) {
+        const size_t limit = (std::min)(a.size(), b.size());
+        size_t i = 0;
+        while (i < limit && a[i] == b[i]) {
+            ++i;
+        }
+        return i;
+    }
+
+    // Largest position <= end that does not split a word.
+    static size_t word_boundary(const std::string& s, size_t end) {
+        while (end > 0 && s[end - 1] != ' ') {
+            --end;
+        }
+        return end;
+    }
+
+    std::string previous_;
+    size_t committed_ = 0;
+};
+
+} // namespace lemon
@@ -0,0 +1,77 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace lemon {
+
+/**
+ * Multiplexes transcription work from concurrent Realtime sessions onto a
+ * small fixed worker pool, instead of spawning one detached task per request.
+ *
+ * Jobs are tagged with the originating session ID. Interim jobs are full
+ * re-decodes of the same growing utterance, so at most one interim per
+ * session is ever queued: a newer audio snapshot replaces the queued one,
+ * and a final drops any queued interim for its session (the final supersedes
+ * it). This bounds the work handed to the ASR backend at O(active sessions)
+ * no matter how far the backend falls behind, which is what limits
+ * concurrent-session capacity in practice.
+ */
+class TranscriptionScheduler {
+public:
+    struct Job {
+        std::string session_id;
+        std::vector<uint8_t> wav_data;
+        std::string model;
+        bool is_interim = false;
+    };
+
+    using Runner = std::function<void(Job&)>;
+
+    TranscriptionScheduler(Runner runner, size_t worker_count);
+    ~TranscriptionScheduler();
+
+    TranscriptionScheduler(const TranscriptionScheduler&) = delete;
+    TranscriptionScheduler& operator=(const TranscriptionScheduler&) = delete;
+
+    /**
+     * Enqueue a job. Interim jobs coalesce with a queued interim for the
+     * same session; final jobs drop any queued interim for their session.
+     */
+    void submit(Job job);
+
+    /**
+     * Discard all queued jobs for a session (used when the session closes).
+     * A job already running on a worker is not interrupted.
+     */
+    void drop_session(const std::string& session_id);
+
+    /**
+     * Stop accepting work, discard queued jobs, and join the workers after
+     * they finish their in-flight job. Idempotent; also called by the
+     * destructor.
+     */
+    void shutdown();
+
+    size_t queued_jobs() const;
+    uint64_t coalesced_jobs() const;
+
+private:
+    void worker_loop();
+
+    Runner runner_;
+    mutable std::mutex mutex_;
+    std::condition_variable cv_;
+    std::deque<Job> queue_;
+    bool stopping_ = false;
+    uint64_t coalesced_ = 0;
+    std::vector<std::thread> workers_;
+};
+
+}  // namespace lemon
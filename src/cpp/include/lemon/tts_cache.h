@@ -0,0 +1,50 @@
+#pragma once
+
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <nlohmann/json.hpp>
+
+namespace lemon {
+
+/**
+ * Content-addressed disk cache for synthesized speech. Entries are keyed by
+ * a hash of the request fields that affect the audio (model, input, voice,
+ * speed, response_format) and stored as files under <cache_dir>/tts-cache,
+ * so repeated phrases are served from disk without loading the TTS model.
+ * The cache is bounded: when it grows past max_bytes the least recently
+ * used entries (by file mtime, refreshed on every hit) are evicted.
+ */
+class TtsCache {
+public:
+    static constexpr uint64_t DEFAULT_MAX_BYTES = 128ull * 1024 * 1024;
+
+    explicit TtsCache(const std::string& cache_dir,
+                      uint64_t max_bytes = DEFAULT_MAX_BYTES);
+
+    /** Cache key for a speech request; same inputs always map to the same key. */
+    static std::string key_for(const nlohmann::json& request,
+                               const std::string& response_format);
+
+    /**
+     * Fetch a cached clip, refreshing its LRU position. The audio format the
+     * entry was stored with comes back in `format` so the caller can pick the
+     * right MIME type without consulting the (possibly unloaded) backend.
+     */
+    bool lookup(const std::string& key, std::string& format, std::string& audio);
+
+    /** Persist a clip and evict the oldest entries past the size bound. */
+    void store(const std::string& key, const std::string& format,
+               const std::string& audio);
+
+    uint64_t size_bytes() const;
+
+private:
+    void evict_to_fit();
+
+    std::string dir_;
+    uint64_t max_bytes_;
+    mutable std::mutex mutex_;
+};
+
+}  // namespace lemon
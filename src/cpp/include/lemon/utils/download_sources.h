@@ -0,0 +1,122 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace lemon {
+namespace utils {
+
+// Scheduler for one multi-source download: every source serves the same
+// bytes, workers ask for the best source per chunk attempt. Selection
+// favors the source with the highest measured throughput split across its
+// active workers, so a fast mirror naturally absorbs more chunks while a
+// throttled one drains to a trickle; unmeasured sources are tried first so
+// each gets probed. A source that keeps failing is dropped unless it is the
+// last one standing.
+class DownloadSourceSet {
+public:
+    static constexpr int kMaxFailures = 3;
+
+    struct Source {
+        std::string url;
+        bool primary = false;
+        std::atomic<std::uint64_t> bytes{0};
+        std::atomic<std::uint64_t> micros{0};
+        std::atomic<int> active{0};
+        std::atomic<int> failures{0};
+        std::atomic<bool> disabled{false};
+
+        double throughput_bytes_per_sec() const {
+            const std::uint64_t us = micros.load(std::memory_order_relaxed);
+            if (us == 0) {
+                return 0.0;
+            }
+            return static_cast<double>(bytes.load(std::memory_order_relaxed)) *
+                   1e6 / static_cast<double>(us);
+        }
+    };
+
+    explicit DownloadSourceSet(const std::vector<std::string>& urls) {
+        sources_.reserve(urls.size());
+        for (const auto& url : urls) {
+            auto source = std::make_unique<Source>();
+            source->url = url;
+            source->primary = sources_.empty();
+            sources_.push_back(std::move(source));
+        }
+    }
+
+    // Picks the enabled source with the best estimated per-worker rate and
+    // marks a worker active on it. Never returns null while any source is
+    // enabled.
+    Source* acquire() {
+        Source* best = nullptr;
+        double best_score = -1.0;
+        for (const auto& source : sources_) {
+            if (source->disabled.load(std::memory_order_relaxed)) {
+                continue;
+            }
+            const int active = source->active.load(std::memory_order_relaxed);
+            const double rate = source->throughput_bytes_per_sec();
+            // Unmeasured sources score as if infinitely fast (minus a bias
+            // per active probe) so they are exercised before the measured
+            // ranking takes over.
+            const double score = (rate == 0.0)
+                                     ? 1e18 / static_cast<double>(active + 1)
+                                     : rate / static_cast<double>(active + 1);
+            if (score > best_score) {
+                best_score = score;
+                best = source.get();
+            }
+        }
+        if (!best && !sources_.empty()) {
+            // Concurrent failures can race every source into disabled;
+            // the primary always answers.
+            best = sources_.front().get();
+        }
+        if (best) {
+            best->active.fetch_add(1, std::memory_order_relaxed);
+        }
+        return best;
+    }
+
+    void release(Source* source, std::uint64_t bytes_transferred,
+                 std::uint64_t elapsed_micros, bool success) {
+        source->active.fetch_sub(1, std::memory_order_relaxed);
+        if (bytes_transferred > 0) {
+            source->bytes.fetch_add(bytes_transferred, std::memory_order_relaxed);
+            source->micros.fetch_add(elapsed_micros > 0 ? elapsed_micros : 1,
+                                     std::memory_order_relaxed);
+        }
+        if (success) {
+            source->failures.store(0, std::memory_order_relaxed);
+            return;
+        }
+        const int failures =
+            source->failures.fetch_add(1, std::memory_order_relaxed) + 1;
+        if (failures >= kMaxFailures && enabled_count() > 1) {
+            source->disabled.store(true, std::memory_order_relaxed);
+        }
+    }
+
+    size_t enabled_count() const {
+        size_t count = 0;
+        for (const auto& source : sources_) {
+            if (!source->disabled.load(std::memory_order_relaxed)) {
+                ++count;
+            }
+        }
+        return count;
+    }
+
+    const std::vector<std::unique_ptr<Source>>& sources() const { return sources_; }
+
+private:
+    std::vector<std::unique_ptr<Source>> sources_;
+};
+
+} // namespace utils
+} // namespace lemon
@@ -0,0 +1,72 @@
+#pragma once
+
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace lemon {
+namespace utils {
+
+/// Background sequential readahead over a model file.
+///
+/// Asks the OS to pull the file into the page cache front-to-back
+/// (posix_fadvise WILLNEED on Linux, F_RDADVISE on macOS,
+/// PrefetchVirtualMemory on Windows) so that when the backend subprocess
+/// mmaps the weights its first-touch faults hit warm pages instead of
+/// issuing random reads. Purely advisory: errors are ignored and the OS
+/// stays free to drop pages under memory pressure.
+///
+/// start() returns immediately; the advice loop runs on its own thread and
+/// stops early when stop() is called or the object is destroyed.
+class FilePrewarmer {
+public:
+    FilePrewarmer() = default;
+    ~FilePrewarmer();
+
+    FilePrewarmer(const FilePrewarmer&) = delete;
+    FilePrewarmer& operator=(const FilePrewarmer&) = delete;
+
+    void start(const std::string& path);
+    void stop();
+
+private:
+    void prewarm_loop(const std::string& path);
+
+    std::thread thread_;
+    std::atomic<bool> stop_requested_{false};
+};
+
+/// Page-cache readahead over a backend executable and the shared libraries
+/// installed next to it.
+///
+/// Backend subprocesses cannot be pre-spawned modelless (the model path is an
+/// argv-time contract), so the startup cost we can remove from a cold model
+/// swap is the image load: CreateProcess/exec plus the loader faulting in the
+/// server binary and its runtime DLLs/.so files from disk. Starting this
+/// before the spawn lets those faults hit warm pages. Same advisory
+/// semantics as FilePrewarmer.
+class BinaryPrewarmer {
+public:
+    BinaryPrewarmer() = default;
+    ~BinaryPrewarmer();
+
+    BinaryPrewarmer(const BinaryPrewarmer&) = delete;
+    BinaryPrewarmer& operator=(const BinaryPrewarmer&) = delete;
+
+    void start(const std::string& executable_path);
+    void stop();
+
+    /// The executable followed by its directory's shared libraries
+    /// (.dll/.so*/.dylib), sorted for determinism.
+    static std::vector<std::string> collect_prewarm_set(const std::string& executable_path);
+
+private:
+    void prewarm_loop(const std::string& executable_path);
+
+    std::thread thread_;
+    std::atomic<bool> stop_requested_{false};
+};
+
+} // namespace utils
+} // namespace lemon
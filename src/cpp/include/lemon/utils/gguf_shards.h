@@ -0,0 +1,131 @@
+#pragma once
+
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <string>
+#include <system_error>
+#include <vector>
+
+#include "lemon/utils/path_utils.h"
+
+namespace lemon {
+namespace utils {
+
+/// A sharded GGUF checkpoint expanded from its first file
+/// (`model-00001-of-00005.gguf`). llama-server derives the sibling shard
+/// names from the same suffix, but only opens them one by one during
+/// startup — so a missing shard surfaces half a minute into a load, and
+/// the first file's size wildly understates the checkpoint. Resolving the
+/// set up front lets the router fail fast, prefetch every shard in
+/// parallel, and hand memory admission the aggregate size.
+struct GgufShardSet {
+    std::vector<std::string> paths;    // expected shards in order (or just the input path)
+    std::vector<std::string> missing;  // expected shards absent on disk
+    std::uint64_t total_bytes = 0;     // bytes of the shards present
+    bool sharded = false;
+
+    bool complete() const { return missing.empty(); }
+};
+
+struct GgufShardName {
+    std::string prefix;     // path up to the "-NNNNN-of-NNNNN" suffix
+    std::string extension;  // ".gguf" as spelled in the input
+    size_t index = 0;
+    size_t count = 0;
+};
+
+/// Parses llama.cpp's `%s-%05d-of-%05d.gguf` shard naming. Returns false
+/// for anything else, including indices outside [1, count].
+inline bool parse_gguf_shard_name(const std::string& path, GgufShardName& out) {
+    // "-NNNNN-of-NNNNN.gguf"
+    constexpr size_t kSuffixLen = 20;
+    if (path.size() < kSuffixLen + 1) {
+        return false;
+    }
+    const size_t base = path.size() - kSuffixLen;
+    const char* s = path.data() + base;
+
+    auto lower = [](char c) {
+        return (c >= 'A' && c <= 'Z') ? static_cast<char>(c - 'A' + 'a') : c;
+    };
+    auto digits5 = [](const char* p, size_t& value) {
+        value = 0;
+        for (int i = 0; i < 5; ++i) {
+            if (p[i] < '0' || p[i] > '9') return false;
+            value = value * 10 + static_cast<size_t>(p[i] - '0');
+        }
+        return true;
+    };
+
+    size_t index = 0;
+    size_t count = 0;
+    if (s[0] != '-' || !digits5(s + 1, index)) return false;
+    if (s[6] != '-' || lower(s[7]) != 'o' || lower(s[8]) != 'f' || s[9] != '-') return false;
+    if (!digits5(s + 10, count)) return false;
+    if (s[15] != '.' || lower(s[16]) != 'g' || lower(s[17]) != 'g' ||
+        lower(s[18]) != 'u' || lower(s[19]) != 'f') {
+        return false;
+    }
+    if (index == 0 || count == 0 || index > count) {
+        return false;
+    }
+
+    out.prefix = path.substr(0, base);
+    out.extension = path.substr(base + 15);
+    out.index = index;
+    out.count = count;
+    return true;
+}
+
+inline std::string gguf_shard_path(const GgufShardName& name, size_t index) {
+    char suffix[24];
+    std::snprintf(suffix, sizeof(suffix), "-%05zu-of-%05zu",
+                  index, name.count);
+    return name.prefix + suffix + name.extension;
+}
+
+/// Expands `path` into its full shard set and stats each member. A path
+/// that is not a multi-file shard (including directories and missing
+/// files) comes back as a one-element set with `sharded == false`, so
+/// call sites can treat every checkpoint uniformly.
+inline GgufShardSet resolve_gguf_shard_set(const std::string& path) {
+    namespace fs = std::filesystem;
+
+    GgufShardSet set;
+    if (path.empty()) {
+        return set;
+    }
+
+    auto stat_shard = [&set](const std::string& shard) {
+        std::error_code ec;
+        const fs::path p = path_from_utf8(shard);
+        if (!fs::exists(p, ec) || ec) {
+            set.missing.push_back(shard);
+            return;
+        }
+        const auto size = fs::file_size(p, ec);
+        if (!ec) {
+            set.total_bytes += static_cast<std::uint64_t>(size);
+        }
+    };
+
+    GgufShardName name;
+    if (!parse_gguf_shard_name(path, name) || name.count < 2) {
+        set.paths.push_back(path);
+        stat_shard(path);
+        return set;
+    }
+
+    set.sharded = true;
+    set.paths.reserve(name.count);
+    for (size_t i = 1; i <= name.count; ++i) {
+        std::string shard = gguf_shard_path(name, i);
+        stat_shard(shard);
+        set.paths.push_back(std::move(shard));
+    }
+    return set;
+}
+
+} // namespace utils
+} // namespace lemon
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstdint>
 #include <string>
 #include <map>
 #include <vector>
@@ -31,6 +32,9 @@ struct MultipartField {
     std::string data;
     std::string filename;       // empty for text fields
     std::string content_type;   // empty for text fields
+    // When set, the part body is streamed from this file by libcurl instead of
+    // being held in `data`, keeping memory O(chunk) for large uploads.
+    std::string file_path;
 };
 
 // Result of a download operation with detailed error information
@@ -83,6 +87,33 @@ struct DownloadOptions {
     bool range_retry_on_zero_byte_retry = true; // Retry empty failed attempts with Range: 0-
     bool force_initial_range_request = false;   // Force Range: 0- even on the first attempt
 
+    // Receive-rate cap in bytes/sec (0 = unshaped). The ranged parallel path
+    // splits the cap evenly across its simultaneous chunks.
+    size_t max_recv_bytes_per_sec = 0;
+
+    // Ranged parallel download. Files at least parallel_min_bytes whose server
+    // advertises byte-range support are split across this many simultaneous
+    // connections, each chunk resumable and checksummed independently.
+    // 1 disables parallelism.
+    int parallel_connections = 1;
+    size_t parallel_min_bytes = 256ull * 1024 * 1024;
+
+    // Disk writer behavior. The target file is preallocated to its final size
+    // once known, so the filesystem lays it out contiguously and disk-full
+    // surfaces early. direct_io additionally bypasses the OS page cache
+    // (O_DIRECT / F_NOCACHE / FILE_FLAG_NO_BUFFERING) so multi-GB pulls do not
+    // evict the mmap'd weights of currently loaded models.
+    bool preallocate = true;
+    bool direct_io = false;
+
+    // Additional sources serving the same bytes (configured mirrors, LAN
+    // peers). The ranged parallel path stripes chunks across every source
+    // that passes a size probe, steering each chunk attempt to the fastest
+    // healthy source; a mirror that keeps failing is dropped. Request
+    // headers (auth tokens) are only ever sent to the primary URL. Ignored
+    // by the sequential path.
+    std::vector<std::string> mirror_urls;
+
     // Optional content verification. expected_hash accepts plain hex or
     // prefixed values like "sha256:<hex>", "sha1:<hex>", or
     // "git-sha1:<hex>". git-sha1 verifies the Git blob object id, i.e.
@@ -125,9 +156,14 @@ public:
         HttpSecurityPolicy policy = HttpSecurityPolicy::ExternalHttpsOnly);
 
     // Streaming POST request (calls callback for each chunk as it arrives).
-    // on_status fires once, before the first chunk is delivered, so callers can
-    // divert an error body instead of forwarding it as payload bytes. Redirects
-    // are never followed.
+    // All streaming transfers are multiplexed onto one shared curl_multi
+    // event-loop thread; the calling thread only waits on a chunk queue, and
+    // stream_callback/on_status still run on the calling thread. on_status
+    // fires once, before the first chunk is delivered, so callers can divert
+    // an error body instead of forwarding it as payload bytes. Redirects are
+    // never followed. should_abort is polled even while no data arrives;
+    // returning true closes the backend connection and the transfer ends with
+    // CURLE_ABORTED_BY_CALLBACK.
     static HttpResponse post_stream(
         const std::string& url,
         const std::string& body,
@@ -135,7 +171,8 @@ public:
         const std::map<std::string, std::string>& headers = {},
         long timeout_seconds = 300,
         std::function<void(int status_code)> on_status = nullptr,
-        HttpSecurityPolicy policy = HttpSecurityPolicy::ExternalHttpsOnly);
+        HttpSecurityPolicy policy = HttpSecurityPolicy::ExternalHttpsOnly,
+        std::function<bool()> should_abort = nullptr);
 
     // Download file to disk with automatic retry and resume support
     static DownloadResult download_file(const std::string& url,
@@ -145,6 +182,18 @@ public:
                                         const DownloadOptions& options = DownloadOptions(),
                                         HttpSecurityPolicy policy = HttpSecurityPolicy::ExternalHttpsOnly);
 
+    // Cumulative keep-alive connection pool counters (see CurlHandlePool in
+    // http_client.cpp), exposed for the Prometheus scrape endpoint.
+    struct PoolStats {
+        uint64_t hits = 0;
+        uint64_t misses = 0;
+    };
+    static PoolStats connection_pool_stats();
+
+    // SHA256 of a file as lowercase hex; "" on read failure. Same digest the
+    // DownloadOptions::expected_hash sha256 verification computes.
+    static std::string sha256_file(const std::string& path);
+
     // Check if URL is reachable. Redirects are never followed.
     static bool is_reachable(
         const std::string& url,
@@ -163,6 +212,22 @@ private:
                                            const DownloadOptions& options,
                                            bool initial_range_request,
                                            HttpSecurityPolicy policy);
+
+    // Ranged parallel download across options.parallel_connections chunks.
+    // total_size comes from probe_ranged_download_size().
+    static DownloadResult download_file_parallel(const std::string& url,
+                                                 const std::string& output_path,
+                                                 size_t total_size,
+                                                 ProgressCallback callback,
+                                                 const std::map<std::string, std::string>& headers,
+                                                 const DownloadOptions& options,
+                                                 HttpSecurityPolicy policy);
+
+    // Returns the remote file size when the server supports byte ranges, or 0
+    // when the size is unknown or ranges are unsupported.
+    static size_t probe_ranged_download_size(const std::string& url,
+                                             const std::map<std::string, std::string>& headers,
+                                             HttpSecurityPolicy policy);
 };
 
 // Creates a throttled progress callback that prints at most once per second.
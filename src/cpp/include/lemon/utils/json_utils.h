@@ -30,14 +30,21 @@ public:
     static void add_legacy_max_tokens_alias(json& request);
     static json with_legacy_max_tokens_alias(const json& request);
 
+    // Copy-free variant for the completion hot path: returns `request` itself
+    // when no aliasing is needed (the common case) and only deep-copies into
+    // `scratch` when a legacy alias has to be inserted. `scratch` must outlive
+    // the returned reference.
+    static const json& with_legacy_max_tokens_alias(const json& request, json& scratch);
+
     // Check if JSON has key
     static bool has_key(const json& j, const std::string& key);
 
     // Get value with default
     template<typename T>
     static T get_or_default(const json& j, const std::string& key, const T& default_value) {
-        if (j.contains(key) && !j[key].is_null()) {
-            return j[key].get<T>();
+        auto it = j.find(key);
+        if (it != j.end() && !it->is_null()) {
+            return it->template get<T>();
         }
         return default_value;
     }
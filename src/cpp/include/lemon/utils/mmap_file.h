@@ -0,0 +1,140 @@
+#pragma once
+
+#include <cstddef>
+#include <streambuf>
+#include <string>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "lemon/utils/path_utils.h"
+
+namespace lemon {
+namespace utils {
+
+// Read-only memory mapping of a whole file. Mapping reserves address space
+// but faults pages in on demand, so a parser that only touches the header
+// reads only the header from disk - no buffered read-ahead of the tensor
+// payload.
+class MappedFile {
+public:
+    explicit MappedFile(const std::string& path) {
+#ifdef _WIN32
+        file_ = CreateFileW(path_from_utf8(path).c_str(), GENERIC_READ,
+                            FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+                            nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (file_ == INVALID_HANDLE_VALUE) {
+            return;
+        }
+        LARGE_INTEGER file_size{};
+        if (!GetFileSizeEx(file_, &file_size) || file_size.QuadPart <= 0) {
+            return;
+        }
+        mapping_ = CreateFileMappingW(file_, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (!mapping_) {
+            return;
+        }
+        data_ = static_cast<const char*>(
+            MapViewOfFile(mapping_, FILE_MAP_READ, 0, 0, 0));
+        if (data_) {
+            size_ = static_cast<size_t>(file_size.QuadPart);
+        }
+#else
+        fd_ = ::open(path_from_utf8(path).c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd_ < 0) {
+            return;
+        }
+        struct stat st{};
+        if (fstat(fd_, &st) != 0 || st.st_size <= 0 || !S_ISREG(st.st_mode)) {
+            return;
+        }
+        void* mapped = mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ,
+                            MAP_PRIVATE, fd_, 0);
+        if (mapped != MAP_FAILED) {
+            data_ = static_cast<const char*>(mapped);
+            size_ = static_cast<size_t>(st.st_size);
+        }
+#endif
+    }
+
+    ~MappedFile() {
+#ifdef _WIN32
+        if (data_) {
+            UnmapViewOfFile(data_);
+        }
+        if (mapping_) {
+            CloseHandle(mapping_);
+        }
+        if (file_ != INVALID_HANDLE_VALUE) {
+            CloseHandle(file_);
+        }
+#else
+        if (data_) {
+            munmap(const_cast<char*>(data_), size_);
+        }
+        if (fd_ >= 0) {
+            ::close(fd_);
+        }
+#endif
+    }
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    bool is_open() const { return data_ != nullptr; }
+    const char* data() const { return data_; }
+    size_t size() const { return size_; }
+
+private:
+    const char* data_ = nullptr;
+    size_t size_ = 0;
+#ifdef _WIN32
+    HANDLE file_ = INVALID_HANDLE_VALUE;
+    HANDLE mapping_ = nullptr;
+#else
+    int fd_ = -1;
+#endif
+};
+
+// streambuf over a read-only byte range, with relative/absolute seeking so
+// istream-based parsers (seekg over skipped fields) work over mapped memory.
+class MemoryStreamBuf : public std::streambuf {
+public:
+    MemoryStreamBuf(const char* data, size_t size) {
+        char* begin = const_cast<char*>(data);
+        setg(begin, begin, begin + size);
+    }
+
+protected:
+    pos_type seekoff(off_type off, std::ios_base::seekdir dir,
+                     std::ios_base::openmode which) override {
+        if (!(which & std::ios_base::in)) {
+            return pos_type(off_type(-1));
+        }
+        char* target = nullptr;
+        switch (dir) {
+            case std::ios_base::beg: target = eback() + off; break;
+            case std::ios_base::cur: target = gptr() + off; break;
+            case std::ios_base::end: target = egptr() + off; break;
+            default: return pos_type(off_type(-1));
+        }
+        if (target < eback() || target > egptr()) {
+            return pos_type(off_type(-1));
+        }
+        setg(eback(), target, egptr());
+        return pos_type(target - eback());
+    }
+
+    pos_type seekpos(pos_type pos, std::ios_base::openmode which) override {
+        return seekoff(off_type(pos), std::ios_base::beg, which);
+    }
+};
+
+}  // namespace utils
+}  // namespace lemon
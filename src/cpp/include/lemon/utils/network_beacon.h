@@ -2,7 +2,9 @@
 #define NETWORK_BEACON_H
 
 #include <atomic>
+#include <condition_variable>
 #include <cstdint>
+#include <functional>
 #include <mutex>
 #include <string>
 #include <thread>
@@ -28,22 +30,45 @@ public:
 
     // Server: Starts a blocking loop to shout presence
     std::string getLocalHostname();
-    std::string buildStandardPayloadPattern(std::string hostname, std::string hostUrl);
+    // statusJson == "" omits the "status" field (heartbeat). stateSeq and
+    // intervalSeconds, when non-zero, add the protocol-v2 fields ("v", "seq",
+    // "interval") so listeners can tell a heartbeat for cached state from a
+    // missed update and size their freshness window to the current cadence.
+    std::string buildStandardPayloadPattern(std::string hostname, std::string hostUrl,
+                                            const std::string& statusJson = "",
+                                            uint64_t stateSeq = 0,
+                                            int intervalSeconds = 0);
+
+    // Optional JSON status block carried by the beacon ("status" key), so
+    // listeners can track server state without HTTP polling. Called once per
+    // broadcast cycle; return "" to omit the field. Loopback beacons always
+    // carry the full block; subnet broadcasts only send it when it changed
+    // or on periodic keyframes, heartbeating the state sequence in between
+    // and stretching their cadence while the state is idle.
+    void setStatusProvider(std::function<std::string()> provider);
     bool isRFC1918(const std::string& ipAddress);
     std::vector<NetworkInterfaceInfo> getLocalRFC1918Interfaces();
     void startBroadcasting(int beaconPort, int serverPort, uint16_t intervalSeconds);
     void stopBroadcasting();
 
+    // Wakes the broadcast loop and forces the next beacon to carry the full
+    // status block. Used to answer discovery probes immediately instead of
+    // making the prober wait out the adaptive interval.
+    void requestImmediateBeacon();
+
 private:
     std::mutex _netMtx;
+    std::condition_variable _netCv;
     std::thread _netThread;
     std::atomic<bool> _netThreadRunning = false;
+    bool _keyframeRequested = false;
 
     uint16_t _port;
     uint16_t _serverPort;
     SOCKET _socket;
     bool _isInitialized;
     uint16_t _broadcastIntervalSeconds;
+    std::function<std::string()> _statusProvider;
     void cleanup();
     void createSocket();
     void broadcastThreadLoop();
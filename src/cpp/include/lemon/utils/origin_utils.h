@@ -3,7 +3,9 @@
 #include <string>
 #include <algorithm>
 #include <cctype>
+#include <mutex>
 #include <sstream>
+#include <unordered_map>
 
 namespace lemon::utils {
 
@@ -183,6 +185,39 @@ inline bool is_origin_allowed(const std::string& origin_str, const std::string&
     return false;
 }
 
+// Memoized is_origin_allowed decisions. Browsers resend the same Origin on
+// every request and preflight, so each distinct origin is parsed and checked
+// against the allow list once and then answered from an O(1) lookup. Origin
+// strings are attacker-controlled, so the cache is bounded; it is also
+// cleared wholesale when the configured allow list changes.
+class OriginAllowCache {
+public:
+    bool allowed(const std::string& origin_str, const std::string& allowed_origins_env) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (allowed_origins_env != allowed_origins_env_) {
+            allowed_origins_env_ = allowed_origins_env;
+            decisions_.clear();
+        }
+        auto it = decisions_.find(origin_str);
+        if (it != decisions_.end()) {
+            return it->second;
+        }
+        const bool result = is_origin_allowed(origin_str, allowed_origins_env);
+        if (decisions_.size() >= kMaxEntries) {
+            decisions_.clear();
+        }
+        decisions_.emplace(origin_str, result);
+        return result;
+    }
+
+private:
+    static constexpr size_t kMaxEntries = 256;
+
+    std::mutex mutex_;
+    std::string allowed_origins_env_;
+    std::unordered_map<std::string, bool> decisions_;
+};
+
 inline bool is_websocket_origin_allowed(const std::string& origin_str, const std::string& allowed_origins_env) {
     if (origin_str.empty()) {
         return false;
@@ -0,0 +1,111 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <string>
+
+namespace lemon {
+namespace utils {
+
+// Incremental line splitter for backend stdout/stderr pipes. The reader
+// thread feeds whole read() chunks; complete lines are emitted in place out
+// of one reusable buffer instead of a substring copy per line. A token
+// bucket caps how many lines per second reach the log sink — a chatty
+// backend is still drained at full read speed so its pipe can never fill and
+// stall inference; overflow lines are counted and reported as a per-window
+// summary line.
+class PipeLineCapture {
+public:
+    static constexpr size_t kDefaultMaxLinesPerSecond = 500;
+    // An unterminated line is flushed at this size so a backend that never
+    // writes '\n' cannot grow the buffer without bound.
+    static constexpr size_t kMaxLineBytes = 64 * 1024;
+
+    explicit PipeLineCapture(std::function<void(const std::string&)> on_line,
+                             size_t max_lines_per_second = kDefaultMaxLinesPerSecond)
+        : on_line_(std::move(on_line)),
+          max_lines_per_second_(max_lines_per_second),
+          tokens_(max_lines_per_second),
+          window_start_(std::chrono::steady_clock::now()) {}
+
+    void feed(const char* data, size_t len) {
+        buffer_.append(data, len);
+        size_t start = 0;
+        while (start < buffer_.size()) {
+            const void* nl = std::memchr(buffer_.data() + start, '\n',
+                                         buffer_.size() - start);
+            if (nl == nullptr) {
+                break;
+            }
+            const size_t pos =
+                static_cast<size_t>(static_cast<const char*>(nl) - buffer_.data());
+            emit(buffer_.data() + start, pos - start);
+            start = pos + 1;
+        }
+        if (start > 0) {
+            buffer_.erase(0, start);
+        }
+        if (buffer_.size() > kMaxLineBytes) {
+            emit(buffer_.data(), buffer_.size());
+            buffer_.clear();
+        }
+    }
+
+    // Flushes the trailing unterminated line and any pending drop summary at
+    // pipe EOF.
+    void finish() {
+        if (!buffer_.empty()) {
+            emit(buffer_.data(), buffer_.size());
+            buffer_.clear();
+        }
+        report_dropped();
+    }
+
+    std::uint64_t total_dropped_lines() const { return total_dropped_; }
+
+private:
+    void emit(const char* data, size_t len) {
+        refill();
+        if (tokens_ == 0) {
+            ++window_dropped_;
+            ++total_dropped_;
+            return;
+        }
+        --tokens_;
+        line_.assign(data, len);
+        on_line_(line_);
+    }
+
+    void refill() {
+        const auto now = std::chrono::steady_clock::now();
+        if (now - window_start_ >= std::chrono::seconds(1)) {
+            report_dropped();
+            tokens_ = max_lines_per_second_;
+            window_start_ = now;
+        }
+    }
+
+    void report_dropped() {
+        if (window_dropped_ == 0) {
+            return;
+        }
+        line_ = "[output capture] dropped " + std::to_string(window_dropped_) +
+                " lines (rate limit)";
+        on_line_(line_);
+        window_dropped_ = 0;
+    }
+
+    std::function<void(const std::string&)> on_line_;
+    size_t max_lines_per_second_;
+    size_t tokens_;
+    std::chrono::steady_clock::time_point window_start_;
+    std::string buffer_;
+    std::string line_;
+    std::uint64_t window_dropped_ = 0;
+    std::uint64_t total_dropped_ = 0;
+};
+
+} // namespace utils
+} // namespace lemon
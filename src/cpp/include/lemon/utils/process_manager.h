@@ -37,6 +37,11 @@ public:
 
     static void stop_process(ProcessHandle handle);
 
+    // Build a handle for a process this lemond did not spawn (e.g. a backend
+    // subprocess inherited across a binary upgrade). On Windows this opens a
+    // real process handle; on POSIX the pid alone is sufficient.
+    static ProcessHandle open_process(int pid);
+
     // Must be non-mutating: on POSIX it must not reap the child, because
     // status/health checks may call this frequently.
     static bool is_running(ProcessHandle handle);
@@ -61,6 +66,10 @@ public:
     // Use this only when another owner will perform the normal lifecycle cleanup.
     static void terminate_process(ProcessHandle handle);
 
+    // Pin the process to a CPU set. Returns false where the platform has no
+    // affinity API (macOS) or the call is rejected.
+    static bool set_process_affinity(ProcessHandle handle, const std::vector<int>& cpus);
+
     // Replacement for system()/popen() that avoids console flashes in GUI apps.
     static int run_command(const std::string& command, std::string& output, int timeout_seconds = 30);
 
@@ -21,6 +21,12 @@ public:
         bool filter_health_logs,
         const std::vector<std::pair<std::string, std::string>>& env_vars) = 0;
 
+    // Attach to an already-running process by pid. The POSIX default is
+    // enough there; Windows implementations must open a real handle.
+    virtual ProcessHandle open_handle(int pid) {
+        return {nullptr, pid};
+    }
+
     virtual void terminate(ProcessHandle handle) = 0;
     virtual bool is_running(ProcessHandle handle) = 0;
     virtual int get_exit_code(ProcessHandle handle) = 0;
@@ -37,6 +43,14 @@ public:
 
     virtual void terminate_without_cleanup(ProcessHandle handle) = 0;
 
+    // Pin a spawned process to a CPU set. The default reports failure so
+    // platforms without a public affinity API (macOS) degrade gracefully.
+    virtual bool set_affinity(ProcessHandle handle, const std::vector<int>& cpus) {
+        (void)handle;
+        (void)cpus;
+        return false;
+    }
+
     // Process with output callback
     virtual int run_with_output(
         const std::string& executable,
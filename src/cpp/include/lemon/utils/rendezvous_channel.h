@@ -0,0 +1,60 @@
+#pragma once
+
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <thread>
+
+#include <nlohmann/json.hpp>
+
+namespace lemon {
+namespace utils {
+
+// Local rendezvous endpoint owned by lemond from the first milliseconds of
+// startup — a unix domain socket (named pipe on Windows) that answers every
+// connection with the server's current lifecycle state and HTTP port. Unlike
+// the UDP beacon, which only exists once the HTTP listener is up and makes
+// clients wait out a broadcast interval, this channel lets the CLI resolve
+// "is lemond here, and on which port?" with a single connect in any server
+// state (starting, ready, stopping).
+class RendezvousChannel {
+public:
+    static RendezvousChannel& global();
+
+    ~RendezvousChannel();
+
+    // Claim the endpoint and begin answering connections. If another live
+    // lemond already owns it, the channel stays unclaimed and this instance
+    // keeps running without one. Idempotent.
+    void start();
+
+    // Update the payload served to subsequent connections. port == 0 keeps
+    // the previously announced port.
+    void set_state(const std::string& state, int port = 0);
+
+    void stop();
+
+    // Client side: connect to a local lemond's rendezvous endpoint and read
+    // its state payload. Returns false when no channel exists (no server, or
+    // a pre-channel server that only has the UDP beacon).
+    static bool query(nlohmann::json& out, int timeout_ms = 250);
+
+private:
+    RendezvousChannel() = default;
+
+    std::string payload() const;
+    void serve_loop();
+
+    mutable std::mutex mutex_;
+    std::string state_ = "starting";
+    int port_ = 0;
+
+    std::atomic<bool> running_{false};
+    std::thread serve_thread_;
+#ifndef _WIN32
+    int listen_fd_ = -1;
+#endif
+};
+
+}  // namespace utils
+}  // namespace lemon
@@ -6,6 +6,7 @@
 #include <mutex>
 #include <string>
 #include <thread>
+#include <vector>
 
 #ifdef _WIN32
     #include <winsock2.h>
@@ -59,6 +60,13 @@ public:
      */
     void send(const json& msg);
 
+    /**
+     * Send several JSON objects as one scatter-gather write (writev /
+     * WSASend), amortizing the per-line syscall. Thread-safe; serialization
+     * buffers are pooled across calls.
+     */
+    void send_batch(const std::vector<json>& msgs);
+
     /**
      * Close the connection and stop the read thread.
      */
@@ -71,10 +79,12 @@ private:
     SOCKET socket_fd_;
     MessageCallback callback_;
     mutable std::mutex socket_mutex_;
+    std::vector<std::string> send_lines_;  // Pooled line buffers; socket_mutex_
 
     void read_loop(const std::string& host, int port);
     bool do_connect(const std::string& host, int port);
     void shutdown_socket();
+    void write_lines_locked(size_t count);
 };
 
 } // namespace utils
@@ -0,0 +1,178 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace lemon {
+namespace utils {
+
+struct TextChunk {
+    size_t index = 0;
+    size_t offset = 0;  // byte offset into the source document
+    std::string text;
+};
+
+struct ChunkingOptions {
+    // "fixed": sliding character windows with overlap.
+    // "sentence": split on sentence boundaries, packed up to max_chars.
+    // "paragraph": split on blank lines, packed up to max_chars.
+    std::string strategy = "paragraph";
+    size_t max_chars = 2000;
+    size_t overlap_chars = 200;  // only used by "fixed"
+};
+
+inline bool is_valid_chunking_strategy(const std::string& strategy) {
+    return strategy == "fixed" || strategy == "sentence" || strategy == "paragraph";
+}
+
+namespace detail {
+
+// Never cut inside a UTF-8 sequence: back a proposed split position up to
+// the start of the code point it would land in.
+inline size_t utf8_floor(const std::string& text, size_t pos) {
+    while (pos > 0 && pos < text.size() &&
+           (static_cast<unsigned char>(text[pos]) & 0xC0) == 0x80) {
+        --pos;
+    }
+    return pos;
+}
+
+inline bool is_space(char c) {
+    return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+}
+
+struct Segment {
+    size_t offset;
+    size_t length;
+};
+
+inline std::vector<Segment> split_sentences(const std::string& text) {
+    std::vector<Segment> segments;
+    size_t start = 0;
+    for (size_t i = 0; i < text.size(); ++i) {
+        const char c = text[i];
+        const bool sentence_end = (c == '.' || c == '!' || c == '?') &&
+                                  (i + 1 >= text.size() || is_space(text[i + 1]));
+        if (sentence_end || c == '\n') {
+            segments.push_back({start, i + 1 - start});
+            start = i + 1;
+        }
+    }
+    if (start < text.size()) {
+        segments.push_back({start, text.size() - start});
+    }
+    return segments;
+}
+
+inline std::vector<Segment> split_paragraphs(const std::string& text) {
+    std::vector<Segment> segments;
+    size_t start = 0;
+    size_t pos = 0;
+    while ((pos = text.find("\n\n", pos)) != std::string::npos) {
+        segments.push_back({start, pos - start});
+        while (pos < text.size() && text[pos] == '\n') {
+            ++pos;
+        }
+        start = pos;
+    }
+    if (start < text.size()) {
+        segments.push_back({start, text.size() - start});
+    }
+    return segments;
+}
+
+inline bool all_whitespace(const std::string& text, size_t offset, size_t length) {
+    for (size_t i = offset; i < offset + length; ++i) {
+        if (!is_space(text[i])) return false;
+    }
+    return true;
+}
+
+// Greedily packs adjacent segments into chunks of at most max_chars; a
+// single segment longer than that is hard-split on code point boundaries.
+inline std::vector<TextChunk> pack_segments(const std::string& text,
+                                            const std::vector<Segment>& segments,
+                                            size_t max_chars) {
+    std::vector<TextChunk> chunks;
+    size_t chunk_start = 0;
+    size_t chunk_end = 0;
+    bool open = false;
+
+    auto flush = [&]() {
+        if (!open || chunk_end <= chunk_start) return;
+        if (!all_whitespace(text, chunk_start, chunk_end - chunk_start)) {
+            chunks.push_back({chunks.size(), chunk_start,
+                              text.substr(chunk_start, chunk_end - chunk_start)});
+        }
+        open = false;
+    };
+
+    for (const auto& segment : segments) {
+        if (segment.length > max_chars) {
+            flush();
+            size_t pos = segment.offset;
+            const size_t end = segment.offset + segment.length;
+            while (pos < end) {
+                size_t piece_end = utf8_floor(text, (std::min)(pos + max_chars, end));
+                if (piece_end <= pos) piece_end = (std::min)(pos + max_chars, end);
+                if (!all_whitespace(text, pos, piece_end - pos)) {
+                    chunks.push_back({chunks.size(), pos,
+                                      text.substr(pos, piece_end - pos)});
+                }
+                pos = piece_end;
+            }
+            continue;
+        }
+        if (open && chunk_end - chunk_start + segment.length > max_chars) {
+            flush();
+        }
+        if (!open) {
+            chunk_start = segment.offset;
+            open = true;
+        }
+        chunk_end = segment.offset + segment.length;
+    }
+    flush();
+    return chunks;
+}
+
+inline std::vector<TextChunk> chunk_fixed(const std::string& text,
+                                          size_t max_chars, size_t overlap_chars) {
+    std::vector<TextChunk> chunks;
+    const size_t overlap = (std::min)(overlap_chars, max_chars - 1);
+    const size_t stride = max_chars - overlap;
+    size_t pos = 0;
+    while (pos < text.size()) {
+        size_t end = utf8_floor(text, (std::min)(pos + max_chars, text.size()));
+        if (end <= pos) end = (std::min)(pos + max_chars, text.size());
+        if (!all_whitespace(text, pos, end - pos)) {
+            chunks.push_back({chunks.size(), pos, text.substr(pos, end - pos)});
+        }
+        if (end >= text.size()) break;
+        const size_t next = utf8_floor(text, pos + stride);
+        // utf8_floor only moves backwards; guarantee forward progress.
+        pos = next > pos ? next : pos + stride;
+    }
+    return chunks;
+}
+
+}  // namespace detail
+
+inline std::vector<TextChunk> chunk_text(const std::string& text,
+                                         const ChunkingOptions& options) {
+    if (text.empty() || options.max_chars == 0) {
+        return {};
+    }
+    if (options.strategy == "fixed") {
+        return detail::chunk_fixed(text, options.max_chars, options.overlap_chars);
+    }
+    const auto segments = options.strategy == "sentence"
+        ? detail::split_sentences(text)
+        : detail::split_paragraphs(text);
+    return detail::pack_segments(text, segments, options.max_chars);
+}
+
+}  // namespace utils
+}  // namespace lemon
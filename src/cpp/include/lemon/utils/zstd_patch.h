@@ -0,0 +1,34 @@
+#pragma once
+
+#include <string>
+
+namespace lemon::utils {
+
+/**
+ * Applies `zstd --patch-from` style binary diffs: the patch is an ordinary
+ * zstd frame whose compression referenced the previous version's archive as
+ * a prefix dictionary, so decompressing it against that same base file
+ * reconstructs the new archive. Frames produced with checksums enabled (the
+ * zstd CLI default) are verified during decompression, so a wrong or
+ * corrupted base fails here rather than producing a broken archive.
+ */
+class ZstdPatch {
+public:
+    /**
+     * Reconstruct output_path from base_path + patch_path. Returns false and
+     * fills `error` on any failure (missing files, oversized base, malformed
+     * frame, checksum mismatch); the partial output file is removed.
+     * The base file is held in memory for the duration of the call.
+     */
+    static bool apply(const std::string& base_path,
+                      const std::string& patch_path,
+                      const std::string& output_path,
+                      std::string& error);
+
+    /** Release asset name for a diff from `from_version` to the version
+     *  that published `filename` (e.g. "llama-….zip.zstd-patch-from-b8600"). */
+    static std::string patch_asset_name(const std::string& filename,
+                                        const std::string& from_version);
+};
+
+} // namespace lemon::utils
@@ -0,0 +1,30 @@
+#pragma once
+
+#include <string>
+
+namespace lemon::utils {
+
+/**
+ * Streaming zstd decompression with the decompressor and the disk write-out
+ * running on separate threads over a bounded buffer queue. libzstd's worker
+ * threads only apply to compression, so this overlap is what keeps archive
+ * decompression disk-bound instead of serializing decompress and write on
+ * one core. The output file is preallocated from the frame's content-size
+ * header when the archive carries one.
+ */
+class ZstdStream {
+public:
+    /** True when the file starts with the zstd frame magic. */
+    static bool is_zstd_file(const std::string& path);
+
+    /**
+     * Decompress src_path into dest_path. Returns false and fills `error`
+     * on any failure (unreadable input, malformed frame, short disk write);
+     * the partial output file is removed.
+     */
+    static bool decompress_file(const std::string& src_path,
+                                const std::string& dest_path,
+                                std::string& error);
+};
+
+} // namespace lemon::utils
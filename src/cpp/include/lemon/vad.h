@@ -1,7 +1,9 @@
 #pragma once
 
-#include <vector>
 #include <chrono>
+#include <cstddef>
+#include <string>
+#include <vector>
 
 namespace lemon {
 
@@ -24,9 +26,17 @@ public:
     enum class Event {
         None,           // No event
         SpeechStart,    // Speech started
+        SpeechEnding,   // Hangover exhausted; end is imminent unless voice resumes
         SpeechEnd       // Speech ended (trigger transcription)
     };
 
+    /**
+     * Fill `config` with a named endpointing preset: "fast" (call-center style
+     * 200ms endpointing), "balanced" (500ms), or "dictation" (the defaults,
+     * 800ms). Returns false and leaves `config` untouched for unknown names.
+     */
+    static bool config_for_profile(const std::string& name, Config& config);
+
     SimpleVAD();
     explicit SimpleVAD(const Config& config);
     ~SimpleVAD() = default;
@@ -39,6 +49,25 @@ public:
      */
     Event process(const std::vector<float>& audio, int sample_rate);
 
+    /**
+     * Allocation-free variant for the realtime path: callers keep a reusable
+     * scratch buffer and pass the raw span.
+     */
+    Event process(const float* samples, size_t count, int sample_rate);
+
+    /**
+     * RMS energy of the chunk most recently passed to process().
+     */
+    float last_rms() const { return last_rms_; }
+
+    /**
+     * Sum of squared samples. Vectorized (SSE2/NEON) where the target
+     * supports it; the scalar kernel is exposed so the microbenchmark can
+     * compare the two.
+     */
+    static float sum_squares(const float* samples, size_t count);
+    static float sum_squares_scalar(const float* samples, size_t count);
+
     /**
      * Check if speech is currently active.
      */
@@ -73,9 +102,10 @@ private:
     int silence_frames_ = 0;     // Consecutive frames without speech
     int onset_counter_ = 0;      // Consecutive voice frames during onset confirmation
     int hangover_counter_ = 0;   // Remaining hangover frames before speech end
+    float last_rms_ = 0.0f;      // RMS of the most recent chunk
 
     // Calculate RMS energy of audio chunk
-    static float calculate_rms(const std::vector<float>& audio);
+    static float calculate_rms(const float* samples, size_t count);
 
     // Get current time in milliseconds
     static int64_t current_time_ms();
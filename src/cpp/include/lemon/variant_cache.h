@@ -0,0 +1,81 @@
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+
+#include <nlohmann/json.hpp>
+
+namespace lemon {
+
+// On-disk TTL cache for /pull/variants responses. Resolving a repository's
+// variant listing costs one or more registry round trips per request, so
+// responses are persisted (variant_cache.json in the lemonade cache dir) and
+// served locally while fresh. A background prefetcher re-fetches entries the
+// user viewed recently once their TTL expires, so the variant picker
+// populates from local data even on a cold UI open.
+class VariantCache {
+public:
+    using Fetcher = std::function<nlohmann::json(const std::string& checkpoint,
+                                                 const std::string& source,
+                                                 bool& not_found)>;
+
+    explicit VariantCache(const std::filesystem::path& manifest_path);
+    ~VariantCache();
+
+    // Cached response if fetched within `ttl`, or at any age when
+    // `allow_stale` (offline mode). Records the view either way so the
+    // prefetcher keeps the entry fresh.
+    std::optional<nlohmann::json> lookup(const std::string& source,
+                                         const std::string& checkpoint,
+                                         std::chrono::seconds ttl,
+                                         bool allow_stale = false);
+
+    void store(const std::string& source, const std::string& checkpoint,
+               const nlohmann::json& body);
+
+    void erase(const std::string& source, const std::string& checkpoint);
+
+    // Periodically re-fetches recently viewed entries whose TTL expired.
+    // `ttl_provider` is polled each cycle; a value <= 0 pauses prefetching.
+    void start_prefetch(Fetcher fetcher,
+                        std::function<std::chrono::seconds()> ttl_provider);
+    void stop_prefetch();
+
+    // Writes the manifest if anything changed, dropping entries not viewed
+    // within the retention window.
+    void save();
+
+private:
+    struct Entry {
+        std::int64_t fetched_at = 0;
+        std::int64_t viewed_at = 0;
+        nlohmann::json body;
+    };
+
+    void load_locked();
+    void save_locked();
+    void prefetch_loop();
+    static std::string key_for(const std::string& source, const std::string& checkpoint);
+
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    std::filesystem::path manifest_path_;
+    std::map<std::string, Entry> entries_;
+    bool loaded_ = false;
+    bool dirty_ = false;
+
+    Fetcher fetcher_;
+    std::function<std::chrono::seconds()> ttl_provider_;
+    std::thread prefetch_thread_;
+    bool stop_requested_ = false;
+};
+
+}  // namespace lemon
@@ -29,6 +29,7 @@ class Router;
  */
 struct PerSessionData {
     char connection_id[32];
+    bool binary_frame;
 };
 
 /**
@@ -109,6 +110,14 @@ private:
         std::string authenticated_token_hash;
         std::string client_session_id;
         bool authenticated = false;
+        // Negotiated via "transport.binary": inbound binary frames carry raw
+        // PCM16 audio, outbound log batches use length-prefixed binary frames.
+        bool binary_transport = false;
+    };
+
+    struct OutboundMessage {
+        std::string payload;
+        bool binary = false;
     };
 
     int port_;
@@ -131,7 +140,7 @@ private:
     // Map connection IDs to lws wsi pointers for sending
     std::unordered_map<std::string, struct lws*> connection_websockets_;
     // Per-connection outbound message queues (deferred write pattern)
-    std::unordered_map<std::string, std::queue<std::string>> message_queues_;
+    std::unordered_map<std::string, std::queue<OutboundMessage>> message_queues_;
     // Per-connection inbound reassembly buffers (libwebsockets may fragment frames)
     std::unordered_map<std::string, std::string> receive_buffers_;
     std::mutex connections_mutex_;
@@ -143,6 +152,9 @@ private:
     // Handle incoming WebSocket message
     void handle_message(const std::string& connection_id, const std::string& msg);
 
+    // Handle incoming binary frame (raw PCM16 audio on realtime connections)
+    void handle_binary_message(const std::string& connection_id, const std::string& msg);
+
     // Handle WebSocket connection close
     void handle_close(const std::string& connection_id);
 
@@ -161,8 +173,18 @@ private:
     // Send JSON message to WebSocket by connection ID
     void send_json(const std::string& connection_id, const json& msg);
 
+    // Send a binary frame to WebSocket by connection ID
+    void send_binary(const std::string& connection_id, std::string payload);
+
+    // [u32le length][record bytes] framing for binary log batches
+    static void append_length_prefixed(std::string& frame, const std::string& record);
+
     void handle_log_subscribe(const std::string& connection_id,
-                              std::optional<uint64_t> after_seq);
+                              std::optional<uint64_t> after_seq,
+                              LogStreamFilter filter);
+    void send_log_entries(const std::string& connection_id,
+                          const std::vector<LogStreamEntry>& entries);
+    bool is_binary_transport(const std::string& connection_id);
     void handle_realtime_connection(const std::string& connection_id,
                                     struct lws* wsi);
     void schedule_pending_writes();
@@ -18,6 +18,8 @@
 #include "model_residency.h"
 #include "backend_manager.h"
 #include "recipe_options.h"
+#include "reservation_policy.h"
+#include "timer_wheel.h"
 #include "backends/backend_descriptor.h"
 
 namespace lemon {
@@ -119,6 +121,13 @@ public:
         return load_duration_ms_;
     }
 
+    // Phase breakdown of the most recent load(). The Router begins a profile
+    // before calling load(); set_process_handle() and wait_for_ready() mark
+    // the spawn and health-poll phases, and backends may mark extra phases.
+    void load_profile_begin();
+    void load_profile_mark(const std::string& phase);
+    json get_load_profile() const;
+
     // Pinned status for eviction prevention
     bool is_pinned() const { return pinned_; }
     void set_pinned(bool pinned) {
@@ -128,6 +137,12 @@ public:
         else recipe_options_.remove_option("pinned");
     }
 
+    // Reservation status comes from config, not from runtime pinning: it cannot
+    // be toggled over the API and is honored even where pinning is not (the
+    // evict-all retry after a failed peer load).
+    bool is_reserved() const { return reservation_enabled(recipe_options_.to_json()); }
+    bool has_dedicated_slot() const { return reservation_has_dedicated_slot(recipe_options_.to_json()); }
+
     // Acquire model for inference, safely recovering from DOWNSIZING/EVICTING if necessary.
     // Blocks if LOADING.
     //
@@ -156,15 +171,33 @@ public:
             return false;
         }
 
-        if (state_ == ModelState::DOWNSIZED) {
-            // Restore the model to full readiness before serving. (A downsize that
-            // failed leaves the model READY, so only DOWNSIZED needs restoring.)
+        if (state_ == ModelState::DOWNSIZED || state_ == ModelState::HIBERNATED) {
+            // Restore the model to full readiness before serving. (A downsize or
+            // hibernate that failed leaves the model READY, so only these two
+            // states need restoring.)
+            const bool hibernated = (state_ == ModelState::HIBERNATED);
             state_ = ModelState::LOADING; // temporarily block others
             lock.unlock();
 
-            this->restore();
+            bool recovered = true;
+            try {
+                if (hibernated) {
+                    this->resume();
+                } else {
+                    this->restore();
+                }
+            } catch (const std::exception&) {
+                recovered = false;
+            }
 
             lock.lock();
+            if (!recovered) {
+                // A failed resume means the relaunch didn't come back; report
+                // not-loaded so the router performs a full cold reload.
+                state_ = ModelState::UNLOADED;
+                state_cv_.notify_all();
+                return false;
+            }
             state_ = ModelState::READY;
             state_cv_.notify_all();
         }
@@ -246,6 +279,36 @@ public:
         state_cv_.notify_all();
     }
 
+    // Called by the eviction engine (under the router lock) to atomically claim an
+    // idle model for hibernation. Accepts READY and DOWNSIZED so the tiers chain:
+    // downsize on soft idle, hibernate on deeper idle, evict last. The same
+    // maintenance guard used by downsize keeps the server alive while the engine
+    // performs hibernate() outside the router lock.
+    bool try_begin_hibernate() {
+        std::lock_guard<std::mutex> lock(state_mutex_);
+        if ((state_ == ModelState::READY || state_ == ModelState::DOWNSIZED) &&
+            active_request_count_ == 0) {
+            pre_hibernate_state_ = state_;
+            state_ = ModelState::HIBERNATING;
+            maintenance_in_progress_ = true;
+            state_cv_.notify_all();
+            return true;
+        }
+        return false;
+    }
+
+    // Completes the hibernation started by try_begin_hibernate(). On failure the
+    // model returns to the exact state it was claimed from so a DOWNSIZED model
+    // is not spuriously promoted back to READY.
+    void finish_hibernate(bool success) {
+        std::lock_guard<std::mutex> lock(state_mutex_);
+        maintenance_in_progress_ = false;
+        if (state_ == ModelState::HIBERNATING) {
+            state_ = success ? ModelState::HIBERNATED : pre_hibernate_state_;
+        }
+        state_cv_.notify_all();
+    }
+
     bool is_busy() const {
         std::lock_guard<std::mutex> lock(state_mutex_);
         return active_request_count_ > 0 || maintenance_in_progress_;
@@ -303,9 +366,34 @@ public:
         std::lock_guard<std::mutex> lock(state_mutex_);
         return recipe_options_;
     }
+
+    // Per-operation-class timeout budget (seconds) from the recipe options.
+    // 0 disables the budget and falls back to the blanket transport behavior.
+    long operation_timeout_seconds(const std::string& option) const {
+        const json value = get_recipe_options().get_option(option);
+        return value.is_number() && value.get<long>() > 0 ? value.get<long>() : 0;
+    }
     int get_process_id() const { return get_process_handle_snapshot().pid; }
     int get_backend_port() const;
 
+    // Re-attach to a backend subprocess inherited from a previous lemond
+    // (binary handover). The subprocess already serves on `port`; callers
+    // verify readiness via wait_for_ready() exactly as after a fresh spawn.
+    void adopt_running_backend(int port, ProcessHandle handle) {
+        port_ = port;
+        set_process_handle(handle);
+    }
+
+    // Health-probe an adopted backend. Success also arms the watchdog, same
+    // as the post-spawn readiness wait.
+    bool verify_adopted_backend(long timeout_seconds = 10) {
+        return wait_for_ready("/health", timeout_seconds);
+    }
+
+    // Release ownership of the backend subprocess so the exiting lemond's
+    // unload-all leaves it running for a successor to adopt by pid.
+    void detach_process_for_handover();
+
     // Cheap liveness gate used by the router. On POSIX this relies on
     // ProcessManager::is_running(), which intentionally checks without reaping.
     virtual bool is_backend_alive() const;
@@ -326,6 +414,11 @@ public:
     // Unload the model and stop the server
     virtual void unload() = 0;
 
+    // Issue a tiny synthetic inference so graph compilation and memory-pool
+    // growth happen before the first user request. Returns false when the
+    // model type has no cheap warmup request; throws on backend errors.
+    bool run_warmup();
+
     void set_load_cancel_flag(std::atomic<bool>* f) { load_cancel_ = f; }
 
     static void set_request_cancel_flag(std::atomic<bool>* f);
@@ -345,6 +438,23 @@ public:
         // No-op by default
     }
 
+    // Hibernate on deep idle: release accelerator memory while keeping a fast
+    // resume path (weights stay warm in the OS page cache). Returns true if the
+    // hibernate succeeded (or was a no-op). The default is a successful no-op,
+    // matching downsize(): backends that cannot hibernate transition to
+    // HIBERNATED once and are not retried while idle.
+    virtual bool hibernate() {
+        // No-op by default
+        return true;
+    }
+
+    // Bring a hibernated model back to full readiness. Throws when the backend
+    // cannot be brought back, in which case the caller treats the model as
+    // unloaded and performs a cold reload.
+    virtual void resume() {
+        // No-op by default
+    }
+
     // Default to an "unsupported" error so non-chat backends (TTS, image,
     // transcription) inherit a sensible response instead of stubbing each one.
     virtual json chat_completion(const json& request) override {
@@ -415,6 +525,14 @@ public:
         return "";
     }
 
+    // Continuous-batching backends report their live queue as {"running",
+    // "waiting", "kv_cache_usage", ...}; everyone else returns null. Called
+    // under the router lock, so implementations must stay cheap (cache any
+    // metrics scrape).
+    virtual json get_queue_stats() {
+        return json();
+    }
+
     virtual std::function<std::map<std::string, nlohmann::json>(const std::string&)> get_additional_telemetry_parser() const {
         return nullptr;
     }
@@ -503,7 +621,9 @@ protected:
     // Validate that the process is running (platform-agnostic check)
     bool is_process_running() const;
 
-    std::string get_base_url() const {
+    // Virtual so backends that run several identical subprocesses (llamacpp
+    // replicas) can route the current request to a specific instance.
+    virtual std::string get_base_url() const {
         return "http://127.0.0.1:" + std::to_string(get_backend_port());
     }
 
@@ -539,25 +659,36 @@ protected:
     // evict_server()) blocks until the operation completes, preventing the server
     // from being unloaded/destroyed while the engine holds a raw pointer to it.
     bool maintenance_in_progress_;
+    ModelState pre_hibernate_state_ = ModelState::READY;
     bool is_streaming_ = false;
     long load_duration_ms_;
     bool pinned_ = false;
     std::atomic<bool>* load_cancel_ = nullptr;
 
+    mutable std::mutex load_profile_mutex_;
+    std::vector<std::pair<std::string, double>> load_phases_;
+    std::chrono::steady_clock::time_point load_profile_last_;
+    bool load_profiling_ = false;
+
 private:
     void begin_backend_request(BackendRequestKind kind);
     void end_backend_request(BackendRequestKind kind);
-    void backend_watchdog_loop();
+    // One watchdog probe cycle, driven by the shared TimerWheel. Returns false
+    // to deschedule once the backend has been marked unavailable.
+    bool backend_watchdog_tick();
     bool has_backend_process_exited() const;
     void request_backend_reset_from_watchdog(const std::string& reason);
 
     mutable std::mutex watchdog_mutex_;
-    std::condition_variable watchdog_cv_;
-    std::thread watchdog_thread_;
     BackendWatchdogPolicy watchdog_policy_;
     std::chrono::steady_clock::time_point last_backend_activity_;
     std::string watchdog_reset_reason_;
-    std::atomic<bool> watchdog_stop_requested_{false};
+    TimerWheel::TaskId watchdog_task_ = 0;
+    std::chrono::seconds watchdog_grace_{90};
+    std::chrono::seconds watchdog_poll_{5};
+    int watchdog_probe_timeout_s_ = 2;
+    int watchdog_max_failures_ = 3;
+    int watchdog_consecutive_failures_ = 0;
     std::atomic<bool> watchdog_running_{false};
     std::atomic<bool> watchdog_triggered_{false};
     std::atomic<int> active_backend_requests_{0};
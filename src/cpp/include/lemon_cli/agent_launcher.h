@@ -12,6 +12,9 @@ struct AgentConfig {
     std::vector<std::string> fallback_paths;
     std::vector<std::pair<std::string, std::string>> env_vars;
     std::vector<std::string> extra_args;
+    // Models the agent hits once running, sent to lemond so they are warm
+    // before the agent's first prompt.
+    std::vector<std::string> prewarm_models;
     std::string install_instructions;
 };
 
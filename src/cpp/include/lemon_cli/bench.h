@@ -42,6 +42,7 @@ struct BenchRunResult {
     double memory_gb = -1.0;    // -1 means not available
     bool success = true;        // false if the run failed (exception, HTTP error, etc.)
     std::string response_text;  // LLM response text (only populated if capture enabled)
+    std::vector<double> token_gap_ms;  // inter-token arrival gaps (streaming mode only)
 };
 
 struct BenchScenarioResult {
@@ -64,6 +65,17 @@ struct BenchScenarioResult {
     double memory_peak_gb() const;
     int input_tokens() const;    // From first run
     int output_tokens() const;   // From first run
+
+    // Inter-token latency pooled across all measurement runs (streaming mode).
+    std::vector<double> all_token_gaps_ms() const;
+    bool has_token_gaps() const;
+    double itl_p50_ms() const;
+    double itl_p95_ms() const;
+    double itl_p99_ms() const;
+    // Gaps above threshold_ms — user-visible mid-generation stalls.
+    int stall_count(double threshold_ms = 500.0) const;
+    // {"edges_ms": [...], "counts": [...], "overflow": N} for gap distribution export.
+    json itl_histogram() const;
 };
 
 struct BenchBackendResult {
@@ -137,7 +149,8 @@ BenchRunResult run_single_bench(lemonade::LemonadeClient& client,
                                 const BenchScenario& scenario,
                                 bool memory_tracking,
                                 bool capture_response,
-                                int timeout);
+                                int timeout,
+                                bool stream = false);
 
 // Benchmark a single text generation
 BenchRunResult run_single_bench_textgen(lemonade::LemonadeClient& client,
@@ -147,6 +160,15 @@ BenchRunResult run_single_bench_textgen(lemonade::LemonadeClient& client,
                                 bool capture_response,
                                 int timeout);
 
+// Benchmark a single text generation over SSE, timestamping each token
+// arrival to capture the inter-token latency distribution.
+BenchRunResult run_single_bench_textgen_stream(lemonade::LemonadeClient& client,
+                                const std::string& model,
+                                const BenchScenario& scenario,
+                                bool memory_tracking,
+                                bool capture_response,
+                                int timeout);
+
 // Run a single benchmark measurement with embedding
 BenchRunResult run_single_bench_embed(lemonade::LemonadeClient& client,
                                 const std::string& model,
@@ -179,7 +201,8 @@ BenchScenarioResult run_scenario(lemonade::LemonadeClient& client,
                                  int timeout,
                                  const std::string& backend_args,
                                  const std::string& response_log_path,
-                                 const std::string& response_timestamp = "");
+                                 const std::string& response_timestamp = "",
+                                 bool stream = false);
 
 // ============================================================
 // CLI Options (raw values parsed by CLI11 in main.cpp)
@@ -200,6 +223,8 @@ struct BenchCliOptions {
     bool no_reload = false;  // disable reload between runs
     std::string compare_file;
     std::string response_log;
+    std::string load_scenario;
+    bool stream = false;
     // Backend-specific custom args (repeatable for multiple comparisons)
     std::vector<std::string> llamacpp_args;
     std::vector<std::string> flm_args;
@@ -207,6 +232,7 @@ struct BenchCliOptions {
     std::vector<std::string> sdcpp_args;
     std::vector<std::string> whispercpp_args;
     int timeout = 300;
+    bool fleet = false;
 };
 
 // ============================================================
@@ -233,6 +259,10 @@ struct BenchConfig {
     // Each recipe can have multiple arg sets; all combinations are benchmarked.
     std::map<std::string, std::vector<std::string>> backend_args;
     int timeout = 300;
+    bool stream = false;  // stream completions over SSE and capture inter-token gaps
+    // Run the server-side `bench` job op on this server and every reachable
+    // federation peer, then aggregate a comparison table.
+    bool fleet = false;
 };
 
 // Main entry point for bench command
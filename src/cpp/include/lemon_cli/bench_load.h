@@ -0,0 +1,80 @@
+#ifndef LEMON_CLI_BENCH_LOAD_H
+#define LEMON_CLI_BENCH_LOAD_H
+
+#include <string>
+#include <vector>
+#include <nlohmann/json.hpp>
+
+namespace lemonade {
+    class LemonadeClient;
+}
+
+namespace lemon_cli {
+
+using json = nlohmann::json;
+
+// ============================================================
+// Concurrent load scenario (multi-model request mixes)
+// ============================================================
+
+struct LoadClass {
+    std::string name;
+    std::string kind;        // "chat", "completions", "embeddings", "reranking"
+    std::string model;
+    double weight = 1.0;
+    int max_tokens = 64;
+    json payload;            // kind-specific inputs (messages, input, query, documents, prompt)
+};
+
+struct LoadArrival {
+    std::string distribution = "poisson";  // "poisson", "uniform", or "burst"
+    double rate_per_second = 1.0;
+    int burst_size = 4;
+    double burst_interval_seconds = 2.0;
+};
+
+struct LoadScenario {
+    std::string name;
+    double duration_seconds = 30.0;
+    int max_in_flight = 8;
+    LoadArrival arrival;
+    std::vector<LoadClass> classes;
+};
+
+// Parse and validate a load scenario JSON file. Throws std::runtime_error
+// with a human-readable message on malformed input.
+LoadScenario parse_load_scenario_file(const std::string& path);
+
+struct LoadClassReport {
+    std::string name;
+    uint64_t dispatched = 0;
+    uint64_t completed = 0;
+    uint64_t failed = 0;
+    std::vector<double> latencies_ms;  // enqueue-to-completion, successes only
+
+    double latency_mean_ms() const;
+    double latency_p50_ms() const;
+    double latency_p95_ms() const;
+    double latency_p99_ms() const;
+};
+
+struct LoadReport {
+    double elapsed_seconds = 0.0;
+    size_t peak_queue_depth = 0;
+    std::vector<LoadClassReport> classes;
+    json router_stats;  // /api/v1/stats snapshot after the run (best effort)
+};
+
+struct BenchLoadConfig {
+    std::string scenario_file;
+    bool json_output = false;
+    std::string output_file;
+    int timeout_ms = 300000;
+};
+
+int handle_bench_load_command(lemonade::LemonadeClient& client,
+                              const BenchLoadConfig& config);
+
+}  // namespace lemon_cli
+
+#endif  // LEMON_CLI_BENCH_LOAD_H
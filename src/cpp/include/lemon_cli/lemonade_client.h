@@ -96,6 +96,9 @@ public:
 
     // Status commands
     int status(int display_port = 0) const;
+    // Renders the same report as status() from a v2 beacon payload assembled
+    // passively off the UDP push channel, skipping the /health round trip.
+    int status_from_beacon(const nlohmann::json& beacon, int display_port = 0) const;
     std::vector<ModelInfo> get_models(bool show_all) const;
 
     // Recipe/backend commands
@@ -141,6 +144,13 @@ private:
     bool is_ssl_ = false;
     std::string normalize_host(const std::string& host) const;
     std::string get_base_url() const;
+
+    // GET with a local snapshot revalidated via ETag/If-None-Match: a 304
+    // answer serves the cached body without re-downloading or re-generating
+    // the full payload. Falls back to a plain fetch when the server sends no
+    // ETag or the snapshot belongs to a different server.
+    std::string fetch_json_with_snapshot(const std::string& path,
+                                         const std::string& snapshot_name) const;
 };
 
 } // namespace lemonade
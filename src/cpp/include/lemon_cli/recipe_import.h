@@ -17,6 +17,12 @@ int import_model_from_json_file(lemonade::LemonadeClient& client,
                                 const std::string& json_path,
                                 std::string* imported_model_out = nullptr);
 
+// Import every *.json model file in a directory, registering across `jobs`
+// worker threads (jobs <= 0 means one per hardware thread).
+int import_models_from_directory(lemonade::LemonadeClient& client,
+                                 const std::string& dir_path,
+                                 int jobs);
+
 // Import a remote recipe from lemonade-sdk/recipes on GitHub.
 int import_remote_recipe(lemonade::LemonadeClient& client,
                          const std::string& repo_dir,
@@ -60,6 +60,11 @@ private:
     std::vector<ModelInfo> get_downloaded_models();
     void fetch_runtime_config();
 
+    // Beacon status push channel: lemond's UDP beacon carries a status block,
+    // so steady-state refresh needs no HTTP polling (local servers only)
+    void start_beacon_listener();
+    bool beacon_is_fresh() const;
+
     // Menu
     void build_menu();
     void refresh_menu();
@@ -114,6 +119,14 @@ private:
     // Recipe options (for context size tracking)
     nlohmann::json recipe_options_;
 
+    // Beacon listener state
+    std::thread beacon_listener_thread_;
+    std::atomic<bool> stop_beacon_listener_{false};
+    std::atomic<long long> last_beacon_ms_{0};
+    std::atomic<int> beacon_interval_s_{2};
+    std::mutex beacon_mutex_;
+    std::string last_beacon_status_;
+
     // Signal handling (non-Windows)
 #ifndef _WIN32
     std::thread signal_monitor_thread_;
@@ -0,0 +1,95 @@
+#include "lemon/admission_controller.h"
+
+namespace lemon {
+
+namespace {
+
+size_t class_index(RequestPriority priority) {
+    return priority == RequestPriority::Batch ? 1 : 0;
+}
+
+}  // namespace
+
+const char* request_priority_name(RequestPriority priority) {
+    return priority == RequestPriority::Batch ? "batch" : "interactive";
+}
+
+void AdmissionController::Ticket::release() {
+    if (controller_) {
+        controller_->release(model_, priority_);
+        controller_ = nullptr;
+    }
+}
+
+AdmissionController::Ticket AdmissionController::admit(const std::string& model,
+                                                       RequestPriority priority,
+                                                       std::chrono::milliseconds max_wait) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    auto& cls = class_stats_[class_index(priority)];
+
+    if (priority == RequestPriority::Batch) {
+        const auto deadline = std::chrono::steady_clock::now() + max_wait;
+        bool waited = false;
+        while (models_[model].active_interactive > 0) {
+            if (!waited) {
+                waited = true;
+                ++cls.waited;
+                ++cls.waiting;
+                ++models_[model].waiting_batch;
+            }
+            if (cv_.wait_until(lock, deadline) == std::cv_status::timeout &&
+                models_[model].active_interactive > 0) {
+                ++cls.forced;
+                break;
+            }
+        }
+        if (waited) {
+            --cls.waiting;
+            --models_[model].waiting_batch;
+        }
+        ++models_[model].active_batch;
+    } else {
+        ++models_[model].active_interactive;
+    }
+
+    ++cls.admitted;
+    ++cls.active;
+    return Ticket(this, model, priority);
+}
+
+void AdmissionController::release(const std::string& model, RequestPriority priority) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = models_.find(model);
+    if (it == models_.end()) {
+        return;
+    }
+    if (priority == RequestPriority::Batch) {
+        --it->second.active_batch;
+    } else {
+        if (--it->second.active_interactive == 0) {
+            cv_.notify_all();
+        }
+    }
+    --class_stats_[class_index(priority)].active;
+    erase_if_idle_locked(model);
+}
+
+void AdmissionController::erase_if_idle_locked(const std::string& model) {
+    auto it = models_.find(model);
+    if (it != models_.end() && it->second.active_interactive == 0 &&
+        it->second.active_batch == 0 && it->second.waiting_batch == 0) {
+        models_.erase(it);
+    }
+}
+
+AdmissionController::ClassStats AdmissionController::stats(RequestPriority priority) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return class_stats_[class_index(priority)];
+}
+
+AdmissionController& AdmissionController::instance() {
+    static AdmissionController controller;
+    return controller;
+}
+
+}  // namespace lemon
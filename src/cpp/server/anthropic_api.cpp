@@ -1,8 +1,9 @@
 #include "lemon/ollama_api.h"
+#include "lemon/anthropic_stream.h"
 #include "lemon/error_types.h"
+#include "lemon/json_repair.h"
 #include <iostream>
 #include <sstream>
-#include <chrono>
 #include <algorithm>
 #include <vector>
 
@@ -54,29 +55,6 @@ static std::string join_text_blocks(const json& value, std::vector<std::string>&
     return join_strings(parts);
 }
 
-static std::string map_finish_reason_to_anthropic_stop_reason(const json& choice) {
-    std::string finish_reason = choice.value("finish_reason", "stop");
-
-    if (finish_reason == "length") {
-        return "max_tokens";
-    }
-    if (finish_reason == "tool_calls") {
-        return "tool_use";
-    }
-    return "end_turn";
-}
-
-static std::string generate_anthropic_message_id() {
-    auto now = std::chrono::system_clock::now().time_since_epoch();
-    auto millis = std::chrono::duration_cast<std::chrono::milliseconds>(now).count();
-    return "msg_" + std::to_string(millis);
-}
-
-static bool write_sse_event(httplib::DataSink& sink, const std::string& event, const json& data) {
-    std::string payload = "event: " + event + "\ndata: " + data.dump() + "\n\n";
-    return sink.write(payload.c_str(), payload.size());
-}
-
 static std::string stringify_anthropic_tool_result_content(const json& content,
                                                            std::vector<std::string>& warnings) {
     if (content.is_string()) {
@@ -131,17 +109,19 @@ static json parse_openai_tool_arguments(const json& tool_call, std::vector<std::
             return json::object();
         }
 
-        try {
-            auto parsed = json::parse(args_str);
-            if (parsed.is_object()) {
-                return parsed;
+        bool repaired = false;
+        if (auto parsed = parse_or_repair_json(args_str, &repaired)) {
+            if (repaired) {
+                add_warning(warnings, "Repaired malformed tool arguments JSON");
+            }
+            if (parsed->is_object()) {
+                return *parsed;
             }
             add_warning(warnings, "Tool arguments were not an object; wrapped as _value");
-            return json{{"_value", parsed}};
-        } catch (...) {
-            add_warning(warnings, "Failed to parse tool arguments as JSON; wrapped as _raw");
-            return json{{"_raw", args_str}};
+            return json{{"_value", *parsed}};
         }
+        add_warning(warnings, "Failed to parse tool arguments as JSON; wrapped as _raw");
+        return json{{"_raw", args_str}};
     }
 
     add_warning(warnings, "Tool arguments had unsupported type; using empty object");
@@ -263,7 +243,7 @@ json OllamaApi::convert_anthropic_to_openai_chat(const json& anthropic_request,
                             continue;
                         }
 
-                        std::string tool_id = block.value("id", generate_anthropic_message_id());
+                        std::string tool_id = block.value("id", anthropic::generate_message_id());
                         json input_obj = json::object();
                         if (block.contains("input")) {
                             if (block["input"].is_object()) {
@@ -469,12 +449,12 @@ json OllamaApi::convert_openai_chat_to_anthropic(const json& openai_response,
     std::string response_text;
     json content_blocks = json::array();
     std::string stop_reason = "end_turn";
-    std::string response_id = openai_response.value("id", generate_anthropic_message_id());
+    std::string response_id = openai_response.value("id", anthropic::generate_message_id());
 
     if (openai_response.contains("choices") && openai_response["choices"].is_array() &&
         !openai_response["choices"].empty()) {
         const auto& choice = openai_response["choices"][0];
-        stop_reason = map_finish_reason_to_anthropic_stop_reason(choice);
+        stop_reason = anthropic::map_finish_reason_to_stop_reason(choice);
 
         if (choice.contains("message") && choice["message"].is_object()) {
             const auto& message = choice["message"];
@@ -497,7 +477,7 @@ json OllamaApi::convert_openai_chat_to_anthropic(const json& openai_response,
                         continue;
                     }
 
-                    std::string tool_id = tool_call.value("id", generate_anthropic_message_id());
+                    std::string tool_id = tool_call.value("id", anthropic::generate_message_id());
                     std::string tool_name;
                     if (tool_call.contains("function") && tool_call["function"].is_object()) {
                         tool_name = tool_call["function"].value("name", "");
@@ -573,309 +553,24 @@ void OllamaApi::stream_openai_sse_to_anthropic_sse(const std::string& openai_bod
                                                    const std::string& model,
                                                    const std::vector<std::string>& warnings,
                                                    StreamFn call_router) {
+    anthropic::StreamTranslator translator(model);
     httplib::DataSink adapter_sink;
-    std::string sse_buffer;
-
-    bool sent_message_start = false;
-    bool sent_text_content_start = false;
-    bool sent_text_content_stop = false;
-    std::vector<bool> started_tool_blocks;
-    std::vector<bool> stopped_tool_blocks;
-    std::vector<std::string> tool_ids;
-    std::vector<std::string> tool_names;
-    std::string stop_reason = "end_turn";
-    int input_tokens = 0;
-    int output_tokens = 0;
-    std::string message_id = generate_anthropic_message_id();
 
     adapter_sink.is_writable = client_sink.is_writable;
 
-    adapter_sink.write = [&client_sink,
-                          &sse_buffer,
-                          &sent_message_start,
-                          &sent_text_content_start,
-                          &sent_text_content_stop,
-                          &started_tool_blocks,
-                          &stopped_tool_blocks,
-                          &tool_ids,
-                          &tool_names,
-                          &stop_reason,
-                          &input_tokens,
-                          &output_tokens,
-                          &message_id,
-                          &model](const char* data, size_t len) -> bool {
-        sse_buffer.append(data, len);
-
-        size_t pos;
-        while ((pos = sse_buffer.find('\n')) != std::string::npos) {
-            std::string line = sse_buffer.substr(0, pos);
-            sse_buffer.erase(0, pos + 1);
-
-            if (!line.empty() && line.back() == '\r') {
-                line.pop_back();
-            }
-
-            if (line.empty() || line.find("data: ") != 0) {
-                continue;
-            }
-
-            std::string json_str = line.substr(6);
-            if (json_str == "[DONE]") {
-                continue;
-            }
-
-            try {
-                auto openai_chunk = json::parse(json_str);
-
-                if (!sent_message_start) {
-                    if (openai_chunk.contains("id") && openai_chunk["id"].is_string()) {
-                        message_id = openai_chunk["id"].get<std::string>();
-                    }
-
-                    json message_start = {
-                        {"type", "message_start"},
-                        {"message", {
-                            {"id", message_id},
-                            {"type", "message"},
-                            {"role", "assistant"},
-                            {"model", model},
-                            {"content", json::array()},
-                            {"stop_reason", nullptr},
-                            {"stop_sequence", nullptr},
-                            {"usage", {{"input_tokens", 0}, {"output_tokens", 0}}}
-                        }}
-                    };
-                    if (!write_sse_event(client_sink, "message_start", message_start)) {
-                        return false;
-                    }
-                    sent_message_start = true;
-                }
-
-                if (openai_chunk.contains("usage") && openai_chunk["usage"].is_object()) {
-                    const auto& usage = openai_chunk["usage"];
-                    input_tokens = usage.value("prompt_tokens", input_tokens);
-                    output_tokens = usage.value("completion_tokens", output_tokens);
-                }
-
-                if (openai_chunk.contains("choices") && openai_chunk["choices"].is_array() &&
-                    !openai_chunk["choices"].empty()) {
-                    const auto& choice = openai_chunk["choices"][0];
-
-                    if (choice.contains("delta") && choice["delta"].is_object()) {
-                        const auto& delta = choice["delta"];
-                        if (delta.contains("content") && delta["content"].is_string()) {
-                            std::string delta_text = delta["content"].get<std::string>();
-                            if (!delta_text.empty()) {
-                                if (!sent_text_content_start) {
-                                    json content_start = {
-                                        {"type", "content_block_start"},
-                                        {"index", 0},
-                                        {"content_block", {{"type", "text"}, {"text", ""}}}
-                                    };
-                                    if (!write_sse_event(client_sink, "content_block_start", content_start)) {
-                                        return false;
-                                    }
-                                    sent_text_content_start = true;
-                                }
-
-                                json content_delta = {
-                                    {"type", "content_block_delta"},
-                                    {"index", 0},
-                                    {"delta", {{"type", "text_delta"}, {"text", delta_text}}}
-                                };
-                                if (!write_sse_event(client_sink, "content_block_delta", content_delta)) {
-                                    return false;
-                                }
-                            }
-                        }
-
-                        if (delta.contains("tool_calls") && delta["tool_calls"].is_array()) {
-                            for (const auto& tool_delta : delta["tool_calls"]) {
-                                if (!tool_delta.is_object()) {
-                                    continue;
-                                }
-
-                                int openai_tool_index = tool_delta.value("index", 0);
-                                if (openai_tool_index < 0) {
-                                    continue;
-                                }
-
-                                size_t idx = static_cast<size_t>(openai_tool_index);
-                                if (started_tool_blocks.size() <= idx) {
-                                    started_tool_blocks.resize(idx + 1, false);
-                                    stopped_tool_blocks.resize(idx + 1, false);
-                                    tool_ids.resize(idx + 1);
-                                    tool_names.resize(idx + 1);
-                                }
-
-                                if (tool_delta.contains("id") && tool_delta["id"].is_string()) {
-                                    tool_ids[idx] = tool_delta["id"].get<std::string>();
-                                }
-
-                                if (tool_delta.contains("function") && tool_delta["function"].is_object()) {
-                                    const auto& fn = tool_delta["function"];
-                                    if (fn.contains("name") && fn["name"].is_string()) {
-                                        tool_names[idx] = fn["name"].get<std::string>();
-                                    }
-                                }
-
-                                if (!started_tool_blocks[idx]) {
-                                    if (tool_ids[idx].empty()) {
-                                        tool_ids[idx] = generate_anthropic_message_id();
-                                    }
-                                    if (tool_names[idx].empty()) {
-                                        tool_names[idx] = "unknown_tool";
-                                    }
-
-                                    json tool_block_start = {
-                                        {"type", "content_block_start"},
-                                        {"index", static_cast<int>(idx) + 1},
-                                        {"content_block", {
-                                            {"type", "tool_use"},
-                                            {"id", tool_ids[idx]},
-                                            {"name", tool_names[idx]},
-                                            {"input", json::object()}
-                                        }}
-                                    };
-                                    if (!write_sse_event(client_sink, "content_block_start", tool_block_start)) {
-                                        return false;
-                                    }
-                                    started_tool_blocks[idx] = true;
-                                }
-
-                                if (tool_delta.contains("function") && tool_delta["function"].is_object()) {
-                                    const auto& fn = tool_delta["function"];
-                                    if (fn.contains("arguments") && fn["arguments"].is_string()) {
-                                        std::string args_delta = fn["arguments"].get<std::string>();
-                                        if (!args_delta.empty()) {
-                                            json tool_input_delta = {
-                                                {"type", "content_block_delta"},
-                                                {"index", static_cast<int>(idx) + 1},
-                                                {"delta", {
-                                                    {"type", "input_json_delta"},
-                                                    {"partial_json", args_delta}
-                                                }}
-                                            };
-                                            if (!write_sse_event(client_sink, "content_block_delta", tool_input_delta)) {
-                                                return false;
-                                            }
-                                        }
-                                    }
-                                }
-                            }
-                        }
-                    }
-
-                    if (choice.contains("finish_reason") && !choice["finish_reason"].is_null()) {
-                        stop_reason = map_finish_reason_to_anthropic_stop_reason(choice);
-                    }
-                }
-            } catch (const std::exception& e) {
-                std::cerr << "[OllamaApi] Failed to parse Anthropic stream chunk: " << e.what() << std::endl;
-            }
+    adapter_sink.write = [&client_sink, &translator](const char* data, size_t len) -> bool {
+        std::string events = translator.feed(data, len);
+        if (events.empty()) {
+            return true;
         }
-        return true;
+        return client_sink.write(events.c_str(), events.size());
     };
 
-    adapter_sink.done = [&client_sink,
-                         &sent_message_start,
-                         &sent_text_content_start,
-                         &sent_text_content_stop,
-                         &started_tool_blocks,
-                         &stopped_tool_blocks,
-                         &stop_reason,
-                         &input_tokens,
-                         &output_tokens,
-                         &warnings]() {
-        if (!sent_message_start) {
-            json message_start = {
-                {"type", "message_start"},
-                {"message", {
-                    {"id", generate_anthropic_message_id()},
-                    {"type", "message"},
-                    {"role", "assistant"},
-                    {"content", json::array()},
-                    {"stop_reason", nullptr},
-                    {"stop_sequence", nullptr},
-                    {"usage", {{"input_tokens", 0}, {"output_tokens", 0}}}
-                }}
-            };
-            if (!write_sse_event(client_sink, "message_start", message_start)) {
-                client_sink.done();
-                return;
-            }
-            sent_message_start = true;
-        }
-
-        if (!sent_text_content_start && started_tool_blocks.empty()) {
-            json content_start = {
-                {"type", "content_block_start"},
-                {"index", 0},
-                {"content_block", {{"type", "text"}, {"text", ""}}}
-            };
-            if (!write_sse_event(client_sink, "content_block_start", content_start)) {
-                client_sink.done();
-                return;
-            }
-            sent_text_content_start = true;
-        }
-
-        if (sent_text_content_start && !sent_text_content_stop) {
-            json content_stop = {
-                {"type", "content_block_stop"},
-                {"index", 0}
-            };
-            if (!write_sse_event(client_sink, "content_block_stop", content_stop)) {
-                client_sink.done();
-                return;
-            }
-            sent_text_content_stop = true;
-        }
-
-        for (size_t idx = 0; idx < started_tool_blocks.size(); ++idx) {
-            if (started_tool_blocks[idx] && !stopped_tool_blocks[idx]) {
-                json tool_stop = {
-                    {"type", "content_block_stop"},
-                    {"index", static_cast<int>(idx) + 1}
-                };
-                if (!write_sse_event(client_sink, "content_block_stop", tool_stop)) {
-                    client_sink.done();
-                    return;
-                }
-                stopped_tool_blocks[idx] = true;
-            }
-        }
-
-        if (stop_reason == "end_turn") {
-            for (bool started : started_tool_blocks) {
-                if (started) {
-                    stop_reason = "tool_use";
-                    break;
-                }
-            }
+    adapter_sink.done = [&client_sink, &translator, &warnings]() {
+        std::string events = translator.finish(warnings);
+        if (!events.empty()) {
+            client_sink.write(events.c_str(), events.size());
         }
-
-        json message_delta = {
-            {"type", "message_delta"},
-            {"delta", {
-                {"stop_reason", stop_reason},
-                {"stop_sequence", nullptr}
-            }},
-            {"usage", {
-                {"input_tokens", input_tokens},
-                {"output_tokens", output_tokens}
-            }}
-        };
-        if (!warnings.empty()) {
-            message_delta["warnings"] = warnings;
-        }
-        if (!write_sse_event(client_sink, "message_delta", message_delta)) {
-            client_sink.done();
-            return;
-        }
-
-        json message_stop = {{"type", "message_stop"}};
-        write_sse_event(client_sink, "message_stop", message_stop);
         client_sink.done();
     };
 
@@ -0,0 +1,300 @@
+#include "lemon/anthropic_stream.h"
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <utility>
+
+#include "lemon/sse_writer.h"
+
+namespace lemon {
+namespace anthropic {
+
+std::string generate_message_id() {
+    auto now = std::chrono::system_clock::now().time_since_epoch();
+    auto millis = std::chrono::duration_cast<std::chrono::milliseconds>(now).count();
+    return "msg_" + std::to_string(millis);
+}
+
+std::string map_finish_reason_to_stop_reason(const json& choice) {
+    std::string finish_reason = choice.value("finish_reason", "stop");
+
+    if (finish_reason == "length") {
+        return "max_tokens";
+    }
+    if (finish_reason == "tool_calls") {
+        return "tool_use";
+    }
+    return "end_turn";
+}
+
+std::string format_sse_event(const std::string& event, const json& data) {
+    std::string out;
+    append_sse_event(out, event, data);
+    return out;
+}
+
+StreamTranslator::StreamTranslator(std::string model)
+    : model_(std::move(model)), message_id_(generate_message_id()) {}
+
+std::string StreamTranslator::feed(const char* data, size_t len) {
+    sse_buffer_.append(data, len);
+
+    std::string out;
+    size_t pos;
+    while ((pos = sse_buffer_.find('\n')) != std::string::npos) {
+        std::string line = sse_buffer_.substr(0, pos);
+        sse_buffer_.erase(0, pos + 1);
+
+        if (!line.empty() && line.back() == '\r') {
+            line.pop_back();
+        }
+
+        if (line.rfind("data: ", 0) != 0) {
+            continue;
+        }
+
+        std::string json_str = line.substr(6);
+        if (json_str == "[DONE]") {
+            continue;
+        }
+
+        try {
+            out += translate_chunk(json::parse(json_str));
+        } catch (const std::exception& e) {
+            std::cerr << "[OllamaApi] Failed to parse Anthropic stream chunk: " << e.what() << std::endl;
+        }
+    }
+    return out;
+}
+
+std::string StreamTranslator::translate_chunk(json openai_chunk) {
+    std::string out;
+
+    if (!sent_message_start_) {
+        if (openai_chunk.contains("id") && openai_chunk["id"].is_string()) {
+            message_id_ = openai_chunk["id"].get<std::string>();
+        }
+
+        json message_start = {
+            {"type", "message_start"},
+            {"message", {
+                {"id", message_id_},
+                {"type", "message"},
+                {"role", "assistant"},
+                {"model", model_},
+                {"content", json::array()},
+                {"stop_reason", nullptr},
+                {"stop_sequence", nullptr},
+                {"usage", {{"input_tokens", 0}, {"output_tokens", 0}}}
+            }}
+        };
+        append_sse_event(out, "message_start", message_start);
+        sent_message_start_ = true;
+    }
+
+    if (openai_chunk.contains("usage") && openai_chunk["usage"].is_object()) {
+        const auto& usage = openai_chunk["usage"];
+        input_tokens_ = usage.value("prompt_tokens", input_tokens_);
+        output_tokens_ = usage.value("completion_tokens", output_tokens_);
+    }
+
+    if (!openai_chunk.contains("choices") || !openai_chunk["choices"].is_array() ||
+        openai_chunk["choices"].empty()) {
+        return out;
+    }
+
+    const auto& choice = openai_chunk["choices"][0];
+
+    if (choice.contains("delta") && choice["delta"].is_object()) {
+        const auto& delta = choice["delta"];
+
+        if (delta.contains("content") && delta["content"].is_string()) {
+            std::string delta_text = delta["content"].get<std::string>();
+            if (!delta_text.empty()) {
+                if (text_index_ < 0) {
+                    text_index_ = next_index_++;
+                    json content_start = {
+                        {"type", "content_block_start"},
+                        {"index", text_index_},
+                        {"content_block", {{"type", "text"}, {"text", ""}}}
+                    };
+                    append_sse_event(out, "content_block_start", content_start);
+                }
+
+                json content_delta = {
+                    {"type", "content_block_delta"},
+                    {"index", text_index_},
+                    {"delta", {{"type", "text_delta"}, {"text", delta_text}}}
+                };
+                append_sse_event(out, "content_block_delta", content_delta);
+            }
+        }
+
+        if (delta.contains("tool_calls") && delta["tool_calls"].is_array()) {
+            for (const auto& tool_delta : delta["tool_calls"]) {
+                if (!tool_delta.is_object()) {
+                    continue;
+                }
+
+                int openai_tool_index = tool_delta.value("index", 0);
+                if (openai_tool_index < 0) {
+                    continue;
+                }
+
+                auto& block = tool_blocks_[openai_tool_index];
+
+                if (tool_delta.contains("id") && tool_delta["id"].is_string()) {
+                    block.id = tool_delta["id"].get<std::string>();
+                }
+
+                const json* fn = nullptr;
+                if (tool_delta.contains("function") && tool_delta["function"].is_object()) {
+                    fn = &tool_delta["function"];
+                    if (fn->contains("name") && (*fn)["name"].is_string()) {
+                        block.name = (*fn)["name"].get<std::string>();
+                    }
+                }
+
+                if (!block.started) {
+                    if (block.id.empty()) {
+                        block.id = generate_message_id();
+                    }
+                    if (block.name.empty()) {
+                        block.name = "unknown_tool";
+                    }
+
+                    block.index = next_index_++;
+                    json tool_block_start = {
+                        {"type", "content_block_start"},
+                        {"index", block.index},
+                        {"content_block", {
+                            {"type", "tool_use"},
+                            {"id", block.id},
+                            {"name", block.name},
+                            {"input", json::object()}
+                        }}
+                    };
+                    append_sse_event(out, "content_block_start", tool_block_start);
+                    block.started = true;
+                }
+
+                if (fn && fn->contains("arguments") && (*fn)["arguments"].is_string()) {
+                    std::string args_delta = (*fn)["arguments"].get<std::string>();
+                    if (!args_delta.empty()) {
+                        block.args_validator.feed(args_delta);
+                        json tool_input_delta = {
+                            {"type", "content_block_delta"},
+                            {"index", block.index},
+                            {"delta", {
+                                {"type", "input_json_delta"},
+                                {"partial_json", args_delta}
+                            }}
+                        };
+                        append_sse_event(out, "content_block_delta", tool_input_delta);
+                    }
+                }
+            }
+        }
+    }
+
+    if (choice.contains("finish_reason") && !choice["finish_reason"].is_null()) {
+        stop_reason_ = map_finish_reason_to_stop_reason(choice);
+    }
+
+    return out;
+}
+
+std::string StreamTranslator::finish(const std::vector<std::string>& warnings) {
+    std::string out;
+
+    if (!sent_message_start_) {
+        json message_start = {
+            {"type", "message_start"},
+            {"message", {
+                {"id", message_id_},
+                {"type", "message"},
+                {"role", "assistant"},
+                {"model", model_},
+                {"content", json::array()},
+                {"stop_reason", nullptr},
+                {"stop_sequence", nullptr},
+                {"usage", {{"input_tokens", 0}, {"output_tokens", 0}}}
+            }}
+        };
+        append_sse_event(out, "message_start", message_start);
+        sent_message_start_ = true;
+    }
+
+    // Clients expect at least one content block even for an empty message
+    if (text_index_ < 0 && tool_blocks_.empty()) {
+        text_index_ = next_index_++;
+        json content_start = {
+            {"type", "content_block_start"},
+            {"index", text_index_},
+            {"content_block", {{"type", "text"}, {"text", ""}}}
+        };
+        append_sse_event(out, "content_block_start", content_start);
+    }
+
+    std::vector<std::pair<int, const ToolBlock*>> open_blocks;
+    if (text_index_ >= 0) {
+        open_blocks.emplace_back(text_index_, nullptr);
+    }
+    bool any_tool_block = false;
+    for (const auto& entry : tool_blocks_) {
+        if (entry.second.started) {
+            open_blocks.emplace_back(entry.second.index, &entry.second);
+            any_tool_block = true;
+        }
+    }
+    std::sort(open_blocks.begin(), open_blocks.end());
+
+    for (const auto& [index, tool_block] : open_blocks) {
+        if (tool_block && !tool_block->args_validator.invalid()) {
+            std::string suffix = tool_block->args_validator.closing_suffix();
+            if (!suffix.empty()) {
+                json repair_delta = {
+                    {"type", "content_block_delta"},
+                    {"index", index},
+                    {"delta", {
+                        {"type", "input_json_delta"},
+                        {"partial_json", suffix}
+                    }}
+                };
+                append_sse_event(out, "content_block_delta", repair_delta);
+            }
+        }
+        json block_stop = {
+            {"type", "content_block_stop"},
+            {"index", index}
+        };
+        append_sse_event(out, "content_block_stop", block_stop);
+    }
+
+    if (stop_reason_ == "end_turn" && any_tool_block) {
+        stop_reason_ = "tool_use";
+    }
+
+    json message_delta = {
+        {"type", "message_delta"},
+        {"delta", {
+            {"stop_reason", stop_reason_},
+            {"stop_sequence", nullptr}
+        }},
+        {"usage", {
+            {"input_tokens", input_tokens_},
+            {"output_tokens", output_tokens_}
+        }}
+    };
+    if (!warnings.empty()) {
+        message_delta["warnings"] = warnings;
+    }
+    append_sse_event(out, "message_delta", message_delta);
+
+    append_sse_event(out, "message_stop", json{{"type", "message_stop"}});
+    return out;
+}
+
+} // namespace anthropic
+} // namespace lemon
@@ -0,0 +1,133 @@
+#include "lemon/artifact_spool.h"
+
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <system_error>
+
+#include "lemon/logging_config.h"
+#include "lemon/utils/path_utils.h"
+#include <lemon/utils/aixlog.hpp>
+
+namespace fs = std::filesystem;
+
+namespace lemon {
+
+namespace {
+
+std::string make_spill_path() {
+    static std::atomic<uint64_t> counter{0};
+    std::error_code ec;
+    fs::path dir = fs::temp_directory_path(ec);
+    if (ec) dir = ".";
+    return utils::path_to_utf8(dir / ("lemonade-artifact-spool-" +
+                                      std::to_string(counter.fetch_add(1) + 1) + "-" +
+                                      std::to_string(std::chrono::steady_clock::now()
+                                                         .time_since_epoch()
+                                                         .count())));
+}
+
+} // namespace
+
+ArtifactSpool::ArtifactSpool(size_t budget_bytes) : budget_bytes_(budget_bytes) {}
+
+ArtifactSpool::~ArtifactSpool() {
+    if (!spill_path_.empty()) {
+        std::error_code ec;
+        fs::remove(utils::path_from_utf8(spill_path_), ec);
+    }
+}
+
+size_t ArtifactSpool::add(Item item) {
+    Entry entry;
+    entry.type = std::move(item.type);
+    entry.mime = std::move(item.mime);
+    entry.data = std::move(item.data);
+    resident_bytes_ += entry.data.size();
+    entries_.push_back(std::move(entry));
+    enforce_budget();
+    return entries_.size() - 1;
+}
+
+void ArtifactSpool::replace(size_t index, Item item) {
+    Entry& entry = entries_[index];
+    if (!entry.spilled) resident_bytes_ -= entry.data.size();
+    entry.type = std::move(item.type);
+    entry.mime = std::move(item.mime);
+    entry.data = std::move(item.data);
+    entry.spilled = false;
+    entry.offset = 0;
+    entry.length = 0;
+    resident_bytes_ += entry.data.size();
+    enforce_budget();
+}
+
+int ArtifactSpool::last_image_index() const {
+    for (int i = static_cast<int>(entries_.size()) - 1; i >= 0; --i) {
+        if (entries_[i].type == "image") return i;
+    }
+    return -1;
+}
+
+ArtifactSpool::Item ArtifactSpool::get(size_t index) const {
+    const Entry& entry = entries_[index];
+    Item item;
+    item.type = entry.type;
+    item.mime = entry.mime;
+    if (!entry.spilled) {
+        item.data = entry.data;
+        return item;
+    }
+    std::ifstream in(utils::path_from_utf8(spill_path_), std::ios::binary);
+    if (in) {
+        item.data.resize(entry.length);
+        in.seekg(static_cast<std::streamoff>(entry.offset));
+        in.read(&item.data[0], static_cast<std::streamsize>(entry.length));
+        if (in.gcount() == static_cast<std::streamsize>(entry.length)) return item;
+    }
+    LOG(ERROR, "Collection") << "Could not read spilled artifact back from " << spill_path_
+                             << std::endl;
+    item.data.clear();
+    return item;
+}
+
+void ArtifactSpool::enforce_budget() {
+    if (resident_bytes_ <= budget_bytes_) return;
+    for (Entry& entry : entries_) {
+        if (resident_bytes_ <= budget_bytes_) break;
+        if (entry.spilled || entry.data.empty()) continue;
+        if (!spill(entry)) break;
+    }
+}
+
+bool ArtifactSpool::spill(Entry& entry) {
+    if (spill_path_.empty()) spill_path_ = make_spill_path();
+    std::ofstream out(utils::path_from_utf8(spill_path_),
+                      std::ios::app | std::ios::binary);
+    if (!out) {
+        // Without a writable temp dir the spool degrades to unbounded memory,
+        // matching the old behavior.
+        LOG(WARNING, "Collection") << "Could not open artifact spill file " << spill_path_
+                                   << "; keeping payloads in memory" << std::endl;
+        return false;
+    }
+    const auto offset = out.tellp();
+    out.write(entry.data.data(), static_cast<std::streamsize>(entry.data.size()));
+    out.flush();
+    if (!out.good()) {
+        LOG(WARNING, "Collection") << "Could not spill artifact payload to " << spill_path_
+                                   << "; keeping it in memory" << std::endl;
+        return false;
+    }
+    entry.spilled = true;
+    entry.offset = static_cast<size_t>(offset);
+    entry.length = entry.data.size();
+    resident_bytes_ -= entry.data.size();
+    spilled_bytes_ += entry.data.size();
+    entry.data.clear();
+    entry.data.shrink_to_fit();
+    return true;
+}
+
+} // namespace lemon
@@ -0,0 +1,120 @@
+#include "lemon/async_log_sink.h"
+
+#include <atomic>
+#include <chrono>
+#include <utility>
+
+namespace lemon {
+
+namespace {
+
+std::atomic<uint64_t> g_dropped_lines{0};
+
+} // namespace
+
+uint64_t async_log_dropped_lines() {
+    return g_dropped_lines.load(std::memory_order_relaxed);
+}
+
+AsyncLogSink::AsyncLogSink(const AixLog::Filter& filter,
+                           std::vector<std::shared_ptr<AixLog::Sink>> downstream)
+    : AixLog::Sink(filter),
+      downstream_(std::move(downstream)) {
+    writer_ = std::thread([this] { writer_loop(); });
+}
+
+AsyncLogSink::~AsyncLogSink() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        shutdown_ = true;
+    }
+    cv_.notify_all();
+    if (writer_.joinable()) {
+        writer_.join();
+    }
+
+    if (!queue_.empty()) {
+        dispatch(queue_);
+        queue_.clear();
+    }
+}
+
+void AsyncLogSink::log(const AixLog::Metadata& metadata, const std::string& message) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (queue_.size() >= kMaxQueuedRecords) {
+            ++dropped_;
+            g_dropped_lines.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        queue_.push_back(Record{metadata, message});
+    }
+    cv_.notify_one();
+}
+
+void AsyncLogSink::writer_loop() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (true) {
+        cv_.wait(lock, [this] { return shutdown_ || !queue_.empty(); });
+        if (shutdown_) {
+            return;
+        }
+
+        std::deque<Record> batch;
+        batch.swap(queue_);
+
+        uint64_t newly_dropped = dropped_ - dropped_reported_;
+        dropped_reported_ = dropped_;
+
+        lock.unlock();
+        dispatch(batch);
+        if (newly_dropped > 0) {
+            Record notice;
+            notice.metadata.severity = AixLog::Severity::warning;
+            notice.metadata.tag = AixLog::Tag("Logging");
+            notice.metadata.timestamp = AixLog::Timestamp(std::chrono::system_clock::now());
+            notice.message = "Log queue overflow: dropped " +
+                             std::to_string(newly_dropped) + " line(s)";
+            dispatch({notice});
+        }
+        lock.lock();
+    }
+}
+
+void AsyncLogSink::dispatch(const std::deque<Record>& records) {
+    for (const auto& record : records) {
+        for (const auto& sink : downstream_) {
+            if (sink->filter.match(record.metadata)) {
+                sink->log(record.metadata, record.message);
+            }
+        }
+    }
+}
+
+JsonLinesSink::JsonLinesSink(const AixLog::Filter& filter, const std::string& filename)
+    : AixLog::Sink(filter),
+      file_(filename.c_str(), std::ofstream::out | std::ofstream::app) {
+}
+
+void JsonLinesSink::log(const AixLog::Metadata& metadata, const std::string& message) {
+    std::string tag = "log";
+    if (metadata.tag) {
+        tag = metadata.tag.text;
+    } else if (metadata.function) {
+        tag = metadata.function.name;
+    }
+
+    nlohmann::json record = {
+        {"timestamp", metadata.timestamp
+                          ? metadata.timestamp.to_string("%Y-%m-%d %H:%M:%S.#ms")
+                          : ""},
+        {"severity", AixLog::to_string(metadata.severity)},
+        {"tag", tag},
+        {"line", message},
+    };
+
+    file_ << record.dump() << '\n';
+    file_.flush();
+}
+
+} // namespace lemon
@@ -0,0 +1,169 @@
+#include "lemon/audio_resampler.h"
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+
+#if defined(__aarch64__) || defined(_M_ARM64)
+    #include <arm_neon.h>
+    #define LEMON_RESAMPLER_NEON 1
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #include <emmintrin.h>
+    #define LEMON_RESAMPLER_SSE2 1
+#endif
+
+namespace lemon {
+namespace audio {
+
+namespace {
+
+constexpr double kPi = 3.14159265358979323846;
+
+double sinc(double x) {
+    if (std::abs(x) < 1e-12) return 1.0;
+    const double px = kPi * x;
+    return std::sin(px) / px;
+}
+
+}  // namespace
+
+Resampler::Resampler(int input_rate, int output_rate, int taps_per_phase)
+    : input_rate_(input_rate),
+      output_rate_(output_rate),
+      taps_per_phase_(std::max(taps_per_phase, 4)) {
+    const int divisor = std::gcd(input_rate, output_rate);
+    up_factor_ = output_rate / divisor;
+    down_factor_ = input_rate / divisor;
+    if (!is_passthrough()) {
+        build_filter_bank();
+    }
+    reset();
+}
+
+void Resampler::build_filter_bank() {
+    const int L = up_factor_;
+    const int K = taps_per_phase_;
+    const size_t length = static_cast<size_t>(L) * K;
+    const double center = (static_cast<double>(length) - 1.0) / 2.0;
+
+    // Cutoff at the narrower of the two Nyquist limits, in the L-upsampled
+    // domain, pulled in slightly to keep the transition band inside it
+    const double cutoff =
+        0.5 * 0.9 / static_cast<double>(std::max(up_factor_, down_factor_));
+
+    std::vector<double> prototype(length);
+    for (size_t i = 0; i < length; ++i) {
+        const double offset = static_cast<double>(i) - center;
+        const double phase = 2.0 * kPi * static_cast<double>(i) /
+                             (static_cast<double>(length) - 1.0);
+        const double window =
+            0.42 - 0.5 * std::cos(phase) + 0.08 * std::cos(2.0 * phase);
+        prototype[i] = 2.0 * cutoff * sinc(2.0 * cutoff * offset) * window;
+    }
+
+    phase_taps_.assign(length, 0.0f);
+    for (int p = 0; p < L; ++p) {
+        double phase_sum = 0.0;
+        for (int k = 0; k < K; ++k) {
+            phase_sum += prototype[static_cast<size_t>(p) + static_cast<size_t>(k) * L];
+        }
+        // Per-phase DC normalization keeps unity gain across all phases
+        const double scale = (std::abs(phase_sum) > 1e-12) ? 1.0 / phase_sum : 1.0;
+        for (int k = 0; k < K; ++k) {
+            const size_t proto_index =
+                static_cast<size_t>(p) + static_cast<size_t>(K - 1 - k) * L;
+            phase_taps_[static_cast<size_t>(p) * K + k] =
+                static_cast<float>(prototype[proto_index] * scale);
+        }
+    }
+}
+
+void Resampler::reset() {
+    extended_.assign(static_cast<size_t>(taps_per_phase_) - 1, 0.0f);
+    consumed_ = 0;
+    next_output_ = 0;
+}
+
+size_t Resampler::process(const int16_t* input, size_t count, std::vector<int16_t>& out) {
+    out.clear();
+    if (count == 0) {
+        return 0;
+    }
+    if (is_passthrough()) {
+        out.assign(input, input + count);
+        return count;
+    }
+
+    const size_t history = static_cast<size_t>(taps_per_phase_) - 1;
+    extended_.resize(history + count);
+    for (size_t i = 0; i < count; ++i) {
+        extended_[history + i] = static_cast<float>(input[i]);
+    }
+
+    const uint64_t last_available = consumed_ + count - 1;
+    const int K = taps_per_phase_;
+    for (;;) {
+        const uint64_t tick = next_output_ * static_cast<uint64_t>(down_factor_);
+        const uint64_t input_index = tick / static_cast<uint64_t>(up_factor_);
+        if (input_index > last_available) {
+            break;
+        }
+        const size_t phase = static_cast<size_t>(tick % static_cast<uint64_t>(up_factor_));
+        const size_t base = static_cast<size_t>(input_index - consumed_);
+        const float sample =
+            dot(phase_taps_.data() + phase * K, extended_.data() + base,
+                static_cast<size_t>(K));
+        const long rounded = std::lround(sample);
+        out.push_back(static_cast<int16_t>(std::clamp(rounded, -32768L, 32767L)));
+        ++next_output_;
+    }
+
+    std::copy(extended_.end() - static_cast<ptrdiff_t>(history), extended_.end(),
+              extended_.begin());
+    extended_.resize(history);
+    consumed_ += count;
+    return out.size();
+}
+
+float Resampler::dot_scalar(const float* a, const float* b, size_t count) {
+    float sum = 0.0f;
+    for (size_t i = 0; i < count; ++i) {
+        sum += a[i] * b[i];
+    }
+    return sum;
+}
+
+float Resampler::dot(const float* a, const float* b, size_t count) {
+#if defined(LEMON_RESAMPLER_NEON)
+    float32x4_t acc = vdupq_n_f32(0.0f);
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        acc = vmlaq_f32(acc, vld1q_f32(a + i), vld1q_f32(b + i));
+    }
+    float sum = vaddvq_f32(acc);
+    for (; i < count; ++i) {
+        sum += a[i] * b[i];
+    }
+    return sum;
+#elif defined(LEMON_RESAMPLER_SSE2)
+    __m128 acc = _mm_setzero_ps();
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        acc = _mm_add_ps(acc, _mm_mul_ps(_mm_loadu_ps(a + i), _mm_loadu_ps(b + i)));
+    }
+    __m128 shuf = _mm_shuffle_ps(acc, acc, _MM_SHUFFLE(2, 3, 0, 1));
+    acc = _mm_add_ps(acc, shuf);
+    shuf = _mm_shuffle_ps(acc, acc, _MM_SHUFFLE(1, 0, 3, 2));
+    acc = _mm_add_ps(acc, shuf);
+    float sum = _mm_cvtss_f32(acc);
+    for (; i < count; ++i) {
+        sum += a[i] * b[i];
+    }
+    return sum;
+#else
+    return dot_scalar(a, b, count);
+#endif
+}
+
+}  // namespace audio
+}  // namespace lemon
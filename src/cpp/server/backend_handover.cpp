@@ -0,0 +1,97 @@
+#include "lemon/backend_handover.h"
+
+#include "lemon/utils/aixlog.hpp"
+
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+
+namespace lemon {
+
+namespace {
+
+constexpr int kStateVersion = 1;
+
+} // namespace
+
+json HandoverRecord::to_json() const {
+    return {
+        {"model_name", model_name},
+        {"checkpoint", checkpoint},
+        {"recipe", recipe},
+        {"port", port},
+        {"pid", pid},
+        {"options", options},
+    };
+}
+
+std::optional<HandoverRecord> HandoverRecord::from_json(const json& j) {
+    if (!j.is_object()) {
+        return std::nullopt;
+    }
+
+    HandoverRecord record;
+    record.model_name = j.value("model_name", "");
+    record.checkpoint = j.value("checkpoint", "");
+    record.recipe = j.value("recipe", "");
+    record.port = j.value("port", 0);
+    record.pid = j.value("pid", 0);
+    record.options = j.value("options", json::object());
+
+    if (record.model_name.empty() || record.port <= 0 || record.pid <= 0) {
+        return std::nullopt;
+    }
+    return record;
+}
+
+std::string BackendHandover::state_path(const std::string& cache_dir) {
+    return (std::filesystem::path(cache_dir) / "handover.json").string();
+}
+
+bool BackendHandover::save(const std::string& cache_dir,
+                           const std::vector<HandoverRecord>& records) {
+    json entries = json::array();
+    for (const auto& record : records) {
+        entries.push_back(record.to_json());
+    }
+    json state = {
+        {"version", kStateVersion},
+        {"backends", entries},
+    };
+
+    std::ofstream file(state_path(cache_dir), std::ofstream::out | std::ofstream::trunc);
+    if (!file) {
+        LOG(ERROR, "Handover") << "Cannot write " << state_path(cache_dir) << std::endl;
+        return false;
+    }
+    file << state.dump(2) << std::endl;
+    return static_cast<bool>(file);
+}
+
+std::vector<HandoverRecord> BackendHandover::take(const std::string& cache_dir) {
+    const std::string path = state_path(cache_dir);
+    std::vector<HandoverRecord> records;
+
+    std::ifstream file(path);
+    if (!file) {
+        return records;
+    }
+
+    json state = json::parse(file, nullptr, false);
+    file.close();
+    std::remove(path.c_str());
+
+    if (state.is_discarded() || state.value("version", 0) != kStateVersion) {
+        LOG(WARNING, "Handover") << "Ignoring unreadable or mismatched " << path << std::endl;
+        return records;
+    }
+
+    for (const auto& entry : state.value("backends", json::array())) {
+        if (auto record = HandoverRecord::from_json(entry)) {
+            records.push_back(std::move(*record));
+        }
+    }
+    return records;
+}
+
+} // namespace lemon
@@ -9,11 +9,13 @@
 #include "lemon/utils/path_utils.h"
 #include <atomic>
 #include <chrono>
+#include <exception>
 #include <filesystem>
 #include <fstream>
 #include <functional>
 #include <iostream>
 #include <map>
+#include <mutex>
 #include <optional>
 #include <thread>
 #include <vector>
@@ -218,6 +220,23 @@ bool backend_update_required(const std::string& recipe, const std::string& backe
     return false;
 }
 
+struct RocmRootProbe {
+    std::optional<fs::path> root;
+    bool resolved_explicitly = false;
+};
+
+// Probing the ROCm root can spawn rocm-sdk, and every backend sharing the
+// runtime would otherwise repeat it on first install. The answer is fixed for
+// the life of the process (restart lemond after changing the system ROCm).
+const RocmRootProbe& cached_rocm_root_probe() {
+    static const RocmRootProbe probe = [] {
+        RocmRootProbe p;
+        p.root = backends::BackendUtils::resolve_rocm_root(&p.resolved_explicitly);
+        return p;
+    }();
+    return probe;
+}
+
 bool will_install_therock(const std::string& os, const json& backend_versions) {
     // TheRock is needed on Linux and Windows for ROCm stable channel.
     if (os != "linux" && os != "windows") {
@@ -232,11 +251,10 @@ bool will_install_therock(const std::string& os, const json& backend_versions) {
     std::string expected_rocm_version = normalize_runtime_version(therock_version);
 
     // Check if system ROCm matches TheRock version - if so, don't need TheRock.
-    // Resolve once here and thread it through, avoiding a second rocm-sdk spawn.
-    bool resolved_explicitly = false;
-    const auto rocm_root = backends::BackendUtils::resolve_rocm_root(&resolved_explicitly);
-    if (rocm_root &&
-        has_matching_system_rocm_runtime(*rocm_root, resolved_explicitly, expected_rocm_version)) {
+    const RocmRootProbe& probe = cached_rocm_root_probe();
+    if (probe.root &&
+        has_matching_system_rocm_runtime(*probe.root, probe.resolved_explicitly,
+                                         expected_rocm_version)) {
         LOG(DEBUG, "BackendManager")
             << "System ROCm " << expected_rocm_version
             << " matches TheRock version, skipping TheRock installation" << std::endl;
@@ -675,13 +693,19 @@ void BackendManager::install_backend(const std::string& recipe, const std::strin
     };
 
     int backend_total_files = 1;
+    // The backend archive and its runtime download concurrently, so progress
+    // state and callback delivery are serialized under one mutex.
+    std::mutex progress_mutex;
+    const int runtime_file_count = static_cast<int>(runtime_steps.size());
+
     DownloadProgressCallback backend_progress_cb = progress_cb;
     if (progress_cb && !runtime_steps.empty()) {
-        const int runtime_file_count = static_cast<int>(runtime_steps.size());
         backend_progress_cb = [progress_cb,
                                runtime_file_count,
+                               &progress_mutex,
                                &backend_total_files,
                                &normalize_progress](const DownloadProgress& p) -> bool {
+            std::lock_guard<std::mutex> lock(progress_mutex);
             backend_total_files = p.total_files > 0 ? p.total_files : 1;
             const int logical_file_index = p.file_index > 0 ? p.file_index : 1;
             const int logical_total_files = backend_total_files + runtime_file_count;
@@ -694,86 +718,197 @@ void BackendManager::install_backend(const std::string& recipe, const std::strin
         backends::BackendUtils::get_install_directory(spec->recipe, resolved_backend);
     const bool backend_install_dir_existed_before = fs::exists(backend_install_dir);
 
-    bool completion_reported = false;
+    // The backend archive and the shared runtime come from different releases
+    // and land in separate install directories, so they are fetched in
+    // parallel; completion is only reported once both are in place.
+    std::exception_ptr runtime_failure;
+    std::thread runtime_thread;
+    if (!runtime_steps.empty()) {
+        runtime_thread = std::thread([&] {
+            try {
+                for (size_t i = 0; i < runtime_steps.size(); ++i) {
+                    bool runtime_reported_progress = false;
+                    DownloadProgressCallback runtime_progress_cb;
+                    if (progress_cb) {
+                        runtime_progress_cb = [&, i](const DownloadProgress& p) -> bool {
+                            std::lock_guard<std::mutex> lock(progress_mutex);
+                            runtime_reported_progress = true;
+                            const int logical_file_index =
+                                backend_total_files + static_cast<int>(i) + 1;
+                            const int logical_total_files =
+                                backend_total_files + runtime_file_count;
+                            return progress_cb(normalize_progress(
+                                p, logical_file_index, logical_total_files,
+                                /*allow_complete=*/false));
+                        };
+                    }
+                    {
+                        // Single-flight: a second backend sharing this runtime
+                        // waits here instead of racing the same install dir,
+                        // then finds the runtime already in place.
+                        std::lock_guard<std::mutex> lock(runtime_install_mutex_);
+                        runtime_steps[i].install(runtime_progress_cb);
+                    }
+                    if (progress_cb && !runtime_reported_progress) {
+                        std::lock_guard<std::mutex> lock(progress_mutex);
+                        DownloadProgress skipped;
+                        skipped.file = runtime_steps[i].name;
+                        skipped.file_index = backend_total_files + static_cast<int>(i) + 1;
+                        skipped.total_files = backend_total_files + runtime_file_count;
+                        skipped.percent = 100;
+                        progress_cb(skipped);
+                    }
+                }
+            } catch (...) {
+                runtime_failure = std::current_exception();
+            }
+        });
+    }
 
+    std::exception_ptr backend_failure;
     try {
         backends::BackendUtils::install_from_github(
             *spec, params.version, params.repo, params.filename, resolved_backend, backend_progress_cb);
+    } catch (...) {
+        backend_failure = std::current_exception();
+    }
+    if (runtime_thread.joinable()) {
+        runtime_thread.join();
+    }
 
-        const int logical_total_files = backend_total_files + static_cast<int>(runtime_steps.size());
-        for (size_t i = 0; i < runtime_steps.size(); ++i) {
-            const int logical_file_index = backend_total_files + static_cast<int>(i) + 1;
-            const bool is_last_runtime_step = (i + 1 == runtime_steps.size());
-            bool runtime_reported_progress = false;
-            bool runtime_reported_completion = false;
-            DownloadProgress last_runtime_progress;
-
-            DownloadProgressCallback runtime_progress_cb;
-            if (progress_cb) {
-                runtime_progress_cb = [progress_cb,
-                                       logical_file_index,
-                                       logical_total_files,
-                                       is_last_runtime_step,
-                                       &completion_reported,
-                                       &runtime_reported_progress,
-                                       &runtime_reported_completion,
-                                       &last_runtime_progress,
-                                       &normalize_progress](const DownloadProgress& p) -> bool {
-                    runtime_reported_progress = true;
-                    DownloadProgress adjusted = normalize_progress(
-                        p, logical_file_index, logical_total_files, is_last_runtime_step);
-                    if (adjusted.complete) {
-                        runtime_reported_completion = true;
-                        completion_reported = true;
-                    }
-                    last_runtime_progress = adjusted;
-                    return progress_cb(adjusted);
-                };
-            }
+    if (backend_failure || runtime_failure) {
+        // If the backend was newly created and either leg fails, roll back the
+        // backend so the status does not look ready with missing deps.
+        if (!backend_install_dir_existed_before) {
+            std::error_code cleanup_ec;
+            fs::remove_all(backend_install_dir, cleanup_ec);
+        }
+        std::rethrow_exception(backend_failure ? backend_failure : runtime_failure);
+    }
+
+    if (progress_cb && !runtime_steps.empty()) {
+        std::lock_guard<std::mutex> lock(progress_mutex);
+        const int logical_total_files = backend_total_files + runtime_file_count;
+        DownloadProgress complete_progress;
+        complete_progress.file = runtime_steps.back().name;
+        complete_progress.file_index = logical_total_files;
+        complete_progress.total_files = logical_total_files;
+        complete_progress.percent = 100;
+        complete_progress.complete = true;
+        progress_cb(complete_progress);
+    }
+}
+
+BackendManager::UpgradeRefreshReport BackendManager::refresh_staged_upgrades(
+    const std::function<bool(const std::string& recipe)>& recipe_is_idle,
+    bool allow_fetch) {
+    UpgradeRefreshReport report;
+    std::unique_lock<std::mutex> lock(upgrade_refresh_mutex_, std::try_to_lock);
+    if (!lock.owns_lock()) {
+        return report;
+    }
+
+    bool can_fetch = allow_fetch;
+    if (auto* cfg = RuntimeConfig::global()) {
+        if (cfg->offline() || cfg->no_fetch_executables()) {
+            can_fetch = false;
+        }
+    }
 
-            runtime_steps[i].install(runtime_progress_cb);
+    const fs::path bin_root = utils::get_downloaded_bin_dir();
+    std::error_code recipe_ec;
+    fs::directory_iterator recipe_it(bin_root, recipe_ec);
+    for (fs::directory_iterator end; !recipe_ec && recipe_it != end;
+         recipe_it.increment(recipe_ec)) {
+        if (!recipe_it->is_directory()) {
+            continue;
+        }
+        const std::string recipe = recipe_it->path().filename().string();
+        auto* spec = backends::try_get_spec_for_recipe(recipe);
+        if (!spec || !spec->install_params_fn) {
+            continue;
+        }
 
-            if (!progress_cb) {
+        std::error_code backend_ec;
+        fs::directory_iterator backend_it(recipe_it->path(), backend_ec);
+        for (fs::directory_iterator bend; !backend_ec && backend_it != bend;
+             backend_it.increment(backend_ec)) {
+            if (!backend_it->is_directory()) {
+                continue;
+            }
+            const std::string resolved_backend =
+                backend_it->path().filename().string();
+            // Scratch and staged siblings (.staging, .next, .next-staging,
+            // .old) live alongside the install dirs they belong to.
+            if (resolved_backend.find('.') != std::string::npos) {
+                continue;
+            }
+            if (backends::recipe_has_rocm_channels(recipe) &&
+                resolved_backend == "rocm-stable") {
                 continue;
             }
 
-            if (!runtime_reported_progress) {
-                DownloadProgress skipped;
-                skipped.file = runtime_steps[i].name;
-                skipped.file_index = logical_file_index;
-                skipped.total_files = logical_total_files;
-                skipped.percent = 100;
-                skipped.complete = is_last_runtime_step;
-                completion_reported = completion_reported || skipped.complete;
-                progress_cb(skipped);
-            } else if (is_last_runtime_step && !runtime_reported_completion) {
-                last_runtime_progress.file_index = logical_file_index;
-                last_runtime_progress.total_files = logical_total_files;
-                last_runtime_progress.percent = 100;
-                last_runtime_progress.complete = true;
-                completion_reported = true;
-                progress_cb(last_runtime_progress);
+            const std::string install_dir = backend_it->path().string();
+            const std::string installed_version =
+                read_version_file(fs::path(install_dir) / "version.txt");
+            if (installed_version.empty()) {
+                continue;
             }
-        }
 
-        if (progress_cb && !runtime_steps.empty() && !completion_reported) {
-            DownloadProgress complete_progress;
-            complete_progress.file = runtime_steps.back().name;
-            complete_progress.file_index = logical_total_files;
-            complete_progress.total_files = logical_total_files;
-            complete_progress.percent = 100;
-            complete_progress.complete = true;
-            progress_cb(complete_progress);
-        }
-    } catch (...) {
-        // If the backend was newly created and a required runtime fails, roll
-        // back the backend so the status does not look ready with missing deps.
-        if (!backend_install_dir_existed_before) {
-            std::error_code cleanup_ec;
-            fs::remove_all(backend_install_dir, cleanup_ec);
+            try {
+                std::string pinned_version, pin_repo, pin_filename;
+                if (can_fetch) {
+                    auto params = get_install_params(recipe, resolved_backend);
+                    pinned_version = params.version;
+                    pin_repo = params.repo;
+                    pin_filename = params.filename;
+                }
+
+                std::string staged =
+                    backends::BackendUtils::get_staged_upgrade_version(install_dir);
+                if (!staged.empty() && !pinned_version.empty() &&
+                    staged != pinned_version) {
+                    // The pin moved again while this copy sat staged; discard
+                    // it rather than promote a version nothing references.
+                    std::error_code rm_ec;
+                    fs::remove_all(
+                        backends::BackendUtils::get_staged_upgrade_dir(install_dir),
+                        rm_ec);
+                    staged.clear();
+                }
+
+                if (!staged.empty()) {
+                    if (staged != installed_version && recipe_is_idle &&
+                        recipe_is_idle(recipe)) {
+                        if (!backends::BackendUtils::promote_staged_upgrade(
+                                 install_dir, spec->binary).empty()) {
+                            report.promoted++;
+                            LOG(INFO, "BackendManager")
+                                << "Promoted staged " << recipe << ":"
+                                << resolved_backend << " upgrade to " << staged
+                                << std::endl;
+                        }
+                    }
+                    continue;
+                }
+
+                if (pinned_version.empty() ||
+                    pinned_version == installed_version) {
+                    continue;
+                }
+                backends::BackendUtils::install_from_github(
+                    *spec, pinned_version, pin_repo, pin_filename,
+                    resolved_backend, nullptr, /*stage_only=*/true);
+                report.staged++;
+            } catch (const std::exception& e) {
+                LOG(DEBUG, "BackendManager")
+                    << "Upgrade prefetch skipped for " << recipe << ":"
+                    << resolved_backend << ": " << e.what() << std::endl;
+            }
         }
-        throw;
     }
+
+    return report;
 }
 
 void BackendManager::uninstall_backend(const std::string& recipe, const std::string& backend) {
@@ -1,4 +1,5 @@
 #include "lemon/backends/backend_utils.h"
+#include "lemon/backends/exe_manifest.h"
 #include "lemon/backends/install_staging.h"
 #include "lemon/runtime_config.h"
 #include "lemon/system_info.h"
@@ -9,17 +10,23 @@
 #include "lemon/utils/json_utils.h"
 #include "lemon/utils/http_client.h"
 #include "lemon/utils/process_manager.h"
+#include "lemon/utils/zstd_patch.h"
+#include "lemon/utils/zstd_stream.h"
 #include "lemon/utils/archive_platform.h"
+#include <atomic>
 #include <cctype>
+#include <condition_variable>
 #include <cstdlib>
 #include <cstring>
 #include <filesystem>
 #include <fstream>
 #include <iostream>
+#include <mutex>
 #include <optional>
 #include <lemon/utils/aixlog.hpp>
 #include <algorithm>
 #include <system_error>
+#include <thread>
 #include <vector>
 #include <nlohmann/json.hpp>
 
@@ -109,6 +116,82 @@ namespace lemon::backends {
         return "";
     }
 
+    // Archives retained as patch bases for differential upgrades, one per
+    // (recipe, backend), named like the download cache file:
+    // <zip_name>_<version>_<safe_filename>.
+    static fs::path retained_archive_dir() {
+        return fs::path(utils::get_downloaded_bin_dir()) / "archives";
+    }
+
+    static std::string find_retained_archive(const std::string& zip_name,
+                                             const std::string& version) {
+        const std::string prefix = zip_name + "_" + version + "_";
+        std::error_code ec;
+        fs::directory_iterator it(retained_archive_dir(), ec);
+        for (fs::directory_iterator end; !ec && it != end; it.increment(ec)) {
+            if (it->is_regular_file(ec) &&
+                it->path().filename().string().rfind(prefix, 0) == 0) {
+                return it->path().string();
+            }
+        }
+        return "";
+    }
+
+    static void retain_archive_for_diffs(const std::string& zip_path,
+                                         const std::string& zip_name,
+                                         const std::string& log_name) {
+        std::error_code ec;
+        fs::create_directories(retained_archive_dir(), ec);
+        if (ec) {
+            LOG(WARNING, log_name) << "Could not create " << retained_archive_dir().string()
+                                   << ": " << ec.message() << std::endl;
+            return;
+        }
+        const std::string prefix = zip_name + "_";
+        fs::directory_iterator it(retained_archive_dir(), ec);
+        for (fs::directory_iterator end; !ec && it != end; it.increment(ec)) {
+            if (it->is_regular_file(ec) &&
+                it->path().filename().string().rfind(prefix, 0) == 0) {
+                std::error_code remove_ec;
+                fs::remove(it->path(), remove_ec);
+            }
+        }
+        const fs::path retained = retained_archive_dir() / fs::path(zip_path).filename();
+        fs::rename(zip_path, retained, ec);
+        if (ec) {
+            // The download cache can live on a different filesystem.
+            ec.clear();
+            fs::copy_file(zip_path, retained, fs::copy_options::overwrite_existing, ec);
+        }
+        if (ec) {
+            LOG(WARNING, log_name) << "Could not retain archive for differential upgrades: "
+                                   << ec.message() << std::endl;
+        } else {
+            LOG(DEBUG, log_name) << "Retained archive as patch base: "
+                                 << retained.string() << std::endl;
+        }
+    }
+
+    // Verify a patched archive against the expected_hash string published for
+    // the full asset. Only sha256 (plain hex or "sha256:" prefixed) can be
+    // checked locally; any other algorithm fails verification so the caller
+    // falls back to the full download, which verifies with its own machinery.
+    static bool patched_archive_hash_ok(const std::string& zip_path,
+                                        const std::string& expected_hash) {
+        if (expected_hash.empty()) {
+            return true;
+        }
+        std::string want = expected_hash;
+        if (want.rfind("sha256:", 0) == 0) {
+            want = want.substr(7);
+        } else if (want.find(':') != std::string::npos) {
+            return false;
+        }
+        std::transform(want.begin(), want.end(), want.begin(),
+                       [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+        return !want.empty() && want == utils::HttpClient::sha256_file(zip_path);
+    }
+
     bool BackendUtils::extract_zip(const std::string& zip_path, const std::string& dest_dir, const std::string& backend_name) {
         auto archive_platform = utils::create_archive_platform();
         return archive_platform->extract_zip(zip_path, dest_dir, backend_name);
@@ -131,7 +214,13 @@ namespace lemon::backends {
                ends_with(filename, ".tar.xz") ||
                ends_with(filename, ".txz") ||
                ends_with(filename, ".tar.bz2") ||
-               ends_with(filename, ".tbz2");
+               ends_with(filename, ".tbz2") ||
+               ends_with(filename, ".tar.zst") ||
+               ends_with(filename, ".tzst");
+    }
+
+    static bool is_zstd_tarball(const std::string& filename) {
+        return ends_with(filename, ".tar.zst") || ends_with(filename, ".tzst");
     }
 
     static bool is_seven_zip(const std::string& filename) {
@@ -290,8 +379,29 @@ namespace lemon::backends {
         return cache_dir;
     }
 
+    // `tar` decompresses on a single core in-process; for zstd tarballs we
+    // decompress ourselves with the overlapped ZstdStream pipeline and hand
+    // tar a plain .tar, so both stages stay disk-bound.
+    static bool extract_zstd_tarball(const std::string& archive_path,
+                                     const std::string& dest_dir,
+                                     const std::string& backend_name) {
+        const std::string tar_path = archive_path + ".tar";
+        std::string error;
+        if (!utils::ZstdStream::decompress_file(archive_path, tar_path, error)) {
+            LOG(ERROR, backend_name) << "zstd decompression failed: " << error << std::endl;
+            return false;
+        }
+        const bool ok = BackendUtils::extract_tarball(tar_path, dest_dir, backend_name);
+        std::error_code ec;
+        fs::remove(tar_path, ec);
+        return ok;
+    }
+
     // Helper to extract archive files based on extension
     bool BackendUtils::extract_archive(const std::string& archive_path, const std::string& dest_dir, const std::string& backend_name) {
+        if (is_zstd_tarball(archive_path)) {
+            return extract_zstd_tarball(archive_path, dest_dir, backend_name);
+        }
         if (is_tarball(archive_path)) {
             return extract_tarball(archive_path, dest_dir, backend_name);
         }
@@ -309,6 +419,29 @@ namespace lemon::backends {
         return ret.make_preferred().string();
     }
 
+    std::string BackendUtils::get_staged_upgrade_dir(const std::string& install_dir) {
+        return install_dir + ".next";
+    }
+
+    std::string BackendUtils::get_staged_upgrade_version(const std::string& install_dir) {
+        const fs::path version_file =
+            fs::path(get_staged_upgrade_dir(install_dir)) / "version.txt";
+        std::error_code ec;
+        if (!fs::exists(version_file, ec)) {
+            return "";
+        }
+        std::ifstream vf(version_file);
+        std::string version;
+        std::getline(vf, version);
+        return version;
+    }
+
+    std::string BackendUtils::promote_staged_upgrade(const std::string& install_dir,
+                                                     const std::string& binary_name) {
+        return commit_staged_install(get_staged_upgrade_dir(install_dir),
+                                     install_dir, binary_name);
+    }
+
     void BackendUtils::build_bin_config_key(const std::string& recipe,
                                               const std::string& backend,
                                               std::string& out_section,
@@ -350,10 +483,40 @@ namespace lemon::backends {
         return cfg->backend_string(section, bin_key);
     }
 
+    static ExeManifest& exe_manifest() {
+        static ExeManifest manifest(
+            (fs::path(utils::get_downloaded_bin_dir()) / "exe_manifest.json")
+                .string());
+        return manifest;
+    }
+
     std::string BackendUtils::find_executable_in_install_dir(const std::string& install_dir, const std::string& binary_name) {
+        // The manifest short-circuits the recursive install-tree walk while
+        // the recorded executable still matches its recorded size and mtime;
+        // any mismatch falls through to the full walk and re-records.
+        std::string cached = exe_manifest().lookup(install_dir, binary_name);
+        if (!cached.empty()) {
+            return cached;
+        }
         // Delegates to the header-only helper so the executable-lookup logic has
         // a single source of truth shared with commit_staged_install().
-        return find_executable_in_dir(install_dir, binary_name);
+        std::string exe_path = find_executable_in_dir(install_dir, binary_name);
+        if (!exe_path.empty()) {
+            exe_manifest().record(install_dir, binary_name, exe_path);
+        }
+        return exe_path;
+    }
+
+    void BackendUtils::verify_exe_manifest_async() {
+        std::thread([] {
+            const size_t pruned = exe_manifest().verify_all();
+            if (pruned > 0) {
+                LOG(INFO, "BackendUtils")
+                    << "Pruned " << pruned
+                    << " stale backend executable manifest entr"
+                    << (pruned == 1 ? "y" : "ies") << std::endl;
+            }
+        }).detach();
     }
 
     std::string BackendUtils::get_backend_binary_path(const BackendSpec& spec, const std::string& backend) {
@@ -455,13 +618,31 @@ namespace lemon::backends {
                                            const std::string& repo,
                                            const std::string& asset_pattern,
                                            const std::string& backend,
-                                           DownloadProgressCallback progress_cb) {
+                                           DownloadProgressCallback progress_cb,
+                                           bool stage_only) {
         std::string install_dir;
         std::string version_file;
+        std::string previous_version;
         std::string exe_path = find_external_backend_binary(spec.recipe, backend);
         bool needs_install = exe_path.empty();
 
-        if (needs_install) {
+        if (stage_only) {
+            // A user-supplied external binary never goes through the
+            // install/upgrade flow, so there is nothing to prefetch for it.
+            if (!needs_install) {
+                return;
+            }
+            install_dir = get_install_directory(spec.recipe, backend);
+            version_file = get_version_file(install_dir);
+            if (fs::exists(version_file)) {
+                std::ifstream vf(version_file);
+                std::getline(vf, previous_version);
+            }
+            if (previous_version == expected_version ||
+                get_staged_upgrade_version(install_dir) == expected_version) {
+                return;
+            }
+        } else if (needs_install) {
             install_dir = get_install_directory(spec.recipe, backend);
             version_file = get_version_file(install_dir);
 
@@ -479,6 +660,7 @@ namespace lemon::backends {
                     LOG(INFO, spec.log_name()) << "Upgrading " << spec.binary << " from " << installed_version
                             << " to " << expected_version << std::endl;
                     needs_install = true;
+                    previous_version = installed_version;
                     // NOTE: do NOT remove install_dir here. The existing working
                     // binary is kept in place until the replacement has been
                     // downloaded, extracted, and verified; the atomic swap below
@@ -497,6 +679,19 @@ namespace lemon::backends {
             }
         }
 
+        // An upgrade prefetched earlier (stage_only) is promoted without
+        // touching the network.
+        if (!stage_only && needs_install && !install_dir.empty() &&
+            get_staged_upgrade_version(install_dir) == expected_version) {
+            const std::string promoted = promote_staged_upgrade(install_dir, spec.binary);
+            if (!promoted.empty()) {
+                LOG(INFO, spec.log_name()) << "Promoted prefetched " << spec.binary
+                        << " " << expected_version << std::endl;
+                exe_path = promoted;
+                needs_install = false;
+            }
+        }
+
         if (needs_install) {
             LOG(INFO, spec.log_name()) << "Installing " << spec.binary << " (version: "
                     << expected_version << ")" << std::endl;
@@ -512,7 +707,8 @@ namespace lemon::backends {
             // complete, extracted, and verified. Only then is staging atomically
             // swapped into place (see commit_staged_install below), so a slow or
             // interrupted download never destroys a working binary.
-            const std::string staging_dir = install_dir + ".staging";
+            const std::string staging_dir =
+                install_dir + (stage_only ? ".next-staging" : ".staging");
             std::error_code staging_ec;
             fs::remove_all(staging_dir, staging_ec);  // clear any leftover from a prior aborted install
             fs::remove_all(install_dir + ".old", staging_ec);  // and any orphaned swap backup
@@ -645,80 +841,205 @@ namespace lemon::backends {
                 utils::DownloadOptions archive_download_opts;
                 archive_download_opts.expected_hash = lookup_expected_asset_hash(
                     spec.recipe, backend, expected_version, repo, filename);
+                // Backend archives are well under the default 256 MiB ranged
+                // threshold but still minutes on one GitHub connection.
+                archive_download_opts.parallel_connections = 4;
+                archive_download_opts.parallel_min_bytes = 32ull * 1024 * 1024;
+
+                // Differential upgrade: when the previous version's archive was
+                // retained, try a zstd --patch-from diff published alongside the
+                // full asset before pulling the whole archive. Any failure
+                // (no diff asset, patch error, checksum mismatch) falls back to
+                // the full download.
+                bool reconstructed_from_patch = false;
+                auto* cfg = RuntimeConfig::global();
+                if (cfg && cfg->differential_backend_upgrades()
+                        && !previous_version.empty()) {
+                    const std::string patch_base =
+                        find_retained_archive(zip_name, previous_version);
+                    if (!patch_base.empty()) {
+                        const std::string patch_name =
+                            utils::ZstdPatch::patch_asset_name(filename, previous_version);
+                        const std::string patch_path = zip_path + ".zstd-patch";
+                        utils::DownloadOptions patch_opts;
+                        patch_opts.expected_hash = lookup_expected_asset_hash(
+                            spec.recipe, backend, expected_version, repo, patch_name);
+                        auto patch_result = utils::HttpClient::download_file(
+                            base_download_url + patch_name, patch_path, nullptr, {},
+                            patch_opts);
+                        if (patch_result.success) {
+                            std::string patch_error;
+                            if (!utils::ZstdPatch::apply(patch_base, patch_path,
+                                                         zip_path, patch_error)) {
+                                LOG(WARNING, spec.log_name())
+                                    << "Differential upgrade failed (" << patch_error
+                                    << "); falling back to full download" << std::endl;
+                            } else if (!patched_archive_hash_ok(
+                                           zip_path, archive_download_opts.expected_hash)) {
+                                LOG(WARNING, spec.log_name())
+                                    << "Patched archive failed checksum verification; "
+                                    << "falling back to full download" << std::endl;
+                                std::error_code remove_ec;
+                                fs::remove(zip_path, remove_ec);
+                            } else {
+                                LOG(INFO, spec.log_name())
+                                    << "Reconstructed " << filename << " from a "
+                                    << (patch_result.bytes_downloaded / 1024 / 1024)
+                                    << " MB diff against " << previous_version
+                                    << std::endl;
+                                reconstructed_from_patch = true;
+                            }
+                        } else {
+                            LOG(DEBUG, spec.log_name())
+                                << "No differential patch published for " << filename
+                                << " from " << previous_version << std::endl;
+                        }
+                        std::error_code remove_ec;
+                        fs::remove(patch_path, remove_ec);
+                    }
+                }
 
-                auto download_result = utils::HttpClient::download_file(
-                    url, zip_path, http_progress_cb, {}, archive_download_opts);
+                if (!reconstructed_from_patch) {
+                    auto download_result = utils::HttpClient::download_file(
+                        url, zip_path, http_progress_cb, {}, archive_download_opts);
 
-                if (!download_result.success) {
-                    throw std::runtime_error("Failed to download " + spec.binary + " from: " + url +
-                                             " - " + download_result.error_message);
+                    if (!download_result.success) {
+                        throw std::runtime_error("Failed to download " + spec.binary + " from: " + url +
+                                                 " - " + download_result.error_message);
+                    }
                 }
             } else {
                 // Split-archive path. Part names are known up front, but the
                 // total byte size is not. Report per-part bytes and let the
                 // caller/frontend aggregate by file_index / total_files.
-                LOG(INFO, spec.log_name()) << "Downloading " << part_assets.size()
+                //
+                // Parts download on a bounded worker pool while this thread
+                // appends them into the combined archive in order as each
+                // becomes ready, so the network phase overlaps the disk
+                // stitching and at most kMaxParallelParts part files sit on
+                // disk alongside the combined archive.
+                const int total_parts = static_cast<int>(part_assets.size());
+                constexpr int kMaxParallelParts = 3;
+                LOG(INFO, spec.log_name()) << "Downloading " << total_parts
                                            << " split parts from " << repo << "@"
-                                           << expected_version << std::endl;
+                                           << expected_version << " ("
+                                           << (std::min)(kMaxParallelParts, total_parts)
+                                           << " in parallel)" << std::endl;
+
+                std::mutex state_mutex;
+                std::condition_variable state_cv;
+                std::vector<char> part_done(total_parts, 0);
+                std::string first_error;
+                std::atomic<bool> abort_parts{false};
+                std::atomic<int> next_part{0};
+                // progress_cb feeds a single SSE stream; serialize the workers'
+                // calls into it.
+                std::mutex progress_mutex;
+
+                auto part_path_for = [&zip_path](int index) {
+                    return zip_path + ".part" + std::to_string(index);
+                };
+
+                auto worker = [&]() {
+                    while (!abort_parts.load()) {
+                        const int index = next_part.fetch_add(1);
+                        if (index >= total_parts) {
+                            return;
+                        }
+                        const std::string part_filename = part_assets[index];
+                        const std::string part_url = base_download_url + part_filename;
+
+                        LOG(DEBUG, spec.log_name()) << "Downloading part "
+                                                    << (index + 1) << "/" << total_parts
+                                                    << ": " << part_filename << std::endl;
+
+                        // Per-part progress wrapper. Keep byte fields scoped to
+                        // the current part; do not synthesize total_download_size
+                        // unless the true total across all parts is known.
+                        utils::ProgressCallback part_http_cb;
+                        if (progress_cb) {
+                            part_http_cb = [&progress_cb, &progress_mutex, &abort_parts,
+                                            part_filename, index, total_parts]
+                                          (size_t downloaded, size_t total) -> bool {
+                                if (abort_parts.load()) {
+                                    return false;
+                                }
+                                DownloadProgress p;
+                                p.file = part_filename;
+                                p.file_index = index + 1;
+                                p.total_files = total_parts;
+                                p.bytes_downloaded = downloaded;
+                                p.bytes_total = total;
+                                p.percent = total > 0
+                                    ? static_cast<int>((downloaded * 100) / total)
+                                    : 0;
+                                p.complete = false;
+                                std::lock_guard<std::mutex> lock(progress_mutex);
+                                return progress_cb(p);
+                            };
+                        } else {
+                            part_http_cb = utils::create_throttled_progress_callback();
+                        }
 
-                std::ofstream combined(zip_path, std::ios::binary);
-                int part_index = 0;
-                const int total_parts = static_cast<int>(part_assets.size());
-                for (const auto& part_filename : part_assets) {
-                    ++part_index;
-                    std::string part_url = base_download_url + part_filename;
-                    std::string part_path = zip_path + ".part" + std::to_string(part_index - 1);
-
-                    LOG(DEBUG, spec.log_name()) << "Downloading part "
-                                                << part_index << "/" << total_parts
-                                                << ": " << part_filename << std::endl;
-
-                    // Per-part progress wrapper. Keep byte fields scoped to
-                    // the current part; do not synthesize total_download_size
-                    // unless the true total across all parts is known.
-                    utils::ProgressCallback part_http_cb;
-                    if (progress_cb) {
-                        int idx_snapshot = part_index;
-                        std::string name_snapshot = part_filename;
-                        part_http_cb = [&progress_cb, name_snapshot, idx_snapshot, total_parts]
-                                      (size_t downloaded, size_t total) -> bool {
-                            DownloadProgress p;
-                            p.file = name_snapshot;
-                            p.file_index = idx_snapshot;
-                            p.total_files = total_parts;
-                            p.bytes_downloaded = downloaded;
-                            p.bytes_total = total;
-                            p.percent = total > 0
-                                ? static_cast<int>((downloaded * 100) / total)
-                                : 0;
-                            p.complete = false;
-                            return progress_cb(p);
-                        };
-                    } else {
-                        part_http_cb = utils::create_throttled_progress_callback();
+                        utils::DownloadOptions part_download_opts;
+                        part_download_opts.expected_hash = lookup_expected_asset_hash(
+                            spec.recipe, backend, expected_version, repo, part_filename);
+
+                        auto part_result = utils::HttpClient::download_file(
+                            part_url, part_path_for(index), part_http_cb, {}, part_download_opts);
+
+                        std::lock_guard<std::mutex> lock(state_mutex);
+                        if (!part_result.success) {
+                            if (first_error.empty()) {
+                                first_error = "Failed to download " + part_filename
+                                    + " from: " + part_url + " - "
+                                    + part_result.error_message;
+                            }
+                            abort_parts.store(true);
+                        }
+                        part_done[index] = 1;
+                        state_cv.notify_all();
                     }
+                };
 
-                    utils::DownloadOptions part_download_opts;
-                    part_download_opts.expected_hash = lookup_expected_asset_hash(
-                        spec.recipe, backend, expected_version, repo, part_filename);
-
-                    auto part_result = utils::HttpClient::download_file(
-                        part_url, part_path, part_http_cb, {}, part_download_opts);
+                std::vector<std::thread> workers;
+                const int worker_count = (std::min)(kMaxParallelParts, total_parts);
+                for (int i = 0; i < worker_count; ++i) {
+                    workers.emplace_back(worker);
+                }
 
-                    if (!part_result.success) {
-                        combined.close();
-                        fs::remove(part_path);
-                        throw std::runtime_error("Failed to download " + part_filename + " from: " + part_url +
-                                                 " - " + part_result.error_message);
+                {
+                    std::ofstream combined(zip_path, std::ios::binary);
+                    for (int index = 0; index < total_parts; ++index) {
+                        {
+                            std::unique_lock<std::mutex> lock(state_mutex);
+                            state_cv.wait(lock, [&] {
+                                return part_done[index] != 0 || abort_parts.load();
+                            });
+                        }
+                        if (abort_parts.load()) {
+                            break;
+                        }
+                        std::ifstream part_in(part_path_for(index), std::ios::binary);
+                        combined << part_in.rdbuf();
+                        part_in.close();
+                        fs::remove(part_path_for(index));
                     }
+                }
+
+                for (auto& part_worker : workers) {
+                    part_worker.join();
+                }
 
-                    // Append part to the combined archive
-                    std::ifstream part_in(part_path, std::ios::binary);
-                    combined << part_in.rdbuf();
-                    part_in.close();
-                    fs::remove(part_path);
+                if (abort_parts.load()) {
+                    std::error_code cleanup_ec;
+                    for (int index = 0; index < total_parts; ++index) {
+                        fs::remove(part_path_for(index), cleanup_ec);
+                    }
+                    throw std::runtime_error(first_error.empty()
+                        ? "Split-archive download was cancelled"
+                        : first_error);
                 }
-                combined.close();
             }
 
             LOG(DEBUG, spec.log_name()) << "Download complete!" << std::endl;
@@ -775,6 +1096,32 @@ namespace lemon::backends {
             }
             #endif
 
+            if (stage_only) {
+                if (find_executable_in_dir(staging_dir, spec.binary).empty()) {
+                    throw std::runtime_error(
+                        "Staged tree is missing executable: " + spec.binary);
+                }
+                const std::string next_dir = get_staged_upgrade_dir(install_dir);
+                std::error_code next_ec;
+                fs::remove_all(next_dir, next_ec);
+                fs::rename(staging_dir, next_dir, next_ec);
+                if (next_ec) {
+                    throw std::runtime_error("Failed to stage upgrade at " +
+                                             next_dir + ": " + next_ec.message());
+                }
+                staging_guard.active = false;
+                // Retain the archive as a patch base exactly as a completed
+                // install would; the promotion itself downloads nothing.
+                if (auto* cfg = RuntimeConfig::global();
+                    cfg && cfg->differential_backend_upgrades()) {
+                    retain_archive_for_diffs(zip_path, zip_name, spec.log_name());
+                }
+                LOG(INFO, spec.log_name())
+                        << "Staged " << spec.binary << " " << expected_version
+                        << " for promotion at the next idle window" << std::endl;
+                return;
+            }
+
             // Verify the staged tree contains the executable, then atomically
             // swap it into place. commit_staged_install keeps a recoverable .old
             // backup across the swap: it removes the staging tree and leaves
@@ -791,6 +1138,13 @@ namespace lemon::backends {
 
             LOG(DEBUG, spec.log_name()) << "Executable verified at: " << exe_path << std::endl;
 
+            // Keep the verified archive as the patch base for the next
+            // differential upgrade; zip_guard's removal then no-ops.
+            if (auto* cfg = RuntimeConfig::global();
+                cfg && cfg->differential_backend_upgrades()) {
+                retain_archive_for_diffs(zip_path, zip_name, spec.log_name());
+            }
+
             // (The downloaded archive is removed by zip_guard on scope exit.)
 
             // Send completion event now that installation is fully done.
@@ -1,6 +1,7 @@
 #include "lemon/backends/cloud/cloud_server.h"
 #include "lemon/backends/backend_registry.h"
 #include "lemon/model_manager.h"
+#include "lemon/cloud_endpoint_tracker.h"
 #include "lemon/cloud_provider_registry.h"
 #include "lemon/error_types.h"
 #include "lemon/runtime_config.h"
@@ -9,6 +10,7 @@
 #include "lemon/utils/json_utils.h"
 #include <algorithm>
 #include <cctype>
+#include <chrono>
 #include <cstdlib>
 #include <cstring>
 #include <curl/curl.h>
@@ -334,23 +336,31 @@ CloudServer::ResolvedCreds CloudServer::resolve_creds() const {
         return creds;
     }
     creds.api_key = registry_->resolve_key(provider_);
-    creds.base_url = registry_->base_url_for(provider_);
-
-    // The registry already normalizes base_url on install, but a defensive
-    // strip here keeps the contract local — anyone tracing post_with_auth
-    // can see the joined URL can't double-slash.
-    while (!creds.base_url.empty() && creds.base_url.back() == '/') {
-        creds.base_url.pop_back();
+    creds.allow_insecure_http = registry_->allow_insecure_http_for(provider_);
+
+    std::vector<std::string> urls = registry_->base_urls_for(provider_);
+    // The registry already normalizes URLs on install, but a defensive strip
+    // here keeps the contract local — anyone tracing post_with_auth can see
+    // the joined URL can't double-slash.
+    for (auto& url : urls) {
+        while (!url.empty() && url.back() == '/') {
+            url.pop_back();
+        }
     }
-
-    const bool allow_insecure_http =
-        registry_->allow_insecure_http_for(provider_);
-    creds.policy = discovery_policy(creds.base_url, allow_insecure_http);
-    if (!creds.api_key.empty() &&
-        CloudProviderRegistry::is_http_base_url(creds.base_url) &&
-        !allow_insecure_http) {
-        creds.insecure_http_blocked = true;
+    if (!creds.api_key.empty() && !creds.allow_insecure_http) {
+        const bool had_urls = !urls.empty();
+        urls.erase(std::remove_if(urls.begin(), urls.end(),
+                                  CloudProviderRegistry::is_http_base_url),
+                   urls.end());
+        if (had_urls && urls.empty()) {
+            creds.insecure_http_blocked = true;
+        }
     }
+    creds.base_urls = CloudEndpointTracker::instance().rank(std::move(urls));
+    if (!creds.base_urls.empty()) {
+        creds.base_url = creds.base_urls.front();
+    }
+    creds.policy = discovery_policy(creds.base_url, creds.allow_insecure_http);
     return creds;
 }
 
@@ -431,44 +441,76 @@ json CloudServer::post_with_auth(const std::string& path, const json& request,
     if (creds.insecure_http_blocked) {
         return insecure_http_error();
     }
-    if (creds.api_key.empty() || creds.base_url.empty()) {
+    if (creds.api_key.empty() || creds.base_urls.empty()) {
         return missing_creds_error();
     }
-    std::string url = creds.base_url + path;
     std::map<std::string, std::string> headers = {
         {"Authorization", "Bearer " + creds.api_key}
     };
 
-    try {
-        auto response = utils::HttpClient::post(
-            url,
-            request.dump(),
-            headers,
-            timeout_seconds,
-            creds.policy);
-        if (response.status_code == 200) {
-            // Return the body unchanged so the server.cpp handler picks up the
-            // `usage` telemetry like every other backend.
-            return json::parse(response.body);
-        }
-
-        json error_details;
+    auto& tracker = CloudEndpointTracker::instance();
+    for (size_t i = 0; i < creds.base_urls.size(); ++i) {
+        const std::string& base = creds.base_urls[i];
+        const bool last_endpoint = i + 1 == creds.base_urls.size();
+        const std::string url = base + path;
+        const auto start = std::chrono::steady_clock::now();
         try {
-            error_details = json::parse(response.body);
-        } catch (...) {
-            error_details = response.body;
-        }
-        return ErrorResponse::create(
-            "cloud (" + provider_ + ") request failed",
-            ErrorType::BACKEND_ERROR,
-            {
-                {"status_code", response.status_code},
-                {"response", error_details}
+            auto response = utils::HttpClient::post(
+                url,
+                request.dump(),
+                headers,
+                timeout_seconds,
+                discovery_policy(base, creds.allow_insecure_http));
+            const double latency_ms = std::chrono::duration<double, std::milli>(
+                std::chrono::steady_clock::now() - start).count();
+            if (response.status_code == 200) {
+                // Return the body unchanged so the server.cpp handler picks up
+                // the `usage` telemetry like every other backend.
+                json body = json::parse(response.body);
+                tracker.record_success(base, latency_ms);
+                return body;
             }
-        );
-    } catch (const std::exception& e) {
-        return ErrorResponse::from_exception(NetworkException(e.what()));
+
+            json error_details;
+            try {
+                error_details = json::parse(response.body);
+            } catch (...) {
+                error_details = response.body;
+            }
+            // 5xx/429 indicts the endpoint; other 4xx (auth, bad request)
+            // would fail identically everywhere, so don't burn the fallback.
+            const bool endpoint_fault =
+                response.status_code >= 500 || response.status_code == 429;
+            if (!endpoint_fault) {
+                tracker.record_success(base, latency_ms);
+            } else {
+                tracker.record_failure(base);
+                if (!last_endpoint) {
+                    LOG(WARNING, "Cloud")
+                        << "Endpoint " << base << " returned HTTP "
+                        << response.status_code << "; failing over" << std::endl;
+                    continue;
+                }
+            }
+            return ErrorResponse::create(
+                "cloud (" + provider_ + ") request failed",
+                ErrorType::BACKEND_ERROR,
+                {
+                    {"status_code", response.status_code},
+                    {"response", error_details}
+                }
+            );
+        } catch (const std::exception& e) {
+            tracker.record_failure(base);
+            if (!last_endpoint) {
+                LOG(WARNING, "Cloud") << "Endpoint " << base << " failed ("
+                                      << e.what() << "); failing over" << std::endl;
+                continue;
+            }
+            return ErrorResponse::from_exception(NetworkException(e.what()));
+        }
     }
+    return missing_creds_error();
 }
 
 json CloudServer::chat_completion(const json& request) {
@@ -547,7 +589,7 @@ void CloudServer::forward_streaming_request(const std::string& endpoint,
         sink.done();
         return;
     }
-    if (creds.api_key.empty() || creds.base_url.empty()) {
+    if (creds.api_key.empty() || creds.base_urls.empty()) {
         std::string error_msg = missing_creds_sse();
         sink.write(error_msg.c_str(), error_msg.size());
         sink.done();
@@ -557,194 +599,264 @@ void CloudServer::forward_streaming_request(const std::string& endpoint,
         return;
     }
 
-    std::string url = creds.base_url + suffix;
-
     std::map<std::string, std::string> headers = {
         {"Authorization", "Bearer " + creds.api_key}
     };
 
-    try {
-        if (sse) {
-            // Providers return 200 with SSE events on success, and JSON (not
-            // SSE) with 4xx/5xx on auth/quota/format errors. We need clean SSE
-            // output in both cases — but post_stream only surfaces the status
-            // code at the end, so we discriminate by peeking at the first
-            // chunk: SSE bodies start with "data:" or ":" (comment/heartbeat),
-            // JSON errors start with "{" or whitespace. Stream-through if SSE;
-            // buffer if it looks like an error, then emit a clean SSE error
-            // envelope on the non-200 path. Holding the whole body before
-            // flushing (the previous behavior) defeats streaming.
-            std::string body_buffer;
-            bool has_done_marker = false;
-            bool streaming_mode = false;
-            bool first_chunk = true;
-
-            int input_tokens = 0;
-            int output_tokens = 0;
-            double time_to_first_token = 0.0;
-            double tokens_per_second = 0.0;
-            bool has_first_token = false;
-            const auto start_time = std::chrono::steady_clock::now();
-            std::string sse_line_buffer;
-
-            auto process_cloud_line = [&](const std::string& line) {
-                std::string json_str;
-                if (line.find("data: ") == 0) {
-                    json_str = line.substr(6);
-                }
-                if (!json_str.empty() && json_str != "[DONE]") {
-                    try {
-                        auto chunk = json::parse(json_str);
-                        if (chunk.contains("usage") && !chunk["usage"].is_null()) {
-                            auto usage = chunk["usage"];
-                            if (usage.contains("prompt_tokens") && usage["prompt_tokens"].is_number()) {
-                                input_tokens = usage["prompt_tokens"].get<int>();
+    auto& tracker = CloudEndpointTracker::instance();
+
+    // One endpoint attempt. Returns false only when the endpoint failed
+    // before anything reached the client, so the caller may fail over to the
+    // next one; once bytes hit the sink the stream is committed to this
+    // endpoint (a retry would replay content), and every such path finishes
+    // the response itself and returns true.
+    auto attempt_endpoint = [&](const std::string& endpoint_base,
+                                bool last_endpoint) -> bool {
+        const std::string url = endpoint_base + suffix;
+        const auto policy =
+            discovery_policy(endpoint_base, creds.allow_insecure_http);
+        bool wrote_to_client = false;
+
+        try {
+            if (sse) {
+                // Providers return 200 with SSE events on success, and JSON (not
+                // SSE) with 4xx/5xx on auth/quota/format errors. We need clean SSE
+                // output in both cases — but post_stream only surfaces the status
+                // code at the end, so we discriminate by peeking at the first
+                // chunk: SSE bodies start with "data:" or ":" (comment/heartbeat),
+                // JSON errors start with "{" or whitespace. Stream-through if SSE;
+                // buffer if it looks like an error, then emit a clean SSE error
+                // envelope on the non-200 path. Holding the whole body before
+                // flushing (the previous behavior) defeats streaming.
+                std::string body_buffer;
+                bool has_done_marker = false;
+                bool streaming_mode = false;
+                bool first_chunk = true;
+
+                int input_tokens = 0;
+                int output_tokens = 0;
+                double time_to_first_token = 0.0;
+                double tokens_per_second = 0.0;
+                bool has_first_token = false;
+                const auto start_time = std::chrono::steady_clock::now();
+                std::string sse_line_buffer;
+
+                auto process_cloud_line = [&](const std::string& line) {
+                    std::string json_str;
+                    if (line.find("data: ") == 0) {
+                        json_str = line.substr(6);
+                    }
+                    if (!json_str.empty() && json_str != "[DONE]") {
+                        try {
+                            auto chunk = json::parse(json_str);
+                            if (chunk.contains("usage") && !chunk["usage"].is_null()) {
+                                auto usage = chunk["usage"];
+                                if (usage.contains("prompt_tokens") && usage["prompt_tokens"].is_number()) {
+                                    input_tokens = usage["prompt_tokens"].get<int>();
+                                }
+                                if (usage.contains("completion_tokens") && usage["completion_tokens"].is_number()) {
+                                    output_tokens = usage["completion_tokens"].get<int>();
+                                }
                             }
-                            if (usage.contains("completion_tokens") && usage["completion_tokens"].is_number()) {
-                                output_tokens = usage["completion_tokens"].get<int>();
+                        } catch (...) {}
+                    }
+                };
+
+                auto result = utils::HttpClient::post_stream(
+                    url,
+                    forwarded_body,
+                    [&](const char* data, size_t length) -> bool {
+                        if (length == 0) return true;
+                        if (first_chunk) {
+                            first_chunk = false;
+                            size_t i = 0;
+                            while (i < length && std::isspace(static_cast<unsigned char>(data[i]))) ++i;
+                            if (i < length && (data[i] == 'd' || data[i] == ':')) {
+                                streaming_mode = true;
                             }
                         }
-                    } catch (...) {}
-                }
-            };
+                        if (streaming_mode) {
+                            if (std::string_view(data, length).find("[DONE]") != std::string_view::npos) {
+                                has_done_marker = true;
+                            }
 
-            auto result = utils::HttpClient::post_stream(
-                url,
-                forwarded_body,
-                [&](const char* data, size_t length) -> bool {
-                    if (length == 0) return true;
-                    if (first_chunk) {
-                        first_chunk = false;
-                        size_t i = 0;
-                        while (i < length && std::isspace(static_cast<unsigned char>(data[i]))) ++i;
-                        if (i < length && (data[i] == 'd' || data[i] == ':')) {
-                            streaming_mode = true;
-                        }
-                    }
-                    if (streaming_mode) {
-                        if (std::string_view(data, length).find("[DONE]") != std::string_view::npos) {
-                            has_done_marker = true;
-                        }
+                            // Parse SSE lines
+                            sse_line_buffer.append(data, length);
+                            StreamingProxy::process_sse_lines(sse_line_buffer, process_cloud_line);
 
-                        // Parse SSE lines
-                        sse_line_buffer.append(data, length);
-                        StreamingProxy::process_sse_lines(sse_line_buffer, process_cloud_line);
+                            if (!has_first_token && std::string_view(data, length).find("data: ") != std::string_view::npos) {
+                                has_first_token = true;
+                                time_to_first_token = std::chrono::duration<double>(
+                                    std::chrono::steady_clock::now() - start_time).count();
+                            }
 
-                        if (!has_first_token && std::string_view(data, length).find("data: ") != std::string_view::npos) {
-                            has_first_token = true;
-                            time_to_first_token = std::chrono::duration<double>(
-                                std::chrono::steady_clock::now() - start_time).count();
+                            wrote_to_client = true;
+                            return sink.write(data, length);
                         }
-
-                        return sink.write(data, length);
+                        body_buffer.append(data, length);
+                        return true;
+                    },
+                    headers,
+                    timeout_seconds,
+                    nullptr,
+                    policy,
+                    [&sink] { return sink.is_writable && !sink.is_writable(); }
+                );
+
+                if (result.curl_code != CURLE_OK) {
+                    if (result.curl_code == CURLE_WRITE_ERROR ||
+                        result.curl_code == CURLE_ABORTED_BY_CALLBACK) {
+                        LOG(WARNING, "Cloud") << "Client disconnected during stream: CURL error: " << result.curl_error << std::endl;
+                        if (telemetry_callback) {
+                            telemetry_callback(0, 0, 0.0, 0.0, "Client disconnected during stream");
+                        }
+                        return true;
+                    } else if (result.curl_code == CURLE_PARTIAL_FILE || result.curl_code == CURLE_RECV_ERROR) {
+                        if (!has_done_marker) {
+                            throw std::runtime_error("backend connection failed during SSE stream before DONE: CURL error: " + result.curl_error);
+                        }
+                    } else {
+                        throw std::runtime_error("SSE stream failed: CURL error: " + result.curl_error);
                     }
-                    body_buffer.append(data, length);
-                    return true;
-                },
-                headers,
-                timeout_seconds,
-                nullptr,
-                creds.policy
-            );
+                }
 
-            if (result.curl_code != CURLE_OK) {
-                if (result.curl_code == CURLE_WRITE_ERROR) {
-                    LOG(WARNING, "Cloud") << "Client disconnected during stream: CURL error: " << result.curl_error << std::endl;
-                    if (telemetry_callback) {
-                        telemetry_callback(0, 0, 0.0, 0.0, "Client disconnected during stream");
+                if (result.status_code != 200) {
+                    const bool endpoint_fault =
+                        result.status_code >= 500 || result.status_code == 429;
+                    if (endpoint_fault) {
+                        tracker.record_failure(endpoint_base);
+                        if (!wrote_to_client && !last_endpoint) {
+                            LOG(WARNING, "Cloud")
+                                << "Endpoint " << endpoint_base << " returned HTTP "
+                                << result.status_code << "; failing over" << std::endl;
+                            return false;
+                        }
                     }
-                    return;
-                } else if (result.curl_code == CURLE_PARTIAL_FILE || result.curl_code == CURLE_RECV_ERROR) {
-                    if (!has_done_marker) {
-                        throw std::runtime_error("backend connection failed during SSE stream before DONE: CURL error: " + result.curl_error);
+                    LOG(ERROR, "Cloud") << "Provider returned status " << result.status_code
+                                        << ", body: " << body_buffer.substr(0, 200) << std::endl;
+                    json extra = {{"status_code", result.status_code}};
+                    std::string error_msg = sse_error(
+                        "cloud (" + provider_ + ") request failed", "backend_error", extra);
+                    sink.write(error_msg.c_str(), error_msg.size());
+                    sink.done();
+                    if (telemetry_callback) {
+                        telemetry_callback(0, 0, 0.0, 0.0, "cloud (" + provider_ + ") request failed with status " + std::to_string(result.status_code));
                     }
-                } else {
-                    throw std::runtime_error("SSE stream failed: CURL error: " + result.curl_error);
+                    return true;
                 }
-            }
 
-            if (result.status_code != 200) {
-                LOG(ERROR, "Cloud") << "Provider returned status " << result.status_code
-                                    << ", body: " << body_buffer.substr(0, 200) << std::endl;
-                json extra = {{"status_code", result.status_code}};
-                std::string error_msg = sse_error(
-                    "cloud (" + provider_ + ") request failed", "backend_error", extra);
-                sink.write(error_msg.c_str(), error_msg.size());
-                sink.done();
-                if (telemetry_callback) {
-                    telemetry_callback(0, 0, 0.0, 0.0, "cloud (" + provider_ + ") request failed with status " + std::to_string(result.status_code));
+                // 200 OK: if streaming_mode is true we've already flushed everything.
+                // If we somehow buffered on a 200 (provider sent non-SSE success),
+                // flush the buffer now so the client at least sees the payload.
+                if (!body_buffer.empty()) {
+                    sink.write(body_buffer.data(), body_buffer.size());
                 }
-                return;
-            }
+                if (!has_done_marker) {
+                    const char* done_marker = "data: [DONE]\n\n";
+                    sink.write(done_marker, std::strlen(done_marker));
+                }
+                sink.done();
 
-            // 200 OK: if streaming_mode is true we've already flushed everything.
-            // If we somehow buffered on a 200 (provider sent non-SSE success),
-            // flush the buffer now so the client at least sees the payload.
-            if (!body_buffer.empty()) {
-                sink.write(body_buffer.data(), body_buffer.size());
-            }
-            if (!has_done_marker) {
-                const char* done_marker = "data: [DONE]\n\n";
-                sink.write(done_marker, std::strlen(done_marker));
-            }
-            sink.done();
+                // Time to first token is the per-endpoint signal worth ranking on;
+                // total stream duration mostly measures generation length.
+                const double latency_ms =
+                    (has_first_token
+                         ? time_to_first_token
+                         : std::chrono::duration<double>(
+                               std::chrono::steady_clock::now() - start_time).count()) *
+                    1000.0;
+                tracker.record_success(endpoint_base, latency_ms);
 
-            if (telemetry_callback) {
-                if (output_tokens > 0 && time_to_first_token > 0.0) {
-                    double duration = std::chrono::duration<double>(std::chrono::steady_clock::now() - start_time).count();
-                    double generation_duration = duration - time_to_first_token;
-                    if (generation_duration > 0.0) {
-                        tokens_per_second = output_tokens / generation_duration;
+                if (telemetry_callback) {
+                    if (output_tokens > 0 && time_to_first_token > 0.0) {
+                        double duration = std::chrono::duration<double>(std::chrono::steady_clock::now() - start_time).count();
+                        double generation_duration = duration - time_to_first_token;
+                        if (generation_duration > 0.0) {
+                            tokens_per_second = output_tokens / generation_duration;
+                        }
                     }
+                    telemetry_callback(input_tokens, output_tokens, time_to_first_token, tokens_per_second, "");
                 }
-                telemetry_callback(input_tokens, output_tokens, time_to_first_token, tokens_per_second, "");
-            }
-        } else {
-            utils::HttpResponse result = utils::HttpClient::post_stream(
-                url,
-                forwarded_body,
-                [&sink](const char* data, size_t length) {
-                    return sink.write(data, length);
-                },
-                headers,
-                timeout_seconds,
-                nullptr,
-                creds.policy
-            );
-            if (result.curl_code != CURLE_OK) {
-                if (result.curl_code == CURLE_WRITE_ERROR) {
-                    LOG(WARNING, "Cloud") << "Client disconnected during stream: CURL error: " << result.curl_error << std::endl;
+            } else {
+                const auto start_time = std::chrono::steady_clock::now();
+                utils::HttpResponse result = utils::HttpClient::post_stream(
+                    url,
+                    forwarded_body,
+                    [&sink, &wrote_to_client](const char* data, size_t length) {
+                        wrote_to_client = true;
+                        return sink.write(data, length);
+                    },
+                    headers,
+                    timeout_seconds,
+                    nullptr,
+                    policy,
+                    [&sink] { return sink.is_writable && !sink.is_writable(); }
+                );
+                if (result.curl_code != CURLE_OK) {
+                    if (result.curl_code == CURLE_WRITE_ERROR ||
+                        result.curl_code == CURLE_ABORTED_BY_CALLBACK) {
+                        LOG(WARNING, "Cloud") << "Client disconnected during stream: CURL error: " << result.curl_error << std::endl;
+                        if (telemetry_callback) {
+                            telemetry_callback(0, 0, 0.0, 0.0, "Client disconnected during stream");
+                        }
+                        return true;
+                    } else {
+                        throw std::runtime_error("Request failed: CURL error: " + result.curl_error);
+                    }
+                }
+                if (result.status_code != 200) {
+                    const bool endpoint_fault =
+                        result.status_code >= 500 || result.status_code == 429;
+                    if (endpoint_fault) {
+                        tracker.record_failure(endpoint_base);
+                        if (!wrote_to_client && !last_endpoint) {
+                            LOG(WARNING, "Cloud")
+                                << "Endpoint " << endpoint_base << " returned HTTP "
+                                << result.status_code << "; failing over" << std::endl;
+                            return false;
+                        }
+                    }
+                    LOG(ERROR, "Cloud") << "Provider returned status " << result.status_code << std::endl;
                     if (telemetry_callback) {
-                        telemetry_callback(0, 0, 0.0, 0.0, "Client disconnected during stream");
+                        telemetry_callback(0, 0, 0.0, 0.0, "status_code " + std::to_string(result.status_code));
                     }
-                    return;
                 } else {
-                    throw std::runtime_error("Request failed: CURL error: " + result.curl_error);
+                    tracker.record_success(
+                        endpoint_base,
+                        std::chrono::duration<double, std::milli>(
+                            std::chrono::steady_clock::now() - start_time).count());
+                    if (telemetry_callback) {
+                        telemetry_callback(0, 0, 0.0, 0.0, "");
+                    }
                 }
+                sink.done();
             }
-            if (result.status_code != 200) {
-                LOG(ERROR, "Cloud") << "Provider returned status " << result.status_code << std::endl;
-                if (telemetry_callback) {
-                    telemetry_callback(0, 0, 0.0, 0.0, "status_code " + std::to_string(result.status_code));
-                }
-            } else {
-                if (telemetry_callback) {
-                    telemetry_callback(0, 0, 0.0, 0.0, "");
-                }
+        } catch (const std::exception& e) {
+            tracker.record_failure(endpoint_base);
+            if (!wrote_to_client && !last_endpoint) {
+                LOG(WARNING, "Cloud") << "Endpoint " << endpoint_base << " failed ("
+                                      << e.what() << "); failing over" << std::endl;
+                return false;
+            }
+            LOG(ERROR, "Cloud") << "Streaming request failed: " << e.what() << std::endl;
+            if (telemetry_callback) {
+                telemetry_callback(0, 0, 0.0, 0.0, e.what());
+            }
+            try {
+                std::string error_msg = sse_error(e.what(), "streaming_error");
+                sink.write(error_msg.c_str(), error_msg.size());
+                sink.done();
+            } catch (...) {
+                // Sink may already be closed.
             }
-            sink.done();
-        }
-    } catch (const std::exception& e) {
-        LOG(ERROR, "Cloud") << "Streaming request failed: " << e.what() << std::endl;
-        if (telemetry_callback) {
-            telemetry_callback(0, 0, 0.0, 0.0, e.what());
         }
-        try {
-            std::string error_msg = sse_error(e.what(), "streaming_error");
-            sink.write(error_msg.c_str(), error_msg.size());
-            sink.done();
-        } catch (...) {
-            // Sink may already be closed.
+        return true;
+    };
+
+    for (size_t i = 0; i < creds.base_urls.size(); ++i) {
+        if (attempt_endpoint(creds.base_urls[i],
+                             i + 1 == creds.base_urls.size())) {
+            return;
         }
     }
 }
@@ -880,9 +992,9 @@ namespace backends {
 namespace cloud {
 
 std::unique_ptr<WrappedServer> create(const BackendContext& ctx) {
-    return std::make_unique<CloudServer>(
+    return with_capability_mask(std::make_unique<CloudServer>(
         ctx.model_info->cloud_provider, ctx.log_level,
-        ctx.model_manager, ctx.backend_manager, ctx.cloud_registry);
+        ctx.model_manager, ctx.backend_manager, ctx.cloud_registry));
 }
 
 
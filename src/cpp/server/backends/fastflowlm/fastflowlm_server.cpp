@@ -2,6 +2,7 @@
 #include "lemon/backends/fastflowlm/fastflowlm.h"
 #include "lemon/backends/fastflowlm/fastflowlm_models.h"
 #include "lemon/backends/fastflowlm/flm_arg_resolver.h"
+#include "lemon/backends/fastflowlm/flm_pipeline.h"
 #include "lemon/backends/backend_registry.h"
 #include "lemon/backends/backend_ops.h"
 #include "lemon/backends/backend_utils.h"
@@ -153,6 +154,11 @@ void FastFlowLMServer::load(const std::string& model_name,
     std::string flm_args = options.get_option("flm_args");
     FLMArgResolution flm_arg_resolution = resolve_flm_args(flm_args, ctx_size);
 
+    // The pipeline is shared across coexisting FLM-type servers (one NPU), so
+    // the most recently loaded model's setting wins.
+    int pipeline_depth = options.get_option("flm_pipeline_depth");
+    FlmPipeline::instance().set_depth(pipeline_depth);
+
     std::cout << "[FastFlowLM] Options: ctx_size=" << ctx_size << std::endl;
     // Note: checkpoint_ is set by Router via set_model_metadata() before load() is called
     // We use checkpoint_ (base class field) for FLM API calls
@@ -295,6 +301,12 @@ json FastFlowLMServer::chat_completion(const json& request) {
     json modified_request = request;
     modified_request["model"] = checkpoint_;
 
+    FlmPipeline::Ticket ticket;
+    try {
+        ticket = FlmPipeline::instance().acquire(model_type_);
+    } catch (const std::runtime_error& e) {
+        return ErrorResponse::create(e.what(), ErrorType::BACKEND_ERROR);
+    }
     return forward_request("/v1/chat/completions", modified_request);
 }
 
@@ -310,6 +322,12 @@ json FastFlowLMServer::completion(const json& request) {
     json modified_request = request;
     modified_request["model"] = checkpoint_;
 
+    FlmPipeline::Ticket ticket;
+    try {
+        ticket = FlmPipeline::instance().acquire(model_type_);
+    } catch (const std::runtime_error& e) {
+        return ErrorResponse::create(e.what(), ErrorType::BACKEND_ERROR);
+    }
     return forward_request("/v1/completions", modified_request);
 }
 
@@ -319,7 +337,14 @@ json FastFlowLMServer::embeddings(const json& request) {
             UnsupportedOperationException("Embeddings", "FLM " + model_type_to_string(model_type_) + " model")
         );
     }
-    return forward_request("/v1/embeddings", request);
+    FlmPipeline::Ticket ticket;
+    try {
+        ticket = FlmPipeline::instance().acquire(model_type_);
+    } catch (const std::runtime_error& e) {
+        return ErrorResponse::create(e.what(), ErrorType::BACKEND_ERROR);
+    }
+    return forward_request("/v1/embeddings", request,
+                           operation_timeout_seconds("embeddings_timeout"));
 }
 
 json FastFlowLMServer::reranking(const json& request) {
@@ -328,7 +353,14 @@ json FastFlowLMServer::reranking(const json& request) {
             UnsupportedOperationException("Reranking", "FLM " + model_type_to_string(model_type_) + " model")
         );
     }
-    return forward_request("/v1/rerank", request);
+    FlmPipeline::Ticket ticket;
+    try {
+        ticket = FlmPipeline::instance().acquire(model_type_);
+    } catch (const std::runtime_error& e) {
+        return ErrorResponse::create(e.what(), ErrorType::BACKEND_ERROR);
+    }
+    return forward_request("/v1/rerank", request,
+                           operation_timeout_seconds("reranking_timeout"));
 }
 
 json FastFlowLMServer::audio_transcriptions(const json& request) {
@@ -338,13 +370,24 @@ json FastFlowLMServer::audio_transcriptions(const json& request) {
         );
     }
 
+    FlmPipeline::Ticket ticket;
     try {
-        if (!request.contains("file_data")) {
+        ticket = FlmPipeline::instance().acquire(model_type_);
+    } catch (const std::runtime_error& e) {
+        return ErrorResponse::create(e.what(), ErrorType::BACKEND_ERROR);
+    }
+
+    try {
+        std::string audio_data;
+        std::string file_path;
+        if (request.contains("file_path")) {
+            file_path = request["file_path"].get<std::string>();
+        } else if (request.contains("file_data")) {
+            audio_data = request["file_data"].get<std::string>();
+        } else {
             throw std::runtime_error("Missing 'file_data' in request");
         }
-
-        std::string audio_data = request["file_data"].get<std::string>();
-        std::string filename = request.value("filename", "audio.wav");
+        std::string filename = request.value("filename", file_path.empty() ? "audio.wav" : file_path);
 
         std::filesystem::path filepath(filename);
         std::string ext = filepath.extension().string();
@@ -361,7 +404,8 @@ json FastFlowLMServer::audio_transcriptions(const json& request) {
             "file",
             audio_data,
             filepath.filename().string(),
-            content_type
+            content_type,
+            file_path
         });
 
         // Model field (required by OpenAI API format)
@@ -412,6 +456,17 @@ void FastFlowLMServer::forward_streaming_request(const std::string& endpoint,
         return;
     }
 
+    FlmPipeline::Ticket ticket;
+    try {
+        ticket = FlmPipeline::instance().acquire(model_type_);
+    } catch (const std::runtime_error& e) {
+        std::string error_msg = "data: {\"error\":{\"message\":\""
+            + std::string(e.what()) + "\",\"type\":\"backend_error\"}}\n\n";
+        sink.write(error_msg.c_str(), error_msg.size());
+        sink.done();
+        return;
+    }
+
     // FLM requires the checkpoint name in the model field (e.g., "gemma3:4b"),
     // not the Lemonade model name (e.g., "Gemma3-4b-it-FLM")
     try {
@@ -0,0 +1,134 @@
+#include "lemon/backends/fastflowlm/flm_pipeline.h"
+
+#include <stdexcept>
+
+#include "lemon/model_types.h"
+
+namespace lemon {
+namespace backends {
+
+FlmPipeline& FlmPipeline::instance() {
+    static FlmPipeline pipeline;
+    return pipeline;
+}
+
+FlmPipeline::Ticket::Ticket(Ticket&& other) noexcept
+    : pipeline_(other.pipeline_), admitted_at_(other.admitted_at_) {
+    other.pipeline_ = nullptr;
+}
+
+FlmPipeline::Ticket& FlmPipeline::Ticket::operator=(Ticket&& other) noexcept {
+    if (this != &other) {
+        if (pipeline_) {
+            pipeline_->release(admitted_at_);
+        }
+        pipeline_ = other.pipeline_;
+        admitted_at_ = other.admitted_at_;
+        other.pipeline_ = nullptr;
+    }
+    return *this;
+}
+
+FlmPipeline::Ticket::~Ticket() {
+    if (pipeline_) {
+        pipeline_->release(admitted_at_);
+    }
+}
+
+FlmPipeline::Ticket FlmPipeline::acquire(ModelType type) {
+    const int type_index = static_cast<int>(type);
+    const auto enqueued_at = std::chrono::steady_clock::now();
+
+    std::unique_lock<std::mutex> lock(mutex_);
+    auto& queue = queues_[type_index];
+    if (static_cast<int>(queue.size()) >= kMaxQueuedPerType) {
+        ++stats_.rejected;
+        throw std::runtime_error("FLM pipeline queue is full for " +
+                                 model_type_to_string(type) + " requests");
+    }
+
+    const std::uint64_t id = ++next_id_;
+    queue.push_back(id);
+    pump_locked();
+    cv_.wait(lock, [this, id] { return granted_.count(id) > 0; });
+    granted_.erase(id);
+
+    const auto admitted_at = std::chrono::steady_clock::now();
+    ++stats_.admitted;
+    stats_.wait_ms_total += static_cast<std::uint64_t>(
+        std::chrono::duration_cast<std::chrono::milliseconds>(admitted_at -
+                                                              enqueued_at)
+            .count());
+
+    Ticket ticket(this);
+    ticket.admitted_at_ = admitted_at;
+    return ticket;
+}
+
+void FlmPipeline::set_depth(int depth) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    depth_ = depth < 1 ? 1 : depth;
+    pump_locked();
+}
+
+int FlmPipeline::depth() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return depth_;
+}
+
+FlmPipeline::Stats FlmPipeline::totals() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return stats_;
+}
+
+int FlmPipeline::in_flight() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return in_flight_;
+}
+
+int FlmPipeline::queued() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    int total = 0;
+    for (const auto& queue : queues_) {
+        total += static_cast<int>(queue.size());
+    }
+    return total;
+}
+
+void FlmPipeline::release(std::chrono::steady_clock::time_point admitted_at) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    --in_flight_;
+    stats_.busy_ms_total += static_cast<std::uint64_t>(
+        std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now() - admitted_at)
+            .count());
+    pump_locked();
+}
+
+void FlmPipeline::pump_locked() {
+    bool granted_any = false;
+    while (in_flight_ < depth_) {
+        int chosen = -1;
+        for (int offset = 0; offset < kTypeCount; ++offset) {
+            const int t = (rr_next_ + offset) % kTypeCount;
+            if (!queues_[t].empty()) {
+                chosen = t;
+                break;
+            }
+        }
+        if (chosen < 0) {
+            break;
+        }
+        granted_.insert(queues_[chosen].front());
+        queues_[chosen].pop_front();
+        ++in_flight_;
+        rr_next_ = (chosen + 1) % kTypeCount;
+        granted_any = true;
+    }
+    if (granted_any) {
+        cv_.notify_all();
+    }
+}
+
+}  // namespace backends
+}  // namespace lemon
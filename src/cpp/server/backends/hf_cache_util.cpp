@@ -1,8 +1,14 @@
 #include "lemon/backends/hf_cache_util.h"
 
+#include <cstdio>
 #include <fstream>
+#include <system_error>
+
+#include <nlohmann/json.hpp>
 
 #include "lemon/model_registry.h"
+#include "lemon/utils/aixlog.hpp"
+#include "lemon/utils/path_utils.h"
 
 #ifdef _WIN32
 #include <windows.h>
@@ -67,6 +73,196 @@ std::string repo_id_to_cache_dir_name(const std::string& repo_id,
         parse_remote_registry_source(registry_source));
 }
 
+namespace {
+
+uint64_t fnv1a(uint64_t hash, const void* data, size_t len) {
+    const auto* bytes = static_cast<const unsigned char*>(data);
+    for (size_t i = 0; i < len; ++i) {
+        hash ^= bytes[i];
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
+uint64_t mtime_ticks(const fs::path& p) {
+    std::error_code ec;
+    const auto mtime = fs::last_write_time(p, ec);
+    return ec ? 0 : static_cast<uint64_t>(mtime.time_since_epoch().count());
+}
+
+// Self mtime plus an order-independent digest of the top-level entries
+// (name, mtime, file size). Cheap: one readdir, no recursion.
+std::string path_fingerprint(const fs::path& path) {
+    if (!hf_cache::exists(path)) {
+        return "";
+    }
+
+    std::error_code ec;
+    uint64_t self = fnv1a(14695981039346656037ull, nullptr, 0);
+    const uint64_t self_mtime = mtime_ticks(path);
+    self = fnv1a(self, &self_mtime, sizeof(self_mtime));
+
+    uint64_t aggregate = 0;
+    uint64_t entry_count = 0;
+    if (fs::is_directory(path, ec) && !ec) {
+        for (const auto& entry : fs::directory_iterator(path, dir_options(), ec)) {
+            if (ec) {
+                break;
+            }
+            uint64_t h = 14695981039346656037ull;
+            const std::string name = lemon::utils::path_to_utf8(entry.path().filename());
+            h = fnv1a(h, name.data(), name.size());
+            const uint64_t mtime = mtime_ticks(entry.path());
+            h = fnv1a(h, &mtime, sizeof(mtime));
+            std::error_code size_ec;
+            const uint64_t size = entry.is_regular_file(size_ec) && !size_ec
+                ? static_cast<uint64_t>(fs::file_size(entry.path(), size_ec))
+                : 0;
+            h = fnv1a(h, &size, sizeof(size));
+            aggregate ^= h;
+            ++entry_count;
+        }
+    } else {
+        std::error_code size_ec;
+        aggregate = static_cast<uint64_t>(fs::file_size(path, size_ec));
+        if (size_ec) {
+            aggregate = 0;
+        }
+    }
+
+    char buffer[64];
+    snprintf(buffer, sizeof(buffer), "%016llx-%016llx-%llu",
+             static_cast<unsigned long long>(self),
+             static_cast<unsigned long long>(aggregate),
+             static_cast<unsigned long long>(entry_count));
+    return buffer;
+}
+
+uint64_t walk_tree_size(const fs::path& path) {
+    std::error_code ec;
+    if (!fs::is_directory(path, ec) || ec) {
+        std::error_code size_ec;
+        const auto size = fs::file_size(path, size_ec);
+        return size_ec ? 0 : static_cast<uint64_t>(size);
+    }
+
+    uint64_t total = 0;
+    for (const auto& entry : fs::recursive_directory_iterator(path, dir_options(), ec)) {
+        if (ec) {
+            break;
+        }
+        std::error_code entry_ec;
+        if (entry.is_regular_file(entry_ec) && !entry_ec) {
+            const auto size = fs::file_size(entry.path(), entry_ec);
+            if (!entry_ec) {
+                total += size;
+            }
+        }
+    }
+    return total;
+}
+
+} // namespace
+
+ScanCache::ScanCache(const fs::path& manifest_path)
+    : manifest_path_(manifest_path) {}
+
+void ScanCache::load_locked() {
+    if (loaded_) {
+        return;
+    }
+    loaded_ = true;
+
+    std::ifstream file(manifest_path_);
+    if (!file.is_open()) {
+        return;
+    }
+    try {
+        const auto manifest = nlohmann::json::parse(file);
+        const auto json_entries = manifest.value("entries", nlohmann::json::object());
+        for (const auto& [path, entry] : json_entries.items()) {
+            if (entry.contains("fp") && entry.contains("bytes")) {
+                entries_[path] = {entry["fp"].get<std::string>(),
+                                  entry["bytes"].get<std::uint64_t>()};
+            }
+        }
+    } catch (const std::exception& e) {
+        LOG(WARNING, "ScanCache") << "Discarding unreadable scan cache "
+                                  << lemon::utils::path_to_utf8(manifest_path_)
+                                  << ": " << e.what() << std::endl;
+        entries_.clear();
+        dirty_ = true;
+    }
+}
+
+std::uint64_t ScanCache::tree_size_bytes(const fs::path& path) {
+    if (!hf_cache::exists(path)) {
+        return 0;
+    }
+
+    const std::string key = lemon::utils::path_to_utf8(path);
+    const std::string fingerprint = path_fingerprint(path);
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        load_locked();
+        auto it = entries_.find(key);
+        if (it != entries_.end() && !fingerprint.empty() &&
+            it->second.fingerprint == fingerprint) {
+            return it->second.bytes;
+        }
+    }
+
+    const uint64_t bytes = walk_tree_size(path);
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    entries_[key] = {fingerprint, bytes};
+    dirty_ = true;
+    return bytes;
+}
+
+void ScanCache::invalidate(const fs::path& path) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    load_locked();
+    if (entries_.erase(lemon::utils::path_to_utf8(path)) > 0) {
+        dirty_ = true;
+    }
+}
+
+void ScanCache::save() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!loaded_ || !dirty_) {
+        return;
+    }
+
+    for (auto it = entries_.begin(); it != entries_.end();) {
+        if (!hf_cache::exists(lemon::utils::path_from_utf8(it->first))) {
+            it = entries_.erase(it);
+        } else {
+            ++it;
+        }
+    }
+
+    nlohmann::json manifest;
+    manifest["version"] = 1;
+    auto& json_entries = manifest["entries"] = nlohmann::json::object();
+    for (const auto& [path, entry] : entries_) {
+        json_entries[path] = {{"fp", entry.fingerprint}, {"bytes", entry.bytes}};
+    }
+
+    std::error_code ec;
+    fs::create_directories(manifest_path_.parent_path(), ec);
+    std::ofstream file(manifest_path_, std::ios::trunc);
+    if (!file.is_open()) {
+        LOG(WARNING, "ScanCache") << "Failed to write scan cache "
+                                  << lemon::utils::path_to_utf8(manifest_path_)
+                                  << std::endl;
+        return;
+    }
+    file << manifest.dump(2);
+    dirty_ = false;
+}
+
 } // namespace hf_cache
 } // namespace backends
 } // namespace lemon
@@ -11,6 +11,7 @@
 #include "lemon/utils/process_manager.h"
 #include "lemon/utils/json_utils.h"
 #include "lemon/error_types.h"
+#include "lemon/sentence_splitter.h"
 #include <httplib.h>
 #include <iostream>
 #include <vector>
@@ -197,6 +198,43 @@ void KokoroServer::audio_speech(const json& request, httplib::DataSink& sink) {
         tts_request["stream"] = true;
     }
 
+    // Streamed PCM is pipelined per sentence: each segment is its own backend
+    // request and its audio is forwarded as soon as it completes, so the
+    // client hears the first sentence while the rest is still synthesizing.
+    // Raw PCM segments concatenate cleanly; container formats (mp3/wav) and
+    // non-streamed requests keep the single-request path.
+    if (tts_request.value("stream", false) && request.contains("input") &&
+        request["input"].is_string()) {
+        const auto segments = split_sentences(request["input"].get<std::string>());
+        if (segments.size() > 1) {
+            LOG(INFO, "KokoroServer") << "Pipelining speech synthesis across "
+                                      << segments.size() << " segments" << std::endl;
+            bool client_open = true;
+            httplib::DataSink segment_sink;
+            segment_sink.write = [&sink, &client_open](const char* data, size_t length) {
+                if (!sink.write(data, length)) {
+                    client_open = false;
+                    return false;
+                }
+                return true;
+            };
+            // The real sink is completed once, after the last segment
+            segment_sink.done = []() {};
+            segment_sink.is_writable = [&sink]() { return sink.is_writable(); };
+
+            for (const auto& segment : segments) {
+                if (!client_open) {
+                    break;
+                }
+                tts_request["input"] = segment;
+                forward_streaming_request("/v1/audio/speech", tts_request.dump(),
+                                          segment_sink, false);
+            }
+            sink.done();
+            return;
+        }
+    }
+
     forward_streaming_request("/v1/audio/speech", tts_request.dump(), sink, false);
 }
 
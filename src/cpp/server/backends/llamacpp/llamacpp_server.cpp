@@ -5,8 +5,12 @@
 #include "lemon/backends/backend_ops.h"
 #include "lemon/backends/backend_utils.h"
 #include "lemon/gguf_capabilities.h"
+#include "lemon/gguf_metadata_cache.h"
 #include "lemon/gguf_reader.h"
+#include "lemon/grammar_cache.h"
 #include "lemon/model_manager.h"
+#include "lemon/offload_planner.h"
+#include "lemon/speculative_stats.h"
 #include <algorithm>
 #include <filesystem>
 #include <regex>
@@ -15,6 +19,7 @@
 #include "lemon/backend_manager.h"
 #include "lemon/runtime_config.h"
 #include "lemon/utils/custom_args.h"
+#include "lemon/utils/file_prewarmer.h"
 #include "lemon/utils/process_manager.h"
 #include "lemon/utils/json_utils.h"
 #include "lemon/utils/path_utils.h"
@@ -27,6 +32,7 @@
 #include <iostream>
 #include <lemon/utils/aixlog.hpp>
 #include <set>
+#include <thread>
 #ifdef __APPLE__
 #include <pwd.h>
 #include <unistd.h>
@@ -51,6 +57,18 @@ namespace backends {
 static const int EMBEDDING_BATCH_SIZE = 8192;
 static const int EMBEDDING_UBATCH_SIZE = 8192;
 
+namespace {
+
+// Port the current thread's forwarded requests target; 0 means the primary.
+thread_local int g_replica_port = 0;
+
+struct ScopedReplicaPort {
+    explicit ScopedReplicaPort(int port) { g_replica_port = port; }
+    ~ScopedReplicaPort() { g_replica_port = 0; }
+};
+
+} // namespace
+
 // Helper to push reserved flags and their aliases
 static void push_reserved(std::set<std::string>& reserved,
                     const std::string& key,
@@ -280,6 +298,8 @@ void LlamaCppServer::load(const std::string& model_name,
     std::string llamacpp_backend_option = options.get_option("llamacpp_backend");
     std::string llamacpp_backend = resolve_llamacpp_backend(llamacpp_backend_option);
     std::string llamacpp_args = options.get_option("llamacpp_args");
+    std::string llamacpp_draft = options.get_option("llamacpp_draft");
+    std::string llamacpp_lora = options.get_option("llamacpp_lora");
 
     RuntimeConfig::validate_backend_choice("llamacpp", llamacpp_backend_option);
 
@@ -308,10 +328,56 @@ void LlamaCppServer::load(const std::string& model_name,
     std::string mmproj_path = model_info.resolved_path("mmproj");
     std::string draft_path = model_info.resolved_path("draft");
 
+    // The llamacpp_draft option pairs a local draft GGUF with the model at
+    // load time, taking precedence over a registry "draft" checkpoint. The
+    // registry draft is already counted in model_info.size; an ad-hoc draft
+    // file is not, so add it to the size the offload planner sees.
+    double draft_extra_size_gb = 0.0;
+    if (!llamacpp_draft.empty()) {
+        std::error_code draft_ec;
+        auto draft_fs_path = path_from_utf8(llamacpp_draft);
+        if (!fs::is_regular_file(draft_fs_path, draft_ec)) {
+            throw std::invalid_argument("llamacpp_draft is not a file: " + llamacpp_draft);
+        }
+        if (!draft_path.empty()) {
+            LOG(INFO, "LlamaCpp") << "llamacpp_draft overrides registry draft checkpoint" << std::endl;
+        } else {
+            auto draft_size = fs::file_size(draft_fs_path, draft_ec);
+            if (!draft_ec) {
+                draft_extra_size_gb = static_cast<double>(draft_size) / (1024.0 * 1024.0 * 1024.0);
+            }
+        }
+        draft_path = llamacpp_draft;
+    }
+
+    std::vector<std::string> lora_paths;
+    for (size_t start = 0; start < llamacpp_lora.size();) {
+        size_t end = llamacpp_lora.find(',', start);
+        if (end == std::string::npos) {
+            end = llamacpp_lora.size();
+        }
+        std::string lora_path = llamacpp_lora.substr(start, end - start);
+        start = end + 1;
+        if (lora_path.empty()) {
+            continue;
+        }
+        std::error_code lora_ec;
+        if (!fs::is_regular_file(path_from_utf8(lora_path), lora_ec)) {
+            throw std::invalid_argument("llamacpp_lora is not a file: " + lora_path);
+        }
+        lora_paths.push_back(std::move(lora_path));
+    }
+
     port_ = choose_port();
 
     std::string executable = BackendUtils::get_backend_binary_path(*llamacpp::spec(), llamacpp_backend);
 
+    // Fault the server image and its runtime libraries into the page cache
+    // while the remaining arguments are assembled, so process creation and
+    // loader mapping hit warm pages on a cold swap.
+    utils::BinaryPrewarmer binary_prewarmer;
+    binary_prewarmer.start(executable);
+
     bool supports_embeddings = (model_info.type == ModelType::EMBEDDING);
     bool supports_reranking = (model_info.type == ModelType::RERANKING);
 
@@ -343,6 +409,20 @@ void LlamaCppServer::load(const std::string& model_name,
     }
     push_reserved(reserved_flags, "--device", std::vector<std::string>{"-dev"});
 
+    if (use_gpu) {
+        int gpu_layers = plan_gpu_offload_layers(model_info.gguf,
+                                                 model_info.size + draft_extra_size_gb,
+                                                 ctx_size,
+                                                 get_available_memory_gb(DEVICE_GPU));
+        if (gpu_layers >= 0) {
+            LOG(DEBUG, "LlamaCpp") << "Offload plan: " << gpu_layers << " of "
+                                   << model_info.gguf.block_count
+                                   << " layers on GPU" << std::endl;
+            push_overridable_arg(args, llamacpp_args, "--n-gpu-layers",
+                                 std::to_string(gpu_layers));
+        }
+    }
+
     push_arg(args, reserved_flags, "--port", std::to_string(port_));
     push_arg(args, reserved_flags, "--jinja", std::vector<std::string>{"--no-jinja"});
     push_arg(args, reserved_flags, "--metrics");
@@ -366,14 +446,31 @@ void LlamaCppServer::load(const std::string& model_name,
     }
     push_reserved(reserved_flags, "--model-draft", std::vector<std::string>{"-md", "--spec-draft-model"});
 
+    // Adapters start detached (scale 0) so the base model answers until a
+    // client activates them via POST /v1/adapters/load.
+    for (const auto& lora_path : lora_paths) {
+        args.push_back("--lora");
+        args.push_back(lora_path);
+    }
+    if (!lora_paths.empty()) {
+        push_arg(args, reserved_flags, "--lora-init-without-apply");
+    }
+    push_reserved(reserved_flags, "--lora", std::vector<std::string>{"--lora-scaled", "--lora-init-without-apply"});
+
     // Use legacy reasoning formatting
     push_overridable_arg(args, llamacpp_args, "--reasoning-format", "auto");
 
-    if (std::find(model_info.labels.begin(), model_info.labels.end(), "mtp") != model_info.labels.end()) {
+    bool is_mtp = std::find(model_info.labels.begin(), model_info.labels.end(), "mtp") != model_info.labels.end();
+    if (is_mtp) {
         LOG(INFO, "LlamaCpp") << "Model uses MTP, adding draft decoding defaults" << std::endl;
         push_overridable_arg(args, llamacpp_args, "--spec-type", "draft-mtp");
         push_overridable_arg(args, llamacpp_args, "--spec-draft-n-max", "3");
         push_overridable_arg(args, llamacpp_args, "--spec-draft-p-min", "0.75");
+    } else if (!draft_path.empty()) {
+        LOG(INFO, "LlamaCpp") << "Model pairs a draft model, adding speculative decoding defaults" << std::endl;
+        push_overridable_arg(args, llamacpp_args, "--draft-max", "16");
+        push_overridable_arg(args, llamacpp_args, "--draft-min", "1");
+        push_overridable_arg(args, llamacpp_args, "--draft-p-min", "0.75");
     }
 
     // Disable llamacpp webui by default
@@ -412,6 +509,23 @@ void LlamaCppServer::load(const std::string& model_name,
         args.insert(args.end(), custom_args_vec.begin(), custom_args_vec.end());
     }
 
+    int parallel_slots = 1;
+    {
+        std::vector<std::string> custom_args_vec = parse_custom_args(llamacpp_args);
+        for (size_t i = 0; i + 1 < custom_args_vec.size(); ++i) {
+            if (custom_args_vec[i] == "--parallel" || custom_args_vec[i] == "-np") {
+                parallel_slots = std::atoi(custom_args_vec[i + 1].c_str());
+            }
+        }
+    }
+    if (parallel_slots > 1 && model_info.type == ModelType::LLM) {
+        LOG(INFO, "LlamaCpp") << "Enabling prefix-affinity slot routing across "
+                              << parallel_slots << " slots" << std::endl;
+        slot_affinity_ = std::make_unique<SlotAffinity>(parallel_slots);
+    } else {
+        slot_affinity_.reset();
+    }
+
     LOG(INFO, "LlamaCpp") << "Starting llama-server..." << std::endl;
 
     // For ROCm on Linux, set LD_LIBRARY_PATH to include the ROCm library directory
@@ -563,6 +677,14 @@ void LlamaCppServer::load(const std::string& model_name,
 #endif
 
     bool inherit_llama_output = (log_level_ == "info") || is_debug();
+
+    launch_executable_ = process_executable;
+    launch_args_ = args;
+    launch_working_dir_ = working_dir;
+    launch_env_vars_ = env_vars;
+    launch_inherit_output_ = inherit_llama_output;
+    launch_port_ = port_;
+
     set_process_handle(ProcessManager::start_process(
         process_executable, args, working_dir, inherit_llama_output, true, env_vars));
 
@@ -574,6 +696,15 @@ void LlamaCppServer::load(const std::string& model_name,
         throw std::runtime_error("llama-server failed to start");
     }
 
+    replica_count_ = 1;
+    json replicas_opt = options.get_option("llamacpp_replicas");
+    if (replicas_opt.is_number()) {
+        replica_count_ = replicas_opt.get<int>();
+    }
+    if (replica_count_ > 1) {
+        start_replicas(replica_count_);
+    }
+
     LOG(DEBUG, "LlamaCpp") << "Model loaded on port " << get_backend_port() << std::endl;
 }
 
@@ -581,15 +712,223 @@ void LlamaCppServer::unload() {
     stop_backend_watchdog();
     LOG(INFO, "LlamaCpp") << "Unloading model..." << std::endl;
 
+    stop_replicas();
+    if (slot_affinity_) {
+        slot_affinity_->reset();
+    }
+
     const ProcessHandle handle = consume_process_handle_for_cleanup();
     if (has_process_handle(handle)) {
         ProcessManager::stop_process(handle);
     }
 }
 
+bool LlamaCppServer::hibernate() {
+    if (launch_executable_.empty()) {
+        return false;
+    }
+
+    LOG(INFO, "LlamaCpp") << "Hibernating model: stopping llama-server (weights stay warm in page cache)..." << std::endl;
+    stop_backend_watchdog();
+
+    stop_replicas();
+    if (slot_affinity_) {
+        slot_affinity_->reset();
+    }
+
+    const ProcessHandle handle = consume_process_handle_for_cleanup();
+    if (has_process_handle(handle)) {
+        ProcessManager::stop_process(handle);
+    }
+    return true;
+}
+
+void LlamaCppServer::resume() {
+    LOG(INFO, "LlamaCpp") << "Resuming hibernated model..." << std::endl;
+
+    port_ = launch_port_;
+    set_process_handle(ProcessManager::start_process(
+        launch_executable_, launch_args_, launch_working_dir_,
+        launch_inherit_output_, true, launch_env_vars_));
+
+    if (!wait_for_ready("/health")) {
+        const ProcessHandle handle = consume_process_handle_for_cleanup();
+        if (has_process_handle(handle)) {
+            ProcessManager::stop_process(handle);
+        }
+        throw std::runtime_error("llama-server failed to resume from hibernation");
+    }
+
+    if (replica_count_ > 1) {
+        start_replicas(replica_count_);
+    }
+
+    LOG(INFO, "LlamaCpp") << "Resume complete on port " << get_backend_port() << std::endl;
+}
+
+std::string LlamaCppServer::get_base_url() const {
+    if (g_replica_port != 0) {
+        return "http://127.0.0.1:" + std::to_string(g_replica_port);
+    }
+    return WrappedServer::get_base_url();
+}
+
+LlamaCppServer::ReplicaLease::ReplicaLease(LlamaCppServer& server)
+    : server_(server), replica_(server.checkout_replica()) {
+    g_replica_port = replica_ ? replica_->port : 0;
+}
+
+LlamaCppServer::ReplicaLease::~ReplicaLease() {
+    g_replica_port = 0;
+    server_.checkin_replica(replica_);
+}
+
+void LlamaCppServer::start_replicas(int replica_count) {
+    std::lock_guard<std::mutex> lock(*replicas_mutex_);
+
+    for (int i = 1; i < replica_count; ++i) {
+        auto replica = std::make_shared<Replica>();
+        replica->port = ProcessManager::find_free_port(8001);
+        if (replica->port < 0) {
+            LOG(ERROR, "LlamaCpp") << "No free port for replica " << i << ", continuing without it" << std::endl;
+            continue;
+        }
+
+        replica->args = launch_args_;
+        for (size_t a = 0; a + 1 < replica->args.size(); ++a) {
+            if (replica->args[a] == "--port") {
+                replica->args[a + 1] = std::to_string(replica->port);
+            }
+        }
+
+        LOG(INFO, "LlamaCpp") << "Starting replica " << i << " of " << (replica_count - 1)
+                              << " on port " << replica->port << std::endl;
+        replica->handle = ProcessManager::start_process(
+            launch_executable_, replica->args, launch_working_dir_,
+            launch_inherit_output_, true, launch_env_vars_);
+
+        if (!wait_for_replica_ready(replica->handle, replica->port)) {
+            LOG(ERROR, "LlamaCpp") << "Replica on port " << replica->port
+                                   << " failed to become ready, continuing without it" << std::endl;
+            if (has_process_handle(replica->handle)) {
+                ProcessManager::stop_process(replica->handle);
+            }
+            continue;
+        }
+
+        replicas_.push_back(std::move(replica));
+    }
+}
+
+void LlamaCppServer::stop_replicas() {
+    std::lock_guard<std::mutex> lock(*replicas_mutex_);
+    for (auto& replica : replicas_) {
+        replica->retired.store(true);
+        if (has_process_handle(replica->handle)) {
+            ProcessManager::stop_process(replica->handle);
+        }
+    }
+    replicas_.clear();
+    primary_slot_.in_flight.store(0);
+}
+
+bool LlamaCppServer::wait_for_replica_ready(const ProcessHandle& handle, int port) {
+    const std::string health_url = "http://127.0.0.1:" + std::to_string(port) + "/health";
+    const long timeout_seconds = utils::HttpClient::get_default_timeout();
+    const long poll_interval_ms = 100;
+    const long max_attempts = (timeout_seconds * 1000) / poll_interval_ms;
+
+    for (long i = 0; i < max_attempts; ++i) {
+        if (!has_process_handle(handle) || !ProcessManager::is_running(handle)) {
+            return false;
+        }
+        if (utils::HttpClient::is_reachable(
+                health_url, 1, utils::HttpSecurityPolicy::TrustedLoopback)) {
+            return true;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(poll_interval_ms));
+    }
+    return false;
+}
+
+// The restart can take minutes (model reload), so it runs detached while
+// traffic falls back to the primary. The thread captures the launch
+// parameters by value and shares ownership of the Replica, never `this`,
+// so it outlives unload() and server destruction safely; a replica retired
+// in the meantime has its freshly spawned process stopped again.
+void LlamaCppServer::restart_replica_async(std::shared_ptr<Replica> replica) {
+    LOG(WARNING, "LlamaCpp") << "Replica on port " << replica->port
+                             << " is down, restarting in the background" << std::endl;
+
+    const ProcessHandle old_handle = replica->handle;
+    replica->handle = {nullptr, 0};
+
+    std::thread([replica = std::move(replica), old_handle,
+                 executable = launch_executable_,
+                 working_dir = launch_working_dir_,
+                 inherit_output = launch_inherit_output_,
+                 env_vars = launch_env_vars_, mutex = replicas_mutex_]() {
+        if (has_process_handle(old_handle)) {
+            ProcessManager::stop_process(old_handle);
+        }
+
+        ProcessHandle handle = ProcessManager::start_process(
+            executable, replica->args, working_dir, inherit_output, true, env_vars);
+        const bool ready = wait_for_replica_ready(handle, replica->port);
+
+        std::lock_guard<std::mutex> lock(*mutex);
+        if (!ready || replica->retired.load()) {
+            if (has_process_handle(handle)) {
+                ProcessManager::stop_process(handle);
+            }
+        } else {
+            replica->handle = handle;
+        }
+        replica->restarting.store(false);
+    }).detach();
+}
+
+LlamaCppServer::Replica* LlamaCppServer::checkout_replica() {
+    std::lock_guard<std::mutex> lock(*replicas_mutex_);
+    if (replicas_.empty()) {
+        return nullptr;
+    }
+
+    Replica* best = &primary_slot_;
+    std::shared_ptr<Replica> best_owner;
+    for (auto& replica : replicas_) {
+        if (replica->restarting.load()) {
+            continue;
+        }
+        if (replica->in_flight.load(std::memory_order_relaxed) <
+            best->in_flight.load(std::memory_order_relaxed)) {
+            best = replica.get();
+            best_owner = replica;
+        }
+    }
+
+    if (best != &primary_slot_ &&
+        (!has_process_handle(best->handle) || !ProcessManager::is_running(best->handle))) {
+        if (!best->restarting.exchange(true)) {
+            restart_replica_async(std::move(best_owner));
+        }
+        best = &primary_slot_;
+    }
+
+    best->in_flight.fetch_add(1, std::memory_order_relaxed);
+    return best;
+}
+
+void LlamaCppServer::checkin_replica(Replica* replica) {
+    if (replica) {
+        replica->in_flight.fetch_sub(1, std::memory_order_relaxed);
+    }
+}
+
 bool LlamaCppServer::downsize() {
     LOG(INFO, "LlamaCpp") << "Downsizing model by erasing KV cache..." << std::endl;
-    try {
+
+    auto erase_all_slots = [this]() {
         json slots = get_slots();
         if (slots.is_array()) {
             for (const auto& slot : slots) {
@@ -601,6 +940,26 @@ bool LlamaCppServer::downsize() {
         } else if (slots.contains("id")) {
             slots_action(slots["id"].get<int>(), "erase", json::object());
         }
+    };
+
+    try {
+        erase_all_slots();
+
+        std::vector<int> replica_ports;
+        {
+            std::lock_guard<std::mutex> lock(*replicas_mutex_);
+            for (const auto& replica : replicas_) {
+                replica_ports.push_back(replica->port);
+            }
+        }
+        for (int port : replica_ports) {
+            ScopedReplicaPort target(port);
+            erase_all_slots();
+        }
+
+        if (slot_affinity_) {
+            slot_affinity_->reset();
+        }
         return true;
     } catch (const std::exception& e) {
         LOG(ERROR, "LlamaCpp") << "Failed to downsize model: " << e.what() << std::endl;
@@ -615,26 +974,110 @@ json LlamaCppServer::normalize_response_model(json response, const json& request
     return response;
 }
 
+std::string LlamaCppServer::prompt_signature(const json& request) {
+    if (request.contains("messages") && request["messages"].is_array()) {
+        std::string signature;
+        for (const auto& message : request["messages"]) {
+            signature += message.value("role", "");
+            signature += '\x1f';
+            if (message.contains("content")) {
+                const auto& content = message["content"];
+                signature += content.is_string() ? content.get<std::string>() : content.dump();
+            }
+            signature += '\x1e';
+        }
+        return signature;
+    }
+    if (request.contains("prompt") && request["prompt"].is_string()) {
+        return request["prompt"].get<std::string>();
+    }
+    return "";
+}
+
+// Swaps response_format: json_schema for a cached pre-compiled grammar so
+// llama-server skips its per-request schema-to-GBNF compilation. Returns true
+// when the request was rewritten.
+static bool apply_cached_grammar(json& request) {
+    if (!request.is_object() || request.contains("grammar") ||
+        !request.contains("response_format")) {
+        return false;
+    }
+    const json& response_format = request["response_format"];
+    if (!response_format.is_object() ||
+        response_format.value("type", std::string()) != "json_schema" ||
+        !response_format.contains("json_schema") ||
+        !response_format["json_schema"].is_object() ||
+        !response_format["json_schema"].contains("schema")) {
+        return false;
+    }
+    auto grammar = GrammarCache::instance().grammar_for(
+        response_format["json_schema"]["schema"]);
+    if (!grammar) {
+        return false;
+    }
+    request.erase("response_format");
+    request["grammar"] = *grammar;
+    return true;
+}
+
+json LlamaCppServer::with_slot_affinity(json request) {
+    if (!request.is_object()) {
+        return request;
+    }
+    std::string session_id;
+    if (request.contains("session_id") && request["session_id"].is_string()) {
+        session_id = request["session_id"].get<std::string>();
+        request.erase("session_id");
+    }
+    if (!slot_affinity_ || request.contains("id_slot")) {
+        return request;
+    }
+    std::string signature = prompt_signature(request);
+    if (signature.empty()) {
+        return request;
+    }
+    request["id_slot"] = session_id.empty()
+        ? slot_affinity_->pick_slot(signature)
+        : slot_affinity_->pick_slot_for_session(session_id, signature);
+    return request;
+}
+
+static void record_speculative_timings(const json& response) {
+    if (response.is_object() && response.contains("timings")) {
+        SpeculativeStats::record_from_timings(response["timings"]);
+    }
+}
+
 json LlamaCppServer::chat_completion(const json& request) {
-    return normalize_response_model(
-        forward_request("/v1/chat/completions",
-                        JsonUtils::with_legacy_max_tokens_alias(request)),
-        request);
+    json scratch;
+    ReplicaLease lease(*this);
+    json prepared = with_slot_affinity(JsonUtils::with_legacy_max_tokens_alias(request, scratch));
+    apply_cached_grammar(prepared);
+    json response = forward_request("/v1/chat/completions", prepared);
+    record_speculative_timings(response);
+    return normalize_response_model(std::move(response), request);
 }
 
 json LlamaCppServer::completion(const json& request) {
-    return normalize_response_model(
-        forward_request("/v1/completions",
-                        JsonUtils::with_legacy_max_tokens_alias(request)),
-        request);
+    json scratch;
+    ReplicaLease lease(*this);
+    json prepared = with_slot_affinity(JsonUtils::with_legacy_max_tokens_alias(request, scratch));
+    apply_cached_grammar(prepared);
+    json response = forward_request("/v1/completions", prepared);
+    record_speculative_timings(response);
+    return normalize_response_model(std::move(response), request);
 }
 
 json LlamaCppServer::embeddings(const json& request) {
-    return forward_request("/v1/embeddings", request);
+    ReplicaLease lease(*this);
+    return forward_request("/v1/embeddings", request,
+                           operation_timeout_seconds("embeddings_timeout"));
 }
 
 json LlamaCppServer::reranking(const json& request) {
-    return forward_request("/v1/rerank", request);
+    ReplicaLease lease(*this);
+    return forward_request("/v1/rerank", request,
+                           operation_timeout_seconds("reranking_timeout"));
 }
 
 json LlamaCppServer::get_slots() {
@@ -645,14 +1088,59 @@ json LlamaCppServer::slots_action(int slot_id, const std::string& action, const
     return forward_request("/slots/" + std::to_string(slot_id) + "?action=" + action, request_body);
 }
 
+json LlamaCppServer::get_lora_adapters() {
+    return forward_get_request("/lora-adapters");
+}
+
+json LlamaCppServer::set_lora_adapters(const json& adapters) {
+    return forward_request("/lora-adapters", adapters);
+}
+
 json LlamaCppServer::tokenize(const json& request_body) {
     return forward_request("/tokenize", request_body);
 }
 
 json LlamaCppServer::responses(const json& request) {
+    ReplicaLease lease(*this);
     return normalize_response_model(forward_request("/v1/responses", request), request);
 }
 
+void LlamaCppServer::forward_streaming_request(const std::string& endpoint,
+                                               const std::string& request_body,
+                                               httplib::DataSink& sink,
+                                               bool sse,
+                                               long timeout_seconds,
+                                               TelemetryCallback telemetry_callback) {
+    ReplicaLease lease(*this);
+    std::string body = request_body;
+    if (slot_affinity_ || request_body.find("\"session_id\"") != std::string::npos ||
+        request_body.find("\"response_format\"") != std::string::npos) {
+        json request = json::parse(request_body, nullptr, false);
+        if (request.is_object()) {
+            if (apply_cached_grammar(request)) {
+                body = request.dump();
+            }
+            std::string session_id;
+            if (request.contains("session_id") && request["session_id"].is_string()) {
+                session_id = request["session_id"].get<std::string>();
+                request.erase("session_id");
+                body = request.dump();
+            }
+            if (slot_affinity_ && !request.contains("id_slot")) {
+                std::string signature = prompt_signature(request);
+                if (!signature.empty()) {
+                    request["id_slot"] = session_id.empty()
+                        ? slot_affinity_->pick_slot(signature)
+                        : slot_affinity_->pick_slot_for_session(session_id, signature);
+                    body = request.dump();
+                }
+            }
+        }
+    }
+    WrappedServer::forward_streaming_request(endpoint, body, sink, sse, timeout_seconds,
+                                             std::move(telemetry_callback));
+}
+
 } // namespace backends
 } // namespace lemon
 
@@ -796,7 +1284,7 @@ public:
             return;
         }
         GgufMetadata meta;
-        if (!read_gguf_metadata(meta, gguf_path)) {
+        if (!GgufMetadataCache::global().read(meta, gguf_path)) {
             return;
         }
         info.max_context_window = meta.context_length;
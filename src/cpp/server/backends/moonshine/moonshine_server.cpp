@@ -8,6 +8,7 @@
 #include "lemon/utils/http_client.h"
 #include "lemon/utils/process_manager.h"
 #include "lemon/error_types.h"
+#include <algorithm>
 #include <cctype>
 #include <iostream>
 #include <filesystem>
@@ -29,6 +30,44 @@ using namespace lemon::utils;
 namespace lemon {
 namespace backends {
 
+namespace {
+
+// Accepts "24-31", "0,2,4", or a mix of both.
+std::vector<int> parse_cpu_set(const std::string& spec) {
+    std::vector<int> cpus;
+    size_t pos = 0;
+    while (pos <= spec.size()) {
+        size_t comma = spec.find(',', pos);
+        std::string token = spec.substr(
+            pos, comma == std::string::npos ? std::string::npos : comma - pos);
+        if (!token.empty()) {
+            size_t dash = token.find('-');
+            try {
+                int first = std::stoi(token.substr(0, dash));
+                int last = dash == std::string::npos
+                    ? first
+                    : std::stoi(token.substr(dash + 1));
+                if (first < 0 || last < first) {
+                    throw std::invalid_argument(token);
+                }
+                for (int cpu = first; cpu <= last; ++cpu) {
+                    cpus.push_back(cpu);
+                }
+            } catch (const std::exception&) {
+                throw std::invalid_argument(
+                    "Invalid moonshine_cpu_set entry: " + token);
+            }
+        }
+        if (comma == std::string::npos) {
+            break;
+        }
+        pos = comma + 1;
+    }
+    return cpus;
+}
+
+}  // namespace
+
 InstallParams MoonshineServer::get_install_params(const std::string& backend, const std::string& version) {
     (void)backend;  // moonshine is CPU-only
     InstallParams params;
@@ -71,6 +110,26 @@ void MoonshineServer::load(const std::string& model_name,
     LOG(INFO, "MoonshineServer") << "Per-model settings: " << options.to_log_string() << std::endl;
 
     std::string moonshine_args = options.get_option("moonshine_args");
+    std::string moonshine_sessions = options.get_option("moonshine_sessions");
+    std::string moonshine_cpu_set = options.get_option("moonshine_cpu_set");
+
+    int sessions = 1;
+    if (!moonshine_sessions.empty()) {
+        try {
+            sessions = std::stoi(moonshine_sessions);
+        } catch (const std::exception&) {
+            sessions = 0;
+        }
+        if (sessions < 1) {
+            throw std::invalid_argument(
+                "moonshine_sessions must be a positive integer, got: " + moonshine_sessions);
+        }
+    }
+
+    std::vector<int> cpus;
+    if (!moonshine_cpu_set.empty()) {
+        cpus = parse_cpu_set(moonshine_cpu_set);
+    }
 
     device_type_ = DEVICE_CPU;
 
@@ -134,13 +193,19 @@ void MoonshineServer::load(const std::string& model_name,
         "--tcp-port", std::to_string(tcp_port_)
     };
 
+    if (sessions > 1) {
+        args.push_back("--num-sessions");
+        args.push_back(std::to_string(sessions));
+    }
+
     // Lemonade manages the model path and ports; optional moonshine-server
     // flags come from moonshine_args.
     std::set<std::string> reserved_flags = {
         "--model-path",
         "--model-arch",
         "--port",
-        "--tcp-port"
+        "--tcp-port",
+        "--num-sessions"
     };
 
     if (!moonshine_args.empty()) {
@@ -160,6 +225,14 @@ void MoonshineServer::load(const std::string& model_name,
     // Prevent system/user Python packages from leaking into the bundled environment
     env_vars.push_back({"PYTHONNOUSERSITE", "1"});
 
+    if (!cpus.empty()) {
+        // Split the reserved core set across sessions so ONNX intra-op pools
+        // don't oversubscribe it and spill onto LLM cores.
+        int threads_per_session =
+            std::max(1, static_cast<int>(cpus.size()) / sessions);
+        env_vars.push_back({"OMP_NUM_THREADS", std::to_string(threads_per_session)});
+    }
+
     bool inherit_output = (log_level_ == "info") || is_debug();
     ProcessHandle started_handle = utils::ProcessManager::start_process(
         executable,
@@ -177,6 +250,16 @@ void MoonshineServer::load(const std::string& model_name,
 
     LOG(INFO, "MoonshineServer") << "Process started with PID: " << started_handle.pid << std::endl;
 
+    if (!cpus.empty()) {
+        if (utils::ProcessManager::set_process_affinity(started_handle, cpus)) {
+            LOG(INFO, "MoonshineServer") << "Pinned to CPUs " << moonshine_cpu_set << std::endl;
+        } else {
+            LOG(WARNING, "MoonshineServer")
+                << "Could not pin process to CPUs " << moonshine_cpu_set
+                << "; continuing without affinity" << std::endl;
+        }
+    }
+
     if (!wait_for_ready("/health")) {
         unload();
         throw std::runtime_error("moonshine-server failed to start or become ready");
@@ -238,12 +321,17 @@ json MoonshineServer::responses(const json& request) {
 
 json MoonshineServer::forward_multipart_audio_data(const std::string& audio_data,
                                                    const std::string& filename,
-                                                   const json& params) {
-    if (audio_data.empty()) {
+                                                   const json& params,
+                                                   const std::string& file_path) {
+    if (audio_data.empty() && file_path.empty()) {
         throw std::runtime_error("Empty audio data");
     }
 
-    LOG(DEBUG, "MoonshineServer") << "Audio data size: " << audio_data.size() << " bytes" << std::endl;
+    if (file_path.empty()) {
+        LOG(DEBUG, "MoonshineServer") << "Audio data size: " << audio_data.size() << " bytes" << std::endl;
+    } else {
+        LOG(DEBUG, "MoonshineServer") << "Streaming audio from " << file_path << std::endl;
+    }
 
     fs::path filepath(filename);
     std::string ext = filepath.extension().string();
@@ -260,7 +348,11 @@ json MoonshineServer::forward_multipart_audio_data(const std::string& audio_data
 
     utils::MultipartField audio_file;
     audio_file.name = "file";
-    audio_file.data = audio_data;
+    if (file_path.empty()) {
+        audio_file.data = audio_data;
+    } else {
+        audio_file.file_path = file_path;
+    }
     audio_file.filename = filepath.filename().string();
     audio_file.content_type = content_type;
     fields.push_back(audio_file);
@@ -338,6 +430,12 @@ json MoonshineServer::forward_multipart_audio_data(const std::string& audio_data
 // ITranscriptionServer implementation
 json MoonshineServer::audio_transcriptions(const json& request) {
     try {
+        if (request.contains("file_path")) {
+            std::string file_path = request["file_path"].get<std::string>();
+            std::string filename = request.value("filename", file_path);
+            return forward_multipart_audio_data("", filename, request, file_path);
+        }
+
         if (!request.contains("file_data")) {
             throw std::runtime_error("Missing 'file_data' in request");
         }
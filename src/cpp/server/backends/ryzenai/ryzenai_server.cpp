@@ -174,7 +174,7 @@ std::unique_ptr<WrappedServer> create(const BackendContext& ctx) {
         ctx.model_info->model_name, ctx.log_level == "debug",
         ctx.model_manager, ctx.backend_manager);
     server->set_model_path(ctx.model_info->resolved_path());
-    return server;
+    return with_capability_mask(std::move(server));
 }
 
 
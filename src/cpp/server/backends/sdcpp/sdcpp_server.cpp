@@ -12,13 +12,16 @@
 #include "lemon/error_types.h"
 #include "lemon/system_info.h"
 #include <httplib.h>
+#include <algorithm>
 #include <iostream>
 #include <filesystem>
 #include <fstream>
 #include <chrono>
+#include <condition_variable>
 #include <random>
 #include <sstream>
 #include <set>
+#include <thread>
 #include <lemon/utils/aixlog.hpp>
 
 namespace fs = std::filesystem;
@@ -83,6 +86,140 @@ std::string get_therock_version() {
 int generate_random_seed() {
     return static_cast<int>(std::random_device{}() & 0x7fffffffU);
 }
+
+uint64_t fnv1a64(const std::string& text) {
+    uint64_t hash = 14695981039346656037ull;
+    for (unsigned char c : text) {
+        hash ^= c;
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
+// Stat-based component identity (same scheme as the backend executable
+// manifest): hashing the multi-GB weights themselves would cost as much as
+// loading them, and path+size+mtime changes whenever the file does.
+uint64_t component_hash(const std::string& path) {
+    std::error_code ec;
+    const fs::path p = path_from_utf8(path);
+    const auto size = fs::file_size(p, ec);
+    const auto mtime = fs::last_write_time(p, ec).time_since_epoch().count();
+    return fnv1a64(path + "|" + std::to_string(size) + "|" + std::to_string(mtime));
+}
+
+// Evicted sd-server subprocess parked for reuse. A parked pipeline keeps its
+// whole component set (text encoder, UNet, VAE) resident, so flipping back to
+// a recently used checkpoint skips the cold start entirely. One slot: the
+// alternating style-exploration pattern only needs the previous pipeline, and
+// each parked process holds gigabytes of weights, so the TTL reaper bounds
+// how long that memory stays claimed after the last switch.
+class ParkedPipeline {
+public:
+    static ParkedPipeline& instance() {
+        static ParkedPipeline parked;
+        return parked;
+    }
+
+    bool adopt(uint64_t fingerprint, const std::vector<uint64_t>& component_hashes,
+               int& port, utils::ProcessHandle& handle) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!occupied_) {
+            return false;
+        }
+        if (!utils::ProcessManager::is_running(handle_)) {
+            occupied_ = false;
+            return false;
+        }
+        if (fingerprint_ != fingerprint) {
+            size_t shared = 0;
+            for (uint64_t hash : component_hashes) {
+                if (std::find(component_hashes_.begin(), component_hashes_.end(),
+                              hash) != component_hashes_.end()) {
+                    ++shared;
+                }
+            }
+            if (shared > 0) {
+                LOG(INFO, "SDServer")
+                    << "Parked pipeline shares " << shared << " of "
+                    << component_hashes.size()
+                    << " components; sd-server cannot swap components "
+                    << "individually, cold-starting" << std::endl;
+            }
+            stop_locked();
+            return false;
+        }
+        port = port_;
+        handle = handle_;
+        occupied_ = false;
+        return true;
+    }
+
+    void park(uint64_t fingerprint, const std::vector<uint64_t>& component_hashes,
+              int port, utils::ProcessHandle handle, int ttl_seconds) {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stop_locked();
+            fingerprint_ = fingerprint;
+            component_hashes_ = component_hashes;
+            port_ = port;
+            handle_ = handle;
+            deadline_ = std::chrono::steady_clock::now() + std::chrono::seconds(ttl_seconds);
+            occupied_ = true;
+            if (!reaper_.joinable()) {
+                reaper_ = std::thread([this] { reap_loop(); });
+            }
+        }
+        cv_.notify_all();
+    }
+
+    ~ParkedPipeline() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            shutdown_ = true;
+            stop_locked();
+        }
+        cv_.notify_all();
+        if (reaper_.joinable()) {
+            reaper_.join();
+        }
+    }
+
+private:
+    void stop_locked() {
+        if (occupied_) {
+            LOG(INFO, "SDServer") << "Stopping parked sd-server (PID: "
+                                  << handle_.pid << ")" << std::endl;
+            utils::ProcessManager::stop_process(handle_);
+            occupied_ = false;
+        }
+    }
+
+    void reap_loop() {
+        std::unique_lock<std::mutex> lock(mutex_);
+        while (!shutdown_) {
+            if (!occupied_) {
+                cv_.wait(lock);
+                continue;
+            }
+            cv_.wait_until(lock, deadline_);
+            if (occupied_ && std::chrono::steady_clock::now() >= deadline_) {
+                LOG(INFO, "SDServer") << "Parked pipeline stayalive expired" << std::endl;
+                stop_locked();
+            }
+        }
+    }
+
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    std::thread reaper_;
+    bool shutdown_ = false;
+    bool occupied_ = false;
+    uint64_t fingerprint_ = 0;
+    std::vector<uint64_t> component_hashes_;
+    int port_ = 0;
+    utils::ProcessHandle handle_{nullptr, 0};
+    std::chrono::steady_clock::time_point deadline_;
+};
 }
 
 InstallParams SDServer::get_install_params(const std::string& backend, const std::string& version) {
@@ -233,6 +370,53 @@ void SDServer::load(const std::string& model_name,
 
     std::string exe_path = BackendUtils::get_backend_binary_path(*sdcpp::spec(), backend);
 
+    stayalive_seconds_ = 300;
+    std::string stayalive_opt = options.get_option("sdcpp_stayalive");
+    if (!stayalive_opt.empty()) {
+        try {
+            stayalive_seconds_ = std::stoi(stayalive_opt);
+        } catch (const std::exception&) {
+            stayalive_seconds_ = -1;
+        }
+        if (stayalive_seconds_ < 0) {
+            throw std::invalid_argument(
+                "sdcpp_stayalive must be a non-negative number of seconds, got: " + stayalive_opt);
+        }
+    }
+
+    component_hashes_ = {component_hash(model_path)};
+    if (!llm_path.empty() && !vae_path.empty()) {
+        component_hashes_.push_back(component_hash(llm_path));
+        component_hashes_.push_back(component_hash(vae_path));
+    }
+    std::string fingerprint_summary = resolved_backend + "\x1f" + sdcpp_args;
+    for (uint64_t hash : component_hashes_) {
+        fingerprint_summary += "\x1f" + std::to_string(hash);
+    }
+    pipeline_fingerprint_ = fnv1a64(fingerprint_summary);
+
+    if (stayalive_seconds_ > 0) {
+        int parked_port = 0;
+        utils::ProcessHandle parked_handle{nullptr, 0};
+        if (ParkedPipeline::instance().adopt(pipeline_fingerprint_, component_hashes_,
+                                             parked_port, parked_handle)) {
+            adopt_running_backend(parked_port, parked_handle);
+            if (wait_for_ready("/", 10)) {
+                parkable_ = true;
+                LOG(INFO, "SDServer") << "Reusing parked pipeline for " << model_name
+                                      << " (PID: " << parked_handle.pid
+                                      << ", port: " << parked_port << ")" << std::endl;
+                return;
+            }
+            LOG(WARNING, "SDServer")
+                << "Parked pipeline is unresponsive; cold-starting" << std::endl;
+            const ProcessHandle stale = consume_process_handle_for_cleanup();
+            if (has_process_handle(stale)) {
+                utils::ProcessManager::stop_process(stale);
+            }
+        }
+    }
+
     port_ = choose_port();
     if (port_ == 0) {
         throw std::runtime_error("Failed to find an available port");
@@ -387,6 +571,7 @@ void SDServer::load(const std::string& model_name,
         throw std::runtime_error("sd-server failed to start or become ready");
     }
 
+    parkable_ = true;
     LOG(INFO, "SDServer") << "Server is ready at http://127.0.0.1:" << get_backend_port() << std::endl;
 }
 
@@ -394,10 +579,22 @@ void SDServer::unload() {
     stop_backend_watchdog();
     const ProcessHandle handle = consume_process_handle_for_cleanup();
     if (has_process_handle(handle)) {
-        LOG(INFO, "SDServer") << "Stopping server (PID: " << handle.pid << ")" << std::endl;
-        utils::ProcessManager::stop_process(handle);
+        if (parkable_ && stayalive_seconds_ > 0 && utils::ProcessManager::is_running(handle)) {
+            LOG(INFO, "SDServer") << "Parking pipeline (PID: " << handle.pid
+                                  << ") for " << stayalive_seconds_ << "s" << std::endl;
+            ParkedPipeline::instance().park(pipeline_fingerprint_, component_hashes_,
+                                            port_, handle, stayalive_seconds_);
+        } else {
+            LOG(INFO, "SDServer") << "Stopping server (PID: " << handle.pid << ")" << std::endl;
+            utils::ProcessManager::stop_process(handle);
+        }
     }
+    parkable_ = false;
     image_defaults_ = ImageDefaults{};
+    {
+        std::lock_guard<std::mutex> lock(decode_cache_mutex_);
+        decode_cache_.clear();
+    }
 }
 
 json SDServer::build_extra_args(const json& request, bool include_flow_shift) const {
@@ -515,6 +712,27 @@ std::string SDServer::resolve_size(const json& request) const {
     return "";
 }
 
+std::string SDServer::decoded_image(const std::string& b64) {
+    // Keyed by (hash, length) so a bare 64-bit collision can't serve the
+    // wrong image.
+    const uint64_t key = fnv1a64(b64) ^ static_cast<uint64_t>(b64.size());
+    std::lock_guard<std::mutex> lock(decode_cache_mutex_);
+    for (auto it = decode_cache_.begin(); it != decode_cache_.end(); ++it) {
+        if (it->first == key) {
+            auto entry = std::move(*it);
+            decode_cache_.erase(it);
+            decode_cache_.push_back(std::move(entry));
+            return decode_cache_.back().second;
+        }
+    }
+    std::string decoded = JsonUtils::base64_decode(b64);
+    if (decode_cache_.size() >= DECODE_CACHE_ENTRIES) {
+        decode_cache_.erase(decode_cache_.begin());
+    }
+    decode_cache_.push_back({key, decoded});
+    return decoded;
+}
+
 // ICompletionServer implementation - not supported for image generation
 json SDServer::chat_completion(const json& /* request */) {
     return ErrorResponse::from_exception(
@@ -586,14 +804,12 @@ json SDServer::image_edits(const json& request) {
     }
 
     if (request.contains("image_data")) {
-        std::string image_binary = JsonUtils::base64_decode(
-            request["image_data"].get<std::string>());
-        fields.push_back({"image[]", image_binary, "image.png", "image/png"});
+        fields.push_back({"image[]", decoded_image(request["image_data"].get<std::string>()),
+                          "image.png", "image/png"});
     }
     if (request.contains("mask_data")) {
-        std::string mask_binary = JsonUtils::base64_decode(
-            request["mask_data"].get<std::string>());
-        fields.push_back({"mask", mask_binary, "mask.png", "image/png"});
+        fields.push_back({"mask", decoded_image(request["mask_data"].get<std::string>()),
+                          "mask.png", "image/png"});
     }
 
     LOG(DEBUG, "SDServer") << "Forwarding image edits to /v1/images/edits (multipart)"
@@ -623,9 +839,8 @@ json SDServer::image_variations(const json& request) {
     }
 
     if (request.contains("image_data")) {
-        std::string image_binary = JsonUtils::base64_decode(
-            request["image_data"].get<std::string>());
-        fields.push_back({"image[]", image_binary, "image.png", "image/png"});
+        fields.push_back({"image[]", decoded_image(request["image_data"].get<std::string>()),
+                          "image.png", "image/png"});
     }
 
     LOG(DEBUG, "SDServer") << "Forwarding image variations to /v1/images/edits (multipart)"
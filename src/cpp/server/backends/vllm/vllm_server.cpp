@@ -764,6 +764,36 @@ std::map<std::string, nlohmann::json> VLLMServer::get_additional_telemetry() {
     return {};
 }
 
+json VLLMServer::get_queue_stats() {
+    if (get_backend_port() <= 0) {
+        return json();
+    }
+    std::lock_guard<std::mutex> lock(queue_stats_mutex_);
+    const auto now = std::chrono::steady_clock::now();
+    if (queue_stats_fetched_at_ != std::chrono::steady_clock::time_point{} &&
+        now - queue_stats_fetched_at_ < std::chrono::seconds(1)) {
+        return queue_stats_cache_;
+    }
+    queue_stats_fetched_at_ = now;
+    queue_stats_cache_ = json();
+    auto attrs = get_additional_telemetry();
+    json stats = json::object();
+    auto copy_attr = [&](const char* attr, const char* key) {
+        auto it = attrs.find(attr);
+        if (it != attrs.end()) {
+            stats[key] = it->second;
+        }
+    };
+    copy_attr("llm.vllm.num_requests_running", "running");
+    copy_attr("llm.vllm.num_requests_waiting", "waiting");
+    copy_attr("llm.vllm.num_requests_swapped", "swapped");
+    copy_attr("llm.vllm.gpu_cache_usage_factor", "kv_cache_usage");
+    if (!stats.empty()) {
+        queue_stats_cache_ = std::move(stats);
+    }
+    return queue_stats_cache_;
+}
+
 std::string VLLMServer::get_additional_telemetry_url() const {
     if (get_backend_port() <= 0) {
         return "";
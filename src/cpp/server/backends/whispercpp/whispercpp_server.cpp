@@ -479,17 +479,14 @@ json WhisperServer::build_transcription_request(const json& request, bool transl
 json WhisperServer::forward_multipart_audio_request(const std::string& file_path,
                                                     const json& params,
                                                     bool translate) {
-    std::ifstream file(file_path, std::ios::binary);
-    if (!file) {
+    std::error_code ec;
+    const auto file_size = fs::file_size(path_from_utf8(file_path), ec);
+    if (ec) {
         throw std::runtime_error("Could not open audio file: " + file_path);
     }
 
-    std::ostringstream oss;
-    oss << file.rdbuf();
-    std::string file_content = oss.str();
-    file.close();
-
-    LOG(DEBUG, "WhisperServer") << "Audio file size: " << file_content.size() << " bytes" << std::endl;
+    LOG(DEBUG, "WhisperServer") << "Audio file size: " << file_size
+                                << " bytes (streamed from disk)" << std::endl;
 
     fs::path filepath(file_path);
     std::string ext = filepath.extension().string();
@@ -506,8 +503,8 @@ json WhisperServer::forward_multipart_audio_request(const std::string& file_path
 
     utils::MultipartField audio_file;
     audio_file.name = "file";
-    audio_file.data = file_content;
-    audio_file.filename = filepath.filename().string();
+    audio_file.file_path = file_path;
+    audio_file.filename = params.value("filename", filepath.filename().string());
     audio_file.content_type = content_type;
     fields.push_back(audio_file);
 
@@ -676,6 +673,13 @@ json WhisperServer::forward_multipart_audio_data(const std::string& audio_data,
 // ITranscriptionServer implementation
 json WhisperServer::audio_transcriptions(const json& request) {
     try {
+        // Uploads spilled to disk by the server arrive as file_path and are
+        // streamed to whisper-server without ever being held in memory.
+        if (request.contains("file_path")) {
+            return forward_multipart_audio_request(
+                request["file_path"].get<std::string>(), request, false);
+        }
+
         if (!request.contains("file_data")) {
             throw std::runtime_error("Missing 'file_data' in request");
         }
@@ -703,7 +707,8 @@ namespace backends {
 namespace whispercpp {
 
 std::unique_ptr<WrappedServer> create(const BackendContext& ctx) {
-    return std::make_unique<WhisperServer>(ctx.log_level, ctx.model_manager, ctx.backend_manager);
+    return with_capability_mask(std::make_unique<WhisperServer>(
+        ctx.log_level, ctx.model_manager, ctx.backend_manager));
 }
 
 
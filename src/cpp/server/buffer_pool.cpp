@@ -0,0 +1,138 @@
+#include "lemon/buffer_pool.h"
+
+#include <array>
+#include <atomic>
+#include <vector>
+
+namespace lemon {
+
+namespace {
+
+constexpr size_t kMinClassShift = 12; // 4 KiB
+constexpr size_t kMaxClassShift = 22; // 4 MiB
+constexpr size_t kNumClasses = kMaxClassShift - kMinClassShift + 1;
+constexpr size_t kMaxBuffersPerClass = 4;
+
+std::atomic<uint64_t> g_hits{0};
+std::atomic<uint64_t> g_misses{0};
+std::atomic<uint64_t> g_discarded{0};
+std::atomic<uint64_t> g_pooled_buffers{0};
+std::atomic<uint64_t> g_pooled_bytes{0};
+
+size_t class_for(size_t capacity) {
+    size_t shift = kMinClassShift;
+    while (shift < kMaxClassShift && (size_t{1} << shift) < capacity) {
+        ++shift;
+    }
+    return shift - kMinClassShift;
+}
+
+struct FreeLists {
+    std::array<std::vector<std::string>, kNumClasses> lists;
+
+    ~FreeLists() {
+        for (const auto& list : lists) {
+            for (const auto& buffer : list) {
+                g_pooled_buffers.fetch_sub(1, std::memory_order_relaxed);
+                g_pooled_bytes.fetch_sub(buffer.capacity(),
+                                         std::memory_order_relaxed);
+            }
+        }
+    }
+};
+
+FreeLists& free_lists() {
+    thread_local FreeLists lists;
+    return lists;
+}
+
+} // namespace
+
+BufferPool::Handle::~Handle() {
+    if (buffer_.capacity() > 0) {
+        BufferPool::release(std::move(buffer_));
+    }
+}
+
+BufferPool::Handle::Handle(Handle&& other) noexcept
+    : buffer_(std::move(other.buffer_)) {
+    other.buffer_ = std::string();
+}
+
+BufferPool::Handle& BufferPool::Handle::operator=(Handle&& other) noexcept {
+    if (this != &other) {
+        if (buffer_.capacity() > 0) {
+            BufferPool::release(std::move(buffer_));
+        }
+        buffer_ = std::move(other.buffer_);
+        other.buffer_ = std::string();
+    }
+    return *this;
+}
+
+std::string BufferPool::Handle::take() {
+    std::string out = std::move(buffer_);
+    buffer_ = std::string();
+    return out;
+}
+
+BufferPool::Handle BufferPool::acquire(size_t min_capacity) {
+    if (min_capacity <= (size_t{1} << kMaxClassShift)) {
+        auto& list = free_lists().lists[class_for(min_capacity)];
+        if (!list.empty()) {
+            std::string buffer = std::move(list.back());
+            list.pop_back();
+            g_pooled_buffers.fetch_sub(1, std::memory_order_relaxed);
+            g_pooled_bytes.fetch_sub(buffer.capacity(), std::memory_order_relaxed);
+            g_hits.fetch_add(1, std::memory_order_relaxed);
+            return Handle(std::move(buffer));
+        }
+    }
+
+    g_misses.fetch_add(1, std::memory_order_relaxed);
+    std::string buffer;
+    buffer.reserve(min_capacity <= (size_t{1} << kMaxClassShift)
+                       ? (size_t{1} << (class_for(min_capacity) + kMinClassShift))
+                       : min_capacity);
+    return Handle(std::move(buffer));
+}
+
+void BufferPool::release(std::string&& buffer) {
+    const size_t capacity = buffer.capacity();
+    if (capacity < (size_t{1} << kMinClassShift) ||
+        capacity > (size_t{1} << kMaxClassShift)) {
+        g_discarded.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    // Growth past the class boundary would hand the next acquirer less than
+    // its class guarantees; re-bucket by the class the capacity still fills.
+    size_t cls = class_for(capacity);
+    if ((size_t{1} << (cls + kMinClassShift)) > capacity) {
+        if (cls == 0) {
+            g_discarded.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        --cls;
+    }
+    auto& list = free_lists().lists[cls];
+    if (list.size() >= kMaxBuffersPerClass) {
+        g_discarded.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    buffer.clear();
+    g_pooled_buffers.fetch_add(1, std::memory_order_relaxed);
+    g_pooled_bytes.fetch_add(capacity, std::memory_order_relaxed);
+    list.push_back(std::move(buffer));
+}
+
+BufferPool::Totals BufferPool::totals() {
+    Totals totals;
+    totals.hits = g_hits.load();
+    totals.misses = g_misses.load();
+    totals.discarded = g_discarded.load();
+    totals.pooled_buffers = g_pooled_buffers.load();
+    totals.pooled_bytes = g_pooled_bytes.load();
+    return totals;
+}
+
+} // namespace lemon
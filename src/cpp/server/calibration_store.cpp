@@ -0,0 +1,188 @@
+#include "lemon/calibration_store.h"
+
+#include <fstream>
+#include <sstream>
+
+#include "lemon/utils/aixlog.hpp"
+#include "lemon/utils/path_utils.h"
+
+namespace lemon {
+
+namespace {
+
+CalibrationStore* g_calibration_store = nullptr;
+
+}  // namespace
+
+nlohmann::json CalibrationCurve::to_json() const {
+    return {
+        {"kv_bytes_per_token", kv_bytes_per_token},
+        {"base_gb", base_gb},
+        {"prefill_tps", prefill_tps},
+        {"decode_tps", decode_tps},
+        {"measured_at", measured_at},
+    };
+}
+
+CalibrationCurve CalibrationCurve::from_json(const nlohmann::json& j) {
+    CalibrationCurve c;
+    c.kv_bytes_per_token = j.value("kv_bytes_per_token", 0.0);
+    c.base_gb = j.value("base_gb", 0.0);
+    c.prefill_tps = j.value("prefill_tps", 0.0);
+    c.decode_tps = j.value("decode_tps", 0.0);
+    c.measured_at = j.value("measured_at", std::string());
+    return c;
+}
+
+CalibrationStore* CalibrationStore::global() {
+    return g_calibration_store;
+}
+
+void CalibrationStore::set_global(CalibrationStore* instance) {
+    g_calibration_store = instance;
+}
+
+CalibrationStore::CalibrationStore(const std::filesystem::path& store_path,
+                                   std::function<std::string()> fingerprint_provider)
+    : store_path_(store_path),
+      fingerprint_provider_(std::move(fingerprint_provider)) {}
+
+const std::string& CalibrationStore::fingerprint_locked() {
+    if (fingerprint_.empty() && fingerprint_provider_) {
+        fingerprint_ = fingerprint_provider_();
+    }
+    return fingerprint_;
+}
+
+const std::string& CalibrationStore::fingerprint() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return fingerprint_locked();
+}
+
+std::optional<CalibrationCurve> CalibrationStore::lookup(const std::string& model) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    load_locked();
+    const std::string& fp = fingerprint_locked();
+    if (fp.empty()) {
+        return std::nullopt;
+    }
+    auto by_model = entries_.find(fp);
+    if (by_model == entries_.end()) {
+        return std::nullopt;
+    }
+    auto it = by_model->second.find(model);
+    if (it == by_model->second.end()) {
+        return std::nullopt;
+    }
+    return it->second;
+}
+
+void CalibrationStore::store(const std::string& model, const CalibrationCurve& curve) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    load_locked();
+    const std::string& fp = fingerprint_locked();
+    if (fp.empty()) {
+        return;
+    }
+    entries_[fp][model] = curve;
+    save_locked();
+}
+
+void CalibrationStore::load_locked() {
+    if (loaded_) {
+        return;
+    }
+    loaded_ = true;
+
+    std::ifstream file(store_path_);
+    if (!file.is_open()) {
+        return;
+    }
+    try {
+        const auto doc = nlohmann::json::parse(file);
+        const auto fingerprints = doc.value("fingerprints", nlohmann::json::object());
+        for (const auto& [fp, models] : fingerprints.items()) {
+            if (!models.is_object()) continue;
+            for (const auto& [model, curve] : models.items()) {
+                entries_[fp][model] = CalibrationCurve::from_json(curve);
+            }
+        }
+    } catch (const std::exception& e) {
+        LOG(WARNING, "CalibrationStore") << "Discarding unreadable calibration store "
+                                         << utils::path_to_utf8(store_path_)
+                                         << ": " << e.what() << std::endl;
+        entries_.clear();
+    }
+}
+
+void CalibrationStore::save_locked() {
+    nlohmann::json fingerprints = nlohmann::json::object();
+    for (const auto& [fp, models] : entries_) {
+        nlohmann::json by_model = nlohmann::json::object();
+        for (const auto& [model, curve] : models) {
+            by_model[model] = curve.to_json();
+        }
+        fingerprints[fp] = std::move(by_model);
+    }
+
+    std::ofstream file(store_path_, std::ios::trunc);
+    if (!file.is_open()) {
+        LOG(WARNING, "CalibrationStore") << "Cannot write calibration store "
+                                         << utils::path_to_utf8(store_path_) << std::endl;
+        return;
+    }
+    file << nlohmann::json{{"fingerprints", std::move(fingerprints)}}.dump(2);
+}
+
+bool CalibrationStore::fit_linear(
+    const std::vector<std::pair<int64_t, double>>& points,
+    double& kv_bytes_per_token, double& base_gb) {
+    if (points.size() < 2) {
+        return false;
+    }
+
+    double sum_x = 0.0, sum_y = 0.0, sum_xx = 0.0, sum_xy = 0.0;
+    for (const auto& [ctx, gb] : points) {
+        const double x = static_cast<double>(ctx);
+        sum_x += x;
+        sum_y += gb;
+        sum_xx += x * x;
+        sum_xy += x * gb;
+    }
+
+    const double n = static_cast<double>(points.size());
+    const double denom = n * sum_xx - sum_x * sum_x;
+    if (denom <= 0.0) {
+        return false;  // all points share one context size
+    }
+
+    const double slope_gb_per_token = (n * sum_xy - sum_x * sum_y) / denom;
+    kv_bytes_per_token = slope_gb_per_token * 1024.0 * 1024.0 * 1024.0;
+    base_gb = (sum_y - slope_gb_per_token * sum_x) / n;
+    return true;
+}
+
+std::string CalibrationStore::compute_hardware_fingerprint(
+    const nlohmann::json& system_info) {
+    std::ostringstream digest_input;
+    digest_input << system_info.value("Processor", "") << '|'
+                 << system_info.value("Physical Memory", "");
+
+    const nlohmann::json devices =
+        system_info.value("devices", nlohmann::json::object());
+    if (devices.contains("amd_gpu") && devices["amd_gpu"].is_array()) {
+        for (const auto& gpu : devices["amd_gpu"]) {
+            digest_input << '|' << gpu.value("name", "");
+            if (gpu.contains("vram_gb")) digest_input << ':' << gpu["vram_gb"].dump();
+        }
+    }
+    if (devices.contains("amd_npu") && devices["amd_npu"].is_object()) {
+        digest_input << '|' << devices["amd_npu"].value("name", "");
+    }
+
+    std::ostringstream out;
+    out << std::hex << std::hash<std::string>{}(digest_input.str());
+    return out.str();
+}
+
+}  // namespace lemon
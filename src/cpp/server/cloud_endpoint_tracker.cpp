@@ -0,0 +1,72 @@
+#include "lemon/cloud_endpoint_tracker.h"
+
+#include <algorithm>
+
+namespace lemon {
+namespace {
+
+constexpr double kEwmaAlpha = 0.2;
+
+// One fully failing endpoint (error_rate 1.0) scores worse than any healthy
+// endpoint short of this latency, so failover beats a fast-but-broken region.
+constexpr double kErrorPenaltyMs = 60000.0;
+
+} // namespace
+
+void CloudEndpointTracker::record_success(const std::string& endpoint,
+                                          double latency_ms) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    Snapshot& s = endpoints_[endpoint];
+    if (s.successes + s.failures == 0) {
+        s.latency_ms = latency_ms;
+    } else {
+        s.latency_ms += kEwmaAlpha * (latency_ms - s.latency_ms);
+    }
+    s.error_rate += kEwmaAlpha * (0.0 - s.error_rate);
+    ++s.successes;
+}
+
+void CloudEndpointTracker::record_failure(const std::string& endpoint) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    Snapshot& s = endpoints_[endpoint];
+    s.error_rate += kEwmaAlpha * (1.0 - s.error_rate);
+    ++s.failures;
+}
+
+double CloudEndpointTracker::score_locked(const std::string& endpoint) const {
+    const auto it = endpoints_.find(endpoint);
+    if (it == endpoints_.end()) {
+        return 0.0;
+    }
+    return it->second.latency_ms + it->second.error_rate * kErrorPenaltyMs;
+}
+
+std::vector<std::string> CloudEndpointTracker::rank(
+    std::vector<std::string> endpoints) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::stable_sort(endpoints.begin(), endpoints.end(),
+                     [this](const std::string& a, const std::string& b) {
+                         return score_locked(a) < score_locked(b);
+                     });
+    return endpoints;
+}
+
+CloudEndpointTracker::Snapshot CloudEndpointTracker::snapshot(
+    const std::string& endpoint) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    const auto it = endpoints_.find(endpoint);
+    return it == endpoints_.end() ? Snapshot{} : it->second;
+}
+
+std::map<std::string, CloudEndpointTracker::Snapshot>
+CloudEndpointTracker::snapshot_all() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return endpoints_;
+}
+
+CloudEndpointTracker& CloudEndpointTracker::instance() {
+    static CloudEndpointTracker tracker;
+    return tracker;
+}
+
+} // namespace lemon
@@ -120,6 +120,15 @@ void CloudProviderRegistry::load_from_config(const json& cloud_providers_array)
         if (entry.contains("allow_insecure_http") && entry["allow_insecure_http"].is_boolean()) {
             r.allow_insecure_http = entry["allow_insecure_http"].get<bool>();
         }
+        if (entry.contains("fallback_base_urls") && entry["fallback_base_urls"].is_array()) {
+            for (const auto& url : entry["fallback_base_urls"]) {
+                if (!url.is_string()) continue;
+                std::string normalized = normalize_base_url(url.get<std::string>());
+                if (!normalized.empty()) {
+                    r.fallback_base_urls.push_back(std::move(normalized));
+                }
+            }
+        }
         if (r.name.empty() || r.base_url.empty()) continue;
         installed_.push_back(std::move(r));
     }
@@ -129,32 +138,49 @@ json CloudProviderRegistry::to_config_array() const {
     std::shared_lock lock(mu_);
     json arr = json::array();
     for (const auto& r : installed_) {
-        arr.push_back({
+        json entry = {
             {"name", r.name},
             {"base_url", r.base_url},
             {"allow_insecure_http", r.allow_insecure_http}
-        });
+        };
+        if (!r.fallback_base_urls.empty()) {
+            entry["fallback_base_urls"] = r.fallback_base_urls;
+        }
+        arr.push_back(std::move(entry));
     }
     return arr;
 }
 
 bool CloudProviderRegistry::install(const std::string& provider,
                                     const std::string& base_url,
-                                    bool allow_insecure_http) {
+                                    bool allow_insecure_http,
+                                    std::vector<std::string> fallback_base_urls) {
     std::unique_lock lock(mu_);
     std::string normalized = normalize_base_url(base_url);
+    for (auto& url : fallback_base_urls) {
+        url = normalize_base_url(url);
+    }
+    fallback_base_urls.erase(
+        std::remove_if(fallback_base_urls.begin(), fallback_base_urls.end(),
+                       [&](const std::string& url) {
+                           return url.empty() || url == normalized;
+                       }),
+        fallback_base_urls.end());
     for (auto& r : installed_) {
         if (r.name == provider) {
             if (r.base_url == normalized &&
-                r.allow_insecure_http == allow_insecure_http) {
+                r.allow_insecure_http == allow_insecure_http &&
+                r.fallback_base_urls == fallback_base_urls) {
                 return false;
             }
             r.base_url = normalized;
             r.allow_insecure_http = allow_insecure_http;
+            r.fallback_base_urls = std::move(fallback_base_urls);
             return true;
         }
     }
-    installed_.push_back({provider, normalized, allow_insecure_http});
+    installed_.push_back(
+        {provider, normalized, allow_insecure_http, std::move(fallback_base_urls)});
     return true;
 }
 
@@ -188,6 +214,21 @@ std::string CloudProviderRegistry::base_url_for(const std::string& provider) con
     return "";
 }
 
+std::vector<std::string>
+CloudProviderRegistry::base_urls_for(const std::string& provider) const {
+    std::shared_lock lock(mu_);
+    for (const auto& r : installed_) {
+        if (r.name != provider) continue;
+        std::vector<std::string> urls;
+        urls.reserve(1 + r.fallback_base_urls.size());
+        urls.push_back(r.base_url);
+        urls.insert(urls.end(), r.fallback_base_urls.begin(),
+                    r.fallback_base_urls.end());
+        return urls;
+    }
+    return {};
+}
+
 bool CloudProviderRegistry::allow_insecure_http_for(const std::string& provider) const {
     std::shared_lock lock(mu_);
     for (const auto& r : installed_) {
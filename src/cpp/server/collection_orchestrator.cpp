@@ -11,9 +11,11 @@
 #include <set>
 #include <string>
 
+#include "lemon/json_repair.h"
 #include "lemon/logging_config.h"
 #include "lemon/model_types.h"
 #include "lemon/router.h"
+#include "lemon/sse_writer.h"
 #include "lemon/utils/json_utils.h"
 #include "lemon/utils/path_utils.h"
 #include <lemon/utils/aixlog.hpp>
@@ -76,6 +78,11 @@ const std::string& image_size() {
 constexpr int MAX_IMAGE_DIMENSION = 2048;
 constexpr int IMAGE_DIMENSION_STEP = 8;
 
+// In-memory cap for media produced during one turn; payloads beyond it are
+// spilled to disk by the ArtifactSpool and read back only when folded into
+// the final response, keeping a media-heavy loop's footprint flat.
+constexpr size_t ARTIFACT_MEMORY_BUDGET = 32ull * 1024 * 1024;
+
 std::string trim_copy(std::string s) {
     auto not_space = [](unsigned char c) { return !std::isspace(c); };
     s.erase(s.begin(), std::find_if(s.begin(), s.end(), not_space));
@@ -470,7 +477,7 @@ CollectionOrchestrator::ToolSet CollectionOrchestrator::build_tools(const ModelI
 }
 
 bool CollectionOrchestrator::execute_tool(const std::string& tool_name, const std::string& model,
-                                          const json& args, std::vector<Artifact>& artifacts,
+                                          const json& args, ArtifactSpool& artifacts,
                                           const std::string& source_image_b64,
                                           const std::string& source_image_mime,
                                           int& produced_index, std::string& success_text) {
@@ -482,12 +489,11 @@ bool CollectionOrchestrator::execute_tool(const std::string& tool_name, const st
         if (tool_name == "edit_image") {
             // Source: most recent generated image, else the seeded history image.
             std::string img_b64, img_mime;
-            for (auto it = artifacts.rbegin(); it != artifacts.rend(); ++it) {
-                if (it->type == "image") {
-                    img_b64 = it->data;
-                    img_mime = it->mime;
-                    break;
-                }
+            const int last = artifacts.last_image_index();
+            if (last >= 0) {
+                Artifact item = artifacts.get(static_cast<size_t>(last));
+                img_b64 = std::move(item.data);
+                img_mime = item.mime;
             }
             if (img_b64.empty()) {
                 img_b64 = source_image_b64;
@@ -509,16 +515,12 @@ bool CollectionOrchestrator::execute_tool(const std::string& tool_name, const st
             if (b64.empty()) throw std::runtime_error(backend_error_message(resp, "Image edit failed"));
 
             // Replace the last generated image this turn, else append.
-            int last = -1;
-            for (int i = static_cast<int>(artifacts.size()) - 1; i >= 0; --i) {
-                if (artifacts[i].type == "image") { last = i; break; }
-            }
             if (last >= 0) {
-                artifacts[last] = Artifact{"image", b64, "image/png"};
+                artifacts.replace(static_cast<size_t>(last), Artifact{"image", b64, "image/png"});
                 produced_index = last;
             } else {
-                artifacts.push_back(Artifact{"image", b64, "image/png"});
-                produced_index = static_cast<int>(artifacts.size()) - 1;
+                produced_index =
+                    static_cast<int>(artifacts.add(Artifact{"image", b64, "image/png"}));
             }
             success_text = "Image edited successfully.";
             return true;
@@ -532,8 +534,7 @@ bool CollectionOrchestrator::execute_tool(const std::string& tool_name, const st
         json resp = router_.image_generations(req);
         const std::string b64 = extract_b64(resp);
         if (b64.empty()) throw std::runtime_error(backend_error_message(resp, "Image generation failed"));
-        artifacts.push_back(Artifact{"image", b64, "image/png"});
-        produced_index = static_cast<int>(artifacts.size()) - 1;
+        produced_index = static_cast<int>(artifacts.add(Artifact{"image", b64, "image/png"}));
         success_text = "Image generated successfully.";
         return true;
     }
@@ -559,8 +560,8 @@ bool CollectionOrchestrator::execute_tool(const std::string& tool_name, const st
         router_.audio_speech(req, sink);
         if (buffer.empty()) throw std::runtime_error("Text-to-speech produced no audio");
 
-        artifacts.push_back(Artifact{"audio", utils::JsonUtils::base64_encode(buffer), "audio/mpeg"});
-        produced_index = static_cast<int>(artifacts.size()) - 1;
+        produced_index = static_cast<int>(
+            artifacts.add(Artifact{"audio", utils::JsonUtils::base64_encode(buffer), "audio/mpeg"}));
         success_text = "Audio generated successfully.";
         return true;
     }
@@ -688,7 +689,7 @@ CollectionOrchestrator::LoopResult CollectionOrchestrator::run_loop(
     ensure_loaded_(toolset.chat_model);
 
     json llm_messages = std::move(processed);
-    std::vector<Artifact> artifacts;
+    auto artifacts = std::make_shared<ArtifactSpool>(ARTIFACT_MEMORY_BUDGET);
     // Skip only exact repeated generation requests in this run. Distinct image
     // requests such as cat/dog or alternate camera angles remain allowed.
     std::set<std::string> generated_image_request_keys;
@@ -733,7 +734,7 @@ CollectionOrchestrator::LoopResult CollectionOrchestrator::run_loop(
 
         if (!has_tool_calls) {
             result.final_text = assistant_text;
-            result.artifacts = std::move(artifacts);
+            result.artifacts = artifacts;
             result.base_response = std::move(response);
             return result;
         }
@@ -756,9 +757,10 @@ CollectionOrchestrator::LoopResult CollectionOrchestrator::run_loop(
             const std::string name = tc.value("function", json::object()).value("name", "");
             const std::string model = toolset.tool_models.count(name) ? toolset.tool_models[name] : "";
             json args = json::object();
-            try {
-                args = json::parse(tc["function"].value("arguments", "{}"));
-            } catch (const std::exception&) {}
+            if (auto parsed = parse_or_repair_json(tc["function"].value("arguments", "{}"));
+                parsed && parsed->is_object()) {
+                args = *parsed;
+            }
 
             std::string success_text;
             int produced_index = -1;
@@ -771,7 +773,7 @@ CollectionOrchestrator::LoopResult CollectionOrchestrator::run_loop(
                 try {
                     LOG(INFO, "Collection") << "Tool call: " << name << " -> " << model << std::endl;
                     ensure_loaded_(model);
-                    execute_tool(name, model, args, artifacts, source_image_b64, source_image_mime,
+                    execute_tool(name, model, args, *artifacts, source_image_b64, source_image_mime,
                                  produced_index, success_text);
                     if (name == "generate_image" && produced_index >= 0) {
                         generated_image_request_keys.insert(gen_key);
@@ -781,8 +783,8 @@ CollectionOrchestrator::LoopResult CollectionOrchestrator::run_loop(
                     produced_index = -1;
                 }
             }
-            if (produced_index >= 0 && produced_index < static_cast<int>(artifacts.size())) {
-                on_artifact(artifacts[produced_index]);
+            if (produced_index >= 0 && produced_index < static_cast<int>(artifacts->size())) {
+                on_artifact(artifacts->get(static_cast<size_t>(produced_index)));
             }
             llm_messages.push_back({{"role", "tool"},
                                     {"tool_call_id", tc.value("id", "")},
@@ -793,7 +795,7 @@ CollectionOrchestrator::LoopResult CollectionOrchestrator::run_loop(
         // `artifacts`) and hand the app calls back to the caller to resume.
         if (!app_calls.empty()) {
             result.final_text = assistant_text;
-            result.artifacts = std::move(artifacts);
+            result.artifacts = artifacts;
             result.app_tool_calls = std::move(app_calls);
             result.finish_reason = "tool_calls";
             result.base_response = std::move(response);
@@ -807,9 +809,9 @@ CollectionOrchestrator::LoopResult CollectionOrchestrator::run_loop(
     // rather than silently truncated.
     LOG(WARNING, "Collection") << "Tool-calling loop hit the " << MAX_ITERATIONS
                                << "-iteration cap for collection '" << collection_info.model_name
-                               << "' (" << artifacts.size() << " artifact(s) produced)" << std::endl;
-    result.final_text = artifacts.empty() ? "Sorry, I was unable to complete that request." : "";
-    result.artifacts = std::move(artifacts);
+                               << "' (" << artifacts->size() << " artifact(s) produced)" << std::endl;
+    result.final_text = artifacts->empty() ? "Sorry, I was unable to complete that request." : "";
+    result.artifacts = artifacts;
     result.base_response = std::move(base_response);
     return result;
 }
@@ -824,9 +826,11 @@ json CollectionOrchestrator::chat_completion(const json& request, const ModelInf
     if (!lr.ok) return lr.error;
 
     std::string content = lr.final_text;
-    for (const auto& a : lr.artifacts) {
-        if (!content.empty()) content += "\n\n";
-        content += render_artifact(a);
+    if (lr.artifacts) {
+        for (size_t i = 0; i < lr.artifacts->size(); ++i) {
+            if (!content.empty()) content += "\n\n";
+            content += render_artifact(lr.artifacts->get(i));
+        }
     }
 
     json response = (lr.base_response.is_object() && !lr.base_response.empty())
@@ -863,7 +867,11 @@ CollectionOrchestrator::ChatParts CollectionOrchestrator::chat_completion_parts(
         return parts;
     }
     parts.final_text = std::move(lr.final_text);
-    parts.artifacts = std::move(lr.artifacts);
+    if (lr.artifacts) {
+        parts.artifacts.reserve(lr.artifacts->size());
+        for (size_t i = 0; i < lr.artifacts->size(); ++i)
+            parts.artifacts.push_back(lr.artifacts->get(i));
+    }
     parts.app_tool_calls = std::move(lr.app_tool_calls);
     parts.finish_reason = std::move(lr.finish_reason);
     return parts;
@@ -876,6 +884,7 @@ void CollectionOrchestrator::chat_completion_stream(const json& request,
     const std::string id = new_completion_id();
     const long created = static_cast<long>(std::time(nullptr));
 
+    SseWriter sse(sink);
     auto send = [&](const json& delta, const json& finish_reason) {
         json chunk = {{"id", id},
                       {"object", "chat.completion.chunk"},
@@ -884,8 +893,7 @@ void CollectionOrchestrator::chat_completion_stream(const json& request,
                       {"choices", json::array({{{"index", 0},
                                                 {"delta", delta},
                                                 {"finish_reason", finish_reason}}})}};
-        const std::string frame = "data: " + chunk.dump() + "\n\n";
-        sink.write(frame.c_str(), frame.size());
+        sse.write_data(chunk);
     };
     // Emit content in slices so no single SSE line exceeds a client's line-length
     // limit (e.g. aiohttp's 128 KiB) — a base64 image is far larger. Clients
@@ -905,8 +913,7 @@ void CollectionOrchestrator::chat_completion_stream(const json& request,
         }
     };
     auto send_done = [&]() {
-        const std::string done = "data: [DONE]\n\n";
-        sink.write(done.c_str(), done.size());
+        sse.write_done();
         sink.done();  // terminate the chunked transfer (final 0-length chunk)
     };
     auto send_error = [&](const std::string& message) {
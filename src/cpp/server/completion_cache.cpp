@@ -0,0 +1,188 @@
+#include "lemon/completion_cache.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <system_error>
+#include <vector>
+
+#include "lemon/utils/aixlog.hpp"
+#include "lemon/utils/path_utils.h"
+
+namespace fs = std::filesystem;
+
+namespace lemon {
+
+namespace {
+
+std::atomic<uint64_t> g_hits{0};
+std::atomic<uint64_t> g_misses{0};
+std::atomic<uint64_t> g_stores{0};
+std::atomic<uint64_t> g_expired{0};
+
+std::uint64_t fnv1a64(const std::string& text,
+                      std::uint64_t hash = 14695981039346656037ull) {
+    for (unsigned char c : text) {
+        hash ^= c;
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
+std::string to_hex(std::uint64_t value) {
+    char buf[17];
+    std::snprintf(buf, sizeof(buf), "%016llx",
+                  static_cast<unsigned long long>(value));
+    return std::string(buf);
+}
+
+int64_t now_epoch_s() {
+    return std::chrono::duration_cast<std::chrono::seconds>(
+               std::chrono::system_clock::now().time_since_epoch())
+        .count();
+}
+
+}  // namespace
+
+CompletionCache::CompletionCache(const std::string& cache_dir, int ttl_hours,
+                                 uint64_t max_bytes)
+    : dir_(cache_dir + "/completion-cache"),
+      ttl_hours_(ttl_hours),
+      max_bytes_(max_bytes) {}
+
+bool CompletionCache::cacheable(const nlohmann::json& request) {
+    if (!request.is_object() || request.value("stream", false)) {
+        return false;
+    }
+    auto it = request.find("temperature");
+    if (it == request.end() || !it->is_number()) {
+        return false;
+    }
+    return it->get<double>() == 0.0;
+}
+
+std::string CompletionCache::key_for(const std::string& endpoint,
+                                     const nlohmann::json& request,
+                                     const std::string& revision) {
+    // nlohmann keeps object keys sorted, so dump() is a canonical
+    // serialization of the full request.
+    const std::string canonical = endpoint + "\n" + revision + "\n" + request.dump();
+    // Two independent 64-bit passes give a 128-bit key so distinct requests
+    // can't realistically collide on the same file name.
+    return to_hex(fnv1a64(canonical)) +
+           to_hex(fnv1a64(canonical, fnv1a64("completion-cache")));
+}
+
+bool CompletionCache::lookup(const std::string& key, nlohmann::json& response) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::error_code ec;
+    const fs::path path = utils::path_from_utf8(dir_) / (key + ".json");
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        g_misses++;
+        return false;
+    }
+    nlohmann::json entry = nlohmann::json::parse(file, nullptr, false);
+    if (!entry.is_object() || !entry.contains("response")) {
+        fs::remove(path, ec);
+        g_misses++;
+        return false;
+    }
+    // TTL runs from creation, not last use, so an entry can't outlive its
+    // window just by being popular.
+    const int64_t created = entry.value("created", static_cast<int64_t>(0));
+    if (ttl_hours_ > 0 && now_epoch_s() - created > int64_t(ttl_hours_) * 3600) {
+        fs::remove(path, ec);
+        g_expired++;
+        g_misses++;
+        return false;
+    }
+    response = entry["response"];
+    fs::last_write_time(path, fs::file_time_type::clock::now(), ec);
+    g_hits++;
+    return true;
+}
+
+void CompletionCache::store(const std::string& key,
+                            const nlohmann::json& response) {
+    const std::string body =
+        nlohmann::json{{"created", now_epoch_s()}, {"response", response}}.dump();
+    if (body.size() > max_bytes_) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::error_code ec;
+    const fs::path dir = utils::path_from_utf8(dir_);
+    fs::create_directories(dir, ec);
+    const fs::path target = dir / (key + ".json");
+    const fs::path tmp = dir / (key + ".tmp");
+    {
+        std::ofstream file(tmp, std::ios::binary | std::ios::trunc);
+        if (!file) {
+            LOG(WARNING, "CompletionCache")
+                << "Failed to write cache entry under " << dir_ << std::endl;
+            return;
+        }
+        file.write(body.data(), static_cast<std::streamsize>(body.size()));
+        if (!file) {
+            file.close();
+            fs::remove(tmp, ec);
+            return;
+        }
+    }
+    fs::rename(tmp, target, ec);
+    if (ec) {
+        fs::remove(tmp, ec);
+        return;
+    }
+    g_stores++;
+    evict_to_fit();
+}
+
+void CompletionCache::evict_to_fit() {
+    struct Entry {
+        fs::file_time_type mtime;
+        uint64_t size;
+        fs::path path;
+    };
+    std::error_code ec;
+    std::vector<Entry> entries;
+    uint64_t total = 0;
+    for (const auto& entry :
+         fs::directory_iterator(utils::path_from_utf8(dir_), ec)) {
+        if (!entry.is_regular_file(ec)) {
+            continue;
+        }
+        const uint64_t size = entry.file_size(ec);
+        entries.push_back({entry.last_write_time(ec), size, entry.path()});
+        total += size;
+    }
+    if (total <= max_bytes_) {
+        return;
+    }
+    std::sort(entries.begin(), entries.end(),
+              [](const Entry& a, const Entry& b) { return a.mtime < b.mtime; });
+    for (const auto& entry : entries) {
+        if (total <= max_bytes_) {
+            break;
+        }
+        fs::remove(entry.path, ec);
+        if (!ec) {
+            total -= entry.size;
+        }
+    }
+}
+
+CompletionCache::Totals CompletionCache::totals() {
+    Totals t;
+    t.hits = g_hits.load();
+    t.misses = g_misses.load();
+    t.stores = g_stores.load();
+    t.expired = g_expired.load();
+    return t;
+}
+
+}  // namespace lemon
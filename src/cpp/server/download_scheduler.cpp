@@ -0,0 +1,56 @@
+#include "lemon/download_scheduler.h"
+#include "lemon/runtime_config.h"
+#include <ctime>
+
+namespace lemon {
+
+namespace {
+
+int local_minute_of_day() {
+    const std::time_t now = std::time(nullptr);
+    std::tm local{};
+#ifdef _WIN32
+    localtime_s(&local, &now);
+#else
+    localtime_r(&now, &local);
+#endif
+    return local.tm_hour * 60 + local.tm_min;
+}
+
+} // namespace
+
+bool DownloadScheduler::offhours_now() {
+    auto* cfg = RuntimeConfig::global();
+    if (!cfg) {
+        return false;
+    }
+    int start = 0, end = 0;
+    if (!parse_window(cfg->download_offhours(), start, end)) {
+        return false;
+    }
+    return in_window(local_minute_of_day(), start, end);
+}
+
+size_t DownloadScheduler::current_rate_limit_bytes_per_sec() {
+    auto* cfg = RuntimeConfig::global();
+    if (!cfg) {
+        return 0;
+    }
+    return effective_rate_bytes_per_sec(
+        cfg->download_rate_limit_mbps(),
+        cfg->download_offhours_rate_limit_mbps(), offhours_now());
+}
+
+bool DownloadScheduler::background_pulls_allowed_now() {
+    auto* cfg = RuntimeConfig::global();
+    if (!cfg) {
+        return true;
+    }
+    int start = 0, end = 0;
+    if (!parse_window(cfg->download_offhours(), start, end)) {
+        return true;
+    }
+    return in_window(local_minute_of_day(), start, end);
+}
+
+} // namespace lemon
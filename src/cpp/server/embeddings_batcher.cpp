@@ -0,0 +1,169 @@
+#include "lemon/embeddings_batcher.h"
+
+#include <chrono>
+#include <stdexcept>
+#include <lemon/utils/aixlog.hpp>
+
+namespace lemon {
+
+EmbeddingsBatcher::EmbeddingsBatcher(size_t max_batch_texts, int batch_window_ms)
+    : max_batch_texts_(max_batch_texts), batch_window_ms_(batch_window_ms) {}
+
+std::string EmbeddingsBatcher::batch_key(const json& request) {
+    // Requests are only mergeable when every field that shapes the backend
+    // output matches; the key captures those fields.
+    json key = json::object();
+    for (const char* field : {"model", "encoding_format", "dimensions", "user"}) {
+        if (request.contains(field)) {
+            key[field] = request[field];
+        }
+    }
+    return key.dump();
+}
+
+bool EmbeddingsBatcher::extract_inputs(const json& request, std::vector<std::string>& out) {
+    if (!request.contains("input")) {
+        return false;
+    }
+    const json& input = request["input"];
+    if (input.is_string()) {
+        out.push_back(input.get<std::string>());
+        return true;
+    }
+    if (input.is_array()) {
+        for (const auto& item : input) {
+            if (!item.is_string()) {
+                return false;
+            }
+            out.push_back(item.get<std::string>());
+        }
+        return !out.empty();
+    }
+    return false;
+}
+
+json EmbeddingsBatcher::embeddings(const json& request, const BackendCall& call) {
+    std::vector<std::string> inputs;
+    if (batch_window_ms_ <= 0 || !extract_inputs(request, inputs) ||
+        inputs.size() >= max_batch_texts_) {
+        return call(request);
+    }
+
+    auto pending = std::make_shared<PendingRequest>();
+    pending->inputs = std::move(inputs);
+
+    const std::string key = batch_key(request);
+    std::unique_lock<std::mutex> lock(mutex_);
+    auto it = batches_.find(key);
+    std::shared_ptr<Batch> batch;
+    bool is_leader = false;
+    if (it == batches_.end() || it->second->leader_running ||
+        it->second->total_texts + pending->inputs.size() > max_batch_texts_) {
+        batch = std::make_shared<Batch>();
+        batches_[key] = batch;
+        is_leader = true;
+    } else {
+        batch = it->second;
+    }
+    batch->members.push_back(pending);
+    batch->total_texts += pending->inputs.size();
+
+    if (is_leader) {
+        batch->cond.wait_for(lock, std::chrono::milliseconds(batch_window_ms_),
+                             [&] { return batch->total_texts >= max_batch_texts_; });
+        batch->leader_running = true;
+        if (batches_.count(key) && batches_[key] == batch) {
+            batches_.erase(key);
+        }
+        run_batch(key, batch, request, call, lock);
+        batch->cond.notify_all();
+    } else {
+        if (batch->total_texts >= max_batch_texts_) {
+            batch->cond.notify_all();
+        }
+        batch->cond.wait(lock, [&] { return pending->done; });
+    }
+
+    if (!pending->error.empty()) {
+        throw std::runtime_error(pending->error);
+    }
+    return pending->result;
+}
+
+void EmbeddingsBatcher::run_batch(const std::string& /*key*/, std::shared_ptr<Batch> batch,
+                                  const json& request_template, const BackendCall& call,
+                                  std::unique_lock<std::mutex>& lock) {
+    json merged = request_template;
+    json merged_input = json::array();
+    for (const auto& member : batch->members) {
+        for (const auto& text : member->inputs) {
+            merged_input.push_back(text);
+        }
+    }
+    merged["input"] = merged_input;
+
+    const size_t batch_size = batch->members.size();
+    const size_t total_texts = batch->total_texts;
+
+    json response;
+    std::string error;
+    lock.unlock();
+    try {
+        if (batch_size > 1) {
+            LOG(DEBUG, "EmbeddingsBatcher")
+                << "Coalesced " << batch_size << " requests (" << total_texts
+                << " texts) into one backend call" << std::endl;
+        }
+        response = call(merged);
+    } catch (const std::exception& e) {
+        error = e.what();
+    }
+    lock.lock();
+
+    if (!error.empty() || !response.contains("data") || !response["data"].is_array() ||
+        response["data"].size() != total_texts) {
+        if (error.empty()) {
+            error = "embeddings backend returned " +
+                    std::to_string(response.contains("data") && response["data"].is_array()
+                                       ? response["data"].size() : 0) +
+                    " results for " + std::to_string(total_texts) + " inputs";
+        }
+        for (auto& member : batch->members) {
+            member->error = error;
+            member->done = true;
+        }
+        return;
+    }
+
+    int prompt_tokens = 0;
+    int total_tokens = 0;
+    if (response.contains("usage") && response["usage"].is_object()) {
+        prompt_tokens = response["usage"].value("prompt_tokens", 0);
+        total_tokens = response["usage"].value("total_tokens", 0);
+    }
+
+    size_t offset = 0;
+    for (auto& member : batch->members) {
+        json data = json::array();
+        for (size_t i = 0; i < member->inputs.size(); i++) {
+            json entry = response["data"][offset + i];
+            entry["index"] = static_cast<int>(i);
+            data.push_back(std::move(entry));
+        }
+        offset += member->inputs.size();
+
+        json result = response;
+        result["data"] = std::move(data);
+        if (total_texts > 0) {
+            const double share = static_cast<double>(member->inputs.size()) / total_texts;
+            result["usage"] = {
+                {"prompt_tokens", static_cast<int>(prompt_tokens * share)},
+                {"total_tokens", static_cast<int>(total_tokens * share)}
+            };
+        }
+        member->result = std::move(result);
+        member->done = true;
+    }
+}
+
+} // namespace lemon
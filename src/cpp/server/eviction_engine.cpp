@@ -54,6 +54,7 @@ void EvictionEngine::evaluation_loop() {
 void EvictionEngine::evaluate_servers(double current_vram_pct) {
     std::string model_to_evict;
     std::vector<std::string> models_to_downsize;
+    std::vector<std::string> models_to_hibernate;
 
     {
         std::lock_guard<std::mutex> lock(router_->load_mutex_);
@@ -73,8 +74,8 @@ void EvictionEngine::evaluate_servers(double current_vram_pct) {
             WrappedServer* server = server_ptr.get();
             if (!server) continue;
 
-            // Pinned models must never be auto-evicted or downsized
-            if (server->is_pinned()) continue;
+            // Pinned and reserved models must never be auto-evicted or downsized
+            if (server->is_pinned() || server->is_reserved()) continue;
 
             // Check auto_evict config
             bool auto_evict = RuntimeConfig::global()->auto_evict();
@@ -86,12 +87,16 @@ void EvictionEngine::evaluate_servers(double current_vram_pct) {
             if (!auto_evict) continue;
 
             long evict_timeout_sec = 300;
+            long hibernate_timeout_sec = 180;
             long downsize_timeout_sec = 60;
             double weight_factor = 1.0;
 
             if (recipe_opts.contains("evict_idle_timeout") && recipe_opts["evict_idle_timeout"].is_number_integer()) {
                 evict_timeout_sec = recipe_opts["evict_idle_timeout"].get<long>();
             }
+            if (recipe_opts.contains("hibernate_idle_timeout") && recipe_opts["hibernate_idle_timeout"].is_number_integer()) {
+                hibernate_timeout_sec = recipe_opts["hibernate_idle_timeout"].get<long>();
+            }
             if (recipe_opts.contains("downsize_idle_timeout") && recipe_opts["downsize_idle_timeout"].is_number_integer()) {
                 downsize_timeout_sec = recipe_opts["downsize_idle_timeout"].get<long>();
             }
@@ -123,15 +128,24 @@ void EvictionEngine::evaluate_servers(double current_vram_pct) {
                 break;
             }
 
-            // 2. Time-based soft idle (downsize) — collect the candidate only. The
+            // 2. Time-based deep idle (hibernate) — between downsize and evict.
+            // Collect the candidate only; try_begin_hibernate() below atomically
+            // re-checks idleness and transitions it to HIBERNATING.
+            if (idle_ms >= hibernate_timeout_sec * 1000 &&
+                (state == ModelState::READY || state == ModelState::DOWNSIZED)) {
+                LOG(INFO) << "Model " << server->get_model_name() << " reached hibernate idle timeout (" << hibernate_timeout_sec << "s). Marking for hibernation." << std::endl;
+                models_to_hibernate.push_back(server->get_model_name());
+            }
+
+            // 3. Time-based soft idle (downsize) — collect the candidate only. The
             // model is not claimed here; try_begin_downsize() below atomically
             // re-checks that it is still idle and transitions it to DOWNSIZING.
-            if (idle_ms >= downsize_timeout_sec * 1000 && state == ModelState::READY) {
+            else if (idle_ms >= downsize_timeout_sec * 1000 && state == ModelState::READY) {
                 LOG(INFO) << "Model " << server->get_model_name() << " reached downsize idle timeout (" << downsize_timeout_sec << "s). Marking for downsize." << std::endl;
                 models_to_downsize.push_back(server->get_model_name());
             }
 
-            // 3. VRAM Pressure tracking
+            // 4. VRAM Pressure tracking
             if (pressure_evict && state != ModelState::EVICTING && state != ModelState::UNLOADED && state != ModelState::IN_USE) {
                 if (eviction_score > highest_eviction_score) {
                     highest_eviction_score = eviction_score;
@@ -173,6 +187,29 @@ void EvictionEngine::evaluate_servers(double current_vram_pct) {
         }
     }
 
+    // Hibernations follow the same owned-maintenance protocol as downsizes:
+    // try_begin_hibernate() claims the idle model under the router lock, and
+    // the matching finish_hibernate() releases the guard and records the
+    // resulting state.
+    for (const auto& name : models_to_hibernate) {
+        WrappedServer* s = nullptr;
+        {
+            std::lock_guard<std::mutex> lk(router_->load_mutex_);
+            if (router_->exclusive_active_) break;
+            s = router_->find_server_by_model_name(name);
+            if (!s || !s->try_begin_hibernate()) {
+                continue;  // gone, busy, or no longer idle since phase 1
+            }
+        }
+        bool ok = s->hibernate();
+        s->finish_hibernate(ok);
+        if (ok) {
+            LOG(INFO) << "Model " << name << " hibernated." << std::endl;
+        } else {
+            LOG(WARNING) << "Hibernate of " << name << " failed; left resident." << std::endl;
+        }
+    }
+
     if (!model_to_evict.empty()) {
         // Race-safe: only unloads if the model hasn't been rescued by an
         // in-flight request since we marked it EVICTING above.
@@ -0,0 +1,276 @@
+#include "lemon/gguf_metadata_cache.h"
+
+#include <algorithm>
+#include <atomic>
+#include <fstream>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+#include <nlohmann/json.hpp>
+
+#include "lemon/utils/aixlog.hpp"
+#include "lemon/utils/path_utils.h"
+
+namespace fs = std::filesystem;
+
+namespace lemon {
+
+namespace {
+
+std::int64_t file_mtime(const fs::path& path) {
+    std::error_code ec;
+    const auto mtime = fs::last_write_time(path, ec);
+    return ec ? 0 : static_cast<std::int64_t>(mtime.time_since_epoch().count());
+}
+
+nlohmann::json metadata_to_json(const GgufMetadata& m) {
+    return {
+        {"architecture", m.architecture},
+        {"context_length", m.context_length},
+        {"block_count", m.block_count},
+        {"embedding_length", m.embedding_length},
+        {"head_count_kv", m.head_count_kv},
+        {"key_length", m.key_length},
+        {"key_length_swa", m.key_length_swa},
+        {"swa_layer_count", m.swa_layer_count},
+        {"full_attention_interval", m.full_attention_interval},
+        {"vision", m.caps.vision},
+        {"tool_calling", m.caps.tool_calling},
+        {"mtp", m.caps.mtp},
+        {"head_count_kv_per_layer", m.head_count_kv_per_layer},
+        {"sliding_window_pattern", m.sliding_window_pattern},
+    };
+}
+
+GgufMetadata metadata_from_json(const nlohmann::json& j) {
+    GgufMetadata m;
+    m.architecture = j.value("architecture", std::string());
+    m.context_length = j.value("context_length", int64_t(0));
+    m.block_count = j.value("block_count", int64_t(0));
+    m.embedding_length = j.value("embedding_length", int64_t(0));
+    m.head_count_kv = j.value("head_count_kv", int64_t(0));
+    m.key_length = j.value("key_length", int64_t(0));
+    m.key_length_swa = j.value("key_length_swa", int64_t(0));
+    m.swa_layer_count = j.value("swa_layer_count", int64_t(0));
+    m.full_attention_interval = j.value("full_attention_interval", int64_t(0));
+    m.caps.vision = j.value("vision", false);
+    m.caps.tool_calling = j.value("tool_calling", false);
+    m.caps.mtp = j.value("mtp", false);
+    if (j.contains("head_count_kv_per_layer")) {
+        m.head_count_kv_per_layer =
+            j["head_count_kv_per_layer"].get<std::vector<int64_t>>();
+    }
+    if (j.contains("sliding_window_pattern")) {
+        m.sliding_window_pattern =
+            j["sliding_window_pattern"].get<std::vector<bool>>();
+    }
+    return m;
+}
+
+}  // namespace
+
+GgufMetadataCache& GgufMetadataCache::global() {
+    static GgufMetadataCache instance(
+        utils::path_from_utf8(utils::get_cache_dir() + "/gguf_metadata_cache.json"));
+    return instance;
+}
+
+GgufMetadataCache::GgufMetadataCache(const fs::path& manifest_path)
+    : manifest_path_(manifest_path) {}
+
+void GgufMetadataCache::load_locked() {
+    if (loaded_) {
+        return;
+    }
+    loaded_ = true;
+
+    std::ifstream file(manifest_path_);
+    if (!file.is_open()) {
+        return;
+    }
+    try {
+        const auto manifest = nlohmann::json::parse(file);
+        const auto json_entries = manifest.value("entries", nlohmann::json::object());
+        for (const auto& [path, entry] : json_entries.items()) {
+            if (entry.contains("mtime") && entry.contains("size") &&
+                entry.contains("metadata")) {
+                entries_[path] = {entry["mtime"].get<std::int64_t>(),
+                                  entry["size"].get<std::uint64_t>(),
+                                  metadata_from_json(entry["metadata"])};
+            }
+        }
+    } catch (const std::exception& e) {
+        LOG(WARNING, "GgufMetadataCache") << "Discarding unreadable metadata cache "
+                                          << utils::path_to_utf8(manifest_path_)
+                                          << ": " << e.what() << std::endl;
+        entries_.clear();
+        dirty_ = true;
+    }
+}
+
+bool GgufMetadataCache::read(GgufMetadata& out, const std::string& path) {
+    const fs::path fs_path = utils::path_from_utf8(path);
+    std::error_code ec;
+    const auto size = fs::file_size(fs_path, ec);
+    if (ec) {
+        return false;
+    }
+    const std::int64_t mtime = file_mtime(fs_path);
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        load_locked();
+        auto it = entries_.find(path);
+        if (it != entries_.end() && it->second.mtime == mtime &&
+            it->second.size == size) {
+            out = it->second.metadata;
+            return true;
+        }
+    }
+
+    GgufMetadata parsed;
+    if (!read_gguf_metadata(parsed, path)) {
+        return false;
+    }
+    out = parsed;
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    entries_[path] = {mtime, static_cast<std::uint64_t>(size), std::move(parsed)};
+    dirty_ = true;
+    save_locked();
+    return true;
+}
+
+int GgufMetadataCache::refresh_directory(const std::string& dir) {
+    const fs::path fs_dir = utils::path_from_utf8(dir);
+    std::error_code ec;
+    if (!fs::is_directory(fs_dir, ec)) {
+        return 0;
+    }
+
+    struct OnDisk {
+        std::int64_t mtime;
+        std::uint64_t size;
+    };
+    std::map<std::string, OnDisk> on_disk;
+    for (auto it = fs::recursive_directory_iterator(
+             fs_dir, fs::directory_options::skip_permission_denied, ec);
+         !ec && it != fs::recursive_directory_iterator(); it.increment(ec)) {
+        if (!it->is_regular_file(ec)) {
+            continue;
+        }
+        const std::string name = utils::path_to_utf8(it->path().filename());
+        if (!gguf_reader_detail::ends_with_ignore_case(name, ".gguf")) {
+            continue;
+        }
+        const auto size = it->file_size(ec);
+        if (ec) {
+            continue;
+        }
+        on_disk[utils::path_to_utf8(it->path())] = {file_mtime(it->path()),
+                                                    static_cast<std::uint64_t>(size)};
+    }
+
+    std::vector<std::string> stale;
+    int changed = 0;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        load_locked();
+        for (const auto& [path, disk] : on_disk) {
+            auto it = entries_.find(path);
+            if (it == entries_.end() || it->second.mtime != disk.mtime ||
+                it->second.size != disk.size) {
+                stale.push_back(path);
+            }
+        }
+        const std::string prefix = utils::path_to_utf8(fs_dir);
+        for (auto it = entries_.begin(); it != entries_.end();) {
+            if (it->first.compare(0, prefix.size(), prefix) == 0 &&
+                on_disk.find(it->first) == on_disk.end()) {
+                it = entries_.erase(it);
+                dirty_ = true;
+                ++changed;
+            } else {
+                ++it;
+            }
+        }
+    }
+
+    // Parse outside the lock — header reads can take seconds on network
+    // storage and read() must stay responsive for other files meanwhile.
+    // Workers oversubscribe the cores because each one spends most of its
+    // time blocked on I/O; bulk refresh is then bounded by the slowest
+    // single header read rather than the sum of them.
+    if (!stale.empty()) {
+        const size_t worker_count = (std::min)(
+            {stale.size(),
+             static_cast<size_t>(16),
+             (std::max)(static_cast<size_t>(4),
+                        static_cast<size_t>(std::thread::hardware_concurrency()) * 2)});
+        std::atomic<size_t> next_index{0};
+        std::atomic<int> parsed_count{0};
+        std::vector<std::thread> workers;
+        workers.reserve(worker_count);
+        for (size_t w = 0; w < worker_count; ++w) {
+            workers.emplace_back([&] {
+                for (size_t i = next_index.fetch_add(1); i < stale.size();
+                     i = next_index.fetch_add(1)) {
+                    const std::string& path = stale[i];
+                    GgufMetadata parsed;
+                    if (!read_gguf_metadata(parsed, path)) {
+                        continue;
+                    }
+                    std::lock_guard<std::mutex> lock(mutex_);
+                    const auto& disk = on_disk.find(path)->second;
+                    entries_[path] = {disk.mtime, disk.size, std::move(parsed)};
+                    dirty_ = true;
+                    ++parsed_count;
+                }
+            });
+        }
+        for (auto& worker : workers) {
+            worker.join();
+        }
+        changed += parsed_count.load();
+    }
+
+    if (changed > 0) {
+        save();
+    }
+    return changed;
+}
+
+void GgufMetadataCache::save() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    save_locked();
+}
+
+void GgufMetadataCache::save_locked() {
+    if (!loaded_ || !dirty_) {
+        return;
+    }
+
+    nlohmann::json manifest;
+    manifest["version"] = 1;
+    auto& json_entries = manifest["entries"] = nlohmann::json::object();
+    for (const auto& [path, entry] : entries_) {
+        json_entries[path] = {{"mtime", entry.mtime},
+                              {"size", entry.size},
+                              {"metadata", metadata_to_json(entry.metadata)}};
+    }
+
+    std::error_code ec;
+    fs::create_directories(manifest_path_.parent_path(), ec);
+    std::ofstream file(manifest_path_, std::ios::trunc);
+    if (!file.is_open()) {
+        LOG(WARNING, "GgufMetadataCache") << "Failed to write metadata cache "
+                                          << utils::path_to_utf8(manifest_path_)
+                                          << std::endl;
+        return;
+    }
+    file << manifest.dump(2);
+    dirty_ = false;
+}
+
+}  // namespace lemon
@@ -32,6 +32,10 @@ void GlobalVramMonitor::set_pressure_callback(VramPressureCallback callback) {
     pressure_callback_ = callback;
 }
 
+std::vector<SystemInfo::GpuMemoryDevice> GlobalVramMonitor::per_device_memory() const {
+    return SystemInfo::get_gpu_memory_per_device();
+}
+
 double GlobalVramMonitor::poll_vram_usage() const {
     // Delegate to the shared cross-vendor detection in SystemInfo so we don't
     // duplicate (or drift from) the platform VRAM logic.
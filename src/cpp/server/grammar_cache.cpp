@@ -0,0 +1,315 @@
+#include "lemon/grammar_cache.h"
+
+#include <algorithm>
+#include <atomic>
+#include <set>
+#include <sstream>
+#include <vector>
+
+namespace lemon {
+
+namespace {
+
+std::atomic<uint64_t> g_hits{0};
+std::atomic<uint64_t> g_compiles{0};
+std::atomic<uint64_t> g_unsupported{0};
+
+// Primitive rule bodies mirroring llama.cpp's json.gbnf, so the generated
+// grammar constrains exactly the JSON the backend's own compiler would allow.
+const std::pair<const char*, const char*> kPrimitiveRules[] = {
+    {"string",
+     "\"\\\"\" ( [^\"\\\\\\x7F\\x00-\\x1F] | \"\\\\\" ([\"\\\\bfnrt] | \"u\" "
+     "[0-9a-fA-F] [0-9a-fA-F] [0-9a-fA-F] [0-9a-fA-F]) )* \"\\\"\" ws"},
+    {"number",
+     "(\"-\"? ([0-9] | [1-9] [0-9]*)) (\".\" [0-9]+)? ([eE] [-+]? [0-9]+)? ws"},
+    {"integer", "(\"-\"? ([0-9] | [1-9] [0-9]*)) ws"},
+    {"boolean", "(\"true\" | \"false\") ws"},
+    {"null", "\"null\" ws"},
+    {"value", "object | array | string | number | boolean | null"},
+    {"object",
+     "\"{\" ws ( string \":\" ws value (\",\" ws string \":\" ws value)* )? \"}\" ws"},
+    {"array", "\"[\" ws ( value (\",\" ws value)* )? \"]\" ws"},
+    {"ws", "([ \\t\\n] ws)?"},
+};
+
+class Compiler {
+public:
+    std::optional<std::string> run(const nlohmann::json& schema) {
+        std::string root = visit(schema);
+        if (!ok_) {
+            return std::nullopt;
+        }
+
+        std::ostringstream out;
+        out << "root ::= " << root << "\n";
+        for (const auto& [name, body] : rules_) {
+            out << name << " ::= " << body << "\n";
+        }
+        // "value"/"object"/"array" are mutually recursive with the other
+        // primitives, so pulling in one pulls in them all.
+        if (used_.count("value") || used_.count("object") || used_.count("array")) {
+            for (const auto& [name, _] : kPrimitiveRules) {
+                used_.insert(name);
+            }
+        }
+        for (const auto& [name, body] : kPrimitiveRules) {
+            if (used_.count(name)) {
+                out << name << " ::= " << body << "\n";
+            }
+        }
+        return out.str();
+    }
+
+private:
+    std::string primitive(const char* name) {
+        used_.insert(name);
+        used_.insert("ws");
+        return name;
+    }
+
+    std::string define(const std::string& body) {
+        std::string name = "rule" + std::to_string(counter_++);
+        rules_.emplace_back(name, body);
+        used_.insert("ws");
+        return name;
+    }
+
+    std::string fail() {
+        ok_ = false;
+        return "";
+    }
+
+    // GBNF literal matching the exact JSON text of `value`, followed by ws.
+    std::string literal(const nlohmann::json& value) {
+        const std::string dumped = value.dump();
+        std::string escaped;
+        for (unsigned char c : dumped) {
+            if (c < 0x20 || c >= 0x7F) {
+                // Non-ASCII / control characters would need grammar escapes
+                // with parser-version-dependent syntax; punt to the backend.
+                return fail();
+            }
+            if (c == '"' || c == '\\') {
+                escaped.push_back('\\');
+            }
+            escaped.push_back(static_cast<char>(c));
+        }
+        used_.insert("ws");
+        return "\"" + escaped + "\" ws";
+    }
+
+    bool keys_supported(const nlohmann::json& node) {
+        static const std::set<std::string> kKnown = {
+            "type", "enum", "const", "properties", "required", "items",
+            "additionalProperties", "anyOf",
+            "description", "title", "default", "$schema"
+        };
+        for (const auto& [key, _] : node.items()) {
+            if (kKnown.count(key) == 0) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    std::string visit_type(const nlohmann::json& node, const std::string& type) {
+        if (type == "string") return primitive("string");
+        if (type == "number") return primitive("number");
+        if (type == "integer") return primitive("integer");
+        if (type == "boolean") return primitive("boolean");
+        if (type == "null") return primitive("null");
+        if (type == "object") return visit_object(node);
+        if (type == "array") return visit_array(node);
+        return fail();
+    }
+
+    std::string visit_object(const nlohmann::json& node) {
+        const bool closed = node.contains("additionalProperties") &&
+                            node["additionalProperties"].is_boolean() &&
+                            !node["additionalProperties"].get<bool>();
+        if (node.contains("additionalProperties") && !closed) {
+            return fail();
+        }
+
+        if (!node.contains("properties") || !node["properties"].is_object() ||
+            node["properties"].empty()) {
+            if (closed) {
+                return define("\"{\" ws \"}\" ws");
+            }
+            return primitive("object");
+        }
+
+        // Only the strict shape — every declared property required — has an
+        // unambiguous fixed layout; optional properties need the alternation
+        // expansion the backend compiler already handles.
+        std::set<std::string> required;
+        if (node.contains("required") && node["required"].is_array()) {
+            for (const auto& name : node["required"]) {
+                if (!name.is_string()) return fail();
+                required.insert(name.get<std::string>());
+            }
+        }
+        for (const auto& [name, _] : node["properties"].items()) {
+            if (required.erase(name) == 0) {
+                return fail();
+            }
+        }
+        if (!required.empty()) {
+            return fail();
+        }
+
+        std::ostringstream body;
+        body << "\"{\" ws ";
+        bool first = true;
+        for (const auto& [name, child] : node["properties"].items()) {
+            std::string key = literal(nlohmann::json(name));
+            std::string value = visit(child);
+            if (!ok_) return "";
+            if (!first) {
+                body << "\",\" ws ";
+            }
+            body << key << "\":\" ws " << value << " ";
+            first = false;
+        }
+        body << "\"}\" ws";
+        return define(body.str());
+    }
+
+    std::string visit_array(const nlohmann::json& node) {
+        if (!node.contains("items")) {
+            return primitive("array");
+        }
+        if (!node["items"].is_object()) {
+            return fail();
+        }
+        std::string item = visit(node["items"]);
+        if (!ok_) return "";
+        return define("\"[\" ws ( " + item + " (\",\" ws " + item + ")* )? \"]\" ws");
+    }
+
+    std::string visit(const nlohmann::json& node) {
+        if (!node.is_object() || !keys_supported(node)) {
+            return fail();
+        }
+
+        if (node.contains("const")) {
+            return define(literal(node["const"]));
+        }
+        if (node.contains("enum")) {
+            if (!node["enum"].is_array() || node["enum"].empty()) {
+                return fail();
+            }
+            std::ostringstream body;
+            bool first = true;
+            for (const auto& value : node["enum"]) {
+                std::string lit = literal(value);
+                if (!ok_) return "";
+                if (!first) body << " | ";
+                body << lit;
+                first = false;
+            }
+            return define(body.str());
+        }
+        if (node.contains("anyOf")) {
+            if (!node["anyOf"].is_array() || node["anyOf"].empty()) {
+                return fail();
+            }
+            std::ostringstream body;
+            bool first = true;
+            for (const auto& option : node["anyOf"]) {
+                std::string ref = visit(option);
+                if (!ok_) return "";
+                if (!first) body << " | ";
+                body << ref;
+                first = false;
+            }
+            return define(body.str());
+        }
+
+        if (!node.contains("type")) {
+            return primitive("value");
+        }
+        if (node["type"].is_string()) {
+            return visit_type(node, node["type"].get<std::string>());
+        }
+        if (node["type"].is_array() && !node["type"].empty()) {
+            std::ostringstream body;
+            bool first = true;
+            for (const auto& type : node["type"]) {
+                if (!type.is_string()) return fail();
+                std::string ref = visit_type(node, type.get<std::string>());
+                if (!ok_) return "";
+                if (!first) body << " | ";
+                body << ref;
+                first = false;
+            }
+            return define(body.str());
+        }
+        return fail();
+    }
+
+    std::vector<std::pair<std::string, std::string>> rules_;
+    std::set<std::string> used_;
+    int counter_ = 0;
+    bool ok_ = true;
+};
+
+} // namespace
+
+GrammarCache& GrammarCache::instance() {
+    static GrammarCache cache;
+    return cache;
+}
+
+std::optional<std::string> GrammarCache::compile(const nlohmann::json& schema) {
+    return Compiler().run(schema);
+}
+
+std::optional<std::string> GrammarCache::grammar_for(const nlohmann::json& schema) {
+    const std::string key = schema.dump();
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = entries_.find(key);
+    if (it != entries_.end()) {
+        it->second.last_used = ++use_counter_;
+        g_hits.fetch_add(1, std::memory_order_relaxed);
+        return it->second.grammar;
+    }
+
+    std::optional<std::string> grammar = compile(schema);
+    if (grammar) {
+        g_compiles.fetch_add(1, std::memory_order_relaxed);
+    } else {
+        g_unsupported.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    while (entries_.size() >= kMaxEntries) {
+        auto victim = entries_.begin();
+        for (auto e = entries_.begin(); e != entries_.end(); ++e) {
+            if (e->second.last_used < victim->second.last_used) {
+                victim = e;
+            }
+        }
+        entries_.erase(victim);
+    }
+
+    Entry& entry = entries_[key];
+    entry.grammar = grammar;
+    entry.last_used = ++use_counter_;
+    return grammar;
+}
+
+size_t GrammarCache::size() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return entries_.size();
+}
+
+GrammarCache::Stats GrammarCache::totals() {
+    Stats stats;
+    stats.hits = g_hits.load(std::memory_order_relaxed);
+    stats.compiles = g_compiles.load(std::memory_order_relaxed);
+    stats.unsupported = g_unsupported.load(std::memory_order_relaxed);
+    return stats;
+}
+
+} // namespace lemon
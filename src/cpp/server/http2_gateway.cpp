@@ -0,0 +1,534 @@
+#include "lemon/http2_gateway.h"
+#include "lemon/utils/process_manager.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+#include <httplib.h>
+
+#include <lemon/utils/aixlog.hpp>
+
+namespace lemon {
+
+namespace {
+
+static struct lws_protocols gateway_protocols[] = {
+    {"lemonade-h2-gateway", Http2Gateway::http_callback, sizeof(PerStreamData), 0, 0, nullptr, 0},
+    LWS_PROTOCOL_LIST_TERM
+};
+
+// Request bodies are buffered before forwarding; bound them so one stream
+// cannot balloon lemond's memory (multipart audio/image uploads stay well
+// under this).
+constexpr size_t kMaxRequestBodyBytes = 128ull * 1024 * 1024;
+
+constexpr size_t kWriteChunkBytes = 16384;
+
+std::string copy_header(struct lws* wsi, enum lws_token_indexes token) {
+    const int len = lws_hdr_total_length(wsi, token);
+    if (len <= 0) {
+        return "";
+    }
+    std::vector<char> buf(static_cast<size_t>(len) + 1, '\0');
+    if (lws_hdr_copy(wsi, buf.data(), static_cast<int>(buf.size()), token) < 0) {
+        return "";
+    }
+    return std::string(buf.data());
+}
+
+// Custom (non-tokenized) header names libwebsockets stores by name; these are
+// the ones the handler layer actually inspects.
+std::string copy_custom_header(struct lws* wsi, const char* name_with_colon) {
+    const int name_len = static_cast<int>(std::strlen(name_with_colon));
+    const int len = lws_hdr_custom_length(wsi, name_with_colon, name_len);
+    if (len <= 0) {
+        return "";
+    }
+    std::vector<char> buf(static_cast<size_t>(len) + 1, '\0');
+    if (lws_hdr_custom_copy(wsi, buf.data(), static_cast<int>(buf.size()),
+                            name_with_colon, name_len) < 0) {
+        return "";
+    }
+    return std::string(buf.data());
+}
+
+std::string detect_method(struct lws* wsi) {
+    // h2 carries the method as the :method pseudo-header; h1 encodes it in
+    // which URI token is populated.
+    const std::string h2_method = copy_header(wsi, WSI_TOKEN_HTTP_COLON_METHOD);
+    if (!h2_method.empty()) {
+        return h2_method;
+    }
+    static const std::pair<enum lws_token_indexes, const char*> kMethodTokens[] = {
+        {WSI_TOKEN_GET_URI, "GET"},
+        {WSI_TOKEN_POST_URI, "POST"},
+        {WSI_TOKEN_PUT_URI, "PUT"},
+        {WSI_TOKEN_DELETE_URI, "DELETE"},
+        {WSI_TOKEN_PATCH_URI, "PATCH"},
+        {WSI_TOKEN_OPTIONS_URI, "OPTIONS"},
+        {WSI_TOKEN_HEAD_URI, "HEAD"},
+    };
+    for (const auto& [token, name] : kMethodTokens) {
+        if (lws_hdr_total_length(wsi, token) > 0) {
+            return name;
+        }
+    }
+    return "GET";
+}
+
+bool method_may_have_body(const std::string& method) {
+    return method == "POST" || method == "PUT" || method == "PATCH";
+}
+
+// Hop-by-hop and framing headers are owned by each leg of the proxy; the
+// gateway re-frames the response itself (h2 data frames or h1 chunking).
+bool is_forwardable_response_header(const std::string& lower_name) {
+    return lower_name != "content-length" && lower_name != "content-type" &&
+           lower_name != "transfer-encoding" && lower_name != "content-encoding" &&
+           lower_name != "connection" && lower_name != "keep-alive" &&
+           lower_name != "upgrade";
+}
+
+std::string to_lower(std::string s) {
+    std::transform(s.begin(), s.end(), s.begin(),
+                   [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+    return s;
+}
+
+} // namespace
+
+Http2Gateway::Http2Gateway(const std::string& host, int requested_port, int upstream_port)
+    : port_(requested_port > 0 ? requested_port : utils::ProcessManager::find_free_port(9100)),
+      host_(host),
+      upstream_port_(upstream_port),
+      service_handle_(std::make_shared<ServiceHandle>()) {
+    LOG(INFO, "Http2Gateway") << "Configured port: " << port_ << std::endl;
+}
+
+Http2Gateway::~Http2Gateway() {
+    stop();
+}
+
+int Http2Gateway::http_callback(struct lws* wsi,
+                                enum lws_callback_reasons reason,
+                                void* user,
+                                void* in,
+                                size_t len) {
+    struct lws_context* ctx = lws_get_context(wsi);
+    if (!ctx) {
+        return 0;
+    }
+
+    auto* gateway = static_cast<Http2Gateway*>(lws_context_user(ctx));
+    if (!gateway) {
+        return 0;
+    }
+
+    auto* pss = static_cast<PerStreamData*>(user);
+
+    switch (reason) {
+        case LWS_CALLBACK_HTTP:
+            return gateway->handle_request(wsi, pss, static_cast<const char*>(in));
+
+        case LWS_CALLBACK_HTTP_BODY:
+            return gateway->handle_body(pss, static_cast<const char*>(in), len);
+
+        case LWS_CALLBACK_HTTP_BODY_COMPLETION:
+            gateway->handle_body_completion(pss->stream_id);
+            return 0;
+
+        case LWS_CALLBACK_HTTP_WRITEABLE:
+            return gateway->handle_writable(pss->stream_id, wsi);
+
+        case LWS_CALLBACK_CLOSED_HTTP:
+            if (pss) {
+                gateway->handle_close(pss->stream_id);
+            }
+            return 0;
+
+        default:
+            return 0;
+    }
+}
+
+int Http2Gateway::handle_request(struct lws* wsi, PerStreamData* pss, const char* uri_path) {
+    auto state = std::make_shared<StreamState>();
+    state->method = detect_method(wsi);
+    state->target = uri_path ? uri_path : "/";
+
+    const std::string args = copy_header(wsi, WSI_TOKEN_HTTP_URI_ARGS);
+    if (!args.empty()) {
+        state->target += "?" + args;
+    }
+
+    static const std::pair<enum lws_token_indexes, const char*> kForwardTokens[] = {
+        {WSI_TOKEN_HTTP_AUTHORIZATION, "Authorization"},
+        {WSI_TOKEN_HTTP_CONTENT_TYPE, "Content-Type"},
+        {WSI_TOKEN_HTTP_ACCEPT, "Accept"},
+        {WSI_TOKEN_ORIGIN, "Origin"},
+    };
+    for (const auto& [token, name] : kForwardTokens) {
+        const std::string value = copy_header(wsi, token);
+        if (!value.empty()) {
+            state->request_headers.emplace(name, value);
+        }
+    }
+    static const std::pair<const char*, const char*> kForwardCustom[] = {
+        {"x-lemonade-priority:", "X-Lemonade-Priority"},
+        {"anthropic-version:", "Anthropic-Version"},
+        {"mcp-session-id:", "Mcp-Session-Id"},
+        {"last-event-id:", "Last-Event-ID"},
+    };
+    for (const auto& [custom_name, name] : kForwardCustom) {
+        const std::string value = copy_custom_header(wsi, custom_name);
+        if (!value.empty()) {
+            state->request_headers.emplace(name, value);
+        }
+    }
+
+    const uint64_t id = next_stream_id_.fetch_add(1);
+    std::snprintf(pss->stream_id, sizeof(pss->stream_id), "%llu",
+                  static_cast<unsigned long long>(id));
+
+    {
+        std::lock_guard<std::mutex> lock(streams_mutex_);
+        streams_[pss->stream_id] = state;
+        stream_websockets_[pss->stream_id] = wsi;
+    }
+
+    LOG(DEBUG, "Http2Gateway") << "Stream " << pss->stream_id << ": "
+                               << state->method << " " << state->target << std::endl;
+
+    if (!method_may_have_body(state->method)) {
+        start_upstream(pss->stream_id);
+    }
+    return 0;
+}
+
+int Http2Gateway::handle_body(PerStreamData* pss, const char* data, size_t len) {
+    if (!data || len == 0) {
+        return 0;
+    }
+    std::shared_ptr<StreamState> state;
+    {
+        std::lock_guard<std::mutex> lock(streams_mutex_);
+        auto it = streams_.find(pss->stream_id);
+        if (it == streams_.end()) {
+            return -1;
+        }
+        state = it->second;
+    }
+    if (state->request_body.size() + len > kMaxRequestBodyBytes) {
+        LOG(WARNING, "Http2Gateway") << "Stream " << pss->stream_id
+                                     << " request body exceeds "
+                                     << kMaxRequestBodyBytes << " bytes, dropping" << std::endl;
+        return -1;
+    }
+    state->request_body.append(data, len);
+    return 0;
+}
+
+void Http2Gateway::handle_body_completion(const std::string& stream_id) {
+    start_upstream(stream_id);
+}
+
+void Http2Gateway::start_upstream(const std::string& stream_id) {
+    std::shared_ptr<StreamState> state;
+    {
+        std::lock_guard<std::mutex> lock(streams_mutex_);
+        auto it = streams_.find(stream_id);
+        if (it == streams_.end()) {
+            return;
+        }
+        state = it->second;
+    }
+
+    // Detached on purpose: the worker owns only shared state and the wake
+    // handle, both shared_ptrs, so gateway shutdown never has to wait out a
+    // long-lived SSE stream (the receiver aborts on the cancelled flag the
+    // next time a chunk arrives).
+    std::thread([state, handle = service_handle_, upstream_port = upstream_port_]() {
+        httplib::Client cli("127.0.0.1", upstream_port);
+        cli.set_connection_timeout(5, 0);
+        // SSE streams stay open indefinitely; cancellation comes from the
+        // content receiver, not the socket timeout.
+        cli.set_read_timeout(24 * 60 * 60, 0);
+
+        httplib::Request req;
+        req.method = state->method;
+        req.path = state->target;
+        for (const auto& [name, value] : state->request_headers) {
+            req.headers.emplace(name, value);
+        }
+        req.body = std::move(state->request_body);
+
+        req.response_handler = [&](const httplib::Response& res) {
+            std::lock_guard<std::mutex> lock(state->mutex);
+            state->status = res.status;
+            state->response_content_type = res.get_header_value("Content-Type");
+            for (const auto& [name, value] : res.headers) {
+                if (is_forwardable_response_header(to_lower(name))) {
+                    state->response_headers.emplace_back(name, value);
+                }
+            }
+            state->have_headers = true;
+            state->needs_kick = true;
+            return !state->cancelled.load();
+        };
+        req.content_receiver = [&](const char* data, size_t data_length,
+                                   uint64_t /*offset*/, uint64_t /*total_length*/) {
+            if (state->cancelled.load()) {
+                return false;
+            }
+            {
+                std::lock_guard<std::mutex> lock(state->mutex);
+                state->pending.append(data, data_length);
+                state->needs_kick = true;
+            }
+            handle->kick();
+            return true;
+        };
+
+        httplib::Response res;
+        httplib::Error error = httplib::Error::Success;
+        cli.send(req, res, error);
+
+        {
+            std::lock_guard<std::mutex> lock(state->mutex);
+            if (!state->have_headers) {
+                state->status = 502;
+                state->response_content_type = "application/json";
+                state->pending =
+                    "{\"error\":{\"message\":\"Gateway could not reach the main "
+                    "listener: " + httplib::to_string(error) + "\",\"type\":\"network_error\"}}";
+                state->have_headers = true;
+            }
+            state->upstream_done = true;
+            state->needs_kick = true;
+        }
+        handle->kick();
+    }).detach();
+}
+
+int Http2Gateway::handle_writable(const std::string& stream_id, struct lws* wsi) {
+    std::shared_ptr<StreamState> state;
+    {
+        std::lock_guard<std::mutex> lock(streams_mutex_);
+        auto it = streams_.find(stream_id);
+        if (it == streams_.end()) {
+            return -1;
+        }
+        state = it->second;
+    }
+
+    std::lock_guard<std::mutex> lock(state->mutex);
+
+    if (!state->headers_sent) {
+        if (!state->have_headers) {
+            return 0;
+        }
+        uint8_t buf[LWS_PRE + 2048];
+        uint8_t *start = &buf[LWS_PRE], *p = start, *end = &buf[sizeof(buf) - 1];
+
+        const char* content_type = state->response_content_type.empty()
+            ? "application/octet-stream"
+            : state->response_content_type.c_str();
+        if (lws_add_http_common_headers(wsi, static_cast<unsigned int>(state->status),
+                                        content_type, LWS_ILLEGAL_HTTP_CONTENT_LEN,
+                                        &p, end)) {
+            return -1;
+        }
+        for (const auto& [name, value] : state->response_headers) {
+            const std::string header_name = to_lower(name) + ":";
+            if (lws_add_http_header_by_name(
+                    wsi, reinterpret_cast<const unsigned char*>(header_name.c_str()),
+                    reinterpret_cast<const unsigned char*>(value.c_str()),
+                    static_cast<int>(value.size()), &p, end)) {
+                return -1;
+            }
+        }
+        if (lws_finalize_write_http_header(wsi, start, &p, end)) {
+            return -1;
+        }
+        state->headers_sent = true;
+        if (!state->pending.empty() || state->upstream_done) {
+            lws_callback_on_writable(wsi);
+        }
+        return 0;
+    }
+
+    if (state->pending.empty()) {
+        if (state->upstream_done && !state->final_written) {
+            uint8_t term[LWS_PRE + 1];
+            if (lws_write(wsi, &term[LWS_PRE], 0, LWS_WRITE_HTTP_FINAL) < 0) {
+                return -1;
+            }
+            state->final_written = true;
+            if (lws_http_transaction_completed(wsi)) {
+                return -1;
+            }
+        }
+        return 0;
+    }
+
+    const size_t n = (std::min)(state->pending.size(), kWriteChunkBytes);
+    std::vector<uint8_t> out(LWS_PRE + n);
+    std::memcpy(out.data() + LWS_PRE, state->pending.data(), n);
+    const bool last = state->upstream_done && n == state->pending.size();
+
+    if (lws_write(wsi, out.data() + LWS_PRE, n,
+                  last ? LWS_WRITE_HTTP_FINAL : LWS_WRITE_HTTP) < 0) {
+        return -1;
+    }
+    state->pending.erase(0, n);
+
+    if (last) {
+        state->final_written = true;
+        if (lws_http_transaction_completed(wsi)) {
+            return -1;
+        }
+    } else if (!state->pending.empty()) {
+        lws_callback_on_writable(wsi);
+    }
+    return 0;
+}
+
+void Http2Gateway::handle_close(const std::string& stream_id) {
+    std::shared_ptr<StreamState> state;
+    {
+        std::lock_guard<std::mutex> lock(streams_mutex_);
+        auto it = streams_.find(stream_id);
+        if (it != streams_.end()) {
+            state = it->second;
+            streams_.erase(it);
+        }
+        stream_websockets_.erase(stream_id);
+    }
+    if (state) {
+        state->cancelled.store(true);
+    }
+}
+
+void Http2Gateway::kick_pending_streams() {
+    std::lock_guard<std::mutex> lock(streams_mutex_);
+    for (auto& [stream_id, state] : streams_) {
+        bool kick = false;
+        {
+            std::lock_guard<std::mutex> state_lock(state->mutex);
+            kick = state->needs_kick;
+            state->needs_kick = false;
+        }
+        if (kick) {
+            auto wsi_it = stream_websockets_.find(stream_id);
+            if (wsi_it != stream_websockets_.end()) {
+                lws_callback_on_writable(wsi_it->second);
+            }
+        }
+    }
+}
+
+bool Http2Gateway::start() {
+    if (running_.load()) {
+        return true;
+    }
+
+    struct lws_context_creation_info info;
+    std::memset(&info, 0, sizeof(info));
+
+    info.port = port_;
+    info.protocols = gateway_protocols;
+    info.user = this;
+    // h2c prior knowledge lets clients multiplex without TLS on this listener;
+    // a TLS-terminating proxy in front negotiates h2 via ALPN and speaks the
+    // same cleartext h2 here.
+    info.options = LWS_SERVER_OPTION_EXPLICIT_VHOSTS |
+                   LWS_SERVER_OPTION_H2_PRIOR_KNOWLEDGE;
+
+    if (host_.empty() || host_ == "localhost") {
+        info.iface = "127.0.0.1";
+    } else if (host_ != "0.0.0.0") {
+        info.iface = host_.c_str();
+    }
+
+    lws_set_log_level(LLL_ERR | LLL_WARN, nullptr);
+
+    context_ = lws_create_context(&info);
+    if (!context_) {
+        LOG(ERROR, "Http2Gateway") << "Failed to create context on port " << port_ << std::endl;
+        return false;
+    }
+
+    vhost_ = lws_create_vhost(context_, &info);
+    if (!vhost_) {
+        LOG(ERROR, "Http2Gateway") << "Failed to create vhost on port " << port_ << std::endl;
+        lws_context_destroy(context_);
+        context_ = nullptr;
+        return false;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(service_handle_->mutex);
+        service_handle_->context = context_;
+    }
+
+    running_.store(true);
+    service_thread_ = std::thread(&Http2Gateway::service_loop, this);
+
+    LOG(INFO, "Http2Gateway") << "Listener started on port " << port_ << std::endl;
+    return true;
+}
+
+void Http2Gateway::stop() {
+    if (!running_.load()) {
+        return;
+    }
+
+    running_.store(false);
+
+    {
+        std::lock_guard<std::mutex> lock(streams_mutex_);
+        for (auto& [stream_id, state] : streams_) {
+            state->cancelled.store(true);
+        }
+    }
+
+    struct lws_context* ctx_to_destroy = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(service_handle_->mutex);
+        if (service_handle_->context) {
+            lws_cancel_service(service_handle_->context);
+            ctx_to_destroy = service_handle_->context;
+            service_handle_->context = nullptr;
+        }
+    }
+    context_ = nullptr;
+    vhost_ = nullptr;
+
+    if (service_thread_.joinable()) {
+        service_thread_.join();
+    }
+
+    if (ctx_to_destroy) {
+        lws_context_destroy(ctx_to_destroy);
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(streams_mutex_);
+        streams_.clear();
+        stream_websockets_.clear();
+    }
+
+    LOG(INFO, "Http2Gateway") << "Listener stopped" << std::endl;
+}
+
+void Http2Gateway::service_loop() {
+    struct lws_context* ctx = context_;
+    while (running_.load()) {
+        lws_service(ctx, 50);
+        kick_pending_streams();
+    }
+}
+
+} // namespace lemon
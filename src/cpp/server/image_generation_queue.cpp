@@ -0,0 +1,134 @@
+#include "lemon/image_generation_queue.h"
+
+#include <algorithm>
+
+namespace lemon {
+
+ImageGenerationQueue::ImageGenerationQueue(size_t max_running)
+    : max_running_(max_running == 0 ? 1 : max_running) {}
+
+std::shared_ptr<ImageGenerationQueue::Ticket> ImageGenerationQueue::enqueue(
+    int priority, const std::string& resolution) {
+    auto ticket = std::make_shared<Ticket>();
+    ticket->priority = priority;
+    ticket->resolution = resolution;
+    std::lock_guard<std::mutex> lock(mutex_);
+    ticket->sequence = next_sequence_++;
+    waiting_.push_back(ticket);
+    schedule_locked();
+    return ticket;
+}
+
+size_t ImageGenerationQueue::position(
+    const std::shared_ptr<Ticket>& ticket) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (ticket->running) {
+        return 0;
+    }
+    size_t ahead = running_;
+    for (const auto& other : waiting_) {
+        if (other == ticket) {
+            continue;
+        }
+        if (other->priority > ticket->priority ||
+            (other->priority == ticket->priority &&
+             other->sequence < ticket->sequence)) {
+            ++ahead;
+        }
+    }
+    return ahead;
+}
+
+size_t ImageGenerationQueue::depth() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return waiting_.size() + running_;
+}
+
+bool ImageGenerationQueue::wait_for_turn(const std::shared_ptr<Ticket>& ticket,
+                                         std::chrono::milliseconds timeout) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    return cv_.wait_for(lock, timeout, [&ticket] {
+        return ticket->running || ticket->cancelled;
+    }) && ticket->running;
+}
+
+void ImageGenerationQueue::cancel(const std::shared_ptr<Ticket>& ticket) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (ticket->running || ticket->cancelled) {
+        return;
+    }
+    ticket->cancelled = true;
+    waiting_.erase(std::remove(waiting_.begin(), waiting_.end(), ticket),
+                   waiting_.end());
+    cv_.notify_all();
+}
+
+void ImageGenerationQueue::complete(const std::shared_ptr<Ticket>& ticket,
+                                    const std::string& estimate_key,
+                                    std::chrono::milliseconds duration) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!ticket->running) {
+        return;
+    }
+    ticket->running = false;
+    --running_;
+    if (duration.count() > 0 && !estimate_key.empty()) {
+        const double ms = static_cast<double>(duration.count());
+        auto it = expected_ms_.find(estimate_key);
+        if (it == expected_ms_.end()) {
+            expected_ms_[estimate_key] = ms;
+        } else {
+            it->second = 0.7 * it->second + 0.3 * ms;
+        }
+    }
+    schedule_locked();
+}
+
+double ImageGenerationQueue::estimated_fraction(
+    const std::string& estimate_key, std::chrono::milliseconds elapsed) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    const auto it = expected_ms_.find(estimate_key);
+    if (it == expected_ms_.end() || it->second <= 0.0) {
+        return -1.0;
+    }
+    const double fraction = static_cast<double>(elapsed.count()) / it->second;
+    return std::min(std::max(fraction, 0.0), 0.95);
+}
+
+void ImageGenerationQueue::schedule_locked() {
+    // A same-resolution ticket may jump at most this many older tickets, so a
+    // steady stream of one resolution can't starve a waiting odd-size request.
+    static constexpr uint64_t AFFINITY_WINDOW = 4;
+
+    bool started = false;
+    while (running_ < max_running_ && !waiting_.empty()) {
+        auto fifo = waiting_.begin();
+        for (auto it = std::next(waiting_.begin()); it != waiting_.end(); ++it) {
+            if ((*it)->priority > (*fifo)->priority ||
+                ((*it)->priority == (*fifo)->priority &&
+                 (*it)->sequence < (*fifo)->sequence)) {
+                fifo = it;
+            }
+        }
+        auto best = fifo;
+        for (auto it = waiting_.begin(); it != waiting_.end(); ++it) {
+            if ((*it)->priority == (*fifo)->priority &&
+                (*it)->resolution == last_resolution_ &&
+                (*it)->sequence - (*fifo)->sequence <= AFFINITY_WINDOW &&
+                ((*best)->resolution != last_resolution_ ||
+                 (*it)->sequence < (*best)->sequence)) {
+                best = it;
+            }
+        }
+        (*best)->running = true;
+        last_resolution_ = (*best)->resolution;
+        waiting_.erase(best);
+        ++running_;
+        started = true;
+    }
+    if (started) {
+        cv_.notify_all();
+    }
+}
+
+}  // namespace lemon
@@ -0,0 +1,238 @@
+#include "lemon/image_part_cache.h"
+
+#include "lemon/utils/aixlog.hpp"
+#include "lemon/utils/image_sniff.h"
+#include "lemon/utils/json_utils.h"
+
+#include <algorithm>
+#include <cctype>
+
+namespace lemon {
+
+namespace {
+
+// Canonical URIs for a few dozen screenshots; oversized payloads just miss.
+constexpr size_t kDefaultBudgetBytes = 32ull * 1024 * 1024;
+
+uint64_t fnv1a(const std::string& data) {
+    uint64_t hash = 1469598103934665603ull;
+    for (unsigned char c : data) {
+        hash ^= c;
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
+uint32_t read_be32(const std::string& bytes, size_t offset) {
+    return (static_cast<uint32_t>(static_cast<unsigned char>(bytes[offset])) << 24) |
+           (static_cast<uint32_t>(static_cast<unsigned char>(bytes[offset + 1])) << 16) |
+           (static_cast<uint32_t>(static_cast<unsigned char>(bytes[offset + 2])) << 8) |
+           static_cast<uint32_t>(static_cast<unsigned char>(bytes[offset + 3]));
+}
+
+uint16_t read_le16(const std::string& bytes, size_t offset) {
+    return static_cast<uint16_t>(static_cast<unsigned char>(bytes[offset])) |
+           (static_cast<uint16_t>(static_cast<unsigned char>(bytes[offset + 1])) << 8);
+}
+
+uint32_t read_le32(const std::string& bytes, size_t offset) {
+    return static_cast<uint32_t>(static_cast<unsigned char>(bytes[offset])) |
+           (static_cast<uint32_t>(static_cast<unsigned char>(bytes[offset + 1])) << 8) |
+           (static_cast<uint32_t>(static_cast<unsigned char>(bytes[offset + 2])) << 16) |
+           (static_cast<uint32_t>(static_cast<unsigned char>(bytes[offset + 3])) << 24);
+}
+
+bool probe_jpeg(const std::string& bytes, int& width, int& height) {
+    size_t pos = 2;
+    while (pos + 9 < bytes.size()) {
+        if (static_cast<unsigned char>(bytes[pos]) != 0xFF) {
+            return false;
+        }
+        const unsigned char marker = static_cast<unsigned char>(bytes[pos + 1]);
+        if (marker == 0xFF) {
+            ++pos;
+            continue;
+        }
+        // Standalone markers without a length field.
+        if (marker == 0xD8 || (marker >= 0xD0 && marker <= 0xD7) || marker == 0x01) {
+            pos += 2;
+            continue;
+        }
+        const size_t segment_len =
+            (static_cast<size_t>(static_cast<unsigned char>(bytes[pos + 2])) << 8) |
+            static_cast<unsigned char>(bytes[pos + 3]);
+        const bool is_sof = marker >= 0xC0 && marker <= 0xCF &&
+                            marker != 0xC4 && marker != 0xC8 && marker != 0xCC;
+        if (is_sof) {
+            if (segment_len < 7 || pos + 9 > bytes.size()) {
+                return false;
+            }
+            height = (static_cast<unsigned char>(bytes[pos + 5]) << 8) |
+                     static_cast<unsigned char>(bytes[pos + 6]);
+            width = (static_cast<unsigned char>(bytes[pos + 7]) << 8) |
+                    static_cast<unsigned char>(bytes[pos + 8]);
+            return width > 0 && height > 0;
+        }
+        if (marker == 0xDA) {
+            return false;
+        }
+        pos += 2 + segment_len;
+    }
+    return false;
+}
+
+}  // namespace
+
+ImagePartCache& ImagePartCache::global() {
+    static ImagePartCache instance(kDefaultBudgetBytes);
+    return instance;
+}
+
+ImagePartCache::ImagePartCache(size_t budget_bytes) : budget_bytes_(budget_bytes) {}
+
+bool ImagePartCache::probe_dimensions(const std::string& bytes, const std::string& mime,
+                                      int& width, int& height) {
+    width = 0;
+    height = 0;
+    if (mime == "image/png") {
+        if (bytes.size() < 24) return false;
+        width = static_cast<int>(read_be32(bytes, 16));
+        height = static_cast<int>(read_be32(bytes, 20));
+    } else if (mime == "image/gif") {
+        if (bytes.size() < 10) return false;
+        width = read_le16(bytes, 6);
+        height = read_le16(bytes, 8);
+    } else if (mime == "image/bmp") {
+        if (bytes.size() < 26) return false;
+        width = static_cast<int>(read_le32(bytes, 18));
+        height = std::abs(static_cast<int>(read_le32(bytes, 22)));
+    } else if (mime == "image/jpeg") {
+        return probe_jpeg(bytes, width, height);
+    } else {
+        return false;
+    }
+    return width > 0 && height > 0;
+}
+
+bool ImagePartCache::canonicalize_part(nlohmann::json& image_url) {
+    if (!image_url.is_object() || !image_url.contains("url") ||
+        !image_url["url"].is_string()) {
+        return false;
+    }
+    const std::string url = image_url["url"].get<std::string>();
+    if (url.rfind("data:", 0) != 0) {
+        return false;
+    }
+    const size_t marker = url.find(";base64,");
+    if (marker == std::string::npos) {
+        return false;
+    }
+
+    const uint64_t key = fnv1a(url);
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        images_++;
+        auto it = entries_.find(key);
+        if (it != entries_.end()) {
+            hits_++;
+            lru_.splice(lru_.begin(), lru_, it->second.lru_it);
+            if (url == it->second.canonical_uri) {
+                return false;
+            }
+            image_url["url"] = it->second.canonical_uri;
+            return true;
+        }
+        misses_++;
+    }
+
+    std::string base64 = url.substr(marker + 8);
+    base64.erase(std::remove_if(base64.begin(), base64.end(),
+                                [](unsigned char c) { return std::isspace(c); }),
+                 base64.end());
+    const std::string bytes = utils::JsonUtils::base64_decode(base64);
+    const auto sniffed = utils::sniff_image(bytes);
+    if (!sniffed.ok()) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        rejected_++;
+        return false;
+    }
+
+    int width = 0, height = 0;
+    if (probe_dimensions(bytes, sniffed.mime, width, height)) {
+        LOG(DEBUG, "ImageCache") << "New " << sniffed.mime << " image part: "
+                << width << "x" << height << ", " << bytes.size() << " bytes" << std::endl;
+    }
+
+    std::string canonical = "data:" + sniffed.mime + ";base64," + base64;
+    const bool changed = canonical != url;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        insert_locked(key, canonical);
+        if (changed) {
+            // A later turn may resend the canonical form directly; make that a
+            // hit instead of a re-decode.
+            insert_locked(fnv1a(canonical), canonical);
+        }
+    }
+    if (changed) {
+        image_url["url"] = std::move(canonical);
+    }
+    return changed;
+}
+
+void ImagePartCache::insert_locked(uint64_t key, std::string canonical_uri) {
+    auto it = entries_.find(key);
+    if (it != entries_.end()) {
+        lru_.splice(lru_.begin(), lru_, it->second.lru_it);
+        return;
+    }
+    if (canonical_uri.size() > budget_bytes_) {
+        return;
+    }
+    cached_bytes_ += canonical_uri.size();
+    lru_.push_front(key);
+    entries_[key] = Entry{std::move(canonical_uri), lru_.begin()};
+    while (cached_bytes_ > budget_bytes_ && !lru_.empty()) {
+        const uint64_t victim = lru_.back();
+        lru_.pop_back();
+        auto victim_it = entries_.find(victim);
+        if (victim_it != entries_.end()) {
+            cached_bytes_ -= victim_it->second.canonical_uri.size();
+            entries_.erase(victim_it);
+        }
+    }
+}
+
+bool ImagePartCache::preprocess_chat_request(nlohmann::json& request) {
+    if (!request.contains("messages") || !request["messages"].is_array()) {
+        return false;
+    }
+    bool modified = false;
+    for (auto& message : request["messages"]) {
+        if (!message.is_object() || !message.contains("content") ||
+            !message["content"].is_array()) {
+            continue;
+        }
+        for (auto& part : message["content"]) {
+            if (part.is_object() && part.value("type", "") == "image_url" &&
+                part.contains("image_url")) {
+                modified = canonicalize_part(part["image_url"]) || modified;
+            }
+        }
+    }
+    return modified;
+}
+
+ImagePartCache::Totals ImagePartCache::totals() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    Totals t;
+    t.images = images_;
+    t.hits = hits_;
+    t.misses = misses_;
+    t.rejected = rejected_;
+    t.cached_bytes = cached_bytes_;
+    t.cached_entries = entries_.size();
+    return t;
+}
+
+} // namespace lemon
@@ -0,0 +1,160 @@
+#include "lemon/image_result_store.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <system_error>
+#include <vector>
+
+#include "lemon/utils/aixlog.hpp"
+#include "lemon/utils/path_utils.h"
+
+namespace fs = std::filesystem;
+
+namespace lemon {
+
+namespace {
+
+std::uint64_t fnv1a64(const std::string& text,
+                      std::uint64_t hash = 14695981039346656037ull) {
+    for (unsigned char c : text) {
+        hash ^= c;
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
+std::string to_hex(std::uint64_t value) {
+    char buf[17];
+    std::snprintf(buf, sizeof(buf), "%016llx",
+                  static_cast<unsigned long long>(value));
+    return std::string(buf);
+}
+
+}  // namespace
+
+ImageResultStore::ImageResultStore(const std::string& cache_dir,
+                                   uint64_t max_bytes)
+    : dir_(cache_dir + "/image-results"), max_bytes_(max_bytes) {}
+
+std::string ImageResultStore::store(const std::string& bytes,
+                                    const std::string& format) {
+    if (bytes.empty() || bytes.size() > max_bytes_) {
+        return "";
+    }
+    // Two independent 64-bit passes give a 128-bit content key so distinct
+    // images can't realistically collide on the same URL.
+    const std::string key =
+        to_hex(fnv1a64(bytes)) + to_hex(fnv1a64(bytes, fnv1a64("image-results")));
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::error_code ec;
+    const fs::path dir = utils::path_from_utf8(dir_);
+    fs::create_directories(dir, ec);
+    const fs::path target = dir / (key + "." + format);
+    if (fs::exists(target, ec)) {
+        fs::last_write_time(target, fs::file_time_type::clock::now(), ec);
+        return key;
+    }
+    const fs::path tmp = dir / (key + ".tmp");
+    {
+        std::ofstream file(tmp, std::ios::binary | std::ios::trunc);
+        if (!file) {
+            LOG(WARNING, "ImageResultStore")
+                << "Failed to write entry under " << dir_ << std::endl;
+            return "";
+        }
+        file.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+        if (!file) {
+            file.close();
+            fs::remove(tmp, ec);
+            return "";
+        }
+    }
+    fs::rename(tmp, target, ec);
+    if (ec) {
+        fs::remove(tmp, ec);
+        return "";
+    }
+    evict_to_fit();
+    return key;
+}
+
+bool ImageResultStore::lookup(const std::string& key, std::string& format,
+                              std::string& bytes) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::error_code ec;
+    for (const auto& entry :
+         fs::directory_iterator(utils::path_from_utf8(dir_), ec)) {
+        if (!entry.is_regular_file() ||
+            utils::path_to_utf8(entry.path().stem()) != key) {
+            continue;
+        }
+        std::ifstream file(entry.path(), std::ios::binary);
+        if (!file) {
+            return false;
+        }
+        bytes.assign(std::istreambuf_iterator<char>(file),
+                     std::istreambuf_iterator<char>());
+        format = utils::path_to_utf8(entry.path().extension());
+        if (!format.empty() && format.front() == '.') {
+            format.erase(0, 1);
+        }
+        fs::last_write_time(entry.path(), fs::file_time_type::clock::now(), ec);
+        return !bytes.empty();
+    }
+    return false;
+}
+
+uint64_t ImageResultStore::size_bytes() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::error_code ec;
+    uint64_t total = 0;
+    for (const auto& entry :
+         fs::directory_iterator(utils::path_from_utf8(dir_), ec)) {
+        if (entry.is_regular_file(ec)) {
+            total += entry.file_size(ec);
+        }
+    }
+    return total;
+}
+
+void ImageResultStore::evict_to_fit() {
+    struct Entry {
+        fs::file_time_type mtime;
+        uint64_t size;
+        fs::path path;
+    };
+    std::error_code ec;
+    std::vector<Entry> entries;
+    uint64_t total = 0;
+    for (const auto& entry :
+         fs::directory_iterator(utils::path_from_utf8(dir_), ec)) {
+        if (!entry.is_regular_file(ec)) {
+            continue;
+        }
+        const uint64_t size = entry.file_size(ec);
+        entries.push_back({entry.last_write_time(ec), size, entry.path()});
+        total += size;
+    }
+    if (total <= max_bytes_) {
+        return;
+    }
+    std::sort(entries.begin(), entries.end(),
+              [](const Entry& a, const Entry& b) { return a.mtime < b.mtime; });
+    for (const auto& entry : entries) {
+        if (total <= max_bytes_) {
+            break;
+        }
+        fs::remove(entry.path, ec);
+        if (!ec) {
+            total -= entry.size;
+            LOG(INFO, "ImageResultStore")
+                << "Evicted " << utils::path_to_utf8(entry.path.filename())
+                << std::endl;
+        }
+    }
+}
+
+}  // namespace lemon
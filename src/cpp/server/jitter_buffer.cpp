@@ -0,0 +1,126 @@
+#include "lemon/jitter_buffer.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <utility>
+
+namespace lemon {
+
+namespace {
+
+constexpr size_t kMaxPooledFrames = 64;
+
+std::atomic<uint64_t> g_frames{0};
+std::atomic<uint64_t> g_late_frames{0};
+std::atomic<uint64_t> g_released_frames{0};
+
+}  // namespace
+
+JitterBuffer::JitterBuffer() : JitterBuffer(Config{}) {}
+
+JitterBuffer::JitterBuffer(Config config) : config_(config) {}
+
+void JitterBuffer::push(const int16_t* samples, size_t count, int64_t now_ms) {
+    if (count == 0) {
+        return;
+    }
+    g_frames++;
+
+    if (last_arrival_ms_ != 0) {
+        const double interval = static_cast<double>(now_ms - last_arrival_ms_);
+        if (interval_ms_ == 0.0) {
+            interval_ms_ = interval;
+        }
+        // A frame is late when its gap overshoots the expected cadence by
+        // more than the depth we keep buffered to hide it.
+        if (interval > interval_ms_ + target_depth_ms()) {
+            g_late_frames++;
+        }
+        const double deviation = std::fabs(interval - interval_ms_);
+        interval_ms_ += (interval - interval_ms_) / 16.0;
+        jitter_ms_ += (deviation - jitter_ms_) / 16.0;
+    }
+    last_arrival_ms_ = now_ms;
+
+    std::vector<int16_t> frame = take_frame();
+    frame.assign(samples, samples + count);
+    queued_samples_ += count;
+    queue_.push_back(std::move(frame));
+}
+
+size_t JitterBuffer::pull_ready(std::vector<int16_t>& out) {
+    const size_t target_samples =
+        static_cast<size_t>(target_depth_ms()) * config_.sample_rate / 1000;
+    size_t released = 0;
+    while (!queue_.empty() && queued_samples_ - queue_.front().size() >= target_samples) {
+        std::vector<int16_t>& frame = queue_.front();
+        out.insert(out.end(), frame.begin(), frame.end());
+        released += frame.size();
+        queued_samples_ -= frame.size();
+        recycle_frame(std::move(frame));
+        queue_.pop_front();
+        g_released_frames++;
+    }
+    return released;
+}
+
+size_t JitterBuffer::flush(std::vector<int16_t>& out) {
+    size_t released = 0;
+    while (!queue_.empty()) {
+        std::vector<int16_t>& frame = queue_.front();
+        out.insert(out.end(), frame.begin(), frame.end());
+        released += frame.size();
+        recycle_frame(std::move(frame));
+        queue_.pop_front();
+        g_released_frames++;
+    }
+    queued_samples_ = 0;
+    return released;
+}
+
+void JitterBuffer::reset() {
+    while (!queue_.empty()) {
+        recycle_frame(std::move(queue_.front()));
+        queue_.pop_front();
+    }
+    queued_samples_ = 0;
+    last_arrival_ms_ = 0;
+    interval_ms_ = 0.0;
+    jitter_ms_ = 0.0;
+}
+
+int JitterBuffer::target_depth_ms() const {
+    const int target = static_cast<int>(jitter_ms_ * config_.jitter_multiplier);
+    return std::clamp(target, config_.min_depth_ms, config_.max_depth_ms);
+}
+
+int JitterBuffer::queued_ms() const {
+    return static_cast<int>(queued_samples_ * 1000 / config_.sample_rate);
+}
+
+std::vector<int16_t> JitterBuffer::take_frame() {
+    if (freelist_.empty()) {
+        return {};
+    }
+    std::vector<int16_t> frame = std::move(freelist_.back());
+    freelist_.pop_back();
+    return frame;
+}
+
+void JitterBuffer::recycle_frame(std::vector<int16_t>&& frame) {
+    if (freelist_.size() < kMaxPooledFrames) {
+        frame.clear();
+        freelist_.push_back(std::move(frame));
+    }
+}
+
+JitterBuffer::Totals JitterBuffer::totals() {
+    Totals t;
+    t.frames = g_frames.load();
+    t.late_frames = g_late_frames.load();
+    t.released_frames = g_released_frames.load();
+    return t;
+}
+
+}  // namespace lemon
@@ -23,6 +23,8 @@ namespace jobs {
 namespace {
 
 constexpr size_t kMaxJobs = 50;
+constexpr size_t kDefaultGroupWidth = 4;
+constexpr size_t kJournalCompactBytes = 1024 * 1024;
 
 std::string iso_now() {
     const auto now = std::chrono::system_clock::now();
@@ -77,10 +79,63 @@ bool job_needs_exclusive(const Job& job, const OpRegistry& registry) {
     return false;
 }
 
+bool parse_window(const std::string& w, int& start_min, int& end_min) {
+    int sh = 0, sm = 0, eh = 0, em = 0, consumed = 0;
+    if (std::sscanf(w.c_str(), "%d:%d-%d:%d%n", &sh, &sm, &eh, &em, &consumed) != 4
+        || consumed != (int)w.size())
+        return false;
+    if (sh < 0 || sh > 23 || sm < 0 || sm > 59 || eh < 0 || eh > 23 || em < 0 || em > 59)
+        return false;
+    start_min = sh * 60 + sm;
+    end_min = eh * 60 + em;
+    return start_min != end_min;
+}
+
+bool window_open(const std::string& w) {
+    if (w.empty()) return true;
+    int start = 0, end = 0;
+    if (!parse_window(w, start, end)) return true;
+    const std::time_t t = std::time(nullptr);
+    std::tm tm_local{};
+#ifdef _WIN32
+    localtime_s(&tm_local, &t);
+#else
+    localtime_r(&t, &tm_local);
+#endif
+    const int now = tm_local.tm_hour * 60 + tm_local.tm_min;
+    if (start < end) return now >= start && now < end;
+    return now >= start || now < end;
+}
+
+json restore_manifest(const Job& job) {
+    json manifest = json::object();
+    for (const auto& s : job.steps) {
+        if (s.status != StepStatus::Completed) continue;
+        try {
+            if (s.op == "load") {
+                json params = resolve_refs(s.params, job.context);
+                if (params.contains("model") && params["model"].is_string())
+                    manifest[params["model"].get<std::string>()] = params;
+            } else if (s.op == "unload") {
+                json params = resolve_refs(s.params, job.context);
+                if (params.contains("model") && params["model"].is_string())
+                    manifest.erase(params["model"].get<std::string>());
+                else
+                    manifest = json::object();
+            }
+        } catch (const std::exception& e) {
+            LOG(WARNING, "Jobs") << "job " << job.id << " restore manifest skipped step '"
+                                 << s.id << "': " << e.what() << std::endl;
+        }
+    }
+    return manifest;
+}
+
 }
 
 JobManager::JobManager(std::string cache_dir, OpRegistry registry)
     : storage_path_((fs::path(cache_dir) / "jobs.json").string()),
+      journal_path_((fs::path(cache_dir) / "jobs.journal").string()),
       registry_(std::move(registry)) {
     load_from_disk();
     worker_ = std::thread(&JobManager::worker_main, this);
@@ -96,6 +151,7 @@ JobManager::~JobManager() {
         }
     }
     cv_.notify_all();
+    updates_cv_.notify_all();
     if (worker_.joinable()) worker_.join();
 }
 
@@ -113,6 +169,7 @@ void JobManager::load_from_disk() {
         }
     }
     try {
+        journal_seq_ = doc.value("journal_seq", (uint64_t)0);
         int loaded = 0, recovered = 0, dropped = 0;
         for (const auto& jj : doc.value("jobs", json::array())) {
             Job job = Job::from_json(jj);
@@ -122,16 +179,6 @@ void JobManager::load_from_disk() {
                 LOG(INFO, "Jobs") << "dropping tombstoned job " << job.id << std::endl;
                 continue;
             }
-            if (job.status == JobStatus::Running || job.status == JobStatus::Queued) {
-                job.status = JobStatus::Interrupted;
-                job.error = "server restarted while the job was active";
-                if (StepRecord* s = find_step(job, job.cursor))
-                    if (s->status == StepStatus::Running) s->status = StepStatus::Pending;
-                recovered++;
-                LOG(WARNING, "Jobs") << "recovered active job " << job.id
-                                     << " as interrupted (resumable at step '" << job.cursor
-                                     << "')" << std::endl;
-            }
             const std::string id = job.id;
             const size_t dash = id.rfind('-');
             if (dash != std::string::npos && dash + 1 < id.size()) {
@@ -144,10 +191,24 @@ void JobManager::load_from_disk() {
             jobs_.emplace(id, std::move(job));
             loaded++;
         }
+        replay_journal();
+        for (auto& kv : jobs_) {
+            Job& job = kv.second;
+            if (job.status != JobStatus::Running && job.status != JobStatus::Queued) continue;
+            job.status = JobStatus::Interrupted;
+            job.error = "server restarted while the job was active";
+            for (auto& s : job.steps)
+                if (s.status == StepStatus::Running) s.status = StepStatus::Pending;
+            recovered++;
+            LOG(WARNING, "Jobs") << "recovered active job " << job.id
+                                 << " as interrupted (resumable at step '" << job.cursor
+                                 << "')" << std::endl;
+        }
+        for (const auto& kv : jobs_) index_locked(kv.second);
         if (loaded)
             LOG(INFO, "Jobs") << "loaded " << loaded << " job(s) from " << storage_path_ << " ("
                               << recovered << " recovered as interrupted)" << std::endl;
-        if (dropped) {
+        if (dropped || recovered || journal_bytes_ > 0) {
             std::lock_guard<std::mutex> lock(mutex_);
             persist_locked();
         }
@@ -157,13 +218,59 @@ void JobManager::load_from_disk() {
     }
 }
 
+void JobManager::replay_journal() {
+    std::ifstream in(lemon::utils::path_from_utf8(journal_path_));
+    if (!in) return;
+    const uint64_t snapshot_seq = journal_seq_;
+    int applied = 0;
+    std::string line;
+    while (std::getline(in, line)) {
+        journal_bytes_ += line.size() + 1;
+        if (line.empty()) continue;
+        json entry;
+        try {
+            entry = json::parse(line);
+        } catch (const std::exception& e) {
+            // A torn final line means the process died mid-append; everything
+            // before it is intact, so stop replaying there.
+            LOG(WARNING, "Jobs") << "stopping journal replay at a torn entry: " << e.what()
+                                 << std::endl;
+            break;
+        }
+        const uint64_t seq = entry.value("seq", (uint64_t)0);
+        if (seq <= snapshot_seq) continue;
+        if (seq > journal_seq_) journal_seq_ = seq;
+        auto it = jobs_.find(entry.value("job", ""));
+        if (it == jobs_.end()) continue;
+        Job& job = it->second;
+        if (entry.contains("status"))
+            job.status = job_status_from_string(entry["status"].get<std::string>());
+        job.cursor = entry.value("cursor", job.cursor);
+        job.error = entry.value("error", "");
+        if (entry.contains("started_at")) job.started_at = entry["started_at"];
+        if (entry.contains("finished_at")) job.finished_at = entry["finished_at"];
+        for (const auto& sj : entry.value("steps", json::array())) {
+            StepRecord rec = StepRecord::from_json(sj);
+            if (StepRecord* s = find_step(job, rec.id)) *s = std::move(rec);
+        }
+        if (entry.contains("context"))
+            for (auto it2 = entry["context"].begin(); it2 != entry["context"].end(); ++it2)
+                job.context[it2.key()] = it2.value();
+        applied++;
+    }
+    if (applied)
+        LOG(INFO, "Jobs") << "replayed " << applied << " journal entr"
+                          << (applied == 1 ? "y" : "ies") << " from " << journal_path_
+                          << std::endl;
+}
+
 void JobManager::persist_locked() {
     json arr = json::array();
     for (const auto& id : order_) {
         auto it = jobs_.find(id);
         if (it != jobs_.end()) arr.push_back(it->second.to_json());
     }
-    json doc = {{"version", 1}, {"jobs", arr}};
+    json doc = {{"version", 1}, {"journal_seq", journal_seq_}, {"jobs", arr}};
     const std::string tmp = storage_path_ + ".tmp";
     bool write_ok = false;
     {
@@ -182,7 +289,78 @@ void JobManager::persist_locked() {
     std::error_code ec;
     lemon::utils::atomic_replace_file(lemon::utils::path_from_utf8(tmp),
                                       lemon::utils::path_from_utf8(storage_path_), ec);
-    if (ec) LOG(WARNING, "Jobs") << "Could not persist jobs: " << ec.message() << std::endl;
+    if (ec) {
+        LOG(WARNING, "Jobs") << "Could not persist jobs: " << ec.message() << std::endl;
+    } else {
+        // The snapshot now covers every journaled change (seq-guarded), so the
+        // journal can start over.
+        std::error_code rm;
+        fs::remove(lemon::utils::path_from_utf8(journal_path_), rm);
+        journal_bytes_ = 0;
+    }
+    updates_cv_.notify_all();
+}
+
+void JobManager::touch_locked(Job& job) {
+    ++job.revision;
+    index_locked(job);
+    updates_cv_.notify_all();
+}
+
+void JobManager::index_locked(const Job& job) {
+    auto it = indexed_.find(job.id);
+    if (it != indexed_.end()) {
+        if (it->second == job.status) return;
+        status_index_[it->second].erase(job.id);
+        it->second = job.status;
+    } else {
+        indexed_[job.id] = job.status;
+    }
+    status_index_[job.status].insert(job.id);
+}
+
+void JobManager::unindex_locked(const std::string& id) {
+    auto it = indexed_.find(id);
+    if (it == indexed_.end()) return;
+    status_index_[it->second].erase(id);
+    indexed_.erase(it);
+}
+
+void JobManager::journal_locked(Job& job, const std::vector<const StepRecord*>& steps,
+                                const json& context_patch) {
+    touch_locked(job);
+    json entry = {{"seq", ++journal_seq_},
+                  {"job", job.id},
+                  {"status", to_string(job.status)},
+                  {"cursor", job.cursor},
+                  {"error", job.error}};
+    if (!job.started_at.empty()) entry["started_at"] = job.started_at;
+    if (!job.finished_at.empty()) entry["finished_at"] = job.finished_at;
+    if (!steps.empty()) {
+        json arr = json::array();
+        for (const StepRecord* s : steps)
+            if (s) arr.push_back(s->to_json());
+        entry["steps"] = arr;
+    }
+    if (!context_patch.empty()) entry["context"] = context_patch;
+
+    const std::string line = entry.dump();
+    bool write_ok = false;
+    {
+        std::ofstream out(lemon::utils::path_from_utf8(journal_path_),
+                          std::ios::app | std::ios::binary);
+        out << line << '\n';
+        out.flush();
+        write_ok = out.good();
+    }
+    if (!write_ok) {
+        LOG(WARNING, "Jobs") << "Could not append to " << journal_path_
+                             << "; falling back to a full snapshot" << std::endl;
+        persist_locked();
+        return;
+    }
+    journal_bytes_ += line.size() + 1;
+    if (journal_bytes_ >= kJournalCompactBytes) persist_locked();
 }
 
 void JobManager::enqueue_locked(const std::string& id) {
@@ -198,26 +376,60 @@ std::shared_ptr<JobManager::Control> JobManager::control_for_locked(const std::s
 }
 
 std::string JobManager::create(const std::string& name, std::vector<StepRecord> steps,
-                               json inputs) {
-    const std::string err = validate_steps(steps, registry_.names());
-    if (!err.empty()) throw JobError(400, err);
+                               json inputs, int priority, const std::string& window) {
+    JobSpec spec;
+    spec.name = name;
+    spec.steps = std::move(steps);
+    spec.inputs = std::move(inputs);
+    spec.priority = priority;
+    spec.window = window;
+    std::vector<JobSpec> specs;
+    specs.push_back(std::move(spec));
+    return create_many(std::move(specs)).front();
+}
+
+std::vector<std::string> JobManager::create_many(std::vector<JobSpec> specs) {
+    if (specs.empty()) throw JobError(400, "no jobs in request");
+    if (specs.size() > kMaxJobs)
+        throw JobError(429, "batch of " + std::to_string(specs.size()) + " exceeds the job limit ("
+                            + std::to_string(kMaxJobs) + ")");
+    for (size_t i = 0; i < specs.size(); ++i) {
+        const auto& spec = specs[i];
+        const auto fail = [&](const std::string& msg) {
+            if (specs.size() == 1) return JobError(400, msg);
+            return JobError(400, "jobs[" + std::to_string(i) + "]: " + msg);
+        };
+        const std::string err =
+            validate_steps(spec.steps, registry_.names(), registry_.streaming_names());
+        if (!err.empty()) throw fail(err);
+        if (!spec.window.empty()) {
+            int start = 0, end = 0;
+            if (!parse_window(spec.window, start, end))
+                throw fail("invalid execution window '" + spec.window
+                           + "' (expected HH:MM-HH:MM, start != end)");
+        }
+        for (const auto& s : spec.steps) {
+            if (s.group.empty()) continue;
+            const OpHandler* h = registry_.find(s.op);
+            if (h && !h->parallel_safe)
+                throw fail("op '" + s.op + "' in step '" + s.id
+                           + "' cannot run in a parallel group");
+        }
+    }
 
     std::lock_guard<std::mutex> lock(mutex_);
 
-    size_t live = 0;
-    bool evictable = false;
+    size_t live_active = 0;
     for (const auto& existing : order_) {
         auto jit = jobs_.find(existing);
         if (jit == jobs_.end() || jit->second.deleted) continue;
-        live++;
-        if (is_terminal(jit->second.status)) evictable = true;
+        if (!is_terminal(jit->second.status)) live_active++;
     }
-    if (live >= kMaxJobs && !evictable)
+    if (live_active + specs.size() > kMaxJobs)
         throw JobError(429, "job limit (" + std::to_string(kMaxJobs)
                             + ") reached and every existing job is still active or resumable; "
                               "delete a job first");
 
-    Job job;
     char stamp[24];
     const std::time_t t = std::time(nullptr);
     std::tm tm_utc{};
@@ -227,22 +439,34 @@ std::string JobManager::create(const std::string& name, std::vector<StepRecord>
     gmtime_r(&t, &tm_utc);
 #endif
     std::strftime(stamp, sizeof(stamp), "%Y%m%d-%H%M%S", &tm_utc);
-    char suffix[16];
-    std::snprintf(suffix, sizeof(suffix), "%06llu", (unsigned long long)(++id_counter_));
-    job.id = std::string("job-") + stamp + "-" + suffix;
-    job.name = name;
-    job.status = JobStatus::Queued;
-    job.inputs = inputs.is_null() ? json::object() : inputs;
-    job.context = {{"inputs", job.inputs}};
-    job.steps = std::move(steps);
-    job.cursor = job.steps.front().id;
-    job.created_at = iso_now();
-
-    const std::string id = job.id;
-    const size_t n_steps = job.steps.size();
-    order_.insert(order_.begin(), id);
-    controls_[id] = std::make_shared<Control>();
-    jobs_.emplace(id, std::move(job));
+
+    std::vector<std::string> ids;
+    for (auto& spec : specs) {
+        Job job;
+        char suffix[16];
+        std::snprintf(suffix, sizeof(suffix), "%06llu", (unsigned long long)(++id_counter_));
+        job.id = std::string("job-") + stamp + "-" + suffix;
+        job.name = spec.name;
+        job.status = JobStatus::Queued;
+        job.priority = spec.priority;
+        job.window = spec.window;
+        job.inputs = spec.inputs.is_null() ? json::object() : spec.inputs;
+        job.context = {{"inputs", job.inputs}};
+        job.steps = std::move(spec.steps);
+        job.cursor = job.steps.front().id;
+        job.created_at = iso_now();
+
+        const std::string id = job.id;
+        const size_t n_steps = job.steps.size();
+        order_.insert(order_.begin(), id);
+        controls_[id] = std::make_shared<Control>();
+        index_locked(job);
+        jobs_.emplace(id, std::move(job));
+        enqueue_locked(id);
+        ids.push_back(id);
+        LOG(INFO, "Jobs") << "created job " << id << " '" << spec.name << "' (" << n_steps
+                          << " steps)" << std::endl;
+    }
 
     while (order_.size() > kMaxJobs) {
         bool evicted = false;
@@ -252,6 +476,7 @@ std::string JobManager::create(const std::string& name, std::vector<StepRecord>
                 const std::string victim = *rit;
                 jobs_.erase(victim);
                 controls_.erase(victim);
+                unindex_locked(victim);
                 order_.erase(std::next(rit).base());
                 evicted = true;
                 break;
@@ -260,12 +485,9 @@ std::string JobManager::create(const std::string& name, std::vector<StepRecord>
         if (!evicted) break;
     }
 
-    enqueue_locked(id);
     persist_locked();
     cv_.notify_all();
-    LOG(INFO, "Jobs") << "created job " << id << " '" << name << "' (" << n_steps << " steps)"
-                      << std::endl;
-    return id;
+    return ids;
 }
 
 json JobManager::list() const {
@@ -278,11 +500,84 @@ json JobManager::list() const {
     return out;
 }
 
+json JobManager::list(const ListQuery& query) const {
+    std::optional<JobStatus> want;
+    if (!query.status.empty()) {
+        const JobStatus st = job_status_from_string(query.status);
+        if (to_string(st) != query.status)
+            throw JobError(400, "unknown status filter '" + query.status + "'");
+        want = st;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    json out = json::array();
+    bool has_more = false;
+    std::string last_id;
+
+    const auto visit = [&](const std::string& id) {
+        auto it = jobs_.find(id);
+        if (it == jobs_.end() || it->second.deleted) return true;
+        if (want && it->second.status != *want) return true;
+        if (query.limit > 0 && out.size() >= query.limit) {
+            has_more = true;
+            return false;
+        }
+        json summary = it->second.to_summary_json();
+        if (!query.fields.empty()) {
+            json trimmed = {{"id", summary["id"]}};
+            for (const auto& f : query.fields)
+                if (summary.contains(f)) trimmed[f] = summary[f];
+            summary = std::move(trimmed);
+        }
+        last_id = id;
+        out.push_back(std::move(summary));
+        return true;
+    };
+
+    if (want) {
+        auto idx = status_index_.find(*want);
+        if (idx != status_index_.end()) {
+            const auto& ids = idx->second;
+            auto rit = query.after.empty()
+                           ? ids.rbegin()
+                           : std::make_reverse_iterator(ids.lower_bound(query.after));
+            for (; rit != ids.rend(); ++rit)
+                if (!visit(*rit)) break;
+        }
+    } else {
+        auto rit = query.after.empty()
+                       ? jobs_.rbegin()
+                       : std::make_reverse_iterator(jobs_.lower_bound(query.after));
+        for (; rit != jobs_.rend(); ++rit)
+            if (!visit(rit->first)) break;
+    }
+
+    json result = {{"jobs", std::move(out)}, {"has_more", has_more}};
+    if (has_more) result["next_cursor"] = last_id;
+    return result;
+}
+
 std::optional<json> JobManager::get(const std::string& id) const {
     std::lock_guard<std::mutex> lock(mutex_);
     auto it = jobs_.find(id);
     if (it == jobs_.end() || it->second.deleted) return std::nullopt;
-    return it->second.to_json();
+    json j = it->second.to_json();
+    j["revision"] = it->second.revision;
+    return j;
+}
+
+std::optional<json> JobManager::wait_for_update(const std::string& id, uint64_t last_revision,
+                                                std::chrono::milliseconds timeout) const {
+    std::unique_lock<std::mutex> lock(mutex_);
+    updates_cv_.wait_for(lock, timeout, [&] {
+        auto it = jobs_.find(id);
+        return it == jobs_.end() || it->second.deleted || it->second.revision != last_revision;
+    });
+    auto it = jobs_.find(id);
+    if (it == jobs_.end() || it->second.deleted) return std::nullopt;
+    json j = it->second.to_json();
+    j["revision"] = it->second.revision;
+    return j;
 }
 
 bool JobManager::pause(const std::string& id) {
@@ -292,7 +587,7 @@ bool JobManager::pause(const std::string& id) {
     if (it->second.status == JobStatus::Queued) {
         queue_.erase(std::remove(queue_.begin(), queue_.end(), id), queue_.end());
         it->second.status = JobStatus::Paused;
-        persist_locked();
+        journal_locked(it->second);
         LOG(INFO, "Jobs") << "paused queued job " << id << std::endl;
         return true;
     }
@@ -310,7 +605,7 @@ bool JobManager::interrupt(const std::string& id) {
     if (it->second.status == JobStatus::Queued) {
         queue_.erase(std::remove(queue_.begin(), queue_.end(), id), queue_.end());
         it->second.status = JobStatus::Interrupted;
-        persist_locked();
+        journal_locked(it->second);
         LOG(INFO, "Jobs") << "interrupted queued job " << id << std::endl;
         return true;
     }
@@ -335,7 +630,7 @@ bool JobManager::resume(const std::string& id) {
     it->second.status = JobStatus::Queued;
     it->second.error.clear();
     enqueue_locked(id);
-    persist_locked();
+    journal_locked(it->second);
     cv_.notify_all();
     LOG(INFO, "Jobs") << "resumed job " << id << " at step '" << it->second.cursor << "'"
                       << std::endl;
@@ -372,6 +667,7 @@ bool JobManager::remove(const std::string& id, bool& active_out) {
     }
     jobs_.erase(id);
     controls_.erase(id);
+    unindex_locked(id);
     order_.erase(std::remove(order_.begin(), order_.end(), id), order_.end());
     queue_.erase(std::remove(queue_.begin(), queue_.end(), id), queue_.end());
     persist_locked();
@@ -390,8 +686,32 @@ void JobManager::worker_main() {
             cv_.wait(lock, [&] { return stop_ || !queue_.empty(); });
             if (stop_ && queue_.empty()) return;
             if (queue_.empty()) continue;
-            id = queue_.front();
-            queue_.pop_front();
+
+            // Highest priority first among window-eligible jobs; ties keep
+            // queue order. Stale and tombstoned entries drain immediately.
+            auto best = queue_.end();
+            int best_priority = 0;
+            for (auto qit = queue_.begin(); qit != queue_.end(); ++qit) {
+                auto jit = jobs_.find(*qit);
+                if (jit == jobs_.end() || jit->second.deleted
+                    || jit->second.status != JobStatus::Queued) {
+                    best = qit;
+                    break;
+                }
+                if (!window_open(jit->second.window)) continue;
+                if (best == queue_.end() || jit->second.priority > best_priority) {
+                    best = qit;
+                    best_priority = jit->second.priority;
+                }
+            }
+            if (best == queue_.end()) {
+                // Everything queued is waiting for its execution window.
+                if (stop_) return;
+                cv_.wait_for(lock, std::chrono::seconds(30));
+                continue;
+            }
+            id = *best;
+            queue_.erase(best);
             auto it = jobs_.find(id);
             if (it == jobs_.end()) continue;
             ctrl = control_for_locked(id);
@@ -404,7 +724,7 @@ void JobManager::worker_main() {
                 if (it->second.started_at.empty()) it->second.started_at = iso_now();
                 active_id_ = id;
                 exclusive = job_needs_exclusive(it->second, registry_);
-                persist_locked();
+                journal_locked(it->second);
                 LOG(INFO, "Jobs") << "running job " << id << " from step '" << it->second.cursor
                                   << "'" << std::endl;
             }
@@ -416,6 +736,7 @@ void JobManager::worker_main() {
             std::lock_guard<std::mutex> lock(mutex_);
             jobs_.erase(id);
             controls_.erase(id);
+            unindex_locked(id);
             order_.erase(std::remove(order_.begin(), order_.end(), id), order_.end());
             queue_.erase(std::remove(queue_.begin(), queue_.end(), id), queue_.end());
             persist_locked();
@@ -445,40 +766,18 @@ void JobManager::worker_main() {
             {
                 std::lock_guard<std::mutex> lock(mutex_);
                 auto it = jobs_.find(id);
-                if (it != jobs_.end()) {
-                    const Job& job = it->second;
-                    for (const auto& s : job.steps) {
-                        if (s.status != StepStatus::Completed) continue;
-                        try {
-                            if (s.op == "load") {
-                                json params = resolve_refs(s.params, job.context);
-                                if (params.contains("model") && params["model"].is_string())
-                                    manifest[params["model"].get<std::string>()] = params;
-                            } else if (s.op == "unload") {
-                                json params = resolve_refs(s.params, job.context);
-                                if (params.contains("model") && params["model"].is_string())
-                                    manifest.erase(params["model"].get<std::string>());
-                                else
-                                    manifest = json::object();
-                            }
-                        } catch (const std::exception& e) {
-                            LOG(WARNING, "Jobs")
-                                << "job " << id << " restore manifest skipped step '" << s.id
-                                << "': " << e.what() << std::endl;
-                        }
-                    }
-                }
+                if (it != jobs_.end()) manifest = restore_manifest(it->second);
             }
             ready = registry_.restore_exclusive(id, manifest, &ctrl->cancel);
         }
         if (ready) {
-            execute(id, ctrl);
+            execute(id, ctrl, guard.held);
         } else {
             std::lock_guard<std::mutex> lock(mutex_);
             auto it = jobs_.find(id);
             if (it != jobs_.end()) {
                 it->second.status = JobStatus::Interrupted;
-                persist_locked();
+                journal_locked(it->second);
             }
             LOG(INFO, "Jobs") << "job " << id
                               << " interrupted while waiting for the exclusive slot" << std::endl;
@@ -507,6 +806,7 @@ void JobManager::worker_main() {
             std::lock_guard<std::mutex> lock(mutex_);
             jobs_.erase(id);
             controls_.erase(id);
+            unindex_locked(id);
             order_.erase(std::remove(order_.begin(), order_.end(), id), order_.end());
             queue_.erase(std::remove(queue_.begin(), queue_.end(), id), queue_.end());
             persist_locked();
@@ -515,10 +815,58 @@ void JobManager::worker_main() {
     }
 }
 
-void JobManager::execute(const std::string& id, const std::shared_ptr<Control>& ctrl) {
+void JobManager::yield_slot_for_traffic(const std::string& id,
+                                        const std::shared_ptr<Control>& ctrl) {
+    if (!registry_.interactive_pressure || !registry_.begin_exclusive || !registry_.end_exclusive)
+        return;
+    if (registry_.interactive_pressure() <= 0) return;
+
+    LOG(INFO, "Jobs") << "job " << id
+                      << " yielding the exclusive slot to interactive traffic" << std::endl;
+    registry_.end_exclusive();
+    while (registry_.interactive_pressure() > 0 && !ctrl->interrupt_requested.load()
+           && !ctrl->pause_requested.load())
+        std::this_thread::sleep_for(std::chrono::milliseconds(250));
+    if (ctrl->interrupt_requested.load() || ctrl->pause_requested.load()) return;
+
+    json manifest = json::object();
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = jobs_.find(id);
+        if (it != jobs_.end()) manifest = restore_manifest(it->second);
+    }
+    if (!registry_.begin_exclusive(id, &ctrl->cancel)
+        || (registry_.restore_exclusive
+            && !registry_.restore_exclusive(id, manifest, &ctrl->cancel))) {
+        ctrl->interrupt_requested.store(true);
+        return;
+    }
+    LOG(INFO, "Jobs") << "job " << id << " re-acquired the exclusive slot" << std::endl;
+}
+
+void JobManager::execute(const std::string& id, const std::shared_ptr<Control>& ctrl,
+                         bool exclusive_held) {
     using clock = std::chrono::steady_clock;
 
     while (true) {
+        if (exclusive_held) yield_slot_for_traffic(id, ctrl);
+
+        {
+            std::string group_name;
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                auto it = jobs_.find(id);
+                if (it == jobs_.end()) return;
+                if (!it->second.cursor.empty())
+                    if (StepRecord* s = find_step(it->second, it->second.cursor))
+                        group_name = s->group;
+            }
+            if (!group_name.empty()) {
+                if (!run_group(id, ctrl, group_name)) return;
+                continue;
+            }
+        }
+
         json params;
         json context_snapshot;
         const OpHandler* handler = nullptr;
@@ -531,26 +879,31 @@ void JobManager::execute(const std::string& id, const std::shared_ptr<Control>&
             Job& job = it->second;
 
             if (ctrl->interrupt_requested.load()) {
-                if (StepRecord* s = find_step(job, job.cursor)) s->status = StepStatus::Pending;
+                StepRecord* s = find_step(job, job.cursor);
+                if (s) s->status = StepStatus::Pending;
                 job.status = JobStatus::Interrupted;
-                persist_locked();
+                journal_locked(job, {s});
                 LOG(INFO, "Jobs") << "job " << id << " interrupted at step '" << job.cursor << "'"
                                   << std::endl;
                 return;
             }
             if (ctrl->pause_requested.load()) {
                 job.status = JobStatus::Paused;
-                persist_locked();
+                journal_locked(job);
                 LOG(INFO, "Jobs") << "job " << id << " paused before step '" << job.cursor << "'"
                                   << std::endl;
                 return;
             }
             if (job.cursor.empty()) {
                 job.status = JobStatus::Completed;
+                std::vector<const StepRecord*> skipped;
                 for (auto& st : job.steps)
-                    if (st.status == StepStatus::Pending) st.status = StepStatus::Skipped;
+                    if (st.status == StepStatus::Pending) {
+                        st.status = StepStatus::Skipped;
+                        skipped.push_back(&st);
+                    }
                 if (job.finished_at.empty()) job.finished_at = iso_now();
-                persist_locked();
+                journal_locked(job, skipped);
                 LOG(INFO, "Jobs") << "job " << id << " completed" << std::endl;
                 return;
             }
@@ -560,7 +913,7 @@ void JobManager::execute(const std::string& id, const std::shared_ptr<Control>&
                 job.status = JobStatus::Failed;
                 job.error = "cursor points to unknown step '" + job.cursor + "'";
                 job.finished_at = iso_now();
-                persist_locked();
+                journal_locked(job);
                 return;
             }
 
@@ -573,7 +926,7 @@ void JobManager::execute(const std::string& id, const std::shared_ptr<Control>&
                 job.status = JobStatus::Failed;
                 job.error = e.what();
                 job.finished_at = iso_now();
-                persist_locked();
+                journal_locked(job, {s});
                 return;
             }
             if (skip) {
@@ -581,7 +934,7 @@ void JobManager::execute(const std::string& id, const std::shared_ptr<Control>&
                 LOG(DEBUG, "Jobs") << "job " << id << " step '" << s->id
                                    << "' skipped (when=false)" << std::endl;
                 job.cursor = next_in_list(job, s->id);
-                persist_locked();
+                journal_locked(job, {s});
                 continue;
             }
 
@@ -592,7 +945,7 @@ void JobManager::execute(const std::string& id, const std::shared_ptr<Control>&
                 job.status = JobStatus::Failed;
                 job.error = s->error;
                 job.finished_at = iso_now();
-                persist_locked();
+                journal_locked(job, {s});
                 return;
             }
 
@@ -604,7 +957,7 @@ void JobManager::execute(const std::string& id, const std::shared_ptr<Control>&
                 job.status = JobStatus::Failed;
                 job.error = e.what();
                 job.finished_at = iso_now();
-                persist_locked();
+                journal_locked(job, {s});
                 return;
             }
 
@@ -612,7 +965,7 @@ void JobManager::execute(const std::string& id, const std::shared_ptr<Control>&
             step_id = s->id;
             context_snapshot = job.context;
             ctrl->cancel.store(false);
-            persist_locked();
+            journal_locked(job, {s});
             LOG(DEBUG, "Jobs") << "job " << id << " running step '" << s->id << "' (op " << s->op
                                << ")" << std::endl;
         }
@@ -643,19 +996,24 @@ void JobManager::execute(const std::string& id, const std::shared_ptr<Control>&
                 s->status = StepStatus::Pending;
                 s->error.clear();
                 job.status = JobStatus::Interrupted;
-                persist_locked();
+                journal_locked(job, {s});
                 LOG(INFO, "Jobs") << "job " << id << " interrupted during step '" << step_id << "'"
                                   << std::endl;
                 return;
             }
 
+            json context_patch = json::object();
             if (ok) {
                 s->output = output;
                 job.context[s->id] = output;
+                context_patch[s->id] = output;
                 try {
-                    for (auto it2 = s->extract.begin(); it2 != s->extract.end(); ++it2)
-                        job.context[it2.key()] =
-                            expr_detail::resolve_ref_path(it2.value().get<std::string>(), output);
+                    for (auto it2 = s->extract.begin(); it2 != s->extract.end(); ++it2) {
+                        json v = expr_detail::resolve_ref_path(it2.value().get<std::string>(),
+                                                               output);
+                        job.context[it2.key()] = v;
+                        context_patch[it2.key()] = std::move(v);
+                    }
                     const std::string next = next_after_success(job, *s);
                     s->status = StepStatus::Completed;
                     job.cursor = next;
@@ -668,7 +1026,7 @@ void JobManager::execute(const std::string& id, const std::shared_ptr<Control>&
                     job.status = JobStatus::Failed;
                     job.error = e.what();
                     job.finished_at = iso_now();
-                    persist_locked();
+                    journal_locked(job, {s}, context_patch);
                     LOG(ERROR, "Jobs") << "job " << id << " failed at step '" << step_id
                                        << "' (extract/branch): " << e.what() << std::endl;
                     return;
@@ -680,7 +1038,7 @@ void JobManager::execute(const std::string& id, const std::shared_ptr<Control>&
                     job.status = JobStatus::Failed;
                     job.error = run_error;
                     job.finished_at = iso_now();
-                    persist_locked();
+                    journal_locked(job, {s});
                     LOG(ERROR, "Jobs") << "job " << id << " failed at step '" << step_id << "' (op "
                                        << s->op << "): " << run_error << std::endl;
                     return;
@@ -697,9 +1055,262 @@ void JobManager::execute(const std::string& id, const std::shared_ptr<Control>&
                                          << std::endl;
                 }
             }
-            persist_locked();
+            journal_locked(job, {s}, context_patch);
+        }
+    }
+}
+
+bool JobManager::run_group(const std::string& id, const std::shared_ptr<Control>& ctrl,
+                           const std::string& group) {
+    using clock = std::chrono::steady_clock;
+
+    struct Member {
+        std::string step_id;
+        const OpHandler* handler = nullptr;
+        json params;
+        json output;
+        std::string error;
+        int64_t duration_ms = 0;
+        bool ok = true;
+        StepStreams streams;
+    };
+
+    std::vector<Member> members;
+    json context_snapshot;
+    std::string last_member_id;
+    size_t width = kDefaultGroupWidth;
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = jobs_.find(id);
+        if (it == jobs_.end()) return false;
+        Job& job = it->second;
+
+        if (ctrl->interrupt_requested.load()) {
+            job.status = JobStatus::Interrupted;
+            journal_locked(job);
+            LOG(INFO, "Jobs") << "job " << id << " interrupted before parallel group '" << group
+                              << "'" << std::endl;
+            return false;
+        }
+        if (ctrl->pause_requested.load()) {
+            job.status = JobStatus::Paused;
+            journal_locked(job);
+            LOG(INFO, "Jobs") << "job " << id << " paused before parallel group '" << group << "'"
+                              << std::endl;
+            return false;
+        }
+
+        int max_width = 0;
+        std::vector<const StepRecord*> changed;
+        for (auto& s : job.steps) {
+            if (s.group != group) continue;
+            last_member_id = s.id;
+            if (s.width > max_width) max_width = s.width;
+            if (s.status != StepStatus::Pending) continue;
+
+            bool skip = false;
+            try {
+                skip = !eval_condition(s.when, job.context);
+            } catch (const std::exception& e) {
+                s.status = StepStatus::Failed;
+                s.error = e.what();
+                job.status = JobStatus::Failed;
+                job.error = e.what();
+                job.finished_at = iso_now();
+                journal_locked(job, {&s});
+                return false;
+            }
+            if (skip) {
+                s.status = StepStatus::Skipped;
+                changed.push_back(&s);
+                LOG(DEBUG, "Jobs") << "job " << id << " step '" << s.id
+                                   << "' skipped (when=false)" << std::endl;
+                continue;
+            }
+
+            Member m;
+            m.step_id = s.id;
+            m.handler = registry_.find(s.op);
+            if (!m.handler) {
+                s.status = StepStatus::Failed;
+                s.error = "unknown op '" + s.op + "'";
+                job.status = JobStatus::Failed;
+                job.error = s.error;
+                job.finished_at = iso_now();
+                journal_locked(job, {&s});
+                return false;
+            }
+            try {
+                m.params = resolve_refs(s.params, job.context);
+            } catch (const std::exception& e) {
+                s.status = StepStatus::Failed;
+                s.error = e.what();
+                job.status = JobStatus::Failed;
+                job.error = e.what();
+                job.finished_at = iso_now();
+                journal_locked(job, {&s});
+                return false;
+            }
+            s.status = StepStatus::Running;
+            changed.push_back(&s);
+            members.push_back(std::move(m));
+        }
+
+        // Wire sentence-buffered channels for members consuming a sibling's
+        // token stream. A producer that is not running in this execution (it
+        // completed before a resume, or was skipped) gets its recorded output
+        // replayed into the channel so the consumer still sees the text.
+        for (auto& m : members) {
+            const std::string from = m.params.value("stream_from", "");
+            if (from.empty()) continue;
+            auto channel = std::make_shared<SentenceStream>();
+            m.streams.consume = channel;
+            bool wired = false;
+            for (auto& producer : members) {
+                if (producer.step_id == from) {
+                    producer.streams.produce = channel;
+                    wired = true;
+                    break;
+                }
+            }
+            if (!wired) {
+                if (const StepRecord* ps = find_step(job, from)) {
+                    const json& out = ps->output;
+                    if (out.contains("choices") && out["choices"].is_array()
+                        && !out["choices"].empty()) {
+                        const json message = out["choices"][0].value("message", json::object());
+                        if (message.contains("content") && message["content"].is_string())
+                            channel->append(message["content"].get<std::string>());
+                    }
+                }
+                channel->close();
+            }
         }
+
+        if (max_width > 0) width = (size_t)max_width;
+        context_snapshot = job.context;
+        ctrl->cancel.store(false);
+        journal_locked(job, changed);
+        if (!members.empty())
+            LOG(INFO, "Jobs") << "job " << id << " running parallel group '" << group << "' ("
+                              << members.size() << " step(s), width "
+                              << std::min(width, members.size()) << ")" << std::endl;
     }
+
+    if (!members.empty()) {
+        std::atomic<size_t> next{0};
+        auto run_member = [&] {
+            while (true) {
+                const size_t i = next.fetch_add(1);
+                if (i >= members.size()) return;
+                Member& m = members[i];
+                const auto t0 = clock::now();
+                try {
+                    if ((m.streams.produce || m.streams.consume) && m.handler->run_streamed)
+                        m.output = m.handler->run_streamed(m.params, context_snapshot,
+                                                           ctrl->cancel, m.streams);
+                    else
+                        m.output = m.handler->run(m.params, context_snapshot, ctrl->cancel);
+                } catch (const std::exception& e) {
+                    m.ok = false;
+                    m.error = e.what();
+                }
+                // Unblock any consumer even when the producer failed or has no
+                // streaming-aware handler.
+                if (m.streams.produce) m.streams.produce->close();
+                m.duration_ms = std::chrono::duration_cast<std::chrono::milliseconds>(
+                                    clock::now() - t0)
+                                    .count();
+            }
+        };
+        std::vector<std::thread> pool;
+        for (size_t t = 1; t < std::min(width, members.size()); ++t)
+            pool.emplace_back(run_member);
+        run_member();
+        for (auto& t : pool) t.join();
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = jobs_.find(id);
+        if (it == jobs_.end()) return false;
+        Job& job = it->second;
+
+        if (ctrl->interrupt_requested.load()) {
+            std::vector<const StepRecord*> reverted;
+            for (auto& s : job.steps)
+                if (s.group == group && s.status == StepStatus::Running) {
+                    s.status = StepStatus::Pending;
+                    s.error.clear();
+                    reverted.push_back(&s);
+                }
+            job.status = JobStatus::Interrupted;
+            journal_locked(job, reverted);
+            LOG(INFO, "Jobs") << "job " << id << " interrupted during parallel group '" << group
+                              << "'" << std::endl;
+            return false;
+        }
+
+        bool abort = false;
+        std::string abort_error;
+        std::vector<const StepRecord*> finished;
+        json context_patch = json::object();
+        for (Member& m : members) {
+            StepRecord* s = find_step(job, m.step_id);
+            if (!s) continue;
+            finished.push_back(s);
+            s->duration_ms = m.duration_ms;
+            if (m.ok) {
+                s->output = m.output;
+                job.context[s->id] = m.output;
+                context_patch[s->id] = m.output;
+                try {
+                    for (auto it2 = s->extract.begin(); it2 != s->extract.end(); ++it2) {
+                        json v = expr_detail::resolve_ref_path(it2.value().get<std::string>(),
+                                                               m.output);
+                        job.context[it2.key()] = v;
+                        context_patch[it2.key()] = std::move(v);
+                    }
+                    s->status = StepStatus::Completed;
+                } catch (const std::exception& e) {
+                    s->status = StepStatus::Failed;
+                    s->error = e.what();
+                    if (!abort) {
+                        abort = true;
+                        abort_error = e.what();
+                    }
+                }
+            } else {
+                s->status = StepStatus::Failed;
+                s->error = m.error;
+                if (s->on_fail == kOnFailAbort) {
+                    if (!abort) {
+                        abort = true;
+                        abort_error = m.error;
+                    }
+                } else {
+                    s->failure_handled = true;
+                    LOG(WARNING, "Jobs") << "job " << id << " step '" << m.step_id << "' failed ("
+                                         << m.error << "), continuing" << std::endl;
+                }
+            }
+        }
+        if (abort) {
+            job.status = JobStatus::Failed;
+            job.error = abort_error;
+            job.finished_at = iso_now();
+            journal_locked(job, finished, context_patch);
+            LOG(ERROR, "Jobs") << "job " << id << " failed in parallel group '" << group << "': "
+                               << abort_error << std::endl;
+            return false;
+        }
+        job.cursor = next_in_list(job, last_member_id);
+        journal_locked(job, finished, context_patch);
+        LOG(DEBUG, "Jobs") << "job " << id << " parallel group '" << group << "' completed -> "
+                           << (job.cursor.empty() ? "end" : "'" + job.cursor + "'") << std::endl;
+    }
+    return true;
 }
 
 }
@@ -22,6 +22,13 @@ std::set<std::string> OpRegistry::names() const {
     return out;
 }
 
+std::set<std::string> OpRegistry::streaming_names() const {
+    std::set<std::string> out;
+    for (const auto& kv : handlers_)
+        if (kv.second.run_streamed) out.insert(kv.first);
+    return out;
+}
+
 OpRegistry build_op_registry(OpProviders providers) {
     OpRegistry reg;
 
@@ -63,23 +70,53 @@ OpRegistry build_op_registry(OpProviders providers) {
     reg.register_op("load", {[providers](const json& params, const json&, CancelFlag& cancel) -> json {
         if (!providers.load_op) throw JobError(501, "load op not available");
         return providers.load_op(params, cancel);
-    }, true});
+    }, true, false});
 
     reg.register_op("unload", {[providers](const json& params, const json&, CancelFlag& cancel) -> json {
         if (!providers.unload_op) throw JobError(501, "unload op not available");
         return providers.unload_op(params, cancel);
-    }, true});
+    }, true, false});
 
-    reg.register_op("chat", {[providers](const json& params, const json&, CancelFlag& cancel) -> json {
+    OpHandler chat;
+    chat.run = [providers](const json& params, const json&, CancelFlag& cancel) -> json {
         if (!providers.chat_op) throw JobError(501, "chat op not available");
         return providers.chat_op(params, cancel);
-    }, true});
+    };
+    chat.exclusive = true;
+    chat.run_streamed = [providers](const json& params, const json&, CancelFlag& cancel,
+                                    const StepStreams& streams) -> json {
+        if (providers.chat_stream_op) return providers.chat_stream_op(params, cancel, streams);
+        if (!providers.chat_op) throw JobError(501, "chat op not available");
+        return providers.chat_op(params, cancel);
+    };
+    reg.register_op("chat", chat);
+
+    reg.register_op("bench", {[providers](const json& params, const json&, CancelFlag& cancel) -> json {
+        if (!providers.bench_op) throw JobError(501, "bench op not available");
+        return providers.bench_op(params, cancel);
+    }, true, false});
+
+    reg.register_op("calibrate", {[providers](const json& params, const json&, CancelFlag& cancel) -> json {
+        if (!providers.calibrate_op) throw JobError(501, "calibrate op not available");
+        return providers.calibrate_op(params, cancel);
+    }, true, false});
+
+    reg.register_op("model_gc", {[providers](const json& params, const json&, CancelFlag& cancel) -> json {
+        if (!providers.model_gc_op) throw JobError(501, "model_gc op not available");
+        return providers.model_gc_op(params, cancel);
+    }, false});
+
+    reg.register_op("cache_gc", {[providers](const json&, const json&, CancelFlag& cancel) -> json {
+        if (!providers.cache_gc_op) throw JobError(501, "cache_gc op not available");
+        return providers.cache_gc_op(cancel);
+    }, false});
 
     reg.begin_exclusive = providers.begin_exclusive;
     reg.end_exclusive = providers.end_exclusive;
     reg.reconcile_unload = providers.reconcile_unload;
     reg.restore_exclusive = providers.restore_exclusive;
     reg.discard_exclusive = providers.discard_exclusive;
+    reg.interactive_pressure = providers.interactive_pressure;
 
     return reg;
 }
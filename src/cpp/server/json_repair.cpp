@@ -0,0 +1,145 @@
+#include "lemon/json_repair.h"
+
+namespace lemon {
+
+namespace {
+constexpr size_t kMaxDepth = 128;
+constexpr size_t kMaxRepairBytes = 1 << 20;
+
+bool is_json_ws(char c) {
+    return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+}
+} // namespace
+
+void StreamingJsonValidator::feed(const std::string& chunk) {
+    for (char c : chunk) {
+        if (invalid_) {
+            return;
+        }
+
+        if (in_string_) {
+            if (escape_) {
+                escape_ = false;
+            } else if (c == '\\') {
+                escape_ = true;
+            } else if (c == '"') {
+                in_string_ = false;
+                if (stack_.empty()) {
+                    complete_ = true;
+                }
+            }
+            continue;
+        }
+
+        if (is_json_ws(c)) {
+            continue;
+        }
+        if (complete_) {
+            invalid_ = true;
+            return;
+        }
+
+        switch (c) {
+        case '"':
+            in_string_ = true;
+            break;
+        case '{':
+        case '[':
+            if (stack_.size() >= kMaxDepth) {
+                invalid_ = true;
+                return;
+            }
+            stack_.push_back(c);
+            break;
+        case '}':
+        case ']':
+            if (stack_.empty() || stack_.back() != (c == '}' ? '{' : '[')) {
+                invalid_ = true;
+                return;
+            }
+            stack_.pop_back();
+            if (stack_.empty()) {
+                complete_ = true;
+            }
+            break;
+        default:
+            break;
+        }
+    }
+}
+
+std::string StreamingJsonValidator::closing_suffix() const {
+    if (invalid_ || complete_) {
+        return "";
+    }
+    std::string suffix;
+    if (in_string_) {
+        if (escape_) {
+            // Completes the pending escape as an escaped quote so the
+            // closing quote that follows is not swallowed.
+            suffix += '"';
+        }
+        suffix += '"';
+    }
+    for (auto it = stack_.rbegin(); it != stack_.rend(); ++it) {
+        suffix += (*it == '{') ? '}' : ']';
+    }
+    return suffix;
+}
+
+void StreamingJsonValidator::reset() {
+    stack_.clear();
+    in_string_ = false;
+    escape_ = false;
+    invalid_ = false;
+    complete_ = false;
+}
+
+std::optional<nlohmann::json> parse_or_repair_json(const std::string& text,
+                                                   bool* repaired) {
+    if (repaired) {
+        *repaired = false;
+    }
+
+    {
+        auto parsed = nlohmann::json::parse(text, nullptr, false);
+        if (!parsed.is_discarded()) {
+            return parsed;
+        }
+    }
+
+    if (text.size() > kMaxRepairBytes) {
+        return std::nullopt;
+    }
+
+    StreamingJsonValidator validator;
+    validator.feed(text);
+    if (validator.invalid()) {
+        return std::nullopt;
+    }
+
+    std::string candidate = text;
+    while (!candidate.empty() && is_json_ws(candidate.back())) {
+        candidate.pop_back();
+    }
+    if (!validator.in_string()) {
+        while (!candidate.empty() && candidate.back() == ',') {
+            candidate.pop_back();
+            while (!candidate.empty() && is_json_ws(candidate.back())) {
+                candidate.pop_back();
+            }
+        }
+    }
+    candidate += validator.closing_suffix();
+
+    auto parsed = nlohmann::json::parse(candidate, nullptr, false);
+    if (parsed.is_discarded()) {
+        return std::nullopt;
+    }
+    if (repaired) {
+        *repaired = true;
+    }
+    return parsed;
+}
+
+} // namespace lemon
@@ -0,0 +1,114 @@
+#include "lemon/latency_histograms.h"
+
+#include <cmath>
+
+namespace lemon {
+
+namespace {
+
+constexpr size_t kMaxSeriesPerMetric = 200;
+
+constexpr double kQueueWaitBounds[] = {
+    0.001, 0.005, 0.025, 0.1, 0.25, 0.5, 1.0, 2.5, 5.0, 10.0, 30.0, 60.0
+};
+constexpr double kBackendBounds[] = {
+    0.01, 0.05, 0.1, 0.25, 0.5, 1.0, 2.5, 5.0, 10.0, 30.0, 60.0, 120.0, 300.0
+};
+constexpr double kTtftBounds[] = {
+    0.05, 0.1, 0.25, 0.5, 1.0, 2.5, 5.0, 10.0, 20.0, 60.0
+};
+constexpr double kTokensPerSecondBounds[] = {
+    1.0, 2.0, 5.0, 10.0, 20.0, 50.0, 100.0, 200.0, 500.0
+};
+
+template<size_t N>
+constexpr size_t array_size(const double (&)[N]) {
+    return N;
+}
+
+} // namespace
+
+LatencyHistograms& LatencyHistograms::instance() {
+    static LatencyHistograms histograms;
+    return histograms;
+}
+
+void LatencyHistograms::observe_queue_wait(const std::string& endpoint, const std::string& model,
+                                           const std::string& backend, double seconds) {
+    observe("lemonade_request_queue_wait_seconds", kQueueWaitBounds,
+            array_size(kQueueWaitBounds), endpoint, model, backend, seconds);
+}
+
+void LatencyHistograms::observe_backend_duration(const std::string& endpoint,
+                                                 const std::string& model,
+                                                 const std::string& backend, double seconds) {
+    observe("lemonade_request_backend_seconds", kBackendBounds,
+            array_size(kBackendBounds), endpoint, model, backend, seconds);
+}
+
+void LatencyHistograms::observe_time_to_first_token(const std::string& model,
+                                                    const std::string& backend, double seconds) {
+    observe("lemonade_time_to_first_token_seconds", kTtftBounds,
+            array_size(kTtftBounds), "", model, backend, seconds);
+}
+
+void LatencyHistograms::observe_tokens_per_second(const std::string& model,
+                                                  const std::string& backend,
+                                                  double tokens_per_second) {
+    observe("lemonade_tokens_per_second", kTokensPerSecondBounds,
+            array_size(kTokensPerSecondBounds), "", model, backend, tokens_per_second);
+}
+
+std::vector<LatencyHistograms::Series> LatencyHistograms::snapshot() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::vector<Series> result;
+    result.reserve(series_.size());
+    for (const auto& kv : series_) {
+        result.push_back(kv.second);
+    }
+    return result;
+}
+
+void LatencyHistograms::observe(const char* metric, const double* bounds, size_t bound_count,
+                                const std::string& endpoint, const std::string& model,
+                                const std::string& backend, double value) {
+    if (!std::isfinite(value) || value < 0.0) {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::string key = std::string(metric) + "\n" + endpoint + "\n" + model + "\n" + backend;
+    auto it = series_.find(key);
+    if (it == series_.end()) {
+        std::string folded_model = model;
+        if (series_per_metric_[metric] >= kMaxSeriesPerMetric) {
+            folded_model = "other";
+            key = std::string(metric) + "\n" + endpoint + "\nother\n" + backend;
+            it = series_.find(key);
+        }
+        if (it == series_.end()) {
+            Series series;
+            series.metric = metric;
+            series.endpoint = endpoint;
+            series.model = folded_model;
+            series.backend = backend;
+            series.upper_bounds = bounds;
+            series.bound_count = bound_count;
+            series.buckets.assign(bound_count, 0);
+            it = series_.emplace(std::move(key), std::move(series)).first;
+            series_per_metric_[metric]++;
+        }
+    }
+
+    Series& series = it->second;
+    for (size_t i = 0; i < series.bound_count; ++i) {
+        if (value <= series.upper_bounds[i]) {
+            series.buckets[i]++;
+            break;
+        }
+    }
+    series.observations++;
+    series.sum += value;
+}
+
+} // namespace lemon
@@ -14,27 +14,55 @@ json LogStreamEntry::to_json() const {
     };
 }
 
+bool LogStreamFilter::matches(const LogStreamEntry& entry) const {
+    if (min_severity.has_value() && entry.severity_value < *min_severity) {
+        return false;
+    }
+    if (tag.has_value() && entry.tag != *tag) {
+        return false;
+    }
+    if (pattern.has_value() && !std::regex_search(entry.line, *pattern)) {
+        return false;
+    }
+    return true;
+}
+
 LogStreamHub& LogStreamHub::instance() {
     static LogStreamHub hub;
     return hub;
 }
 
+LogStreamHub::~LogStreamHub() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        shutdown_ = true;
+    }
+    flusher_cv_.notify_all();
+    if (flusher_.joinable()) {
+        flusher_.join();
+    }
+}
+
 std::string LogStreamHub::subscribe_with_snapshot(
     SubscriberCallback callback,
     std::optional<uint64_t> after_seq,
-    std::vector<LogStreamEntry>& out_snapshot) {
+    std::vector<LogStreamEntry>& out_snapshot,
+    LogStreamFilter filter) {
     std::lock_guard<std::mutex> lock(mutex_);
 
     out_snapshot.clear();
     out_snapshot.reserve(entries_.size());
     for (const auto& entry : entries_) {
-        if (!after_seq.has_value() || entry.seq > *after_seq) {
+        if ((!after_seq.has_value() || entry.seq > *after_seq) && filter.matches(entry)) {
             out_snapshot.push_back(entry);
         }
     }
 
     std::string subscriber_id = next_subscriber_id();
-    subscribers_.emplace(subscriber_id, std::move(callback));
+    Subscriber& subscriber = subscribers_[subscriber_id];
+    subscriber.callback = std::move(callback);
+    subscriber.filter = std::move(filter);
+    ensure_flusher_locked();
     return subscriber_id;
 }
 
@@ -49,8 +77,9 @@ void LogStreamHub::publish(const AixLog::Metadata& metadata, const std::string&
     entry.severity = AixLog::to_string(metadata.severity);
     entry.tag = resolve_tag(metadata);
     entry.line = formatted_line;
+    entry.severity_value = metadata.severity;
 
-    std::vector<SubscriberCallback> callbacks;
+    std::vector<std::pair<SubscriberCallback, std::vector<LogStreamEntry>>> full_batches;
 
     {
         std::lock_guard<std::mutex> lock(mutex_);
@@ -60,16 +89,56 @@ void LogStreamHub::publish(const AixLog::Metadata& metadata, const std::string&
             entries_.pop_front();
         }
 
-        callbacks.reserve(subscribers_.size());
-        for (const auto& [_, callback] : subscribers_) {
-            callbacks.push_back(callback);
+        for (auto& [_, subscriber] : subscribers_) {
+            if (!subscriber.filter.matches(entry)) {
+                continue;
+            }
+            subscriber.pending.push_back(entry);
+            if (subscriber.pending.size() >= kBatchMaxEntries) {
+                full_batches.emplace_back(subscriber.callback,
+                                          std::move(subscriber.pending));
+                subscriber.pending.clear();
+            }
         }
     }
 
     // Invoke callbacks outside the lock to avoid deadlocking if a callback
     // ends up logging (which would re-enter publish via the HubPublishingSink).
-    for (const auto& callback : callbacks) {
-        callback(entry);
+    for (const auto& [callback, batch] : full_batches) {
+        callback(batch);
+    }
+}
+
+void LogStreamHub::ensure_flusher_locked() {
+    if (!flusher_.joinable()) {
+        flusher_ = std::thread([this] { flusher_loop(); });
+    }
+}
+
+void LogStreamHub::flusher_loop() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (!shutdown_) {
+        flusher_cv_.wait_for(lock, kBatchMaxDelay);
+        if (shutdown_) {
+            break;
+        }
+
+        std::vector<std::pair<SubscriberCallback, std::vector<LogStreamEntry>>> batches;
+        for (auto& [_, subscriber] : subscribers_) {
+            if (!subscriber.pending.empty()) {
+                batches.emplace_back(subscriber.callback, std::move(subscriber.pending));
+                subscriber.pending.clear();
+            }
+        }
+        if (batches.empty()) {
+            continue;
+        }
+
+        lock.unlock();
+        for (const auto& [callback, batch] : batches) {
+            callback(batch);
+        }
+        lock.lock();
     }
 }
 
@@ -77,6 +146,24 @@ std::string LogStreamHub::next_subscriber_id() {
     return "log-sub-" + std::to_string(next_subscriber_++);
 }
 
+size_t LogStreamHub::approx_bytes() const {
+    auto entry_bytes = [](const LogStreamEntry& entry) {
+        return sizeof(LogStreamEntry) + entry.timestamp.size() +
+               entry.severity.size() + entry.tag.size() + entry.line.size();
+    };
+    std::lock_guard<std::mutex> lock(mutex_);
+    size_t bytes = 0;
+    for (const auto& entry : entries_) {
+        bytes += entry_bytes(entry);
+    }
+    for (const auto& [id, subscriber] : subscribers_) {
+        for (const auto& entry : subscriber.pending) {
+            bytes += entry_bytes(entry);
+        }
+    }
+    return bytes;
+}
+
 std::string LogStreamHub::resolve_tag(const AixLog::Metadata& metadata) {
     if (metadata.tag) {
         return metadata.tag.text;
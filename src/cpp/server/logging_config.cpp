@@ -1,10 +1,12 @@
 #include "lemon/logging_config.h"
 
+#include "lemon/async_log_sink.h"
 #include "lemon/log_stream.h"
 #include "lemon/runtime_config.h"
 #include "lemon/system_info.h"
 #include "lemon/utils/path_utils.h"
 
+#include <cstdlib>
 #include <fstream>
 #include <mutex>
 #include <sstream>
@@ -75,11 +77,14 @@ std::vector<std::shared_ptr<AixLog::Sink>> build_logging_sinks(
             *targets.file_path,
             RuntimeConfig::LOG_FORMAT));
     }
+    if (targets.json_file && targets.json_file_path.has_value()) {
+        sinks.push_back(std::make_shared<JsonLinesSink>(filter, *targets.json_file_path));
+    }
     if (targets.stream_hub) {
         sinks.push_back(std::make_shared<HubPublishingSink>(filter, RuntimeConfig::LOG_FORMAT));
     }
 
-    return sinks;
+    return {std::make_shared<AsyncLogSink>(filter, std::move(sinks))};
 }
 
 LoggingTargets& active_logging_targets() {
@@ -122,6 +127,17 @@ LoggingTargets resolve_logging_targets(LoggingMode mode) {
 #endif
     }
 
+    const char* json_logs = std::getenv("LEMONADE_JSON_LOGS");
+    if (json_logs && (std::string(json_logs) == "1" || std::string(json_logs) == "true" ||
+                      std::string(json_logs) == "True" || std::string(json_logs) == "TRUE")) {
+        targets.json_file = true;
+#ifdef _WIN32
+        targets.json_file_path = utils::get_runtime_dir() + "lemonade-server.jsonl";
+#else
+        targets.json_file_path = utils::get_runtime_dir() + "/lemonade-server.jsonl";
+#endif
+    }
+
     return targets;
 }
 
@@ -0,0 +1,216 @@
+#include "lemon/long_audio.h"
+
+#include "lemon/vad.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace lemon {
+namespace audio {
+
+namespace {
+
+uint32_t read_u32(const uint8_t* bytes) {
+    return static_cast<uint32_t>(bytes[0]) | (static_cast<uint32_t>(bytes[1]) << 8) |
+           (static_cast<uint32_t>(bytes[2]) << 16) | (static_cast<uint32_t>(bytes[3]) << 24);
+}
+
+uint16_t read_u16(const uint8_t* bytes) {
+    return static_cast<uint16_t>(bytes[0] | (bytes[1] << 8));
+}
+
+}  // namespace
+
+bool parse_wav_pcm16(const uint8_t* bytes, size_t size, WavInfo& info) {
+    if (size < 44 || std::memcmp(bytes, "RIFF", 4) != 0 ||
+        std::memcmp(bytes + 8, "WAVE", 4) != 0) {
+        return false;
+    }
+
+    bool have_fmt = false;
+    size_t offset = 12;
+    while (offset + 8 <= size) {
+        const uint32_t chunk_size = read_u32(bytes + offset + 4);
+        const uint8_t* chunk_id = bytes + offset;
+        const size_t chunk_data = offset + 8;
+
+        if (std::memcmp(chunk_id, "fmt ", 4) == 0) {
+            if (chunk_size < 16 || chunk_data + 16 > size) {
+                return false;
+            }
+            const uint16_t audio_format = read_u16(bytes + chunk_data);
+            const uint16_t bits_per_sample = read_u16(bytes + chunk_data + 14);
+            if (audio_format != 1 || bits_per_sample != 16) {
+                return false;
+            }
+            info.channels = read_u16(bytes + chunk_data + 2);
+            info.sample_rate = static_cast<int>(read_u32(bytes + chunk_data + 4));
+            have_fmt = true;
+        } else if (std::memcmp(chunk_id, "data", 4) == 0) {
+            if (!have_fmt || info.channels <= 0 || info.sample_rate <= 0) {
+                return false;
+            }
+            const size_t available = std::min(static_cast<size_t>(chunk_size),
+                                              size - chunk_data);
+            if (chunk_data % 2 != 0) {
+                return false;
+            }
+            info.data_offset = chunk_data;
+            info.num_samples = available / sizeof(int16_t) /
+                               static_cast<size_t>(info.channels);
+            return info.num_samples > 0;
+        }
+
+        // Chunks are word-aligned; odd-sized ones carry a pad byte
+        offset = chunk_data + chunk_size + (chunk_size % 2);
+    }
+    return false;
+}
+
+std::vector<std::pair<size_t, size_t>> plan_chunks(
+    const int16_t* samples, size_t count, int sample_rate,
+    const ChunkPolicy& policy) {
+    std::vector<std::pair<size_t, size_t>> chunks;
+    if (count == 0 || sample_rate <= 0) {
+        return chunks;
+    }
+
+    const size_t frame = static_cast<size_t>(sample_rate) * policy.frame_ms / 1000;
+    if (frame == 0) {
+        // Sub-50 Hz rates only appear in crafted headers; refuse to plan
+        // rather than divide by zero below.
+        return chunks;
+    }
+    const size_t num_frames = (count + frame - 1) / frame;
+
+    std::vector<bool> silent(num_frames, false);
+    std::vector<float> scratch(frame);
+    for (size_t f = 0; f < num_frames; ++f) {
+        const size_t begin = f * frame;
+        const size_t len = std::min(frame, count - begin);
+        for (size_t i = 0; i < len; ++i) {
+            scratch[i] = static_cast<float>(samples[begin + i]) / 32768.0f;
+        }
+        const float rms =
+            std::sqrt(SimpleVAD::sum_squares(scratch.data(), len) /
+                      static_cast<float>(len));
+        silent[f] = rms < policy.silence_rms_threshold;
+    }
+
+    const size_t min_silence_frames =
+        std::max<size_t>(1, static_cast<size_t>(policy.min_silence_ms) / policy.frame_ms);
+    const size_t target = static_cast<size_t>(sample_rate) * policy.target_seconds;
+    const size_t max_len = static_cast<size_t>(sample_rate) * policy.max_seconds;
+    const size_t min_len = static_cast<size_t>(sample_rate) * policy.min_seconds;
+
+    size_t begin = 0;
+    while (begin < count) {
+        if (count - begin <= max_len) {
+            chunks.emplace_back(begin, count);
+            break;
+        }
+
+        const size_t window_lo = begin + std::max(min_len, frame);
+        const size_t window_hi = begin + max_len;
+        const size_t preferred = begin + target;
+
+        // Find the center of the silence run closest to the target length
+        size_t best_cut = 0;
+        size_t best_distance = count;
+        size_t run_start = 0;
+        size_t run_length = 0;
+        const size_t frame_lo = window_lo / frame;
+        const size_t frame_hi = std::min(window_hi / frame, num_frames);
+        for (size_t f = frame_lo; f <= frame_hi; ++f) {
+            const bool in_run = f < frame_hi && silent[f];
+            if (in_run) {
+                if (run_length == 0) run_start = f;
+                ++run_length;
+                continue;
+            }
+            if (run_length >= min_silence_frames) {
+                const size_t cut = (run_start + run_length / 2) * frame;
+                const size_t distance =
+                    cut > preferred ? cut - preferred : preferred - cut;
+                if (cut > begin && cut < count && distance < best_distance) {
+                    best_distance = distance;
+                    best_cut = cut;
+                }
+            }
+            run_length = 0;
+        }
+
+        const size_t end = (best_cut != 0) ? best_cut : window_hi;
+        chunks.emplace_back(begin, end);
+        begin = end;
+    }
+
+    // Fold a trailing sliver into the previous chunk
+    if (chunks.size() >= 2 &&
+        chunks.back().second - chunks.back().first < min_len) {
+        chunks[chunks.size() - 2].second = chunks.back().second;
+        chunks.pop_back();
+    }
+    return chunks;
+}
+
+std::vector<uint8_t> make_wav(const int16_t* samples, size_t count, int sample_rate) {
+    const uint32_t data_size = static_cast<uint32_t>(count * sizeof(int16_t));
+    const uint32_t byte_rate = static_cast<uint32_t>(sample_rate) * sizeof(int16_t);
+
+    std::vector<uint8_t> wav;
+    wav.reserve(44 + data_size);
+
+    auto write_u16 = [&wav](uint16_t val) {
+        wav.push_back(val & 0xFF);
+        wav.push_back((val >> 8) & 0xFF);
+    };
+    auto write_u32 = [&wav](uint32_t val) {
+        wav.push_back(val & 0xFF);
+        wav.push_back((val >> 8) & 0xFF);
+        wav.push_back((val >> 16) & 0xFF);
+        wav.push_back((val >> 24) & 0xFF);
+    };
+
+    wav.push_back('R'); wav.push_back('I'); wav.push_back('F'); wav.push_back('F');
+    write_u32(36 + data_size);
+    wav.push_back('W'); wav.push_back('A'); wav.push_back('V'); wav.push_back('E');
+
+    wav.push_back('f'); wav.push_back('m'); wav.push_back('t'); wav.push_back(' ');
+    write_u32(16);
+    write_u16(1);  // PCM
+    write_u16(1);  // mono
+    write_u32(static_cast<uint32_t>(sample_rate));
+    write_u32(byte_rate);
+    write_u16(sizeof(int16_t));  // block align
+    write_u16(16);               // bits per sample
+
+    wav.push_back('d'); wav.push_back('a'); wav.push_back('t'); wav.push_back('a');
+    write_u32(data_size);
+    for (size_t i = 0; i < count; ++i) {
+        const uint16_t val = static_cast<uint16_t>(samples[i]);
+        wav.push_back(val & 0xFF);
+        wav.push_back((val >> 8) & 0xFF);
+    }
+    return wav;
+}
+
+std::string stitch_transcripts(const std::vector<std::string>& pieces) {
+    std::string result;
+    for (const auto& piece : pieces) {
+        size_t first = piece.find_first_not_of(" \t\r\n");
+        if (first == std::string::npos) {
+            continue;
+        }
+        size_t last = piece.find_last_not_of(" \t\r\n");
+        if (!result.empty()) {
+            result += ' ';
+        }
+        result.append(piece, first, last - first + 1);
+    }
+    return result;
+}
+
+}  // namespace audio
+}  // namespace lemon
@@ -10,6 +10,7 @@
 #include <lemon/system_info.h>
 #include <lemon/version.h>
 #include <lemon/utils/path_utils.h>
+#include <lemon/utils/rendezvous_channel.h>
 #include <lemon/utils/aixlog.hpp>
 
 #ifndef _WIN32
@@ -91,6 +92,11 @@ int main(int argc, char** argv) {
         auto config = std::make_shared<RuntimeConfig>(config_json);
         RuntimeConfig::set_global(config.get());
 
+        // Claim the rendezvous channel before the slow startup work so CLI
+        // clients can already resolve the port while the server is starting.
+        utils::RendezvousChannel::global().set_state("starting", config->port());
+        utils::RendezvousChannel::global().start();
+
         // Initialize logging with the configured level — console + file + log hub
         configure_application_logging(config->log_level(), LoggingMode::direct_server);
 
@@ -57,6 +57,7 @@ constexpr int kDefaultTimeoutMs = 30000;
 constexpr int kMinTimeoutMs = 1000;
 constexpr int kMaxTimeoutMs = 300000;
 constexpr int kMaxToolListPages = 32;
+constexpr std::chrono::seconds kToolsCatalogTtl{5};
 constexpr std::size_t kReadBufferBytes = 8192;
 constexpr std::size_t kMaxMessageBytes = 64U * 1024U * 1024U;
 
@@ -1918,6 +1919,11 @@ void McpClientManager::register_routes(httplib::Server& server) {
             }
         });
 
+    server.Post("/internal/mcp/servers/connect-all",
+                [self](const httplib::Request&, httplib::Response& res) {
+                    set_json(res, self->connect_all_json());
+                });
+
     server.Post(
         R"(/internal/mcp/servers/([A-Za-z0-9_.-]+)/disconnect)",
         [self](const httplib::Request& req, httplib::Response& res) {
@@ -1963,6 +1969,7 @@ void McpClientManager::stop_all() {
     for (auto& [_, runtime] : runtimes) {
         if (runtime) runtime->disconnect();
     }
+    invalidate_tools_cache();
 }
 
 McpServerConfig McpClientManager::parse_server_config_json(
@@ -2195,6 +2202,14 @@ json McpClientManager::list_servers_json() const {
 }
 
 json McpClientManager::list_tools_json() const {
+    {
+        std::lock_guard<std::mutex> cache_lock(tools_cache_mutex_);
+        if (!tools_cache_.is_null() &&
+            std::chrono::steady_clock::now() - tools_cache_at_ < kToolsCatalogTtl) {
+            return tools_cache_;
+        }
+    }
+
     std::vector<std::pair<McpServerConfig, std::shared_ptr<Runtime>>> entries;
     {
         std::lock_guard<std::mutex> lock(mutex_);
@@ -2234,7 +2249,19 @@ json McpClientManager::list_tools_json() const {
                       openai_tool_from_mcp_tool(config, tool)}});
         }
     }
-    return json{{"tools", std::move(tools_json)}};
+
+    json catalog{{"tools", std::move(tools_json)}};
+    {
+        std::lock_guard<std::mutex> cache_lock(tools_cache_mutex_);
+        tools_cache_ = catalog;
+        tools_cache_at_ = std::chrono::steady_clock::now();
+    }
+    return catalog;
+}
+
+void McpClientManager::invalidate_tools_cache() const {
+    std::lock_guard<std::mutex> cache_lock(tools_cache_mutex_);
+    tools_cache_ = json(nullptr);
 }
 
 json McpClientManager::upsert_server_json(const json& body) {
@@ -2264,6 +2291,7 @@ json McpClientManager::upsert_server_json(const json& body) {
         }
     }
     if (old_runtime) old_runtime->disconnect();
+    invalidate_tools_cache();
     return json{{"server", config_to_json(config, false)}};
 }
 
@@ -2286,6 +2314,7 @@ json McpClientManager::remove_server_json(const std::string& id) {
         }
     }
     if (runtime) runtime->disconnect();
+    invalidate_tools_cache();
     return json{{"removed", id}};
 }
 
@@ -2296,9 +2325,50 @@ json McpClientManager::connect_server_json(const std::string& id) {
     }
     const auto runtime = get_or_create_runtime(config);
     runtime->connect(config);
+    invalidate_tools_cache();
     return json{{"server", runtime->snapshot(false)}};
 }
 
+json McpClientManager::connect_all_json() {
+    std::vector<McpServerConfig> targets;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (const auto& [id, config] : configs_) {
+            if (config.enabled) targets.push_back(config);
+        }
+    }
+
+    // One thread per upstream: connect + initialize + tools/list are
+    // dominated by the child process round trips, so the fan-out turns N
+    // serial handshakes into max-of-N.
+    std::vector<json> results(targets.size());
+    std::vector<std::thread> workers;
+    workers.reserve(targets.size());
+    for (size_t i = 0; i < targets.size(); ++i) {
+        workers.emplace_back([this, &targets, &results, i] {
+            const McpServerConfig& config = targets[i];
+            try {
+                const auto runtime = get_or_create_runtime(config);
+                runtime->connect(config);
+                results[i] = runtime->snapshot(false);
+            } catch (const std::exception& e) {
+                json item = config_to_json(config, false);
+                item["status"] = "error";
+                item["connected"] = false;
+                item["last_error"] = e.what();
+                results[i] = std::move(item);
+            }
+        });
+    }
+    for (auto& worker : workers) worker.join();
+
+    invalidate_tools_cache();
+
+    json servers = json::array();
+    for (auto& result : results) servers.push_back(std::move(result));
+    return json{{"servers", std::move(servers)}};
+}
+
 json McpClientManager::disconnect_server_json(const std::string& id) {
     McpServerConfig config;
     std::shared_ptr<Runtime> runtime;
@@ -2313,6 +2383,7 @@ json McpClientManager::disconnect_server_json(const std::string& id) {
         if (runtime_it != runtimes_.end()) runtime = runtime_it->second;
     }
     if (runtime) runtime->disconnect();
+    invalidate_tools_cache();
 
     json state = config_to_json(config, false);
     state["status"] = "disconnected";
@@ -2333,6 +2404,7 @@ json McpClientManager::refresh_tools_json(const std::string& id) {
     const auto runtime = get_or_create_runtime(config);
     runtime->connect(config);
     runtime->refresh_tools();
+    invalidate_tools_cache();
     return json{{"server", runtime->snapshot(false)}};
 }
 
@@ -2519,22 +2591,25 @@ std::string McpClientManager::next_id_locked(
     return id;
 }
 
-void register_mcp_client_routes(httplib::Server& server,
-                                const std::string& cache_dir) {
+std::shared_ptr<McpClientManager> get_mcp_client_manager(
+    const std::string& cache_dir) {
     static std::mutex managers_mutex;
     static std::map<std::string, std::weak_ptr<McpClientManager>> managers;
 
+    std::lock_guard<std::mutex> lock(managers_mutex);
+    const auto it = managers.find(cache_dir);
     std::shared_ptr<McpClientManager> manager;
-    {
-        std::lock_guard<std::mutex> lock(managers_mutex);
-        const auto it = managers.find(cache_dir);
-        if (it != managers.end()) manager = it->second.lock();
-        if (!manager) {
-            manager = std::make_shared<McpClientManager>(cache_dir);
-            managers[cache_dir] = manager;
-        }
+    if (it != managers.end()) manager = it->second.lock();
+    if (!manager) {
+        manager = std::make_shared<McpClientManager>(cache_dir);
+        managers[cache_dir] = manager;
     }
-    manager->register_routes(server);
+    return manager;
+}
+
+void register_mcp_client_routes(httplib::Server& server,
+                                const std::string& cache_dir) {
+    get_mcp_client_manager(cache_dir)->register_routes(server);
 }
 
 }  // namespace lemon
@@ -7,6 +7,7 @@
 #include <filesystem>
 #include <fstream>
 #include <iomanip>
+#include <map>
 #include <mutex>
 #include <sstream>
 #include <string>
@@ -18,6 +19,8 @@
 
 #include "lemon/collection_orchestrator.h"
 #include "lemon/model_types.h"
+#include "lemon/sse_writer.h"
+#include "lemon/streaming_proxy.h"
 #include "lemon/utils/json_utils.h"
 #include "lemon/utils/path_utils.h"
 #include "lemon/version.h"
@@ -226,9 +229,29 @@ void McpServer::register_routes(httplib::Server& server) {
     auto self = shared_from_this();
 
     server.Post("/mcp", [self](const httplib::Request& req, httplib::Response& res) {
+        // Sessions are opt-in: only requests presenting an Mcp-Session-Id are
+        // validated against the registry, so stateless clients keep working.
+        SessionContext ctx;
+        const std::string session_id = req.get_header_value("Mcp-Session-Id");
+        if (!session_id.empty()) {
+            ctx.session = self->sessions_.find(session_id);
+            if (!ctx.session) {
+                // Per Streamable HTTP, 404 tells the client to re-initialize.
+                res.status = 404;
+                json err = make_error_response(nullptr, kJsonRpcInvalidRequest,
+                                               "Unknown or expired Mcp-Session-Id");
+                res.set_content(err.dump(), "application/json");
+                return;
+            }
+        }
+
+        if (self->try_stream_tools_call(req, res)) {
+            return;
+        }
+
         std::string response_body;
         try {
-            response_body = self->handle_request_body(req.body);
+            response_body = self->handle_request_body(req.body, ctx);
         } catch (const std::exception& e) {
             LOG(ERROR, "McpServer") << "Unhandled exception in POST /mcp: " << e.what() << std::endl;
             res.status = 500;
@@ -237,6 +260,10 @@ void McpServer::register_routes(httplib::Server& server) {
             return;
         }
 
+        if (!ctx.assigned_session_id.empty()) {
+            res.set_header("Mcp-Session-Id", ctx.assigned_session_id);
+        }
+
         if (response_body.empty()) {
             // All messages were notifications — Streamable HTTP expects 202.
             res.status = 202;
@@ -247,6 +274,18 @@ void McpServer::register_routes(httplib::Server& server) {
         res.set_content(response_body, "application/json");
     });
 
+    server.Delete("/mcp", [self](const httplib::Request& req, httplib::Response& res) {
+        const std::string session_id = req.get_header_value("Mcp-Session-Id");
+        if (session_id.empty()) {
+            res.status = 400;
+            json err = make_error_response(nullptr, kJsonRpcInvalidRequest,
+                                           "DELETE /mcp requires an Mcp-Session-Id header");
+            res.set_content(err.dump(), "application/json");
+            return;
+        }
+        res.status = self->sessions_.remove(session_id) ? 204 : 404;
+    });
+
     server.Get("/mcp", [](const httplib::Request&, httplib::Response& res) {
         // No SSE channel in this MVP; refuse GET explicitly.
         res.status = 405;
@@ -260,6 +299,11 @@ void McpServer::register_routes(httplib::Server& server) {
 }
 
 std::string McpServer::handle_request_body(const std::string& body) {
+    SessionContext ctx;
+    return handle_request_body(body, ctx);
+}
+
+std::string McpServer::handle_request_body(const std::string& body, SessionContext& ctx) {
     json parsed;
     try {
         parsed = json::parse(body);
@@ -277,7 +321,7 @@ std::string McpServer::handle_request_body(const std::string& body) {
         }
         json responses = json::array();
         for (const auto& message : parsed) {
-            json reply = dispatch_message(message);
+            json reply = dispatch_message(message, ctx);
             if (!reply.is_null()) {
                 responses.push_back(std::move(reply));
             }
@@ -291,12 +335,12 @@ std::string McpServer::handle_request_body(const std::string& body) {
                                        "Request must be a JSON object or array");
         return err.dump();
     }
-    json reply = dispatch_message(parsed);
+    json reply = dispatch_message(parsed, ctx);
     if (reply.is_null()) return "";
     return reply.dump();
 }
 
-json McpServer::dispatch_message(const json& message) {
+json McpServer::dispatch_message(const json& message, SessionContext& ctx) {
     if (!message.is_object()) {
         return make_error_response(nullptr, kJsonRpcInvalidRequest,
                                    "Request must be a JSON object");
@@ -313,14 +357,18 @@ json McpServer::dispatch_message(const json& message) {
     const std::string method = message["method"].get<std::string>();
     json params = message.value("params", json::object());
 
+    if (ctx.session) {
+        ctx.session->calls.fetch_add(1, std::memory_order_relaxed);
+    }
+
     try {
         if (method == "initialize") {
             if (notification) return json(nullptr);
-            return handle_initialize(params, id);
+            return handle_initialize(params, id, ctx);
         }
         if (method == "tools/list") {
             if (notification) return json(nullptr);
-            return handle_tools_list(id);
+            return handle_tools_list(id, ctx);
         }
         if (method == "tools/call") {
             if (notification) return json(nullptr);
@@ -345,7 +393,12 @@ json McpServer::dispatch_message(const json& message) {
     }
 }
 
-json McpServer::handle_initialize(const json& /*params*/, const json& id) {
+json McpServer::handle_initialize(const json& /*params*/, const json& id, SessionContext& ctx) {
+    // Every initialize starts a fresh session, even over an existing one —
+    // the Streamable HTTP way to reset negotiated state.
+    ctx.session = sessions_.create();
+    ctx.assigned_session_id = ctx.session->id;
+
     json result = {
         {"protocolVersion", kMcpProtocolVersion},
         {"capabilities", {
@@ -359,7 +412,17 @@ json McpServer::handle_initialize(const json& /*params*/, const json& id) {
     return make_success_response(id, std::move(result));
 }
 
-json McpServer::handle_tools_list(const json& id) {
+json McpServer::handle_tools_list(const json& id, SessionContext& ctx) {
+    if (ctx.session) {
+        json cached = ctx.session->cached_value("tools");
+        if (!cached.is_null()) {
+            return make_success_response(id, std::move(cached));
+        }
+        json result = {{"tools", tools_descriptor()}};
+        ctx.session->store_cached_value("tools", result);
+        return make_success_response(id, std::move(result));
+    }
+
     json result = {{"tools", tools_descriptor()}};
     return make_success_response(id, std::move(result));
 }
@@ -412,6 +475,208 @@ json McpServer::handle_ping(const json& id) {
     return make_success_response(id, json::object());
 }
 
+bool McpServer::try_stream_tools_call(const httplib::Request& req, httplib::Response& res) {
+    if (req.get_header_value("Accept").find("text/event-stream") == std::string::npos) {
+        return false;
+    }
+
+    json message;
+    json arguments;
+    json progress_token;
+    try {
+        message = json::parse(req.body);
+        if (!message.is_object() || is_notification(message) ||
+            message.value("method", std::string()) != "tools/call") {
+            return false;
+        }
+
+        const json params = message.value("params", json::object());
+        if (!params.is_object() || params.value("name", std::string()) != "lemonade_chat") {
+            return false;
+        }
+        const json meta = params.value("_meta", json::object());
+        if (!meta.is_object() || !meta.contains("progressToken")) {
+            return false;
+        }
+        progress_token = meta["progressToken"];
+
+        arguments = params.value("arguments", json::object());
+        if (!arguments.is_object()) {
+            return false;
+        }
+    } catch (const std::exception&) {
+        // Malformed shapes fall through to the buffered path's error reporting.
+        return false;
+    }
+
+    LOG(INFO, "McpServer") << "tools/call (streaming): lemonade_chat" << std::endl;
+
+    auto self = shared_from_this();
+    json id = message.value("id", json(nullptr));
+
+    res.set_header("Cache-Control", "no-cache");
+    res.set_chunked_content_provider(
+        "text/event-stream",
+        [self, id, progress_token, arguments](size_t offset, httplib::DataSink& sink) {
+            if (offset > 0) return false;
+
+            SseWriter sse(sink);
+            auto emit = [&sse](const json& rpc) {
+                return sse.write_data(rpc);
+            };
+
+            // `progress` must increase monotonically; cumulative character
+            // count does, and gives clients a cheap throughput signal.
+            size_t chars_streamed = 0;
+            json result;
+            try {
+                result = self->tool_chat(arguments, [&](const std::string& delta) {
+                    chars_streamed += delta.size();
+                    emit({
+                        {"jsonrpc", "2.0"},
+                        {"method", "notifications/progress"},
+                        {"params", {
+                            {"progressToken", progress_token},
+                            {"progress", chars_streamed},
+                            {"message", delta},
+                        }},
+                    });
+                });
+            } catch (const std::exception& e) {
+                LOG(ERROR, "McpServer") << "Streaming lemonade_chat failed: " << e.what() << std::endl;
+                result = {
+                    {"content", json::array({text_content_block(std::string("Error: ") + e.what())})},
+                    {"isError", true},
+                };
+            }
+
+            emit(make_success_response(id, std::move(result)));
+            sink.done();
+            return false;
+        });
+    return true;
+}
+
+json McpServer::stream_chat_completion(json openai_request, const ProgressFn& on_delta) {
+    openai_request["stream"] = true;
+
+    std::string content;
+    std::string reasoning;
+    std::string finish_reason;
+    std::map<int, json> tool_calls;
+    json usage;
+    json error;
+    std::string line_buffer;
+
+    httplib::DataSink sink;
+    sink.is_writable = []() { return true; };
+    sink.done = []() {};
+    sink.write = [&](const char* data, size_t len) -> bool {
+        line_buffer.append(data, len);
+        StreamingProxy::process_sse_lines(line_buffer, [&](const std::string& line) {
+            if (line.rfind("data: ", 0) != 0) return;
+            const std::string payload = line.substr(6);
+            if (payload == "[DONE]") return;
+
+            json chunk;
+            try {
+                chunk = json::parse(payload);
+            } catch (const std::exception&) {
+                return;
+            }
+
+            if (chunk.contains("error")) {
+                error = chunk["error"];
+                return;
+            }
+            if (chunk.contains("usage") && chunk["usage"].is_object()) {
+                usage = chunk["usage"];
+            }
+            if (!chunk.contains("choices") || !chunk["choices"].is_array() ||
+                chunk["choices"].empty()) {
+                return;
+            }
+
+            const auto& choice = chunk["choices"][0];
+            if (choice.contains("finish_reason") && choice["finish_reason"].is_string()) {
+                finish_reason = choice["finish_reason"].get<std::string>();
+            }
+            if (!choice.contains("delta") || !choice["delta"].is_object()) return;
+            const auto& delta = choice["delta"];
+
+            if (delta.contains("content") && delta["content"].is_string()) {
+                const std::string text = delta["content"].get<std::string>();
+                if (!text.empty()) {
+                    content += text;
+                    on_delta(text);
+                }
+            }
+            if (delta.contains("reasoning_content") && delta["reasoning_content"].is_string()) {
+                const std::string text = delta["reasoning_content"].get<std::string>();
+                if (!text.empty()) {
+                    reasoning += text;
+                    on_delta(text);
+                }
+            }
+            if (delta.contains("tool_calls") && delta["tool_calls"].is_array()) {
+                for (const auto& td : delta["tool_calls"]) {
+                    if (!td.is_object()) continue;
+                    auto& tc = tool_calls[td.value("index", 0)];
+                    if (tc.is_null()) {
+                        tc = json{{"type", "function"},
+                                  {"function", {{"name", ""}, {"arguments", ""}}}};
+                    }
+                    if (td.contains("id") && td["id"].is_string()) {
+                        tc["id"] = td["id"];
+                    }
+                    if (td.contains("function") && td["function"].is_object()) {
+                        const auto& fn = td["function"];
+                        if (fn.contains("name") && fn["name"].is_string()) {
+                            tc["function"]["name"] = fn["name"];
+                        }
+                        if (fn.contains("arguments") && fn["arguments"].is_string()) {
+                            tc["function"]["arguments"] =
+                                tc["function"]["arguments"].get<std::string>() +
+                                fn["arguments"].get<std::string>();
+                        }
+                    }
+                }
+            }
+        });
+        return true;
+    };
+
+    router_->chat_completion_stream(openai_request.dump(), sink);
+
+    if (!error.is_null()) {
+        return json{{"error", std::move(error)}};
+    }
+
+    json message = {{"role", "assistant"}, {"content", std::move(content)}};
+    if (!reasoning.empty()) {
+        message["reasoning_content"] = std::move(reasoning);
+    }
+    if (!tool_calls.empty()) {
+        json arr = json::array();
+        for (auto& [index, tc] : tool_calls) {
+            (void)index;
+            arr.push_back(std::move(tc));
+        }
+        message["tool_calls"] = std::move(arr);
+    }
+
+    json response = {
+        {"choices", json::array({json{
+            {"message", std::move(message)},
+            {"finish_reason", finish_reason.empty() ? "stop" : finish_reason},
+        }})},
+    };
+    if (!usage.is_null()) {
+        response["usage"] = std::move(usage);
+    }
+    return response;
+}
+
 json McpServer::make_needs_model_result(const char* type_str,
                                         const char* default_model,
                                         const std::string& name_hint) {
@@ -472,7 +737,7 @@ std::variant<std::string, json> McpServer::resolve_model_for_tool(
         type_str, default_model, "an explicit model name");
 }
 
-json McpServer::tool_chat(const json& arguments) {
+json McpServer::tool_chat(const json& arguments, const ProgressFn& on_delta) {
     if (!arguments.contains("messages") || !arguments["messages"].is_array()) {
         throw std::runtime_error("Missing or non-array argument: messages");
     }
@@ -511,7 +776,8 @@ json McpServer::tool_chat(const json& arguments) {
         openai_request["chat_template_kwargs"] = {{"enable_thinking", false}};
     }
 
-    json response = router_->chat_completion(openai_request);
+    json response = on_delta ? stream_chat_completion(std::move(openai_request), on_delta)
+                             : router_->chat_completion(openai_request);
     if (response.contains("error")) {
         throw std::runtime_error(response["error"].value("message", "chat completion failed"));
     }
@@ -1173,7 +1439,10 @@ json McpServer::tools_descriptor() {
              "`model` or `allow_download: true` (which downloads the default, "
              "Qwen3.5-4B-MTP-GGUF). Call `lemonade_list_models` first if you "
              "want to choose explicitly — a wrong name may trigger a multi-GB "
-             "download."},
+             "download. Supports MCP progress streaming: send "
+             "`_meta.progressToken` with `Accept: text/event-stream` to "
+             "receive generated text incrementally via "
+             "`notifications/progress` before the final result."},
             {"inputSchema", {
                 {"type", "object"},
                 {"required", json::array({"messages"})},
@@ -0,0 +1,146 @@
+#include "lemon/mcp_session.h"
+
+#include <algorithm>
+#include <iomanip>
+#include <random>
+#include <sstream>
+#include <utility>
+
+namespace lemon {
+
+namespace {
+
+// Sweeping on every call would make each request O(sessions); once a second
+// keeps expiry timely without that cost.
+constexpr std::chrono::seconds kSweepInterval{1};
+
+}  // namespace
+
+McpSessionManager::McpSessionManager(std::chrono::milliseconds idle_timeout,
+                                     size_t max_sessions)
+    : idle_timeout_(idle_timeout),
+      max_sessions_(std::max<size_t>(1, max_sessions)),
+      last_sweep_(std::chrono::steady_clock::now()) {}
+
+std::shared_ptr<McpSessionManager::Session> McpSessionManager::create() {
+    const auto now = std::chrono::steady_clock::now();
+    std::lock_guard<std::mutex> lock(mutex_);
+    expire_idle_locked(now);
+
+    if (sessions_.size() >= max_sessions_) {
+        auto oldest = sessions_.begin();
+        for (auto it = sessions_.begin(); it != sessions_.end(); ++it) {
+            if (it->second->last_used < oldest->second->last_used) {
+                oldest = it;
+            }
+        }
+        park_locked(std::move(oldest->second));
+        sessions_.erase(oldest);
+    }
+
+    std::shared_ptr<Session> session;
+    if (!free_pool_.empty()) {
+        session = std::move(free_pool_.back());
+        free_pool_.pop_back();
+    } else {
+        session = std::make_shared<Session>();
+    }
+
+    session->id = generate_id();
+    session->last_used = now;
+    sessions_[session->id] = session;
+    return session;
+}
+
+std::shared_ptr<McpSessionManager::Session> McpSessionManager::find(const std::string& id) {
+    const auto now = std::chrono::steady_clock::now();
+    std::lock_guard<std::mutex> lock(mutex_);
+    expire_idle_locked(now);
+
+    auto it = sessions_.find(id);
+    if (it == sessions_.end()) {
+        return nullptr;
+    }
+    it->second->last_used = now;
+    return it->second;
+}
+
+bool McpSessionManager::remove(const std::string& id) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = sessions_.find(id);
+    if (it == sessions_.end()) {
+        return false;
+    }
+    park_locked(std::move(it->second));
+    sessions_.erase(it);
+    return true;
+}
+
+size_t McpSessionManager::size() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return sessions_.size();
+}
+
+size_t McpSessionManager::pooled() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return free_pool_.size();
+}
+
+size_t McpSessionManager::approx_bytes() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    size_t bytes = 0;
+    for (const auto& [id, session] : sessions_) {
+        bytes += id.size();
+        std::lock_guard<std::mutex> session_lock(session->mutex);
+        for (const auto& [key, value] : session->cache) {
+            bytes += key.size() + value.dump().size();
+        }
+    }
+    return bytes;
+}
+
+void McpSessionManager::expire_idle_locked(std::chrono::steady_clock::time_point now) {
+    if (now - last_sweep_ < kSweepInterval && now - last_sweep_ < idle_timeout_) {
+        return;
+    }
+    last_sweep_ = now;
+
+    for (auto it = sessions_.begin(); it != sessions_.end();) {
+        if (now - it->second->last_used >= idle_timeout_) {
+            park_locked(std::move(it->second));
+            it = sessions_.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+void McpSessionManager::park_locked(std::shared_ptr<Session> session) {
+    // The request that evicted this session may still hold it; only recycle
+    // slots nobody else references.
+    if (session.use_count() != 1) {
+        return;
+    }
+    session->id.clear();
+    session->calls = 0;
+    {
+        std::lock_guard<std::mutex> lock(session->mutex);
+        session->cache.clear();
+    }
+    free_pool_.push_back(std::move(session));
+}
+
+std::string McpSessionManager::generate_id() {
+    // Session ids must be unguessable (the header is the only credential for
+    // session reuse), so draw from the OS entropy source rather than a
+    // counter.
+    static thread_local std::mt19937_64 rng{std::random_device{}()};
+    std::uniform_int_distribution<uint64_t> dist;
+    std::ostringstream oss;
+    oss << std::hex << std::setfill('0')
+        << std::setw(16) << dist(rng)
+        << std::setw(16) << dist(rng);
+    return oss.str();
+}
+
+}  // namespace lemon
@@ -0,0 +1,201 @@
+#include "lemon/memory_accounting.h"
+
+#include <algorithm>
+#include <chrono>
+#include <vector>
+
+#ifdef _WIN32
+    #include <windows.h>
+    #include <psapi.h>
+#elif defined(__APPLE__)
+    #include <mach/mach.h>
+#else
+    #include <cstdio>
+#endif
+
+#include "lemon/utils/aixlog.hpp"
+
+namespace lemon {
+
+MemoryAccounting& MemoryAccounting::global() {
+    static MemoryAccounting instance;
+    return instance;
+}
+
+MemoryAccounting::~MemoryAccounting() {
+    stop_watchdog();
+}
+
+void MemoryAccounting::register_gauge(const std::string& subsystem,
+                                      std::function<std::uint64_t()> bytes) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    gauges_[subsystem] = std::move(bytes);
+}
+
+nlohmann::json MemoryAccounting::snapshot() const {
+    std::map<std::string, std::function<std::uint64_t()>> gauges;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        gauges = gauges_;
+    }
+
+    // Gauges run outside the registry lock — they take subsystem locks of
+    // their own and must not be able to deadlock against register_gauge().
+    nlohmann::json subsystems = nlohmann::json::object();
+    for (const auto& [name, gauge] : gauges) {
+        std::uint64_t value = 0;
+        try {
+            value = gauge();
+        } catch (const std::exception&) {
+        }
+        subsystems[name] = value;
+    }
+
+    return {{"rss_bytes", process_rss_bytes()},
+            {"subsystems", std::move(subsystems)}};
+}
+
+std::uint64_t MemoryAccounting::process_rss_bytes() {
+#ifdef _WIN32
+    PROCESS_MEMORY_COUNTERS counters{};
+    counters.cb = sizeof(counters);
+    if (!GetProcessMemoryInfo(GetCurrentProcess(), &counters,
+                              sizeof(counters))) {
+        return 0;
+    }
+    return static_cast<std::uint64_t>(counters.WorkingSetSize);
+#elif defined(__APPLE__)
+    mach_task_basic_info info{};
+    mach_msg_type_number_t count = MACH_TASK_BASIC_INFO_COUNT;
+    if (task_info(mach_task_self(), MACH_TASK_BASIC_INFO,
+                  reinterpret_cast<task_info_t>(&info), &count) != KERN_SUCCESS) {
+        return 0;
+    }
+    return static_cast<std::uint64_t>(info.resident_size);
+#else
+    FILE* statm = std::fopen("/proc/self/statm", "r");
+    if (!statm) {
+        return 0;
+    }
+    unsigned long long total_pages = 0;
+    unsigned long long resident_pages = 0;
+    const int parsed =
+        std::fscanf(statm, "%llu %llu", &total_pages, &resident_pages);
+    std::fclose(statm);
+    if (parsed != 2) {
+        return 0;
+    }
+    return static_cast<std::uint64_t>(resident_pages) * 4096;
+#endif
+}
+
+nlohmann::json MemoryAccounting::growth_report(const nlohmann::json& previous,
+                                               const nlohmann::json& current) {
+    const auto prev_subsystems =
+        previous.value("subsystems", nlohmann::json::object());
+    const auto cur_subsystems =
+        current.value("subsystems", nlohmann::json::object());
+
+    struct Growth {
+        std::string subsystem;
+        std::uint64_t bytes;
+        std::uint64_t grew_bytes;
+    };
+    std::vector<Growth> growers;
+    for (const auto& [name, value] : cur_subsystems.items()) {
+        const std::uint64_t now = value.is_number() ? value.get<std::uint64_t>() : 0;
+        const std::uint64_t before = prev_subsystems.contains(name) &&
+                                             prev_subsystems[name].is_number()
+                                         ? prev_subsystems[name].get<std::uint64_t>()
+                                         : 0;
+        if (now > before) {
+            growers.push_back({name, now, now - before});
+        }
+    }
+    std::sort(growers.begin(), growers.end(),
+              [](const Growth& a, const Growth& b) {
+                  return a.grew_bytes > b.grew_bytes;
+              });
+
+    nlohmann::json report = nlohmann::json::array();
+    for (const auto& g : growers) {
+        report.push_back({{"subsystem", g.subsystem},
+                          {"bytes", g.bytes},
+                          {"grew_bytes", g.grew_bytes}});
+    }
+    return report;
+}
+
+void MemoryAccounting::start_watchdog(std::uint64_t step_bytes,
+                                      int interval_seconds) {
+    std::lock_guard<std::mutex> lock(watchdog_mutex_);
+    if (watchdog_running_) {
+        return;
+    }
+    watchdog_running_ = true;
+    watchdog_ = std::thread(
+        [this, step_bytes, interval_seconds] {
+            watchdog_loop(step_bytes, interval_seconds);
+        });
+}
+
+void MemoryAccounting::stop_watchdog() {
+    {
+        std::lock_guard<std::mutex> lock(watchdog_mutex_);
+        if (!watchdog_running_) {
+            return;
+        }
+        watchdog_running_ = false;
+        watchdog_cv_.notify_all();
+    }
+    if (watchdog_.joinable()) {
+        watchdog_.join();
+    }
+}
+
+void MemoryAccounting::watchdog_loop(std::uint64_t step_bytes,
+                                     int interval_seconds) {
+    nlohmann::json last_crossing = snapshot();
+    std::uint64_t threshold =
+        last_crossing.value("rss_bytes", std::uint64_t(0)) + step_bytes;
+
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(watchdog_mutex_);
+            watchdog_cv_.wait_for(lock, std::chrono::seconds(interval_seconds),
+                                  [this] { return !watchdog_running_; });
+            if (!watchdog_running_) {
+                return;
+            }
+        }
+
+        const std::uint64_t rss = process_rss_bytes();
+        if (rss == 0 || rss < threshold) {
+            continue;
+        }
+
+        const nlohmann::json now = snapshot();
+        const nlohmann::json growers = growth_report(last_crossing, now);
+        std::string suspects;
+        for (const auto& g : growers) {
+            if (!suspects.empty()) {
+                suspects += ", ";
+            }
+            suspects += g.value("subsystem", "") + " +" +
+                        std::to_string(g.value("grew_bytes", std::uint64_t(0)) /
+                                       (1024 * 1024)) +
+                        "MB";
+        }
+        LOG(WARNING, "MemWatchdog")
+            << "RSS crossed " << (threshold / (1024 * 1024)) << "MB (now "
+            << (rss / (1024 * 1024)) << "MB). Top tracked growth since last "
+            << "crossing: "
+            << (suspects.empty() ? "none of the tracked subsystems" : suspects)
+            << std::endl;
+
+        last_crossing = now;
+        threshold = rss + step_bytes;
+    }
+}
+
+}  // namespace lemon
@@ -0,0 +1,285 @@
+#include "lemon/metrics_pusher.h"
+
+#include "lemon/runtime_config.h"
+#include "lemon/utils/aixlog.hpp"
+#include "lemon/utils/http_client.h"
+
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <vector>
+#include <zstd.h>
+
+#ifdef _WIN32
+#include <winsock2.h>
+#else
+#include <unistd.h>
+#endif
+
+namespace fs = std::filesystem;
+
+namespace lemon {
+
+namespace {
+
+std::string local_hostname() {
+    char buffer[256];
+    if (gethostname(buffer, sizeof(buffer)) == 0) {
+        return std::string(buffer);
+    }
+    return "UnknownHost";
+}
+
+// Pushgateway group labels end up in URL path segments.
+std::string sanitize_label(const std::string& value) {
+    std::string out;
+    out.reserve(value.size());
+    for (char c : value) {
+        if (std::isalnum(static_cast<unsigned char>(c)) || c == '-' || c == '_' || c == '.') {
+            out += c;
+        } else {
+            out += '_';
+        }
+    }
+    return out.empty() ? "unknown" : out;
+}
+
+bool compress_to_file(const std::string& payload, const fs::path& path) {
+    const size_t bound = ZSTD_compressBound(payload.size());
+    std::vector<char> compressed(bound);
+    const size_t written = ZSTD_compress(compressed.data(), bound,
+                                         payload.data(), payload.size(), 3);
+    if (ZSTD_isError(written)) {
+        return false;
+    }
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (!file) {
+        return false;
+    }
+    file.write(compressed.data(), static_cast<std::streamsize>(written));
+    return file.good();
+}
+
+bool decompress_from_file(const fs::path& path, std::string& payload) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        return false;
+    }
+    std::string compressed((std::istreambuf_iterator<char>(file)),
+                           std::istreambuf_iterator<char>());
+    const unsigned long long content_size =
+        ZSTD_getFrameContentSize(compressed.data(), compressed.size());
+    if (content_size == ZSTD_CONTENTSIZE_ERROR ||
+        content_size == ZSTD_CONTENTSIZE_UNKNOWN ||
+        content_size > 64ULL * 1024 * 1024) {
+        return false;
+    }
+    payload.resize(static_cast<size_t>(content_size));
+    const size_t written = ZSTD_decompress(payload.data(), payload.size(),
+                                           compressed.data(), compressed.size());
+    return !ZSTD_isError(written) && written == payload.size();
+}
+
+} // namespace
+
+MetricsPusher::MetricsPusher(std::function<std::string()> build_payload,
+                             const std::string& cache_dir)
+    : build_payload_(std::move(build_payload)),
+      spool_dir_((fs::path(cache_dir) / "metrics_spool").string()) {}
+
+MetricsPusher::~MetricsPusher() {
+    stop();
+}
+
+void MetricsPusher::start() {
+    if (running_) return;
+    running_ = true;
+    push_thread_ = std::thread(&MetricsPusher::push_loop, this);
+}
+
+void MetricsPusher::stop() {
+    running_ = false;
+    wake_cv_.notify_all();
+    if (push_thread_.joinable()) {
+        push_thread_.join();
+    }
+}
+
+std::string MetricsPusher::resolve_push_url() const {
+    auto* config = RuntimeConfig::global();
+    if (!config) return "";
+    std::string base = config->metrics_push_url();
+    if (base.empty()) return "";
+    while (!base.empty() && base.back() == '/') {
+        base.pop_back();
+    }
+    std::string instance = config->metrics_push_instance();
+    if (instance.empty()) {
+        instance = local_hostname();
+    }
+    return base + "/metrics/job/" + sanitize_label(config->metrics_push_job()) +
+           "/instance/" + sanitize_label(instance);
+}
+
+void MetricsPusher::push_loop() {
+    while (running_) {
+        int interval_s = 15;
+        if (auto* config = RuntimeConfig::global()) {
+            interval_s = std::max(1, config->metrics_push_interval_s());
+        }
+        {
+            std::unique_lock<std::mutex> lock(wake_mutex_);
+            wake_cv_.wait_for(lock, std::chrono::seconds(interval_s),
+                              [this] { return !running_; });
+        }
+        if (!running_) break;
+
+        const std::string url = resolve_push_url();
+        if (url.empty()) continue;
+
+        std::string payload;
+        try {
+            payload = build_payload_();
+        } catch (const std::exception& e) {
+            LOG(WARNING, "MetricsPush") << "Failed to build metrics payload: "
+                    << e.what() << std::endl;
+            continue;
+        }
+
+        int max_series = 0;
+        if (auto* config = RuntimeConfig::global()) {
+            max_series = config->metrics_push_max_series();
+        }
+        if (max_series > 0) {
+            std::string limited = apply_series_limit(payload, max_series);
+            if (limited.size() != payload.size() && !series_limit_logged_) {
+                series_limit_logged_ = true;
+                LOG(WARNING, "MetricsPush") << "Metrics payload exceeds "
+                        << max_series << " series; truncating pushes" << std::endl;
+            }
+            payload = std::move(limited);
+        }
+
+        if (!replay_spool(url)) {
+            spool_payload(payload);
+            continue;
+        }
+        if (push_payload(url, payload)) {
+            if (gateway_unreachable_) {
+                gateway_unreachable_ = false;
+                LOG(INFO, "MetricsPush") << "Push gateway reachable again" << std::endl;
+            }
+        } else {
+            if (!gateway_unreachable_) {
+                gateway_unreachable_ = true;
+                LOG(WARNING, "MetricsPush") << "Push gateway unreachable; "
+                        << "spooling metrics to " << spool_dir_ << std::endl;
+            }
+            spool_payload(payload);
+        }
+    }
+}
+
+bool MetricsPusher::push_payload(const std::string& url, const std::string& payload) {
+    try {
+        const auto policy = url.rfind("http://", 0) == 0
+            ? utils::HttpSecurityPolicy::AllowInsecureHttp
+            : utils::HttpSecurityPolicy::ExternalHttpsOnly;
+        auto response = utils::HttpClient::post(
+            url, payload,
+            {{"Content-Type", "text/plain; version=0.0.4; charset=utf-8"}},
+            10, policy);
+        return response.status_code >= 200 && response.status_code < 300;
+    } catch (const std::exception&) {
+        return false;
+    }
+}
+
+std::string MetricsPusher::apply_series_limit(const std::string& payload,
+                                              int max_series) {
+    std::istringstream input(payload);
+    std::ostringstream output;
+    std::string line;
+    int series = 0;
+    while (std::getline(input, line)) {
+        const bool is_sample = !line.empty() && line[0] != '#';
+        if (is_sample && ++series > max_series) {
+            break;
+        }
+        output << line << '\n';
+    }
+    return output.str();
+}
+
+void MetricsPusher::spool_payload(const std::string& payload) {
+    int max_files = 64;
+    if (auto* config = RuntimeConfig::global()) {
+        max_files = config->metrics_push_spool_max_files();
+    }
+    if (max_files <= 0) return;
+
+    std::error_code ec;
+    fs::create_directories(spool_dir_, ec);
+    if (ec) return;
+
+    const auto now_ms = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+    const fs::path path = fs::path(spool_dir_) /
+        (std::to_string(now_ms) + ".prom.zst");
+    if (!compress_to_file(payload, path)) {
+        fs::remove(path, ec);
+        return;
+    }
+
+    // Filenames are epoch millis, so lexicographic-by-length ordering is
+    // chronological for any realistic clock; drop the oldest beyond the cap.
+    std::vector<fs::path> spooled;
+    for (const auto& entry : fs::directory_iterator(spool_dir_, ec)) {
+        if (entry.is_regular_file(ec)) {
+            spooled.push_back(entry.path());
+        }
+    }
+    std::sort(spooled.begin(), spooled.end());
+    while (spooled.size() > static_cast<size_t>(max_files)) {
+        fs::remove(spooled.front(), ec);
+        spooled.erase(spooled.begin());
+    }
+}
+
+bool MetricsPusher::replay_spool(const std::string& url) {
+    std::error_code ec;
+    if (!fs::exists(spool_dir_, ec)) {
+        return true;
+    }
+    std::vector<fs::path> spooled;
+    for (const auto& entry : fs::directory_iterator(spool_dir_, ec)) {
+        if (entry.is_regular_file(ec)) {
+            spooled.push_back(entry.path());
+        }
+    }
+    if (spooled.empty()) {
+        return true;
+    }
+    std::sort(spooled.begin(), spooled.end());
+
+    for (const auto& path : spooled) {
+        if (!running_) return false;
+        std::string payload;
+        if (!decompress_from_file(path, payload)) {
+            fs::remove(path, ec);
+            continue;
+        }
+        if (!push_payload(url, payload)) {
+            return false;
+        }
+        fs::remove(path, ec);
+    }
+    LOG(INFO, "MetricsPush") << "Replayed " << spooled.size()
+            << " spooled metrics payloads" << std::endl;
+    return true;
+}
+
+} // namespace lemon
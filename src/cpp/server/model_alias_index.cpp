@@ -0,0 +1,93 @@
+#include "lemon/model_alias_index.h"
+
+#include <cctype>
+#include <mutex>
+
+namespace lemon {
+
+namespace {
+constexpr uint32_t kAmbiguous = UINT32_MAX;
+
+std::string fold_case(const std::string& s) {
+    std::string folded = s;
+    for (char& c : folded) {
+        c = static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+    }
+    return folded;
+}
+} // namespace
+
+size_t ModelAliasIndex::FoldedHash::operator()(const std::string& s) const {
+    uint64_t hash = 1469598103934665603ull;
+    for (unsigned char c : s) {
+        hash ^= static_cast<unsigned char>(
+            std::tolower(static_cast<unsigned char>(c)));
+        hash *= 1099511628211ull;
+    }
+    return static_cast<size_t>(hash);
+}
+
+uint32_t ModelAliasIndex::intern(const std::string& id,
+                                 std::unordered_map<std::string, uint32_t>& seen) {
+    auto it = seen.find(id);
+    if (it != seen.end()) {
+        return it->second;
+    }
+    uint32_t index = static_cast<uint32_t>(pool_.size());
+    pool_.push_back(id);
+    seen.emplace(id, index);
+    return index;
+}
+
+void ModelAliasIndex::rebuild(const std::map<std::string, std::string>& aliases,
+                              const std::map<std::string, std::string>& public_names) {
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    pool_.clear();
+    forward_.clear();
+    folded_.clear();
+    reverse_.clear();
+
+    std::unordered_map<std::string, uint32_t> seen;
+    forward_.reserve(aliases.size());
+    folded_.reserve(aliases.size());
+    reverse_.reserve(public_names.size());
+
+    for (const auto& [alias, canonical] : aliases) {
+        uint32_t target = intern(canonical, seen);
+        forward_.emplace(alias, target);
+
+        auto [it, inserted] = folded_.emplace(fold_case(alias), target);
+        if (!inserted && it->second != target) {
+            it->second = kAmbiguous;
+        }
+    }
+    for (const auto& [canonical, public_name] : public_names) {
+        reverse_.emplace(canonical, intern(public_name, seen));
+    }
+}
+
+std::string ModelAliasIndex::resolve(const std::string& name) const {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    auto it = forward_.find(name);
+    if (it != forward_.end()) {
+        return pool_[it->second];
+    }
+    auto folded = folded_.find(fold_case(name));
+    if (folded != folded_.end() && folded->second != kAmbiguous) {
+        return pool_[folded->second];
+    }
+    return name;
+}
+
+std::string ModelAliasIndex::public_name(const std::string& name) const {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    auto it = reverse_.find(name);
+    return it != reverse_.end() ? pool_[it->second] : name;
+}
+
+size_t ModelAliasIndex::size() const {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    return forward_.size();
+}
+
+} // namespace lemon
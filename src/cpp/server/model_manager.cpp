@@ -1,8 +1,12 @@
 #include <lemon/model_manager.h>
+#include <lemon/download_scheduler.h>
+#include <lemon/gguf_metadata_cache.h>
 #include <lemon/runtime_config.h>
 #include <lemon/hf_variants.h>
 #include <lemon/model_registry.h>
+#include <lemon/registry_snapshot.h>
 #include <lemon/routing_policy_parser.h>
+#include <lemon/utils/gguf_shards.h>
 #include <lemon/utils/json_utils.h>
 #include <lemon/utils/http_client.h>
 #include <lemon/utils/process_manager.h>
@@ -376,36 +380,14 @@ static bool is_repo_shared(const std::string& repo_id,
     return false;
 }
 
-// Parse image_defaults from a model JSON entry into ModelInfo
-static void parse_image_defaults(ModelInfo& info, const json& model_json) {
-    if (model_json.contains("image_defaults") && model_json["image_defaults"].is_object()) {
-        const auto& img_defaults = model_json["image_defaults"];
-        info.image_defaults.has_defaults = true;
-        info.image_defaults.steps = JsonUtils::get_or_default<int>(img_defaults, "steps", 20);
-        info.image_defaults.cfg_scale = JsonUtils::get_or_default<float>(img_defaults, "cfg_scale", 7.0f);
-        info.image_defaults.width = JsonUtils::get_or_default<int>(img_defaults, "width", 512);
-        info.image_defaults.height = JsonUtils::get_or_default<int>(img_defaults, "height", 512);
-        info.image_defaults.sampling_method = JsonUtils::get_or_default<std::string>(img_defaults, "sampling_method", "");
-        info.image_defaults.flow_shift = JsonUtils::get_or_default<float>(img_defaults, "flow_shift", 0.0f);
-    }
-}
-
-// Populate ModelInfo::extras with any model-JSON key not consumed by a typed
-// ModelInfo field. This lets a new backend read custom per-model fields in load()
-// without editing the shared ModelInfo struct. Keep this set in sync with the
-// keys read by the parse blocks in build_cache().
-static void parse_extras(ModelInfo& info, const json& model_json) {
-    static const std::set<std::string> kKnownKeys = {
-        "checkpoint", "checkpoints", "components", "mmproj", "recipe", "suggested",
-        "source", "registry_source", "size", "cloud_provider",
-        "labels", "image_defaults", "recipe_options"
-    };
-    if (!model_json.is_object()) return;
-    for (auto& [key, value] : model_json.items()) {
-        if (kKnownKeys.count(key) == 0) {
-            info.extras[key] = value;
-        }
-    }
+static void parse_image_defaults_object(ModelInfo& info, const json& img_defaults) {
+    info.image_defaults.has_defaults = true;
+    info.image_defaults.steps = JsonUtils::get_or_default<int>(img_defaults, "steps", 20);
+    info.image_defaults.cfg_scale = JsonUtils::get_or_default<float>(img_defaults, "cfg_scale", 7.0f);
+    info.image_defaults.width = JsonUtils::get_or_default<int>(img_defaults, "width", 512);
+    info.image_defaults.height = JsonUtils::get_or_default<int>(img_defaults, "height", 512);
+    info.image_defaults.sampling_method = JsonUtils::get_or_default<std::string>(img_defaults, "sampling_method", "");
+    info.image_defaults.flow_shift = JsonUtils::get_or_default<float>(img_defaults, "flow_shift", 0.0f);
 }
 
 // Default device for a recipe: the backend descriptor is authoritative for
@@ -458,6 +440,13 @@ static RecipeOptions build_recipe_options(const ModelInfo& info,
         }
     }
 
+    // A typo'd option would otherwise be silently dropped here and only show
+    // up as a subprocess launched without it; surface it at registry load.
+    for (const auto& error : RecipeOptions::validate(info.recipe, base_options)) {
+        LOG(WARNING, "ModelManager") << "Model '" << info.model_name << "': "
+                                     << error << std::endl;
+    }
+
     return RecipeOptions(info.recipe, base_options);
 }
 
@@ -529,47 +518,37 @@ static void cleanup_empty_parents(const fs::path& file_path, const fs::path& sto
 // Return the on-disk size of a resolved model path. Some recipes (for
 // example Moonshine streaming) resolve to a directory of artifacts rather than
 // to a single model file. std::filesystem::file_size() fails on directories
-static uintmax_t resolved_path_size_bytes(const fs::path& path) {
+static uintmax_t resolved_path_size_bytes(const fs::path& path,
+                                          backends::hf_cache::ScanCache& scan_cache) {
     std::error_code ec;
     if (!safe_exists(path)) {
         return 0;
     }
 
     if (!safe_is_directory(path)) {
+        // The resolved path of a sharded GGUF is its first shard; report the
+        // whole set so memory admission sees the real checkpoint size.
+        const auto shard_set = utils::resolve_gguf_shard_set(path_to_utf8(path));
+        if (shard_set.sharded) {
+            return static_cast<uintmax_t>(shard_set.total_bytes);
+        }
         auto size = fs::file_size(path, ec);
         return ec ? 0 : size;
     }
 
-    uintmax_t total = 0;
-    for (const auto& entry : fs::recursive_directory_iterator(path, safe_dir_options, ec)) {
-        if (ec) {
-            ec.clear();
-            break;
-        }
-        if (!entry.is_regular_file(ec)) {
-            ec.clear();
-            continue;
-        }
-
-        auto size = fs::file_size(entry.path(), ec);
-        if (!ec) {
-            total += size;
-        } else {
-            ec.clear();
-        }
-    }
-    return total;
+    return static_cast<uintmax_t>(scan_cache.tree_size_bytes(path));
 }
 
 
 // Replace the static registry size with the aggregate on-disk size once the
 // files exist, so directory-checkpoint models (whose repos can carry more than
 // the registry estimate) report what was actually downloaded.
-static void refresh_on_disk_size(ModelInfo& info) {
+static void refresh_on_disk_size(ModelInfo& info,
+                                 backends::hf_cache::ScanCache& scan_cache) {
     uintmax_t total_size = 0;
     for (auto& [type, path] : info.resolved_paths) {
         (void)type;
-        total_size += resolved_path_size_bytes(path_from_utf8(path));
+        total_size += resolved_path_size_bytes(path_from_utf8(path), scan_cache);
     }
     if (total_size == 0) {
         return;
@@ -603,7 +582,7 @@ std::vector<ModelFileInfo> ModelManager::list_model_files(const std::string& mod
         file.role = role;
         file.exists = path_exists;
         file.size_bytes = path_exists
-            ? static_cast<std::uint64_t>(resolved_path_size_bytes(path))
+            ? static_cast<std::uint64_t>(resolved_path_size_bytes(path, scan_cache()))
             : 0;
         files.push_back(std::move(file));
     }
@@ -750,12 +729,21 @@ static bool cleanup_incomplete_hf_model_cache(const ModelInfo& info,
             rel == normalized_variant + ".partial" ||
             rel.rfind("/" + normalized_variant + ".partial") != std::string::npos;
 
-        if (!matches_variant_partial) {
+        // Parallel downloads leave ".chunkN" pieces and a ".chunks.json" state
+        // file instead of a single ".partial" until assembly.
+        const bool matches_variant_chunk =
+            filename.rfind(variant + ".chunk", 0) == 0 ||
+            rel.rfind(normalized_variant + ".chunk", 0) == 0 ||
+            rel.find("/" + normalized_variant + ".chunk") != std::string::npos;
+
+        if (!matches_variant_partial && !matches_variant_chunk) {
             continue;
         }
 
         remove_file_or_throw(partial_path, "incomplete model download partial");
-        remove_stale_manifest_for_partial(partial_path, model_cache_path);
+        if (matches_variant_partial) {
+            remove_stale_manifest_for_partial(partial_path, model_cache_path);
+        }
         cleanup_empty_parents(partial_path, model_cache_path);
         removed_any = true;
     }
@@ -1020,6 +1008,14 @@ std::string ModelManager::get_recipe_options_file() {
     return get_cache_dir() + "/recipe_options.json";
 }
 
+backends::hf_cache::ScanCache& ModelManager::scan_cache() {
+    if (!scan_cache_) {
+        scan_cache_ = std::make_unique<backends::hf_cache::ScanCache>(
+            path_from_utf8(get_cache_dir() + "/hf_scan_cache.json"));
+    }
+    return *scan_cache_;
+}
+
 std::string ModelManager::get_hf_cache_dir() const {
     return lemon::utils::get_hf_cache_dir();
 }
@@ -1027,6 +1023,7 @@ std::string ModelManager::get_hf_cache_dir() const {
 void ModelManager::invalidate_models_cache() {
     std::lock_guard<std::mutex> lock(models_cache_mutex_);
     cache_valid_ = false;
+    models_revision_.fetch_add(1);
 }
 
 bool ModelManager::refresh_user_models_from_disk_for_lookup(const std::string& model_name) {
@@ -1089,6 +1086,15 @@ void ModelManager::start_directory_watcher() {
     directory_watcher_ = std::make_unique<DirectoryWatcher>(extra_models_dir_);
     directory_watcher_->set_callback([this]() {
         LOG(DEBUG, "ModelManager") << "Extra models directory changed, invalidating cache" << std::endl;
+        // Reconcile GGUF metadata records on the watcher thread so the rescan
+        // triggered by the invalidation only re-parses the files that actually
+        // changed, not every local GGUF.
+        try {
+            GgufMetadataCache::global().refresh_directory(extra_models_dir_);
+        } catch (const std::exception& e) {
+            LOG(WARNING, "ModelManager") << "GGUF metadata refresh failed: "
+                                         << e.what() << std::endl;
+        }
         {
             std::lock_guard<std::mutex> lock(models_cache_mutex_);
             cache_valid_ = false;
@@ -1289,9 +1295,13 @@ void ModelManager::resolve_all_model_paths(ModelInfo& info) {
 
 json ModelManager::load_server_models() {
     try {
-        // Load from resources directory (relative to executable)
+        // Load from resources directory (relative to executable), preferring
+        // the binary snapshot from the previous run when the source text is
+        // unchanged.
         std::string models_path = get_resource_path("resources/server_models.json");
-        return JsonUtils::load_from_file(models_path);
+        return registry_snapshot::load(
+            models_path,
+            path_from_utf8(get_cache_dir() + "/registry_snapshot.bin"));
     } catch (const std::exception& e) {
         LOG(ERROR, "ModelManager") << "Failed to load server_models.json: " << e.what() << std::endl;
         LOG(ERROR, "ModelManager") << "This is a critical file required for the application to run." << std::endl;
@@ -1416,6 +1426,29 @@ std::map<std::string, ModelInfo> ModelManager::get_supported_models() {
     return public_models;
 }
 
+std::vector<ModelInfo> ModelManager::search_models(const std::string& query, size_t limit) {
+    build_cache();
+
+    const auto matches = search_index_.search(query, limit);
+
+    std::lock_guard<std::mutex> lock(models_cache_mutex_);
+    std::vector<ModelInfo> results;
+    results.reserve(matches.size());
+    for (const auto& name : matches) {
+        auto it = models_cache_.find(name);
+        if (it == models_cache_.end()) {
+            continue;
+        }
+        ModelInfo info = it->second;
+        auto public_it = canonical_public_names_.find(name);
+        if (public_it != canonical_public_names_.end()) {
+            info.model_name = public_it->second;
+        }
+        results.push_back(std::move(info));
+    }
+    return results;
+}
+
 std::vector<std::string> ModelManager::check_for_model_updates() {
     std::lock_guard<std::mutex> update_check_lock(update_check_mutex_);
 
@@ -1611,14 +1644,82 @@ static void parse_legacy_mmproj(ModelInfo& info, const json& model_json) {
     }
 }
 
-static void parse_components(ModelInfo& info, const json& model_json) {
-    if (!model_json.contains("components") || !model_json["components"].is_array()) {
-        return;
+// Single-pass, schema-dispatched parse of one registry entry into ModelInfo:
+// every member is visited exactly once and routed straight to its typed field,
+// instead of the previous per-field tree probes (a dozen lookups plus temporary
+// json copies for each of the thousands of entries on every cache build).
+// Unknown keys land in extras so a new backend can read custom per-model config
+// in load() without editing the shared ModelInfo struct. recipe_options_out
+// receives the raw "recipe_options" object, or null when absent. source /
+// registry_source are left to parse_model_source_fields so each caller keeps
+// its own error handling for conflicting registries.
+static void parse_registry_entry(ModelInfo& info, const json& model_json,
+                                 bool suggested_default, json& recipe_options_out) {
+    info.suggested = suggested_default;
+    recipe_options_out = json(nullptr);
+
+    std::string main_checkpoint;
+    std::string legacy_mmproj;
+    const json* explicit_checkpoints = nullptr;
+
+    if (model_json.is_object()) {
+        for (const auto& [key, field] : model_json.items()) {
+            if (key == "checkpoint") {
+                if (field.is_string()) main_checkpoint = field.get<std::string>();
+            } else if (key == "checkpoints") {
+                if (field.is_object()) explicit_checkpoints = &field;
+            } else if (key == "mmproj") {
+                if (field.is_string()) legacy_mmproj = field.get<std::string>();
+            } else if (key == "components") {
+                if (field.is_array()) {
+                    for (const auto& component : field) {
+                        if (component.is_string()) {
+                            info.components.push_back(component.get<std::string>());
+                        }
+                    }
+                }
+            } else if (key == "recipe") {
+                if (field.is_string()) info.recipe = field.get<std::string>();
+            } else if (key == "suggested") {
+                if (field.is_boolean()) info.suggested = field.get<bool>();
+            } else if (key == "size") {
+                if (field.is_number()) info.size = field.get<double>();
+            } else if (key == "cloud_provider") {
+                if (field.is_string()) info.cloud_provider = field.get<std::string>();
+            } else if (key == "labels") {
+                if (field.is_array()) {
+                    for (const auto& label : field) {
+                        if (label.is_string()) {
+                            info.labels.push_back(label.get<std::string>());
+                        }
+                    }
+                }
+            } else if (key == "image_defaults") {
+                if (field.is_object()) parse_image_defaults_object(info, field);
+            } else if (key == "recipe_options") {
+                if (field.is_object()) recipe_options_out = field;
+            } else if (key == "source" || key == "registry_source") {
+                continue;
+            } else {
+                if (key == "system_prompt" && field.is_string()) {
+                    info.system_prompt = field.get<std::string>();
+                }
+                info.extras[key] = field;
+            }
+        }
     }
 
-    for (const auto& component : model_json["components"]) {
-        if (component.is_string()) {
-            info.components.push_back(component.get<std::string>());
+    // Composed last so precedence holds regardless of member order: an explicit
+    // checkpoints object overrides both "checkpoint" and the legacy mmproj form.
+    info.checkpoints["main"] = main_checkpoint;
+    if (!legacy_mmproj.empty()) {
+        info.checkpoints["mmproj"] = legacy_mmproj_to_checkpoint(main_checkpoint, legacy_mmproj);
+    }
+    if (explicit_checkpoints) {
+        for (const auto& [type, checkpoint] : explicit_checkpoints->items()) {
+            if (checkpoint.is_string()) {
+                info.checkpoints[type] = checkpoint.get<std::string>();
+            }
         }
     }
 }
@@ -1803,12 +1904,8 @@ void ModelManager::build_cache() {
     for (auto& [key, value] : server_models_.items()) {
         ModelInfo info;
         info.model_name = key;
-        info.checkpoints["main"] = JsonUtils::get_or_default<std::string>(value, "checkpoint", "");
-        parse_legacy_mmproj(info, value);
-        load_checkpoints(info, value);
-        parse_components(info, value);
-        info.recipe = JsonUtils::get_or_default<std::string>(value, "recipe", "");
-        info.suggested = JsonUtils::get_or_default<bool>(value, "suggested", false);
+        json entry_recipe_options;
+        parse_registry_entry(info, value, false, entry_recipe_options);
         try {
             parse_model_source_fields(info, value);
         } catch (const std::exception& e) {
@@ -1817,9 +1914,6 @@ void ModelManager::build_cache() {
                 << "': " << e.what() << std::endl;
             continue;
         }
-        info.size = JsonUtils::get_or_default<double>(value, "size", 0.0);
-        info.cloud_provider = JsonUtils::get_or_default<std::string>(value, "cloud_provider", "");
-        info.system_prompt = JsonUtils::get_or_default<std::string>(value, "system_prompt", "");
 
         // Registry-backed collections store their components remotely — the
         // cached manifest is the single source of truth. Rebuild the component
@@ -1834,18 +1928,8 @@ void ModelManager::build_cache() {
             populate_collection_components_from_cache_locked(info);
         }
 
-        if (value.contains("labels") && value["labels"].is_array()) {
-            for (const auto& label : value["labels"]) {
-                info.labels.push_back(label.get<std::string>());
-            }
-        }
-
-        parse_image_defaults(info, value);
-        parse_extras(info, value);
-
-        // Parse recipe_options if present (for per-model runtime config like sdcpp_args)
-        if (value.contains("recipe_options") && value["recipe_options"].is_object()) {
-            json_recipe_options[key] = value["recipe_options"];
+        if (!entry_recipe_options.is_null()) {
+            json_recipe_options[key] = std::move(entry_recipe_options);
         }
 
         // Populate type and device fields (multi-model support)
@@ -1864,12 +1948,8 @@ void ModelManager::build_cache() {
     for (auto& [key, value] : user_models_.items()) {
         ModelInfo info;
         info.model_name = "user." + key;
-        info.checkpoints["main"] = JsonUtils::get_or_default<std::string>(value, "checkpoint", "");
-        parse_legacy_mmproj(info, value);
-        load_checkpoints(info, value);
-        parse_components(info, value);
-        info.recipe = JsonUtils::get_or_default<std::string>(value, "recipe", "");
-        info.suggested = JsonUtils::get_or_default<bool>(value, "suggested", true);
+        json entry_recipe_options;
+        parse_registry_entry(info, value, true, entry_recipe_options);
         try {
             parse_model_source_fields(info, value);
         } catch (const std::exception& e) {
@@ -1878,9 +1958,6 @@ void ModelManager::build_cache() {
                 << "': " << e.what() << std::endl;
             continue;
         }
-        info.size = JsonUtils::get_or_default<double>(value, "size", 0.0);
-        info.cloud_provider = JsonUtils::get_or_default<std::string>(value, "cloud_provider", "");
-        info.system_prompt = JsonUtils::get_or_default<std::string>(value, "system_prompt", "");
 
         // Registry-backed user collections (created by `lemonade pull <org>/<repo>` or `--source`)
         // keep only a repo pointer in user_models.json; their components live in
@@ -1894,18 +1971,8 @@ void ModelManager::build_cache() {
             populate_collection_components_from_cache_locked(info);
         }
 
-        if (value.contains("labels") && value["labels"].is_array()) {
-            for (const auto& label : value["labels"]) {
-                info.labels.push_back(label.get<std::string>());
-            }
-        }
-
-        parse_image_defaults(info, value);
-        parse_extras(info, value);
-
-        // Parse recipe_options if present (for per-model runtime config like sdcpp_args)
-        if (value.contains("recipe_options") && value["recipe_options"].is_object()) {
-            json_recipe_options[info.model_name] = value["recipe_options"];
+        if (!entry_recipe_options.is_null()) {
+            json_recipe_options[info.model_name] = std::move(entry_recipe_options);
         }
 
         // Populate type and device fields (multi-model support)
@@ -2014,10 +2081,11 @@ void ModelManager::build_cache() {
     for (auto& [name, info] : all_models) {
         populate_model_metadata(info);
         if (info.downloaded) {
-            refresh_on_disk_size(info);
+            refresh_on_disk_size(info, scan_cache());
         }
         models_cache_[name] = info;
     }
+    scan_cache().save();
 
     rebuild_public_model_aliases_locked();
 
@@ -2100,28 +2168,11 @@ void ModelManager::add_model_to_cache(const std::string& model_name) {
     // Build ModelInfo
     ModelInfo info;
     info.model_name = model_name;
-    info.checkpoints["main"] = JsonUtils::get_or_default<std::string>(*model_json, "checkpoint", "");
-    parse_legacy_mmproj(info, *model_json);
-    load_checkpoints(info, *model_json);
-    parse_components(info, *model_json);
-    info.recipe = JsonUtils::get_or_default<std::string>(*model_json, "recipe", "");
-    info.cloud_provider = JsonUtils::get_or_default<std::string>(*model_json, "cloud_provider", "");
-
-    parse_image_defaults(info, *model_json);
-    parse_extras(info, *model_json);
-    json jro = (model_json->contains("recipe_options") && (*model_json)["recipe_options"].is_object())
-        ? (*model_json)["recipe_options"] : json(nullptr);
-    info.recipe_options = build_recipe_options(info, jro, cache_key_to_canonical_id(model_name), recipe_options_);
-
-    info.suggested = JsonUtils::get_or_default<bool>(*model_json, "suggested", is_user_model);
+    json entry_recipe_options;
+    parse_registry_entry(info, *model_json, is_user_model, entry_recipe_options);
+    info.recipe_options = build_recipe_options(info, entry_recipe_options,
+                                               cache_key_to_canonical_id(model_name), recipe_options_);
     parse_model_source_fields(info, *model_json);
-    info.system_prompt = JsonUtils::get_or_default<std::string>(*model_json, "system_prompt", "");
-
-    if (model_json->contains("labels") && (*model_json)["labels"].is_array()) {
-        for (const auto& label : (*model_json)["labels"]) {
-            info.labels.push_back(label.get<std::string>());
-        }
-    }
 
     // Populate type and device fields (multi-model support)
     info.type = get_deployment_model_type(info.recipe, info.labels);
@@ -2204,7 +2255,8 @@ void ModelManager::update_model_in_cache(const std::string& model_name, bool dow
             LOG(INFO, "ModelManager") << "Updated '" << model_name
                       << "' downloaded=" << downloaded << std::endl;
         }
-        refresh_on_disk_size(it->second);
+        refresh_on_disk_size(it->second, scan_cache());
+        scan_cache().save();
 
         // Recompute downloaded status for any collections that
         // depend on this model, so the collection reflects component changes
@@ -3677,6 +3729,89 @@ static void remove_unused_hf_snapshot(const fs::path& cache_path,
     }
 }
 
+static std::string percent_encode(const std::string& value) {
+    std::ostringstream encoded;
+    encoded << std::hex << std::uppercase << std::setfill('0');
+    for (unsigned char c : value) {
+        if (std::isalnum(c) || c == '-' || c == '_' || c == '.' || c == '~' || c == '/') {
+            encoded << c;
+        } else {
+            encoded << '%' << std::setw(2) << static_cast<int>(c);
+        }
+    }
+    return encoded.str();
+}
+
+void ModelManager::set_peer_url_provider(PeerUrlProvider provider) {
+    peer_url_provider_ = std::move(provider);
+}
+
+std::string ModelManager::find_local_model_file(const std::string& filename, size_t size) const {
+    if (filename.empty() || filename.find("..") != std::string::npos || size == 0) {
+        return "";
+    }
+
+    std::vector<std::string> roots = {get_hf_cache_dir()};
+    if (!extra_models_dir_.empty()) {
+        roots.push_back(extra_models_dir_);
+    }
+
+    for (const auto& root : roots) {
+        fs::path root_path = path_from_utf8(root);
+        std::error_code ec;
+        if (!safe_is_directory(root_path)) {
+            continue;
+        }
+        for (fs::recursive_directory_iterator it(root_path, safe_dir_options, ec), end;
+             it != end && !ec; it.increment(ec)) {
+            if (!it->is_regular_file(ec)) {
+                continue;
+            }
+            std::string candidate = path_to_utf8(it->path());
+            std::replace(candidate.begin(), candidate.end(), '\\', '/');
+            if (candidate.size() <= filename.size() + 1 ||
+                candidate.compare(candidate.size() - filename.size(), filename.size(), filename) != 0 ||
+                candidate[candidate.size() - filename.size() - 1] != '/') {
+                continue;
+            }
+            if (safe_exists(path_from_utf8(path_to_utf8(it->path()) + ".partial"))) {
+                continue;
+            }
+            std::error_code size_ec;
+            const auto on_disk = fs::file_size(it->path(), size_ec);
+            if (size_ec || on_disk != size) {
+                continue;
+            }
+            return path_to_utf8(it->path());
+        }
+    }
+    return "";
+}
+
+std::string ModelManager::find_peer_file_url(const std::string& filename, size_t size) const {
+    if (!peer_url_provider_) {
+        return "";
+    }
+    const std::string query = "internal/model-files/locate?file=" + percent_encode(filename) +
+                              "&size=" + std::to_string(size);
+    for (const auto& root : peer_url_provider_()) {
+        try {
+            auto response = HttpClient::get(root + query, {}, 5,
+                                            HttpSecurityPolicy::AllowInsecureHttp);
+            if (response.status_code != 200) {
+                continue;
+            }
+            auto body = json::parse(response.body, nullptr, /*allow_exceptions=*/false);
+            if (body.is_object() && body.value("available", false)) {
+                return root + "internal/model-files/get?file=" + percent_encode(filename) +
+                       "&size=" + std::to_string(size);
+            }
+        } catch (const std::exception&) {
+        }
+    }
+    return "";
+}
+
 void ModelManager::download_from_manifest(const json& manifest, std::map<std::string, std::string>& headers, DownloadProgressCallback progress_callback) {
     // Download each file with robust retry and resume support
     int file_index = 0;
@@ -3827,6 +3962,11 @@ void ModelManager::download_from_manifest(const json& manifest, std::map<std::st
         download_opts.low_speed_limit = 1000;
         download_opts.low_speed_time = 60;
         download_opts.connect_timeout = 60;
+        download_opts.parallel_connections =
+            RuntimeConfig::global()->download_parallel_connections();
+        download_opts.direct_io = RuntimeConfig::global()->download_direct_io();
+        download_opts.max_recv_bytes_per_sec =
+            DownloadScheduler::current_rate_limit_bytes_per_sec();
         if (file_desc.contains("hash") && file_desc["hash"].is_object()) {
             const auto& hash = file_desc["hash"];
             if (hash.contains("algorithm") && hash["algorithm"].is_string() &&
@@ -3861,13 +4001,62 @@ void ModelManager::download_from_manifest(const json& manifest, std::map<std::st
             http_progress_cb = utils::create_throttled_progress_callback();
         }
 
-        auto result = HttpClient::download_file(
-            file_url,
-            output_path,
-            http_progress_cb,
-            headers,
-            download_opts
-        );
+        utils::DownloadResult result;
+        bool fetched_from_peer = false;
+        const std::string peer_url = find_peer_file_url(filename, file_size);
+        // Files big enough for ranged striping aggregate the registry URL,
+        // configured mirrors, and the peer copy into one multi-source
+        // download; below that threshold a peer copy is still preferred
+        // wholesale since LAN round trips beat CDN latency outright.
+        const bool stripe_eligible = file_size >= download_opts.parallel_min_bytes;
+        if (!peer_url.empty() && !stripe_eligible) {
+            LOG(INFO, "ModelManager") << "Fetching " << filename << " from LAN peer" << std::endl;
+            auto peer_opts = download_opts;
+            // One shot against the peer; the registry remains the retry path.
+            peer_opts.max_retries = 1;
+            // LAN transfers are bandwidth-bound, not RTT-bound; ranged parallel
+            // connections keep a fast link busy even when the global setting is 1.
+            peer_opts.parallel_connections = (std::max)(peer_opts.parallel_connections, 4);
+            result = HttpClient::download_file(
+                peer_url,
+                output_path,
+                http_progress_cb,
+                {},
+                peer_opts,
+                utils::HttpSecurityPolicy::AllowInsecureHttp
+            );
+            fetched_from_peer = result.success;
+            if (!result.success && !result.cancelled) {
+                LOG(WARNING, "ModelManager") << "Peer fetch failed for " << filename
+                                             << "; falling back to registry" << std::endl;
+            }
+        }
+
+        if (!fetched_from_peer && !result.cancelled) {
+            auto rebase_to_mirror = [&file_url](const std::string& base) -> std::string {
+                const size_t scheme = file_url.find("://");
+                if (scheme == std::string::npos) return "";
+                const size_t path_pos = file_url.find('/', scheme + 3);
+                if (path_pos == std::string::npos) return "";
+                return base + file_url.substr(path_pos);
+            };
+            for (const auto& mirror : RuntimeConfig::global()->download_mirrors()) {
+                const std::string mirror_url = rebase_to_mirror(mirror);
+                if (!mirror_url.empty()) {
+                    download_opts.mirror_urls.push_back(mirror_url);
+                }
+            }
+            if (stripe_eligible && !peer_url.empty()) {
+                download_opts.mirror_urls.push_back(peer_url);
+            }
+            result = HttpClient::download_file(
+                file_url,
+                output_path,
+                http_progress_cb,
+                headers,
+                download_opts
+            );
+        }
 
         // Check if download was cancelled
         if (result.cancelled) {
@@ -4266,6 +4455,23 @@ void ModelManager::download_from_registry(const ModelInfo& info,
 
 
 void ModelManager::delete_model(const std::string& model_name) {
+    for (const auto& pending : unlink_model(model_name)) {
+        gc_pending_delete(pending, nullptr);
+    }
+}
+
+nlohmann::json ModelManager::PendingDelete::to_json() const {
+    return {{"path", path}, {"cache_root", cache_root}};
+}
+
+ModelManager::PendingDelete ModelManager::PendingDelete::from_json(const nlohmann::json& j) {
+    PendingDelete pending;
+    pending.path = j.value("path", "");
+    pending.cache_root = j.value("cache_root", "");
+    return pending;
+}
+
+std::vector<ModelManager::PendingDelete> ModelManager::unlink_model(const std::string& model_name) {
     auto info = get_model_info(model_name);
     std::string canonical_model_name = info.model_name;
 
@@ -4300,7 +4506,7 @@ void ModelManager::delete_model(const std::string& model_name) {
         // Remove from cache after successful deletion
         remove_model_from_cache(canonical_model_name);
 
-        return;
+        return {};
     }
 
     // Use resolved_path to find the model directory to delete.
@@ -4333,7 +4539,7 @@ void ModelManager::delete_model(const std::string& model_name) {
 
         remove_model_from_cache(canonical_model_name);
         LOG(INFO, "ModelManager") << "Successfully removed model from registry: " << canonical_model_name << std::endl;
-        return;
+        return {};
     }
 
     // Find the models--* directory from resolved_path
@@ -4364,12 +4570,11 @@ void ModelManager::delete_model(const std::string& model_name) {
     // Check if the main repo is shared with another model
     bool main_shared = is_repo_shared(main_repo, effective_registry_source(info), canonical_model_name, models_cache_);
 
+    std::vector<PendingDelete> pending_deletes;
     if (!main_shared) {
         // No other model uses this repo - safe to delete the entire directory
         if (fs::exists(model_cache_path_fs)) {
-            LOG(INFO, "ModelManager") << "Removing directory..." << std::endl;
-            fs::remove_all(model_cache_path_fs);
-            LOG(INFO, "ModelManager") << "✓ Deleted model files: " << canonical_model_name << std::endl;
+            pending_deletes.push_back({model_cache_path, ""});
         } else {
             LOG(INFO, "ModelManager") << "Warning: Model cache directory not found (may already be deleted)" << std::endl;
         }
@@ -4378,17 +4583,9 @@ void ModelManager::delete_model(const std::string& model_name) {
         LOG(INFO, "ModelManager") << "Main repo " << main_repo
                     << " is shared with other models, deleting variant path only" << std::endl;
         std::string rpath = info.resolved_path("main");
-        if (!rpath.empty()) {
-            fs::path variant_path = path_from_utf8(rpath);
-            if (safe_exists(variant_path)) {
-                // Delete the whole resolved path, not just regular files
-                // and clean any HF symlink blobs before removing the snapshot entries.
-                cleanup_orphaned_blobs_under(variant_path, model_cache_path_fs);
-                remove_resolved_path_or_throw(variant_path, "variant path");
-                cleanup_empty_parents(variant_path, model_cache_path_fs);
-            }
+        if (!rpath.empty() && safe_exists(path_from_utf8(rpath))) {
+            pending_deletes.push_back({rpath, model_cache_path});
         }
-        LOG(INFO, "ModelManager") << "✓ Deleted variant for: " << canonical_model_name << std::endl;
     }
 
     // Clean up non-main checkpoint files in their own repo dirs (multi-repo models)
@@ -4407,10 +4604,8 @@ void ModelManager::delete_model(const std::string& model_name) {
 
         // Not shared — safe to delete the entire repo directory
         std::string cp_cache_dir = get_hf_cache_dir() + "/" + repo_id_to_cache_dir_name(cp_repo, effective_registry_source(info));
-        fs::path cp_cache_path = path_from_utf8(cp_cache_dir);
-        if (fs::exists(cp_cache_path)) {
-            LOG(INFO, "ModelManager") << "Removing non-main repo directory: " << cp_cache_dir << std::endl;
-            fs::remove_all(cp_cache_path);
+        if (fs::exists(path_from_utf8(cp_cache_dir))) {
+            pending_deletes.push_back({cp_cache_dir, ""});
         }
     }
 
@@ -4428,8 +4623,79 @@ void ModelManager::delete_model(const std::string& model_name) {
         LOG(INFO, "ModelManager") << "✓ Removed from user_models.json" << std::endl;
     }
 
+    for (const auto& [type, rpath] : info.resolved_paths) {
+        (void)type;
+        if (!rpath.empty()) {
+            scan_cache().invalidate(path_from_utf8(rpath));
+        }
+    }
+    scan_cache().save();
+
     // Remove from cache after successful deletion
     remove_model_from_cache(canonical_model_name);
+
+    LOG(INFO, "ModelManager") << "Unlinked " << canonical_model_name << " from registry; "
+                << pending_deletes.size() << " tree(s) pending removal" << std::endl;
+    return pending_deletes;
+}
+
+uint64_t ModelManager::gc_pending_delete(const PendingDelete& pending,
+                                         const std::function<bool()>& should_continue) {
+    const fs::path target = path_from_utf8(pending.path);
+    if (!safe_exists(target)) {
+        return 0;
+    }
+
+    if (!pending.cache_root.empty()) {
+        const fs::path cache_root = path_from_utf8(pending.cache_root);
+        // Clean HF symlink blobs before removing the snapshot entries.
+        cleanup_orphaned_blobs_under(target, cache_root);
+        remove_resolved_path_or_throw(target, "variant path");
+        cleanup_empty_parents(target, cache_root);
+        LOG(INFO, "ModelManager") << "✓ Deleted variant path: " << pending.path << std::endl;
+        return 0;
+    }
+
+    constexpr int kBatchFiles = 32;
+    constexpr auto kBatchPause = std::chrono::milliseconds(10);
+    uint64_t bytes_freed = 0;
+    int batch = 0;
+
+    std::error_code ec;
+    if (fs::is_directory(target, ec)) {
+        fs::recursive_directory_iterator it(
+            target, fs::directory_options::skip_permission_denied, ec);
+        for (fs::recursive_directory_iterator end; !ec && it != end; it.increment(ec)) {
+            if (should_continue && !should_continue()) {
+                LOG(INFO, "ModelManager") << "Deletion of " << pending.path
+                            << " interrupted; remaining files left for a later pass" << std::endl;
+                return bytes_freed;
+            }
+            std::error_code entry_ec;
+            const auto status = it->symlink_status(entry_ec);
+            if (entry_ec || fs::is_directory(status)) {
+                continue;
+            }
+            uint64_t size = 0;
+            if (fs::is_regular_file(status)) {
+                size = it->file_size(entry_ec);
+                if (entry_ec) size = 0;
+            }
+            std::error_code remove_ec;
+            if (fs::remove(it->path(), remove_ec)) {
+                bytes_freed += size;
+            }
+            if (++batch >= kBatchFiles) {
+                batch = 0;
+                std::this_thread::sleep_for(kBatchPause);
+            }
+        }
+    }
+
+    fs::remove_all(target);
+    LOG(INFO, "ModelManager") << "✓ Deleted " << pending.path << " ("
+                << (bytes_freed / (1024 * 1024)) << " MB)" << std::endl;
+    return bytes_freed;
 }
 
 json ModelManager::cleanup_orphaned_cache(bool dry_run) {
@@ -4512,9 +4778,8 @@ ModelInfo ModelManager::get_model_info(const std::string& model_name) {
 
     // O(1) lookup in cache
     {
+        std::string canonical_name = alias_index_.resolve(model_name);
         std::lock_guard<std::mutex> lock(models_cache_mutex_);
-        auto alias_it = public_model_aliases_.find(model_name);
-        std::string canonical_name = alias_it != public_model_aliases_.end() ? alias_it->second : model_name;
         auto it = models_cache_.find(canonical_name);
         if (it != models_cache_.end()) {
             return it->second;
@@ -4522,9 +4787,8 @@ ModelInfo ModelManager::get_model_info(const std::string& model_name) {
     }
 
     if (refresh_user_models_from_disk_for_lookup(model_name)) {
+        std::string canonical_name = alias_index_.resolve(model_name);
         std::lock_guard<std::mutex> lock(models_cache_mutex_);
-        auto alias_it = public_model_aliases_.find(model_name);
-        std::string canonical_name = alias_it != public_model_aliases_.end() ? alias_it->second : model_name;
         auto it = models_cache_.find(canonical_name);
         if (it != models_cache_.end()) {
             return it->second;
@@ -4537,17 +4801,13 @@ ModelInfo ModelManager::get_model_info(const std::string& model_name) {
 std::string ModelManager::resolve_model_name(const std::string& model_name) {
     build_cache();
 
-    std::lock_guard<std::mutex> lock(models_cache_mutex_);
-    auto it = public_model_aliases_.find(model_name);
-    return it != public_model_aliases_.end() ? it->second : model_name;
+    return alias_index_.resolve(model_name);
 }
 
 std::string ModelManager::get_public_model_name(const std::string& model_name) {
     build_cache();
 
-    std::lock_guard<std::mutex> lock(models_cache_mutex_);
-    auto it = canonical_public_names_.find(model_name);
-    return it != canonical_public_names_.end() ? it->second : model_name;
+    return alias_index_.public_name(model_name);
 }
 
 bool ModelManager::model_exists(const std::string& model_name) {
@@ -4556,18 +4816,16 @@ bool ModelManager::model_exists(const std::string& model_name) {
 
     // O(1) lookup in cache
     {
+        std::string canonical_name = alias_index_.resolve(model_name);
         std::lock_guard<std::mutex> lock(models_cache_mutex_);
-        auto alias_it = public_model_aliases_.find(model_name);
-        std::string canonical_name = alias_it != public_model_aliases_.end() ? alias_it->second : model_name;
         if (models_cache_.find(canonical_name) != models_cache_.end()) {
             return true;
         }
     }
 
     if (refresh_user_models_from_disk_for_lookup(model_name)) {
+        std::string canonical_name = alias_index_.resolve(model_name);
         std::lock_guard<std::mutex> lock(models_cache_mutex_);
-        auto alias_it = public_model_aliases_.find(model_name);
-        std::string canonical_name = alias_it != public_model_aliases_.end() ? alias_it->second : model_name;
         return models_cache_.find(canonical_name) != models_cache_.end();
     }
 
@@ -4823,32 +5081,9 @@ ModelInfo ModelManager::get_model_info_unfiltered(const std::string& model_name)
     info.model_name = is_user_lookup
         ? canonical_id(ModelSource::Registered, registry_name)
         : registry_name;
-    info.checkpoints["main"] = JsonUtils::get_or_default<std::string>(*model_json, "checkpoint", "");
-    parse_legacy_mmproj(info, *model_json);
-    load_checkpoints(info, *model_json);
-    parse_components(info, *model_json);
-    info.recipe = JsonUtils::get_or_default<std::string>(*model_json, "recipe", "");
-    info.suggested = JsonUtils::get_or_default<bool>(*model_json, "suggested", false);
+    json entry_recipe_options;
+    parse_registry_entry(info, *model_json, false, entry_recipe_options);
     parse_model_source_fields(info, *model_json);
-    info.system_prompt = JsonUtils::get_or_default<std::string>(*model_json, "system_prompt", "");
-
-    // Parse labels array
-    if (model_json->contains("labels") && (*model_json)["labels"].is_array()) {
-        for (const auto& label : (*model_json)["labels"]) {
-            if (label.is_string()) {
-                info.labels.push_back(label.get<std::string>());
-            }
-        }
-    }
-
-    // Parse size
-    if (model_json->contains("size")) {
-        if ((*model_json)["size"].is_number()) {
-            info.size = (*model_json)["size"].get<double>();
-        }
-    }
-
-    parse_extras(info, *model_json);
 
     return info;
 }
@@ -4938,6 +5173,19 @@ void ModelManager::rebuild_public_model_aliases_locked() {
         std::string canonical = canonical_id(ModelSource::Builtin, cache_key);
         public_model_aliases_.try_emplace(canonical, cache_key);
     }
+
+    std::vector<ModelSearchEntry> search_entries;
+    search_entries.reserve(models_cache_.size());
+    for (const auto& [cache_key, info] : models_cache_) {
+        ModelSearchEntry entry;
+        entry.name = cache_key;
+        entry.fields = info.labels;
+        entry.fields.push_back(info.recipe);
+        entry.fields.push_back(model_type_to_string(info.type));
+        search_entries.push_back(std::move(entry));
+    }
+    search_index_.rebuild(std::move(search_entries));
+    alias_index_.rebuild(public_model_aliases_, canonical_public_names_);
 }
 
 } // namespace lemon
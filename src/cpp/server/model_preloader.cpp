@@ -0,0 +1,287 @@
+#include "lemon/model_preloader.h"
+
+#include "lemon/model_manager.h"
+#include "lemon/router.h"
+#include "lemon/runtime_config.h"
+#include "lemon/utils/aixlog.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <ctime>
+#include <fstream>
+#include <nlohmann/json.hpp>
+
+namespace lemon {
+
+namespace {
+
+using json = nlohmann::json;
+
+constexpr int kInitialWarmDelaySeconds = 10;
+constexpr int kScheduleIntervalMinutes = 15;
+constexpr int64_t kHistoryRetentionDays = 30;
+
+int current_hour() {
+    std::time_t now = std::time(nullptr);
+    std::tm tm_buf{};
+#ifdef _WIN32
+    localtime_s(&tm_buf, &now);
+#else
+    localtime_r(&now, &tm_buf);
+#endif
+    return tm_buf.tm_hour;
+}
+
+int64_t current_day() {
+    return static_cast<int64_t>(std::time(nullptr) / 86400);
+}
+
+} // namespace
+
+ModelPreloader::ModelPreloader(Router* router,
+                               ModelManager* model_manager,
+                               const std::string& cache_dir,
+                               std::function<void(const std::string&)> load_model)
+    : router_(router),
+      model_manager_(model_manager),
+      history_path_(cache_dir + "/preload_history.json"),
+      load_model_(std::move(load_model)) {
+    load_history();
+}
+
+ModelPreloader::~ModelPreloader() {
+    stop();
+}
+
+void ModelPreloader::start() {
+    if (running_.exchange(true)) {
+        return;
+    }
+    scheduler_thread_ = std::thread(&ModelPreloader::scheduler_loop, this);
+}
+
+void ModelPreloader::stop() {
+    if (!running_.exchange(false)) {
+        return;
+    }
+    wake_cv_.notify_all();
+    if (scheduler_thread_.joinable()) {
+        scheduler_thread_.join();
+    }
+    save_history();
+}
+
+void ModelPreloader::record_use(const std::string& model_name) {
+    if (model_name.empty()) {
+        return;
+    }
+    // Warm loads issued by the scheduler come back through the same load
+    // path; they must not feed the history they were predicted from.
+    if (std::this_thread::get_id() == scheduler_thread_.get_id()) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    decay_if_new_day_locked();
+    auto& entry = history_[model_name];
+    entry.hour_counts[current_hour()] += 1.0;
+    entry.last_used = static_cast<int64_t>(std::time(nullptr));
+    dirty_ = true;
+}
+
+std::map<std::string, ModelPreloader::UsageStat> ModelPreloader::usage_snapshot() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::map<std::string, UsageStat> out;
+    for (const auto& [model, entry] : history_) {
+        UsageStat stat;
+        stat.last_used = entry.last_used;
+        for (double count : entry.hour_counts) {
+            stat.total_uses += count;
+        }
+        out[model] = stat;
+    }
+    return out;
+}
+
+void ModelPreloader::scheduler_loop() {
+    // Initial warm pass shortly after startup so a restart during working
+    // hours comes back warm without waiting for the first request.
+    {
+        std::unique_lock<std::mutex> lock(wake_mutex_);
+        wake_cv_.wait_for(lock, std::chrono::seconds(kInitialWarmDelaySeconds),
+                          [this] { return !running_.load(); });
+    }
+
+    while (running_.load()) {
+        try {
+            warm_top_models();
+        } catch (const std::exception& e) {
+            LOG(WARNING, "Preloader") << "Warm pass failed: " << e.what() << std::endl;
+        }
+        save_history();
+
+        std::unique_lock<std::mutex> lock(wake_mutex_);
+        wake_cv_.wait_for(lock, std::chrono::minutes(kScheduleIntervalMinutes),
+                          [this] { return !running_.load(); });
+    }
+}
+
+void ModelPreloader::warm_top_models() {
+    const int top_n = RuntimeConfig::global()->preload_top_n();
+    if (top_n <= 0) {
+        return;
+    }
+
+    for (const auto& name : pick_candidates(top_n)) {
+        if (!running_.load()) {
+            return;
+        }
+        if (router_->is_model_loaded(name)) {
+            continue;
+        }
+        // Warming never downloads — only models already on disk qualify.
+        if (!model_manager_->model_exists(name) ||
+            !model_manager_->is_model_downloaded(name)) {
+            continue;
+        }
+
+        const double vram = router_->current_vram_usage();
+        const double threshold = RuntimeConfig::global()->auto_evict_threshold_pct();
+        if (vram >= threshold) {
+            LOG(INFO, "Preloader") << "Skipping warm loads: VRAM usage "
+                                   << (vram * 100.0) << "% is over the eviction threshold"
+                                   << std::endl;
+            return;
+        }
+
+        LOG(INFO, "Preloader") << "Warming model from usage history: " << name << std::endl;
+        try {
+            load_model_(name);
+        } catch (const std::exception& e) {
+            LOG(WARNING, "Preloader") << "Warm load failed for " << name
+                                      << ": " << e.what() << std::endl;
+        }
+    }
+}
+
+std::vector<std::string> ModelPreloader::pick_candidates(int top_n) {
+    const int hour = current_hour();
+    std::vector<std::pair<double, std::string>> scored;
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        decay_if_new_day_locked();
+        for (const auto& [name, entry] : history_) {
+            const double score =
+                entry.hour_counts[hour] + entry.hour_counts[(hour + 1) % 24];
+            if (score >= 1.0) {
+                scored.emplace_back(score, name);
+            }
+        }
+    }
+
+    std::sort(scored.begin(), scored.end(),
+              [](const auto& a, const auto& b) { return a.first > b.first; });
+    if (static_cast<int>(scored.size()) > top_n) {
+        scored.resize(static_cast<size_t>(top_n));
+    }
+
+    std::vector<std::string> names;
+    names.reserve(scored.size());
+    for (const auto& [score, name] : scored) {
+        names.push_back(name);
+    }
+    return names;
+}
+
+void ModelPreloader::decay_if_new_day_locked() {
+    const int64_t today = current_day();
+    if (last_decay_day_ == 0) {
+        last_decay_day_ = today;
+        return;
+    }
+    if (today <= last_decay_day_) {
+        return;
+    }
+
+    // Halve counts once per elapsed day so recent habits dominate stale ones.
+    const int64_t days = std::min<int64_t>(today - last_decay_day_, 10);
+    const double factor = std::pow(0.5, static_cast<double>(days));
+    const int64_t cutoff =
+        static_cast<int64_t>(std::time(nullptr)) - kHistoryRetentionDays * 86400;
+
+    for (auto it = history_.begin(); it != history_.end();) {
+        if (it->second.last_used < cutoff) {
+            it = history_.erase(it);
+            continue;
+        }
+        for (auto& count : it->second.hour_counts) {
+            count *= factor;
+        }
+        ++it;
+    }
+    last_decay_day_ = today;
+    dirty_ = true;
+}
+
+void ModelPreloader::load_history() {
+    std::ifstream file(history_path_);
+    if (!file.is_open()) {
+        return;
+    }
+
+    try {
+        json data = json::parse(file);
+        std::lock_guard<std::mutex> lock(mutex_);
+        last_decay_day_ = data.value("last_decay_day", int64_t{0});
+        if (data.contains("models") && data["models"].is_object()) {
+            for (const auto& [name, entry] : data["models"].items()) {
+                ModelHistory history;
+                if (entry.contains("hour_counts") && entry["hour_counts"].is_array() &&
+                    entry["hour_counts"].size() == history.hour_counts.size()) {
+                    for (size_t i = 0; i < history.hour_counts.size(); i++) {
+                        history.hour_counts[i] = entry["hour_counts"][i].get<double>();
+                    }
+                }
+                history.last_used = entry.value("last_used", int64_t{0});
+                history_[name] = history;
+            }
+        }
+    } catch (const std::exception& e) {
+        LOG(WARNING, "Preloader") << "Discarding unreadable usage history at "
+                                  << history_path_ << ": " << e.what() << std::endl;
+    }
+}
+
+void ModelPreloader::save_history() {
+    json models = json::object();
+    json data;
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!dirty_) {
+            return;
+        }
+        for (const auto& [name, entry] : history_) {
+            models[name] = {
+                {"hour_counts", entry.hour_counts},
+                {"last_used", entry.last_used},
+            };
+        }
+        data = {
+            {"last_decay_day", last_decay_day_},
+            {"models", models},
+        };
+        dirty_ = false;
+    }
+
+    std::ofstream file(history_path_);
+    if (!file.is_open()) {
+        LOG(WARNING, "Preloader") << "Could not write usage history to "
+                                  << history_path_ << std::endl;
+        return;
+    }
+    file << data.dump(2);
+}
+
+} // namespace lemon
@@ -0,0 +1,193 @@
+#include <lemon/model_search_index.h>
+
+#include <algorithm>
+#include <cctype>
+#include <map>
+#include <mutex>
+#include <utility>
+
+namespace lemon {
+
+namespace {
+
+std::string lower_copy(std::string value) {
+    std::transform(value.begin(), value.end(), value.begin(), [](unsigned char c) {
+        return static_cast<char>(std::tolower(c));
+    });
+    return value;
+}
+
+std::vector<std::string> tokenize(const std::string& text) {
+    std::vector<std::string> tokens;
+    std::string current;
+    for (const unsigned char c : text) {
+        if (std::isalnum(c)) {
+            current.push_back(static_cast<char>(std::tolower(c)));
+        } else if (!current.empty()) {
+            tokens.push_back(std::move(current));
+            current.clear();
+        }
+    }
+    if (!current.empty()) {
+        tokens.push_back(std::move(current));
+    }
+    return tokens;
+}
+
+std::string compact_text(const std::string& text) {
+    std::string compact;
+    compact.reserve(text.size());
+    for (const unsigned char c : text) {
+        if (std::isalnum(c)) {
+            compact.push_back(static_cast<char>(std::tolower(c)));
+        }
+    }
+    return compact;
+}
+
+bool starts_with(const std::string& value, const std::string& prefix) {
+    return value.size() >= prefix.size() &&
+           value.compare(0, prefix.size(), prefix) == 0;
+}
+
+// Lower is better: 0 exact token, 1 token prefix, 2 token substring,
+// 3 compact-text substring.
+constexpr int kMatchExact = 0;
+constexpr int kMatchPrefix = 1;
+constexpr int kMatchSubstring = 2;
+constexpr int kMatchCompact = 3;
+
+} // namespace
+
+void ModelSearchIndex::rebuild(std::vector<ModelSearchEntry> entries) {
+    std::vector<Entry> new_entries;
+    std::map<std::string, std::vector<uint32_t>> new_index;
+    new_entries.reserve(entries.size());
+
+    for (auto& source : entries) {
+        const auto id = static_cast<uint32_t>(new_entries.size());
+        std::string full_text = source.name;
+        for (const auto& field : source.fields) {
+            full_text += ' ';
+            full_text += field;
+        }
+
+        for (auto& token : tokenize(full_text)) {
+            auto& postings = new_index[std::move(token)];
+            if (postings.empty() || postings.back() != id) {
+                postings.push_back(id);
+            }
+        }
+        new_entries.push_back({std::move(source.name), compact_text(full_text)});
+    }
+
+    std::unique_lock lock(mutex_);
+    entries_ = std::move(new_entries);
+    token_index_ = std::move(new_index);
+}
+
+std::vector<std::string> ModelSearchIndex::search(const std::string& query,
+                                                 size_t limit) const {
+    const auto query_tokens = tokenize(query);
+    if (query_tokens.empty() || limit == 0) {
+        return {};
+    }
+
+    std::shared_lock lock(mutex_);
+
+    // score[id] accumulates per-token match quality; an entry survives only if
+    // every query token matched it.
+    std::map<uint32_t, int> scores;
+    for (size_t t = 0; t < query_tokens.size(); ++t) {
+        const std::string& token = query_tokens[t];
+        std::map<uint32_t, int> token_matches;
+
+        for (auto it = token_index_.lower_bound(token);
+             it != token_index_.end() && starts_with(it->first, token); ++it) {
+            const int quality = (it->first.size() == token.size()) ? kMatchExact
+                                                                   : kMatchPrefix;
+            for (const uint32_t id : it->second) {
+                auto [entry, inserted] = token_matches.emplace(id, quality);
+                if (!inserted && quality < entry->second) {
+                    entry->second = quality;
+                }
+            }
+        }
+
+        // Substring pass over the token set (not the registry): only tokens
+        // that did not already prefix-match can add candidates.
+        for (const auto& [indexed_token, postings] : token_index_) {
+            if (starts_with(indexed_token, token) ||
+                indexed_token.find(token) == std::string::npos) {
+                continue;
+            }
+            for (const uint32_t id : postings) {
+                token_matches.emplace(id, kMatchSubstring);
+            }
+        }
+
+        if (t == 0) {
+            scores = std::move(token_matches);
+        } else {
+            for (auto it = scores.begin(); it != scores.end();) {
+                auto match = token_matches.find(it->first);
+                if (match == token_matches.end()) {
+                    it = scores.erase(it);
+                } else {
+                    it->second += match->second;
+                    ++it;
+                }
+            }
+        }
+        if (scores.empty()) {
+            break;
+        }
+    }
+
+    // Cross-token substrings ("ama31" in "Llama-3.1") only appear in the
+    // compacted text, so entries the token passes missed get one more chance.
+    const std::string query_compact = compact_text(query);
+    if (!query_compact.empty()) {
+        for (uint32_t id = 0; id < entries_.size(); ++id) {
+            if (scores.count(id) == 0 &&
+                entries_[id].compact.find(query_compact) != std::string::npos) {
+                scores[id] = kMatchCompact * static_cast<int>(query_tokens.size());
+            }
+        }
+    }
+
+    std::vector<std::pair<int, uint32_t>> ranked;
+    ranked.reserve(scores.size());
+    for (const auto& [id, score] : scores) {
+        ranked.push_back({score, id});
+    }
+    std::sort(ranked.begin(), ranked.end(),
+              [this](const auto& lhs, const auto& rhs) {
+                  if (lhs.first != rhs.first) {
+                      return lhs.first < rhs.first;
+                  }
+                  const auto& lhs_name = entries_[lhs.second].name;
+                  const auto& rhs_name = entries_[rhs.second].name;
+                  if (lhs_name.size() != rhs_name.size()) {
+                      return lhs_name.size() < rhs_name.size();
+                  }
+                  return lower_copy(lhs_name) < lower_copy(rhs_name);
+              });
+
+    std::vector<std::string> results;
+    results.reserve((std::min)(ranked.size(), limit));
+    for (const auto& [score, id] : ranked) {
+        if (results.size() >= limit) {
+            break;
+        }
+        results.push_back(entries_[id].name);
+    }
+    return results;
+}
+
+size_t ModelSearchIndex::size() const {
+    std::shared_lock lock(mutex_);
+    return entries_.size();
+}
+
+} // namespace lemon
@@ -1,6 +1,9 @@
 #include "lemon/ollama_api.h"
+#include "lemon/buffer_pool.h"
 #include "lemon/error_types.h"
 #include "lemon/model_types.h"
+#include "lemon/ollama_mapping.h"
+#include "lemon/request_json.h"
 #include "lemon/runtime_config.h"
 #include <iostream>
 #include <lemon/utils/aixlog.hpp>
@@ -101,10 +104,6 @@ static bool send_backend_error(const json& response, httplib::Response& res) {
     return true;
 }
 
-// ============================================================================
-// Ollama → OpenAI option name mapping (ollama_key → openai_key)
-// Options where both names are the same use identical strings.
-// ============================================================================
 static void set_ollama_residency_conflict_response(
     const RouterResidencyConflictException& error,
     httplib::Response& res) {
@@ -117,40 +116,13 @@ static void set_ollama_residency_conflict_response(
     res.set_content(body.dump(), "application/json");
 }
 
-struct OptionMapping { const char* ollama_key; const char* openai_key; };
-
-static const OptionMapping OPTION_MAPPINGS[] = {
-    {"temperature",    "temperature"},
-    {"top_p",          "top_p"},
-    {"seed",           "seed"},
-    {"stop",           "stop"},
-    {"num_predict",    "max_tokens"},
-    {"repeat_penalty", "frequency_penalty"},
-};
-
-// Apply the option mappings from an Ollama request to an OpenAI request.
-// Checks the "options" sub-object first, then top-level keys (top-level wins).
-static void map_ollama_options(const json& ollama_request, json& openai_req) {
-    // From options sub-object
-    if (ollama_request.contains("options") && ollama_request["options"].is_object()) {
-        const auto& opts = ollama_request["options"];
-        for (const auto& m : OPTION_MAPPINGS) {
-            if (opts.contains(m.ollama_key)) {
-                openai_req[m.openai_key] = opts[m.ollama_key];
-            }
-        }
-    }
-
-    // Top-level overrides (Ollama also accepts these at the top level)
-    for (const auto& m : OPTION_MAPPINGS) {
-        if (ollama_request.contains(m.ollama_key)) {
-            openai_req[m.openai_key] = ollama_request[m.ollama_key];
-        }
-    }
+OllamaApi::OllamaApi(Router* router, ModelManager* model_manager,
+                     std::atomic<uint64_t>* models_epoch)
+    : router_(router), model_manager_(model_manager), models_epoch_(models_epoch) {
 }
 
-OllamaApi::OllamaApi(Router* router, ModelManager* model_manager)
-    : router_(router), model_manager_(model_manager) {
+void OllamaApi::bump_models_epoch() {
+    models_epoch_->fetch_add(1, std::memory_order_relaxed);
 }
 
 void OllamaApi::register_routes(httplib::Server& server) {
@@ -266,9 +238,11 @@ void OllamaApi::auto_load_model(const std::string& model, const json& request_op
         LOG(INFO, "OllamaApi") << "Model not cached, downloading..." << std::endl;
         model_manager_->download_registered_model(info, true);
         info = model_manager_->get_model_info(name);
+        bump_models_epoch();
     }
 
     router_->load_model(name, info, RecipeOptions(info.recipe, request_options), true);
+    bump_models_epoch();
     LOG(INFO, "OllamaApi") << "Model loaded: " << name << std::endl;
 }
 
@@ -283,7 +257,7 @@ nlohmann::json OllamaApi::extract_auto_load_options(const json& request) {
         result["ctx_size"] = request["options"]["num_ctx"];
     }
 
-    // Top-level wins over options.num_ctx, matching map_ollama_options precedence.
+    // Top-level wins over options.num_ctx, matching ollama::map_options precedence.
     if (request.contains("ctx_size")) {
         result["ctx_size"] = request["ctx_size"];
     }
@@ -335,61 +309,6 @@ static json build_ollama_capabilities(const ModelInfo& info) {
     return capabilities;
 }
 
-static json normalize_ollama_tool_calls(json tool_calls) {
-    if (!tool_calls.is_array()) {
-        return tool_calls;
-    }
-
-    for (auto& tool_call : tool_calls) {
-        if (!tool_call.is_object() ||
-            !tool_call.contains("function") ||
-            !tool_call["function"].is_object()) {
-            continue;
-        }
-
-        auto& function = tool_call["function"];
-        if (!function.contains("arguments") || !function["arguments"].is_string()) {
-            continue;
-        }
-
-        std::string arguments = function["arguments"].get<std::string>();
-        try {
-            function["arguments"] = json::parse(arguments);
-        } catch (const std::exception&) {
-            function["arguments"] = json::object();
-        }
-    }
-
-    return tool_calls;
-}
-
-static json normalize_openai_tool_calls(json tool_calls) {
-    if (!tool_calls.is_array()) {
-        return tool_calls;
-    }
-
-    for (auto& tool_call : tool_calls) {
-        if (!tool_call.is_object() ||
-            !tool_call.contains("function") ||
-            !tool_call["function"].is_object()) {
-            continue;
-        }
-
-        if (!tool_call.contains("type") || !tool_call["type"].is_string()) {
-            tool_call["type"] = "function";
-        }
-
-        auto& function = tool_call["function"];
-        if (!function.contains("arguments") || function["arguments"].is_string()) {
-            continue;
-        }
-
-        function["arguments"] = function["arguments"].dump();
-    }
-
-    return tool_calls;
-}
-
 json OllamaApi::build_ollama_model_entry(const std::string& id, const ModelInfo& info) {
     // Compute size in bytes (info.size is in GB)
     int64_t size_bytes = static_cast<int64_t>(info.size * 1073741824.0);  // 1 GB = 2^30 bytes
@@ -405,235 +324,6 @@ json OllamaApi::build_ollama_model_entry(const std::string& id, const ModelInfo&
 
     return entry;
 }
-
-// ============================================================================
-// Request conversion: Ollama chat → OpenAI chat
-// ============================================================================
-json OllamaApi::convert_ollama_to_openai_chat(const json& ollama_request) {
-    json openai_req;
-
-    // Map model (normalize name)
-    std::string model = normalize_model_name(ollama_request.value("model", ""));
-    openai_req["model"] = model;
-
-    // Map messages
-    if (ollama_request.contains("messages")) {
-        json messages = json::array();
-        std::unordered_map<std::string, std::string> tool_call_ids_by_name;
-        for (const auto& msg : ollama_request["messages"]) {
-            json openai_msg;
-            std::string role = msg.value("role", "user");
-            openai_msg["role"] = role;
-
-            // Handle content - could be string or have images
-            if (msg.contains("images") && msg["images"].is_array() && !msg["images"].empty()) {
-                // Multimodal: convert to OpenAI content array format
-                json content_parts = json::array();
-                if (msg.contains("content") && !msg["content"].get<std::string>().empty()) {
-                    content_parts.push_back({{"type", "text"}, {"text", msg["content"]}});
-                }
-                for (const auto& img : msg["images"]) {
-                    content_parts.push_back({
-                        {"type", "image_url"},
-                        {"image_url", {{"url", "data:image/png;base64," + img.get<std::string>()}}}
-                    });
-                }
-                openai_msg["content"] = content_parts;
-            } else {
-                openai_msg["content"] = msg.value("content", "");
-            }
-
-            // Forward tool_calls if present
-            if (msg.contains("tool_calls") && msg["tool_calls"].is_array() && !msg["tool_calls"].empty()) {
-                auto tool_calls = normalize_openai_tool_calls(msg["tool_calls"]);
-                openai_msg["tool_calls"] = tool_calls;
-                for (const auto& tool_call : tool_calls) {
-                    if (tool_call.contains("id") && tool_call["id"].is_string() &&
-                        tool_call.contains("function") && tool_call["function"].is_object() &&
-                        tool_call["function"].contains("name") && tool_call["function"]["name"].is_string()) {
-                        tool_call_ids_by_name[tool_call["function"]["name"].get<std::string>()] =
-                            tool_call["id"].get<std::string>();
-                    }
-                }
-            }
-
-            if (role == "tool") {
-                if (msg.contains("tool_call_id") && msg["tool_call_id"].is_string()) {
-                    openai_msg["tool_call_id"] = msg["tool_call_id"];
-                } else if (msg.contains("tool_name") && msg["tool_name"].is_string()) {
-                    auto it = tool_call_ids_by_name.find(msg["tool_name"].get<std::string>());
-                    if (it != tool_call_ids_by_name.end()) {
-                        openai_msg["tool_call_id"] = it->second;
-                    }
-                }
-            }
-
-            messages.push_back(openai_msg);
-        }
-        openai_req["messages"] = messages;
-    }
-
-    // Map options (from "options" sub-object and top-level)
-    map_ollama_options(ollama_request, openai_req);
-
-    // Map tools if present
-    if (ollama_request.contains("tools")) {
-        openai_req["tools"] = ollama_request["tools"];
-    }
-
-    // Map format: "json" → response_format
-    if (ollama_request.contains("format") && ollama_request["format"].is_string() &&
-        ollama_request["format"].get<std::string>() == "json") {
-        openai_req["response_format"] = {{"type", "json_object"}};
-    }
-
-    // Map think parameter → enable_thinking (controls reasoning output)
-    if (ollama_request.contains("think")) {
-        openai_req["enable_thinking"] = ollama_request["think"];
-    }
-
-    // Stream flag is handled by the caller
-    openai_req["stream"] = false;
-
-    return openai_req;
-}
-
-// ============================================================================
-// Request conversion: Ollama generate → OpenAI completion
-// ============================================================================
-json OllamaApi::convert_ollama_to_openai_completion(const json& ollama_request) {
-    json openai_req;
-
-    std::string model = normalize_model_name(ollama_request.value("model", ""));
-    openai_req["model"] = model;
-
-    // For /api/generate, if there's a "system" field and "prompt", combine into messages
-    // for chat completion (since many backends don't support raw completion)
-    if (ollama_request.contains("prompt")) {
-        openai_req["prompt"] = ollama_request["prompt"];
-    }
-
-    // Map options (from "options" sub-object and top-level)
-    map_ollama_options(ollama_request, openai_req);
-
-    openai_req["stream"] = false;
-
-    return openai_req;
-}
-
-// ============================================================================
-// Response conversion: OpenAI chat response → Ollama chat response
-// ============================================================================
-json OllamaApi::convert_openai_chat_to_ollama(const json& openai_response, const std::string& model) {
-    json ollama_res;
-    ollama_res["model"] = model;
-    ollama_res["created_at"] = "2024-01-01T00:00:00Z";
-
-    // Extract message from first choice
-    if (openai_response.contains("choices") && !openai_response["choices"].empty()) {
-        const auto& choice = openai_response["choices"][0];
-        if (choice.contains("message")) {
-            const auto& message = choice["message"];
-            json msg;
-            msg["role"] = (message.contains("role") && message["role"].is_string())
-                          ? message["role"].get<std::string>() : "assistant";
-            msg["content"] = (message.contains("content") && message["content"].is_string())
-                             ? message["content"].get<std::string>() : "";
-
-            // Map reasoning_content → thinking (Ollama uses "thinking" for reasoning models)
-            if (message.contains("reasoning_content") && message["reasoning_content"].is_string()) {
-                msg["thinking"] = message["reasoning_content"].get<std::string>();
-            }
-
-            // Forward tool_calls if present
-            if (message.contains("tool_calls")) {
-                msg["tool_calls"] = normalize_ollama_tool_calls(message["tool_calls"]);
-            }
-
-            ollama_res["message"] = msg;
-        }
-
-        ollama_res["done_reason"] = (choice.contains("finish_reason") && choice["finish_reason"].is_string())
-                                    ? choice["finish_reason"].get<std::string>() : "stop";
-    }
-
-    ollama_res["done"] = true;
-
-    // Extract usage → Ollama duration/count fields
-    if (openai_response.contains("usage")) {
-        const auto& usage = openai_response["usage"];
-        int prompt_tokens = usage.value("prompt_tokens", 0);
-        int completion_tokens = usage.value("completion_tokens", 0);
-
-        ollama_res["prompt_eval_count"] = prompt_tokens;
-        ollama_res["eval_count"] = completion_tokens;
-
-        // Provide reasonable timing estimates (nanoseconds)
-        // These are approximations since the OpenAI response doesn't include timings
-        ollama_res["total_duration"] = 0;
-        ollama_res["load_duration"] = 0;
-        ollama_res["prompt_eval_duration"] = 0;
-        ollama_res["eval_duration"] = 0;
-    }
-
-    // If timings are available (from llama.cpp backends), use them
-    if (openai_response.contains("timings")) {
-        const auto& timings = openai_response["timings"];
-        if (timings.contains("prompt_n"))
-            ollama_res["prompt_eval_count"] = timings["prompt_n"];
-        if (timings.contains("predicted_n"))
-            ollama_res["eval_count"] = timings["predicted_n"];
-        if (timings.contains("prompt_ms"))
-            ollama_res["prompt_eval_duration"] = static_cast<int64_t>(timings["prompt_ms"].get<double>() * 1000000);
-        if (timings.contains("predicted_ms"))
-            ollama_res["eval_duration"] = static_cast<int64_t>(timings["predicted_ms"].get<double>() * 1000000);
-    }
-
-    return ollama_res;
-}
-
-// ============================================================================
-// Response conversion: OpenAI streaming delta → Ollama streaming chunk
-// ============================================================================
-json OllamaApi::convert_openai_delta_to_ollama(const json& openai_chunk, const std::string& model) {
-    json ollama_chunk;
-    ollama_chunk["model"] = model;
-    ollama_chunk["created_at"] = "2024-01-01T00:00:00Z";
-    ollama_chunk["done"] = false;
-
-    // Extract delta content
-    if (openai_chunk.contains("choices") && !openai_chunk["choices"].empty()) {
-        const auto& choice = openai_chunk["choices"][0];
-        if (choice.contains("delta")) {
-            const auto& delta = choice["delta"];
-            json msg;
-            msg["role"] = (delta.contains("role") && delta["role"].is_string())
-                          ? delta["role"].get<std::string>() : "assistant";
-            msg["content"] = (delta.contains("content") && delta["content"].is_string())
-                             ? delta["content"].get<std::string>() : "";
-
-            // Map reasoning_content → thinking (Ollama uses "thinking" for reasoning models)
-            if (delta.contains("reasoning_content") && delta["reasoning_content"].is_string()) {
-                msg["thinking"] = delta["reasoning_content"].get<std::string>();
-            }
-
-            if (delta.contains("tool_calls")) {
-                msg["tool_calls"] = delta["tool_calls"];
-            }
-
-            ollama_chunk["message"] = msg;
-        }
-
-        // Check for finish_reason
-        if (choice.contains("finish_reason") && !choice["finish_reason"].is_null()) {
-            ollama_chunk["done"] = true;
-            ollama_chunk["done_reason"] = choice["finish_reason"];
-        }
-    }
-
-    return ollama_chunk;
-}
-
 // ============================================================================
 // Common streaming adapter: SSE → NDJSON
 // Parses OpenAI SSE stream, converts each chunk via convert_chunk, writes
@@ -646,12 +336,13 @@ void OllamaApi::stream_sse_to_ndjson(const std::string& openai_body,
                                       StreamFn call_router) {
     httplib::DataSink adapter_sink;
     std::string sse_buffer;
+    auto frame = BufferPool::acquire(4096);
     int eval_count = 0;
     int prompt_eval_count = 0;
 
     adapter_sink.is_writable = client_sink.is_writable;
 
-    adapter_sink.write = [&client_sink, &sse_buffer, &eval_count,
+    adapter_sink.write = [&client_sink, &sse_buffer, &frame, &eval_count,
                           &prompt_eval_count, &convert_chunk](const char* data, size_t len) -> bool {
         sse_buffer.append(data, len);
 
@@ -686,8 +377,10 @@ void OllamaApi::stream_sse_to_ndjson(const std::string& openai_body,
                 }
 
                 auto ollama_chunk = convert_chunk(openai_chunk);
-                std::string ndjson = ollama_chunk.dump() + "\n";
-                if (!client_sink.write(ndjson.c_str(), ndjson.size())) {
+                std::string& ndjson = frame.str();
+                ndjson.assign(ollama_chunk.dump());
+                ndjson.push_back('\n');
+                if (!client_sink.write(ndjson.data(), ndjson.size())) {
                     return false;
                 }
             } catch (const std::exception& e) {
@@ -711,9 +404,14 @@ void OllamaApi::stream_sse_to_ndjson(const std::string& openai_body,
 // POST /api/chat — Ollama chat completion
 // ============================================================================
 void OllamaApi::handle_chat(const httplib::Request& req, httplib::Response& res) {
-    try {
-        auto request_json = json::parse(req.body);
+    json request_json;
+    if (!parse_request_json(req.body, request_json)) {
+        res.status = 400;
+        res.set_content(R"({"error":"invalid JSON in request body"})", "application/json");
+        return;
+    }
 
+    try {
         std::string model = normalize_model_name(request_json.value("model", ""));
         if (model.empty()) {
             res.status = 400;
@@ -758,13 +456,14 @@ void OllamaApi::handle_chat(const httplib::Request& req, httplib::Response& res)
         // Determine streaming
         bool stream = request_json.value("stream", true);  // Ollama defaults to streaming
 
-        // Convert to OpenAI format
-        auto openai_req = convert_ollama_to_openai_chat(request_json);
-
         bool has_tools = request_json.contains("tools") &&
                          request_json["tools"].is_array() &&
                          !request_json["tools"].empty();
 
+        // Convert to OpenAI format, handing over the parsed request so large
+        // subtrees move instead of copy
+        auto openai_req = ollama::chat_request_to_openai(std::move(request_json), model);
+
         if (stream && has_tools) {
             LOG(INFO, "OllamaApi") << "POST /api/chat - Streaming requested with tools; using non-streaming backend call (model: " << model << ")" << std::endl;
 
@@ -772,7 +471,7 @@ void OllamaApi::handle_chat(const httplib::Request& req, httplib::Response& res)
 
             if (send_backend_error(openai_response, res)) return;
 
-            auto ollama_response = convert_openai_chat_to_ollama(openai_response, model);
+            auto ollama_response = ollama::chat_response_to_ollama(std::move(openai_response), model);
             json done_response = {
                 {"model", model}, {"created_at", "2024-01-01T00:00:00Z"},
                 {"message", {{"role", "assistant"}, {"content", ""}}},
@@ -802,8 +501,8 @@ void OllamaApi::handle_chat(const httplib::Request& req, httplib::Response& res)
                     if (offset > 0) return false;
                     stream_sse_to_ndjson(openai_body, sink,
                         // Convert each SSE chunk to Ollama chat format
-                        [this, &model](const json& chunk) {
-                            return convert_openai_delta_to_ollama(chunk, model);
+                        [&model](const json& chunk) {
+                            return ollama::delta_to_ollama(chunk, model);
                         },
                         // Build final done message
                         [&model](int prompt_eval_count, int eval_count) -> json {
@@ -831,7 +530,7 @@ void OllamaApi::handle_chat(const httplib::Request& req, httplib::Response& res)
 
             if (send_backend_error(openai_response, res)) return;
 
-            auto ollama_response = convert_openai_chat_to_ollama(openai_response, model);
+            auto ollama_response = ollama::chat_response_to_ollama(std::move(openai_response), model);
             res.set_content(ollama_response.dump(), "application/json");
         }
 
@@ -847,9 +546,14 @@ void OllamaApi::handle_chat(const httplib::Request& req, httplib::Response& res)
 // POST /api/generate — Ollama text generation
 // ============================================================================
 void OllamaApi::handle_generate(const httplib::Request& req, httplib::Response& res) {
-    try {
-        auto request_json = json::parse(req.body);
+    json request_json;
+    if (!parse_request_json(req.body, request_json)) {
+        res.status = 400;
+        res.set_content(R"({"error":"invalid JSON in request body"})", "application/json");
+        return;
+    }
 
+    try {
         std::string model = normalize_model_name(request_json.value("model", ""));
         if (model.empty()) {
             res.status = 400;
@@ -902,7 +606,7 @@ void OllamaApi::handle_generate(const httplib::Request& req, httplib::Response&
 
         bool stream = request_json.value("stream", true);  // Ollama defaults to streaming
 
-        auto openai_req = convert_ollama_to_openai_completion(request_json);
+        auto openai_req = ollama::completion_request_to_openai(std::move(request_json), model);
 
         if (stream) {
             LOG(INFO, "OllamaApi") << "POST /api/generate - Streaming (model: " << model << ")" << std::endl;
@@ -1098,6 +802,15 @@ void OllamaApi::handle_generate_image(const json& request_json, httplib::Respons
 // ============================================================================
 void OllamaApi::handle_tags(const httplib::Request& req, httplib::Response& res) {
     try {
+        const uint64_t epoch = models_epoch_->load(std::memory_order_relaxed);
+        {
+            std::lock_guard<std::mutex> lock(snapshot_cache_mutex_);
+            if (tags_cache_epoch_ == epoch) {
+                res.set_content(tags_cache_body_, "application/json");
+                return;
+            }
+        }
+
         auto models = model_manager_->get_downloaded_models();
 
         json response;
@@ -1107,7 +820,16 @@ void OllamaApi::handle_tags(const httplib::Request& req, httplib::Response& res)
             response["models"].push_back(build_ollama_model_entry(id, info));
         }
 
-        res.set_content(response.dump(), "application/json");
+        std::string body = response.dump();
+        {
+            std::lock_guard<std::mutex> lock(snapshot_cache_mutex_);
+            if (models_epoch_->load(std::memory_order_relaxed) == epoch) {
+                tags_cache_body_ = body;
+                tags_cache_epoch_ = epoch;
+            }
+        }
+
+        res.set_content(body, "application/json");
 
     } catch (const std::exception& e) {
         LOG(ERROR, "OllamaApi") << "Error in /api/tags: " << e.what() << std::endl;
@@ -1189,6 +911,7 @@ void OllamaApi::handle_delete(const httplib::Request& req, httplib::Response& re
         }
 
         model_manager_->delete_model(name);
+        bump_models_epoch();
 
         // Ollama returns 200 with no body on success
         res.status = 200;
@@ -1271,6 +994,7 @@ void OllamaApi::handle_pull(const httplib::Request& req, httplib::Response& res)
                         };
 
                         model_manager_->download_model(name, json::object(), false, progress_cb);
+                        bump_models_epoch();
 
                         // Final success
                         std::string success = json({{"status", "success"}}).dump() + "\n";
@@ -1292,6 +1016,7 @@ void OllamaApi::handle_pull(const httplib::Request& req, httplib::Response& res)
         } else {
             // Non-streaming: block until complete
             model_manager_->download_model(name, json::object());
+            bump_models_epoch();
             json response = {{"status", "success"}};
             res.set_content(response.dump(), "application/json");
         }
@@ -1308,9 +1033,14 @@ void OllamaApi::handle_pull(const httplib::Request& req, httplib::Response& res)
 // POST /api/embed — Embeddings (new format, returns array of embeddings)
 // ============================================================================
 void OllamaApi::handle_embed(const httplib::Request& req, httplib::Response& res) {
-    try {
-        auto request_json = json::parse(req.body);
+    json request_json;
+    if (!parse_request_json(req.body, request_json)) {
+        res.status = 400;
+        res.set_content(R"({"error":"invalid JSON in request body"})", "application/json");
+        return;
+    }
 
+    try {
         std::string model = normalize_model_name(request_json.value("model", ""));
         if (model.empty()) {
             res.status = 400;
@@ -1378,9 +1108,14 @@ void OllamaApi::handle_embed(const httplib::Request& req, httplib::Response& res
 // POST /api/embeddings — Legacy embeddings (returns single embedding)
 // ============================================================================
 void OllamaApi::handle_embeddings(const httplib::Request& req, httplib::Response& res) {
-    try {
-        auto request_json = json::parse(req.body);
+    json request_json;
+    if (!parse_request_json(req.body, request_json)) {
+        res.status = 400;
+        res.set_content(R"({"error":"invalid JSON in request body"})", "application/json");
+        return;
+    }
 
+    try {
         std::string model = normalize_model_name(request_json.value("model", ""));
         if (model.empty()) {
             res.status = 400;
@@ -1445,6 +1180,15 @@ void OllamaApi::handle_embeddings(const httplib::Request& req, httplib::Response
 // ============================================================================
 void OllamaApi::handle_ps(const httplib::Request& req, httplib::Response& res) {
     try {
+        const uint64_t epoch = models_epoch_->load(std::memory_order_relaxed);
+        {
+            std::lock_guard<std::mutex> lock(snapshot_cache_mutex_);
+            if (ps_cache_epoch_ == epoch) {
+                res.set_content(ps_cache_body_, "application/json");
+                return;
+            }
+        }
+
         auto loaded = router_->get_all_loaded_models();
 
         json response;
@@ -1468,7 +1212,16 @@ void OllamaApi::handle_ps(const httplib::Request& req, httplib::Response& res) {
             }
         }
 
-        res.set_content(response.dump(), "application/json");
+        std::string body = response.dump();
+        {
+            std::lock_guard<std::mutex> lock(snapshot_cache_mutex_);
+            if (models_epoch_->load(std::memory_order_relaxed) == epoch) {
+                ps_cache_body_ = body;
+                ps_cache_epoch_ = epoch;
+            }
+        }
+
+        res.set_content(body, "application/json");
 
     } catch (const std::exception& e) {
         LOG(ERROR, "OllamaApi") << "Error in /api/ps: " << e.what() << std::endl;
@@ -0,0 +1,290 @@
+#include "lemon/ollama_mapping.h"
+
+#include "lemon/json_repair.h"
+
+#include <cstdint>
+#include <unordered_map>
+#include <utility>
+
+namespace lemon {
+namespace ollama {
+
+namespace {
+struct OptionMapping { const char* ollama_key; const char* openai_key; };
+
+const OptionMapping OPTION_MAPPINGS[] = {
+    {"temperature",    "temperature"},
+    {"top_p",          "top_p"},
+    {"seed",           "seed"},
+    {"stop",           "stop"},
+    {"num_predict",    "max_tokens"},
+    {"repeat_penalty", "frequency_penalty"},
+};
+}
+
+void map_options(const json& ollama_request, json& openai_req) {
+    if (ollama_request.contains("options") && ollama_request["options"].is_object()) {
+        const auto& opts = ollama_request["options"];
+        for (const auto& m : OPTION_MAPPINGS) {
+            if (opts.contains(m.ollama_key)) {
+                openai_req[m.openai_key] = opts[m.ollama_key];
+            }
+        }
+    }
+
+    for (const auto& m : OPTION_MAPPINGS) {
+        if (ollama_request.contains(m.ollama_key)) {
+            openai_req[m.openai_key] = ollama_request[m.ollama_key];
+        }
+    }
+}
+
+json normalize_ollama_tool_calls(json tool_calls) {
+    if (!tool_calls.is_array()) {
+        return tool_calls;
+    }
+
+    for (auto& tool_call : tool_calls) {
+        if (!tool_call.is_object() ||
+            !tool_call.contains("function") ||
+            !tool_call["function"].is_object()) {
+            continue;
+        }
+
+        auto& function = tool_call["function"];
+        if (!function.contains("arguments") || !function["arguments"].is_string()) {
+            continue;
+        }
+
+        std::string arguments = function["arguments"].get<std::string>();
+        auto parsed = parse_or_repair_json(arguments);
+        function["arguments"] = parsed ? *parsed : json::object();
+    }
+
+    return tool_calls;
+}
+
+json normalize_openai_tool_calls(json tool_calls) {
+    if (!tool_calls.is_array()) {
+        return tool_calls;
+    }
+
+    for (auto& tool_call : tool_calls) {
+        if (!tool_call.is_object() ||
+            !tool_call.contains("function") ||
+            !tool_call["function"].is_object()) {
+            continue;
+        }
+
+        if (!tool_call.contains("type") || !tool_call["type"].is_string()) {
+            tool_call["type"] = "function";
+        }
+
+        auto& function = tool_call["function"];
+        if (!function.contains("arguments") || function["arguments"].is_string()) {
+            continue;
+        }
+
+        function["arguments"] = function["arguments"].dump();
+    }
+
+    return tool_calls;
+}
+
+json chat_request_to_openai(json ollama_request, const std::string& model) {
+    json openai_req;
+    openai_req["model"] = model;
+
+    // Scalar options are copied before the subtree moves below disturb the
+    // source document.
+    map_options(ollama_request, openai_req);
+
+    if (ollama_request.contains("messages")) {
+        json messages = json::array();
+        std::unordered_map<std::string, std::string> tool_call_ids_by_name;
+        for (auto& msg : ollama_request["messages"]) {
+            json openai_msg;
+            std::string role = msg.value("role", "user");
+            openai_msg["role"] = role;
+
+            if (msg.contains("images") && msg["images"].is_array() && !msg["images"].empty()) {
+                json content_parts = json::array();
+                if (msg.contains("content") && !msg["content"].get<std::string>().empty()) {
+                    content_parts.push_back({{"type", "text"}, {"text", std::move(msg["content"])}});
+                }
+                for (auto& img : msg["images"]) {
+                    content_parts.push_back({
+                        {"type", "image_url"},
+                        {"image_url", {{"url", "data:image/png;base64," + img.get<std::string>()}}}
+                    });
+                }
+                openai_msg["content"] = std::move(content_parts);
+            } else if (msg.contains("content")) {
+                openai_msg["content"] = std::move(msg["content"]);
+            } else {
+                openai_msg["content"] = "";
+            }
+
+            if (msg.contains("tool_calls") && msg["tool_calls"].is_array() && !msg["tool_calls"].empty()) {
+                auto tool_calls = normalize_openai_tool_calls(std::move(msg["tool_calls"]));
+                for (const auto& tool_call : tool_calls) {
+                    if (tool_call.contains("id") && tool_call["id"].is_string() &&
+                        tool_call.contains("function") && tool_call["function"].is_object() &&
+                        tool_call["function"].contains("name") && tool_call["function"]["name"].is_string()) {
+                        tool_call_ids_by_name[tool_call["function"]["name"].get<std::string>()] =
+                            tool_call["id"].get<std::string>();
+                    }
+                }
+                openai_msg["tool_calls"] = std::move(tool_calls);
+            }
+
+            if (role == "tool") {
+                if (msg.contains("tool_call_id") && msg["tool_call_id"].is_string()) {
+                    openai_msg["tool_call_id"] = std::move(msg["tool_call_id"]);
+                } else if (msg.contains("tool_name") && msg["tool_name"].is_string()) {
+                    auto it = tool_call_ids_by_name.find(msg["tool_name"].get<std::string>());
+                    if (it != tool_call_ids_by_name.end()) {
+                        openai_msg["tool_call_id"] = it->second;
+                    }
+                }
+            }
+
+            messages.push_back(std::move(openai_msg));
+        }
+        openai_req["messages"] = std::move(messages);
+    }
+
+    if (ollama_request.contains("tools")) {
+        openai_req["tools"] = std::move(ollama_request["tools"]);
+    }
+
+    if (ollama_request.contains("format") && ollama_request["format"].is_string() &&
+        ollama_request["format"].get<std::string>() == "json") {
+        openai_req["response_format"] = {{"type", "json_object"}};
+    }
+
+    if (ollama_request.contains("think")) {
+        openai_req["enable_thinking"] = std::move(ollama_request["think"]);
+    }
+
+    // Stream flag is handled by the caller
+    openai_req["stream"] = false;
+
+    return openai_req;
+}
+
+json completion_request_to_openai(json ollama_request, const std::string& model) {
+    json openai_req;
+    openai_req["model"] = model;
+
+    map_options(ollama_request, openai_req);
+
+    if (ollama_request.contains("prompt")) {
+        openai_req["prompt"] = std::move(ollama_request["prompt"]);
+    }
+
+    openai_req["stream"] = false;
+
+    return openai_req;
+}
+
+json chat_response_to_ollama(json openai_response, const std::string& model) {
+    json ollama_res;
+    ollama_res["model"] = model;
+    ollama_res["created_at"] = "2024-01-01T00:00:00Z";
+
+    if (openai_response.contains("choices") && !openai_response["choices"].empty()) {
+        auto& choice = openai_response["choices"][0];
+        if (choice.contains("message")) {
+            auto& message = choice["message"];
+            json msg;
+            msg["role"] = (message.contains("role") && message["role"].is_string())
+                          ? std::move(message["role"]) : json("assistant");
+            msg["content"] = (message.contains("content") && message["content"].is_string())
+                             ? std::move(message["content"]) : json("");
+
+            // Ollama uses "thinking" for reasoning models
+            if (message.contains("reasoning_content") && message["reasoning_content"].is_string()) {
+                msg["thinking"] = std::move(message["reasoning_content"]);
+            }
+
+            if (message.contains("tool_calls")) {
+                msg["tool_calls"] = normalize_ollama_tool_calls(std::move(message["tool_calls"]));
+            }
+
+            ollama_res["message"] = std::move(msg);
+        }
+
+        ollama_res["done_reason"] = (choice.contains("finish_reason") && choice["finish_reason"].is_string())
+                                    ? std::move(choice["finish_reason"]) : json("stop");
+    }
+
+    ollama_res["done"] = true;
+
+    if (openai_response.contains("usage")) {
+        const auto& usage = openai_response["usage"];
+        ollama_res["prompt_eval_count"] = usage.value("prompt_tokens", 0);
+        ollama_res["eval_count"] = usage.value("completion_tokens", 0);
+
+        // The OpenAI response carries no timings; report zeros rather than guesses
+        ollama_res["total_duration"] = 0;
+        ollama_res["load_duration"] = 0;
+        ollama_res["prompt_eval_duration"] = 0;
+        ollama_res["eval_duration"] = 0;
+    }
+
+    // llama.cpp backends report real timings
+    if (openai_response.contains("timings")) {
+        const auto& timings = openai_response["timings"];
+        if (timings.contains("prompt_n"))
+            ollama_res["prompt_eval_count"] = timings["prompt_n"];
+        if (timings.contains("predicted_n"))
+            ollama_res["eval_count"] = timings["predicted_n"];
+        if (timings.contains("prompt_ms"))
+            ollama_res["prompt_eval_duration"] = static_cast<int64_t>(timings["prompt_ms"].get<double>() * 1000000);
+        if (timings.contains("predicted_ms"))
+            ollama_res["eval_duration"] = static_cast<int64_t>(timings["predicted_ms"].get<double>() * 1000000);
+    }
+
+    return ollama_res;
+}
+
+json delta_to_ollama(json openai_chunk, const std::string& model) {
+    json ollama_chunk;
+    ollama_chunk["model"] = model;
+    ollama_chunk["created_at"] = "2024-01-01T00:00:00Z";
+    ollama_chunk["done"] = false;
+
+    if (openai_chunk.contains("choices") && !openai_chunk["choices"].empty()) {
+        auto& choice = openai_chunk["choices"][0];
+        if (choice.contains("delta")) {
+            auto& delta = choice["delta"];
+            json msg;
+            msg["role"] = (delta.contains("role") && delta["role"].is_string())
+                          ? std::move(delta["role"]) : json("assistant");
+            msg["content"] = (delta.contains("content") && delta["content"].is_string())
+                             ? std::move(delta["content"]) : json("");
+
+            // Ollama uses "thinking" for reasoning models
+            if (delta.contains("reasoning_content") && delta["reasoning_content"].is_string()) {
+                msg["thinking"] = std::move(delta["reasoning_content"]);
+            }
+
+            if (delta.contains("tool_calls")) {
+                msg["tool_calls"] = std::move(delta["tool_calls"]);
+            }
+
+            ollama_chunk["message"] = std::move(msg);
+        }
+
+        if (choice.contains("finish_reason") && !choice["finish_reason"].is_null()) {
+            ollama_chunk["done"] = true;
+            ollama_chunk["done_reason"] = std::move(choice["finish_reason"]);
+        }
+    }
+
+    return ollama_chunk;
+}
+
+} // namespace ollama
+} // namespace lemon
@@ -0,0 +1,359 @@
+#include "lemon/peer_registry.h"
+
+#include <algorithm>
+#include <chrono>
+
+#include "lemon/utils/aixlog.hpp"
+#include "lemon/utils/http_client.h"
+
+#ifdef _WIN32
+    #include <winsock2.h>
+    #include <ws2tcpip.h>
+    #pragma comment(lib, "ws2_32.lib")
+    #define INVALID_SOCKET_PR INVALID_SOCKET
+    typedef SOCKET socket_pr_t;
+    typedef int socklen_t;
+#else
+    #include <arpa/inet.h>
+    #include <netinet/in.h>
+    #include <sys/socket.h>
+    #include <sys/time.h>
+    #include <unistd.h>
+
+    #define closesocket close
+    #define INVALID_SOCKET_PR -1
+    typedef int socket_pr_t;
+#endif
+
+namespace lemon {
+
+namespace {
+
+// Base TTL for v1 peers (beacons every 2s); v2 peers advertise their
+// adaptive interval and expire after missing several of those instead.
+constexpr auto kPeerTtl = std::chrono::seconds(10);
+constexpr int kPeerTtlIntervals = 4;
+constexpr int kPollIntervalSeconds = 3;
+constexpr long kPollTimeoutSeconds = 5;
+constexpr double kLatencyEwmaAlpha = 0.2;
+// Peers whose model state arrives on the beacon are only probed for the
+// latency signal, not for state.
+constexpr auto kPassiveProbeInterval = std::chrono::seconds(30);
+
+std::string local_hostname() {
+    char buffer[256];
+    if (gethostname(buffer, sizeof(buffer)) == 0) {
+        return std::string(buffer);
+    }
+    return "UnknownHost";
+}
+
+}  // namespace
+
+PeerRegistry::PeerRegistry() {
+#ifdef _WIN32
+    WSADATA wsa_data;
+    WSAStartup(MAKEWORD(2, 2), &wsa_data);
+#endif
+    self_hostname_ = local_hostname();
+}
+
+PeerRegistry::~PeerRegistry() {
+    stop();
+#ifdef _WIN32
+    WSACleanup();
+#endif
+}
+
+void PeerRegistry::set_probe_callback(std::function<void()> callback) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    probe_callback_ = std::move(callback);
+}
+
+void PeerRegistry::start(int beacon_port) {
+    if (running_.exchange(true)) {
+        return;
+    }
+    listen_thread_ = std::thread(&PeerRegistry::listen_loop, this, beacon_port);
+    poll_thread_ = std::thread(&PeerRegistry::poll_loop, this);
+}
+
+void PeerRegistry::stop() {
+    if (!running_.exchange(false)) {
+        return;
+    }
+    if (listen_thread_.joinable()) {
+        listen_thread_.join();
+    }
+    if (poll_thread_.joinable()) {
+        poll_thread_.join();
+    }
+}
+
+void PeerRegistry::listen_loop(int beacon_port) {
+    socket_pr_t sock = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+    if (sock == INVALID_SOCKET_PR) {
+        LOG(ERROR, "PeerRegistry") << "Could not create discovery socket" << std::endl;
+        return;
+    }
+
+    // The beacon broadcaster and any tray clients share this port, so the
+    // listener must not claim it exclusively.
+    int reuse = 1;
+    setsockopt(sock, SOL_SOCKET, SO_REUSEADDR, (char*)&reuse, sizeof(reuse));
+#ifdef SO_REUSEPORT
+    setsockopt(sock, SOL_SOCKET, SO_REUSEPORT, (char*)&reuse, sizeof(reuse));
+#endif
+
+#ifdef _WIN32
+    DWORD timeout_ms = 1000;
+    setsockopt(sock, SOL_SOCKET, SO_RCVTIMEO, (char*)&timeout_ms, sizeof(timeout_ms));
+#else
+    struct timeval tv{};
+    tv.tv_sec = 1;
+    setsockopt(sock, SOL_SOCKET, SO_RCVTIMEO, (char*)&tv, sizeof(tv));
+#endif
+
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(static_cast<uint16_t>(beacon_port));
+    addr.sin_addr.s_addr = htonl(INADDR_ANY);
+    if (bind(sock, (sockaddr*)&addr, sizeof(addr)) != 0) {
+        LOG(ERROR, "PeerRegistry") << "Could not bind discovery socket on port "
+                                   << beacon_port << std::endl;
+        closesocket(sock);
+        return;
+    }
+
+    char buffer[2048];
+    while (running_.load()) {
+        sockaddr_in from{};
+        socklen_t from_len = sizeof(from);
+        int received = recvfrom(sock, buffer, sizeof(buffer) - 1, 0,
+                                (sockaddr*)&from, &from_len);
+        if (received <= 0) {
+            continue;
+        }
+        buffer[received] = '\0';
+        handle_beacon_payload(std::string(buffer, static_cast<size_t>(received)));
+    }
+
+    closesocket(sock);
+}
+
+void PeerRegistry::handle_beacon_payload(const std::string& payload) {
+    auto parsed = nlohmann::json::parse(payload, nullptr, /*allow_exceptions=*/false);
+    if (parsed.is_discarded() || !parsed.is_object()) {
+        return;
+    }
+    if (parsed.value("service", "") != "lemonade") {
+        return;
+    }
+    if (parsed.value("probe", false)) {
+        std::function<void()> callback;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            callback = probe_callback_;
+        }
+        if (callback) {
+            callback();
+        }
+        return;
+    }
+    const std::string hostname = parsed.value("hostname", "");
+    const std::string url = parsed.value("url", "");
+    if (hostname.empty() || url.empty()) {
+        return;
+    }
+    // Our own beacons come back on every interface; same-host instances
+    // offer no pooling benefit either way.
+    if (hostname == self_hostname_) {
+        return;
+    }
+    if (url.rfind("http://127.", 0) == 0 || url.rfind("http://localhost", 0) == 0) {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto& peer = peers_[url];
+    if (peer.base_url.empty()) {
+        LOG(INFO, "PeerRegistry") << "Discovered peer '" << hostname
+                                  << "' at " << url << std::endl;
+        peer.base_url = url;
+    }
+    peer.hostname = hostname;
+    peer.last_seen = std::chrono::steady_clock::now();
+
+    const int interval = parsed.value("interval", 0);
+    if (interval > 0) {
+        peer.beacon_interval_s = std::min(interval, 60);
+    }
+    const uint64_t seq = parsed.value("seq", uint64_t{0});
+
+    // v2 status keyframe: the loaded-model set travels on the beacon, no
+    // /health poll needed. Heartbeats (same seq, no status) leave the
+    // assembled state as-is.
+    if (parsed.contains("status") && parsed["status"].is_object() &&
+        parsed["status"].contains("loaded") && parsed["status"]["loaded"].is_array()) {
+        std::vector<std::string> loaded;
+        for (const auto& model : parsed["status"]["loaded"]) {
+            const std::string name = model.is_object()
+                ? model.value("model_name", "")
+                : (model.is_string() ? model.get<std::string>() : "");
+            if (!name.empty()) {
+                loaded.push_back(name);
+            }
+        }
+        peer.loaded_models = std::move(loaded);
+        peer.passive_state = true;
+        peer.reachable = true;
+        peer.state_seq = seq;
+    }
+}
+
+void PeerRegistry::poll_loop() {
+    while (running_.load()) {
+        std::vector<std::string> urls;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            prune_expired_locked();
+            urls.reserve(peers_.size());
+            const auto now = std::chrono::steady_clock::now();
+            for (const auto& [url, peer] : peers_) {
+                if (peer.passive_state &&
+                    now - peer.last_probe < kPassiveProbeInterval) {
+                    continue;
+                }
+                urls.push_back(url);
+            }
+        }
+
+        for (const auto& url : urls) {
+            if (!running_.load()) {
+                return;
+            }
+
+            std::vector<std::string> loaded;
+            bool reachable = false;
+            const auto started = std::chrono::steady_clock::now();
+            try {
+                auto response = utils::HttpClient::get(
+                    url + "health", {}, kPollTimeoutSeconds,
+                    utils::HttpSecurityPolicy::AllowInsecureHttp);
+                if (response.status_code == 200) {
+                    auto health = nlohmann::json::parse(response.body, nullptr,
+                                                        /*allow_exceptions=*/false);
+                    if (health.is_object() && health.contains("all_models_loaded") &&
+                        health["all_models_loaded"].is_array()) {
+                        for (const auto& model : health["all_models_loaded"]) {
+                            const std::string name = model.is_object()
+                                ? model.value("model_name", "")
+                                : (model.is_string() ? model.get<std::string>() : "");
+                            if (!name.empty()) {
+                                loaded.push_back(name);
+                            }
+                        }
+                        reachable = true;
+                    }
+                }
+            } catch (const std::exception&) {
+            }
+            const double elapsed_ms =
+                std::chrono::duration<double, std::milli>(
+                    std::chrono::steady_clock::now() - started).count();
+
+            std::lock_guard<std::mutex> lock(mutex_);
+            auto it = peers_.find(url);
+            if (it == peers_.end()) {
+                continue;
+            }
+            it->second.last_probe = std::chrono::steady_clock::now();
+            it->second.reachable = reachable;
+            if (reachable) {
+                it->second.loaded_models = std::move(loaded);
+                if (it->second.poll_latency_ms == 0.0) {
+                    it->second.poll_latency_ms = elapsed_ms;
+                } else {
+                    it->second.poll_latency_ms +=
+                        kLatencyEwmaAlpha * (elapsed_ms - it->second.poll_latency_ms);
+                }
+            } else {
+                it->second.loaded_models.clear();
+            }
+        }
+
+        for (int i = 0; i < kPollIntervalSeconds * 10 && running_.load(); ++i) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        }
+    }
+}
+
+void PeerRegistry::prune_expired_locked() {
+    const auto now = std::chrono::steady_clock::now();
+    for (auto it = peers_.begin(); it != peers_.end();) {
+        const auto ttl = (std::max)(
+            std::chrono::steady_clock::duration(kPeerTtl),
+            std::chrono::steady_clock::duration(
+                std::chrono::seconds(kPeerTtlIntervals * it->second.beacon_interval_s)));
+        if (now - it->second.last_seen > ttl) {
+            LOG(INFO, "PeerRegistry") << "Peer '" << it->second.hostname
+                                      << "' at " << it->first << " expired" << std::endl;
+            it = peers_.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+std::optional<std::string> PeerRegistry::peer_with_model(const std::string& model) const {
+    if (model.empty()) {
+        return std::nullopt;
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    const Peer* best = nullptr;
+    for (const auto& [url, peer] : peers_) {
+        (void)url;
+        if (!peer.reachable) {
+            continue;
+        }
+        if (std::find(peer.loaded_models.begin(), peer.loaded_models.end(), model) ==
+            peer.loaded_models.end()) {
+            continue;
+        }
+        if (!best || peer.poll_latency_ms < best->poll_latency_ms) {
+            best = &peer;
+        }
+    }
+    if (!best) {
+        return std::nullopt;
+    }
+    return best->base_url;
+}
+
+std::vector<PeerRegistry::Peer> PeerRegistry::peers() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::vector<Peer> result;
+    result.reserve(peers_.size());
+    for (const auto& [url, peer] : peers_) {
+        (void)url;
+        result.push_back(peer);
+    }
+    return result;
+}
+
+nlohmann::json PeerRegistry::snapshot() const {
+    nlohmann::json result = nlohmann::json::array();
+    for (const auto& peer : peers()) {
+        result.push_back({
+            {"hostname", peer.hostname},
+            {"url", peer.base_url},
+            {"reachable", peer.reachable},
+            {"loaded_models", peer.loaded_models},
+            {"poll_latency_ms", peer.poll_latency_ms},
+            {"state_source", peer.passive_state ? "beacon" : "poll"},
+        });
+    }
+    return result;
+}
+
+}  // namespace lemon
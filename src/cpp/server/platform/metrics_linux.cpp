@@ -189,8 +189,86 @@ public:
     }
 
     double get_npu_utilization() override {
+        return query_npu_utilization("accel0");
+    }
+
+    std::vector<DeviceUtilization> get_device_utilization() override {
+        std::vector<DeviceUtilization> out;
+        try {
+            std::string drm_path = "/sys/class/drm";
+            if (fs::exists(drm_path)) {
+                for (const auto& entry : fs::directory_iterator(drm_path)) {
+                    std::string card_name = entry.path().filename().string();
+                    if (card_name.find("card") != 0 || card_name.find("-") != std::string::npos) {
+                        continue;
+                    }
+
+                    std::string device_path = entry.path().string() + "/device";
+
+                    double busy = -1.0;
+                    std::ifstream busy_file(device_path + "/gpu_busy_percent");
+                    if (busy_file.is_open()) {
+                        busy_file >> busy;
+                    }
+
+                    uint64_t vram_used = 0;
+                    std::ifstream vram_file(device_path + "/mem_info_vram_used");
+                    if (vram_file.is_open()) {
+                        vram_file >> vram_used;
+                    }
+                    uint64_t gtt_used = 0;
+                    std::ifstream gtt_file(device_path + "/mem_info_gtt_used");
+                    if (gtt_file.is_open()) {
+                        gtt_file >> gtt_used;
+                    }
+
+                    bool is_dgpu = fs::exists(device_path + "/board_info");
+                    uint64_t card_memory = is_dgpu ? vram_used : (vram_used + gtt_used);
+
+                    if (busy < 0 && card_memory == 0) {
+                        continue;
+                    }
+
+                    DeviceUtilization d;
+                    d.device = "gpu:" + card_name;
+                    d.busy_percent = busy;
+                    d.memory_gb = card_memory > 0
+                                      ? card_memory / (1024.0 * 1024.0 * 1024.0)
+                                      : -1.0;
+                    out.push_back(std::move(d));
+                }
+            }
+        } catch (...) {
+        }
+
+        try {
+            std::string accel_path = "/sys/class/accel";
+            if (fs::exists(accel_path)) {
+                for (const auto& entry : fs::directory_iterator(accel_path)) {
+                    std::string accel_name = entry.path().filename().string();
+                    if (accel_name.find("accel") != 0) {
+                        continue;
+                    }
+                    const double busy = query_npu_utilization(accel_name);
+                    if (busy < 0) {
+                        continue;
+                    }
+                    DeviceUtilization d;
+                    d.device = "npu:" + accel_name;
+                    d.busy_percent = busy;
+                    out.push_back(std::move(d));
+                }
+            }
+        } catch (...) {
+        }
+
+        return out;
+    }
+
+private:
+    double query_npu_utilization(const std::string& accel_name) {
         try {
-            std::string accel_path = "/dev/accel/accel0";
+            std::string accel_path = "/dev/accel/" + accel_name;
             if (!fs::exists(accel_path)) {
                 return -1.0;
             }
@@ -216,7 +294,8 @@ public:
             }
 
             // Check power_state to avoid waking the NPU if it is asleep
-            fs::path power_state_path = "/sys/class/accel/accel0/device/power_state";
+            fs::path power_state_path =
+                "/sys/class/accel/" + accel_name + "/device/power_state";
             if (fs::exists(power_state_path)) {
                 std::ifstream power_file(power_state_path);
                 std::string state;
@@ -1,6 +1,23 @@
 #include "lemon/prometheus_metrics.h"
 
+#include "lemon/admission_controller.h"
+#include "lemon/async_log_sink.h"
 #include "lemon/backends/backend_descriptor_registry.h"
+#include "lemon/buffer_pool.h"
+#include "lemon/backends/fastflowlm/flm_pipeline.h"
+#include "lemon/cloud_endpoint_tracker.h"
+#include "lemon/completion_cache.h"
+#include "lemon/grammar_cache.h"
+#include "lemon/image_part_cache.h"
+#include "lemon/jitter_buffer.h"
+#include "lemon/latency_histograms.h"
+#include "lemon/request_coalescer.h"
+#include "lemon/routing_classifier_cache.h"
+#include "lemon/slot_affinity.h"
+#include "lemon/speculative_stats.h"
+#include "lemon/sse_compression.h"
+#include "lemon/streaming_proxy.h"
+#include "lemon/utils/http_client.h"
 #include "lemon/version.h"
 
 #include <algorithm>
@@ -165,6 +182,54 @@ private:
     std::set<std::string> described_;
 };
 
+std::string format_bucket_bound(double bound) {
+    std::ostringstream oss;
+    oss << bound;
+    return oss.str();
+}
+
+const char* latency_histogram_help(const std::string& metric) {
+    if (metric == "lemonade_request_queue_wait_seconds") {
+        return "Time a request waited for a Router slot before reaching its backend.";
+    }
+    if (metric == "lemonade_request_backend_seconds") {
+        return "Time a request spent in the backend subprocess, excluding queue wait.";
+    }
+    if (metric == "lemonade_time_to_first_token_seconds") {
+        return "Time to first token as reported by backend telemetry.";
+    }
+    if (metric == "lemonade_tokens_per_second") {
+        return "Generation throughput as reported by backend telemetry.";
+    }
+    return "Lemonade latency distribution.";
+}
+
+void append_latency_histograms(PrometheusBuilder& metrics) {
+    for (const auto& series : LatencyHistograms::instance().snapshot()) {
+        metrics.describe(series.metric, latency_histogram_help(series.metric), "histogram");
+
+        std::map<std::string, std::string> labels;
+        if (!series.endpoint.empty()) {
+            labels["endpoint"] = series.endpoint;
+        }
+        labels["model"] = series.model;
+        labels["backend"] = series.backend;
+
+        uint64_t cumulative = 0;
+        for (size_t i = 0; i < series.bound_count; ++i) {
+            cumulative += series.buckets[i];
+            auto bucket_labels = labels;
+            bucket_labels["le"] = format_bucket_bound(series.upper_bounds[i]);
+            metrics.sample_uint(series.metric + "_bucket", bucket_labels, cumulative);
+        }
+        auto inf_labels = labels;
+        inf_labels["le"] = "+Inf";
+        metrics.sample_uint(series.metric + "_bucket", inf_labels, series.observations);
+        metrics.sample(series.metric + "_sum", labels, series.sum);
+        metrics.sample_uint(series.metric + "_count", labels, series.observations);
+    }
+}
+
 bool parse_backend_port(const std::string& backend_url, int& port) {
     const std::string host = "127.0.0.1:";
     size_t host_pos = backend_url.find(host);
@@ -314,7 +379,8 @@ void append_llamacpp_backend_metrics(PrometheusBuilder& metrics,
 
 } // namespace
 
-std::string build_prometheus_metrics(Router& router, const SystemMetrics& system_metrics) {
+std::string build_prometheus_metrics(Router& router, const SystemMetrics& system_metrics,
+                                     const SystemStatsHistory* stats_history) {
     PrometheusBuilder metrics;
 
     metrics.describe("lemonade_server_up", "Whether the Lemonade server is running.", "gauge");
@@ -323,6 +389,254 @@ std::string build_prometheus_metrics(Router& router, const SystemMetrics& system
     metrics.describe("lemonade_server_info", "Lemonade server build information.", "gauge");
     metrics.sample("lemonade_server_info", {{"version", LEMON_VERSION_STRING}}, 1.0);
 
+    const auto pool_stats = utils::HttpClient::connection_pool_stats();
+    metrics.describe("lemonade_http_connection_pool_hits_total",
+                     "Outgoing HTTP requests served on a pooled keep-alive connection.", "counter");
+    metrics.sample("lemonade_http_connection_pool_hits_total", {},
+                   static_cast<double>(pool_stats.hits));
+    metrics.describe("lemonade_http_connection_pool_misses_total",
+                     "Outgoing HTTP requests that opened a fresh connection.", "counter");
+    metrics.sample("lemonade_http_connection_pool_misses_total", {},
+                   static_cast<double>(pool_stats.misses));
+
+    const auto buffer_pool = BufferPool::totals();
+    metrics.describe("lemonade_buffer_pool_hits_total",
+                     "Buffer acquisitions served from a warm pooled allocation.", "counter");
+    metrics.sample_uint("lemonade_buffer_pool_hits_total", {}, buffer_pool.hits);
+    metrics.describe("lemonade_buffer_pool_misses_total",
+                     "Buffer acquisitions that allocated fresh memory.", "counter");
+    metrics.sample_uint("lemonade_buffer_pool_misses_total", {}, buffer_pool.misses);
+    metrics.describe("lemonade_buffer_pool_discarded_total",
+                     "Buffers freed instead of pooled (size class full or oversized).", "counter");
+    metrics.sample_uint("lemonade_buffer_pool_discarded_total", {}, buffer_pool.discarded);
+    metrics.describe("lemonade_buffer_pool_buffers",
+                     "Buffers currently held on pool free lists.", "gauge");
+    metrics.sample_uint("lemonade_buffer_pool_buffers", {}, buffer_pool.pooled_buffers);
+    metrics.describe("lemonade_buffer_pool_bytes",
+                     "Bytes of capacity currently held on pool free lists.", "gauge");
+    metrics.sample_uint("lemonade_buffer_pool_bytes", {}, buffer_pool.pooled_bytes);
+
+    metrics.describe("lemonade_sse_sink_blocked_seconds_total",
+                     "Time spent with backend reads paused because a streaming client "
+                     "exceeded the buffering high-water mark.", "counter");
+    metrics.sample("lemonade_sse_sink_blocked_seconds_total", {},
+                   static_cast<double>(StreamingProxy::sink_blocked_ms_total()) / 1000.0);
+
+    const auto sse_zstd = SseCompression::totals();
+    metrics.describe("lemonade_sse_zstd_streams_total",
+                     "SSE responses streamed with zstd content encoding.", "counter");
+    metrics.sample_uint("lemonade_sse_zstd_streams_total", {}, sse_zstd.streams);
+    metrics.describe("lemonade_sse_zstd_bytes_in_total",
+                     "Uncompressed SSE bytes fed to the zstd encoder.", "counter");
+    metrics.sample_uint("lemonade_sse_zstd_bytes_in_total", {}, sse_zstd.bytes_in);
+    metrics.describe("lemonade_sse_zstd_bytes_out_total",
+                     "Compressed SSE bytes sent to clients.", "counter");
+    metrics.sample_uint("lemonade_sse_zstd_bytes_out_total", {}, sse_zstd.bytes_out);
+    metrics.describe("lemonade_sse_zstd_cpu_seconds_total",
+                     "CPU time spent compressing SSE streams.", "counter");
+    metrics.sample("lemonade_sse_zstd_cpu_seconds_total", {},
+                   static_cast<double>(sse_zstd.cpu_micros) / 1e6);
+    metrics.describe("lemonade_sse_zstd_ctx_pool_hits_total",
+                     "SSE compression contexts reused from the pool.", "counter");
+    metrics.sample_uint("lemonade_sse_zstd_ctx_pool_hits_total", {}, sse_zstd.ctx_pool_hits);
+    metrics.describe("lemonade_sse_zstd_ctx_pool_misses_total",
+                     "SSE compression contexts freshly allocated.", "counter");
+    metrics.sample_uint("lemonade_sse_zstd_ctx_pool_misses_total", {}, sse_zstd.ctx_pool_misses);
+
+    const auto coalescer = RequestCoalescer::totals();
+    metrics.describe("lemonade_coalescer_requests_total",
+                     "Requests that opted into in-flight coalescing.", "counter");
+    metrics.sample_uint("lemonade_coalescer_requests_total", {}, coalescer.requests);
+    metrics.describe("lemonade_coalescer_leaders_total",
+                     "Coalescing-eligible requests that ran the computation.", "counter");
+    metrics.sample_uint("lemonade_coalescer_leaders_total", {}, coalescer.leaders);
+    metrics.describe("lemonade_coalescer_coalesced_total",
+                     "Duplicate requests served from another request's in-flight "
+                     "computation.", "counter");
+    metrics.sample_uint("lemonade_coalescer_coalesced_total", {}, coalescer.coalesced);
+    metrics.describe("lemonade_coalescer_bypassed_total",
+                     "Opted-in requests that were not deterministic and ran "
+                     "uncoalesced.", "counter");
+    metrics.sample_uint("lemonade_coalescer_bypassed_total", {}, coalescer.bypassed);
+
+    const auto completion_cache = CompletionCache::totals();
+    metrics.describe("lemonade_completion_cache_hits_total",
+                     "Deterministic completions served from the persistent disk "
+                     "cache.", "counter");
+    metrics.sample_uint("lemonade_completion_cache_hits_total", {}, completion_cache.hits);
+    metrics.describe("lemonade_completion_cache_misses_total",
+                     "Deterministic completions not found in the persistent disk "
+                     "cache.", "counter");
+    metrics.sample_uint("lemonade_completion_cache_misses_total", {}, completion_cache.misses);
+    metrics.describe("lemonade_completion_cache_stores_total",
+                     "Deterministic completions written to the persistent disk "
+                     "cache.", "counter");
+    metrics.sample_uint("lemonade_completion_cache_stores_total", {}, completion_cache.stores);
+    metrics.describe("lemonade_completion_cache_expired_total",
+                     "Cache entries dropped because their TTL lapsed.", "counter");
+    metrics.sample_uint("lemonade_completion_cache_expired_total", {}, completion_cache.expired);
+
+    const auto jitter = JitterBuffer::totals();
+    metrics.describe("lemonade_realtime_jitter_frames_total",
+                     "Audio frames that entered a realtime session jitter "
+                     "buffer.", "counter");
+    metrics.sample_uint("lemonade_realtime_jitter_frames_total", {}, jitter.frames);
+    metrics.describe("lemonade_realtime_jitter_late_frames_total",
+                     "Frames whose arrival gap exceeded the expected cadence "
+                     "plus the buffered depth.", "counter");
+    metrics.sample_uint("lemonade_realtime_jitter_late_frames_total", {},
+                        jitter.late_frames);
+    metrics.describe("lemonade_realtime_jitter_released_frames_total",
+                     "Frames released from jitter buffers into session audio "
+                     "buffers.", "counter");
+    metrics.sample_uint("lemonade_realtime_jitter_released_frames_total", {},
+                        jitter.released_frames);
+
+    const auto image_cache = ImagePartCache::global().totals();
+    metrics.describe("lemonade_vision_image_cache_hits_total",
+                     "Inline chat images replayed from the canonical-form cache.", "counter");
+    metrics.sample_uint("lemonade_vision_image_cache_hits_total", {}, image_cache.hits);
+    metrics.describe("lemonade_vision_image_cache_misses_total",
+                     "Inline chat images decoded and canonicalized fresh.", "counter");
+    metrics.sample_uint("lemonade_vision_image_cache_misses_total", {}, image_cache.misses);
+    metrics.describe("lemonade_vision_image_cache_rejected_total",
+                     "Inline chat images left untouched (unrecognized format).", "counter");
+    metrics.sample_uint("lemonade_vision_image_cache_rejected_total", {}, image_cache.rejected);
+    metrics.describe("lemonade_vision_image_cache_bytes",
+                     "Bytes of canonical image URIs currently cached.", "gauge");
+    metrics.sample_uint("lemonade_vision_image_cache_bytes", {}, image_cache.cached_bytes);
+
+    const auto slot_affinity = SlotAffinity::totals();
+    metrics.describe("lemonade_slot_affinity_requests_total",
+                     "Requests steered to a llama-server slot by prefix-affinity routing.", "counter");
+    metrics.sample_uint("lemonade_slot_affinity_requests_total", {}, slot_affinity.requests);
+    metrics.describe("lemonade_slot_affinity_prefix_hits_total",
+                     "Steered requests that landed on a slot already holding a matching "
+                     "prompt prefix in its KV cache.", "counter");
+    metrics.sample_uint("lemonade_slot_affinity_prefix_hits_total", {}, slot_affinity.prefix_hits);
+    metrics.describe("lemonade_slot_affinity_prefix_chars_reused_total",
+                     "Prompt characters covered by a cached slot prefix instead of re-prefilled.",
+                     "counter");
+    metrics.sample_uint("lemonade_slot_affinity_prefix_chars_reused_total", {},
+                        slot_affinity.prefix_chars_reused);
+
+    const auto grammar_cache = GrammarCache::totals();
+    metrics.describe("lemonade_grammar_cache_hits_total",
+                     "Structured-output requests served a pre-compiled GBNF grammar from cache.",
+                     "counter");
+    metrics.sample_uint("lemonade_grammar_cache_hits_total", {}, grammar_cache.hits);
+    metrics.describe("lemonade_grammar_cache_compiles_total",
+                     "JSON schemas compiled to GBNF grammars.", "counter");
+    metrics.sample_uint("lemonade_grammar_cache_compiles_total", {}, grammar_cache.compiles);
+    metrics.describe("lemonade_grammar_cache_unsupported_total",
+                     "Schemas outside the supported subset, passed through to the backend compiler.",
+                     "counter");
+    metrics.sample_uint("lemonade_grammar_cache_unsupported_total", {},
+                        grammar_cache.unsupported);
+
+    metrics.describe("lemonade_log_dropped_lines_total",
+                     "Log lines dropped because the async log queue was full.", "counter");
+    metrics.sample_uint("lemonade_log_dropped_lines_total", {}, async_log_dropped_lines());
+
+    const auto speculative = SpeculativeStats::totals();
+    metrics.describe("lemonade_speculative_draft_tokens_total",
+                     "Tokens proposed by a speculative-decoding draft model.", "counter");
+    metrics.sample_uint("lemonade_speculative_draft_tokens_total", {}, speculative.drafted);
+    metrics.describe("lemonade_speculative_draft_tokens_accepted_total",
+                     "Draft-model tokens accepted by the target model.", "counter");
+    metrics.sample_uint("lemonade_speculative_draft_tokens_accepted_total", {},
+                        speculative.accepted);
+
+    const auto cloud_endpoints = CloudEndpointTracker::instance().snapshot_all();
+    if (!cloud_endpoints.empty()) {
+        metrics.describe("lemonade_cloud_endpoint_latency_ms",
+                         "EWMA latency of successful requests to a cloud provider endpoint.",
+                         "gauge");
+        metrics.describe("lemonade_cloud_endpoint_error_rate",
+                         "EWMA failure rate (0-1) of requests to a cloud provider endpoint.",
+                         "gauge");
+        metrics.describe("lemonade_cloud_endpoint_requests_total",
+                         "Requests attempted against a cloud provider endpoint.",
+                         "counter");
+        for (const auto& [endpoint, stats] : cloud_endpoints) {
+            metrics.sample("lemonade_cloud_endpoint_latency_ms",
+                           {{"endpoint", endpoint}}, stats.latency_ms);
+            metrics.sample("lemonade_cloud_endpoint_error_rate",
+                           {{"endpoint", endpoint}}, stats.error_rate);
+            metrics.sample_uint("lemonade_cloud_endpoint_requests_total",
+                                {{"endpoint", endpoint}},
+                                stats.successes + stats.failures);
+        }
+    }
+
+    const auto classifier_cache = ClassifierResultCache::instance().stats();
+    metrics.describe("lemonade_routing_classifier_cache_hits_total",
+                     "Routing classifier invocations served from the result cache.",
+                     "counter");
+    metrics.sample_uint("lemonade_routing_classifier_cache_hits_total", {},
+                        classifier_cache.hits);
+    metrics.describe("lemonade_routing_classifier_cache_misses_total",
+                     "Routing classifier invocations that ran the classifier model.",
+                     "counter");
+    metrics.sample_uint("lemonade_routing_classifier_cache_misses_total", {},
+                        classifier_cache.misses);
+    metrics.describe("lemonade_routing_classifier_cache_entries",
+                     "Entries currently held in the routing classifier result cache.",
+                     "gauge");
+    metrics.sample_uint("lemonade_routing_classifier_cache_entries", {},
+                        static_cast<uint64_t>(classifier_cache.entries));
+
+    metrics.describe("lemonade_admission_requests_total",
+                     "Completion requests admitted, by priority class.", "counter");
+    metrics.describe("lemonade_admission_waited_total",
+                     "Admissions that had to wait for the priority gate.", "counter");
+    metrics.describe("lemonade_admission_forced_total",
+                     "Batch admissions that waited out the gate and ran anyway.",
+                     "counter");
+    metrics.describe("lemonade_admission_active",
+                     "Requests currently past the admission gate.", "gauge");
+    metrics.describe("lemonade_admission_waiting",
+                     "Requests currently waiting at the admission gate.", "gauge");
+    for (auto priority : {RequestPriority::Interactive, RequestPriority::Batch}) {
+        const auto admission = AdmissionController::instance().stats(priority);
+        const std::string cls = request_priority_name(priority);
+        metrics.sample_uint("lemonade_admission_requests_total", {{"class", cls}},
+                            admission.admitted);
+        metrics.sample_uint("lemonade_admission_waited_total", {{"class", cls}},
+                            admission.waited);
+        metrics.sample_uint("lemonade_admission_forced_total", {{"class", cls}},
+                            admission.forced);
+        metrics.sample_uint("lemonade_admission_active", {{"class", cls}},
+                            static_cast<uint64_t>(admission.active));
+        metrics.sample_uint("lemonade_admission_waiting", {{"class", cls}},
+                            static_cast<uint64_t>(admission.waiting));
+    }
+
+    auto& flm_pipeline = backends::FlmPipeline::instance();
+    const auto flm_totals = flm_pipeline.totals();
+    metrics.describe("lemonade_flm_pipeline_in_flight",
+                     "FLM requests currently admitted to the NPU pipeline.", "gauge");
+    metrics.sample_uint("lemonade_flm_pipeline_in_flight", {},
+                        static_cast<uint64_t>(flm_pipeline.in_flight()));
+    metrics.describe("lemonade_flm_pipeline_queued",
+                     "FLM requests waiting for a pipeline slot.", "gauge");
+    metrics.sample_uint("lemonade_flm_pipeline_queued", {},
+                        static_cast<uint64_t>(flm_pipeline.queued()));
+    metrics.describe("lemonade_flm_pipeline_admitted_total",
+                     "FLM requests admitted to the NPU pipeline.", "counter");
+    metrics.sample_uint("lemonade_flm_pipeline_admitted_total", {}, flm_totals.admitted);
+    metrics.describe("lemonade_flm_pipeline_rejected_total",
+                     "FLM requests rejected because the pipeline wait queue was full.", "counter");
+    metrics.sample_uint("lemonade_flm_pipeline_rejected_total", {}, flm_totals.rejected);
+    metrics.describe("lemonade_flm_pipeline_wait_ms_total",
+                     "Milliseconds FLM requests spent waiting for a pipeline slot.", "counter");
+    metrics.sample_uint("lemonade_flm_pipeline_wait_ms_total", {}, flm_totals.wait_ms_total);
+    metrics.describe("lemonade_flm_pipeline_busy_ms_total",
+                     "Milliseconds FLM requests spent holding a pipeline slot.", "counter");
+    metrics.sample_uint("lemonade_flm_pipeline_busy_ms_total", {}, flm_totals.busy_ms_total);
+
+    append_latency_histograms(metrics);
+
     json snapshot = router.get_metrics_snapshot();
     const json loaded_models = snapshot.value("loaded_models", json::array());
     const json model_metrics = snapshot.value("model_metrics", json::array());
@@ -413,6 +727,16 @@ std::string build_prometheus_metrics(Router& router, const SystemMetrics& system
     metrics.sample_uint("lemonade_output_tokens_total", {}, totals.value("output_tokens", 0ULL));
     metrics.sample_uint("lemonade_prompt_tokens_total", {}, totals.value("prompt_tokens", 0ULL));
 
+    const json hedging = snapshot.value("cloud_hedging", json::object());
+    metrics.describe("lemonade_cloud_hedge_races_total", "Hedged cloud streaming races started.", "counter");
+    metrics.describe("lemonade_cloud_hedge_cloud_wins_total", "Hedged races won by the cloud provider.", "counter");
+    metrics.describe("lemonade_cloud_hedge_local_wins_total", "Hedged races won by the local fallback model.", "counter");
+    metrics.describe("lemonade_cloud_hedge_failures_total", "Hedged races where both branches failed.", "counter");
+    metrics.sample_uint("lemonade_cloud_hedge_races_total", {}, hedging.value("races", 0ULL));
+    metrics.sample_uint("lemonade_cloud_hedge_cloud_wins_total", {}, hedging.value("cloud_wins", 0ULL));
+    metrics.sample_uint("lemonade_cloud_hedge_local_wins_total", {}, hedging.value("local_wins", 0ULL));
+    metrics.sample_uint("lemonade_cloud_hedge_failures_total", {}, hedging.value("failures", 0ULL));
+
     metrics.describe("lemonade_cpu_usage_percent", "System CPU utilization percentage.", "gauge");
     if (system_metrics.cpu_percent >= 0 && std::isfinite(system_metrics.cpu_percent)) {
         metrics.sample("lemonade_cpu_usage_percent", {}, system_metrics.cpu_percent);
@@ -431,14 +755,66 @@ std::string build_prometheus_metrics(Router& router, const SystemMetrics& system
         metrics.sample("lemonade_gpu_usage_percent", {}, system_metrics.gpu_percent);
     }
 
+    // When an on-demand probe fails, fall back to the continuous sampler's
+    // latest reading so scrapes keep seeing the memory gauges.
+    double vram_gb = system_metrics.vram_gb;
+    double npu_percent = system_metrics.npu_percent;
+    SystemStatsHistory::Sample latest_sample;
+    const bool have_latest_sample = stats_history && stats_history->latest(latest_sample);
+    if (vram_gb < 0 && have_latest_sample) {
+        vram_gb = latest_sample.vram_gb;
+    }
+    if (npu_percent < 0 && have_latest_sample) {
+        npu_percent = latest_sample.npu_percent;
+    }
+
     metrics.describe("lemonade_vram_used_gb", "GPU memory usage in GiB.", "gauge");
-    if (system_metrics.vram_gb >= 0 && std::isfinite(system_metrics.vram_gb)) {
-        metrics.sample("lemonade_vram_used_gb", {}, system_metrics.vram_gb);
+    if (vram_gb >= 0 && std::isfinite(vram_gb)) {
+        metrics.sample("lemonade_vram_used_gb", {}, vram_gb);
     }
 
     metrics.describe("lemonade_npu_usage_percent", "NPU utilization percentage.", "gauge");
-    if (system_metrics.npu_percent >= 0 && std::isfinite(system_metrics.npu_percent)) {
-        metrics.sample("lemonade_npu_usage_percent", {}, system_metrics.npu_percent);
+    if (npu_percent >= 0 && std::isfinite(npu_percent)) {
+        metrics.sample("lemonade_npu_usage_percent", {}, npu_percent);
+    }
+
+    if (have_latest_sample && !latest_sample.devices.empty()) {
+        metrics.describe("lemonade_device_busy_percent",
+                         "Per-device utilization percentage.", "gauge");
+        metrics.describe("lemonade_device_memory_used_gb",
+                         "Per-device memory usage in GiB.", "gauge");
+        for (const auto& device : latest_sample.devices) {
+            const std::map<std::string, std::string> labels = {{"device", device.device}};
+            if (device.busy_percent >= 0) {
+                metrics.sample("lemonade_device_busy_percent", labels, device.busy_percent);
+            }
+            if (device.memory_gb >= 0) {
+                metrics.sample("lemonade_device_memory_used_gb", labels, device.memory_gb);
+            }
+        }
+    }
+
+    metrics.describe("lemonade_model_device",
+                     "Device classes a loaded model occupies (constant 1).", "gauge");
+    for (const auto& loaded : router.get_all_loaded_models()) {
+        const std::string name = loaded.value("model_name", "");
+        if (name.empty()) {
+            continue;
+        }
+        std::istringstream classes(loaded.value("device", std::string()));
+        std::string device_class;
+        while (std::getline(classes, device_class, '|')) {
+            metrics.sample("lemonade_model_device",
+                           {{"model", name}, {"device", device_class}}, 1.0);
+        }
+    }
+
+    if (stats_history) {
+        metrics.describe("lemonade_stats_history_samples_total",
+                         "Memory telemetry samples recorded by the continuous history sampler.",
+                         "counter");
+        metrics.sample_uint("lemonade_stats_history_samples_total", {},
+                            stats_history->total_samples());
     }
 
     return metrics.str();
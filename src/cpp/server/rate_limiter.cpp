@@ -0,0 +1,205 @@
+#include "lemon/rate_limiter.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+
+namespace lemon {
+
+namespace {
+
+constexpr int64_t kMicro = 1000000;
+
+int64_t now_micros() {
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+               std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+}
+
+// Credit elapsed time into `level` at `rate_per_second`, clamped to
+// `capacity`. The stamp exchange guarantees each elapsed interval is credited
+// exactly once even when threads race.
+void credit(std::atomic<int64_t>& level, std::atomic<int64_t>& stamp,
+            double rate_per_second, double capacity, int64_t now_us) {
+    const int64_t prev = stamp.exchange(now_us, std::memory_order_acq_rel);
+    const int64_t cap_micro = static_cast<int64_t>(capacity * kMicro);
+    int64_t add = cap_micro;
+    if (prev != 0) {
+        if (now_us <= prev) {
+            return;
+        }
+        add = static_cast<int64_t>(
+            static_cast<double>(now_us - prev) * rate_per_second);
+    }
+    int64_t cur = level.load(std::memory_order_relaxed);
+    int64_t next;
+    do {
+        next = (std::min)(cap_micro, cur + add);
+    } while (next != cur &&
+             !level.compare_exchange_weak(cur, next, std::memory_order_acq_rel,
+                                          std::memory_order_relaxed));
+}
+
+}  // namespace
+
+void RateLimiter::StreamLease::release() {
+    if (limiter_) {
+        limiter_->release_stream(key_);
+        limiter_ = nullptr;
+    }
+}
+
+void RateLimiter::set_limits(const Limits& limits) {
+    {
+        std::lock_guard<std::mutex> lock(limits_mutex_);
+        limits_ = limits;
+    }
+    enabled_.store(limits.requests_per_second > 0.0 ||
+                       limits.tokens_per_minute > 0.0 ||
+                       limits.max_concurrent_streams > 0,
+                   std::memory_order_release);
+}
+
+RateLimiter::Limits RateLimiter::limits() const {
+    std::lock_guard<std::mutex> lock(limits_mutex_);
+    return limits_;
+}
+
+bool RateLimiter::enabled() const {
+    return enabled_.load(std::memory_order_acquire);
+}
+
+RateLimiter::Bucket& RateLimiter::bucket_for(const std::string& key) {
+    {
+        std::shared_lock lock(mutex_);
+        auto it = buckets_.find(key);
+        if (it != buckets_.end()) {
+            return *it->second;
+        }
+    }
+    std::unique_lock lock(mutex_);
+    auto& slot = buckets_[key];
+    if (!slot) {
+        slot = std::make_unique<Bucket>();
+    }
+    return *slot;
+}
+
+void RateLimiter::refill(Bucket& bucket, const Limits& limits, int64_t now_us) {
+    if (limits.requests_per_second > 0.0) {
+        // Burst capacity of one second's worth of requests, at least one.
+        const double capacity = (std::max)(limits.requests_per_second, 1.0);
+        credit(bucket.request_level_micro, bucket.request_stamp_us,
+               limits.requests_per_second, capacity, now_us);
+    }
+    if (limits.tokens_per_minute > 0.0) {
+        credit(bucket.token_level_micro, bucket.token_stamp_us,
+               limits.tokens_per_minute / 60.0, limits.tokens_per_minute,
+               now_us);
+    }
+}
+
+RateLimiter::Decision RateLimiter::admit_request(const std::string& key) {
+    Decision decision;
+    if (!enabled()) {
+        return decision;
+    }
+    const Limits lim = limits();
+    Bucket& bucket = bucket_for(key);
+    refill(bucket, lim, now_micros());
+
+    if (lim.requests_per_second > 0.0) {
+        decision.limit = lim.requests_per_second;
+        const int64_t after =
+            bucket.request_level_micro.fetch_sub(kMicro,
+                                                 std::memory_order_acq_rel) -
+            kMicro;
+        if (after < 0) {
+            bucket.request_level_micro.fetch_add(kMicro,
+                                                 std::memory_order_acq_rel);
+            decision.allowed = false;
+            decision.remaining = 0.0;
+            decision.retry_after_seconds = (std::max)(
+                1, static_cast<int>(std::ceil(
+                       static_cast<double>(kMicro - (after + kMicro)) /
+                       (lim.requests_per_second * kMicro))));
+            return decision;
+        }
+        decision.remaining = static_cast<double>(after) / kMicro;
+    }
+
+    if (lim.tokens_per_minute > 0.0) {
+        const int64_t level =
+            bucket.token_level_micro.load(std::memory_order_acquire);
+        if (level < 0) {
+            decision.allowed = false;
+            decision.limit = lim.tokens_per_minute;
+            decision.remaining = 0.0;
+            decision.retry_after_seconds = (std::max)(
+                1, static_cast<int>(std::ceil(
+                       static_cast<double>(-level) /
+                       (lim.tokens_per_minute / 60.0 * kMicro))));
+            if (lim.requests_per_second > 0.0) {
+                bucket.request_level_micro.fetch_add(kMicro,
+                                                     std::memory_order_acq_rel);
+            }
+            return decision;
+        }
+    }
+    return decision;
+}
+
+bool RateLimiter::acquire_stream(const std::string& key, StreamLease& lease) {
+    if (!enabled()) {
+        return true;
+    }
+    const Limits lim = limits();
+    if (lim.max_concurrent_streams <= 0) {
+        return true;
+    }
+    Bucket& bucket = bucket_for(key);
+    if (bucket.streams.fetch_add(1, std::memory_order_acq_rel) >=
+        lim.max_concurrent_streams) {
+        bucket.streams.fetch_sub(1, std::memory_order_acq_rel);
+        return false;
+    }
+    lease = StreamLease(this, key);
+    return true;
+}
+
+void RateLimiter::release_stream(const std::string& key) {
+    std::shared_lock lock(mutex_);
+    auto it = buckets_.find(key);
+    if (it != buckets_.end()) {
+        it->second->streams.fetch_sub(1, std::memory_order_acq_rel);
+    }
+}
+
+void RateLimiter::record_tokens(const std::string& key, double tokens) {
+    if (!enabled() || tokens <= 0.0) {
+        return;
+    }
+    const Limits lim = limits();
+    if (lim.tokens_per_minute <= 0.0) {
+        return;
+    }
+    Bucket& bucket = bucket_for(key);
+    refill(bucket, lim, now_micros());
+    bucket.token_level_micro.fetch_sub(static_cast<int64_t>(tokens * kMicro),
+                                       std::memory_order_acq_rel);
+}
+
+int RateLimiter::active_streams(const std::string& key) const {
+    std::shared_lock lock(mutex_);
+    auto it = buckets_.find(key);
+    return it != buckets_.end()
+               ? it->second->streams.load(std::memory_order_acquire)
+               : 0;
+}
+
+RateLimiter& RateLimiter::instance() {
+    static RateLimiter limiter;
+    return limiter;
+}
+
+}  // namespace lemon
@@ -1,5 +1,6 @@
 #include "lemon/realtime_session.h"
 #include "lemon/router.h"
+#include "lemon/utils/json_utils.h"
 #include <random>
 #include <chrono>
 #include <iostream>
@@ -15,19 +16,40 @@
 
 namespace lemon {
 
+namespace {
+
+int64_t arrival_now_ms() {
+    return std::chrono::duration_cast<std::chrono::milliseconds>(
+               std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+}
+
+void decode_pcm16(const std::string& pcm16, std::vector<int16_t>& out) {
+    const auto* raw_bytes = reinterpret_cast<const uint8_t*>(pcm16.data());
+    const size_t num_samples = pcm16.size() / 2;
+    out.resize(num_samples);
+    for (size_t i = 0; i < num_samples; i++) {
+        out[i] = static_cast<int16_t>(raw_bytes[i * 2] | (raw_bytes[i * 2 + 1] << 8));
+    }
+}
+
+}  // namespace
+
 RealtimeSessionManager::RealtimeSessionManager(Router* router)
-    : router_(router) {
+    : router_(router),
+      transcription_scheduler_(
+          [this](TranscriptionScheduler::Job& job) {
+              auto session = get_session(job.session_id);
+              if (!session) return;
+              transcribe_wav(session, std::move(job.wav_data), std::move(job.model),
+                             job.is_interim);
+          },
+          TRANSCRIPTION_WORKERS) {
 }
 
 RealtimeSessionManager::~RealtimeSessionManager() {
-    // Wait for pending transcriptions to complete
-    {
-        std::lock_guard<std::mutex> lock(transcriptions_mutex_);
-        for (auto& f : pending_transcriptions_) {
-            if (f.valid()) f.wait();
-        }
-        pending_transcriptions_.clear();
-    }
+    // Stop the workers before tearing down sessions they may reference
+    transcription_scheduler_.shutdown();
 
     // Close all sessions
     std::lock_guard<std::mutex> lock(sessions_mutex_);
@@ -63,19 +85,38 @@ void RealtimeSessionManager::apply_turn_detection_config(
     }
 
     SimpleVAD::Config vad_config;
-    if (session->turn_detection_config.is_object()) {
-        vad_config.energy_threshold = session->turn_detection_config.value(
-            "threshold",
-            vad_config.energy_threshold
-        );
-        vad_config.min_silence_ms = session->turn_detection_config.value(
-            "silence_duration_ms",
-            vad_config.min_silence_ms
-        );
-        vad_config.min_speech_ms = session->turn_detection_config.value(
-            "prefix_padding_ms",
-            vad_config.min_speech_ms
-        );
+    std::string profile;
+    if (turn_detection.is_object() && turn_detection.contains("profile")) {
+        profile = turn_detection["profile"].get<std::string>();
+        if (!SimpleVAD::config_for_profile(profile, vad_config)) {
+            LOG(WARNING, "RealtimeSession")
+                << "Unknown turn_detection profile '" << profile
+                << "'; keeping current endpointing settings" << std::endl;
+            profile.clear();
+        }
+    }
+
+    if (profile.empty()) {
+        if (session->turn_detection_config.is_object()) {
+            // Re-seed from the session's profile so preset fields without a
+            // JSON echo (hangover) survive incremental updates.
+            profile = session->turn_detection_config.value("profile", "");
+            if (!profile.empty()) {
+                SimpleVAD::config_for_profile(profile, vad_config);
+            }
+            vad_config.energy_threshold = session->turn_detection_config.value(
+                "threshold",
+                vad_config.energy_threshold
+            );
+            vad_config.min_silence_ms = session->turn_detection_config.value(
+                "silence_duration_ms",
+                vad_config.min_silence_ms
+            );
+            vad_config.min_speech_ms = session->turn_detection_config.value(
+                "prefix_padding_ms",
+                vad_config.min_speech_ms
+            );
+        }
     }
 
     if (turn_detection.is_object()) {
@@ -96,9 +137,43 @@ void RealtimeSessionManager::apply_turn_detection_config(
         {"silence_duration_ms", vad_config.min_silence_ms},
         {"prefix_padding_ms", vad_config.min_speech_ms}
     };
+    if (!profile.empty()) {
+        session->turn_detection_config["profile"] = profile;
+    }
     session->turn_detection_enabled = true;
 }
 
+void RealtimeSessionManager::apply_input_sample_rate(
+    std::shared_ptr<RealtimeSession> session, const json& config) {
+    if (!config.contains("input_audio_sample_rate")) {
+        return;
+    }
+    const int rate = config["input_audio_sample_rate"].get<int>();
+    if (rate > 0 && rate != StreamingAudioBuffer::SAMPLE_RATE) {
+        session->input_resampler = std::make_unique<audio::Resampler>(
+            rate, StreamingAudioBuffer::SAMPLE_RATE);
+        LOG(INFO, "RealtimeSession") << "Resampling session input from " << rate
+                                     << "Hz to " << StreamingAudioBuffer::SAMPLE_RATE
+                                     << "Hz" << std::endl;
+    } else {
+        session->input_resampler.reset();
+    }
+}
+
+const std::vector<int16_t>& RealtimeSessionManager::resample_input(
+    std::shared_ptr<RealtimeSession> session, const std::string& pcm16) {
+    const auto* raw_bytes = reinterpret_cast<const uint8_t*>(pcm16.data());
+    const size_t num_samples = pcm16.size() / 2;
+    session->resample_in.resize(num_samples);
+    for (size_t i = 0; i < num_samples; i++) {
+        session->resample_in[i] =
+            static_cast<int16_t>(raw_bytes[i * 2] | (raw_bytes[i * 2 + 1] << 8));
+    }
+    session->input_resampler->process(session->resample_in.data(), num_samples,
+                                      session->resample_out);
+    return session->resample_out;
+}
+
 std::string RealtimeSessionManager::create_session(
     std::function<void(const json&)> send_callback,
     const json& config
@@ -118,6 +193,8 @@ std::string RealtimeSessionManager::create_session(
         apply_turn_detection_config(session, config["turn_detection"]);
     }
 
+    apply_input_sample_rate(session, config);
+
     // Attempt to connect to a streaming backend if one is available
     connect_streaming_backend(session);
 
@@ -157,6 +234,8 @@ void RealtimeSessionManager::update_session(const std::string& session_id, const
         apply_turn_detection_config(session, config["turn_detection"]);
     }
 
+    apply_input_sample_rate(session, config);
+
     // Reconnect streaming backend if model changed
     connect_streaming_backend(session);
 
@@ -167,7 +246,10 @@ void RealtimeSessionManager::update_session(const std::string& session_id, const
             {"session", {
                 {"id", session_id},
                 {"model", session->model},
-                {"turn_detection", session->turn_detection_config}
+                {"turn_detection", session->turn_detection_config},
+                {"input_audio_sample_rate", session->input_resampler
+                    ? session->input_resampler->input_rate()
+                    : StreamingAudioBuffer::SAMPLE_RATE}
             }}
         };
         session->send_message(updated_msg);
@@ -182,18 +264,71 @@ void RealtimeSessionManager::append_audio(const std::string& session_id, const s
 
     // If connected to a streaming backend, forward audio directly
     if (session->use_streaming_backend.load()) {
-        forward_streaming_audio(session, base64_audio);
+        if (session->input_resampler) {
+            const auto& samples = resample_input(
+                session, utils::JsonUtils::base64_decode(base64_audio));
+            std::string pcm16(reinterpret_cast<const char*>(samples.data()),
+                              samples.size() * sizeof(int16_t));
+            forward_streaming_audio(session, utils::JsonUtils::base64_encode(pcm16));
+        } else {
+            forward_streaming_audio(session, base64_audio);
+        }
         return;
     }
 
     // Append to buffer
-    session->audio_buffer.append(base64_audio);
+    if (session->input_resampler) {
+        buffer_audio(session,
+                     resample_input(session, utils::JsonUtils::base64_decode(base64_audio)));
+    } else {
+        decode_pcm16(utils::JsonUtils::base64_decode(base64_audio), session->decode_scratch);
+        buffer_audio(session, session->decode_scratch);
+    }
 
     // Log buffer growth periodically (every ~5 seconds at 256ms chunks ≈ every 20 chunks)
     static int chunk_count = 0;
     if (++chunk_count % 20 == 1) {
         LOG(DEBUG, "RealtimeSession") << "Audio buffer: " << session->audio_buffer.duration_ms()
-                  << "ms (" << session->audio_buffer.sample_count() << " samples)" << std::endl;
+                  << "ms (" << session->audio_buffer.sample_count() << " samples), jitter "
+                  << session->jitter_buffer.jitter_ms() << "ms, depth target "
+                  << session->jitter_buffer.target_depth_ms() << "ms" << std::endl;
+    }
+}
+
+void RealtimeSessionManager::append_audio_raw(const std::string& session_id, const std::string& pcm16) {
+    auto session = get_session(session_id);
+    if (!session || !session->session_active) {
+        return;
+    }
+
+    if (session->use_streaming_backend.load()) {
+        // The backend streaming protocol is JSON; encode for that hop only.
+        if (session->input_resampler) {
+            const auto& resampled = resample_input(session, pcm16);
+            std::string pcm_out(reinterpret_cast<const char*>(resampled.data()),
+                                resampled.size() * sizeof(int16_t));
+            forward_streaming_audio(session, utils::JsonUtils::base64_encode(pcm_out));
+        } else {
+            forward_streaming_audio(session, utils::JsonUtils::base64_encode(pcm16));
+        }
+        return;
+    }
+
+    if (session->input_resampler) {
+        buffer_audio(session, resample_input(session, pcm16));
+        return;
+    }
+
+    decode_pcm16(pcm16, session->decode_scratch);
+    buffer_audio(session, session->decode_scratch);
+}
+
+void RealtimeSessionManager::buffer_audio(std::shared_ptr<RealtimeSession> session,
+                                          const std::vector<int16_t>& samples) {
+    session->jitter_buffer.push(samples.data(), samples.size(), arrival_now_ms());
+    session->jitter_release.clear();
+    if (session->jitter_buffer.pull_ready(session->jitter_release) > 0) {
+        session->audio_buffer.append_raw(session->jitter_release);
     }
 
     // In manual-commit mode, buffer audio only and skip server-side VAD/interim work.
@@ -204,25 +339,24 @@ void RealtimeSessionManager::append_audio(const std::string& session_id, const s
 
 void RealtimeSessionManager::process_vad(std::shared_ptr<RealtimeSession> session) {
     // Get recent audio for VAD processing (last 100ms)
-    auto recent_audio = session->audio_buffer.get_recent_samples(100);
-    if (recent_audio.empty()) {
+    size_t sample_count =
+        session->audio_buffer.copy_recent_samples(100, session->vad_scratch);
+    if (sample_count == 0) {
         return;
     }
 
+    SimpleVAD::Event event = session->vad.process(
+        session->vad_scratch.data(), sample_count, StreamingAudioBuffer::SAMPLE_RATE);
+
     // Log RMS periodically for threshold tuning
     {
-        float sum_sq = 0.0f;
-        for (float s : recent_audio) sum_sq += s * s;
-        float rms = std::sqrt(sum_sq / static_cast<float>(recent_audio.size()));
         static int vad_log_count = 0;
         if (++vad_log_count % 20 == 1) {
-            LOG(DEBUG, "RealtimeSession") << "VAD: RMS=" << rms
+            LOG(DEBUG, "RealtimeSession") << "VAD: RMS=" << session->vad.last_rms()
                       << " speech_active=" << session->vad.is_speech_active() << std::endl;
         }
     }
 
-    SimpleVAD::Event event = session->vad.process(recent_audio, StreamingAudioBuffer::SAMPLE_RATE);
-
     switch (event) {
         case SimpleVAD::Event::SpeechStart: {
             LOG(DEBUG, "RealtimeSession") << "VAD: SpeechStart detected" << std::endl;
@@ -240,6 +374,17 @@ void RealtimeSessionManager::process_vad(std::shared_ptr<RealtimeSession> sessio
             break;
         }
 
+        case SimpleVAD::Event::SpeechEnding: {
+            // The silence window is now running out. Push a partial
+            // immediately so a voice agent can begin LLM prefill during the
+            // endpointing margin instead of after turn end.
+            if (session->send_message) {
+                session->send_message(json{{"type", "input_audio_buffer.speech_ending"}});
+            }
+            transcribe_interim(session);
+            break;
+        }
+
         case SimpleVAD::Event::SpeechEnd: {
             LOG(DEBUG, "RealtimeSession") << "VAD: SpeechEnd detected, triggering transcription" << std::endl;
             int64_t audio_end_ms = session->vad.speech_end_ms();
@@ -288,37 +433,17 @@ void RealtimeSessionManager::maybe_interim_transcribe(std::shared_ptr<RealtimeSe
 void RealtimeSessionManager::transcribe_interim(std::shared_ptr<RealtimeSession> session) {
     if (!session || session->audio_buffer.empty()) return;
 
-    // Avoid overlapping interim transcriptions for the same session
-    bool expected = false;
-    if (!session->interim_in_flight.compare_exchange_strong(expected, true)) {
-        return;  // Another interim is already running
-    }
-
     // Snapshot the buffer WITHOUT clearing it
     auto wav_data = session->audio_buffer.get_wav_padded(500);
-    std::string model = session->model;
     session->last_interim_transcription_ms = session->audio_buffer.duration_ms();
 
     LOG(DEBUG, "RealtimeSession") << "Firing interim transcription at "
               << session->last_interim_transcription_ms << "ms" << std::endl;
 
-    auto future = std::async(std::launch::async,
-        [this, session, wav_data = std::move(wav_data), model = std::move(model)]() {
-            transcribe_wav(session, wav_data, model, /*is_interim=*/true);
-            session->interim_in_flight.store(false);
-        });
-
-    {
-        std::lock_guard<std::mutex> lock(transcriptions_mutex_);
-        pending_transcriptions_.erase(
-            std::remove_if(pending_transcriptions_.begin(), pending_transcriptions_.end(),
-                [](const std::future<void>& f) {
-                    return f.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
-                }),
-            pending_transcriptions_.end()
-        );
-        pending_transcriptions_.push_back(std::move(future));
-    }
+    // The scheduler keeps at most one queued interim per session: if the
+    // workers are behind, this snapshot replaces the queued one
+    transcription_scheduler_.submit({session->session_id, std::move(wav_data),
+                                     session->model, /*is_interim=*/true});
 }
 
 void RealtimeSessionManager::commit_audio(const std::string& session_id) {
@@ -340,8 +465,13 @@ void RealtimeSessionManager::commit_audio(const std::string& session_id) {
                 << std::endl;
         }
         session->audio_buffer.clear();
+        session->jitter_buffer.reset();
         session->vad.reset();
         session->last_interim_transcription_ms = 0;
+        {
+            std::lock_guard<std::mutex> stabilizer_lock(session->stabilizer_mutex);
+            session->interim_stabilizer.reset();
+        }
 
         if (session->send_message) {
             json msg = {
@@ -352,6 +482,13 @@ void RealtimeSessionManager::commit_audio(const std::string& session_id) {
         return;
     }
 
+    // A short utterance can still sit entirely in the jitter queue; pull it
+    // in before deciding whether there is anything to transcribe.
+    session->jitter_release.clear();
+    if (session->jitter_buffer.flush(session->jitter_release) > 0) {
+        session->audio_buffer.append_raw(session->jitter_release);
+    }
+
     if (session->audio_buffer.empty()) {
         return;
     }
@@ -384,8 +521,16 @@ void RealtimeSessionManager::clear_audio(const std::string& session_id) {
     }
 
     session->audio_buffer.clear();
+    session->jitter_buffer.reset();
     session->vad.reset();
     session->vad_speech_window_open = false;
+    if (session->input_resampler) {
+        session->input_resampler->reset();
+    }
+    {
+        std::lock_guard<std::mutex> stabilizer_lock(session->stabilizer_mutex);
+        session->interim_stabilizer.reset();
+    }
 
     if (session->send_message) {
         json msg = {
@@ -396,37 +541,31 @@ void RealtimeSessionManager::clear_audio(const std::string& session_id) {
 }
 
 void RealtimeSessionManager::transcribe_and_send(std::shared_ptr<RealtimeSession> session) {
-    if (!session || session->audio_buffer.empty()) {
+    if (!session) {
+        return;
+    }
+
+    // Trailing audio held for jitter smoothing belongs to this utterance.
+    session->jitter_release.clear();
+    if (session->jitter_buffer.flush(session->jitter_release) > 0) {
+        session->audio_buffer.append_raw(session->jitter_release);
+    }
+
+    if (session->audio_buffer.empty()) {
         return;
     }
 
     // Snapshot WAV data and clear buffer on the callback thread (no data race)
     auto wav_data = session->audio_buffer.get_wav_padded(500);
-    std::string model = session->model;
     session->audio_buffer.clear();
     session->vad.reset();
     session->vad_speech_window_open = false;
     session->last_interim_transcription_ms = 0;  // Reset for next utterance
 
-    // Dispatch transcription to worker thread so it doesn't block the WebSocket callback
-    auto future = std::async(std::launch::async,
-        [this, session, wav_data = std::move(wav_data), model = std::move(model)]() {
-            transcribe_wav(session, wav_data, model);
-        });
-
-    // Track future for clean shutdown
-    {
-        std::lock_guard<std::mutex> lock(transcriptions_mutex_);
-        // Remove completed futures
-        pending_transcriptions_.erase(
-            std::remove_if(pending_transcriptions_.begin(), pending_transcriptions_.end(),
-                [](const std::future<void>& f) {
-                    return f.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
-                }),
-            pending_transcriptions_.end()
-        );
-        pending_transcriptions_.push_back(std::move(future));
-    }
+    // The final supersedes any queued interim for this session; the
+    // scheduler drops it so the backend never decodes the stale snapshot
+    transcription_scheduler_.submit({session->session_id, std::move(wav_data),
+                                     session->model, /*is_interim=*/false});
 }
 
 void RealtimeSessionManager::transcribe_wav(
@@ -462,14 +601,26 @@ void RealtimeSessionManager::transcribe_wav(
                       << transcript << "\"" << std::endl;
 
             if (is_interim) {
-                // Interim/partial result — client should treat as replaceable
+                // Interim hypotheses are full re-decodes of the utterance so
+                // far; emit only the newly-stable prefix as the append-only
+                // delta, with the churning tail in "volatile".
+                TranscriptUpdate update;
+                {
+                    std::lock_guard<std::mutex> lock(session->stabilizer_mutex);
+                    update = session->interim_stabilizer.update(transcript);
+                }
                 json msg = {
                     {"type", "conversation.item.input_audio_transcription.delta"},
-                    {"delta", transcript}
+                    {"delta", update.stable_delta},
+                    {"volatile", update.volatile_suffix}
                 };
                 session->send_message(msg);
             } else {
                 // Final result — speech segment is complete
+                {
+                    std::lock_guard<std::mutex> lock(session->stabilizer_mutex);
+                    session->interim_stabilizer.reset();
+                }
                 json msg = {
                     {"type", "conversation.item.input_audio_transcription.completed"},
                     {"transcript", transcript}
@@ -532,8 +683,27 @@ void RealtimeSessionManager::connect_streaming_backend(std::shared_ptr<RealtimeS
         // events (delta/completed) and the stream-level audio events
         // (speech_started/speech_stopped/committed) the UI listens for.
         std::string event_type = msg.value("type", "");
-        if (event_type == "conversation.item.input_audio_transcription.delta" ||
-            event_type == "conversation.item.input_audio_transcription.completed" ||
+        if (event_type == "conversation.item.input_audio_transcription.delta") {
+            // The backend re-decodes the utterance on every audio delta and
+            // sends the full hypothesis; stabilize it so interim payloads
+            // stay bounded over long utterances.
+            TranscriptUpdate update;
+            {
+                std::lock_guard<std::mutex> lock(session->stabilizer_mutex);
+                update = session->interim_stabilizer.update(msg.value("delta", ""));
+            }
+            json out = msg;
+            out["delta"] = update.stable_delta;
+            out["volatile"] = update.volatile_suffix;
+            session->send_message(out);
+            return;
+        }
+        if (event_type == "conversation.item.input_audio_transcription.completed" ||
+            event_type == "input_audio_buffer.speech_started") {
+            std::lock_guard<std::mutex> lock(session->stabilizer_mutex);
+            session->interim_stabilizer.reset();
+        }
+        if (event_type == "conversation.item.input_audio_transcription.completed" ||
             event_type == "input_audio_buffer.speech_started" ||
             event_type == "input_audio_buffer.speech_stopped" ||
             event_type == "input_audio_buffer.committed" ||
@@ -632,6 +802,12 @@ void RealtimeSessionManager::close_session(const std::string& session_id) {
         }
     }
     if (session) {
+        transcription_scheduler_.drop_session(session_id);
+        const uint64_t dropped = session->audio_buffer.overflow_samples();
+        if (dropped > 0) {
+            LOG(WARNING, "RealtimeSession") << "Session " << session_id << " dropped "
+                                            << dropped << " audio samples (ring overflow)" << std::endl;
+        }
         disconnect_streaming_backend(session);
     }
 }
@@ -2,6 +2,7 @@
 #include <lemon/backends/backend_descriptor_registry.h>
 #include <lemon/utils/custom_args.h>
 #include <nlohmann/json.hpp>
+#include <algorithm>
 #include <map>
 #ifdef LEMONADE_CLI
 #include <CLI/CLI.hpp>
@@ -22,9 +23,19 @@ static const json& common_defaults() {
         // Auto-eviction options (apply to every recipe)
         {"auto_evict", nullptr},          // nullptr means fallback to global config
         {"evict_idle_timeout", 300},      // Default hard idle timeout (5 mins)
+        {"hibernate_idle_timeout", 180},  // Default deep idle timeout (3 mins)
         {"downsize_idle_timeout", 60},    // Default soft idle timeout (1 min)
         {"evict_weight_factor", 1.0},     // Eviction-protection weight (higher = more protected)
         {"pinned", false},
+        {"reserved", false},
+        {"reserved_dedicated_slot", false},
+        {"warmup", true},
+        // Per-operation-class backend timeout budgets in seconds (0 disables
+        // the budget). chat_idle_timeout bounds time between streamed chunks
+        // rather than total generation time.
+        {"embeddings_timeout", 60},
+        {"reranking_timeout", 60},
+        {"chat_idle_timeout", 300},
     };
     return d;
 }
@@ -52,6 +63,7 @@ static const std::map<std::string, std::string>& get_option_to_cli_flag() {
         std::map<std::string, std::string> m{
             {"ctx_size", "--ctx-size"},
             {"merge_args", "--merge-args"},
+            {"warmup", "--warmup"},
         };
         for (const auto* desc : lemon::backends::all_descriptors()) {
             for (const auto& opt : desc->options) {
@@ -65,7 +77,7 @@ static const std::map<std::string, std::string>& get_option_to_cli_flag() {
     return mapping;
 }
 
-static std::vector<std::string> get_keys_for_recipe(const std::string& recipe) {
+static std::vector<std::string> build_keys_for_recipe(const std::string& recipe) {
     std::vector<std::string> keys;
     if (const auto* desc = lemon::backends::descriptor_for(recipe)) {
         if (desc->uses_ctx_size) {
@@ -80,13 +92,38 @@ static std::vector<std::string> get_keys_for_recipe(const std::string& recipe) {
     // Add auto-eviction options for all recipes
     keys.push_back("auto_evict");
     keys.push_back("evict_idle_timeout");
+    keys.push_back("hibernate_idle_timeout");
     keys.push_back("downsize_idle_timeout");
     keys.push_back("evict_weight_factor");
     keys.push_back("pinned");
+    keys.push_back("reserved");
+    keys.push_back("reserved_dedicated_slot");
+    keys.push_back("warmup");
+    keys.push_back("embeddings_timeout");
+    keys.push_back("reranking_timeout");
+    keys.push_back("chat_idle_timeout");
 
     return keys;
 }
 
+// Per-recipe key sets never change after the descriptor registry is built, so
+// they are assembled once instead of on every RecipeOptions construction.
+static const std::vector<std::string>& get_keys_for_recipe(const std::string& recipe) {
+    static const std::map<std::string, std::vector<std::string>> precomputed = [] {
+        std::map<std::string, std::vector<std::string>> m;
+        for (const auto* desc : lemon::backends::all_descriptors()) {
+            m[desc->recipe] = build_keys_for_recipe(desc->recipe);
+        }
+        return m;
+    }();
+    auto it = precomputed.find(recipe);
+    if (it != precomputed.end()) {
+        return it->second;
+    }
+    static const std::vector<std::string> common_only = build_keys_for_recipe("");
+    return common_only;
+}
+
 static bool is_empty_option(json option) {
     return option.is_null() ||
            (option.is_number() && (option == -1)) ||
@@ -143,11 +180,92 @@ std::vector<std::string> RecipeOptions::known_keys() {
     return keys;
 }
 
+static size_t edit_distance(const std::string& a, const std::string& b) {
+    std::vector<size_t> prev(b.size() + 1);
+    std::vector<size_t> cur(b.size() + 1);
+    for (size_t j = 0; j <= b.size(); ++j) prev[j] = j;
+    for (size_t i = 1; i <= a.size(); ++i) {
+        cur[0] = i;
+        for (size_t j = 1; j <= b.size(); ++j) {
+            size_t cost = a[i - 1] == b[j - 1] ? 0 : 1;
+            cur[j] = std::min({prev[j] + 1, cur[j - 1] + 1, prev[j - 1] + cost});
+        }
+        std::swap(prev, cur);
+    }
+    return prev[b.size()];
+}
+
+static const char* json_type_label(const json& value) {
+    if (value.is_boolean()) return "a boolean";
+    if (value.is_number()) return "a number";
+    if (value.is_string()) return "a string";
+    if (value.is_null()) return "null";
+    if (value.is_array()) return "an array";
+    return "an object";
+}
+
+std::vector<std::string> RecipeOptions::validate(const std::string& recipe, const json& options) {
+    std::vector<std::string> errors;
+    if (!lemon::backends::descriptor_for(recipe)) {
+        return errors;
+    }
+    if (!options.is_object()) {
+        if (!options.is_null()) {
+            errors.push_back("recipe options for '" + recipe + "' must be a JSON object");
+        }
+        return errors;
+    }
+
+    const std::vector<std::string>& keys = get_keys_for_recipe(recipe);
+    for (auto it = options.begin(); it != options.end(); ++it) {
+        const std::string& key = it.key();
+        if (std::find(keys.begin(), keys.end(), key) == keys.end()) {
+            std::string msg = "unknown option '" + key + "' for recipe '" + recipe + "'";
+            std::string best;
+            size_t best_distance = 3;
+            for (const auto& known : keys) {
+                size_t d = edit_distance(key, known);
+                if (d < best_distance) {
+                    best_distance = d;
+                    best = known;
+                }
+            }
+            if (!best.empty()) {
+                msg += " (did you mean '" + best + "'?)";
+            }
+            errors.push_back(msg);
+            continue;
+        }
+
+        const json& value = it.value();
+        if (is_empty_option(value)) {
+            continue;
+        }
+        if (!get_defaults().contains(key)) {
+            continue;
+        }
+        const json& def = get_defaults()[key];
+        // auto_evict defaults to null (fall back to global config), so it
+        // carries no type to validate against.
+        if (def.is_null()) {
+            continue;
+        }
+        bool compatible = (def.is_number() && value.is_number()) ||
+                          value.type() == def.type();
+        if (!compatible) {
+            errors.push_back("option '" + key + "' for recipe '" + recipe +
+                             "' expects " + json_type_label(def) + ", got " +
+                             json_type_label(value) + " (" + value.dump() + ")");
+        }
+    }
+    return errors;
+}
+
 RecipeOptions::RecipeOptions(const std::string& recipe, const json& options) {
     recipe_ = recipe;
-    std::vector<std::string> to_copy = get_keys_for_recipe(recipe_);
+    const std::vector<std::string>& to_copy = get_keys_for_recipe(recipe_);
 
-    for (auto key : to_copy) {
+    for (const auto& key : to_copy) {
         if (options.contains(key) && !is_empty_option(options[key])) {
             options_[key] = options[key];
         }
@@ -167,10 +285,10 @@ json RecipeOptions::to_json() const {
 }
 
 std::string RecipeOptions::to_log_string(bool resolve_defaults) const {
-    std::vector<std::string> to_log = get_keys_for_recipe(recipe_);
+    const std::vector<std::string>& to_log = get_keys_for_recipe(recipe_);
     std::string log_string = "";
     bool first = true;
-    for (auto key : to_log) {
+    for (const auto& key : to_log) {
         if (resolve_defaults || options_.contains(key)) {
             if (!first) log_string += ", ";
             first = false;
@@ -252,6 +370,7 @@ static const json& get_cli_options() {
         json o = json::object();
         o["--ctx-size"] = {{"option_name", "ctx_size"}, {"type_name", "SIZE"}, {"help", "Context size for the model"}, {"group", "General Options"}};
         o["--merge-args"] = {{"option_name", "merge_args"}, {"type_name", "BOOL"}, {"help", "Merge global and model arguments when loading the model"}, {"group", "General Options"}};
+        o["--warmup"] = {{"option_name", "warmup"}, {"type_name", "BOOL"}, {"help", "Run a tiny synthetic inference after load so the first request hits steady-state latency"}, {"group", "General Options"}};
         for (const auto* desc : lemon::backends::all_descriptors()) {
             for (const auto& opt : desc->options) {
                 if (opt.cli_flag.empty()) {
@@ -0,0 +1,189 @@
+#include "lemon/registry_snapshot.h"
+
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+#include "lemon/utils/aixlog.hpp"
+#include "lemon/utils/path_utils.h"
+
+namespace fs = std::filesystem;
+
+namespace lemon {
+namespace registry_snapshot {
+
+namespace {
+
+constexpr char kMagic[4] = {'L', 'M', 'R', 'S'};
+constexpr std::uint32_t kFormatVersion = 1;
+
+void append_u32(std::string& out, std::uint32_t v) {
+    for (int i = 0; i < 4; ++i) {
+        out.push_back(static_cast<char>((v >> (8 * i)) & 0xff));
+    }
+}
+
+void append_u64(std::string& out, std::uint64_t v) {
+    for (int i = 0; i < 8; ++i) {
+        out.push_back(static_cast<char>((v >> (8 * i)) & 0xff));
+    }
+}
+
+std::uint32_t read_u32(const char* p) {
+    std::uint32_t v = 0;
+    for (int i = 0; i < 4; ++i) {
+        v |= static_cast<std::uint32_t>(static_cast<unsigned char>(p[i])) << (8 * i);
+    }
+    return v;
+}
+
+std::uint64_t read_u64(const char* p) {
+    std::uint64_t v = 0;
+    for (int i = 0; i < 8; ++i) {
+        v |= static_cast<std::uint64_t>(static_cast<unsigned char>(p[i])) << (8 * i);
+    }
+    return v;
+}
+
+bool read_file_bytes(const fs::path& path, std::string& out) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file.is_open()) {
+        return false;
+    }
+    std::ostringstream buffer;
+    buffer << file.rdbuf();
+    out = buffer.str();
+    return file.good() || file.eof();
+}
+
+}  // namespace
+
+std::uint64_t hash_bytes(const std::string& bytes) {
+    // FNV-1a, 64-bit.
+    std::uint64_t hash = 0xcbf29ce484222325ULL;
+    for (const char c : bytes) {
+        hash ^= static_cast<unsigned char>(c);
+        hash *= 0x100000001b3ULL;
+    }
+    return hash;
+}
+
+bool read_snapshot(const fs::path& path,
+                   std::uint64_t expected_source_hash,
+                   nlohmann::json& out) {
+    // Header: magic (4) + format version (4) + source hash (8) + payload
+    // size (8), little-endian, followed by the CBOR-encoded document.
+    constexpr size_t kHeaderSize = 24;
+
+    std::string bytes;
+    if (!read_file_bytes(path, bytes) || bytes.size() < kHeaderSize) {
+        return false;
+    }
+    if (std::memcmp(bytes.data(), kMagic, sizeof(kMagic)) != 0) {
+        return false;
+    }
+    if (read_u32(bytes.data() + 4) != kFormatVersion) {
+        return false;
+    }
+    if (read_u64(bytes.data() + 8) != expected_source_hash) {
+        return false;
+    }
+    const std::uint64_t payload_size = read_u64(bytes.data() + 16);
+    if (payload_size != bytes.size() - kHeaderSize) {
+        return false;
+    }
+
+    try {
+        out = nlohmann::json::from_cbor(bytes.begin() + kHeaderSize, bytes.end());
+    } catch (const nlohmann::json::exception&) {
+        return false;
+    }
+    return true;
+}
+
+bool write_snapshot(const fs::path& path,
+                    std::uint64_t source_hash,
+                    const nlohmann::json& doc) {
+    try {
+        std::string bytes;
+        bytes.append(kMagic, sizeof(kMagic));
+        append_u32(bytes, kFormatVersion);
+        append_u64(bytes, source_hash);
+
+        const std::vector<std::uint8_t> payload = nlohmann::json::to_cbor(doc);
+        append_u64(bytes, payload.size());
+        bytes.append(reinterpret_cast<const char*>(payload.data()), payload.size());
+
+        std::error_code dir_ec;
+        fs::create_directories(path.parent_path(), dir_ec);
+
+        // Temp file + rename so a crash mid-write leaves either the old
+        // snapshot or none; a partial file would just fail validation anyway.
+        std::ostringstream tmp_suffix;
+        tmp_suffix << ".tmp."
+                   << std::this_thread::get_id() << "."
+                   << std::chrono::steady_clock::now().time_since_epoch().count();
+        fs::path tmp = path;
+        tmp += tmp_suffix.str();
+        {
+            std::ofstream file(tmp, std::ios::binary | std::ios::trunc);
+            if (!file.is_open()) {
+                throw std::runtime_error("Failed to open " + utils::path_to_utf8(tmp));
+            }
+            file.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+            file.flush();
+            if (!file) {
+                throw std::runtime_error("Failed to write " + utils::path_to_utf8(tmp));
+            }
+        }
+
+        std::error_code ec;
+        fs::rename(tmp, path, ec);
+#ifdef _WIN32
+        if (ec) {
+            ec.clear();
+            fs::remove(path, ec);
+            ec.clear();
+            fs::rename(tmp, path, ec);
+        }
+#endif
+        if (ec) {
+            std::error_code cleanup_ec;
+            fs::remove(tmp, cleanup_ec);
+            throw std::runtime_error("Failed to replace " + utils::path_to_utf8(path) +
+                                     ": " + ec.message());
+        }
+        return true;
+    } catch (const std::exception& e) {
+        LOG(WARNING, "RegistrySnapshot")
+            << "Could not write registry snapshot: " << e.what() << std::endl;
+        return false;
+    }
+}
+
+nlohmann::json load(const std::string& source_path, const fs::path& snapshot_path) {
+    std::string source_bytes;
+    if (!read_file_bytes(utils::path_from_utf8(source_path), source_bytes)) {
+        throw std::runtime_error("Failed to read " + source_path);
+    }
+    const std::uint64_t source_hash = hash_bytes(source_bytes);
+
+    nlohmann::json doc;
+    if (read_snapshot(snapshot_path, source_hash, doc)) {
+        LOG(DEBUG, "RegistrySnapshot")
+            << "Loaded " << fs::path(source_path).filename()
+            << " from binary snapshot" << std::endl;
+        return doc;
+    }
+
+    doc = nlohmann::json::parse(source_bytes);
+    write_snapshot(snapshot_path, source_hash, doc);
+    return doc;
+}
+
+}  // namespace registry_snapshot
+}  // namespace lemon
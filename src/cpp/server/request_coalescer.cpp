@@ -0,0 +1,103 @@
+#include "lemon/request_coalescer.h"
+
+#include <atomic>
+
+namespace lemon {
+
+namespace {
+
+std::atomic<uint64_t> g_requests{0};
+std::atomic<uint64_t> g_leaders{0};
+std::atomic<uint64_t> g_coalesced{0};
+std::atomic<uint64_t> g_bypassed{0};
+
+}  // namespace
+
+bool RequestCoalescer::is_deterministic(const nlohmann::json& request) {
+    if (!request.is_object() || request.value("stream", false)) {
+        return false;
+    }
+    auto it = request.find("temperature");
+    if (it == request.end() || !it->is_number()) {
+        return false;
+    }
+    return it->get<double>() == 0.0;
+}
+
+nlohmann::json RequestCoalescer::run(const std::string& endpoint,
+                                     const nlohmann::json& request,
+                                     const std::function<nlohmann::json()>& compute) {
+    g_requests++;
+    if (!is_deterministic(request)) {
+        g_bypassed++;
+        return compute();
+    }
+
+    // nlohmann objects are key-sorted, so dump() is a canonical serialization.
+    // The full payload is the key: a digest could collide and hand one client
+    // a response computed for another's prompt.
+    const std::string key = endpoint + ":" + request.dump();
+
+    std::shared_ptr<Entry> entry;
+    bool leader = false;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = inflight_.find(key);
+        if (it != inflight_.end()) {
+            entry = it->second;
+        } else {
+            entry = std::make_shared<Entry>();
+            inflight_[key] = entry;
+            leader = true;
+        }
+    }
+
+    if (!leader) {
+        g_coalesced++;
+        std::unique_lock<std::mutex> lock(entry->mutex);
+        entry->cv.wait(lock, [&] { return entry->done; });
+        if (entry->error) {
+            std::rethrow_exception(entry->error);
+        }
+        return entry->result;
+    }
+
+    g_leaders++;
+    nlohmann::json result;
+    std::exception_ptr error;
+    try {
+        result = compute();
+    } catch (...) {
+        error = std::current_exception();
+    }
+
+    // Retire the key before publishing so arrivals from here on start a fresh
+    // computation instead of attaching to a finished one.
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        inflight_.erase(key);
+    }
+    {
+        std::lock_guard<std::mutex> lock(entry->mutex);
+        entry->result = result;
+        entry->error = error;
+        entry->done = true;
+    }
+    entry->cv.notify_all();
+
+    if (error) {
+        std::rethrow_exception(error);
+    }
+    return result;
+}
+
+RequestCoalescer::Totals RequestCoalescer::totals() {
+    Totals t;
+    t.requests = g_requests.load();
+    t.leaders = g_leaders.load();
+    t.coalesced = g_coalesced.load();
+    t.bypassed = g_bypassed.load();
+    return t;
+}
+
+} // namespace lemon
@@ -0,0 +1,219 @@
+#include "lemon/rerank_batcher.h"
+
+#include <algorithm>
+#include <set>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+namespace lemon {
+
+namespace {
+
+struct ScoredDocument {
+    json entry;
+    size_t index = 0;
+    double score = 0.0;
+};
+
+double entry_score(const json& entry) {
+    if (entry.contains("relevance_score") && entry["relevance_score"].is_number()) {
+        return entry["relevance_score"].get<double>();
+    }
+    if (entry.contains("score") && entry["score"].is_number()) {
+        return entry["score"].get<double>();
+    }
+    return 0.0;
+}
+
+void merge_usage(json& total, const json& chunk_usage) {
+    if (!chunk_usage.is_object()) {
+        return;
+    }
+    if (!total.is_object()) {
+        total = json::object();
+    }
+    for (const auto& [key, value] : chunk_usage.items()) {
+        if (!value.is_number()) {
+            continue;
+        }
+        if (total.contains(key) && total[key].is_number()) {
+            total[key] = total[key].get<double>() + value.get<double>();
+        } else {
+            total[key] = value;
+        }
+    }
+}
+
+std::set<size_t> top_n_indices(const std::vector<ScoredDocument>& scored, size_t n) {
+    std::vector<const ScoredDocument*> ranked;
+    ranked.reserve(scored.size());
+    for (const auto& doc : scored) {
+        ranked.push_back(&doc);
+    }
+    std::sort(ranked.begin(), ranked.end(),
+              [](const ScoredDocument* a, const ScoredDocument* b) {
+                  if (a->score != b->score) return a->score > b->score;
+                  return a->index < b->index;
+              });
+
+    std::set<size_t> indices;
+    for (size_t i = 0; i < ranked.size() && i < n; ++i) {
+        indices.insert(ranked[i]->index);
+    }
+    return indices;
+}
+
+} // namespace
+
+RerankBatcher::RerankBatcher(int chunk_docs, int parallel_chunks)
+    : chunk_docs_(chunk_docs), parallel_chunks_(std::max(1, parallel_chunks)) {}
+
+json RerankBatcher::reranking(const json& request, const BackendCall& call) {
+    if (chunk_docs_ <= 0 || !request.is_object() || !request.contains("documents") ||
+        !request["documents"].is_array()) {
+        return call(request);
+    }
+
+    const json& documents = request["documents"];
+    const size_t total_docs = documents.size();
+    if (total_docs <= static_cast<size_t>(chunk_docs_)) {
+        return call(request);
+    }
+
+    int top_n = 0;
+    if (request.contains("top_n") && request["top_n"].is_number_integer()) {
+        top_n = request["top_n"].get<int>();
+    }
+    const bool early_stop = request.value("early_stop", false) && top_n > 0 &&
+                            static_cast<size_t>(top_n) < total_docs;
+
+    json chunk_template = request;
+    chunk_template.erase("top_n");
+    chunk_template.erase("early_stop");
+
+    struct Chunk {
+        size_t begin = 0;
+        size_t end = 0;
+        json response;
+        std::string failure;
+    };
+    std::vector<Chunk> chunks;
+    for (size_t begin = 0; begin < total_docs; begin += chunk_docs_) {
+        Chunk chunk;
+        chunk.begin = begin;
+        chunk.end = std::min(begin + chunk_docs_, total_docs);
+        chunks.push_back(std::move(chunk));
+    }
+
+    std::vector<ScoredDocument> scored;
+    scored.reserve(total_docs);
+    json first_response;
+    json usage;
+    std::set<size_t> previous_top;
+    bool have_previous_top = false;
+    bool stopped_early = false;
+
+    for (size_t wave_begin = 0; wave_begin < chunks.size() && !stopped_early;
+         wave_begin += parallel_chunks_) {
+        const size_t wave_end =
+            std::min(wave_begin + parallel_chunks_, chunks.size());
+
+        std::vector<std::thread> workers;
+        for (size_t i = wave_begin; i < wave_end; ++i) {
+            workers.emplace_back([&, i] {
+                Chunk& chunk = chunks[i];
+                json chunk_request = chunk_template;
+                json chunk_docs = json::array();
+                for (size_t doc = chunk.begin; doc < chunk.end; ++doc) {
+                    chunk_docs.push_back(documents[doc]);
+                }
+                chunk_request["documents"] = std::move(chunk_docs);
+                try {
+                    chunk.response = call(chunk_request);
+                } catch (const std::exception& e) {
+                    chunk.failure = e.what();
+                }
+            });
+        }
+        for (auto& worker : workers) {
+            worker.join();
+        }
+
+        for (size_t i = wave_begin; i < wave_end; ++i) {
+            Chunk& chunk = chunks[i];
+            if (!chunk.failure.empty()) {
+                throw std::runtime_error(chunk.failure);
+            }
+            if (chunk.response.contains("error")) {
+                return chunk.response;
+            }
+            if (first_response.is_null()) {
+                first_response = chunk.response;
+            }
+            if (chunk.response.contains("usage")) {
+                merge_usage(usage, chunk.response["usage"]);
+            }
+            if (!chunk.response.contains("results") ||
+                !chunk.response["results"].is_array()) {
+                continue;
+            }
+            for (const auto& entry : chunk.response["results"]) {
+                if (!entry.is_object() || !entry.contains("index") ||
+                    !entry["index"].is_number_integer()) {
+                    continue;
+                }
+                ScoredDocument doc;
+                doc.index = chunk.begin + entry["index"].get<size_t>();
+                doc.score = entry_score(entry);
+                doc.entry = entry;
+                doc.entry["index"] = doc.index;
+                scored.push_back(std::move(doc));
+            }
+        }
+
+        if (early_stop && scored.size() >= static_cast<size_t>(top_n) &&
+            wave_end < chunks.size()) {
+            std::set<size_t> current_top =
+                top_n_indices(scored, static_cast<size_t>(top_n));
+            if (have_previous_top && current_top == previous_top) {
+                stopped_early = true;
+            }
+            previous_top = std::move(current_top);
+            have_previous_top = true;
+        }
+    }
+
+    std::sort(scored.begin(), scored.end(),
+              [top_n](const ScoredDocument& a, const ScoredDocument& b) {
+                  if (top_n > 0 && a.score != b.score) return a.score > b.score;
+                  return a.index < b.index;
+              });
+
+    json results = json::array();
+    for (const auto& doc : scored) {
+        if (top_n > 0 && results.size() >= static_cast<size_t>(top_n)) {
+            break;
+        }
+        results.push_back(doc.entry);
+    }
+
+    json response = json::object();
+    if (first_response.is_object()) {
+        if (first_response.contains("model")) response["model"] = first_response["model"];
+        if (first_response.contains("object")) response["object"] = first_response["object"];
+    }
+    if (!response.contains("model") && request.contains("model")) {
+        response["model"] = request["model"];
+    }
+    response["results"] = std::move(results);
+    if (usage.is_object()) {
+        response["usage"] = std::move(usage);
+    }
+    if (stopped_early) {
+        response["early_stopped"] = true;
+    }
+    return response;
+}
+
+} // namespace lemon
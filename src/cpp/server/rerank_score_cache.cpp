@@ -0,0 +1,186 @@
+#include "lemon/rerank_score_cache.h"
+
+#include <algorithm>
+#include <vector>
+
+namespace lemon {
+
+namespace {
+
+constexpr uint64_t kFnvOffsetBasis = 0xcbf29ce484222325ULL;
+constexpr uint64_t kFnvPrime = 0x100000001b3ULL;
+constexpr char kFieldSeparator = '\x1f';
+
+uint64_t fnv1a64(const std::string& data, uint64_t hash) {
+    for (unsigned char c : data) {
+        hash ^= c;
+        hash *= kFnvPrime;
+    }
+    hash ^= static_cast<unsigned char>(kFieldSeparator);
+    hash *= kFnvPrime;
+    return hash;
+}
+
+double entry_score(const json& entry) {
+    if (entry.contains("relevance_score") && entry["relevance_score"].is_number()) {
+        return entry["relevance_score"].get<double>();
+    }
+    if (entry.contains("score") && entry["score"].is_number()) {
+        return entry["score"].get<double>();
+    }
+    return 0.0;
+}
+
+} // namespace
+
+RerankScoreCache::RerankScoreCache(size_t max_entries) : max_entries_(max_entries) {}
+
+json RerankScoreCache::reranking(const json& request, const std::string& model_key,
+                                 const BackendCall& call) {
+    if (max_entries_ == 0 || model_key.empty() || !request.is_object() ||
+        !request.contains("query") || !request["query"].is_string() ||
+        !request.contains("documents") || !request["documents"].is_array() ||
+        request["documents"].empty() || request.value("early_stop", false)) {
+        return call(request);
+    }
+
+    const json& documents = request["documents"];
+    const std::string& query = request["query"].get_ref<const std::string&>();
+    // The echoed document changes the entry shape, so the flag is part of the
+    // pair identity.
+    const std::string flags = request.value("return_documents", false) ? "1" : "0";
+
+    int top_n = 0;
+    if (request.contains("top_n") && request["top_n"].is_number_integer()) {
+        top_n = request["top_n"].get<int>();
+    }
+
+    // Two independent 64-bit FNV-1a passes over the same fields; at cache
+    // sizes in the thousands a 128-bit collision is negligible, and the key
+    // stays fixed-size regardless of document length.
+    const uint64_t lo_base =
+        fnv1a64(flags, fnv1a64(query, fnv1a64(model_key, kFnvOffsetBasis)));
+    const uint64_t hi_base =
+        fnv1a64(flags, fnv1a64(query, fnv1a64(model_key, ~kFnvOffsetBasis)));
+
+    std::vector<PairKey> keys;
+    keys.reserve(documents.size());
+    for (const auto& doc : documents) {
+        const std::string content = doc.is_string()
+                                        ? doc.get<std::string>()
+                                        : doc.dump();
+        keys.push_back({fnv1a64(content, lo_base), fnv1a64(content, hi_base)});
+    }
+
+    std::vector<json> merged(documents.size());
+    std::vector<size_t> uncached;
+    for (size_t i = 0; i < keys.size(); ++i) {
+        json entry;
+        if (lookup(keys[i], entry)) {
+            entry["index"] = i;
+            merged[i] = std::move(entry);
+        } else {
+            uncached.push_back(i);
+        }
+    }
+
+    json backend_response;
+    if (!uncached.empty()) {
+        json sub_request = request;
+        // The backend must score every uncached document so cached and fresh
+        // scores can be ranked together; top-n truncation happens after the
+        // merge.
+        sub_request.erase("top_n");
+        json sub_docs = json::array();
+        for (size_t i : uncached) {
+            sub_docs.push_back(documents[i]);
+        }
+        sub_request["documents"] = std::move(sub_docs);
+
+        backend_response = call(sub_request);
+        if (!backend_response.is_object() || backend_response.contains("error") ||
+            !backend_response.contains("results") ||
+            !backend_response["results"].is_array()) {
+            return backend_response;
+        }
+        for (const auto& entry : backend_response["results"]) {
+            if (!entry.is_object() || !entry.contains("index") ||
+                !entry["index"].is_number_integer()) {
+                continue;
+            }
+            const size_t sub_index = entry["index"].get<size_t>();
+            if (sub_index >= uncached.size()) {
+                continue;
+            }
+            const size_t original = uncached[sub_index];
+            json stored = entry;
+            stored.erase("index");
+            store(keys[original], stored);
+            stored["index"] = original;
+            merged[original] = std::move(stored);
+        }
+    }
+
+    std::vector<const json*> ranked;
+    ranked.reserve(merged.size());
+    for (const auto& entry : merged) {
+        if (entry.is_object()) {
+            ranked.push_back(&entry);
+        }
+    }
+    std::sort(ranked.begin(), ranked.end(), [top_n](const json* a, const json* b) {
+        const double score_a = entry_score(*a);
+        const double score_b = entry_score(*b);
+        if (top_n > 0 && score_a != score_b) return score_a > score_b;
+        return (*a)["index"].get<size_t>() < (*b)["index"].get<size_t>();
+    });
+
+    json results = json::array();
+    for (const json* entry : ranked) {
+        if (top_n > 0 && results.size() >= static_cast<size_t>(top_n)) {
+            break;
+        }
+        results.push_back(*entry);
+    }
+
+    json response = json::object();
+    if (backend_response.is_object()) {
+        if (backend_response.contains("model")) response["model"] = backend_response["model"];
+        if (backend_response.contains("object")) response["object"] = backend_response["object"];
+        if (backend_response.contains("usage")) response["usage"] = backend_response["usage"];
+    }
+    if (!response.contains("model") && request.contains("model")) {
+        response["model"] = request["model"];
+    }
+    response["results"] = std::move(results);
+    return response;
+}
+
+bool RerankScoreCache::lookup(const PairKey& key, json& result) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = entries_.find(key);
+    if (it == entries_.end()) {
+        return false;
+    }
+    lru_.splice(lru_.end(), lru_, it->second);
+    result = it->second->result;
+    return true;
+}
+
+void RerankScoreCache::store(const PairKey& key, json result) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = entries_.find(key);
+    if (it != entries_.end()) {
+        it->second->result = std::move(result);
+        lru_.splice(lru_.end(), lru_, it->second);
+        return;
+    }
+    lru_.push_back({key, std::move(result)});
+    entries_[key] = std::prev(lru_.end());
+    while (entries_.size() > max_entries_) {
+        entries_.erase(lru_.front().key);
+        lru_.pop_front();
+    }
+}
+
+} // namespace lemon
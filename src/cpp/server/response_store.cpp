@@ -0,0 +1,341 @@
+#include "lemon/response_store.h"
+
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <random>
+#include <sstream>
+
+#include "lemon/utils/aixlog.hpp"
+
+namespace fs = std::filesystem;
+
+namespace lemon {
+
+ResponseStore::ResponseStore(const std::string& root_dir, size_t max_records)
+    : root_dir_(root_dir), max_records_(max_records == 0 ? 1 : max_records) {
+    std::error_code ec;
+    fs::create_directories(root_dir_, ec);
+    load_from_disk();
+}
+
+bool ResponseStore::is_terminal_status(const std::string& status) {
+    return status == "completed" || status == "failed" || status == "cancelled";
+}
+
+std::string ResponseStore::generate_id() {
+    static thread_local std::mt19937_64 rng{std::random_device{}()};
+    std::uniform_int_distribution<uint64_t> dist;
+    std::ostringstream oss;
+    oss << "resp_" << std::hex << std::setfill('0')
+        << std::setw(16) << dist(rng)
+        << std::setw(16) << dist(rng);
+    return oss.str();
+}
+
+std::string ResponseStore::record_path(const std::string& id) const {
+    return (fs::path(root_dir_) / (id + ".json")).string();
+}
+
+std::string ResponseStore::create(const json& request) {
+    Record record;
+    record.id = generate_id();
+    record.status = "queued";
+    record.created_at = std::chrono::duration_cast<std::chrono::seconds>(
+                            std::chrono::system_clock::now().time_since_epoch())
+                            .count();
+    if (request.is_object() && request.contains("model") &&
+        request["model"].is_string()) {
+        record.model = request["model"].get<std::string>();
+    }
+    record.request = request;
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    evict_over_budget_locked();
+    const std::string id = record.id;
+    creation_order_.push_back(id);
+    records_.emplace(id, std::move(record));
+    return id;
+}
+
+void ResponseStore::mark_in_progress(const std::string& id) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = records_.find(id);
+    if (it != records_.end() && it->second.status == "queued") {
+        it->second.status = "in_progress";
+    }
+}
+
+bool ResponseStore::append_event(const std::string& id, const std::string& chunk) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = records_.find(id);
+    if (it == records_.end() || it->second.cancel_requested ||
+        is_terminal_status(it->second.status)) {
+        return false;
+    }
+    it->second.events.push_back(chunk);
+    return true;
+}
+
+void ResponseStore::complete(const std::string& id, const json& response) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = records_.find(id);
+    if (it == records_.end() || is_terminal_status(it->second.status)) {
+        return;
+    }
+    it->second.status = it->second.cancel_requested ? "cancelled" : "completed";
+    it->second.response = response;
+    persist_locked(it->second);
+}
+
+void ResponseStore::fail(const std::string& id, const std::string& error) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = records_.find(id);
+    if (it == records_.end() || is_terminal_status(it->second.status)) {
+        return;
+    }
+    it->second.status = it->second.cancel_requested ? "cancelled" : "failed";
+    it->second.error = error;
+    persist_locked(it->second);
+}
+
+void ResponseStore::finalize_from_events(const std::string& id) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = records_.find(id);
+    if (it == records_.end() || is_terminal_status(it->second.status)) {
+        return;
+    }
+    Record& record = it->second;
+
+    if (record.cancel_requested) {
+        record.status = "cancelled";
+        persist_locked(record);
+        return;
+    }
+
+    // The terminal SSE event of a /responses stream carries the full response
+    // object; take the last parseable "data:" payload that has one.
+    for (auto chunk = record.events.rbegin(); chunk != record.events.rend();
+         ++chunk) {
+        std::istringstream lines(*chunk);
+        std::string line;
+        json final_response;
+        while (std::getline(lines, line)) {
+            if (line.rfind("data: ", 0) != 0) continue;
+            json payload = json::parse(line.substr(6), nullptr, false);
+            if (payload.is_object() && payload.contains("response") &&
+                payload["response"].is_object()) {
+                final_response = payload["response"];
+            }
+        }
+        if (!final_response.is_null()) {
+            record.status = "completed";
+            record.response = std::move(final_response);
+            persist_locked(record);
+            return;
+        }
+    }
+
+    record.status = "failed";
+    record.error = "Backend stream ended without a terminal response event";
+    persist_locked(record);
+}
+
+bool ResponseStore::cancel(const std::string& id) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = records_.find(id);
+    if (it == records_.end() || is_terminal_status(it->second.status)) {
+        return false;
+    }
+    it->second.cancel_requested = true;
+    if (it->second.status == "queued") {
+        it->second.status = "cancelled";
+        persist_locked(it->second);
+    }
+    return true;
+}
+
+bool ResponseStore::remove(const std::string& id) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = records_.find(id);
+    if (it == records_.end()) {
+        return false;
+    }
+    records_.erase(it);
+    for (auto order = creation_order_.begin(); order != creation_order_.end();
+         ++order) {
+        if (*order == id) {
+            creation_order_.erase(order);
+            break;
+        }
+    }
+    std::error_code ec;
+    fs::remove(record_path(id), ec);
+    return true;
+}
+
+bool ResponseStore::exists(const std::string& id) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return records_.count(id) > 0;
+}
+
+bool ResponseStore::is_terminal(const std::string& id) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = records_.find(id);
+    return it != records_.end() && is_terminal_status(it->second.status);
+}
+
+json ResponseStore::get(const std::string& id) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = records_.find(id);
+    if (it == records_.end()) {
+        return json();
+    }
+    const Record& record = it->second;
+
+    json out;
+    if (record.status == "completed" && record.response.is_object()) {
+        out = record.response;
+    }
+    out["id"] = record.id;
+    out["object"] = "response";
+    out["status"] = record.status;
+    out["created_at"] = record.created_at;
+    if (!record.model.empty() && !out.contains("model")) {
+        out["model"] = record.model;
+    }
+    if (record.status == "failed" && !record.error.empty()) {
+        out["error"] = {{"message", record.error}};
+    }
+    return out;
+}
+
+std::vector<std::string> ResponseStore::events_after(const std::string& id,
+                                                    size_t cursor,
+                                                    size_t* next_cursor) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::vector<std::string> chunks;
+    auto it = records_.find(id);
+    if (it == records_.end()) {
+        if (next_cursor) *next_cursor = cursor;
+        return chunks;
+    }
+    const auto& events = it->second.events;
+    for (size_t i = cursor; i < events.size(); ++i) {
+        chunks.push_back(events[i]);
+    }
+    if (next_cursor) *next_cursor = events.size() > cursor ? events.size() : cursor;
+    return chunks;
+}
+
+size_t ResponseStore::size() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return records_.size();
+}
+
+size_t ResponseStore::approx_bytes() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    size_t bytes = 0;
+    for (const auto& [id, record] : records_) {
+        bytes += id.size() + record.request.dump().size() +
+                 record.response.dump().size() + record.error.size();
+        for (const auto& event : record.events) {
+            bytes += event.size();
+        }
+    }
+    return bytes;
+}
+
+void ResponseStore::persist_locked(const Record& record) const {
+    json doc = {
+        {"id", record.id},
+        {"status", record.status},
+        {"created_at", record.created_at},
+        {"model", record.model},
+        {"request", record.request},
+        {"response", record.response},
+        {"error", record.error},
+        {"events", record.events},
+    };
+    std::ofstream file(record_path(record.id));
+    if (!file.is_open()) {
+        LOG(WARNING, "ResponseStore") << "Failed to persist " << record.id
+                                      << std::endl;
+        return;
+    }
+    file << doc.dump();
+}
+
+void ResponseStore::evict_over_budget_locked() {
+    while (records_.size() >= max_records_) {
+        bool evicted = false;
+        for (auto order = creation_order_.begin();
+             order != creation_order_.end(); ++order) {
+            auto it = records_.find(*order);
+            if (it == records_.end()) {
+                order = creation_order_.erase(order);
+                evicted = true;
+                break;
+            }
+            if (is_terminal_status(it->second.status)) {
+                std::error_code ec;
+                fs::remove(record_path(*order), ec);
+                records_.erase(it);
+                creation_order_.erase(order);
+                evicted = true;
+                break;
+            }
+        }
+        // Every resident record is still running; let the bound slip rather
+        // than destroy live runs (in-flight count is limited in practice).
+        if (!evicted) {
+            break;
+        }
+    }
+}
+
+void ResponseStore::load_from_disk() {
+    std::error_code ec;
+    std::vector<Record> loaded;
+    for (const auto& entry : fs::directory_iterator(root_dir_, ec)) {
+        if (!entry.is_regular_file() || entry.path().extension() != ".json") {
+            continue;
+        }
+        std::ifstream file(entry.path());
+        json doc = json::parse(file, nullptr, false);
+        if (!doc.is_object() || !doc.contains("id") || !doc["id"].is_string() ||
+            !doc.contains("status") || !doc["status"].is_string() ||
+            !is_terminal_status(doc["status"].get<std::string>())) {
+            continue;
+        }
+        Record record;
+        record.id = doc["id"].get<std::string>();
+        record.status = doc["status"].get<std::string>();
+        record.created_at = doc.value("created_at", std::int64_t{0});
+        record.model = doc.value("model", "");
+        record.request = doc.value("request", json());
+        record.response = doc.value("response", json());
+        record.error = doc.value("error", "");
+        if (doc.contains("events") && doc["events"].is_array()) {
+            for (const auto& event : doc["events"]) {
+                if (event.is_string()) {
+                    record.events.push_back(event.get<std::string>());
+                }
+            }
+        }
+        loaded.push_back(std::move(record));
+    }
+
+    std::sort(loaded.begin(), loaded.end(),
+              [](const Record& a, const Record& b) {
+                  return a.created_at < b.created_at;
+              });
+    for (auto& record : loaded) {
+        creation_order_.push_back(record.id);
+        records_.emplace(record.id, std::move(record));
+    }
+}
+
+} // namespace lemon
@@ -11,27 +11,47 @@
 #include "lemon/backends/sdcpp/sdcpp_server.h"
 #include "lemon/backends/vllm/vllm_server.h"
 #include "lemon/server_capabilities.h"
+#include "lemon/sse_writer.h"
 #include "lemon/streaming_proxy.h"
 #include "lemon/error_types.h"
 #include "lemon/recipe_options.h"
+#include "lemon/reservation_policy.h"
 #include "lemon/auto_tune.h"
+#include "lemon/latency_histograms.h"
+#include "lemon/router_journal.h"
 #include "telemetry.h"
 #include <algorithm>
+#include <chrono>
 #include <condition_variable>
+#include <iomanip>
 #include <iostream>
 #include <mutex>
 #include <queue>
+#include <sstream>
+#include <string_view>
 #include <thread>
 #include "lemon/utils/aixlog.hpp"
+#include "lemon/utils/file_prewarmer.h"
+#include "lemon/utils/gguf_shards.h"
 #include "lemon/global_vram_monitor.h"
 #include "lemon/eviction_engine.h"
 #include "lemon/suspend_inhibitor.h"
 #include "lemon/utils/http_client.h"
+#include "lemon/utils/path_utils.h"
 
 namespace lemon {
 
 namespace {
 
+StatsStore::ModelIdentity to_store_identity(const ModelTelemetryIdentity& identity) {
+    return {identity.model_name, identity.checkpoint, identity.type,
+            identity.device, identity.recipe};
+}
+
+// Marks loads issued by the warm-standby restore thread so a failing restore
+// cannot trigger another snapshot-and-nuke cycle.
+thread_local bool t_standby_reload_thread = false;
+
 // RAII: holds a suspend-inhibitor refcount for the duration of one inference,
 // but only when the feature is enabled in config. Released on scope exit so all
 // early-return/exception paths are covered.
@@ -63,6 +83,34 @@ Router::Router(RuntimeConfig* config, ModelManager* model_manager, BackendManage
     LOG(DEBUG, "Router") << "Max loaded models per type: " << max << std::endl;
     }
 
+    try {
+        stats_store_ = std::make_unique<StatsStore>(
+            std::filesystem::path(utils::get_cache_dir()) / "stats_log.jsonl");
+        for (const auto& model : stats_store_->replay()) {
+            ModelTelemetryIdentity identity;
+            identity.model_name = model.identity.model_name;
+            identity.checkpoint = model.identity.checkpoint;
+            identity.type = model.identity.type;
+            identity.device = model.identity.device;
+            identity.recipe = model.identity.recipe;
+
+            ModelTelemetryRecord& record = telemetry_by_model_[identity.key()];
+            record.identity = identity;
+            record.telemetry.request_count_total = model.totals.request_count_total;
+            record.telemetry.input_tokens_total = model.totals.input_tokens_total;
+            record.telemetry.output_tokens_total = model.totals.output_tokens_total;
+            record.telemetry.prompt_tokens_total = model.totals.prompt_tokens_total;
+
+            aggregate_telemetry_.request_count_total += model.totals.request_count_total;
+            aggregate_telemetry_.input_tokens_total += model.totals.input_tokens_total;
+            aggregate_telemetry_.output_tokens_total += model.totals.output_tokens_total;
+            aggregate_telemetry_.prompt_tokens_total += model.totals.prompt_tokens_total;
+        }
+    } catch (const std::exception& e) {
+        LOG(WARNING, "Router") << "Stats persistence unavailable: " << e.what()
+                               << std::endl;
+    }
+
     vram_monitor_ = std::make_unique<GlobalVramMonitor>();
     eviction_engine_ = std::make_unique<EvictionEngine>(this, vram_monitor_.get());
     suspend_inhibitor_ = create_suspend_inhibitor();
@@ -78,6 +126,8 @@ Router::Router(RuntimeConfig* config, ModelManager* model_manager, BackendManage
 
 Router::~Router() {
     LOG(DEBUG, "Router") << "Destructor: stopping monitors and unloading all models" << std::endl;
+    standby_cancel_.store(true);
+    if (standby_reload_thread_.joinable()) standby_reload_thread_.join();
     if (eviction_engine_) eviction_engine_->stop();
     if (vram_monitor_) vram_monitor_->stop();
     unload_model("");  // Unload all
@@ -165,7 +215,48 @@ bool Router::is_watchdog_reset_response(const json& response) const {
     return false;
 }
 
-bool Router::reload_model_after_watchdog_reset(const std::string& requested_model, const RecipeOptions& options) {
+bool Router::charge_restart_budget(const std::string& model_name, int& retry_after_seconds) {
+    const auto now = std::chrono::steady_clock::now();
+    std::lock_guard<std::mutex> lock(restart_budget_mutex_);
+    auto& attempts = restart_attempts_[model_name];
+    while (!attempts.empty() && now - attempts.front() > kRestartBudgetWindow) {
+        attempts.pop_front();
+    }
+    if (static_cast<int>(attempts.size()) >= kRestartBudgetMax) {
+        const auto wait = kRestartBudgetWindow - (now - attempts.front());
+        retry_after_seconds = static_cast<int>(
+            std::chrono::duration_cast<std::chrono::seconds>(wait).count()) + 1;
+        return false;
+    }
+    attempts.push_back(now);
+    retry_after_seconds = 0;
+    return true;
+}
+
+int Router::estimate_reload_seconds(const std::string& model_name) {
+    std::lock_guard<std::mutex> lock(restart_budget_mutex_);
+    auto it = last_load_duration_ms_.find(model_name);
+    if (it == last_load_duration_ms_.end() || it->second <= 0) {
+        return 15;
+    }
+    return static_cast<int>(it->second / 1000) + 1;
+}
+
+bool Router::reload_model_after_watchdog_reset(const std::string& requested_model, const RecipeOptions& options,
+                                               int* retry_after_seconds) {
+    int budget_wait = 0;
+    if (!charge_restart_budget(requested_model, budget_wait)) {
+        LOG(ERROR, "Router") << "Restart budget exhausted for " << requested_model
+                              << " (" << kRestartBudgetMax << " restarts in "
+                              << kRestartBudgetWindow.count()
+                              << " min); next automatic restart allowed in "
+                              << budget_wait << "s" << std::endl;
+        if (retry_after_seconds) {
+            *retry_after_seconds = budget_wait;
+        }
+        return false;
+    }
+
     try {
         LOG(WARNING, "Router") << "Reloading model after backend watchdog reset: "
                                 << requested_model << std::endl;
@@ -180,12 +271,22 @@ bool Router::reload_model_after_watchdog_reset(const std::string& requested_mode
                 was_residency_class = existing->get_residency_class();
             }
         }
+        const auto reload_start = std::chrono::steady_clock::now();
         load_model(requested_model, info, options, true, false, was_pinned,
                    load_purpose_for_residency_class(was_residency_class));
+        {
+            std::lock_guard<std::mutex> lock(restart_budget_mutex_);
+            last_load_duration_ms_[requested_model] =
+                std::chrono::duration_cast<std::chrono::milliseconds>(
+                    std::chrono::steady_clock::now() - reload_start).count();
+        }
         return true;
     } catch (const std::exception& e) {
         LOG(ERROR, "Router") << "Automatic reload after watchdog reset failed for "
                               << requested_model << ": " << e.what() << std::endl;
+        if (retry_after_seconds) {
+            *retry_after_seconds = estimate_reload_seconds(requested_model);
+        }
         return false;
     }
 }
@@ -203,6 +304,30 @@ static bool is_unmetered_recipe(const std::string& recipe) {
     return slot_policy_for_recipe(recipe) == SlotPolicy::Unmetered;
 }
 
+// A failed warmup never fails the load: the model is already up, and the
+// worst case is the first real request paying the cold-start cost anyway.
+static void run_warmup_if_enabled(WrappedServer* server, const RecipeOptions& options) {
+    auto warmup = options.get_option("warmup");
+    if (warmup.is_boolean() && !warmup.get<bool>()) {
+        return;
+    }
+    if (is_unmetered_recipe(options.get_recipe())) {
+        return;
+    }
+    auto start = std::chrono::steady_clock::now();
+    try {
+        if (!server->run_warmup()) {
+            return;
+        }
+        auto elapsed_ms = std::chrono::duration_cast<std::chrono::milliseconds>(
+                              std::chrono::steady_clock::now() - start)
+                              .count();
+        LOG(DEBUG, "Router") << "Warmup inference finished in " << elapsed_ms << "ms" << std::endl;
+    } catch (const std::exception& e) {
+        LOG(WARNING, "Router") << "Warmup inference failed: " << e.what() << std::endl;
+    }
+}
+
 int Router::count_servers_in_pool(ModelType type,
                                   ResidencyClass residency_class,
                                   const std::string& model_name) const {
@@ -213,6 +338,11 @@ int Router::count_servers_in_pool(ModelType type,
         if (is_unmetered_recipe(server->get_recipe_options().get_recipe())) {
             continue;
         }
+        // A reserved model with a dedicated slot holds its own allocation
+        // outside the shared pool, so it does not shrink the slot budget.
+        if (server->has_dedicated_slot()) {
+            continue;
+        }
         if (server->is_backend_alive() &&
             same_residency_pool(server->get_model_type(),
                                 server->get_residency_class(),
@@ -245,7 +375,7 @@ WrappedServer* Router::find_lru_server_in_pool(
                                 type,
                                 residency_class,
                                 model_name)) {
-            if (server->is_pinned()) {
+            if (server->is_pinned() || server->is_reserved()) {
                 continue;
             }
             if (!lru || server->get_last_access_time() < lru->get_last_access_time()) {
@@ -268,15 +398,168 @@ void Router::ensure_residency_capacity(
 
     WrappedServer* lru = find_lru_server_in_pool(type, residency_class, model_name);
     if (!lru) {
+        for (const auto& server : loaded_servers_) {
+            if (server->is_backend_alive() && server->is_reserved() &&
+                same_residency_pool(server->get_model_type(),
+                                    server->get_residency_class(),
+                                    server->get_model_name(),
+                                    type,
+                                    residency_class,
+                                    model_name)) {
+                throw ReservationViolationException(
+                    model_name, server->get_model_name(),
+                    "pool " + residency_pool_to_string(type, residency_class) +
+                        " is at its slot limit and reserved models are never evicted");
+            }
+        }
         throw SlotsPinnedException(residency_pool_to_string(type, residency_class));
     }
 
     LOG(INFO, "Router") << "Slot limit reached for pool "
                          << residency_pool_to_string(type, residency_class)
                          << ", evicting LRU: " << lru->get_model_name() << std::endl;
+    RouterJournal::instance().record(
+        RouterEventKind::SlotEvict, lru->get_model_name(),
+        "slot limit reached for pool " +
+            residency_pool_to_string(type, residency_class),
+        model_name);
     evict_server(lru);
 }
 
+void Router::ensure_memory_headroom_locked(
+    const ModelInfo& model_info,
+    const RecipeOptions& effective_options,
+    const std::string& model_name) {
+    const double predicted_gb = predict_model_footprint_gb(model_info, effective_options);
+    double available_gb = get_available_memory_gb(model_info.device);
+    if (available_gb <= 0.0) {
+        return;  // Memory undetectable; the fail-evict-retry path remains the backstop.
+    }
+
+    while (predicted_gb > available_gb) {
+        WrappedServer* lru = nullptr;
+        WrappedServer* reserved_peer = nullptr;
+        auto oldest = std::chrono::steady_clock::time_point::max();
+        for (const auto& server : loaded_servers_) {
+            if (!server->is_backend_alive()) continue;
+            if (server->get_model_name() == model_name) continue;
+            if ((server->get_device_type() & model_info.device) == 0) continue;
+            if (server->is_reserved()) {
+                reserved_peer = server.get();
+                continue;
+            }
+            if (server->is_pinned()) continue;
+            if (server->get_last_access_time() < oldest) {
+                oldest = server->get_last_access_time();
+                lru = server.get();
+            }
+        }
+        if (!lru) {
+            // Launching anyway next to a reserved model would put its latency
+            // guarantee at the mercy of allocator luck; reject instead.
+            if (reserved_peer) {
+                throw ReservationViolationException(
+                    model_name, reserved_peer->get_model_name(),
+                    "predicted footprint exceeds the memory left beside it on the device");
+            }
+            LOG(WARNING, "Router") << "Predicted footprint for " << model_name
+                    << " (" << std::fixed << std::setprecision(2) << predicted_gb
+                    << " GB) exceeds " << available_gb
+                    << " GB available with no evictable peers; launching anyway" << std::endl;
+            return;
+        }
+
+        LOG(INFO, "Router") << "Admission control: predicted footprint for " << model_name
+                << " (" << std::fixed << std::setprecision(2) << predicted_gb
+                << " GB) exceeds " << available_gb
+                << " GB available, evicting LRU: " << lru->get_model_name() << std::endl;
+        {
+            std::ostringstream reason;
+            reason << "predicted footprint " << std::fixed << std::setprecision(2)
+                   << predicted_gb << " GB exceeds " << available_gb
+                   << " GB available";
+            RouterJournal::instance().record(RouterEventKind::MemoryEvict,
+                                             lru->get_model_name(), reason.str(),
+                                             model_name, available_gb);
+        }
+        evict_server(lru);
+
+        available_gb = get_available_memory_gb(model_info.device);
+        if (available_gb <= 0.0) {
+            return;
+        }
+    }
+}
+
+void Router::apply_gpu_placement_locked(const ModelInfo& model_info,
+                                        const std::string& backend,
+                                        RecipeOptions& effective_options) const {
+    if (model_info.recipe != "llamacpp" || !vram_monitor_) {
+        return;
+    }
+
+    json pinned_device = effective_options.get_option("llamacpp_device");
+    if (pinned_device.is_string() && !pinned_device.get<std::string>().empty()) {
+        return;
+    }
+
+    std::string prefix;
+    std::string vendor;
+    if (backend.find("cuda") != std::string::npos) {
+        prefix = "CUDA";
+        vendor = "nvidia";
+    } else if (backend.find("rocm") != std::string::npos) {
+        prefix = "ROCm";
+        vendor = "amd";
+    } else if (backend.find("vulkan") != std::string::npos) {
+        prefix = "Vulkan";
+    } else {
+        return;
+    }
+
+    std::vector<SystemInfo::GpuMemoryDevice> eligible;
+    bool any_discrete = false;
+    for (const auto& dev : vram_monitor_->per_device_memory()) {
+        if (!vendor.empty() && dev.vendor != vendor) continue;
+        any_discrete = any_discrete || !dev.integrated;
+        eligible.push_back(dev);
+    }
+    // Vulkan numbers devices across vendors in driver enumeration order, which
+    // this per-vendor enumeration cannot reproduce on mixed-vendor boxes.
+    if (vendor.empty() && !eligible.empty()) {
+        for (const auto& dev : eligible) {
+            if (dev.vendor != eligible.front().vendor) {
+                return;
+            }
+        }
+    }
+    if (eligible.size() < 2) {
+        return;
+    }
+
+    // An iGPU's "free" budget is shared system memory and would always win the
+    // comparison; only place on it when no discrete GPU exists.
+    const SystemInfo::GpuMemoryDevice* best = nullptr;
+    for (const auto& dev : eligible) {
+        if (any_discrete && dev.integrated) continue;
+        const uint64_t free_bytes = dev.total_bytes - dev.used_bytes;
+        if (!best || free_bytes > best->total_bytes - best->used_bytes) {
+            best = &dev;
+        }
+    }
+    if (!best) {
+        return;
+    }
+
+    const std::string device = prefix + std::to_string(best->index);
+    LOG(INFO, "Router") << "Multi-GPU placement: " << device << " ("
+            << std::fixed << std::setprecision(2)
+            << static_cast<double>(best->total_bytes - best->used_bytes) /
+               (1024.0 * 1024.0 * 1024.0)
+            << " GB free) selected for " << model_info.recipe << " load" << std::endl;
+    effective_options.set_option("llamacpp_device", device);
+}
+
 void Router::transition_server_residency_locked(
     WrappedServer* server,
     ResidencyClass requested_residency_class) {
@@ -311,11 +594,15 @@ bool Router::ensure_loaded_model_residency(
         residency_class_for_load_purpose(load_purpose);
 
     std::unique_lock<std::mutex> lock(load_mutex_);
+    const bool behind_exclusive =
+        exclusive_active_ && exclusive_owner_ != std::this_thread::get_id();
+    if (behind_exclusive) ++exclusive_waiters_;
     load_cv_.wait(lock, [&] {
-        return !is_loading_ &&
+        return !model_load_in_flight_locked(canonical_model_name) &&
                (!exclusive_active_ ||
                 exclusive_owner_ == std::this_thread::get_id());
     });
+    if (behind_exclusive) --exclusive_waiters_;
 
     prune_unavailable_servers_locked();
 
@@ -422,7 +709,7 @@ void Router::evict_server(WrappedServer* server, int timeout_seconds) {
     LOG(INFO, "Router") << "Evicted model: " << model_name << std::endl;
 }
 
-void Router::evict_all_servers() {
+void Router::evict_all_servers(bool spare_reserved) {
     LOG(INFO, "Router") << "Evicting all models (" << loaded_servers_.size() << " total)" << std::endl;
 
     // Copy raw pointers first; evict_server may erase entries and move
@@ -432,6 +719,11 @@ void Router::evict_all_servers() {
     std::vector<WrappedServer*> servers;
     servers.reserve(loaded_servers_.size());
     for (const auto& server : loaded_servers_) {
+        if (spare_reserved && server->is_reserved()) {
+            LOG(INFO, "Router") << "Sparing reserved model from evict-all: "
+                                << server->get_model_name() << std::endl;
+            continue;
+        }
         servers.push_back(server.get());
     }
 
@@ -443,6 +735,177 @@ void Router::evict_all_servers() {
                          << loaded_servers_.size() << std::endl;
 }
 
+std::vector<HandoverRecord> Router::export_handover_records(int drain_timeout_seconds) {
+    std::vector<WrappedServer*> candidates;
+    {
+        std::lock_guard<std::mutex> lock(load_mutex_);
+        for (const auto& server : loaded_servers_) {
+            const ModelState state = server->get_state();
+            if (state != ModelState::READY && state != ModelState::IN_USE) continue;
+            if (!server->is_backend_alive()) continue;
+            if (server->get_backend_port() <= 0 || server->get_process_id() <= 0) continue;
+            // Replica sets hold several subprocesses behind one wrapper; only
+            // the primary's handle is exportable, so hand none of them over.
+            json replicas = server->get_recipe_options().get_option("llamacpp_replicas");
+            if (replicas.is_number() && replicas.get<int>() > 1) continue;
+            candidates.push_back(server.get());
+        }
+    }
+
+    std::vector<HandoverRecord> records;
+    for (auto* server : candidates) {
+        if (!server->wait_until_not_busy(drain_timeout_seconds)) {
+            LOG(WARNING, "Router") << "Handover: " << server->get_model_name()
+                                   << " still busy after " << drain_timeout_seconds
+                                   << "s, it will be unloaded normally" << std::endl;
+            continue;
+        }
+
+        HandoverRecord record;
+        record.model_name = server->get_model_name();
+        record.checkpoint = server->get_checkpoint();
+        record.recipe = server->get_recipe_options().get_recipe();
+        record.port = server->get_backend_port();
+        record.pid = server->get_process_id();
+        record.options = server->get_recipe_options().to_json();
+
+        // Detach the handle: the exiting process must not kill this backend
+        // during its normal unload-all, and the successor re-opens it by pid.
+        server->detach_process_for_handover();
+
+        LOG(INFO, "Router") << "Handing over " << record.model_name << " (pid "
+                            << record.pid << ", port " << record.port << ")" << std::endl;
+        records.push_back(std::move(record));
+    }
+    return records;
+}
+
+size_t Router::adopt_handover_records(const std::vector<HandoverRecord>& records) {
+    size_t adopted = 0;
+    for (const auto& record : records) {
+        ProcessHandle handle = utils::ProcessManager::open_process(record.pid);
+        if (!utils::ProcessManager::is_running(handle)) {
+            LOG(WARNING, "Router") << "Handover: backend pid " << record.pid
+                                   << " for " << record.model_name
+                                   << " is gone, skipping" << std::endl;
+            continue;
+        }
+
+        ModelInfo model_info = model_manager_->get_model_info(record.model_name);
+        if (model_info.model_name.empty() ||
+            (!record.recipe.empty() && model_info.recipe != record.recipe)) {
+            LOG(WARNING, "Router") << "Handover: " << record.model_name
+                                   << " no longer resolves to recipe '" << record.recipe
+                                   << "', stopping orphaned backend pid " << record.pid
+                                   << std::endl;
+            utils::ProcessManager::stop_process(handle);
+            continue;
+        }
+
+        std::unique_ptr<WrappedServer> server = create_backend_server(model_info);
+        server->set_model_metadata(record.model_name, record.checkpoint,
+                                   model_info.type, model_info.device,
+                                   RecipeOptions(record.recipe, record.options));
+        server->adopt_running_backend(record.port, handle);
+
+        if (!server->verify_adopted_backend()) {
+            LOG(WARNING, "Router") << "Handover: backend for " << record.model_name
+                                   << " failed its health probe, stopping pid "
+                                   << record.pid << std::endl;
+            const ProcessHandle stale = utils::ProcessManager::open_process(record.pid);
+            if (utils::ProcessManager::is_running(stale)) {
+                utils::ProcessManager::stop_process(stale);
+            }
+            continue;
+        }
+
+        server->set_state(ModelState::READY);
+        server->update_access_time();
+
+        {
+            std::lock_guard<std::mutex> lock(load_mutex_);
+            loaded_servers_.push_back(std::move(server));
+        }
+        ++adopted;
+        LOG(INFO, "Router") << "Adopted running backend for " << record.model_name
+                            << " (pid " << record.pid << ", port " << record.port
+                            << ")" << std::endl;
+    }
+    return adopted;
+}
+
+size_t Router::recover_after_resume() {
+    struct Candidate {
+        WrappedServer* server;
+        std::string model_name;
+        RecipeOptions options;
+    };
+    std::vector<Candidate> candidates;
+    {
+        std::lock_guard<std::mutex> lock(load_mutex_);
+        for (const auto& server : loaded_servers_) {
+            const ModelState state = server->get_state();
+            if (state != ModelState::READY && state != ModelState::IN_USE) continue;
+            if (server->get_backend_port() <= 0) continue;
+            candidates.push_back({server.get(), server->get_model_name(),
+                                  server->get_recipe_options()});
+        }
+    }
+    if (candidates.empty()) {
+        return 0;
+    }
+
+    LOG(INFO, "Router") << "Post-resume health check of " << candidates.size()
+                        << " backend(s)" << std::endl;
+
+    constexpr long kResumeProbeTimeoutSeconds = 10;
+    std::vector<char> healthy(candidates.size(), 0);
+    std::vector<std::thread> probes;
+    probes.reserve(candidates.size());
+    for (size_t i = 0; i < candidates.size(); ++i) {
+        probes.emplace_back([&candidates, &healthy, i]() {
+            WrappedServer* server = candidates[i].server;
+            healthy[i] = server->is_backend_alive() &&
+                                 server->verify_adopted_backend(kResumeProbeTimeoutSeconds)
+                             ? 1
+                             : 0;
+        });
+    }
+    for (auto& probe : probes) {
+        probe.join();
+    }
+
+    size_t restarted = 0;
+    for (size_t i = 0; i < candidates.size(); ++i) {
+        const auto& candidate = candidates[i];
+        if (healthy[i]) {
+            try {
+                candidate.server->run_warmup();
+            } catch (const std::exception& e) {
+                LOG(WARNING, "Router") << "Post-resume warmup of " << candidate.model_name
+                                       << " failed: " << e.what() << std::endl;
+            }
+            continue;
+        }
+
+        LOG(WARNING, "Router") << candidate.model_name
+                               << " is unresponsive after resume, restarting" << std::endl;
+        if (reload_model_after_watchdog_reset(candidate.model_name, candidate.options)) {
+            ++restarted;
+        }
+    }
+
+    if (restarted > 0) {
+        LOG(INFO, "Router") << "Post-resume recovery restarted " << restarted
+                            << " backend(s)" << std::endl;
+    }
+    return restarted;
+}
+
+double Router::current_vram_usage() const {
+    return vram_monitor_ ? vram_monitor_->current_usage() : -1.0;
+}
+
 void Router::simulate_vram_pressure(double pct) {
     if (vram_monitor_) {
         vram_monitor_->simulate_pressure(pct);
@@ -485,7 +948,7 @@ bool Router::begin_exclusive(std::atomic<bool>* cancel) {
             load_cv_.notify_all();
             return false;
         }
-        if (is_loading_) {
+        if (!loads_in_flight_.empty()) {
             load_cv_.wait_for(lock, std::chrono::milliseconds(25));
             continue;
         }
@@ -514,10 +977,212 @@ void Router::end_exclusive() {
     load_cv_.notify_all();
 }
 
+bool Router::load_conflicts_locked(const InFlightLoad& candidate) const {
+    for (const auto& load : loads_in_flight_) {
+        if (load.model_name == candidate.model_name) {
+            return true;
+        }
+        if ((load.device & candidate.device) != 0) {
+            return true;
+        }
+        if (same_residency_pool(candidate.type, candidate.residency_class,
+                                candidate.model_name, load.type,
+                                load.residency_class, load.model_name)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool Router::model_load_in_flight_locked(const std::string& model_name) const {
+    for (const auto& load : loads_in_flight_) {
+        if (load.model_name == model_name) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void Router::end_load_locked(const std::string& model_name) {
+    for (auto it = loads_in_flight_.begin(); it != loads_in_flight_.end(); ++it) {
+        if (it->model_name == model_name) {
+            loads_in_flight_.erase(it);
+            return;
+        }
+    }
+}
+
+std::vector<Router::StandbyReloadEntry> Router::snapshot_residents_for_standby_locked(
+    const std::string& excluding_model) {
+    std::vector<StandbyReloadEntry> entries;
+    for (const auto& server : loaded_servers_) {
+        if (!server->is_backend_alive()) continue;
+        const std::string name = server->get_model_name();
+        if (name == excluding_model) continue;
+        StandbyReloadEntry entry;
+        entry.model_name = name;
+        entry.options = server->get_recipe_options();
+        entry.pinned = server->is_pinned();
+        entry.load_purpose =
+            load_purpose_for_residency_class(server->get_residency_class());
+        entries.push_back(std::move(entry));
+    }
+
+    {
+        std::lock_guard<std::mutex> tlock(telemetry_mutex_);
+        for (auto& entry : entries) {
+            for (const auto& [key, record] : telemetry_by_model_) {
+                if (record.identity.model_name == entry.model_name) {
+                    entry.request_count += record.telemetry.request_count_total;
+                }
+            }
+        }
+    }
+
+    std::sort(entries.begin(), entries.end(),
+              [](const StandbyReloadEntry& a, const StandbyReloadEntry& b) {
+                  return a.request_count > b.request_count;
+              });
+    return entries;
+}
+
+void Router::start_standby_reload(std::vector<StandbyReloadEntry> entries) {
+    if (standby_reload_running_.exchange(true)) {
+        return;
+    }
+    if (standby_reload_thread_.joinable()) {
+        standby_reload_thread_.join();
+    }
+
+    standby_reload_thread_ = std::thread([this, entries = std::move(entries)]() {
+        t_standby_reload_thread = true;
+        LOG(INFO, "Router") << "Warm standby: restoring " << entries.size()
+                            << " evicted model(s) in the background" << std::endl;
+        for (const auto& entry : entries) {
+            if (standby_cancel_.load()) {
+                break;
+            }
+            try {
+                if (is_model_loaded(entry.model_name) ||
+                    !model_manager_->model_exists(entry.model_name)) {
+                    continue;
+                }
+                ModelInfo info = model_manager_->get_model_info(entry.model_name);
+                load_model(entry.model_name, info, entry.options, true,
+                           /*allow_reload_on_option_change=*/false,
+                           entry.pinned, entry.load_purpose, &standby_cancel_);
+            } catch (const std::exception& e) {
+                LOG(WARNING, "Router") << "Warm standby reload failed for "
+                                       << entry.model_name << ": " << e.what() << std::endl;
+            }
+        }
+        standby_reload_running_.store(false);
+    });
+}
+
 void Router::wait_for_slot_clearance(std::unique_lock<std::mutex>& lock) {
+    if (!exclusive_active_ || exclusive_owner_ == std::this_thread::get_id()) return;
+    ++exclusive_waiters_;
     exclusive_cv_.wait(lock, [&] {
         return !exclusive_active_ || exclusive_owner_ == std::this_thread::get_id();
     });
+    --exclusive_waiters_;
+}
+
+int Router::exclusive_pressure() const {
+    return exclusive_waiters_.load();
+}
+
+Router::QueueWaitTicket::QueueWaitTicket(Router& router, const std::string& model)
+    : router_(router), model_(model) {
+    std::lock_guard<std::mutex> lock(router_.queue_state_mutex_);
+    ++router_.queue_waiting_[model_];
+}
+
+Router::QueueWaitTicket::~QueueWaitTicket() {
+    std::lock_guard<std::mutex> lock(router_.queue_state_mutex_);
+    auto it = router_.queue_waiting_.find(model_);
+    if (it != router_.queue_waiting_.end() && --it->second <= 0) {
+        router_.queue_waiting_.erase(it);
+    }
+}
+
+void Router::set_load_in_flight(const std::string& model, const std::string& recipe,
+                                WrappedServer* server) {
+    std::lock_guard<std::mutex> lock(queue_state_mutex_);
+    load_in_flight_model_ = model;
+    load_in_flight_recipe_ = recipe;
+    load_in_flight_started_ = std::chrono::steady_clock::now();
+    load_in_flight_server_ = server;
+}
+
+void Router::clear_load_in_flight(const WrappedServer* server) {
+    std::lock_guard<std::mutex> lock(queue_state_mutex_);
+    if (load_in_flight_server_ == server) {
+        load_in_flight_model_.clear();
+        load_in_flight_recipe_.clear();
+        load_in_flight_server_ = nullptr;
+    }
+}
+
+json Router::get_queue_snapshot() const {
+    json snapshot;
+    snapshot["waiting"] = json::object();
+
+    std::lock_guard<std::mutex> lock(queue_state_mutex_);
+    for (const auto& [model, count] : queue_waiting_) {
+        if (count > 0) {
+            snapshot["waiting"][model] = count;
+        }
+    }
+    snapshot["exclusive_transition_waiters"] = exclusive_waiters_.load();
+
+    if (load_in_flight_server_) {
+        const auto elapsed_ms = std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now() - load_in_flight_started_).count();
+        json load;
+        load["model"] = load_in_flight_model_;
+        load["recipe"] = load_in_flight_recipe_;
+        load["elapsed_ms"] = elapsed_ms;
+        load["phases_completed"] = load_in_flight_server_->get_load_profile();
+
+        long estimate_ms = 0;
+        {
+            std::lock_guard<std::mutex> budget(restart_budget_mutex_);
+            auto it = last_load_duration_ms_.find(load_in_flight_model_);
+            if (it != last_load_duration_ms_.end()) {
+                estimate_ms = it->second;
+            }
+        }
+        if (estimate_ms > 0) {
+            load["estimated_total_ms"] = estimate_ms;
+            load["estimated_ready_in_ms"] =
+                (std::max)(0L, estimate_ms - static_cast<long>(elapsed_ms));
+        }
+        snapshot["load_in_progress"] = std::move(load);
+    }
+    return snapshot;
+}
+
+json Router::get_queue_stats(const std::string& model_name) const {
+    std::lock_guard<std::mutex> lock(load_mutex_);
+    WrappedServer* server = find_server_by_model_name(resolve_model_name(model_name));
+    return server && server->is_backend_alive() ? server->get_queue_stats() : json();
+}
+
+json Router::snapshot_queue_stats() const {
+    std::lock_guard<std::mutex> lock(load_mutex_);
+    json stats = json::object();
+    for (const auto& server : loaded_servers_) {
+        if (!server->is_backend_alive()) {
+            continue;
+        }
+        json queue = server->get_queue_stats();
+        if (!queue.is_null()) {
+            stats[server->get_model_name()] = std::move(queue);
+        }
+    }
+    return stats;
 }
 
 std::map<std::string, bool> Router::snapshot_loaded_models() const {
@@ -596,15 +1261,24 @@ void Router::load_model(const std::string& model_name,
                             model_manager_->get_architecture_defaults(model_info.gguf.architecture));
     RecipeOptions effective_options = options.inherit(model_info.recipe_options.inherit(arch_opts.inherit(default_opt)));
 
-    // LOAD SERIALIZATION STRATEGY (from spec: point #2 in Additional Considerations)
+    // LOAD ADMISSION: loads run concurrently unless they share a model, a
+    // device, or a residency pool (capacity and eviction math assume those
+    // stay stable for the duration of a load). NPU loads always conflict
+    // with each other via the shared device bit, preserving invariant 2.
     std::unique_lock<std::mutex> lock(load_mutex_);
 
+    const InFlightLoad in_flight{canonical_model_name, model_info.type,
+                                 model_info.device, requested_residency_class};
+    const bool behind_exclusive =
+        exclusive_active_ && exclusive_owner_ != std::this_thread::get_id();
+    if (behind_exclusive) ++exclusive_waiters_;
     load_cv_.wait(lock, [&] {
-        return !is_loading_
+        return !load_conflicts_locked(in_flight)
                && (!exclusive_active_ || exclusive_owner_ == std::this_thread::get_id());
     });
+    if (behind_exclusive) --exclusive_waiters_;
 
-    is_loading_ = true;
+    loads_in_flight_.push_back(in_flight);
 
     LOG(DEBUG, "Router") << "Loading model: " << canonical_model_name
             << " (checkpoint: " << model_info.checkpoint()
@@ -643,6 +1317,13 @@ void Router::load_model(const std::string& model_name,
             json requested_opts = effective_options.to_json();
             existing_opts.erase("pinned");
             requested_opts.erase("pinned");
+            // An auto-placed device is not a user-visible option change: when
+            // the request does not pin a device, carry the current placement
+            // into the comparison so re-loads don't thrash between GPUs.
+            if (requested_opts.value("llamacpp_device", std::string()).empty() &&
+                !existing_opts.value("llamacpp_device", std::string()).empty()) {
+                requested_opts["llamacpp_device"] = existing_opts["llamacpp_device"];
+            }
             if (allow_reload_on_option_change && existing_opts != requested_opts) {
                 LOG(INFO, "Router") << "Options changed, reloading model: " << canonical_model_name << std::endl;
                 evict_server(existing);
@@ -656,7 +1337,7 @@ void Router::load_model(const std::string& model_name,
                 LOG(DEBUG, "Router") << "Model already loaded, updating access time and pinned status" << std::endl;
                 existing->set_pinned(final_pinned);
                 existing->update_access_time();
-                is_loading_ = false;
+                end_load_locked(canonical_model_name);
                 load_cv_.notify_all();
                 return;
             }
@@ -749,14 +1430,48 @@ void Router::load_model(const std::string& model_name,
         // routing helper therefore does not consume or evict a normal candidate
         // slot of the same ModelType. Cloud remains unmetered and outside both pools.
         const bool is_unmetered_load = is_unmetered_recipe(model_info.recipe);
-        if (!is_unmetered_load) {
+        const bool dedicated_slot_load =
+            reservation_has_dedicated_slot(effective_options.to_json());
+        if (!is_unmetered_load && !dedicated_slot_load) {
             ensure_residency_capacity(model_type, requested_residency_class,
                                       canonical_model_name);
         }
 
         // Auto-tune: resolve ctx_size = -1 → computed from memory + arch metadata
         // Done AFTER eviction so that freed VRAM/RAM is visible to the memory query.
-        int64_t auto_ctx = resolve_auto_ctx_size(effective_options, model_info);
+        // The KV budget is split across the planned resident set rather than
+        // letting every model tune as if it owned all free memory: unfilled
+        // slots in this model's own pool each keep a bounded reserve, and an
+        // LLM keeps one slot's worth of room for a first helper-pool model
+        // (embedding, reranking, audio — pools are per ModelType, so those
+        // coexist even at max_loaded_models=1). Resident peers need no
+        // reservation; their usage is already measured.
+        int future_slots = 0;
+        if (!is_unmetered_load) {
+            const int slot_limit = residency_limit(requested_residency_class,
+                                                   config_->max_loaded_models());
+            if (slot_limit > 0) {
+                const int pool_peers = count_servers_in_pool(
+                    model_type, requested_residency_class, canonical_model_name);
+                future_slots = (std::max)(0, slot_limit - pool_peers - 1);
+            }
+            if (model_type == ModelType::LLM) {
+                bool helper_resident = false;
+                for (const auto& server : loaded_servers_) {
+                    if (!server->is_backend_alive()) continue;
+                    if (server->get_model_name() == canonical_model_name) continue;
+                    if ((server->get_device_type() & device_type) == 0) continue;
+                    if (server->get_model_type() != ModelType::LLM) {
+                        helper_resident = true;
+                        break;
+                    }
+                }
+                if (!helper_resident) {
+                    ++future_slots;
+                }
+            }
+        }
+        int64_t auto_ctx = resolve_auto_ctx_size(effective_options, model_info, future_slots);
         if (auto_ctx > 0) {
             LOG(INFO, "Router") << "Auto-tune ctx_size resolved to " << auto_ctx << std::endl;
             effective_options.set_option("ctx_size", auto_ctx);
@@ -764,6 +1479,33 @@ void Router::load_model(const std::string& model_name,
 
         LOG(DEBUG, "Router") << "Effective settings: " << effective_options.to_log_string() << std::endl;
 
+        // A sharded checkpoint missing a shard is only discovered by the
+        // backend deep into startup; verify the set here so a doomed load
+        // fails before any peer is evicted for it. The set also drives the
+        // per-shard prewarm below.
+        const auto shard_set =
+            utils::resolve_gguf_shard_set(model_info.resolved_path());
+        if (shard_set.sharded && !shard_set.complete()) {
+            const size_t present = shard_set.paths.size() - shard_set.missing.size();
+            throw std::runtime_error(
+                "Model file not found: " + shard_set.missing[0] +
+                " (sharded checkpoint has " + std::to_string(present) + " of " +
+                std::to_string(shard_set.paths.size()) + " shards on disk)");
+        }
+
+        // Memory admission: evict LRU peers up front when the predicted
+        // footprint (weights + KV at the effective ctx_size) will not fit,
+        // instead of paying the fail-evict-retry cycle after the subprocess
+        // launches. Done after ctx_size resolution so the prediction is real.
+        if (!is_unmetered_load) {
+            ensure_memory_headroom_locked(model_info, effective_options,
+                                          canonical_model_name);
+        }
+
+        // Placement runs after eviction so freed VRAM counts toward the
+        // per-GPU occupancy comparison.
+        apply_gpu_placement_locked(model_info, backend, effective_options);
+
         // Create new backend server
         std::unique_ptr<WrappedServer> new_server = create_backend_server(model_info);
 
@@ -776,6 +1518,19 @@ void Router::load_model(const std::string& model_name,
         // CRITICAL: Release lock before slow backend startup
         lock.unlock();
 
+        // Pull the weights into the page cache while the backend spawns and
+        // initializes, so its mmap first-touch faults hit warm pages instead
+        // of random disk reads. One prewarmer per shard: llama-server opens
+        // shards serially, but the readahead streams can overlap on arrays
+        // that serve concurrent sequential reads well.
+        std::vector<std::unique_ptr<utils::FilePrewarmer>> weights_prewarmers;
+        weights_prewarmers.reserve(shard_set.paths.size());
+        for (const auto& shard_path : shard_set.paths) {
+            auto prewarmer = std::make_unique<utils::FilePrewarmer>();
+            prewarmer->start(shard_path);
+            weights_prewarmers.push_back(std::move(prewarmer));
+        }
+
         // Load the backend (this can take 30-60 seconds)
         LOG(DEBUG, "Router") << "Starting backend (this may take a moment)..." << std::endl;
         bool load_success = false;
@@ -783,20 +1538,41 @@ void Router::load_model(const std::string& model_name,
         auto load_start = std::chrono::steady_clock::now();
 
         new_server->set_load_cancel_flag(cancel_flag);
+        new_server->load_profile_begin();
+        set_load_in_flight(canonical_model_name, model_info.recipe, new_server.get());
 
         try {
             new_server->load(canonical_model_name, model_info, effective_options, do_not_upgrade);
             load_success = true;
             auto load_end = std::chrono::steady_clock::now();
             new_server->set_load_duration_ms(std::chrono::duration_cast<std::chrono::milliseconds>(load_end - load_start).count());
+            record_load_profile(new_server.get());
+            {
+                std::lock_guard<std::mutex> budget(restart_budget_mutex_);
+                last_load_duration_ms_[canonical_model_name] = new_server->get_load_duration_ms();
+            }
             LOG(DEBUG, "Router") << "Backend started successfully in " << new_server->get_load_duration_ms() << "ms" << std::endl;
+            RouterJournal::instance().record(
+                RouterEventKind::Load, canonical_model_name,
+                "recipe " + model_info.recipe + " loaded in " +
+                    std::to_string(new_server->get_load_duration_ms()) + "ms");
         } catch (const std::exception& e) {
             error_message = e.what();
             load_success = false;
             LOG(ERROR, "Router") << "Backend load failed: " << error_message << std::endl;
+            RouterJournal::instance().record(RouterEventKind::LoadFailed,
+                                             canonical_model_name, error_message);
         }
 
+        clear_load_in_flight(new_server.get());
         new_server->set_load_cancel_flag(nullptr);
+        for (auto& prewarmer : weights_prewarmers) {
+            prewarmer->stop();
+        }
+
+        if (load_success) {
+            run_warmup_if_enabled(new_server.get(), effective_options);
+        }
 
         lock.lock();
 
@@ -811,7 +1587,7 @@ void Router::load_model(const std::string& model_name,
             // Add to loaded servers
             loaded_servers_.push_back(std::move(new_server));
 
-            is_loading_ = false;
+            end_load_locked(canonical_model_name);
             load_cv_.notify_all();
 
             LOG(INFO, "Router") << "Model loaded successfully. Total loaded: "
@@ -823,9 +1599,6 @@ void Router::load_model(const std::string& model_name,
                                      error_message.find("does not exist") != std::string::npos ||
                                      error_message.find("No such file") != std::string::npos);
 
-            is_loading_ = false;
-            load_cv_.notify_all();
-
             if (cancel_flag && cancel_flag->load()) {
                 LOG(INFO, "Router") << "Load cancelled, skipping nuclear retry" << std::endl;
                 throw std::runtime_error("load cancelled");
@@ -836,14 +1609,22 @@ void Router::load_model(const std::string& model_name,
                 throw std::runtime_error(error_message);
             }
 
-            // Nuclear option: evict all models and retry
+            // Nuclear option: evict all models (reserved ones excepted) and retry
             LOG(WARNING, "Router") << "Load failed with non-file-not-found error, "
                       << "evicting all models and retrying..." << std::endl;
+            RouterJournal::instance().record(RouterEventKind::NuclearEvict,
+                                             canonical_model_name, error_message,
+                                             canonical_model_name);
+
+            // Snapshot the resident set first so it can be restored in the
+            // background after the retry succeeds. Not when this load IS a
+            // standby reload — that would loop the nuke.
+            std::vector<StandbyReloadEntry> standby_entries;
+            if (config_->nuclear_warm_standby() && !t_standby_reload_thread) {
+                standby_entries = snapshot_residents_for_standby_locked(canonical_model_name);
+            }
 
-            evict_all_servers();
-
-            // Mark loading again for retry
-            is_loading_ = true;
+            evict_all_servers(/*spare_reserved=*/true);
 
             // Create new server for retry
             std::unique_ptr<WrappedServer> retry_server = create_backend_server(model_info);
@@ -858,9 +1639,18 @@ void Router::load_model(const std::string& model_name,
             LOG(DEBUG, "Router") << "Retrying backend load..." << std::endl;
             try {
                 auto retry_start = std::chrono::steady_clock::now();
+                retry_server->load_profile_begin();
+                set_load_in_flight(canonical_model_name, model_info.recipe, retry_server.get());
                 retry_server->load(canonical_model_name, model_info, effective_options, do_not_upgrade);
+                clear_load_in_flight(retry_server.get());
                 auto retry_end = std::chrono::steady_clock::now();
                 retry_server->set_load_duration_ms(std::chrono::duration_cast<std::chrono::milliseconds>(retry_end - retry_start).count());
+                record_load_profile(retry_server.get());
+                {
+                    std::lock_guard<std::mutex> budget(restart_budget_mutex_);
+                    last_load_duration_ms_[canonical_model_name] = retry_server->get_load_duration_ms();
+                }
+                run_warmup_if_enabled(retry_server.get(), effective_options);
 
                 lock.lock();
 
@@ -868,16 +1658,23 @@ void Router::load_model(const std::string& model_name,
                 const auto retry_duration_ms = retry_server->get_load_duration_ms();
                 retry_server->set_load_cancel_flag(nullptr);
                 loaded_servers_.push_back(std::move(retry_server));
-                is_loading_ = false;
+                end_load_locked(canonical_model_name);
                 load_cv_.notify_all();
 
                 LOG(DEBUG, "Router") << "Retry successful in " << retry_duration_ms << "ms!" << std::endl;
+                RouterJournal::instance().record(
+                    RouterEventKind::Load, canonical_model_name,
+                    "recipe " + model_info.recipe + " loaded in " +
+                        std::to_string(retry_duration_ms) +
+                        "ms after nuclear retry");
+
+                if (!standby_entries.empty()) {
+                    start_standby_reload(std::move(standby_entries));
+                }
             } catch (const std::exception& retry_error) {
+                clear_load_in_flight(retry_server.get());
                 retry_server->set_load_cancel_flag(nullptr);
                 lock.lock();
-                is_loading_ = false;
-                load_cv_.notify_all();
-
                 LOG(ERROR, "Router") << "Retry also failed: " << retry_error.what() << std::endl;
                 throw;
             }
@@ -889,7 +1686,7 @@ void Router::load_model(const std::string& model_name,
         if (!lock.owns_lock()) {
             lock.lock();
         }
-        is_loading_ = false;
+        end_load_locked(canonical_model_name);
         load_cv_.notify_all();
 
         throw;
@@ -927,10 +1724,12 @@ void Router::evict_if_committed(const std::string& model_name) {
     // An exclusive session may have started (and re-pinned this model via the
     // job snapshot reconcile) since the EVICTING mark was set. Neither state
     // was known when the eviction was decided, so abandon it.
-    if (exclusive_active_ || server->is_pinned()) {
+    if (exclusive_active_ || server->is_pinned() || server->is_reserved()) {
         server->rescue_from_eviction();
         LOG(INFO, "Router") << "Eviction of " << model_name << " cancelled ("
-                            << (server->is_pinned() ? "pinned" : "exclusive session active")
+                            << (server->is_reserved() ? "reserved"
+                                : server->is_pinned() ? "pinned"
+                                                      : "exclusive session active")
                             << ")" << std::endl;
         return;
     }
@@ -1024,6 +1823,7 @@ json Router::get_all_loaded_models() const {
             model_info["watchdog_reset_reason"] = watchdog_reason;
         }
         model_info["pinned"] = server->is_pinned();
+        model_info["reserved"] = server->is_reserved();
         RecipeOptions recipe_options =  server->get_recipe_options();
         model_info["recipe"] = recipe_options.get_recipe();
         model_info["recipe_options"] = recipe_options.to_json();
@@ -1090,6 +1890,16 @@ bool Router::is_model_loaded(const std::string& model_name) const {
     return server != nullptr && server->is_backend_alive();
 }
 
+bool Router::is_recipe_loaded(const std::string& recipe) const {
+    std::lock_guard<std::mutex> lock(load_mutex_);
+    for (const auto& server : loaded_servers_) {
+        if (server && server->get_recipe_options().get_recipe() == recipe) {
+            return true;
+        }
+    }
+    return false;
+}
+
 RecipeOptions Router::get_model_recipe_options(const std::string& model_name) const {
     std::lock_guard<std::mutex> lock(load_mutex_);
     auto* server = find_server_by_model_name(resolve_model_name(model_name));
@@ -1125,12 +1935,12 @@ std::string Router::get_streaming_transcription_address(const std::string& model
     if (!server) {
         return "";
     }
-    auto* streaming = dynamic_cast<IStreamingTranscriptionServer*>(server);
+    auto* streaming = capability_cast<IStreamingTranscriptionServer>(server);
     return streaming ? streaming->get_streaming_address() : "";
 }
 
 template<typename Func>
-auto Router::execute_inference(const json& request, Func&& inference_func) -> decltype(inference_func(nullptr)) {
+auto Router::execute_inference(const json& request, Func&& inference_func, const char* endpoint) -> decltype(inference_func(nullptr)) {
     std::string requested_model;
     if (request.contains("model") && request["model"].is_string()) {
         requested_model = request["model"].get<std::string>();
@@ -1148,8 +1958,10 @@ auto Router::execute_inference(const json& request, Func&& inference_func) -> de
         RecipeOptions restart_options;
         std::string restart_model_name;
         bool should_reload_before_request = false;
+        const auto queue_enter = std::chrono::steady_clock::now();
 
         {
+            QueueWaitTicket queue_ticket(*this, resolve_model_name(requested_model));
             std::unique_lock<std::mutex> lock(load_mutex_);
             wait_for_slot_clearance(lock);
             server = find_server_by_model_name(resolve_model_name(requested_model));
@@ -1173,20 +1985,35 @@ auto Router::execute_inference(const json& request, Func&& inference_func) -> de
             if (restart_model_name.empty()) {
                 restart_model_name = requested_model;
             }
-            if (attempt == 0 && reload_model_after_watchdog_reset(restart_model_name, restart_options)) {
+            int retry_after = 0;
+            if (attempt == 0 &&
+                reload_model_after_watchdog_reset(restart_model_name, restart_options, &retry_after)) {
                 continue;
             }
+            if (retry_after <= 0) {
+                retry_after = estimate_reload_seconds(restart_model_name);
+            }
             return ErrorResponse::create(
                 "Backend for model '" + requested_model + "' is unavailable",
                 ErrorType::BACKEND_ERROR,
-                {{"code", "backend_unavailable"}, {"retryable", true}}
+                {{"code", "backend_unavailable"}, {"retryable", true},
+                 {"status_code", 503}, {"retry_after_seconds", retry_after}}
             );
         }
 
         InhibitGuard inhibit_guard(suspend_inhibitor_.get(), config_->inhibit_suspend());
 
+        const ModelTelemetryIdentity identity = get_telemetry_identity(server);
+        LatencyHistograms::instance().observe_queue_wait(
+            endpoint, identity.model_name, identity.recipe,
+            std::chrono::duration<double>(std::chrono::steady_clock::now() - queue_enter).count());
+
         try {
+            const auto backend_start = std::chrono::steady_clock::now();
             auto response = inference_func(server);
+            LatencyHistograms::instance().observe_backend_duration(
+                endpoint, identity.model_name, identity.recipe,
+                std::chrono::duration<double>(std::chrono::steady_clock::now() - backend_start).count());
             const bool watchdog_reset =
                 server->was_watchdog_triggered() || is_watchdog_reset_response(response);
 
@@ -1216,13 +2043,15 @@ auto Router::execute_inference(const json& request, Func&& inference_func) -> de
     return ErrorResponse::create(
         "Backend watchdog reset recovery failed for model '" + requested_model + "'",
         ErrorType::BACKEND_ERROR,
-        {{"code", "backend_watchdog_reset"}, {"retryable", true}}
+        {{"code", "backend_watchdog_reset"}, {"retryable", true},
+         {"status_code", 503},
+         {"retry_after_seconds", estimate_reload_seconds(requested_model)}}
     );
 }
 
 // Template method for streaming execution
 template<typename Func>
-void Router::execute_streaming(const std::string& request_body, httplib::DataSink& sink, Func&& streaming_func, std::shared_ptr<telemetry::InferenceSpan> span) {
+void Router::execute_streaming(const std::string& request_body, httplib::DataSink& sink, Func&& streaming_func, std::shared_ptr<telemetry::InferenceSpan> span, const char* endpoint) {
     WrappedServer* server = nullptr;
     std::string requested_model;
 
@@ -1238,7 +2067,8 @@ void Router::execute_streaming(const std::string& request_body, httplib::DataSin
     if (requested_model.empty()) {
         LOG(ERROR, "Router") << "No model specified in streaming request" << std::endl;
         json error = ErrorResponse::from_exception(InvalidRequestException("No model specified in request"));
-        std::string error_msg = "data: " + error.dump() + "\n\n";
+        std::string error_msg;
+        append_sse_data(error_msg, error);
         sink.write(error_msg.c_str(), error_msg.size());
         sink.done();
         return;
@@ -1248,14 +2078,17 @@ void Router::execute_streaming(const std::string& request_body, httplib::DataSin
         RecipeOptions restart_options;
         std::string restart_model_name;
         bool should_reload_before_request = false;
+        const auto queue_enter = std::chrono::steady_clock::now();
 
         {
+            QueueWaitTicket queue_ticket(*this, resolve_model_name(requested_model));
             std::unique_lock<std::mutex> lock(load_mutex_);
             wait_for_slot_clearance(lock);
             server = find_server_by_model_name(resolve_model_name(requested_model));
             if (!server) {
                 json error = ErrorResponse::from_exception(ModelNotLoadedException(requested_model));
-                std::string error_msg = "data: " + error.dump() + "\n\n";
+                std::string error_msg;
+                append_sse_data(error_msg, error);
                 sink.write(error_msg.c_str(), error_msg.size());
                 sink.done();
                 return;
@@ -1282,16 +2115,23 @@ void Router::execute_streaming(const std::string& request_body, httplib::DataSin
             if (restart_model_name.empty()) {
                 restart_model_name = requested_model;
             }
-            if (attempt == 0 && reload_model_after_watchdog_reset(restart_model_name, restart_options)) {
+            int retry_after = 0;
+            if (attempt == 0 &&
+                reload_model_after_watchdog_reset(restart_model_name, restart_options, &retry_after)) {
                 continue;
             }
+            if (retry_after <= 0) {
+                retry_after = estimate_reload_seconds(restart_model_name);
+            }
 
             json error = ErrorResponse::create(
                 "Backend for model '" + requested_model + "' is unavailable",
                 ErrorType::BACKEND_ERROR,
-                {{"code", "backend_unavailable"}, {"retryable", true}}
+                {{"code", "backend_unavailable"}, {"retryable", true},
+                 {"status_code", 503}, {"retry_after_seconds", retry_after}}
             );
-            std::string error_msg = "data: " + error.dump() + "\n\n";
+            std::string error_msg;
+            append_sse_data(error_msg, error);
             sink.write(error_msg.c_str(), error_msg.size());
             sink.done();
             return;
@@ -1299,8 +2139,17 @@ void Router::execute_streaming(const std::string& request_body, httplib::DataSin
 
         InhibitGuard inhibit_guard(suspend_inhibitor_.get(), config_->inhibit_suspend());
 
+        const ModelTelemetryIdentity identity = get_telemetry_identity(server);
+        LatencyHistograms::instance().observe_queue_wait(
+            endpoint, identity.model_name, identity.recipe,
+            std::chrono::duration<double>(std::chrono::steady_clock::now() - queue_enter).count());
+
         try {
+            const auto backend_start = std::chrono::steady_clock::now();
             streaming_func(server);
+            LatencyHistograms::instance().observe_backend_duration(
+                endpoint, identity.model_name, identity.recipe,
+                std::chrono::duration<double>(std::chrono::steady_clock::now() - backend_start).count());
             const bool watchdog_reset = server->was_watchdog_triggered();
 
             if (watchdog_reset) {
@@ -1311,13 +2160,15 @@ void Router::execute_streaming(const std::string& request_body, httplib::DataSin
             server->release_inference();
 
             // Do not replay a streaming response after bytes may have reached the
-            // client. Reload immediately so the next request does not see a
-            // stale tombstone, then return the stream outcome as-is.
+            // client. Reload in the background so the stream outcome is returned
+            // immediately and the next request does not see a stale tombstone.
             if (watchdog_reset) {
                 if (restart_model_name.empty()) {
                     restart_model_name = requested_model;
                 }
-                reload_model_after_watchdog_reset(restart_model_name, restart_options);
+                std::thread([this, restart_model_name, restart_options] {
+                    reload_model_after_watchdog_reset(restart_model_name, restart_options);
+                }).detach();
             }
             return;
         } catch (const BackendStreamRetryableReset& e) {
@@ -1328,9 +2179,14 @@ void Router::execute_streaming(const std::string& request_body, httplib::DataSin
             if (restart_model_name.empty()) {
                 restart_model_name = requested_model;
             }
-            if (attempt == 0 && reload_model_after_watchdog_reset(restart_model_name, restart_options)) {
+            int retry_after = 0;
+            if (attempt == 0 &&
+                reload_model_after_watchdog_reset(restart_model_name, restart_options, &retry_after)) {
                 continue;
             }
+            if (retry_after <= 0) {
+                retry_after = estimate_reload_seconds(restart_model_name);
+            }
 
             if (span) {
                 span->end_with_error(e.what());
@@ -1340,9 +2196,11 @@ void Router::execute_streaming(const std::string& request_body, httplib::DataSin
                 std::string("Backend for model '") + requested_model +
                     "' crashed before streaming started and could not be reloaded: " + e.what(),
                 ErrorType::BACKEND_ERROR,
-                {{"code", "backend_watchdog_reset"}, {"retryable", true}}
+                {{"code", "backend_watchdog_reset"}, {"retryable", true},
+                 {"status_code", 503}, {"retry_after_seconds", retry_after}}
             );
-            std::string error_msg = "data: " + error.dump() + "\n\n";
+            std::string error_msg;
+            append_sse_data(error_msg, error);
             sink.write(error_msg.c_str(), error_msg.size());
             sink.done();
             return;
@@ -1384,7 +2242,7 @@ json Router::chat_completion(const json& request, std::atomic<bool>* cancel) {
                 if (request.contains("max_completion_tokens")) span->set_attribute("llm.config.max_completion_tokens", request["max_completion_tokens"]);
             }
             return server->chat_completion(request);
-        });
+        }, "chat.completions");
 
         if (span) {
             if (response.contains("error")) {
@@ -1464,6 +2322,16 @@ json Router::chat_completion(const json& request, std::atomic<bool>* cancel) {
     }
 }
 
+json Router::chat_completion_coalesced(const json& request) {
+    return request_coalescer_.run("chat", request,
+                                  [&] { return chat_completion(request); });
+}
+
+json Router::completion_coalesced(const json& request) {
+    return request_coalescer_.run("completion", request,
+                                  [&] { return completion(request); });
+}
+
 json Router::completion(const json& request) {
     std::string requested_model = request.value("model", "");
     std::shared_ptr<telemetry::InferenceSpan> span = telemetry::TelemetryTracker::start_span("LLM", "completions", requested_model, request);
@@ -1483,7 +2351,7 @@ json Router::completion(const json& request) {
                 if (request.contains("max_tokens")) span->set_attribute("llm.config.max_tokens", request["max_tokens"]);
             }
             return server->completion(request);
-        });
+        }, "completions");
 
         if (span) {
             if (response.contains("error")) {
@@ -1545,14 +2413,14 @@ json Router::embeddings(const json& request) {
                 span->set_attribute("embedding.checkpoint", identity.checkpoint);
                 span->set_attribute("embedding.recipe", identity.recipe);
             }
-            auto embeddings_server = dynamic_cast<IEmbeddingsServer*>(server);
+            auto embeddings_server = capability_cast<IEmbeddingsServer>(server);
             if (!embeddings_server) {
                 return ErrorResponse::from_exception(
                     UnsupportedOperationException("Embeddings", device_type_to_string(server->get_device_type()))
                 );
             }
             return embeddings_server->embeddings(request);
-        });
+        }, "embeddings");
 
         if (span) {
             if (response.contains("error")) {
@@ -1601,14 +2469,14 @@ json Router::reranking(const json& request) {
                 span->set_attribute("reranker.checkpoint", identity.checkpoint);
                 span->set_attribute("reranker.recipe", identity.recipe);
             }
-            auto reranking_server = dynamic_cast<IRerankingServer*>(server);
+            auto reranking_server = capability_cast<IRerankingServer>(server);
             if (!reranking_server) {
                 return ErrorResponse::from_exception(
                     UnsupportedOperationException("Reranking", device_type_to_string(server->get_device_type()))
                 );
             }
             return reranking_server->reranking(request);
-        });
+        }, "reranking");
 
         if (span) {
             if (response.contains("error")) {
@@ -1651,14 +2519,14 @@ json Router::classify(const json& request) {
                 span->set_attribute("classifier.checkpoint", identity.checkpoint);
                 span->set_attribute("classifier.recipe", identity.recipe);
             }
-            auto classification_server = dynamic_cast<IClassificationServer*>(server);
+            auto classification_server = capability_cast<IClassificationServer>(server);
             if (!classification_server) {
                 return ErrorResponse::from_exception(
                     UnsupportedOperationException("Classification", device_type_to_string(server->get_device_type()))
                 );
             }
             return classification_server->classify(request);
-        });
+        }, "classify");
 
         if (span) {
             if (response.contains("error")) {
@@ -1694,7 +2562,7 @@ json Router::get_slots() {
         }
 
         // Check if server supports slots capability
-        slots_server = dynamic_cast<ISlotsServer*>(server);
+        slots_server = capability_cast<ISlotsServer>(server);
         if (!slots_server) {
             return ErrorResponse::from_exception(
                 UnsupportedOperationException("Slots", device_type_to_string(server->get_device_type()))
@@ -1734,7 +2602,7 @@ json Router::slots_action(int slot_id, const std::string& action, const json& re
         }
 
         // Check if server supports slots capability
-        slots_server = dynamic_cast<ISlotsServer*>(server);
+        slots_server = capability_cast<ISlotsServer>(server);
         if (!slots_server) {
             return ErrorResponse::from_exception(
                 UnsupportedOperationException("Slots", device_type_to_string(server->get_device_type()))
@@ -1759,6 +2627,84 @@ json Router::slots_action(int slot_id, const std::string& action, const json& re
     }
 }
 
+json Router::get_lora_adapters() {
+    WrappedServer* server = nullptr;
+    ILoraAdapterServer* lora_server = nullptr;
+
+    {
+        std::unique_lock<std::mutex> lock(load_mutex_);
+        wait_for_slot_clearance(lock);
+        server = get_most_recent_server();
+        if (!server) {
+            return ErrorResponse::from_exception(
+                ModelNotLoadedException("No models loaded")
+            );
+        }
+
+        lora_server = capability_cast<ILoraAdapterServer>(server);
+        if (!lora_server) {
+            return ErrorResponse::from_exception(
+                UnsupportedOperationException("LoRA adapters", device_type_to_string(server->get_device_type()))
+            );
+        }
+
+        // Mark as busy and update access time
+        if (!server->acquire_for_inference()) {
+            return ErrorResponse::from_exception(ModelNotLoadedException("No models loaded"));
+        }
+        server->update_access_time();
+    } // Lock released here
+
+    // Execute without holding lock (but busy flag prevents eviction)
+    try {
+        auto response = lora_server->get_lora_adapters();
+        server->release_inference();
+        return response;
+    } catch (...) {
+        server->release_inference();
+        throw;
+    }
+}
+
+json Router::set_lora_adapters(const json& adapters) {
+    WrappedServer* server = nullptr;
+    ILoraAdapterServer* lora_server = nullptr;
+
+    {
+        std::unique_lock<std::mutex> lock(load_mutex_);
+        wait_for_slot_clearance(lock);
+        server = get_most_recent_server();
+        if (!server) {
+            return ErrorResponse::from_exception(
+                ModelNotLoadedException("No models loaded")
+            );
+        }
+
+        lora_server = capability_cast<ILoraAdapterServer>(server);
+        if (!lora_server) {
+            return ErrorResponse::from_exception(
+                UnsupportedOperationException("LoRA adapters", device_type_to_string(server->get_device_type()))
+            );
+        }
+
+        // Mark as busy and update access time
+        if (!server->acquire_for_inference()) {
+            return ErrorResponse::from_exception(ModelNotLoadedException("No models loaded"));
+        }
+        server->update_access_time();
+    } // Lock released here
+
+    // Execute without holding lock (but busy flag prevents eviction)
+    try {
+        auto response = lora_server->set_lora_adapters(adapters);
+        server->release_inference();
+        return response;
+    } catch (...) {
+        server->release_inference();
+        throw;
+    }
+}
+
 json Router::tokenize(const json& request_body) {
     WrappedServer* server = nullptr;
     ITokenizerServer* tokenizer_server = nullptr;
@@ -1774,7 +2720,7 @@ json Router::tokenize(const json& request_body) {
         }
 
         // Check if server supports tokenize capability
-        tokenizer_server = dynamic_cast<ITokenizerServer*>(server);
+        tokenizer_server = capability_cast<ITokenizerServer>(server);
         if (!tokenizer_server) {
             return ErrorResponse::from_exception(
                 UnsupportedOperationException("Tokenization", device_type_to_string(server->get_device_type()))
@@ -1802,104 +2748,162 @@ json Router::tokenize(const json& request_body) {
 json Router::responses(const json& request) {
     return execute_inference(request, [&](WrappedServer* server) {
         return server->responses(request);
-    });
+    }, "responses");
 }
 
 json Router::audio_transcriptions(const json& request) {
     return execute_inference(request, [&](WrappedServer* server) {
-        auto transcription_server = dynamic_cast<ITranscriptionServer*>(server);
+        auto transcription_server = capability_cast<ITranscriptionServer>(server);
         if (!transcription_server) {
             return ErrorResponse::from_exception(
                 UnsupportedOperationException("Audio transcription", device_type_to_string(server->get_device_type()))
             );
         }
         return transcription_server->audio_transcriptions(request);
-    });
+    }, "audio.transcriptions");
 }
 
 void Router::audio_speech(const json& request, httplib::DataSink& sink) {
     execute_streaming(request.dump(), sink, [&](WrappedServer* server) {
-        auto tts_server = dynamic_cast<ITextToSpeechServer*>(server);
+        auto tts_server = capability_cast<ITextToSpeechServer>(server);
         if (!tts_server) {
             throw UnsupportedOperationException("Text to speech", device_type_to_string(server->get_device_type()));
         }
         tts_server->audio_speech(request, sink);
-    });
+    }, nullptr, "audio.speech");
 }
 
 std::vector<std::string> Router::audio_speech_supported_formats(const std::string& model_name) {
     std::lock_guard<std::mutex> lock(load_mutex_);
-    auto tts_server = dynamic_cast<ITextToSpeechServer*>(
+    auto tts_server = capability_cast<ITextToSpeechServer>(
         find_server_by_model_name(resolve_model_name(model_name)));
     return tts_server ? tts_server->supported_audio_formats() : std::vector<std::string>{};
 }
 
 json Router::image_generations(const json& request) {
     return execute_inference(request, [&](WrappedServer* server) {
-        auto image_server = dynamic_cast<IImageServer*>(server);
+        auto image_server = capability_cast<IImageServer>(server);
         if (!image_server) {
             return ErrorResponse::from_exception(
                 UnsupportedOperationException("Image generation", device_type_to_string(server->get_device_type()))
             );
         }
         return image_server->image_generations(request);
-    });
+    }, "images.generations");
 }
 
 json Router::image_edits(const json& request) {
     return execute_inference(request, [&](WrappedServer* server) {
-        auto image_server = dynamic_cast<IImageServer*>(server);
+        auto image_server = capability_cast<IImageServer>(server);
         if (!image_server) {
             return ErrorResponse::from_exception(
                 UnsupportedOperationException("Image editing", device_type_to_string(server->get_device_type()))
             );
         }
         return image_server->image_edits(request);
-    });
+    }, "images.edits");
 }
 
 json Router::image_variations(const json& request) {
     return execute_inference(request, [&](WrappedServer* server) {
-        auto image_server = dynamic_cast<IImageServer*>(server);
+        auto image_server = capability_cast<IImageServer>(server);
         if (!image_server) {
             return ErrorResponse::from_exception(
                 UnsupportedOperationException("Image variations", device_type_to_string(server->get_device_type()))
             );
         }
         return image_server->image_variations(request);
-    });
+    }, "images.variations");
 }
 
 void Router::audio_generations(const json& request, httplib::DataSink& sink) {
     execute_streaming(request.dump(), sink, [&](WrappedServer* server) {
-        auto audio_server = dynamic_cast<IAudioGenerationServer*>(server);
+        auto audio_server = capability_cast<IAudioGenerationServer>(server);
         if (!audio_server) {
             throw UnsupportedOperationException("Audio generation", device_type_to_string(server->get_device_type()));
         }
         audio_server->audio_generations(request, sink);
-    });
+    }, nullptr, "audio.generations");
 }
 
 std::vector<std::string> Router::audio_generation_supported_formats(const std::string& model_name) {
     std::lock_guard<std::mutex> lock(load_mutex_);
-    auto audio_server = dynamic_cast<IAudioGenerationServer*>(
+    auto audio_server = capability_cast<IAudioGenerationServer>(
         find_server_by_model_name(resolve_model_name(model_name)));
     return audio_server ? audio_server->supported_audio_formats() : std::vector<std::string>{};
 }
 
 void Router::model_3d_generations(const json& request, httplib::DataSink& sink) {
     execute_streaming(request.dump(), sink, [&](WrappedServer* server) {
-        auto model_server = dynamic_cast<IModel3DServer*>(server);
+        auto model_server = capability_cast<IModel3DServer>(server);
         if (!model_server) {
             throw UnsupportedOperationException("3D generation", device_type_to_string(server->get_device_type()));
         }
         model_server->model_3d_generations(request, sink);
-    });
+    }, nullptr, "3d.generations");
 }
 
 json Router::get_stats() const {
     std::lock_guard<std::mutex> lock(telemetry_mutex_);
-    return aggregate_telemetry_.to_json();
+    json stats = aggregate_telemetry_.to_json();
+    json load_profiles = json::object();
+    for (const auto& item : telemetry_by_model_) {
+        const auto& record = item.second;
+        if (!record.last_load_profile.empty()) {
+            load_profiles[model_manager_->get_public_model_name(record.identity.model_name)] =
+                record.last_load_profile;
+        }
+    }
+    if (!load_profiles.empty()) {
+        stats["load_profiles"] = load_profiles;
+    }
+
+    json windows = json::object();
+    for (auto& [window_name, models] : stats_windows_.to_json().items()) {
+        json mapped = json::object();
+        for (auto& [model_name, entry] : models.items()) {
+            mapped[model_manager_->get_public_model_name(model_name)] = std::move(entry);
+        }
+        windows[window_name] = std::move(mapped);
+    }
+    stats["windows"] = std::move(windows);
+    return stats;
+}
+
+void Router::record_load_profile(WrappedServer* server) {
+    json phases = server->get_load_profile();
+    if (phases.empty()) return;
+
+    json profile;
+    profile["phases"] = phases;
+    profile["total_ms"] = server->get_load_duration_ms();
+
+    double accounted_ms = 0.0;
+    std::ostringstream breakdown;
+    for (const auto& item : phases.items()) {
+        accounted_ms += item.value().get<double>();
+        breakdown << item.key() << "=" << std::fixed << std::setprecision(0)
+                  << item.value().get<double>() << "ms ";
+    }
+    // Backend-specific setup after the health poll (e.g. capability probes)
+    // lands in the remainder rather than a named phase.
+    const double other_ms = static_cast<double>(server->get_load_duration_ms()) - accounted_ms;
+    if (other_ms > 1.0) {
+        profile["phases"]["other"] = other_ms;
+        breakdown << "other=" << std::fixed << std::setprecision(0) << other_ms << "ms ";
+    }
+
+    ModelTelemetryIdentity identity = get_telemetry_identity(server);
+    {
+        std::lock_guard<std::mutex> lock(telemetry_mutex_);
+        auto& record = telemetry_by_model_[identity.key()];
+        record.identity = identity;
+        record.last_load_profile = profile;
+    }
+
+    LOG(INFO, "Router") << "Load profile for " << identity.model_name << " ("
+                        << identity.recipe << "): " << breakdown.str()
+                        << "total=" << server->get_load_duration_ms() << "ms" << std::endl;
 }
 
 json Router::get_metrics_snapshot() const {
@@ -1970,6 +2974,13 @@ json Router::get_metrics_snapshot() const {
         result["totals"]["prompt_tokens"] = aggregate_telemetry_.prompt_tokens_total;
     }
 
+    result["cloud_hedging"] = {
+        {"races", hedge_races_total_.load()},
+        {"cloud_wins", hedge_cloud_wins_total_.load()},
+        {"local_wins", hedge_local_wins_total_.load()},
+        {"failures", hedge_failures_total_.load()}
+    };
+
     return result;
 }
 
@@ -2021,6 +3032,23 @@ void Router::record_telemetry_for_model(const ModelTelemetryIdentity& identity,
         model_telemetry.output_tokens_total += static_cast<uint64_t>(output_tokens);
         aggregate_telemetry_.output_tokens_total += static_cast<uint64_t>(output_tokens);
     }
+
+    stats_windows_.record(identity.model_name, input_tokens, output_tokens,
+                          time_to_first_token);
+
+    if (stats_store_) {
+        stats_store_->record_request(to_store_identity(identity), input_tokens,
+                                     output_tokens);
+    }
+
+    if (time_to_first_token > 0.0) {
+        LatencyHistograms::instance().observe_time_to_first_token(
+            identity.model_name, identity.recipe, time_to_first_token);
+    }
+    if (tokens_per_second > 0.0) {
+        LatencyHistograms::instance().observe_tokens_per_second(
+            identity.model_name, identity.recipe, tokens_per_second);
+    }
 }
 
 void Router::record_prompt_tokens_for_model(const ModelTelemetryIdentity& identity, int prompt_tokens) {
@@ -2038,6 +3066,10 @@ void Router::record_prompt_tokens_for_model(const ModelTelemetryIdentity& identi
         model_telemetry.prompt_tokens_total += static_cast<uint64_t>(prompt_tokens);
         aggregate_telemetry_.prompt_tokens_total += static_cast<uint64_t>(prompt_tokens);
     }
+
+    if (stats_store_) {
+        stats_store_->record_prompt_tokens(to_store_identity(identity), prompt_tokens);
+    }
 }
 
 void Router::update_telemetry(const std::string& model_name,
@@ -2067,6 +3099,249 @@ void Router::update_prompt_tokens(const std::string& model_name, int prompt_toke
     record_prompt_tokens_for_model(identity, prompt_tokens);
 }
 
+namespace {
+
+// Arbitration for a hedged stream race. The first branch to deliver payload
+// claims the client sink; afterwards the loser's writes fail and its liveness
+// probe reports a dead client, so its transfer aborts like an ordinary client
+// disconnect. Error envelopes never claim — a branch that fails fast must not
+// beat one that can still produce tokens; the orchestrator reports the
+// terminal error itself when both branches fail.
+class HedgeGate {
+public:
+    enum class Branch { None, Cloud, Local };
+
+    explicit HedgeGate(httplib::DataSink& client) : client_(client) {}
+
+    bool write(Branch branch, const char* data, size_t length) {
+        std::unique_lock<std::mutex> lock(mutex_);
+        if (winner_ == Branch::None) {
+            if (looks_like_error(data, length)) {
+                branch_error(branch) = true;
+                cv_.notify_all();
+                // Swallow the envelope so the branch finishes cleanly.
+                return true;
+            }
+            winner_ = branch;
+            cv_.notify_all();
+        }
+        if (winner_ != branch) {
+            return false;
+        }
+        lock.unlock();
+        return client_.write ? client_.write(data, length) : false;
+    }
+
+    bool writable(Branch branch) {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (winner_ != Branch::None && winner_ != branch) {
+                return false;
+            }
+        }
+        return client_.is_writable ? client_.is_writable() : true;
+    }
+
+    void done(Branch branch) {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (winner_ != branch) {
+                return;
+            }
+        }
+        if (client_.done) {
+            client_.done();
+        }
+    }
+
+    // A branch that returns without ever claiming can no longer win.
+    void mark_finished(Branch branch) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (winner_ != branch) {
+            branch_error(branch) = true;
+            cv_.notify_all();
+        }
+    }
+
+    // True when `branch` claimed the sink within timeout_ms.
+    bool wait_for_claim(Branch branch, int timeout_ms) {
+        std::unique_lock<std::mutex> lock(mutex_);
+        cv_.wait_for(lock, std::chrono::milliseconds(timeout_ms), [&] {
+            return winner_ != Branch::None || branch_error(branch);
+        });
+        return winner_ == branch;
+    }
+
+    Branch winner() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return winner_;
+    }
+
+private:
+    static bool looks_like_error(const char* data, size_t length) {
+        std::string_view chunk(data, length);
+        const size_t start = chunk.find_first_not_of(" \t\r\n");
+        if (start == std::string_view::npos) {
+            return false;
+        }
+        chunk.remove_prefix(start);
+        return chunk.rfind("data: {\"error\"", 0) == 0 ||
+               chunk.rfind("{\"error\"", 0) == 0;
+    }
+
+    bool& branch_error(Branch branch) {
+        return branch == Branch::Cloud ? cloud_error_ : local_error_;
+    }
+
+    httplib::DataSink& client_;
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    Branch winner_ = Branch::None;
+    bool cloud_error_ = false;
+    bool local_error_ = false;
+};
+
+}  // namespace
+
+void Router::run_hedged_cloud_stream(WrappedServer* cloud_server,
+                                     const std::string& hedge_model,
+                                     int hedge_after_ms,
+                                     const std::string& endpoint,
+                                     const std::string& request_body,
+                                     httplib::DataSink& sink,
+                                     WrappedServer::TelemetryCallback telemetry_callback) {
+    hedge_races_total_++;
+    HedgeGate gate(sink);
+
+    auto make_branch_sink = [&gate](HedgeGate::Branch branch) {
+        httplib::DataSink branch_sink;
+        branch_sink.write = [&gate, branch](const char* data, size_t length) {
+            return gate.write(branch, data, length);
+        };
+        branch_sink.is_writable = [&gate, branch]() {
+            return gate.writable(branch);
+        };
+        branch_sink.done = [&gate, branch]() { gate.done(branch); };
+        branch_sink.done_with_trailer = [&gate, branch](const httplib::Headers&) {
+            gate.done(branch);
+        };
+        return branch_sink;
+    };
+
+    // Winner-only telemetry: the race must not double-count the request.
+    int cloud_in = 0, cloud_out = 0;
+    double cloud_ttft = 0.0, cloud_tps = 0.0;
+    std::string cloud_error;
+
+    httplib::DataSink cloud_sink = make_branch_sink(HedgeGate::Branch::Cloud);
+    std::thread cloud_thread([&] {
+        try {
+            cloud_server->forward_streaming_request(
+                endpoint, request_body, cloud_sink, true, 0,
+                [&](int input_tokens, int output_tokens, double time_to_first_token,
+                    double tokens_per_second, const std::string& error_message) {
+                    cloud_in = input_tokens;
+                    cloud_out = output_tokens;
+                    cloud_ttft = time_to_first_token;
+                    cloud_tps = tokens_per_second;
+                    cloud_error = error_message;
+                });
+        } catch (const std::exception& e) {
+            cloud_error = e.what();
+        }
+        gate.mark_finished(HedgeGate::Branch::Cloud);
+    });
+
+    int local_in = 0, local_out = 0;
+    double local_ttft = 0.0, local_tps = 0.0;
+    std::string local_error;
+
+    if (!gate.wait_for_claim(HedgeGate::Branch::Cloud, hedge_after_ms) &&
+        gate.winner() == HedgeGate::Branch::None) {
+        LOG(INFO, "Router") << "Cloud hedge armed for " << cloud_server->get_model_name()
+                << ": no provider token after " << hedge_after_ms
+                << "ms, racing local model " << hedge_model << std::endl;
+
+        WrappedServer* local = nullptr;
+        try {
+            auto info = model_manager_->get_model_info(hedge_model);
+            load_model(hedge_model, info, RecipeOptions());
+            std::lock_guard<std::mutex> lock(load_mutex_);
+            local = find_server_by_model_name(resolve_model_name(hedge_model));
+            if (local && local->is_backend_alive() && local->acquire_for_inference()) {
+                local->update_access_time();
+            } else {
+                local = nullptr;
+            }
+        } catch (const std::exception& e) {
+            LOG(WARNING, "Router") << "Cloud hedge could not start local model "
+                    << hedge_model << ": " << e.what() << std::endl;
+            local_error = e.what();
+        }
+
+        if (local) {
+            httplib::DataSink local_sink = make_branch_sink(HedgeGate::Branch::Local);
+            if (gate.winner() != HedgeGate::Branch::Cloud) {
+                try {
+                    local->forward_streaming_request(
+                        endpoint, request_body, local_sink, true, 0,
+                        [&](int input_tokens, int output_tokens,
+                            double time_to_first_token, double tokens_per_second,
+                            const std::string& error_message) {
+                            local_in = input_tokens;
+                            local_out = output_tokens;
+                            local_ttft = time_to_first_token;
+                            local_tps = tokens_per_second;
+                            local_error = error_message;
+                        });
+                } catch (const std::exception& e) {
+                    local_error = e.what();
+                }
+            }
+            local->release_inference();
+            gate.mark_finished(HedgeGate::Branch::Local);
+        }
+    }
+
+    cloud_thread.join();
+
+    switch (gate.winner()) {
+        case HedgeGate::Branch::Cloud:
+            hedge_cloud_wins_total_++;
+            if (telemetry_callback) {
+                telemetry_callback(cloud_in, cloud_out, cloud_ttft, cloud_tps, cloud_error);
+            }
+            break;
+        case HedgeGate::Branch::Local:
+            hedge_local_wins_total_++;
+            LOG(INFO, "Router") << "Cloud hedge won by local model " << hedge_model << std::endl;
+            if (telemetry_callback) {
+                telemetry_callback(local_in, local_out, local_ttft, local_tps, local_error);
+            }
+            break;
+        case HedgeGate::Branch::None: {
+            hedge_failures_total_++;
+            const std::string detail =
+                !cloud_error.empty() ? cloud_error : local_error;
+            json error = ErrorResponse::create(
+                "Hedged request failed on both the provider and the local model" +
+                    (detail.empty() ? "" : ": " + detail),
+                ErrorType::BACKEND_ERROR);
+            std::string error_msg;
+            append_sse_data(error_msg, error);
+            sink.write(error_msg.c_str(), error_msg.size());
+            if (sink.done) {
+                sink.done();
+            }
+            if (telemetry_callback) {
+                telemetry_callback(0, 0, 0.0, 0.0,
+                                   "Hedged request failed on both branches");
+            }
+            break;
+        }
+    }
+}
+
 void Router::chat_completion_stream(const std::string& request_body, httplib::DataSink& sink) {
     json request_json;
     try {
@@ -2155,7 +3430,7 @@ void Router::chat_completion_stream(const std::string& request_body, httplib::Da
                 if (request_json.contains("max_completion_tokens")) span->set_attribute("llm.config.max_completion_tokens", request_json["max_completion_tokens"]);
             }
 
-            server->forward_streaming_request("/v1/chat/completions", request_body, telemetry_sink, true, 0,
+            WrappedServer::TelemetryCallback telemetry_cb =
                 [this, identity, span, accumulated_text, accumulated_reasoning, server](int input_tokens,
                                  int output_tokens,
                                  double time_to_first_token,
@@ -2191,8 +3466,25 @@ void Router::chat_completion_stream(const std::string& request_body, httplib::Da
                         }
                         telemetry::end_llm_span_async(span, url, parser, usage_payload, final_output);
                     }
-                });
-        }, span);
+                };
+
+            if (identity.recipe == "cloud") {
+                RecipeOptions opts = server->get_recipe_options();
+                std::string hedge_model = opts.get_option("cloud_hedge_model").is_string()
+                    ? opts.get_option("cloud_hedge_model").get<std::string>() : "";
+                int hedge_after_ms = opts.get_option("cloud_hedge_after_ms").is_number_integer()
+                    ? opts.get_option("cloud_hedge_after_ms").get<int>() : 0;
+                if (!hedge_model.empty() && hedge_after_ms > 0) {
+                    run_hedged_cloud_stream(server, hedge_model, hedge_after_ms,
+                                            "/v1/chat/completions", request_body,
+                                            telemetry_sink, telemetry_cb);
+                    return;
+                }
+            }
+
+            server->forward_streaming_request("/v1/chat/completions", request_body,
+                                              telemetry_sink, true, 0, telemetry_cb);
+        }, span, "chat.completions");
     } catch (const std::exception& e) {
         if (span) span->end_with_error(e.what());
         throw;
@@ -2279,7 +3571,7 @@ void Router::completion_stream(const std::string& request_body, httplib::DataSin
                 if (request_json.contains("max_tokens")) span->set_attribute("llm.config.max_tokens", request_json["max_tokens"]);
             }
 
-            server->forward_streaming_request("/v1/completions", request_body, telemetry_sink, true, 0,
+            WrappedServer::TelemetryCallback telemetry_cb =
                 [this, identity, span, accumulated_text, server](int input_tokens,
                                  int output_tokens,
                                  double time_to_first_token,
@@ -2311,8 +3603,25 @@ void Router::completion_stream(const std::string& request_body, httplib::DataSin
                         }
                         telemetry::end_llm_span_async(span, url, parser, usage_payload, *accumulated_text);
                     }
-                });
-        }, span);
+                };
+
+            if (identity.recipe == "cloud") {
+                RecipeOptions opts = server->get_recipe_options();
+                std::string hedge_model = opts.get_option("cloud_hedge_model").is_string()
+                    ? opts.get_option("cloud_hedge_model").get<std::string>() : "";
+                int hedge_after_ms = opts.get_option("cloud_hedge_after_ms").is_number_integer()
+                    ? opts.get_option("cloud_hedge_after_ms").get<int>() : 0;
+                if (!hedge_model.empty() && hedge_after_ms > 0) {
+                    run_hedged_cloud_stream(server, hedge_model, hedge_after_ms,
+                                            "/v1/completions", request_body,
+                                            telemetry_sink, telemetry_cb);
+                    return;
+                }
+            }
+
+            server->forward_streaming_request("/v1/completions", request_body,
+                                              telemetry_sink, true, 0, telemetry_cb);
+        }, span, "completions");
     } catch (const std::exception& e) {
         if (span) span->end_with_error(e.what());
         throw;
@@ -2427,7 +3736,7 @@ void Router::responses_stream(const std::string& request_body, httplib::DataSink
                         telemetry::end_llm_span_async(span, url, parser, usage_payload, *accumulated_text);
                     }
                 });
-        }, span);
+        }, span, "responses");
     } catch (const std::exception& e) {
         if (span) span->end_with_error(e.what());
         throw;
@@ -2445,10 +3754,14 @@ int Router::count_pinned_servers_in_pool(
         if (is_unmetered_recipe(server->get_recipe_options().get_recipe())) {
             continue;
         }
+        // A reserved model in the shared pool occupies its slot as firmly as a
+        // pinned one, so the CLI's pre-emptive capacity warning must see it.
+        // With a dedicated slot it consumes no shared capacity at all.
         if (server->is_backend_alive() &&
             server->get_model_type() == type &&
             server->get_residency_class() == residency_class &&
-            server->is_pinned()) {
+            (server->is_pinned() ||
+             (server->is_reserved() && !server->has_dedicated_slot()))) {
             count++;
         }
     }
@@ -2488,6 +3801,10 @@ void Router::set_model_pinned(const std::string& model_name, bool pinned) {
     if (!server) {
         throw std::runtime_error("Model not loaded: " + model_name);
     }
+    if (!pinned && server->is_reserved()) {
+        throw InvalidRequestException("model '" + model_name +
+                                      "' is reserved in config; its residency cannot be unpinned at runtime");
+    }
     server->set_pinned(pinned);
 }
 
@@ -0,0 +1,191 @@
+#include "lemon/router_journal.h"
+
+#include "lemon/utils/aixlog.hpp"
+#include "lemon/utils/path_utils.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <system_error>
+
+namespace fs = std::filesystem;
+
+namespace lemon {
+
+namespace {
+
+constexpr auto kFlushInterval = std::chrono::seconds(2);
+// The persisted trail is an operational log, not a database; one rotation
+// generation keeps it bounded without losing the recent past.
+constexpr std::uintmax_t kMaxPersistBytes = 4ULL * 1024 * 1024;
+
+void copy_text(char (&dst)[RouterJournal::kTextBytes], const std::string& src) {
+    const size_t n = (std::min)(src.size(), sizeof(dst) - 1);
+    std::memcpy(dst, src.data(), n);
+    dst[n] = '\0';
+}
+
+std::int64_t now_ms() {
+    return std::chrono::duration_cast<std::chrono::milliseconds>(
+               std::chrono::system_clock::now().time_since_epoch())
+        .count();
+}
+
+} // namespace
+
+const char* router_event_kind_to_string(RouterEventKind kind) {
+    switch (kind) {
+        case RouterEventKind::Load: return "load";
+        case RouterEventKind::LoadFailed: return "load_failed";
+        case RouterEventKind::SlotEvict: return "slot_evict";
+        case RouterEventKind::MemoryEvict: return "memory_evict";
+        case RouterEventKind::NuclearEvict: return "nuclear_evict";
+    }
+    return "unknown";
+}
+
+RouterJournal& RouterJournal::instance() {
+    static RouterJournal journal;
+    return journal;
+}
+
+RouterJournal::RouterJournal() = default;
+
+RouterJournal::~RouterJournal() {
+    shutdown();
+}
+
+void RouterJournal::record(RouterEventKind kind,
+                           const std::string& model,
+                           const std::string& reason,
+                           const std::string& trigger,
+                           double vram_free_gb) {
+    const std::uint64_t seq = next_.fetch_add(1, std::memory_order_acq_rel);
+    Slot& slot = slots_[seq % kCapacity];
+
+    slot.stamp.store(0, std::memory_order_release);
+    Event& event = slot.event;
+    event.seq = seq;
+    event.timestamp_ms = now_ms();
+    event.kind = kind;
+    event.vram_free_gb = vram_free_gb;
+    copy_text(event.model, model);
+    copy_text(event.reason, reason);
+    copy_text(event.trigger, trigger);
+    slot.stamp.store(seq + 1, std::memory_order_release);
+}
+
+std::vector<RouterJournal::Event> RouterJournal::snapshot(std::int64_t since_ms,
+                                                          size_t limit) const {
+    const std::uint64_t end = next_.load(std::memory_order_acquire);
+    const std::uint64_t begin = end > kCapacity ? end - kCapacity : 0;
+
+    std::vector<Event> out;
+    out.reserve(static_cast<size_t>(end - begin));
+    for (std::uint64_t seq = begin; seq < end; ++seq) {
+        const Slot& slot = slots_[seq % kCapacity];
+        const std::uint64_t stamp = slot.stamp.load(std::memory_order_acquire);
+        if (stamp != seq + 1) {
+            continue;  // mid-write or already lapped
+        }
+        Event copy = slot.event;
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (slot.stamp.load(std::memory_order_relaxed) != stamp) {
+            continue;
+        }
+        if (copy.timestamp_ms < since_ms) {
+            continue;
+        }
+        out.push_back(copy);
+    }
+    if (limit > 0 && out.size() > limit) {
+        out.erase(out.begin(), out.end() - static_cast<std::ptrdiff_t>(limit));
+    }
+    return out;
+}
+
+nlohmann::json RouterJournal::to_json(const Event& event) {
+    nlohmann::json j;
+    j["seq"] = event.seq;
+    j["timestamp_ms"] = event.timestamp_ms;
+    j["kind"] = router_event_kind_to_string(event.kind);
+    j["model"] = std::string(event.model);
+    j["reason"] = std::string(event.reason);
+    if (event.trigger[0] != '\0') {
+        j["trigger"] = std::string(event.trigger);
+    }
+    j["vram_free_gb"] = (event.vram_free_gb >= 0.0)
+                            ? nlohmann::json(event.vram_free_gb)
+                            : nlohmann::json();
+    return j;
+}
+
+void RouterJournal::enable_persistence(const std::string& path) {
+    std::lock_guard<std::mutex> lock(persist_mutex_);
+    if (writer_thread_.joinable() || path.empty()) {
+        return;
+    }
+    persist_path_ = path;
+    stop_ = false;
+    writer_thread_ = std::thread(&RouterJournal::writer_loop, this);
+}
+
+void RouterJournal::shutdown() {
+    {
+        std::lock_guard<std::mutex> lock(persist_mutex_);
+        if (!writer_thread_.joinable()) {
+            return;
+        }
+        stop_ = true;
+    }
+    persist_cv_.notify_all();
+    writer_thread_.join();
+}
+
+void RouterJournal::writer_loop() {
+    std::unique_lock<std::mutex> lock(persist_mutex_);
+    while (!stop_) {
+        persist_cv_.wait_for(lock, kFlushInterval);
+        flush_locked();
+    }
+    flush_locked();
+}
+
+void RouterJournal::flush_locked() {
+    const auto events = snapshot();
+    std::uint64_t last_seq = persisted_seq_;
+    std::string lines;
+    for (const auto& event : events) {
+        if (event.seq < persisted_seq_) {
+            continue;
+        }
+        lines += to_json(event).dump();
+        lines += '\n';
+        last_seq = event.seq + 1;
+    }
+    if (lines.empty()) {
+        return;
+    }
+
+    const fs::path path = utils::path_from_utf8(persist_path_);
+    std::error_code ec;
+    const auto size = fs::file_size(path, ec);
+    if (!ec && size > kMaxPersistBytes) {
+        const fs::path rotated = utils::path_from_utf8(persist_path_ + ".1");
+        fs::remove(rotated, ec);
+        fs::rename(path, rotated, ec);
+    }
+
+    std::ofstream out(path, std::ios::app | std::ios::binary);
+    if (!out) {
+        LOG(WARNING, "RouterJournal")
+            << "Cannot persist events to " << persist_path_ << std::endl;
+        return;
+    }
+    out << lines;
+    persisted_seq_ = last_seq;
+}
+
+} // namespace lemon
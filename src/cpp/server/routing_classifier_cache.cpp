@@ -0,0 +1,88 @@
+#include "lemon/routing_classifier_cache.h"
+
+#include <utility>
+
+namespace lemon {
+namespace {
+
+constexpr uint64_t kFnvOffset = 14695981039346656037ULL;
+constexpr uint64_t kFnvPrime = 1099511628211ULL;
+
+uint64_t fnv1a_append(uint64_t hash, const std::string& data) {
+    for (unsigned char byte : data) {
+        hash ^= byte;
+        hash *= kFnvPrime;
+    }
+    return hash;
+}
+
+} // namespace
+
+ClassifierResultCache::ClassifierResultCache(size_t capacity)
+    : capacity_(capacity) {}
+
+uint64_t ClassifierResultCache::hash_features(const std::string& model,
+                                              const std::string& text) {
+    uint64_t hash = fnv1a_append(kFnvOffset, model);
+    hash ^= 0x1f;
+    hash *= kFnvPrime;
+    return fnv1a_append(hash, text);
+}
+
+bool ClassifierResultCache::lookup(const std::string& model,
+                                   const std::string& text,
+                                   std::map<std::string, double>& scores) {
+    const uint64_t hash = hash_features(model, text);
+    std::lock_guard<std::mutex> lock(mutex_);
+    const auto it = index_.find(hash);
+    if (it == index_.end() || it->second->model != model ||
+        it->second->text != text) {
+        ++misses_;
+        return false;
+    }
+    lru_.splice(lru_.begin(), lru_, it->second);
+    scores = it->second->scores;
+    ++hits_;
+    return true;
+}
+
+void ClassifierResultCache::store(const std::string& model,
+                                  const std::string& text,
+                                  std::map<std::string, double> scores) {
+    if (capacity_ == 0) {
+        return;
+    }
+    const uint64_t hash = hash_features(model, text);
+    std::lock_guard<std::mutex> lock(mutex_);
+    const auto it = index_.find(hash);
+    if (it != index_.end()) {
+        it->second->model = model;
+        it->second->text = text;
+        it->second->scores = std::move(scores);
+        lru_.splice(lru_.begin(), lru_, it->second);
+        return;
+    }
+    lru_.push_front(Entry{hash, model, text, std::move(scores)});
+    index_[hash] = lru_.begin();
+    if (lru_.size() > capacity_) {
+        index_.erase(lru_.back().hash);
+        lru_.pop_back();
+    }
+}
+
+ClassifierResultCache::Stats ClassifierResultCache::stats() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    Stats stats;
+    stats.hits = hits_;
+    stats.misses = misses_;
+    stats.entries = lru_.size();
+    stats.capacity = capacity_;
+    return stats;
+}
+
+ClassifierResultCache& ClassifierResultCache::instance() {
+    static ClassifierResultCache cache;
+    return cache;
+}
+
+} // namespace lemon
@@ -251,8 +251,10 @@ ClassifierServices make_classifier_services_from_router_calls(
     RouterJsonCall chat_completion,
     EnsureClassifierModelLoaded ensure_loaded,
     RouterJsonCall classify,
-    RouterModelTypeCall get_model_type) {
+    RouterModelTypeCall get_model_type,
+    RouterQueueStatsCall queue_stats) {
     ClassifierServices services;
+    services.queue_stats = std::move(queue_stats);
     auto embeddings_call = std::make_shared<RouterJsonCall>(std::move(embeddings));
     auto chat_completion_call =
         std::make_shared<RouterJsonCall>(std::move(chat_completion));
@@ -1,7 +1,9 @@
 #include "lemon/routing_classifier_services.h"
 
 #include "lemon/router.h"
+#include "lemon/routing_classifier_cache.h"
 
+#include <map>
 #include <utility>
 
 namespace lemon {
@@ -9,12 +11,30 @@ namespace lemon {
 ClassifierServices make_router_classifier_services(
     Router& router,
     EnsureClassifierModelLoaded ensure_loaded) {
-    return make_classifier_services_from_router_calls(
+    ClassifierServices services = make_classifier_services_from_router_calls(
         [&router](const json& request) { return router.embeddings(request); },
         [&router](const json& request) { return router.chat_completion(request); },
         std::move(ensure_loaded),
         [&router](const json& request) { return router.classify(request); },
-        [&router](const std::string& model) { return router.get_model_type(model); });
+        [&router](const std::string& model) { return router.get_model_type(model); },
+        [&router](const std::string& model) { return router.get_queue_stats(model); });
+
+    // Failures throw before store(), so only successful classifications are
+    // memoized.
+    auto run_classifier = std::move(services.run_classifier);
+    services.run_classifier =
+        [run_classifier](const std::string& model,
+                         const std::string& text) -> std::map<std::string, double> {
+        auto& cache = ClassifierResultCache::instance();
+        std::map<std::string, double> scores;
+        if (cache.lookup(model, text, scores)) {
+            return scores;
+        }
+        scores = run_classifier(model, text);
+        cache.store(model, text, scores);
+        return scores;
+    };
+    return services;
 }
 
 } // namespace lemon
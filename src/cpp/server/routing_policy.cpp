@@ -959,6 +959,53 @@ private:
     bool exists_expected_;
 };
 
+// queue — live backend-queue saturation for a named model, read through
+// ClassifierServices::queue_stats (the same injection seam the classifiers
+// use; the engine never touches the Router directly). Every authored bound
+// must hold (value >= bound). A model with no stats — not loaded, or a
+// backend that reports no queue — never matches, so spill rules fail open to
+// the primary.
+class QueueCondition final : public Condition {
+public:
+    QueueCondition(std::string model, std::optional<double> min_running,
+                   std::optional<double> min_waiting,
+                   std::optional<double> min_kv_cache_usage)
+        : model_(std::move(model)), min_running_(min_running),
+          min_waiting_(min_waiting), min_kv_cache_usage_(min_kv_cache_usage) {}
+
+    bool evaluate(EvalContext& ctx) const override {
+        bool result = false;
+        if (ctx.services.queue_stats) {
+            json stats;
+            try {
+                stats = ctx.services.queue_stats(model_);
+            } catch (...) {
+                stats = json();
+            }
+            if (stats.is_object()) {
+                result = meets(stats, "running", min_running_) &&
+                         meets(stats, "waiting", min_waiting_) &&
+                         meets(stats, "kv_cache_usage", min_kv_cache_usage_);
+            }
+        }
+        trace_leaf(ctx, "queue", result);
+        return result;
+    }
+
+private:
+    static bool meets(const json& stats, const char* key,
+                      const std::optional<double>& bound) {
+        if (!bound.has_value()) return true;
+        auto it = stats.find(key);
+        return it != stats.end() && it->is_number() && it->get<double>() >= *bound;
+    }
+
+    std::string model_;
+    std::optional<double> min_running_;
+    std::optional<double> min_waiting_;
+    std::optional<double> min_kv_cache_usage_;
+};
+
 // -- factory-side validation helpers ----------------------------------------
 
 ConditionPtr build_keywords(const json& arr, bool require_all, const char* op) {
@@ -1047,6 +1094,36 @@ ConditionPtr build_metadata(const json& spec) {
         std::set<std::string>{}, spec["exists"].get<bool>());
 }
 
+ConditionPtr build_queue(const json& spec) {
+    if (!spec.is_object()) {
+        throw std::invalid_argument("queue requires an object");
+    }
+    if (!spec.contains("model") || !spec["model"].is_string() ||
+        spec["model"].get<std::string>().empty()) {
+        throw std::invalid_argument("queue requires a non-empty string 'model'");
+    }
+
+    auto bound = [&spec](const char* key) -> std::optional<double> {
+        if (!spec.contains(key)) return std::nullopt;
+        if (!spec[key].is_number() || spec[key].get<double>() < 0.0) {
+            throw std::invalid_argument(std::string("queue '") + key +
+                                        "' must be a non-negative number");
+        }
+        return spec[key].get<double>();
+    };
+    auto min_running = bound("min_running");
+    auto min_waiting = bound("min_waiting");
+    auto min_kv_cache_usage = bound("min_kv_cache_usage");
+    if (!min_running && !min_waiting && !min_kv_cache_usage) {
+        throw std::invalid_argument(
+            "queue requires at least one bound: min_running, min_waiting, or "
+            "min_kv_cache_usage");
+    }
+    return std::make_shared<QueueCondition>(spec["model"].get<std::string>(),
+                                            min_running, min_waiting,
+                                            min_kv_cache_usage);
+}
+
 } // namespace
 
 ConditionPtr make_all_condition(std::vector<ConditionPtr> children) {
@@ -1280,6 +1357,9 @@ NamedLeafFactories make_deterministic_leaf_factories() {
     factories["metadata"] = [](const json& leaf) -> ConditionPtr {
         return build_metadata(leaf.at("metadata"));
     };
+    factories["queue"] = [](const json& leaf) -> ConditionPtr {
+        return build_queue(leaf.at("queue"));
+    };
 
     return factories;
 }
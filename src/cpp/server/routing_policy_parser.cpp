@@ -241,6 +241,27 @@ void validate_metadata_match(const json& spec, const std::string& path) {
     }
 }
 
+void validate_queue_match(const json& spec, const std::string& path) {
+    reject_unknown_keys(spec, routing_queue_match_keys(), path);
+    required_string(spec, "model", path);
+    std::size_t bounds = 0;
+    for (const char* key : {"min_running", "min_waiting", "min_kv_cache_usage"}) {
+        if (!spec.contains(key)) {
+            continue;
+        }
+        ++bounds;
+        if (!spec.at(key).is_number() || spec.at(key).get<double>() < 0.0) {
+            throw std::invalid_argument(path + "." + key +
+                                        " must be a non-negative number");
+        }
+    }
+    if (bounds == 0) {
+        throw std::invalid_argument(
+            path + " must contain at least one bound: min_running, min_waiting, "
+                   "or min_kv_cache_usage");
+    }
+}
+
 void validate_leaf(const json& leaf,
                    const std::map<std::string, ClassifierPtr>& classifiers,
                    const std::string& path) {
@@ -321,6 +342,10 @@ void validate_leaf(const json& leaf,
         ++condition_count;
         validate_metadata_match(leaf.at("metadata"), path + ".metadata");
     }
+    if (leaf.contains("queue")) {
+        ++condition_count;
+        validate_queue_match(leaf.at("queue"), path + ".queue");
+    }
 
     if (condition_count == 0) {
         throw std::invalid_argument(path + " must contain at least one leaf condition");
@@ -553,7 +578,7 @@ const std::set<std::string>& routing_match_expr_keys() {
     static const std::set<std::string> keys = {
         "any", "all", "not", "classifier", "label", "min_score", "max_score",
         "keywords_any", "keywords_all", "regex", "min_chars", "max_chars",
-        "has_tools", "has_images", "metadata"};
+        "has_tools", "has_images", "metadata", "queue"};
     return keys;
 }
 
@@ -562,6 +587,13 @@ const std::set<std::string>& routing_metadata_match_keys() {
     return keys;
 }
 
+const std::set<std::string>& routing_queue_match_keys() {
+    static const std::set<std::string> keys = {"model", "min_running",
+                                               "min_waiting",
+                                               "min_kv_cache_usage"};
+    return keys;
+}
+
 // Desugar the `routing.router` (L0a) sugar into the explicit core form: one
 // `llm` classifier whose labels are the candidates, plus one identity rule per
 // candidate (label X -> route_to X), evaluated first-match-wins. The engine
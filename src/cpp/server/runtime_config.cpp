@@ -1,5 +1,6 @@
 #include "lemon/runtime_config.h"
 #include "lemon/backends/backend_descriptor_registry.h"
+#include "lemon/download_scheduler.h"
 #include "lemon/system_info.h"
 #include "lemon/utils/aixlog.hpp"
 #include "lemon/utils/path_utils.h"
@@ -209,6 +210,15 @@ int RuntimeConfig::websocket_port() const {
     return val.get<int>();
 }
 
+int RuntimeConfig::http2_port() const {
+    std::shared_lock lock(mutex_);
+    const auto& val = config_["http2_port"];
+    if (val.is_string() && val.get<std::string>() == "auto") {
+        return 0;  // OS auto-assign
+    }
+    return val.get<int>();
+}
+
 std::string RuntimeConfig::log_level() const {
     std::shared_lock lock(mutex_);
     return config_["log_level"].get<std::string>();
@@ -260,6 +270,271 @@ bool RuntimeConfig::inhibit_suspend() const {
     return true;
 }
 
+int RuntimeConfig::http_worker_threads() const {
+    std::shared_lock lock(mutex_);
+    if (config_.contains("http_worker_threads")) {
+        return config_["http_worker_threads"].get<int>();
+    }
+    // 0 = size from the host CPU count (see setup_http_servers()).
+    return 0;
+}
+
+int RuntimeConfig::http_max_queued_requests() const {
+    std::shared_lock lock(mutex_);
+    if (config_.contains("http_max_queued_requests")) {
+        return config_["http_max_queued_requests"].get<int>();
+    }
+    return 128;
+}
+
+int RuntimeConfig::embeddings_batch_max_texts() const {
+    std::shared_lock lock(mutex_);
+    if (config_.contains("embeddings_batch_max_texts")) {
+        return config_["embeddings_batch_max_texts"].get<int>();
+    }
+    return 64;
+}
+
+int RuntimeConfig::embeddings_batch_window_ms() const {
+    std::shared_lock lock(mutex_);
+    if (config_.contains("embeddings_batch_window_ms")) {
+        return config_["embeddings_batch_window_ms"].get<int>();
+    }
+    // 0 disables coalescing; small windows trade a few ms of latency for one
+    // backend round trip per batch.
+    return 5;
+}
+
+int RuntimeConfig::rerank_chunk_docs() const {
+    std::shared_lock lock(mutex_);
+    if (config_.contains("rerank_chunk_docs")) {
+        return config_["rerank_chunk_docs"].get<int>();
+    }
+    // 0 disables chunking; requests at or below the chunk size are forwarded
+    // unchanged either way.
+    return 64;
+}
+
+int RuntimeConfig::rerank_parallel_chunks() const {
+    std::shared_lock lock(mutex_);
+    if (config_.contains("rerank_parallel_chunks")) {
+        return config_["rerank_parallel_chunks"].get<int>();
+    }
+    return 4;
+}
+
+int RuntimeConfig::rerank_score_cache_entries() const {
+    std::shared_lock lock(mutex_);
+    if (config_.contains("rerank_score_cache_entries")) {
+        return config_["rerank_score_cache_entries"].get<int>();
+    }
+    // 0 disables the cache; each entry holds one scored (query, document) pair.
+    return 4096;
+}
+
+bool RuntimeConfig::federation() const {
+    std::shared_lock lock(mutex_);
+    if (config_.contains("federation")) {
+        return config_["federation"].get<bool>();
+    }
+    return false;
+}
+
+bool RuntimeConfig::nuclear_warm_standby() const {
+    std::shared_lock lock(mutex_);
+    if (config_.contains("nuclear_warm_standby")) {
+        return config_["nuclear_warm_standby"].get<bool>();
+    }
+    return true;
+}
+
+int RuntimeConfig::preload_top_n() const {
+    std::shared_lock lock(mutex_);
+    if (config_.contains("preload_top_n")) {
+        return config_["preload_top_n"].get<int>();
+    }
+    // 0 disables predictive warming.
+    return 2;
+}
+
+int RuntimeConfig::download_parallel_connections() const {
+    std::shared_lock lock(mutex_);
+    if (config_.contains("download_parallel_connections")) {
+        return config_["download_parallel_connections"].get<int>();
+    }
+    return 4;
+}
+
+double RuntimeConfig::download_rate_limit_mbps() const {
+    std::shared_lock lock(mutex_);
+    if (config_.contains("download_rate_limit_mbps")) {
+        return config_["download_rate_limit_mbps"].get<double>();
+    }
+    return 0.0;
+}
+
+double RuntimeConfig::download_offhours_rate_limit_mbps() const {
+    std::shared_lock lock(mutex_);
+    if (config_.contains("download_offhours_rate_limit_mbps")) {
+        return config_["download_offhours_rate_limit_mbps"].get<double>();
+    }
+    return 0.0;
+}
+
+std::string RuntimeConfig::download_offhours() const {
+    std::shared_lock lock(mutex_);
+    if (config_.contains("download_offhours")) {
+        return config_["download_offhours"].get<std::string>();
+    }
+    return "";
+}
+
+bool RuntimeConfig::download_direct_io() const {
+    std::shared_lock lock(mutex_);
+    if (config_.contains("download_direct_io")) {
+        return config_["download_direct_io"].get<bool>();
+    }
+    // Off by default: bypassing the page cache helps when models are loaded
+    // during a pull but slows cold downloads on some filesystems.
+    return false;
+}
+
+std::vector<std::string> RuntimeConfig::download_mirrors() const {
+    std::shared_lock lock(mutex_);
+    std::vector<std::string> mirrors;
+    if (config_.contains("download_mirrors") && config_["download_mirrors"].is_array()) {
+        for (const auto& item : config_["download_mirrors"]) {
+            if (item.is_string() && !item.get<std::string>().empty()) {
+                std::string mirror = item.get<std::string>();
+                while (!mirror.empty() && mirror.back() == '/') mirror.pop_back();
+                mirrors.push_back(std::move(mirror));
+            }
+        }
+    }
+    return mirrors;
+}
+
+bool RuntimeConfig::differential_backend_upgrades() const {
+    std::shared_lock lock(mutex_);
+    if (config_.contains("differential_backend_upgrades")) {
+        return config_["differential_backend_upgrades"].get<bool>();
+    }
+    // Off by default: enabling it retains the last downloaded archive per
+    // backend (hundreds of MB each) as the patch base for the next upgrade.
+    return false;
+}
+
+bool RuntimeConfig::backend_upgrade_prefetch() const {
+    std::shared_lock lock(mutex_);
+    if (config_.contains("backend_upgrade_prefetch")) {
+        return config_["backend_upgrade_prefetch"].get<bool>();
+    }
+    // Off by default: prefetching downloads new backend pins in the
+    // background, which surprises metered connections.
+    return false;
+}
+
+double RuntimeConfig::model_store_quota_gb() const {
+    std::shared_lock lock(mutex_);
+    if (config_.contains("model_store_quota_gb")) {
+        return config_["model_store_quota_gb"].get<double>();
+    }
+    // 0 disables automatic store eviction.
+    return 0.0;
+}
+
+int RuntimeConfig::variant_cache_ttl_minutes() const {
+    std::shared_lock lock(mutex_);
+    if (config_.contains("variant_cache_ttl_minutes")) {
+        return config_["variant_cache_ttl_minutes"].get<int>();
+    }
+    // 0 disables variant caching and prefetch.
+    return 24 * 60;
+}
+
+double RuntimeConfig::quota_requests_per_second() const {
+    std::shared_lock lock(mutex_);
+    if (config_.contains("quota_requests_per_second")) {
+        return config_["quota_requests_per_second"].get<double>();
+    }
+    // 0 disables the per-key request rate limit.
+    return 0.0;
+}
+
+double RuntimeConfig::quota_tokens_per_minute() const {
+    std::shared_lock lock(mutex_);
+    if (config_.contains("quota_tokens_per_minute")) {
+        return config_["quota_tokens_per_minute"].get<double>();
+    }
+    // 0 disables the per-key inference token budget.
+    return 0.0;
+}
+
+int RuntimeConfig::quota_max_concurrent_streams() const {
+    std::shared_lock lock(mutex_);
+    if (config_.contains("quota_max_concurrent_streams")) {
+        return config_["quota_max_concurrent_streams"].get<int>();
+    }
+    // 0 disables the per-key concurrent stream cap.
+    return 0;
+}
+
+int RuntimeConfig::max_chat_sessions() const {
+    std::shared_lock lock(mutex_);
+    if (config_.contains("max_chat_sessions")) {
+        return config_["max_chat_sessions"].get<int>();
+    }
+    // LRU budget for server-stored /sessions conversations.
+    return 32;
+}
+
+std::string RuntimeConfig::metrics_push_url() const {
+    // Empty (the default) disables the Pushgateway exporter.
+    return get_string_opt(nullptr, {"metrics_push", "url"}, "");
+}
+
+int RuntimeConfig::metrics_push_interval_s() const {
+    return get_int_opt(nullptr, {"metrics_push", "interval_s"}, 15);
+}
+
+std::string RuntimeConfig::metrics_push_job() const {
+    return get_string_opt(nullptr, {"metrics_push", "job"}, "lemonade");
+}
+
+std::string RuntimeConfig::metrics_push_instance() const {
+    // Empty means "use the local hostname".
+    return get_string_opt(nullptr, {"metrics_push", "instance"}, "");
+}
+
+int RuntimeConfig::metrics_push_max_series() const {
+    // 0 means no cardinality cap.
+    return get_int_opt(nullptr, {"metrics_push", "max_series"}, 0);
+}
+
+int RuntimeConfig::metrics_push_spool_max_files() const {
+    return get_int_opt(nullptr, {"metrics_push", "spool_max_files"}, 64);
+}
+
+bool RuntimeConfig::completion_cache_enabled() const {
+    return get_bool_opt(nullptr, {"completion_cache", "enabled"}, false);
+}
+
+int RuntimeConfig::completion_cache_ttl_hours() const {
+    return get_int_opt(nullptr, {"completion_cache", "ttl_hours"}, 168);
+}
+
+int RuntimeConfig::completion_cache_max_mb() const {
+    return get_int_opt(nullptr, {"completion_cache", "max_mb"}, 64);
+}
+
+int RuntimeConfig::streaming_high_water_mark_kb() const {
+    std::shared_lock lock(mutex_);
+    if (config_.contains("streaming_high_water_mark_kb")) {
+        return config_["streaming_high_water_mark_kb"].get<int>();
+    }
+    return 1024;
+}
+
 double RuntimeConfig::auto_evict_threshold_pct() const {
     std::shared_lock lock(mutex_);
     if (config_.contains("auto_evict_threshold_pct")) {
@@ -527,6 +802,22 @@ void RuntimeConfig::validate(const std::string& key, const json& value) const {
             throw std::invalid_argument(
                 "'websocket_port' must be \"auto\" or an integer 0-65535");
         }
+    } else if (key == "http2_port") {
+        if (value.is_string()) {
+            if (value.get<std::string>() != "auto") {
+                throw std::invalid_argument(
+                    "'http2_port' must be \"auto\" or an integer 0-65535");
+            }
+        } else if (value.is_number_integer()) {
+            int p = value.get<int>();
+            if (p < 0 || p > 65535) {
+                throw std::invalid_argument(
+                    "'http2_port' must be between 0 and 65535");
+            }
+        } else {
+            throw std::invalid_argument(
+                "'http2_port' must be \"auto\" or an integer 0-65535");
+        }
     } else if (key == "log_level") {
         if (!value.is_string()) {
             throw std::invalid_argument("'log_level' must be a string");
@@ -579,6 +870,64 @@ void RuntimeConfig::validate(const std::string& key, const json& value) const {
         if (!value.is_boolean()) {
             throw std::invalid_argument("'inhibit_suspend' must be a boolean");
         }
+    } else if (key == "nuclear_warm_standby") {
+        if (!value.is_boolean()) {
+            throw std::invalid_argument("'nuclear_warm_standby' must be a boolean");
+        }
+    } else if (key == "federation") {
+        if (!value.is_boolean()) {
+            throw std::invalid_argument("'federation' must be a boolean");
+        }
+    } else if (key == "download_direct_io") {
+        if (!value.is_boolean()) {
+            throw std::invalid_argument("'download_direct_io' must be a boolean");
+        }
+    } else if (key == "download_mirrors") {
+        if (!value.is_array()) {
+            throw std::invalid_argument("'download_mirrors' must be an array of base URLs");
+        }
+        for (const auto& item : value) {
+            if (!item.is_string()) {
+                throw std::invalid_argument("'download_mirrors' entries must be strings");
+            }
+        }
+    } else if (key == "differential_backend_upgrades" ||
+               key == "backend_upgrade_prefetch") {
+        if (!value.is_boolean()) {
+            throw std::invalid_argument("'" + key + "' must be a boolean");
+        }
+    } else if (key == "http_worker_threads" || key == "http_max_queued_requests" ||
+               key == "embeddings_batch_max_texts" || key == "embeddings_batch_window_ms" ||
+               key == "rerank_chunk_docs" || key == "rerank_parallel_chunks" ||
+               key == "rerank_score_cache_entries" ||
+               key == "streaming_high_water_mark_kb" || key == "preload_top_n" ||
+               key == "download_parallel_connections" || key == "variant_cache_ttl_minutes" ||
+               key == "quota_max_concurrent_streams" || key == "max_chat_sessions") {
+        if (!value.is_number_integer()) {
+            throw std::invalid_argument("'" + key + "' must be an integer");
+        }
+        if (value.get<int>() < 0) {
+            throw std::invalid_argument("'" + key + "' must be >= 0");
+        }
+    } else if (key == "download_offhours") {
+        if (!value.is_string()) {
+            throw std::invalid_argument("'download_offhours' must be a string");
+        }
+        int start = 0, end = 0;
+        if (!value.get<std::string>().empty() &&
+            !DownloadScheduler::parse_window(value.get<std::string>(), start, end)) {
+            throw std::invalid_argument(
+                "'download_offhours' must be \"HH:MM-HH:MM\" or empty");
+        }
+    } else if (key == "quota_requests_per_second" || key == "quota_tokens_per_minute" ||
+               key == "model_store_quota_gb" || key == "download_rate_limit_mbps" ||
+               key == "download_offhours_rate_limit_mbps") {
+        if (!value.is_number()) {
+            throw std::invalid_argument("'" + key + "' must be a number");
+        }
+        if (value.get<double>() < 0.0) {
+            throw std::invalid_argument("'" + key + "' must be >= 0");
+        }
     } else if (key == "auto_evict_threshold_pct") {
         if (!value.is_number()) {
             throw std::invalid_argument("'auto_evict_threshold_pct' must be a number");
@@ -723,6 +1072,88 @@ void RuntimeConfig::validate(const std::string& key, const json& value) const {
                 }
             }
         }
+    } else if (key == "metrics_push") {
+        if (!value.is_object()) {
+            throw std::invalid_argument("'metrics_push' must be an object");
+        }
+        static const std::unordered_set<std::string> valid_push_keys = {
+            "url", "interval_s", "job", "instance", "max_series", "spool_max_files"
+        };
+        for (auto& [p_key, p_val] : value.items()) {
+            if (valid_push_keys.find(p_key) == valid_push_keys.end()) {
+                throw std::invalid_argument("Unknown config key: 'metrics_push." + p_key + "'");
+            }
+        }
+        if (value.contains("url")) {
+            if (!value["url"].is_string()) {
+                throw std::invalid_argument("'metrics_push.url' must be a string");
+            }
+            std::string url = value["url"].get<std::string>();
+            if (!url.empty() && url.rfind("http://", 0) != 0 && url.rfind("https://", 0) != 0) {
+                throw std::invalid_argument("'metrics_push.url' must start with http:// or https://");
+            }
+        }
+        if (value.contains("job") && !value["job"].is_string()) {
+            throw std::invalid_argument("'metrics_push.job' must be a string");
+        }
+        if (value.contains("instance") && !value["instance"].is_string()) {
+            throw std::invalid_argument("'metrics_push.instance' must be a string");
+        }
+        if (value.contains("interval_s")) {
+            if (!value["interval_s"].is_number_integer()) {
+                throw std::invalid_argument("'metrics_push.interval_s' must be an integer");
+            }
+            if (value["interval_s"].get<int>() < 1) {
+                throw std::invalid_argument("'metrics_push.interval_s' must be >= 1");
+            }
+        }
+        if (value.contains("max_series")) {
+            if (!value["max_series"].is_number_integer()) {
+                throw std::invalid_argument("'metrics_push.max_series' must be an integer");
+            }
+            if (value["max_series"].get<int>() < 0) {
+                throw std::invalid_argument("'metrics_push.max_series' must be >= 0");
+            }
+        }
+        if (value.contains("spool_max_files")) {
+            if (!value["spool_max_files"].is_number_integer()) {
+                throw std::invalid_argument("'metrics_push.spool_max_files' must be an integer");
+            }
+            if (value["spool_max_files"].get<int>() < 0) {
+                throw std::invalid_argument("'metrics_push.spool_max_files' must be >= 0");
+            }
+        }
+    } else if (key == "completion_cache") {
+        if (!value.is_object()) {
+            throw std::invalid_argument("'completion_cache' must be an object");
+        }
+        static const std::unordered_set<std::string> valid_cache_keys = {
+            "enabled", "ttl_hours", "max_mb"
+        };
+        for (auto& [c_key, c_val] : value.items()) {
+            if (valid_cache_keys.find(c_key) == valid_cache_keys.end()) {
+                throw std::invalid_argument("Unknown config key: 'completion_cache." + c_key + "'");
+            }
+        }
+        if (value.contains("enabled") && !value["enabled"].is_boolean()) {
+            throw std::invalid_argument("'completion_cache.enabled' must be a boolean");
+        }
+        if (value.contains("ttl_hours")) {
+            if (!value["ttl_hours"].is_number_integer()) {
+                throw std::invalid_argument("'completion_cache.ttl_hours' must be an integer");
+            }
+            if (value["ttl_hours"].get<int>() < 0) {
+                throw std::invalid_argument("'completion_cache.ttl_hours' must be >= 0");
+            }
+        }
+        if (value.contains("max_mb")) {
+            if (!value["max_mb"].is_number_integer()) {
+                throw std::invalid_argument("'completion_cache.max_mb' must be an integer");
+            }
+            if (value["max_mb"].get<int>() < 1) {
+                throw std::invalid_argument("'completion_cache.max_mb' must be >= 1");
+            }
+        }
     } else if (is_backend_name(key)) {
         if (!value.is_object()) {
             throw std::invalid_argument("'" + key + "' must be an object");
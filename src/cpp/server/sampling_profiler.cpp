@@ -0,0 +1,369 @@
+#include "lemon/sampling_profiler.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <map>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#ifndef _WIN32
+    #include <csignal>
+    #include <cxxabi.h>
+    #include <dlfcn.h>
+    #include <execinfo.h>
+    #include <sys/time.h>
+#endif
+
+namespace lemon {
+
+#ifndef _WIN32
+
+namespace {
+
+class ProtoWriter {
+public:
+    std::string buf;
+
+    void write_varint(uint64_t val) {
+        while (val >= 0x80) {
+            buf.push_back(static_cast<char>((val & 0x7F) | 0x80));
+            val >>= 7;
+        }
+        buf.push_back(static_cast<char>(val & 0x7F));
+    }
+
+    void write_key(uint32_t field_num, uint32_t wire_type) {
+        write_varint((field_num << 3) | wire_type);
+    }
+
+    void write_int64(uint32_t field_num, int64_t val) {
+        write_key(field_num, 0);
+        write_varint(static_cast<uint64_t>(val));
+    }
+
+    void write_uint64(uint32_t field_num, uint64_t val) {
+        write_key(field_num, 0);
+        write_varint(val);
+    }
+
+    void write_string(uint32_t field_num, const std::string& val) {
+        write_key(field_num, 2);
+        write_varint(val.size());
+        buf.append(val);
+    }
+
+    void write_message(uint32_t field_num, const ProtoWriter& sub) {
+        write_key(field_num, 2);
+        write_varint(sub.buf.size());
+        buf.append(sub.buf);
+    }
+};
+
+constexpr int kMaxFrames = 64;
+constexpr int kMaxSeconds = 120;
+constexpr int kMaxHz = 1000;
+constexpr size_t kMaxSamples = 65536;
+
+struct RawSample {
+    std::atomic<bool> ready{false};
+    int depth = 0;
+    void* frames[kMaxFrames];
+};
+
+RawSample* g_samples = nullptr;
+size_t g_capacity = 0;
+std::atomic<size_t> g_next{0};
+std::atomic<size_t> g_dropped{0};
+
+void sigprof_handler(int) {
+    size_t idx = g_next.fetch_add(1, std::memory_order_relaxed);
+    if (idx >= g_capacity) {
+        g_dropped.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    RawSample& sample = g_samples[idx];
+    sample.depth = backtrace(sample.frames, kMaxFrames);
+    sample.ready.store(true, std::memory_order_release);
+}
+
+std::string demangle(const char* name) {
+    int status = 0;
+    char* demangled = abi::__cxa_demangle(name, nullptr, nullptr, &status);
+    if (status == 0 && demangled) {
+        std::string result(demangled);
+        free(demangled);
+        return result;
+    }
+    free(demangled);
+    return name;
+}
+
+struct FrameInfo {
+    std::string function;
+    std::string module;
+    uint64_t module_base = 0;
+};
+
+FrameInfo symbolize(uintptr_t address) {
+    FrameInfo info;
+    Dl_info dl;
+    if (dladdr(reinterpret_cast<void*>(address), &dl)) {
+        if (dl.dli_sname) {
+            info.function = demangle(dl.dli_sname);
+        }
+        if (dl.dli_fname) {
+            info.module = dl.dli_fname;
+        }
+        info.module_base = reinterpret_cast<uint64_t>(dl.dli_fbase);
+    }
+    return info;
+}
+
+std::string build_pprof(const std::map<std::vector<uintptr_t>, int64_t>& stacks,
+                        int hz, int64_t duration_nanos) {
+    const int64_t period_nanos = 1000000000LL / hz;
+
+    std::vector<std::string> strings = {""};
+    std::map<std::string, int64_t> string_ids = {{"", 0}};
+    auto intern = [&](const std::string& s) -> int64_t {
+        auto it = string_ids.find(s);
+        if (it != string_ids.end()) return it->second;
+        int64_t id = static_cast<int64_t>(strings.size());
+        strings.push_back(s);
+        string_ids.emplace(s, id);
+        return id;
+    };
+
+    ProtoWriter profile;
+
+    {
+        ProtoWriter samples_type;
+        samples_type.write_int64(1, intern("samples"));
+        samples_type.write_int64(2, intern("count"));
+        profile.write_message(1, samples_type);
+
+        ProtoWriter cpu_type;
+        cpu_type.write_int64(1, intern("cpu"));
+        cpu_type.write_int64(2, intern("nanoseconds"));
+        profile.write_message(1, cpu_type);
+    }
+
+    std::map<uintptr_t, uint64_t> location_ids;
+    std::map<std::string, uint64_t> function_ids;
+    std::map<std::string, uint64_t> mapping_ids;
+    ProtoWriter locations;
+    ProtoWriter functions;
+    ProtoWriter mappings;
+
+    auto location_for = [&](uintptr_t address) -> uint64_t {
+        auto it = location_ids.find(address);
+        if (it != location_ids.end()) return it->second;
+        uint64_t id = location_ids.size() + 1;
+        location_ids.emplace(address, id);
+
+        FrameInfo info = symbolize(address);
+
+        uint64_t mapping_id = 0;
+        if (!info.module.empty()) {
+            auto mit = mapping_ids.find(info.module);
+            if (mit != mapping_ids.end()) {
+                mapping_id = mit->second;
+            } else {
+                mapping_id = mapping_ids.size() + 1;
+                mapping_ids.emplace(info.module, mapping_id);
+                ProtoWriter mapping;
+                mapping.write_uint64(1, mapping_id);
+                mapping.write_uint64(2, info.module_base);
+                mapping.write_int64(5, intern(info.module));
+                mappings.write_message(3, mapping);
+            }
+        }
+
+        ProtoWriter location;
+        location.write_uint64(1, id);
+        if (mapping_id != 0) {
+            location.write_uint64(2, mapping_id);
+        }
+        location.write_uint64(3, static_cast<uint64_t>(address));
+
+        if (!info.function.empty()) {
+            uint64_t function_id = 0;
+            auto fit = function_ids.find(info.function);
+            if (fit != function_ids.end()) {
+                function_id = fit->second;
+            } else {
+                function_id = function_ids.size() + 1;
+                function_ids.emplace(info.function, function_id);
+                ProtoWriter function;
+                function.write_uint64(1, function_id);
+                function.write_int64(2, intern(info.function));
+                function.write_int64(3, intern(info.function));
+                if (!info.module.empty()) {
+                    function.write_int64(4, intern(info.module));
+                }
+                functions.write_message(5, function);
+            }
+            ProtoWriter line;
+            line.write_uint64(1, function_id);
+            location.write_message(4, line);
+        }
+
+        locations.write_message(4, location);
+        return id;
+    };
+
+    for (const auto& [stack, count] : stacks) {
+        ProtoWriter sample;
+        for (uintptr_t address : stack) {
+            sample.write_uint64(1, location_for(address));
+        }
+        sample.write_int64(2, count);
+        sample.write_int64(2, count * period_nanos);
+        profile.write_message(2, sample);
+    }
+
+    profile.buf.append(mappings.buf);
+    profile.buf.append(locations.buf);
+    profile.buf.append(functions.buf);
+
+    for (const std::string& s : strings) {
+        profile.write_string(6, s);
+    }
+
+    auto now_nanos = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+    profile.write_int64(9, now_nanos - duration_nanos);
+    profile.write_int64(10, duration_nanos);
+
+    {
+        ProtoWriter period_type;
+        period_type.write_int64(1, intern("cpu"));
+        period_type.write_int64(2, intern("nanoseconds"));
+        profile.write_message(11, period_type);
+    }
+    profile.write_int64(12, period_nanos);
+
+    return std::move(profile.buf);
+}
+
+} // namespace
+
+SamplingProfiler::Result SamplingProfiler::collect(int seconds, int hz) {
+    Result result;
+    if (seconds < 1 || seconds > kMaxSeconds) {
+        result.error = Error::BadRequest;
+        result.message = "seconds must be between 1 and " + std::to_string(kMaxSeconds);
+        return result;
+    }
+    if (hz < 1 || hz > kMaxHz) {
+        result.error = Error::BadRequest;
+        result.message = "hz must be between 1 and " + std::to_string(kMaxHz);
+        return result;
+    }
+
+    static std::atomic<bool> busy{false};
+    bool expected = false;
+    if (!busy.compare_exchange_strong(expected, true)) {
+        result.error = Error::Busy;
+        result.message = "a profile collection is already in progress";
+        return result;
+    }
+
+    size_t capacity = static_cast<size_t>(seconds) * static_cast<size_t>(hz) * 2;
+    if (capacity > kMaxSamples) capacity = kMaxSamples;
+    auto samples = std::make_unique<RawSample[]>(capacity);
+    g_samples = samples.get();
+    g_capacity = capacity;
+    g_next.store(0);
+    g_dropped.store(0);
+
+    // backtrace() lazily loads libgcc on first use, which is not
+    // async-signal-safe; force that load before the handler can run.
+    {
+        void* warmup[2];
+        backtrace(warmup, 2);
+    }
+
+    struct sigaction action;
+    std::memset(&action, 0, sizeof(action));
+    action.sa_handler = sigprof_handler;
+    action.sa_flags = SA_RESTART;
+    sigemptyset(&action.sa_mask);
+    struct sigaction previous_action;
+    if (sigaction(SIGPROF, &action, &previous_action) != 0) {
+        busy.store(false);
+        result.error = Error::Internal;
+        result.message = "failed to install SIGPROF handler";
+        return result;
+    }
+
+    struct itimerval timer;
+    timer.it_interval.tv_sec = 0;
+    timer.it_interval.tv_usec = static_cast<suseconds_t>(1000000 / hz);
+    timer.it_value = timer.it_interval;
+    struct itimerval previous_timer;
+    if (setitimer(ITIMER_PROF, &timer, &previous_timer) != 0) {
+        sigaction(SIGPROF, &previous_action, nullptr);
+        busy.store(false);
+        result.error = Error::Internal;
+        result.message = "failed to arm profiling timer";
+        return result;
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    std::this_thread::sleep_for(std::chrono::seconds(seconds));
+
+    struct itimerval disarm;
+    std::memset(&disarm, 0, sizeof(disarm));
+    setitimer(ITIMER_PROF, &disarm, nullptr);
+    sigaction(SIGPROF, &previous_action, nullptr);
+    setitimer(ITIMER_PROF, &previous_timer, nullptr);
+    // Let any handler that fired just before disarm finish writing its slot.
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+
+    auto duration_nanos = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - start).count();
+
+    std::map<std::vector<uintptr_t>, int64_t> stacks;
+    size_t taken = g_next.load();
+    if (taken > capacity) taken = capacity;
+    for (size_t i = 0; i < taken; ++i) {
+        RawSample& sample = samples[i];
+        if (!sample.ready.load(std::memory_order_acquire)) continue;
+        // Frame 0 is the handler and frame 1 the signal trampoline; the
+        // interrupted code starts below them.
+        constexpr int kSkipFrames = 2;
+        if (sample.depth <= kSkipFrames) continue;
+        std::vector<uintptr_t> stack;
+        stack.reserve(sample.depth - kSkipFrames);
+        for (int f = kSkipFrames; f < sample.depth; ++f) {
+            stack.push_back(reinterpret_cast<uintptr_t>(sample.frames[f]));
+        }
+        stacks[stack]++;
+        result.samples++;
+    }
+    result.dropped = static_cast<int>(g_dropped.load());
+
+    result.profile = build_pprof(stacks, hz, duration_nanos);
+
+    g_samples = nullptr;
+    g_capacity = 0;
+    busy.store(false);
+    return result;
+}
+
+#else
+
+SamplingProfiler::Result SamplingProfiler::collect(int, int) {
+    Result result;
+    result.error = Error::Unsupported;
+    result.message = "CPU profiling is not supported on Windows";
+    return result;
+}
+
+#endif
+
+} // namespace lemon
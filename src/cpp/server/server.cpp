@@ -1,35 +1,57 @@
 #include "lemon/server.h"
+#include "lemon/backend_handover.h"
+#include "lemon/bounded_task_queue.h"
 #include "lemon/error_types.h"
 #include <optional>
 #include "lemon/collection_orchestrator.h"
 #include "lemon/hf_variants.h"
 #include "lemon/model_registry.h"
 #include "lemon/route_decision_response.h"
+#include "lemon/router_journal.h"
 #include "lemon/routing_classifier_services.h"
 #include "lemon/routing_policy.h"
+#include "lemon/auto_tune.h"
+#include "lemon/calibration_store.h"
 #include "lemon/config_file.h"
+#include "lemon/download_scheduler.h"
 #include "lemon/jobs/job_manager.h"
 #include "lemon/mcp_server.h"
 #include "lemon/mcp_client.h"
+#include "lemon/log_stream.h"
+#include "lemon/memory_accounting.h"
 #include "lemon/ollama_api.h"
 #include "lemon/backends/cloud/cloud_server.h"
 #include "lemon/backends/sdcpp/sdcpp_server.h"
 #include "lemon/backends/backend_utils.h"
 #include <cstring>
+#include "lemon/image_part_cache.h"
 #include "lemon/utils/image_sniff.h"
 #include "lemon/utils/json_utils.h"
 #include "lemon/utils/path_utils.h"
+#include "lemon/utils/rendezvous_channel.h"
+#include "lemon/utils/text_chunker.h"
 #include "lemon/streaming_proxy.h"
 #include "lemon/logging_config.h"
 #include "lemon/thinking_controls.h"
 #include "lemon/prometheus_metrics.h"
+#include "lemon/rate_limiter.h"
+#include "lemon/request_json.h"
 #include "lemon/runtime_config.h"
+#include "lemon/sampling_profiler.h"
+#include "lemon/sse_compression.h"
+#include "lemon/sse_writer.h"
+#include "lemon/store_eviction.h"
 #include "telemetry.h"
 #include "lemon/system_info.h"
 #include "lemon/version.h"
+#include "lemon/audio_types.h"
+#include "lemon/long_audio.h"
+#include <atomic>
 #include <cctype>
+#include <condition_variable>
 #include <cstdint>
 #include <cstdlib>
+#include <ctime>
 #include <iostream>
 #include <iomanip>
 #include <sstream>
@@ -81,7 +103,10 @@ namespace lemon {
 
 namespace {
 
-
+constexpr char kCorsAllowMethods[] = "GET, POST, PUT, DELETE, OPTIONS";
+constexpr char kCorsAllowHeaders[] =
+    "Content-Type, Authorization, X-Client-Session-Id, X-Account-Session-Id, "
+    "mcp-protocol-version, traceparent, Mcp-Session-Id";
 
 // Normalize client-provided model names: strip ":latest" suffix (Ollama/Docker convention)
 // Returns true if the model name was modified
@@ -137,6 +162,18 @@ int get_error_status_code(const json& response, int default_status_code = 500) {
 void set_error_response(const json& response, httplib::Response& res,
                         int default_status_code = 500) {
     res.status = get_error_status_code(response, default_status_code);
+    if (response.contains("error") && response["error"].is_object()) {
+        const auto& error = response["error"];
+        if (error.contains("details") && error["details"].is_object()) {
+            const auto& details = error["details"];
+            if (details.contains("retry_after_seconds") &&
+                details["retry_after_seconds"].is_number_integer() &&
+                details["retry_after_seconds"].get<int>() > 0) {
+                res.set_header("Retry-After",
+                               std::to_string(details["retry_after_seconds"].get<int>()));
+            }
+        }
+    }
     res.set_content(response.dump(), "application/json");
 }
 
@@ -166,6 +203,7 @@ void attach_route_decision(json& response, httplib::Response& res,
 
 template <typename StreamFn>
 void set_route_decision_sse_content_provider(
+    const httplib::Request& req,
     httplib::Response& res,
     const std::optional<RouterDispatchResult>& dispatch,
     std::string request_body,
@@ -173,10 +211,18 @@ void set_route_decision_sse_content_provider(
     res.set_header("Cache-Control", "no-cache");
     res.set_header("Connection", "keep-alive");
     res.set_header("X-Accel-Buffering", "no");
+    res.set_header("Vary", "Accept-Encoding");
     if (dispatch) {
         attach_route_header(res, dispatch->decision);
     }
 
+    // httplib never compresses text/event-stream on its own; setting
+    // Content-Encoding here also keeps its buffered-response compressor away.
+    const bool compress = SseCompression::client_accepts_zstd(req);
+    if (compress) {
+        res.set_header("Content-Encoding", "zstd");
+    }
+
     json route_decision_json = dispatch
         ? route_decision_to_json(dispatch->decision)
         : json(nullptr);
@@ -184,17 +230,47 @@ void set_route_decision_sse_content_provider(
         "text/event-stream",
         [request_body = std::move(request_body),
          route_decision_json = std::move(route_decision_json),
-         stream_fn = std::move(stream_fn)](size_t offset, httplib::DataSink& sink) {
+         stream_fn = std::move(stream_fn), compress](size_t offset, httplib::DataSink& sink) {
             if (offset > 0) {
                 return false;
             }
 
-            stream_with_route_decision(
-                sink,
-                route_decision_json,
-                [&request_body, &stream_fn](httplib::DataSink& route_sink) {
-                    stream_fn(request_body, route_sink);
-                });
+            auto run = [&](httplib::DataSink& out) {
+                stream_with_route_decision(
+                    out,
+                    route_decision_json,
+                    [&request_body, &stream_fn](httplib::DataSink& route_sink) {
+                        stream_fn(request_body, route_sink);
+                    });
+            };
+
+            if (!compress) {
+                run(sink);
+                return false;
+            }
+
+            SseCompression::Stream zstream;
+            httplib::DataSink compressed_sink;
+            compressed_sink.write = [&zstream, &sink](const char* data, size_t length) {
+                return zstream.write(sink, data, length);
+            };
+            compressed_sink.is_writable = [&sink]() { return sink.is_writable(); };
+            compressed_sink.done = [&zstream, &sink]() {
+                zstream.finish(sink);
+                sink.done();
+            };
+            compressed_sink.done_with_trailer = [&zstream, &sink](const httplib::Headers& trailer) {
+                zstream.finish(sink);
+                if (sink.done_with_trailer) {
+                    sink.done_with_trailer(trailer);
+                } else {
+                    sink.done();
+                }
+            };
+            run(compressed_sink);
+            // Streams that end without done() still get a closed zstd frame
+            // (finish() is a no-op when done() already ran).
+            zstream.finish(sink);
             return false;
         });
 }
@@ -350,6 +426,36 @@ Server::Server(std::shared_ptr<RuntimeConfig> config, const std::string& cache_d
     // Set global HttpClient timeout
     utils::HttpClient::set_default_timeout(config->global_timeout());
 
+    LOG(DEBUG, "Server") << "Debug logging enabled - subprocess output will be visible" << std::endl;
+
+    const char* api_key_env = std::getenv("LEMONADE_API_KEY");
+    api_key_ = api_key_env ? std::string(api_key_env) : "";
+
+    // Read admin API key - if not set, defaults to regular API key value
+    const char* admin_api_key_env = std::getenv("LEMONADE_ADMIN_API_KEY");
+    if (admin_api_key_env) {
+        admin_api_key_ = std::string(admin_api_key_env);
+    } else {
+        admin_api_key_ = api_key_;
+    }
+
+    // Optional credential whose requests are classed as batch priority.
+    // It authenticates against the regular API endpoints like api_key_.
+    const char* batch_api_key_env = std::getenv("LEMONADE_BATCH_API_KEY");
+    batch_api_key_ = batch_api_key_env ? std::string(batch_api_key_env) : "";
+
+    RateLimiter::instance().set_limits({config->quota_requests_per_second(),
+                                        config->quota_tokens_per_minute(),
+                                        config->quota_max_concurrent_streams()});
+
+    setup_http_servers();
+}
+
+// Heavy startup: registry parse, backend/router construction, and cache loads.
+// Runs on a background thread spawned from run() so the HTTP listener binds
+// immediately; until components_ready_ is set, /health reports "warming" and
+// the pre-routing handler answers other routes with 503.
+void Server::initialize_components() {
     cloud_registry_ = std::make_unique<CloudProviderRegistry>();
     // Seed installed providers from config.json. Runtime keys stay empty
     // until either an env var resolves them per-request or a client POSTs
@@ -363,15 +469,77 @@ Server::Server(std::shared_ptr<RuntimeConfig> config, const std::string& cache_d
 
     model_manager_ = std::make_unique<ModelManager>(config_->extra_models_dir());
     model_manager_->set_cloud_registry(cloud_registry_.get());
+    model_manager_->set_peer_url_provider([this]() {
+        std::vector<std::string> roots;
+        if (!peer_registry_ || !peer_registry_->running()) {
+            return roots;
+        }
+        for (const auto& peer : peer_registry_->peers()) {
+            if (!peer.reachable) {
+                continue;
+            }
+            // Beacons advertise the versioned prefix (".../api/v1/"); the
+            // model-file cache lives under the root "/internal/" prefix.
+            auto pos = peer.base_url.find("/api/");
+            roots.push_back(pos == std::string::npos
+                                ? peer.base_url
+                                : peer.base_url.substr(0, pos + 1));
+        }
+        return roots;
+    });
 
     backend_manager_ = std::make_unique<BackendManager>();
     BackendManager::set_global(backend_manager_.get());
+    backends::BackendUtils::verify_exe_manifest_async();
 
     router_ = std::make_unique<Router>(config_.get(),
                                        model_manager_.get(),
                                        backend_manager_.get());
     router_->set_cloud_registry(cloud_registry_.get());
 
+    if (!cache_dir_.empty()) {
+        auto handover_records = BackendHandover::take(cache_dir_);
+        if (!handover_records.empty()) {
+            const size_t adopted = router_->adopt_handover_records(handover_records);
+            LOG(INFO, "Server") << "Adopted " << adopted << " of "
+                                << handover_records.size()
+                                << " handed-over backend(s)" << std::endl;
+        }
+    }
+
+    embeddings_batcher_ = std::make_unique<EmbeddingsBatcher>(
+        static_cast<size_t>(config_->embeddings_batch_max_texts()),
+        config_->embeddings_batch_window_ms());
+
+    rerank_batcher_ = std::make_unique<RerankBatcher>(
+        config_->rerank_chunk_docs(), config_->rerank_parallel_chunks());
+
+    rerank_score_cache_ = std::make_unique<RerankScoreCache>(
+        static_cast<size_t>(config_->rerank_score_cache_entries()));
+
+    StreamingProxy::set_high_water_mark(
+        static_cast<size_t>(config_->streaming_high_water_mark_kb()) * 1024);
+
+    image_queue_ = std::make_unique<ImageGenerationQueue>();
+    if (!cache_dir_.empty()) {
+        image_result_store_ = std::make_unique<ImageResultStore>(cache_dir_);
+    }
+    tts_cache_ = std::make_unique<TtsCache>(cache_dir_);
+    if (!cache_dir_.empty() && config_->completion_cache_enabled()) {
+        completion_cache_ = std::make_unique<CompletionCache>(
+            cache_dir_, config_->completion_cache_ttl_hours(),
+            static_cast<uint64_t>(config_->completion_cache_max_mb()) * 1024 * 1024);
+    }
+    if (!cache_dir_.empty()) {
+        response_store_ = std::make_unique<ResponseStore>(
+            (fs::path(cache_dir_) / "background_responses").string());
+    }
+
+    model_preloader_ = std::make_unique<ModelPreloader>(
+        router_.get(), model_manager_.get(), cache_dir_,
+        [this](const std::string& m) { auto_load_model_if_needed(m); });
+    model_preloader_->start();
+
     {
         lemon::jobs::OpProviders providers;
         struct JobModelState {
@@ -496,6 +664,448 @@ Server::Server(std::shared_ptr<RuntimeConfig> config, const std::string& cache_d
             }
             return lemon::jobs::json::parse(response.dump());
         };
+        providers.chat_stream_op = [this](const lemon::jobs::json& params,
+                                          lemon::jobs::CancelFlag& cancel,
+                                          const lemon::jobs::StepStreams& streams)
+            -> lemon::jobs::json {
+            nlohmann::json request = nlohmann::json::parse(params.dump());
+            request.erase("stream_from");
+
+            const auto throw_on_error = [](const nlohmann::json& response) {
+                if (!response.contains("error")) return;
+                std::string msg = "chat failed";
+                const auto& err = response["error"];
+                if (err.is_object() && err.contains("message") && err["message"].is_string())
+                    msg = err["message"].get<std::string>();
+                else if (err.is_string())
+                    msg = err.get<std::string>();
+                throw lemon::jobs::JobError(424, msg);
+            };
+            const auto completion_output = [&request](const std::string& content,
+                                                      int chunks) -> lemon::jobs::json {
+                nlohmann::json out = {
+                    {"object", "chat.completion"},
+                    {"model", request.value("model", "")},
+                    {"choices",
+                     {{{"index", 0},
+                       {"message", {{"role", "assistant"}, {"content", content}}},
+                       {"finish_reason", "stop"}}}}};
+                if (chunks > 0) out["chunks"] = chunks;
+                return lemon::jobs::json::parse(out.dump());
+            };
+
+            if (streams.consume) {
+                // One completion per sentence batch from the upstream step:
+                // the step's own messages carry the instruction, each batch
+                // arrives as an extra user turn, and the per-batch replies are
+                // concatenated into the recorded output.
+                nlohmann::json base_messages = request.value("messages", nlohmann::json::array());
+                std::string combined;
+                int chunk_count = 0;
+                std::vector<std::string> sentences;
+                while (streams.consume->pop(sentences, cancel)) {
+                    std::string chunk;
+                    for (const auto& sentence : sentences) chunk += sentence;
+                    nlohmann::json chunk_request = request;
+                    chunk_request["messages"] = base_messages;
+                    chunk_request["messages"].push_back(
+                        {{"role", "user"}, {"content", chunk}});
+                    nlohmann::json response = router_->chat_completion(chunk_request, &cancel);
+                    throw_on_error(response);
+                    std::string piece;
+                    if (response.contains("choices") && response["choices"].is_array()
+                        && !response["choices"].empty()) {
+                        const nlohmann::json message =
+                            response["choices"][0].value("message", nlohmann::json::object());
+                        if (message.contains("content") && message["content"].is_string())
+                            piece = message["content"].get<std::string>();
+                    }
+                    if (!combined.empty() && !piece.empty()) combined += " ";
+                    combined += piece;
+                    if (streams.produce && !piece.empty())
+                        streams.produce->append(piece + " ");
+                    ++chunk_count;
+                }
+                if (cancel.load()) throw lemon::jobs::JobError(499, "interrupted");
+                return completion_output(combined, chunk_count);
+            }
+
+            // Producer: run the completion streamed so sentences reach the
+            // consumer while this generation is still running.
+            request["stream"] = true;
+            std::string accumulated;
+            std::string line_buffer;
+            nlohmann::json error_json;
+            httplib::DataSink sink;
+            sink.write = [&](const char* data, size_t len) -> bool {
+                line_buffer.append(data, len);
+                StreamingProxy::process_sse_lines(line_buffer, [&](const std::string& line) {
+                    if (line.rfind("data: ", 0) != 0) return;
+                    const std::string payload = line.substr(6);
+                    if (payload.find("[DONE]") != std::string::npos) return;
+                    try {
+                        auto parsed = nlohmann::json::parse(payload);
+                        if (parsed.contains("error")) {
+                            error_json = parsed;
+                            return;
+                        }
+                        if (parsed.contains("choices") && parsed["choices"].is_array()
+                            && !parsed["choices"].empty()) {
+                            const nlohmann::json delta =
+                                parsed["choices"][0].value("delta", nlohmann::json::object());
+                            if (delta.contains("content") && delta["content"].is_string()) {
+                                const std::string piece = delta["content"].get<std::string>();
+                                accumulated += piece;
+                                if (streams.produce) streams.produce->append(piece);
+                            }
+                        }
+                    } catch (...) {}
+                });
+                return !cancel.load();
+            };
+            sink.is_writable = [&cancel]() -> bool { return !cancel.load(); };
+            sink.done = []() {};
+            router_->chat_completion_stream(request.dump(), sink);
+            if (cancel.load()) throw lemon::jobs::JobError(499, "interrupted");
+            if (error_json.is_null() && accumulated.empty() && !line_buffer.empty()) {
+                // A load failure comes back as a plain JSON error body, not SSE.
+                try {
+                    error_json = nlohmann::json::parse(line_buffer);
+                } catch (...) {}
+            }
+            if (!error_json.is_null()) throw_on_error(error_json);
+            return completion_output(accumulated, 0);
+        };
+        providers.bench_op = [this](const lemon::jobs::json& params,
+                                    lemon::jobs::CancelFlag& cancel) -> lemon::jobs::json {
+            if (!params.contains("model") || !params["model"].is_string())
+                throw lemon::jobs::JobError(400, "bench requires a 'model' string");
+            const std::string model = params["model"].get<std::string>();
+            if (!model_manager_->model_exists(model))
+                throw lemon::jobs::JobError(404, "unknown model '" + model + "'");
+            if (!model_manager_->is_model_downloaded(model))
+                throw lemon::jobs::JobError(404, "model '" + model + "' is not downloaded");
+
+            std::vector<int> prompt_sizes = {256, 1024};
+            if (params.contains("prompt_tokens") && params["prompt_tokens"].is_array()) {
+                prompt_sizes.clear();
+                for (const auto& size : params["prompt_tokens"]) {
+                    if (!size.is_number_integer()) continue;
+                    prompt_sizes.push_back(
+                        std::clamp(size.get<int>(), 16, 32768));
+                    if (prompt_sizes.size() >= 8) break;
+                }
+                if (prompt_sizes.empty())
+                    throw lemon::jobs::JobError(400, "'prompt_tokens' must hold integers");
+            }
+            const int output_tokens =
+                std::clamp(params.value("output_tokens", 64), 8, 2048);
+            const int runs = std::clamp(params.value("runs", 1), 1, 10);
+
+            const auto median = [](std::vector<double> values) -> double {
+                if (values.empty()) return 0.0;
+                std::sort(values.begin(), values.end());
+                const size_t mid = values.size() / 2;
+                if (values.size() % 2 == 1) return values[mid];
+                return (values[mid - 1] + values[mid]) / 2.0;
+            };
+
+            nlohmann::json result;
+            result["object"] = "bench.result";
+            result["model"] = model;
+
+            // Hardware fingerprint so fleet-wide aggregation can tell boxes
+            // apart without a second system_info round-trip per result.
+            {
+                const nlohmann::json sys = nlohmann::json::parse(
+                    SystemInfoCache::get_system_info_with_cache().dump());
+                nlohmann::json hw;
+                hw["os"] = sys.value("OS Version", "");
+                hw["processor"] = sys.value("Processor", "");
+                hw["physical_memory"] = sys.value("Physical Memory", "");
+                const nlohmann::json devices = sys.value("devices", nlohmann::json::object());
+                if (devices.contains("amd_gpu") && devices["amd_gpu"].is_array()) {
+                    nlohmann::json gpus = nlohmann::json::array();
+                    for (const auto& gpu : devices["amd_gpu"]) {
+                        nlohmann::json entry = {{"name", gpu.value("name", "")}};
+                        if (gpu.contains("vram_gb")) entry["vram_gb"] = gpu["vram_gb"];
+                        gpus.push_back(std::move(entry));
+                    }
+                    if (!gpus.empty()) hw["gpus"] = std::move(gpus);
+                }
+                if (devices.contains("amd_npu") && devices["amd_npu"].is_object())
+                    hw["npu"] = devices["amd_npu"].value("name", "");
+                result["hardware"] = std::move(hw);
+            }
+
+            // ~4 characters per token keeps the synthetic prompt near the
+            // requested size across common tokenizers; the recorded
+            // usage.prompt_tokens carries the exact count.
+            const std::string filler = "The quick brown fox jumps over the lazy dog. ";
+            nlohmann::json probes = nlohmann::json::array();
+            for (const int target_tokens : prompt_sizes) {
+                std::string prompt =
+                    "Repeat the word 'ready' once and stop.\n\n";
+                const size_t target_chars = static_cast<size_t>(target_tokens) * 4;
+                while (prompt.size() < target_chars) prompt += filler;
+
+                std::vector<double> ttft_ms;
+                std::vector<double> prefill_tps;
+                std::vector<double> decode_tps;
+                std::vector<double> wall_ms;
+                int measured_prompt_tokens = 0;
+                int measured_output_tokens = 0;
+
+                for (int run = 0; run < runs; ++run) {
+                    if (cancel.load())
+                        throw lemon::jobs::JobError(499, "interrupted");
+
+                    nlohmann::json request = {
+                        {"model", model},
+                        {"messages",
+                         {{{"role", "user"}, {"content", prompt}}}},
+                        {"max_tokens", output_tokens},
+                        {"temperature", 0}};
+                    const auto start = std::chrono::steady_clock::now();
+                    nlohmann::json response = router_->chat_completion(request, &cancel);
+                    const double elapsed_ms =
+                        std::chrono::duration<double, std::milli>(
+                            std::chrono::steady_clock::now() - start).count();
+                    if (response.contains("error")) {
+                        std::string msg = "bench probe failed";
+                        const auto& err = response["error"];
+                        if (err.is_object() && err.contains("message") && err["message"].is_string())
+                            msg = err["message"].get<std::string>();
+                        else if (err.is_string())
+                            msg = err.get<std::string>();
+                        throw lemon::jobs::JobError(424, msg);
+                    }
+
+                    wall_ms.push_back(elapsed_ms);
+                    const nlohmann::json usage =
+                        response.value("usage", nlohmann::json::object());
+                    measured_prompt_tokens = usage.value("prompt_tokens", 0);
+                    measured_output_tokens = usage.value("completion_tokens", 0);
+
+                    const nlohmann::json timings =
+                        response.value("timings", nlohmann::json::object());
+                    if (timings.value("prompt_ms", 0.0) > 0.0)
+                        ttft_ms.push_back(timings["prompt_ms"].get<double>());
+                    if (timings.value("prompt_per_second", 0.0) > 0.0)
+                        prefill_tps.push_back(timings["prompt_per_second"].get<double>());
+                    if (timings.value("predicted_per_second", 0.0) > 0.0) {
+                        decode_tps.push_back(timings["predicted_per_second"].get<double>());
+                    } else if (measured_output_tokens > 0 && elapsed_ms > 0.0) {
+                        // Backends without llama-server timings only support a
+                        // wall-clock decode estimate.
+                        decode_tps.push_back(measured_output_tokens /
+                                             (elapsed_ms / 1000.0));
+                    }
+                }
+
+                nlohmann::json probe;
+                probe["prompt_tokens_requested"] = target_tokens;
+                probe["prompt_tokens"] = measured_prompt_tokens;
+                probe["output_tokens"] = measured_output_tokens;
+                probe["runs"] = runs;
+                probe["wall_ms"] = median(wall_ms);
+                if (!ttft_ms.empty()) probe["ttft_ms"] = median(ttft_ms);
+                if (!prefill_tps.empty()) probe["prefill_tps"] = median(prefill_tps);
+                if (!decode_tps.empty()) probe["decode_tps"] = median(decode_tps);
+                probes.push_back(std::move(probe));
+            }
+            result["probes"] = std::move(probes);
+            return lemon::jobs::json::parse(result.dump());
+        };
+        providers.calibrate_op = [this](const lemon::jobs::json& params,
+                                        lemon::jobs::CancelFlag& cancel) -> lemon::jobs::json {
+            if (!params.contains("model") || !params["model"].is_string())
+                throw lemon::jobs::JobError(400, "calibrate requires a 'model' string");
+            const std::string model = params["model"].get<std::string>();
+            if (!model_manager_->model_exists(model))
+                throw lemon::jobs::JobError(404, "unknown model '" + model + "'");
+            if (!model_manager_->is_model_downloaded(model))
+                throw lemon::jobs::JobError(404, "model '" + model + "' is not downloaded");
+            auto info = model_manager_->get_model_info(model);
+
+            std::vector<int64_t> ctx_points = {4096, 16384};
+            if (params.contains("ctx_points") && params["ctx_points"].is_array()) {
+                ctx_points.clear();
+                for (const auto& point : params["ctx_points"]) {
+                    if (!point.is_number_integer()) continue;
+                    ctx_points.push_back(
+                        std::clamp(point.get<int64_t>(), int64_t{1024}, int64_t{131072}));
+                    if (ctx_points.size() >= 4) break;
+                }
+            }
+            std::sort(ctx_points.begin(), ctx_points.end());
+            ctx_points.erase(std::unique(ctx_points.begin(), ctx_points.end()),
+                             ctx_points.end());
+            if (ctx_points.size() < 2)
+                throw lemon::jobs::JobError(
+                    400, "'ctx_points' needs at least two distinct context sizes");
+            const int output_tokens =
+                std::clamp(params.value("output_tokens", 32), 8, 256);
+
+            // A fixed mid-size prompt: each point measures the same work, so
+            // throughput differences come from the configured context alone.
+            std::string prompt = "Repeat the word 'ready' once and stop.\n\n";
+            const std::string filler =
+                "The quick brown fox jumps over the lazy dog. ";
+            while (prompt.size() < 512 * 4) prompt += filler;
+
+            nlohmann::json result;
+            result["object"] = "calibration.result";
+            result["model"] = model;
+            if (calibration_store_)
+                result["hardware_fingerprint"] = calibration_store_->fingerprint();
+
+            nlohmann::json points = nlohmann::json::array();
+            std::vector<std::pair<int64_t, double>> fit_points;
+            double prefill_tps = 0.0;
+            double decode_tps = 0.0;
+
+            for (const int64_t ctx : ctx_points) {
+                if (cancel.load())
+                    throw lemon::jobs::JobError(499, "interrupted");
+
+                // Reload from a clean baseline so the resident delta at each
+                // point is the weights plus the KV cache preallocated for ctx.
+                if (router_->is_model_loaded(model)) router_->unload_model(model);
+                const double baseline = get_used_memory_gb(info.device);
+
+                nlohmann::json opt_json = {{"ctx_size", ctx}};
+                RecipeOptions options(info.recipe, opt_json);
+                try {
+                    router_->load_model(model, info, options, true, true,
+                                        std::nullopt, LoadPurpose::UserInference,
+                                        &cancel);
+                } catch (const std::exception& e) {
+                    throw lemon::jobs::JobError(500, e.what());
+                }
+                const double resident =
+                    std::max(0.0, get_used_memory_gb(info.device) - baseline);
+
+                nlohmann::json request = {
+                    {"model", model},
+                    {"messages", {{{"role", "user"}, {"content", prompt}}}},
+                    {"max_tokens", output_tokens},
+                    {"temperature", 0}};
+                nlohmann::json response = router_->chat_completion(request, &cancel);
+                if (response.contains("error")) {
+                    std::string msg = "calibration probe failed";
+                    const auto& err = response["error"];
+                    if (err.is_object() && err.contains("message") && err["message"].is_string())
+                        msg = err["message"].get<std::string>();
+                    else if (err.is_string())
+                        msg = err.get<std::string>();
+                    throw lemon::jobs::JobError(424, msg);
+                }
+                const nlohmann::json timings =
+                    response.value("timings", nlohmann::json::object());
+                if (timings.value("prompt_per_second", 0.0) > 0.0)
+                    prefill_tps = timings["prompt_per_second"].get<double>();
+                if (timings.value("predicted_per_second", 0.0) > 0.0)
+                    decode_tps = timings["predicted_per_second"].get<double>();
+
+                nlohmann::json point;
+                point["ctx_size"] = ctx;
+                point["resident_gb"] = resident;
+                if (prefill_tps > 0.0) point["prefill_tps"] = prefill_tps;
+                if (decode_tps > 0.0) point["decode_tps"] = decode_tps;
+                points.push_back(std::move(point));
+                fit_points.emplace_back(ctx, resident);
+            }
+            if (router_->is_model_loaded(model)) router_->unload_model(model);
+            result["points"] = std::move(points);
+
+            double kv_bytes_per_token = 0.0;
+            double base_gb = 0.0;
+            bool persisted = false;
+            if (CalibrationStore::fit_linear(fit_points, kv_bytes_per_token, base_gb) &&
+                kv_bytes_per_token > 0.0) {
+                result["fitted"] = {{"kv_bytes_per_token", kv_bytes_per_token},
+                                    {"base_gb", std::max(0.0, base_gb)}};
+                if (calibration_store_) {
+                    CalibrationCurve curve;
+                    curve.kv_bytes_per_token = kv_bytes_per_token;
+                    curve.base_gb = std::max(0.0, base_gb);
+                    curve.prefill_tps = prefill_tps;
+                    curve.decode_tps = decode_tps;
+                    const std::time_t t = std::chrono::system_clock::to_time_t(
+                        std::chrono::system_clock::now());
+                    std::tm tm_utc{};
+#ifdef _WIN32
+                    gmtime_s(&tm_utc, &t);
+#else
+                    gmtime_r(&t, &tm_utc);
+#endif
+                    char stamp[32];
+                    std::strftime(stamp, sizeof(stamp), "%Y-%m-%dT%H:%M:%SZ", &tm_utc);
+                    curve.measured_at = stamp;
+                    // Key by the registry name auto-tune sees in ModelInfo, not
+                    // whatever alias the caller used.
+                    calibration_store_->store(
+                        info.model_name.empty() ? model : info.model_name, curve);
+                    persisted = true;
+                }
+            }
+            result["persisted"] = persisted;
+            return lemon::jobs::json::parse(result.dump());
+        };
+        providers.model_gc_op = [this](const lemon::jobs::json& params,
+                                       lemon::jobs::CancelFlag& cancel) -> lemon::jobs::json {
+            auto pending = ModelManager::PendingDelete::from_json(
+                nlohmann::json::parse(params.dump()));
+            if (pending.path.empty())
+                throw lemon::jobs::JobError(400, "model_gc requires a 'path'");
+            // The jobs API is reachable by any client; never delete outside the
+            // model cache regardless of what the params claim.
+            auto cache_root =
+                fs::path(model_manager_->get_hf_cache_dir()).lexically_normal();
+            if (!cache_root.has_filename())
+                cache_root = cache_root.parent_path();
+            const auto target = fs::path(pending.path).lexically_normal();
+            // Compare whole components: a bare string-prefix check would also
+            // admit siblings like "<cache_root>-backup".
+            const auto split = std::mismatch(cache_root.begin(), cache_root.end(),
+                                             target.begin(), target.end());
+            if (split.first != cache_root.end() || target == cache_root)
+                throw lemon::jobs::JobError(400, "model_gc path must be inside the model cache");
+
+            const int max_retries = 3;
+            std::string last_error;
+            for (int attempt = 0; attempt <= max_retries; ++attempt) {
+                try {
+                    uint64_t bytes = model_manager_->gc_pending_delete(
+                        pending, [&cancel] { return !cancel.load(); });
+                    if (cancel.load())
+                        throw lemon::jobs::JobError(499, "interrupted");
+                    return {{"path", pending.path}, {"bytes_freed", bytes}};
+                } catch (const lemon::jobs::JobError&) {
+                    throw;
+                } catch (const std::exception& e) {
+                    last_error = e.what();
+                    // Cancelled downloads can still hold file handles when the
+                    // delete lands; give them time to let go.
+                    const bool is_file_locked =
+                        last_error.find("being used by another process") != std::string::npos ||
+                        last_error.find("Permission denied") != std::string::npos ||
+                        last_error.find("resource busy") != std::string::npos;
+                    if (!is_file_locked || attempt == max_retries)
+                        throw lemon::jobs::JobError(500, last_error);
+                    for (int i = 0; i < 50 && !cancel.load(); ++i)
+                        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+                    if (cancel.load())
+                        throw lemon::jobs::JobError(499, "interrupted");
+                }
+            }
+            throw lemon::jobs::JobError(500, last_error);
+        };
+        providers.cache_gc_op = [this](lemon::jobs::CancelFlag&) -> lemon::jobs::json {
+            return lemon::jobs::json::parse(
+                model_manager_->cleanup_orphaned_cache(false).dump());
+        };
         providers.begin_exclusive = [this, job_states, current_job, state_mutex](
                                         const std::string& job_id,
                                         lemon::jobs::CancelFlag* cancel) -> bool {
@@ -513,6 +1123,9 @@ Server::Server(std::shared_ptr<RuntimeConfig> config, const std::string& cache_d
             }
             router_->end_exclusive();
         };
+        providers.interactive_pressure = [this]() -> int {
+            return router_->exclusive_pressure();
+        };
         providers.reconcile_unload = [this, job_states, state_mutex](
                                          const std::string& job_id) {
             std::map<std::string, int> owned_live;
@@ -599,28 +1212,77 @@ Server::Server(std::shared_ptr<RuntimeConfig> config, const std::string& cache_d
             lemon::utils::get_cache_dir(), lemon::jobs::build_op_registry(std::move(providers)));
     }
 
-    LOG(DEBUG, "Server") << "Debug logging enabled - subprocess output will be visible" << std::endl;
+    // Initialize WebSocket server for realtime API and log streaming
+    websocket_server_ = std::make_unique<WebSocketServer>(
+        router_.get(),
+        config_->host(),
+        config_->websocket_port());
 
-    const char* api_key_env = std::getenv("LEMONADE_API_KEY");
-    api_key_ = api_key_env ? std::string(api_key_env) : "";
+    if (websocket_server_->start()) {
+        LOG(INFO, "Server") << "WebSocket server started on port "
+                            << websocket_server_->get_port() << std::endl;
+    } else {
+        LOG(WARNING, "Server") << "Failed to start WebSocket server" << std::endl;
+    }
 
-    // Read admin API key - if not set, defaults to regular API key value
-    const char* admin_api_key_env = std::getenv("LEMONADE_ADMIN_API_KEY");
-    if (admin_api_key_env) {
-        admin_api_key_ = std::string(admin_api_key_env);
+    // HTTP/2-capable front listener multiplexing many streams over few
+    // connections; forwards to the main HTTP/1.1 listener over loopback
+    http2_gateway_ = std::make_unique<Http2Gateway>(
+        config_->host(),
+        config_->http2_port(),
+        config_->port());
+
+    if (http2_gateway_->start()) {
+        LOG(INFO, "Server") << "HTTP/2 gateway started on port "
+                            << http2_gateway_->get_port() << std::endl;
     } else {
-        admin_api_key_ = api_key_;
+        LOG(WARNING, "Server") << "Failed to start HTTP/2 gateway" << std::endl;
     }
 
-    setup_http_servers();
+    variant_cache_ = std::make_unique<VariantCache>(
+        utils::path_from_utf8(utils::get_cache_dir() + "/variant_cache.json"));
+    variant_cache_->start_prefetch(
+        [](const std::string& checkpoint, const std::string& source, bool& not_found) {
+            return fetch_pull_variants(checkpoint, source, not_found);
+        },
+        [this]() -> std::chrono::seconds {
+            if (config_->offline()) {
+                return std::chrono::seconds(0);
+            }
+            return std::chrono::minutes(config_->variant_cache_ttl_minutes());
+        });
 
-    // Initialize WebSocket server for realtime API and log streaming
-    websocket_server_ = std::make_unique<WebSocketServer>(
-        router_.get(),
-        config_->host(),
-        config_->websocket_port());
+    calibration_store_ = std::make_unique<CalibrationStore>(
+        utils::path_from_utf8(utils::get_cache_dir() + "/calibration_store.json"),
+        []() {
+            return CalibrationStore::compute_hardware_fingerprint(
+                nlohmann::json::parse(
+                    SystemInfoCache::get_system_info_with_cache().dump()));
+        });
+    CalibrationStore::set_global(calibration_store_.get());
+
+    stats_history_ = std::make_unique<SystemStatsHistory>();
+    stats_history_->start();
+
+    RouterJournal::instance().enable_persistence(utils::get_cache_dir() +
+                                                 "/router_events.jsonl");
+
+    metrics_pusher_ = std::make_unique<MetricsPusher>(
+        [this]() {
+            SystemMetrics system_metrics;
+            system_metrics.cpu_percent = get_cpu_usage();
+            system_metrics.gpu_percent = get_gpu_usage();
+            system_metrics.vram_gb = get_vram_usage();
+            system_metrics.npu_percent = get_npu_utilization();
+            return build_prometheus_metrics(*router_, system_metrics, stats_history_.get());
+        },
+        utils::get_cache_dir());
+    metrics_pusher_->start();
 
     start_model_cache_warmup();
+    start_config_watcher();
+    start_resume_watcher();
+    start_backend_upgrade_watcher();
 }
 
 void Server::start_model_cache_warmup() {
@@ -658,6 +1320,196 @@ void Server::start_model_cache_warmup() {
     });
 }
 
+void Server::start_config_watcher() {
+    if (cache_dir_.empty() || config_watcher_thread_.joinable()) {
+        return;
+    }
+
+    config_watcher_stop_ = false;
+    config_watcher_thread_ = std::thread([this]() {
+        const fs::path config_path = utils::path_from_utf8(cache_dir_) / "config.json";
+
+        std::error_code ec;
+        auto last_write = fs::last_write_time(config_path, ec);
+        while (!config_watcher_stop_.load()) {
+            std::this_thread::sleep_for(std::chrono::seconds(2));
+            if (config_watcher_stop_.load()) {
+                break;
+            }
+            auto current = fs::last_write_time(config_path, ec);
+            if (ec || current == last_write) {
+                continue;
+            }
+            last_write = current;
+            reload_config_from_disk();
+        }
+    });
+}
+
+void Server::start_resume_watcher() {
+    if (resume_watcher_thread_.joinable()) {
+        return;
+    }
+
+    resume_watcher_stop_ = false;
+    resume_watcher_thread_ = std::thread([this]() {
+        // sleep_for runs on a monotonic timer that does not fire during
+        // suspend, so a wall-clock gap far beyond the tick means the machine
+        // slept through it. Works unprivileged on all three platforms, unlike
+        // logind PrepareForSleep or WM_POWERBROADCAST.
+        constexpr auto kTick = std::chrono::seconds(1);
+        constexpr auto kSuspendGapThreshold = std::chrono::seconds(30);
+
+        auto last_tick = std::chrono::system_clock::now();
+        while (!resume_watcher_stop_.load()) {
+            std::this_thread::sleep_for(kTick);
+            const auto now = std::chrono::system_clock::now();
+            const auto gap = now - last_tick;
+            last_tick = now;
+            if (resume_watcher_stop_.load()) {
+                break;
+            }
+            if (gap < kTick + kSuspendGapThreshold) {
+                continue;
+            }
+
+            const auto gap_seconds =
+                std::chrono::duration_cast<std::chrono::seconds>(gap).count();
+            LOG(INFO, "Server") << "System resume detected (" << gap_seconds
+                                << "s wall-clock gap); checking backend health" << std::endl;
+
+            if (!router_ || resume_recovery_running_.exchange(true)) {
+                continue;
+            }
+            // Detached: recovery can cold-reload models and must not stall
+            // resume detection or shutdown joins.
+            std::thread([this]() {
+                try {
+                    router_->recover_after_resume();
+                } catch (const std::exception& e) {
+                    LOG(WARNING, "Server") << "Post-resume recovery failed: "
+                                           << e.what() << std::endl;
+                }
+                resume_recovery_running_ = false;
+            }).detach();
+        }
+    });
+}
+
+void Server::start_backend_upgrade_watcher() {
+    if (backend_upgrade_thread_.joinable()) {
+        return;
+    }
+
+    backend_upgrade_stop_ = false;
+    backend_upgrade_check_requested_ = true;
+    backend_upgrade_thread_ = std::thread([this]() {
+        // Each tick is a cheap directory scan that promotes anything already
+        // staged once its recipe goes idle; the pin comparison (which can hit
+        // GitHub for "latest" pins) only runs periodically or right after a
+        // config reload bumps a pin.
+        constexpr auto kTick = std::chrono::seconds(30);
+        constexpr auto kPinCheckInterval = std::chrono::hours(6);
+
+        auto last_pin_check = std::chrono::steady_clock::time_point{};
+        while (!backend_upgrade_stop_.load()) {
+            std::this_thread::sleep_for(kTick);
+            if (backend_upgrade_stop_.load()) {
+                break;
+            }
+            if (!config_->backend_upgrade_prefetch() || !backend_manager_) {
+                continue;
+            }
+
+            const auto now = std::chrono::steady_clock::now();
+            bool check_pins =
+                backend_upgrade_check_requested_.exchange(false) ||
+                now - last_pin_check >= kPinCheckInterval;
+            if (check_pins && !DownloadScheduler::background_pulls_allowed_now()) {
+                // Keep the request pending until the off-hours window opens;
+                // promotion of already-staged upgrades is local and continues.
+                backend_upgrade_check_requested_ = true;
+                check_pins = false;
+            }
+            if (check_pins) {
+                last_pin_check = now;
+            }
+
+            try {
+                const auto report = backend_manager_->refresh_staged_upgrades(
+                    [this](const std::string& recipe) {
+                        return router_ && !router_->is_recipe_loaded(recipe);
+                    },
+                    check_pins);
+                if (report.staged > 0 || report.promoted > 0) {
+                    LOG(INFO, "Server")
+                        << "Backend upgrade prefetch: staged " << report.staged
+                        << ", promoted " << report.promoted << std::endl;
+                }
+            } catch (const std::exception& e) {
+                LOG(WARNING, "Server")
+                    << "Backend upgrade prefetch failed: " << e.what() << std::endl;
+            }
+        }
+    });
+}
+
+void Server::reload_config_from_disk() {
+    json incoming;
+    try {
+        incoming = ConfigFile::load(cache_dir_);
+    } catch (const std::exception& e) {
+        LOG(WARNING, "Server") << "Ignoring config.json change; reload failed: "
+                               << e.what() << std::endl;
+        return;
+    }
+
+    // Applied one top-level key at a time because RuntimeConfig::set is
+    // all-or-nothing and config.json legitimately holds keys it does not
+    // manage (provider registry, migration bookkeeping) — one bad or foreign
+    // key must not block the rest of the edit.
+    const json current = config_->snapshot();
+    for (auto& [key, value] : incoming.items()) {
+        if (key == "config_version" || key == "cloud_providers") {
+            continue;
+        }
+        json change;
+        if (value.is_object() && current.contains(key) && current[key].is_object()) {
+            json section;
+            for (auto& [sub_key, sub_value] : value.items()) {
+                if (!current[key].contains(sub_key) || current[key][sub_key] != sub_value) {
+                    section[sub_key] = sub_value;
+                }
+            }
+            if (section.is_null()) {
+                continue;
+            }
+            change[key] = std::move(section);
+        } else if (!current.contains(key) || current[key] != value) {
+            change[key] = value;
+        } else {
+            continue;
+        }
+
+        try {
+            config_->set(change, [this](const json& applied) {
+                apply_config_side_effects(applied);
+            });
+            LOG(INFO, "Server") << "Applied config.json change to '" << key << "'" << std::endl;
+        } catch (const std::invalid_argument& e) {
+            LOG(WARNING, "Server") << "Rejected config.json change to '" << key
+                                   << "': " << e.what() << std::endl;
+        } catch (const std::exception& e) {
+            LOG(WARNING, "Server") << "Failed to apply config.json change to '" << key
+                                   << "': " << e.what() << std::endl;
+        }
+    }
+
+    // A reload may have bumped a backend pin; have the upgrade watcher compare
+    // pins on its next tick instead of waiting out the periodic interval.
+    backend_upgrade_check_requested_ = true;
+}
+
 // Extract the member-function pointer for httplib::Server's private virtual
 // process_and_close_socket (see upgradable_http_server.h). Explicit
 // instantiation is the one context where C++ permits naming a private member.
@@ -674,6 +1526,9 @@ void Server::setup_http_servers() {
     // processed by the routed servers above. The dedicated websocket_port
     // listener keeps running unchanged.
     auto upgrade_handler = [this](socket_t sock) -> bool {
+        if (!components_ready_.load(std::memory_order_acquire)) {
+            return false;
+        }
         if (websocket_server_ && websocket_server_->is_running()) {
             return websocket_server_->adopt_socket(static_cast<intptr_t>(sock));
         }
@@ -690,16 +1545,28 @@ void Server::setup_http_servers() {
     // CRITICAL: Enable multi-threading so the server can handle concurrent requests
     // Without this, the server is single-threaded and blocks on long operations
 
-    // Size the pool from the host CPU count instead of a fixed 8. cpp-httplib
-    // dedicates one worker thread per in-flight request for the connection's
-    // lifetime, so a small fixed pool lets a handful of slow-loris or long-lived
-    // streaming connections starve the management endpoints (/health, /load).
-    unsigned int hw = std::thread::hardware_concurrency();
-    size_t thread_count = std::clamp<size_t>(static_cast<size_t>(hw) * 4, 32, 256);
-    std::function<httplib::TaskQueue *(void)> task_queue_factory = [thread_count] {
-        LOG(DEBUG, "Server") << "Creating new thread pool with " << thread_count
-                             << " threads" << std::endl;
-        return new httplib::ThreadPool(thread_count);
+    // Size the pool from the host CPU count instead of a fixed 8 (overridable
+    // via http_worker_threads in config.json). cpp-httplib dedicates one worker
+    // thread per in-flight request for the connection's lifetime, so a small
+    // fixed pool lets a handful of slow-loris or long-lived streaming
+    // connections starve the management endpoints (/health, /load).
+    size_t thread_count = static_cast<size_t>(config_->http_worker_threads());
+    if (thread_count == 0) {
+        unsigned int hw = std::thread::hardware_concurrency();
+        thread_count = std::clamp<size_t>(static_cast<size_t>(hw) * 4, 32, 256);
+    }
+    // Bound the accept queue so burst load degrades into fast 503s instead of
+    // unbounded connection backlog. The pending counter is shared across the
+    // v4/v6 listeners and drives the shed check in the pre-routing handler.
+    size_t queue_depth = static_cast<size_t>(config_->http_max_queued_requests());
+    http_queue_depth_ = queue_depth;
+    http_pending_ = std::make_shared<std::atomic<size_t>>(0);
+    auto pending = http_pending_;
+    std::function<httplib::TaskQueue *(void)> task_queue_factory =
+        [thread_count, queue_depth, pending] {
+        LOG(DEBUG, "Server") << "Creating worker pool with " << thread_count
+                             << " threads, queue depth " << queue_depth << std::endl;
+        return new BoundedTaskQueue(thread_count, queue_depth, pending);
     };
 
     // The fronts own the accept loops (and therefore the task queues)
@@ -749,6 +1616,9 @@ void Server::stop_http_listeners() {
 Server::~Server() {
     cancel_download_jobs();
     stop();
+    // calibration_store_ is destroyed before router_; drop the global first
+    // so no late unload path can reach a dangling store.
+    CalibrationStore::set_global(nullptr);
 }
 
 namespace {
@@ -837,6 +1707,8 @@ httplib::Server::HandlerResponse Server::authenticate_request(const httplib::Req
     // never leaks across requests on a reused worker thread.
     telemetry::g_incoming_trace_id.clear();
     telemetry::g_incoming_parent_span_id.clear();
+    telemetry::g_active_trace_id.clear();
+    telemetry::g_active_span_id.clear();
     if (config_->telemetry_trust_incoming_trace_context() && req.has_header("traceparent")) {
         std::string trace_id;
         std::string parent_id;
@@ -915,7 +1787,8 @@ httplib::Server::HandlerResponse Server::authenticate_request(const httplib::Req
         }
     } else if ((is_api_route || is_metrics_route) && req.method != "OPTIONS") {
         if (!api_key_.empty()) {
-            if ((auth_token != api_key_) && (auth_token != admin_api_key_)) {
+            if ((auth_token != api_key_) && (auth_token != admin_api_key_) &&
+                (batch_api_key_.empty() || auth_token != batch_api_key_)) {
                 res.status = 401;
                 res.set_content("{\"error\": \"Invalid or missing API key\"}", "application/json");
                 return httplib::Server::HandlerResponse::Handled;
@@ -923,6 +1796,29 @@ httplib::Server::HandlerResponse Server::authenticate_request(const httplib::Req
         }
     }
 
+    // Per-key quota check after authentication. Probe endpoints stay exempt
+    // so health polling (tray clients, federation peers) never burns quota.
+    if (is_api_route && req.method != "OPTIONS" &&
+        RateLimiter::instance().enabled() &&
+        req.path != "/live" && req.path.find("/health") == std::string::npos) {
+        const std::string quota_key =
+            auth_token.empty() ? "ip:" + req.remote_addr : auth_token;
+        const auto decision = RateLimiter::instance().admit_request(quota_key);
+        if (!decision.allowed) {
+            res.status = 429;
+            res.set_header("Retry-After", std::to_string(decision.retry_after_seconds));
+            res.set_header("X-RateLimit-Limit",
+                           std::to_string(static_cast<long>(decision.limit)));
+            res.set_header("X-RateLimit-Remaining",
+                           std::to_string(static_cast<long>(decision.remaining)));
+            res.set_header("X-RateLimit-Reset",
+                           std::to_string(decision.retry_after_seconds));
+            res.set_content("{\"error\": \"Rate limit exceeded, retry later\"}",
+                            "application/json");
+            return httplib::Server::HandlerResponse::Handled;
+        }
+    }
+
     return httplib::Server::HandlerResponse::Unhandled;
 }
 
@@ -932,24 +1828,45 @@ void Server::setup_routes(httplib::Server &web_server) {
     web_server.set_pre_routing_handler([this](const httplib::Request& req, httplib::Response& res) {
         this->log_request(req);
 
+        // Overload shed: when the accept queue is saturated, answer cheap 503s
+        // instead of queueing more inference work. /health and /live stay
+        // exempt so probes keep seeing a live (if busy) server.
+        if (http_queue_depth_ > 0 && http_pending_ &&
+            http_pending_->load(std::memory_order_relaxed) >= http_queue_depth_ &&
+            req.path != "/live" && req.path.find("/health") == std::string::npos) {
+            res.status = 503;
+            res.set_header("Retry-After", "1");
+            res.set_content("{\"error\": \"Server overloaded, retry later\"}", "application/json");
+            return httplib::Server::HandlerResponse::Handled;
+        }
+
+        // Startup warming: the listener is up before the heavy components
+        // (registry, router, backends) exist, so until initialization
+        // finishes only the probe endpoints are served.
+        if (!components_ready_.load(std::memory_order_acquire) &&
+            req.path != "/live" && req.path.find("/health") == std::string::npos) {
+            res.status = 503;
+            res.set_header("Retry-After", "1");
+            res.set_content("{\"error\": \"Server is warming up, retry shortly\"}", "application/json");
+            return httplib::Server::HandlerResponse::Handled;
+        }
+
         // Unconditionally set Vary: Origin to prevent caching issues, preserving existing values
-        std::string vary = "Origin";
-        if (res.has_header("Vary")) {
+        if (!res.has_header("Vary")) {
+            res.set_header("Vary", "Origin");
+        } else {
             std::string existing = res.get_header_value("Vary");
             if (existing.find("Origin") == std::string::npos) {
-                vary = existing + ", Origin";
-            } else {
-                vary = existing;
+                res.set_header("Vary", existing + ", Origin");
             }
         }
-        res.set_header("Vary", vary);
 
         if (req.has_header("Origin")) {
             std::string origin = req.get_header_value("Origin");
             const char* env_origins = std::getenv("LEMONADE_ALLOWED_ORIGINS");
             std::string allowed_origins = env_origins ? std::string(env_origins) : "";
 
-            if (utils::is_origin_allowed(origin, allowed_origins)) {
+            if (origin_allow_cache_.allowed(origin, allowed_origins)) {
                 res.set_header("Access-Control-Allow-Origin", origin);
                 if (req.has_header("Access-Control-Request-Private-Network") &&
                     req.get_header_value("Access-Control-Request-Private-Network") == "true") {
@@ -962,7 +1879,26 @@ void Server::setup_routes(httplib::Server &web_server) {
             }
         }
 
-        return authenticate_request(req, res);
+        const auto auth = authenticate_request(req, res);
+        if (auth != httplib::Server::HandlerResponse::Unhandled) {
+            return auth;
+        }
+
+        // Preflights carry no body and hit no handler; answer them here so
+        // they skip route dispatch entirely. The auth checks above still ran,
+        // so keyless-internal preflights keep failing closed.
+        if (req.method == "OPTIONS") {
+            if (!res.has_header("Access-Control-Allow-Methods")) {
+                res.set_header("Access-Control-Allow-Methods", kCorsAllowMethods);
+            }
+            if (!res.has_header("Access-Control-Allow-Headers")) {
+                res.set_header("Access-Control-Allow-Headers", kCorsAllowHeaders);
+            }
+            res.status = 204;
+            return httplib::Server::HandlerResponse::Handled;
+        }
+
+        return httplib::Server::HandlerResponse::Unhandled;
     });
 
     web_server.Get("/live", [this](const httplib::Request& req, httplib::Response& res) {
@@ -977,39 +1913,19 @@ void Server::setup_routes(httplib::Server &web_server) {
     // Setup CORS for all routes
     setup_cors(web_server);
 
-    // Helper lambda to register routes for both v0 and v1 (with and without /api prefix for OpenAI compatibility)
-    auto register_get = [this, &web_server](const std::string& endpoint,
+    // Helper lambdas to register routes for both v0 and v1 (with and without
+    // /api prefix for OpenAI compatibility). Exact-path endpoints go into the
+    // dispatch tables served by the catch-all routes registered at the end of
+    // this function; routes that need path captures keep explicit regex
+    // registrations, which win because they are registered first.
+    auto register_get = [this](const std::string& endpoint,
                                std::function<void(const httplib::Request&, httplib::Response&)> handler) {
-        web_server.Get("/api/v0/" + endpoint, handler);
-        web_server.Get("/api/v1/" + endpoint, handler);
-        web_server.Get("/v0/" + endpoint, handler);
-        web_server.Get("/v1/" + endpoint, handler);
+        versioned_get_routes_[endpoint] = std::move(handler);
     };
 
-    auto register_post = [this, &web_server](const std::string& endpoint,
+    auto register_post = [this](const std::string& endpoint,
                                 std::function<void(const httplib::Request&, httplib::Response&)> handler) {
-        web_server.Post("/api/v0/" + endpoint, handler);
-        web_server.Post("/api/v1/" + endpoint, handler);
-        web_server.Post("/v0/" + endpoint, handler);
-        web_server.Post("/v1/" + endpoint, handler);
-        if (endpoint != "params" && endpoint != "jobs") {
-            web_server.Get("/api/v0/" + endpoint, [](const httplib::Request&, httplib::Response& res) {
-                res.status = 405;
-                res.set_content("{\"error\": \"Method Not Allowed. Use POST for this endpoint\"}", "application/json");
-            });
-            web_server.Get("/api/v1/" + endpoint, [](const httplib::Request&, httplib::Response& res) {
-                res.status = 405;
-                res.set_content("{\"error\": \"Method Not Allowed. Use POST for this endpoint\"}", "application/json");
-            });
-            web_server.Get("/v0/" + endpoint, [](const httplib::Request&, httplib::Response& res) {
-                res.status = 405;
-                res.set_content("{\"error\": \"Method Not Allowed. Use POST for this endpoint\"}", "application/json");
-            });
-            web_server.Get("/v1/" + endpoint, [](const httplib::Request&, httplib::Response& res) {
-                res.status = 405;
-                res.set_content("{\"error\": \"Method Not Allowed. Use POST for this endpoint\"}", "application/json");
-            });
-        }
+        versioned_post_routes_[endpoint] = std::move(handler);
     };
 
     // Health check
@@ -1027,6 +1943,22 @@ void Server::setup_routes(httplib::Server &web_server) {
         handle_model_update_check(req, res);
     });
 
+    // Capability record for one model, from the persisted GGUF metadata cache.
+    // Registered before the generic /models/(.+) route for the same reason as
+    // /files below.
+    web_server.Get(R"(/api/v0/models/(.+)/capabilities)", [this](const httplib::Request& req, httplib::Response& res) {
+        handle_model_capabilities(req, res);
+    });
+    web_server.Get(R"(/api/v1/models/(.+)/capabilities)", [this](const httplib::Request& req, httplib::Response& res) {
+        handle_model_capabilities(req, res);
+    });
+    web_server.Get(R"(/v0/models/(.+)/capabilities)", [this](const httplib::Request& req, httplib::Response& res) {
+        handle_model_capabilities(req, res);
+    });
+    web_server.Get(R"(/v1/models/(.+)/capabilities)", [this](const httplib::Request& req, httplib::Response& res) {
+        handle_model_capabilities(req, res);
+    });
+
     // Model files endpoint for the Files tab. Register before the generic
     // /models/(.+) route so '<model-id>/files' is not parsed as the model ID.
     web_server.Get(R"(/api/v0/models/(.+)/files)", [this](const httplib::Request& req, httplib::Response& res) {
@@ -1071,6 +2003,12 @@ void Server::setup_routes(httplib::Server &web_server) {
         handle_embeddings(req, res);
     });
 
+    // Document ingestion: server-side chunking and batch scheduling, results
+    // streamed back as NDJSON (one line per chunk).
+    register_post("embeddings/ingest", [this](const httplib::Request& req, httplib::Response& res) {
+        handle_embeddings_ingest(req, res);
+    });
+
     // Reranking
     register_post("reranking", [this](const httplib::Request& req, httplib::Response& res) {
         handle_reranking(req, res);
@@ -1085,6 +2023,14 @@ void Server::setup_routes(httplib::Server &web_server) {
         handle_slots(req, res);
     });
 
+    // Runtime LoRA adapter listing and switching (llama.cpp backend)
+    register_get("adapters", [this](const httplib::Request& req, httplib::Response& res) {
+        handle_adapters(req, res);
+    });
+    register_post("adapters/load", [this](const httplib::Request& req, httplib::Response& res) {
+        handle_adapters_load(req, res);
+    });
+
     // Slots action endpoints (need to register for both versions with regex, with and without /api prefix)
     web_server.Post(R"(/api/v0/slots/(\d+))", [this](const httplib::Request& req, httplib::Response& res) {
         handle_slots_by_id(req, res);
@@ -1104,9 +2050,28 @@ void Server::setup_routes(httplib::Server &web_server) {
         handle_tokenize(req, res);
     });
 
-    // Audio endpoints (OpenAI /v1/audio/* compatible)
-    register_post("audio/transcriptions", [this](const httplib::Request& req, httplib::Response& res) {
-        handle_audio_transcriptions(req, res);
+    // Audio endpoints (OpenAI /v1/audio/* compatible). Transcriptions use the
+    // content-reader overload so large uploads stream to disk instead of being
+    // buffered by httplib.
+    {
+        auto streamed_handler = [this](const httplib::Request& req, httplib::Response& res,
+                                       const httplib::ContentReader& content_reader) {
+            handle_audio_transcriptions(req, res, content_reader);
+        };
+        auto method_not_allowed = [](const httplib::Request&, httplib::Response& res) {
+            res.status = 405;
+            res.set_content("{\"error\": \"Method Not Allowed. Use POST for this endpoint\"}", "application/json");
+        };
+        for (const char* prefix : {"/api/v0/", "/api/v1/", "/v0/", "/v1/"}) {
+            web_server.Post(std::string(prefix) + "audio/transcriptions", streamed_handler);
+            web_server.Get(std::string(prefix) + "audio/transcriptions", method_not_allowed);
+        }
+    }
+
+    // Batch transcription: JSON manifest of server-visible paths, results
+    // streamed back as NDJSON in manifest order.
+    register_post("audio/transcriptions/batch", [this](const httplib::Request& req, httplib::Response& res) {
+        handle_audio_transcriptions_batch(req, res);
     });
 
     // Speech
@@ -1127,6 +2092,15 @@ void Server::setup_routes(httplib::Server &web_server) {
     register_post("images/upscale", [this](const httplib::Request& req, httplib::Response& res) {
         handle_image_upscale(req, res);
     });
+    // Content-addressed results from the image result store. Registered as a
+    // regex route because the key is a path segment; the hex charset keeps it
+    // from shadowing the images/* action endpoints above.
+    for (const char* prefix : {"/api/v0/", "/api/v1/", "/v0/", "/v1/"}) {
+        web_server.Get(std::string(prefix) + R"(images/([0-9a-f]{32}))",
+                       [this](const httplib::Request& req, httplib::Response& res) {
+            handle_image_get(req, res);
+        });
+    }
     // Generative-audio endpoint: text -> audio clip (music, sound effects)
     register_post("audio/generations", [this](const httplib::Request& req, httplib::Response& res) {
         handle_audio_generations(req, res);
@@ -1138,10 +2112,25 @@ void Server::setup_routes(httplib::Server &web_server) {
     register_post("responses", [this](const httplib::Request& req, httplib::Response& res) {
         handle_responses(req, res);
     });
+    for (const char* prefix : {"/api/v0", "/api/v1", "/v0", "/v1"}) {
+        web_server.Post(std::string(prefix) + R"(/responses/([^/]+)/cancel)",
+                        [this](const httplib::Request& req, httplib::Response& res) {
+                            handle_response_cancel(req, res);
+                        });
+        web_server.Get(std::string(prefix) + R"(/responses/([^/]+))",
+                       [this](const httplib::Request& req, httplib::Response& res) {
+                           handle_response_get(req, res);
+                       });
+        web_server.Delete(std::string(prefix) + R"(/responses/([^/]+))",
+                          [this](const httplib::Request& req, httplib::Response& res) {
+                              handle_response_delete(req, res);
+                          });
+    }
 
     // Model management endpoints
     register_post("pull", [this](const httplib::Request& req, httplib::Response& res) {
         handle_pull(req, res);
+        invalidate_models_cache();
     });
 
     register_get("registry/search", [this](const httplib::Request& req, httplib::Response& res) {
@@ -1189,17 +2178,45 @@ void Server::setup_routes(httplib::Server &web_server) {
                           });
     }
 
+    register_post("sessions", [this](const httplib::Request& req, httplib::Response& res) {
+        handle_sessions_create(req, res);
+    });
+    register_get("sessions", [this](const httplib::Request& req, httplib::Response& res) {
+        handle_sessions_list(req, res);
+    });
+    for (const char* prefix : {"/api/v0", "/api/v1", "/v0", "/v1"}) {
+        web_server.Post(std::string(prefix) + R"(/sessions/([^/]+)/chat)",
+                        [this](const httplib::Request& req, httplib::Response& res) {
+                            handle_sessions_chat(req, res);
+                        });
+        web_server.Get(std::string(prefix) + R"(/sessions/([^/]+))",
+                       [this](const httplib::Request& req, httplib::Response& res) {
+                           handle_sessions_get(req, res);
+                       });
+        web_server.Delete(std::string(prefix) + R"(/sessions/([^/]+))",
+                          [this](const httplib::Request& req, httplib::Response& res) {
+                              handle_sessions_delete(req, res);
+                          });
+    }
+
 
     register_post("load", [this](const httplib::Request& req, httplib::Response& res) {
         handle_load(req, res);
+        invalidate_models_cache();
     });
 
     register_post("unload", [this](const httplib::Request& req, httplib::Response& res) {
         handle_unload(req, res);
+        invalidate_models_cache();
+    });
+
+    register_post("prewarm", [this](const httplib::Request& req, httplib::Response& res) {
+        handle_prewarm(req, res);
     });
 
     register_post("delete", [this](const httplib::Request& req, httplib::Response& res) {
         handle_delete(req, res);
+        invalidate_models_cache();
     });
 
     register_post("params", [this](const httplib::Request& req, httplib::Response& res) {
@@ -1213,6 +2230,7 @@ void Server::setup_routes(httplib::Server &web_server) {
     // Backend management endpoints
     register_post("install", [this](const httplib::Request& req, httplib::Response& res) {
         handle_install(req, res);
+        invalidate_models_cache();
     });
 
     register_post("install/dry-run", [this](const httplib::Request& req, httplib::Response& res) {
@@ -1221,6 +2239,7 @@ void Server::setup_routes(httplib::Server &web_server) {
 
     register_post("uninstall", [this](const httplib::Request& req, httplib::Response& res) {
         handle_uninstall(req, res);
+        invalidate_models_cache();
     });
 
     // System endpoints
@@ -1228,6 +2247,10 @@ void Server::setup_routes(httplib::Server &web_server) {
         handle_stats(req, res);
     });
 
+    register_get("queue", [this](const httplib::Request& req, httplib::Response& res) {
+        handle_queue(req, res);
+    });
+
     register_get("system-info", [this](const httplib::Request& req, httplib::Response& res) {
         handle_system_info(req, res);
     });
@@ -1236,6 +2259,14 @@ void Server::setup_routes(httplib::Server &web_server) {
         handle_system_stats(req, res);
     });
 
+    register_get("system-stats/history", [this](const httplib::Request& req, httplib::Response& res) {
+        handle_system_stats_history(req, res);
+    });
+
+    register_get("router/events", [this](const httplib::Request& req, httplib::Response& res) {
+        handle_router_events(req, res);
+    });
+
     register_post("log-level", [this](const httplib::Request& req, httplib::Response& res) {
         handle_log_level(req, res);
     });
@@ -1271,15 +2302,61 @@ void Server::setup_routes(httplib::Server &web_server) {
     });
     web_server.Post("/internal/cleanup-cache", [this](const httplib::Request& req, httplib::Response& res) {
         handle_cleanup_cache(req, res);
+        invalidate_models_cache();
+    });
+    web_server.Post("/internal/store-gc", [this](const httplib::Request& req, httplib::Response& res) {
+        handle_store_gc(req, res);
+        invalidate_models_cache();
     });
     web_server.Post("/internal/simulate-vram-pressure", [this](const httplib::Request& req, httplib::Response& res) {
         handle_simulate_vram_pressure(req, res);
     });
 
+    // Federation model-file cache: peers check for and fetch already-downloaded
+    // files over the LAN instead of re-pulling them from the remote registry.
+    web_server.Get("/internal/model-files/locate", [this](const httplib::Request& req, httplib::Response& res) {
+        handle_model_file_locate(req, res);
+    });
+    web_server.Get("/internal/model-files/get", [this](const httplib::Request& req, httplib::Response& res) {
+        handle_model_file_get(req, res);
+    });
+
+    web_server.Get("/internal/profile", [](const httplib::Request& req, httplib::Response& res) {
+        int seconds = 30;
+        if (req.has_param("seconds")) {
+            seconds = std::atoi(req.get_param_value("seconds").c_str());
+        }
+        int hz = 99;
+        if (req.has_param("hz")) {
+            hz = std::atoi(req.get_param_value("hz").c_str());
+        }
+
+        auto result = SamplingProfiler::collect(seconds, hz);
+        if (result.error != SamplingProfiler::Error::None) {
+            switch (result.error) {
+                case SamplingProfiler::Error::BadRequest: res.status = 400; break;
+                case SamplingProfiler::Error::Busy: res.status = 409; break;
+                case SamplingProfiler::Error::Unsupported: res.status = 501; break;
+                default: res.status = 500; break;
+            }
+            res.set_content(nlohmann::json{{"error", result.message}}.dump(), "application/json");
+            return;
+        }
+
+        res.set_header("X-Profile-Samples", std::to_string(result.samples));
+        res.set_header("X-Profile-Dropped-Samples", std::to_string(result.dropped));
+        res.set_content(result.profile, "application/octet-stream");
+    });
+
+    web_server.Get("/internal/memory", [](const httplib::Request&, httplib::Response& res) {
+        res.set_content(MemoryAccounting::global().snapshot().dump(2), "application/json");
+    });
+
     // Server-side MCP client host foundation (admin-gated through the existing
     // /internal/* pre-routing auth). GUI3 and the web UI can both use these
     // endpoints via the normal Lemonade server connection.
-    register_mcp_client_routes(web_server, cache_dir_);
+    mcp_client_manager_ = get_mcp_client_manager(cache_dir_);
+    mcp_client_manager_->register_routes(web_server);
 
     // Cloud auth: register quad-prefix POST and a parameterized DELETE.
     //   POST /v1/cloud/auth        body: {provider, api_key}
@@ -1311,7 +2388,8 @@ void Server::setup_routes(httplib::Server &web_server) {
     });
 
     // Register Ollama-compatible API routes
-    auto ollama_api = std::make_shared<OllamaApi>(router_.get(), model_manager_.get());
+    auto ollama_api = std::make_shared<OllamaApi>(router_.get(), model_manager_.get(),
+                                                  &models_cache_epoch_);
     ollama_api->register_routes(web_server);
 
     // Register MCP gateway (POST /mcp). NOTE: /mcp is an INTENTIONAL EXCEPTION
@@ -1323,10 +2401,62 @@ void Server::setup_routes(httplib::Server &web_server) {
         [this](const std::string& m) { auto_load_model_if_needed(m); });
     mcp_server->register_routes(web_server);
 
+    // Memory accounting gauges for the subsystems that retain request data
+    // in-process. Model weights live in backend subprocesses and are covered
+    // by eviction/VRAM accounting, not here.
+    MemoryAccounting::global().register_gauge("sessions", [this]() -> std::uint64_t {
+        return session_store_.approx_bytes();
+    });
+    MemoryAccounting::global().register_gauge("background_responses", [this]() -> std::uint64_t {
+        return response_store_ ? response_store_->approx_bytes() : 0;
+    });
+    MemoryAccounting::global().register_gauge("log_stream", []() -> std::uint64_t {
+        return LogStreamHub::instance().approx_bytes();
+    });
+    MemoryAccounting::global().register_gauge("mcp_gateway_sessions",
+                                              [mcp_server]() -> std::uint64_t {
+        return mcp_server->session_bytes();
+    });
+    MemoryAccounting::global().start_watchdog();
+
+    // Catch-alls for the dispatch tables. Registered last so every explicit
+    // regex route above (model-by-id, jobs/{id}, slots/{id}, streamed
+    // transcriptions, Anthropic /v1/messages, ...) keeps priority.
+    const std::string versioned_pattern = R"(^(?:/api)?/v[01]/(.+)$)";
+    web_server.Get(versioned_pattern, [this](const httplib::Request& req, httplib::Response& res) {
+        dispatch_versioned_route(req, res, true);
+    });
+    web_server.Post(versioned_pattern, [this](const httplib::Request& req, httplib::Response& res) {
+        dispatch_versioned_route(req, res, false);
+    });
+
     // Setup static file serving for web UI
     setup_static_files(web_server);
 }
 
+void Server::dispatch_versioned_route(const httplib::Request& req, httplib::Response& res, bool is_get) {
+    const std::string endpoint = req.matches[1];
+    if (is_get) {
+        auto it = versioned_get_routes_.find(endpoint);
+        if (it != versioned_get_routes_.end()) {
+            it->second(req, res);
+            return;
+        }
+        if (versioned_post_routes_.count(endpoint)) {
+            res.status = 405;
+            res.set_content("{\"error\": \"Method Not Allowed. Use POST for this endpoint\"}", "application/json");
+            return;
+        }
+    } else {
+        auto it = versioned_post_routes_.find(endpoint);
+        if (it != versioned_post_routes_.end()) {
+            it->second(req, res);
+            return;
+        }
+    }
+    res.status = 404;
+}
+
 void Server::setup_static_files(httplib::Server &web_server) {
     // Determine static files directory (relative to executable)
     std::string static_dir = utils::get_resource_path("resources/static");
@@ -1693,15 +2823,12 @@ window.api = {
 }
 
 void Server::setup_cors(httplib::Server &web_server) {
-    // Set CORS headers for all responses
+    // Set CORS headers for all responses. Preflights never reach routing:
+    // the pre-routing handler answers OPTIONS directly with these same
+    // precomputed blocks.
     web_server.set_default_headers({
-        {"Access-Control-Allow-Methods", "GET, POST, PUT, DELETE, OPTIONS"},
-        {"Access-Control-Allow-Headers", "Content-Type, Authorization, X-Client-Session-Id, X-Account-Session-Id, mcp-protocol-version, traceparent, Mcp-Session-Id"}
-    });
-
-    // Handle preflight OPTIONS requests
-    web_server.Options(".*", [](const httplib::Request&, httplib::Response& res) {
-        res.status = 204;
+        {"Access-Control-Allow-Methods", kCorsAllowMethods},
+        {"Access-Control-Allow-Headers", kCorsAllowHeaders}
     });
 
     // Catch-all error handler - must be last!
@@ -1897,14 +3024,14 @@ void Server::run() {
 
     running_ = true;
 
-    // Start WebSocket server for realtime API and log streaming
-    if (websocket_server_) {
-        if (websocket_server_->start()) {
-            LOG(INFO, "Server") << "WebSocket server started on port "
-                                << websocket_server_->get_port() << std::endl;
-        } else {
-            LOG(WARNING, "Server") << "Failed to start WebSocket server" << std::endl;
-        }
+    // Bind the listener first so orchestrator liveness probes see /health
+    // within milliseconds; the slow startup work proceeds in parallel.
+    if (!components_ready_.load(std::memory_order_acquire) && !init_thread_.joinable()) {
+        init_thread_ = std::thread([this]() {
+            initialize_components();
+            components_ready_.store(true, std::memory_order_release);
+            LOG(INFO, "Server") << "Startup initialization complete" << std::endl;
+        });
     }
 
     while (true) {
@@ -1961,6 +3088,44 @@ void Server::run() {
             });
         }
 
+        // Piggyback a compact status block on the beacon so local trays can
+        // track loaded models and registry changes without HTTP polling.
+        udp_beacon_.setStatusProvider([this]() -> std::string {
+            if (!components_ready_.load(std::memory_order_acquire) || !router_ ||
+                !model_manager_) {
+                return "";
+            }
+            try {
+                nlohmann::json loaded = nlohmann::json::array();
+                int busy = 0;
+                for (const auto& model : router_->get_all_loaded_models()) {
+                    if (model.value("is_busy", false)) {
+                        ++busy;
+                    }
+                    loaded.push_back({{"model_name", model.value("model_name", "")},
+                                      {"type", model.value("type", "llm")},
+                                      {"device", model.value("device", "")},
+                                      {"recipe", model.value("recipe", "")},
+                                      {"checkpoint", model.value("checkpoint", "")},
+                                      {"pinned", model.value("pinned", false)}});
+                }
+                const size_t loaded_count = loaded.size();
+                nlohmann::json status = {
+                    {"loaded", std::move(loaded)},
+                    {"models_rev", model_manager_->models_revision()},
+                    {"version", LEMON_VERSION_STRING},
+                    {"load_factor", loaded_count == 0
+                        ? 0.0
+                        : static_cast<double>(busy) / static_cast<double>(loaded_count)},
+                };
+                return status.dump();
+            } catch (const std::exception&) {
+                return "";
+            }
+        });
+
+        utils::RendezvousChannel::global().set_state("ready", port_);
+
         // Enumerate all RFC1918 interfaces to determine if we can broadcast.
         // The beacon will send per-interface with the correct IP in the payload.
         auto rfc1918Interfaces = udp_beacon_.getLocalRFC1918Interfaces();
@@ -1984,6 +3149,15 @@ void Server::run() {
                         << "or hostname that resolves to RFC1918 IPv4." << std::endl;
         }
 
+        if (config_->federation() && !peer_registry_) {
+            LOG(INFO, "Server") << "Federation enabled - discovering peer lemond instances" << std::endl;
+            peer_registry_ = std::make_unique<PeerRegistry>();
+            peer_registry_->set_probe_callback([this]() {
+                udp_beacon_.requestImmediateBeacon();
+            });
+            peer_registry_->start(13305);
+        }
+
         // Wait for listener threads, but check periodically for shutdown or rebind signals.
         // The threads are blocked in listen_after_bind(), which only returns when
         // the server is stopped or an error occurs.
@@ -2070,9 +3244,24 @@ bool Server::startup_failed() const {
 }
 
 void Server::stop() {
+    // Finish (or wait out) background initialization so teardown below sees
+    // fully constructed components instead of half-built ones.
+    if (init_thread_.joinable()) {
+        init_thread_.join();
+    }
+
+    config_watcher_stop_ = true;
+    resume_watcher_stop_ = true;
+    backend_upgrade_stop_ = true;
+
     if (running_) {
         LOG(INFO, "Server") << "Stopping HTTP server..." << std::endl;
+        utils::RendezvousChannel::global().set_state("stopping");
+        MemoryAccounting::global().stop_watchdog();
         udp_beacon_.stopBroadcasting();
+        if (peer_registry_) {
+            peer_registry_->stop();
+        }
         stop_http_listeners();
         running_ = false;
         shutdown_requested_ = false;  // Reset for potential future use
@@ -2083,6 +3272,24 @@ void Server::stop() {
             websocket_server_->stop();
         }
 
+        if (http2_gateway_) {
+            LOG(INFO, "Server") << "Stopping HTTP/2 gateway..." << std::endl;
+            http2_gateway_->stop();
+        }
+
+        if (variant_cache_) {
+            variant_cache_->stop_prefetch();
+            variant_cache_->save();
+        }
+
+        if (metrics_pusher_) {
+            metrics_pusher_->stop();
+        }
+
+        if (stats_history_) {
+            stats_history_->stop();
+        }
+
         // Explicitly clean up router (unload models, stop backend servers)
         if (router_) {
             LOG(INFO, "Server") << "Unloading models and stopping backend servers..." << std::endl;
@@ -2102,6 +3309,16 @@ void Server::stop() {
     if (model_cache_warmup_thread_.joinable()) {
         model_cache_warmup_thread_.join();
     }
+
+    if (config_watcher_thread_.joinable()) {
+        config_watcher_thread_.join();
+    }
+    if (resume_watcher_thread_.joinable()) {
+        resume_watcher_thread_.join();
+    }
+    if (backend_upgrade_thread_.joinable()) {
+        backend_upgrade_thread_.join();
+    }
 }
 
 // Generates an actionable error message for model loading failures.
@@ -2262,6 +3479,9 @@ void Server::auto_load_model_if_needed(
     const std::string& requested_model,
     const json& request_options,
     LoadPurpose load_purpose) {
+    if (model_preloader_) {
+        model_preloader_->record_use(requested_model);
+    }
     // A live process follows its current use without a reload: routing work
     // promotes it to RoutingHelper, while direct inference demotes it into the
     // counted Standard pool. Destination-pool admission remains authoritative.
@@ -2297,6 +3517,7 @@ void Server::auto_load_model_if_needed(
     // Collections have no backend of their own — load each component instead.
     if (is_omni_collection_recipe(info.recipe)) {
         ensure_collection_loaded(info);
+        invalidate_models_cache();
         return;
     }
 
@@ -2319,6 +3540,7 @@ void Server::auto_load_model_if_needed(
         // CRITICAL: Refresh model info after download to get correct resolved_path
         // The resolved_path is computed based on filesystem, so we need fresh info now that files exist
         info = model_manager_->get_model_info(requested_model);
+        invalidate_models_cache();
     }
 
     // Load model with do_not_upgrade=true, applying per-request options on first load.
@@ -2329,6 +3551,7 @@ void Server::auto_load_model_if_needed(
                         /*allow_reload_on_option_change=*/false,
                         /*pinned=*/std::nullopt,
                         load_purpose);
+    invalidate_models_cache();
     LOG(INFO, "Server") << "Model loaded successfully: " << requested_model << std::endl;
 }
 
@@ -2366,6 +3589,14 @@ void Server::handle_health(const httplib::Request& req, httplib::Response& res)
         return;
     }
 
+    // During startup warmup the router and model manager don't exist yet;
+    // report a warming state so probes see the process as alive but not ready.
+    if (!components_ready_.load(std::memory_order_acquire)) {
+        nlohmann::json warming = {{"status", "warming"}, {"version", LEMON_VERSION_STRING}};
+        res.set_content(warming.dump(), "application/json");
+        return;
+    }
+
     nlohmann::json response = {{"status", "ok"}};
 
     // Add version information
@@ -2412,9 +3643,18 @@ void Server::handle_health(const httplib::Request& req, httplib::Response& res)
         response["websocket_port"] = websocket_server_->get_port();
     }
 
+    // Add HTTP/2 gateway port for multiplexed clients
+    if (http2_gateway_ && http2_gateway_->is_running()) {
+        response["http2_port"] = http2_gateway_->get_port();
+    }
+
     // Add update check status
     response["update_check_done"] = update_check_done_.load();
 
+    if (peer_registry_ && peer_registry_->running()) {
+        response["federation"] = peer_registry_->snapshot();
+    }
+
     res.set_content(response.dump(), "application/json");
 }
 
@@ -2462,6 +3702,10 @@ void Server::handle_model_update_check(const httplib::Request& req, httplib::Res
     }
 }
 
+void Server::invalidate_models_cache() {
+    models_cache_epoch_.fetch_add(1, std::memory_order_relaxed);
+}
+
 void Server::handle_models(const httplib::Request& req, httplib::Response& res) {
     // For HEAD requests, just return 200 OK without processing
     if (req.method == "HEAD") {
@@ -2472,6 +3716,30 @@ void Server::handle_models(const httplib::Request& req, httplib::Response& res)
     // Check if we should show all models (for CLI list command) or only downloaded (OpenAI API behavior)
     bool show_all = req.has_param("show_all") && req.get_param_value("show_all") == "true";
 
+    // Dashboards and OpenAI-SDK proxies poll this endpoint continuously, so the
+    // serialized body is cached per variant and invalidated by bumping the
+    // epoch whenever models are pulled/deleted/loaded/unloaded. The ETag lets
+    // pollers revalidate with a 304 instead of re-downloading the list.
+    const size_t cache_idx = show_all ? 1 : 0;
+    const uint64_t epoch = models_cache_epoch_.load(std::memory_order_relaxed);
+
+    auto serve = [&](const std::string& body, const std::string& etag) {
+        res.set_header("ETag", etag);
+        if (req.get_header_value("If-None-Match") == etag) {
+            res.status = 304;
+            return;
+        }
+        res.set_content(body, "application/json");
+    };
+
+    {
+        std::lock_guard<std::mutex> lock(models_cache_mutex_);
+        if (models_cache_epoch_cached_[cache_idx] == epoch) {
+            serve(models_cache_body_[cache_idx], models_cache_etag_[cache_idx]);
+            return;
+        }
+    }
+
     // OPTIMIZATION: For OpenAI API mode, use get_downloaded_models() which filters first
     // Only use get_supported_models() when we need to show ALL models
     std::map<std::string, ModelInfo> models;
@@ -2489,7 +3757,21 @@ void Server::handle_models(const httplib::Request& req, httplib::Response& res)
         response["data"].push_back(model_info_to_json(model_id, model_info));
     }
 
-    res.set_content(response.dump(), "application/json");
+    std::string body = response.dump();
+    std::ostringstream etag_stream;
+    etag_stream << "\"" << std::hex << std::hash<std::string>{}(body) << "-" << epoch << "\"";
+    const std::string etag = etag_stream.str();
+
+    {
+        std::lock_guard<std::mutex> lock(models_cache_mutex_);
+        if (models_cache_epoch_.load(std::memory_order_relaxed) == epoch) {
+            models_cache_body_[cache_idx] = body;
+            models_cache_etag_[cache_idx] = etag;
+            models_cache_epoch_cached_[cache_idx] = epoch;
+        }
+    }
+
+    serve(body, etag);
 }
 
 // Maximum collection-component nesting depth embedded in "models" arrays.
@@ -2621,6 +3903,35 @@ void Server::handle_model_by_id(const httplib::Request& req, httplib::Response&
     }
 }
 
+void Server::handle_model_capabilities(const httplib::Request& req, httplib::Response& res) {
+    std::string model_id = req.matches[1];
+
+    if (!model_manager_->model_exists(model_id)) {
+        res.status = 404;
+        auto error_response = create_model_error(model_id, "Model not found");
+        res.set_content(error_response.dump(), "application/json");
+        return;
+    }
+
+    auto info = model_manager_->get_model_info(model_id);
+    std::string canonical_cache_key = model_manager_->resolve_model_name(model_id);
+    std::string wire_id = model_manager_->get_public_model_name(canonical_cache_key);
+
+    nlohmann::json response = {
+        {"model_id", wire_id},
+        {"capabilities", {
+            {"vision", info.gguf.caps.vision},
+            {"tool_calling", info.gguf.caps.tool_calling},
+            {"mtp", info.gguf.caps.mtp}
+        }},
+        {"labels", info.labels}
+    };
+    if (info.max_context_window > 0) {
+        response["max_context_window"] = info.max_context_window;
+    }
+    res.set_content(response.dump(), "application/json");
+}
+
 void Server::handle_model_files(const httplib::Request& req, httplib::Response& res) {
     std::string model_id = req.matches[1];
     const bool include_paths = req.has_param("include_paths") &&
@@ -2735,20 +4046,14 @@ std::optional<RouterDispatchResult> Server::route_collection_request(
         return std::nullopt;
     }
 
-    // The engine owns its policy (and is rebuilt per request because its
-    // classifier services are bound to the live Router), so copy the shared,
-    // immutable policy into it.
-    RoutePolicy policy = *collection_info.route_policy;
-    ClassifierServices services = make_router_classifier_services(
-        *router_, [this](const std::string& m) {
-            auto_load_model_if_needed(m, json::object(),
-                                      LoadPurpose::RoutingDependency);
-        });
-    RoutingPolicyEngine engine(std::move(policy), std::move(services));
+    auto engine = compiled_routing_engine(collection_info);
+    if (!engine) {
+        return std::nullopt;
+    }
 
     RouteContext ctx = build_route_context(request_json, collection_info.model_name);
     const bool want_trace = request_json.value("route_trace", false);
-    Decision decision = engine.route(ctx, want_trace);
+    Decision decision = engine->route(ctx, want_trace);
     RouterDispatchResult result;
     result.requested_model = collection_info.model_name;
     result.selected_model = decision.route_to;
@@ -2756,6 +4061,31 @@ std::optional<RouterDispatchResult> Server::route_collection_request(
     return result;
 }
 
+std::shared_ptr<const RoutingPolicyEngine> Server::compiled_routing_engine(
+    const ModelInfo& collection_info) {
+    if (!collection_info.route_policy) {
+        return nullptr;
+    }
+    std::lock_guard<std::mutex> lock(routing_engines_mutex_);
+    auto it = routing_engines_.find(collection_info.model_name);
+    if (it != routing_engines_.end() &&
+        it->second.policy == collection_info.route_policy) {
+        return it->second.engine;
+    }
+    // The classifier services bind to long-lived Server members (router_ and
+    // the auto-load path), so the engine can safely outlive any one request.
+    ClassifierServices services = make_router_classifier_services(
+        *router_, [this](const std::string& m) {
+            auto_load_model_if_needed(m, json::object(),
+                                      LoadPurpose::RoutingDependency);
+        });
+    auto engine = std::make_shared<const RoutingPolicyEngine>(
+        *collection_info.route_policy, std::move(services));
+    routing_engines_[collection_info.model_name] =
+        CompiledRoutingEngine{collection_info.route_policy, engine};
+    return engine;
+}
+
 std::optional<RouterDispatchResult> Server::apply_router_collection_dispatch(
     nlohmann::json& request_json) {
     if (!request_json.contains("model") || !request_json["model"].is_string()) {
@@ -2792,77 +4122,316 @@ std::optional<RouterDispatchResult> Server::apply_router_collection_dispatch(
     return std::nullopt;
 }
 
-void Server::handle_chat_completions(const httplib::Request& req, httplib::Response& res) {
-    nlohmann::json request_json;
-    if (!parse_required_json_body(req, res, request_json)) return;
-
-    try {
-
-        // Normalize client-provided model names (e.g., strip ":latest" suffix)
-        // Must be done before any model_manager/router lookups and before forwarding
-        normalize_client_model_name(request_json);
+bool Server::try_peer_forward(const std::string& model,
+                              const std::string& endpoint,
+                              const nlohmann::json& request_json,
+                              bool is_streaming,
+                              httplib::Response& res) {
+    if (!peer_registry_ || !peer_registry_->running() || model.empty()) {
+        return false;
+    }
 
-        // Debug: Check if tools are present
-        if (request_json.contains("tools")) {
-            LOG(DEBUG, "Server") << "Tools present in request: " << request_json["tools"].size() << " tool(s)" << std::endl;
-            LOG(DEBUG, "Server") << "Tools JSON: " << request_json["tools"].dump() << std::endl;
-        } else {
-            LOG(DEBUG, "Server") << "No tools in request" << std::endl;
+    auto loaded = router_->get_all_loaded_models();
+    for (const auto& entry : loaded) {
+        if (entry.value("model_name", "") == model) {
+            return false;
         }
+    }
 
-        bool request_modified = false;
-        std::optional<RouterDispatchResult> route_dispatch;
+    auto peer = peer_registry_->peer_with_model(model);
+    if (!peer) {
+        return false;
+    }
+    const std::string url = *peer + endpoint;
 
-        // Omni "collection" models run a server-side tool-calling loop instead of a
-        // plain completion. Branch before auto-load/LLM-type checks: the collection
-        // recipe has no backend of its own; the orchestrator loads each component.
-        if (request_json.contains("model") && request_json["model"].is_string()) {
-            const std::string requested_model = request_json["model"].get<std::string>();
-            try {
-                if (model_manager_->model_exists(requested_model)) {
-                    ModelInfo info = model_manager_->get_model_info(requested_model);
-                    if (is_omni_collection_recipe(info.recipe)) {
-                        handle_collection_chat_completions(request_json, info, res);
-                        return;
-                    }
-                    if (is_router_collection_recipe(info.recipe)) {
-                        // The recipe is the trigger (no "auto", no /v1/route): run the
-                        // routing engine and rewrite the model to the selected
-                        // candidate, then fall through to normal completion handling.
-                        route_dispatch = route_collection_request(request_json, info);
-                        if (route_dispatch) {
-                            route_dispatch->requested_model = requested_model;
-                            LOG(INFO, "Server") << "Router collection '" << requested_model
-                                                << "' -> '" << route_dispatch->selected_model << "'" << std::endl;
-                            request_json["model"] = route_dispatch->selected_model;
-                            request_json.erase("route_trace");
-                        }
-                    }
+    if (is_streaming) {
+        LOG(INFO, "Server") << "Forwarding streaming " << endpoint << " for '"
+                            << model << "' to peer " << *peer << std::endl;
+        const std::string body = request_json.dump();
+        const long timeout = config_->global_timeout();
+        res.set_header("Cache-Control", "no-cache");
+        res.set_header("Connection", "keep-alive");
+        res.set_header("X-Accel-Buffering", "no");
+        res.set_chunked_content_provider("text/event-stream",
+            [url, body, timeout](size_t offset, httplib::DataSink& sink) {
+                if (offset > 0) {
+                    return false;
                 }
-            } catch (const RouterResidencyConflictException& e) {
-                LOG(WARNING, "Server") << "Router residency conflict for '"
-                                       << requested_model << "': " << e.what() << std::endl;
-                set_router_residency_conflict_response(e, res);
-                return;
-            } catch (const std::exception& e) {
-                LOG(DEBUG, "Server") << "Collection check failed for '" << requested_model
-                                     << "': " << e.what() << std::endl;
-            }
+                StreamingProxy::forward_sse_stream(url, body, sink, nullptr, timeout);
+                return false;
+            });
+        return true;
+    }
+
+    try {
+        auto response = utils::HttpClient::post(
+            url, request_json.dump(), {{"Content-Type", "application/json"}},
+            config_->global_timeout(), utils::HttpSecurityPolicy::AllowInsecureHttp);
+        if (response.status_code != 200) {
+            LOG(WARNING, "Server") << "Peer " << *peer << " returned "
+                                   << response.status_code << " for '" << model
+                                   << "'; loading locally" << std::endl;
+            return false;
         }
+        LOG(INFO, "Server") << "Forwarded " << endpoint << " for '" << model
+                            << "' to peer " << *peer << std::endl;
+        res.set_content(response.body, "application/json");
+        return true;
+    } catch (const std::exception& e) {
+        LOG(WARNING, "Server") << "Peer forward to " << *peer << " failed: "
+                               << e.what() << "; loading locally" << std::endl;
+        return false;
+    }
+}
 
-        std::string requested_model;
-        if (request_json.contains("model") && request_json["model"].is_string()) {
-            requested_model = request_json["model"].get<std::string>();
+static std::string quota_key_for(const httplib::Request& req) {
+    if (req.has_header("Authorization")) {
+        const std::string auth_value = req.get_header_value("Authorization");
+        if (auth_value.size() >= 7) {
+            const std::string token = httplib::get_bearer_token_auth(req);
+            if (!token.empty()) {
+                return token;
+            }
         }
-        auto span = telemetry::TelemetryTracker::start_span("LLM", "chat.completions", requested_model, request_json);
+    }
+    return "ip:" + req.remote_addr;
+}
 
-        // Handle model loading/switching
-        if (request_json.contains("model")) {
-            try {
-                auto_load_model_if_needed(requested_model, extract_auto_load_options(request_json));
-                if (span) {
-                    span->cancel();
-                }
+static void record_quota_tokens(const std::string& quota_key,
+                                const nlohmann::json& response) {
+    if (!RateLimiter::instance().enabled()) {
+        return;
+    }
+    double tokens = 0.0;
+    if (response.contains("usage") && response["usage"].is_object()) {
+        const auto& usage = response["usage"];
+        if (usage.contains("total_tokens") && usage["total_tokens"].is_number()) {
+            tokens = usage["total_tokens"].get<double>();
+        } else {
+            if (usage.contains("prompt_tokens") && usage["prompt_tokens"].is_number()) {
+                tokens += usage["prompt_tokens"].get<double>();
+            }
+            if (usage.contains("completion_tokens") && usage["completion_tokens"].is_number()) {
+                tokens += usage["completion_tokens"].get<double>();
+            }
+        }
+    } else if (response.contains("timings") && response["timings"].is_object()) {
+        const auto& timings = response["timings"];
+        if (timings.contains("prompt_n") && timings["prompt_n"].is_number()) {
+            tokens += timings["prompt_n"].get<double>();
+        }
+        if (timings.contains("predicted_n") && timings["predicted_n"].is_number()) {
+            tokens += timings["predicted_n"].get<double>();
+        }
+    }
+    if (tokens > 0.0) {
+        RateLimiter::instance().record_tokens(quota_key, tokens);
+    }
+}
+
+RequestPriority Server::resolve_request_priority(const httplib::Request& req) const {
+    std::string header = req.get_header_value("X-Lemonade-Priority");
+    std::transform(header.begin(), header.end(), header.begin(),
+                   [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+    if (header == "batch" || header == "low" || header == "background") {
+        return RequestPriority::Batch;
+    }
+    if (!header.empty()) {
+        return RequestPriority::Interactive;
+    }
+
+    if (!batch_api_key_.empty() && req.has_header("Authorization")) {
+        const std::string auth_value = req.get_header_value("Authorization");
+        if (auth_value.size() >= 7 &&
+            httplib::get_bearer_token_auth(req) == batch_api_key_) {
+            return RequestPriority::Batch;
+        }
+    }
+    return RequestPriority::Interactive;
+}
+
+void Server::handle_model_file_locate(const httplib::Request& req, httplib::Response& res) {
+    if (!components_ready_.load(std::memory_order_acquire)) {
+        res.status = 503;
+        res.set_content(R"({"error": "Server is warming up"})", "application/json");
+        return;
+    }
+    const std::string file = req.get_param_value("file");
+    size_t size = 0;
+    try {
+        size = static_cast<size_t>(std::stoull(req.get_param_value("size")));
+    } catch (const std::exception&) {
+    }
+    if (file.empty() || size == 0) {
+        res.status = 400;
+        res.set_content(R"({"error": "'file' and 'size' query parameters are required"})",
+                        "application/json");
+        return;
+    }
+    const std::string path = model_manager_->find_local_model_file(file, size);
+    nlohmann::json response = {{"available", !path.empty()}, {"size", size}};
+    res.set_content(response.dump(), "application/json");
+}
+
+void Server::handle_model_file_get(const httplib::Request& req, httplib::Response& res) {
+    if (!components_ready_.load(std::memory_order_acquire)) {
+        res.status = 503;
+        res.set_content(R"({"error": "Server is warming up"})", "application/json");
+        return;
+    }
+    const std::string file = req.get_param_value("file");
+    size_t size = 0;
+    try {
+        size = static_cast<size_t>(std::stoull(req.get_param_value("size")));
+    } catch (const std::exception&) {
+    }
+    const std::string path = file.empty() || size == 0
+        ? std::string()
+        : model_manager_->find_local_model_file(file, size);
+    if (path.empty()) {
+        res.status = 404;
+        res.set_content(R"({"error": "File not available"})", "application/json");
+        return;
+    }
+
+    auto stream = std::make_shared<std::ifstream>(utils::path_from_utf8(path), std::ios::binary);
+    if (!stream->is_open()) {
+        res.status = 404;
+        res.set_content(R"({"error": "File not available"})", "application/json");
+        return;
+    }
+    res.set_content_provider(
+        size, "application/octet-stream",
+        [stream](size_t offset, size_t length, httplib::DataSink& sink) {
+            std::vector<char> buffer((std::min)(length, static_cast<size_t>(1 << 20)));
+            stream->clear();
+            stream->seekg(static_cast<std::streamoff>(offset));
+            stream->read(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+            const auto got = stream->gcount();
+            if (got <= 0) {
+                return false;
+            }
+            return sink.write(buffer.data(), static_cast<size_t>(got));
+        });
+}
+
+std::string Server::completion_cache_key_for(const std::string& endpoint,
+                                             const httplib::Request& req,
+                                             const json& request_json) {
+    if (!completion_cache_ ||
+        req.get_header_value("X-Lemonade-Cache-Bypass") == "1" ||
+        !CompletionCache::cacheable(request_json)) {
+        return "";
+    }
+    // The key pins the exact weights via the registry checkpoint; unknown
+    // models (and registry lookups that fail) are simply not cached.
+    std::string revision;
+    try {
+        revision = model_manager_->get_model_info(request_json.value("model", "")).checkpoint();
+    } catch (const std::exception&) {
+        return "";
+    }
+    if (revision.empty()) {
+        return "";
+    }
+    return CompletionCache::key_for(endpoint, request_json, revision);
+}
+
+void Server::handle_chat_completions(const httplib::Request& req, httplib::Response& res) {
+    nlohmann::json request_json;
+    if (!parse_required_json_body(req, res, request_json)) return;
+
+    try {
+
+        // Normalize client-provided model names (e.g., strip ":latest" suffix)
+        // Must be done before any model_manager/router lookups and before forwarding
+        normalize_client_model_name(request_json);
+
+        // Debug: Check if tools are present
+        if (request_json.contains("tools")) {
+            LOG(DEBUG, "Server") << "Tools present in request: " << request_json["tools"].size() << " tool(s)" << std::endl;
+            LOG(DEBUG, "Server") << "Tools JSON: " << request_json["tools"].dump() << std::endl;
+        } else {
+            LOG(DEBUG, "Server") << "No tools in request" << std::endl;
+        }
+
+        bool request_modified = false;
+        std::optional<RouterDispatchResult> route_dispatch;
+
+        // Omni "collection" models run a server-side tool-calling loop instead of a
+        // plain completion. Branch before auto-load/LLM-type checks: the collection
+        // recipe has no backend of its own; the orchestrator loads each component.
+        if (request_json.contains("model") && request_json["model"].is_string()) {
+            const std::string requested_model = request_json["model"].get<std::string>();
+            try {
+                if (model_manager_->model_exists(requested_model)) {
+                    ModelInfo info = model_manager_->get_model_info(requested_model);
+                    if (is_omni_collection_recipe(info.recipe)) {
+                        handle_collection_chat_completions(request_json, info, res);
+                        return;
+                    }
+                    if (is_router_collection_recipe(info.recipe)) {
+                        // The recipe is the trigger (no "auto", no /v1/route): run the
+                        // routing engine and rewrite the model to the selected
+                        // candidate, then fall through to normal completion handling.
+                        route_dispatch = route_collection_request(request_json, info);
+                        if (route_dispatch) {
+                            route_dispatch->requested_model = requested_model;
+                            LOG(INFO, "Server") << "Router collection '" << requested_model
+                                                << "' -> '" << route_dispatch->selected_model << "'" << std::endl;
+                            request_json["model"] = route_dispatch->selected_model;
+                            request_json.erase("route_trace");
+                        }
+                    }
+                }
+            } catch (const RouterResidencyConflictException& e) {
+                LOG(WARNING, "Server") << "Router residency conflict for '"
+                                       << requested_model << "': " << e.what() << std::endl;
+                set_router_residency_conflict_response(e, res);
+                return;
+            } catch (const std::exception& e) {
+                LOG(DEBUG, "Server") << "Collection check failed for '" << requested_model
+                                     << "': " << e.what() << std::endl;
+            }
+        }
+
+        std::string requested_model;
+        if (request_json.contains("model") && request_json["model"].is_string()) {
+            requested_model = request_json["model"].get<std::string>();
+        }
+
+        {
+            const bool wants_stream = request_json.contains("stream") &&
+                request_json["stream"].is_boolean() && request_json["stream"].get<bool>();
+            if (try_peer_forward(requested_model, "chat/completions", request_json,
+                                 wants_stream, res)) {
+                return;
+            }
+        }
+
+        const RequestPriority priority = resolve_request_priority(req);
+        auto admission = std::make_shared<AdmissionController::Ticket>(
+            AdmissionController::instance().admit(requested_model, priority));
+
+        const std::string quota_key = quota_key_for(req);
+        auto stream_lease = std::make_shared<RateLimiter::StreamLease>();
+        if (!RateLimiter::instance().acquire_stream(quota_key, *stream_lease)) {
+            res.status = 429;
+            res.set_header("Retry-After", "1");
+            res.set_content("{\"error\": \"Too many concurrent requests for this API key\"}",
+                            "application/json");
+            return;
+        }
+
+        auto span = telemetry::TelemetryTracker::start_span("LLM", "chat.completions", requested_model, request_json);
+
+        // Handle model loading/switching
+        if (request_json.contains("model")) {
+            try {
+                auto_load_model_if_needed(requested_model, extract_auto_load_options(request_json));
+                if (span) {
+                    span->cancel();
+                }
             } catch (const std::exception& e) {
                 LOG(ERROR, "Server") << "Failed to load model: " << e.what() << std::endl;
                 auto error_response = create_model_error(requested_model, e.what());
@@ -2914,6 +4483,11 @@ void Server::handle_chat_completions(const httplib::Request& req, httplib::Respo
         // instead of Lemonade's enable_thinking=false.
         request_modified = normalize_thinking_controls(request_json) || request_modified;
 
+        // Canonicalize inline images so a resent screenshot produces the same
+        // bytes every turn and stays eligible for backend prompt caching.
+        request_modified =
+            ImagePartCache::global().preprocess_chat_request(request_json) || request_modified;
+
         // If we modified the request (or normalized the model name earlier), serialize to string
         // The early normalize_client_model_name() call modifies request_json but doesn't set a flag,
         // so we always use request_json for the body to ensure model name normalization is applied
@@ -2925,10 +4499,11 @@ void Server::handle_chat_completions(const httplib::Request& req, httplib::Respo
                 LOG(INFO, "Server") << "POST /api/v1/chat/completions - Streaming" << std::endl;
 
                 set_route_decision_sse_content_provider(
+                    req,
                     res,
                     route_dispatch,
                     request_body,
-                    [this](const std::string& body, httplib::DataSink& sink) {
+                    [this, admission, stream_lease](const std::string& body, httplib::DataSink& sink) {
                         router_->chat_completion_stream(body, sink);
                     });
             } catch (const std::exception& e) {
@@ -2940,7 +4515,20 @@ void Server::handle_chat_completions(const httplib::Request& req, httplib::Respo
             // Log the HTTP request
             LOG(INFO, "Server") << "POST /api/v1/chat/completions - 200 OK" << std::endl;
 
-            auto response = router_->chat_completion(request_json);
+            const std::string completion_cache_key =
+                completion_cache_key_for("chat", req, request_json);
+            if (!completion_cache_key.empty()) {
+                json cached;
+                if (completion_cache_->lookup(completion_cache_key, cached)) {
+                    LOG(INFO, "Server") << "POST /api/v1/chat/completions (cache hit)" << std::endl;
+                    res.set_content(cached.dump(), "application/json");
+                    return;
+                }
+            }
+
+            bool coalesce = req.get_header_value("X-Lemonade-Coalesce") == "1";
+            auto response = coalesce ? router_->chat_completion_coalesced(request_json)
+                                     : router_->chat_completion(request_json);
 
             if (response.contains("error")) {
                 LOG(ERROR, "Server") << "Backend returned error response: " << response["error"].dump() << std::endl;
@@ -2948,6 +4536,11 @@ void Server::handle_chat_completions(const httplib::Request& req, httplib::Respo
                 return;
             }
 
+            if (!completion_cache_key.empty()) {
+                completion_cache_->store(completion_cache_key, response);
+            }
+
+            record_quota_tokens(quota_key, response);
             attach_route_decision(response, res, route_dispatch);
             // Debug: Check if response contains tool_calls
             if (response.contains("choices") && response["choices"].is_array() && !response["choices"].empty()) {
@@ -3072,9 +4665,10 @@ void Server::handle_chat_completions(const httplib::Request& req, httplib::Respo
 }
 
 void Server::handle_completions(const httplib::Request& req, httplib::Response& res) {
-    try {
-        auto request_json = nlohmann::json::parse(req.body);
+    nlohmann::json request_json;
+    if (!parse_required_json_body(req, res, request_json)) return;
 
+    try {
         // Normalize client-provided model names (e.g., strip ":latest" suffix)
         // Must be done before any model_manager/router lookups and before forwarding
         normalize_client_model_name(request_json);
@@ -3088,6 +4682,30 @@ void Server::handle_completions(const httplib::Request& req, httplib::Response&
         if (request_json.contains("model") && request_json["model"].is_string()) {
             requested_model = request_json["model"].get<std::string>();
         }
+
+        {
+            const bool wants_stream = request_json.contains("stream") &&
+                request_json["stream"].is_boolean() && request_json["stream"].get<bool>();
+            if (try_peer_forward(requested_model, "completions", request_json,
+                                 wants_stream, res)) {
+                return;
+            }
+        }
+
+        const RequestPriority priority = resolve_request_priority(req);
+        auto admission = std::make_shared<AdmissionController::Ticket>(
+            AdmissionController::instance().admit(requested_model, priority));
+
+        const std::string quota_key = quota_key_for(req);
+        auto stream_lease = std::make_shared<RateLimiter::StreamLease>();
+        if (!RateLimiter::instance().acquire_stream(quota_key, *stream_lease)) {
+            res.status = 429;
+            res.set_header("Retry-After", "1");
+            res.set_content("{\"error\": \"Too many concurrent requests for this API key\"}",
+                            "application/json");
+            return;
+        }
+
         auto span = telemetry::TelemetryTracker::start_span("LLM", "completions", requested_model, request_json);
 
         // Handle model loading/switching (same logic as chat_completions)
@@ -3148,10 +4766,11 @@ void Server::handle_completions(const httplib::Request& req, httplib::Response&
                 LOG(INFO, "Server") << "POST /api/v1/completions - Streaming" << std::endl;
 
                 set_route_decision_sse_content_provider(
+                    req,
                     res,
                     route_dispatch,
                     request_body,
-                    [this](const std::string& body, httplib::DataSink& sink) {
+                    [this, admission, stream_lease](const std::string& body, httplib::DataSink& sink) {
                         router_->completion_stream(body, sink);
                     });
 
@@ -3166,7 +4785,20 @@ void Server::handle_completions(const httplib::Request& req, httplib::Response&
             }
         } else {
             // Non-streaming
-            auto response = router_->completion(request_json);
+            const std::string completion_cache_key =
+                completion_cache_key_for("completion", req, request_json);
+            if (!completion_cache_key.empty()) {
+                json cached;
+                if (completion_cache_->lookup(completion_cache_key, cached)) {
+                    LOG(INFO, "Server") << "POST /api/v1/completions (cache hit)" << std::endl;
+                    res.set_content(cached.dump(), "application/json");
+                    return;
+                }
+            }
+
+            bool coalesce = req.get_header_value("X-Lemonade-Coalesce") == "1";
+            auto response = coalesce ? router_->completion_coalesced(request_json)
+                                     : router_->completion(request_json);
 
             // Check if response contains an error
             if (response.contains("error")) {
@@ -3184,6 +4816,11 @@ void Server::handle_completions(const httplib::Request& req, httplib::Response&
                 return;
             }
 
+            if (!completion_cache_key.empty()) {
+                completion_cache_->store(completion_cache_key, response);
+            }
+
+            record_quota_tokens(quota_key, response);
             attach_route_decision(response, res, route_dispatch);
             res.set_content(response.dump(), "application/json");
 
@@ -3290,10 +4927,36 @@ void Server::handle_completions(const httplib::Request& req, httplib::Response&
     }
 }
 
+static std::string embedding_bytes_le(const nlohmann::json& embedding) {
+    std::string bytes;
+    bytes.reserve(embedding.size() * sizeof(float));
+    for (const auto& value : embedding) {
+        const float f = value.get<float>();
+        uint32_t bits;
+        std::memcpy(&bits, &f, sizeof(bits));
+        bytes.push_back(static_cast<char>(bits & 0xFF));
+        bytes.push_back(static_cast<char>((bits >> 8) & 0xFF));
+        bytes.push_back(static_cast<char>((bits >> 16) & 0xFF));
+        bytes.push_back(static_cast<char>((bits >> 24) & 0xFF));
+    }
+    return bytes;
+}
+
 void Server::handle_embeddings(const httplib::Request& req, httplib::Response& res) {
-    try {
-        auto request_json = nlohmann::json::parse(req.body);
+    nlohmann::json request_json;
+    if (!parse_required_json_body(req, res, request_json)) return;
 
+    // OpenAI-style "encoding_format": "base64" and a raw f32 body negotiated
+    // via Accept are applied here after the backend call, so base64 and float
+    // requests for the same model still coalesce into one backend batch.
+    const bool base64_output = request_json.contains("encoding_format") &&
+                               request_json["encoding_format"] == "base64";
+    request_json.erase("encoding_format");
+    const bool raw_output =
+        req.get_header_value("Accept").find("application/octet-stream") !=
+        std::string::npos;
+
+    try {
         std::string requested_model;
         if (request_json.contains("model") && request_json["model"].is_string()) {
             requested_model = request_json["model"].get<std::string>();
@@ -3333,83 +4996,337 @@ void Server::handle_embeddings(const httplib::Request& req, httplib::Response& r
             span->cancel();
         }
 
-        // Call router's embeddings method
-        auto response = router_->embeddings(request_json);
-        res.set_content(response.dump(), "application/json");
-
-    } catch (const std::exception& e) {
-        LOG(ERROR, "Server") << "ERROR in handle_embeddings: " << e.what() << std::endl;
-        res.status = 500;
-        nlohmann::json error = {{"error", e.what()}};
-        res.set_content(error.dump(), "application/json");
-    }
-}
-
-void Server::handle_reranking(const httplib::Request& req, httplib::Response& res) {
-    try {
-        auto request_json = nlohmann::json::parse(req.body);
-
-        std::string requested_model;
-        if (request_json.contains("model") && request_json["model"].is_string()) {
-            requested_model = request_json["model"].get<std::string>();
-        }
-        auto span = telemetry::TelemetryTracker::start_span("RERANKER", "reranking", requested_model, request_json);
+        // Coalesce with concurrent same-model requests before hitting the
+        // backend; falls through to a direct router call when batching is
+        // disabled or the input shape is not mergeable.
+        auto response = embeddings_batcher_->embeddings(
+            request_json, [this](const json& merged) { return router_->embeddings(merged); });
 
-        // Handle model loading/switching using helper function
-        if (request_json.contains("model")) {
-            try {
-                auto_load_model_if_needed(requested_model, extract_auto_load_options(request_json));
-                if (span) {
-                    span->cancel();
-                }
-            } catch (const std::exception& e) {
-                LOG(ERROR, "Server") << "Failed to load model: " << e.what() << std::endl;
-                auto error_response = create_model_error(requested_model, e.what());
-                std::string error_code = error_response["error"]["code"].get<std::string>();
-                res.status = get_http_status_from_error(error_code);
-                res.set_content(error_response.dump(), "application/json");
+        const bool has_vectors = !response.contains("error") &&
+                                 response.contains("data") &&
+                                 response["data"].is_array();
 
-                if (span) {
-                    span->end_with_error(e.what());
+        if (raw_output && has_vectors) {
+            std::string body;
+            size_t dimensions = 0;
+            for (const auto& item : response["data"]) {
+                if (!item.contains("embedding") || !item["embedding"].is_array()) {
+                    continue;
                 }
-                return;
-            }
-        } else if (!router_->is_model_loaded()) {
-            LOG(ERROR, "Server") << "No model loaded and no model specified in request" << std::endl;
-            res.status = 400;
-            res.set_content("{\"error\": \"No model loaded and no model specified in request\"}", "application/json");
-            if (span) {
-                span->cancel();
+                dimensions = item["embedding"].size();
+                body += embedding_bytes_le(item["embedding"]);
             }
+            res.set_header("X-Embedding-Count",
+                           std::to_string(response["data"].size()));
+            res.set_header("X-Embedding-Dim", std::to_string(dimensions));
+            res.set_content(std::move(body), "application/octet-stream");
             return;
         }
 
-        if (span) {
-            span->cancel();
+        if (base64_output && has_vectors) {
+            for (auto& item : response["data"]) {
+                if (item.contains("embedding") && item["embedding"].is_array()) {
+                    item["embedding"] = utils::JsonUtils::base64_encode(
+                        embedding_bytes_le(item["embedding"]));
+                }
+            }
         }
 
-        // Call router's reranking method
-        auto response = router_->reranking(request_json);
         res.set_content(response.dump(), "application/json");
 
     } catch (const std::exception& e) {
-        LOG(ERROR, "Server") << "ERROR in handle_reranking: " << e.what() << std::endl;
+        LOG(ERROR, "Server") << "ERROR in handle_embeddings: " << e.what() << std::endl;
         res.status = 500;
         nlohmann::json error = {{"error", e.what()}};
         res.set_content(error.dump(), "application/json");
     }
 }
 
-void Server::handle_classify(const httplib::Request& req, httplib::Response& res) {
+void Server::handle_embeddings_ingest(const httplib::Request& req, httplib::Response& res) {
     try {
-        nlohmann::json request_json;
-        try {
-            request_json = nlohmann::json::parse(req.body);
-        } catch (const nlohmann::json::parse_error& e) {
+        nlohmann::json header;
+        std::vector<nlohmann::json> documents;
+
+        const bool ndjson_body =
+            req.get_header_value("Content-Type").find("ndjson") != std::string::npos;
+        if (ndjson_body) {
+            // First line is a header object (model, chunking); each following
+            // line is one document — a JSON string or {"id", "text"} object.
+            std::istringstream stream(req.body);
+            std::string line;
+            while (std::getline(stream, line)) {
+                if (line.empty() || line == "\r") continue;
+                nlohmann::json parsed;
+                try {
+                    parsed = nlohmann::json::parse(line);
+                } catch (const nlohmann::json::parse_error& e) {
+                    res.status = 400;
+                    nlohmann::json error = {{"error", {
+                        {"message", std::string("Invalid NDJSON line: ") + e.what()},
+                        {"type", "invalid_request_error"}
+                    }}};
+                    res.set_content(error.dump(), "application/json");
+                    return;
+                }
+                if (header.is_null()) {
+                    header = std::move(parsed);
+                } else {
+                    documents.push_back(std::move(parsed));
+                }
+            }
+        } else {
+            if (!parse_required_json_body(req, res, header)) return;
+            if (header.contains("documents") && header["documents"].is_array()) {
+                for (auto& entry : header["documents"]) {
+                    documents.push_back(entry);
+                }
+            }
+        }
+
+        if (!header.is_object() || !header.contains("model") ||
+            !header["model"].is_string()) {
             res.status = 400;
             nlohmann::json error = {{"error", {
-                {"message", std::string("Invalid JSON in request body: ") + e.what()},
-                {"type", "invalid_request_error"}}}};
+                {"message", "Missing 'model' field in request"},
+                {"type", "invalid_request_error"}
+            }}};
+            res.set_content(error.dump(), "application/json");
+            return;
+        }
+        if (documents.empty()) {
+            res.status = 400;
+            nlohmann::json error = {{"error", {
+                {"message", "'documents' must be a non-empty array of strings or "
+                            "{\"id\", \"text\"} objects"},
+                {"type", "invalid_request_error"}
+            }}};
+            res.set_content(error.dump(), "application/json");
+            return;
+        }
+
+        utils::ChunkingOptions chunking;
+        if (header.contains("chunking") && header["chunking"].is_object()) {
+            const auto& opts = header["chunking"];
+            chunking.strategy = opts.value("strategy", chunking.strategy);
+            chunking.max_chars = opts.value("max_chars", chunking.max_chars);
+            chunking.overlap_chars = opts.value("overlap_chars", chunking.overlap_chars);
+        }
+        if (!utils::is_valid_chunking_strategy(chunking.strategy) ||
+            chunking.max_chars == 0) {
+            res.status = 400;
+            nlohmann::json error = {{"error", {
+                {"message", "'chunking.strategy' must be one of \"fixed\", "
+                            "\"sentence\", \"paragraph\" and 'chunking.max_chars' "
+                            "must be positive"},
+                {"type", "invalid_request_error"}
+            }}};
+            res.set_content(error.dump(), "application/json");
+            return;
+        }
+
+        const std::string requested_model = header["model"].get<std::string>();
+        try {
+            auto_load_model_if_needed(requested_model, extract_auto_load_options(header));
+        } catch (const std::exception& e) {
+            LOG(ERROR, "Server") << "Failed to load model: " << e.what() << std::endl;
+            auto error_response = create_model_error(requested_model, e.what());
+            std::string error_code = error_response["error"]["code"].get<std::string>();
+            res.status = get_http_status_from_error(error_code);
+            res.set_content(error_response.dump(), "application/json");
+            return;
+        }
+
+        auto chunks = std::make_shared<std::vector<nlohmann::json>>();
+        for (size_t doc_index = 0; doc_index < documents.size(); ++doc_index) {
+            const auto& doc = documents[doc_index];
+            std::string id = "doc-" + std::to_string(doc_index);
+            std::string text;
+            if (doc.is_string()) {
+                text = doc.get<std::string>();
+            } else if (doc.is_object() && doc.contains("text") && doc["text"].is_string()) {
+                text = doc["text"].get<std::string>();
+                if (doc.contains("id") && doc["id"].is_string()) {
+                    id = doc["id"].get<std::string>();
+                }
+            } else {
+                res.status = 400;
+                nlohmann::json error = {{"error", {
+                    {"message", "'documents' entries must be strings or objects "
+                                "with a string 'text' field"},
+                    {"type", "invalid_request_error"}
+                }}};
+                res.set_content(error.dump(), "application/json");
+                return;
+            }
+            for (auto& piece : utils::chunk_text(text, chunking)) {
+                chunks->push_back({
+                    {"id", id},
+                    {"chunk", piece.index},
+                    {"offset", piece.offset},
+                    {"text", std::move(piece.text)}
+                });
+            }
+        }
+
+        LOG(INFO, "Server") << "Embeddings ingest: " << documents.size()
+                            << " documents, " << chunks->size() << " chunks" << std::endl;
+
+        // Chunks are already grouped into full backend-sized batches here, so
+        // the micro-batching window in EmbeddingsBatcher is skipped.
+        const size_t batch_size =
+            (std::max)(static_cast<size_t>(1),
+                       static_cast<size_t>(config_->embeddings_batch_max_texts()));
+
+        res.set_header("Cache-Control", "no-cache");
+        res.set_header("Connection", "keep-alive");
+        res.set_header("X-Accel-Buffering", "no");
+        res.set_chunked_content_provider(
+            "application/x-ndjson",
+            [this, chunks, requested_model, batch_size](size_t offset, httplib::DataSink& sink) {
+                if (offset > 0) return false;  // single pass
+                for (size_t start = 0; start < chunks->size(); start += batch_size) {
+                    const size_t end = (std::min)(start + batch_size, chunks->size());
+                    nlohmann::json batch_request = {
+                        {"model", requested_model},
+                        {"input", nlohmann::json::array()}
+                    };
+                    for (size_t i = start; i < end; ++i) {
+                        batch_request["input"].push_back((*chunks)[i]["text"]);
+                    }
+
+                    nlohmann::json response;
+                    std::string batch_error;
+                    try {
+                        response = router_->embeddings(batch_request);
+                        if (response.contains("error")) {
+                            batch_error = response["error"].dump();
+                        }
+                    } catch (const std::exception& e) {
+                        batch_error = e.what();
+                    }
+
+                    bool client_gone = false;
+                    for (size_t i = start; i < end; ++i) {
+                        nlohmann::json line = {
+                            {"id", (*chunks)[i]["id"]},
+                            {"chunk", (*chunks)[i]["chunk"]},
+                            {"offset", (*chunks)[i]["offset"]}
+                        };
+                        const size_t data_index = i - start;
+                        if (!batch_error.empty()) {
+                            line["error"] = {
+                                {"message", batch_error},
+                                {"type", "internal_error"}
+                            };
+                        } else if (response.contains("data") &&
+                                   response["data"].is_array() &&
+                                   data_index < response["data"].size() &&
+                                   response["data"][data_index].contains("embedding")) {
+                            line["embedding"] = response["data"][data_index]["embedding"];
+                        } else {
+                            line["error"] = {
+                                {"message", "Backend returned no embedding for this chunk"},
+                                {"type", "internal_error"}
+                            };
+                        }
+                        const std::string payload = line.dump() + "\n";
+                        if (!sink.write(payload.data(), payload.size())) {
+                            client_gone = true;
+                            break;
+                        }
+                    }
+                    if (client_gone) break;
+                }
+                sink.done();
+                return false;
+            });
+
+    } catch (const std::exception& e) {
+        LOG(ERROR, "Server") << "ERROR in handle_embeddings_ingest: " << e.what() << std::endl;
+        res.status = 500;
+        nlohmann::json error = {{"error", {
+            {"message", e.what()},
+            {"type", "internal_error"}
+        }}};
+        res.set_content(error.dump(), "application/json");
+    }
+}
+
+void Server::handle_reranking(const httplib::Request& req, httplib::Response& res) {
+    nlohmann::json request_json;
+    if (!parse_required_json_body(req, res, request_json)) return;
+
+    try {
+        std::string requested_model;
+        if (request_json.contains("model") && request_json["model"].is_string()) {
+            requested_model = request_json["model"].get<std::string>();
+        }
+        auto span = telemetry::TelemetryTracker::start_span("RERANKER", "reranking", requested_model, request_json);
+
+        // Handle model loading/switching using helper function
+        if (request_json.contains("model")) {
+            try {
+                auto_load_model_if_needed(requested_model, extract_auto_load_options(request_json));
+                if (span) {
+                    span->cancel();
+                }
+            } catch (const std::exception& e) {
+                LOG(ERROR, "Server") << "Failed to load model: " << e.what() << std::endl;
+                auto error_response = create_model_error(requested_model, e.what());
+                std::string error_code = error_response["error"]["code"].get<std::string>();
+                res.status = get_http_status_from_error(error_code);
+                res.set_content(error_response.dump(), "application/json");
+
+                if (span) {
+                    span->end_with_error(e.what());
+                }
+                return;
+            }
+        } else if (!router_->is_model_loaded()) {
+            LOG(ERROR, "Server") << "No model loaded and no model specified in request" << std::endl;
+            res.status = 400;
+            res.set_content("{\"error\": \"No model loaded and no model specified in request\"}", "application/json");
+            if (span) {
+                span->cancel();
+            }
+            return;
+        }
+
+        if (span) {
+            span->cancel();
+        }
+
+        // Cached (query, document) pairs skip the backend entirely; the rest
+        // are scored as parallel chunks, with small requests falling through
+        // to a single direct router call.
+        const std::string cache_model_key =
+            !requested_model.empty() ? requested_model : router_->get_loaded_model();
+        auto response = rerank_score_cache_->reranking(
+            request_json, cache_model_key, [this](const json& partial) {
+                return rerank_batcher_->reranking(partial, [this](const json& chunk) {
+                    return router_->reranking(chunk);
+                });
+            });
+        res.set_content(response.dump(), "application/json");
+
+    } catch (const std::exception& e) {
+        LOG(ERROR, "Server") << "ERROR in handle_reranking: " << e.what() << std::endl;
+        res.status = 500;
+        nlohmann::json error = {{"error", e.what()}};
+        res.set_content(error.dump(), "application/json");
+    }
+}
+
+void Server::handle_classify(const httplib::Request& req, httplib::Response& res) {
+    try {
+        nlohmann::json request_json;
+        try {
+            request_json = nlohmann::json::parse(req.body);
+        } catch (const nlohmann::json::parse_error& e) {
+            res.status = 400;
+            nlohmann::json error = {{"error", {
+                {"message", std::string("Invalid JSON in request body: ") + e.what()},
+                {"type", "invalid_request_error"}}}};
             res.set_content(error.dump(), "application/json");
             return;
         }
@@ -3635,6 +5552,73 @@ void Server::handle_slots_by_id(const httplib::Request& req, httplib::Response&
     }
 }
 
+void Server::handle_adapters(const httplib::Request& req, httplib::Response& res) {
+    try {
+        if (!router_->is_model_loaded()) {
+            LOG(ERROR, "Server") << "No model loaded for adapters query" << std::endl;
+            res.status = 400;
+            res.set_content("{\"error\": \"No model loaded for adapters query\"}", "application/json");
+            return;
+        }
+
+        auto response = router_->get_lora_adapters();
+        res.set_content(response.dump(), "application/json");
+
+    } catch (const std::exception& e) {
+        LOG(ERROR, "Server") << "ERROR in handle_adapters: " << e.what() << std::endl;
+        res.status = 500;
+        nlohmann::json error = {{"error", e.what()}};
+        res.set_content(error.dump(), "application/json");
+    }
+}
+
+void Server::handle_adapters_load(const httplib::Request& req, httplib::Response& res) {
+    try {
+        json request_body;
+        if (!req.body.empty()) {
+            try {
+                request_body = json::parse(req.body);
+            } catch (const std::exception& e) {
+                LOG(ERROR, "Server") << "Failed to parse request body: " << e.what() << std::endl;
+                res.status = 400;
+                res.set_content("{\"error\": \"Invalid JSON in request body\"}", "application/json");
+                return;
+            }
+        }
+
+        // Accept either llama-server's bare array of {id, scale} entries or a
+        // wrapped {"adapters": [...]} object.
+        json adapters;
+        if (request_body.is_array()) {
+            adapters = request_body;
+        } else if (request_body.is_object() && request_body.contains("adapters") &&
+                   request_body["adapters"].is_array()) {
+            adapters = request_body["adapters"];
+        } else {
+            LOG(ERROR, "Server") << "Invalid adapters request body" << std::endl;
+            res.status = 400;
+            res.set_content("{\"error\": \"Request body must be an array of {id, scale} entries or {\\\"adapters\\\": [...]}\"}", "application/json");
+            return;
+        }
+
+        if (!router_->is_model_loaded()) {
+            LOG(ERROR, "Server") << "No model loaded for adapters load" << std::endl;
+            res.status = 400;
+            res.set_content("{\"error\": \"No model loaded for adapters load\"}", "application/json");
+            return;
+        }
+
+        auto response = router_->set_lora_adapters(adapters);
+        res.set_content(response.dump(), "application/json");
+
+    } catch (const std::exception& e) {
+        LOG(ERROR, "Server") << "ERROR in handle_adapters_load: " << e.what() << std::endl;
+        res.status = 500;
+        nlohmann::json error = {{"error", e.what()}};
+        res.set_content(error.dump(), "application/json");
+    }
+}
+
 void Server::handle_tokenize(const httplib::Request& req, httplib::Response& res) {
     try {
         LOG(INFO, "Server") << "POST /api/v1/tokenize" << std::endl;
@@ -3670,8 +5654,33 @@ void Server::handle_tokenize(const httplib::Request& req, httplib::Response& res
             return;
         }
 
+        // count_only is the context-budgeting fast path: repeated counts for
+        // the same (model, text) answer from the LRU without a backend round
+        // trip. Token arrays are never cached — only counts.
+        const bool count_only = request_body.value("count_only", false);
+        const std::string content = request_body["content"].get<std::string>();
+        const std::string loaded_model = router_->get_loaded_model();
+
+        if (count_only) {
+            if (auto count = token_count_cache_.lookup(loaded_model, content)) {
+                nlohmann::json response = {{"count", *count}, {"cached", true}};
+                res.set_content(response.dump(), "application/json");
+                return;
+            }
+        }
+
         // Forward request to router
         auto response = router_->tokenize(request_body);
+        if (response.contains("tokens") && response["tokens"].is_array()) {
+            const auto count = static_cast<int64_t>(response["tokens"].size());
+            token_count_cache_.store(loaded_model, content, count);
+            if (count_only) {
+                nlohmann::json counted = {{"count", count}, {"cached", false}};
+                res.set_content(counted.dump(), "application/json");
+                return;
+            }
+            response["count"] = count;
+        }
         res.set_content(response.dump(), "application/json");
 
     } catch (const std::exception& e) {
@@ -3682,7 +5691,19 @@ void Server::handle_tokenize(const httplib::Request& req, httplib::Response& res
     }
 }
 
-void Server::handle_audio_transcriptions(const httplib::Request& req, httplib::Response& res) {
+void Server::handle_audio_transcriptions(const httplib::Request& req, httplib::Response& res,
+                                         const httplib::ContentReader& content_reader) {
+    // Removes the spilled upload once the backend response has been produced.
+    struct TempFileGuard {
+        std::filesystem::path path;
+        ~TempFileGuard() {
+            if (!path.empty()) {
+                std::error_code ec;
+                std::filesystem::remove(path, ec);
+            }
+        }
+    } temp_guard;
+
     try {
         LOG(INFO, "Server") << "POST /api/v1/audio/transcriptions" << std::endl;
 
@@ -3697,39 +5718,66 @@ void Server::handle_audio_transcriptions(const httplib::Request& req, httplib::R
             return;
         }
 
-        // Build request JSON for router
+        // Build request JSON for router. The body is consumed with the
+        // streaming content reader: text fields accumulate in memory while the
+        // audio part is spilled to a temp file as chunks arrive, so peak RSS
+        // stays O(chunk) instead of O(file) for large uploads.
         nlohmann::json request_json;
+        std::map<std::string, std::string> form_fields;
+        std::ofstream audio_out;
+        std::string current_field;
+        bool current_is_audio = false;
+        bool found_audio = false;
+        size_t audio_bytes = 0;
+        std::string audio_filename;
+
+        content_reader(
+            [&](const httplib::FormData& part) {
+                current_field = part.name;
+                current_is_audio = (part.name == "file") && !found_audio;
+                if (current_is_audio) {
+                    found_audio = true;
+                    audio_filename = part.filename;
+                    std::string ext =
+                        std::filesystem::path(part.filename).extension().string();
+                    if (ext.empty()) {
+                        ext = ".audio";
+                    }
+                    auto nonce = static_cast<unsigned long long>(
+                        std::chrono::steady_clock::now().time_since_epoch().count());
+                    temp_guard.path = utils::path_from_utf8(utils::get_runtime_dir()) /
+                                      ("upload-" + std::to_string(nonce) + ext);
+                    audio_out.open(temp_guard.path, std::ios::binary);
+                    return audio_out.is_open();
+                }
+                return true;
+            },
+            [&](const char* data, size_t length) {
+                if (current_is_audio) {
+                    audio_out.write(data, static_cast<std::streamsize>(length));
+                    audio_bytes += length;
+                    return audio_out.good();
+                }
+                form_fields[current_field].append(data, length);
+                return true;
+            });
+        audio_out.close();
 
-        // Extract form fields
-        if (req.form.has_field("model")) {
-            request_json["model"] = req.form.get_field("model");
-        }
-        if (req.form.has_field("language")) {
-            request_json["language"] = req.form.get_field("language");
-        }
-        if (req.form.has_field("prompt")) {
-            request_json["prompt"] = req.form.get_field("prompt");
-        }
-        if (req.form.has_field("response_format")) {
-            request_json["response_format"] = req.form.get_field("response_format");
+        for (const char* field : {"model", "language", "prompt", "response_format"}) {
+            auto it = form_fields.find(field);
+            if (it != form_fields.end()) {
+                request_json[field] = it->second;
+            }
         }
-        if (req.form.has_field("temperature")) {
-            request_json["temperature"] = std::stod(req.form.get_field("temperature"));
+        if (form_fields.count("temperature")) {
+            request_json["temperature"] = std::stod(form_fields["temperature"]);
         }
 
-        // Extract audio file
-        const auto& files = req.form.files;
-        bool found_audio = false;
-        for (const auto& file_pair : files) {
-            if (file_pair.first == "file") {
-                const auto& file = file_pair.second;
-                request_json["file_data"] = file.content;
-                request_json["filename"] = file.filename;
-                found_audio = true;
-                LOG(INFO, "Server") << "Audio file: " << file.filename
-                          << " (" << file.content.size() << " bytes)" << std::endl;
-                break;
-            }
+        if (found_audio) {
+            request_json["file_path"] = utils::path_to_utf8(temp_guard.path);
+            request_json["filename"] = audio_filename;
+            LOG(INFO, "Server") << "Audio file: " << audio_filename
+                      << " (" << audio_bytes << " bytes, spilled to disk)" << std::endl;
         }
 
         if (!found_audio) {
@@ -3765,6 +5813,13 @@ void Server::handle_audio_transcriptions(const httplib::Request& req, httplib::R
             return;
         }
 
+        const bool stream_requested =
+            form_fields.count("stream") &&
+            (form_fields["stream"] == "true" || form_fields["stream"] == "1");
+        if (try_long_audio_transcription(request_json, stream_requested, res)) {
+            return;
+        }
+
         // Forward to router
         auto response = router_->audio_transcriptions(request_json);
 
@@ -3787,24 +5842,309 @@ void Server::handle_audio_transcriptions(const httplib::Request& req, httplib::R
     }
 }
 
-void Server::handle_audio_speech(const httplib::Request& req, httplib::Response& res) {
+bool Server::try_long_audio_transcription(const nlohmann::json& request_json,
+                                          bool stream, httplib::Response& res) {
+    static constexpr int MIN_LONG_AUDIO_SECONDS = 120;
+    static constexpr int MIN_SAMPLE_RATE_HZ = 8000;
+    static constexpr size_t MAX_PARALLEL_CHUNKS = 4;
+
+    if (!request_json.contains("file_path")) {
+        return false;
+    }
+    if (request_json.contains("response_format") &&
+        request_json["response_format"].get<std::string>() != audio::ResponseFormat::JSON) {
+        return false;
+    }
+
+    std::ifstream file(
+        utils::path_from_utf8(request_json["file_path"].get<std::string>()),
+        std::ios::binary);
+    if (!file.is_open()) {
+        return false;
+    }
+    std::vector<uint8_t> bytes((std::istreambuf_iterator<char>(file)),
+                               std::istreambuf_iterator<char>());
+
+    audio::WavInfo info;
+    if (!audio::parse_wav_pcm16(bytes.data(), bytes.size(), info) ||
+        info.channels != 1 || info.sample_rate < MIN_SAMPLE_RATE_HZ) {
+        return false;
+    }
+    if (info.num_samples <
+        static_cast<size_t>(info.sample_rate) * MIN_LONG_AUDIO_SECONDS) {
+        return false;
+    }
+
+    const auto* samples =
+        reinterpret_cast<const int16_t*>(bytes.data() + info.data_offset);
+    const auto ranges =
+        audio::plan_chunks(samples, info.num_samples, info.sample_rate);
+    if (ranges.size() < 2) {
+        return false;
+    }
+
+    LOG(INFO, "Server") << "Long-audio transcription: "
+                        << info.num_samples / static_cast<size_t>(info.sample_rate)
+                        << "s split into " << ranges.size() << " chunks" << std::endl;
+
+    auto chunk_requests = std::make_shared<std::vector<nlohmann::json>>();
+    chunk_requests->reserve(ranges.size());
+    for (size_t i = 0; i < ranges.size(); ++i) {
+        nlohmann::json chunk_req;
+        for (const char* field : {"model", "language", "prompt", "temperature"}) {
+            if (request_json.contains(field)) {
+                chunk_req[field] = request_json[field];
+            }
+        }
+        auto wav = audio::make_wav(samples + ranges[i].first,
+                                   ranges[i].second - ranges[i].first,
+                                   info.sample_rate);
+        chunk_req["file_data"] =
+            std::string(reinterpret_cast<const char*>(wav.data()), wav.size());
+        chunk_req["filename"] = "chunk-" + std::to_string(i) + ".wav";
+        chunk_requests->push_back(std::move(chunk_req));
+    }
+    bytes.clear();
+    bytes.shrink_to_fit();
+
+    struct ChunkResults {
+        std::mutex mutex;
+        std::condition_variable cv;
+        std::vector<nlohmann::json> responses;
+        std::vector<bool> done;
+    };
+    auto results = std::make_shared<ChunkResults>();
+    results->responses.resize(chunk_requests->size());
+    results->done.assign(chunk_requests->size(), false);
+
+    auto spawn_pool = [this, chunk_requests, results]() {
+        auto next = std::make_shared<std::atomic<size_t>>(0);
+        std::vector<std::thread> pool;
+        const size_t workers = std::min(MAX_PARALLEL_CHUNKS, chunk_requests->size());
+        for (size_t w = 0; w < workers; ++w) {
+            pool.emplace_back([this, chunk_requests, results, next]() {
+                for (;;) {
+                    const size_t i = next->fetch_add(1);
+                    if (i >= chunk_requests->size()) {
+                        return;
+                    }
+                    nlohmann::json response;
+                    try {
+                        response = router_->audio_transcriptions((*chunk_requests)[i]);
+                    } catch (const std::exception& e) {
+                        response = {{"error", {
+                            {"message", e.what()},
+                            {"type", "internal_error"}
+                        }}};
+                    }
+                    {
+                        std::lock_guard<std::mutex> lock(results->mutex);
+                        results->responses[i] = std::move(response);
+                        results->done[i] = true;
+                    }
+                    results->cv.notify_all();
+                }
+            });
+        }
+        return pool;
+    };
+
+    if (!stream) {
+        auto pool = spawn_pool();
+        for (auto& worker : pool) {
+            worker.join();
+        }
+        std::vector<std::string> pieces;
+        for (auto& response : results->responses) {
+            if (response.contains("error")) {
+                set_error_response(response, res, 500);
+                return true;
+            }
+            pieces.push_back(response.value("text", ""));
+        }
+        nlohmann::json response = {{"text", audio::stitch_transcripts(pieces)}};
+        res.set_content(response.dump(), "application/json");
+        return true;
+    }
+
+    res.set_header("Cache-Control", "no-cache");
+    res.set_header("Connection", "keep-alive");
+    res.set_header("X-Accel-Buffering", "no");
+    res.set_chunked_content_provider(
+        "text/event-stream",
+        [spawn_pool, results](size_t offset, httplib::DataSink& sink) {
+            if (offset > 0) return false;  // single pass
+            SseWriter sse(sink);
+            auto write_event = [&sse](const nlohmann::json& event) {
+                return sse.write_data(event);
+            };
+
+            auto pool = spawn_pool();
+            std::vector<std::string> pieces;
+            bool failed = false;
+            for (size_t i = 0; i < results->responses.size() && !failed; ++i) {
+                nlohmann::json response;
+                {
+                    std::unique_lock<std::mutex> lock(results->mutex);
+                    results->cv.wait(lock, [&] { return results->done[i]; });
+                    response = results->responses[i];
+                }
+                if (response.contains("error")) {
+                    write_event(response);
+                    failed = true;
+                    break;
+                }
+                pieces.push_back(response.value("text", ""));
+                if (!write_event({{"type", "transcript.text.delta"},
+                                  {"delta", pieces.back()}})) {
+                    failed = true;
+                }
+            }
+            if (!failed) {
+                write_event({{"type", "transcript.text.done"},
+                             {"text", audio::stitch_transcripts(pieces)}});
+            }
+            for (auto& worker : pool) {
+                worker.join();
+            }
+            sink.done();
+            return false;
+        });
+    return true;
+}
+
+void Server::handle_audio_transcriptions_batch(const httplib::Request& req, httplib::Response& res) {
     try {
-        auto request_json = nlohmann::json::parse(req.body);
+        LOG(INFO, "Server") << "POST /api/v1/audio/transcriptions/batch" << std::endl;
 
-        // Handle model loading
-        if (request_json.contains("model")) {
-            std::string requested_model = request_json["model"];
-            try {
-                auto_load_model_if_needed(requested_model, extract_auto_load_options(request_json));
-            } catch (const std::exception& e) {
-                LOG(ERROR, "Server") << "Failed to load text-to-speech model: " << e.what() << std::endl;
-                auto error_response = create_model_error(requested_model, e.what());
-                std::string error_code = error_response["error"]["code"].get<std::string>();
-                res.status = get_http_status_from_error(error_code);
-                res.set_content(error_response.dump(), "application/json");
+        nlohmann::json request_json;
+        try {
+            request_json = nlohmann::json::parse(req.body);
+        } catch (const nlohmann::json::parse_error& e) {
+            res.status = 400;
+            nlohmann::json error = {{"error", {
+                {"message", std::string("Invalid JSON: ") + e.what()},
+                {"type", "invalid_request_error"}
+            }}};
+            res.set_content(error.dump(), "application/json");
+            return;
+        }
+
+        if (!request_json.contains("model")) {
+            res.status = 400;
+            nlohmann::json error = {{"error", {
+                {"message", "Missing 'model' field in request"},
+                {"type", "invalid_request_error"}
+            }}};
+            res.set_content(error.dump(), "application/json");
+            return;
+        }
+
+        if (!request_json.contains("files") || !request_json["files"].is_array() ||
+            request_json["files"].empty()) {
+            res.status = 400;
+            nlohmann::json error = {{"error", {
+                {"message", "'files' must be a non-empty array of server-visible audio paths"},
+                {"type", "invalid_request_error"}
+            }}};
+            res.set_content(error.dump(), "application/json");
+            return;
+        }
+
+        std::string requested_model = request_json["model"];
+        try {
+            auto_load_model_if_needed(requested_model, extract_auto_load_options(request_json));
+        } catch (const std::exception& e) {
+            LOG(ERROR, "Server") << "Failed to load audio model: " << e.what() << std::endl;
+            auto error_response = create_model_error(requested_model, e.what());
+            std::string error_code = error_response["error"]["code"].get<std::string>();
+            res.status = get_http_status_from_error(error_code);
+            res.set_content(error_response.dump(), "application/json");
+            return;
+        }
+
+        auto file_requests = std::make_shared<std::vector<nlohmann::json>>();
+        file_requests->reserve(request_json["files"].size());
+        for (const auto& entry : request_json["files"]) {
+            if (!entry.is_string()) {
+                res.status = 400;
+                nlohmann::json error = {{"error", {
+                    {"message", "'files' entries must be path strings"},
+                    {"type", "invalid_request_error"}
+                }}};
+                res.set_content(error.dump(), "application/json");
                 return;
             }
-        } else {
+            nlohmann::json file_req;
+            for (const char* field : {"model", "language", "prompt", "temperature",
+                                      "response_format"}) {
+                if (request_json.contains(field)) {
+                    file_req[field] = request_json[field];
+                }
+            }
+            const std::string path = entry.get<std::string>();
+            file_req["file_path"] = path;
+            file_req["filename"] =
+                utils::path_to_utf8(utils::path_from_utf8(path).filename());
+            file_requests->push_back(std::move(file_req));
+        }
+
+        LOG(INFO, "Server") << "Batch transcription: " << file_requests->size()
+                            << " files" << std::endl;
+
+        res.set_header("Cache-Control", "no-cache");
+        res.set_header("Connection", "keep-alive");
+        res.set_header("X-Accel-Buffering", "no");
+        res.set_chunked_content_provider(
+            "application/x-ndjson",
+            [this, file_requests](size_t offset, httplib::DataSink& sink) {
+                if (offset > 0) return false;  // single pass
+                for (size_t i = 0; i < file_requests->size(); ++i) {
+                    const nlohmann::json& file_req = (*file_requests)[i];
+                    const std::string path = file_req["file_path"].get<std::string>();
+                    nlohmann::json line;
+                    if (!std::filesystem::exists(utils::path_from_utf8(path))) {
+                        line["error"] = {
+                            {"message", "File not found: " + path},
+                            {"type", "invalid_request_error"}
+                        };
+                    } else {
+                        try {
+                            line = router_->audio_transcriptions(file_req);
+                        } catch (const std::exception& e) {
+                            line = {{"error", {
+                                {"message", e.what()},
+                                {"type", "internal_error"}
+                            }}};
+                        }
+                    }
+                    line["index"] = i;
+                    line["file"] = path;
+                    const std::string payload = line.dump() + "\n";
+                    if (!sink.write(payload.data(), payload.size())) {
+                        break;
+                    }
+                }
+                sink.done();
+                return false;
+            });
+
+    } catch (const std::exception& e) {
+        LOG(ERROR, "Server") << "ERROR in handle_audio_transcriptions_batch: " << e.what() << std::endl;
+        res.status = 500;
+        nlohmann::json error = {{"error", {
+            {"message", e.what()},
+            {"type", "internal_error"}
+        }}};
+        res.set_content(error.dump(), "application/json");
+    }
+}
+
+void Server::handle_audio_speech(const httplib::Request& req, httplib::Response& res) {
+    try {
+        auto request_json = nlohmann::json::parse(req.body);
+
+        if (!request_json.contains("model")) {
             res.status = 400;
             nlohmann::json error = {{"error", {
                 {"message", "Missing 'model' field in request"},
@@ -3839,6 +6179,57 @@ void Server::handle_audio_speech(const httplib::Request& req, httplib::Response&
             }
         }
 
+        // The cache key uses the pre-load format resolution — an explicit
+        // response_format, "pcm" for streams, or "default" (which resolves
+        // deterministically per model) — so hits never need the model loaded.
+        std::string format_token = "default";
+        if (is_streaming) {
+            format_token = "pcm";
+        } else if (request_json.contains("response_format") &&
+                   request_json["response_format"].is_string()) {
+            format_token = request_json["response_format"].get<std::string>();
+        }
+        const std::string cache_key = TtsCache::key_for(request_json, format_token);
+        std::string cached_format;
+        std::string cached_audio;
+        if (tts_cache_ && tts_cache_->lookup(cache_key, cached_format, cached_audio) &&
+            MIME_TYPES.contains(cached_format)) {
+            LOG(INFO, "Server") << "POST /api/v1/audio/speech (cache hit)" << std::endl;
+            const std::string cached_mime = MIME_TYPES[cached_format];
+            if (is_streaming) {
+                res.set_header("Cache-Control", "no-cache");
+                res.set_header("Connection", "keep-alive");
+                res.set_header("X-Accel-Buffering", "no");
+                auto audio = std::make_shared<std::string>(std::move(cached_audio));
+                res.set_chunked_content_provider(cached_mime,
+                    [audio](size_t offset, httplib::DataSink& sink) {
+                        if (offset > 0) {
+                            return false;
+                        }
+                        sink.write(audio->data(), audio->size());
+                        sink.done();
+                        return false;
+                    });
+            } else {
+                res.set_content(cached_audio, cached_mime);
+            }
+            return;
+        }
+
+        {
+            std::string requested_model = request_json["model"];
+            try {
+                auto_load_model_if_needed(requested_model, extract_auto_load_options(request_json));
+            } catch (const std::exception& e) {
+                LOG(ERROR, "Server") << "Failed to load text-to-speech model: " << e.what() << std::endl;
+                auto error_response = create_model_error(requested_model, e.what());
+                std::string error_code = error_response["error"]["code"].get<std::string>();
+                res.status = get_http_status_from_error(error_code);
+                res.set_content(error_response.dump(), "application/json");
+                return;
+            }
+        }
+
         const auto supported_formats =
             router_->audio_speech_supported_formats(request_json["model"].get<std::string>());
         std::string response_format = "mp3";
@@ -3902,9 +6293,13 @@ void Server::handle_audio_speech(const httplib::Request& req, httplib::Response&
             // Use cpp-httplib's chunked content provider for streaming
             res.set_chunked_content_provider(mime_type, audio_source);
         } else {
-            serve_media_or_error(res, mime_type, [this, request_json](httplib::DataSink& sink) {
-                router_->audio_speech(request_json, sink);
-            });
+            const bool served =
+                serve_media_or_error(res, mime_type, [this, request_json](httplib::DataSink& sink) {
+                    router_->audio_speech(request_json, sink);
+                });
+            if (served && tts_cache_) {
+                tts_cache_->store(cache_key, response_format, res.body);
+            }
         }
 
         return;
@@ -3941,7 +6336,7 @@ static nlohmann::json extract_error_payload(const std::string& buf) {
     return nullptr;
 }
 
-void Server::serve_media_or_error(httplib::Response& res, const std::string& mime_type,
+bool Server::serve_media_or_error(httplib::Response& res, const std::string& mime_type,
                                   const std::function<void(httplib::DataSink&)>& generate) {
     // Buffer the generated media so we can tell success from a silent failure. A
     // streaming content provider commits a 200 before the backend runs, so a backend
@@ -3959,7 +6354,7 @@ void Server::serve_media_or_error(httplib::Response& res, const std::string& mim
             {"message", "Generation failed: the backend produced no output (it likely crashed or ran "
                         "out of GPU memory). Check the server logs."},
             {"type", "backend_error"}}}}.dump(), "application/json");
-        return;
+        return false;
     }
     if (auto error_payload = extract_error_payload(buf); !error_payload.is_null()) {
         res.status = 500;
@@ -3971,9 +6366,10 @@ void Server::serve_media_or_error(httplib::Response& res, const std::string& mim
             }
         }
         res.set_content(error_payload.dump(), "application/json");
-        return;
+        return false;
     }
     res.set_content(buf, mime_type);
+    return true;
 }
 
 void Server::handle_audio_generations(const httplib::Request& req, httplib::Response& res) {
@@ -4157,6 +6553,54 @@ void Server::handle_3d_generations(const httplib::Request& req, httplib::Respons
     }
 }
 
+void Server::externalize_image_response(const nlohmann::json& request_json,
+                                        nlohmann::json& response) {
+    if (!image_result_store_ ||
+        request_json.value("response_format", "b64_json") != "url") {
+        return;
+    }
+    if (!response.is_object() || response.contains("error") ||
+        !response.contains("data") || !response["data"].is_array()) {
+        return;
+    }
+    for (auto& item : response["data"]) {
+        if (!item.is_object() || !item.contains("b64_json") ||
+            !item["b64_json"].is_string()) {
+            continue;
+        }
+        const std::string bytes =
+            utils::JsonUtils::base64_decode(item["b64_json"].get<std::string>());
+        if (bytes.empty()) {
+            continue;
+        }
+        const std::string key = image_result_store_->store(bytes, "png");
+        if (key.empty()) {
+            continue;
+        }
+        item.erase("b64_json");
+        item["url"] = "/v1/images/" + key;
+    }
+}
+
+void Server::handle_image_get(const httplib::Request& req, httplib::Response& res) {
+    const std::string key = req.matches[1];
+    std::string format;
+    std::string bytes;
+    if (!image_result_store_ || !image_result_store_->lookup(key, format, bytes)) {
+        res.status = 404;
+        nlohmann::json error = {{"error", {
+            {"message", "No stored image for key: " + key},
+            {"type", "invalid_request_error"}
+        }}};
+        res.set_content(error.dump(), "application/json");
+        return;
+    }
+    // The key is a content hash, so the bytes at this URL can never change.
+    res.set_header("Cache-Control", "public, max-age=31536000, immutable");
+    const std::string mime = format == "jpg" ? "image/jpeg" : "image/" + format;
+    res.set_content(bytes, mime);
+}
+
 void Server::handle_image_generations(const httplib::Request& req, httplib::Response& res) {
     try {
         LOG(INFO, "Server") << "POST /api/v1/images/generations" << std::endl;
@@ -4186,6 +6630,14 @@ void Server::handle_image_generations(const httplib::Request& req, httplib::Resp
 
         std::string requested_model = request_json["model"];
 
+        const bool stream_requested = request_json.value("stream", false);
+        int priority = 0;
+        if (request_json.contains("priority") && request_json["priority"].is_number_integer()) {
+            priority = request_json["priority"].get<int>();
+        }
+        request_json.erase("stream");
+        request_json.erase("priority");
+
         try {
             auto_load_model_if_needed(requested_model, extract_auto_load_options(request_json));
         } catch (const std::exception& e) {
@@ -4197,12 +6649,136 @@ void Server::handle_image_generations(const httplib::Request& req, httplib::Resp
             return;
         }
 
+        std::string resolution = "default";
+        if (request_json.contains("size") && request_json["size"].is_string()) {
+            resolution = request_json["size"].get<std::string>();
+        } else if (request_json.contains("width") && request_json.contains("height") &&
+                   request_json["width"].is_number_integer() &&
+                   request_json["height"].is_number_integer()) {
+            resolution = std::to_string(request_json["width"].get<int>()) + "x" +
+                         std::to_string(request_json["height"].get<int>());
+        }
+        int steps = 0;
+        if (request_json.contains("steps") && request_json["steps"].is_number_integer()) {
+            steps = request_json["steps"].get<int>();
+        }
+        const std::string estimate_key = resolution + "@" + std::to_string(steps);
+
+        if (stream_requested) {
+            res.set_header("Cache-Control", "no-cache");
+            res.set_header("Connection", "keep-alive");
+            res.set_header("X-Accel-Buffering", "no");
+            res.set_chunked_content_provider("text/event-stream",
+                [this, request_json, priority, resolution, steps, estimate_key](
+                    size_t offset, httplib::DataSink& sink) {
+                    if (offset > 0) {
+                        return false;
+                    }
+                    SseWriter sse(sink);
+                    auto emit = [&sse](const nlohmann::json& event) {
+                        return sse.write_data(event);
+                    };
+
+                    auto ticket = image_queue_->enqueue(priority, resolution);
+                    size_t last_position = SIZE_MAX;
+                    while (!image_queue_->wait_for_turn(ticket, std::chrono::milliseconds(250))) {
+                        if (!sink.is_writable()) {
+                            image_queue_->cancel(ticket);
+                            return false;
+                        }
+                        const size_t pos = image_queue_->position(ticket);
+                        if (pos != last_position) {
+                            last_position = pos;
+                            if (!emit({{"type", "image_generation.queued"},
+                                       {"position", pos}})) {
+                                image_queue_->cancel(ticket);
+                                return false;
+                            }
+                        }
+                    }
+                    emit({{"type", "image_generation.started"}});
+
+                    const auto start = std::chrono::steady_clock::now();
+                    auto result = std::make_shared<nlohmann::json>();
+                    std::atomic<bool> done{false};
+                    std::thread worker([this, request_json, result, &done] {
+                        try {
+                            *result = router_->image_generations(request_json);
+                        } catch (const std::exception& e) {
+                            *result = nlohmann::json{{"error", {
+                                {"message", e.what()},
+                                {"type", "internal_error"}}}};
+                        }
+                        done = true;
+                    });
+                    while (!done) {
+                        std::this_thread::sleep_for(std::chrono::milliseconds(500));
+                        if (done) {
+                            break;
+                        }
+                        const auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+                            std::chrono::steady_clock::now() - start);
+                        nlohmann::json progress = {{"type", "image_generation.progress"},
+                                                   {"elapsed_ms", elapsed.count()},
+                                                   {"estimated", true}};
+                        const double fraction =
+                            image_queue_->estimated_fraction(estimate_key, elapsed);
+                        if (fraction >= 0.0) {
+                            progress["fraction"] = fraction;
+                            if (steps > 0) {
+                                progress["step"] = std::min(
+                                    steps - 1,
+                                    static_cast<int>(fraction * steps));
+                                progress["total_steps"] = steps;
+                            }
+                        }
+                        // Delivery failures are ignored: the generation can't be
+                        // aborted mid-run, so we finish and release the slot.
+                        emit(progress);
+                    }
+                    worker.join();
+                    const auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+                        std::chrono::steady_clock::now() - start);
+                    image_queue_->complete(
+                        ticket, result->contains("error") ? "" : estimate_key, elapsed);
+
+                    if (result->contains("error")) {
+                        LOG(ERROR, "Server") << "Image generation backend error: "
+                                             << result->dump() << std::endl;
+                        emit({{"type", "image_generation.error"}, {"response", *result}});
+                    } else {
+                        externalize_image_response(request_json, *result);
+                        emit({{"type", "image_generation.completed"}, {"response", *result}});
+                    }
+                    const std::string done_frame = "data: [DONE]\n\n";
+                    sink.write(done_frame.data(), done_frame.size());
+                    sink.done();
+                    return false;
+                });
+            return;
+        }
+
         {
-            auto response = router_->image_generations(request_json);
+            auto ticket = image_queue_->enqueue(priority, resolution);
+            while (!image_queue_->wait_for_turn(ticket, std::chrono::seconds(5))) {
+            }
+            const auto start = std::chrono::steady_clock::now();
+            nlohmann::json response;
+            try {
+                response = router_->image_generations(request_json);
+            } catch (...) {
+                image_queue_->complete(ticket, "", std::chrono::milliseconds(0));
+                throw;
+            }
+            const auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+                std::chrono::steady_clock::now() - start);
+            image_queue_->complete(
+                ticket, response.contains("error") ? "" : estimate_key, elapsed);
             if (response.contains("error")) {
                 LOG(ERROR, "Server") << "Image generation backend error: " << response.dump() << std::endl;
                 res.status = 500;
             }
+            externalize_image_response(request_json, response);
             res.set_content(response.dump(), "application/json");
         }
 
@@ -4422,6 +6998,7 @@ void Server::handle_image_edits(const httplib::Request& req, httplib::Response&
             LOG(ERROR, "Server") << "Image edits backend error: " << response.dump() << std::endl;
             res.status = 500;
         }
+        externalize_image_response(request_json, response);
         res.set_content(response.dump(), "application/json");
 
     } catch (const nlohmann::json::exception& e) {
@@ -4474,6 +7051,7 @@ void Server::handle_image_variations(const httplib::Request& req, httplib::Respo
             LOG(ERROR, "Server") << "Image variations backend error: " << response.dump() << std::endl;
             res.status = 500;
         }
+        externalize_image_response(request_json, response);
         res.set_content(response.dump(), "application/json");
 
     } catch (const nlohmann::json::exception& e) {
@@ -4685,6 +7263,12 @@ void Server::handle_responses(const httplib::Request& req, httplib::Response& re
         std::optional<RouterDispatchResult> route_dispatch =
             apply_router_collection_dispatch(request_json);
 
+        if (response_store_ && request_json.value("background", false)) {
+            request_json.erase("background");
+            handle_responses_background(std::move(request_json), res);
+            return;
+        }
+
         // Handle model loading/switching using helper function
         if (request_json.contains("model")) {
             std::string requested_model = request_json["model"];
@@ -4708,6 +7292,10 @@ void Server::handle_responses(const httplib::Request& req, httplib::Response& re
         // Check if streaming is requested
         bool is_streaming = request_json.contains("stream") && request_json["stream"].get<bool>();
 
+        std::map<std::string, std::pair<std::string, std::string>> mcp_chat_tools;
+        const bool mcp_tools_requested =
+            expand_mcp_request_tools(request_json, mcp_chat_tools);
+
         // Re-serialize so any collection.router model rewrite reaches the backend
         // (streaming forwards this body verbatim).
         std::string request_body = request_json.dump();
@@ -4717,6 +7305,7 @@ void Server::handle_responses(const httplib::Request& req, httplib::Response& re
                 LOG(INFO, "Server") << "POST /api/v1/responses - Streaming" << std::endl;
 
                 set_route_decision_sse_content_provider(
+                    req,
                     res,
                     route_dispatch,
                     request_body,
@@ -4731,7 +7320,9 @@ void Server::handle_responses(const httplib::Request& req, httplib::Response& re
         } else {
             LOG(INFO, "Server") << "POST /api/v1/responses - Non-streaming" << std::endl;
 
-            auto response = router_->responses(request_json);
+            auto response = mcp_tools_requested
+                ? run_responses_mcp_tool_loop(std::move(request_json), mcp_chat_tools)
+                : router_->responses(request_json);
 
             if (response.contains("error")) {
                 LOG(ERROR, "Server") << "Responses backend error: " << response["error"].dump() << std::endl;
@@ -4755,6 +7346,287 @@ void Server::handle_responses(const httplib::Request& req, httplib::Response& re
         res.set_content(error.dump(), "application/json");
     }
 }
+
+bool Server::expand_mcp_request_tools(
+    nlohmann::json& request_json,
+    std::map<std::string, std::pair<std::string, std::string>>& chat_tools) {
+    if (!mcp_client_manager_ || !request_json.contains("tools") ||
+        !request_json["tools"].is_array()) {
+        return false;
+    }
+
+    bool requested = false;
+    bool all_servers = false;
+    std::set<std::string> allowed_servers;
+    nlohmann::json kept_tools = nlohmann::json::array();
+    for (auto& tool : request_json["tools"]) {
+        if (!tool.is_object() || tool.value("type", "") != "mcp") {
+            kept_tools.push_back(std::move(tool));
+            continue;
+        }
+        requested = true;
+        // Accept both our server ids and OpenAI's remote-MCP field name.
+        const char* id_field = tool.contains("server_id") ? "server_id" : "server_label";
+        if (tool.contains(id_field) && tool[id_field].is_string()) {
+            allowed_servers.insert(tool[id_field].get<std::string>());
+        } else {
+            all_servers = true;
+        }
+    }
+    if (!requested) return false;
+
+    const nlohmann::json catalog = mcp_client_manager_->list_tools_json();
+    for (const auto& tool : catalog.value("tools", nlohmann::json::array())) {
+        const std::string server_id = tool.value("server_id", std::string());
+        if (!all_servers && !allowed_servers.count(server_id)) continue;
+        const std::string chat_name = tool.value("chat_name", std::string());
+        if (chat_name.empty() || !tool.contains("openai_tool")) continue;
+        chat_tools[chat_name] = {server_id, tool.value("name", std::string())};
+        kept_tools.push_back(tool["openai_tool"]);
+    }
+    request_json["tools"] = std::move(kept_tools);
+    return true;
+}
+
+static std::string mcp_call_output_text(const nlohmann::json& result) {
+    std::string text;
+    if (result.contains("content") && result["content"].is_array()) {
+        for (const auto& part : result["content"]) {
+            if (part.is_object() && part.value("type", "") == "text" &&
+                part.contains("text") && part["text"].is_string()) {
+                text += part["text"].get<std::string>();
+            }
+        }
+    }
+    return text.empty() ? result.dump() : text;
+}
+
+nlohmann::json Server::run_responses_mcp_tool_loop(
+    nlohmann::json request_json,
+    const std::map<std::string, std::pair<std::string, std::string>>& chat_tools) {
+    constexpr int kMaxMcpToolRounds = 8;
+
+    nlohmann::json executed_calls = nlohmann::json::array();
+    nlohmann::json response;
+    for (int round = 0;; ++round) {
+        response = router_->responses(request_json);
+        if (response.contains("error") || !response.contains("output") ||
+            !response["output"].is_array() || round >= kMaxMcpToolRounds) {
+            break;
+        }
+
+        // Only continue server-side when every tool call this turn is an MCP
+        // tool; a mixed turn goes back to the client, which owns its own tools.
+        std::vector<nlohmann::json> calls;
+        bool client_tool_call = false;
+        for (const auto& item : response["output"]) {
+            if (!item.is_object() || item.value("type", "") != "function_call") {
+                continue;
+            }
+            if (chat_tools.count(item.value("name", std::string()))) {
+                calls.push_back(item);
+            } else {
+                client_tool_call = true;
+            }
+        }
+        if (calls.empty() || client_tool_call) break;
+
+        if (!request_json.contains("input") || !request_json["input"].is_array()) {
+            nlohmann::json history = nlohmann::json::array();
+            if (request_json.contains("input") && request_json["input"].is_string()) {
+                history.push_back({{"role", "user"},
+                                   {"content", request_json["input"]}});
+            }
+            request_json["input"] = std::move(history);
+        }
+
+        for (const auto& call : calls) {
+            const auto& target = chat_tools.at(call.value("name", std::string()));
+
+            nlohmann::json arguments = nlohmann::json::object();
+            if (call.contains("arguments") && call["arguments"].is_string()) {
+                try {
+                    arguments = nlohmann::json::parse(
+                        call["arguments"].get<std::string>());
+                } catch (const nlohmann::json::parse_error&) {
+                }
+                if (!arguments.is_object()) arguments = nlohmann::json::object();
+            } else if (call.contains("arguments") && call["arguments"].is_object()) {
+                arguments = call["arguments"];
+            }
+
+            std::string output_text;
+            try {
+                const nlohmann::json result = mcp_client_manager_->call_tool_json(
+                    target.first,
+                    {{"name", target.second}, {"arguments", arguments}});
+                output_text =
+                    mcp_call_output_text(result.value("result", nlohmann::json::object()));
+            } catch (const std::exception& e) {
+                LOG(WARNING, "Server") << "MCP tool call failed: " << e.what()
+                                       << std::endl;
+                output_text = std::string("MCP tool call failed: ") + e.what();
+            }
+
+            request_json["input"].push_back(call);
+            request_json["input"].push_back(
+                {{"type", "function_call_output"},
+                 {"call_id", call.value("call_id", std::string())},
+                 {"output", output_text}});
+            executed_calls.push_back(
+                {{"type", "mcp_call"},
+                 {"id", call.value("id", call.value("call_id", std::string()))},
+                 {"server_label", target.first},
+                 {"name", target.second},
+                 {"arguments", call.value("arguments", nlohmann::json())},
+                 {"output", output_text}});
+        }
+    }
+
+    // Surface the server-executed calls ahead of the final turn's output, the
+    // way OpenAI reports remote MCP calls.
+    if (!executed_calls.empty() && response.is_object() &&
+        response.contains("output") && response["output"].is_array()) {
+        for (auto& item : response["output"]) {
+            executed_calls.push_back(std::move(item));
+        }
+        response["output"] = std::move(executed_calls);
+    }
+    return response;
+}
+
+void Server::handle_responses_background(nlohmann::json request_json,
+                                         httplib::Response& res) {
+    if (!request_json.contains("model") && !router_->is_model_loaded()) {
+        res.status = 400;
+        res.set_content("{\"error\": \"No model loaded and no model specified in request\"}", "application/json");
+        return;
+    }
+
+    const std::string id = response_store_->create(request_json);
+    LOG(INFO, "Server") << "POST /api/v1/responses - Background " << id << std::endl;
+
+    std::thread([this, id, body = std::move(request_json)]() mutable {
+        run_background_response(id, std::move(body));
+    }).detach();
+
+    res.set_content(response_store_->get(id).dump(), "application/json");
+}
+
+void Server::run_background_response(const std::string& id,
+                                     nlohmann::json request_json) {
+    try {
+        if (request_json.contains("model")) {
+            auto_load_model_if_needed(request_json["model"],
+                                      extract_auto_load_options(request_json));
+        }
+        if (response_store_->is_terminal(id)) {
+            return;
+        }
+        response_store_->mark_in_progress(id);
+
+        const bool is_streaming = request_json.value("stream", false);
+        if (is_streaming) {
+            httplib::DataSink sink;
+            sink.write = [this, &id](const char* data, size_t len) {
+                return response_store_->append_event(id, std::string(data, len));
+            };
+            sink.is_writable = [this, &id]() {
+                return !response_store_->is_terminal(id);
+            };
+            sink.done = []() {};
+            router_->responses_stream(request_json.dump(), sink);
+            response_store_->finalize_from_events(id);
+        } else {
+            auto response = router_->responses(request_json);
+            if (response.contains("error")) {
+                response_store_->fail(id, response["error"].dump());
+            } else {
+                response_store_->complete(id, response);
+            }
+        }
+    } catch (const std::exception& e) {
+        LOG(ERROR, "Server") << "Background response " << id << " failed: "
+                             << e.what() << std::endl;
+        response_store_->fail(id, e.what());
+    }
+}
+
+void Server::handle_response_get(const httplib::Request& req, httplib::Response& res) {
+    const std::string id = req.matches[1];
+    if (!response_store_ || !response_store_->exists(id)) {
+        res.status = 404;
+        res.set_content(nlohmann::json{{"error", "unknown response id"}}.dump(),
+                        "application/json");
+        return;
+    }
+
+    if (req.get_param_value("stream") != "true") {
+        res.set_content(response_store_->get(id).dump(), "application/json");
+        return;
+    }
+
+    size_t cursor = 0;
+    if (req.has_param("starting_after")) {
+        cursor = static_cast<size_t>(
+            std::atoll(req.get_param_value("starting_after").c_str()));
+    }
+
+    res.set_header("Cache-Control", "no-cache");
+    res.set_header("Connection", "keep-alive");
+    res.set_header("X-Accel-Buffering", "no");
+    res.set_chunked_content_provider("text/event-stream",
+        [this, id, cursor](size_t offset, httplib::DataSink& sink) {
+            if (offset > 0) {
+                return false;
+            }
+            // Replay what the detached run captured so far, then follow
+            // until the run reaches a terminal state and the cursor drains.
+            size_t next = cursor;
+            while (true) {
+                const bool terminal = response_store_->is_terminal(id);
+                for (const auto& chunk : response_store_->events_after(id, next, &next)) {
+                    if (!sink.write(chunk.data(), chunk.size())) {
+                        return false;
+                    }
+                }
+                if (terminal) {
+                    break;
+                }
+                std::this_thread::sleep_for(std::chrono::milliseconds(100));
+            }
+            sink.done();
+            return false;
+        });
+}
+
+void Server::handle_response_cancel(const httplib::Request& req, httplib::Response& res) {
+    const std::string id = req.matches[1];
+    if (!response_store_ || !response_store_->cancel(id)) {
+        res.status = 404;
+        res.set_content(
+            nlohmann::json{{"error", "response not found or already finished"}}.dump(),
+            "application/json");
+        return;
+    }
+    res.set_content(response_store_->get(id).dump(), "application/json");
+}
+
+void Server::handle_response_delete(const httplib::Request& req, httplib::Response& res) {
+    const std::string id = req.matches[1];
+    if (!response_store_ || !response_store_->is_terminal(id) ||
+        !response_store_->remove(id)) {
+        const bool exists = response_store_ && response_store_->exists(id);
+        res.status = exists ? 409 : 404;
+        res.set_content(
+            nlohmann::json{{"error", exists ? "response is still running"
+                                            : "unknown response id"}}.dump(),
+            "application/json");
+        return;
+    }
+    res.set_content(R"({"status":"deleted"})", "application/json");
+}
+
 bool Server::parse_required_json_body(const httplib::Request& req,
                                       httplib::Response& res,
                                       nlohmann::json& out) {
@@ -4764,15 +7636,14 @@ bool Server::parse_required_json_body(const httplib::Request& req,
         res.set_content(error.dump(), "application/json");
         return false;
     }
-    try {
-        out = nlohmann::json::parse(req.body);
+    std::string parse_error;
+    if (parse_request_json(req.body, out, &parse_error)) {
         return true;
-    } catch (const nlohmann::json::parse_error& e) {
-        res.status = 400;
-        nlohmann::json error = {{"error", std::string("Invalid JSON in request body: ") + e.what()}};
-        res.set_content(error.dump(), "application/json");
-        return false;
     }
+    res.status = 400;
+    nlohmann::json error = {{"error", "Invalid JSON in request body: " + parse_error}};
+    res.set_content(error.dump(), "application/json");
+    return false;
 }
 
 void Server::handle_pull(const httplib::Request& req, httplib::Response& res) {
@@ -4955,6 +7826,7 @@ void Server::handle_pull(const httplib::Request& req, httplib::Response& res) {
         } else {
             // Legacy synchronous mode - blocks until complete
             model_manager_->download_model(model_name, request_json, do_not_upgrade);
+            maybe_enforce_store_quota();
 
             nlohmann::json response = {{"status", "success"}, {"model_name", model_name}};
             res.set_content(response.dump(), "application/json");
@@ -4981,7 +7853,23 @@ void Server::handle_registry_search(const httplib::Request& req, httplib::Respon
         const auto first = query.find_first_not_of(" \t\r\n");
         const auto last = query.find_last_not_of(" \t\r\n");
         query = first == std::string::npos ? "" : query.substr(first, last - first + 1);
-        if (query.size() < 3) {
+
+        const std::string source_text = req.has_param("source")
+            ? req.get_param_value("source") : "huggingface";
+
+        // Local searches hit the in-memory registry index, so single-character
+        // search-as-you-type queries are fine; remote sources keep the
+        // 3-character floor to avoid hammering upstream APIs.
+        if (source_text == "local") {
+            if (query.empty()) {
+                res.status = 400;
+                res.set_content(nlohmann::json{{"error", {
+                    {"message", "Query parameter 'query' must not be empty"},
+                    {"type", "invalid_request_error"}
+                }}}.dump(), "application/json");
+                return;
+            }
+        } else if (query.size() < 3) {
             res.status = 400;
             res.set_content(nlohmann::json{{"error", {
                 {"message", "Query parameter 'query' must contain at least 3 characters"},
@@ -4990,10 +7878,6 @@ void Server::handle_registry_search(const httplib::Request& req, httplib::Respon
             return;
         }
 
-        const std::string source_text = req.has_param("source")
-            ? req.get_param_value("source") : "huggingface";
-        const auto source = parse_remote_registry_source(source_text);
-
         std::size_t limit = 12;
         if (req.has_param("limit")) {
             const std::string limit_text = req.get_param_value("limit");
@@ -5011,6 +7895,29 @@ void Server::handle_registry_search(const httplib::Request& req, httplib::Respon
             limit = parsed;
         }
 
+        if (source_text == "local") {
+            nlohmann::json results = nlohmann::json::array();
+            for (const auto& model : model_manager_->search_models(query, limit)) {
+                results.push_back({
+                    {"model_name", model.model_name},
+                    {"recipe", model.recipe},
+                    {"labels", model.labels},
+                    {"downloaded", model.downloaded},
+                    {"suggested", model.suggested},
+                    {"size", model.size}
+                });
+            }
+            res.set_content(nlohmann::json{
+                {"source", "local"},
+                {"query", query},
+                {"total", results.size()},
+                {"results", std::move(results)}
+            }.dump(), "application/json");
+            return;
+        }
+
+        const auto source = parse_remote_registry_source(source_text);
+
         bool gguf_only = false;
         if (req.has_param("format")) {
             const std::string format = req.get_param_value("format");
@@ -5097,6 +8004,17 @@ void Server::handle_pull_variants(const httplib::Request& req, httplib::Response
         const std::string source = req.has_param("source")
             ? req.get_param_value("source") : "huggingface";
         const auto parsed_source = parse_remote_registry_source(source);
+        const std::string source_name = remote_registry_source_name(parsed_source);
+        const auto ttl = std::chrono::minutes(config_->variant_cache_ttl_minutes());
+        if (variant_cache_ && ttl.count() > 0) {
+            // In offline mode a stale entry beats no data; online, expired
+            // entries fall through to a fresh fetch.
+            if (auto cached = variant_cache_->lookup(source_name, checkpoint, ttl,
+                                                     config_->offline())) {
+                res.set_content(cached->dump(), "application/json");
+                return;
+            }
+        }
         if (config_->offline()) {
             res.status = 400;
             nlohmann::json error = {{"error", "Lemond is in offline mode, models not downloaded"}, {"code", "lemond_offline"}};
@@ -5105,7 +8023,10 @@ void Server::handle_pull_variants(const httplib::Request& req, httplib::Response
         }
         bool not_found = false;
         nlohmann::json body = lemon::fetch_pull_variants(
-            checkpoint, remote_registry_source_name(parsed_source), not_found);
+            checkpoint, source_name, not_found);
+        if (variant_cache_ && ttl.count() > 0 && !not_found) {
+            variant_cache_->store(source_name, checkpoint, body);
+        }
         if (not_found) {
             res.status = 404;
             nlohmann::json error = {{"error", "Checkpoint '" + checkpoint + "' not found on " +
@@ -5301,6 +8222,81 @@ void Server::handle_unload(const httplib::Request& req, httplib::Response& res)
     }
 }
 
+void Server::handle_prewarm(const httplib::Request& req, httplib::Response& res) {
+    nlohmann::json request_json;
+    if (!parse_required_json_body(req, res, request_json)) return;
+
+    static constexpr size_t kMaxPrewarmModels = 8;
+
+    if (!request_json.contains("models") || !request_json["models"].is_array() ||
+        request_json["models"].empty()) {
+        res.status = 400;
+        res.set_content(nlohmann::json{{"error",
+            "'models' must be a non-empty array of model names"}}.dump(),
+            "application/json");
+        return;
+    }
+
+    std::vector<std::string> models;
+    for (const auto& entry : request_json["models"]) {
+        if (!entry.is_string()) {
+            res.status = 400;
+            res.set_content(nlohmann::json{{"error",
+                "'models' entries must be strings"}}.dump(), "application/json");
+            return;
+        }
+        const std::string name = entry.get<std::string>();
+        if (std::find(models.begin(), models.end(), name) == models.end()) {
+            models.push_back(name);
+        }
+    }
+    if (models.size() > kMaxPrewarmModels) {
+        res.status = 400;
+        res.set_content(nlohmann::json{{"error",
+            "'models' lists more than " + std::to_string(kMaxPrewarmModels) +
+            " models"}}.dump(), "application/json");
+        return;
+    }
+
+    for (const auto& name : models) {
+        if (!model_manager_->model_exists(name)) {
+            res.status = 404;
+            auto error_response = create_model_error(name, "Model not found");
+            res.set_content(error_response.dump(), "application/json");
+            return;
+        }
+    }
+
+    const std::string source = request_json.value("source", std::string());
+    nlohmann::json load_options = request_json.value("options", nlohmann::json::object());
+    if (!load_options.is_object()) {
+        load_options = nlohmann::json::object();
+    }
+
+    LOG(INFO, "Server") << "Prewarming " << models.size() << " model(s)"
+                        << (source.empty() ? "" : " for " + source) << std::endl;
+
+    // Accept-then-load: the caller (typically `lemonade launch`) must not block
+    // on model bring-up, so the loads run in the background and the Router
+    // serializes the actual work.
+    for (const auto& name : models) {
+        std::thread([this, name, load_options]() {
+            try {
+                auto_load_model_if_needed(name, load_options);
+            } catch (const std::exception& e) {
+                LOG(WARNING, "Server") << "Prewarm of '" << name
+                                       << "' failed: " << e.what() << std::endl;
+            }
+        }).detach();
+    }
+
+    nlohmann::json response = {
+        {"status", "accepted"},
+        {"models", models}
+    };
+    res.set_content(response.dump(), "application/json");
+}
+
 void Server::handle_pin(const httplib::Request& req, httplib::Response& res) {
     try {
         nlohmann::json request_json;
@@ -5377,22 +8373,42 @@ void Server::handle_delete(const httplib::Request& req, httplib::Response& res)
             router_->unload_model(model_name);
         }
 
-        // Retry delete with delays to handle in-progress downloads releasing file handles
-        // This handles the race condition where a cancelled download hasn't yet released
-        // its file handles when the delete request arrives
+        // Retry the unlink with delays to handle in-progress downloads releasing
+        // file handles (incomplete-download cleanup still touches partial files
+        // on the request thread).
         const int max_retries = 3;
         const int retry_delay_seconds = 5;
         std::string last_error;
 
         for (int attempt = 0; attempt <= max_retries; ++attempt) {
             try {
-                model_manager_->delete_model(model_name);
+                auto pending = model_manager_->unlink_model(model_name);
 
-                // Success - send response and return
                 nlohmann::json response = {
                     {"status", "success"},
                     {"message", "Deleted model: " + model_name}
                 };
+                if (!pending.empty() && job_manager_) {
+                    // File removal runs as a background job so a slow
+                    // filesystem cannot pin this HTTP worker; the model is
+                    // already gone from the registry.
+                    std::vector<lemon::jobs::StepRecord> steps;
+                    for (const auto& p : pending) {
+                        lemon::jobs::StepRecord step;
+                        step.id = "gc-" + std::to_string(steps.size());
+                        step.op = "model_gc";
+                        step.params = lemon::jobs::json::parse(p.to_json().dump());
+                        steps.push_back(std::move(step));
+                    }
+                    const std::string job_id = job_manager_->create(
+                        "delete " + model_name, std::move(steps),
+                        lemon::jobs::json::object());
+                    response["job_id"] = job_id;
+                } else {
+                    for (const auto& p : pending) {
+                        model_manager_->gc_pending_delete(p, nullptr);
+                    }
+                }
                 res.set_content(response.dump(), "application/json");
                 return;
 
@@ -5440,13 +8456,167 @@ void Server::handle_cleanup_cache(const httplib::Request& req, httplib::Response
         auto request_json = nlohmann::json::parse(req.body);
         bool dry_run = request_json.value("dry_run", true);
 
-        auto result = model_manager_->cleanup_orphaned_cache(dry_run);
-        res.set_content(result.dump(), "application/json");
+        if (!dry_run && job_manager_) {
+            // Enumerate synchronously for the response; the actual deletion
+            // runs as a job so the scan-and-delete never blocks this worker.
+            auto result = model_manager_->cleanup_orphaned_cache(true);
+            lemon::jobs::StepRecord step;
+            step.id = "gc";
+            step.op = "cache_gc";
+            result["dry_run"] = false;
+            result["job_id"] = job_manager_->create(
+                "cache cleanup", {std::move(step)}, lemon::jobs::json::object());
+            res.set_content(result.dump(), "application/json");
+            return;
+        }
+
+        auto result = model_manager_->cleanup_orphaned_cache(dry_run);
+        res.set_content(result.dump(), "application/json");
+    } catch (const std::exception& e) {
+        LOG(ERROR, "Server") << "ERROR in handle_cleanup_cache: " << e.what() << std::endl;
+        res.status = 500;
+        auto error_response = create_model_error("", e.what());
+        res.set_content(error_response.dump(), "application/json");
+    }
+}
+
+void Server::handle_store_gc(const httplib::Request& req, httplib::Response& res) {
+    try {
+        bool dry_run = true;
+        if (!req.body.empty()) {
+            auto request_json = nlohmann::json::parse(req.body);
+            dry_run = request_json.value("dry_run", true);
+        }
+        res.set_content(enforce_store_quota(dry_run).dump(), "application/json");
+    } catch (const std::exception& e) {
+        LOG(ERROR, "Server") << "ERROR in handle_store_gc: " << e.what() << std::endl;
+        res.status = 500;
+        nlohmann::json error = {{"error", e.what()}};
+        res.set_content(error.dump(), "application/json");
+    }
+}
+
+nlohmann::json Server::enforce_store_quota(bool dry_run) {
+    constexpr double kBytesPerGb = 1024.0 * 1024.0 * 1024.0;
+    const double quota_gb = config_->model_store_quota_gb();
+
+    nlohmann::json result = {
+        {"enabled", quota_gb > 0.0},
+        {"quota_gb", quota_gb},
+        {"dry_run", dry_run},
+        {"evictions", nlohmann::json::array()}
+    };
+    if (quota_gb <= 0.0) {
+        return result;
+    }
+
+    auto downloaded = model_manager_->get_downloaded_models();
+
+    // Components of downloaded collections stay protected: deleting one would
+    // break a model the user still has.
+    std::set<std::string> referenced;
+    for (const auto& [name, info] : downloaded) {
+        referenced.insert(info.components.begin(), info.components.end());
+    }
+
+    std::map<std::string, ModelPreloader::UsageStat> usage;
+    if (model_preloader_) {
+        usage = model_preloader_->usage_snapshot();
+    }
+
+    const int64_t now = std::chrono::duration_cast<std::chrono::seconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+
+    std::vector<StoreCandidate> candidates;
+    uint64_t store_bytes = 0;
+    for (const auto& [name, info] : downloaded) {
+        // local_path / extra_models_dir files live outside the cache, so they
+        // neither count toward the quota nor get evicted.
+        if (info.source == "local_path" || info.source == "extra_models_dir") {
+            continue;
+        }
+        StoreCandidate candidate;
+        candidate.model = name;
+        candidate.size_bytes = static_cast<uint64_t>(info.size * kBytesPerGb);
+        // local_upload data is irreplaceable — the server cannot re-download
+        // what the user imported from their own disk.
+        candidate.pinned = info.source == "local_upload" ||
+                           referenced.count(name) > 0 ||
+                           router_->is_model_loaded(name);
+        auto it = usage.find(name);
+        if (it != usage.end()) {
+            candidate.last_used = it->second.last_used;
+            candidate.use_count = it->second.total_uses;
+        }
+        store_bytes += candidate.size_bytes;
+        candidates.push_back(std::move(candidate));
+    }
+    result["store_gb"] = static_cast<double>(store_bytes) / kBytesPerGb;
+
+    const uint64_t quota_bytes = static_cast<uint64_t>(quota_gb * kBytesPerGb);
+    auto plan = StoreEvictionPolicy::plan(std::move(candidates), quota_bytes, now);
+
+    std::vector<lemon::jobs::StepRecord> steps;
+    uint64_t freed_bytes = 0;
+    for (const auto& candidate : plan) {
+        nlohmann::json entry = {
+            {"model", candidate.model},
+            {"size_gb", static_cast<double>(candidate.size_bytes) / kBytesPerGb},
+            {"last_used", candidate.last_used},
+            {"score", StoreEvictionPolicy::eviction_score(candidate, now)}
+        };
+        if (!dry_run) {
+            try {
+                auto pending = model_manager_->unlink_model(candidate.model);
+                for (const auto& p : pending) {
+                    lemon::jobs::StepRecord step;
+                    step.id = "gc-" + std::to_string(steps.size());
+                    step.op = "model_gc";
+                    step.params = lemon::jobs::json::parse(p.to_json().dump());
+                    steps.push_back(std::move(step));
+                }
+            } catch (const std::exception& e) {
+                LOG(WARNING, "Server") << "Store GC failed to evict "
+                                        << candidate.model << ": " << e.what() << std::endl;
+                entry["error"] = e.what();
+                result["evictions"].push_back(std::move(entry));
+                continue;
+            }
+        }
+        freed_bytes += candidate.size_bytes;
+        result["evictions"].push_back(std::move(entry));
+    }
+    result["freed_gb"] = static_cast<double>(freed_bytes) / kBytesPerGb;
+
+    if (!steps.empty()) {
+        if (job_manager_) {
+            result["job_id"] = job_manager_->create(
+                "store gc", std::move(steps), lemon::jobs::json::object());
+        } else {
+            for (const auto& step : steps) {
+                model_manager_->gc_pending_delete(
+                    ModelManager::PendingDelete::from_json(
+                        nlohmann::json::parse(step.params.dump())), nullptr);
+            }
+        }
+    }
+    return result;
+}
+
+void Server::maybe_enforce_store_quota() {
+    if (config_->model_store_quota_gb() <= 0.0) {
+        return;
+    }
+    try {
+        auto result = enforce_store_quota(false);
+        if (!result["evictions"].empty()) {
+            LOG(INFO, "Server") << "Store GC evicted " << result["evictions"].size()
+                                 << " model(s), freed " << result.value("freed_gb", 0.0)
+                                 << " GB" << std::endl;
+            invalidate_models_cache();
+        }
     } catch (const std::exception& e) {
-        LOG(ERROR, "Server") << "ERROR in handle_cleanup_cache: " << e.what() << std::endl;
-        res.status = 500;
-        auto error_response = create_model_error("", e.what());
-        res.set_content(error_response.dump(), "application/json");
+        LOG(WARNING, "Server") << "Store GC failed: " << e.what() << std::endl;
     }
 }
 
@@ -5734,6 +8904,44 @@ void Server::handle_stats(const httplib::Request& req, httplib::Response& res) {
     }
 }
 
+void Server::handle_queue(const httplib::Request& req, httplib::Response& res) {
+    try {
+        const bool stream = req.has_param("stream") &&
+            req.get_param_value("stream") == "true";
+        if (!stream) {
+            res.set_content(router_->get_queue_snapshot().dump(), "application/json");
+            return;
+        }
+
+        // SSE mode for clients waiting on a queued request: one snapshot per
+        // tick, closing once the queue drains so subscribers don't idle open.
+        res.set_header("Cache-Control", "no-cache");
+        res.set_header("Connection", "keep-alive");
+        res.set_header("X-Accel-Buffering", "no");
+        res.set_chunked_content_provider(
+            "text/event-stream",
+            [this](size_t /*offset*/, httplib::DataSink& sink) {
+                nlohmann::json snapshot = router_->get_queue_snapshot();
+                SseWriter sse(sink);
+                if (!sse.write_data(snapshot)) {
+                    return false;
+                }
+                if (snapshot["waiting"].empty() &&
+                    !snapshot.contains("load_in_progress")) {
+                    sink.done();
+                    return false;
+                }
+                std::this_thread::sleep_for(std::chrono::milliseconds(500));
+                return true;
+            });
+    } catch (const std::exception& e) {
+        LOG(ERROR, "Server") << "ERROR in handle_queue: " << e.what() << std::endl;
+        res.status = 500;
+        nlohmann::json error = {{"error", e.what()}};
+        res.set_content(error.dump(), "application/json");
+    }
+}
+
 void Server::handle_metrics(const httplib::Request& req, httplib::Response& res) {
     if (req.method == "HEAD") {
         res.status = 200;
@@ -5747,7 +8955,7 @@ void Server::handle_metrics(const httplib::Request& req, httplib::Response& res)
         system_metrics.vram_gb = get_vram_usage();
         system_metrics.npu_percent = get_npu_utilization();
 
-        res.set_content(build_prometheus_metrics(*router_, system_metrics),
+        res.set_content(build_prometheus_metrics(*router_, system_metrics, stats_history_.get()),
                         "text/plain; version=0.0.4; charset=utf-8");
     } catch (const std::exception& e) {
         LOG(ERROR, "Server") << "ERROR in handle_metrics: " << e.what() << std::endl;
@@ -5848,28 +9056,183 @@ void Server::handle_system_stats(const httplib::Request& req, httplib::Response&
 
     nlohmann::json stats;
 
-    // CPU usage
-    double cpu_percent = get_cpu_usage();
-    stats["cpu_percent"] = (cpu_percent >= 0) ? nlohmann::json(cpu_percent) : nlohmann::json();
+    // Serve the background sampler's latest reading instead of querying the
+    // platform per request: the desktop app polls this endpoint, and on
+    // Windows the WMI queries behind it are expensive.
+    SystemStatsHistory::Sample sample;
+    std::vector<DeviceUtilization> device_samples;
+    const int64_t now = std::chrono::duration_cast<std::chrono::seconds>(
+                            std::chrono::system_clock::now().time_since_epoch())
+                            .count();
+    if (stats_history_ && stats_history_->latest(sample) && now - sample.timestamp <= 5) {
+        device_samples = sample.devices;
+        stats["cpu_percent"] =
+            (sample.cpu_percent >= 0) ? nlohmann::json(sample.cpu_percent) : nlohmann::json();
+        stats["memory_gb"] = (sample.memory_gb >= 0) ? sample.memory_gb : 0.0f;
+        stats["gpu_percent"] =
+            (sample.gpu_percent >= 0) ? nlohmann::json(sample.gpu_percent) : nlohmann::json();
+        stats["vram_gb"] =
+            (sample.vram_gb >= 0) ? nlohmann::json(sample.vram_gb) : nlohmann::json();
+        stats["npu_percent"] =
+            (sample.npu_percent >= 0) ? nlohmann::json(sample.npu_percent) : nlohmann::json();
+    } else {
+        double cpu_percent = get_cpu_usage();
+        stats["cpu_percent"] = (cpu_percent >= 0) ? nlohmann::json(cpu_percent) : nlohmann::json();
+
+        stats["memory_gb"] = metrics_platform_->get_memory_usage_gb();
 
-    // Get memory info
-    stats["memory_gb"] = metrics_platform_->get_memory_usage_gb();
+        double gpu_percent = get_gpu_usage();
+        stats["gpu_percent"] = (gpu_percent >= 0) ? nlohmann::json(gpu_percent) : nlohmann::json();
 
-    // GPU usage
-    double gpu_percent = get_gpu_usage();
-    stats["gpu_percent"] = (gpu_percent >= 0) ? nlohmann::json(gpu_percent) : nlohmann::json();
+        double vram_gb = get_vram_usage();
+        stats["vram_gb"] = (vram_gb >= 0) ? nlohmann::json(vram_gb) : nlohmann::json();
 
-    // VRAM usage
-    double vram_gb = get_vram_usage();
-    stats["vram_gb"] = (vram_gb >= 0) ? nlohmann::json(vram_gb) : nlohmann::json();
+        double npu_percent = get_npu_utilization();
+        stats["npu_percent"] = (npu_percent >= 0) ? nlohmann::json(npu_percent) : nlohmann::json();
+
+        device_samples = metrics_platform_->get_device_utilization();
+    }
+
+    // Per-device utilization, attributing each device class to the loaded
+    // models whose recipe occupies it.
+    if (!device_samples.empty()) {
+        std::map<std::string, nlohmann::json> owners_by_class;
+        if (router_) {
+            for (const auto& m : router_->get_all_loaded_models()) {
+                const std::string name = m.value("model_name", "");
+                if (name.empty()) continue;
+                std::istringstream classes(m.value("device", std::string()));
+                std::string cls;
+                while (std::getline(classes, cls, '|')) {
+                    owners_by_class[cls].push_back(name);
+                }
+            }
+        }
+        nlohmann::json devices = nlohmann::json::array();
+        for (const auto& d : device_samples) {
+            nlohmann::json entry;
+            entry["device"] = d.device;
+            entry["busy_percent"] =
+                (d.busy_percent >= 0) ? nlohmann::json(d.busy_percent) : nlohmann::json();
+            if (d.memory_gb >= 0) entry["memory_gb"] = d.memory_gb;
+            const std::string cls = d.device.substr(0, d.device.find(':'));
+            auto owners = owners_by_class.find(cls);
+            if (owners != owners_by_class.end()) entry["models"] = owners->second;
+            devices.push_back(std::move(entry));
+        }
+        stats["devices"] = std::move(devices);
+    }
 
-    // NPU Utilization
-    double npu_percent = get_npu_utilization();
-    stats["npu_percent"] = (npu_percent >= 0) ? nlohmann::json(npu_percent) : nlohmann::json();
+    // Per-model backend queue stats (continuous-batching backends only)
+    if (router_) {
+        nlohmann::json queue = router_->snapshot_queue_stats();
+        if (!queue.empty()) {
+            stats["queue"] = std::move(queue);
+        }
+    }
 
     res.set_content(stats.dump(), "application/json");
 }
 
+void Server::handle_system_stats_history(const httplib::Request& req, httplib::Response& res) {
+    if (req.method == "HEAD") {
+        res.status = 200;
+        return;
+    }
+
+    int64_t since = 0;
+    if (req.has_param("seconds")) {
+        try {
+            int64_t seconds = std::stoll(req.get_param_value("seconds"));
+            if (seconds < 0) {
+                throw std::invalid_argument("seconds must be non-negative");
+            }
+            const int64_t now = std::chrono::duration_cast<std::chrono::seconds>(
+                                    std::chrono::system_clock::now().time_since_epoch())
+                                    .count();
+            since = now - seconds;
+        } catch (const std::exception&) {
+            res.status = 400;
+            nlohmann::json error = {{"error", "invalid 'seconds' parameter"}};
+            res.set_content(error.dump(), "application/json");
+            return;
+        }
+    }
+
+    nlohmann::json samples = nlohmann::json::array();
+    if (stats_history_) {
+        for (const auto& s : stats_history_->snapshot(since)) {
+            nlohmann::json entry;
+            entry["timestamp"] = s.timestamp;
+            entry["vram_gb"] = (s.vram_gb >= 0) ? nlohmann::json(s.vram_gb) : nlohmann::json();
+            entry["memory_gb"] = (s.memory_gb >= 0) ? nlohmann::json(s.memory_gb) : nlohmann::json();
+            entry["npu_percent"] =
+                (s.npu_percent >= 0) ? nlohmann::json(s.npu_percent) : nlohmann::json();
+            entry["cpu_percent"] =
+                (s.cpu_percent >= 0) ? nlohmann::json(s.cpu_percent) : nlohmann::json();
+            entry["gpu_percent"] =
+                (s.gpu_percent >= 0) ? nlohmann::json(s.gpu_percent) : nlohmann::json();
+            samples.push_back(std::move(entry));
+        }
+    }
+
+    nlohmann::json response;
+    response["interval_seconds"] = SystemStatsHistory::kDefaultIntervalMs / 1000;
+    response["retention_seconds"] = SystemStatsHistory::kCapacity;
+    response["samples"] = std::move(samples);
+    res.set_content(response.dump(), "application/json");
+}
+
+void Server::handle_router_events(const httplib::Request& req, httplib::Response& res) {
+    if (req.method == "HEAD") {
+        res.status = 200;
+        return;
+    }
+
+    int64_t since_ms = 0;
+    size_t limit = RouterJournal::kCapacity;
+    try {
+        if (req.has_param("seconds")) {
+            int64_t seconds = std::stoll(req.get_param_value("seconds"));
+            if (seconds < 0) {
+                throw std::invalid_argument("seconds must be non-negative");
+            }
+            const int64_t now_ms = std::chrono::duration_cast<std::chrono::milliseconds>(
+                                       std::chrono::system_clock::now().time_since_epoch())
+                                       .count();
+            since_ms = now_ms - seconds * 1000;
+        }
+        if (req.has_param("since_ms")) {
+            since_ms = std::stoll(req.get_param_value("since_ms"));
+            if (since_ms < 0) {
+                throw std::invalid_argument("since_ms must be non-negative");
+            }
+        }
+        if (req.has_param("limit")) {
+            int64_t requested = std::stoll(req.get_param_value("limit"));
+            if (requested <= 0) {
+                throw std::invalid_argument("limit must be positive");
+            }
+            limit = static_cast<size_t>(requested);
+        }
+    } catch (const std::exception&) {
+        res.status = 400;
+        nlohmann::json error = {{"error", "invalid time or limit parameter"}};
+        res.set_content(error.dump(), "application/json");
+        return;
+    }
+
+    nlohmann::json events = nlohmann::json::array();
+    for (const auto& event : RouterJournal::instance().snapshot(since_ms, limit)) {
+        events.push_back(RouterJournal::to_json(event));
+    }
+
+    nlohmann::json response;
+    response["capacity"] = RouterJournal::kCapacity;
+    response["events"] = std::move(events);
+    res.set_content(response.dump(), "application/json");
+}
+
 void Server::handle_log_level(const httplib::Request& req, httplib::Response& res) {
     try {
         auto request_json = nlohmann::json::parse(req.body);
@@ -5920,24 +9283,224 @@ void job_error(httplib::Response& res, int status, const std::string& message) {
 
 }
 
+void Server::handle_sessions_create(const httplib::Request& req, httplib::Response& res) {
+    nlohmann::json request_json;
+    if (!parse_required_json_body(req, res, request_json)) return;
+
+    if (!request_json.contains("model") || !request_json["model"].is_string() ||
+        request_json["model"].get<std::string>().empty()) {
+        res.status = 400;
+        res.set_content("{\"error\": \"'model' is required\"}", "application/json");
+        return;
+    }
+    normalize_client_model_name(request_json);
+
+    nlohmann::json initial = nlohmann::json::array();
+    if (request_json.contains("system_prompt") && request_json["system_prompt"].is_string()) {
+        initial.push_back({{"role", "system"},
+                           {"content", request_json["system_prompt"]}});
+    }
+    if (request_json.contains("messages") && request_json["messages"].is_array()) {
+        for (const auto& message : request_json["messages"]) {
+            initial.push_back(message);
+        }
+    }
+
+    const std::string model = request_json["model"].get<std::string>();
+    const std::string id = session_store_.create(model, initial,
+                                                 config_->max_chat_sessions());
+
+    nlohmann::json response = {
+        {"id", id},
+        {"model", model},
+        {"message_count", initial.size()}
+    };
+    res.set_content(response.dump(), "application/json");
+}
+
+void Server::handle_sessions_list(const httplib::Request& req, httplib::Response& res) {
+    (void)req;
+    nlohmann::json response = {{"sessions", session_store_.list()}};
+    res.set_content(response.dump(), "application/json");
+}
+
+void Server::handle_sessions_get(const httplib::Request& req, httplib::Response& res) {
+    const std::string session_id = req.matches[1];
+    auto snapshot = session_store_.get(session_id);
+    if (!snapshot) {
+        res.status = 404;
+        nlohmann::json error = {{"error", "Unknown session: " + session_id}};
+        res.set_content(error.dump(), "application/json");
+        return;
+    }
+    nlohmann::json response = {
+        {"id", snapshot->id},
+        {"model", snapshot->model},
+        {"turns", snapshot->turns},
+        {"messages", snapshot->messages}
+    };
+    res.set_content(response.dump(), "application/json");
+}
+
+void Server::handle_sessions_delete(const httplib::Request& req, httplib::Response& res) {
+    const std::string session_id = req.matches[1];
+    if (!session_store_.remove(session_id)) {
+        res.status = 404;
+        nlohmann::json error = {{"error", "Unknown session: " + session_id}};
+        res.set_content(error.dump(), "application/json");
+        return;
+    }
+    res.set_content("{\"status\": \"success\"}", "application/json");
+}
+
+void Server::handle_sessions_chat(const httplib::Request& req, httplib::Response& res) {
+    nlohmann::json request_json;
+    if (!parse_required_json_body(req, res, request_json)) return;
+
+    const std::string session_id = req.matches[1];
+
+    try {
+        if (!request_json.contains("messages") || !request_json["messages"].is_array() ||
+            request_json["messages"].empty()) {
+            res.status = 400;
+            res.set_content("{\"error\": \"'messages' must be a non-empty array of new messages\"}",
+                            "application/json");
+            return;
+        }
+        if (request_json.contains("stream") && request_json["stream"].is_boolean() &&
+            request_json["stream"].get<bool>()) {
+            res.status = 400;
+            res.set_content("{\"error\": \"Session chat does not support streaming; omit 'stream'\"}",
+                            "application/json");
+            return;
+        }
+
+        auto snapshot = session_store_.get(session_id);
+        if (!snapshot) {
+            res.status = 404;
+            nlohmann::json error = {{"error", "Unknown session: " + session_id}};
+            res.set_content(error.dump(), "application/json");
+            return;
+        }
+
+        const RequestPriority priority = resolve_request_priority(req);
+        auto admission = std::make_shared<AdmissionController::Ticket>(
+            AdmissionController::instance().admit(snapshot->model, priority));
+
+        const std::string quota_key = quota_key_for(req);
+        auto stream_lease = std::make_shared<RateLimiter::StreamLease>();
+        if (!RateLimiter::instance().acquire_stream(quota_key, *stream_lease)) {
+            res.status = 429;
+            res.set_header("Retry-After", "1");
+            res.set_content("{\"error\": \"Too many concurrent requests for this API key\"}",
+                            "application/json");
+            return;
+        }
+
+        nlohmann::json completion_request = request_json;
+        completion_request["model"] = snapshot->model;
+        completion_request["messages"] = snapshot->messages;
+        for (const auto& message : request_json["messages"]) {
+            completion_request["messages"].push_back(message);
+        }
+        completion_request["session_id"] = session_id;
+        completion_request["stream"] = false;
+
+        try {
+            auto_load_model_if_needed(snapshot->model,
+                                      extract_auto_load_options(completion_request));
+        } catch (const std::exception& e) {
+            LOG(ERROR, "Server") << "Failed to load model: " << e.what() << std::endl;
+            auto error_response = create_model_error(snapshot->model, e.what());
+            res.status = get_http_status_from_error(
+                error_response["error"]["code"].get<std::string>());
+            res.set_content(error_response.dump(), "application/json");
+            return;
+        }
+
+        if (router_->get_model_type(snapshot->model) != ModelType::LLM) {
+            res.status = 400;
+            res.set_content(R"({"error": {"message": "This model does not support chat completion. Only LLM models support this endpoint.", "type": "invalid_request_error"}})",
+                            "application/json");
+            return;
+        }
+
+        LOG(INFO, "Server") << "POST /api/v1/sessions/" << session_id << "/chat - 200 OK" << std::endl;
+        auto response = router_->chat_completion(completion_request);
+        if (response.contains("error")) {
+            LOG(ERROR, "Server") << "Backend returned error response: "
+                                 << response["error"].dump() << std::endl;
+            set_error_response(response, res);
+            return;
+        }
+        record_quota_tokens(quota_key, response);
+
+        // The turn is committed only after a successful completion so a failed
+        // or retried turn never duplicates user messages in the stored history.
+        nlohmann::json turn_messages = request_json["messages"];
+        if (response.contains("choices") && response["choices"].is_array() &&
+            !response["choices"].empty() && response["choices"][0].contains("message")) {
+            nlohmann::json assistant = response["choices"][0]["message"];
+            assistant.erase("reasoning_content");
+            turn_messages.push_back(assistant);
+        }
+        session_store_.append(session_id, turn_messages);
+
+        response["session_id"] = session_id;
+        res.set_content(response.dump(), "application/json");
+    } catch (const std::exception& e) {
+        LOG(ERROR, "Server") << "ERROR in handle_sessions_chat: " << e.what() << std::endl;
+        res.status = 500;
+        nlohmann::json error = {{"error", e.what()}};
+        res.set_content(error.dump(), "application/json");
+    }
+}
+
 void Server::handle_jobs_create(const httplib::Request& req, httplib::Response& res) {
     try {
         auto body = lemon::jobs::json::parse(req.body);
-        const std::string name = body.value("name", "");
-        lemon::jobs::json steps_json = lemon::jobs::json::array();
-        if (body.contains("definition") && body["definition"].is_object()
-            && body["definition"].contains("steps")) {
-            steps_json = body["definition"]["steps"];
-        } else if (body.contains("steps")) {
-            steps_json = body["steps"];
-        }
-        std::vector<lemon::jobs::StepRecord> steps;
-        if (steps_json.is_array())
-            for (const auto& s : steps_json)
-                steps.push_back(lemon::jobs::StepRecord::from_json(s));
-        lemon::jobs::json inputs =
-            body.contains("inputs") ? body["inputs"] : lemon::jobs::json::object();
-        const std::string id = job_manager_->create(name, std::move(steps), inputs);
+        const auto to_spec = [](const lemon::jobs::json& b) {
+            lemon::jobs::JobManager::JobSpec spec;
+            spec.name = b.value("name", "");
+            lemon::jobs::json steps_json = lemon::jobs::json::array();
+            if (b.contains("definition") && b["definition"].is_object()
+                && b["definition"].contains("steps")) {
+                steps_json = b["definition"]["steps"];
+            } else if (b.contains("steps")) {
+                steps_json = b["steps"];
+            }
+            if (steps_json.is_array())
+                for (const auto& s : steps_json)
+                    spec.steps.push_back(lemon::jobs::StepRecord::from_json(s));
+            spec.inputs = b.contains("inputs") ? b["inputs"] : lemon::jobs::json::object();
+            spec.priority = b.value("priority", 0);
+            spec.window = b.value("window", "");
+            return spec;
+        };
+        const bool bulk = body.is_array()
+                          || (body.is_object() && body.contains("jobs")
+                              && body["jobs"].is_array());
+        if (bulk) {
+            const auto& arr = body.is_array() ? body : body["jobs"];
+            std::vector<lemon::jobs::JobManager::JobSpec> specs;
+            for (size_t i = 0; i < arr.size(); ++i) {
+                try {
+                    specs.push_back(to_spec(arr[i]));
+                } catch (const lemon::jobs::JobError&) {
+                    throw;
+                } catch (const std::exception& e) {
+                    throw lemon::jobs::JobError(
+                        400, "jobs[" + std::to_string(i) + "]: " + e.what());
+                }
+            }
+            const auto ids = job_manager_->create_many(std::move(specs));
+            res.status = 202;
+            res.set_content(lemon::jobs::json{{"ids", ids}}.dump(), "application/json");
+            return;
+        }
+        auto spec = to_spec(body);
+        const std::string id = job_manager_->create(spec.name, std::move(spec.steps),
+                                                    spec.inputs, spec.priority, spec.window);
         res.status = 202;
         res.set_content(lemon::jobs::json{{"id", id}}.dump(), "application/json");
     } catch (const lemon::jobs::JobError& e) {
@@ -5947,17 +9510,123 @@ void Server::handle_jobs_create(const httplib::Request& req, httplib::Response&
     }
 }
 
-void Server::handle_jobs_list(const httplib::Request&, httplib::Response& res) {
-    res.set_content(lemon::jobs::json{{"jobs", job_manager_->list()}}.dump(), "application/json");
+void Server::handle_jobs_list(const httplib::Request& req, httplib::Response& res) {
+    if (!req.has_param("status") && !req.has_param("after") && !req.has_param("limit")
+        && !req.has_param("fields")) {
+        res.set_content(lemon::jobs::json{{"jobs", job_manager_->list()}}.dump(),
+                        "application/json");
+        return;
+    }
+    try {
+        lemon::jobs::JobManager::ListQuery query;
+        query.status = req.get_param_value("status");
+        query.after = req.get_param_value("after");
+        if (req.has_param("limit")) {
+            const int limit = std::atoi(req.get_param_value("limit").c_str());
+            if (limit <= 0) {
+                job_error(res, 400, "limit must be a positive integer");
+                return;
+            }
+            query.limit = static_cast<size_t>(limit);
+        }
+        if (req.has_param("fields")) {
+            std::stringstream fields(req.get_param_value("fields"));
+            std::string field;
+            while (std::getline(fields, field, ','))
+                if (!field.empty()) query.fields.push_back(field);
+        }
+        res.set_content(job_manager_->list(query).dump(), "application/json");
+    } catch (const lemon::jobs::JobError& e) {
+        job_error(res, e.status, e.what());
+    }
 }
 
 void Server::handle_jobs_get(const httplib::Request& req, httplib::Response& res) {
-    const auto job = job_manager_->get(job_id_from_path(req));
+    const std::string id = job_id_from_path(req);
+    const auto job = job_manager_->get(id);
     if (!job) {
         job_error(res, 404, "unknown job");
         return;
     }
-    res.set_content(job->dump(), "application/json");
+    if (req.get_param_value("stream") != "true") {
+        res.set_content(job->dump(), "application/json");
+        return;
+    }
+
+    res.set_header("Cache-Control", "no-cache");
+    res.set_header("Connection", "keep-alive");
+    res.set_header("X-Accel-Buffering", "no");
+    res.set_chunked_content_provider("text/event-stream",
+        [this, id](size_t offset, httplib::DataSink& sink) {
+            if (offset > 0) {
+                return false;
+            }
+            SseWriter sse(sink);
+            auto emit = [&sse](const lemon::jobs::json& event) {
+                return sse.write_data(event.dump());
+            };
+
+            uint64_t revision = UINT64_MAX;
+            std::map<std::string, std::string> sent_statuses;
+            bool first = true;
+            while (true) {
+                const auto snapshot =
+                    job_manager_->wait_for_update(id, revision, std::chrono::seconds(15));
+                if (!snapshot) {
+                    emit({{"type", "job.deleted"}, {"id", id}});
+                    break;
+                }
+                const uint64_t rev = (*snapshot)["revision"].get<uint64_t>();
+                if (!first && rev == revision) {
+                    if (!sse.write_comment("keep-alive")) {
+                        return false;
+                    }
+                    continue;
+                }
+                revision = rev;
+
+                lemon::jobs::json changed = lemon::jobs::json::array();
+                for (const auto& sj : (*snapshot)["steps"]) {
+                    const std::string step_id = sj.value("id", "");
+                    const std::string status = sj.value("status", "");
+                    auto it = sent_statuses.find(step_id);
+                    if (it != sent_statuses.end() && it->second == status) {
+                        continue;
+                    }
+                    sent_statuses[step_id] = status;
+                    if (!first) changed.push_back(sj);
+                }
+
+                bool delivered;
+                if (first) {
+                    delivered = emit({{"type", "job.snapshot"}, {"job", *snapshot}});
+                    first = false;
+                } else {
+                    lemon::jobs::json event = {{"type", "job.update"},
+                                               {"id", id},
+                                               {"revision", rev},
+                                               {"status", (*snapshot)["status"]},
+                                               {"cursor", (*snapshot)["cursor"]}};
+                    if (snapshot->contains("error")) event["error"] = (*snapshot)["error"];
+                    if (snapshot->contains("finished_at"))
+                        event["finished_at"] = (*snapshot)["finished_at"];
+                    if (!changed.empty()) event["steps"] = changed;
+                    delivered = emit(event);
+                }
+                if (!delivered) {
+                    return false;
+                }
+
+                const std::string status = (*snapshot)["status"].get<std::string>();
+                if (status != "queued" && status != "running") {
+                    break;
+                }
+            }
+            const std::string done_frame = "data: [DONE]\n\n";
+            sink.write(done_frame.data(), done_frame.size());
+            sink.done();
+            return false;
+        });
 }
 
 void Server::handle_jobs_pause(const httplib::Request& req, httplib::Response& res) {
@@ -5996,6 +9665,23 @@ void Server::handle_jobs_delete(const httplib::Request& req, httplib::Response&
 void Server::handle_shutdown(const httplib::Request& req, httplib::Response& res) {
     LOG(INFO, "Server") << "Shutdown request received" << std::endl;
 
+    // Binary-upgrade handover: drain and detach ready backends, persist the
+    // records, and let the replacement lemond re-attach instead of cold-loading.
+    bool handover = false;
+    if (!req.body.empty()) {
+        auto body = nlohmann::json::parse(req.body, nullptr, false);
+        if (body.is_object()) {
+            handover = body.value("handover", false);
+        }
+    }
+    if (handover && router_ && !cache_dir_.empty()) {
+        auto records = router_->export_handover_records();
+        if (!records.empty() && BackendHandover::save(cache_dir_, records)) {
+            LOG(INFO, "Server") << "Handover state saved for " << records.size()
+                                << " backend(s)" << std::endl;
+        }
+    }
+
     // Unload all models SYNCHRONOUSLY before sending the response.
     // This ensures child processes (llama-server, etc.) are terminated
     // before the caller proceeds, avoiding zombie processes.
@@ -6192,6 +9878,16 @@ void Server::apply_config_side_effects(const json& applied_changes) {
                     websocket_server_->start();
                 }
             }
+            if (http2_gateway_) {
+                http2_gateway_->stop();
+                http2_gateway_ = std::make_unique<Http2Gateway>(
+                    config_->host(),
+                    config_->http2_port(),
+                    config_->port());
+                if (running_) {
+                    http2_gateway_->start();
+                }
+            }
         } else if (key == "websocket_port") {
             if (websocket_server_) {
                 LOG(INFO, "Server") << "Restarting WebSocket server on requested port "
@@ -6205,6 +9901,19 @@ void Server::apply_config_side_effects(const json& applied_changes) {
                     websocket_server_->start();
                 }
             }
+        } else if (key == "http2_port") {
+            if (http2_gateway_) {
+                LOG(INFO, "Server") << "Restarting HTTP/2 gateway on requested port "
+                                    << config_->http2_port() << std::endl;
+                http2_gateway_->stop();
+                http2_gateway_ = std::make_unique<Http2Gateway>(
+                    config_->host(),
+                    config_->http2_port(),
+                    config_->port());
+                if (running_) {
+                    http2_gateway_->start();
+                }
+            }
         } else if (key == "log_level") {
             std::string level = config_->log_level();
             LOG(INFO, "Server") << "Log level changed to: " << level << std::endl;
@@ -6224,6 +9933,26 @@ void Server::apply_config_side_effects(const json& applied_changes) {
                     udp_beacon_.startBroadcasting(13305, port_, 2);
                 }
             }
+        } else if (key == "federation") {
+            bool enabled = config_->federation();
+            LOG(INFO, "Server") << "Federation " << (enabled ? "enabled" : "disabled") << std::endl;
+            if (enabled) {
+                // Keep the instance once created: request threads read the
+                // pointer unguarded, so disable stops the threads but never
+                // frees the registry.
+                if (!peer_registry_) {
+                    peer_registry_ = std::make_unique<PeerRegistry>();
+                }
+                peer_registry_->start(13305);
+            } else if (peer_registry_) {
+                peer_registry_->stop();
+            }
+        } else if (key == "quota_requests_per_second" || key == "quota_tokens_per_minute" ||
+                   key == "quota_max_concurrent_streams") {
+            RateLimiter::instance().set_limits({config_->quota_requests_per_second(),
+                                                config_->quota_tokens_per_minute(),
+                                                config_->quota_max_concurrent_streams()});
+            LOG(INFO, "Server") << "Per-key quota limits updated" << std::endl;
         } else if (key == "extra_models_dir") {
             std::string dir = config_->extra_models_dir();
             LOG(INFO, "Server") << "Extra models dir changed to: " << dir << std::endl;
@@ -6437,27 +10166,35 @@ std::shared_ptr<Server::DownloadJob> Server::start_download_job(
 
             operation(progress_cb);
 
-            std::lock_guard<std::mutex> lock(downloads_mutex_);
-            if (job->cancel_requested && job->stop_acknowledged) {
-                job->status = job->cancel_action == "cancel" ? "cancelled" : "paused";
-                job->progress["complete"] = false;
-            } else {
-                // The operation returned normally without acknowledging a stop
-                // request. Treat that as success; a late pause/cancel button must
-                // not erase or delete a completed download.
-                job->status = "completed";
-                job->progress["complete"] = true;
-                job->progress["percent"] = 100;
-                const uint64_t total_download_size = job->progress.value("total_download_size", uint64_t{0});
-                if (total_download_size > 0) {
-                    job->progress["cumulative_bytes_downloaded"] = total_download_size;
-                    job->progress["overall_bytes_downloaded"] = total_download_size;
+            bool completed = false;
+            {
+                std::lock_guard<std::mutex> lock(downloads_mutex_);
+                if (job->cancel_requested && job->stop_acknowledged) {
+                    job->status = job->cancel_action == "cancel" ? "cancelled" : "paused";
+                    job->progress["complete"] = false;
+                } else {
+                    // The operation returned normally without acknowledging a stop
+                    // request. Treat that as success; a late pause/cancel button must
+                    // not erase or delete a completed download.
+                    job->status = "completed";
+                    job->progress["complete"] = true;
+                    job->progress["percent"] = 100;
+                    const uint64_t total_download_size = job->progress.value("total_download_size", uint64_t{0});
+                    if (total_download_size > 0) {
+                        job->progress["cumulative_bytes_downloaded"] = total_download_size;
+                        job->progress["overall_bytes_downloaded"] = total_download_size;
+                    }
                 }
+                job->running = false;
+                job->terminal_since = (job->status == "completed" || job->status == "cancelled")
+                    ? std::chrono::steady_clock::now()
+                    : std::chrono::steady_clock::time_point{};
+                completed = job->status == "completed";
+            }
+            invalidate_models_cache();
+            if (completed) {
+                maybe_enforce_store_quota();
             }
-            job->running = false;
-            job->terminal_since = (job->status == "completed" || job->status == "cancelled")
-                ? std::chrono::steady_clock::now()
-                : std::chrono::steady_clock::time_point{};
         } catch (const lemon::UnknownModelError& e) {
             std::lock_guard<std::mutex> lock(downloads_mutex_);
             LOG(ERROR, "DownloadManager") << "worker unknown-model error id=" << job->id
@@ -6773,8 +10510,37 @@ void Server::handle_install(const httplib::Request& req, httplib::Response& res)
                 res.set_content(error.dump(), "application/json");
                 return;
             }
+            std::vector<std::string> fallback_base_urls;
+            if (request_json.contains("fallback_base_urls")) {
+                if (!request_json["fallback_base_urls"].is_array()) {
+                    res.status = 400;
+                    nlohmann::json error = {{"error", {
+                        {"message", "fallback_base_urls must be an array of URL strings when provided"},
+                        {"type", "invalid_request_error"}}}};
+                    res.set_content(error.dump(), "application/json");
+                    return;
+                }
+                for (const auto& url : request_json["fallback_base_urls"]) {
+                    std::string err = url.is_string()
+                        ? CloudProviderRegistry::validate_base_url(url.get<std::string>())
+                        : "fallback_base_urls entries must be strings";
+                    if (!err.empty()) {
+                        res.status = 400;
+                        nlohmann::json error = {{"error", {
+                            {"message", err},
+                            {"type", "invalid_request_error"}}}};
+                        res.set_content(error.dump(), "application/json");
+                        return;
+                    }
+                    fallback_base_urls.push_back(url.get<std::string>());
+                }
+            }
             const auto env_state = cloud_registry_->auth_state(provider);
-            if (CloudProviderRegistry::is_http_base_url(base_url) &&
+            bool any_http = CloudProviderRegistry::is_http_base_url(base_url);
+            for (const auto& url : fallback_base_urls) {
+                any_http = any_http || CloudProviderRegistry::is_http_base_url(url);
+            }
+            if (any_http &&
                 !allow_insecure_http &&
                 (!api_key.empty() || env_state.env_var_set)) {
                 res.status = 400;
@@ -6789,7 +10555,8 @@ void Server::handle_install(const httplib::Request& req, httplib::Response& res)
             }
             LOG(INFO, "Server") << "Installing cloud provider '" << provider
                                   << "' with base_url " << base_url << std::endl;
-            cloud_registry_->install(provider, base_url, allow_insecure_http);
+            cloud_registry_->install(provider, base_url, allow_insecure_http,
+                                     std::move(fallback_base_urls));
             persist_cloud_providers();
 
             // Best-effort optional auth: if api_key was supplied, treat this
@@ -0,0 +1,132 @@
+#include "lemon/session_store.h"
+
+#include <algorithm>
+#include <random>
+#include <sstream>
+#include <vector>
+
+namespace lemon {
+
+namespace {
+
+std::string generate_session_id() {
+    std::random_device rd;
+    std::mt19937_64 gen(rd());
+    std::ostringstream oss;
+    oss << "sess-" << std::hex << gen();
+    return oss.str();
+}
+
+} // namespace
+
+SessionStore::Snapshot SessionStore::snapshot_of(const std::string& id,
+                                                 const Session& session) {
+    Snapshot snapshot;
+    snapshot.id = id;
+    snapshot.model = session.model;
+    snapshot.messages = session.messages;
+    snapshot.turns = session.turns;
+    return snapshot;
+}
+
+std::string SessionStore::create(const std::string& model,
+                                 const nlohmann::json& initial_messages,
+                                 int budget) {
+    const size_t capacity = static_cast<size_t>((std::max)(budget, 1));
+
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    while (sessions_.size() >= capacity) {
+        auto victim = sessions_.begin();
+        for (auto it = sessions_.begin(); it != sessions_.end(); ++it) {
+            if (it->second.last_used < victim->second.last_used) {
+                victim = it;
+            }
+        }
+        sessions_.erase(victim);
+    }
+
+    std::string id = generate_session_id();
+    while (sessions_.count(id) > 0) {
+        id = generate_session_id();
+    }
+
+    Session& session = sessions_[id];
+    session.model = model;
+    session.messages = initial_messages.is_array() ? initial_messages
+                                                   : nlohmann::json::array();
+    session.last_used = ++use_counter_;
+    return id;
+}
+
+std::optional<SessionStore::Snapshot> SessionStore::get(const std::string& id) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = sessions_.find(id);
+    if (it == sessions_.end()) {
+        return std::nullopt;
+    }
+    it->second.last_used = ++use_counter_;
+    return snapshot_of(id, it->second);
+}
+
+std::optional<SessionStore::Snapshot> SessionStore::append(
+        const std::string& id, const nlohmann::json& new_messages) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = sessions_.find(id);
+    if (it == sessions_.end()) {
+        return std::nullopt;
+    }
+    Session& session = it->second;
+    if (new_messages.is_array()) {
+        for (const auto& message : new_messages) {
+            session.messages.push_back(message);
+        }
+    }
+    session.turns++;
+    session.last_used = ++use_counter_;
+    return snapshot_of(id, session);
+}
+
+bool SessionStore::remove(const std::string& id) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return sessions_.erase(id) > 0;
+}
+
+nlohmann::json SessionStore::list() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    std::vector<std::pair<uint64_t, nlohmann::json>> entries;
+    entries.reserve(sessions_.size());
+    for (const auto& [id, session] : sessions_) {
+        entries.emplace_back(session.last_used, nlohmann::json{
+            {"id", id},
+            {"model", session.model},
+            {"message_count", session.messages.size()},
+            {"turns", session.turns}
+        });
+    }
+    std::sort(entries.begin(), entries.end(),
+              [](const auto& a, const auto& b) { return a.first > b.first; });
+
+    nlohmann::json sessions = nlohmann::json::array();
+    for (auto& [_, entry] : entries) {
+        sessions.push_back(std::move(entry));
+    }
+    return sessions;
+}
+
+size_t SessionStore::size() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return sessions_.size();
+}
+
+size_t SessionStore::approx_bytes() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    size_t bytes = 0;
+    for (const auto& [id, session] : sessions_) {
+        bytes += id.size() + session.model.size() + session.messages.dump().size();
+    }
+    return bytes;
+}
+
+} // namespace lemon
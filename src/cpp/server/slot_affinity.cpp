@@ -0,0 +1,130 @@
+#include "lemon/slot_affinity.h"
+
+#include <algorithm>
+#include <atomic>
+
+namespace lemon {
+
+namespace {
+
+constexpr size_t kBlockSize = 256;
+constexpr size_t kMaxBlocks = 512;
+
+std::atomic<uint64_t> g_requests{0};
+std::atomic<uint64_t> g_prefix_hits{0};
+std::atomic<uint64_t> g_prefix_chars_reused{0};
+
+} // namespace
+
+SlotAffinity::SlotAffinity(int slot_count)
+    : slot_count_(std::max(slot_count, 1)), slots_(static_cast<size_t>(slot_count_)) {
+}
+
+// Cumulative FNV-1a per block: hash i covers bytes [0, (i+1)*kBlockSize), so
+// two prompts share an i-block prefix iff their first i hashes match.
+std::vector<uint64_t> SlotAffinity::fingerprint(const std::string& prompt_signature) {
+    std::vector<uint64_t> hashes;
+    uint64_t hash = 1469598103934665603ULL;
+    size_t limit = std::min(prompt_signature.size(), kBlockSize * kMaxBlocks);
+    for (size_t i = 0; i < limit; ++i) {
+        hash ^= static_cast<unsigned char>(prompt_signature[i]);
+        hash *= 1099511628211ULL;
+        if ((i + 1) % kBlockSize == 0) {
+            hashes.push_back(hash);
+        }
+    }
+    return hashes;
+}
+
+size_t SlotAffinity::choose_slot_locked(const std::vector<uint64_t>& hashes) {
+    size_t best_index = 0;
+    size_t best_match = 0;
+    for (size_t i = 0; i < slots_.size(); ++i) {
+        const Slot& slot = slots_[i];
+        size_t shared = std::min(hashes.size(), slot.block_hashes.size());
+        size_t match = 0;
+        while (match < shared && hashes[match] == slot.block_hashes[match]) {
+            ++match;
+        }
+        if (match > best_match ||
+            (match == best_match && slot.last_used < slots_[best_index].last_used)) {
+            best_index = i;
+            best_match = match;
+        }
+    }
+
+    if (best_match > 0) {
+        g_prefix_hits.fetch_add(1, std::memory_order_relaxed);
+        g_prefix_chars_reused.fetch_add(best_match * kBlockSize, std::memory_order_relaxed);
+    }
+    return best_index;
+}
+
+int SlotAffinity::pick_slot(const std::string& prompt_signature) {
+    std::vector<uint64_t> hashes = fingerprint(prompt_signature);
+
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    g_requests.fetch_add(1, std::memory_order_relaxed);
+    size_t index = choose_slot_locked(hashes);
+
+    Slot& chosen = slots_[index];
+    chosen.session.clear();
+    chosen.block_hashes = std::move(hashes);
+    chosen.last_used = ++use_counter_;
+    return static_cast<int>(index);
+}
+
+int SlotAffinity::pick_slot_for_session(const std::string& session_id,
+                                        const std::string& prompt_signature) {
+    std::vector<uint64_t> hashes = fingerprint(prompt_signature);
+
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    g_requests.fetch_add(1, std::memory_order_relaxed);
+    for (size_t i = 0; i < slots_.size(); ++i) {
+        Slot& slot = slots_[i];
+        if (slot.session != session_id) {
+            continue;
+        }
+        size_t shared = std::min(hashes.size(), slot.block_hashes.size());
+        size_t match = 0;
+        while (match < shared && hashes[match] == slot.block_hashes[match]) {
+            ++match;
+        }
+        if (match > 0) {
+            g_prefix_hits.fetch_add(1, std::memory_order_relaxed);
+            g_prefix_chars_reused.fetch_add(match * kBlockSize, std::memory_order_relaxed);
+        }
+        slot.block_hashes = std::move(hashes);
+        slot.last_used = ++use_counter_;
+        return static_cast<int>(i);
+    }
+
+    size_t index = choose_slot_locked(hashes);
+    Slot& chosen = slots_[index];
+    chosen.session = session_id;
+    chosen.block_hashes = std::move(hashes);
+    chosen.last_used = ++use_counter_;
+    return static_cast<int>(index);
+}
+
+void SlotAffinity::reset() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (Slot& slot : slots_) {
+        slot.block_hashes.clear();
+        slot.session.clear();
+        slot.last_used = 0;
+    }
+    use_counter_ = 0;
+}
+
+SlotAffinity::Stats SlotAffinity::totals() {
+    Stats stats;
+    stats.requests = g_requests.load(std::memory_order_relaxed);
+    stats.prefix_hits = g_prefix_hits.load(std::memory_order_relaxed);
+    stats.prefix_chars_reused = g_prefix_chars_reused.load(std::memory_order_relaxed);
+    return stats;
+}
+
+} // namespace lemon
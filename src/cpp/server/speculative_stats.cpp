@@ -0,0 +1,42 @@
+#include "lemon/speculative_stats.h"
+
+#include <atomic>
+
+namespace lemon {
+
+namespace {
+
+std::atomic<uint64_t> g_drafted{0};
+std::atomic<uint64_t> g_accepted{0};
+
+} // namespace
+
+void SpeculativeStats::record(uint64_t drafted, uint64_t accepted) {
+    if (drafted == 0) {
+        return;
+    }
+    g_drafted.fetch_add(drafted, std::memory_order_relaxed);
+    g_accepted.fetch_add(accepted, std::memory_order_relaxed);
+}
+
+void SpeculativeStats::record_from_timings(const nlohmann::json& timings) {
+    if (!timings.is_object() || !timings.contains("draft_n") ||
+        !timings["draft_n"].is_number()) {
+        return;
+    }
+    uint64_t drafted = timings["draft_n"].get<uint64_t>();
+    uint64_t accepted = 0;
+    if (timings.contains("draft_n_accepted") && timings["draft_n_accepted"].is_number()) {
+        accepted = timings["draft_n_accepted"].get<uint64_t>();
+    }
+    record(drafted, accepted);
+}
+
+SpeculativeStats::Totals SpeculativeStats::totals() {
+    Totals totals;
+    totals.drafted = g_drafted.load(std::memory_order_relaxed);
+    totals.accepted = g_accepted.load(std::memory_order_relaxed);
+    return totals;
+}
+
+} // namespace lemon
@@ -0,0 +1,153 @@
+#include "lemon/sse_compression.h"
+
+#include <atomic>
+#include <cctype>
+#include <chrono>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <zstd.h>
+
+namespace lemon {
+
+namespace {
+
+// Token streams are tiny per-write; a low level keeps the per-chunk CPU cost
+// negligible while dictionary reuse across a stream still compresses the
+// repetitive SSE/JSON framing well.
+constexpr int kCompressionLevel = 1;
+constexpr size_t kMaxPooledContexts = 16;
+
+std::mutex g_ctx_mutex;
+std::vector<ZSTD_CCtx*> g_ctx_pool;
+
+std::atomic<uint64_t> g_streams{0};
+std::atomic<uint64_t> g_bytes_in{0};
+std::atomic<uint64_t> g_bytes_out{0};
+std::atomic<uint64_t> g_cpu_micros{0};
+std::atomic<uint64_t> g_ctx_hits{0};
+std::atomic<uint64_t> g_ctx_misses{0};
+
+ZSTD_CCtx* acquire_context() {
+    {
+        std::lock_guard<std::mutex> lock(g_ctx_mutex);
+        if (!g_ctx_pool.empty()) {
+            ZSTD_CCtx* ctx = g_ctx_pool.back();
+            g_ctx_pool.pop_back();
+            g_ctx_hits++;
+            return ctx;
+        }
+    }
+    g_ctx_misses++;
+    return ZSTD_createCCtx();
+}
+
+void release_context(ZSTD_CCtx* ctx) {
+    if (!ctx) return;
+    ZSTD_CCtx_reset(ctx, ZSTD_reset_session_and_parameters);
+    std::lock_guard<std::mutex> lock(g_ctx_mutex);
+    if (g_ctx_pool.size() < kMaxPooledContexts) {
+        g_ctx_pool.push_back(ctx);
+    } else {
+        ZSTD_freeCCtx(ctx);
+    }
+}
+
+}  // namespace
+
+bool SseCompression::client_accepts_zstd(const httplib::Request& req) {
+    if (!req.has_header("Accept-Encoding")) {
+        return false;
+    }
+    std::istringstream encodings(req.get_header_value("Accept-Encoding"));
+    std::string entry;
+    while (std::getline(encodings, entry, ',')) {
+        size_t start = entry.find_first_not_of(" \t");
+        if (start == std::string::npos) continue;
+        size_t end = entry.find_first_of(" \t;", start);
+        std::string name = entry.substr(start, end == std::string::npos ? std::string::npos
+                                                                        : end - start);
+        for (auto& c : name) c = static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+        if (name != "zstd") continue;
+        const size_t q_pos = entry.find("q=");
+        if (q_pos != std::string::npos) {
+            try {
+                if (std::stod(entry.substr(q_pos + 2)) <= 0.0) {
+                    return false;
+                }
+            } catch (...) {}
+        }
+        return true;
+    }
+    return false;
+}
+
+SseCompression::Stream::Stream() {
+    ZSTD_CCtx* ctx = acquire_context();
+    if (ctx) {
+        ZSTD_CCtx_setParameter(ctx, ZSTD_c_compressionLevel, kCompressionLevel);
+    }
+    cctx_ = ctx;
+    g_streams++;
+}
+
+SseCompression::Stream::~Stream() {
+    release_context(static_cast<ZSTD_CCtx*>(cctx_));
+}
+
+bool SseCompression::Stream::write(httplib::DataSink& downstream,
+                                   const char* data, size_t length) {
+    auto* ctx = static_cast<ZSTD_CCtx*>(cctx_);
+    if (!ctx || finished_) return false;
+    if (length == 0) return true;
+
+    const auto start = std::chrono::steady_clock::now();
+    std::string compressed(ZSTD_compressBound(length), '\0');
+    ZSTD_inBuffer input{data, length, 0};
+    ZSTD_outBuffer output{compressed.data(), compressed.size(), 0};
+    // Flush each write as a complete block so the client can decode every
+    // event as soon as it arrives, at a small ratio cost versus buffering.
+    const size_t remaining = ZSTD_compressStream2(ctx, &output, &input, ZSTD_e_flush);
+    if (ZSTD_isError(remaining) || input.pos != input.size) {
+        return false;
+    }
+    g_cpu_micros += static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now() - start).count());
+    g_bytes_in += length;
+    g_bytes_out += output.pos;
+
+    if (output.pos == 0) return true;
+    return downstream.write(compressed.data(), output.pos);
+}
+
+bool SseCompression::Stream::finish(httplib::DataSink& downstream) {
+    auto* ctx = static_cast<ZSTD_CCtx*>(cctx_);
+    if (!ctx || finished_) return false;
+    finished_ = true;
+
+    std::string compressed(ZSTD_compressBound(0), '\0');
+    ZSTD_inBuffer input{nullptr, 0, 0};
+    ZSTD_outBuffer output{compressed.data(), compressed.size(), 0};
+    const size_t remaining = ZSTD_compressStream2(ctx, &output, &input, ZSTD_e_end);
+    if (ZSTD_isError(remaining) || remaining != 0) {
+        return false;
+    }
+    g_bytes_out += output.pos;
+    if (output.pos == 0) return true;
+    return downstream.write(compressed.data(), output.pos);
+}
+
+SseCompression::Totals SseCompression::totals() {
+    Totals t;
+    t.streams = g_streams.load();
+    t.bytes_in = g_bytes_in.load();
+    t.bytes_out = g_bytes_out.load();
+    t.cpu_micros = g_cpu_micros.load();
+    t.ctx_pool_hits = g_ctx_hits.load();
+    t.ctx_pool_misses = g_ctx_misses.load();
+    return t;
+}
+
+} // namespace lemon
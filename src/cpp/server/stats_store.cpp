@@ -0,0 +1,236 @@
+#include "lemon/stats_store.h"
+
+#include <chrono>
+#include <fstream>
+#include <system_error>
+
+#include "lemon/utils/aixlog.hpp"
+
+namespace lemon {
+
+namespace fs = std::filesystem;
+using json = nlohmann::json;
+
+namespace {
+
+json identity_to_json(const StatsStore::ModelIdentity& identity) {
+    return {{"model", identity.model_name},
+            {"checkpoint", identity.checkpoint},
+            {"type", identity.type},
+            {"device", identity.device},
+            {"recipe", identity.recipe}};
+}
+
+StatsStore::ModelIdentity identity_from_json(const json& record) {
+    StatsStore::ModelIdentity identity;
+    identity.model_name = record.value("model", "");
+    identity.checkpoint = record.value("checkpoint", "");
+    identity.type = record.value("type", "");
+    identity.device = record.value("device", "");
+    identity.recipe = record.value("recipe", "");
+    return identity;
+}
+
+void apply_counts(StatsStore::Totals& totals, const json& record) {
+    totals.request_count_total += record.value("requests", uint64_t{0});
+    totals.input_tokens_total += record.value("input_tokens", uint64_t{0});
+    totals.output_tokens_total += record.value("output_tokens", uint64_t{0});
+    totals.prompt_tokens_total += record.value("prompt_tokens", uint64_t{0});
+}
+
+json counts_to_json(const StatsStore::ModelIdentity& identity,
+                    const StatsStore::Totals& totals) {
+    json entry = identity_to_json(identity);
+    entry["requests"] = totals.request_count_total;
+    entry["input_tokens"] = totals.input_tokens_total;
+    entry["output_tokens"] = totals.output_tokens_total;
+    entry["prompt_tokens"] = totals.prompt_tokens_total;
+    return entry;
+}
+
+} // namespace
+
+StatsStore::StatsStore(const fs::path& log_path, size_t max_log_records)
+    : log_path_(log_path), max_log_records_(max_log_records) {
+    flush_thread_ = std::thread([this] {
+        std::unique_lock<std::mutex> lock(mutex_);
+        while (!stopping_) {
+            stop_cv_.wait_for(lock, std::chrono::seconds(kFlushIntervalSeconds),
+                              [this] { return stopping_; });
+            if (stopping_) {
+                break;
+            }
+            flush_locked();
+        }
+    });
+}
+
+StatsStore::~StatsStore() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    stop_cv_.notify_all();
+    if (flush_thread_.joinable()) {
+        flush_thread_.join();
+    }
+    flush();
+}
+
+std::vector<StatsStore::ModelTotals> StatsStore::replay() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    entries_.clear();
+    log_records_ = 0;
+
+    std::ifstream in(log_path_);
+    std::string line;
+    while (in && std::getline(in, line)) {
+        if (line.empty()) {
+            continue;
+        }
+        json record = json::parse(line, nullptr, false);
+        if (record.is_discarded() || !record.is_object() ||
+            !record.contains("models") || !record["models"].is_array()) {
+            // A torn trailing record (crash mid-append) parses as garbage;
+            // the counts it carried are lost but everything before it stands.
+            continue;
+        }
+        const std::string op = record.value("op", "");
+        if (op == "snapshot") {
+            entries_.clear();
+        } else if (op != "delta") {
+            continue;
+        }
+        ++log_records_;
+        for (const auto& model : record["models"]) {
+            if (!model.is_object()) {
+                continue;
+            }
+            Entry& entry = entry_for(identity_from_json(model));
+            apply_counts(entry.cumulative, model);
+        }
+    }
+
+    std::vector<ModelTotals> totals;
+    totals.reserve(entries_.size());
+    for (const auto& item : entries_) {
+        totals.push_back({item.second.identity, item.second.cumulative});
+    }
+    return totals;
+}
+
+void StatsStore::record_request(const ModelIdentity& identity, int input_tokens,
+                                int output_tokens) {
+    if (identity.model_name.empty()) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    Entry& entry = entry_for(identity);
+    entry.pending.request_count_total += 1;
+    entry.cumulative.request_count_total += 1;
+    if (input_tokens > 0) {
+        entry.pending.input_tokens_total += static_cast<uint64_t>(input_tokens);
+        entry.cumulative.input_tokens_total += static_cast<uint64_t>(input_tokens);
+    }
+    if (output_tokens > 0) {
+        entry.pending.output_tokens_total += static_cast<uint64_t>(output_tokens);
+        entry.cumulative.output_tokens_total += static_cast<uint64_t>(output_tokens);
+    }
+    dirty_ = true;
+}
+
+void StatsStore::record_prompt_tokens(const ModelIdentity& identity,
+                                      int prompt_tokens) {
+    if (identity.model_name.empty() || prompt_tokens <= 0) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    Entry& entry = entry_for(identity);
+    entry.pending.prompt_tokens_total += static_cast<uint64_t>(prompt_tokens);
+    entry.cumulative.prompt_tokens_total += static_cast<uint64_t>(prompt_tokens);
+    dirty_ = true;
+}
+
+void StatsStore::flush() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    flush_locked();
+}
+
+void StatsStore::flush_locked() {
+    if (!dirty_) {
+        return;
+    }
+
+    json models = json::array();
+    for (auto& item : entries_) {
+        Entry& entry = item.second;
+        const Totals& pending = entry.pending;
+        if (pending.request_count_total == 0 && pending.input_tokens_total == 0 &&
+            pending.output_tokens_total == 0 && pending.prompt_tokens_total == 0) {
+            continue;
+        }
+        models.push_back(counts_to_json(entry.identity, pending));
+        entry.pending = Totals{};
+    }
+    dirty_ = false;
+    if (models.empty()) {
+        return;
+    }
+
+    try {
+        std::ofstream out(log_path_, std::ios::app);
+        if (!out) {
+            LOG(WARNING, "StatsStore")
+                << "Cannot append to " << log_path_.string() << std::endl;
+            return;
+        }
+        out << json{{"op", "delta"}, {"models", std::move(models)}}.dump() << "\n";
+        out.close();
+        ++log_records_;
+    } catch (const std::exception& e) {
+        LOG(WARNING, "StatsStore") << "Flush failed: " << e.what() << std::endl;
+        return;
+    }
+
+    if (log_records_ > max_log_records_) {
+        compact_locked();
+    }
+}
+
+void StatsStore::compact_locked() {
+    json models = json::array();
+    for (const auto& item : entries_) {
+        models.push_back(counts_to_json(item.second.identity, item.second.cumulative));
+    }
+
+    const fs::path temp_path = fs::path(log_path_).concat(".tmp");
+    try {
+        {
+            std::ofstream out(temp_path, std::ios::trunc);
+            if (!out) {
+                return;
+            }
+            out << json{{"op", "snapshot"}, {"models", std::move(models)}}.dump()
+                << "\n";
+        }
+        std::error_code ec;
+        fs::rename(temp_path, log_path_, ec);
+        if (ec) {
+            fs::remove(temp_path, ec);
+            return;
+        }
+        log_records_ = 1;
+        LOG(DEBUG, "StatsStore") << "Compacted stats log to one snapshot ("
+                                 << entries_.size() << " model(s))" << std::endl;
+    } catch (const std::exception& e) {
+        LOG(WARNING, "StatsStore") << "Compaction failed: " << e.what() << std::endl;
+    }
+}
+
+StatsStore::Entry& StatsStore::entry_for(const ModelIdentity& identity) {
+    Entry& entry = entries_[identity.key()];
+    entry.identity = identity;
+    return entry;
+}
+
+} // namespace lemon
@@ -0,0 +1,156 @@
+#include "lemon/stats_windows.h"
+
+#include <algorithm>
+
+namespace lemon {
+
+namespace {
+
+struct WindowSpec {
+    const char* name;
+    uint64_t slot_seconds;
+    size_t slot_count;
+};
+
+constexpr WindowSpec kWindowSpecs[] = {
+    {"1m", 1, 60},
+    {"1h", 60, 60},
+    {"24h", 3600, 24},
+};
+
+constexpr double kTtftBounds[] = {
+    0.05, 0.1, 0.25, 0.5, 1.0, 2.5, 5.0, 10.0, 20.0, 60.0
+};
+
+uint64_t epoch_seconds(std::chrono::steady_clock::time_point now) {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::seconds>(
+                                     now.time_since_epoch())
+                                     .count());
+}
+
+size_t ttft_bucket(double seconds) {
+    for (size_t i = 0; i < std::size(kTtftBounds); ++i) {
+        if (seconds <= kTtftBounds[i]) {
+            return i;
+        }
+    }
+    return std::size(kTtftBounds);
+}
+
+double ttft_quantile(const uint64_t* buckets, uint64_t count, double quantile) {
+    const double rank = quantile * static_cast<double>(count);
+    uint64_t cumulative = 0;
+    for (size_t i = 0; i <= std::size(kTtftBounds); ++i) {
+        const uint64_t next = cumulative + buckets[i];
+        if (static_cast<double>(next) >= rank && buckets[i] > 0) {
+            if (i == std::size(kTtftBounds)) {
+                return kTtftBounds[std::size(kTtftBounds) - 1];
+            }
+            const double lower = i == 0 ? 0.0 : kTtftBounds[i - 1];
+            const double fraction =
+                (rank - static_cast<double>(cumulative)) / static_cast<double>(buckets[i]);
+            return lower + (kTtftBounds[i] - lower) * std::clamp(fraction, 0.0, 1.0);
+        }
+        cumulative = next;
+    }
+    return kTtftBounds[std::size(kTtftBounds) - 1];
+}
+
+} // namespace
+
+void StatsWindows::record(const std::string& model, int input_tokens,
+                          int output_tokens, double ttft_seconds,
+                          std::chrono::steady_clock::time_point now) {
+    const uint64_t seconds = epoch_seconds(now);
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    ModelWindows& model_windows = by_model_[model];
+    for (size_t w = 0; w < kWindowCount; ++w) {
+        const WindowSpec& spec = kWindowSpecs[w];
+        Window& window = model_windows.windows[w];
+        if (window.slots.empty()) {
+            window.slots.resize(spec.slot_count);
+        }
+
+        const uint64_t epoch = seconds / spec.slot_seconds;
+        Slot& slot = window.slots[epoch % spec.slot_count];
+        if (slot.epoch != epoch) {
+            slot = Slot{};
+            slot.epoch = epoch;
+        }
+
+        slot.requests++;
+        if (input_tokens > 0) {
+            slot.input_tokens += static_cast<uint64_t>(input_tokens);
+        }
+        if (output_tokens > 0) {
+            slot.output_tokens += static_cast<uint64_t>(output_tokens);
+        }
+        if (ttft_seconds > 0.0) {
+            slot.ttft_count++;
+            slot.ttft_sum += ttft_seconds;
+            slot.ttft_buckets[ttft_bucket(ttft_seconds)]++;
+        }
+    }
+}
+
+nlohmann::json StatsWindows::to_json(std::chrono::steady_clock::time_point now) const {
+    const uint64_t seconds = epoch_seconds(now);
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    nlohmann::json result = nlohmann::json::object();
+    for (size_t w = 0; w < kWindowCount; ++w) {
+        const WindowSpec& spec = kWindowSpecs[w];
+        const uint64_t now_epoch = seconds / spec.slot_seconds;
+
+        nlohmann::json models = nlohmann::json::object();
+        for (const auto& [model, model_windows] : by_model_) {
+            const Window& window = model_windows.windows[w];
+
+            uint64_t requests = 0;
+            uint64_t input_tokens = 0;
+            uint64_t output_tokens = 0;
+            uint64_t ttft_count = 0;
+            double ttft_sum = 0.0;
+            uint64_t merged[kTtftBucketCount + 1] = {};
+
+            for (const Slot& slot : window.slots) {
+                if (slot.epoch + spec.slot_count <= now_epoch || slot.epoch > now_epoch) {
+                    continue;
+                }
+                requests += slot.requests;
+                input_tokens += slot.input_tokens;
+                output_tokens += slot.output_tokens;
+                ttft_count += slot.ttft_count;
+                ttft_sum += slot.ttft_sum;
+                for (size_t i = 0; i <= kTtftBucketCount; ++i) {
+                    merged[i] += slot.ttft_buckets[i];
+                }
+            }
+
+            if (requests == 0) {
+                continue;
+            }
+
+            nlohmann::json entry = {
+                {"requests", requests},
+                {"input_tokens", input_tokens},
+                {"output_tokens", output_tokens},
+            };
+            if (ttft_count > 0) {
+                entry["ttft"] = {
+                    {"count", ttft_count},
+                    {"avg", ttft_sum / static_cast<double>(ttft_count)},
+                    {"p50", ttft_quantile(merged, ttft_count, 0.50)},
+                    {"p95", ttft_quantile(merged, ttft_count, 0.95)},
+                    {"p99", ttft_quantile(merged, ttft_count, 0.99)},
+                };
+            }
+            models[model] = std::move(entry);
+        }
+        result[spec.name] = std::move(models);
+    }
+    return result;
+}
+
+} // namespace lemon
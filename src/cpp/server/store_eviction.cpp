@@ -0,0 +1,55 @@
+#include "lemon/store_eviction.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace lemon {
+
+namespace {
+constexpr double kNeverUsedAgeDays = 365.0;
+constexpr double kSecondsPerDay = 86400.0;
+constexpr double kBytesPerGb = 1024.0 * 1024.0 * 1024.0;
+}
+
+double StoreEvictionPolicy::eviction_score(const StoreCandidate& candidate, int64_t now) {
+    double age_days = kNeverUsedAgeDays;
+    if (candidate.last_used > 0) {
+        age_days = std::max(0.0, static_cast<double>(now - candidate.last_used) / kSecondsPerDay);
+    }
+    const double size_gb = static_cast<double>(candidate.size_bytes) / kBytesPerGb;
+    const double redownload_cost = 1.0 + std::log2(1.0 + size_gb);
+    return (1.0 + age_days) * size_gb /
+           ((1.0 + std::max(0.0, candidate.use_count)) * redownload_cost);
+}
+
+std::vector<StoreCandidate> StoreEvictionPolicy::plan(std::vector<StoreCandidate> candidates,
+                                                      uint64_t quota_bytes,
+                                                      int64_t now) {
+    uint64_t total_bytes = 0;
+    for (const auto& candidate : candidates) {
+        total_bytes += candidate.size_bytes;
+    }
+    if (total_bytes <= quota_bytes) {
+        return {};
+    }
+
+    std::stable_sort(candidates.begin(), candidates.end(),
+                     [now](const StoreCandidate& a, const StoreCandidate& b) {
+                         return eviction_score(a, now) > eviction_score(b, now);
+                     });
+
+    std::vector<StoreCandidate> evictions;
+    for (auto& candidate : candidates) {
+        if (total_bytes <= quota_bytes) {
+            break;
+        }
+        if (candidate.pinned) {
+            continue;
+        }
+        total_bytes -= candidate.size_bytes;
+        evictions.push_back(std::move(candidate));
+    }
+    return evictions;
+}
+
+} // namespace lemon
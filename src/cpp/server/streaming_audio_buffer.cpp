@@ -7,6 +7,57 @@
 
 namespace lemon {
 
+StreamingAudioBuffer::StreamingAudioBuffer()
+    : ring_(CAPACITY_SAMPLES) {
+}
+
+void StreamingAudioBuffer::push_samples(const int16_t* data, size_t count) {
+    if (count == 0) {
+        return;
+    }
+
+    const uint64_t head = head_.load(std::memory_order_acquire);
+    const uint64_t tail = tail_.load(std::memory_order_relaxed);
+    const size_t free_space = CAPACITY_SAMPLES - static_cast<size_t>(tail - head);
+    const size_t to_write = (std::min)(count, free_space);
+    const size_t dropped = count - to_write;
+
+    const size_t idx = static_cast<size_t>(tail % CAPACITY_SAMPLES);
+    const size_t first_segment = (std::min)(to_write, CAPACITY_SAMPLES - idx);
+    std::memcpy(ring_.data() + idx, data, first_segment * sizeof(int16_t));
+    if (to_write > first_segment) {
+        std::memcpy(ring_.data(), data + first_segment,
+                    (to_write - first_segment) * sizeof(int16_t));
+    }
+    tail_.store(tail + to_write, std::memory_order_release);
+
+    if (dropped > 0 &&
+        overflow_.fetch_add(dropped, std::memory_order_relaxed) == 0) {
+        LOG(WARNING, "AudioBuffer") << "Ring full, dropping audio ("
+                                    << dropped << " samples); consumer is not draining" << std::endl;
+    }
+}
+
+std::vector<int16_t> StreamingAudioBuffer::snapshot() const {
+    const uint64_t tail = tail_.load(std::memory_order_acquire);
+    const uint64_t head = head_.load(std::memory_order_relaxed);
+    const size_t count = static_cast<size_t>(tail - head);
+
+    std::vector<int16_t> out(count);
+    if (count == 0) {
+        return out;
+    }
+
+    const size_t idx = static_cast<size_t>(head % CAPACITY_SAMPLES);
+    const size_t first_segment = (std::min)(count, CAPACITY_SAMPLES - idx);
+    std::memcpy(out.data(), ring_.data() + idx, first_segment * sizeof(int16_t));
+    if (count > first_segment) {
+        std::memcpy(out.data() + first_segment, ring_.data(),
+                    (count - first_segment) * sizeof(int16_t));
+    }
+    return out;
+}
+
 void StreamingAudioBuffer::append(const std::string& base64_audio) {
     if (base64_audio.empty()) {
         return;
@@ -51,17 +102,11 @@ void StreamingAudioBuffer::append(const std::string& base64_audio) {
         LOG(DEBUG, "AudioBuffer") << "base64 prefix: " << base64_audio.substr(0, 40) << std::endl;
     }
 
-    std::lock_guard<std::mutex> lock(mutex_);
-    samples_.insert(samples_.end(), new_samples.begin(), new_samples.end());
+    push_samples(new_samples.data(), num_samples);
 }
 
 void StreamingAudioBuffer::append_raw(const std::vector<int16_t>& samples) {
-    if (samples.empty()) {
-        return;
-    }
-
-    std::lock_guard<std::mutex> lock(mutex_);
-    samples_.insert(samples_.end(), samples.begin(), samples.end());
+    push_samples(samples.data(), samples.size());
 }
 
 std::vector<uint8_t> StreamingAudioBuffer::build_wav(const std::vector<int16_t>& samples) {
@@ -117,72 +162,80 @@ std::vector<uint8_t> StreamingAudioBuffer::build_wav(const std::vector<int16_t>&
 }
 
 std::vector<uint8_t> StreamingAudioBuffer::get_wav() const {
-    std::lock_guard<std::mutex> lock(mutex_);
-    return build_wav(samples_);
+    return build_wav(snapshot());
 }
 
 std::vector<uint8_t> StreamingAudioBuffer::get_wav_padded(int min_duration_ms) const {
-    std::lock_guard<std::mutex> lock(mutex_);
+    std::vector<int16_t> samples = snapshot();
 
     size_t min_samples = static_cast<size_t>(min_duration_ms) * SAMPLE_RATE / 1000;
-
-    if (samples_.size() >= min_samples) {
-        // No padding needed
-        return build_wav(samples_);
+    if (samples.size() < min_samples) {
+        // Pad with silence (zeros) at the end
+        samples.resize(min_samples, 0);
     }
 
-    // Copy samples and pad with silence (zeros) at the end
-    std::vector<int16_t> padded_samples(samples_);
-    padded_samples.resize(min_samples, 0);
-
-    return build_wav(padded_samples);
+    return build_wav(samples);
 }
 
 std::vector<float> StreamingAudioBuffer::get_samples() const {
-    std::lock_guard<std::mutex> lock(mutex_);
+    std::vector<int16_t> samples = snapshot();
 
-    std::vector<float> float_samples(samples_.size());
-    for (size_t i = 0; i < samples_.size(); i++) {
-        float_samples[i] = samples_[i] / 32768.0f;
+    std::vector<float> float_samples(samples.size());
+    for (size_t i = 0; i < samples.size(); i++) {
+        float_samples[i] = samples[i] / 32768.0f;
     }
     return float_samples;
 }
 
 std::vector<float> StreamingAudioBuffer::get_recent_samples(int ms) const {
-    std::lock_guard<std::mutex> lock(mutex_);
+    std::vector<float> float_samples;
+    copy_recent_samples(ms, float_samples);
+    return float_samples;
+}
+
+size_t StreamingAudioBuffer::copy_recent_samples(int ms, std::vector<float>& out) const {
+    const uint64_t tail = tail_.load(std::memory_order_acquire);
+    const uint64_t head = head_.load(std::memory_order_relaxed);
+    const size_t available = static_cast<size_t>(tail - head);
 
     size_t num_samples = static_cast<size_t>(ms * SAMPLE_RATE / 1000);
-    if (num_samples > samples_.size()) {
-        num_samples = samples_.size();
+    if (num_samples > available) {
+        num_samples = available;
     }
 
-    std::vector<float> float_samples(num_samples);
-    size_t start_idx = samples_.size() - num_samples;
-
-    for (size_t i = 0; i < num_samples; i++) {
-        float_samples[i] = samples_[start_idx + i] / 32768.0f;
+    out.resize(num_samples);
+    const uint64_t start = tail - num_samples;
+    const size_t idx = static_cast<size_t>(start % CAPACITY_SAMPLES);
+    const size_t first_segment = (std::min)(num_samples, CAPACITY_SAMPLES - idx);
+    for (size_t i = 0; i < first_segment; i++) {
+        out[i] = ring_[idx + i] / 32768.0f;
     }
-    return float_samples;
+    for (size_t i = first_segment; i < num_samples; i++) {
+        out[i] = ring_[i - first_segment] / 32768.0f;
+    }
+    return num_samples;
 }
 
 void StreamingAudioBuffer::clear() {
-    std::lock_guard<std::mutex> lock(mutex_);
-    samples_.clear();
+    head_.store(tail_.load(std::memory_order_acquire), std::memory_order_release);
 }
 
 int StreamingAudioBuffer::duration_ms() const {
-    std::lock_guard<std::mutex> lock(mutex_);
-    return static_cast<int>(samples_.size() * 1000 / SAMPLE_RATE);
+    return static_cast<int>(sample_count() * 1000 / SAMPLE_RATE);
 }
 
 size_t StreamingAudioBuffer::sample_count() const {
-    std::lock_guard<std::mutex> lock(mutex_);
-    return samples_.size();
+    const uint64_t tail = tail_.load(std::memory_order_acquire);
+    const uint64_t head = head_.load(std::memory_order_relaxed);
+    return static_cast<size_t>(tail - head);
 }
 
 bool StreamingAudioBuffer::empty() const {
-    std::lock_guard<std::mutex> lock(mutex_);
-    return samples_.empty();
+    return sample_count() == 0;
+}
+
+uint64_t StreamingAudioBuffer::overflow_samples() const {
+    return overflow_.load(std::memory_order_relaxed);
 }
 
 } // namespace lemon
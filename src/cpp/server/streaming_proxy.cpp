@@ -1,9 +1,20 @@
 #include "lemon/streaming_proxy.h"
+#include "lemon/buffer_pool.h"
+#include "lemon/speculative_stats.h"
+#include "telemetry.h"
+#include <atomic>
 #include <sstream>
 #include <iostream>
 #include <chrono>
+#include <condition_variable>
 #include <cstring>
+#include <deque>
+#include <memory>
+#include <mutex>
 #include <stdexcept>
+#include <string_view>
+#include <thread>
+#include <vector>
 #include <curl/curl.h>
 #include <lemon/utils/aixlog.hpp>
 
@@ -11,6 +22,146 @@ namespace lemon {
 
 namespace {
 
+std::atomic<size_t> g_high_water_mark{1024 * 1024};
+std::atomic<uint64_t> g_sink_blocked_ms{0};
+
+std::map<std::string, std::string> backend_trace_headers() {
+    std::map<std::string, std::string> headers;
+    const std::string traceparent = telemetry::current_traceparent();
+    if (!traceparent.empty()) {
+        headers["traceparent"] = traceparent;
+    }
+    return headers;
+}
+
+// Decouples backend reads from client writes. Chunks queue up to the
+// high-water mark so momentary client stalls do not stall the backend socket;
+// past it, write() blocks the curl callback, which stops curl reading from the
+// backend until the writer thread drains below the mark.
+class BoundedSinkWriter {
+public:
+    BoundedSinkWriter(httplib::DataSink& sink, size_t high_water_mark)
+        : sink_(sink), high_water_mark_(high_water_mark),
+          writer_([this] { run(); }) {}
+
+    ~BoundedSinkWriter() {
+        finish();
+    }
+
+    bool write(const char* data, size_t length) {
+        std::unique_lock<std::mutex> lock(mutex_);
+        if (buffered_ + length > high_water_mark_ && !failed_) {
+            const auto blocked_start = std::chrono::steady_clock::now();
+            space_cv_.wait(lock, [this, length] {
+                return failed_ || buffered_ + length <= high_water_mark_ || buffered_ == 0;
+            });
+            blocked_ms_ += std::chrono::duration_cast<std::chrono::milliseconds>(
+                std::chrono::steady_clock::now() - blocked_start).count();
+        }
+        if (failed_) {
+            return false;
+        }
+        // Reuse buffers the writer thread already drained; spare_ lives under
+        // mutex_ because the global pool's free lists are thread-local and the
+        // producer and writer are different threads.
+        BufferPool::Handle chunk;
+        if (!spare_.empty()) {
+            chunk = std::move(spare_.back());
+            spare_.pop_back();
+        } else {
+            chunk = BufferPool::acquire(length);
+        }
+        chunk.str().assign(data, length);
+        chunks_.push_back(std::move(chunk));
+        buffered_ += length;
+        data_cv_.notify_one();
+        return true;
+    }
+
+    // Flushes queued chunks and joins the writer thread; false if the sink
+    // rejected a write (client disconnected).
+    bool finish() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (done_) {
+                return !failed_;
+            }
+            done_ = true;
+            data_cv_.notify_one();
+        }
+        writer_.join();
+        return !failed_;
+    }
+
+    uint64_t blocked_ms() const {
+        return blocked_ms_;
+    }
+
+    // True once the client socket is known dead — either a write failed or
+    // the idle liveness probe saw the connection close. Polled by the curl
+    // transfer so an abandoned request stops the backend even when the
+    // backend has produced no bytes yet (e.g. still in prompt processing).
+    bool client_gone() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return failed_;
+    }
+
+private:
+    void run() {
+        std::unique_lock<std::mutex> lock(mutex_);
+        while (true) {
+            data_cv_.wait_for(lock, std::chrono::milliseconds(250),
+                              [this] { return !chunks_.empty() || done_; });
+            if (chunks_.empty()) {
+                if (done_) {
+                    return;
+                }
+                // Idle tick: probe the socket so a disconnect during a quiet
+                // stretch is noticed without waiting for the next chunk.
+                if (!sink_.is_writable()) {
+                    failed_ = true;
+                    space_cv_.notify_all();
+                    return;
+                }
+                continue;
+            }
+            BufferPool::Handle chunk = std::move(chunks_.front());
+            chunks_.pop_front();
+            lock.unlock();
+            const bool ok = sink_.write(chunk.str().data(), chunk.str().size());
+            const size_t written = chunk.str().size();
+            lock.lock();
+            buffered_ -= written;
+            if (spare_.size() < kMaxSpareBuffers) {
+                spare_.push_back(std::move(chunk));
+            }
+            if (!ok) {
+                failed_ = true;
+                chunks_.clear();
+                buffered_ = 0;
+                space_cv_.notify_all();
+                return;
+            }
+            space_cv_.notify_all();
+        }
+    }
+
+    static constexpr size_t kMaxSpareBuffers = 8;
+
+    httplib::DataSink& sink_;
+    size_t high_water_mark_;
+    std::deque<BufferPool::Handle> chunks_;
+    std::vector<BufferPool::Handle> spare_;
+    size_t buffered_ = 0;
+    bool done_ = false;
+    bool failed_ = false;
+    uint64_t blocked_ms_ = 0;
+    std::mutex mutex_;
+    std::condition_variable space_cv_;
+    std::condition_variable data_cv_;
+    std::thread writer_;
+};
+
 void extract_telemetry_from_chunk(const nlohmann::json& chunk, StreamingProxy::TelemetryData& telemetry) {
     nlohmann::json usage;
     if (chunk.contains("usage")) {
@@ -46,6 +197,7 @@ void extract_telemetry_from_chunk(const nlohmann::json& chunk, StreamingProxy::T
     }
 
     if (timings.is_object()) {
+        SpeculativeStats::record_from_timings(timings);
         if (timings.contains("prompt_n")) {
             telemetry.input_tokens = timings["prompt_n"].get<int>();
         }
@@ -70,7 +222,8 @@ void StreamingProxy::forward_sse_stream(
     httplib::DataSink& sink,
     std::function<void(const TelemetryData&)> on_complete,
     long timeout_seconds,
-    std::function<void()> on_chunk) {
+    std::function<void()> on_chunk,
+    long idle_timeout_seconds) {
 
     TelemetryData telemetry;
     try {
@@ -80,13 +233,28 @@ void StreamingProxy::forward_sse_stream(
         }
     } catch (...) {}
     std::string line_buffer;
+    // Zero-copy passthrough: backend bytes go straight to the sink. Per-line we
+    // only do a byte search for the usage/timings markers and stash the last
+    // matching line; it is parsed as JSON once, after the stream completes.
+    std::string last_usage_line;
     bool stream_error = false;
     bool has_done_marker = false;
     bool has_first_token = false;
     double time_to_first_token = 0.0;
     const auto start_time = std::chrono::steady_clock::now();
 
-    auto process_line = [&telemetry](const std::string& line) {
+    auto process_line = [&last_usage_line](const std::string& line) {
+        if (line.compare(0, 6, "data: ") != 0 &&
+            line.compare(0, 21, "ChatCompletionChunk: ") != 0) {
+            return;
+        }
+        if (line.find("\"usage\"") != std::string::npos ||
+            line.find("\"timings\"") != std::string::npos) {
+            last_usage_line = line;
+        }
+    };
+
+    auto parse_usage_line = [&telemetry](const std::string& line) {
         std::string json_str;
         if (line.find("data: ") == 0) {
             json_str = line.substr(6);
@@ -101,11 +269,22 @@ void StreamingProxy::forward_sse_stream(
         }
     };
 
+    BoundedSinkWriter writer(sink, g_high_water_mark.load());
+
+    auto last_activity = std::make_shared<std::atomic<std::int64_t>>(
+        std::chrono::duration_cast<std::chrono::milliseconds>(
+            start_time.time_since_epoch()).count());
+    bool idle_timed_out = false;
+
     utils::HttpResponse result = utils::HttpClient::post_stream(
         backend_url,
         request_body,
-        [&sink, &line_buffer, &has_done_marker, &has_first_token,
-         &time_to_first_token, &start_time, &on_chunk, &process_line](const char* data, size_t length) {
+        [&writer, &line_buffer, &has_done_marker, &has_first_token,
+         &time_to_first_token, &start_time, &on_chunk, &process_line,
+         last_activity](const char* data, size_t length) {
+            last_activity->store(
+                std::chrono::duration_cast<std::chrono::milliseconds>(
+                    std::chrono::steady_clock::now().time_since_epoch()).count());
             if (on_chunk) {
                 on_chunk();
             }
@@ -113,34 +292,69 @@ void StreamingProxy::forward_sse_stream(
             line_buffer.append(data, length);
             process_sse_lines(line_buffer, process_line);
 
-            std::string chunk(data, length);
-            if (!has_first_token && chunk.find("data: ") != std::string::npos) {
+            std::string_view chunk(data, length);
+            if (!has_first_token && chunk.find("data: ") != std::string_view::npos) {
                 has_first_token = true;
                 time_to_first_token = std::chrono::duration<double>(
                     std::chrono::steady_clock::now() - start_time).count();
             }
 
-            if (chunk.find("data: [DONE]") != std::string::npos) {
+            if (chunk.find("data: [DONE]") != std::string_view::npos) {
                 has_done_marker = true;
             }
 
-            if (!sink.write(data, length)) {
+            if (!writer.write(data, length)) {
                 return false;
             }
 
             return true;
         },
-        {},
+        backend_trace_headers(),
         timeout_seconds,
         nullptr,
-        utils::HttpSecurityPolicy::TrustedLoopback
+        utils::HttpSecurityPolicy::TrustedLoopback,
+        [&writer, last_activity, idle_timeout_seconds, &idle_timed_out] {
+            if (writer.client_gone()) return true;
+            if (idle_timeout_seconds > 0) {
+                const auto now_ms =
+                    std::chrono::duration_cast<std::chrono::milliseconds>(
+                        std::chrono::steady_clock::now().time_since_epoch()).count();
+                if (now_ms - last_activity->load() > idle_timeout_seconds * 1000) {
+                    idle_timed_out = true;
+                    return true;
+                }
+            }
+            return false;
+        }
     );
 
+    const bool sink_alive = writer.finish();
+    if (writer.blocked_ms() > 0) {
+        g_sink_blocked_ms += writer.blocked_ms();
+        LOG(DEBUG, "StreamingProxy") << "Backend reads paused " << writer.blocked_ms()
+                                     << "ms waiting on slow client" << std::endl;
+    }
+    if (!sink_alive && result.curl_code == CURLE_OK) {
+        // The last queued chunks failed to reach the client after the backend
+        // had already finished cleanly.
+        stream_error = true;
+        telemetry.error_message = "Client disconnected during stream";
+    }
+
     const bool transport_interrupted =
         result.curl_code == CURLE_PARTIAL_FILE || result.curl_code == CURLE_RECV_ERROR;
 
     if (result.curl_code != CURLE_OK) {
-        if (result.curl_code == CURLE_WRITE_ERROR) {
+        if (idle_timed_out && result.curl_code == CURLE_ABORTED_BY_CALLBACK) {
+            // The backend went quiet for longer than the idle budget; surface
+            // it like a backend failure so the caller health-flags and resets
+            // instead of reporting a client disconnect.
+            throw std::runtime_error(
+                "backend produced no stream output for " +
+                std::to_string(idle_timeout_seconds) + "s (idle timeout)");
+        }
+        if (result.curl_code == CURLE_WRITE_ERROR ||
+            result.curl_code == CURLE_ABORTED_BY_CALLBACK) {
             stream_error = true;
             LOG(WARNING, "StreamingProxy") << "Client disconnected during SSE stream (CURL error: " << result.curl_error << ")" << std::endl;
             telemetry.error_message = "Client disconnected during stream";
@@ -187,6 +401,9 @@ void StreamingProxy::forward_sse_stream(
             }
             process_line(line_buffer);
         }
+        if (!last_usage_line.empty()) {
+            parse_usage_line(last_usage_line);
+        }
 
         if (telemetry.time_to_first_token <= 0.0) {
             telemetry.time_to_first_token = time_to_first_token;
@@ -206,6 +423,9 @@ void StreamingProxy::forward_sse_stream(
         }
     } else {
         sink.done();
+        if (!last_usage_line.empty()) {
+            parse_usage_line(last_usage_line);
+        }
         if (on_complete) {
             on_complete(telemetry);
         }
@@ -249,10 +469,11 @@ void StreamingProxy::forward_byte_stream(
 
             return true;
         },
-        {},
+        backend_trace_headers(),
         timeout_seconds,
         [&backend_status](int status) { backend_status = status; },
-        utils::HttpSecurityPolicy::TrustedLoopback
+        utils::HttpSecurityPolicy::TrustedLoopback,
+        [&sink] { return !sink.is_writable(); }
     );
 
     const bool transport_interrupted =
@@ -260,7 +481,8 @@ void StreamingProxy::forward_byte_stream(
 
     if (result.curl_code != CURLE_OK) {
         stream_error = true;
-        if (result.curl_code == CURLE_WRITE_ERROR) {
+        if (result.curl_code == CURLE_WRITE_ERROR ||
+            result.curl_code == CURLE_ABORTED_BY_CALLBACK) {
             LOG(WARNING, "StreamingProxy") << "Client disconnected during byte stream (CURL error: " << result.curl_error << ")" << std::endl;
         } else if (transport_interrupted) {
             // Keep byte streams consistent with SSE: an interrupted transport is a
@@ -356,6 +578,14 @@ void StreamingProxy::process_sse_lines(std::string& line_buffer, std::function<v
     }
 }
 
+void StreamingProxy::set_high_water_mark(size_t bytes) {
+    g_high_water_mark = bytes;
+}
+
+uint64_t StreamingProxy::sink_blocked_ms_total() {
+    return g_sink_blocked_ms.load();
+}
+
 void StreamingProxy::accumulate_responses_delta(const nlohmann::json& parsed, std::string& accumulated_text) {
     if (parsed.contains("choices") && parsed["choices"].is_array() && !parsed["choices"].empty()) {
         auto choice = parsed["choices"][0];
@@ -4219,6 +4219,145 @@ double get_windows_dxgi_vram_usage() {
 }
 #endif
 
+std::vector<SystemInfo::GpuMemoryDevice> SystemInfo::get_gpu_memory_per_device() {
+    std::vector<GpuMemoryDevice> devices;
+
+    if (!find_executable_in_path("nvidia-smi").empty()) {
+        std::string output;
+        const int rc = lemon::utils::ProcessManager::run_command(
+            "nvidia-smi --query-gpu=index,memory.used,memory.total --format=csv,noheader,nounits",
+            output, 5);
+        if (rc == 0 && !output.empty()) {
+            std::istringstream iss(output);
+            std::string line;
+            while (std::getline(iss, line)) {
+                std::istringstream fields(line);
+                std::string index_str, used_str, total_str;
+                if (!std::getline(fields, index_str, ',') ||
+                    !std::getline(fields, used_str, ',') ||
+                    !std::getline(fields, total_str, ',')) {
+                    continue;
+                }
+
+                try {
+                    GpuMemoryDevice dev;
+                    dev.index = std::stoi(index_str);
+                    dev.vendor = "nvidia";
+                    dev.used_bytes =
+                        static_cast<uint64_t>(std::stod(used_str)) * 1024 * 1024;
+                    dev.total_bytes =
+                        static_cast<uint64_t>(std::stod(total_str)) * 1024 * 1024;
+                    if (dev.total_bytes > 0) {
+                        devices.push_back(dev);
+                    }
+                } catch (...) {
+                }
+            }
+        }
+    }
+
+#ifdef __linux__
+    try {
+        const fs::path drm_path = "/sys/class/drm";
+        if (fs::exists(drm_path)) {
+            auto read_sysfs_u64 = [](const fs::path& path, uint64_t& value) {
+                std::ifstream file(path);
+                return file.is_open() && static_cast<bool>(file >> value);
+            };
+
+            // directory_iterator order is unspecified; sort by card number so
+            // the per-vendor ordinal is stable across calls.
+            std::vector<std::pair<int, fs::path>> cards;
+            for (const auto& entry : fs::directory_iterator(drm_path)) {
+                const std::string card_name = entry.path().filename().string();
+                if (card_name.rfind("card", 0) != 0 ||
+                    card_name.find('-') != std::string::npos) {
+                    continue;
+                }
+                try {
+                    cards.push_back({std::stoi(card_name.substr(4)), entry.path()});
+                } catch (...) {
+                }
+            }
+            std::sort(cards.begin(), cards.end());
+
+            int amd_ordinal = 0;
+            for (const auto& card : cards) {
+                const fs::path device_path = card.second / "device";
+
+                uint64_t vram_used = 0;
+                uint64_t vram_total = 0;
+                if (!read_sysfs_u64(device_path / "mem_info_vram_used", vram_used) ||
+                    !read_sysfs_u64(device_path / "mem_info_vram_total", vram_total) ||
+                    vram_total == 0) {
+                    continue;
+                }
+
+                GpuMemoryDevice dev;
+                dev.index = amd_ordinal++;
+                dev.vendor = "amd";
+                dev.integrated = query_amdgpu_is_apu(card.second);
+                dev.used_bytes = std::min(vram_used, vram_total);
+                dev.total_bytes = vram_total;
+                devices.push_back(dev);
+            }
+        }
+    } catch (...) {}
+#endif
+
+#ifdef _WIN32
+    // NVIDIA is already covered by nvidia-smi above; DXGI fills in AMD adapters.
+    {
+        using Microsoft::WRL::ComPtr;
+        ComPtr<IDXGIFactory4> factory;
+        if (SUCCEEDED(CreateDXGIFactory1(IID_PPV_ARGS(&factory)))) {
+            ComPtr<IDXGIAdapter1> adapter;
+            int amd_ordinal = 0;
+            for (UINT adapterIndex = 0;
+                 factory->EnumAdapters1(adapterIndex, &adapter) != DXGI_ERROR_NOT_FOUND;
+                 ++adapterIndex) {
+                DXGI_ADAPTER_DESC1 desc{};
+                if (FAILED(adapter->GetDesc1(&desc))) {
+                    continue;
+                }
+                if (desc.Flags & DXGI_ADAPTER_FLAG_SOFTWARE) {
+                    continue;
+                }
+                if (desc.VendorId != 0x1002) {
+                    continue;
+                }
+
+                ComPtr<IDXGIAdapter3> adapter3;
+                if (FAILED(adapter.As(&adapter3))) {
+                    continue;
+                }
+                DXGI_QUERY_VIDEO_MEMORY_INFO memInfo{};
+                if (FAILED(adapter3->QueryVideoMemoryInfo(
+                        0, DXGI_MEMORY_SEGMENT_GROUP_LOCAL, &memInfo))) {
+                    continue;
+                }
+
+                GpuMemoryDevice dev;
+                dev.index = amd_ordinal++;
+                dev.vendor = "amd";
+                dev.integrated = (desc.DedicatedVideoMemory == 0);
+                dev.total_bytes = dev.integrated
+                    ? static_cast<uint64_t>(desc.SharedSystemMemory)
+                    : static_cast<uint64_t>(desc.DedicatedVideoMemory);
+                dev.used_bytes = dev.total_bytes > memInfo.Budget
+                    ? dev.total_bytes - static_cast<uint64_t>(memInfo.Budget)
+                    : 0;
+                if (dev.total_bytes > 0) {
+                    devices.push_back(dev);
+                }
+            }
+        }
+    }
+#endif
+
+    return devices;
+}
+
 double SystemInfo::get_global_vram_usage_pct() {
     auto usage_ratio = [](uint64_t used, uint64_t total) {
         if (total == 0) {
@@ -0,0 +1,98 @@
+#include "lemon/system_stats_history.h"
+
+#include "lemon/system_metrics_platform.h"
+#include "lemon/utils/aixlog.hpp"
+
+#include <chrono>
+
+namespace lemon {
+
+SystemStatsHistory::SystemStatsHistory() : ring_(kCapacity) {}
+
+SystemStatsHistory::~SystemStatsHistory() {
+    stop();
+}
+
+void SystemStatsHistory::start(int interval_ms) {
+    if (sampler_thread_.joinable()) return;
+    interval_ms_ = interval_ms > 0 ? interval_ms : kDefaultIntervalMs;
+    stop_requested_ = false;
+    metrics_platform_ = create_metrics_platform();
+    if (!metrics_platform_) {
+        LOG(WARNING, "StatsHistory") << "No metrics platform available, history disabled" << std::endl;
+        return;
+    }
+    sampler_thread_ = std::thread(&SystemStatsHistory::sampler_loop, this);
+}
+
+void SystemStatsHistory::stop() {
+    {
+        std::lock_guard<std::mutex> lock(cv_mutex_);
+        stop_requested_ = true;
+    }
+    cv_.notify_all();
+    if (sampler_thread_.joinable()) {
+        sampler_thread_.join();
+    }
+}
+
+std::vector<SystemStatsHistory::Sample> SystemStatsHistory::snapshot(int64_t since_timestamp) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::vector<Sample> out;
+    out.reserve(count_);
+    const size_t start = (head_ + kCapacity - count_) % kCapacity;
+    for (size_t i = 0; i < count_; ++i) {
+        const Sample& s = ring_[(start + i) % kCapacity];
+        if (s.timestamp >= since_timestamp) {
+            out.push_back(s);
+        }
+    }
+    return out;
+}
+
+bool SystemStatsHistory::latest(Sample& out) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (count_ == 0) return false;
+    out = ring_[(head_ + kCapacity - 1) % kCapacity];
+    return true;
+}
+
+uint64_t SystemStatsHistory::total_samples() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return total_;
+}
+
+void SystemStatsHistory::record(const Sample& sample) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    ring_[head_] = sample;
+    head_ = (head_ + 1) % kCapacity;
+    if (count_ < kCapacity) ++count_;
+    ++total_;
+}
+
+void SystemStatsHistory::sampler_loop() {
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(cv_mutex_);
+            cv_.wait_for(lock, std::chrono::milliseconds(interval_ms_),
+                         [this] { return stop_requested_; });
+            if (stop_requested_) return;
+        }
+
+        Sample s;
+        s.timestamp = std::chrono::duration_cast<std::chrono::seconds>(
+                          std::chrono::system_clock::now().time_since_epoch())
+                          .count();
+        s.vram_gb = static_cast<float>(metrics_platform_->get_vram_usage_gb());
+        const double mem = metrics_platform_->get_memory_usage_gb();
+        s.memory_gb = mem > 0 ? static_cast<float>(mem) : -1.0f;
+        s.npu_percent = static_cast<float>(metrics_platform_->get_npu_utilization());
+        s.cpu_percent = static_cast<float>(metrics_platform_->get_cpu_usage(
+            cpu_stats_mutex_, cpu_last_total_, cpu_last_idle_));
+        s.gpu_percent = static_cast<float>(metrics_platform_->get_gpu_usage());
+        s.devices = metrics_platform_->get_device_utilization();
+        record(s);
+    }
+}
+
+} // namespace lemon
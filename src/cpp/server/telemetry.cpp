@@ -4,6 +4,7 @@
 #include "lemon/utils/aixlog.hpp"
 #include "lemon/utils/http_client.h"
 #include "lemon/version.h"
+#include <array>
 #include <cctype>
 #include <condition_variable>
 #include <cstdlib>
@@ -100,118 +101,259 @@ std::string hex_to_bytes(const std::string& hex) {
     return bytes;
 }
 
-std::string strip_thinking(const std::string& text) {
-    std::string result = text;
-    std::vector<std::pair<std::string, std::string>> tag_pairs = {
-        {"<|think|>", "</|think|>"},
-        {"<|think|>", "<turn|>"},
-        {"<|think|>", "<|turn>"},
-        {"<think>", "</think>"},
-        {"<thought>", "</thought>"}
+namespace {
+
+enum class ThinkToken {
+    StartPipe,     // <|think|>
+    StartPlain,    // <think>
+    StartThought,  // <thought>
+    EndPipe,       // </|think|>
+    EndPlain,      // </think>
+    EndPipeAlt,    // </think|>
+    EndThought,    // </thought>
+    TurnA,         // <turn|>
+    TurnB,         // <|turn>
+};
+
+bool is_start_token(ThinkToken t) {
+    return t == ThinkToken::StartPipe || t == ThinkToken::StartPlain ||
+           t == ThinkToken::StartThought;
+}
+
+bool is_end_token(ThinkToken t) {
+    return t == ThinkToken::EndPipe || t == ThinkToken::EndPlain ||
+           t == ThinkToken::EndPipeAlt || t == ThinkToken::EndThought;
+}
+
+// Each start dialect is only closed by its own end tag, never by another
+// dialect's.
+ThinkToken end_token_for(ThinkToken start) {
+    switch (start) {
+        case ThinkToken::StartPipe: return ThinkToken::EndPipe;
+        case ThinkToken::StartThought: return ThinkToken::EndThought;
+        default: return ThinkToken::EndPlain;
+    }
+}
+
+bool is_tag_space(char c) {
+    return c == ' ' || c == '\t' || c == '\r' || c == '\n';
+}
+
+// Byte trie compiled once over the fixed tag set; matching at a '<' is a
+// pure table walk instead of one string search per tag per pass. No tag is
+// a prefix of another, so the first terminal state reached is the unique
+// match.
+class ThinkTagTrie {
+public:
+    static const ThinkTagTrie& instance() {
+        static const ThinkTagTrie trie;
+        return trie;
+    }
+
+    bool match(const std::string& text, size_t pos, ThinkToken& token,
+               size_t& length) const {
+        int node = 0;
+        for (size_t i = pos; i < text.size(); ++i) {
+            node = nodes_[node].next[static_cast<unsigned char>(text[i])];
+            if (node == 0) {
+                return false;
+            }
+            if (nodes_[node].terminal) {
+                token = nodes_[node].token;
+                length = i - pos + 1;
+                return true;
+            }
+        }
+        return false;
+    }
+
+private:
+    struct Node {
+        std::array<int, 256> next{};
+        bool terminal = false;
+        ThinkToken token = ThinkToken::StartPlain;
     };
-    for (const auto& [start_tag, end_tag] : tag_pairs) {
-        size_t start_pos = 0;
-        while ((start_pos = result.find(start_tag, start_pos)) != std::string::npos) {
-            size_t end_pos = result.find(end_tag, start_pos + start_tag.length());
-            if (end_pos != std::string::npos) {
-                size_t erase_len = end_pos - start_pos;
-                if (end_tag == "</|think|>" || end_tag == "</think>" || end_tag == "</thought>") {
-                    erase_len += end_tag.length();
-                }
-                result.erase(start_pos, erase_len);
-            } else {
-                result.erase(start_pos);
-                break;
+
+    ThinkTagTrie() {
+        nodes_.emplace_back();
+        add("<|think|>", ThinkToken::StartPipe);
+        add("<think>", ThinkToken::StartPlain);
+        add("<thought>", ThinkToken::StartThought);
+        add("</|think|>", ThinkToken::EndPipe);
+        add("</think>", ThinkToken::EndPlain);
+        add("</think|>", ThinkToken::EndPipeAlt);
+        add("</thought>", ThinkToken::EndThought);
+        add("<turn|>", ThinkToken::TurnA);
+        add("<|turn>", ThinkToken::TurnB);
+    }
+
+    void add(const char* text, ThinkToken token) {
+        int node = 0;
+        for (const char* p = text; *p != '\0'; ++p) {
+            const auto c = static_cast<unsigned char>(*p);
+            if (nodes_[node].next[c] == 0) {
+                nodes_[node].next[c] = static_cast<int>(nodes_.size());
+                nodes_.emplace_back();
             }
+            node = nodes_[node].next[c];
         }
+        nodes_[node].terminal = true;
+        nodes_[node].token = token;
     }
-    size_t first = result.find_first_not_of(" \t\r\n");
+
+    std::vector<Node> nodes_;
+};
+
+std::string trim_tag_space(const std::string& text) {
+    size_t first = text.find_first_not_of(" \t\r\n");
     if (first == std::string::npos) {
         return "";
     }
-    size_t last = result.find_last_not_of(" \t\r\n");
-    return result.substr(first, last - first + 1);
+    size_t last = text.find_last_not_of(" \t\r\n");
+    return text.substr(first, last - first + 1);
 }
 
-std::string standardize_thinking(const std::string& text) {
-    std::string result = text;
-    std::vector<std::string> start_tags = {"<|think|>", "<thought>"};
-    for (const auto& tag : start_tags) {
-        size_t pos = 0;
-        while ((pos = result.find(tag, pos)) != std::string::npos) {
-            result.replace(pos, tag.length(), "<think>");
-            pos += 7;
-        }
+} // namespace
+
+std::string strip_thinking(const std::string& text) {
+    if (text.find('<') == std::string::npos) {
+        return trim_tag_space(text);
     }
 
-    std::vector<std::string> end_tags = {"</|think|>", "</think|>", "</thought>"};
-    for (const auto& tag : end_tags) {
-        size_t pos = 0;
-        while ((pos = result.find(tag, pos)) != std::string::npos) {
-            result.replace(pos, tag.length(), "</think>");
-            pos += 8;
+    const auto& trie = ThinkTagTrie::instance();
+    std::string result;
+    result.reserve(text.size());
+
+    size_t pos = 0;
+    while (pos < text.size()) {
+        size_t lt = text.find('<', pos);
+        if (lt == std::string::npos) {
+            result.append(text, pos, std::string::npos);
+            break;
+        }
+        result.append(text, pos, lt - pos);
+
+        ThinkToken token;
+        size_t length = 0;
+        if (!trie.match(text, lt, token, length) || !is_start_token(token)) {
+            // Orphan end tags, transition tags, and plain '<' pass through.
+            const size_t literal = length > 0 ? length : 1;
+            result.append(text, lt, literal);
+            pos = lt + literal;
+            continue;
         }
-    }
 
-    std::vector<std::string> transition_tags = {"<turn|>", "<|turn>"};
-    for (const auto& transition_tag : transition_tags) {
-        size_t search_pos = 0;
-        while (true) {
-            size_t think_pos = result.find("<think>", search_pos);
-            if (think_pos == std::string::npos) {
+        // Drop everything through the matching end tag; an unclosed block
+        // drops the rest of the text.
+        const ThinkToken end = end_token_for(token);
+        size_t scan = lt + length;
+        pos = text.size();
+        while (scan < text.size()) {
+            const size_t next_lt = text.find('<', scan);
+            if (next_lt == std::string::npos) {
                 break;
             }
-            size_t next_close = result.find("</think>", think_pos + 7);
-            size_t transition_pos = result.find(transition_tag, think_pos + 7);
-
-            if (transition_pos != std::string::npos && (next_close == std::string::npos || next_close > transition_pos)) {
-                result.insert(transition_pos, "</think>\n");
-                search_pos = transition_pos + 9 + transition_tag.length();
-            } else {
-                search_pos = (next_close != std::string::npos) ? next_close + 8 : std::string::npos;
-                if (search_pos == std::string::npos) {
-                    break;
-                }
+            ThinkToken candidate;
+            size_t candidate_length = 0;
+            if (trie.match(text, next_lt, candidate, candidate_length) &&
+                candidate == end) {
+                pos = next_lt + candidate_length;
+                break;
             }
+            scan = next_lt + 1;
         }
     }
 
-    size_t search_start = 0;
-    while (true) {
-        size_t first_think = result.find("<think>", search_start);
-        if (first_think == std::string::npos) {
-            break;
-        }
-        size_t next_pos = first_think + 7;
-        while (next_pos < result.size() && (result[next_pos] == ' ' || result[next_pos] == '\t' || result[next_pos] == '\r' || result[next_pos] == '\n')) {
-            next_pos++;
+    return trim_tag_space(result);
+}
+
+std::string standardize_thinking(const std::string& text) {
+    if (text.find('<') == std::string::npos) {
+        return text;
+    }
+
+    const auto& trie = ThinkTagTrie::instance();
+    std::string result;
+    result.reserve(text.size());
+
+    // Whitespace after an emitted tag is held back so a repeated identical
+    // tag collapses together with the whitespace between the two.
+    enum class LastTag { None, Start, End };
+    LastTag last_tag = LastTag::None;
+    std::string pending_ws;
+    bool open = false;
+
+    auto flush_pending = [&]() {
+        result += pending_ws;
+        pending_ws.clear();
+        last_tag = LastTag::None;
+    };
+
+    auto emit_literal = [&](size_t from, size_t count) {
+        size_t i = from;
+        const size_t end = from + count;
+        while (i < end && last_tag != LastTag::None) {
+            if (is_tag_space(text[i])) {
+                pending_ws.push_back(text[i]);
+                ++i;
+            } else {
+                flush_pending();
+            }
         }
-        if (next_pos + 7 <= result.size() && result.substr(next_pos, 7) == "<think>") {
-            result.erase(first_think + 7, (next_pos + 7) - (first_think + 7));
-            search_start = first_think;
-        } else {
-            search_start = first_think + 7;
+        if (i < end) {
+            result.append(text, i, end - i);
         }
-    }
+    };
 
-    size_t search_end = 0;
-    while (true) {
-        size_t first_close = result.find("</think>", search_end);
-        if (first_close == std::string::npos) {
+    size_t pos = 0;
+    while (pos < text.size()) {
+        size_t lt = text.find('<', pos);
+        if (lt == std::string::npos) {
+            emit_literal(pos, text.size() - pos);
             break;
         }
-        size_t next_pos = first_close + 8;
-        while (next_pos < result.size() && (result[next_pos] == ' ' || result[next_pos] == '\t' || result[next_pos] == '\r' || result[next_pos] == '\n')) {
-            next_pos++;
+        emit_literal(pos, lt - pos);
+        pos = lt;
+
+        ThinkToken token;
+        size_t length = 0;
+        if (!trie.match(text, lt, token, length)) {
+            emit_literal(lt, 1);
+            pos = lt + 1;
+            continue;
         }
-        if (next_pos + 8 <= result.size() && result.substr(next_pos, 8) == "</think>") {
-            result.erase(first_close + 8, (next_pos + 8) - (first_close + 8));
-            search_end = first_close;
+        pos = lt + length;
+
+        if (is_start_token(token)) {
+            if (last_tag == LastTag::Start) {
+                pending_ws.clear();
+            } else {
+                flush_pending();
+                result += "<think>";
+                last_tag = LastTag::Start;
+            }
+            open = true;
+        } else if (is_end_token(token)) {
+            if (last_tag == LastTag::End) {
+                pending_ws.clear();
+            } else {
+                flush_pending();
+                result += "</think>";
+                last_tag = LastTag::End;
+            }
+            open = false;
         } else {
-            search_end = first_close + 8;
+            // Transition tags close an open thinking block and stay verbatim.
+            flush_pending();
+            if (open) {
+                result += "</think>\n";
+                open = false;
+            }
+            result.append(text, lt, length);
         }
     }
 
+    result += pending_ws;
     return result;
 }
 
@@ -443,13 +585,112 @@ private:
 
 static MetricsWorker g_metrics_worker;
 
+static bool is_valid_header_token(const std::string& str) {
+    for (char c : str) {
+        if (c == '\r' || c == '\n' || c == '\0') {
+            return false;
+        }
+    }
+    return true;
+}
+
+static std::string to_lowercase(std::string str) {
+    std::transform(str.begin(), str.end(), str.begin(), [](unsigned char c) {
+        return std::tolower(c);
+    });
+    return str;
+}
+
+struct ExportTarget {
+    bool enabled = false;
+    std::string endpoint;
+    std::map<std::string, std::string> headers;
+    std::string protocol;
+};
+
+// Header parsing and sanitization happen on the export thread, once per batch,
+// so a config or env change between enqueue and send applies to the whole batch.
+static ExportTarget resolve_export_target() {
+    ExportTarget target;
+    auto* config = RuntimeConfig::global();
+    if (!config || !config->telemetry_enabled()) {
+        return target;
+    }
+    target.enabled = true;
+    target.endpoint = config->telemetry_otlp_endpoint();
+    target.protocol = config->telemetry_otlp_protocol();
+
+    auto sanitize_and_insert = [&target](std::string k, std::string v) {
+        size_t start = 0;
+        while (start < k.size() && std::isspace(static_cast<unsigned char>(k[start]))) {
+            start++;
+        }
+        size_t end = k.size();
+        while (end > start && std::isspace(static_cast<unsigned char>(k[end - 1]))) {
+            end--;
+        }
+        k = k.substr(start, end - start);
+
+        start = 0;
+        while (start < v.size() && std::isspace(static_cast<unsigned char>(v[start]))) {
+            start++;
+        }
+        end = v.size();
+        while (end > start && std::isspace(static_cast<unsigned char>(v[end - 1]))) {
+            end--;
+        }
+        v = v.substr(start, end - start);
+
+        if (!k.empty() && is_valid_header_token(k) && is_valid_header_token(v)) {
+            std::string k_lower = to_lowercase(k);
+            if (k_lower != "content-type" && k_lower != "content-length") {
+                target.headers[k] = v;
+            } else {
+                LOG(WARNING, "Telemetry") << "Disallowed overriding well-known OTLP header: " << k << std::endl;
+            }
+        } else if (!k.empty()) {
+            LOG(WARNING, "Telemetry") << "Rejected invalid OTLP header key or value containing CR, LF, or NUL." << std::endl;
+        }
+    };
+
+    for (const auto& [k, v] : config->telemetry_otlp_headers()) {
+        sanitize_and_insert(k, v);
+    }
+
+    if (const char* env_headers = std::getenv("OTEL_EXPORTER_OTLP_HEADERS")) {
+        std::string env_str(env_headers);
+        std::stringstream ss(env_str);
+        std::string item;
+        while (std::getline(ss, item, ',')) {
+            size_t eq = item.find('=');
+            if (eq != std::string::npos) {
+                std::string k = item.substr(0, eq);
+                std::string v = item.substr(eq + 1);
+                sanitize_and_insert(k, v);
+            }
+        }
+    }
+
+    return target;
+}
+
+static void scrub_span_for_export(nlohmann::json& span_details) {
+    if (span_details.contains("attributes") && span_details["attributes"].is_array()) {
+        auto& attrs = span_details["attributes"];
+        for (auto it = attrs.begin(); it != attrs.end(); ) {
+            if (it->is_object() && it->value("key", "") == "lemon.auth_token_hash") {
+                it = attrs.erase(it);
+            } else {
+                ++it;
+            }
+        }
+    }
+}
+
 class TelemetryQueue {
 private:
     struct Task {
         nlohmann::json span_details;
-        std::string endpoint;
-        std::map<std::string, std::string> headers;
-        std::string protocol;
         std::chrono::steady_clock::time_point arrival_time;
     };
 
@@ -462,16 +703,12 @@ private:
     size_t dropped_spans_count_ = 0;
     bool endpoint_unreachable_ = false;
     std::string last_endpoint_;
-    bool last_enabled_ = false;
     bool flush_requested_ = false;
     std::condition_variable cv_flush_;
 
     void worker_loop() {
         while (true) {
             std::vector<nlohmann::json> batch_spans;
-            std::string batch_endpoint;
-            std::map<std::string, std::string> batch_headers;
-            std::string batch_protocol;
 
             {
                 std::unique_lock<std::mutex> lock(mutex_);
@@ -485,21 +722,9 @@ private:
                         return;
                     }
                     if (shutdown_ && !queue_.empty()) {
-                        const auto& oldest_task = queue_.front();
-                        batch_endpoint = oldest_task.endpoint;
-                        batch_headers = oldest_task.headers;
-                        batch_protocol = oldest_task.protocol;
-
-                        auto it = queue_.begin();
-                        while (it != queue_.end()) {
-                            if (it->endpoint == batch_endpoint &&
-                                it->headers == batch_headers &&
-                                it->protocol == batch_protocol) {
-                                batch_spans.push_back(std::move(it->span_details));
-                                it = queue_.erase(it);
-                            } else {
-                                ++it;
-                            }
+                        while (!queue_.empty()) {
+                            batch_spans.push_back(std::move(queue_.front().span_details));
+                            queue_.pop_front();
                         }
                         break;
                     }
@@ -509,26 +734,14 @@ private:
                             cv_flush_.notify_all();
                             break;
                         }
-                        const auto& oldest_task = queue_.front();
-                        batch_endpoint = oldest_task.endpoint;
-                        batch_headers = oldest_task.headers;
-                        batch_protocol = oldest_task.protocol;
-
                         int batch_size = 100;
                         if (auto* config = RuntimeConfig::global()) {
                             batch_size = config->telemetry_otlp_send_batch_size();
                         }
 
-                        auto it = queue_.begin();
-                        while (it != queue_.end() && static_cast<int>(batch_spans.size()) < batch_size) {
-                            if (it->endpoint == batch_endpoint &&
-                                it->headers == batch_headers &&
-                                it->protocol == batch_protocol) {
-                                batch_spans.push_back(std::move(it->span_details));
-                                it = queue_.erase(it);
-                            } else {
-                                ++it;
-                            }
+                        while (!queue_.empty() && static_cast<int>(batch_spans.size()) < batch_size) {
+                            batch_spans.push_back(std::move(queue_.front().span_details));
+                            queue_.pop_front();
                         }
                         LOG(DEBUG, "Telemetry") << "Flush requested. Exporting batch of "
                                                 << batch_spans.size() << " spans..." << std::endl;
@@ -539,11 +752,7 @@ private:
                         continue;
                     }
 
-                    const auto& oldest_task = queue_.front();
-                    std::string target_endpoint = oldest_task.endpoint;
-                    std::map<std::string, std::string> target_headers = oldest_task.headers;
-                    std::string target_protocol = oldest_task.protocol;
-                    auto oldest_arrival = oldest_task.arrival_time;
+                    auto oldest_arrival = queue_.front().arrival_time;
 
                     int batch_size = 100;
                     double timeout_s = 1.0;
@@ -552,33 +761,13 @@ private:
                         timeout_s = config->telemetry_otlp_batch_timeout_s();
                     }
 
-                    int matching_count = 0;
-                    for (const auto& task : queue_) {
-                        if (task.endpoint == target_endpoint &&
-                            task.headers == target_headers &&
-                            task.protocol == target_protocol) {
-                            matching_count++;
-                        }
-                    }
-
                     auto now = std::chrono::steady_clock::now();
                     double elapsed_s = std::chrono::duration<double>(now - oldest_arrival).count();
 
-                    if (matching_count >= batch_size || elapsed_s >= timeout_s) {
-                        batch_endpoint = target_endpoint;
-                        batch_headers = target_headers;
-                        batch_protocol = target_protocol;
-
-                        auto it = queue_.begin();
-                        while (it != queue_.end() && static_cast<int>(batch_spans.size()) < batch_size) {
-                            if (it->endpoint == target_endpoint &&
-                                it->headers == target_headers &&
-                                it->protocol == target_protocol) {
-                                batch_spans.push_back(std::move(it->span_details));
-                                it = queue_.erase(it);
-                            } else {
-                                ++it;
-                            }
+                    if (static_cast<int>(queue_.size()) >= batch_size || elapsed_s >= timeout_s) {
+                        while (!queue_.empty() && static_cast<int>(batch_spans.size()) < batch_size) {
+                            batch_spans.push_back(std::move(queue_.front().span_details));
+                            queue_.pop_front();
                         }
 
                         LOG(DEBUG, "Telemetry") << "Batch target size reached or timeout elapsed. Exporting batch of "
@@ -596,6 +785,27 @@ private:
                 continue;
             }
 
+            ExportTarget target = resolve_export_target();
+            if (!target.enabled || target.endpoint.empty()) {
+                LOG(DEBUG, "Telemetry") << "Telemetry disabled at export time. Dropping batch of "
+                                        << batch_spans.size() << " spans." << std::endl;
+                continue;
+            }
+            for (auto& span : batch_spans) {
+                scrub_span_for_export(span);
+            }
+
+            std::string batch_endpoint = std::move(target.endpoint);
+            std::map<std::string, std::string> batch_headers = std::move(target.headers);
+            std::string batch_protocol = std::move(target.protocol);
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                if (batch_endpoint != last_endpoint_) {
+                    last_endpoint_ = batch_endpoint;
+                    endpoint_unreachable_ = false;
+                }
+            }
+
             std::string payload;
             if (batch_protocol == "http/json") {
                 batch_headers["Content-Type"] = "application/json";
@@ -744,16 +954,10 @@ public:
         shutdown();
     }
 
-    void push(nlohmann::json span_details, std::string endpoint, std::map<std::string, std::string> headers, std::string protocol) {
+    void push(nlohmann::json span_details) {
         std::unique_lock<std::mutex> lock(mutex_);
         if (shutdown_) return;
 
-        if (endpoint != last_endpoint_ || !last_enabled_) {
-            last_endpoint_ = endpoint;
-            last_enabled_ = true;
-            endpoint_unreachable_ = false;
-        }
-
         size_t max_capacity = MAX_CAPACITY;
         if (auto* config = RuntimeConfig::global()) {
             max_capacity = config->telemetry_max_queue_capacity();
@@ -768,13 +972,7 @@ public:
             queue_.pop_front();
         }
 
-        int batch_size = 100;
-        if (auto* config = RuntimeConfig::global()) {
-            batch_size = config->telemetry_otlp_send_batch_size();
-        }
-        LOG(DEBUG, "Telemetry") << "Accumulating span to batch (size " << (queue_.size() + 1) << "/" << batch_size << ")..." << std::endl;
-
-        queue_.push_back({std::move(span_details), std::move(endpoint), std::move(headers), std::move(protocol), std::chrono::steady_clock::now()});
+        queue_.push_back({std::move(span_details), std::chrono::steady_clock::now()});
         cv_.notify_one();
     }
 };
@@ -832,6 +1030,8 @@ InferenceSpan::InferenceSpan(const std::string& span_kind, const std::string& na
         trace_id_ = generate_hex_id(16);
     }
     span_id_ = generate_hex_id(8);
+    g_active_trace_id = trace_id_;
+    g_active_span_id = span_id_;
 
     size_t max_len = 4096;
     if (auto* config = RuntimeConfig::global()) {
@@ -1158,98 +1358,13 @@ void InferenceSpan::cancel() {
     ended_ = true;
 }
 
-static bool is_valid_header_token(const std::string& str) {
-    for (char c : str) {
-        if (c == '\r' || c == '\n' || c == '\0') {
-            return false;
-        }
-    }
-    return true;
-}
-
-static std::string to_lowercase(std::string str) {
-    std::transform(str.begin(), str.end(), str.begin(), [](unsigned char c) {
-        return std::tolower(c);
-    });
-    return str;
-}
-
 void InferenceSpan::submit_span(const nlohmann::json& span_details) {
     emit_span(span_details);
 
     auto* config = RuntimeConfig::global();
     if (!config || !config->telemetry_enabled()) return;
 
-    nlohmann::json scrubbed_span_details = span_details;
-    if (scrubbed_span_details.contains("attributes") && scrubbed_span_details["attributes"].is_array()) {
-        auto& attrs = scrubbed_span_details["attributes"];
-        for (auto it = attrs.begin(); it != attrs.end(); ) {
-            if (it->is_object() && it->value("key", "") == "lemon.auth_token_hash") {
-                it = attrs.erase(it);
-            } else {
-                ++it;
-            }
-        }
-    }
-
-    std::string endpoint = config->telemetry_otlp_endpoint();
-    auto raw_config_headers = config->telemetry_otlp_headers();
-    std::string protocol = config->telemetry_otlp_protocol();
-
-    std::map<std::string, std::string> headers;
-
-    auto sanitize_and_insert = [&headers](std::string k, std::string v) {
-        size_t start = 0;
-        while (start < k.size() && std::isspace(static_cast<unsigned char>(k[start]))) {
-            start++;
-        }
-        size_t end = k.size();
-        while (end > start && std::isspace(static_cast<unsigned char>(k[end - 1]))) {
-            end--;
-        }
-        k = k.substr(start, end - start);
-
-        start = 0;
-        while (start < v.size() && std::isspace(static_cast<unsigned char>(v[start]))) {
-            start++;
-        }
-        end = v.size();
-        while (end > start && std::isspace(static_cast<unsigned char>(v[end - 1]))) {
-            end--;
-        }
-        v = v.substr(start, end - start);
-
-        if (!k.empty() && is_valid_header_token(k) && is_valid_header_token(v)) {
-            std::string k_lower = to_lowercase(k);
-            if (k_lower != "content-type" && k_lower != "content-length") {
-                headers[k] = v;
-            } else {
-                LOG(WARNING, "Telemetry") << "Disallowed overriding well-known OTLP header: " << k << std::endl;
-            }
-        } else if (!k.empty()) {
-            LOG(WARNING, "Telemetry") << "Rejected invalid OTLP header key or value containing CR, LF, or NUL." << std::endl;
-        }
-    };
-
-    for (const auto& [k, v] : raw_config_headers) {
-        sanitize_and_insert(k, v);
-    }
-
-    if (const char* env_headers = std::getenv("OTEL_EXPORTER_OTLP_HEADERS")) {
-        std::string env_str(env_headers);
-        std::stringstream ss(env_str);
-        std::string item;
-        while (std::getline(ss, item, ',')) {
-            size_t eq = item.find('=');
-            if (eq != std::string::npos) {
-                std::string k = item.substr(0, eq);
-                std::string v = item.substr(eq + 1);
-                sanitize_and_insert(k, v);
-            }
-        }
-    }
-
-    get_queue().push(std::move(scrubbed_span_details), std::move(endpoint), std::move(headers), std::move(protocol));
+    get_queue().push(span_details);
 }
 
 std::shared_ptr<InferenceSpan> TelemetryTracker::start_span(const std::string& span_kind, const std::string& name, const std::string& model_name, const nlohmann::json& request_json) {
@@ -1369,5 +1484,14 @@ thread_local std::chrono::steady_clock::time_point g_request_start_time;
 thread_local std::string g_current_client_session_id;
 thread_local std::string g_incoming_trace_id;
 thread_local std::string g_incoming_parent_span_id;
+thread_local std::string g_active_trace_id;
+thread_local std::string g_active_span_id;
+
+std::string current_traceparent() {
+    if (g_active_trace_id.size() != 32 || g_active_span_id.size() != 16) {
+        return "";
+    }
+    return "00-" + g_active_trace_id + "-" + g_active_span_id + "-01";
+}
 
 } // namespace lemon::telemetry
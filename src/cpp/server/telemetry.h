@@ -67,10 +67,17 @@ bool has_span_listeners();
 void emit_span(const nlohmann::json& span_details);
 std::string hash_token(const std::string& token);
 
+// W3C traceparent for this thread's active inference span, or "" when no span
+// is active. Attached to backend subprocess requests so an OTLP-instrumented
+// backend joins the request's trace.
+std::string current_traceparent();
+
 extern thread_local std::string g_current_auth_token;
 extern thread_local std::chrono::steady_clock::time_point g_request_start_time;
 extern thread_local std::string g_current_client_session_id;
 extern thread_local std::string g_incoming_trace_id;
 extern thread_local std::string g_incoming_parent_span_id;
+extern thread_local std::string g_active_trace_id;
+extern thread_local std::string g_active_span_id;
 
 } // namespace lemon::telemetry
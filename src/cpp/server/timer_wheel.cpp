@@ -0,0 +1,149 @@
+#include <lemon/timer_wheel.h>
+
+#include <utility>
+#include <vector>
+
+#include <lemon/utils/aixlog.hpp>
+
+namespace lemon {
+
+namespace {
+
+// Deadlines are rounded up to this boundary so tasks with similar periods
+// share one wakeup instead of staggering the worker awake.
+constexpr auto kQuantum = std::chrono::milliseconds(100);
+
+} // namespace
+
+TimerWheel& TimerWheel::shared() {
+    static TimerWheel instance;
+    return instance;
+}
+
+TimerWheel::~TimerWheel() {
+    std::thread worker;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        running_ = false;
+        tasks_.clear();
+        deadlines_.clear();
+        worker = std::move(worker_);
+    }
+    cv_.notify_all();
+    if (worker.joinable()) {
+        worker.join();
+    }
+}
+
+TimerWheel::Clock::time_point TimerWheel::quantize(Clock::time_point deadline) const {
+    const auto since_epoch =
+        std::chrono::duration_cast<std::chrono::milliseconds>(deadline.time_since_epoch());
+    const auto remainder = since_epoch % kQuantum;
+    if (remainder.count() == 0) {
+        return deadline;
+    }
+    return Clock::time_point(since_epoch - remainder + kQuantum);
+}
+
+TimerWheel::TaskId TimerWheel::schedule_recurring(const std::string& name,
+                                                  std::chrono::milliseconds interval,
+                                                  std::function<bool()> tick) {
+    if (interval <= std::chrono::milliseconds(0)) {
+        interval = kQuantum;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    const TaskId id = next_id_++;
+    tasks_[id] = Task{name, interval, std::move(tick)};
+    deadlines_.emplace(quantize(Clock::now() + interval), id);
+
+    if (!running_) {
+        running_ = true;
+        worker_ = std::thread(&TimerWheel::worker_loop, this);
+    }
+
+    cv_.notify_all();
+    return id;
+}
+
+void TimerWheel::cancel(TaskId id) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    tasks_.erase(id);
+    for (auto it = deadlines_.begin(); it != deadlines_.end(); ++it) {
+        if (it->second == id) {
+            deadlines_.erase(it);
+            break;
+        }
+    }
+    cv_.wait(lock, [this, id]() { return executing_id_ != id; });
+}
+
+size_t TimerWheel::task_count() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return tasks_.size();
+}
+
+void TimerWheel::worker_loop() {
+    std::unique_lock<std::mutex> lock(mutex_);
+
+    while (running_) {
+        if (deadlines_.empty()) {
+            cv_.wait(lock, [this]() { return !running_ || !deadlines_.empty(); });
+            continue;
+        }
+
+        const auto next_deadline = deadlines_.begin()->first;
+        if (cv_.wait_until(lock, next_deadline, [this, next_deadline]() {
+                return !running_ ||
+                       (!deadlines_.empty() && deadlines_.begin()->first < next_deadline);
+            })) {
+            continue;
+        }
+
+        // One wakeup drains everything due inside the coalescing quantum.
+        const auto now = Clock::now();
+        std::vector<TaskId> due;
+        while (!deadlines_.empty() && deadlines_.begin()->first <= now + kQuantum / 2) {
+            due.push_back(deadlines_.begin()->second);
+            deadlines_.erase(deadlines_.begin());
+        }
+
+        for (const TaskId id : due) {
+            auto it = tasks_.find(id);
+            if (it == tasks_.end()) {
+                continue;
+            }
+
+            // Copy out before unlocking: cancel() and schedule_recurring() may
+            // mutate tasks_ while the tick runs.
+            const std::string name = it->second.name;
+            const auto tick = it->second.tick;
+            const auto interval = it->second.interval;
+
+            executing_id_ = id;
+            bool keep = false;
+            lock.unlock();
+            try {
+                keep = tick();
+            } catch (const std::exception& e) {
+                LOG(ERROR, "TimerWheel") << "Task '" << name << "' threw: "
+                                         << e.what() << "; descheduling" << std::endl;
+            }
+            lock.lock();
+            executing_id_ = 0;
+            cv_.notify_all();
+
+            // cancel() may have removed the task while its tick was running.
+            if (tasks_.find(id) == tasks_.end()) {
+                continue;
+            }
+            if (!keep) {
+                tasks_.erase(id);
+                continue;
+            }
+            deadlines_.emplace(quantize(Clock::now() + interval), id);
+        }
+    }
+}
+
+} // namespace lemon
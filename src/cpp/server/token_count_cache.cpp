@@ -0,0 +1,61 @@
+#include "lemon/token_count_cache.h"
+
+namespace lemon {
+
+namespace {
+
+uint64_t fnv1a_64(const std::string& text) {
+    uint64_t hash = 1469598103934665603ull;
+    for (unsigned char c : text) {
+        hash ^= c;
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
+}  // namespace
+
+std::string TokenCountCache::key_for(const std::string& model, const std::string& text) {
+    return model + '\x1f' + std::to_string(fnv1a_64(text)) + ':' +
+           std::to_string(text.size());
+}
+
+std::optional<int64_t> TokenCountCache::lookup(const std::string& model,
+                                               const std::string& text) {
+    const std::string key = key_for(model, text);
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = entries_.find(key);
+    if (it == entries_.end()) {
+        return std::nullopt;
+    }
+    it->second.last_used = ++use_counter_;
+    return it->second.count;
+}
+
+void TokenCountCache::store(const std::string& model, const std::string& text,
+                            int64_t count) {
+    const std::string key = key_for(model, text);
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    while (entries_.size() >= kMaxEntries && entries_.find(key) == entries_.end()) {
+        auto victim = entries_.begin();
+        for (auto e = entries_.begin(); e != entries_.end(); ++e) {
+            if (e->second.last_used < victim->second.last_used) {
+                victim = e;
+            }
+        }
+        entries_.erase(victim);
+    }
+
+    Entry& entry = entries_[key];
+    entry.count = count;
+    entry.last_used = ++use_counter_;
+}
+
+size_t TokenCountCache::size() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return entries_.size();
+}
+
+}  // namespace lemon
@@ -0,0 +1,96 @@
+#include "lemon/transcription_scheduler.h"
+
+#include <algorithm>
+#include <utility>
+
+namespace lemon {
+
+TranscriptionScheduler::TranscriptionScheduler(Runner runner, size_t worker_count)
+    : runner_(std::move(runner)) {
+    if (worker_count == 0) worker_count = 1;
+    workers_.reserve(worker_count);
+    for (size_t i = 0; i < worker_count; ++i) {
+        workers_.emplace_back(&TranscriptionScheduler::worker_loop, this);
+    }
+}
+
+TranscriptionScheduler::~TranscriptionScheduler() {
+    shutdown();
+}
+
+void TranscriptionScheduler::submit(Job job) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (stopping_) return;
+
+        if (job.is_interim) {
+            for (auto& queued : queue_) {
+                if (queued.is_interim && queued.session_id == job.session_id) {
+                    queued.wav_data = std::move(job.wav_data);
+                    queued.model = std::move(job.model);
+                    ++coalesced_;
+                    return;
+                }
+            }
+        } else {
+            auto superseded = std::remove_if(queue_.begin(), queue_.end(),
+                [&job](const Job& queued) {
+                    return queued.is_interim && queued.session_id == job.session_id;
+                });
+            coalesced_ += static_cast<uint64_t>(queue_.end() - superseded);
+            queue_.erase(superseded, queue_.end());
+        }
+
+        queue_.push_back(std::move(job));
+    }
+    cv_.notify_one();
+}
+
+void TranscriptionScheduler::drop_session(const std::string& session_id) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    queue_.erase(
+        std::remove_if(queue_.begin(), queue_.end(),
+            [&session_id](const Job& queued) {
+                return queued.session_id == session_id;
+            }),
+        queue_.end());
+}
+
+void TranscriptionScheduler::shutdown() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (stopping_) return;
+        stopping_ = true;
+        queue_.clear();
+    }
+    cv_.notify_all();
+    for (auto& worker : workers_) {
+        if (worker.joinable()) worker.join();
+    }
+}
+
+size_t TranscriptionScheduler::queued_jobs() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return queue_.size();
+}
+
+uint64_t TranscriptionScheduler::coalesced_jobs() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return coalesced_;
+}
+
+void TranscriptionScheduler::worker_loop() {
+    for (;;) {
+        Job job;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            cv_.wait(lock, [this] { return stopping_ || !queue_.empty(); });
+            if (stopping_) return;
+            job = std::move(queue_.front());
+            queue_.pop_front();
+        }
+        runner_(job);
+    }
+}
+
+}  // namespace lemon
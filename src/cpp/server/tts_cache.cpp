@@ -0,0 +1,166 @@
+#include "lemon/tts_cache.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+#include "lemon/utils/aixlog.hpp"
+#include "lemon/utils/path_utils.h"
+
+namespace fs = std::filesystem;
+
+namespace lemon {
+
+namespace {
+
+std::uint64_t fnv1a64(const std::string& text,
+                      std::uint64_t hash = 14695981039346656037ull) {
+    for (unsigned char c : text) {
+        hash ^= c;
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
+std::string to_hex(std::uint64_t value) {
+    char buf[17];
+    std::snprintf(buf, sizeof(buf), "%016llx",
+                  static_cast<unsigned long long>(value));
+    return std::string(buf);
+}
+
+}  // namespace
+
+TtsCache::TtsCache(const std::string& cache_dir, uint64_t max_bytes)
+    : dir_(cache_dir + "/tts-cache"), max_bytes_(max_bytes) {}
+
+std::string TtsCache::key_for(const nlohmann::json& request,
+                              const std::string& response_format) {
+    // Hash every request field except the transport ones, so anything that
+    // shapes the audio (voice, speed, reference_wav_b64, ...) keys a distinct
+    // entry. nlohmann keeps object keys sorted, so dump() is canonical.
+    nlohmann::json canonical_json = request;
+    canonical_json.erase("stream");
+    canonical_json.erase("stream_format");
+    canonical_json.erase("response_format");
+    const std::string canonical = canonical_json.dump() + "\n" + response_format;
+    // Two independent 64-bit passes give a 128-bit key so distinct requests
+    // can't realistically collide on the same file name.
+    return to_hex(fnv1a64(canonical)) +
+           to_hex(fnv1a64(canonical, fnv1a64("tts-cache")));
+}
+
+bool TtsCache::lookup(const std::string& key, std::string& format,
+                      std::string& audio) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::error_code ec;
+    for (const auto& entry :
+         fs::directory_iterator(utils::path_from_utf8(dir_), ec)) {
+        if (!entry.is_regular_file() ||
+            utils::path_to_utf8(entry.path().stem()) != key) {
+            continue;
+        }
+        std::ifstream file(entry.path(), std::ios::binary);
+        if (!file) {
+            return false;
+        }
+        audio.assign(std::istreambuf_iterator<char>(file),
+                     std::istreambuf_iterator<char>());
+        format = utils::path_to_utf8(entry.path().extension());
+        if (!format.empty() && format.front() == '.') {
+            format.erase(0, 1);
+        }
+        fs::last_write_time(entry.path(), fs::file_time_type::clock::now(), ec);
+        return !audio.empty();
+    }
+    return false;
+}
+
+void TtsCache::store(const std::string& key, const std::string& format,
+                     const std::string& audio) {
+    if (audio.empty() || audio.size() > max_bytes_) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::error_code ec;
+    const fs::path dir = utils::path_from_utf8(dir_);
+    fs::create_directories(dir, ec);
+    const fs::path target = dir / (key + "." + format);
+    const fs::path tmp = dir / (key + ".tmp");
+    {
+        std::ofstream file(tmp, std::ios::binary | std::ios::trunc);
+        if (!file) {
+            LOG(WARNING, "TtsCache") << "Failed to write cache entry under "
+                                     << dir_ << std::endl;
+            return;
+        }
+        file.write(audio.data(), static_cast<std::streamsize>(audio.size()));
+        if (!file) {
+            file.close();
+            fs::remove(tmp, ec);
+            return;
+        }
+    }
+    fs::rename(tmp, target, ec);
+    if (ec) {
+        fs::remove(tmp, ec);
+        return;
+    }
+    evict_to_fit();
+}
+
+uint64_t TtsCache::size_bytes() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::error_code ec;
+    uint64_t total = 0;
+    for (const auto& entry :
+         fs::directory_iterator(utils::path_from_utf8(dir_), ec)) {
+        if (entry.is_regular_file(ec)) {
+            total += entry.file_size(ec);
+        }
+    }
+    return total;
+}
+
+void TtsCache::evict_to_fit() {
+    struct Entry {
+        fs::file_time_type mtime;
+        uint64_t size;
+        fs::path path;
+    };
+    std::error_code ec;
+    std::vector<Entry> entries;
+    uint64_t total = 0;
+    for (const auto& entry :
+         fs::directory_iterator(utils::path_from_utf8(dir_), ec)) {
+        if (!entry.is_regular_file(ec)) {
+            continue;
+        }
+        const uint64_t size = entry.file_size(ec);
+        entries.push_back({entry.last_write_time(ec), size, entry.path()});
+        total += size;
+    }
+    if (total <= max_bytes_) {
+        return;
+    }
+    std::sort(entries.begin(), entries.end(),
+              [](const Entry& a, const Entry& b) { return a.mtime < b.mtime; });
+    for (const auto& entry : entries) {
+        if (total <= max_bytes_) {
+            break;
+        }
+        fs::remove(entry.path, ec);
+        if (!ec) {
+            total -= entry.size;
+            LOG(INFO, "TtsCache") << "Evicted "
+                                  << utils::path_to_utf8(entry.path.filename())
+                                  << std::endl;
+        }
+    }
+}
+
+}  // namespace lemon
@@ -0,0 +1,135 @@
+#include "lemon/utils/file_prewarmer.h"
+
+#include "lemon/utils/aixlog.hpp"
+#include "lemon/utils/mmap_file.h"
+
+#include <algorithm>
+#include <filesystem>
+#include <system_error>
+
+#ifdef _WIN32
+    #include <windows.h>
+#else
+    #include <sys/mman.h>
+#endif
+
+namespace lemon {
+namespace utils {
+
+namespace {
+// Advice is issued one window at a time so stop() stays responsive and the
+// kernel's readahead queue is never handed a multi-gigabyte range at once.
+constexpr size_t kPrewarmChunkBytes = 256ULL * 1024 * 1024;
+
+void advise_file(const std::string& path, const std::atomic<bool>& stop_requested) {
+    MappedFile map(path);
+    if (!map.data() || map.size() == 0) {
+        return;
+    }
+
+    for (size_t offset = 0; offset < map.size(); offset += kPrewarmChunkBytes) {
+        if (stop_requested.load(std::memory_order_acquire)) {
+            return;
+        }
+        const size_t length = (std::min)(kPrewarmChunkBytes, map.size() - offset);
+        void* chunk = const_cast<char*>(map.data()) + offset;
+#ifdef _WIN32
+        WIN32_MEMORY_RANGE_ENTRY range;
+        range.VirtualAddress = chunk;
+        range.NumberOfBytes = length;
+        PrefetchVirtualMemory(GetCurrentProcess(), 1, &range, 0);
+#else
+        madvise(chunk, length, MADV_WILLNEED);
+#endif
+    }
+}
+
+bool is_shared_library(const std::filesystem::path& path) {
+    const std::string name = path.filename().string();
+    const std::string ext = path.extension().string();
+    return ext == ".dll" || ext == ".dylib" || name.find(".so") != std::string::npos;
+}
+}
+
+FilePrewarmer::~FilePrewarmer() {
+    stop();
+}
+
+void FilePrewarmer::start(const std::string& path) {
+    if (thread_.joinable() || path.empty()) return;
+    stop_requested_ = false;
+    thread_ = std::thread(&FilePrewarmer::prewarm_loop, this, path);
+}
+
+void FilePrewarmer::stop() {
+    stop_requested_ = true;
+    if (thread_.joinable()) {
+        thread_.join();
+    }
+}
+
+void FilePrewarmer::prewarm_loop(const std::string& path) {
+    LOG(DEBUG, "Prewarmer") << "Prewarming " << path << std::endl;
+    advise_file(path, stop_requested_);
+    LOG(DEBUG, "Prewarmer") << "Prewarm advice issued for " << path << std::endl;
+}
+
+BinaryPrewarmer::~BinaryPrewarmer() {
+    stop();
+}
+
+void BinaryPrewarmer::start(const std::string& executable_path) {
+    if (thread_.joinable() || executable_path.empty()) return;
+    stop_requested_ = false;
+    thread_ = std::thread(&BinaryPrewarmer::prewarm_loop, this, executable_path);
+}
+
+void BinaryPrewarmer::stop() {
+    stop_requested_ = true;
+    if (thread_.joinable()) {
+        thread_.join();
+    }
+}
+
+std::vector<std::string> BinaryPrewarmer::collect_prewarm_set(const std::string& executable_path) {
+    namespace fs = std::filesystem;
+
+    std::vector<std::string> files;
+    std::error_code ec;
+    const fs::path exe(executable_path);
+    if (!fs::is_regular_file(exe, ec)) {
+        return files;
+    }
+    files.push_back(exe.string());
+
+    std::vector<std::string> libraries;
+    for (const auto& entry : fs::directory_iterator(exe.parent_path(), ec)) {
+        if (entry.is_regular_file(ec) && is_shared_library(entry.path()) &&
+            entry.path() != exe) {
+            libraries.push_back(entry.path().string());
+        }
+    }
+    std::sort(libraries.begin(), libraries.end());
+    files.insert(files.end(), libraries.begin(), libraries.end());
+    return files;
+}
+
+void BinaryPrewarmer::prewarm_loop(const std::string& executable_path) {
+    const auto files = collect_prewarm_set(executable_path);
+    if (files.empty()) {
+        return;
+    }
+
+    LOG(DEBUG, "Prewarmer") << "Prewarming " << files.size()
+                            << " binary file(s) next to " << executable_path << std::endl;
+
+    for (const auto& file : files) {
+        if (stop_requested_.load(std::memory_order_acquire)) {
+            return;
+        }
+        advise_file(file, stop_requested_);
+    }
+}
+
+} // namespace utils
+} // namespace lemon
@@ -1,4 +1,5 @@
 #include <lemon/utils/http_client.h>
+#include <lemon/utils/download_sources.h>
 #include <lemon/utils/path_utils.h>
 #include <lemon/utils/aixlog.hpp>
 #include <curl/curl.h>
@@ -11,10 +12,23 @@
 #include <filesystem>
 #include <algorithm>
 #include <cctype>
+#include <condition_variable>
+#include <cstring>
+#include <deque>
 #include <fstream>
 #include <memory>
+#include <mutex>
 #include <vector>
 #include <mbedtls/md.h>
+#include <nlohmann/json.hpp>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <cerrno>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
 
 namespace fs = std::filesystem;
 
@@ -237,6 +251,14 @@ static HashCheckResult verify_file_hash(const fs::path& path, const ExpectedHash
     return result;
 }
 
+// SHA256 of a file as lowercase hex; "" on failure. Used for per-chunk
+// checksums in parallel downloads, where no upstream hash exists per range.
+static std::string sha256_file_hex(const fs::path& path) {
+    const ExpectedHash sha256_only{"sha256", ""};
+    auto result = digest_file_with_library(path, sha256_only, "");
+    return result.error.empty() ? lower_copy(result.actual) : "";
+}
+
 } // namespace
 
 // Callback for writing response data to string
@@ -247,10 +269,285 @@ static size_t write_callback(void* contents, size_t size, size_t nmemb, void* us
     return total_size;
 }
 
-// Callback for writing to file
-static size_t write_file_callback(void* ptr, size_t size, size_t nmemb, void* stream) {
-    size_t written = fwrite(ptr, size, nmemb, static_cast<FILE*>(stream));
-    return written;
+// Disk writer for downloads. Stages bytes in one large aligned buffer so the
+// filesystem sees 4 MiB writes, can preallocate the target to its final size,
+// and optionally bypasses the page cache (O_DIRECT / F_NOCACHE /
+// FILE_FLAG_NO_BUFFERING) so multi-GB pulls do not evict the mmap'd weights of
+// currently loaded models. Direct mode writes whole aligned blocks and
+// zero-pads the final one, then trims the file back to its logical size on
+// close; if the resume offset is unaligned, the attempt silently runs
+// buffered instead.
+class DownloadFileSink {
+public:
+    static constexpr size_t kAlignment = 4096;
+    static constexpr size_t kBufferSize = 4 * 1024 * 1024;
+
+    DownloadFileSink() = default;
+    DownloadFileSink(const DownloadFileSink&) = delete;
+    DownloadFileSink& operator=(const DownloadFileSink&) = delete;
+    ~DownloadFileSink() { close(); }
+
+    bool open(const fs::path& path, size_t resume_from, bool direct_io) {
+#ifdef _WIN32
+        buffer_ = static_cast<char*>(_aligned_malloc(kBufferSize, kAlignment));
+#else
+        void* raw = nullptr;
+        if (posix_memalign(&raw, kAlignment, kBufferSize) == 0) {
+            buffer_ = static_cast<char*>(raw);
+        }
+#endif
+        if (!buffer_) {
+            return false;
+        }
+
+        logical_size_ = resume_from;
+        const bool want_direct = direct_io && (resume_from % kAlignment == 0);
+#ifdef _WIN32
+        path_ = path;
+        const DWORD creation = (resume_from > 0) ? OPEN_ALWAYS : CREATE_ALWAYS;
+        DWORD flags = FILE_ATTRIBUTE_NORMAL;
+        if (want_direct) {
+            flags |= FILE_FLAG_NO_BUFFERING;
+        }
+        handle_ = CreateFileW(path.c_str(), GENERIC_WRITE, FILE_SHARE_READ, nullptr,
+                              creation, flags, nullptr);
+        if (handle_ == INVALID_HANDLE_VALUE && want_direct) {
+            handle_ = CreateFileW(path.c_str(), GENERIC_WRITE, FILE_SHARE_READ, nullptr,
+                                  creation, FILE_ATTRIBUTE_NORMAL, nullptr);
+        } else if (handle_ != INVALID_HANDLE_VALUE) {
+            direct_ = want_direct;
+        }
+        if (handle_ == INVALID_HANDLE_VALUE) {
+            return false;
+        }
+        LARGE_INTEGER pos;
+        pos.QuadPart = static_cast<LONGLONG>(resume_from);
+        if (!SetFilePointerEx(handle_, pos, nullptr, FILE_BEGIN)) {
+            return false;
+        }
+#else
+        int open_flags = O_WRONLY | O_CREAT | O_CLOEXEC;
+        if (resume_from == 0) {
+            open_flags |= O_TRUNC;
+        }
+#ifdef __linux__
+        if (want_direct) {
+            open_flags |= O_DIRECT;
+        }
+#endif
+        fd_ = ::open(path.c_str(), open_flags, 0644);
+#ifdef __linux__
+        if (fd_ < 0 && want_direct) {
+            open_flags &= ~O_DIRECT;
+            fd_ = ::open(path.c_str(), open_flags, 0644);
+        } else if (fd_ >= 0 && want_direct) {
+            direct_ = true;
+        }
+#endif
+        if (fd_ < 0) {
+            return false;
+        }
+#ifdef __APPLE__
+        if (direct_io) {
+            fcntl(fd_, F_NOCACHE, 1);
+        }
+#endif
+        if (resume_from > 0 &&
+            lseek(fd_, static_cast<off_t>(resume_from), SEEK_SET) < 0) {
+            return false;
+        }
+#endif
+        return true;
+    }
+
+    // Best-effort: a failed reservation just means writes allocate as they go.
+    void preallocate_once(size_t total_bytes) {
+        if (preallocated_ || total_bytes <= logical_size_) {
+            return;
+        }
+        preallocated_ = true;
+#ifdef _WIN32
+        LARGE_INTEGER current{};
+        LARGE_INTEGER zero{};
+        if (!SetFilePointerEx(handle_, zero, &current, FILE_CURRENT)) {
+            return;
+        }
+        size_t end_bytes = total_bytes;
+        if (direct_) {
+            end_bytes = ((end_bytes + kAlignment - 1) / kAlignment) * kAlignment;
+        }
+        LARGE_INTEGER end;
+        end.QuadPart = static_cast<LONGLONG>(end_bytes);
+        if (SetFilePointerEx(handle_, end, nullptr, FILE_BEGIN)) {
+            SetEndOfFile(handle_);
+        }
+        SetFilePointerEx(handle_, current, nullptr, FILE_BEGIN);
+#elif defined(__linux__)
+        // fallocate(2) rather than posix_fallocate: on filesystems without
+        // native support the latter emulates by writing every block.
+        fallocate(fd_, 0, 0, static_cast<off_t>(total_bytes));
+#elif defined(__APPLE__)
+        fstore_t store = {F_ALLOCATECONTIG, F_PEOFPOSMODE, 0,
+                          static_cast<off_t>(total_bytes), 0};
+        if (fcntl(fd_, F_PREALLOCATE, &store) == -1) {
+            store.fst_flags = F_ALLOCATEALL;
+            fcntl(fd_, F_PREALLOCATE, &store);
+        }
+#endif
+    }
+
+    bool write(const char* data, size_t len) {
+        if (failed_) {
+            return false;
+        }
+        while (len > 0) {
+            const size_t n = (std::min)(kBufferSize - buffered_, len);
+            memcpy(buffer_ + buffered_, data, n);
+            buffered_ += n;
+            data += n;
+            len -= n;
+            if (buffered_ == kBufferSize && !flush_buffer()) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // Flushes any staged bytes (kept even after a failed transfer so resume
+    // works) and trims padding/preallocation back to the logical size.
+    bool close() {
+        if (closed_) {
+            return !failed_;
+        }
+        closed_ = true;
+        if (!failed_ && buffered_ > 0) {
+            flush_buffer();
+        }
+#ifdef _WIN32
+        if (handle_ != INVALID_HANDLE_VALUE) {
+            const bool trim = preallocated_ || padded_tail_;
+            CloseHandle(handle_);
+            handle_ = INVALID_HANDLE_VALUE;
+            if (trim) {
+                // NO_BUFFERING handles cannot sit at unaligned offsets, so the
+                // trim happens through a plain buffered handle.
+                bool trimmed = false;
+                HANDLE h = CreateFileW(path_.c_str(), GENERIC_WRITE, FILE_SHARE_READ,
+                                       nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL,
+                                       nullptr);
+                if (h != INVALID_HANDLE_VALUE) {
+                    LARGE_INTEGER pos;
+                    pos.QuadPart = static_cast<LONGLONG>(logical_size_);
+                    trimmed = SetFilePointerEx(h, pos, nullptr, FILE_BEGIN) &&
+                              SetEndOfFile(h);
+                    CloseHandle(h);
+                }
+                if (!trimmed) {
+                    failed_ = true;
+                }
+            }
+        }
+#else
+        if (fd_ >= 0) {
+            if ((preallocated_ || padded_tail_) &&
+                ftruncate(fd_, static_cast<off_t>(logical_size_)) != 0) {
+                failed_ = true;
+            }
+            ::close(fd_);
+            fd_ = -1;
+        }
+#endif
+        const bool ok = !failed_;
+        if (buffer_) {
+#ifdef _WIN32
+            _aligned_free(buffer_);
+#else
+            free(buffer_);
+#endif
+            buffer_ = nullptr;
+        }
+        return ok;
+    }
+
+private:
+    bool flush_buffer() {
+        if (buffered_ == 0) {
+            return true;
+        }
+        size_t to_write = buffered_;
+        if (direct_ && (to_write % kAlignment) != 0) {
+            const size_t padded = ((to_write + kAlignment - 1) / kAlignment) * kAlignment;
+            memset(buffer_ + to_write, 0, padded - to_write);
+            to_write = padded;
+            padded_tail_ = true;
+        }
+        if (!write_raw(buffer_, to_write)) {
+            failed_ = true;
+            return false;
+        }
+        logical_size_ += buffered_;
+        buffered_ = 0;
+        return true;
+    }
+
+    bool write_raw(const char* data, size_t len) {
+#ifdef _WIN32
+        while (len > 0) {
+            const DWORD chunk = static_cast<DWORD>((std::min)(len, size_t{1} << 30));
+            DWORD written = 0;
+            if (!WriteFile(handle_, data, chunk, &written, nullptr) || written == 0) {
+                return false;
+            }
+            data += written;
+            len -= written;
+        }
+#else
+        while (len > 0) {
+            const ssize_t n = ::write(fd_, data, len);
+            if (n < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+#ifdef __linux__
+                // Some filesystems accept O_DIRECT at open but reject the
+                // writes; drop to buffered instead of failing the download.
+                if (errno == EINVAL && direct_) {
+                    const int fl = fcntl(fd_, F_GETFL);
+                    if (fl >= 0 && fcntl(fd_, F_SETFL, fl & ~O_DIRECT) == 0) {
+                        direct_ = false;
+                        continue;
+                    }
+                }
+#endif
+                return false;
+            }
+            data += n;
+            len -= static_cast<size_t>(n);
+        }
+#endif
+        return true;
+    }
+
+#ifdef _WIN32
+    HANDLE handle_ = INVALID_HANDLE_VALUE;
+    fs::path path_;
+#else
+    int fd_ = -1;
+#endif
+    char* buffer_ = nullptr;
+    size_t buffered_ = 0;
+    size_t logical_size_ = 0;
+    bool direct_ = false;
+    bool preallocated_ = false;
+    bool padded_tail_ = false;
+    bool failed_ = false;
+    bool closed_ = false;
+};
+
+static size_t sink_write_callback(void* ptr, size_t size, size_t nmemb, void* userdata) {
+    const size_t total = size * nmemb;
+    auto* sink = static_cast<DownloadFileSink*>(userdata);
+    return sink->write(static_cast<const char*>(ptr), total) ? total : 0;
 }
 
 static int cancel_xferinfo_callback(void* clientp, curl_off_t, curl_off_t, curl_off_t,
@@ -261,6 +558,8 @@ static int cancel_xferinfo_callback(void* clientp, curl_off_t, curl_off_t, curl_
 
 struct ProgressData {
     ProgressCallback callback;
+    DownloadFileSink* sink = nullptr;
+    size_t resume_from = 0;
     bool cancelled = false;
     bool stalled = false;
     bool waiting_for_first_byte = false;
@@ -335,6 +634,12 @@ static int progress_callback(void* clientp, curl_off_t dltotal, curl_off_t dlnow
         return 1;
     }
 
+    // With a resume offset, curl reports the size of the remaining range, so
+    // resume_from + dltotal is the full file size.
+    if (data->sink && dltotal > 0) {
+        data->sink->preallocate_once(data->resume_from + curl_off_to_size(dltotal));
+    }
+
     if (data->callback &&
         !data->callback(curl_off_to_size(dlnow), curl_off_to_size(dltotal))) {
         data->cancelled = true;
@@ -394,8 +699,13 @@ bool apply_http_security_policy(
     switch (policy) {
         case HttpSecurityPolicy::TrustedLoopback:
             // Managed loopback backends are plain HTTP and must never redirect.
+            // Large transfer buffers cut per-request loopback syscalls and
+            // copies (audio uploads especially); curl still hands data over as
+            // soon as it arrives, so streaming latency is unaffected.
             return set(CURLOPT_FOLLOWLOCATION, 0L) &&
-                   set(CURLOPT_PROTOCOLS_STR, "http");
+                   set(CURLOPT_PROTOCOLS_STR, "http") &&
+                   set(CURLOPT_BUFFERSIZE, 512L * 1024L) &&
+                   set(CURLOPT_UPLOAD_BUFFERSIZE, 1024L * 1024L);
         case HttpSecurityPolicy::AllowInsecureHttp:
             return apply_protocols("http,https", "http,https");
         case HttpSecurityPolicy::ExternalHttpsOnly:
@@ -403,13 +713,396 @@ bool apply_http_security_policy(
             return apply_protocols("https", "https");
     }
 }
+
+std::atomic<uint64_t> g_pool_hits{0};
+std::atomic<uint64_t> g_pool_misses{0};
+
+// Keeps warm curl easy handles keyed by scheme://host:port. libcurl's
+// connection cache lives inside the easy handle, so reusing the handle reuses
+// the established TCP (and TLS) connection; curl_easy_reset clears options but
+// keeps live connections. Handles whose last transfer hit a transport error
+// are destroyed instead of pooled, and idle handles are evicted after a TTL.
+class CurlHandlePool {
+public:
+    static CurlHandlePool& instance() {
+        static CurlHandlePool pool;
+        return pool;
+    }
+
+    static std::string key_for_url(const std::string& url) {
+        const auto scheme_end = url.find("://");
+        if (scheme_end == std::string::npos) {
+            return "";
+        }
+        const auto authority_end = url.find('/', scheme_end + 3);
+        return authority_end == std::string::npos ? url : url.substr(0, authority_end);
+    }
+
+    CURL* acquire(const std::string& key) {
+        if (!key.empty()) {
+            std::lock_guard<std::mutex> lock(mutex_);
+            auto it = idle_.find(key);
+            if (it != idle_.end()) {
+                evict_stale(it->second);
+                if (!it->second.empty()) {
+                    CURL* handle = it->second.back().handle;
+                    it->second.pop_back();
+                    g_pool_hits.fetch_add(1, std::memory_order_relaxed);
+                    curl_easy_reset(handle);
+                    curl_easy_setopt(handle, CURLOPT_TCP_KEEPALIVE, 1L);
+                    return handle;
+                }
+            }
+        }
+        g_pool_misses.fetch_add(1, std::memory_order_relaxed);
+        CURL* handle = curl_easy_init();
+        if (handle) {
+            curl_easy_setopt(handle, CURLOPT_TCP_KEEPALIVE, 1L);
+        }
+        return handle;
+    }
+
+    void release(const std::string& key, CURL* handle, bool healthy) {
+        if (!handle) {
+            return;
+        }
+        if (key.empty() || !healthy) {
+            curl_easy_cleanup(handle);
+            return;
+        }
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto& handles = idle_[key];
+        evict_stale(handles);
+        if (handles.size() >= max_idle_per_key_) {
+            curl_easy_cleanup(handle);
+            return;
+        }
+        handles.push_back({handle, std::chrono::steady_clock::now()});
+    }
+
+private:
+    struct IdleHandle {
+        CURL* handle;
+        std::chrono::steady_clock::time_point since;
+    };
+
+    void evict_stale(std::vector<IdleHandle>& handles) {
+        const auto now = std::chrono::steady_clock::now();
+        handles.erase(
+            std::remove_if(handles.begin(), handles.end(),
+                           [&](IdleHandle& idle) {
+                               if (now - idle.since > idle_ttl_) {
+                                   curl_easy_cleanup(idle.handle);
+                                   return true;
+                               }
+                               return false;
+                           }),
+            handles.end());
+    }
+
+    static constexpr size_t max_idle_per_key_ = 8;
+    static constexpr std::chrono::seconds idle_ttl_{60};
+    std::mutex mutex_;
+    std::map<std::string, std::vector<IdleHandle>> idle_;
+};
+
+// Returns the handle to the pool on scope exit; only handles marked healthy
+// (clean transport on the last transfer) are kept warm.
+struct PooledCurl {
+    explicit PooledCurl(const std::string& url)
+        : key(CurlHandlePool::key_for_url(url)),
+          handle(CurlHandlePool::instance().acquire(key)) {}
+    ~PooledCurl() { CurlHandlePool::instance().release(key, handle, healthy); }
+    PooledCurl(const PooledCurl&) = delete;
+    PooledCurl& operator=(const PooledCurl&) = delete;
+
+    std::string key;
+    CURL* handle = nullptr;
+    bool healthy = false;
+};
+
+// Multiplexes every streaming transfer onto one curl_multi event-loop thread,
+// so an in-flight stream that is waiting on its backend costs a queue entry
+// instead of an OS thread parked inside curl_easy_perform. Received chunks are
+// handed back to the submitting thread, which keeps stream_callback/on_status
+// on the caller's thread (where httplib's DataSink lives). A slow consumer
+// pauses only its own transfer (CURL_WRITEFUNC_PAUSE); it never stalls the
+// loop or other streams.
+class CurlTransferLoop {
+public:
+    struct Transfer {
+        CURL* easy = nullptr;
+        std::mutex mutex;
+        std::condition_variable cv;
+        std::deque<std::string> chunks;
+        size_t queued_bytes = 0;
+        bool paused = false;
+        bool unpause_requested = false;
+        bool cancel_requested = false;
+        bool done = false;
+        bool saw_chunk = false;
+        long status_code = 0;
+        CURLcode result = CURLE_OK;
+    };
+
+    static CurlTransferLoop& instance() {
+        static CurlTransferLoop loop;
+        return loop;
+    }
+
+    static size_t write_callback(char* ptr, size_t size, size_t nmemb, void* userdata) {
+        auto* transfer = static_cast<Transfer*>(userdata);
+        const size_t total = size * nmemb;
+        std::lock_guard<std::mutex> lock(transfer->mutex);
+        if (transfer->cancel_requested) {
+            return 0;
+        }
+        if (transfer->queued_bytes >= kMaxQueuedBytes) {
+            // libcurl redelivers this same data after CURLPAUSE_CONT, so
+            // nothing is queued here.
+            transfer->paused = true;
+            return CURL_WRITEFUNC_PAUSE;
+        }
+        if (!transfer->saw_chunk) {
+            transfer->saw_chunk = true;
+            curl_easy_getinfo(transfer->easy, CURLINFO_RESPONSE_CODE,
+                              &transfer->status_code);
+        }
+        transfer->chunks.emplace_back(ptr, total);
+        transfer->queued_bytes += total;
+        transfer->cv.notify_one();
+        return total;
+    }
+
+    // Blocks the calling thread until the transfer completes, delivering
+    // queued chunks to on_chunk as they arrive.
+    CURLcode run(Transfer& transfer, const StreamCallback& on_chunk,
+                 const std::function<void(int)>& on_status,
+                 const std::function<bool()>& should_abort) {
+        submit(transfer);
+        bool status_reported = false;
+        bool consumer_failed = false;
+        bool abort_initiated = false;
+        std::unique_lock<std::mutex> lock(transfer.mutex);
+        while (true) {
+            while (!transfer.chunks.empty() && !consumer_failed) {
+                std::string chunk = std::move(transfer.chunks.front());
+                transfer.chunks.pop_front();
+                transfer.queued_bytes -= chunk.size();
+                const bool resume =
+                    transfer.paused && transfer.queued_bytes <= kMaxQueuedBytes / 2;
+                if (resume) {
+                    transfer.paused = false;
+                    transfer.unpause_requested = true;
+                }
+                const long status = transfer.status_code;
+                lock.unlock();
+                if (resume) {
+                    wakeup();
+                }
+                if (!status_reported) {
+                    status_reported = true;
+                    if (on_status) {
+                        on_status(static_cast<int>(status));
+                    }
+                }
+                bool keep_going = false;
+                try {
+                    keep_going = on_chunk && on_chunk(chunk.data(), chunk.size());
+                } catch (const std::exception& e) {
+                    LOG(ERROR, "HttpClient")
+                        << "Exception in stream callback: " << e.what() << std::endl;
+                } catch (...) {
+                    LOG(ERROR, "HttpClient")
+                        << "Unknown exception in stream callback" << std::endl;
+                }
+                lock.lock();
+                if (!keep_going) {
+                    consumer_failed = true;
+                    transfer.cancel_requested = true;
+                    transfer.chunks.clear();
+                    transfer.queued_bytes = 0;
+                    lock.unlock();
+                    wakeup();
+                    lock.lock();
+                }
+            }
+            if (transfer.done) {
+                break;
+            }
+            if (should_abort && !abort_initiated && !transfer.cancel_requested) {
+                lock.unlock();
+                const bool abort_now = should_abort();
+                lock.lock();
+                if (abort_now && !transfer.done) {
+                    abort_initiated = true;
+                    transfer.cancel_requested = true;
+                    lock.unlock();
+                    wakeup();
+                    lock.lock();
+                }
+                if (abort_now) {
+                    continue;
+                }
+            }
+            transfer.cv.wait_for(lock, std::chrono::milliseconds(250));
+        }
+        CURLcode code = transfer.result;
+        // Callers distinguish a consumer that stopped accepting data
+        // (CURLE_WRITE_ERROR: client disconnected) from a caller-requested
+        // abort (CURLE_ABORTED_BY_CALLBACK: e.g. idle timeout). Both funnel
+        // through the same cancel path here, so restore the code each caller
+        // expects.
+        if (consumer_failed && code == CURLE_ABORTED_BY_CALLBACK) {
+            code = CURLE_WRITE_ERROR;
+        } else if (abort_initiated && code == CURLE_WRITE_ERROR) {
+            code = CURLE_ABORTED_BY_CALLBACK;
+        }
+        return code;
+    }
+
+private:
+    static constexpr size_t kMaxQueuedBytes = 1024 * 1024;
+
+    CurlTransferLoop() : multi_(curl_multi_init()) {
+        thread_ = std::thread([this] { loop(); });
+    }
+
+    ~CurlTransferLoop() {
+        {
+            std::lock_guard<std::mutex> lock(control_mutex_);
+            running_ = false;
+        }
+        wakeup();
+        if (thread_.joinable()) {
+            thread_.join();
+        }
+        if (multi_) {
+            curl_multi_cleanup(multi_);
+        }
+    }
+
+    void submit(Transfer& transfer) {
+        {
+            std::lock_guard<std::mutex> lock(control_mutex_);
+            pending_.push_back(&transfer);
+        }
+        wakeup();
+    }
+
+    void wakeup() {
+#if LIBCURL_VERSION_NUM >= 0x074400
+        curl_multi_wakeup(multi_);
+#endif
+        // Older libcurl: the loop notices control changes on its poll timeout.
+    }
+
+    static void complete(Transfer& transfer, CURLcode result) {
+        std::lock_guard<std::mutex> lock(transfer.mutex);
+        transfer.result = result;
+        transfer.done = true;
+        transfer.cv.notify_one();
+    }
+
+    void loop() {
+        std::vector<Transfer*> active;
+        while (true) {
+            bool shutting_down = false;
+            std::vector<Transfer*> added;
+            {
+                std::lock_guard<std::mutex> lock(control_mutex_);
+                shutting_down = !running_;
+                added.swap(pending_);
+            }
+            if (shutting_down) {
+                for (Transfer* t : active) {
+                    curl_multi_remove_handle(multi_, t->easy);
+                    complete(*t, CURLE_ABORTED_BY_CALLBACK);
+                }
+                for (Transfer* t : added) {
+                    complete(*t, CURLE_ABORTED_BY_CALLBACK);
+                }
+                return;
+            }
+            for (Transfer* t : added) {
+                curl_multi_add_handle(multi_, t->easy);
+                active.push_back(t);
+            }
+
+            for (auto it = active.begin(); it != active.end();) {
+                Transfer* t = *it;
+                bool cancel = false;
+                bool unpause = false;
+                {
+                    std::lock_guard<std::mutex> lock(t->mutex);
+                    cancel = t->cancel_requested;
+                    unpause = t->unpause_requested;
+                    t->unpause_requested = false;
+                }
+                if (cancel) {
+                    curl_multi_remove_handle(multi_, t->easy);
+                    it = active.erase(it);
+                    complete(*t, CURLE_ABORTED_BY_CALLBACK);
+                    continue;
+                }
+                if (unpause) {
+                    curl_easy_pause(t->easy, CURLPAUSE_CONT);
+                }
+                ++it;
+            }
+
+            int running_handles = 0;
+            curl_multi_perform(multi_, &running_handles);
+
+            int msgs_in_queue = 0;
+            while (CURLMsg* msg = curl_multi_info_read(multi_, &msgs_in_queue)) {
+                if (msg->msg != CURLMSG_DONE) {
+                    continue;
+                }
+                CURL* easy = msg->easy_handle;
+                const CURLcode result = msg->data.result;
+                curl_multi_remove_handle(multi_, easy);
+                auto it = std::find_if(active.begin(), active.end(),
+                                       [&](Transfer* t) { return t->easy == easy; });
+                if (it != active.end()) {
+                    Transfer* t = *it;
+                    active.erase(it);
+                    complete(*t, result);
+                }
+            }
+
+            int numfds = 0;
+#if LIBCURL_VERSION_NUM >= 0x074200
+            curl_multi_poll(multi_, nullptr, 0, 100, &numfds);
+#else
+            curl_multi_wait(multi_, nullptr, 0, 100, &numfds);
+#endif
+        }
+    }
+
+    CURLM* multi_ = nullptr;
+    std::mutex control_mutex_;
+    std::vector<Transfer*> pending_;
+    bool running_ = true;
+    std::thread thread_;
+};
 } // namespace
 
+HttpClient::PoolStats HttpClient::connection_pool_stats() {
+    return {g_pool_hits.load(std::memory_order_relaxed),
+            g_pool_misses.load(std::memory_order_relaxed)};
+}
+
+std::string HttpClient::sha256_file(const std::string& path) {
+    return sha256_file_hex(path);
+}
+
 HttpResponse HttpClient::get(const std::string& url,
                              const std::map<std::string, std::string>& headers,
                              long timeout_seconds,
                              HttpSecurityPolicy policy) {
-    CURL* curl = curl_easy_init();
+    PooledCurl pooled(url);
+    CURL* curl = pooled.handle;
     if (!curl) {
         throw std::runtime_error("Failed to initialize CURL");
     }
@@ -421,7 +1114,6 @@ HttpResponse HttpClient::get(const std::string& url,
     curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, write_callback);
     curl_easy_setopt(curl, CURLOPT_WRITEDATA, &response_body);
     if (!apply_http_security_policy(curl, policy, true)) {
-        curl_easy_cleanup(curl);
         throw std::runtime_error("Failed to apply HTTP security policy");
     }
     curl_easy_setopt(curl, CURLOPT_TIMEOUT,
@@ -443,7 +1135,6 @@ HttpResponse HttpClient::get(const std::string& url,
     if (res != CURLE_OK) {
         std::string error = "CURL error: " + std::string(curl_easy_strerror(res));
         curl_slist_free_all(header_list);
-        curl_easy_cleanup(curl);
         throw std::runtime_error(error);
     }
 
@@ -453,7 +1144,7 @@ HttpResponse HttpClient::get(const std::string& url,
     response.body = response_body;
 
     curl_slist_free_all(header_list);
-    curl_easy_cleanup(curl);
+    pooled.healthy = true;
 
     return response;
 }
@@ -464,7 +1155,8 @@ HttpResponse HttpClient::post(const std::string& url,
                               long timeout_seconds,
                               HttpSecurityPolicy policy,
                               std::atomic<bool>* cancel_flag) {
-    CURL* curl = curl_easy_init();
+    PooledCurl pooled(url);
+    CURL* curl = pooled.handle;
     if (!curl) {
         throw std::runtime_error("Failed to initialize CURL");
     }
@@ -478,7 +1170,6 @@ HttpResponse HttpClient::post(const std::string& url,
     curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, write_callback);
     curl_easy_setopt(curl, CURLOPT_WRITEDATA, &response_body);
     if (!apply_http_security_policy(curl, policy, false)) {
-        curl_easy_cleanup(curl);
         throw std::runtime_error("Failed to apply HTTP security policy");
     }
     curl_easy_setopt(curl, CURLOPT_TIMEOUT, timeout_seconds);
@@ -516,7 +1207,6 @@ HttpResponse HttpClient::post(const std::string& url,
     if (res != CURLE_OK) {
         std::string error = "CURL error: " + std::string(curl_easy_strerror(res));
         curl_slist_free_all(header_list);
-        curl_easy_cleanup(curl);
         throw std::runtime_error(error);
     }
 
@@ -526,7 +1216,7 @@ HttpResponse HttpClient::post(const std::string& url,
     response.body = response_body;
 
     curl_slist_free_all(header_list);
-    curl_easy_cleanup(curl);
+    pooled.healthy = true;
 
     return response;
 }
@@ -548,7 +1238,11 @@ HttpResponse HttpClient::post_multipart(const std::string& url,
     for (const auto& field : fields) {
         curl_mimepart* part = curl_mime_addpart(mime);
         curl_mime_name(part, field.name.c_str());
-        curl_mime_data(part, field.data.c_str(), field.data.size());
+        if (!field.file_path.empty()) {
+            curl_mime_filedata(part, field.file_path.c_str());
+        } else {
+            curl_mime_data(part, field.data.c_str(), field.data.size());
+        }
         if (!field.filename.empty()) {
             curl_mime_filename(part, field.filename.c_str());
         }
@@ -589,75 +1283,31 @@ HttpResponse HttpClient::post_multipart(const std::string& url,
     return response;
 }
 
-// Helper struct to pass stream callback through C interface
-struct StreamCallbackData {
-    StreamCallback* callback;
-    std::string* buffer;
-    CURL* curl = nullptr;
-    std::function<void(int)>* on_status = nullptr;
-    bool status_reported = false;
-};
-
-// Static C-style callback function
-static size_t stream_write_callback(char* ptr, size_t size, size_t nmemb, void* userdata) {
-    try {
-        StreamCallbackData* data = static_cast<StreamCallbackData*>(userdata);
-        size_t total_size = size * nmemb;
-
-        if (!data || !data->callback || !*(data->callback)) {
-            LOG(ERROR, "HttpClient") << "Callback data is null!" << std::endl;
-            return 0;
-        }
-
-        if (!data->status_reported && data->on_status && *(data->on_status) && data->curl) {
-            long code = 0;
-            curl_easy_getinfo(data->curl, CURLINFO_RESPONSE_CODE, &code);
-            (*(data->on_status))(static_cast<int>(code));
-            data->status_reported = true;
-        }
-
-        if (!(*(data->callback))(ptr, total_size)) {
-            return 0; // Signal error to stop transfer
-        }
-
-        return total_size;
-    } catch (const std::exception& e) {
-        LOG(ERROR, "HttpClient") << "Exception in stream callback: " << e.what() << std::endl;
-        return 0;
-    } catch (...) {
-        LOG(ERROR, "HttpClient") << "Unknown exception in stream callback" << std::endl;
-        return 0;
-    }
-}
-
 HttpResponse HttpClient::post_stream(const std::string& url,
                                      const std::string& body,
                                      StreamCallback stream_callback,
                                      const std::map<std::string, std::string>& headers,
                                      long timeout_seconds,
                                      std::function<void(int)> on_status,
-                                     HttpSecurityPolicy policy) {
-    CURL* curl = curl_easy_init();
+                                     HttpSecurityPolicy policy,
+                                     std::function<bool()> should_abort) {
+    PooledCurl pooled(url);
+    CURL* curl = pooled.handle;
     if (!curl) {
         throw std::runtime_error("Failed to initialize CURL");
     }
 
     HttpResponse response;
 
-    // Create callback data
-    StreamCallbackData callback_data;
-    callback_data.callback = &stream_callback;
-    callback_data.buffer = nullptr;
-    callback_data.curl = curl;
-    callback_data.on_status = &on_status;
+    CurlTransferLoop::Transfer transfer;
+    transfer.easy = curl;
 
     curl_easy_setopt(curl, CURLOPT_URL, url.c_str());
     curl_easy_setopt(curl, CURLOPT_POSTFIELDS, body.data());
     curl_easy_setopt(curl, CURLOPT_POSTFIELDSIZE_LARGE, static_cast<curl_off_t>(body.size()));
-    curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, stream_write_callback);
-    curl_easy_setopt(curl, CURLOPT_WRITEDATA, &callback_data);
+    curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, CurlTransferLoop::write_callback);
+    curl_easy_setopt(curl, CURLOPT_WRITEDATA, &transfer);
     if (!apply_http_security_policy(curl, policy, false)) {
-        curl_easy_cleanup(curl);
         throw std::runtime_error("Failed to apply HTTP security policy");
     }
     curl_easy_setopt(curl, CURLOPT_TIMEOUT, timeout_seconds);
@@ -684,7 +1334,8 @@ HttpResponse HttpClient::post_stream(const std::string& url,
     }
     curl_easy_setopt(curl, CURLOPT_HTTPHEADER, header_list);
 
-    CURLcode res = curl_easy_perform(curl);
+    CURLcode res = CurlTransferLoop::instance().run(transfer, stream_callback,
+                                                    on_status, should_abort);
 
     // Get response code before checking for errors
     long response_code;
@@ -697,12 +1348,13 @@ HttpResponse HttpClient::post_stream(const std::string& url,
     // after a backend closes the connection. Do not throw here because the SSE
     // layer knows whether it saw the protocol-level [DONE] marker. It will treat
     // the same transport code as success after [DONE] and as backend failure
-    // before [DONE]. Other CURL errors are still exceptional.
-    if (res != CURLE_OK && res != CURLE_PARTIAL_FILE && res != CURLE_RECV_ERROR && res != CURLE_WRITE_ERROR) {
+    // before [DONE]. A caller-requested abort is likewise the stream layer's
+    // decision, not an exception. Other CURL errors are still exceptional.
+    if (res != CURLE_OK && res != CURLE_PARTIAL_FILE && res != CURLE_RECV_ERROR &&
+        res != CURLE_WRITE_ERROR && res != CURLE_ABORTED_BY_CALLBACK) {
         std::string error = "CURL error: " + response.curl_error;
         LOG(ERROR, "HttpClient") << "" << error << std::endl;
         curl_slist_free_all(header_list);
-        curl_easy_cleanup(curl);
         throw std::runtime_error(error);
     }
 
@@ -714,7 +1366,7 @@ HttpResponse HttpClient::post_stream(const std::string& url,
     }
 
     curl_slist_free_all(header_list);
-    curl_easy_cleanup(curl);
+    pooled.healthy = (res == CURLE_OK);
 
     return response;
 }
@@ -735,26 +1387,19 @@ DownloadResult HttpClient::download_attempt(const std::string& url,
         return result;
     }
 
-    const char* mode = (resume_from > 0) ? "ab" : "wb";
     fs::path output_path_fs = path_from_utf8(output_path);
-#ifdef _WIN32
-    std::wstring wide_mode = (resume_from > 0) ? L"ab" : L"wb";
-    FILE* fp = _wfopen(output_path_fs.c_str(), wide_mode.c_str());
-#else
-    FILE* fp = fopen(output_path.c_str(), mode);
-#endif
-    if (!fp) {
+    DownloadFileSink sink;
+    if (!sink.open(output_path_fs, resume_from, options.direct_io)) {
         result.error_message = "Failed to open file for writing: " + output_path;
         curl_easy_cleanup(curl);
         return result;
     }
 
     curl_easy_setopt(curl, CURLOPT_URL, url.c_str());
-    curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, write_file_callback);
-    curl_easy_setopt(curl, CURLOPT_WRITEDATA, fp);
+    curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, sink_write_callback);
+    curl_easy_setopt(curl, CURLOPT_WRITEDATA, &sink);
     if (!apply_http_security_policy(curl, policy, true)) {
         result.error_message = "Failed to apply HTTP security policy";
-        fclose(fp);
         curl_easy_cleanup(curl);
         return result;
     }
@@ -763,6 +1408,10 @@ DownloadResult HttpClient::download_attempt(const std::string& url,
     curl_easy_setopt(curl, CURLOPT_CONNECTTIMEOUT, static_cast<long>(options.connect_timeout));
     curl_easy_setopt(curl, CURLOPT_LOW_SPEED_LIMIT, static_cast<long>(options.low_speed_limit));
     curl_easy_setopt(curl, CURLOPT_LOW_SPEED_TIME, static_cast<long>(options.low_speed_time));
+    if (options.max_recv_bytes_per_sec > 0) {
+        curl_easy_setopt(curl, CURLOPT_MAX_RECV_SPEED_LARGE,
+                         static_cast<curl_off_t>(options.max_recv_bytes_per_sec));
+    }
 
     if (resume_from > 0) {
         curl_easy_setopt(curl, CURLOPT_RESUME_FROM_LARGE, static_cast<curl_off_t>(resume_from));
@@ -775,6 +1424,10 @@ DownloadResult HttpClient::download_attempt(const std::string& url,
     if (callback || no_progress_timeout > 0) {
         prog_data = std::make_unique<ProgressData>();
         prog_data->callback = callback;
+        if (options.preallocate) {
+            prog_data->sink = &sink;
+            prog_data->resume_from = resume_from;
+        }
         prog_data->no_progress_timeout = no_progress_timeout;
         prog_data->last_progress_time = std::chrono::steady_clock::now();
         curl_easy_setopt(curl, CURLOPT_HEADERFUNCTION, header_callback);
@@ -807,7 +1460,7 @@ DownloadResult HttpClient::download_attempt(const std::string& url,
     result.bytes_downloaded = static_cast<size_t>(downloaded);
     result.total_bytes = (total > 0) ? static_cast<size_t>(total) : 0;
 
-    fclose(fp);
+    sink.close();
     curl_slist_free_all(header_list);
     curl_easy_getinfo(curl, CURLINFO_RESPONSE_CODE, &result.http_code);
 
@@ -989,6 +1642,516 @@ DownloadResult HttpClient::download_attempt(const std::string& url,
     return result;
 }
 
+namespace {
+
+// Shared progress/cancellation state for one parallel download. Workers report
+// their chunk's absolute on-disk byte count; the user callback sees the sum.
+struct ChunkProgress {
+    std::mutex mutex;
+    ProgressCallback callback;
+    std::vector<size_t> chunk_bytes;
+    size_t completed_base = 0;
+    size_t total_size = 0;
+    std::atomic<bool> cancelled{false};
+
+    bool report(size_t chunk_index, size_t bytes_on_disk) {
+        std::lock_guard<std::mutex> lock(mutex);
+        chunk_bytes[chunk_index] = bytes_on_disk;
+        if (callback) {
+            size_t sum = completed_base;
+            for (size_t b : chunk_bytes) {
+                sum += b;
+            }
+            if (!callback(sum, total_size)) {
+                cancelled.store(true);
+            }
+        }
+        return !cancelled.load();
+    }
+};
+
+struct ChunkXferData {
+    ChunkProgress* progress = nullptr;
+    size_t chunk_index = 0;
+    size_t resume_from = 0;
+};
+
+int chunk_xferinfo_callback(void* clientp, curl_off_t, curl_off_t dlnow, curl_off_t,
+                            curl_off_t) {
+    auto* data = static_cast<ChunkXferData*>(clientp);
+    return data->progress->report(data->chunk_index,
+                                  data->resume_from + curl_off_to_size(dlnow)) ? 0 : 1;
+}
+
+// Mirrors sourced from config or peer discovery may be plaintext LAN
+// endpoints the user explicitly opted into; external mirrors keep the
+// primary's policy.
+HttpSecurityPolicy policy_for_source(const std::string& url,
+                                     HttpSecurityPolicy primary_policy) {
+    if (url.rfind("http://", 0) == 0) {
+        return HttpSecurityPolicy::AllowInsecureHttp;
+    }
+    return primary_policy;
+}
+
+// One attempt at a bounded byte range [range_start + resume_from, range_end]
+// appended to chunk_path.
+DownloadResult download_chunk_attempt(const std::string& url,
+                                      const fs::path& chunk_path,
+                                      size_t range_start,
+                                      size_t range_end,
+                                      size_t resume_from,
+                                      const std::map<std::string, std::string>& headers,
+                                      const DownloadOptions& options,
+                                      HttpSecurityPolicy policy,
+                                      size_t chunk_index,
+                                      ChunkProgress& progress) {
+    DownloadResult result;
+
+    CURL* curl = curl_easy_init();
+    if (!curl) {
+        result.error_message = "Failed to initialize CURL";
+        return result;
+    }
+
+    DownloadFileSink sink;
+    if (!sink.open(chunk_path, resume_from, options.direct_io)) {
+        result.error_message = "Failed to open chunk file for writing: " + path_to_utf8(chunk_path);
+        curl_easy_cleanup(curl);
+        return result;
+    }
+    if (options.preallocate) {
+        sink.preallocate_once(range_end - range_start + 1);
+    }
+
+    const std::string range = std::to_string(range_start + resume_from) + "-" +
+                              std::to_string(range_end);
+
+    curl_easy_setopt(curl, CURLOPT_URL, url.c_str());
+    curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, sink_write_callback);
+    curl_easy_setopt(curl, CURLOPT_WRITEDATA, &sink);
+    curl_easy_setopt(curl, CURLOPT_RANGE, range.c_str());
+    if (!apply_http_security_policy(curl, policy, true)) {
+        result.error_message = "Failed to apply HTTP security policy";
+        curl_easy_cleanup(curl);
+        return result;
+    }
+    curl_easy_setopt(curl, CURLOPT_TIMEOUT, 0L);
+    curl_easy_setopt(curl, CURLOPT_USERAGENT, "lemon.cpp/1.0");
+    curl_easy_setopt(curl, CURLOPT_CONNECTTIMEOUT, static_cast<long>(options.connect_timeout));
+    if (options.max_recv_bytes_per_sec > 0) {
+        curl_easy_setopt(curl, CURLOPT_MAX_RECV_SPEED_LARGE,
+                         static_cast<curl_off_t>(options.max_recv_bytes_per_sec));
+    }
+
+    ChunkXferData xfer_data{&progress, chunk_index, resume_from};
+    curl_easy_setopt(curl, CURLOPT_XFERINFOFUNCTION, chunk_xferinfo_callback);
+    curl_easy_setopt(curl, CURLOPT_XFERINFODATA, &xfer_data);
+    curl_easy_setopt(curl, CURLOPT_NOPROGRESS, 0L);
+
+    struct curl_slist* header_list = nullptr;
+    for (const auto& header : headers) {
+        std::string header_str = header.first + ": " + header.second;
+        header_list = curl_slist_append(header_list, header_str.c_str());
+    }
+    if (header_list) {
+        curl_easy_setopt(curl, CURLOPT_HTTPHEADER, header_list);
+    }
+
+    CURLcode res = curl_easy_perform(curl);
+
+    sink.close();
+    curl_slist_free_all(header_list);
+    curl_easy_getinfo(curl, CURLINFO_RESPONSE_CODE, &result.http_code);
+    result.curl_code = static_cast<int>(res);
+    result.curl_error = curl_easy_strerror(res);
+    curl_easy_cleanup(curl);
+
+    if (res == CURLE_ABORTED_BY_CALLBACK || progress.cancelled.load()) {
+        result.cancelled = true;
+        result.error_message = "Download cancelled by user";
+        result.can_resume = true;
+        return result;
+    }
+
+    if (res != CURLE_OK) {
+        result.can_resume = true;
+        result.error_message = "Chunk download failed: " + result.curl_error +
+                               " (CURL code: " + std::to_string(result.curl_code) + ")";
+        return result;
+    }
+
+    // A server that answers 200 to a non-zero range sent the whole file and
+    // corrupted the chunk; a single sequential retry is the only safe recovery.
+    if (result.http_code != 206) {
+        result.permanent = true;
+        result.error_message = "Server ignored byte range (HTTP " +
+                               std::to_string(result.http_code) + ")";
+        return result;
+    }
+
+    const size_t expected_len = range_end - range_start + 1;
+    std::error_code ec;
+    const size_t on_disk = fs::file_size(chunk_path, ec);
+    if (ec || on_disk != expected_len) {
+        result.can_resume = !ec && on_disk < expected_len;
+        result.error_message = "Chunk size mismatch: expected " +
+                               std::to_string(expected_len) + " bytes, have " +
+                               std::to_string(ec ? 0 : on_disk);
+        return result;
+    }
+
+    result.success = true;
+    result.bytes_downloaded = expected_len - resume_from;
+    return result;
+}
+
+} // namespace
+
+size_t HttpClient::probe_ranged_download_size(const std::string& url,
+                                              const std::map<std::string, std::string>& headers,
+                                              HttpSecurityPolicy policy) {
+    CURL* curl = curl_easy_init();
+    if (!curl) {
+        return 0;
+    }
+
+    std::string response_headers;
+    curl_easy_setopt(curl, CURLOPT_URL, url.c_str());
+    curl_easy_setopt(curl, CURLOPT_NOBODY, 1L);
+    curl_easy_setopt(curl, CURLOPT_TIMEOUT, 30L);
+    curl_easy_setopt(curl, CURLOPT_USERAGENT, "lemon.cpp/1.0");
+    curl_easy_setopt(curl, CURLOPT_HEADERFUNCTION, write_callback);
+    curl_easy_setopt(curl, CURLOPT_HEADERDATA, &response_headers);
+    if (!apply_http_security_policy(curl, policy, true)) {
+        curl_easy_cleanup(curl);
+        return 0;
+    }
+
+    struct curl_slist* header_list = nullptr;
+    for (const auto& header : headers) {
+        std::string header_str = header.first + ": " + header.second;
+        header_list = curl_slist_append(header_list, header_str.c_str());
+    }
+    if (header_list) {
+        curl_easy_setopt(curl, CURLOPT_HTTPHEADER, header_list);
+    }
+
+    CURLcode res = curl_easy_perform(curl);
+
+    long http_code = 0;
+    curl_off_t content_length = 0;
+    curl_easy_getinfo(curl, CURLINFO_RESPONSE_CODE, &http_code);
+    curl_easy_getinfo(curl, CURLINFO_CONTENT_LENGTH_DOWNLOAD_T, &content_length);
+    curl_slist_free_all(header_list);
+    curl_easy_cleanup(curl);
+
+    if (res != CURLE_OK || http_code >= 400 || content_length <= 0) {
+        return 0;
+    }
+    if (lower_copy(response_headers).find("accept-ranges: bytes") == std::string::npos) {
+        return 0;
+    }
+    return static_cast<size_t>(content_length);
+}
+
+DownloadResult HttpClient::download_file_parallel(
+    const std::string& url,
+    const std::string& output_path,
+    size_t total_size,
+    ProgressCallback callback,
+    const std::map<std::string, std::string>& headers,
+    const DownloadOptions& options,
+    HttpSecurityPolicy policy) {
+    using nlohmann::json;
+
+    DownloadResult final_result;
+    final_result.total_bytes = total_size;
+
+    const size_t chunk_count = static_cast<size_t>(
+        (std::min)((std::max)(options.parallel_connections, 2), 16));
+    const size_t base_len = total_size / chunk_count;
+
+    // The rate cap applies to the whole transfer, so each chunk gets an even
+    // share of it.
+    DownloadOptions chunk_options = options;
+    if (chunk_options.max_recv_bytes_per_sec > 0) {
+        chunk_options.max_recv_bytes_per_sec = (std::max)(
+            size_t{1}, chunk_options.max_recv_bytes_per_sec / chunk_count);
+    }
+
+    const std::string state_path = output_path + ".chunks.json";
+    const fs::path state_path_fs = path_from_utf8(state_path);
+
+    auto chunk_path_for = [&](size_t i) {
+        return path_from_utf8(output_path + ".chunk" + std::to_string(i));
+    };
+    auto chunk_start = [&](size_t i) { return i * base_len; };
+    auto chunk_end = [&](size_t i) {
+        return (i + 1 == chunk_count) ? total_size - 1 : (i + 1) * base_len - 1;
+    };
+    auto chunk_len = [&](size_t i) { return chunk_end(i) - chunk_start(i) + 1; };
+
+    // Per-chunk checksums recorded as each chunk completes; an interrupted
+    // download resumes by re-verifying completed chunks and appending to the
+    // incomplete ones.
+    std::vector<std::string> chunk_hashes(chunk_count);
+    bool state_valid = false;
+    if (fs::exists(state_path_fs)) {
+        try {
+            std::ifstream state_file(state_path_fs);
+            json state = json::parse(state_file);
+            if (state.value("total_size", size_t{0}) == total_size &&
+                state.value("chunk_count", size_t{0}) == chunk_count &&
+                state.contains("chunks") && state["chunks"].size() == chunk_count) {
+                for (size_t i = 0; i < chunk_count; i++) {
+                    chunk_hashes[i] = state["chunks"][i].get<std::string>();
+                }
+                state_valid = true;
+            }
+        } catch (const std::exception&) {
+            state_valid = false;
+        }
+    }
+    if (!state_valid) {
+        std::error_code ec;
+        for (size_t i = 0; i < chunk_count; i++) {
+            fs::remove(chunk_path_for(i), ec);
+        }
+        fs::remove(state_path_fs, ec);
+        std::fill(chunk_hashes.begin(), chunk_hashes.end(), "");
+    }
+
+    std::mutex state_mutex;
+    auto save_state = [&]() {
+        json state = {
+            {"total_size", total_size},
+            {"chunk_count", chunk_count},
+            {"chunks", chunk_hashes},
+        };
+        std::ofstream state_file(state_path_fs);
+        state_file << state.dump();
+    };
+
+    ChunkProgress progress;
+    progress.callback = std::move(callback);
+    progress.chunk_bytes.assign(chunk_count, 0);
+    progress.total_size = total_size;
+
+    std::vector<size_t> pending;
+    std::vector<size_t> resume_offsets(chunk_count, 0);
+    for (size_t i = 0; i < chunk_count; i++) {
+        const fs::path chunk_path = chunk_path_for(i);
+        std::error_code ec;
+        const size_t on_disk = fs::exists(chunk_path, ec) ? fs::file_size(chunk_path, ec) : 0;
+
+        if (!chunk_hashes[i].empty() && on_disk == chunk_len(i) &&
+            sha256_file_hex(chunk_path) == chunk_hashes[i]) {
+            progress.completed_base += chunk_len(i);
+            continue;
+        }
+
+        chunk_hashes[i].clear();
+        if (on_disk > chunk_len(i)) {
+            fs::remove(chunk_path, ec);
+            resume_offsets[i] = 0;
+        } else {
+            resume_offsets[i] = on_disk;
+        }
+        progress.chunk_bytes[i] = resume_offsets[i];
+        pending.push_back(i);
+    }
+
+    // Multi-source striping: mirrors that pass a ranged size probe join the
+    // primary; each chunk attempt is steered to the fastest healthy source.
+    std::vector<std::string> source_urls{url};
+    for (const auto& mirror : options.mirror_urls) {
+        const size_t mirror_size =
+            probe_ranged_download_size(mirror, {}, policy_for_source(mirror, policy));
+        if (mirror_size == total_size) {
+            source_urls.push_back(mirror);
+        } else {
+            LOG(WARNING, "Download")
+                << "Skipping mirror " << mirror << " (ranged size probe returned "
+                << mirror_size << ", expected " << total_size << ")" << std::endl;
+        }
+    }
+    DownloadSourceSet source_set(source_urls);
+
+    if (!pending.empty()) {
+        LOG(INFO, "Download") << "Parallel download: " << pending.size() << "/"
+                              << chunk_count << " chunk(s) across "
+                              << chunk_count << " connections and "
+                              << source_urls.size() << " source(s) ("
+                              << std::fixed << std::setprecision(1)
+                              << (total_size / (1024.0 * 1024.0)) << " MB total)"
+                              << std::endl;
+    }
+
+    std::vector<DownloadResult> chunk_results(chunk_count);
+    std::vector<std::thread> workers;
+    workers.reserve(pending.size());
+
+    for (size_t i : pending) {
+        workers.emplace_back([&, i]() {
+            DownloadResult result;
+            int retry_delay_ms = options.initial_retry_delay_ms;
+            size_t resume_from = resume_offsets[i];
+
+            for (int attempt = 0; attempt <= options.max_retries; ++attempt) {
+                if (attempt > 0) {
+                    std::this_thread::sleep_for(std::chrono::milliseconds(retry_delay_ms));
+                    retry_delay_ms = (std::min)(retry_delay_ms * 2, options.max_retry_delay_ms);
+
+                    std::error_code ec;
+                    const fs::path chunk_path = chunk_path_for(i);
+                    resume_from = fs::exists(chunk_path, ec) ? fs::file_size(chunk_path, ec) : 0;
+                    if (resume_from > chunk_len(i)) {
+                        fs::remove(chunk_path, ec);
+                        resume_from = 0;
+                    }
+                }
+                if (progress.cancelled.load()) {
+                    result.cancelled = true;
+                    break;
+                }
+
+                auto* source = source_set.acquire();
+                const auto attempt_start = std::chrono::steady_clock::now();
+                // Auth headers go to the primary only; a mirror or peer must
+                // never see the registry token.
+                result = download_chunk_attempt(
+                    source->url, chunk_path_for(i), chunk_start(i), chunk_end(i),
+                    resume_from,
+                    source->primary ? headers : std::map<std::string, std::string>{},
+                    chunk_options, policy_for_source(source->url, policy), i,
+                    progress);
+                const auto attempt_micros =
+                    std::chrono::duration_cast<std::chrono::microseconds>(
+                        std::chrono::steady_clock::now() - attempt_start)
+                        .count();
+                source_set.release(source,
+                                   result.success ? result.bytes_downloaded : 0,
+                                   static_cast<uint64_t>(attempt_micros),
+                                   result.success);
+                if (result.permanent && !source->primary) {
+                    // A mirror that ignores byte ranges poisons only itself;
+                    // the chunk is retried on another source.
+                    source->disabled.store(true, std::memory_order_relaxed);
+                    result.permanent = false;
+                    result.can_resume = false;  // drop the poisoned chunk file
+                }
+                if (result.success || result.cancelled || result.permanent) {
+                    break;
+                }
+                if (!result.can_resume) {
+                    std::error_code ec;
+                    fs::remove(chunk_path_for(i), ec);
+                    resume_from = 0;
+                }
+            }
+
+            if (result.success) {
+                const std::string digest = sha256_file_hex(chunk_path_for(i));
+                std::lock_guard<std::mutex> lock(state_mutex);
+                chunk_hashes[i] = digest;
+                save_state();
+            }
+            chunk_results[i] = result;
+        });
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+
+    if (source_set.sources().size() > 1) {
+        for (const auto& source : source_set.sources()) {
+            const double mb = source->bytes.load() / (1024.0 * 1024.0);
+            LOG(INFO, "Download")
+                << "Source " << source->url << ": " << std::fixed
+                << std::setprecision(1) << mb << " MB at "
+                << (source->throughput_bytes_per_sec() / (1024.0 * 1024.0))
+                << " MB/s" << (source->disabled.load() ? " (dropped)" : "")
+                << std::endl;
+        }
+    }
+
+    for (size_t i : pending) {
+        const DownloadResult& chunk_result = chunk_results[i];
+        if (chunk_result.success) {
+            final_result.bytes_downloaded += chunk_result.bytes_downloaded;
+            continue;
+        }
+        final_result.success = false;
+        final_result.cancelled = chunk_result.cancelled;
+        final_result.permanent = chunk_result.permanent;
+        final_result.can_resume = !chunk_result.permanent;
+        final_result.http_code = chunk_result.http_code;
+        final_result.curl_code = chunk_result.curl_code;
+        final_result.curl_error = chunk_result.curl_error;
+        final_result.error_message = chunk_result.error_message;
+        if (!chunk_result.cancelled && !chunk_result.permanent) {
+            final_result.error_message +=
+                "\nCompleted chunks are preserved; run the command again to resume.";
+        }
+        return final_result;
+    }
+
+    // Assemble chunks into the standard .partial and hand the final
+    // verification/rename to the same path the sequential download uses.
+    const std::string partial_path = output_path + ".partial";
+    const fs::path partial_path_fs = path_from_utf8(partial_path);
+    {
+        std::ofstream out(partial_path_fs, std::ios::binary | std::ios::trunc);
+        if (!out.is_open()) {
+            final_result.error_message = "Failed to open file for assembly: " + partial_path;
+            return final_result;
+        }
+        for (size_t i = 0; i < chunk_count; i++) {
+            std::ifstream in(chunk_path_for(i), std::ios::binary);
+            if (!in.is_open() || !(out << in.rdbuf())) {
+                final_result.error_message =
+                    "Failed to assemble chunk " + std::to_string(i) + " into " + partial_path;
+                return final_result;
+            }
+        }
+    }
+
+    std::error_code ec;
+    for (size_t i = 0; i < chunk_count; i++) {
+        fs::remove(chunk_path_for(i), ec);
+    }
+    fs::remove(state_path_fs, ec);
+
+    const ExpectedHash expected_hash = parse_expected_hash(options);
+    if (expected_hash.present()) {
+        auto hash_result = verify_file_hash(partial_path_fs, expected_hash);
+        if (!hash_result.ok) {
+            final_result.error_message = "Download content verification failed for " +
+                                         output_path + ": " + hash_result.error;
+            fs::remove(partial_path_fs, ec);
+            return final_result;
+        }
+        LOG(INFO, "Download") << "Hash verified for " << output_path << std::endl;
+    }
+
+    fs::rename(partial_path_fs, path_from_utf8(output_path), ec);
+    if (ec) {
+        fs::copy_file(partial_path_fs, path_from_utf8(output_path),
+                      fs::copy_options::overwrite_existing, ec);
+        if (!ec) {
+            fs::remove(partial_path_fs, ec);
+        }
+    }
+    if (ec) {
+        final_result.error_message = "Download succeeded but failed to rename file: " + ec.message();
+        return final_result;
+    }
+
+    final_result.success = true;
+    return final_result;
+}
+
 DownloadResult HttpClient::download_file(const std::string& url,
                                          const std::string& output_path,
                                          ProgressCallback callback,
@@ -1068,6 +2231,24 @@ DownloadResult HttpClient::download_file(const std::string& url,
         }
     }
 
+    // Ranged parallel path for large files. A sequential .partial on disk wins
+    // (its resume is cheaper than restarting the split); a server that ignores
+    // byte ranges drops through to the sequential path below.
+    if ((options.parallel_connections > 1 || !options.mirror_urls.empty()) &&
+        !fs::exists(partial_path_fs)) {
+        const size_t total_size = probe_ranged_download_size(url, headers, policy);
+        if (total_size >= options.parallel_min_bytes) {
+            final_result = download_file_parallel(url, output_path, total_size,
+                                                  callback, headers, options, policy);
+            if (final_result.success || final_result.cancelled || !final_result.permanent) {
+                return final_result;
+            }
+            LOG(WARNING, "Download") << "Parallel download not usable ("
+                                     << final_result.error_message
+                                     << "); falling back to sequential" << std::endl;
+        }
+    }
+
     // Check for existing partial file to resume
     size_t resume_offset = 0;
     if (options.resume_partial && fs::exists(partial_path_fs)) {
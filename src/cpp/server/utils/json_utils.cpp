@@ -48,21 +48,23 @@ std::string JsonUtils::to_string(const json& j, int indent) {
     return j.dump(indent);
 }
 
-json JsonUtils::merge(const json& base, const json& overlay) {
-    json result = base;
-
-    if (!overlay.is_object()) {
-        return overlay;
-    }
-
+static void merge_into(json& base, const json& overlay) {
     for (auto it = overlay.begin(); it != overlay.end(); ++it) {
-        if (result.contains(it.key()) && result[it.key()].is_object() && it.value().is_object()) {
-            result[it.key()] = merge(result[it.key()], it.value());
+        if (base.contains(it.key()) && base[it.key()].is_object() && it.value().is_object()) {
+            merge_into(base[it.key()], it.value());
         } else {
-            result[it.key()] = it.value();
+            base[it.key()] = it.value();
         }
     }
+}
 
+json JsonUtils::merge(const json& base, const json& overlay) {
+    if (!overlay.is_object()) {
+        return overlay;
+    }
+
+    json result = base;
+    merge_into(result, overlay);
     return result;
 }
 
@@ -78,8 +80,18 @@ json JsonUtils::with_legacy_max_tokens_alias(const json& request) {
     return modified;
 }
 
+const json& JsonUtils::with_legacy_max_tokens_alias(const json& request, json& scratch) {
+    if (!request.contains("max_completion_tokens") || request.contains("max_tokens")) {
+        return request;
+    }
+    scratch = request;
+    add_legacy_max_tokens_alias(scratch);
+    return scratch;
+}
+
 bool JsonUtils::has_key(const json& j, const std::string& key) {
-    return j.contains(key) && !j[key].is_null();
+    auto it = j.find(key);
+    return it != j.end() && !it->is_null();
 }
 
 std::string JsonUtils::base64_encode(const std::string& input) {
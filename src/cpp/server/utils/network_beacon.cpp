@@ -26,6 +26,163 @@
     #define INVALID_SOCKET_NB -1
 #endif
 
+namespace {
+
+// Heartbeats between full status keyframes; a change always forces one.
+constexpr int kKeyframeEvery = 4;
+// Unchanged cycles before the broadcast interval doubles, and the cap on
+// that backoff relative to the configured base interval.
+constexpr int kIdleCyclesBeforeBackoff = 5;
+constexpr int kMaxBackoffMultiplier = 4;
+
+constexpr uint16_t kMdnsPort = 5353;
+const char* const kMdnsGroup = "224.0.0.251";
+const char* const kMdnsServiceName = "_lemonade._tcp.local";
+
+void appendDnsName(std::string& out, const std::string& dotted) {
+    size_t start = 0;
+    while (start <= dotted.size()) {
+        size_t dot = dotted.find('.', start);
+        size_t len = (dot == std::string::npos ? dotted.size() : dot) - start;
+        if (len > 0 && len < 64) {
+            out.push_back(static_cast<char>(len));
+            out.append(dotted, start, len);
+        }
+        if (dot == std::string::npos) break;
+        start = dot + 1;
+    }
+    out.push_back('\0');
+}
+
+void appendU16(std::string& out, uint16_t value) {
+    out.push_back(static_cast<char>(value >> 8));
+    out.push_back(static_cast<char>(value & 0xFF));
+}
+
+void appendU32(std::string& out, uint32_t value) {
+    out.push_back(static_cast<char>(value >> 24));
+    out.push_back(static_cast<char>((value >> 16) & 0xFF));
+    out.push_back(static_cast<char>((value >> 8) & 0xFF));
+    out.push_back(static_cast<char>(value & 0xFF));
+}
+
+void appendRdata(std::string& out, const std::string& rdata) {
+    appendU16(out, static_cast<uint16_t>(rdata.size()));
+    out += rdata;
+}
+
+// Unsolicited DNS-SD announcement (RFC 6762/6763): PTR for service browse,
+// SRV/TXT for the instance, A for the host target. Name compression is
+// optional in mDNS, so names are emitted verbatim.
+std::string buildMdnsAnnouncement(const std::string& hostname,
+                                  const std::string& interfaceIp,
+                                  uint16_t serverPort) {
+    const std::string instance = hostname + "." + kMdnsServiceName;
+    const std::string target = hostname + ".local";
+
+    std::string pkt;
+    appendU16(pkt, 0);        // transaction id (0 for mDNS)
+    appendU16(pkt, 0x8400);   // authoritative response
+    appendU16(pkt, 0);        // questions
+    appendU16(pkt, 4);        // answers
+    appendU16(pkt, 0);        // authority
+    appendU16(pkt, 0);        // additional
+
+    // PTR (shared record: no cache-flush bit)
+    appendDnsName(pkt, kMdnsServiceName);
+    appendU16(pkt, 12);
+    appendU16(pkt, 0x0001);
+    appendU32(pkt, 4500);
+    {
+        std::string rdata;
+        appendDnsName(rdata, instance);
+        appendRdata(pkt, rdata);
+    }
+
+    // SRV
+    appendDnsName(pkt, instance);
+    appendU16(pkt, 33);
+    appendU16(pkt, 0x8001);   // IN, cache-flush
+    appendU32(pkt, 120);
+    {
+        std::string rdata;
+        appendU16(rdata, 0);  // priority
+        appendU16(rdata, 0);  // weight
+        appendU16(rdata, serverPort);
+        appendDnsName(rdata, target);
+        appendRdata(pkt, rdata);
+    }
+
+    // TXT
+    appendDnsName(pkt, instance);
+    appendU16(pkt, 16);
+    appendU16(pkt, 0x8001);
+    appendU32(pkt, 4500);
+    {
+        std::string rdata;
+        const std::string url = "url=http://" + interfaceIp + ":" +
+                                std::to_string(serverPort) + "/api/v1/";
+        rdata.push_back(static_cast<char>(url.size()));
+        rdata += url;
+        const std::string version = "v=2";
+        rdata.push_back(static_cast<char>(version.size()));
+        rdata += version;
+        appendRdata(pkt, rdata);
+    }
+
+    // A
+    appendDnsName(pkt, target);
+    appendU16(pkt, 1);
+    appendU16(pkt, 0x8001);
+    appendU32(pkt, 120);
+    {
+        std::string rdata;
+        struct in_addr addr;
+        if (inet_pton(AF_INET, interfaceIp.c_str(), &addr) != 1) {
+            return "";
+        }
+        rdata.append(reinterpret_cast<const char*>(&addr.s_addr), 4);
+        appendRdata(pkt, rdata);
+    }
+
+    return pkt;
+}
+
+// Multicast DNS-SD announcements on every RFC1918 interface so clients on
+// routed networks (where the subnet broadcast never arrives) can still find
+// the server through standard mDNS browsing or a reflector. Best effort:
+// failures are silent because plenty of networks filter multicast.
+void announceMdns(const std::vector<NetworkInterfaceInfo>& interfaces,
+                  const std::string& hostname, uint16_t serverPort) {
+    SOCKET sock = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+    if (sock == INVALID_SOCKET_NB) return;
+
+    unsigned char ttl = 255;
+    setsockopt(sock, IPPROTO_IP, IP_MULTICAST_TTL, (char*)&ttl, sizeof(ttl));
+
+    sockaddr_in destAddr{};
+    destAddr.sin_family = AF_INET;
+    destAddr.sin_port = htons(kMdnsPort);
+    inet_pton(AF_INET, kMdnsGroup, &destAddr.sin_addr);
+
+    for (const auto& iface : interfaces) {
+        struct in_addr ifaceAddr;
+        if (inet_pton(AF_INET, iface.ipAddress.c_str(), &ifaceAddr) != 1) continue;
+        uint32_t ip = ntohl(ifaceAddr.s_addr);
+        if ((ip & 0xFF000000u) == 0x7F000000u) continue;
+
+        std::string pkt = buildMdnsAnnouncement(hostname, iface.ipAddress, serverPort);
+        if (pkt.empty()) continue;
+
+        setsockopt(sock, IPPROTO_IP, IP_MULTICAST_IF, (char*)&ifaceAddr, sizeof(ifaceAddr));
+        sendto(sock, pkt.c_str(), (int)pkt.size(), 0, (sockaddr*)&destAddr, sizeof(destAddr));
+    }
+
+    closesocket(sock);
+}
+
+}  // namespace
+
 NetworkBeacon::NetworkBeacon() : _socket(INVALID_SOCKET_NB), _isInitialized(false), _netThreadRunning(false) {
 #ifdef _WIN32
     WSADATA wsaData;
@@ -182,18 +339,33 @@ std::vector<NetworkInterfaceInfo> NetworkBeacon::getLocalRFC1918Interfaces() {
     return interfaces;
 }
 
-std::string NetworkBeacon::buildStandardPayloadPattern(std::string hostname, std::string hostUrl) {
+std::string NetworkBeacon::buildStandardPayloadPattern(std::string hostname, std::string hostUrl,
+                                                       const std::string& statusJson,
+                                                       uint64_t stateSeq, int intervalSeconds) {
     std::stringstream ss;
 
     ss << "{";
     ss << "\"service\": \"lemonade\", ";
     ss << "\"hostname\": \"" << hostname << "\", ";
     ss << "\"url\": \"" << hostUrl << "\"";
+    if (intervalSeconds > 0) {
+        ss << ", \"v\": 2";
+        ss << ", \"seq\": " << stateSeq;
+        ss << ", \"interval\": " << intervalSeconds;
+    }
+    if (!statusJson.empty()) {
+        ss << ", \"status\": " << statusJson;
+    }
     ss << "}";
 
     return ss.str();
 }
 
+void NetworkBeacon::setStatusProvider(std::function<std::string()> provider) {
+    std::lock_guard<std::mutex> lock(_netMtx);
+    _statusProvider = std::move(provider);
+}
+
 void NetworkBeacon::startBroadcasting(int beaconPort, int serverPort, uint16_t intervalSeconds) {
     std::lock_guard<std::mutex> lock(_netMtx);
 
@@ -213,6 +385,7 @@ void NetworkBeacon::stopBroadcasting() {
         if (!_netThreadRunning) return;
         _netThreadRunning = false;
     }
+    _netCv.notify_all();
 
     // Join net thread.
     if (_netThread.joinable()) {
@@ -222,6 +395,15 @@ void NetworkBeacon::stopBroadcasting() {
     cleanup(); // Close socket after thread is dead
 }
 
+void NetworkBeacon::requestImmediateBeacon() {
+    {
+        std::lock_guard<std::mutex> lock(_netMtx);
+        if (!_netThreadRunning) return;
+        _keyframeRequested = true;
+    }
+    _netCv.notify_all();
+}
+
 void NetworkBeacon::broadcastThreadLoop() {
     int interval;
     int serverPort;
@@ -244,46 +426,109 @@ void NetworkBeacon::broadcastThreadLoop() {
     loopbackAddr.sin_port = htons(port);
     loopbackAddr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
 
+    const int baseInterval = interval;
+    int skipMultiplier = 1;      // subnet broadcast every this many ticks
+    int ticksSinceBroadcast = 0;
+    uint64_t stateSeq = 0;
+    std::string lastStatusJson;
+    int broadcastsSinceKeyframe = 0;
+    int idleTicks = 0;
+    bool firstCycle = true;
+
     while (true)
     {
+        std::function<std::string()> statusProvider;
+        bool forcedKeyframe;
         {
             std::lock_guard<std::mutex> lock(_netMtx);
             if (!_netThreadRunning) break;
+            statusProvider = _statusProvider;
+            forcedKeyframe = _keyframeRequested;
+            _keyframeRequested = false;
+        }
+        std::string statusJson;
+        if (statusProvider) {
+            statusJson = statusProvider();
         }
 
-        // Enumerate all RFC1918 interfaces and send a beacon on each
-        auto interfaces = getLocalRFC1918Interfaces();
-        for (const auto& iface : interfaces) {
-            // Skip loopback interfaces here, handled separately below
-            struct sockaddr_in loopCheck{};
-            if (inet_pton(AF_INET, iface.ipAddress.c_str(), &loopCheck.sin_addr) == 1) {
-                uint32_t ip = ntohl(loopCheck.sin_addr.s_addr);
-                if ((ip & 0xFF000000u) == 0x7F000000u) continue;
+        // Delta cadence for the subnet: a state change bumps the sequence,
+        // returns to the fast cadence and forces a keyframe. Unchanged state
+        // sends compact heartbeats, re-sending the full block every
+        // kKeyframeEvery broadcasts for late joiners, and stretches the
+        // effective broadcast interval while idle by skipping ticks.
+        const bool changed = firstCycle || statusJson != lastStatusJson;
+        firstCycle = false;
+        if (changed) {
+            ++stateSeq;
+            lastStatusJson = statusJson;
+            idleTicks = 0;
+            skipMultiplier = 1;
+        } else {
+            ++idleTicks;
+            if (idleTicks >= kIdleCyclesBeforeBackoff &&
+                skipMultiplier < kMaxBackoffMultiplier) {
+                skipMultiplier *= 2;
+                idleTicks = 0;
             }
-
-            std::string payload = buildStandardPayloadPattern(
-                hostname,
-                "http://" + iface.ipAddress + ":" + std::to_string(serverPort) + "/api/v1/"
-            );
-
-            sockaddr_in destAddr{};
-            destAddr.sin_family = AF_INET;
-            destAddr.sin_port = htons(port);
-            inet_pton(AF_INET, iface.broadcastAddress.c_str(), &destAddr.sin_addr);
-
-            if (sendto(_socket, payload.c_str(), (int)payload.size(), 0, (sockaddr*)&destAddr, sizeof(destAddr)) == -1) {
+        }
+        const bool broadcastDue = changed || forcedKeyframe ||
+                                  ++ticksSinceBroadcast >= skipMultiplier;
+
+        if (broadcastDue) {
+            ticksSinceBroadcast = 0;
+            const bool keyframe = changed || forcedKeyframe ||
+                                  ++broadcastsSinceKeyframe >= kKeyframeEvery;
+            if (keyframe) broadcastsSinceKeyframe = 0;
+            static const std::string kEmptyStatus;
+            const std::string& broadcastStatus = keyframe ? statusJson : kEmptyStatus;
+            const int advertisedInterval = baseInterval * skipMultiplier;
+
+            // Enumerate all RFC1918 interfaces and send a beacon on each
+            auto interfaces = getLocalRFC1918Interfaces();
+            for (const auto& iface : interfaces) {
+                // Skip loopback interfaces here, handled separately below
+                struct sockaddr_in loopCheck{};
+                if (inet_pton(AF_INET, iface.ipAddress.c_str(), &loopCheck.sin_addr) == 1) {
+                    uint32_t ip = ntohl(loopCheck.sin_addr.s_addr);
+                    if ((ip & 0xFF000000u) == 0x7F000000u) continue;
+                }
+
+                std::string payload = buildStandardPayloadPattern(
+                    hostname,
+                    "http://" + iface.ipAddress + ":" + std::to_string(serverPort) + "/api/v1/",
+                    broadcastStatus,
+                    stateSeq,
+                    advertisedInterval
+                );
+
+                sockaddr_in destAddr{};
+                destAddr.sin_family = AF_INET;
+                destAddr.sin_port = htons(port);
+                inet_pton(AF_INET, iface.broadcastAddress.c_str(), &destAddr.sin_addr);
+
+                if (sendto(_socket, payload.c_str(), (int)payload.size(), 0, (sockaddr*)&destAddr, sizeof(destAddr)) == -1) {
 #ifdef _WIN32
-                std::cerr << "[NetworkBeacon] sendto failed, error=" << WSAGetLastError() << std::endl;
+                    std::cerr << "[NetworkBeacon] sendto failed, error=" << WSAGetLastError() << std::endl;
 #else
-                std::cerr << "[NetworkBeacon] sendto failed, errno=" << errno << std::endl;
+                    std::cerr << "[NetworkBeacon] sendto failed, errno=" << errno << std::endl;
 #endif
+                }
+            }
+
+            if (keyframe) {
+                announceMdns(interfaces, hostname, static_cast<uint16_t>(serverPort));
             }
         }
 
-        // Always send on loopback for same-machine discovery
+        // Always send full status on loopback every tick: same-machine
+        // listeners (tray, CLI status) assemble state purely off this
+        // channel, and loopback bandwidth costs nothing.
         std::string loopbackPayload = buildStandardPayloadPattern(
             hostname,
-            "http://127.0.0.1:" + std::to_string(serverPort) + "/api/v1/"
+            "http://127.0.0.1:" + std::to_string(serverPort) + "/api/v1/",
+            statusJson,
+            stateSeq,
+            baseInterval
         );
         if (sendto(_socket, loopbackPayload.c_str(), (int)loopbackPayload.size(), 0, (sockaddr*)&loopbackAddr, sizeof(loopbackAddr)) == -1) {
 #ifdef _WIN32
@@ -293,6 +538,9 @@ void NetworkBeacon::broadcastThreadLoop() {
 #endif
         }
 
-        std::this_thread::sleep_for(std::chrono::seconds(interval));
+        std::unique_lock<std::mutex> waitLock(_netMtx);
+        _netCv.wait_for(waitLock, std::chrono::seconds(baseInterval), [this] {
+            return !_netThreadRunning || _keyframeRequested;
+        });
     }
 }
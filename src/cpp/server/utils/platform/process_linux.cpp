@@ -1,10 +1,12 @@
 #include <lemon/utils/process_platform.h>
 #include <lemon/utils/aixlog.hpp>
+#include <lemon/utils/pipe_line_capture.h>
 
 #include <stdexcept>
 #include <iostream>
 #include <fstream>
 
+#include <sched.h>
 #include <unistd.h>
 #include <sys/types.h>
 #include <sys/wait.h>
@@ -121,6 +123,7 @@ public:
 
     int find_free_port(int start_port) override;
     int run_command(const std::string& command, std::string& output, int timeout_seconds) override;
+    bool set_affinity(ProcessHandle handle, const std::vector<int>& cpus) override;
 
 protected:
     // To be overridden by platform-specific subclasses (macOS uses posix_spawn)
@@ -174,7 +177,7 @@ pid_t LinuxProcessPlatform::spawn_process(
             close(stdout_pipe[1]);
             close(stderr_pipe[1]);
         } else if (!inherit_output) {
-            int dev_null = open("/dev/null", O_WRONLY);
+            int dev_null = ::open("/dev/null", O_WRONLY);
             if (dev_null >= 0) {
                 dup2(dev_null, STDOUT_FILENO);
                 dup2(dev_null, STDERR_FILENO);
@@ -252,53 +255,20 @@ ProcessHandle LinuxProcessPlatform::spawn(
         close(stdout_pipe[1]);
         close(stderr_pipe[1]);
 
-        std::thread([fd = stdout_pipe[0]]() {
-            char buffer[4096];
-            std::string line_buffer;
+        auto pump_pipe = [](int fd) {
+            PipeLineCapture capture(log_process_line);
+            char buffer[65536];
             ssize_t bytes_read;
 
-            while ((bytes_read = read(fd, buffer, sizeof(buffer) - 1)) > 0) {
-                buffer[bytes_read] = '\0';
-                line_buffer += buffer;
-
-                size_t pos;
-                while ((pos = line_buffer.find('\n')) != std::string::npos) {
-                    std::string line = line_buffer.substr(0, pos);
-                    line_buffer = line_buffer.substr(pos + 1);
-                    log_process_line(line);
-                }
-            }
-
-            if (!line_buffer.empty()) {
-                log_process_line(line_buffer);
-            }
-
-            close(fd);
-        }).detach();
-
-        std::thread([fd = stderr_pipe[0]]() {
-            char buffer[4096];
-            std::string line_buffer;
-            ssize_t bytes_read;
-
-            while ((bytes_read = read(fd, buffer, sizeof(buffer) - 1)) > 0) {
-                buffer[bytes_read] = '\0';
-                line_buffer += buffer;
-
-                size_t pos;
-                while ((pos = line_buffer.find('\n')) != std::string::npos) {
-                    std::string line = line_buffer.substr(0, pos);
-                    line_buffer = line_buffer.substr(pos + 1);
-                    log_process_line(line);
-                }
-            }
-
-            if (!line_buffer.empty()) {
-                log_process_line(line_buffer);
+            while ((bytes_read = read(fd, buffer, sizeof(buffer))) > 0) {
+                capture.feed(buffer, static_cast<size_t>(bytes_read));
             }
 
+            capture.finish();
             close(fd);
-        }).detach();
+        };
+        std::thread(pump_pipe, stdout_pipe[0]).detach();
+        std::thread(pump_pipe, stderr_pipe[0]).detach();
     }
 
     return handle;
@@ -650,6 +620,20 @@ int LinuxProcessPlatform::run_with_output(
     return WIFEXITED(status) ? WEXITSTATUS(status) : -1;
 }
 
+bool LinuxProcessPlatform::set_affinity(ProcessHandle handle, const std::vector<int>& cpus) {
+    if (handle.pid <= 0 || cpus.empty()) {
+        return false;
+    }
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    for (int cpu : cpus) {
+        if (cpu >= 0 && cpu < CPU_SETSIZE) {
+            CPU_SET(cpu, &set);
+        }
+    }
+    return sched_setaffinity(handle.pid, sizeof(set), &set) == 0;
+}
+
 int LinuxProcessPlatform::find_free_port(int start_port) {
     for (int port = start_port; port < start_port + 1000; ++port) {
         int sock = socket(AF_INET, SOCK_STREAM, 0);
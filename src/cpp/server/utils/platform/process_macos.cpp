@@ -1,5 +1,6 @@
 #include <lemon/utils/process_platform.h>
 #include <lemon/utils/aixlog.hpp>
+#include <lemon/utils/pipe_line_capture.h>
 
 #include <stdexcept>
 
@@ -218,53 +219,20 @@ ProcessHandle MacOSProcessPlatform::spawn(
         close(stdout_pipe[1]);
         close(stderr_pipe[1]);
 
-        std::thread([fd = stdout_pipe[0]]() {
-            char buffer[4096];
-            std::string line_buffer;
+        auto pump_pipe = [](int fd) {
+            PipeLineCapture capture(log_process_line);
+            char buffer[65536];
             ssize_t bytes_read;
 
-            while ((bytes_read = read(fd, buffer, sizeof(buffer) - 1)) > 0) {
-                buffer[bytes_read] = '\0';
-                line_buffer += buffer;
-
-                size_t pos;
-                while ((pos = line_buffer.find('\n')) != std::string::npos) {
-                    std::string line = line_buffer.substr(0, pos);
-                    line_buffer = line_buffer.substr(pos + 1);
-                    log_process_line(line);
-                }
-            }
-
-            if (!line_buffer.empty()) {
-                log_process_line(line_buffer);
-            }
-
-            close(fd);
-        }).detach();
-
-        std::thread([fd = stderr_pipe[0]]() {
-            char buffer[4096];
-            std::string line_buffer;
-            ssize_t bytes_read;
-
-            while ((bytes_read = read(fd, buffer, sizeof(buffer) - 1)) > 0) {
-                buffer[bytes_read] = '\0';
-                line_buffer += buffer;
-
-                size_t pos;
-                while ((pos = line_buffer.find('\n')) != std::string::npos) {
-                    std::string line = line_buffer.substr(0, pos);
-                    line_buffer = line_buffer.substr(pos + 1);
-                    log_process_line(line);
-                }
-            }
-
-            if (!line_buffer.empty()) {
-                log_process_line(line_buffer);
+            while ((bytes_read = read(fd, buffer, sizeof(buffer))) > 0) {
+                capture.feed(buffer, static_cast<size_t>(bytes_read));
             }
 
+            capture.finish();
             close(fd);
-        }).detach();
+        };
+        std::thread(pump_pipe, stdout_pipe[0]).detach();
+        std::thread(pump_pipe, stderr_pipe[0]).detach();
     }
 
     return handle;
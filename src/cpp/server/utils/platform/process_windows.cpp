@@ -19,11 +19,15 @@
 
 #include <lemon/utils/process_platform.h>
 #include <lemon/utils/aixlog.hpp>
+#include <lemon/utils/pipe_line_capture.h>
 #include <algorithm>
+#include <atomic>
 #include <cctype>
 #include <chrono>
-#include <thread>
+#include <cstdio>
 #include <stdexcept>
+#include <thread>
+#include <vector>
 
 namespace lemon {
 namespace utils {
@@ -82,32 +86,174 @@ static void log_process_line(const std::string& line) {
     }
 }
 
-// Thread function to read from pipe and filter output
-static DWORD WINAPI output_filter_thread(LPVOID param) {
-    HANDLE pipe = static_cast<HANDLE>(param);
-    char buffer[4096];
-    DWORD bytes_read;
-    std::string line_buffer;
+// Anonymous pipes don't support overlapped I/O, so the IOCP path uses a
+// uniquely named pipe pair instead: inbound overlapped server end for the
+// parent, inheritable client end for the child's stdout/stderr.
+static bool create_overlapped_pipe(HANDLE* read_end, HANDLE* write_end) {
+    static std::atomic<unsigned long> serial{0};
+    char name[MAX_PATH];
+    std::snprintf(name, sizeof(name), "\\\\.\\pipe\\lemonade.%lu.%lu",
+                  static_cast<unsigned long>(GetCurrentProcessId()),
+                  serial.fetch_add(1) + 1);
+
+    HANDLE read_h = CreateNamedPipeA(
+        name,
+        PIPE_ACCESS_INBOUND | FILE_FLAG_OVERLAPPED | FILE_FLAG_FIRST_PIPE_INSTANCE,
+        PIPE_TYPE_BYTE | PIPE_WAIT, 1, 65536, 65536, 0, nullptr);
+    if (read_h == INVALID_HANDLE_VALUE) {
+        return false;
+    }
+
+    SECURITY_ATTRIBUTES sa;
+    sa.nLength = sizeof(SECURITY_ATTRIBUTES);
+    sa.bInheritHandle = TRUE;
+    sa.lpSecurityDescriptor = nullptr;
+    HANDLE write_h = CreateFileA(name, GENERIC_WRITE, 0, &sa, OPEN_EXISTING,
+                                 FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (write_h == INVALID_HANDLE_VALUE) {
+        CloseHandle(read_h);
+        return false;
+    }
+
+    *read_end = read_h;
+    *write_end = write_h;
+    return true;
+}
+
+// One completion port services every backend's stdout/stderr with a fixed
+// two-thread pool, instead of two blocking reader threads per process.
+// Per-pipe state is owned by the service from watch() until the pipe breaks;
+// only one read is ever outstanding per pipe, so its line capture needs no
+// locking even with multiple workers.
+class IocpPipeService {
+public:
+    static IocpPipeService& instance() {
+        static IocpPipeService service;
+        return service;
+    }
+
+    // Takes ownership of the overlapped read end. Returns false (handle not
+    // consumed) when registration fails.
+    bool watch(HANDLE pipe) {
+        if (!port_) {
+            return false;
+        }
+        auto* state = new PipeState(pipe);
+        if (!CreateIoCompletionPort(pipe, port_,
+                                    reinterpret_cast<ULONG_PTR>(state), 0)) {
+            delete state;
+            return false;
+        }
+        issue_read(state);
+        return true;
+    }
+
+private:
+    struct PipeState {
+        explicit PipeState(HANDLE h) : pipe(h), capture(log_process_line) {}
+        HANDLE pipe;
+        PipeLineCapture capture;
+        char buffer[65536];
+        OVERLAPPED overlapped{};
+    };
+
+    static constexpr ULONG_PTR kStopKey = 1;  // PipeState pointers are aligned
 
-    while (ReadFile(pipe, buffer, sizeof(buffer) - 1, &bytes_read, nullptr) && bytes_read > 0) {
-        buffer[bytes_read] = '\0';
-        line_buffer += buffer;
+    IocpPipeService() {
+        port_ = CreateIoCompletionPort(INVALID_HANDLE_VALUE, nullptr, 0, 0);
+        if (!port_) {
+            return;
+        }
+        for (int i = 0; i < 2; ++i) {
+            workers_.emplace_back([this]() { run(); });
+        }
+    }
 
-        // Process complete lines
-        size_t pos;
-        while ((pos = line_buffer.find('\n')) != std::string::npos) {
-            std::string line = line_buffer.substr(0, pos);
-            line_buffer = line_buffer.substr(pos + 1);
+    ~IocpPipeService() {
+        if (port_) {
+            for (size_t i = 0; i < workers_.size(); ++i) {
+                PostQueuedCompletionStatus(port_, 0, kStopKey, nullptr);
+            }
+        }
+        for (auto& worker : workers_) {
+            worker.join();
+        }
+        if (port_) {
+            CloseHandle(port_);
+        }
+    }
 
-            log_process_line(line);
+    void issue_read(PipeState* state) {
+        ZeroMemory(&state->overlapped, sizeof(state->overlapped));
+        if (!ReadFile(state->pipe, state->buffer, sizeof(state->buffer),
+                      nullptr, &state->overlapped) &&
+            GetLastError() != ERROR_IO_PENDING) {
+            finish(state);
         }
     }
 
-    // Print any remaining partial line
-    if (!line_buffer.empty()) {
-        log_process_line(line_buffer);
+    void finish(PipeState* state) {
+        state->capture.finish();
+        CloseHandle(state->pipe);
+        delete state;
     }
 
+    void run() {
+        for (;;) {
+            DWORD bytes = 0;
+            ULONG_PTR key = 0;
+            LPOVERLAPPED overlapped = nullptr;
+            const BOOL ok = GetQueuedCompletionStatus(port_, &bytes, &key,
+                                                      &overlapped, INFINITE);
+            if (key == kStopKey) {
+                break;
+            }
+            if (!overlapped) {
+                if (!ok) {
+                    break;  // port closed
+                }
+                continue;
+            }
+            auto* state = reinterpret_cast<PipeState*>(key);
+            if (!ok || bytes == 0) {
+                finish(state);  // broken pipe: child exited or closed stdio
+                continue;
+            }
+            state->capture.feed(state->buffer, bytes);
+            issue_read(state);
+        }
+    }
+
+    HANDLE port_ = nullptr;
+    std::vector<std::thread> workers_;
+};
+
+// Fallback reader when IOCP registration fails: one thread per pipe, using
+// event-based waits because the handle is opened overlapped.
+static DWORD WINAPI output_filter_thread(LPVOID param) {
+    HANDLE pipe = static_cast<HANDLE>(param);
+    PipeLineCapture capture(log_process_line);
+    char buffer[65536];
+
+    OVERLAPPED overlapped = {};
+    overlapped.hEvent = CreateEventA(nullptr, TRUE, FALSE, nullptr);
+    if (overlapped.hEvent) {
+        for (;;) {
+            DWORD bytes_read = 0;
+            if (!ReadFile(pipe, buffer, sizeof(buffer), nullptr, &overlapped) &&
+                GetLastError() != ERROR_IO_PENDING) {
+                break;
+            }
+            if (!GetOverlappedResult(pipe, &overlapped, &bytes_read, TRUE) ||
+                bytes_read == 0) {
+                break;
+            }
+            capture.feed(buffer, bytes_read);
+        }
+        CloseHandle(overlapped.hEvent);
+    }
+
+    capture.finish();
     CloseHandle(pipe);
     return 0;
 }
@@ -225,25 +371,18 @@ public:
 
         // If inherit_output is true, either use pipes with filtering or direct inheritance
         if (inherit_output && use_filtered_output) {
-            // Create pipes for stdout and stderr to filter output
-            SECURITY_ATTRIBUTES sa;
-            sa.nLength = sizeof(SECURITY_ATTRIBUTES);
-            sa.bInheritHandle = TRUE;
-            sa.lpSecurityDescriptor = nullptr;
-
-            if (!CreatePipe(&stdout_read, &stdout_write, &sa, 0)) {
+            // Overlapped pipes for stdout and stderr so one completion port
+            // can service every backend's output (read ends are created
+            // non-inheritable; write ends inheritable)
+            if (!create_overlapped_pipe(&stdout_read, &stdout_write)) {
                 throw std::runtime_error("Failed to create stdout pipe");
             }
-            if (!CreatePipe(&stderr_read, &stderr_write, &sa, 0)) {
+            if (!create_overlapped_pipe(&stderr_read, &stderr_write)) {
                 CloseHandle(stdout_read);
                 CloseHandle(stdout_write);
                 throw std::runtime_error("Failed to create stderr pipe");
             }
 
-            // Make sure the read handles are not inherited
-            SetHandleInformation(stdout_read, HANDLE_FLAG_INHERIT, 0);
-            SetHandleInformation(stderr_read, HANDLE_FLAG_INHERIT, 0);
-
             si.dwFlags = STARTF_USESTDHANDLES;
             si.hStdInput = GetStdHandle(STD_INPUT_HANDLE);
             if (si.hStdInput == nullptr || si.hStdInput == INVALID_HANDLE_VALUE) {
@@ -336,10 +475,13 @@ public:
         if (stdout_write) CloseHandle(stdout_write);
         if (stderr_write) CloseHandle(stderr_write);
 
-        // Start filter threads if needed
+        // Hand the read ends to the shared completion port
         if (inherit_output && use_filtered_output) {
-            CreateThread(nullptr, 0, output_filter_thread, stdout_read, 0, nullptr);
-            CreateThread(nullptr, 0, output_filter_thread, stderr_read, 0, nullptr);
+            for (HANDLE read_end : {stdout_read, stderr_read}) {
+                if (!IocpPipeService::instance().watch(read_end)) {
+                    CreateThread(nullptr, 0, output_filter_thread, read_end, 0, nullptr);
+                }
+            }
         }
 
         if (inherit_output) {
@@ -353,6 +495,31 @@ public:
         return handle;
     }
 
+    ProcessHandle open_handle(int pid) override {
+        HANDLE h = OpenProcess(
+            PROCESS_QUERY_LIMITED_INFORMATION | SYNCHRONIZE | PROCESS_TERMINATE,
+            FALSE, static_cast<DWORD>(pid));
+        return {h, pid};
+    }
+
+    bool set_affinity(ProcessHandle handle, const std::vector<int>& cpus) override {
+        if (!handle.handle || cpus.empty()) {
+            return false;
+        }
+        // An affinity mask covers the first 64 logical processors only;
+        // cores beyond that cannot be requested through this API.
+        DWORD_PTR mask = 0;
+        for (int cpu : cpus) {
+            if (cpu >= 0 && cpu < static_cast<int>(sizeof(DWORD_PTR) * 8)) {
+                mask |= static_cast<DWORD_PTR>(1) << cpu;
+            }
+        }
+        if (mask == 0) {
+            return false;
+        }
+        return SetProcessAffinityMask(handle.handle, mask) != 0;
+    }
+
     void terminate(ProcessHandle handle) override {
         if (handle.handle) {
             TerminateProcess(handle.handle, 0);
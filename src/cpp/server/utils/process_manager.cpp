@@ -21,6 +21,11 @@ void ProcessManager::stop_process(ProcessHandle handle) {
     platform->terminate(handle);
 }
 
+ProcessHandle ProcessManager::open_process(int pid) {
+    auto platform = create_process_platform();
+    return platform->open_handle(pid);
+}
+
 bool ProcessManager::is_running(ProcessHandle handle) {
     auto platform = create_process_platform();
     return platform->is_running(handle);
@@ -69,6 +74,11 @@ void ProcessManager::terminate_process(ProcessHandle handle) {
     platform->terminate_without_cleanup(handle);
 }
 
+bool ProcessManager::set_process_affinity(ProcessHandle handle, const std::vector<int>& cpus) {
+    auto platform = create_process_platform();
+    return platform->set_affinity(handle, cpus);
+}
+
 int ProcessManager::find_free_port(int start_port) {
     auto platform = create_process_platform();
     return platform->find_free_port(start_port);
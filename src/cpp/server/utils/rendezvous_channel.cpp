@@ -0,0 +1,286 @@
+#include "lemon/utils/rendezvous_channel.h"
+
+#include <cerrno>
+#include <cstring>
+
+#ifdef _WIN32
+    #include <windows.h>
+#else
+    #include <poll.h>
+    #include <sys/socket.h>
+    #include <sys/un.h>
+    #include <unistd.h>
+#endif
+
+#include "lemon/utils/aixlog.hpp"
+#include "lemon/utils/path_utils.h"
+#include "lemon/version.h"
+
+namespace lemon {
+namespace utils {
+
+namespace {
+
+#ifdef _WIN32
+const char* kPipeName = "\\\\.\\pipe\\lemonade-lemond";
+#else
+std::string socket_path() {
+    return get_runtime_dir() + "/lemond.sock";
+}
+#endif
+
+int current_pid() {
+#ifdef _WIN32
+    return static_cast<int>(GetCurrentProcessId());
+#else
+    return static_cast<int>(getpid());
+#endif
+}
+
+}  // namespace
+
+RendezvousChannel& RendezvousChannel::global() {
+    static RendezvousChannel instance;
+    return instance;
+}
+
+RendezvousChannel::~RendezvousChannel() {
+    stop();
+}
+
+std::string RendezvousChannel::payload() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    const nlohmann::json hello = {
+        {"service", "lemonade"},
+        {"state", state_},
+        {"port", port_},
+        {"pid", current_pid()},
+        {"version", LEMON_VERSION_STRING},
+    };
+    return hello.dump();
+}
+
+void RendezvousChannel::set_state(const std::string& state, int port) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    state_ = state;
+    if (port > 0) {
+        port_ = port;
+    }
+}
+
+void RendezvousChannel::start() {
+    if (running_.exchange(true)) {
+        return;
+    }
+
+    // A live answer means another lemond owns the endpoint; leave it alone
+    // rather than hijacking its channel.
+    nlohmann::json other;
+    if (query(other, 100)) {
+        LOG(WARNING, "Rendezvous")
+            << "Another lemond (pid " << other.value("pid", 0)
+            << ") already owns the rendezvous channel" << std::endl;
+        running_ = false;
+        return;
+    }
+
+#ifndef _WIN32
+    std::string path;
+    try {
+        path = socket_path();
+    } catch (const std::exception& e) {
+        LOG(WARNING, "Rendezvous")
+            << "No runtime directory for the rendezvous channel: " << e.what()
+            << std::endl;
+        running_ = false;
+        return;
+    }
+    ::unlink(path.c_str());
+
+    listen_fd_ = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    if (listen_fd_ < 0) {
+        running_ = false;
+        return;
+    }
+
+    sockaddr_un addr{};
+    addr.sun_family = AF_UNIX;
+    if (path.size() >= sizeof(addr.sun_path)) {
+        ::close(listen_fd_);
+        listen_fd_ = -1;
+        running_ = false;
+        return;
+    }
+    std::strncpy(addr.sun_path, path.c_str(), sizeof(addr.sun_path) - 1);
+
+    if (::bind(listen_fd_, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) < 0 ||
+        ::listen(listen_fd_, 8) < 0) {
+        LOG(WARNING, "Rendezvous") << "Failed to claim " << path << ": "
+                                   << std::strerror(errno) << std::endl;
+        ::close(listen_fd_);
+        listen_fd_ = -1;
+        running_ = false;
+        return;
+    }
+#endif
+
+    serve_thread_ = std::thread([this] { serve_loop(); });
+}
+
+void RendezvousChannel::serve_loop() {
+#ifdef _WIN32
+    while (running_.load()) {
+        HANDLE pipe = CreateNamedPipeA(kPipeName,
+                                       PIPE_ACCESS_OUTBOUND,
+                                       PIPE_TYPE_BYTE | PIPE_WAIT,
+                                       PIPE_UNLIMITED_INSTANCES,
+                                       1024, 1024, 0, nullptr);
+        if (pipe == INVALID_HANDLE_VALUE) {
+            Sleep(250);
+            continue;
+        }
+        const BOOL connected = ConnectNamedPipe(pipe, nullptr)
+            ? TRUE
+            : (GetLastError() == ERROR_PIPE_CONNECTED);
+        if (connected && running_.load()) {
+            const std::string hello = payload();
+            DWORD written = 0;
+            WriteFile(pipe, hello.data(), static_cast<DWORD>(hello.size()),
+                      &written, nullptr);
+            FlushFileBuffers(pipe);
+        }
+        DisconnectNamedPipe(pipe);
+        CloseHandle(pipe);
+    }
+#else
+    while (running_.load()) {
+        pollfd pfd{};
+        pfd.fd = listen_fd_;
+        pfd.events = POLLIN;
+        const int ready = ::poll(&pfd, 1, 250);
+        if (ready <= 0 || !(pfd.revents & POLLIN)) {
+            continue;
+        }
+        const int client = ::accept(listen_fd_, nullptr, nullptr);
+        if (client < 0) {
+            continue;
+        }
+        const std::string hello = payload();
+        size_t sent = 0;
+        while (sent < hello.size()) {
+            const ssize_t n =
+                ::send(client, hello.data() + sent, hello.size() - sent, 0);
+            if (n <= 0) {
+                break;
+            }
+            sent += static_cast<size_t>(n);
+        }
+        ::close(client);
+    }
+#endif
+}
+
+void RendezvousChannel::stop() {
+    if (!running_.exchange(false)) {
+        return;
+    }
+#ifdef _WIN32
+    // Unblock ConnectNamedPipe by completing a throwaway connection.
+    HANDLE poke = CreateFileA(kPipeName, GENERIC_READ, 0, nullptr,
+                              OPEN_EXISTING, 0, nullptr);
+    if (poke != INVALID_HANDLE_VALUE) {
+        CloseHandle(poke);
+    }
+#endif
+    if (serve_thread_.joinable()) {
+        serve_thread_.join();
+    }
+#ifndef _WIN32
+    if (listen_fd_ >= 0) {
+        ::close(listen_fd_);
+        listen_fd_ = -1;
+        try {
+            ::unlink(socket_path().c_str());
+        } catch (const std::exception&) {
+        }
+    }
+#endif
+}
+
+bool RendezvousChannel::query(nlohmann::json& out, int timeout_ms) {
+    std::string data;
+#ifdef _WIN32
+    HANDLE pipe = CreateFileA(kPipeName, GENERIC_READ, 0, nullptr,
+                              OPEN_EXISTING, 0, nullptr);
+    if (pipe == INVALID_HANDLE_VALUE && GetLastError() == ERROR_PIPE_BUSY) {
+        if (!WaitNamedPipeA(kPipeName, static_cast<DWORD>(timeout_ms))) {
+            return false;
+        }
+        pipe = CreateFileA(kPipeName, GENERIC_READ, 0, nullptr,
+                           OPEN_EXISTING, 0, nullptr);
+    }
+    if (pipe == INVALID_HANDLE_VALUE) {
+        return false;
+    }
+    char buffer[1024];
+    DWORD read = 0;
+    while (ReadFile(pipe, buffer, sizeof(buffer), &read, nullptr) && read > 0) {
+        data.append(buffer, read);
+    }
+    CloseHandle(pipe);
+#else
+    const int fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0) {
+        return false;
+    }
+
+    timeval timeout{};
+    timeout.tv_sec = timeout_ms / 1000;
+    timeout.tv_usec = (timeout_ms % 1000) * 1000;
+    ::setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+    ::setsockopt(fd, SOL_SOCKET, SO_SNDTIMEO, &timeout, sizeof(timeout));
+
+    sockaddr_un addr{};
+    addr.sun_family = AF_UNIX;
+    std::string path;
+    try {
+        path = socket_path();
+    } catch (const std::exception&) {
+        ::close(fd);
+        return false;
+    }
+    if (path.size() >= sizeof(addr.sun_path)) {
+        ::close(fd);
+        return false;
+    }
+    std::strncpy(addr.sun_path, path.c_str(), sizeof(addr.sun_path) - 1);
+
+    if (::connect(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) < 0) {
+        ::close(fd);
+        return false;
+    }
+    char buffer[1024];
+    ssize_t n;
+    while ((n = ::recv(fd, buffer, sizeof(buffer), 0)) > 0) {
+        data.append(buffer, static_cast<size_t>(n));
+    }
+    ::close(fd);
+#endif
+
+    if (data.empty()) {
+        return false;
+    }
+    try {
+        auto hello = nlohmann::json::parse(data);
+        if (hello.value("service", "") != "lemonade") {
+            return false;
+        }
+        out = std::move(hello);
+        return true;
+    } catch (const nlohmann::json::exception&) {
+        return false;
+    }
+}
+
+}  // namespace utils
+}  // namespace lemon
@@ -15,6 +15,7 @@
     #include <arpa/inet.h>
     #include <netinet/in.h>
     #include <sys/socket.h>
+    #include <sys/uio.h>
     #include <unistd.h>
     #define INVALID_SOCKET_JL -1
     #define LMCLOSE_SOCKET ::close
@@ -110,16 +111,84 @@ void TcpJsonlClient::send(const json& msg) {
         return;
     }
 
-    std::string line = msg.dump() + "\n";
-    const char* data = line.c_str();
-    size_t remaining = line.size();
+    if (send_lines_.empty()) {
+        send_lines_.emplace_back();
+    }
+    std::string& line = send_lines_[0];
+    line.assign(msg.dump());
+    line.push_back('\n');
+
+    write_lines_locked(1);
+}
+
+void TcpJsonlClient::send_batch(const std::vector<json>& msgs) {
+    if (msgs.empty()) {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(socket_mutex_);
+    if (socket_fd_ == INVALID_SOCKET_JL || !connected_.load()) {
+        return;
+    }
+
+    if (send_lines_.size() < msgs.size()) {
+        send_lines_.resize(msgs.size());
+    }
+    for (size_t i = 0; i < msgs.size(); ++i) {
+        std::string& line = send_lines_[i];
+        line.assign(msgs[i].dump());
+        line.push_back('\n');
+    }
+
+    write_lines_locked(msgs.size());
+}
+
+void TcpJsonlClient::write_lines_locked(size_t count) {
+    // Scatter-gather chunks capped well under any platform's IOV_MAX.
+    constexpr size_t kMaxVectors = 64;
 
-    while (remaining > 0) {
 #ifdef _WIN32
-        int sent = ::send(socket_fd_, data, static_cast<int>(remaining), 0);
+    std::vector<WSABUF> vectors(count);
+    for (size_t i = 0; i < count; ++i) {
+        vectors[i].buf = send_lines_[i].data();
+        vectors[i].len = static_cast<ULONG>(send_lines_[i].size());
+    }
+
+    size_t idx = 0;
+    while (idx < count) {
+        const DWORD chunk = static_cast<DWORD>(
+            (count - idx) < kMaxVectors ? (count - idx) : kMaxVectors);
+        DWORD sent = 0;
+        if (WSASend(socket_fd_, vectors.data() + idx, chunk, &sent, 0, nullptr,
+                    nullptr) != 0) {
+            if (SOCKET_ERRNO == SOCKET_EINTR) {
+                continue;
+            }
+            connected_.store(false);
+            return;
+        }
+        size_t remaining = sent;
+        while (idx < count && remaining >= vectors[idx].len) {
+            remaining -= vectors[idx].len;
+            ++idx;
+        }
+        if (idx < count && remaining > 0) {
+            vectors[idx].buf += remaining;
+            vectors[idx].len -= static_cast<ULONG>(remaining);
+        }
+    }
 #else
-        auto sent = ::send(socket_fd_, data, remaining, 0);
-#endif
+    std::vector<struct iovec> vectors(count);
+    for (size_t i = 0; i < count; ++i) {
+        vectors[i].iov_base = send_lines_[i].data();
+        vectors[i].iov_len = send_lines_[i].size();
+    }
+
+    size_t idx = 0;
+    while (idx < count) {
+        const int chunk = static_cast<int>(
+            (count - idx) < kMaxVectors ? (count - idx) : kMaxVectors);
+        const ssize_t sent = ::writev(socket_fd_, vectors.data() + idx, chunk);
         if (sent < 0) {
             if (SOCKET_ERRNO == SOCKET_EINTR) {
                 continue;
@@ -127,9 +196,17 @@ void TcpJsonlClient::send(const json& msg) {
             connected_.store(false);
             return;
         }
-        data += sent;
-        remaining -= static_cast<size_t>(sent);
+        size_t remaining = static_cast<size_t>(sent);
+        while (idx < count && remaining >= vectors[idx].iov_len) {
+            remaining -= vectors[idx].iov_len;
+            ++idx;
+        }
+        if (idx < count && remaining > 0) {
+            vectors[idx].iov_base = static_cast<char*>(vectors[idx].iov_base) + remaining;
+            vectors[idx].iov_len -= remaining;
+        }
     }
+#endif
 }
 
 void TcpJsonlClient::close() {
@@ -164,10 +241,10 @@ void TcpJsonlClient::read_loop(const std::string& host, int port) {
     (void)port;
 
     std::string buffer;
-    buffer.reserve(4096);
+    buffer.reserve(8192);
 
     while (!stop_.load() && connected_.load()) {
-        char chunk[1024];
+        char chunk[8192];
 #ifdef _WIN32
         int n = recv(socket_fd_, chunk, static_cast<int>(sizeof(chunk)), 0);
 #else
@@ -182,28 +259,32 @@ void TcpJsonlClient::read_loop(const std::string& host, int port) {
 
         buffer.append(chunk, static_cast<size_t>(n));
 
-        // Process complete lines
+        // Parse every complete line in place, then drop the consumed prefix
+        // in one erase (a per-line erase is quadratic when a read delivers
+        // many lines).
+        size_t start = 0;
         size_t pos;
-        while ((pos = buffer.find('\n')) != std::string::npos) {
-            std::string line = buffer.substr(0, pos);
-            buffer.erase(0, pos + 1);
-
-            if (!line.empty() && line.back() == '\r') {
-                line.pop_back();
+        while ((pos = buffer.find('\n', start)) != std::string::npos) {
+            size_t len = pos - start;
+            if (len > 0 && buffer[start + len - 1] == '\r') {
+                --len;
             }
 
-            if (line.empty()) {
-                continue;
-            }
-
-            try {
-                json msg = json::parse(line);
-                if (callback_) {
-                    callback_(msg);
+            if (len > 0) {
+                try {
+                    const char* first = buffer.data() + start;
+                    json msg = json::parse(first, first + len);
+                    if (callback_) {
+                        callback_(msg);
+                    }
+                } catch (const json::parse_error&) {
+                    // Malformed line, ignore
                 }
-            } catch (const json::parse_error&) {
-                // Malformed line, ignore
             }
+            start = pos + 1;
+        }
+        if (start > 0) {
+            buffer.erase(0, start);
         }
 
         // Prevent unbounded growth if no newlines ever arrive
@@ -0,0 +1,148 @@
+#include "lemon/utils/zstd_patch.h"
+
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <vector>
+#include <zstd.h>
+
+namespace fs = std::filesystem;
+
+namespace lemon::utils {
+
+namespace {
+
+constexpr std::uintmax_t kMaxBaseBytes = 4ull * 1024 * 1024 * 1024;
+
+bool read_whole_file(const std::string& path, std::vector<char>& out,
+                     std::string& error) {
+    std::error_code ec;
+    const auto size = fs::file_size(path, ec);
+    if (ec) {
+        error = "Cannot stat base file " + path + ": " + ec.message();
+        return false;
+    }
+    if (size > kMaxBaseBytes) {
+        error = "Base file too large for in-memory patching: " + path;
+        return false;
+    }
+    std::ifstream in(path, std::ios::binary);
+    if (!in) {
+        error = "Cannot open base file: " + path;
+        return false;
+    }
+    out.resize(static_cast<size_t>(size));
+    if (size > 0 && !in.read(out.data(), static_cast<std::streamsize>(size))) {
+        error = "Failed to read base file: " + path;
+        return false;
+    }
+    return true;
+}
+
+struct DCtxGuard {
+    ZSTD_DCtx* ctx;
+    explicit DCtxGuard(ZSTD_DCtx* c) : ctx(c) {}
+    ~DCtxGuard() { ZSTD_freeDCtx(ctx); }
+};
+
+} // namespace
+
+bool ZstdPatch::apply(const std::string& base_path,
+                      const std::string& patch_path,
+                      const std::string& output_path,
+                      std::string& error) {
+    std::vector<char> base;
+    if (!read_whole_file(base_path, base, error)) {
+        return false;
+    }
+
+    std::ifstream patch_in(patch_path, std::ios::binary);
+    if (!patch_in) {
+        error = "Cannot open patch file: " + patch_path;
+        return false;
+    }
+    std::ofstream out(output_path, std::ios::binary | std::ios::trunc);
+    if (!out) {
+        error = "Cannot create output file: " + output_path;
+        return false;
+    }
+
+    ZSTD_DCtx* dctx = ZSTD_createDCtx();
+    if (!dctx) {
+        error = "Failed to create zstd decompression context";
+        return false;
+    }
+    DCtxGuard dctx_guard(dctx);
+
+    auto fail = [&](const std::string& message) {
+        error = message;
+        out.close();
+        std::error_code ec;
+        fs::remove(output_path, ec);
+        return false;
+    };
+
+    // patch-from frames carry a window as large as the base file, which can
+    // exceed the library's default 2^27 streaming limit.
+    size_t rc = ZSTD_DCtx_setParameter(dctx, ZSTD_d_windowLogMax, 31);
+    if (ZSTD_isError(rc)) {
+        return fail(std::string("zstd parameter error: ") + ZSTD_getErrorName(rc));
+    }
+
+    std::vector<char> in_buf(ZSTD_DStreamInSize());
+    std::vector<char> out_buf(ZSTD_DStreamOutSize());
+    bool at_frame_start = true;
+
+    while (true) {
+        patch_in.read(in_buf.data(), static_cast<std::streamsize>(in_buf.size()));
+        const size_t read_bytes = static_cast<size_t>(patch_in.gcount());
+        if (read_bytes == 0) {
+            if (at_frame_start) {
+                break;
+            }
+            return fail("Patch file is truncated: " + patch_path);
+        }
+
+        ZSTD_inBuffer input{in_buf.data(), read_bytes, 0};
+        while (input.pos < input.size) {
+            if (at_frame_start) {
+                // The prefix reference is consumed by each frame; re-attach it
+                // before every frame in the patch.
+                rc = ZSTD_DCtx_refPrefix(dctx, base.data(), base.size());
+                if (ZSTD_isError(rc)) {
+                    return fail(std::string("zstd prefix error: ")
+                                + ZSTD_getErrorName(rc));
+                }
+                at_frame_start = false;
+            }
+            ZSTD_outBuffer output{out_buf.data(), out_buf.size(), 0};
+            rc = ZSTD_decompressStream(dctx, &output, &input);
+            if (ZSTD_isError(rc)) {
+                return fail(std::string("Patch application failed: ")
+                            + ZSTD_getErrorName(rc));
+            }
+            if (output.pos > 0) {
+                out.write(out_buf.data(), static_cast<std::streamsize>(output.pos));
+                if (!out.good()) {
+                    return fail("Failed to write output file: " + output_path);
+                }
+            }
+            if (rc == 0) {
+                at_frame_start = true;
+            }
+        }
+    }
+
+    out.flush();
+    if (!out.good()) {
+        return fail("Failed to write output file: " + output_path);
+    }
+    return true;
+}
+
+std::string ZstdPatch::patch_asset_name(const std::string& filename,
+                                        const std::string& from_version) {
+    return filename + ".zstd-patch-from-" + from_version;
+}
+
+} // namespace lemon::utils
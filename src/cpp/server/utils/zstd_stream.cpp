@@ -0,0 +1,246 @@
+#include "lemon/utils/zstd_stream.h"
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <filesystem>
+#include <fstream>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <zstd.h>
+
+namespace fs = std::filesystem;
+
+namespace lemon::utils {
+
+namespace {
+
+// Large enough that the writer issues few, sequential writes; small enough
+// that the bounded queue caps pipeline memory at a few megabytes.
+constexpr size_t kChunkBytes = 1 << 20;
+constexpr size_t kMaxQueuedChunks = 4;
+
+struct DCtxGuard {
+    ZSTD_DCtx* ctx;
+    explicit DCtxGuard(ZSTD_DCtx* c) : ctx(c) {}
+    ~DCtxGuard() { ZSTD_freeDCtx(ctx); }
+};
+
+class ChunkQueue {
+public:
+    // Blocks while the queue is full. Returns false once the consumer has
+    // given up, so the producer stops decompressing into a dead pipeline.
+    bool push(std::vector<char>&& chunk) {
+        std::unique_lock<std::mutex> lock(mutex_);
+        not_full_.wait(lock, [this] {
+            return queue_.size() < kMaxQueuedChunks || aborted_;
+        });
+        if (aborted_) {
+            return false;
+        }
+        queue_.push_back(std::move(chunk));
+        not_empty_.notify_one();
+        return true;
+    }
+
+    // Blocks until a chunk is available or the producer finished. Returns
+    // false on end of stream.
+    bool pop(std::vector<char>& chunk) {
+        std::unique_lock<std::mutex> lock(mutex_);
+        not_empty_.wait(lock, [this] { return !queue_.empty() || finished_; });
+        if (queue_.empty()) {
+            return false;
+        }
+        chunk = std::move(queue_.front());
+        queue_.pop_front();
+        not_full_.notify_one();
+        return true;
+    }
+
+    void finish() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        finished_ = true;
+        not_empty_.notify_all();
+    }
+
+    void abort() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        aborted_ = true;
+        finished_ = true;
+        not_full_.notify_all();
+        not_empty_.notify_all();
+    }
+
+private:
+    std::mutex mutex_;
+    std::condition_variable not_full_;
+    std::condition_variable not_empty_;
+    std::deque<std::vector<char>> queue_;
+    bool finished_ = false;
+    bool aborted_ = false;
+};
+
+} // namespace
+
+bool ZstdStream::is_zstd_file(const std::string& path) {
+    std::ifstream in(path, std::ios::binary);
+    if (!in) {
+        return false;
+    }
+    unsigned char magic[4] = {};
+    in.read(reinterpret_cast<char*>(magic), sizeof(magic));
+    if (in.gcount() != sizeof(magic)) {
+        return false;
+    }
+    return magic[0] == 0x28 && magic[1] == 0xB5 && magic[2] == 0x2F &&
+           magic[3] == 0xFD;
+}
+
+bool ZstdStream::decompress_file(const std::string& src_path,
+                                 const std::string& dest_path,
+                                 std::string& error) {
+    std::ifstream in(src_path, std::ios::binary);
+    if (!in) {
+        error = "Cannot open archive: " + src_path;
+        return false;
+    }
+    std::ofstream out(dest_path, std::ios::binary | std::ios::trunc);
+    if (!out) {
+        error = "Cannot create output file: " + dest_path;
+        return false;
+    }
+
+    ZSTD_DCtx* dctx = ZSTD_createDCtx();
+    if (!dctx) {
+        error = "Failed to create zstd decompression context";
+        return false;
+    }
+    DCtxGuard dctx_guard(dctx);
+
+    std::vector<char> in_buf(ZSTD_DStreamInSize());
+
+    // Peek the first frame header for the content size so the output file can
+    // be preallocated, keeping the write-out sequential over already-reserved
+    // extents instead of growing the file chunk by chunk.
+    in.read(in_buf.data(), static_cast<std::streamsize>(in_buf.size()));
+    size_t pending = static_cast<size_t>(in.gcount());
+    std::uint64_t preallocated = 0;
+    {
+        const unsigned long long content_size =
+            ZSTD_getFrameContentSize(in_buf.data(), pending);
+        if (content_size != ZSTD_CONTENTSIZE_UNKNOWN &&
+            content_size != ZSTD_CONTENTSIZE_ERROR && content_size > 0) {
+            std::error_code ec;
+            fs::resize_file(dest_path, content_size, ec);
+            if (!ec) {
+                preallocated = content_size;
+                out.seekp(0);
+            }
+        }
+    }
+
+    ChunkQueue queue;
+    std::uint64_t written = 0;
+    bool write_failed = false;
+    std::thread writer([&] {
+        std::vector<char> chunk;
+        while (queue.pop(chunk)) {
+            out.write(chunk.data(), static_cast<std::streamsize>(chunk.size()));
+            if (!out.good()) {
+                write_failed = true;
+                queue.abort();
+                return;
+            }
+            written += chunk.size();
+        }
+    });
+
+    auto fail = [&](const std::string& message) {
+        queue.abort();
+        writer.join();
+        error = message;
+        out.close();
+        std::error_code ec;
+        fs::remove(dest_path, ec);
+        return false;
+    };
+
+    std::vector<char> out_buf;
+    out_buf.reserve(kChunkBytes);
+    std::vector<char> scratch(ZSTD_DStreamOutSize());
+    bool at_frame_end = true;
+
+    while (true) {
+        if (pending == 0) {
+            in.read(in_buf.data(), static_cast<std::streamsize>(in_buf.size()));
+            pending = static_cast<size_t>(in.gcount());
+            if (pending == 0) {
+                if (!at_frame_end) {
+                    return fail("Archive is truncated: " + src_path);
+                }
+                break;
+            }
+        }
+
+        ZSTD_inBuffer input{in_buf.data(), pending, 0};
+        while (input.pos < input.size) {
+            ZSTD_outBuffer output{scratch.data(), scratch.size(), 0};
+            const size_t rc = ZSTD_decompressStream(dctx, &output, &input);
+            if (ZSTD_isError(rc)) {
+                return fail(std::string("zstd decompression failed: ") +
+                            ZSTD_getErrorName(rc));
+            }
+            at_frame_end = (rc == 0);
+            if (output.pos > 0) {
+                out_buf.insert(out_buf.end(), scratch.data(),
+                               scratch.data() + output.pos);
+                if (out_buf.size() >= kChunkBytes) {
+                    if (!queue.push(std::move(out_buf))) {
+                        return fail("Failed to write output file: " + dest_path);
+                    }
+                    out_buf = std::vector<char>();
+                    out_buf.reserve(kChunkBytes);
+                }
+            }
+        }
+        pending = 0;
+    }
+
+    if (!out_buf.empty() && !queue.push(std::move(out_buf))) {
+        return fail("Failed to write output file: " + dest_path);
+    }
+    queue.finish();
+    writer.join();
+    if (write_failed) {
+        error = "Failed to write output file: " + dest_path;
+        out.close();
+        std::error_code ec;
+        fs::remove(dest_path, ec);
+        return false;
+    }
+
+    out.flush();
+    out.close();
+    if (!out.good()) {
+        error = "Failed to write output file: " + dest_path;
+        std::error_code ec;
+        fs::remove(dest_path, ec);
+        return false;
+    }
+
+    // Multi-frame archives (or a wrong content-size header) can come up short
+    // of the preallocation; trim the tail so tar never sees trailing zeros.
+    if (preallocated > written) {
+        std::error_code ec;
+        fs::resize_file(dest_path, written, ec);
+        if (ec) {
+            error = "Failed to trim output file: " + dest_path;
+            fs::remove(dest_path, ec);
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace lemon::utils
@@ -1,6 +1,14 @@
 #include "lemon/vad.h"
-#include <cmath>
 #include <chrono>
+#include <cmath>
+
+#if defined(__aarch64__) || defined(_M_ARM64)
+    #include <arm_neon.h>
+    #define LEMON_VAD_NEON 1
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #include <emmintrin.h>
+    #define LEMON_VAD_SSE2 1
+#endif
 
 namespace lemon {
 
@@ -12,16 +20,69 @@ SimpleVAD::SimpleVAD(const Config& config)
     : config_(config) {
 }
 
-float SimpleVAD::calculate_rms(const std::vector<float>& audio) {
-    if (audio.empty()) {
-        return 0.0f;
+bool SimpleVAD::config_for_profile(const std::string& name, Config& config) {
+    Config preset;
+    if (name == "fast") {
+        preset.min_speech_ms = 150;
+        preset.min_silence_ms = 200;
+        preset.hangover_frames = 2;
+    } else if (name == "balanced") {
+        preset.min_silence_ms = 500;
+        preset.hangover_frames = 4;
+    } else if (name != "dictation") {
+        return false;
+    }
+    config = preset;
+    return true;
+}
+
+float SimpleVAD::sum_squares_scalar(const float* samples, size_t count) {
+    float sum = 0.0f;
+    for (size_t i = 0; i < count; ++i) {
+        sum += samples[i] * samples[i];
+    }
+    return sum;
+}
+
+float SimpleVAD::sum_squares(const float* samples, size_t count) {
+#if defined(LEMON_VAD_NEON)
+    float32x4_t acc = vdupq_n_f32(0.0f);
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        float32x4_t v = vld1q_f32(samples + i);
+        acc = vmlaq_f32(acc, v, v);
+    }
+    float sum = vaddvq_f32(acc);
+    for (; i < count; ++i) {
+        sum += samples[i] * samples[i];
+    }
+    return sum;
+#elif defined(LEMON_VAD_SSE2)
+    __m128 acc = _mm_setzero_ps();
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        __m128 v = _mm_loadu_ps(samples + i);
+        acc = _mm_add_ps(acc, _mm_mul_ps(v, v));
     }
+    __m128 shuf = _mm_shuffle_ps(acc, acc, _MM_SHUFFLE(2, 3, 0, 1));
+    acc = _mm_add_ps(acc, shuf);
+    shuf = _mm_shuffle_ps(acc, acc, _MM_SHUFFLE(1, 0, 3, 2));
+    acc = _mm_add_ps(acc, shuf);
+    float sum = _mm_cvtss_f32(acc);
+    for (; i < count; ++i) {
+        sum += samples[i] * samples[i];
+    }
+    return sum;
+#else
+    return sum_squares_scalar(samples, count);
+#endif
+}
 
-    float sum_squares = 0.0f;
-    for (float sample : audio) {
-        sum_squares += sample * sample;
+float SimpleVAD::calculate_rms(const float* samples, size_t count) {
+    if (count == 0) {
+        return 0.0f;
     }
-    return std::sqrt(sum_squares / static_cast<float>(audio.size()));
+    return std::sqrt(sum_squares(samples, count) / static_cast<float>(count));
 }
 
 int64_t SimpleVAD::current_time_ms() {
@@ -31,16 +92,21 @@ int64_t SimpleVAD::current_time_ms() {
 }
 
 SimpleVAD::Event SimpleVAD::process(const std::vector<float>& audio, int sample_rate) {
-    if (audio.empty()) {
+    return process(audio.data(), audio.size(), sample_rate);
+}
+
+SimpleVAD::Event SimpleVAD::process(const float* samples, size_t count, int sample_rate) {
+    if (count == 0) {
         return Event::None;
     }
 
     // Calculate RMS energy of this chunk
-    float rms = calculate_rms(audio);
+    float rms = calculate_rms(samples, count);
+    last_rms_ = rms;
     bool is_voice = rms > config_.energy_threshold;
 
     // Calculate frame duration in milliseconds
-    float frame_duration_ms = static_cast<float>(audio.size()) * 1000.0f / static_cast<float>(sample_rate);
+    float frame_duration_ms = static_cast<float>(count) * 1000.0f / static_cast<float>(sample_rate);
 
     Event result = Event::None;
 
@@ -79,6 +145,9 @@ SimpleVAD::Event SimpleVAD::process(const std::vector<float>& audio, int sample_
             } else {
                 // Hangover exhausted, start counting silence
                 silence_frames_++;
+                if (silence_frames_ == 1) {
+                    result = Event::SpeechEnding;
+                }
 
                 float silence_duration_ms = silence_frames_ * frame_duration_ms;
                 if (silence_duration_ms >= config_.min_silence_ms) {
@@ -104,6 +173,7 @@ void SimpleVAD::reset() {
     silence_frames_ = 0;
     onset_counter_ = 0;
     hangover_counter_ = 0;
+    last_rms_ = 0.0f;
 }
 
 } // namespace lemon
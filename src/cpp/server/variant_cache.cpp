@@ -0,0 +1,238 @@
+#include "lemon/variant_cache.h"
+
+#include <fstream>
+#include <system_error>
+#include <vector>
+
+#include "lemon/utils/aixlog.hpp"
+#include "lemon/utils/path_utils.h"
+
+namespace fs = std::filesystem;
+
+namespace lemon {
+
+namespace {
+
+// Only entries the user looked at recently are worth refreshing or keeping.
+constexpr std::int64_t kViewWindowSeconds = 7 * 24 * 3600;
+constexpr std::int64_t kRetentionSeconds = 30 * 24 * 3600;
+constexpr auto kFirstCycleDelay = std::chrono::minutes(1);
+constexpr auto kCycleInterval = std::chrono::minutes(10);
+
+std::int64_t now_seconds() {
+    return std::chrono::duration_cast<std::chrono::seconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+}
+
+}  // namespace
+
+VariantCache::VariantCache(const fs::path& manifest_path)
+    : manifest_path_(manifest_path) {}
+
+VariantCache::~VariantCache() {
+    stop_prefetch();
+}
+
+std::string VariantCache::key_for(const std::string& source, const std::string& checkpoint) {
+    return source + ":" + checkpoint;
+}
+
+void VariantCache::load_locked() {
+    if (loaded_) {
+        return;
+    }
+    loaded_ = true;
+
+    std::ifstream file(manifest_path_);
+    if (!file.is_open()) {
+        return;
+    }
+    try {
+        const auto manifest = nlohmann::json::parse(file);
+        const auto json_entries = manifest.value("entries", nlohmann::json::object());
+        for (const auto& [key, entry] : json_entries.items()) {
+            if (entry.contains("fetched_at") && entry.contains("viewed_at") &&
+                entry.contains("body")) {
+                entries_[key] = {entry["fetched_at"].get<std::int64_t>(),
+                                 entry["viewed_at"].get<std::int64_t>(),
+                                 entry["body"]};
+            }
+        }
+    } catch (const std::exception& e) {
+        LOG(WARNING, "VariantCache") << "Discarding unreadable variant cache "
+                                     << lemon::utils::path_to_utf8(manifest_path_)
+                                     << ": " << e.what() << std::endl;
+        entries_.clear();
+        dirty_ = true;
+    }
+}
+
+std::optional<nlohmann::json> VariantCache::lookup(const std::string& source,
+                                                   const std::string& checkpoint,
+                                                   std::chrono::seconds ttl,
+                                                   bool allow_stale) {
+    const std::int64_t now = now_seconds();
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    load_locked();
+    auto it = entries_.find(key_for(source, checkpoint));
+    if (it == entries_.end()) {
+        return std::nullopt;
+    }
+    it->second.viewed_at = now;
+    dirty_ = true;
+    if (!allow_stale && now - it->second.fetched_at > ttl.count()) {
+        return std::nullopt;
+    }
+    return it->second.body;
+}
+
+void VariantCache::store(const std::string& source, const std::string& checkpoint,
+                         const nlohmann::json& body) {
+    const std::int64_t now = now_seconds();
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    load_locked();
+    auto& entry = entries_[key_for(source, checkpoint)];
+    entry.fetched_at = now;
+    if (entry.viewed_at == 0) {
+        entry.viewed_at = now;
+    }
+    entry.body = body;
+    dirty_ = true;
+    save_locked();
+}
+
+void VariantCache::erase(const std::string& source, const std::string& checkpoint) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    load_locked();
+    if (entries_.erase(key_for(source, checkpoint)) > 0) {
+        dirty_ = true;
+        save_locked();
+    }
+}
+
+void VariantCache::start_prefetch(Fetcher fetcher,
+                                  std::function<std::chrono::seconds()> ttl_provider) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (prefetch_thread_.joinable()) {
+        return;
+    }
+    fetcher_ = std::move(fetcher);
+    ttl_provider_ = std::move(ttl_provider);
+    stop_requested_ = false;
+    prefetch_thread_ = std::thread([this]() { prefetch_loop(); });
+}
+
+void VariantCache::stop_prefetch() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stop_requested_ = true;
+    }
+    cv_.notify_all();
+    if (prefetch_thread_.joinable()) {
+        prefetch_thread_.join();
+    }
+}
+
+void VariantCache::prefetch_loop() {
+    auto wait = kFirstCycleDelay;
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            cv_.wait_for(lock, wait, [this]() { return stop_requested_; });
+            if (stop_requested_) {
+                return;
+            }
+        }
+        wait = kCycleInterval;
+
+        const auto ttl = ttl_provider_ ? ttl_provider_() : std::chrono::seconds(0);
+        if (ttl.count() <= 0) {
+            continue;
+        }
+
+        const std::int64_t now = now_seconds();
+        std::vector<std::string> stale;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            load_locked();
+            for (const auto& [key, entry] : entries_) {
+                if (now - entry.viewed_at <= kViewWindowSeconds &&
+                    now - entry.fetched_at > ttl.count()) {
+                    stale.push_back(key);
+                }
+            }
+        }
+
+        for (const auto& key : stale) {
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                if (stop_requested_) {
+                    return;
+                }
+            }
+            const size_t colon = key.find(':');
+            if (colon == std::string::npos) {
+                continue;
+            }
+            const std::string source = key.substr(0, colon);
+            const std::string checkpoint = key.substr(colon + 1);
+            try {
+                bool not_found = false;
+                auto body = fetcher_(checkpoint, source, not_found);
+                if (not_found) {
+                    erase(source, checkpoint);
+                } else {
+                    store(source, checkpoint, body);
+                }
+            } catch (const std::exception& e) {
+                LOG(DEBUG, "VariantCache") << "Prefetch of " << key
+                                           << " failed: " << e.what() << std::endl;
+            }
+        }
+    }
+}
+
+void VariantCache::save() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    save_locked();
+}
+
+void VariantCache::save_locked() {
+    if (!loaded_ || !dirty_) {
+        return;
+    }
+
+    const std::int64_t now = now_seconds();
+    for (auto it = entries_.begin(); it != entries_.end();) {
+        if (now - it->second.viewed_at > kRetentionSeconds) {
+            it = entries_.erase(it);
+        } else {
+            ++it;
+        }
+    }
+
+    nlohmann::json manifest;
+    manifest["version"] = 1;
+    auto& json_entries = manifest["entries"] = nlohmann::json::object();
+    for (const auto& [key, entry] : entries_) {
+        json_entries[key] = {{"fetched_at", entry.fetched_at},
+                             {"viewed_at", entry.viewed_at},
+                             {"body", entry.body}};
+    }
+
+    std::error_code ec;
+    fs::create_directories(manifest_path_.parent_path(), ec);
+    std::ofstream file(manifest_path_, std::ios::trunc);
+    if (!file.is_open()) {
+        LOG(WARNING, "VariantCache") << "Failed to write variant cache "
+                                     << lemon::utils::path_to_utf8(manifest_path_)
+                                     << std::endl;
+        return;
+    }
+    file << manifest.dump(2);
+    dirty_ = false;
+}
+
+}  // namespace lemon
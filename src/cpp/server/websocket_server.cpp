@@ -126,7 +126,11 @@ int WebSocketServer::ws_callback(struct lws* wsi,
                 if (state_it == server->connection_states_.end()) {
                     break;
                 }
-                server->receive_buffers_[conn_id].append(static_cast<const char*>(in), len);
+                auto& buffer = server->receive_buffers_[conn_id];
+                if (buffer.empty()) {
+                    pss->binary_frame = lws_frame_is_binary(wsi) != 0;
+                }
+                buffer.append(static_cast<const char*>(in), len);
             }
 
             if (lws_remaining_packet_payload(wsi) == 0 && lws_is_final_fragment(wsi)) {
@@ -136,7 +140,11 @@ int WebSocketServer::ws_callback(struct lws* wsi,
                     complete_msg = std::move(server->receive_buffers_[conn_id]);
                     server->receive_buffers_[conn_id].clear();
                 }
-                server->handle_message(conn_id, complete_msg);
+                if (pss->binary_frame) {
+                    server->handle_binary_message(conn_id, complete_msg);
+                } else {
+                    server->handle_message(conn_id, complete_msg);
+                }
             }
             break;
         }
@@ -426,17 +434,16 @@ void WebSocketServer::handle_realtime_connection(
 }
 
 void WebSocketServer::handle_log_subscribe(const std::string& connection_id,
-                                           std::optional<uint64_t> after_seq) {
+                                           std::optional<uint64_t> after_seq,
+                                           LogStreamFilter filter) {
     std::vector<LogStreamEntry> snapshot_entries;
     const std::string subscriber_id = LogStreamHub::instance().subscribe_with_snapshot(
-        [this, connection_id](const LogStreamEntry& entry) {
-            send_json(connection_id, {
-                {"type", "logs.entry"},
-                {"entry", entry.to_json()},
-            });
+        [this, connection_id](const std::vector<LogStreamEntry>& entries) {
+            send_log_entries(connection_id, entries);
         },
         after_seq,
-        snapshot_entries);
+        snapshot_entries,
+        std::move(filter));
 
     {
         std::lock_guard<std::mutex> lock(connections_mutex_);
@@ -445,6 +452,15 @@ void WebSocketServer::handle_log_subscribe(const std::string& connection_id,
         state.log_subscriber_id = subscriber_id;
     }
 
+    if (is_binary_transport(connection_id)) {
+        std::string frame;
+        for (const auto& entry : snapshot_entries) {
+            append_length_prefixed(frame, entry.to_json().dump());
+        }
+        send_binary(connection_id, std::move(frame));
+        return;
+    }
+
     json entries_json = json::array();
     for (const auto& entry : snapshot_entries) {
         entries_json.push_back(entry.to_json());
@@ -456,6 +472,32 @@ void WebSocketServer::handle_log_subscribe(const std::string& connection_id,
     });
 }
 
+void WebSocketServer::send_log_entries(const std::string& connection_id,
+                                       const std::vector<LogStreamEntry>& entries) {
+    if (entries.empty()) {
+        return;
+    }
+
+    if (is_binary_transport(connection_id)) {
+        std::string frame;
+        for (const auto& entry : entries) {
+            append_length_prefixed(frame, entry.to_json().dump());
+        }
+        send_binary(connection_id, std::move(frame));
+        return;
+    }
+
+    json entries_json = json::array();
+    for (const auto& entry : entries) {
+        entries_json.push_back(entry.to_json());
+    }
+
+    send_json(connection_id, {
+        {"type", "logs.batch"},
+        {"entries", entries_json},
+    });
+}
+
 void WebSocketServer::handle_message(const std::string& connection_id, const std::string& msg) {
     ConnectionKind kind;
     std::string session_id;
@@ -568,13 +610,50 @@ void WebSocketServer::handle_message(const std::string& connection_id, const std
         return;
     }
 
+    if (msg_type == "transport.binary") {
+        const bool enabled = request.value("enabled", true);
+        {
+            std::lock_guard<std::mutex> lock(connections_mutex_);
+            auto state_it = connection_states_.find(connection_id);
+            if (state_it != connection_states_.end()) {
+                state_it->second.binary_transport = enabled;
+            }
+        }
+        send_json(connection_id, {{"type", "transport.binary.ok"}, {"enabled", enabled}});
+        return;
+    }
+
     if (kind == ConnectionKind::logs) {
         if (msg_type == "logs.subscribe") {
             std::optional<uint64_t> after_seq;
             if (request.contains("after_seq") && !request["after_seq"].is_null()) {
                 after_seq = request["after_seq"].get<uint64_t>();
             }
-            handle_log_subscribe(connection_id, after_seq);
+
+            LogStreamFilter filter;
+            const std::string level = request.value("level", "");
+            if (!level.empty()) {
+                filter.min_severity = AixLog::to_severity(level);
+            }
+            const std::string tag = request.value("tag", "");
+            if (!tag.empty()) {
+                filter.tag = tag;
+            }
+            const std::string pattern = request.value("pattern", "");
+            if (!pattern.empty()) {
+                try {
+                    filter.pattern = std::regex(
+                        pattern, std::regex::ECMAScript | std::regex::optimize);
+                } catch (const std::regex_error&) {
+                    send_json(connection_id, {
+                        {"type", "error"},
+                        {"error", {{"message", "Invalid pattern regex"}, {"type", "invalid_request_error"}}},
+                    });
+                    return;
+                }
+            }
+
+            handle_log_subscribe(connection_id, after_seq, std::move(filter));
         } else {
             send_json(connection_id, {
                 {"type", "error"},
@@ -603,6 +682,35 @@ void WebSocketServer::handle_message(const std::string& connection_id, const std
     }
 }
 
+void WebSocketServer::handle_binary_message(const std::string& connection_id, const std::string& msg) {
+    ConnectionKind kind;
+    std::string session_id;
+    bool accepted = false;
+
+    {
+        std::lock_guard<std::mutex> lock(connections_mutex_);
+        auto it = connection_states_.find(connection_id);
+        if (it == connection_states_.end()) {
+            return;
+        }
+        kind = it->second.kind;
+        session_id = it->second.realtime_session_id;
+        accepted = it->second.authenticated && it->second.binary_transport;
+    }
+
+    if (!accepted || kind != ConnectionKind::realtime || session_id.empty()) {
+        send_json(connection_id, {
+            {"type", "error"},
+            {"error", {{"message", "Binary frames require an authenticated realtime connection "
+                                   "with transport.binary enabled"},
+                       {"type", "invalid_request_error"}}},
+        });
+        return;
+    }
+
+    session_manager_->append_audio_raw(session_id, msg);
+}
+
 void WebSocketServer::handle_close(const std::string& connection_id) {
     ConnectionState state;
 
@@ -630,7 +738,7 @@ void WebSocketServer::handle_close(const std::string& connection_id) {
 }
 
 void WebSocketServer::handle_writable(const std::string& connection_id, struct lws* wsi) {
-    std::string msg;
+    OutboundMessage out;
     bool has_more = false;
 
     {
@@ -639,15 +747,17 @@ void WebSocketServer::handle_writable(const std::string& connection_id, struct l
         if (it == message_queues_.end() || it->second.empty()) {
             return;
         }
-        msg = std::move(it->second.front());
+        out = std::move(it->second.front());
         it->second.pop();
         has_more = !it->second.empty();
     }
 
+    const std::string& msg = out.payload;
     std::vector<unsigned char> buf(LWS_PRE + msg.size());
     std::memcpy(&buf[LWS_PRE], msg.data(), msg.size());
 
-    int written = lws_write(wsi, &buf[LWS_PRE], msg.size(), LWS_WRITE_TEXT);
+    int written = lws_write(wsi, &buf[LWS_PRE], msg.size(),
+                            out.binary ? LWS_WRITE_BINARY : LWS_WRITE_TEXT);
     if (written < static_cast<int>(msg.size())) {
         LOG(ERROR, "WebSocket") << "Error writing to connection " << connection_id << std::endl;
         return;
@@ -749,7 +859,7 @@ void WebSocketServer::send_json(const std::string& connection_id, const json& ms
         std::lock_guard<std::mutex> lock(connections_mutex_);
         auto it = connection_websockets_.find(connection_id);
         if (it != connection_websockets_.end() && it->second != nullptr) {
-            message_queues_[connection_id].push(std::move(payload));
+            message_queues_[connection_id].push({std::move(payload), false});
             writable_dispatch_pending_.store(true);
         }
     } catch (const std::exception& e) {
@@ -765,6 +875,39 @@ void WebSocketServer::send_json(const std::string& connection_id, const json& ms
     }
 }
 
+void WebSocketServer::send_binary(const std::string& connection_id, std::string payload) {
+    {
+        std::lock_guard<std::mutex> lock(connections_mutex_);
+        auto it = connection_websockets_.find(connection_id);
+        if (it != connection_websockets_.end() && it->second != nullptr) {
+            message_queues_[connection_id].push({std::move(payload), true});
+            writable_dispatch_pending_.store(true);
+        }
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(context_mutex_);
+        if (context_) {
+            lws_cancel_service(context_);
+        }
+    }
+}
+
+void WebSocketServer::append_length_prefixed(std::string& frame, const std::string& record) {
+    const uint32_t len = static_cast<uint32_t>(record.size());
+    frame.push_back(static_cast<char>(len & 0xff));
+    frame.push_back(static_cast<char>((len >> 8) & 0xff));
+    frame.push_back(static_cast<char>((len >> 16) & 0xff));
+    frame.push_back(static_cast<char>((len >> 24) & 0xff));
+    frame.append(record);
+}
+
+bool WebSocketServer::is_binary_transport(const std::string& connection_id) {
+    std::lock_guard<std::mutex> lock(connections_mutex_);
+    auto it = connection_states_.find(connection_id);
+    return it != connection_states_.end() && it->second.binary_transport;
+}
+
 void WebSocketServer::schedule_pending_writes() {
     if (!writable_dispatch_pending_.exchange(false)) {
         return;
@@ -871,7 +1014,7 @@ void WebSocketServer::broadcast_span(const json& span) {
                     std::string payload = filtered_span.dump(-1, ' ', false, json::error_handler_t::replace);
                     auto it = connection_websockets_.find(conn_id);
                     if (it != connection_websockets_.end() && it->second != nullptr) {
-                        message_queues_[conn_id].push(std::move(payload));
+                        message_queues_[conn_id].push({std::move(payload), false});
                         writable_dispatch_pending_.store(true);
                     }
                 } catch (const std::exception& e) {
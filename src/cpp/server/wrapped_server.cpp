@@ -3,6 +3,7 @@
 #include <lemon/utils/http_client.h>
 #include <lemon/streaming_proxy.h>
 #include <lemon/error_types.h>
+#include "telemetry.h"
 #include <httplib.h>
 #include <algorithm>
 #include <cctype>
@@ -88,6 +89,16 @@ bool is_backend_connection_failure(const std::string& message) {
            lowered.find("stream before done") != std::string::npos;
 }
 
+// A request that exhausted its operation-class timeout budget means the
+// backend is wedged, not just this request: treat it like a watchdog trip so
+// subsequent requests fail fast while the backend resets.
+bool is_backend_timeout(const std::string& message) {
+    const std::string lowered = lower_copy(message);
+    return lowered.find("timeout was reached") != std::string::npos ||
+           lowered.find("timed out") != std::string::npos ||
+           lowered.find("(idle timeout)") != std::string::npos;
+}
+
 bool is_context_window_error(const std::string& message) {
     const std::string lowered = lower_copy(message);
     return lowered.find("exceeds the available context size") != std::string::npos ||
@@ -178,8 +189,73 @@ ProcessHandle WrappedServer::get_process_handle_snapshot() const {
 }
 
 void WrappedServer::set_process_handle(ProcessHandle handle) {
-    std::lock_guard<std::mutex> lock(process_mutex_);
-    process_handle_ = handle;
+    {
+        std::lock_guard<std::mutex> lock(process_mutex_);
+        process_handle_ = handle;
+    }
+    if (has_process_handle(handle)) {
+        load_profile_mark("prepare_and_spawn");
+    }
+}
+
+void WrappedServer::load_profile_begin() {
+    std::lock_guard<std::mutex> lock(load_profile_mutex_);
+    load_phases_.clear();
+    load_profile_last_ = std::chrono::steady_clock::now();
+    load_profiling_ = true;
+}
+
+void WrappedServer::load_profile_mark(const std::string& phase) {
+    std::lock_guard<std::mutex> lock(load_profile_mutex_);
+    if (!load_profiling_) return;
+    for (const auto& recorded : load_phases_) {
+        if (recorded.first == phase) return;
+    }
+    const auto now = std::chrono::steady_clock::now();
+    const double elapsed_ms =
+        std::chrono::duration_cast<std::chrono::duration<double, std::milli>>(
+            now - load_profile_last_)
+            .count();
+    load_phases_.emplace_back(phase, elapsed_ms);
+    load_profile_last_ = now;
+}
+
+json WrappedServer::get_load_profile() const {
+    std::lock_guard<std::mutex> lock(load_profile_mutex_);
+    json phases = json::object();
+    for (const auto& phase : load_phases_) {
+        phases[phase.first] = phase.second;
+    }
+    return phases;
+}
+
+bool WrappedServer::run_warmup() {
+    switch (get_model_type()) {
+        case ModelType::LLM:
+            completion({{"prompt", "Hi"}, {"max_tokens", 1}, {"stream", false}});
+            return true;
+        case ModelType::EMBEDDING:
+            if (auto* embedder = dynamic_cast<IEmbeddingsServer*>(this)) {
+                embedder->embeddings({{"input", "Hi"}});
+                return true;
+            }
+            return false;
+        case ModelType::RERANKING:
+            if (auto* reranker = dynamic_cast<IRerankingServer*>(this)) {
+                reranker->reranking({{"query", "Hi"}, {"documents", json::array({"Hi"})}});
+                return true;
+            }
+            return false;
+        case ModelType::IMAGE:
+            if (auto* imager = dynamic_cast<IImageServer*>(this)) {
+                imager->image_generations(
+                    {{"prompt", "warmup"}, {"steps", 1}, {"width", 64}, {"height", 64}});
+                return true;
+            }
+            return false;
+        default:
+            return false;
+    }
 }
 
 int WrappedServer::get_backend_port() const {
@@ -195,10 +271,20 @@ ProcessHandle WrappedServer::consume_process_handle_for_cleanup() {
     return handle;
 }
 
+void WrappedServer::detach_process_for_handover() {
+    consume_process_handle_for_cleanup();
+}
+
 bool WrappedServer::is_backend_alive() const {
     if (watchdog_triggered_.load(std::memory_order_acquire)) {
         return false;
     }
+    // A hibernated model has intentionally no process; it is still a live
+    // resident from the router's point of view and resumes on next use.
+    const ModelState state = get_state();
+    if (state == ModelState::HIBERNATING || state == ModelState::HIBERNATED) {
+        return true;
+    }
     const ProcessHandle handle = get_process_handle_snapshot();
     return has_process_handle(handle) && utils::ProcessManager::is_running(handle);
 }
@@ -207,6 +293,10 @@ std::string WrappedServer::get_backend_health_state() const {
     if (watchdog_triggered_.load(std::memory_order_acquire)) {
         return "watchdog_reset";
     }
+    const ModelState state = get_state();
+    if (state == ModelState::HIBERNATING || state == ModelState::HIBERNATED) {
+        return "hibernated";
+    }
     const ProcessHandle handle = get_process_handle_snapshot();
     if (!has_process_handle(handle)) {
         return "stopped";
@@ -244,11 +334,8 @@ json WrappedServer::create_watchdog_reset_response() const {
 }
 
 void WrappedServer::note_backend_activity() {
-    {
-        std::lock_guard<std::mutex> lock(watchdog_mutex_);
-        last_backend_activity_ = std::chrono::steady_clock::now();
-    }
-    watchdog_cv_.notify_all();
+    std::lock_guard<std::mutex> lock(watchdog_mutex_);
+    last_backend_activity_ = std::chrono::steady_clock::now();
 }
 
 void WrappedServer::begin_backend_request(BackendRequestKind kind) {
@@ -281,8 +368,6 @@ void WrappedServer::end_backend_request(BackendRequestKind kind) {
             active_non_streaming_requests_.store(0, std::memory_order_release);
         }
     }
-
-    watchdog_cv_.notify_all();
 }
 
 void WrappedServer::set_watchdog_health_endpoint(const std::string& endpoint) {
@@ -318,15 +403,23 @@ void WrappedServer::start_backend_watchdog(const BackendWatchdogPolicy& policy)
 
     bool expected = false;
     if (!watchdog_running_.compare_exchange_strong(expected, true, std::memory_order_acq_rel)) {
-        // Idempotent start: keep the existing thread and just publish the new
-        // policy. Do not reset active counters or watchdog state while requests
-        // may already be in flight.
-        watchdog_cv_.notify_all();
+        // Idempotent start: keep the existing timer task and just publish the
+        // new policy. Do not reset active counters or watchdog state while
+        // requests may already be in flight.
         return;
     }
 
+    watchdog_grace_ = std::chrono::seconds(
+        get_env_long("LEMONADE_BACKEND_WATCHDOG_GRACE_SECONDS", 90, 10));
+    watchdog_poll_ = std::chrono::seconds(
+        get_env_long("LEMONADE_BACKEND_WATCHDOG_POLL_SECONDS", 5, 1));
+    watchdog_probe_timeout_s_ = static_cast<int>(
+        get_env_long("LEMONADE_BACKEND_WATCHDOG_PROBE_TIMEOUT_SECONDS", 2, 1));
+    watchdog_max_failures_ = static_cast<int>(
+        get_env_long("LEMONADE_BACKEND_WATCHDOG_MAX_FAILURES", 3, 1));
+    watchdog_consecutive_failures_ = 0;
+
     watchdog_triggered_.store(false, std::memory_order_release);
-    watchdog_stop_requested_.store(false, std::memory_order_release);
     active_backend_requests_.store(0, std::memory_order_release);
     active_streaming_requests_.store(0, std::memory_order_release);
     active_non_streaming_requests_.store(0, std::memory_order_release);
@@ -336,7 +429,10 @@ void WrappedServer::start_backend_watchdog(const BackendWatchdogPolicy& policy)
         last_backend_activity_ = std::chrono::steady_clock::now();
     }
 
-    watchdog_thread_ = std::thread(&WrappedServer::backend_watchdog_loop, this);
+    watchdog_task_ = TimerWheel::shared().schedule_recurring(
+        server_name_ + " watchdog",
+        std::chrono::duration_cast<std::chrono::milliseconds>(watchdog_poll_),
+        [this]() { return backend_watchdog_tick(); });
 
     LOG(INFO, "BackendWatchdog") << "Started watchdog for " << server_name_
                                   << " using " << get_base_url() << effective_policy.health_endpoint
@@ -352,12 +448,10 @@ void WrappedServer::stop_backend_watchdog() {
         return;
     }
 
-    watchdog_stop_requested_.store(true, std::memory_order_release);
-    watchdog_cv_.notify_all();
-
-    if (watchdog_thread_.joinable()) {
-        watchdog_thread_.join();
-    }
+    // Blocks until any in-flight probe tick has returned, matching the old
+    // thread-join semantics so callers can safely tear the backend down.
+    TimerWheel::shared().cancel(watchdog_task_);
+    watchdog_task_ = 0;
 
     watchdog_running_.store(false, std::memory_order_release);
     active_backend_requests_.store(0, std::memory_order_release);
@@ -411,104 +505,88 @@ void WrappedServer::request_backend_reset_from_watchdog(const std::string& reaso
                                       << reason << "; no process handle to reap"
                                       << std::endl;
     }
-
-    watchdog_cv_.notify_all();
 }
 
-void WrappedServer::backend_watchdog_loop() {
-    const auto grace = std::chrono::seconds(
-        get_env_long("LEMONADE_BACKEND_WATCHDOG_GRACE_SECONDS", 90, 10));
-    const auto poll = std::chrono::seconds(
-        get_env_long("LEMONADE_BACKEND_WATCHDOG_POLL_SECONDS", 5, 1));
-    const int probe_timeout_seconds = static_cast<int>(
-        get_env_long("LEMONADE_BACKEND_WATCHDOG_PROBE_TIMEOUT_SECONDS", 2, 1));
-    const int max_failures = static_cast<int>(
-        get_env_long("LEMONADE_BACKEND_WATCHDOG_MAX_FAILURES", 3, 1));
-
-    int consecutive_failures = 0;
+bool WrappedServer::backend_watchdog_tick() {
+    if (watchdog_triggered_.load(std::memory_order_acquire)) {
+        return false;
+    }
 
-    while (!watchdog_stop_requested_.load(std::memory_order_acquire)) {
-        std::unique_lock<std::mutex> lock(watchdog_mutex_);
-        watchdog_cv_.wait_for(lock, poll, [this]() {
-            return watchdog_stop_requested_.load(std::memory_order_acquire);
-        });
+    // Always detect child-process exit/zombie state, even when there is no
+    // active request or when the active request is non-streaming. This is a
+    // cheap process-handle/PID check, not an HTTP /health probe, so long
+    // non-streaming work such as image generation is not killed just because
+    // it takes a long time. If the backend has crashed, mark it unavailable
+    // so the router can lazily reload/retry recoverable calls.
+    if (has_backend_process_exited()) {
+        request_backend_reset_from_watchdog("backend process exited while watchdog was active");
+        return false;
+    }
 
-        if (watchdog_stop_requested_.load(std::memory_order_acquire) ||
-            watchdog_triggered_.load(std::memory_order_acquire)) {
-            break;
-        }
+    const int active = active_backend_requests_.load(std::memory_order_acquire);
+    if (active <= 0) {
+        watchdog_consecutive_failures_ = 0;
+        return true;
+    }
 
-        // Always detect child-process exit/zombie state, even when there is no
-        // active request or when the active request is non-streaming. This is a
-        // cheap process-handle/PID check, not an HTTP /health probe, so long
-        // non-streaming work such as image generation is not killed just because
-        // it takes a long time. If the backend has crashed, mark it unavailable
-        // so the router can lazily reload/retry recoverable calls.
-        if (has_backend_process_exited()) {
-            lock.unlock();
-            request_backend_reset_from_watchdog("backend process exited while watchdog was active");
-            break;
-        }
+    BackendWatchdogPolicy policy;
+    std::chrono::steady_clock::time_point last_activity;
+    {
+        std::lock_guard<std::mutex> lock(watchdog_mutex_);
+        policy = watchdog_policy_;
+        last_activity = last_backend_activity_;
+    }
 
-        const int active = active_backend_requests_.load(std::memory_order_acquire);
-        if (active <= 0) {
-            consecutive_failures = 0;
-            continue;
-        }
+    const bool has_streaming = active_streaming_requests_.load(std::memory_order_acquire) > 0;
+    const bool has_non_streaming = active_non_streaming_requests_.load(std::memory_order_acquire) > 0;
+    const bool should_monitor =
+        (has_streaming && policy.monitor_streaming_requests) ||
+        has_non_streaming;
 
-        const BackendWatchdogPolicy policy = watchdog_policy_;
-        const bool has_streaming = active_streaming_requests_.load(std::memory_order_acquire) > 0;
-        const bool has_non_streaming = active_non_streaming_requests_.load(std::memory_order_acquire) > 0;
-        const bool should_monitor =
-            (has_streaming && policy.monitor_streaming_requests) ||
-            has_non_streaming;
+    if (!policy.enabled || policy.health_endpoint.empty() || !should_monitor) {
+        watchdog_consecutive_failures_ = 0;
+        return true;
+    }
 
-        if (!policy.enabled || policy.health_endpoint.empty() || !should_monitor) {
-            consecutive_failures = 0;
-            continue;
-        }
+    const auto idle_for = std::chrono::steady_clock::now() - last_activity;
+    if (idle_for < watchdog_grace_) {
+        watchdog_consecutive_failures_ = 0;
+        return true;
+    }
 
-        const auto last_activity = last_backend_activity_;
-        const auto idle_for = std::chrono::steady_clock::now() - last_activity;
-        if (idle_for < grace) {
-            consecutive_failures = 0;
-            continue;
-        }
+    const std::string health_url = get_base_url() + policy.health_endpoint;
 
-        const std::string health_url = get_base_url() + policy.health_endpoint;
-        lock.unlock();
+    const ProcessHandle handle = get_process_handle_snapshot();
+    if (!has_process_handle(handle) || !utils::ProcessManager::is_running(handle)) {
+        request_backend_reset_from_watchdog("backend process exited during an active request");
+        return false;
+    }
 
-        const ProcessHandle handle = get_process_handle_snapshot();
-        if (!has_process_handle(handle) || !utils::ProcessManager::is_running(handle)) {
-            request_backend_reset_from_watchdog("backend process exited during an active request");
-            break;
-        }
+    const bool reachable = utils::HttpClient::is_reachable(
+        health_url,
+        watchdog_probe_timeout_s_,
+        utils::HttpSecurityPolicy::TrustedLoopback);
+    if (reachable) {
+        watchdog_consecutive_failures_ = 0;
+        note_backend_activity();
+        return true;
+    }
 
-        const bool reachable = utils::HttpClient::is_reachable(
-            health_url,
-            probe_timeout_seconds,
-            utils::HttpSecurityPolicy::TrustedLoopback);
-        if (reachable) {
-            consecutive_failures = 0;
-            note_backend_activity();
-            continue;
-        }
+    ++watchdog_consecutive_failures_;
+    LOG(WARNING, "BackendWatchdog") << server_name_ << " health probe failed "
+                                     << watchdog_consecutive_failures_ << "/" << watchdog_max_failures_
+                                     << " after "
+                                     << std::chrono::duration_cast<std::chrono::seconds>(idle_for).count()
+                                     << "s without observable progress"
+                                     << std::endl;
 
-        ++consecutive_failures;
-        LOG(WARNING, "BackendWatchdog") << server_name_ << " health probe failed "
-                                         << consecutive_failures << "/" << max_failures
-                                         << " after "
-                                         << std::chrono::duration_cast<std::chrono::seconds>(idle_for).count()
-                                         << "s without observable progress"
-                                         << std::endl;
-
-        if (consecutive_failures >= max_failures) {
-            request_backend_reset_from_watchdog(
-                "health endpoint did not respond after " + std::to_string(max_failures) +
-                " consecutive probes while a request was active");
-            break;
-        }
+    if (watchdog_consecutive_failures_ >= watchdog_max_failures_) {
+        request_backend_reset_from_watchdog(
+            "health endpoint did not respond after " + std::to_string(watchdog_max_failures_) +
+            " consecutive probes while a request was active");
+        return false;
     }
+    return true;
 }
 
 int WrappedServer::choose_port() {
@@ -568,6 +646,7 @@ bool WrappedServer::wait_for_ready(const std::string& endpoint, long timeout_sec
         if (utils::HttpClient::is_reachable(
                 health_url, 1, utils::HttpSecurityPolicy::TrustedLoopback)) {
             LOG(INFO, "WrappedServer") << server_name_ + " is ready!" << std::endl;
+            load_profile_mark("health_poll");
             start_backend_watchdog(normalized_endpoint);
             return true;
         }
@@ -651,11 +730,25 @@ json WrappedServer::forward_request(const std::string& endpoint, const json& req
 
     std::string url = get_base_url() + endpoint;
     std::map<std::string, std::string> headers = {{"Content-Type", "application/json"}};
+    const std::string traceparent = telemetry::current_traceparent();
+    if (!traceparent.empty()) {
+        headers["traceparent"] = traceparent;
+    }
+
+    // Lemonade-level slot pinning hint; backends that honor it (llama.cpp)
+    // consume it before forwarding, everything else must never see it.
+    json sanitized;
+    const json* payload = &request;
+    if (request.is_object() && request.contains("session_id")) {
+        sanitized = request;
+        sanitized.erase("session_id");
+        payload = &sanitized;
+    }
 
     try {
         auto response = utils::HttpClient::post(
             url,
-            request.dump(),
+            payload->dump(),
             headers,
             timeout_seconds,
             utils::HttpSecurityPolicy::TrustedLoopback,
@@ -680,11 +773,17 @@ json WrappedServer::forward_request(const std::string& endpoint, const json& req
             );
         }
     } catch (const std::exception& e) {
-        if (was_watchdog_triggered() || has_backend_process_exited() || is_backend_connection_failure(e.what())) {
+        if (was_watchdog_triggered() || has_backend_process_exited() ||
+            is_backend_connection_failure(e.what()) || is_backend_timeout(e.what())) {
             if (!was_watchdog_triggered()) {
-                const std::string reset_reason = has_backend_process_exited()
-                    ? "backend process exited during request"
-                    : "backend connection failed during request: " + std::string(e.what());
+                std::string reset_reason;
+                if (has_backend_process_exited()) {
+                    reset_reason = "backend process exited during request";
+                } else if (is_backend_timeout(e.what())) {
+                    reset_reason = "backend request exceeded its timeout budget: " + std::string(e.what());
+                } else {
+                    reset_reason = "backend connection failed during request: " + std::string(e.what());
+                }
                 request_backend_reset_from_watchdog(reset_reason);
             }
             return create_watchdog_reset_response();
@@ -777,6 +876,16 @@ void WrappedServer::forward_streaming_request(const std::string& endpoint,
     BackendRequestScope request_scope(*this, BackendRequestKind::Streaming);
 
     std::string url = get_base_url() + endpoint;
+    std::string sanitized_body;
+    const std::string* body = &request_body;
+    if (request_body.find("\"session_id\"") != std::string::npos) {
+        json request = json::parse(request_body, nullptr, false);
+        if (request.is_object() && request.contains("session_id")) {
+            request.erase("session_id");
+            sanitized_body = request.dump();
+            body = &sanitized_body;
+        }
+    }
     bool streamed_any_bytes = false;
     auto mark_stream_progress = [this, &streamed_any_bytes]() {
         if (!streamed_any_bytes) {
@@ -791,7 +900,7 @@ void WrappedServer::forward_streaming_request(const std::string& endpoint,
         if (sse) {
             // Use StreamingProxy to forward the SSE stream with telemetry callback
             // Use INFERENCE_TIMEOUT_SECONDS (0 = infinite) as chat completions can take a long time
-            StreamingProxy::forward_sse_stream(url, request_body, sink,
+            StreamingProxy::forward_sse_stream(url, *body, sink,
                 [telemetry_callback](const StreamingProxy::TelemetryData& telemetry) {
                     if (telemetry_callback) {
                         telemetry_callback(telemetry.input_tokens,
@@ -802,10 +911,11 @@ void WrappedServer::forward_streaming_request(const std::string& endpoint,
                     }
                 },
                 timeout_seconds,
-                mark_stream_progress
+                mark_stream_progress,
+                operation_timeout_seconds("chat_idle_timeout")
             );
         } else {
-            StreamingProxy::forward_byte_stream(url, request_body, sink, timeout_seconds,
+            StreamingProxy::forward_byte_stream(url, *body, sink, timeout_seconds,
                 mark_stream_progress
             );
         }
@@ -813,7 +923,9 @@ void WrappedServer::forward_streaming_request(const std::string& endpoint,
         // Log the error but don't crash the server
         LOG(ERROR, "WrappedServer") << "Streaming request failed: " << e.what() << std::endl;
 
-        bool will_retry = (was_watchdog_triggered() || has_backend_process_exited() || is_backend_connection_failure(e.what())) && !streamed_any_bytes;
+        bool will_retry = (was_watchdog_triggered() || has_backend_process_exited() ||
+                           is_backend_connection_failure(e.what()) || is_backend_timeout(e.what())) &&
+                          !streamed_any_bytes;
 
         if (telemetry_callback && !will_retry) {
             telemetry_callback(0, 0, 0.0, 0.0, e.what());
@@ -822,11 +934,17 @@ void WrappedServer::forward_streaming_request(const std::string& endpoint,
         // Try to send error to client if possible
         try {
             json error;
-            if (was_watchdog_triggered() || has_backend_process_exited() || is_backend_connection_failure(e.what())) {
+            if (was_watchdog_triggered() || has_backend_process_exited() ||
+                is_backend_connection_failure(e.what()) || is_backend_timeout(e.what())) {
                 if (!was_watchdog_triggered()) {
-                    const std::string reset_reason = has_backend_process_exited()
-                        ? "backend process exited during streaming request"
-                        : "backend connection failed during streaming request: " + std::string(e.what());
+                    std::string reset_reason;
+                    if (has_backend_process_exited()) {
+                        reset_reason = "backend process exited during streaming request";
+                    } else if (is_backend_timeout(e.what())) {
+                        reset_reason = "backend stream exceeded its idle timeout budget: " + std::string(e.what());
+                    } else {
+                        reset_reason = "backend connection failed during streaming request: " + std::string(e.what());
+                    }
                     request_backend_reset_from_watchdog(reset_reason);
                 }
 
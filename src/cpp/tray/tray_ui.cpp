@@ -15,10 +15,13 @@
 #include <winsock2.h>
 #include <windows.h>
 #else
+#include <arpa/inet.h>
 #include <cstdlib>
 #include <fcntl.h>
+#include <netinet/in.h>
 #include <signal.h>
 #include <sys/select.h>
+#include <sys/socket.h>
 #include <sys/wait.h>
 #include <unistd.h>
 #endif
@@ -67,6 +70,11 @@ TrayUI::TrayUI(int port, const std::string& host, bool silent)
 }
 
 TrayUI::~TrayUI() {
+    stop_beacon_listener_ = true;
+    if (beacon_listener_thread_.joinable()) {
+        beacon_listener_thread_.join();
+    }
+
 #ifndef _WIN32
     if (signal_monitor_thread_.joinable()) {
         stop_signal_monitor_ = true;
@@ -118,6 +126,8 @@ bool TrayUI::initialize() {
 }
 
 void TrayUI::run() {
+    start_beacon_listener();
+
 #ifndef _WIN32
     // Background thread to monitor signals and periodically refresh the menu
     signal_monitor_thread_ = std::thread([this]() {
@@ -132,7 +142,11 @@ void TrayUI::run() {
 
             auto now = std::chrono::steady_clock::now();
             if (std::chrono::duration_cast<std::chrono::seconds>(now - last_tick).count() >= 5) {
-                refresh_menu();
+                // While the beacon push channel is live the listener drives
+                // refreshes; the HTTP poll is only the fallback.
+                if (!beacon_is_fresh()) {
+                    refresh_menu();
+                }
                 last_tick = now;
             }
 
@@ -201,6 +215,111 @@ std::string TrayUI::http_post(const std::string& endpoint, const std::string& bo
     return "";
 }
 
+// ---------------------------------------------------------------------------
+// Beacon status listener
+// ---------------------------------------------------------------------------
+
+static long long steady_now_ms() {
+    return std::chrono::duration_cast<std::chrono::milliseconds>(
+               std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+}
+
+bool TrayUI::beacon_is_fresh() const {
+    const long long last = last_beacon_ms_.load();
+    // Cover three missed beacons at the server's advertised (adaptive)
+    // broadcast interval, plus slack.
+    const long long window_ms = beacon_interval_s_.load() * 3000LL + 1000;
+    return last != 0 && steady_now_ms() - last < window_ms;
+}
+
+void TrayUI::start_beacon_listener() {
+    // The beacon only carries loopback-verified status for a same-machine
+    // server; remote servers keep the HTTP polling path.
+    if (get_connect_host() != "127.0.0.1" || beacon_listener_thread_.joinable()) {
+        return;
+    }
+
+    beacon_listener_thread_ = std::thread([this]() {
+#ifdef _WIN32
+        WSADATA wsaData;
+        if (WSAStartup(MAKEWORD(2, 2), &wsaData) != 0) return;
+        SOCKET fd = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+        if (fd == INVALID_SOCKET) {
+            WSACleanup();
+            return;
+        }
+#else
+        int fd = socket(AF_INET, SOCK_DGRAM, 0);
+        if (fd < 0) return;
+#endif
+
+        int reuse_addr = 1;
+        setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, (char*)&reuse_addr, sizeof(reuse_addr));
+
+        sockaddr_in addr{};
+        addr.sin_family = AF_INET;
+        addr.sin_addr.s_addr = INADDR_ANY;
+        addr.sin_port = htons(13305);
+        const bool bound = bind(fd, (sockaddr*)&addr, sizeof(addr)) == 0;
+
+        struct timeval timeout{};
+        timeout.tv_usec = 500000;
+        setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, (char*)&timeout, sizeof(timeout));
+
+        while (bound && !stop_beacon_listener_) {
+            char buffer[2048];
+            sockaddr_in sender{};
+#ifdef _WIN32
+            int sender_size = sizeof(sender);
+#else
+            socklen_t sender_size = sizeof(sender);
+#endif
+            int bytes = recvfrom(fd, buffer, sizeof(buffer) - 1, 0,
+                                 (sockaddr*)&sender, &sender_size);
+            if (bytes <= 0) continue;
+            if (sender.sin_addr.s_addr != htonl(INADDR_LOOPBACK)) continue;
+            buffer[bytes] = '\0';
+
+            try {
+                auto beacon = nlohmann::json::parse(buffer);
+                if (beacon.value("service", "") != "lemonade") continue;
+                if (beacon.value("probe", false)) continue;
+
+                // v2 heartbeats omit the status block when state is
+                // unchanged; they still refresh the push-channel liveness so
+                // the HTTP fallback stays off while cached state is current.
+                const int interval = beacon.value("interval", 0);
+                if (interval > 0) {
+                    beacon_interval_s_.store(std::min(interval, 60));
+                }
+                last_beacon_ms_.store(steady_now_ms());
+                if (!beacon.contains("status")) continue;
+                std::string status = beacon["status"].dump();
+
+                bool changed;
+                {
+                    std::lock_guard<std::mutex> lock(beacon_mutex_);
+                    changed = status != last_beacon_status_;
+                    last_beacon_status_ = std::move(status);
+                }
+                if (changed && !stop_beacon_listener_) {
+                    build_menu();
+                }
+            } catch (const nlohmann::json::exception&) {
+                // Not a valid JSON beacon, ignore
+            }
+        }
+
+#ifdef _WIN32
+        closesocket(fd);
+        WSACleanup();
+#else
+        close(fd);
+#endif
+    });
+}
+
 // ---------------------------------------------------------------------------
 // Data fetchers
 // ---------------------------------------------------------------------------
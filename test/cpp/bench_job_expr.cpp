@@ -0,0 +1,71 @@
+// Job expression microbenchmark: evaluations per second for a compiled
+// expression, the cached eval_condition path, and a forced re-parse on
+// every call, over a context shaped like a data-generation loop step.
+//
+// Build: cmake --build <build-dir> --target lemonade-bench-job-expr
+
+#include "lemon/jobs/job_expr.h"
+
+#include <chrono>
+#include <cstdio>
+
+using namespace lemon::jobs;
+using Clock = std::chrono::steady_clock;
+
+namespace {
+
+template <typename Fn>
+double seconds_for(Fn&& fn) {
+    const auto start = Clock::now();
+    fn();
+    return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+} // namespace
+
+int main() {
+    const size_t iterations = 500000;
+    const char* expr =
+        "${loop.count} < ${loop.limit} && (${gen.output.score} >= 0.5 || ${retries} < 3)";
+    json ctx = {{"loop", {{"count", 0}, {"limit", 1000000}}},
+                {"gen", {{"output", {{"score", 0.73}}}}},
+                {"retries", 1}};
+
+    size_t guard = 0;
+    const auto compiled = CompiledExpr::compile(expr);
+    const double compiled_seconds = seconds_for([&]() {
+        for (size_t i = 0; i < iterations; ++i) {
+            ctx["loop"]["count"] = i;
+            guard += compiled.eval(ctx) ? 1 : 0;
+        }
+    });
+
+    const double cached_seconds = seconds_for([&]() {
+        for (size_t i = 0; i < iterations; ++i) {
+            ctx["loop"]["count"] = i;
+            guard += eval_condition(expr, ctx) ? 1 : 0;
+        }
+    });
+
+    const double reparse_seconds = seconds_for([&]() {
+        for (size_t i = 0; i < iterations; ++i) {
+            ctx["loop"]["count"] = i;
+            guard += CompiledExpr::compile(expr).eval(ctx) ? 1 : 0;
+        }
+    });
+
+    std::printf("{\n");
+    std::printf("  \"iterations\": %zu,\n", iterations);
+    std::printf("  \"compiled_meval_per_s\": %.2f,\n",
+                iterations / compiled_seconds / 1e6);
+    std::printf("  \"cached_meval_per_s\": %.2f,\n",
+                iterations / cached_seconds / 1e6);
+    std::printf("  \"reparse_meval_per_s\": %.2f,\n",
+                iterations / reparse_seconds / 1e6);
+    std::printf("  \"compile_cache_speedup\": %.2f\n",
+                cached_seconds > 0.0 ? reparse_seconds / cached_seconds : 0.0);
+    std::printf("}\n");
+
+    (void)guard;
+    return 0;
+}
@@ -0,0 +1,274 @@
+// Proxy overhead benchmark: a mock backend emits synthetic SSE at a
+// configurable token rate and N concurrent clients stream through
+// StreamingProxy::forward_sse_stream — the same code path lemond uses for
+// chat/completions. Reports per-token added latency, CPU per stream, and
+// peak RSS as JSON for trend tracking.
+//
+// Build: cmake --build <build-dir> --target lemonade-bench-proxy
+// Run:   lemonade-bench-proxy --streams 8 --tokens 256 --token-rate 40
+
+#include "lemon/streaming_proxy.h"
+
+#include <CLI/CLI.hpp>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#ifdef _WIN32
+    // PSAPI_VERSION 2 resolves GetProcessMemoryInfo from kernel32, so no
+    // psapi.lib link dependency.
+    #define PSAPI_VERSION 2
+    #include <windows.h>
+    #include <psapi.h>
+#else
+    #include <sys/resource.h>
+#endif
+
+using json = nlohmann::json;
+using Clock = std::chrono::steady_clock;
+
+namespace {
+
+struct EmitLog {
+    std::mutex mutex;
+    std::map<int, std::vector<Clock::time_point>> by_stream;
+
+    void record(int stream_id, Clock::time_point t) {
+        std::lock_guard<std::mutex> lock(mutex);
+        by_stream[stream_id].push_back(t);
+    }
+};
+
+double process_cpu_seconds() {
+#ifdef _WIN32
+    FILETIME creation, exit, kernel, user;
+    if (!GetProcessTimes(GetCurrentProcess(), &creation, &exit, &kernel, &user)) {
+        return 0.0;
+    }
+    auto to_seconds = [](const FILETIME& ft) {
+        ULARGE_INTEGER v;
+        v.LowPart = ft.dwLowDateTime;
+        v.HighPart = ft.dwHighDateTime;
+        return static_cast<double>(v.QuadPart) * 1e-7;
+    };
+    return to_seconds(kernel) + to_seconds(user);
+#else
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0) {
+        return 0.0;
+    }
+    auto to_seconds = [](const timeval& tv) {
+        return static_cast<double>(tv.tv_sec) + static_cast<double>(tv.tv_usec) * 1e-6;
+    };
+    return to_seconds(usage.ru_utime) + to_seconds(usage.ru_stime);
+#endif
+}
+
+double peak_rss_mb() {
+#ifdef _WIN32
+    PROCESS_MEMORY_COUNTERS counters;
+    if (!GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) {
+        return 0.0;
+    }
+    return static_cast<double>(counters.PeakWorkingSetSize) / (1024.0 * 1024.0);
+#else
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0) {
+        return 0.0;
+    }
+    #ifdef __APPLE__
+    return static_cast<double>(usage.ru_maxrss) / (1024.0 * 1024.0);
+    #else
+    return static_cast<double>(usage.ru_maxrss) / 1024.0;
+    #endif
+#endif
+}
+
+double percentile(std::vector<double> values, double p) {
+    if (values.empty()) return 0.0;
+    std::sort(values.begin(), values.end());
+    const double rank = p * static_cast<double>(values.size() - 1);
+    const size_t lo = static_cast<size_t>(rank);
+    const size_t hi = (std::min)(lo + 1, values.size() - 1);
+    const double frac = rank - static_cast<double>(lo);
+    return values[lo] + (values[hi] - values[lo]) * frac;
+}
+
+void run_mock_backend(httplib::Server& backend, EmitLog& emit_log) {
+    backend.Post("/v1/chat/completions",
+                 [&emit_log](const httplib::Request& req, httplib::Response& res) {
+        const auto body = json::parse(req.body);
+        const int stream_id = body.value("bench_stream_id", 0);
+        const int tokens = body.value("bench_tokens", 64);
+        const double token_rate = body.value("bench_token_rate", 0.0);
+
+        res.set_chunked_content_provider(
+            "text/event-stream",
+            [&emit_log, stream_id, tokens, token_rate](size_t, httplib::DataSink& sink) {
+                const auto start = Clock::now();
+                for (int i = 0; i < tokens; ++i) {
+                    if (token_rate > 0.0) {
+                        std::this_thread::sleep_until(
+                            start + std::chrono::duration_cast<Clock::duration>(
+                                        std::chrono::duration<double>(i / token_rate)));
+                    }
+                    emit_log.record(stream_id, Clock::now());
+                    const std::string chunk =
+                        "data: {\"choices\":[{\"delta\":{\"content\":\"tok\"}}]}\n\n";
+                    if (!sink.write(chunk.data(), chunk.size())) {
+                        return false;
+                    }
+                }
+                const std::string tail =
+                    "data: {\"usage\":{\"prompt_tokens\":8,\"completion_tokens\":" +
+                    std::to_string(tokens) + "}}\n\ndata: [DONE]\n\n";
+                sink.write(tail.data(), tail.size());
+                sink.done();
+                return false;
+            });
+    });
+}
+
+struct StreamResult {
+    std::vector<Clock::time_point> recv_times;
+    double duration_seconds = 0.0;
+};
+
+void run_client_stream(const std::string& url, int stream_id, int tokens,
+                       double token_rate, StreamResult& result) {
+    const json request = {
+        {"model", "bench"},
+        {"stream", true},
+        {"bench_stream_id", stream_id},
+        {"bench_tokens", tokens},
+        {"bench_token_rate", token_rate},
+    };
+
+    std::string line_buffer;
+    httplib::DataSink sink;
+    sink.write = [&result, &line_buffer](const char* data, size_t length) {
+        const auto now = Clock::now();
+        line_buffer.append(data, length);
+        size_t pos = 0;
+        while ((pos = line_buffer.find("data: ")) != std::string::npos) {
+            line_buffer.erase(0, pos + 6);
+            result.recv_times.push_back(now);
+        }
+        return true;
+    };
+    sink.done = []() {};
+    sink.is_writable = []() { return true; };
+
+    const auto start = Clock::now();
+    lemon::StreamingProxy::forward_sse_stream(url, request.dump(), sink);
+    result.duration_seconds = std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    CLI::App app{"lemond proxy overhead benchmark"};
+
+    int streams = 4;
+    int tokens = 256;
+    double token_rate = 40.0;
+    std::string output_path;
+    app.add_option("--streams", streams, "Concurrent client streams");
+    app.add_option("--tokens", tokens, "Tokens emitted per stream");
+    app.add_option("--token-rate", token_rate,
+                   "Backend emission rate in tokens/s per stream (0 = unthrottled)");
+    app.add_option("--output", output_path, "Write the JSON report to a file instead of stdout");
+    CLI11_PARSE(app, argc, argv);
+
+    EmitLog emit_log;
+    httplib::Server backend;
+    run_mock_backend(backend, emit_log);
+    const int port = backend.bind_to_any_port("127.0.0.1");
+    std::thread backend_thread([&backend]() { backend.listen_after_bind(); });
+    backend.wait_until_ready();
+    const std::string url =
+        "http://127.0.0.1:" + std::to_string(port) + "/v1/chat/completions";
+
+    const double cpu_before = process_cpu_seconds();
+    const auto wall_start = Clock::now();
+
+    std::vector<StreamResult> results(static_cast<size_t>(streams));
+    std::vector<std::thread> clients;
+    for (int i = 0; i < streams; ++i) {
+        clients.emplace_back(run_client_stream, url, i, tokens, token_rate,
+                             std::ref(results[static_cast<size_t>(i)]));
+    }
+    for (auto& t : clients) {
+        t.join();
+    }
+
+    const double wall_seconds = std::chrono::duration<double>(Clock::now() - wall_start).count();
+    const double cpu_seconds = process_cpu_seconds() - cpu_before;
+
+    backend.stop();
+    backend_thread.join();
+
+    std::vector<double> latencies_ms;
+    int tokens_received = 0;
+    for (int i = 0; i < streams; ++i) {
+        const auto& recv = results[static_cast<size_t>(i)].recv_times;
+        const auto& emitted = emit_log.by_stream[i];
+        const size_t n = (std::min)(recv.size(), emitted.size());
+        tokens_received += static_cast<int>(recv.size());
+        for (size_t j = 0; j < n; ++j) {
+            latencies_ms.push_back(
+                std::chrono::duration<double, std::milli>(recv[j] - emitted[j]).count());
+        }
+    }
+
+    double latency_sum = 0.0;
+    double latency_max = 0.0;
+    for (double v : latencies_ms) {
+        latency_sum += v;
+        latency_max = (std::max)(latency_max, v);
+    }
+
+    const json report = {
+        {"config", {
+            {"streams", streams},
+            {"tokens_per_stream", tokens},
+            {"token_rate", token_rate},
+        }},
+        {"results", {
+            {"tokens_received", tokens_received},
+            {"added_latency_ms", {
+                {"mean", latencies_ms.empty() ? 0.0 : latency_sum / static_cast<double>(latencies_ms.size())},
+                {"p50", percentile(latencies_ms, 0.50)},
+                {"p95", percentile(latencies_ms, 0.95)},
+                {"max", latency_max},
+            }},
+            {"cpu_seconds_per_stream", streams > 0 ? cpu_seconds / streams : 0.0},
+            {"peak_rss_mb", peak_rss_mb()},
+            {"wall_seconds", wall_seconds},
+        }},
+    };
+
+    const std::string serialized = report.dump(2);
+    if (!output_path.empty()) {
+        FILE* f = std::fopen(output_path.c_str(), "w");
+        if (!f) {
+            std::fprintf(stderr, "Failed to open %s\n", output_path.c_str());
+            return 1;
+        }
+        std::fputs(serialized.c_str(), f);
+        std::fputs("\n", f);
+        std::fclose(f);
+    } else {
+        std::printf("%s\n", serialized.c_str());
+    }
+
+    const bool complete = tokens_received >= streams * tokens;
+    return complete ? 0 : 1;
+}
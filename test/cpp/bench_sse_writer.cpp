@@ -0,0 +1,105 @@
+// SSE framing microbenchmark: frames synthetic chat chunks with the old
+// per-event string concatenation and with the shared SseWriter buffer reuse,
+// writing to a no-op sink so only framing cost is measured. Reports events/sec
+// for both paths as JSON for trend tracking.
+//
+// Build: cmake --build <build-dir> --target lemonade-bench-sse-writer
+// Run:   lemonade-bench-sse-writer --events 2000000
+
+#include "lemon/sse_writer.h"
+
+#include <CLI/CLI.hpp>
+#include <chrono>
+#include <cstdio>
+#include <string>
+
+using json = nlohmann::json;
+using Clock = std::chrono::steady_clock;
+
+namespace {
+
+// Consumes frames without I/O; the volatile sums keep the writes observable
+// so the framing work cannot be optimized away.
+struct NullSink {
+    httplib::DataSink sink;
+    volatile size_t bytes = 0;
+
+    NullSink() {
+        sink.write = [this](const char* data, size_t len) -> bool {
+            bytes = bytes + len + static_cast<size_t>(data[0]);
+            return true;
+        };
+        sink.is_writable = []() { return true; };
+        sink.done = []() {};
+    }
+};
+
+std::string make_payload() {
+    const json chunk = {
+        {"id", "chatcmpl-bench"},
+        {"object", "chat.completion.chunk"},
+        {"created", 1700000000},
+        {"model", "bench-model"},
+        {"choices",
+         json::array({{{"index", 0},
+                       {"delta", {{"content", "the quick brown fox"}}},
+                       {"finish_reason", nullptr}}})},
+    };
+    return chunk.dump();
+}
+
+double run_concat(NullSink& out, const std::string& payload, long events) {
+    const auto start = Clock::now();
+    for (long i = 0; i < events; ++i) {
+        const std::string frame = "data: " + payload + "\n\n";
+        out.sink.write(frame.data(), frame.size());
+    }
+    const double secs =
+        std::chrono::duration<double>(Clock::now() - start).count();
+    return events / secs;
+}
+
+double run_writer(NullSink& out, const std::string& payload, long events) {
+    lemon::SseWriter writer(out.sink);
+    const auto start = Clock::now();
+    for (long i = 0; i < events; ++i) {
+        writer.write_data(payload);
+    }
+    const double secs =
+        std::chrono::duration<double>(Clock::now() - start).count();
+    return events / secs;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    long events = 2000000;
+
+    CLI::App app{"SSE framing microbenchmark"};
+    app.add_option("--events", events, "Events to frame per path");
+    try {
+        app.parse(argc, argv);
+    } catch (const CLI::ParseError& e) {
+        return app.exit(e);
+    }
+
+    NullSink out;
+    const std::string payload = make_payload();
+
+    // Warm both paths before timing so allocator state is comparable.
+    run_concat(out, payload, events / 10);
+    run_writer(out, payload, events / 10);
+
+    const double concat_eps = run_concat(out, payload, events);
+    const double writer_eps = run_writer(out, payload, events);
+
+    json report = {
+        {"events", events},
+        {"payload_bytes", payload.size()},
+        {"concat_events_per_sec", concat_eps},
+        {"writer_events_per_sec", writer_eps},
+        {"speedup", concat_eps > 0 ? writer_eps / concat_eps : 0.0},
+    };
+    std::printf("%s\n", report.dump(2).c_str());
+    return 0;
+}
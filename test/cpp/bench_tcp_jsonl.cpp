@@ -0,0 +1,174 @@
+// TCP JSONL throughput microbenchmark: per-line send() vs batched
+// send_batch() against a loopback sink that counts delivered lines.
+//
+// Build: cmake --build <build-dir> --target lemonade-bench-tcp-jsonl
+
+#include "lemon/utils/tcp_jsonl_client.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <thread>
+#include <vector>
+
+#ifdef _WIN32
+    #include <winsock2.h>
+    #include <ws2tcpip.h>
+    #pragma comment(lib, "ws2_32.lib")
+    typedef int socklen_t;
+    #define LMCLOSE_SOCKET ::closesocket
+#else
+    #include <arpa/inet.h>
+    #include <netinet/in.h>
+    #include <sys/socket.h>
+    #include <unistd.h>
+    typedef int SOCKET;
+    #define INVALID_SOCKET (-1)
+    #define LMCLOSE_SOCKET ::close
+#endif
+
+using lemon::utils::TcpJsonlClient;
+using nlohmann::json;
+using Clock = std::chrono::steady_clock;
+
+namespace {
+
+struct LineSink {
+    SOCKET listen_fd = INVALID_SOCKET;
+    int port = 0;
+    std::thread thread;
+    std::atomic<size_t> lines{0};
+
+    bool start() {
+#ifdef _WIN32
+        WSADATA wsa_data;
+        if (WSAStartup(MAKEWORD(2, 2), &wsa_data) != 0) return false;
+#endif
+        listen_fd = ::socket(AF_INET, SOCK_STREAM, 0);
+        if (listen_fd == INVALID_SOCKET) return false;
+
+        sockaddr_in addr{};
+        addr.sin_family = AF_INET;
+        addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        addr.sin_port = 0;
+        if (::bind(listen_fd, (sockaddr*)&addr, sizeof(addr)) != 0) return false;
+        if (::listen(listen_fd, 1) != 0) return false;
+
+        socklen_t addr_size = sizeof(addr);
+        if (::getsockname(listen_fd, (sockaddr*)&addr, &addr_size) != 0) return false;
+        port = ntohs(addr.sin_port);
+
+        thread = std::thread([this]() {
+            SOCKET conn = ::accept(listen_fd, nullptr, nullptr);
+            if (conn == INVALID_SOCKET) return;
+            char buffer[65536];
+            while (true) {
+#ifdef _WIN32
+                int n = recv(conn, buffer, static_cast<int>(sizeof(buffer)), 0);
+#else
+                auto n = recv(conn, buffer, sizeof(buffer), 0);
+#endif
+                if (n <= 0) break;
+                size_t newlines = 0;
+                for (int i = 0; i < static_cast<int>(n); ++i) {
+                    newlines += buffer[i] == '\n' ? 1 : 0;
+                }
+                lines.fetch_add(newlines);
+            }
+            LMCLOSE_SOCKET(conn);
+        });
+        return true;
+    }
+
+    void wait_for_lines(size_t expected) {
+        while (lines.load() < expected) {
+            std::this_thread::yield();
+        }
+    }
+
+    void stop() {
+        if (listen_fd != INVALID_SOCKET) {
+            LMCLOSE_SOCKET(listen_fd);
+            listen_fd = INVALID_SOCKET;
+        }
+        if (thread.joinable()) {
+            thread.join();
+        }
+    }
+};
+
+json make_message(size_t i) {
+    return {{"type", "input_audio_buffer.append"},
+            {"seq", i},
+            {"audio", std::string(120, 'A')}};
+}
+
+double run_per_line(LineSink& sink, TcpJsonlClient& client, size_t messages,
+                    size_t already_delivered) {
+    const auto start = Clock::now();
+    for (size_t i = 0; i < messages; ++i) {
+        client.send(make_message(i));
+    }
+    sink.wait_for_lines(already_delivered + messages);
+    return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+double run_batched(LineSink& sink, TcpJsonlClient& client, size_t messages,
+                   size_t batch_size, size_t already_delivered) {
+    std::vector<json> batch;
+    batch.reserve(batch_size);
+    const auto start = Clock::now();
+    for (size_t i = 0; i < messages; ++i) {
+        batch.push_back(make_message(i));
+        if (batch.size() == batch_size) {
+            client.send_batch(batch);
+            batch.clear();
+        }
+    }
+    if (!batch.empty()) {
+        client.send_batch(batch);
+    }
+    sink.wait_for_lines(already_delivered + messages);
+    return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+} // namespace
+
+int main() {
+    const size_t messages = 100000;
+    const size_t batch_size = 32;
+
+    LineSink sink;
+    if (!sink.start()) {
+        std::fprintf(stderr, "failed to start loopback sink\n");
+        return 1;
+    }
+
+    TcpJsonlClient client;
+    if (!client.connect("tcp://127.0.0.1:" + std::to_string(sink.port),
+                        [](const json&) {})) {
+        std::fprintf(stderr, "failed to connect\n");
+        sink.stop();
+        return 1;
+    }
+
+    const double per_line_seconds = run_per_line(sink, client, messages, 0);
+    const double batched_seconds =
+        run_batched(sink, client, messages, batch_size, messages);
+
+    client.close();
+    sink.stop();
+
+    std::printf("{\n");
+    std::printf("  \"messages\": %zu,\n", messages);
+    std::printf("  \"batch_size\": %zu,\n", batch_size);
+    std::printf("  \"per_line_klines_per_s\": %.1f,\n",
+                messages / per_line_seconds / 1e3);
+    std::printf("  \"batched_klines_per_s\": %.1f,\n",
+                messages / batched_seconds / 1e3);
+    std::printf("  \"batch_speedup\": %.2f\n",
+                batched_seconds > 0.0 ? per_line_seconds / batched_seconds : 0.0);
+    std::printf("}\n");
+    return 0;
+}
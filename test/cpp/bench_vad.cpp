@@ -0,0 +1,84 @@
+// VAD microbenchmark: throughput of the scalar vs vectorized energy kernel
+// and of the full SimpleVAD::process() loop on synthetic 16kHz audio.
+// "Sessions per core" is audio seconds processed per CPU second at the
+// realtime path's 100ms tick.
+//
+// Build: cmake --build <build-dir> --target lemonade-bench-vad
+
+#include "lemon/vad.h"
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+using lemon::SimpleVAD;
+using Clock = std::chrono::steady_clock;
+
+namespace {
+
+constexpr int kSampleRate = 16000;
+constexpr size_t kChunkSamples = kSampleRate / 10;  // 100ms realtime tick
+
+std::vector<float> synthetic_audio(size_t count) {
+    std::vector<float> samples(count);
+    unsigned int state = 12345;
+    for (size_t i = 0; i < count; ++i) {
+        state = state * 1103515245u + 12345u;
+        const float noise = static_cast<float>(state >> 16) / 65535.0f - 0.5f;
+        samples[i] = 0.4f * std::sin(0.05f * static_cast<float>(i)) + 0.05f * noise;
+    }
+    return samples;
+}
+
+template <typename Fn>
+double seconds_for(Fn&& fn) {
+    const auto start = Clock::now();
+    fn();
+    return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+} // namespace
+
+int main() {
+    const size_t iterations = 20000;
+    const auto audio = synthetic_audio(kChunkSamples);
+
+    volatile float guard = 0.0f;
+    const double scalar_seconds = seconds_for([&]() {
+        for (size_t i = 0; i < iterations; ++i) {
+            guard += SimpleVAD::sum_squares_scalar(audio.data(), audio.size());
+        }
+    });
+    const double simd_seconds = seconds_for([&]() {
+        for (size_t i = 0; i < iterations; ++i) {
+            guard += SimpleVAD::sum_squares(audio.data(), audio.size());
+        }
+    });
+
+    SimpleVAD vad;
+    const double process_seconds = seconds_for([&]() {
+        for (size_t i = 0; i < iterations; ++i) {
+            vad.process(audio.data(), audio.size(), kSampleRate);
+        }
+    });
+
+    const double audio_seconds = static_cast<double>(iterations) * 0.1;
+    const double sessions_per_core =
+        process_seconds > 0.0 ? audio_seconds / process_seconds : 0.0;
+
+    std::printf("{\n");
+    std::printf("  \"chunk_samples\": %zu,\n", kChunkSamples);
+    std::printf("  \"iterations\": %zu,\n", iterations);
+    std::printf("  \"scalar_gsamples_per_s\": %.3f,\n",
+                iterations * static_cast<double>(kChunkSamples) / scalar_seconds / 1e9);
+    std::printf("  \"simd_gsamples_per_s\": %.3f,\n",
+                iterations * static_cast<double>(kChunkSamples) / simd_seconds / 1e9);
+    std::printf("  \"simd_speedup\": %.2f,\n",
+                simd_seconds > 0.0 ? scalar_seconds / simd_seconds : 0.0);
+    std::printf("  \"vad_sessions_per_core\": %.0f\n", sessions_per_core);
+    std::printf("}\n");
+
+    (void)guard;
+    return 0;
+}
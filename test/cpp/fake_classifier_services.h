@@ -56,6 +56,12 @@ public:
         chat_replies_[model] = std::move(reply);
     }
 
+    // Configure fixed backend queue stats returned for `model`. Models with no
+    // configured stats return null, matching a Router with the model unloaded.
+    void set_queue_stats(const std::string& model, json stats) {
+        queue_stats_[model] = std::move(stats);
+    }
+
     // Build a ClassifierServices wired to this fake. The returned struct copies
     // `this` by pointer, so keep the FakeClassifierServices alive for the
     // services' lifetime.
@@ -85,6 +91,11 @@ public:
             if (it != self->chat_replies_.end()) return it->second;
             return std::string{};
         };
+        svc.queue_stats = [self](const std::string& model) {
+            auto it = self->queue_stats_.find(model);
+            if (it != self->queue_stats_.end()) return it->second;
+            return json();
+        };
         return svc;
     }
 
@@ -95,6 +106,7 @@ private:
     int total_embed_calls_ = 0;
     std::map<std::string, std::map<std::string, double>> classifier_scores_;
     std::map<std::string, std::string> chat_replies_;
+    std::map<std::string, json> queue_stats_;
 };
 
 } // namespace testing
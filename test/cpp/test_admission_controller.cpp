@@ -0,0 +1,102 @@
+// Admission gate: interactive requests pass immediately, batch requests wait
+// for interactive traffic on the same model, forced admission after max_wait.
+
+#include "lemon/admission_controller.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <thread>
+
+using lemon::AdmissionController;
+using lemon::RequestPriority;
+
+static int g_failures = 0;
+
+static void check(const char* name, bool ok) {
+    std::printf("[%s] %s\n", ok ? "PASS" : "FAIL", name);
+    if (!ok) {
+        ++g_failures;
+    }
+}
+
+static void test_interactive_is_immediate() {
+    AdmissionController controller;
+    auto ticket = controller.admit("llama", RequestPriority::Interactive);
+    auto stats = controller.stats(RequestPriority::Interactive);
+    check("interactive admits immediately", stats.active == 1 && stats.waited == 0);
+    ticket.release();
+    check("release drops the active count",
+          controller.stats(RequestPriority::Interactive).active == 0);
+}
+
+static void test_batch_waits_for_interactive() {
+    AdmissionController controller;
+    auto interactive = controller.admit("llama", RequestPriority::Interactive);
+
+    std::atomic<bool> batch_admitted{false};
+    std::thread batch([&]() {
+        auto ticket = controller.admit("llama", RequestPriority::Batch,
+                                       std::chrono::seconds(5));
+        batch_admitted.store(true);
+        ticket.release();
+    });
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    check("batch waits while interactive is active", !batch_admitted.load());
+    check("waiting batch shows in stats",
+          controller.stats(RequestPriority::Batch).waiting == 1);
+
+    interactive.release();
+    batch.join();
+    check("batch admits once interactive releases", batch_admitted.load());
+    auto stats = controller.stats(RequestPriority::Batch);
+    check("batch wait was counted", stats.waited == 1 && stats.forced == 0);
+}
+
+static void test_batch_on_other_model_is_immediate() {
+    AdmissionController controller;
+    auto interactive = controller.admit("llama", RequestPriority::Interactive);
+    auto batch = controller.admit("qwen", RequestPriority::Batch,
+                                  std::chrono::milliseconds(0));
+    check("batch on a different model admits immediately",
+          controller.stats(RequestPriority::Batch).waited == 0);
+}
+
+static void test_forced_admission_after_max_wait() {
+    AdmissionController controller;
+    auto interactive = controller.admit("llama", RequestPriority::Interactive);
+    auto batch = controller.admit("llama", RequestPriority::Batch,
+                                  std::chrono::milliseconds(50));
+    auto stats = controller.stats(RequestPriority::Batch);
+    check("batch is force-admitted after max_wait",
+          stats.active == 1 && stats.forced == 1 && stats.waiting == 0);
+}
+
+static void test_moved_ticket_releases_once() {
+    AdmissionController controller;
+    {
+        auto ticket = controller.admit("llama", RequestPriority::Interactive);
+        AdmissionController::Ticket moved = std::move(ticket);
+        ticket.release();
+        check("moved-from ticket holds no admission",
+              controller.stats(RequestPriority::Interactive).active == 1);
+    }
+    check("moved-to ticket releases on destruction",
+          controller.stats(RequestPriority::Interactive).active == 0);
+}
+
+int main() {
+    test_interactive_is_immediate();
+    test_batch_waits_for_interactive();
+    test_batch_on_other_model_is_immediate();
+    test_forced_admission_after_max_wait();
+    test_moved_ticket_releases_once();
+
+    if (g_failures > 0) {
+        std::printf("%d check(s) failed\n", g_failures);
+        return 1;
+    }
+    std::printf("All checks passed\n");
+    return 0;
+}
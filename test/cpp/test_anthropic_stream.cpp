@@ -0,0 +1,246 @@
+// Anthropic stream translator: incremental OpenAI SSE -> Anthropic SSE
+// conversion, including partial tool-argument streaming and block indexing.
+
+#include "lemon/anthropic_stream.h"
+
+#include <cstdio>
+#include <string>
+#include <utility>
+#include <vector>
+
+using lemon::anthropic::json;
+using lemon::anthropic::StreamTranslator;
+
+static int g_failures = 0;
+
+static void check(const char* name, bool ok) {
+    std::printf("[%s] %s\n", ok ? "PASS" : "FAIL", name);
+    if (!ok) {
+        ++g_failures;
+    }
+}
+
+struct Event {
+    std::string name;
+    json data;
+};
+
+static std::vector<Event> parse_events(const std::string& sse) {
+    std::vector<Event> events;
+    size_t pos = 0;
+    while ((pos = sse.find("event: ", pos)) != std::string::npos) {
+        size_t name_end = sse.find('\n', pos);
+        std::string name = sse.substr(pos + 7, name_end - pos - 7);
+        size_t data_start = sse.find("data: ", name_end) + 6;
+        size_t data_end = sse.find("\n\n", data_start);
+        events.push_back({name, json::parse(sse.substr(data_start, data_end - data_start))});
+        pos = data_end;
+    }
+    return events;
+}
+
+static std::string feed(StreamTranslator& t, const std::string& bytes) {
+    return t.feed(bytes.data(), bytes.size());
+}
+
+static std::string chunk_line(const json& chunk) {
+    return "data: " + chunk.dump() + "\n\n";
+}
+
+static void test_text_streaming() {
+    StreamTranslator t("llama3");
+
+    json first = {
+        {"id", "chatcmpl-1"},
+        {"choices", json::array({{{"delta", {{"content", "Hel"}}}}})},
+    };
+    std::string line = chunk_line(first);
+
+    // Split mid-line to exercise partial SSE buffering
+    std::string out = feed(t, line.substr(0, 10));
+    check("no events until a full line arrives", out.empty());
+    out += feed(t, line.substr(10));
+
+    json second = {
+        {"choices", json::array({{{"delta", {{"content", "lo"}}}, {"finish_reason", "stop"}}})},
+        {"usage", {{"prompt_tokens", 12}, {"completion_tokens", 3}}},
+    };
+    out += feed(t, chunk_line(second));
+    out += feed(t, "data: [DONE]\n\n");
+    out += t.finish({});
+
+    auto events = parse_events(out);
+    check("message_start first", !events.empty() && events[0].name == "message_start" &&
+                                     events[0].data["message"]["id"] == "chatcmpl-1");
+    check("text block starts at index 0",
+          events.size() > 1 && events[1].name == "content_block_start" &&
+              events[1].data["index"] == 0 &&
+              events[1].data["content_block"]["type"] == "text");
+    check("text deltas emitted per chunk",
+          events.size() > 3 && events[2].data["delta"]["text"] == "Hel" &&
+              events[3].data["delta"]["text"] == "lo");
+    check("block stopped before message_delta",
+          events.size() > 5 && events[4].name == "content_block_stop" &&
+              events[5].name == "message_delta");
+    check("stop_reason and usage in message_delta",
+          events[5].data["delta"]["stop_reason"] == "end_turn" &&
+              events[5].data["usage"]["input_tokens"] == 12 &&
+              events[5].data["usage"]["output_tokens"] == 3);
+    check("message_stop last", events.back().name == "message_stop");
+}
+
+static void test_tool_argument_streaming() {
+    StreamTranslator t("llama3");
+
+    json start = {
+        {"choices", json::array({{{"delta", {{"tool_calls", json::array({
+            {{"index", 0},
+             {"id", "call_1"},
+             {"function", {{"name", "lookup"}, {"arguments", "{\"q\":"}}}},
+        })}}}}})},
+    };
+    std::string out = feed(t, chunk_line(start));
+
+    json more = {
+        {"choices", json::array({{{"delta", {{"tool_calls", json::array({
+            {{"index", 0}, {"function", {{"arguments", "\"x\"}"}}}},
+        })}}}}})},
+    };
+    out += feed(t, chunk_line(more));
+
+    json finish = {
+        {"choices", json::array({{{"delta", json::object()}, {"finish_reason", "tool_calls"}}})},
+    };
+    out += feed(t, chunk_line(finish));
+    out += t.finish({});
+
+    auto events = parse_events(out);
+    check("tool-only response uses index 0",
+          events.size() > 1 && events[1].name == "content_block_start" &&
+              events[1].data["index"] == 0 &&
+              events[1].data["content_block"]["type"] == "tool_use" &&
+              events[1].data["content_block"]["id"] == "call_1" &&
+              events[1].data["content_block"]["name"] == "lookup");
+    check("arguments stream as input_json_delta fragments",
+          events.size() > 3 &&
+              events[2].data["delta"]["type"] == "input_json_delta" &&
+              events[2].data["delta"]["partial_json"] == "{\"q\":" &&
+              events[3].data["delta"]["partial_json"] == "\"x\"}");
+
+    bool tool_use_stop = false;
+    for (const auto& e : events) {
+        if (e.name == "message_delta" && e.data["delta"]["stop_reason"] == "tool_use") {
+            tool_use_stop = true;
+        }
+    }
+    check("finish_reason tool_calls maps to tool_use", tool_use_stop);
+}
+
+static void test_text_then_tools() {
+    StreamTranslator t("llama3");
+
+    json text = {{"choices", json::array({{{"delta", {{"content", "Looking"}}}}})}};
+    json tool = {
+        {"choices", json::array({{{"delta", {{"tool_calls", json::array({
+            {{"index", 0}, {"function", {{"name", "lookup"}, {"arguments", "{}"}}}},
+        })}}}}})},
+    };
+    std::string out = feed(t, chunk_line(text));
+    out += feed(t, chunk_line(tool));
+    out += t.finish({"a warning"});
+
+    auto events = parse_events(out);
+    int text_index = -1;
+    int tool_index = -1;
+    int stops = 0;
+    bool warnings_forwarded = false;
+    for (const auto& e : events) {
+        if (e.name == "content_block_start") {
+            if (e.data["content_block"]["type"] == "text") text_index = e.data["index"];
+            if (e.data["content_block"]["type"] == "tool_use") tool_index = e.data["index"];
+        }
+        if (e.name == "content_block_stop") {
+            ++stops;
+        }
+        if (e.name == "message_delta" && e.data.contains("warnings")) {
+            warnings_forwarded = e.data["warnings"][0] == "a warning";
+        }
+    }
+    check("text block precedes tool block", text_index == 0 && tool_index == 1);
+    check("both blocks stopped", stops == 2);
+    check("warnings forwarded in message_delta", warnings_forwarded);
+}
+
+static void test_truncated_tool_arguments_closed() {
+    StreamTranslator t("llama3");
+
+    json start = {
+        {"choices", json::array({{{"delta", {{"tool_calls", json::array({
+            {{"index", 0},
+             {"id", "call_1"},
+             {"function", {{"name", "lookup"}, {"arguments", "{\"q\": \"par"}}}},
+        })}}}}})},
+    };
+    std::string out = feed(t, chunk_line(start));
+    out += t.finish({});
+
+    auto events = parse_events(out);
+    std::string assembled;
+    bool repair_before_stop = false;
+    for (const auto& e : events) {
+        if (e.name == "content_block_delta" &&
+            e.data["delta"]["type"] == "input_json_delta") {
+            assembled += e.data["delta"]["partial_json"].get<std::string>();
+        }
+        if (e.name == "content_block_stop") {
+            repair_before_stop = assembled == "{\"q\": \"par\"}";
+        }
+    }
+    check("truncated arguments closed before block stop", repair_before_stop);
+    check("assembled arguments parse",
+          !json::parse(assembled, nullptr, false).is_discarded());
+}
+
+static void test_empty_stream() {
+    StreamTranslator t("llama3");
+    std::string out = t.finish({});
+
+    auto events = parse_events(out);
+    check("empty stream still forms a full message",
+          events.size() == 5 && events[0].name == "message_start" &&
+              events[1].name == "content_block_start" &&
+              events[2].name == "content_block_stop" &&
+              events[3].name == "message_delta" &&
+              events[4].name == "message_stop");
+    check("empty stream emits an empty text block",
+          events[1].data["content_block"]["type"] == "text" &&
+              events[1].data["index"] == 0);
+}
+
+static void test_malformed_lines_skipped() {
+    StreamTranslator t("llama3");
+    std::string out = feed(t, ": keep-alive\n\ndata: {not json}\n\n");
+    check("malformed lines produce no events", out.empty());
+
+    json text = {{"choices", json::array({{{"delta", {{"content", "ok"}}}}})}};
+    out = feed(t, chunk_line(text));
+    auto events = parse_events(out);
+    check("stream recovers after malformed line",
+          events.size() == 3 && events[2].data["delta"]["text"] == "ok");
+}
+
+int main() {
+    test_text_streaming();
+    test_tool_argument_streaming();
+    test_text_then_tools();
+    test_truncated_tool_arguments_closed();
+    test_empty_stream();
+    test_malformed_lines_skipped();
+
+    if (g_failures > 0) {
+        std::printf("%d check(s) failed\n", g_failures);
+        return 1;
+    }
+    std::printf("All checks passed\n");
+    return 0;
+}
@@ -0,0 +1,90 @@
+#include "lemon/artifact_spool.h"
+
+#include <cstdio>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+namespace fs = std::filesystem;
+using lemon::ArtifactSpool;
+
+static int g_failures = 0;
+
+static void check(const char* name, bool ok) {
+    std::printf("[%s] %s\n", ok ? "PASS" : "FAIL", name);
+    if (!ok) ++g_failures;
+}
+
+static ArtifactSpool::Item image(char fill, size_t size) {
+    return {"image", std::string(size, fill), "image/png"};
+}
+
+static ArtifactSpool::Item audio(char fill, size_t size) {
+    return {"audio", std::string(size, fill), "audio/mpeg"};
+}
+
+static size_t spill_file_count() {
+    size_t count = 0;
+    for (const auto& entry : fs::directory_iterator(fs::temp_directory_path())) {
+        if (entry.path().filename().string().rfind("lemonade-artifact-spool-", 0) == 0) ++count;
+    }
+    return count;
+}
+
+static void test_within_budget() {
+    ArtifactSpool spool(1024);
+    spool.add(image('a', 100));
+    spool.add(audio('b', 200));
+    check("resident: nothing spilled under budget", spool.spilled_bytes() == 0);
+    check("resident: payloads intact",
+          spool.get(0).data == std::string(100, 'a') && spool.get(1).data == std::string(200, 'b'));
+    check("resident: accounting matches", spool.resident_bytes() == 300);
+    check("resident: last image found", spool.last_image_index() == 0);
+}
+
+static void test_spill_and_readback() {
+    const size_t before = spill_file_count();
+    {
+        ArtifactSpool spool(250);
+        spool.add(image('a', 100));
+        spool.add(image('b', 100));
+        spool.add(audio('c', 100));
+        check("spill: resident bytes bounded", spool.resident_bytes() <= 250);
+        check("spill: overflow went to disk", spool.spilled_bytes() >= 50);
+        check("spill: every payload reads back",
+              spool.get(0).data == std::string(100, 'a') &&
+              spool.get(1).data == std::string(100, 'b') &&
+              spool.get(2).data == std::string(100, 'c'));
+        check("spill: types survive",
+              spool.type(0) == "image" && spool.type(2) == "audio");
+        check("spill: last image index skips audio", spool.last_image_index() == 1);
+    }
+    check("spill: file removed on destruction", spill_file_count() == before);
+}
+
+static void test_replace() {
+    ArtifactSpool spool(150);
+    spool.add(image('a', 100));
+    spool.add(image('b', 100));
+    const int last = spool.last_image_index();
+    check("replace: oldest spilled first", spool.get(0).data == std::string(100, 'a'));
+    spool.replace(static_cast<size_t>(last), image('z', 120));
+    check("replace: new payload wins", spool.get(1).data == std::string(120, 'z'));
+    check("replace: spilled entry replaceable", [&] {
+        spool.replace(0, image('y', 10));
+        return spool.get(0).data == std::string(10, 'y');
+    }());
+    check("replace: budget still enforced", spool.resident_bytes() <= 150);
+}
+
+int main() {
+    test_within_budget();
+    test_spill_and_readback();
+    test_replace();
+    if (g_failures) {
+        std::printf("%d FAILURE(S)\n", g_failures);
+        return 1;
+    }
+    std::printf("ALL PASS (0 failures)\n");
+    return 0;
+}
@@ -0,0 +1,177 @@
+// Standalone test for the polyphase audio resampler.
+//
+// Compile: g++ -std=c++17 -I src/cpp/include test/cpp/test_audio_resampler.cpp
+//   src/cpp/server/audio_resampler.cpp -o test_audio_resampler
+
+#include "lemon/audio_resampler.h"
+
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+using lemon::audio::Resampler;
+
+static int g_failures = 0;
+
+static void check(const char* name, bool ok) {
+    std::printf("[%s] %s\n", ok ? "PASS" : "FAIL", name);
+    if (!ok) ++g_failures;
+}
+
+namespace {
+
+constexpr double kPi = 3.14159265358979323846;
+
+std::vector<int16_t> make_sine(double freq_hz, int sample_rate, size_t count,
+                               double amplitude = 8000.0) {
+    std::vector<int16_t> samples(count);
+    for (size_t i = 0; i < count; ++i) {
+        samples[i] = static_cast<int16_t>(
+            amplitude * std::sin(2.0 * kPi * freq_hz * static_cast<double>(i) /
+                                 sample_rate));
+    }
+    return samples;
+}
+
+double rms(const std::vector<int16_t>& samples, size_t skip = 0) {
+    if (samples.size() <= skip) return 0.0;
+    double sum = 0.0;
+    for (size_t i = skip; i < samples.size(); ++i) {
+        sum += static_cast<double>(samples[i]) * samples[i];
+    }
+    return std::sqrt(sum / static_cast<double>(samples.size() - skip));
+}
+
+size_t zero_crossings(const std::vector<int16_t>& samples, size_t skip = 0) {
+    size_t crossings = 0;
+    for (size_t i = skip + 1; i < samples.size(); ++i) {
+        if ((samples[i - 1] < 0) != (samples[i] < 0)) ++crossings;
+    }
+    return crossings;
+}
+
+}  // namespace
+
+static void test_matching_rates_pass_through() {
+    Resampler resampler(16000, 16000);
+    check("matching rates report passthrough", resampler.is_passthrough());
+
+    const auto input = make_sine(440.0, 16000, 1600);
+    std::vector<int16_t> out;
+    resampler.process(input.data(), input.size(), out);
+    check("passthrough is an exact copy", out == input);
+}
+
+static void test_48k_output_length_and_dc_gain() {
+    Resampler resampler(48000, 16000);
+    std::vector<int16_t> input(48000, 1000);
+    std::vector<int16_t> out;
+    resampler.process(input.data(), input.size(), out);
+
+    check("48k->16k produces one third the samples",
+          out.size() >= 15998 && out.size() <= 16000);
+
+    bool flat = true;
+    for (size_t i = 32; i < out.size(); ++i) {
+        if (std::abs(out[i] - 1000) > 2) { flat = false; break; }
+    }
+    check("DC gain is unity", flat);
+}
+
+static void test_44k_output_length() {
+    Resampler resampler(44100, 16000);
+    std::vector<int16_t> input(44100, 500);
+    std::vector<int16_t> out;
+    resampler.process(input.data(), input.size(), out);
+    check("44.1k->16k produces 16k samples per second",
+          out.size() >= 15998 && out.size() <= 16000);
+}
+
+static void test_tone_survives_conversion() {
+    Resampler resampler(48000, 16000);
+    const auto input = make_sine(1000.0, 48000, 48000);
+    std::vector<int16_t> out;
+    resampler.process(input.data(), input.size(), out);
+
+    // A 1kHz tone over one second crosses zero ~2000 times at any rate
+    const size_t crossings = zero_crossings(out, 64);
+    check("tone frequency is preserved", crossings >= 1980 && crossings <= 2020);
+
+    const double gain = rms(out, 64) / rms(input);
+    check("tone amplitude is preserved", gain > 0.9 && gain < 1.1);
+}
+
+static void test_out_of_band_tone_is_attenuated() {
+    Resampler resampler(48000, 16000);
+    // 10kHz is above the 16kHz Nyquist limit and must not alias through
+    const auto input = make_sine(10000.0, 48000, 48000);
+    std::vector<int16_t> out;
+    resampler.process(input.data(), input.size(), out);
+
+    const double gain = rms(out, 64) / rms(input);
+    check("out-of-band tone is attenuated", gain < 0.05);
+}
+
+static void test_chunked_equals_one_shot() {
+    const auto input = make_sine(700.0, 48000, 9600);
+
+    Resampler one_shot(48000, 16000);
+    std::vector<int16_t> expected;
+    one_shot.process(input.data(), input.size(), expected);
+
+    Resampler streaming(48000, 16000);
+    std::vector<int16_t> assembled;
+    std::vector<int16_t> chunk_out;
+    const size_t chunk_sizes[] = {1, 7, 480, 3000, 6112};
+    size_t offset = 0;
+    for (size_t chunk : chunk_sizes) {
+        streaming.process(input.data() + offset, chunk, chunk_out);
+        assembled.insert(assembled.end(), chunk_out.begin(), chunk_out.end());
+        offset += chunk;
+    }
+    check("chunk sizes cover the input", offset == input.size());
+    check("chunked output is bit-identical to one-shot", assembled == expected);
+}
+
+static void test_reset_restarts_the_stream() {
+    const auto input = make_sine(300.0, 48000, 4800);
+
+    Resampler resampler(48000, 16000);
+    std::vector<int16_t> first;
+    resampler.process(input.data(), input.size(), first);
+
+    resampler.reset();
+    std::vector<int16_t> second;
+    resampler.process(input.data(), input.size(), second);
+
+    check("reset reproduces the stream from scratch", first == second);
+}
+
+static void test_simd_matches_scalar() {
+    std::vector<float> a(37), b(37);
+    for (size_t i = 0; i < a.size(); ++i) {
+        a[i] = 0.25f * static_cast<float>(i) - 3.0f;
+        b[i] = 1.0f - 0.125f * static_cast<float>(i);
+    }
+    const float vectorized = Resampler::dot(a.data(), b.data(), a.size());
+    const float scalar = Resampler::dot_scalar(a.data(), b.data(), a.size());
+    check("SIMD dot matches scalar", std::abs(vectorized - scalar) < 1e-2f);
+}
+
+int main() {
+    test_matching_rates_pass_through();
+    test_48k_output_length_and_dc_gain();
+    test_44k_output_length();
+    test_tone_survives_conversion();
+    test_out_of_band_tone_is_attenuated();
+    test_chunked_equals_one_shot();
+    test_reset_restarts_the_stream();
+    test_simd_matches_scalar();
+
+    if (g_failures > 0) {
+        std::printf("%d check(s) failed\n", g_failures);
+        return 1;
+    }
+    std::printf("All checks passed\n");
+    return 0;
+}
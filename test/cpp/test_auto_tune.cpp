@@ -3,6 +3,7 @@
 // Compile: g++ -std=c++17 -I src/cpp/include test/cpp/test_auto_tune.cpp -o test_auto_tune
 
 #include "lemon/gguf_reader.h"
+#include "lemon/kv_budget.h"
 #include <cmath>
 #include <cstdio>
 #include <vector>
@@ -294,6 +295,24 @@ static void test_varying_heads_swa() {
           !approx_eq(bytes, old_approx, 1000.0));
 }
 
+static void test_kv_budget_plan() {
+    check("budget: no future slots keeps everything",
+          approx_eq(lemon::plan_kv_budget_gb(16.0, 0), 16.0));
+    check("budget: negative slots keep everything",
+          approx_eq(lemon::plan_kv_budget_gb(16.0, -1), 16.0));
+    check("budget: one slot reserves the per-slot amount",
+          approx_eq(lemon::plan_kv_budget_gb(16.0, 1),
+                    16.0 - lemon::KV_BUDGET_RESERVE_PER_SLOT_GB));
+    check("budget: reserve is capped at the max fraction",
+          approx_eq(lemon::plan_kv_budget_gb(16.0, 100),
+                    16.0 * (1.0 - lemon::KV_BUDGET_MAX_RESERVE_FRACTION)));
+    check("budget: tiny free memory still uses the fraction cap",
+          approx_eq(lemon::plan_kv_budget_gb(1.0, 1),
+                    1.0 * (1.0 - lemon::KV_BUDGET_MAX_RESERVE_FRACTION)));
+    check("budget: non-positive availability passes through",
+          approx_eq(lemon::plan_kv_budget_gb(0.0, 3), 0.0));
+}
+
 int main() {
     test_scalar_head_count_kv();
     test_array_head_count_kv();
@@ -306,6 +325,7 @@ int main() {
     test_fai_improvement();
     test_missing_metadata();
     test_varying_heads_swa();
+    test_kv_budget_plan();
 
     if (g_failures == 0) {
         std::printf("\nAll auto_tune tests passed\n");
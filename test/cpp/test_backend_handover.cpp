@@ -0,0 +1,117 @@
+#include "lemon/backend_handover.h"
+
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+
+using lemon::BackendHandover;
+using lemon::HandoverRecord;
+using nlohmann::json;
+
+static int g_failures = 0;
+
+static void check(const char* name, bool ok) {
+    std::printf("[%s] %s\n", ok ? "PASS" : "FAIL", name);
+    if (!ok) ++g_failures;
+}
+
+static HandoverRecord make_record(const std::string& model, int port, int pid) {
+    HandoverRecord record;
+    record.model_name = model;
+    record.checkpoint = model + ":Q4_K_M";
+    record.recipe = "llamacpp";
+    record.port = port;
+    record.pid = pid;
+    record.options = {{"ctx_size", 4096}};
+    return record;
+}
+
+static void test_record_roundtrip() {
+    HandoverRecord original = make_record("Qwen3-8B-GGUF", 8001, 4242);
+    auto restored = HandoverRecord::from_json(original.to_json());
+    check("record survives a json round trip",
+          restored && restored->model_name == original.model_name &&
+              restored->checkpoint == original.checkpoint &&
+              restored->recipe == original.recipe &&
+              restored->port == original.port && restored->pid == original.pid &&
+              restored->options == original.options);
+}
+
+static void test_invalid_records_rejected() {
+    check("missing model name rejected",
+          !HandoverRecord::from_json({{"port", 8001}, {"pid", 42}}));
+    check("missing pid rejected",
+          !HandoverRecord::from_json({{"model_name", "m"}, {"port", 8001}}));
+    check("non-object rejected", !HandoverRecord::from_json(json::array()));
+}
+
+static void test_save_and_take() {
+    const std::string dir = "handover_test_dir";
+    std::filesystem::create_directories(dir);
+
+    std::vector<HandoverRecord> records = {
+        make_record("model-a", 8001, 100),
+        make_record("model-b", 8002, 200),
+    };
+    check("save writes the state file",
+          BackendHandover::save(dir, records) &&
+              std::filesystem::exists(BackendHandover::state_path(dir)));
+
+    auto taken = BackendHandover::take(dir);
+    check("take returns the saved records",
+          taken.size() == 2 && taken[0].model_name == "model-a" &&
+              taken[1].model_name == "model-b" && taken[1].port == 8002);
+    check("take removes the state file",
+          !std::filesystem::exists(BackendHandover::state_path(dir)));
+    check("second take finds nothing", BackendHandover::take(dir).empty());
+
+    std::filesystem::remove_all(dir);
+}
+
+static void test_bad_state_files_ignored() {
+    const std::string dir = "handover_test_dir_bad";
+    std::filesystem::create_directories(dir);
+
+    {
+        std::ofstream file(BackendHandover::state_path(dir));
+        file << "{not json";
+    }
+    check("corrupt file yields no records and is removed",
+          BackendHandover::take(dir).empty() &&
+              !std::filesystem::exists(BackendHandover::state_path(dir)));
+
+    {
+        std::ofstream file(BackendHandover::state_path(dir));
+        file << json{{"version", 99}, {"backends", json::array()}}.dump();
+    }
+    check("version mismatch yields no records",
+          BackendHandover::take(dir).empty());
+
+    {
+        json state = {
+            {"version", 1},
+            {"backends", json::array({make_record("ok", 8001, 10).to_json(),
+                                      json{{"model_name", ""}, {"port", 0}}})},
+        };
+        std::ofstream file(BackendHandover::state_path(dir));
+        file << state.dump();
+    }
+    auto taken = BackendHandover::take(dir);
+    check("invalid entries are skipped, valid ones kept",
+          taken.size() == 1 && taken[0].model_name == "ok");
+
+    std::filesystem::remove_all(dir);
+}
+
+int main() {
+    test_record_roundtrip();
+    test_invalid_records_rejected();
+    test_save_and_take();
+    test_bad_state_files_ignored();
+    if (g_failures) {
+        std::printf("%d FAILURE(S)\n", g_failures);
+        return 1;
+    }
+    std::printf("ALL PASS (0 failures)\n");
+    return 0;
+}
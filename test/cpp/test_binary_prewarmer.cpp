@@ -0,0 +1,91 @@
+// Binary prewarmer: prewarm-set collection next to an executable, advisory
+// readahead lifecycle on real temp files.
+
+#include "lemon/utils/file_prewarmer.h"
+
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace fs = std::filesystem;
+using lemon::utils::BinaryPrewarmer;
+
+static int g_failures = 0;
+
+static void check(const char* name, bool ok) {
+    std::printf("[%s] %s\n", ok ? "PASS" : "FAIL", name);
+    if (!ok) {
+        ++g_failures;
+    }
+}
+
+static void write_file(const fs::path& path, size_t bytes) {
+    std::ofstream out(path, std::ios::binary);
+    out << std::string(bytes, 'x');
+}
+
+int main() {
+    const fs::path dir = fs::temp_directory_path() / "lemon_binary_prewarmer_test";
+    fs::remove_all(dir);
+    fs::create_directories(dir);
+
+    const fs::path exe = dir / "llama-server";
+    write_file(exe, 4096);
+    write_file(dir / "ggml-vulkan.so", 4096);
+    write_file(dir / "libggml.so.1", 4096);
+    write_file(dir / "ggml-base.dll", 4096);
+    write_file(dir / "libwhisper.dylib", 4096);
+    write_file(dir / "README.txt", 64);
+    write_file(dir / "model.gguf", 4096);
+    fs::create_directories(dir / "subdir");
+
+    const auto files = BinaryPrewarmer::collect_prewarm_set(exe.string());
+    check("executable listed first", !files.empty() && files.front() == exe.string());
+    check("shared libraries of every flavor collected", files.size() == 5);
+
+    bool sorted = true;
+    for (size_t i = 2; i < files.size(); ++i) {
+        if (files[i - 1] > files[i]) {
+            sorted = false;
+        }
+    }
+    check("library order deterministic", sorted);
+
+    bool skipped_non_libraries = true;
+    for (const auto& file : files) {
+        const std::string name = fs::path(file).filename().string();
+        if (name == "README.txt" || name == "model.gguf" || name == "subdir") {
+            skipped_non_libraries = false;
+        }
+    }
+    check("non-library siblings skipped", skipped_non_libraries);
+
+    check("missing executable yields empty set",
+          BinaryPrewarmer::collect_prewarm_set((dir / "missing").string()).empty());
+    check("empty path yields empty set", BinaryPrewarmer::collect_prewarm_set("").empty());
+
+    {
+        BinaryPrewarmer prewarmer;
+        prewarmer.start(exe.string());
+        prewarmer.stop();
+        prewarmer.stop();
+    }
+    check("start/stop lifecycle completes", true);
+
+    {
+        BinaryPrewarmer prewarmer;
+        prewarmer.start((dir / "missing").string());
+    }
+    check("missing executable tolerated", true);
+
+    fs::remove_all(dir);
+
+    if (g_failures > 0) {
+        std::printf("%d check(s) failed\n", g_failures);
+        return 1;
+    }
+    std::printf("All checks passed\n");
+    return 0;
+}
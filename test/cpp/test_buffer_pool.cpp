@@ -0,0 +1,116 @@
+#include "lemon/buffer_pool.h"
+
+#include <cstdio>
+#include <thread>
+#include <vector>
+
+using lemon::BufferPool;
+
+static int g_failures = 0;
+
+static void check(const char* name, bool ok) {
+    std::printf("[%s] %s\n", ok ? "PASS" : "FAIL", name);
+    if (!ok) ++g_failures;
+}
+
+static void test_acquire_reserves_class_capacity() {
+    auto small = BufferPool::acquire(1);
+    check("small acquire is empty", small.str().empty());
+    check("small acquire reserves min class", small.str().capacity() >= 4096);
+
+    auto large = BufferPool::acquire(100 * 1024);
+    check("large acquire rounds up to class", large.str().capacity() >= 128 * 1024);
+
+    auto oversized = BufferPool::acquire(8 * 1024 * 1024);
+    check("oversized acquire reserves exact", oversized.str().capacity() >= 8 * 1024 * 1024);
+}
+
+static void test_release_and_reuse() {
+    // A size class no other test touches, so totals deltas are deterministic.
+    const size_t size = 600 * 1024;
+    const auto before = BufferPool::totals();
+    const char* address;
+    {
+        auto handle = BufferPool::acquire(size);
+        handle.str().assign("payload");
+        address = handle.str().data();
+    }
+    const auto pooled = BufferPool::totals();
+    check("released buffer is pooled",
+          pooled.pooled_buffers == before.pooled_buffers + 1);
+    check("pooled bytes tracked", pooled.pooled_bytes > before.pooled_bytes);
+
+    auto reused = BufferPool::acquire(size);
+    const auto after = BufferPool::totals();
+    check("same-class acquire is a hit", after.hits == pooled.hits + 1);
+    check("reused buffer comes back cleared", reused.str().empty());
+    check("reused buffer keeps its allocation", reused.str().data() == address);
+    check("pool occupancy drops on reuse",
+          after.pooled_buffers == pooled.pooled_buffers - 1);
+}
+
+static void test_take_escapes_pool() {
+    const auto before = BufferPool::totals();
+    std::string escaped;
+    {
+        auto handle = BufferPool::acquire(300 * 1024);
+        handle.str().assign("kept");
+        escaped = handle.take();
+    }
+    const auto after = BufferPool::totals();
+    check("taken buffer keeps contents", escaped == "kept");
+    check("taken buffer does not return to pool",
+          after.pooled_buffers == before.pooled_buffers);
+}
+
+static void test_class_cap_discards() {
+    const auto before = BufferPool::totals();
+    {
+        std::vector<BufferPool::Handle> handles;
+        for (int i = 0; i < 8; ++i) {
+            handles.push_back(BufferPool::acquire(64 * 1024));
+            handles.back().str().assign("x");
+        }
+    }
+    const auto after = BufferPool::totals();
+    check("full size class discards extra returns",
+          after.discarded > before.discarded);
+    check("pool growth stays within class cap",
+          after.pooled_buffers <= before.pooled_buffers + 4);
+}
+
+static void test_free_lists_are_thread_local() {
+    {
+        auto warm = BufferPool::acquire(32 * 1024);
+        warm.str().assign("x");
+    }
+    const auto before = BufferPool::totals();
+
+    std::thread([&] {
+        auto handle = BufferPool::acquire(32 * 1024);
+        const auto inner = BufferPool::totals();
+        check("other thread misses this thread's free list",
+              inner.misses == before.misses + 1);
+        handle.str().assign("y");
+    }).join();
+
+    const auto after = BufferPool::totals();
+    check("exited thread's buffers leave the occupancy gauges",
+          after.pooled_buffers == before.pooled_buffers &&
+          after.pooled_bytes == before.pooled_bytes);
+}
+
+int main() {
+    test_acquire_reserves_class_capacity();
+    test_release_and_reuse();
+    test_take_escapes_pool();
+    test_class_cap_discards();
+    test_free_lists_are_thread_local();
+
+    if (g_failures == 0) {
+        std::printf("All buffer pool tests passed\n");
+        return 0;
+    }
+    std::printf("%d buffer pool check(s) failed\n", g_failures);
+    return 1;
+}
@@ -0,0 +1,173 @@
+// Standalone test for the measured-calibration store: linear fit over
+// (ctx, resident GB) points, persistence round-trips, and hardware
+// fingerprint isolation.
+//
+// Compile: g++ -std=c++17 -I src/cpp/include test/cpp/test_calibration_store.cpp \
+//              src/cpp/server/calibration_store.cpp -o test_calibration_store
+
+#include "lemon/calibration_store.h"
+
+#include <cmath>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+
+namespace fs = std::filesystem;
+using lemon::CalibrationCurve;
+using lemon::CalibrationStore;
+
+static int g_failures = 0;
+
+static void check(const char* name, bool ok) {
+    std::printf("[%s] %s\n", ok ? "PASS" : "FAIL", name);
+    if (!ok) ++g_failures;
+}
+
+static bool approx_eq(double a, double b, double tol) {
+    return std::fabs(a - b) < tol;
+}
+
+static constexpr double GIB = 1024.0 * 1024.0 * 1024.0;
+
+static void test_fit_exact_line() {
+    // resident = 4 GB + 0.25 MB/token * ctx
+    const double slope_gb = 0.25 / 1024.0;
+    std::vector<std::pair<int64_t, double>> points = {
+        {4096, 4.0 + slope_gb * 4096},
+        {16384, 4.0 + slope_gb * 16384},
+        {32768, 4.0 + slope_gb * 32768},
+    };
+    double bytes_per_token = 0.0, base_gb = 0.0;
+    check("fit: three collinear points succeed",
+          CalibrationStore::fit_linear(points, bytes_per_token, base_gb));
+    check("fit: slope recovered in bytes/token",
+          approx_eq(bytes_per_token, slope_gb * GIB, 1.0));
+    check("fit: intercept recovered in GB", approx_eq(base_gb, 4.0, 0.001));
+}
+
+static void test_fit_two_points() {
+    std::vector<std::pair<int64_t, double>> points = {
+        {8192, 6.0},
+        {32768, 12.0},
+    };
+    double bytes_per_token = 0.0, base_gb = 0.0;
+    check("fit: two points succeed",
+          CalibrationStore::fit_linear(points, bytes_per_token, base_gb));
+    const double expected_slope = (12.0 - 6.0) / (32768 - 8192) * GIB;
+    check("fit: two-point slope", approx_eq(bytes_per_token, expected_slope, 1.0));
+    check("fit: two-point intercept",
+          approx_eq(base_gb, 6.0 - (12.0 - 6.0) / (32768 - 8192) * 8192, 0.001));
+}
+
+static void test_fit_degenerate() {
+    double bytes_per_token = 0.0, base_gb = 0.0;
+    std::vector<std::pair<int64_t, double>> one = {{4096, 5.0}};
+    check("fit: single point rejected",
+          !CalibrationStore::fit_linear(one, bytes_per_token, base_gb));
+
+    std::vector<std::pair<int64_t, double>> same_x = {{4096, 5.0}, {4096, 6.0}};
+    check("fit: identical context sizes rejected",
+          !CalibrationStore::fit_linear(same_x, bytes_per_token, base_gb));
+}
+
+static void test_store_roundtrip(const fs::path& dir) {
+    const fs::path path = dir / "calibration_store.json";
+
+    CalibrationCurve curve;
+    curve.kv_bytes_per_token = 262144.0;
+    curve.base_gb = 4.5;
+    curve.prefill_tps = 900.0;
+    curve.decode_tps = 42.0;
+    curve.measured_at = "2026-08-26T00:00:00Z";
+
+    {
+        CalibrationStore store(path, [] { return std::string("box-a"); });
+        check("lookup: miss before store", !store.lookup("m1").has_value());
+        store.store("m1", curve);
+        auto hit = store.lookup("m1");
+        check("lookup: hit after store", hit.has_value());
+        check("lookup: curve round-trips",
+              hit && approx_eq(hit->kv_bytes_per_token, 262144.0, 0.001) &&
+                  approx_eq(hit->base_gb, 4.5, 0.001) &&
+                  hit->measured_at == "2026-08-26T00:00:00Z");
+    }
+
+    {
+        CalibrationStore reopened(path, [] { return std::string("box-a"); });
+        auto hit = reopened.lookup("m1");
+        check("persistence: curve survives reopen",
+              hit.has_value() && approx_eq(hit->decode_tps, 42.0, 0.001));
+        check("persistence: unknown model still misses",
+              !reopened.lookup("m2").has_value());
+    }
+
+    {
+        CalibrationStore other_box(path, [] { return std::string("box-b"); });
+        check("fingerprint: other hardware misses the same file",
+              !other_box.lookup("m1").has_value());
+        CalibrationCurve own = curve;
+        own.kv_bytes_per_token = 131072.0;
+        other_box.store("m1", own);
+    }
+
+    {
+        CalibrationStore box_a(path, [] { return std::string("box-a"); });
+        auto hit = box_a.lookup("m1");
+        check("fingerprint: per-box curves do not clobber each other",
+              hit.has_value() && approx_eq(hit->kv_bytes_per_token, 262144.0, 0.001));
+    }
+}
+
+static void test_corrupt_file(const fs::path& dir) {
+    const fs::path path = dir / "corrupt.json";
+    std::ofstream(path) << "{not json";
+
+    CalibrationStore store(path, [] { return std::string("box-a"); });
+    check("corrupt: unreadable file reads as empty",
+          !store.lookup("m1").has_value());
+    CalibrationCurve curve;
+    curve.kv_bytes_per_token = 1024.0;
+    store.store("m1", curve);
+    check("corrupt: store still writable afterwards",
+          store.lookup("m1").has_value());
+}
+
+static void test_fingerprint_digest() {
+    nlohmann::json a = {
+        {"Processor", "AMD Ryzen AI MAX+ 395"},
+        {"Physical Memory", "128 GB"},
+        {"devices",
+         {{"amd_gpu", {{{"name", "Radeon 8060S"}, {"vram_gb", 96}}}}}},
+    };
+    nlohmann::json b = a;
+    b["Physical Memory"] = "64 GB";
+
+    const std::string fp_a = CalibrationStore::compute_hardware_fingerprint(a);
+    check("fingerprint: stable for identical snapshots",
+          fp_a == CalibrationStore::compute_hardware_fingerprint(a));
+    check("fingerprint: changes when memory changes",
+          fp_a != CalibrationStore::compute_hardware_fingerprint(b));
+}
+
+int main() {
+    const fs::path dir =
+        fs::temp_directory_path() / "lemon_calibration_store_test";
+    fs::remove_all(dir);
+    fs::create_directories(dir);
+
+    test_fit_exact_line();
+    test_fit_two_points();
+    test_fit_degenerate();
+    test_store_roundtrip(dir);
+    test_corrupt_file(dir);
+    test_fingerprint_digest();
+
+    fs::remove_all(dir);
+
+    if (g_failures == 0) {
+        std::printf("\nAll calibration store tests passed\n");
+        return 0;
+    }
+    std::printf("\n%d calibration store test(s) FAILED\n", g_failures);
+    return 1;
+}
@@ -0,0 +1,96 @@
+// Cloud endpoint tracker: EWMA latency/error accounting and best-first
+// ranking used by the cloud backend's multi-endpoint failover.
+
+#include "lemon/cloud_endpoint_tracker.h"
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+using lemon::CloudEndpointTracker;
+
+static int g_failures = 0;
+
+static void check(const char* name, bool ok) {
+    std::printf("[%s] %s\n", ok ? "PASS" : "FAIL", name);
+    if (!ok) {
+        ++g_failures;
+    }
+}
+
+static void test_ewma_accounting() {
+    CloudEndpointTracker tracker;
+
+    tracker.record_success("https://a", 100.0);
+    auto s = tracker.snapshot("https://a");
+    check("first sample seeds the latency EWMA", s.latency_ms == 100.0);
+    check("success decays the error rate", s.error_rate == 0.0 && s.successes == 1);
+
+    tracker.record_success("https://a", 200.0);
+    s = tracker.snapshot("https://a");
+    check("latency EWMA moves toward new samples",
+          s.latency_ms > 100.0 && s.latency_ms < 200.0);
+
+    tracker.record_failure("https://a");
+    s = tracker.snapshot("https://a");
+    check("failure raises the error rate", s.error_rate > 0.0 && s.failures == 1);
+
+    check("unknown endpoint snapshots empty",
+          tracker.snapshot("https://nope").successes == 0);
+}
+
+static void test_ranking() {
+    CloudEndpointTracker tracker;
+
+    tracker.record_success("https://slow", 900.0);
+    tracker.record_success("https://fast", 80.0);
+    auto ranked = tracker.rank({"https://slow", "https://fast"});
+    check("lower latency ranks first",
+          ranked.front() == "https://fast" && ranked.back() == "https://slow");
+
+    for (int i = 0; i < 5; ++i) {
+        tracker.record_failure("https://fast");
+    }
+    ranked = tracker.rank({"https://fast", "https://slow"});
+    check("error rate outweighs latency", ranked.front() == "https://slow");
+
+    ranked = tracker.rank({"https://primary", "https://secondary"});
+    check("unsampled endpoints keep their configured order",
+          ranked.front() == "https://primary");
+
+    ranked = tracker.rank({"https://slow", "https://new"});
+    check("unsampled endpoint outranks a sampled one",
+          ranked.front() == "https://new");
+}
+
+static void test_recovery() {
+    CloudEndpointTracker tracker;
+
+    for (int i = 0; i < 5; ++i) {
+        tracker.record_failure("https://flaky");
+    }
+    tracker.record_success("https://healthy", 50.0);
+    check("degraded endpoint ranks last",
+          tracker.rank({"https://flaky", "https://healthy"}).front() ==
+              "https://healthy");
+
+    for (int i = 0; i < 40; ++i) {
+        tracker.record_success("https://flaky", 10.0);
+    }
+    check("sustained successes restore the endpoint",
+          tracker.rank({"https://healthy", "https://flaky"}).front() ==
+              "https://flaky");
+}
+
+int main() {
+    test_ewma_accounting();
+    test_ranking();
+    test_recovery();
+
+    if (g_failures > 0) {
+        std::printf("%d check(s) failed\n", g_failures);
+        return 1;
+    }
+    std::printf("All checks passed\n");
+    return 0;
+}
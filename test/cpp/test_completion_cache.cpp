@@ -0,0 +1,135 @@
+// Persistent completion cache: cacheability, disk round-trip, TTL, eviction.
+
+#include "lemon/completion_cache.h"
+
+#include <cstdio>
+#include <filesystem>
+#include <string>
+
+#include <nlohmann/json.hpp>
+
+namespace fs = std::filesystem;
+
+using json = nlohmann::json;
+using lemon::CompletionCache;
+
+static int g_failures = 0;
+
+static void check(const char* name, bool ok) {
+    std::printf("[%s] %s\n", ok ? "PASS" : "FAIL", name);
+    if (!ok) {
+        ++g_failures;
+    }
+}
+
+static json deterministic_request(const std::string& prompt) {
+    return json{{"model", "test"}, {"prompt", prompt}, {"temperature", 0.0}};
+}
+
+static void test_cacheability() {
+    check("temperature 0 qualifies",
+          CompletionCache::cacheable(deterministic_request("hi")));
+    check("missing temperature does not",
+          !CompletionCache::cacheable(json{{"prompt", "hi"}}));
+    check("nonzero temperature does not",
+          !CompletionCache::cacheable(json{{"prompt", "hi"}, {"temperature", 0.3}}));
+    check("streaming does not",
+          !CompletionCache::cacheable(
+              json{{"prompt", "hi"}, {"temperature", 0.0}, {"stream", true}}));
+}
+
+static void test_key_inputs() {
+    const json request = deterministic_request("hi");
+    check("revision changes the key",
+          CompletionCache::key_for("chat", request, "repo:Q4") !=
+              CompletionCache::key_for("chat", request, "repo:Q8"));
+    check("endpoint changes the key",
+          CompletionCache::key_for("chat", request, "repo:Q4") !=
+              CompletionCache::key_for("completion", request, "repo:Q4"));
+    check("request changes the key",
+          CompletionCache::key_for("chat", request, "repo:Q4") !=
+              CompletionCache::key_for("chat", deterministic_request("yo"), "repo:Q4"));
+}
+
+static void test_round_trip(const std::string& dir) {
+    CompletionCache cache(dir, 1);
+    const std::string key =
+        CompletionCache::key_for("chat", deterministic_request("hi"), "repo:Q4");
+    const json response = {{"choices", json::array({{{"text", "hello"}}})}};
+
+    json out;
+    check("cold lookup misses", !cache.lookup(key, out));
+    cache.store(key, response);
+    check("warm lookup hits", cache.lookup(key, out));
+    check("response replayed byte-identically", out == response);
+
+    CompletionCache reopened(dir, 1);
+    check("entry survives reopen", reopened.lookup(key, out) && out == response);
+}
+
+static void test_ttl_expiry(const std::string& dir) {
+    // ttl_hours 0 disables expiry; a cache reopened with a negative-equivalent
+    // window can't be expressed, so write with one instance and read with a
+    // second whose TTL already lapsed relative to the stored timestamp.
+    const std::string key =
+        CompletionCache::key_for("chat", deterministic_request("old"), "repo:Q4");
+    {
+        CompletionCache cache(dir, 1);
+        cache.store(key, json{{"ok", true}});
+        // Backdate the entry past the 1-hour TTL.
+        const fs::path path = fs::path(dir) / "completion-cache" / (key + ".json");
+        json entry = json::parse(std::string("{\"created\": 0, \"response\": {\"ok\": true}}"));
+        std::FILE* file = std::fopen(path.string().c_str(), "wb");
+        const std::string body = entry.dump();
+        std::fwrite(body.data(), 1, body.size(), file);
+        std::fclose(file);
+    }
+    CompletionCache cache(dir, 1);
+    json out;
+    check("expired entry misses", !cache.lookup(key, out));
+    check("expired entry removed from disk",
+          !fs::exists(fs::path(dir) / "completion-cache" / (key + ".json")));
+
+    CompletionCache no_ttl(dir, 0);
+    no_ttl.store(key, json{{"ok", true}});
+    check("ttl 0 never expires", no_ttl.lookup(key, out));
+}
+
+static void test_eviction(const std::string& dir) {
+    CompletionCache cache(dir, 1, 1024);
+    const json big = {{"text", std::string(400, 'x')}};
+    for (int i = 0; i < 8; ++i) {
+        cache.store(CompletionCache::key_for("chat",
+                                             deterministic_request(std::to_string(i)),
+                                             "repo:Q4"),
+                    big);
+    }
+    uint64_t total = 0;
+    for (const auto& entry :
+         fs::directory_iterator(fs::path(dir) / "completion-cache")) {
+        total += entry.file_size();
+    }
+    check("evicts down to the size bound", total <= 1024);
+}
+
+int main() {
+    const fs::path base =
+        fs::temp_directory_path() / "lemon-completion-cache-test";
+    fs::remove_all(base);
+    fs::create_directories(base);
+
+    test_cacheability();
+    test_key_inputs();
+    test_round_trip((base / "roundtrip").string());
+    test_ttl_expiry((base / "ttl").string());
+    test_eviction((base / "evict").string());
+
+    fs::remove_all(base);
+
+    if (g_failures != 0) {
+        std::printf("%d check(s) failed\n", g_failures);
+        return 1;
+    }
+    std::printf("All completion cache checks passed\n");
+    return 0;
+}
@@ -0,0 +1,114 @@
+// Standalone unit tests for the pure parts of lemon::DownloadScheduler — the
+// "HH:MM-HH:MM" off-hours window parser, window membership (including windows
+// that wrap midnight), and the cap selection that maps the configured
+// megabit/sec limits to a bytes/sec value for CURLOPT_MAX_RECV_SPEED_LARGE.
+// The RuntimeConfig-driven helpers are thin wiring over these and are not
+// exercised here.
+//
+// Checks use an explicit pass/fail counter (not assert()) so the test stays
+// effective under the Release build the CI `default` preset uses, where
+// -DNDEBUG would compile assert() to a no-op.
+//
+// Compile with:
+//   g++ -std=c++17 -I src/cpp/include \
+//       test/cpp/test_download_scheduler.cpp -o download_scheduler_test
+//
+// Run with:
+//   ./download_scheduler_test
+
+#include <cstdio>
+#include <string>
+
+#include <lemon/download_scheduler.h>
+
+using lemon::DownloadScheduler;
+
+struct TestResult {
+    int passed = 0;
+    int failed = 0;
+
+    void check(bool cond, const std::string& name) {
+        if (cond) {
+            printf("[PASS] %s\n", name.c_str());
+            ++passed;
+        } else {
+            printf("[FAIL] %s\n", name.c_str());
+            ++failed;
+        }
+    }
+};
+
+static void test_parse_window(TestResult& r) {
+    int start = -1, end = -1;
+    r.check(DownloadScheduler::parse_window("22:00-06:00", start, end),
+            "parse: well-formed window accepted");
+    r.check(start == 22 * 60 && end == 6 * 60, "parse: minutes-of-day correct");
+
+    r.check(DownloadScheduler::parse_window("9:30-17:05", start, end),
+            "parse: single-digit hour accepted");
+    r.check(start == 9 * 60 + 30 && end == 17 * 60 + 5,
+            "parse: single-digit hour minutes correct");
+
+    start = end = -1;
+    r.check(!DownloadScheduler::parse_window("", start, end), "parse: empty rejected");
+    r.check(!DownloadScheduler::parse_window("22:00", start, end),
+            "parse: missing dash rejected");
+    r.check(!DownloadScheduler::parse_window("24:00-06:00", start, end),
+            "parse: hour 24 rejected");
+    r.check(!DownloadScheduler::parse_window("22:60-06:00", start, end),
+            "parse: minute 60 rejected");
+    r.check(!DownloadScheduler::parse_window("22:0-06:00", start, end),
+            "parse: one-digit minute rejected");
+    r.check(!DownloadScheduler::parse_window("aa:bb-cc:dd", start, end),
+            "parse: non-numeric rejected");
+    r.check(start == -1 && end == -1, "parse: outputs untouched on failure");
+}
+
+static void test_in_window(TestResult& r) {
+    const int start = 9 * 60, end = 17 * 60;
+    r.check(DownloadScheduler::in_window(12 * 60, start, end), "window: inside");
+    r.check(DownloadScheduler::in_window(start, start, end),
+            "window: start inclusive");
+    r.check(!DownloadScheduler::in_window(end, start, end),
+            "window: end exclusive");
+    r.check(!DownloadScheduler::in_window(3 * 60, start, end), "window: before");
+
+    // 22:00-06:00 wraps midnight.
+    const int night_start = 22 * 60, night_end = 6 * 60;
+    r.check(DownloadScheduler::in_window(23 * 60, night_start, night_end),
+            "wrap: late evening inside");
+    r.check(DownloadScheduler::in_window(2 * 60, night_start, night_end),
+            "wrap: early morning inside");
+    r.check(!DownloadScheduler::in_window(12 * 60, night_start, night_end),
+            "wrap: midday outside");
+
+    r.check(!DownloadScheduler::in_window(12 * 60, 720, 720),
+            "degenerate: start == end matches nothing");
+}
+
+static void test_effective_rate(TestResult& r) {
+    r.check(DownloadScheduler::effective_rate_bytes_per_sec(0.0, 0.0, false) == 0,
+            "rate: unconfigured is unshaped");
+    r.check(DownloadScheduler::effective_rate_bytes_per_sec(8.0, 0.0, false) ==
+                1000000,
+            "rate: 8 Mbit/s is 1 MB/s outside the window");
+    r.check(DownloadScheduler::effective_rate_bytes_per_sec(8.0, 0.0, true) == 0,
+            "rate: window cap of 0 lifts the daytime cap");
+    r.check(DownloadScheduler::effective_rate_bytes_per_sec(8.0, 80.0, true) ==
+                10000000,
+            "rate: window cap replaces the daytime cap");
+    r.check(DownloadScheduler::effective_rate_bytes_per_sec(0.5, 0.0, false) ==
+                62500,
+            "rate: fractional megabits supported");
+}
+
+int main() {
+    TestResult r;
+
+    test_parse_window(r);
+    test_in_window(r);
+    test_effective_rate(r);
+
+    printf("\n%d passed, %d failed\n", r.passed, r.failed);
+    return r.failed == 0 ? 0 : 1;
+}
@@ -0,0 +1,127 @@
+// Standalone test for the multi-source download scheduler: probe-first
+// selection, throughput-weighted steering, failure-driven source dropping,
+// and the last-source-standing guarantee.
+//
+// Compile: g++ -std=c++17 -I src/cpp/include test/cpp/test_download_sources.cpp \
+//              -o test_download_sources
+
+#include "lemon/utils/download_sources.h"
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+using lemon::utils::DownloadSourceSet;
+
+static int g_failures = 0;
+
+static void check(const char* name, bool ok) {
+    std::printf("[%s] %s\n", ok ? "PASS" : "FAIL", name);
+    if (!ok) ++g_failures;
+}
+
+static void test_probe_first() {
+    DownloadSourceSet set({"https://primary/a", "https://mirror/a"});
+
+    auto* first = set.acquire();
+    auto* second = set.acquire();
+    check("probe: both sources exercised before ranking",
+          first != second && first && second);
+    check("probe: first source is primary",
+          set.sources()[0]->primary && !set.sources()[1]->primary);
+    set.release(first, 1000, 1000, true);
+    set.release(second, 1000, 1000, true);
+}
+
+static void test_throughput_steering() {
+    DownloadSourceSet set({"https://slow/a", "https://fast/a"});
+
+    auto* slow = set.acquire();
+    auto* fast = set.acquire();
+    set.release(slow, 1 * 1000 * 1000, 1000 * 1000, true);    // 1 MB/s
+    set.release(fast, 50 * 1000 * 1000, 1000 * 1000, true);   // 50 MB/s
+
+    auto* pick = set.acquire();
+    check("steering: fastest source wins", pick == fast);
+    auto* next = set.acquire();
+    check("steering: loaded fast source still beats idle slow one "
+          "(50/2 > 1/1)",
+          next == fast);
+    set.release(pick, 0, 0, true);
+    set.release(next, 0, 0, true);
+
+    // Pile enough workers onto the fast source and the slow one becomes the
+    // better per-worker deal.
+    std::vector<DownloadSourceSet::Source*> held;
+    for (int i = 0; i < 60; ++i) held.push_back(set.acquire());
+    bool slow_reached = false;
+    for (auto* s : held) {
+        if (s == slow) slow_reached = true;
+    }
+    check("steering: saturation rebalances onto the slower source", slow_reached);
+    for (auto* s : held) set.release(s, 0, 0, true);
+}
+
+static void test_failure_dropping() {
+    DownloadSourceSet set({"https://primary/a", "https://flaky/a"});
+    auto* flaky = set.sources()[1].get();
+
+    for (int i = 0; i < DownloadSourceSet::kMaxFailures; ++i) {
+        flaky->active.fetch_add(1);
+        set.release(flaky, 0, 0, false);
+    }
+    check("dropping: source disabled after repeated failures",
+          flaky->disabled.load() && set.enabled_count() == 1);
+
+    auto* pick = set.acquire();
+    check("dropping: disabled source never picked",
+          pick == set.sources()[0].get());
+    set.release(pick, 0, 0, true);
+}
+
+static void test_last_source_standing() {
+    DownloadSourceSet set({"https://only/a"});
+    auto* only = set.sources()[0].get();
+
+    for (int i = 0; i < DownloadSourceSet::kMaxFailures * 2; ++i) {
+        only->active.fetch_add(1);
+        set.release(only, 0, 0, false);
+    }
+    check("last standing: sole source is never disabled",
+          !only->disabled.load());
+
+    // Even a fully-disabled set still answers with the primary.
+    DownloadSourceSet raced({"https://a/x", "https://b/x"});
+    raced.sources()[0]->disabled.store(true);
+    raced.sources()[1]->disabled.store(true);
+    auto* fallback = raced.acquire();
+    check("last standing: all-disabled race falls back to primary",
+          fallback == raced.sources()[0].get());
+}
+
+static void test_success_resets_failures() {
+    DownloadSourceSet set({"https://primary/a", "https://mirror/a"});
+    auto* mirror = set.sources()[1].get();
+
+    for (int i = 0; i < DownloadSourceSet::kMaxFailures - 1; ++i) {
+        mirror->active.fetch_add(1);
+        set.release(mirror, 0, 0, false);
+    }
+    mirror->active.fetch_add(1);
+    set.release(mirror, 1000, 1000, true);
+    mirror->active.fetch_add(1);
+    set.release(mirror, 0, 0, false);
+    check("recovery: a success resets the failure streak",
+          !mirror->disabled.load());
+}
+
+int main() {
+    test_probe_first();
+    test_throughput_steering();
+    test_failure_dropping();
+    test_last_source_standing();
+    test_success_resets_failures();
+
+    std::printf("%s\n", g_failures == 0 ? "ALL PASS" : "FAILURES");
+    return g_failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,130 @@
+#include "lemon/backends/exe_manifest.h"
+
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+using lemon::backends::ExeManifest;
+
+namespace fs = std::filesystem;
+
+static int g_failures = 0;
+
+static void check(const char* name, bool ok) {
+    std::printf("[%s] %s\n", ok ? "PASS" : "FAIL", name);
+    if (!ok) ++g_failures;
+}
+
+static fs::path make_root(const char* suffix) {
+    auto root = fs::temp_directory_path() /
+                (std::string("lemon_exe_manifest_test_") + suffix);
+    fs::remove_all(root);
+    fs::create_directories(root / "install" / "bin");
+    return root;
+}
+
+static void write_file(const fs::path& path, const std::string& contents) {
+    std::ofstream file(path);
+    file << contents;
+}
+
+static void test_record_and_lookup() {
+    const auto root = make_root("lookup");
+    const auto exe = root / "install" / "bin" / "llama-server";
+    write_file(exe, "binary");
+
+    ExeManifest manifest((root / "manifest.json").string());
+    check("miss before record",
+          manifest.lookup((root / "install").string(), "llama-server").empty());
+
+    manifest.record((root / "install").string(), "llama-server", exe.string());
+    check("hit after record",
+          manifest.lookup((root / "install").string(), "llama-server") ==
+              exe.string());
+    check("other binary still misses",
+          manifest.lookup((root / "install").string(), "whisper-server").empty());
+
+    fs::remove_all(root);
+}
+
+static void test_stale_entries_fall_back() {
+    const auto root = make_root("stale");
+    const auto exe = root / "install" / "bin" / "llama-server";
+    write_file(exe, "binary");
+
+    ExeManifest manifest((root / "manifest.json").string());
+    manifest.record((root / "install").string(), "llama-server", exe.string());
+
+    write_file(exe, "upgraded binary with different size");
+    check("size change invalidates entry",
+          manifest.lookup((root / "install").string(), "llama-server").empty());
+
+    manifest.record((root / "install").string(), "llama-server", exe.string());
+    fs::remove(exe);
+    check("deleted file invalidates entry",
+          manifest.lookup((root / "install").string(), "llama-server").empty());
+    check("invalidated entries are dropped", manifest.size() == 0);
+
+    fs::remove_all(root);
+}
+
+static void test_persists_across_instances() {
+    const auto root = make_root("persist");
+    const auto exe = root / "install" / "bin" / "llama-server";
+    write_file(exe, "binary");
+    const auto manifest_path = (root / "manifest.json").string();
+
+    {
+        ExeManifest manifest(manifest_path);
+        manifest.record((root / "install").string(), "llama-server", exe.string());
+    }
+
+    ExeManifest reloaded(manifest_path);
+    check("entry survives reload",
+          reloaded.lookup((root / "install").string(), "llama-server") ==
+              exe.string());
+
+    reloaded.erase((root / "install").string(), "llama-server");
+    ExeManifest after_erase(manifest_path);
+    check("erase persists",
+          after_erase.lookup((root / "install").string(), "llama-server").empty());
+
+    fs::remove_all(root);
+}
+
+static void test_verify_all_prunes() {
+    const auto root = make_root("verify");
+    const auto kept = root / "install" / "bin" / "llama-server";
+    const auto removed = root / "install" / "bin" / "whisper-server";
+    write_file(kept, "kept");
+    write_file(removed, "removed");
+
+    ExeManifest manifest((root / "manifest.json").string());
+    manifest.record((root / "install").string(), "llama-server", kept.string());
+    manifest.record((root / "install").string(), "whisper-server",
+                    removed.string());
+    fs::remove(removed);
+
+    check("verify prunes stale entries only", manifest.verify_all() == 1);
+    check("valid entry survives verify",
+          manifest.lookup((root / "install").string(), "llama-server") ==
+              kept.string());
+    check("no further pruning when clean", manifest.verify_all() == 0);
+
+    fs::remove_all(root);
+}
+
+int main() {
+    test_record_and_lookup();
+    test_stale_entries_fall_back();
+    test_persists_across_instances();
+    test_verify_all_prunes();
+
+    if (g_failures == 0) {
+        std::printf("All exe manifest tests passed\n");
+        return 0;
+    }
+    std::printf("%d exe manifest check(s) failed\n", g_failures);
+    return 1;
+}
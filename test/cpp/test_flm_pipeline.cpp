@@ -0,0 +1,169 @@
+// FLM pipeline: admission depth, per-type fairness, queue bounds, occupancy
+// stats. Uses a local FlmPipeline instance so runs stay independent of the
+// process-wide singleton.
+
+#include "lemon/backends/fastflowlm/flm_pipeline.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+using lemon::ModelType;
+using lemon::backends::FlmPipeline;
+
+static int g_failures = 0;
+
+static void check(const char* name, bool ok) {
+    std::printf("[%s] %s\n", ok ? "PASS" : "FAIL", name);
+    if (!ok) {
+        ++g_failures;
+    }
+}
+
+static void test_depth_cap() {
+    FlmPipeline pipeline;
+    pipeline.set_depth(2);
+
+    std::atomic<int> in_flight{0};
+    std::atomic<int> max_in_flight{0};
+    std::vector<std::thread> workers;
+    for (int i = 0; i < 8; ++i) {
+        workers.emplace_back([&] {
+            auto ticket = pipeline.acquire(ModelType::LLM);
+            int now = ++in_flight;
+            int seen = max_in_flight.load();
+            while (now > seen && !max_in_flight.compare_exchange_weak(seen, now)) {
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+            --in_flight;
+        });
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+
+    check("depth cap respected under concurrency", max_in_flight.load() <= 2);
+    check("all requests eventually admitted", pipeline.totals().admitted == 8);
+    check("pipeline drains to idle", pipeline.in_flight() == 0 && pipeline.queued() == 0);
+}
+
+static void test_round_robin_fairness() {
+    FlmPipeline pipeline;
+    pipeline.set_depth(1);
+
+    auto blocker = pipeline.acquire(ModelType::LLM);
+
+    std::mutex order_mutex;
+    std::vector<ModelType> admitted_order;
+    std::vector<std::thread> waiters;
+    auto enqueue = [&](ModelType type) {
+        waiters.emplace_back([&, type] {
+            auto ticket = pipeline.acquire(type);
+            std::lock_guard<std::mutex> lock(order_mutex);
+            admitted_order.push_back(type);
+        });
+    };
+
+    enqueue(ModelType::LLM);
+    enqueue(ModelType::LLM);
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    enqueue(ModelType::EMBEDDING);
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+
+    blocker = FlmPipeline::Ticket();
+    for (auto& waiter : waiters) {
+        waiter.join();
+    }
+
+    bool embedding_before_second_llm = false;
+    int llm_seen = 0;
+    for (ModelType type : admitted_order) {
+        if (type == ModelType::EMBEDDING) {
+            embedding_before_second_llm = llm_seen < 2;
+            break;
+        }
+        if (type == ModelType::LLM) {
+            ++llm_seen;
+        }
+    }
+    check("late embedding admitted before the llm backlog drains",
+          admitted_order.size() == 3 && embedding_before_second_llm);
+}
+
+static void test_queue_bound() {
+    FlmPipeline pipeline;
+    pipeline.set_depth(1);
+
+    auto blocker = pipeline.acquire(ModelType::EMBEDDING);
+
+    std::vector<std::thread> waiters;
+    for (int i = 0; i < FlmPipeline::kMaxQueuedPerType; ++i) {
+        waiters.emplace_back([&] { auto ticket = pipeline.acquire(ModelType::EMBEDDING); });
+    }
+    while (pipeline.queued() < FlmPipeline::kMaxQueuedPerType) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    bool rejected = false;
+    try {
+        auto ticket = pipeline.acquire(ModelType::EMBEDDING);
+    } catch (const std::runtime_error&) {
+        rejected = true;
+    }
+    check("full per-type queue rejects", rejected);
+
+    bool other_type_rejected = true;
+    {
+        std::thread other([&] {
+            auto ticket = pipeline.acquire(ModelType::RERANKING);
+            other_type_rejected = false;
+        });
+        blocker = FlmPipeline::Ticket();
+        other.join();
+    }
+    check("other types unaffected by a full queue", !other_type_rejected);
+
+    for (auto& waiter : waiters) {
+        waiter.join();
+    }
+    check("rejection counted", pipeline.totals().rejected == 1);
+}
+
+static void test_stats_and_ticket_raii() {
+    FlmPipeline pipeline;
+    pipeline.set_depth(1);
+
+    {
+        auto ticket = pipeline.acquire(ModelType::LLM);
+        check("ticket holds a slot", pipeline.in_flight() == 1);
+        std::this_thread::sleep_for(std::chrono::milliseconds(15));
+        FlmPipeline::Ticket moved = std::move(ticket);
+        check("moved ticket keeps the slot", pipeline.in_flight() == 1);
+    }
+    check("ticket destruction releases the slot", pipeline.in_flight() == 0);
+
+    auto totals = pipeline.totals();
+    check("admission counted", totals.admitted == 1);
+    check("busy time accumulated", totals.busy_ms_total >= 10);
+
+    check("depth clamps to at least one", (pipeline.set_depth(0), pipeline.depth() == 1));
+    check("default depth is two", FlmPipeline().depth() == FlmPipeline::kDefaultDepth);
+}
+
+int main() {
+    test_depth_cap();
+    test_round_robin_fairness();
+    test_queue_bound();
+    test_stats_and_ticket_raii();
+
+    if (g_failures > 0) {
+        std::printf("%d check(s) failed\n", g_failures);
+        return 1;
+    }
+    std::printf("All checks passed\n");
+    return 0;
+}
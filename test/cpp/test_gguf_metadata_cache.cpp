@@ -0,0 +1,187 @@
+// Standalone test for lemon::GgufMetadataCache and the mmap-backed
+// read_gguf_metadata path, using a synthetic GGUF header.
+
+#include "lemon/gguf_metadata_cache.h"
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+using lemon::GgufMetadata;
+using lemon::GgufMetadataCache;
+namespace fs = std::filesystem;
+
+struct TestResult {
+    int passed = 0;
+    int failed = 0;
+
+    void ok(const std::string& name) {
+        printf("[PASS] %s\n", name.c_str());
+        ++passed;
+    }
+
+    void fail(const std::string& name) {
+        printf("[FAIL] %s\n", name.c_str());
+        ++failed;
+    }
+};
+
+static void check(TestResult& r, bool cond, const std::string& name) {
+    if (cond) {
+        r.ok(name);
+    } else {
+        r.fail(name);
+    }
+}
+
+static fs::path make_temp_dir() {
+    fs::path tmp = fs::temp_directory_path() / "gguf_metadata_cache_test_";
+    tmp += std::to_string(std::hash<std::string>{}(std::to_string(std::time(nullptr))));
+    fs::create_directories(tmp);
+    return tmp;
+}
+
+struct GgufWriter {
+    std::vector<char> bytes;
+
+    void raw(const void* data, size_t len) {
+        const char* p = static_cast<const char*>(data);
+        bytes.insert(bytes.end(), p, p + len);
+    }
+
+    template <typename T>
+    void le(T value) { raw(&value, sizeof(value)); }
+
+    void str(const std::string& s) {
+        le<uint64_t>(s.size());
+        raw(s.data(), s.size());
+    }
+
+    void kv_string(const std::string& key, const std::string& value) {
+        str(key);
+        le<uint32_t>(8);
+        str(value);
+    }
+
+    void kv_u32(const std::string& key, uint32_t value) {
+        str(key);
+        le<uint32_t>(4);
+        le<uint32_t>(value);
+    }
+};
+
+static void write_gguf(const fs::path& path, const std::string& arch,
+                       uint32_t context_length, uint32_t block_count) {
+    GgufWriter w;
+    w.raw("GGUF", 4);
+    w.le<uint32_t>(3);   // version
+    w.le<uint64_t>(0);   // tensor count
+    w.le<uint64_t>(4);   // kv count
+    w.kv_string("general.architecture", arch);
+    w.kv_u32(arch + ".context_length", context_length);
+    w.kv_u32(arch + ".block_count", block_count);
+    w.kv_u32(arch + ".embedding_length", 2048);
+
+    std::ofstream out(path, std::ios::trunc | std::ios::binary);
+    out.write(w.bytes.data(), static_cast<std::streamsize>(w.bytes.size()));
+}
+
+int main() {
+    TestResult r;
+
+    const fs::path root = make_temp_dir();
+    const fs::path manifest = root / "gguf_metadata_cache.json";
+    const fs::path gguf = root / "model.gguf";
+
+    write_gguf(gguf, "llama", 8192, 32);
+
+    {
+        GgufMetadata direct;
+        check(r, lemon::read_gguf_metadata(direct, gguf.string()),
+              "mmap reader parses a synthetic header");
+        check(r, direct.architecture == "llama" && direct.context_length == 8192 &&
+                  direct.block_count == 32 && direct.embedding_length == 2048,
+              "parsed fields match what was written");
+    }
+
+    const auto original_mtime = fs::last_write_time(gguf);
+
+    {
+        GgufMetadataCache cache(manifest);
+        GgufMetadata meta;
+        check(r, cache.read(meta, gguf.string()) && meta.context_length == 8192,
+              "first read parses and stores");
+        check(r, fs::exists(manifest), "manifest is written on store");
+
+        // Same size and restored mtime: the stale cached entry must be
+        // served, proving the file was not re-parsed.
+        write_gguf(gguf, "qwen2", 4096, 32);
+        fs::last_write_time(gguf, original_mtime);
+        GgufMetadata cached;
+        check(r, cache.read(cached, gguf.string()) && cached.architecture == "llama",
+              "matching (mtime, size) serves the cached entry");
+
+        // Bumped mtime invalidates.
+        fs::last_write_time(gguf, original_mtime + std::chrono::seconds(5));
+        GgufMetadata reparsed;
+        check(r, cache.read(reparsed, gguf.string()) && reparsed.architecture == "qwen2" &&
+                  reparsed.context_length == 4096,
+              "mtime change forces a re-parse");
+    }
+
+    {
+        GgufMetadataCache cache(manifest);
+        GgufMetadata meta;
+        check(r, cache.read(meta, gguf.string()) && meta.architecture == "qwen2",
+              "entry survives a restart");
+
+        check(r, !cache.read(meta, (root / "missing.gguf").string()),
+              "missing file fails cleanly");
+
+        std::ofstream(root / "not_gguf.bin", std::ios::trunc) << "plain text";
+        check(r, !cache.read(meta, (root / "not_gguf.bin").string()),
+              "non-GGUF file fails cleanly");
+    }
+
+    {
+        const fs::path watched = root / "extra";
+        fs::create_directories(watched / "sub");
+        write_gguf(watched / "a.gguf", "llama", 8192, 32);
+        write_gguf(watched / "sub" / "b.gguf", "qwen2", 4096, 28);
+
+        GgufMetadataCache cache(manifest);
+        check(r, cache.refresh_directory(watched.string()) == 2,
+              "refresh_directory records new files");
+        check(r, cache.refresh_directory(watched.string()) == 0,
+              "second pass over an unchanged tree is a no-op");
+
+        write_gguf(watched / "a.gguf", "llama", 16384, 32);
+        fs::last_write_time(watched / "a.gguf",
+                            fs::last_write_time(watched / "a.gguf") +
+                                std::chrono::seconds(5));
+        check(r, cache.refresh_directory(watched.string()) == 1,
+              "only the changed file is re-parsed");
+        GgufMetadata meta;
+        check(r, cache.read(meta, (watched / "a.gguf").string()) &&
+                  meta.context_length == 16384,
+              "refreshed record carries the new metadata");
+
+        fs::remove(watched / "sub" / "b.gguf");
+        check(r, cache.refresh_directory(watched.string()) == 1,
+              "deleted file drops its record");
+
+        // Records outside the refreshed tree stay untouched.
+        check(r, cache.read(meta, gguf.string()) && meta.architecture == "qwen2",
+              "records outside the directory survive a refresh");
+    }
+
+    fs::remove_all(root);
+
+    printf("\n%d passed, %d failed\n", r.passed, r.failed);
+    return r.failed == 0 ? 0 : 1;
+}
@@ -0,0 +1,110 @@
+// Standalone test for GGUF shard-set resolution: shard-name parsing, set
+// expansion, completeness checking, and aggregate size accounting.
+//
+// Compile: g++ -std=c++17 -I src/cpp/include test/cpp/test_gguf_shards.cpp \
+//              src/cpp/server/utils/path_utils.cpp -o test_gguf_shards
+
+#include "lemon/utils/gguf_shards.h"
+
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+namespace fs = std::filesystem;
+using lemon::utils::GgufShardName;
+using lemon::utils::gguf_shard_path;
+using lemon::utils::parse_gguf_shard_name;
+using lemon::utils::resolve_gguf_shard_set;
+
+static int g_failures = 0;
+
+static void check(const char* name, bool ok) {
+    std::printf("[%s] %s\n", ok ? "PASS" : "FAIL", name);
+    if (!ok) ++g_failures;
+}
+
+static void write_file(const fs::path& path, size_t bytes) {
+    std::ofstream out(path, std::ios::binary);
+    out << std::string(bytes, 'g');
+}
+
+static void test_parse() {
+    GgufShardName name;
+    check("parse: first shard",
+          parse_gguf_shard_name("/m/model-00001-of-00005.gguf", name) &&
+          name.prefix == "/m/model" && name.index == 1 && name.count == 5);
+    check("parse: middle shard index",
+          parse_gguf_shard_name("model-00003-of-00005.gguf", name) &&
+          name.index == 3 && name.count == 5);
+    check("parse: uppercase extension kept",
+          parse_gguf_shard_name("model-00001-of-00002.GGUF", name) &&
+          name.extension == ".GGUF");
+    check("parse: plain gguf rejected",
+          !parse_gguf_shard_name("model-q4_k_m.gguf", name));
+    check("parse: four-digit counters rejected",
+          !parse_gguf_shard_name("model-0001-of-0005.gguf", name));
+    check("parse: index past count rejected",
+          !parse_gguf_shard_name("model-00006-of-00005.gguf", name));
+    check("parse: zero index rejected",
+          !parse_gguf_shard_name("model-00000-of-00005.gguf", name));
+    check("parse: other extension rejected",
+          !parse_gguf_shard_name("model-00001-of-00005.bin", name));
+
+    parse_gguf_shard_name("/m/model-00002-of-00004.gguf", name);
+    check("parse: sibling path rebuilt",
+          gguf_shard_path(name, 4) == "/m/model-00004-of-00004.gguf");
+}
+
+static void test_resolve(const fs::path& dir) {
+    const std::string first = (dir / "big-00001-of-00003.gguf").string();
+    write_file(dir / "big-00001-of-00003.gguf", 100);
+    write_file(dir / "big-00002-of-00003.gguf", 200);
+    write_file(dir / "big-00003-of-00003.gguf", 300);
+
+    auto set = resolve_gguf_shard_set(first);
+    check("resolve: full set found", set.sharded && set.complete() &&
+          set.paths.size() == 3);
+    check("resolve: aggregate size summed", set.total_bytes == 600);
+    check("resolve: shards in order",
+          set.paths[2] == (dir / "big-00003-of-00003.gguf").string());
+
+    fs::remove(dir / "big-00002-of-00003.gguf");
+    set = resolve_gguf_shard_set(first);
+    check("resolve: missing shard detected", set.sharded && !set.complete() &&
+          set.missing.size() == 1 &&
+          set.missing[0] == (dir / "big-00002-of-00003.gguf").string());
+    check("resolve: present shards still sized", set.total_bytes == 400);
+
+    write_file(dir / "single.gguf", 50);
+    set = resolve_gguf_shard_set((dir / "single.gguf").string());
+    check("resolve: plain file is a one-element set", !set.sharded &&
+          set.complete() && set.paths.size() == 1 && set.total_bytes == 50);
+
+    set = resolve_gguf_shard_set((dir / "absent.gguf").string());
+    check("resolve: absent plain file reported missing",
+          !set.sharded && !set.complete() && set.total_bytes == 0);
+
+    set = resolve_gguf_shard_set("");
+    check("resolve: empty path yields empty set",
+          set.paths.empty() && set.complete());
+
+    write_file(dir / "solo-00001-of-00001.gguf", 10);
+    set = resolve_gguf_shard_set((dir / "solo-00001-of-00001.gguf").string());
+    check("resolve: one-of-one treated as plain file",
+          !set.sharded && set.paths.size() == 1 && set.total_bytes == 10);
+}
+
+int main() {
+    const fs::path dir =
+        fs::temp_directory_path() / "lemon_gguf_shards_test";
+    fs::remove_all(dir);
+    fs::create_directories(dir);
+
+    test_parse();
+    test_resolve(dir);
+
+    fs::remove_all(dir);
+    std::printf("%s\n", g_failures == 0 ? "ALL PASS" : "FAILURES");
+    return g_failures == 0 ? 0 : 1;
+}
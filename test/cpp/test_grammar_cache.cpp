@@ -0,0 +1,132 @@
+#include "lemon/grammar_cache.h"
+
+#include <cstdio>
+#include <string>
+
+using lemon::GrammarCache;
+using nlohmann::json;
+
+static int g_failures = 0;
+
+static void check(const char* name, bool ok) {
+    std::printf("[%s] %s\n", ok ? "PASS" : "FAIL", name);
+    if (!ok) ++g_failures;
+}
+
+static bool contains(const std::string& text, const std::string& needle) {
+    return text.find(needle) != std::string::npos;
+}
+
+static json tool_call_schema() {
+    return json{
+        {"type", "object"},
+        {"properties", {
+            {"location", {{"type", "string"}}},
+            {"unit", {{"enum", {"celsius", "fahrenheit"}}}},
+            {"days", {{"type", "integer"}}}
+        }},
+        {"required", {"location", "unit", "days"}},
+        {"additionalProperties", false}
+    };
+}
+
+static void test_strict_object_compiles() {
+    auto grammar = GrammarCache::compile(tool_call_schema());
+    check("strict tool-call schema compiles", grammar.has_value());
+    if (!grammar) return;
+    check("grammar has a root rule", contains(*grammar, "root ::= "));
+    check("property names appear as literals", contains(*grammar, "\\\"location\\\""));
+    check("enum values appear as literals",
+          contains(*grammar, "\\\"celsius\\\"") && contains(*grammar, "\\\"fahrenheit\\\""));
+    check("integer primitive pulled in", contains(*grammar, "\ninteger ::= "));
+    check("unused primitives stay out", !contains(*grammar, "\nnumber ::= "));
+}
+
+static void test_primitives_and_composites() {
+    check("bare integer compiles",
+          GrammarCache::compile(json{{"type", "integer"}}).has_value());
+
+    json array_schema = {
+        {"type", "array"},
+        {"items", {{"type", "string"}}}
+    };
+    auto arr = GrammarCache::compile(array_schema);
+    check("typed array compiles", arr.has_value());
+
+    json nullable = {{"anyOf", {json{{"type", "string"}}, json{{"type", "null"}}}}};
+    check("anyOf alternation compiles", GrammarCache::compile(nullable).has_value());
+
+    json untyped = json::object();
+    auto generic = GrammarCache::compile(untyped);
+    check("untyped schema uses generic value", generic && contains(*generic, "\nvalue ::= "));
+
+    json quoted_const = {{"const", "say \"hi\""}};
+    check("const with quotes compiles", GrammarCache::compile(quoted_const).has_value());
+}
+
+static void test_unsupported_schemas_fall_back() {
+    json optional_prop = {
+        {"type", "object"},
+        {"properties", {{"a", {{"type", "string"}}}}}
+    };
+    check("optional properties are unsupported",
+          !GrammarCache::compile(optional_prop).has_value());
+
+    json with_ref = {{"$ref", "#/definitions/foo"}};
+    check("$ref is unsupported", !GrammarCache::compile(with_ref).has_value());
+
+    json with_pattern = {{"type", "string"}, {"pattern", "^[a-z]+$"}};
+    check("pattern is unsupported", !GrammarCache::compile(with_pattern).has_value());
+
+    json open_object = {
+        {"type", "object"},
+        {"properties", {{"a", {{"type", "string"}}}}},
+        {"required", {"a"}},
+        {"additionalProperties", true}
+    };
+    check("open objects are unsupported",
+          !GrammarCache::compile(open_object).has_value());
+
+    json non_ascii_const = {{"const", "caf\xc3\xa9"}};
+    check("non-ASCII literals are unsupported",
+          !GrammarCache::compile(non_ascii_const).has_value());
+}
+
+static void test_cache_hits_and_bound() {
+    auto& cache = GrammarCache::instance();
+
+    const auto before = GrammarCache::totals();
+    json schema = tool_call_schema();
+    auto first = cache.grammar_for(schema);
+    auto second = cache.grammar_for(schema);
+    const auto after = GrammarCache::totals();
+
+    check("repeat schema is a cache hit", after.hits >= before.hits + 1);
+    check("schema compiled once", after.compiles == before.compiles + 1);
+    check("cached grammar matches compile", first && second && *first == *second);
+
+    auto unsupported = cache.grammar_for(json{{"$ref", "#"}});
+    auto unsupported_again = cache.grammar_for(json{{"$ref", "#"}});
+    const auto final_stats = GrammarCache::totals();
+    check("unsupported schemas cache their verdict",
+          !unsupported && !unsupported_again &&
+          final_stats.unsupported == after.unsupported + 1);
+
+    for (int i = 0; i < 80; ++i) {
+        cache.grammar_for(json{{"const", "filler-" + std::to_string(i)}});
+    }
+    check("cache stays bounded", cache.size() <= 64);
+}
+
+int main() {
+    test_strict_object_compiles();
+    test_primitives_and_composites();
+    test_unsupported_schemas_fall_back();
+    test_cache_hits_and_bound();
+    if (g_failures) {
+        std::printf("%d FAILURE(S)\n", g_failures);
+        return 1;
+    }
+    std::printf("ALL PASS (0 failures)\n");
+    return 0;
+}
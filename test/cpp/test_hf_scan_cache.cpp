@@ -0,0 +1,132 @@
+// Standalone test for lemon::backends::hf_cache::ScanCache.
+
+#include "lemon/backends/hf_cache_util.h"
+
+#include <chrono>
+#include <cstdio>
+#include <ctime>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <thread>
+
+using lemon::backends::hf_cache::ScanCache;
+namespace fs = std::filesystem;
+
+struct TestResult {
+    int passed = 0;
+    int failed = 0;
+
+    void ok(const std::string& name) {
+        printf("[PASS] %s\n", name.c_str());
+        ++passed;
+    }
+
+    void fail(const std::string& name) {
+        printf("[FAIL] %s\n", name.c_str());
+        ++failed;
+    }
+};
+
+static void check(TestResult& r, bool cond, const std::string& name) {
+    if (cond) {
+        r.ok(name);
+    } else {
+        r.fail(name);
+    }
+}
+
+static fs::path make_temp_dir() {
+    fs::path tmp = fs::temp_directory_path() / "hf_scan_cache_test_";
+    tmp += std::to_string(std::hash<std::string>{}(std::to_string(std::time(nullptr))));
+    fs::create_directories(tmp);
+    return tmp;
+}
+
+static void write_file(const fs::path& path, const std::string& content) {
+    fs::create_directories(path.parent_path());
+    std::ofstream out(path, std::ios::trunc | std::ios::binary);
+    out << content;
+}
+
+int main() {
+    TestResult r;
+
+    const fs::path root = make_temp_dir();
+    const fs::path manifest = root / "manifest" / "hf_scan_cache.json";
+    const fs::path tree = root / "snapshots" / "abc123";
+
+    write_file(tree / "config.json", std::string(100, 'a'));
+    write_file(tree / "weights" / "model.gguf", std::string(4000, 'b'));
+
+    {
+        ScanCache cache(manifest);
+        check(r, cache.tree_size_bytes(tree) == 4100, "full walk sums nested files");
+        check(r, cache.tree_size_bytes(tree / "config.json") == 100,
+              "plain file reports its own size");
+        check(r, cache.tree_size_bytes(root / "missing") == 0,
+              "nonexistent path reports zero");
+
+        cache.save();
+        check(r, fs::exists(manifest), "save writes the manifest");
+    }
+
+    {
+        ScanCache cache(manifest);
+        check(r, cache.tree_size_bytes(tree) == 4100,
+              "size survives a restart via the manifest");
+
+        // Ensure the directory mtime moves past filesystem timestamp
+        // granularity before mutating the tree.
+        std::this_thread::sleep_for(std::chrono::milliseconds(1100));
+        write_file(tree / "tokenizer.json", std::string(50, 'c'));
+        check(r, cache.tree_size_bytes(tree) == 4150,
+              "top-level change invalidates the fingerprint");
+
+        // Rewriting a deep file in place leaves every top-level mtime alone -
+        // the documented blind spot: the cached size is served until an
+        // explicit invalidate.
+        std::this_thread::sleep_for(std::chrono::milliseconds(1100));
+        write_file(tree / "weights" / "model.gguf", std::string(4025, 'd'));
+        check(r, cache.tree_size_bytes(tree) == 4150,
+              "deep-only change keeps the cached size");
+
+        cache.invalidate(tree);
+        check(r, cache.tree_size_bytes(tree) == 4175,
+              "invalidate forces a rescan");
+        cache.save();
+    }
+
+    {
+        write_file(manifest, "{not json");
+        ScanCache cache(manifest);
+        check(r, cache.tree_size_bytes(tree) == 4175,
+              "corrupt manifest is discarded and rebuilt");
+        cache.save();
+
+        std::ifstream in(manifest);
+        std::string contents((std::istreambuf_iterator<char>(in)),
+                             std::istreambuf_iterator<char>());
+        check(r, contents.find("\"version\"") != std::string::npos,
+              "save rewrites a valid manifest");
+    }
+
+    {
+        ScanCache cache(manifest);
+        (void)cache.tree_size_bytes(tree);
+        fs::remove_all(tree);
+        cache.invalidate(tree);
+        cache.save();
+
+        std::ifstream in(manifest);
+        std::string contents((std::istreambuf_iterator<char>(in)),
+                             std::istreambuf_iterator<char>());
+        check(r, contents.find("abc123") == std::string::npos,
+              "deleted trees are pruned from the manifest");
+    }
+
+    fs::remove_all(root);
+
+    printf("\n%d passed, %d failed\n", r.passed, r.failed);
+    return r.failed == 0 ? 0 : 1;
+}
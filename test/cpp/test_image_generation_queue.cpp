@@ -0,0 +1,172 @@
+// Standalone test for the image generation admission queue.
+//
+// Compile: g++ -std=c++17 -I src/cpp/include test/cpp/test_image_generation_queue.cpp
+//   src/cpp/server/image_generation_queue.cpp -o test_image_generation_queue -pthread
+
+#include "lemon/image_generation_queue.h"
+
+#include <chrono>
+#include <cstdio>
+#include <thread>
+#include <vector>
+
+using lemon::ImageGenerationQueue;
+using std::chrono::milliseconds;
+
+static int g_failures = 0;
+
+static void check(const char* name, bool ok) {
+    std::printf("[%s] %s\n", ok ? "PASS" : "FAIL", name);
+    if (!ok) ++g_failures;
+}
+
+static void test_fifo_order() {
+    ImageGenerationQueue queue;
+    auto a = queue.enqueue(0, "512x512");
+    auto b = queue.enqueue(0, "512x512");
+    auto c = queue.enqueue(0, "512x512");
+
+    check("first ticket runs immediately", a->running);
+    check("second ticket waits at position 1", queue.position(b) == 1);
+    check("third ticket waits at position 2", queue.position(c) == 2);
+
+    queue.complete(a, "", milliseconds(0));
+    check("completion promotes the next ticket in order",
+          b->running && !c->running);
+    queue.complete(b, "", milliseconds(0));
+    check("queue drains in order", c->running);
+    queue.complete(c, "", milliseconds(0));
+    check("drained queue is empty", queue.depth() == 0);
+}
+
+static void test_priority_order() {
+    ImageGenerationQueue queue;
+    auto running = queue.enqueue(0, "512x512");
+    auto low = queue.enqueue(0, "512x512");
+    auto high = queue.enqueue(5, "512x512");
+
+    check("higher priority ranks ahead of earlier arrival",
+          queue.position(high) == 1 && queue.position(low) == 2);
+    queue.complete(running, "", milliseconds(0));
+    check("higher priority is scheduled first", high->running && !low->running);
+}
+
+static void test_resolution_affinity() {
+    ImageGenerationQueue queue;
+    auto running = queue.enqueue(0, "512x512");
+    auto other = queue.enqueue(0, "1024x1024");
+    auto same = queue.enqueue(0, "512x512");
+
+    queue.complete(running, "", milliseconds(0));
+    check("same-resolution ticket within the window jumps ahead",
+          same->running && !other->running);
+    queue.complete(same, "", milliseconds(0));
+    check("remaining ticket runs afterwards", other->running);
+}
+
+static void test_affinity_does_not_starve() {
+    ImageGenerationQueue queue;
+    auto running = queue.enqueue(0, "512x512");
+    auto odd = queue.enqueue(0, "1024x1024");
+    std::vector<std::shared_ptr<ImageGenerationQueue::Ticket>> same;
+    for (int i = 0; i < 8; ++i) {
+        same.push_back(queue.enqueue(0, "512x512"));
+    }
+
+    queue.complete(running, "", milliseconds(0));
+    int generations_before_odd = 0;
+    while (!odd->running && generations_before_odd < 20) {
+        ++generations_before_odd;
+        for (auto& ticket : same) {
+            if (ticket->running) {
+                queue.complete(ticket, "", milliseconds(0));
+                break;
+            }
+        }
+    }
+    check("odd resolution is scheduled within the affinity window",
+          odd->running && generations_before_odd <= 5);
+}
+
+static void test_cancel() {
+    ImageGenerationQueue queue;
+    auto running = queue.enqueue(0, "512x512");
+    auto waiting = queue.enqueue(0, "512x512");
+    auto last = queue.enqueue(0, "512x512");
+
+    queue.cancel(waiting);
+    check("cancelled ticket leaves the queue", queue.depth() == 2);
+    check("cancel is recorded on the ticket", waiting->cancelled);
+    queue.complete(running, "", milliseconds(0));
+    check("cancelled ticket is skipped", last->running && !waiting->running);
+
+    queue.cancel(last);
+    check("a running ticket cannot be cancelled",
+          last->running && !last->cancelled);
+}
+
+static void test_wait_for_turn_blocks_and_wakes() {
+    ImageGenerationQueue queue;
+    auto running = queue.enqueue(0, "512x512");
+    auto waiting = queue.enqueue(0, "512x512");
+
+    check("wait_for_turn times out while busy",
+          !queue.wait_for_turn(waiting, milliseconds(30)));
+
+    std::thread releaser([&queue, &running] {
+        std::this_thread::sleep_for(milliseconds(30));
+        queue.complete(running, "", milliseconds(0));
+    });
+    check("wait_for_turn wakes when the slot frees",
+          queue.wait_for_turn(waiting, milliseconds(2000)));
+    releaser.join();
+
+    auto cancelled = queue.enqueue(0, "512x512");
+    std::thread canceller([&queue, &cancelled] {
+        std::this_thread::sleep_for(milliseconds(30));
+        queue.cancel(cancelled);
+    });
+    check("wait_for_turn returns false for a cancelled ticket",
+          !queue.wait_for_turn(cancelled, milliseconds(2000)));
+    canceller.join();
+}
+
+static void test_duration_estimates() {
+    ImageGenerationQueue queue;
+    check("no estimate before any completion",
+          queue.estimated_fraction("512x512@20", milliseconds(5000)) < 0.0);
+
+    auto first = queue.enqueue(0, "512x512");
+    queue.complete(first, "512x512@20", milliseconds(10000));
+
+    const double halfway = queue.estimated_fraction("512x512@20", milliseconds(5000));
+    check("estimate reflects recorded duration",
+          halfway > 0.45 && halfway < 0.55);
+    check("estimate is clamped below completion",
+          queue.estimated_fraction("512x512@20", milliseconds(60000)) <= 0.95);
+    check("other keys have no estimate",
+          queue.estimated_fraction("1024x1024@20", milliseconds(5000)) < 0.0);
+
+    auto second = queue.enqueue(0, "512x512");
+    queue.complete(second, "512x512@20", milliseconds(20000));
+    const double blended = queue.estimated_fraction("512x512@20", milliseconds(13000));
+    check("estimate blends toward recent durations",
+          blended > 0.90 && blended <= 0.95);
+}
+
+int main() {
+    test_fifo_order();
+    test_priority_order();
+    test_resolution_affinity();
+    test_affinity_does_not_starve();
+    test_cancel();
+    test_wait_for_turn_blocks_and_wakes();
+    test_duration_estimates();
+
+    if (g_failures > 0) {
+        std::printf("%d check(s) failed\n", g_failures);
+        return 1;
+    }
+    std::printf("All checks passed\n");
+    return 0;
+}
@@ -0,0 +1,116 @@
+// Inline image canonicalization: data URI rewrite, cache hits, header probes.
+
+#include "lemon/image_part_cache.h"
+
+#include <cstdio>
+#include <string>
+
+#include <nlohmann/json.hpp>
+
+using json = nlohmann::json;
+using lemon::ImagePartCache;
+
+static int g_failures = 0;
+
+static void check(const char* name, bool ok) {
+    std::printf("[%s] %s\n", ok ? "PASS" : "FAIL", name);
+    if (!ok) {
+        ++g_failures;
+    }
+}
+
+// 1x1 transparent PNG.
+static const char* kPngBase64 =
+    "iVBORw0KGgoAAAANSUhEUgAAAAEAAAABCAYAAAAfFcSJAAAADUlEQVR42mNk"
+    "YPhfDwAChwGA60e6kgAAAABJRU5ErkJggg==";
+
+static json chat_request(const std::string& url) {
+    return json{
+        {"model", "test"},
+        {"messages", json::array({
+            {{"role", "user"},
+             {"content", json::array({
+                 {{"type", "text"}, {"text", "what is this?"}},
+                 {{"type", "image_url"}, {"image_url", {{"url", url}}}},
+             })}},
+        })},
+    };
+}
+
+static std::string part_url(const json& request) {
+    return request["messages"][0]["content"][1]["image_url"]["url"].get<std::string>();
+}
+
+static void test_canonicalization_and_hits() {
+    ImagePartCache cache(1024 * 1024);
+
+    // Wrong mime label and wrapped base64, as agents commonly resend them.
+    std::string wrapped(kPngBase64);
+    wrapped.insert(20, "\n");
+    json first = chat_request("data:image/jpeg;base64," + wrapped);
+    check("mislabeled wrapped image rewritten", cache.preprocess_chat_request(first));
+    const std::string canonical = part_url(first);
+    check("mime corrected from magic bytes",
+          canonical.rfind("data:image/png;base64,", 0) == 0);
+    check("whitespace stripped", canonical.find('\n') == std::string::npos);
+
+    json resent_original = chat_request("data:image/jpeg;base64," + wrapped);
+    check("resent original rewritten from cache",
+          cache.preprocess_chat_request(resent_original));
+    check("cache replays identical bytes", part_url(resent_original) == canonical);
+
+    json resent_canonical = chat_request(canonical);
+    check("canonical resend left unchanged",
+          !cache.preprocess_chat_request(resent_canonical));
+
+    const auto totals = cache.totals();
+    check("three images observed", totals.images == 3);
+    check("two cache hits", totals.hits == 2);
+    check("one miss", totals.misses == 1);
+}
+
+static void test_passthrough() {
+    ImagePartCache cache(1024 * 1024);
+
+    json http_url = chat_request("https://example.com/cat.png");
+    check("http urls untouched", !cache.preprocess_chat_request(http_url));
+
+    json garbage = chat_request("data:image/png;base64,bm90IGFuIGltYWdl");
+    check("undecodable payload untouched", !cache.preprocess_chat_request(garbage));
+    check("rejection counted", cache.totals().rejected == 1);
+
+    json no_images = json{{"model", "test"},
+                          {"messages", json::array({{{"role", "user"},
+                                                     {"content", "plain text"}}})}};
+    check("text-only request untouched", !cache.preprocess_chat_request(no_images));
+}
+
+static void test_dimension_probes() {
+    int w = 0, h = 0;
+    const std::string png =
+        std::string("\x89PNG\r\n\x1a\n", 8) + std::string(8, '\0') +
+        std::string("\x00\x00\x01\x40", 4) + std::string("\x00\x00\x00\xf0", 4);
+    check("png dimensions", ImagePartCache::probe_dimensions(png, "image/png", w, h) &&
+                                w == 320 && h == 240);
+
+    const std::string gif = std::string("GIF89a") +
+        std::string("\x40\x01\xf0\x00", 4);
+    check("gif dimensions", ImagePartCache::probe_dimensions(gif, "image/gif", w, h) &&
+                                w == 320 && h == 240);
+
+    check("truncated header rejected",
+          !ImagePartCache::probe_dimensions("GIF89a", "image/gif", w, h));
+}
+
+int main() {
+    test_canonicalization_and_hits();
+    test_passthrough();
+    test_dimension_probes();
+
+    if (g_failures != 0) {
+        std::printf("%d check(s) failed\n", g_failures);
+        return 1;
+    }
+    std::printf("All image part cache checks passed\n");
+    return 0;
+}
@@ -0,0 +1,92 @@
+// Image result store: content-addressed keys, dedup, round-trip, eviction.
+
+#include "lemon/image_result_store.h"
+
+#include <cstdio>
+#include <filesystem>
+#include <string>
+
+namespace fs = std::filesystem;
+
+using lemon::ImageResultStore;
+
+static int g_failures = 0;
+
+static void check(const char* name, bool ok) {
+    std::printf("[%s] %s\n", ok ? "PASS" : "FAIL", name);
+    if (!ok) {
+        ++g_failures;
+    }
+}
+
+static size_t entry_count(const std::string& dir) {
+    size_t count = 0;
+    std::error_code ec;
+    for (const auto& entry :
+         fs::directory_iterator(fs::path(dir) / "image-results", ec)) {
+        if (entry.is_regular_file()) {
+            ++count;
+        }
+    }
+    return count;
+}
+
+static void test_store_and_lookup(const std::string& dir) {
+    ImageResultStore store(dir);
+    const std::string png(2048, 'p');
+
+    const std::string key = store.store(png, "png");
+    check("store returns a 32-hex content key",
+          key.size() == 32 && key.find_first_not_of("0123456789abcdef") ==
+              std::string::npos);
+
+    std::string format;
+    std::string bytes;
+    check("lookup round-trips the bytes",
+          store.lookup(key, format, bytes) && bytes == png);
+    check("lookup reports the stored format", format == "png");
+
+    check("unknown key misses", !store.lookup(std::string(32, '0'), format, bytes));
+    check("empty payload is rejected", store.store("", "png").empty());
+}
+
+static void test_dedup(const std::string& dir) {
+    ImageResultStore store(dir);
+    const std::string png(1024, 'x');
+
+    const std::string first = store.store(png, "png");
+    const std::string second = store.store(png, "png");
+    check("identical bytes map to the same key", !first.empty() && first == second);
+    check("identical bytes keep one file on disk", entry_count(dir) == 1);
+
+    const std::string other = store.store(std::string(1024, 'y'), "png");
+    check("different bytes map to a different key", other != first);
+}
+
+static void test_eviction(const std::string& dir) {
+    ImageResultStore store(dir, 4096);
+    for (int i = 0; i < 8; ++i) {
+        store.store(std::string(1024, static_cast<char>('a' + i)), "png");
+    }
+    check("evicts down to the size bound", store.size_bytes() <= 4096);
+    check("newest entries survive eviction", entry_count(dir) > 0);
+}
+
+int main() {
+    const fs::path base = fs::temp_directory_path() / "lemon-image-result-test";
+    fs::remove_all(base);
+    fs::create_directories(base);
+
+    test_store_and_lookup((base / "roundtrip").string());
+    test_dedup((base / "dedup").string());
+    test_eviction((base / "evict").string());
+
+    fs::remove_all(base);
+
+    if (g_failures != 0) {
+        std::printf("%d check(s) failed\n", g_failures);
+        return 1;
+    }
+    std::printf("All image result store checks passed\n");
+    return 0;
+}
@@ -0,0 +1,111 @@
+// Adaptive jitter buffer: pass-through convergence, depth under jitter,
+// late-frame accounting, flush and reset behavior.
+
+#include "lemon/jitter_buffer.h"
+
+#include <cstdio>
+#include <vector>
+
+using lemon::JitterBuffer;
+
+static int g_failures = 0;
+
+static void check(const char* name, bool ok) {
+    std::printf("[%s] %s\n", ok ? "PASS" : "FAIL", name);
+    if (!ok) {
+        ++g_failures;
+    }
+}
+
+static std::vector<int16_t> frame_of(size_t samples, int16_t value) {
+    return std::vector<int16_t>(samples, value);
+}
+
+static void test_steady_cadence_is_pass_through() {
+    JitterBuffer buffer;
+    std::vector<int16_t> out;
+    const auto frame = frame_of(1600, 1);  // 100 ms at 16 kHz
+
+    bool pass_through = true;
+    for (int i = 0; i < 20; ++i) {
+        buffer.push(frame.data(), frame.size(), 1000 + i * 100);
+        out.clear();
+        pass_through = pass_through && buffer.pull_ready(out) == frame.size();
+    }
+    check("steady cadence releases every frame immediately", pass_through);
+    check("steady cadence keeps target depth at zero",
+          buffer.target_depth_ms() == 0);
+    check("steady cadence keeps nothing queued", buffer.queued_ms() == 0);
+}
+
+static void test_jittery_arrivals_build_depth() {
+    JitterBuffer buffer;
+    std::vector<int16_t> out;
+    const auto frame = frame_of(1600, 1);
+
+    // Alternate 20 ms / 180 ms gaps: same average cadence, high variance.
+    int64_t now = 1000;
+    for (int i = 0; i < 40; ++i) {
+        now += (i % 2 == 0) ? 20 : 180;
+        buffer.push(frame.data(), frame.size(), now);
+        buffer.pull_ready(out);
+    }
+    check("jittery arrivals raise the target depth",
+          buffer.target_depth_ms() > 0);
+    check("jittery arrivals hold audio back", buffer.queued_ms() > 0);
+    check("held audio stays below the configured ceiling",
+          buffer.target_depth_ms() <= 320);
+}
+
+static void test_late_frame_accounting() {
+    JitterBuffer buffer;
+    std::vector<int16_t> out;
+    const auto frame = frame_of(1600, 1);
+
+    for (int i = 0; i < 10; ++i) {
+        buffer.push(frame.data(), frame.size(), 1000 + i * 100);
+        buffer.pull_ready(out);
+    }
+    const uint64_t late_before = JitterBuffer::totals().late_frames;
+    buffer.push(frame.data(), frame.size(), 1000 + 9 * 100 + 1000);
+    check("a frame arriving far past cadence counts as late",
+          JitterBuffer::totals().late_frames == late_before + 1);
+}
+
+static void test_flush_and_reset() {
+    JitterBuffer buffer;
+    std::vector<int16_t> out;
+    const auto frame = frame_of(800, 7);
+
+    int64_t now = 1000;
+    for (int i = 0; i < 20; ++i) {
+        now += (i % 2 == 0) ? 10 : 190;
+        buffer.push(frame.data(), frame.size(), now);
+        buffer.pull_ready(out);
+    }
+    out.clear();
+    const size_t queued = static_cast<size_t>(buffer.queued_ms()) * 16;
+    check("flush returns exactly what was queued",
+          buffer.flush(out) == queued && out.size() == queued);
+    check("flush empties the queue", buffer.queued_ms() == 0);
+
+    buffer.push(frame.data(), frame.size(), now + 10);
+    buffer.reset();
+    out.clear();
+    check("reset drops queued audio", buffer.flush(out) == 0);
+    check("reset clears the jitter estimate", buffer.target_depth_ms() == 0);
+}
+
+int main() {
+    test_steady_cadence_is_pass_through();
+    test_jittery_arrivals_build_depth();
+    test_late_frame_accounting();
+    test_flush_and_reset();
+
+    if (g_failures != 0) {
+        std::printf("%d check(s) failed\n", g_failures);
+        return 1;
+    }
+    std::printf("All jitter buffer checks passed\n");
+    return 0;
+}
@@ -107,12 +107,37 @@ static void test_syntax_check() {
     check("syntax: empty ok", check_expression_syntax("").empty());
 }
 
+static void test_compiled_form() {
+    const auto compiled = CompiledExpr::compile("${count} < ${limit}");
+    check("compiled: true under first context",
+          compiled.eval({{"count", 3}, {"limit", 10}}));
+    check("compiled: false under changed context",
+          !compiled.eval({{"count", 10}, {"limit", 10}}));
+    check("compiled: empty expression is true", CompiledExpr::compile("").eval(json::object()));
+
+    bool syntax_threw = false;
+    try {
+        CompiledExpr::compile("1 +");
+    } catch (const JobError& e) {
+        syntax_threw = e.status == 400;
+    }
+    check("compiled: syntax error thrown at compile time", syntax_threw);
+
+    // Same expression text through the cached path: results track the
+    // context and eval-time errors recur on every evaluation.
+    check("cached: result follows context", eval_condition("${n} > 1", {{"n", 2}}));
+    check("cached: result follows context flip", !eval_condition("${n} > 1", {{"n", 0}}));
+    check("cached: missing ref still throws per eval", threw("${n} > 1", json::object()));
+    check("cached: works again after eval error", eval_condition("${n} > 1", {{"n", 5}}));
+}
+
 int main() {
     test_reference_resolution();
     test_arithmetic_and_precedence();
     test_comparison_and_boolean();
     test_truthiness_and_edges();
     test_syntax_check();
+    test_compiled_form();
     if (g_failures) {
         std::printf("%d FAILURE(S)\n", g_failures);
         return 1;
@@ -98,6 +98,78 @@ static void test_invalid_graphs() {
           validate_steps(dotted, kOps).find("'.'") != std::string::npos);
 }
 
+static StepRecord grouped(const std::string& id, const std::string& op,
+                          const std::string& group) {
+    StepRecord s = step(id, op);
+    s.group = group;
+    return s;
+}
+
+static void test_parallel_groups() {
+    std::vector<StepRecord> ok = {step("setup", "load"), grouped("a", "chat", "evals"),
+                                  grouped("b", "chat", "evals"), step("teardown", "unload")};
+    check("group: contiguous group ok", validate_steps(ok, kOps).empty());
+
+    std::vector<StepRecord> gap = {grouped("a", "chat", "evals"), step("x", "system_info"),
+                                   grouped("b", "chat", "evals")};
+    check("group: non-contiguous group rejected",
+          validate_steps(gap, kOps).find("contiguous") != std::string::npos);
+
+    std::vector<StepRecord> branched = {grouped("a", "chat", "evals"),
+                                        grouped("b", "chat", "evals"), step("c", "unload")};
+    branched[0].on_done = "c";
+    check("group: on_done from a member rejected",
+          validate_steps(branched, kOps).find("on_done") != std::string::npos);
+
+    std::vector<StepRecord> failgoto = {grouped("a", "chat", "evals"),
+                                        grouped("b", "chat", "evals"), step("c", "unload")};
+    failgoto[0].on_fail = "c";
+    check("group: on_fail goto from a member rejected",
+          !validate_steps(failgoto, kOps).empty());
+
+    std::vector<StepRecord> cont = {grouped("a", "chat", "evals"),
+                                    grouped("b", "chat", "evals")};
+    cont[0].on_fail = kOnFailContinue;
+    check("group: on_fail continue allowed", validate_steps(cont, kOps).empty());
+
+    std::vector<StepRecord> into = {step("pre", "load"), grouped("a", "chat", "evals"),
+                                    grouped("b", "chat", "evals")};
+    into[0].on_done = "b";
+    check("group: jump into the middle of a group rejected",
+          validate_steps(into, kOps).find("middle") != std::string::npos);
+    into[0].on_done = "a";
+    check("group: jump to the first member allowed", validate_steps(into, kOps).empty());
+
+    std::vector<StepRecord> dep = {grouped("a", "chat", "evals"),
+                                   grouped("b", "chat", "evals")};
+    dep[1].params = {{"messages", "${a.choices}"}};
+    check("group: sibling data dependency rejected",
+          validate_steps(dep, kOps).find("independent") != std::string::npos);
+
+    std::vector<StepRecord> outer_ref = {step("seed", "chat"), grouped("a", "chat", "evals"),
+                                         grouped("b", "chat", "evals")};
+    outer_ref[2].params = {{"messages", "${seed.choices}"}, {"model", "${inputs.model}"}};
+    check("group: refs to earlier steps and inputs allowed",
+          validate_steps(outer_ref, kOps).empty());
+
+    std::vector<StepRecord> wide = {grouped("a", "chat", "evals"),
+                                    grouped("b", "chat", "evals")};
+    wide[0].width = 99;
+    check("group: out-of-range width rejected",
+          validate_steps(wide, kOps).find("width") != std::string::npos);
+
+    std::vector<StepRecord> stray = {step("a", "chat")};
+    stray[0].width = 4;
+    check("group: width outside a group rejected",
+          validate_steps(stray, kOps).find("width") != std::string::npos);
+
+    StepRecord roundtrip = grouped("a", "chat", "evals");
+    roundtrip.width = 8;
+    StepRecord back = StepRecord::from_json(roundtrip.to_json());
+    check("group: group and width survive json round-trip",
+          back.group == "evals" && back.width == 8);
+}
+
 static void test_json_roundtrip() {
     Job j;
     j.id = "job-1";
@@ -136,6 +208,7 @@ static void test_json_roundtrip() {
 int main() {
     test_valid_graphs();
     test_invalid_graphs();
+    test_parallel_groups();
     test_json_roundtrip();
     if (g_failures) {
         std::printf("%d FAILURE(S)\n", g_failures);
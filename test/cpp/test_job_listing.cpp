@@ -0,0 +1,190 @@
+#include "lemon/jobs/job_manager.h"
+#include "lemon/jobs/job_ops.h"
+#include "lemon/jobs/job_types.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace fs = std::filesystem;
+using namespace lemon::jobs;
+
+static int g_failures = 0;
+
+static void check(const char* name, bool ok) {
+    std::printf("[%s] %s\n", ok ? "PASS" : "FAIL", name);
+    if (!ok) ++g_failures;
+}
+
+static std::atomic<bool> g_gate{false};
+
+static fs::path make_temp_dir(const std::string& tag) {
+    const auto stamp = std::chrono::steady_clock::now().time_since_epoch().count();
+    fs::path dir = fs::temp_directory_path()
+                   / ("lemonade-job-list-" + tag + "-" + std::to_string(stamp));
+    fs::create_directories(dir);
+    return dir;
+}
+
+static OpRegistry make_registry() {
+    OpRegistry reg;
+    reg.register_op("gate", {[](const json&, const json&, CancelFlag& cancel) -> json {
+        while (!g_gate.load() && !cancel.load())
+            std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        return json::object();
+    }});
+    reg.register_op("emit", {[](const json& params, const json&, CancelFlag&) -> json {
+        return params;
+    }});
+    return reg;
+}
+
+static StepRecord step(const std::string& id, const std::string& op, json params) {
+    StepRecord s;
+    s.id = id;
+    s.op = op;
+    s.params = std::move(params);
+    return s;
+}
+
+static JobManager::JobSpec spec(const std::string& name, const std::string& op) {
+    JobManager::JobSpec s;
+    s.name = name;
+    s.steps.push_back(step("s", op, json::object()));
+    s.inputs = json::object();
+    return s;
+}
+
+static bool wait_status(JobManager& mgr, const std::string& id, const std::string& want,
+                        int timeout_ms = 5000) {
+    for (int i = 0; i < timeout_ms / 10; ++i) {
+        const auto j = mgr.get(id);
+        if (j && (*j)["status"] == want) return true;
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    return false;
+}
+
+static void test_bulk_create() {
+    const fs::path dir = make_temp_dir("bulk");
+    {
+        JobManager mgr(dir.string(), make_registry());
+
+        std::vector<JobManager::JobSpec> specs;
+        for (int i = 0; i < 5; ++i) specs.push_back(spec("bulk-" + std::to_string(i), "emit"));
+        const auto ids = mgr.create_many(std::move(specs));
+        check("bulk: one id per spec", ids.size() == 5);
+        check("bulk: ids ascend in spec order",
+              std::is_sorted(ids.begin(), ids.end()) && ids.front() < ids.back());
+        bool all_done = true;
+        for (const auto& id : ids) all_done = all_done && wait_status(mgr, id, "completed");
+        check("bulk: every job runs", all_done);
+
+        std::vector<JobManager::JobSpec> bad;
+        bad.push_back(spec("ok", "emit"));
+        bad.push_back(spec("bad", "no-such-op"));
+        bool rejected = false;
+        std::string message;
+        try {
+            mgr.create_many(std::move(bad));
+        } catch (const JobError& e) {
+            rejected = e.status == 400;
+            message = e.what();
+        }
+        check("bulk: invalid spec rejects the whole batch", rejected);
+        check("bulk: error names the offending index",
+              message.find("jobs[1]") != std::string::npos);
+        check("bulk: nothing from the failed batch was admitted",
+              mgr.list().size() == 5);
+
+        bool over_cap = false;
+        try {
+            mgr.create_many(std::vector<JobManager::JobSpec>(100, spec("flood", "emit")));
+        } catch (const JobError& e) {
+            over_cap = e.status == 429;
+        }
+        check("bulk: oversized batch rejected with 429", over_cap);
+    }
+    fs::remove_all(dir);
+}
+
+static void test_pagination_and_filters() {
+    const fs::path dir = make_temp_dir("page");
+    {
+        JobManager mgr(dir.string(), make_registry());
+        g_gate = false;
+
+        std::vector<JobManager::JobSpec> specs;
+        for (int i = 0; i < 6; ++i) specs.push_back(spec("done-" + std::to_string(i), "emit"));
+        const auto done_ids = mgr.create_many(std::move(specs));
+        for (const auto& id : done_ids) wait_status(mgr, id, "completed");
+        const std::string runner =
+            mgr.create("runner", {step("hold", "gate", json::object())}, json::object());
+        check("page: runner running", wait_status(mgr, runner, "running"));
+
+        JobManager::ListQuery q;
+        q.limit = 4;
+        const json page1 = mgr.list(q);
+        check("page: first page is full", page1["jobs"].size() == 4);
+        check("page: has_more set mid-history", page1["has_more"] == true);
+        check("page: newest job first", page1["jobs"][0]["id"] == runner);
+
+        q.after = page1["next_cursor"].get<std::string>();
+        const json page2 = mgr.list(q);
+        check("page: second page has the remainder", page2["jobs"].size() == 3);
+        check("page: has_more clear at the end", page2["has_more"] == false);
+
+        std::set<std::string> seen;
+        for (const auto& j : page1["jobs"]) seen.insert(j["id"].get<std::string>());
+        for (const auto& j : page2["jobs"]) seen.insert(j["id"].get<std::string>());
+        check("page: pages cover every job exactly once", seen.size() == 7);
+
+        JobManager::ListQuery by_status;
+        by_status.status = "completed";
+        const json completed = mgr.list(by_status);
+        check("filter: completed jobs only", completed["jobs"].size() == 6);
+        by_status.status = "running";
+        const json running = mgr.list(by_status);
+        check("filter: running matches the gate job",
+              running["jobs"].size() == 1 && running["jobs"][0]["id"] == runner);
+        by_status.status = "bogus";
+        bool rejected = false;
+        try {
+            mgr.list(by_status);
+        } catch (const JobError& e) {
+            rejected = e.status == 400;
+        }
+        check("filter: unknown status rejected", rejected);
+
+        JobManager::ListQuery fields;
+        fields.fields = {"status"};
+        fields.limit = 2;
+        const json trimmed = mgr.list(fields);
+        bool only_fields = trimmed["jobs"].size() == 2;
+        for (const auto& j : trimmed["jobs"])
+            only_fields = only_fields && j.size() == 2 && j.contains("id") && j.contains("status");
+        check("fields: summaries trimmed to id + requested keys", only_fields);
+
+        g_gate = true;
+        wait_status(mgr, runner, "completed");
+        by_status.status = "running";
+        check("filter: index follows status changes", mgr.list(by_status)["jobs"].empty());
+    }
+    fs::remove_all(dir);
+}
+
+int main() {
+    test_bulk_create();
+    test_pagination_and_filters();
+    if (g_failures) {
+        std::printf("%d FAILURE(S)\n", g_failures);
+        return 1;
+    }
+    std::printf("ALL PASS (0 failures)\n");
+    return 0;
+}
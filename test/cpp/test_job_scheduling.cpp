@@ -0,0 +1,181 @@
+#include "lemon/jobs/job_manager.h"
+#include "lemon/jobs/job_ops.h"
+#include "lemon/jobs/job_types.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <ctime>
+#include <filesystem>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace fs = std::filesystem;
+using namespace lemon::jobs;
+
+static int g_failures = 0;
+
+static void check(const char* name, bool ok) {
+    std::printf("[%s] %s\n", ok ? "PASS" : "FAIL", name);
+    if (!ok) ++g_failures;
+}
+
+static std::atomic<bool> g_gate{false};
+static std::mutex g_order_mutex;
+static std::vector<std::string> g_order;
+
+static fs::path make_temp_dir(const std::string& tag) {
+    const auto stamp = std::chrono::steady_clock::now().time_since_epoch().count();
+    fs::path dir = fs::temp_directory_path()
+                   / ("lemonade-job-sched-" + tag + "-" + std::to_string(stamp));
+    fs::create_directories(dir);
+    return dir;
+}
+
+static OpRegistry make_registry() {
+    OpRegistry reg;
+    reg.register_op("gate", {[](const json&, const json&, CancelFlag& cancel) -> json {
+        while (!g_gate.load() && !cancel.load())
+            std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        return json::object();
+    }});
+    reg.register_op("mark", {[](const json& params, const json&, CancelFlag&) -> json {
+        std::lock_guard<std::mutex> lock(g_order_mutex);
+        g_order.push_back(params.value("tag", ""));
+        return json::object();
+    }});
+    return reg;
+}
+
+static StepRecord step(const std::string& id, const std::string& op, json params) {
+    StepRecord s;
+    s.id = id;
+    s.op = op;
+    s.params = std::move(params);
+    return s;
+}
+
+static bool wait_status(JobManager& mgr, const std::string& id, const std::string& want,
+                        int timeout_ms = 5000) {
+    for (int i = 0; i < timeout_ms / 10; ++i) {
+        const auto j = mgr.get(id);
+        if (j && (*j)["status"] == want) return true;
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    return false;
+}
+
+static int now_minutes() {
+    const std::time_t t = std::time(nullptr);
+    std::tm tm_local{};
+#ifdef _WIN32
+    localtime_s(&tm_local, &t);
+#else
+    localtime_r(&t, &tm_local);
+#endif
+    return tm_local.tm_hour * 60 + tm_local.tm_min;
+}
+
+static std::string hhmm(int minutes) {
+    minutes = ((minutes % 1440) + 1440) % 1440;
+    char buf[8];
+    std::snprintf(buf, sizeof(buf), "%02d:%02d", minutes / 60, minutes % 60);
+    return buf;
+}
+
+static void test_priority_order() {
+    const fs::path dir = make_temp_dir("priority");
+    {
+        JobManager mgr(dir.string(), make_registry());
+        g_gate = false;
+        g_order.clear();
+
+        const std::string blocker =
+            mgr.create("blocker", {step("hold", "gate", json::object())}, json::object());
+        check("priority: blocker running", wait_status(mgr, blocker, "running"));
+
+        const std::string low =
+            mgr.create("low", {step("m", "mark", {{"tag", "low"}})}, json::object());
+        const std::string high =
+            mgr.create("high", {step("m", "mark", {{"tag", "high"}})}, json::object(), 5);
+        g_gate = true;
+
+        check("priority: low-priority job completes", wait_status(mgr, low, "completed"));
+        check("priority: high-priority job completes", wait_status(mgr, high, "completed"));
+        {
+            std::lock_guard<std::mutex> lock(g_order_mutex);
+            check("priority: higher priority ran first",
+                  g_order.size() == 2 && g_order[0] == "high" && g_order[1] == "low");
+        }
+        const auto j = mgr.get(high);
+        check("priority: priority survives in the record", j && (*j)["priority"] == 5);
+    }
+    fs::remove_all(dir);
+}
+
+static void test_execution_window() {
+    const fs::path dir = make_temp_dir("window");
+    {
+        JobManager mgr(dir.string(), make_registry());
+        const int now = now_minutes();
+
+        const std::string closed = hhmm(now + 60) + "-" + hhmm(now + 120);
+        const std::string deferred = mgr.create(
+            "deferred", {step("m", "mark", {{"tag", "deferred"}})}, json::object(), 0, closed);
+
+        const std::string open = hhmm(now - 60) + "-" + hhmm(now + 60);
+        const std::string eligible = mgr.create(
+            "eligible", {step("m", "mark", {{"tag", "eligible"}})}, json::object(), 0, open);
+
+        check("window: job inside its window runs", wait_status(mgr, eligible, "completed"));
+        std::this_thread::sleep_for(std::chrono::milliseconds(200));
+        const auto j = mgr.get(deferred);
+        check("window: job outside its window stays queued",
+              j && (*j)["status"] == "queued");
+        check("window: window survives in the record", j && (*j)["window"] == closed);
+
+        // The wrap form of the same closed interval stays closed, and the
+        // wrap form spanning midnight around now counts as open.
+        const std::string wrap_open = hhmm(now + 720) + "-" + hhmm(now + 60);
+        const std::string wrapped = mgr.create(
+            "wrapped", {step("m", "mark", {{"tag", "wrapped"}})}, json::object(), 0, wrap_open);
+        check("window: overnight window spanning now runs",
+              wait_status(mgr, wrapped, "completed"));
+
+        bool active = false;
+        check("window: waiting job can be deleted", mgr.remove(deferred, active) && !active);
+    }
+    fs::remove_all(dir);
+}
+
+static void test_invalid_windows() {
+    const fs::path dir = make_temp_dir("invalid");
+    {
+        JobManager mgr(dir.string(), make_registry());
+        const char* bad[] = {"25:00-26:00", "09:00", "10:00-10:00", "aa:bb-cc:dd"};
+        for (const char* w : bad) {
+            bool rejected = false;
+            try {
+                mgr.create("bad", {step("m", "mark", json::object())}, json::object(), 0, w);
+            } catch (const JobError& e) {
+                rejected = e.status == 400;
+            }
+            check((std::string("window: '") + w + "' rejected").c_str(), rejected);
+        }
+    }
+    fs::remove_all(dir);
+}
+
+int main() {
+    test_priority_order();
+    test_execution_window();
+    test_invalid_windows();
+    if (g_failures) {
+        std::printf("%d FAILURE(S)\n", g_failures);
+        return 1;
+    }
+    std::printf("ALL PASS (0 failures)\n");
+    return 0;
+}
@@ -0,0 +1,214 @@
+// Streaming data passing: sentence buffering, stream_from validation, and a
+// pipelined parallel group overlapping producer and consumer.
+
+#include "lemon/jobs/job_graph.h"
+#include "lemon/jobs/job_manager.h"
+#include "lemon/jobs/job_ops.h"
+#include "lemon/jobs/job_stream.h"
+#include "lemon/jobs/job_types.h"
+
+#include <atomic>
+#include <cctype>
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace fs = std::filesystem;
+using namespace lemon::jobs;
+
+static int g_failures = 0;
+
+static void check(const char* name, bool ok) {
+    std::printf("[%s] %s\n", ok ? "PASS" : "FAIL", name);
+    if (!ok) ++g_failures;
+}
+
+static std::atomic<long long> g_producer_done_ns{0};
+static std::atomic<long long> g_consumer_first_ns{0};
+
+static long long now_ns() {
+    return std::chrono::steady_clock::now().time_since_epoch().count();
+}
+
+static void test_sentence_buffering() {
+    const std::atomic<bool> no_cancel{false};
+    std::vector<std::string> out;
+
+    SentenceStream stream;
+    stream.append("Hello world");
+    stream.append(".");
+    check("sentence held until the boundary is confirmed", !stream.is_closed());
+    stream.append(" Second");
+    check("sentence released once trailing whitespace arrives",
+          stream.pop(out, no_cancel) && out.size() == 1 && out[0] == "Hello world.");
+
+    SentenceStream decimals;
+    decimals.append("Pi is 3.14 exactly!");
+    decimals.append(" More");
+    check("decimal point does not split",
+          decimals.pop(out, no_cancel) && out.size() == 1
+              && out[0] == "Pi is 3.14 exactly!");
+
+    SentenceStream lines;
+    lines.append("line one\nline two\nrest");
+    check("newlines split and batch",
+          lines.pop(out, no_cancel) && out.size() == 2 && out[0] == "line one\n"
+              && out[1] == "line two\n");
+    lines.close();
+    check("close flushes the remainder",
+          lines.pop(out, no_cancel) && out.size() == 1 && out[0] == "rest");
+    check("closed and drained stream returns false", !lines.pop(out, no_cancel));
+
+    SentenceStream cancelled;
+    const std::atomic<bool> cancel{true};
+    check("pop honours cancellation", !cancelled.pop(out, cancel));
+}
+
+static StepRecord step(const std::string& id, const std::string& op, json params,
+                       const std::string& group = "") {
+    StepRecord s;
+    s.id = id;
+    s.op = op;
+    s.params = std::move(params);
+    s.group = group;
+    return s;
+}
+
+static void test_validation() {
+    const std::set<std::string> ops = {"produce", "xform", "plain"};
+    const std::set<std::string> streaming = {"produce", "xform"};
+
+    const auto err = [&](std::vector<StepRecord> steps) {
+        return validate_steps(steps, ops, streaming);
+    };
+
+    check("valid pipeline accepted",
+          err({step("src", "produce", json::object(), "pipe"),
+               step("dst", "xform", {{"stream_from", "src"}}, "pipe")})
+              .empty());
+    check("stream_from outside a group rejected",
+          !err({step("src", "produce", json::object()),
+                step("dst", "xform", {{"stream_from", "src"}})})
+               .empty());
+    check("unknown producer rejected",
+          !err({step("src", "produce", json::object(), "pipe"),
+                step("dst", "xform", {{"stream_from", "nope"}}, "pipe")})
+               .empty());
+    check("forward stream reference rejected (no cycles)",
+          !err({step("dst", "xform", {{"stream_from", "src"}}, "pipe"),
+                step("src", "produce", json::object(), "pipe")})
+               .empty());
+    check("non-streaming producer rejected",
+          !err({step("src", "plain", json::object(), "pipe"),
+                step("dst", "xform", {{"stream_from", "src"}}, "pipe")})
+               .empty());
+    check("second consumer of one stream rejected",
+          !err({step("src", "produce", json::object(), "pipe"),
+                step("a", "xform", {{"stream_from", "src"}}, "pipe"),
+                step("b", "xform", {{"stream_from", "src"}}, "pipe")})
+               .empty());
+}
+
+static OpRegistry make_registry() {
+    OpRegistry reg;
+
+    OpHandler produce;
+    produce.run = [](const json&, const json&, CancelFlag&) -> json {
+        return json::object();
+    };
+    produce.run_streamed = [](const json& params, const json&, CancelFlag&,
+                              const StepStreams& streams) -> json {
+        const std::string text = params.value("text", "");
+        for (size_t i = 0; i < text.size(); i += 4) {
+            if (streams.produce) streams.produce->append(text.substr(i, 4));
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+        g_producer_done_ns = now_ns();
+        return {{"choices", json::array({{{"message", {{"content", text}}}}})}};
+    };
+    reg.register_op("produce", produce);
+
+    OpHandler xform;
+    xform.run = [](const json&, const json&, CancelFlag&) -> json {
+        return json::object();
+    };
+    xform.run_streamed = [](const json&, const json&, CancelFlag& cancel,
+                            const StepStreams& streams) -> json {
+        std::string content;
+        int chunks = 0;
+        std::vector<std::string> batch;
+        while (streams.consume && streams.consume->pop(batch, cancel)) {
+            if (g_consumer_first_ns.load() == 0) g_consumer_first_ns = now_ns();
+            for (const auto& sentence : batch)
+                for (char c : sentence)
+                    content += static_cast<char>(std::toupper(static_cast<unsigned char>(c)));
+            ++chunks;
+            std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        }
+        return {{"content", content}, {"chunks", chunks}};
+    };
+    reg.register_op("xform", xform);
+
+    return reg;
+}
+
+static void test_pipelined_group() {
+    const auto stamp = std::chrono::steady_clock::now().time_since_epoch().count();
+    const fs::path dir =
+        fs::temp_directory_path() / ("lemonade-job-stream-" + std::to_string(stamp));
+    fs::create_directories(dir);
+    {
+        JobManager mgr(dir.string(), make_registry());
+        g_producer_done_ns = 0;
+        g_consumer_first_ns = 0;
+
+        const std::string text = "One sentence here. Another one follows. A third closes.";
+        const std::string id = mgr.create(
+            "pipeline",
+            {step("src", "produce", {{"text", text}}, "pipe"),
+             step("dst", "xform", {{"stream_from", "src"}}, "pipe")},
+            json::object());
+
+        bool completed = false;
+        for (int i = 0; i < 800; ++i) {
+            const auto j = mgr.get(id);
+            if (j && (*j)["status"] == "completed") {
+                completed = true;
+                break;
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+        check("pipelined job completes", completed);
+
+        const auto j = mgr.get(id);
+        json dst_output = json::object();
+        if (j)
+            for (const auto& s : (*j)["steps"])
+                if (s["id"] == "dst") dst_output = s.value("output", json::object());
+        std::string expected;
+        for (char c : text)
+            expected += static_cast<char>(std::toupper(static_cast<unsigned char>(c)));
+        check("consumer saw the full producer text",
+              dst_output.value("content", "") == expected);
+        check("consumer worked in multiple chunks", dst_output.value("chunks", 0) >= 2);
+        check("consumer started before the producer finished",
+              g_consumer_first_ns.load() != 0 && g_producer_done_ns.load() != 0
+                  && g_consumer_first_ns.load() < g_producer_done_ns.load());
+    }
+    fs::remove_all(dir);
+}
+
+int main() {
+    test_sentence_buffering();
+    test_validation();
+    test_pipelined_group();
+    if (g_failures) {
+        std::printf("%d FAILURE(S)\n", g_failures);
+        return 1;
+    }
+    std::printf("ALL PASS (0 failures)\n");
+    return 0;
+}
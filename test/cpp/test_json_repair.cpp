@@ -0,0 +1,93 @@
+#include "lemon/json_repair.h"
+
+#include <cstdio>
+#include <string>
+
+using lemon::parse_or_repair_json;
+using lemon::StreamingJsonValidator;
+using nlohmann::json;
+
+static int g_failures = 0;
+
+static void check(const char* name, bool ok) {
+    std::printf("[%s] %s\n", ok ? "PASS" : "FAIL", name);
+    if (!ok) ++g_failures;
+}
+
+static void test_validator_tracking() {
+    StreamingJsonValidator v;
+    v.feed("{\"city\": \"par");
+    check("open string detected", v.in_string() && !v.complete() && !v.invalid());
+    check("suffix closes string then object", v.closing_suffix() == "\"}");
+
+    v.feed("is\", \"units\": [1, 2");
+    check("suffix closes nested containers", v.closing_suffix() == "]}");
+
+    v.feed("]}");
+    check("balanced input is complete", v.complete() && v.closing_suffix().empty());
+
+    v.feed("garbage");
+    check("trailing garbage is invalid", v.invalid());
+
+    v.reset();
+    v.feed("{\"a\": 1]");
+    check("mismatched closer is invalid", v.invalid());
+
+    v.reset();
+    v.feed("\"brackets } ] inside strings\"");
+    check("closers inside strings are ignored", v.complete() && !v.invalid());
+}
+
+static void test_repair_truncations() {
+    bool repaired = false;
+
+    auto intact = parse_or_repair_json("{\"a\": 1}", &repaired);
+    check("valid json passes through unrepaired",
+          intact && !repaired && (*intact)["a"] == 1);
+
+    auto closed = parse_or_repair_json("{\"q\": \"paris\", \"n\": 3", &repaired);
+    check("truncated object is closed",
+          closed && repaired && (*closed)["q"] == "paris" && (*closed)["n"] == 3);
+
+    auto mid_string = parse_or_repair_json("{\"q\": \"par");
+    check("truncated string is closed", mid_string && (*mid_string)["q"] == "par");
+
+    auto nested = parse_or_repair_json("{\"a\": [1, {\"b\": \"x");
+    check("nested truncation is closed",
+          nested && (*nested)["a"][1]["b"] == "x");
+
+    auto trailing_comma = parse_or_repair_json("{\"a\": 1,");
+    check("trailing comma is stripped",
+          trailing_comma && trailing_comma->size() == 1);
+
+    auto escaped = parse_or_repair_json("{\"a\": \"he said \\\"hi");
+    check("escapes survive string closing",
+          escaped && (*escaped)["a"] == "he said \"hi");
+}
+
+static void test_repair_refuses_garbage() {
+    check("mismatched brackets stay broken",
+          !parse_or_repair_json("{\"a\": [1}").has_value());
+    check("prose stays broken",
+          !parse_or_repair_json("I will call the tool now").has_value());
+    check("truncated literal stays broken",
+          !parse_or_repair_json("{\"a\": tru").has_value());
+    check("empty input stays broken",
+          !parse_or_repair_json("").has_value());
+
+    bool repaired = true;
+    auto broken = parse_or_repair_json("{]", &repaired);
+    check("repaired flag false on failure", !broken && !repaired);
+}
+
+int main() {
+    test_validator_tracking();
+    test_repair_truncations();
+    test_repair_refuses_garbage();
+    if (g_failures) {
+        std::printf("%d FAILURE(S)\n", g_failures);
+        return 1;
+    }
+    std::printf("ALL PASS (0 failures)\n");
+    return 0;
+}
@@ -0,0 +1,111 @@
+// Allocation-count checks for the JsonUtils request helpers: the no-alias
+// fast path must not touch the heap, and merge/lookup semantics must be
+// unchanged by the churn-reduction rewrite.
+//
+// Compile: g++ -std=c++17 -I src/cpp/include -I <nlohmann-include> test/cpp/test_json_utils_churn.cpp src/cpp/server/utils/json_utils.cpp -o test_json_utils_churn
+
+#include <lemon/utils/json_utils.h>
+
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+
+static std::atomic<bool> g_counting{false};
+static std::atomic<long> g_allocations{0};
+
+void* operator new(std::size_t size) {
+    if (g_counting.load(std::memory_order_relaxed)) {
+        g_allocations.fetch_add(1, std::memory_order_relaxed);
+    }
+    void* p = std::malloc(size);
+    if (!p) throw std::bad_alloc();
+    return p;
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+
+using lemon::utils::JsonUtils;
+using json = nlohmann::json;
+
+static int g_failures = 0;
+
+static void check(const char* name, bool ok) {
+    std::printf("[%s] %s\n", ok ? "PASS" : "FAIL", name);
+    if (!ok) ++g_failures;
+}
+
+template <typename Fn>
+static long count_allocations(Fn&& fn) {
+    g_allocations.store(0, std::memory_order_relaxed);
+    g_counting.store(true, std::memory_order_relaxed);
+    fn();
+    g_counting.store(false, std::memory_order_relaxed);
+    return g_allocations.load(std::memory_order_relaxed);
+}
+
+static void test_alias_fast_path_is_allocation_free() {
+    json request = {{"model", "m"}, {"max_tokens", 128}, {"stream", true}};
+    json scratch;
+
+    const json* returned = nullptr;
+    long allocs = count_allocations([&]() {
+        returned = &JsonUtils::with_legacy_max_tokens_alias(request, scratch);
+    });
+    check("no-alias path returns the request itself", returned == &request);
+    check("no-alias path performs zero allocations", allocs == 0);
+    check("scratch untouched on fast path", scratch.is_null());
+}
+
+static void test_alias_slow_path_copies_once() {
+    json request = {{"model", "m"}, {"max_completion_tokens", 64}};
+    json scratch;
+
+    const json& returned = JsonUtils::with_legacy_max_tokens_alias(request, scratch);
+    check("alias path returns scratch", &returned == &scratch);
+    check("alias inserted", returned["max_tokens"] == 64);
+    check("original request unmodified", !request.contains("max_tokens"));
+
+    json existing = {{"max_completion_tokens", 64}, {"max_tokens", 32}};
+    json scratch2;
+    const json& kept = JsonUtils::with_legacy_max_tokens_alias(existing, scratch2);
+    check("explicit max_tokens wins", &kept == &existing && kept["max_tokens"] == 32);
+}
+
+static void test_merge_semantics_preserved() {
+    json base = {{"a", 1}, {"nested", {{"x", 1}, {"y", 2}}}};
+    json overlay = {{"b", 2}, {"nested", {{"y", 3}, {"z", 4}}}};
+
+    json merged = JsonUtils::merge(base, overlay);
+    check("merge keeps base keys", merged["a"] == 1);
+    check("merge adds overlay keys", merged["b"] == 2);
+    check("merge recurses into objects",
+          merged["nested"]["x"] == 1 && merged["nested"]["y"] == 3 && merged["nested"]["z"] == 4);
+    check("non-object overlay replaces base", JsonUtils::merge(base, json(7)) == 7);
+    check("merge does not mutate base", base["nested"]["y"] == 2);
+}
+
+static void test_single_lookup_helpers() {
+    json j = {{"present", 5}, {"null_value", nullptr}};
+    check("has_key true for value", JsonUtils::has_key(j, "present"));
+    check("has_key false for null", !JsonUtils::has_key(j, "null_value"));
+    check("has_key false for missing", !JsonUtils::has_key(j, "missing"));
+    check("get_or_default reads value", JsonUtils::get_or_default(j, "present", 0) == 5);
+    check("get_or_default falls back on null", JsonUtils::get_or_default(j, "null_value", 9) == 9);
+    check("get_or_default falls back on missing", JsonUtils::get_or_default(j, "missing", 9) == 9);
+}
+
+int main() {
+    test_alias_fast_path_is_allocation_free();
+    test_alias_slow_path_copies_once();
+    test_merge_semantics_preserved();
+    test_single_lookup_helpers();
+
+    if (g_failures > 0) {
+        std::printf("%d check(s) failed\n", g_failures);
+        return 1;
+    }
+    std::printf("All checks passed\n");
+    return 0;
+}
@@ -0,0 +1,107 @@
+#include "lemon/latency_histograms.h"
+
+#include <cmath>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+using lemon::LatencyHistograms;
+
+static int g_failures = 0;
+
+static void check(const char* name, bool ok) {
+    std::printf("[%s] %s\n", ok ? "PASS" : "FAIL", name);
+    if (!ok) ++g_failures;
+}
+
+static const LatencyHistograms::Series* find(const std::vector<LatencyHistograms::Series>& all,
+                                             const std::string& metric,
+                                             const std::string& model) {
+    for (const auto& series : all) {
+        if (series.metric == metric && series.model == model) return &series;
+    }
+    return nullptr;
+}
+
+static void test_bucket_placement() {
+    LatencyHistograms h;
+    h.observe_queue_wait("chat.completions", "m", "llamacpp", 0.003);
+    h.observe_queue_wait("chat.completions", "m", "llamacpp", 0.02);
+    h.observe_queue_wait("chat.completions", "m", "llamacpp", 500.0);
+
+    const auto all = h.snapshot();
+    const auto* series = find(all, "lemonade_request_queue_wait_seconds", "m");
+    check("placement: series exists", series != nullptr);
+    if (!series) return;
+
+    check("placement: endpoint label kept", series->endpoint == "chat.completions");
+    check("placement: backend label kept", series->backend == "llamacpp");
+    check("placement: count covers all observations", series->observations == 3);
+    check("placement: sum accumulates", std::fabs(series->sum - 500.023) < 1e-9);
+
+    uint64_t bucketed = 0;
+    for (uint64_t count : series->buckets) bucketed += count;
+    check("placement: overflow stays out of finite buckets", bucketed == 2);
+
+    uint64_t le_025 = 0;
+    for (size_t i = 0; i < series->bound_count; ++i) {
+        if (series->upper_bounds[i] <= 0.025) le_025 += series->buckets[i];
+    }
+    check("placement: cumulative le=0.025 sees both fast waits", le_025 == 2);
+}
+
+static void test_label_shapes() {
+    LatencyHistograms h;
+    h.observe_backend_duration("embeddings", "m", "llamacpp", 0.2);
+    h.observe_time_to_first_token("m", "llamacpp", 0.4);
+    h.observe_tokens_per_second("m", "llamacpp", 42.0);
+
+    const auto all = h.snapshot();
+    const auto* backend = find(all, "lemonade_request_backend_seconds", "m");
+    const auto* ttft = find(all, "lemonade_time_to_first_token_seconds", "m");
+    const auto* tps = find(all, "lemonade_tokens_per_second", "m");
+    check("labels: all three metrics recorded", backend && ttft && tps);
+    if (!backend || !ttft || !tps) return;
+    check("labels: backend metric carries endpoint", backend->endpoint == "embeddings");
+    check("labels: ttft has no endpoint label", ttft->endpoint.empty());
+    check("labels: tps has no endpoint label", tps->endpoint.empty());
+}
+
+static void test_invalid_values_ignored() {
+    LatencyHistograms h;
+    h.observe_queue_wait("chat.completions", "m", "llamacpp", -1.0);
+    h.observe_queue_wait("chat.completions", "m", "llamacpp", std::nan(""));
+    check("invalid: negative and NaN never create a series", h.snapshot().empty());
+}
+
+static void test_cardinality_fold() {
+    LatencyHistograms h;
+    for (int i = 0; i < 230; ++i) {
+        h.observe_time_to_first_token("model-" + std::to_string(i), "llamacpp", 0.1);
+    }
+
+    const auto all = h.snapshot();
+    check("fold: series count bounded", all.size() <= 201);
+
+    const auto* other = find(all, "lemonade_time_to_first_token_seconds", "other");
+    check("fold: overflow models land in model=other", other && other->observations == 30);
+
+    h.observe_time_to_first_token("model-0", "llamacpp", 0.1);
+    const auto after = h.snapshot();
+    const auto* existing = find(after, "lemonade_time_to_first_token_seconds", "model-0");
+    check("fold: established series still addressable at cap",
+          existing && existing->observations == 2);
+}
+
+int main() {
+    test_bucket_placement();
+    test_label_shapes();
+    test_invalid_values_ignored();
+    test_cardinality_fold();
+    if (g_failures) {
+        std::printf("%d FAILURE(S)\n", g_failures);
+        return 1;
+    }
+    std::printf("ALL PASS (0 failures)\n");
+    return 0;
+}
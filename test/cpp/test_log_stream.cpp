@@ -0,0 +1,190 @@
+#include "lemon/log_stream.h"
+
+#include <chrono>
+#include <cstdio>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using lemon::LogStreamEntry;
+using lemon::LogStreamFilter;
+using lemon::LogStreamHub;
+
+static int g_failures = 0;
+
+static void check(const char* name, bool ok) {
+    std::printf("[%s] %s\n", ok ? "PASS" : "FAIL", name);
+    if (!ok) ++g_failures;
+}
+
+struct Collector {
+    std::mutex mutex;
+    std::vector<LogStreamEntry> got;
+
+    LogStreamHub::SubscriberCallback callback() {
+        return [this](const std::vector<LogStreamEntry>& entries) {
+            std::lock_guard<std::mutex> lock(mutex);
+            got.insert(got.end(), entries.begin(), entries.end());
+        };
+    }
+
+    size_t count() {
+        std::lock_guard<std::mutex> lock(mutex);
+        return got.size();
+    }
+
+    bool wait_for_count(size_t expected) {
+        for (int i = 0; i < 100; ++i) {
+            if (count() >= expected) return count() == expected;
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+        return false;
+    }
+};
+
+static void publish(const std::string& tag, AixLog::Severity severity, const std::string& line) {
+    AixLog::Metadata metadata;
+    metadata.severity = severity;
+    metadata.tag = AixLog::Tag(tag);
+    LogStreamHub::instance().publish(metadata, line);
+}
+
+static LogStreamEntry make_entry(AixLog::Severity severity, const std::string& tag,
+                                 const std::string& line) {
+    LogStreamEntry entry;
+    entry.severity_value = severity;
+    entry.severity = AixLog::to_string(severity);
+    entry.tag = tag;
+    entry.line = line;
+    return entry;
+}
+
+static void test_filter_severity() {
+    LogStreamFilter filter;
+    filter.min_severity = AixLog::Severity::warning;
+    check("info below min severity rejected",
+          !filter.matches(make_entry(AixLog::Severity::info, "t", "x")));
+    check("warning at min severity accepted",
+          filter.matches(make_entry(AixLog::Severity::warning, "t", "x")));
+    check("error above min severity accepted",
+          filter.matches(make_entry(AixLog::Severity::error, "t", "x")));
+}
+
+static void test_filter_tag_and_pattern() {
+    LogStreamFilter filter;
+    filter.tag = "Router";
+    check("tag must match exactly",
+          filter.matches(make_entry(AixLog::Severity::info, "Router", "x")) &&
+              !filter.matches(make_entry(AixLog::Severity::info, "RouterX", "x")));
+
+    LogStreamFilter regex_filter;
+    regex_filter.pattern = std::regex("load(ed|ing)");
+    check("pattern matches anywhere in the line",
+          regex_filter.matches(make_entry(AixLog::Severity::info, "t", "model loaded ok")) &&
+              !regex_filter.matches(make_entry(AixLog::Severity::info, "t", "model unload")));
+
+    LogStreamFilter empty;
+    check("empty filter matches everything",
+          empty.matches(make_entry(AixLog::Severity::trace, "t", "x")));
+}
+
+static void test_filtered_snapshot() {
+    publish("SnapTag", AixLog::Severity::info, "snap info");
+    publish("SnapTag", AixLog::Severity::warning, "snap warning");
+    publish("OtherTag", AixLog::Severity::error, "other error");
+
+    LogStreamFilter filter;
+    filter.tag = "SnapTag";
+    filter.min_severity = AixLog::Severity::warning;
+
+    Collector collector;
+    std::vector<LogStreamEntry> snapshot;
+    std::string id = LogStreamHub::instance().subscribe_with_snapshot(
+        collector.callback(), std::nullopt, snapshot, filter);
+
+    check("snapshot contains only matching entries",
+          snapshot.size() == 1 && snapshot[0].line == "snap warning");
+    LogStreamHub::instance().remove_subscriber(id);
+}
+
+static void test_inline_flush_at_batch_size() {
+    LogStreamFilter filter;
+    filter.tag = "BatchTag";
+
+    Collector collector;
+    std::vector<LogStreamEntry> snapshot;
+    std::string id = LogStreamHub::instance().subscribe_with_snapshot(
+        collector.callback(), std::nullopt, snapshot, filter);
+    check("no prior entries for fresh tag", snapshot.empty());
+
+    for (size_t i = 0; i < LogStreamHub::kBatchMaxEntries; ++i) {
+        publish("BatchTag", AixLog::Severity::info, "batch line " + std::to_string(i));
+    }
+    check("full batch flushed inline",
+          collector.count() == LogStreamHub::kBatchMaxEntries);
+    LogStreamHub::instance().remove_subscriber(id);
+}
+
+static void test_timed_flush() {
+    LogStreamFilter filter;
+    filter.tag = "TimedTag";
+
+    Collector collector;
+    std::vector<LogStreamEntry> snapshot;
+    std::string id = LogStreamHub::instance().subscribe_with_snapshot(
+        collector.callback(), std::nullopt, snapshot, filter);
+
+    publish("TimedTag", AixLog::Severity::info, "a");
+    publish("TimedTag", AixLog::Severity::info, "b");
+    publish("TimedTag", AixLog::Severity::info, "c");
+    check("partial batch delivered by the flusher", collector.wait_for_count(3));
+    LogStreamHub::instance().remove_subscriber(id);
+}
+
+static void test_removed_subscriber_gets_nothing() {
+    LogStreamFilter filter;
+    filter.tag = "GoneTag";
+
+    Collector collector;
+    std::vector<LogStreamEntry> snapshot;
+    std::string id = LogStreamHub::instance().subscribe_with_snapshot(
+        collector.callback(), std::nullopt, snapshot, filter);
+    LogStreamHub::instance().remove_subscriber(id);
+
+    publish("GoneTag", AixLog::Severity::error, "after removal");
+    std::this_thread::sleep_for(LogStreamHub::kBatchMaxDelay * 3);
+    check("removed subscriber receives nothing", collector.count() == 0);
+}
+
+static void test_filtered_live_entries() {
+    LogStreamFilter filter;
+    filter.tag = "LiveTag";
+    filter.min_severity = AixLog::Severity::warning;
+
+    Collector collector;
+    std::vector<LogStreamEntry> snapshot;
+    std::string id = LogStreamHub::instance().subscribe_with_snapshot(
+        collector.callback(), std::nullopt, snapshot, filter);
+
+    publish("LiveTag", AixLog::Severity::debug, "filtered out");
+    publish("LiveTag", AixLog::Severity::error, "kept");
+    check("live entries honor the filter",
+          collector.wait_for_count(1) && collector.got[0].line == "kept");
+    LogStreamHub::instance().remove_subscriber(id);
+}
+
+int main() {
+    test_filter_severity();
+    test_filter_tag_and_pattern();
+    test_filtered_snapshot();
+    test_inline_flush_at_batch_size();
+    test_timed_flush();
+    test_removed_subscriber_gets_nothing();
+    test_filtered_live_entries();
+    if (g_failures) {
+        std::printf("%d FAILURE(S)\n", g_failures);
+        return 1;
+    }
+    std::printf("ALL PASS (0 failures)\n");
+    return 0;
+}
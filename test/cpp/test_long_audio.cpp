@@ -0,0 +1,164 @@
+// Standalone test for long-audio chunk planning and stitching.
+//
+// Compile: g++ -std=c++17 -I src/cpp/include test/cpp/test_long_audio.cpp
+//   src/cpp/server/long_audio.cpp src/cpp/server/vad.cpp -o test_long_audio
+
+#include "lemon/long_audio.h"
+
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+using namespace lemon::audio;
+
+static int g_failures = 0;
+
+static void check(const char* name, bool ok) {
+    std::printf("[%s] %s\n", ok ? "PASS" : "FAIL", name);
+    if (!ok) ++g_failures;
+}
+
+namespace {
+
+constexpr int kRate = 16000;
+constexpr double kPi = 3.14159265358979323846;
+
+// Loud tone with a silent gap every `gap_every_s` seconds
+std::vector<int16_t> make_speech_like(int total_seconds, int gap_every_s,
+                                      double gap_seconds = 1.0) {
+    std::vector<int16_t> samples(static_cast<size_t>(total_seconds) * kRate);
+    const size_t gap_period = static_cast<size_t>(gap_every_s) * kRate;
+    const size_t gap_len = static_cast<size_t>(gap_seconds * kRate);
+    for (size_t i = 0; i < samples.size(); ++i) {
+        const bool in_gap = gap_every_s > 0 && (i % gap_period) < gap_len;
+        samples[i] = in_gap ? 0
+                            : static_cast<int16_t>(
+                                  6000.0 * std::sin(2.0 * kPi * 200.0 *
+                                                    static_cast<double>(i) / kRate));
+    }
+    return samples;
+}
+
+}  // namespace
+
+static void test_wav_roundtrip() {
+    const auto samples = make_speech_like(2, 0);
+    const auto wav = make_wav(samples.data(), samples.size(), kRate);
+
+    WavInfo info;
+    check("roundtrip parses", parse_wav_pcm16(wav.data(), wav.size(), info));
+    check("roundtrip sample rate", info.sample_rate == kRate);
+    check("roundtrip is mono", info.channels == 1);
+    check("roundtrip sample count", info.num_samples == samples.size());
+
+    const auto* parsed =
+        reinterpret_cast<const int16_t*>(wav.data() + info.data_offset);
+    check("roundtrip payload matches",
+          std::memcmp(parsed, samples.data(),
+                      samples.size() * sizeof(int16_t)) == 0);
+}
+
+static void test_parse_rejects_non_wav() {
+    WavInfo info;
+    const uint8_t garbage[64] = {0};
+    check("rejects non-RIFF data", !parse_wav_pcm16(garbage, sizeof(garbage), info));
+
+    auto wav = make_wav(nullptr, 0, kRate);
+    check("rejects empty payload", !parse_wav_pcm16(wav.data(), wav.size(), info));
+
+    const auto samples = make_speech_like(1, 0);
+    wav = make_wav(samples.data(), samples.size(), kRate);
+    wav[20] = 3;  // format tag -> IEEE float
+    check("rejects non-PCM encoding", !parse_wav_pcm16(wav.data(), wav.size(), info));
+}
+
+static void test_chunks_cover_recording_and_cut_at_silence() {
+    // 5 minutes with a one-second gap every 50s
+    const auto samples = make_speech_like(300, 50);
+    ChunkPolicy policy;
+    const auto chunks = plan_chunks(samples.data(), samples.size(), kRate, policy);
+
+    check("long recording is split", chunks.size() >= 3);
+
+    bool contiguous = !chunks.empty() && chunks.front().first == 0 &&
+                      chunks.back().second == samples.size();
+    for (size_t i = 1; i < chunks.size(); ++i) {
+        if (chunks[i].first != chunks[i - 1].second) contiguous = false;
+    }
+    check("chunks tile the recording exactly", contiguous);
+
+    // Every internal boundary should land in a silent gap (gaps start at
+    // multiples of 50s and last 1s)
+    bool at_silence = true;
+    for (size_t i = 1; i < chunks.size(); ++i) {
+        const size_t boundary = chunks[i].first;
+        const size_t within_period = boundary % (50 * kRate);
+        if (within_period > static_cast<size_t>(1.0 * kRate)) at_silence = false;
+    }
+    check("boundaries land in silence", at_silence);
+
+    bool lengths_ok = true;
+    for (const auto& chunk : chunks) {
+        const size_t len = chunk.second - chunk.first;
+        if (len > static_cast<size_t>(policy.max_seconds) * kRate ||
+            len < static_cast<size_t>(policy.min_seconds) * kRate) {
+            lengths_ok = false;
+        }
+    }
+    check("chunk lengths stay within policy bounds", lengths_ok);
+}
+
+static void test_continuous_audio_hard_cuts() {
+    // 4 minutes with no silence anywhere: the planner must still terminate
+    // and fall back to hard cuts at the max length
+    const auto samples = make_speech_like(240, 0);
+    ChunkPolicy policy;
+    const auto chunks = plan_chunks(samples.data(), samples.size(), kRate, policy);
+
+    check("gapless audio still splits", chunks.size() >= 2);
+    check("gapless chunks cover the recording",
+          !chunks.empty() && chunks.front().first == 0 &&
+          chunks.back().second == samples.size());
+}
+
+static void test_short_audio_is_one_chunk() {
+    const auto samples = make_speech_like(30, 10);
+    const auto chunks = plan_chunks(samples.data(), samples.size(), kRate);
+    check("short recording is a single chunk",
+          chunks.size() == 1 && chunks[0].first == 0 &&
+          chunks[0].second == samples.size());
+}
+
+static void test_implausible_sample_rate() {
+    // A crafted header can claim any rate; below 50 Hz a VAD frame rounds to
+    // zero samples and planning must bail out instead of dividing by it
+    const auto samples = make_speech_like(1, 0);
+    const auto chunks = plan_chunks(samples.data(), samples.size(), 40);
+    check("implausibly low sample rate yields no plan", chunks.empty());
+}
+
+static void test_stitching() {
+    check("stitch trims and joins",
+          stitch_transcripts({" Hello there. ", "", "  How are you?\n"}) ==
+          "Hello there. How are you?");
+    check("stitch of nothing is empty", stitch_transcripts({}).empty());
+    check("stitch of blanks is empty", stitch_transcripts({"  ", "\n"}).empty());
+}
+
+int main() {
+    test_wav_roundtrip();
+    test_parse_rejects_non_wav();
+    test_chunks_cover_recording_and_cut_at_silence();
+    test_continuous_audio_hard_cuts();
+    test_short_audio_is_one_chunk();
+    test_implausible_sample_rate();
+    test_stitching();
+
+    if (g_failures > 0) {
+        std::printf("%d check(s) failed\n", g_failures);
+        return 1;
+    }
+    std::printf("All checks passed\n");
+    return 0;
+}
@@ -0,0 +1,126 @@
+// MCP session manager: id allocation, lookup and idle expiry, slot pooling,
+// LRU eviction at capacity, and per-session cached values.
+
+#include "lemon/mcp_session.h"
+
+#include <chrono>
+#include <cstdio>
+#include <set>
+#include <string>
+#include <thread>
+
+using lemon::McpSessionManager;
+using lemon::json;
+
+static int g_failures = 0;
+
+static void check(const char* name, bool ok) {
+    std::printf("[%s] %s\n", ok ? "PASS" : "FAIL", name);
+    if (!ok) {
+        ++g_failures;
+    }
+}
+
+static void test_create_and_find() {
+    McpSessionManager manager;
+
+    auto a = manager.create();
+    auto b = manager.create();
+    check("sessions get distinct non-empty ids",
+          !a->id.empty() && !b->id.empty() && a->id != b->id);
+    check("find returns the same session", manager.find(a->id) == a);
+    check("unknown id returns null", manager.find("nope") == nullptr);
+    check("size tracks live sessions", manager.size() == 2);
+
+    check("remove drops the session", manager.remove(a->id) && !manager.find(a->id));
+    check("remove is idempotent", !manager.remove(a->id));
+}
+
+static void test_cached_values() {
+    McpSessionManager manager;
+    auto session = manager.create();
+
+    check("cache miss is null", session->cached_value("tools").is_null());
+    session->store_cached_value("tools", json{{"count", 5}});
+    check("cache hit returns stored value",
+          session->cached_value("tools")["count"] == 5);
+}
+
+static void test_idle_expiry_and_pooling() {
+    McpSessionManager manager(std::chrono::milliseconds(20), 8);
+
+    std::string stale_id;
+    {
+        auto stale = manager.create();
+        stale_id = stale->id;
+        stale->store_cached_value("tools", json{{"stale", true}});
+    }
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(40));
+    check("idle session expires", manager.find(stale_id) == nullptr);
+    check("expired slot is parked for reuse", manager.pooled() == 1);
+
+    auto fresh = manager.create();
+    check("pooled slot is recycled", manager.pooled() == 0);
+    check("recycled slot carries no stale state",
+          fresh->id != stale_id && fresh->cached_value("tools").is_null() &&
+              fresh->calls.load() == 0);
+}
+
+static void test_touch_keeps_session_alive() {
+    McpSessionManager manager(std::chrono::milliseconds(50), 8);
+    auto session = manager.create();
+
+    for (int i = 0; i < 4; ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(25));
+        if (!manager.find(session->id)) break;
+    }
+    check("find refreshes the idle clock", manager.find(session->id) == session);
+}
+
+static void test_capacity_eviction() {
+    McpSessionManager manager(std::chrono::minutes(5), 3);
+
+    auto first = manager.create();
+    std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    auto second = manager.create();
+    std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    auto third = manager.create();
+    (void)third;
+
+    manager.find(first->id);
+    std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    auto fourth = manager.create();
+
+    check("capacity is enforced", manager.size() == 3);
+    check("least recently used session is evicted",
+          manager.find(second->id) == nullptr && manager.find(first->id) != nullptr &&
+              manager.find(fourth->id) != nullptr);
+}
+
+static void test_held_session_not_recycled() {
+    McpSessionManager manager(std::chrono::minutes(5), 8);
+    auto session = manager.create();
+    const std::string id = session->id;
+
+    // Simulates an in-flight request holding the session while it's removed.
+    check("remove succeeds while held", manager.remove(id));
+    check("held session is not parked", manager.pooled() == 0);
+    check("held session stays usable", session->id == id);
+}
+
+int main() {
+    test_create_and_find();
+    test_cached_values();
+    test_idle_expiry_and_pooling();
+    test_touch_keeps_session_alive();
+    test_capacity_eviction();
+    test_held_session_not_recycled();
+
+    if (g_failures > 0) {
+        std::printf("%d check(s) failed\n", g_failures);
+        return 1;
+    }
+    std::printf("All checks passed\n");
+    return 0;
+}
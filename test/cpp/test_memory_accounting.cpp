@@ -0,0 +1,74 @@
+// Standalone test for the memory accounting registry: gauge registration
+// and replacement, snapshot shape, RSS reading, throwing gauges, and the
+// watchdog's growth attribution between threshold crossings.
+
+#include "lemon/memory_accounting.h"
+
+#include <cstdio>
+#include <stdexcept>
+#include <string>
+
+using lemon::MemoryAccounting;
+
+static int g_failures = 0;
+
+static void check(const char* name, bool ok) {
+    std::printf("[%s] %s\n", ok ? "PASS" : "FAIL", name);
+    if (!ok) ++g_failures;
+}
+
+int main() {
+    auto& accounting = MemoryAccounting::global();
+
+    check("process rss readable", MemoryAccounting::process_rss_bytes() > 0);
+
+    std::uint64_t sessions_bytes = 100;
+    accounting.register_gauge("sessions", [&] { return sessions_bytes; });
+    accounting.register_gauge("log_stream", [] { return std::uint64_t(50); });
+    accounting.register_gauge("broken", []() -> std::uint64_t {
+        throw std::runtime_error("boom");
+    });
+
+    auto before = accounting.snapshot();
+    check("snapshot carries rss", before.value("rss_bytes", std::uint64_t(0)) > 0);
+    check("snapshot carries gauges",
+          before["subsystems"].value("sessions", std::uint64_t(0)) == 100 &&
+          before["subsystems"].value("log_stream", std::uint64_t(0)) == 50);
+    check("throwing gauge reads as zero",
+          before["subsystems"].value("broken", std::uint64_t(1)) == 0);
+
+    accounting.register_gauge("log_stream", [] { return std::uint64_t(75); });
+    check("re-registering replaces the gauge",
+          accounting.snapshot()["subsystems"].value("log_stream",
+                                                    std::uint64_t(0)) == 75);
+
+    before = accounting.snapshot();
+    sessions_bytes = 5 * 1024 * 1024;
+    auto after = accounting.snapshot();
+    auto report = MemoryAccounting::growth_report(before, after);
+    check("growth report is an array", report.is_array());
+    check("grown subsystem reported", !report.empty());
+    check("largest grower first",
+          report[0].value("subsystem", "") == "sessions" &&
+          report[0].value("grew_bytes", std::uint64_t(0)) ==
+              5 * 1024 * 1024 - 100);
+    for (const auto& entry : report) {
+        check("unchanged subsystems omitted",
+              entry.value("subsystem", "") != "log_stream" &&
+              entry.value("subsystem", "") != "broken");
+    }
+
+    check("new subsystem counts fully as growth",
+          MemoryAccounting::growth_report(nlohmann::json::object(), after)[0]
+              .value("grew_bytes", std::uint64_t(0)) > 0);
+
+    // Start/stop must be clean even when no threshold is ever crossed.
+    accounting.start_watchdog(/*step_bytes=*/1ull << 40, /*interval_seconds=*/1);
+    accounting.start_watchdog();
+    accounting.stop_watchdog();
+    accounting.stop_watchdog();
+    check("watchdog start/stop idempotent", true);
+
+    std::printf("%s\n", g_failures == 0 ? "ALL PASS" : "FAILURES");
+    return g_failures == 0 ? 0 : 1;
+}
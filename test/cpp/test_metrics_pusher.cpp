@@ -0,0 +1,73 @@
+// Pushgateway exporter: cardinality cap applied to exposition text.
+
+#include "lemon/metrics_pusher.h"
+
+#include <cstdio>
+#include <string>
+
+using lemon::MetricsPusher;
+
+static int g_failures = 0;
+
+static void check(const char* name, bool ok) {
+    std::printf("[%s] %s\n", ok ? "PASS" : "FAIL", name);
+    if (!ok) {
+        ++g_failures;
+    }
+}
+
+static const std::string kPayload =
+    "# HELP lemonade_requests_total Cumulative inference requests.\n"
+    "# TYPE lemonade_requests_total counter\n"
+    "lemonade_requests_total 5\n"
+    "# HELP lemonade_input_tokens_total Cumulative input tokens.\n"
+    "# TYPE lemonade_input_tokens_total counter\n"
+    "lemonade_input_tokens_total 120\n"
+    "lemonade_output_tokens_total 80\n";
+
+static size_t count_samples(const std::string& text) {
+    size_t samples = 0;
+    size_t pos = 0;
+    while (pos < text.size()) {
+        size_t end = text.find('\n', pos);
+        if (end == std::string::npos) end = text.size();
+        if (end > pos && text[pos] != '#') {
+            ++samples;
+        }
+        pos = end + 1;
+    }
+    return samples;
+}
+
+static void test_no_limit_when_under_cap() {
+    check("payload under cap is unchanged",
+          MetricsPusher::apply_series_limit(kPayload, 10) == kPayload);
+}
+
+static void test_truncates_at_cap() {
+    std::string limited = MetricsPusher::apply_series_limit(kPayload, 2);
+    check("sample count equals cap", count_samples(limited) == 2);
+    check("earlier series survive",
+          limited.find("lemonade_requests_total 5") != std::string::npos);
+    check("later series dropped",
+          limited.find("lemonade_output_tokens_total") == std::string::npos);
+}
+
+static void test_comments_kept_before_cut() {
+    std::string limited = MetricsPusher::apply_series_limit(kPayload, 2);
+    check("HELP/TYPE lines preserved",
+          limited.find("# TYPE lemonade_input_tokens_total counter") != std::string::npos);
+}
+
+int main() {
+    test_no_limit_when_under_cap();
+    test_truncates_at_cap();
+    test_comments_kept_before_cut();
+
+    if (g_failures != 0) {
+        std::printf("%d check(s) failed\n", g_failures);
+        return 1;
+    }
+    std::printf("All metrics pusher checks passed\n");
+    return 0;
+}
@@ -0,0 +1,165 @@
+#include "lemon/model_alias_index.h"
+
+#include <cctype>
+#include <cstdio>
+#include <map>
+#include <random>
+#include <string>
+
+using lemon::ModelAliasIndex;
+
+static int g_failures = 0;
+
+static void check(const char* name, bool ok) {
+    std::printf("[%s] %s\n", ok ? "PASS" : "FAIL", name);
+    if (!ok) ++g_failures;
+}
+
+static std::string fold(std::string s) {
+    for (char& c : s) {
+        c = static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+    }
+    return s;
+}
+
+static void test_exact_resolution() {
+    ModelAliasIndex index;
+    index.rebuild(
+        {{"Qwen3-4B", "user.Qwen3-4B"},
+         {"builtin.Qwen3-4B", "Qwen3-4B-builtin-key"},
+         {"Llama-3.2-1B", "Llama-3.2-1B"}},
+        {{"user.Qwen3-4B", "Qwen3-4B"},
+         {"Qwen3-4B-builtin-key", "builtin.Qwen3-4B"}});
+
+    check("bare alias resolves to winner",
+          index.resolve("Qwen3-4B") == "user.Qwen3-4B");
+    check("canonical alias resolves",
+          index.resolve("builtin.Qwen3-4B") == "Qwen3-4B-builtin-key");
+    check("unknown name is identity", index.resolve("nope") == "nope");
+    check("public name maps back",
+          index.public_name("user.Qwen3-4B") == "Qwen3-4B");
+    check("public name identity on miss",
+          index.public_name("other") == "other");
+    check("size counts aliases", index.size() == 3);
+}
+
+static void test_case_fold_fallback() {
+    ModelAliasIndex index;
+    index.rebuild({{"Qwen3-4B", "user.Qwen3-4B"},
+                   {"AMBIG", "user.A"},
+                   {"ambig", "user.B"}},
+                  {});
+
+    check("case variant resolves to the unique entry",
+          index.resolve("qwen3-4b") == "user.Qwen3-4B" &&
+              index.resolve("QWEN3-4B") == "user.Qwen3-4B");
+    check("exact match wins over folding",
+          index.resolve("AMBIG") == "user.A" && index.resolve("ambig") == "user.B");
+    check("ambiguous folded lookup stays identity",
+          index.resolve("Ambig") == "Ambig");
+    check("same-target case twins are not ambiguous", [] {
+        ModelAliasIndex twins;
+        twins.rebuild({{"Foo", "user.Foo"}, {"foo", "user.Foo"}}, {});
+        return twins.resolve("FOO") == "user.Foo";
+    }());
+}
+
+static void test_rebuild_replaces_contents() {
+    ModelAliasIndex index;
+    index.rebuild({{"old", "user.old"}}, {{"user.old", "old"}});
+    index.rebuild({{"new", "user.new"}}, {{"user.new", "new"}});
+
+    check("stale aliases dropped on rebuild",
+          index.resolve("old") == "old" && index.public_name("user.old") == "user.old");
+    check("fresh aliases served after rebuild",
+          index.resolve("new") == "user.new");
+}
+
+static void test_fuzz_matches_map_semantics() {
+    std::mt19937 rng(20260826);
+    const char charset[] = "abcXYZ.-_09";
+
+    auto random_name = [&](size_t max_len) {
+        std::uniform_int_distribution<size_t> len_dist(1, max_len);
+        std::uniform_int_distribution<size_t> char_dist(0, sizeof(charset) - 2);
+        std::string s;
+        size_t len = len_dist(rng);
+        for (size_t i = 0; i < len; ++i) {
+            s += charset[char_dist(rng)];
+        }
+        return s;
+    };
+
+    bool all_match = true;
+    for (int round = 0; round < 50 && all_match; ++round) {
+        std::map<std::string, std::string> aliases;
+        std::map<std::string, std::string> public_names;
+        std::uniform_int_distribution<int> count_dist(0, 40);
+        int count = count_dist(rng);
+        for (int i = 0; i < count; ++i) {
+            std::string canonical = "user." + random_name(8);
+            aliases[random_name(8)] = canonical;
+            public_names[canonical] = random_name(8);
+        }
+
+        ModelAliasIndex index;
+        index.rebuild(aliases, public_names);
+
+        for (const auto& [alias, canonical] : aliases) {
+            if (index.resolve(alias) != canonical) {
+                all_match = false;
+            }
+        }
+        for (const auto& [canonical, public_name] : public_names) {
+            if (index.public_name(canonical) != public_name) {
+                all_match = false;
+            }
+        }
+
+        for (int probe = 0; probe < 200; ++probe) {
+            std::string query = random_name(8);
+            auto it = aliases.find(query);
+            std::string resolved = index.resolve(query);
+            if (it != aliases.end()) {
+                if (resolved != it->second) {
+                    all_match = false;
+                }
+                continue;
+            }
+            // The reference misses; the index may only deviate from identity
+            // by matching a unique case variant of a real alias.
+            if (resolved != query) {
+                std::string target;
+                int folded_hits = 0;
+                for (const auto& [alias, canonical] : aliases) {
+                    if (fold(alias) == fold(query)) {
+                        if (folded_hits == 0 || canonical == target) {
+                            target = canonical;
+                            ++folded_hits;
+                        } else {
+                            folded_hits = -1;
+                            break;
+                        }
+                    }
+                }
+                if (folded_hits <= 0 || resolved != target) {
+                    all_match = false;
+                }
+            }
+        }
+    }
+    check("fuzz: index matches ordered-map semantics", all_match);
+}
+
+int main() {
+    test_exact_resolution();
+    test_case_fold_fallback();
+    test_rebuild_replaces_contents();
+    test_fuzz_matches_map_semantics();
+    if (g_failures) {
+        std::printf("%d FAILURE(S)\n", g_failures);
+        return 1;
+    }
+    std::printf("ALL PASS (0 failures)\n");
+    return 0;
+}
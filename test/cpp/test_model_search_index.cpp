@@ -0,0 +1,88 @@
+#include <lemon/model_search_index.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+using lemon::ModelSearchEntry;
+using lemon::ModelSearchIndex;
+
+struct TestResult {
+    int passed = 0;
+    int failed = 0;
+
+    void check(bool condition, const std::string& name) {
+        if (condition) {
+            printf("[PASS] %s\n", name.c_str());
+            ++passed;
+        } else {
+            printf("[FAIL] %s\n", name.c_str());
+            ++failed;
+        }
+    }
+};
+
+static bool contains(const std::vector<std::string>& results, const std::string& name) {
+    return std::find(results.begin(), results.end(), name) != results.end();
+}
+
+int main() {
+    TestResult r;
+    ModelSearchIndex index;
+    index.rebuild({
+        {"Llama-3.1-8B-Instruct-Hybrid", {"llm", "ryzenai-llm", "hot"}},
+        {"Qwen2.5-7B-Instruct-GGUF", {"llm", "llamacpp"}},
+        {"Qwen3-Embedding-0.6B-GGUF", {"embeddings", "llamacpp"}},
+        {"whisper-large-v3", {"audio", "whispercpp"}},
+        {"user.my-local-llama", {"llm", "llamacpp"}},
+    });
+
+    r.check(index.size() == 5, "index holds all entries");
+
+    auto results = index.search("llama", 10);
+    r.check(contains(results, "Llama-3.1-8B-Instruct-Hybrid"), "token match finds Llama");
+    r.check(contains(results, "user.my-local-llama"), "token match finds user model");
+    r.check(contains(results, "Qwen2.5-7B-Instruct-GGUF"),
+            "recipe field llamacpp matches llama prefix");
+    r.check(results.size() == 4 &&
+                contains({results.begin(), results.begin() + 2},
+                         "Llama-3.1-8B-Instruct-Hybrid") &&
+                contains({results.begin(), results.begin() + 2}, "user.my-local-llama"),
+            "exact token matches outrank field prefix matches");
+
+    results = index.search("qw", 10);
+    r.check(contains(results, "Qwen2.5-7B-Instruct-GGUF") &&
+                contains(results, "Qwen3-Embedding-0.6B-GGUF"),
+            "prefix query matches both Qwen models");
+
+    results = index.search("hisper", 10);
+    r.check(contains(results, "whisper-large-v3"), "substring query matches mid-token");
+
+    results = index.search("qwen embedding", 10);
+    r.check(results.size() == 1 && results.front() == "Qwen3-Embedding-0.6B-GGUF",
+            "multi-token query intersects");
+
+    results = index.search("ama31", 10);
+    r.check(contains(results, "Llama-3.1-8B-Instruct-Hybrid"),
+            "compact text matches across token boundaries");
+
+    results = index.search("embeddings", 10);
+    r.check(results.size() == 1 && results.front() == "Qwen3-Embedding-0.6B-GGUF",
+            "capability field is searchable");
+
+    results = index.search("nonexistent-model-xyz", 10);
+    r.check(results.empty(), "no match returns empty");
+
+    results = index.search("llm", 1);
+    r.check(results.size() == 1, "limit caps result count");
+
+    r.check(index.search("", 10).empty(), "empty query returns empty");
+
+    index.rebuild({{"only-model", {"llm"}}});
+    r.check(index.size() == 1 && index.search("llama", 10).empty(),
+            "rebuild replaces previous entries");
+
+    printf("\n%d passed, %d failed\n", r.passed, r.failed);
+    return r.failed == 0 ? 0 : 1;
+}
@@ -0,0 +1,59 @@
+// Standalone test for beacon payload building: v1 compatibility, v2
+// heartbeat vs keyframe field sets, and status block embedding.
+//
+// Compile: g++ -std=c++17 -I src/cpp/include test/cpp/test_network_beacon.cpp \
+//              src/cpp/server/utils/network_beacon.cpp -pthread \
+//              -o test_network_beacon
+
+#include "lemon/utils/network_beacon.h"
+
+#include <cstdio>
+#include <string>
+
+static int g_failures = 0;
+
+static void check(const char* name, bool ok) {
+    std::printf("[%s] %s\n", ok ? "PASS" : "FAIL", name);
+    if (!ok) ++g_failures;
+}
+
+static bool contains(const std::string& haystack, const std::string& needle) {
+    return haystack.find(needle) != std::string::npos;
+}
+
+int main() {
+    NetworkBeacon beacon;
+
+    const std::string v1 = beacon.buildStandardPayloadPattern(
+        "myhost", "http://10.0.0.5:8000/api/v1/");
+    check("v1: service marker present", contains(v1, "\"service\": \"lemonade\""));
+    check("v1: hostname present", contains(v1, "\"hostname\": \"myhost\""));
+    check("v1: url present", contains(v1, "\"url\": \"http://10.0.0.5:8000/api/v1/\""));
+    check("v1: no protocol version field", !contains(v1, "\"v\":"));
+    check("v1: no sequence field", !contains(v1, "\"seq\":"));
+    check("v1: no status field", !contains(v1, "\"status\":"));
+
+    const std::string heartbeat = beacon.buildStandardPayloadPattern(
+        "myhost", "http://10.0.0.5:8000/api/v1/", "", 7, 4);
+    check("heartbeat: protocol version 2", contains(heartbeat, "\"v\": 2"));
+    check("heartbeat: sequence carried", contains(heartbeat, "\"seq\": 7"));
+    check("heartbeat: interval advertised", contains(heartbeat, "\"interval\": 4"));
+    check("heartbeat: status omitted", !contains(heartbeat, "\"status\":"));
+
+    const std::string keyframe = beacon.buildStandardPayloadPattern(
+        "myhost", "http://127.0.0.1:8000/api/v1/",
+        "{\"loaded\": [], \"load_factor\": 0.0}", 8, 2);
+    check("keyframe: sequence carried", contains(keyframe, "\"seq\": 8"));
+    check("keyframe: status embedded verbatim",
+          contains(keyframe, "\"status\": {\"loaded\": [], \"load_factor\": 0.0}"));
+    check("keyframe: payload is an object",
+          !keyframe.empty() && keyframe.front() == '{' && keyframe.back() == '}');
+
+    const std::string legacy_status = beacon.buildStandardPayloadPattern(
+        "myhost", "http://127.0.0.1:8000/api/v1/", "{\"loaded\": []}");
+    check("legacy status: no v2 fields without interval",
+          !contains(legacy_status, "\"v\":") && contains(legacy_status, "\"status\":"));
+
+    std::printf("%s\n", g_failures == 0 ? "ALL PASS" : "FAILURES");
+    return g_failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,116 @@
+// Standalone test for the per-layer GPU offload planner.
+//
+// Compile: g++ -std=c++17 -I src/cpp/include test/cpp/test_offload_planner.cpp -o test_offload_planner
+
+#include "lemon/offload_planner.h"
+#include <cstdio>
+
+using lemon::GgufMetadata;
+using lemon::plan_gpu_offload_layers;
+
+static int g_failures = 0;
+
+static void check(const char* name, bool ok) {
+    std::printf("[%s] %s\n", ok ? "PASS" : "FAIL", name);
+    if (!ok) ++g_failures;
+}
+
+static GgufMetadata uniform_model(int64_t blocks, int64_t heads, int64_t key_length) {
+    GgufMetadata m;
+    m.block_count = blocks;
+    m.key_length = key_length;
+    m.head_count_kv_per_layer.assign(static_cast<size_t>(blocks), heads);
+    m.head_count_kv = heads * blocks;
+    return m;
+}
+
+static void test_insufficient_inputs() {
+    GgufMetadata m = uniform_model(32, 8, 128);
+    check("no block count -> no plan",
+          plan_gpu_offload_layers(GgufMetadata{}, 8.0, 4096, 24.0) == -1);
+    check("unknown model size -> no plan",
+          plan_gpu_offload_layers(m, 0.0, 4096, 24.0) == -1);
+    check("no ctx -> no plan",
+          plan_gpu_offload_layers(m, 8.0, 0, 24.0) == -1);
+    check("no vram measurement -> no plan",
+          plan_gpu_offload_layers(m, 8.0, 4096, 0.0) == -1);
+}
+
+static void test_full_offload_when_it_fits() {
+    GgufMetadata m = uniform_model(32, 8, 128);
+    // 8 GB weights + 32 layers × 8×128×4×4096 ≈ 0.5 GB KV, far below 24 GB.
+    int n = plan_gpu_offload_layers(m, 8.0, 4096, 24.0);
+    check("7B on 24 GB offloads every block plus the output layer", n == 33);
+}
+
+static void test_partial_offload_for_large_model() {
+    GgufMetadata m = uniform_model(80, 8, 128);
+    // 40 GB of weights on a 24 GB card: only a fraction of the 80 blocks fit.
+    int n = plan_gpu_offload_layers(m, 40.0, 4096, 24.0);
+    check("70B on 24 GB offloads a partial layer set", n > 0 && n < 80);
+    // Weights alone are 0.5 GB/layer; 22.5 GB usable can never take > 45.
+    check("partial plan respects the weight budget", n <= 45);
+}
+
+static void test_nothing_fits() {
+    GgufMetadata m = uniform_model(32, 8, 128);
+    int n = plan_gpu_offload_layers(m, 8.0, 4096, 1.0);
+    check("vram below fixed overhead -> zero layers", n == 0);
+}
+
+static void test_larger_ctx_fits_fewer_layers() {
+    GgufMetadata m = uniform_model(80, 8, 128);
+    int small_ctx = plan_gpu_offload_layers(m, 40.0, 4096, 24.0);
+    int large_ctx = plan_gpu_offload_layers(m, 40.0, 131072, 24.0);
+    check("growing ctx shrinks the layer plan", large_ctx < small_ctx);
+}
+
+static void test_swa_layers_cost_less() {
+    GgufMetadata full = uniform_model(48, 8, 128);
+    GgufMetadata swa = full;
+    swa.key_length_swa = 32;
+    swa.sliding_window_pattern.assign(48, true);
+    for (size_t i = 0; i < 48; i += 6)
+        swa.sliding_window_pattern[i] = false;
+
+    int n_full = plan_gpu_offload_layers(full, 20.0, 65536, 24.0);
+    int n_swa = plan_gpu_offload_layers(swa, 20.0, 65536, 24.0);
+    check("swa-reduced kv lets more layers fit", n_swa >= n_full);
+}
+
+static void test_hybrid_ssm_layers_free_of_kv() {
+    GgufMetadata hybrid = uniform_model(48, 8, 128);
+    hybrid.full_attention_interval = 4;
+
+    GgufMetadata dense = uniform_model(48, 8, 128);
+    int n_hybrid = plan_gpu_offload_layers(hybrid, 20.0, 65536, 24.0);
+    int n_dense = plan_gpu_offload_layers(dense, 20.0, 65536, 24.0);
+    check("ssm layers carry no kv so more of them fit", n_hybrid >= n_dense);
+}
+
+static void test_scalar_fallback() {
+    GgufMetadata m;
+    m.block_count = 32;
+    m.key_length = 128;
+    m.head_count_kv = 8 * 32;
+    int n = plan_gpu_offload_layers(m, 8.0, 4096, 24.0);
+    check("scalar-only metadata still produces a plan", n == 33);
+}
+
+int main() {
+    test_insufficient_inputs();
+    test_full_offload_when_it_fits();
+    test_partial_offload_for_large_model();
+    test_nothing_fits();
+    test_larger_ctx_fits_fewer_layers();
+    test_swa_layers_cost_less();
+    test_hybrid_ssm_layers_free_of_kv();
+    test_scalar_fallback();
+
+    if (g_failures == 0) {
+        std::printf("\nAll offload planner tests passed.\n");
+        return 0;
+    }
+    std::printf("\n%d offload planner test(s) FAILED.\n", g_failures);
+    return 1;
+}
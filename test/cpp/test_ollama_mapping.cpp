@@ -0,0 +1,159 @@
+// Ollama mapping core: request translation (messages, images, tools, options
+// precedence), response translation (content, thinking, tool calls, timings),
+// and streaming delta chunks.
+
+#include "lemon/ollama_mapping.h"
+
+#include <cstdio>
+#include <string>
+
+using lemon::ollama::json;
+
+static int g_failures = 0;
+
+static void check(const char* name, bool ok) {
+    std::printf("[%s] %s\n", ok ? "PASS" : "FAIL", name);
+    if (!ok) {
+        ++g_failures;
+    }
+}
+
+static void test_chat_request() {
+    json request = {
+        {"model", "llama3:latest"},
+        {"messages", json::array({
+            {{"role", "system"}, {"content", "be brief"}},
+            {{"role", "user"}, {"content", "hi"}},
+        })},
+        {"options", {{"temperature", 0.2}, {"num_predict", 64}}},
+        {"temperature", 0.9},
+        {"think", true},
+        {"format", "json"},
+        {"stream", true},
+    };
+
+    json openai = lemon::ollama::chat_request_to_openai(std::move(request), "llama3");
+
+    check("model replaced with normalized name", openai["model"] == "llama3");
+    check("messages carried over", openai["messages"].size() == 2 &&
+                                       openai["messages"][1]["content"] == "hi");
+    check("options sub-object mapped", openai["max_tokens"] == 64);
+    check("top-level option wins over options sub-object", openai["temperature"] == 0.9);
+    check("think maps to enable_thinking", openai["enable_thinking"] == true);
+    check("format json maps to response_format",
+          openai["response_format"]["type"] == "json_object");
+    check("stream reset for the caller", openai["stream"] == false);
+}
+
+static void test_chat_request_images_and_tools() {
+    json request = {
+        {"model", "llava"},
+        {"messages", json::array({
+            {{"role", "user"}, {"content", "what is this"}, {"images", json::array({"QUJD"})}},
+            {{"role", "assistant"},
+             {"tool_calls", json::array({
+                 {{"id", "call_1"},
+                  {"function", {{"name", "lookup"}, {"arguments", {{"q", "x"}}}}}},
+             })}},
+            {{"role", "tool"}, {"content", "42"}, {"tool_name", "lookup"}},
+        })},
+        {"tools", json::array({{{"type", "function"}, {"function", {{"name", "lookup"}}}}})},
+    };
+
+    json openai = lemon::ollama::chat_request_to_openai(std::move(request), "llava");
+
+    const auto& image_msg = openai["messages"][0];
+    check("image message becomes content parts",
+          image_msg["content"].is_array() && image_msg["content"].size() == 2 &&
+              image_msg["content"][1]["image_url"]["url"] == "data:image/png;base64,QUJD");
+
+    const auto& assistant = openai["messages"][1];
+    check("tool-call arguments stringified",
+          assistant["tool_calls"][0]["function"]["arguments"].is_string());
+    check("tool-call type defaulted", assistant["tool_calls"][0]["type"] == "function");
+
+    check("tool result resolves id by tool_name",
+          openai["messages"][2]["tool_call_id"] == "call_1");
+    check("tools forwarded", openai["tools"].size() == 1);
+}
+
+static void test_completion_request() {
+    json request = {
+        {"model", "llama3"},
+        {"prompt", "Once upon a time"},
+        {"options", {{"seed", 7}}},
+    };
+
+    json openai = lemon::ollama::completion_request_to_openai(std::move(request), "llama3");
+
+    check("prompt carried over", openai["prompt"] == "Once upon a time");
+    check("seed mapped", openai["seed"] == 7);
+    check("completion stream reset", openai["stream"] == false);
+}
+
+static void test_chat_response() {
+    json response = {
+        {"choices", json::array({
+            {{"message",
+              {{"role", "assistant"},
+               {"content", "hello"},
+               {"reasoning_content", "thinking aloud"},
+               {"tool_calls", json::array({
+                   {{"id", "call_1"},
+                    {"function", {{"name", "lookup"}, {"arguments", "{\"q\":1}"}}}},
+               })}}},
+             {"finish_reason", "stop"}},
+        })},
+        {"usage", {{"prompt_tokens", 10}, {"completion_tokens", 5}}},
+        {"timings", {{"prompt_n", 11}, {"predicted_n", 6}, {"prompt_ms", 2.0}, {"predicted_ms", 3.0}}},
+    };
+
+    json ollama = lemon::ollama::chat_response_to_ollama(std::move(response), "llama3");
+
+    check("content mapped", ollama["message"]["content"] == "hello");
+    check("reasoning maps to thinking", ollama["message"]["thinking"] == "thinking aloud");
+    check("tool-call arguments parsed to object",
+          ollama["message"]["tool_calls"][0]["function"]["arguments"]["q"] == 1);
+    check("done_reason from finish_reason", ollama["done_reason"] == "stop");
+    check("timings override usage counts",
+          ollama["prompt_eval_count"] == 11 && ollama["eval_count"] == 6);
+    check("timings converted to nanoseconds",
+          ollama["prompt_eval_duration"] == 2000000 && ollama["eval_duration"] == 3000000);
+
+    json empty = lemon::ollama::chat_response_to_ollama(json::object(), "llama3");
+    check("choice-less response still done", empty["done"] == true);
+}
+
+static void test_delta() {
+    json chunk = {
+        {"choices", json::array({
+            {{"delta", {{"content", "hi"}}}, {"finish_reason", nullptr}},
+        })},
+    };
+    json ollama = lemon::ollama::delta_to_ollama(std::move(chunk), "llama3");
+    check("delta content mapped", ollama["message"]["content"] == "hi");
+    check("mid-stream chunk not done", ollama["done"] == false);
+
+    json final_chunk = {
+        {"choices", json::array({
+            {{"delta", json::object()}, {"finish_reason", "stop"}},
+        })},
+    };
+    json done = lemon::ollama::delta_to_ollama(std::move(final_chunk), "llama3");
+    check("finish_reason marks done", done["done"] == true && done["done_reason"] == "stop");
+}
+
+int main() {
+    test_chat_request();
+    test_chat_request_images_and_tools();
+    test_completion_request();
+    test_chat_response();
+    test_delta();
+
+    if (g_failures > 0) {
+        std::printf("%d check(s) failed\n", g_failures);
+        return 1;
+    }
+    std::printf("All checks passed\n");
+    return 0;
+}
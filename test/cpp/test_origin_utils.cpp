@@ -296,6 +296,52 @@ static void test_is_websocket_origin_allowed(TestResult& r) {
     }
 }
 
+static void test_origin_allow_cache(TestResult& r) {
+    using namespace lemon::utils;
+
+    OriginAllowCache cache;
+
+    if (cache.allowed("http://localhost:3000", "") &&
+        cache.allowed("http://localhost:3000", "")) {
+        r.ok("cache allows loopback on repeat lookups");
+    } else {
+        r.fail("cache allows loopback on repeat lookups");
+    }
+
+    if (!cache.allowed("http://evil.example", "") &&
+        !cache.allowed("http://evil.example", "")) {
+        r.ok("cache denies cross origin on repeat lookups");
+    } else {
+        r.fail("cache denies cross origin on repeat lookups");
+    }
+
+    if (cache.allowed("http://app.example:8080", "http://app.example:8080")) {
+        r.ok("cache allows origin from allow list");
+    } else {
+        r.fail("cache allows origin from allow list");
+    }
+
+    // A changed allow list must invalidate previously cached decisions.
+    if (!cache.allowed("http://app.example:8080", "")) {
+        r.ok("cache invalidates when allow list changes");
+    } else {
+        r.fail("cache invalidates when allow list changes");
+    }
+
+    // Overflowing the bound must not change answers.
+    bool overflow_ok = true;
+    for (int i = 0; i < 600; ++i) {
+        cache.allowed("http://host" + std::to_string(i) + ".example", "");
+    }
+    overflow_ok = overflow_ok && cache.allowed("http://localhost:3000", "");
+    overflow_ok = overflow_ok && !cache.allowed("http://evil.example", "");
+    if (overflow_ok) {
+        r.ok("cache stays correct past its size bound");
+    } else {
+        r.fail("cache stays correct past its size bound");
+    }
+}
+
 int main() {
     TestResult r;
     printf("=== OriginUtils Unit Tests ===\n\n");
@@ -304,6 +350,7 @@ int main() {
     test_origin_matching(r);
     test_is_origin_allowed(r);
     test_is_websocket_origin_allowed(r);
+    test_origin_allow_cache(r);
 
     printf("\n%d/%d tests passed\n", r.passed, r.passed + r.failed);
     return r.failed == 0 ? 0 : 1;
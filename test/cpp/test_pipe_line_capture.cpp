@@ -0,0 +1,103 @@
+// Standalone test for the pipe line capture: chunk-boundary line splitting,
+// EOF flush, oversized-line flushing, and the per-second rate limit with
+// dropped-line accounting.
+//
+// Compile: g++ -std=c++17 -I src/cpp/include test/cpp/test_pipe_line_capture.cpp \
+//              -o test_pipe_line_capture
+
+#include "lemon/utils/pipe_line_capture.h"
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+using lemon::utils::PipeLineCapture;
+
+static int g_failures = 0;
+
+static void check(const char* name, bool ok) {
+    std::printf("[%s] %s\n", ok ? "PASS" : "FAIL", name);
+    if (!ok) ++g_failures;
+}
+
+static void test_line_splitting() {
+    std::vector<std::string> lines;
+    PipeLineCapture capture([&](const std::string& line) { lines.push_back(line); });
+
+    const std::string chunk = "alpha\nbeta\ngam";
+    capture.feed(chunk.data(), chunk.size());
+    check("split: complete lines emitted", lines.size() == 2 &&
+          lines[0] == "alpha" && lines[1] == "beta");
+
+    const std::string rest = "ma\ndelta";
+    capture.feed(rest.data(), rest.size());
+    check("split: line across chunk boundary", lines.size() == 3 && lines[2] == "gamma");
+
+    capture.finish();
+    check("split: EOF flushes trailing partial line",
+          lines.size() == 4 && lines[3] == "delta");
+    check("split: nothing dropped", capture.total_dropped_lines() == 0);
+}
+
+static void test_empty_lines() {
+    std::vector<std::string> lines;
+    PipeLineCapture capture([&](const std::string& line) { lines.push_back(line); });
+
+    const std::string chunk = "\n\nx\n";
+    capture.feed(chunk.data(), chunk.size());
+    capture.finish();
+    check("empty: blank lines preserved", lines.size() == 3 &&
+          lines[0].empty() && lines[1].empty() && lines[2] == "x");
+}
+
+static void test_oversized_line_flush() {
+    std::vector<std::string> lines;
+    PipeLineCapture capture([&](const std::string& line) { lines.push_back(line); });
+
+    const std::string big(PipeLineCapture::kMaxLineBytes + 10, 'x');
+    capture.feed(big.data(), big.size());
+    check("oversize: unterminated line flushed at the bound",
+          lines.size() == 1 && lines[0].size() == big.size());
+}
+
+static void test_rate_limit() {
+    std::vector<std::string> lines;
+    PipeLineCapture capture([&](const std::string& line) { lines.push_back(line); }, 3);
+
+    const std::string burst = "1\n2\n3\n4\n5\n6\n";
+    capture.feed(burst.data(), burst.size());
+    check("rate: only the budgeted lines emitted",
+          lines.size() == 3 && lines[2] == "3");
+    check("rate: overflow counted", capture.total_dropped_lines() == 3);
+
+    capture.finish();
+    check("rate: drop summary reported at EOF",
+          lines.size() == 4 &&
+          lines[3].find("dropped 3 lines") != std::string::npos);
+}
+
+static void test_drain_continues_past_limit() {
+    std::vector<std::string> lines;
+    PipeLineCapture capture([&](const std::string& line) { lines.push_back(line); }, 1);
+
+    // Rate-limited input must still be consumed in full: the internal buffer
+    // never grows with already-split lines, which is what keeps the pipe
+    // reader draining.
+    for (int i = 0; i < 1000; ++i) {
+        const std::string chunk = "line " + std::to_string(i) + "\n";
+        capture.feed(chunk.data(), chunk.size());
+    }
+    check("drain: all input consumed", capture.total_dropped_lines() == 999);
+    check("drain: one line within budget", lines.size() == 1 && lines[0] == "line 0");
+}
+
+int main() {
+    test_line_splitting();
+    test_empty_lines();
+    test_oversized_line_flush();
+    test_rate_limit();
+    test_drain_continues_past_limit();
+
+    std::printf("%s\n", g_failures == 0 ? "ALL PASS" : "FAILURES");
+    return g_failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,90 @@
+// Per-key quota enforcement: request-rate bucket, post-paid token bucket,
+// concurrent-stream slots, and refill over time.
+
+#include "lemon/rate_limiter.h"
+
+#include <chrono>
+#include <cstdio>
+#include <thread>
+
+using lemon::RateLimiter;
+
+static int g_failures = 0;
+
+static void check(const char* name, bool ok) {
+    std::printf("[%s] %s\n", ok ? "PASS" : "FAIL", name);
+    if (!ok) {
+        ++g_failures;
+    }
+}
+
+static void test_disabled_admits_everything() {
+    RateLimiter limiter;
+    bool all_allowed = true;
+    for (int i = 0; i < 100; ++i) {
+        all_allowed = all_allowed && limiter.admit_request("key").allowed;
+    }
+    check("disabled limiter admits everything", all_allowed);
+}
+
+static void test_request_rate_bucket() {
+    RateLimiter limiter;
+    limiter.set_limits({2.0, 0.0, 0});
+
+    check("first request admitted", limiter.admit_request("alice").allowed);
+    check("burst up to the rate admitted", limiter.admit_request("alice").allowed);
+    auto denied = limiter.admit_request("alice");
+    check("request over the rate denied", !denied.allowed);
+    check("denial carries retry-after", denied.retry_after_seconds >= 1);
+    check("other keys are unaffected", limiter.admit_request("bob").allowed);
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(600));
+    check("bucket refills over time", limiter.admit_request("alice").allowed);
+}
+
+static void test_token_debt_blocks_admission() {
+    RateLimiter limiter;
+    limiter.set_limits({0.0, 60.0, 0});
+
+    check("token bucket starts open", limiter.admit_request("alice").allowed);
+    limiter.record_tokens("alice", 120.0);
+    auto denied = limiter.admit_request("alice");
+    check("key in token debt is denied", !denied.allowed);
+    check("token denial carries retry-after", denied.retry_after_seconds >= 1);
+    check("token debt is per key", limiter.admit_request("bob").allowed);
+}
+
+static void test_concurrent_stream_slots() {
+    RateLimiter limiter;
+    limiter.set_limits({0.0, 0.0, 1});
+
+    RateLimiter::StreamLease first;
+    check("first stream acquires", limiter.acquire_stream("alice", first));
+    RateLimiter::StreamLease second;
+    check("second stream over the limit fails",
+          !limiter.acquire_stream("alice", second));
+    check("stream slots are per key", limiter.active_streams("alice") == 1);
+
+    RateLimiter::StreamLease moved = std::move(first);
+    first.release();
+    check("moved-from lease holds no slot", limiter.active_streams("alice") == 1);
+
+    moved.release();
+    check("release frees the slot", limiter.active_streams("alice") == 0);
+    RateLimiter::StreamLease again;
+    check("slot can be re-acquired", limiter.acquire_stream("alice", again));
+}
+
+int main() {
+    test_disabled_admits_everything();
+    test_request_rate_bucket();
+    test_token_debt_blocks_admission();
+    test_concurrent_stream_slots();
+
+    if (g_failures > 0) {
+        std::printf("%d check(s) failed\n", g_failures);
+        return 1;
+    }
+    std::printf("All checks passed\n");
+    return 0;
+}
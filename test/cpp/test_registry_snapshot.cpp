@@ -0,0 +1,133 @@
+// Standalone test for the binary registry snapshot: hash-validated
+// read/write round-trips, rejection of stale or corrupt snapshots, and the
+// parse-or-snapshot load path.
+//
+// Compile: g++ -std=c++17 -I src/cpp/include test/cpp/test_registry_snapshot.cpp \
+//              src/cpp/server/registry_snapshot.cpp -o test_registry_snapshot
+
+#include "lemon/registry_snapshot.h"
+
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+
+namespace fs = std::filesystem;
+namespace snap = lemon::registry_snapshot;
+using nlohmann::json;
+
+static int g_failures = 0;
+
+static void check(const char* name, bool ok) {
+    std::printf("[%s] %s\n", ok ? "PASS" : "FAIL", name);
+    if (!ok) ++g_failures;
+}
+
+static json sample_registry() {
+    return {
+        {"Model-A", {{"recipe", "llamacpp"}, {"checkpoint", "org/repo:file.gguf"}}},
+        {"Model-B", {{"recipe", "whispercpp"}, {"size", 1.5}}},
+    };
+}
+
+static void write_text(const fs::path& path, const std::string& text) {
+    std::ofstream file(path, std::ios::trunc);
+    file << text;
+}
+
+static void test_hash_stability() {
+    check("hash: equal inputs agree",
+          snap::hash_bytes("{\"a\":1}") == snap::hash_bytes("{\"a\":1}"));
+    check("hash: different inputs differ",
+          snap::hash_bytes("{\"a\":1}") != snap::hash_bytes("{\"a\":2}"));
+}
+
+static void test_roundtrip(const fs::path& dir) {
+    const fs::path path = dir / "roundtrip.bin";
+    const json doc = sample_registry();
+    const std::uint64_t hash = snap::hash_bytes(doc.dump());
+
+    check("roundtrip: write succeeds", snap::write_snapshot(path, hash, doc));
+
+    json out;
+    check("roundtrip: read with matching hash succeeds",
+          snap::read_snapshot(path, hash, out));
+    check("roundtrip: document survives", out == doc);
+    check("roundtrip: mismatched hash rejected",
+          !snap::read_snapshot(path, hash + 1, out));
+}
+
+static void test_corrupt_rejected(const fs::path& dir) {
+    const fs::path path = dir / "corrupt.bin";
+    const json doc = sample_registry();
+    const std::uint64_t hash = snap::hash_bytes(doc.dump());
+    snap::write_snapshot(path, hash, doc);
+
+    // Truncate mid-payload; the recorded payload size no longer matches.
+    const auto size = fs::file_size(path);
+    fs::resize_file(path, size - 5);
+    json out;
+    check("corrupt: truncated snapshot rejected",
+          !snap::read_snapshot(path, hash, out));
+
+    write_text(path, "not a snapshot at all");
+    check("corrupt: garbage file rejected", !snap::read_snapshot(path, hash, out));
+    check("corrupt: missing file rejected",
+          !snap::read_snapshot(dir / "does-not-exist.bin", hash, out));
+}
+
+static void test_load_prefers_snapshot(const fs::path& dir) {
+    const fs::path source = dir / "registry.json";
+    const fs::path snapshot = dir / "registry.bin";
+    const json doc = sample_registry();
+    write_text(source, doc.dump(2));
+
+    json loaded = snap::load(source.string(), snapshot);
+    check("load: parses source on first run", loaded == doc);
+    check("load: snapshot written after parse", fs::exists(snapshot));
+
+    // Replace the snapshot payload with a marker document under the current
+    // source hash; load must serve it, proving the parse was skipped.
+    std::string source_bytes = doc.dump(2);
+    const json marker = {{"from_snapshot", true}};
+    snap::write_snapshot(snapshot, snap::hash_bytes(source_bytes), marker);
+    loaded = snap::load(source.string(), snapshot);
+    check("load: unchanged source served from snapshot", loaded == marker);
+
+    // Edit the source; the marker snapshot is now stale and must be replaced.
+    json changed = doc;
+    changed["Model-C"] = {{"recipe", "sdcpp"}};
+    write_text(source, changed.dump(2));
+    loaded = snap::load(source.string(), snapshot);
+    check("load: changed source re-parsed", loaded == changed);
+    json out;
+    check("load: snapshot refreshed for new source",
+          snap::read_snapshot(snapshot, snap::hash_bytes(changed.dump(2)), out) &&
+              out == changed);
+}
+
+static void test_load_missing_source_throws(const fs::path& dir) {
+    bool threw = false;
+    try {
+        snap::load((dir / "missing.json").string(), dir / "missing.bin");
+    } catch (const std::exception&) {
+        threw = true;
+    }
+    check("load: missing source throws", threw);
+}
+
+int main() {
+    const fs::path dir =
+        fs::temp_directory_path() / "lemonade_registry_snapshot_test";
+    fs::remove_all(dir);
+    fs::create_directories(dir);
+
+    test_hash_stability();
+    test_roundtrip(dir);
+    test_corrupt_rejected(dir);
+    test_load_prefers_snapshot(dir);
+    test_load_missing_source_throws(dir);
+
+    fs::remove_all(dir);
+    std::printf("%s\n", g_failures == 0 ? "ALL PASS" : "FAILURES");
+    return g_failures == 0 ? 0 : 1;
+}
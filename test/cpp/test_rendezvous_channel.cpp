@@ -0,0 +1,58 @@
+// Standalone test for the lemond rendezvous channel: claim, state payload
+// round-trips over the local endpoint, port retention on state-only updates,
+// and teardown leaving no answering endpoint behind.
+
+#include "lemon/utils/rendezvous_channel.h"
+
+#include <cstdio>
+#ifndef _WIN32
+#include <cstdlib>
+#endif
+
+using lemon::utils::RendezvousChannel;
+
+static int g_failures = 0;
+
+static void check(const char* name, bool ok) {
+    std::printf("[%s] %s\n", ok ? "PASS" : "FAIL", name);
+    if (!ok) ++g_failures;
+}
+
+int main() {
+#ifndef _WIN32
+    // Headless CI runners often lack a session runtime directory.
+    setenv("XDG_RUNTIME_DIR", "/tmp", 0);
+#endif
+    auto& channel = RendezvousChannel::global();
+
+    nlohmann::json hello;
+    check("query before start fails", !RendezvousChannel::query(hello));
+
+    channel.set_state("starting", 8123);
+    channel.start();
+
+    check("query after start succeeds", RendezvousChannel::query(hello));
+    check("service marker present", hello.value("service", "") == "lemonade");
+    check("starting state served", hello.value("state", "") == "starting");
+    check("port served", hello.value("port", 0) == 8123);
+    check("pid served", hello.value("pid", 0) > 0);
+    check("version served", !hello.value("version", "").empty());
+
+    channel.set_state("ready", 9001);
+    hello = nlohmann::json();
+    check("query after update succeeds", RendezvousChannel::query(hello));
+    check("ready state served", hello.value("state", "") == "ready");
+    check("updated port served", hello.value("port", 0) == 9001);
+
+    channel.set_state("stopping");
+    hello = nlohmann::json();
+    check("query during stopping succeeds", RendezvousChannel::query(hello));
+    check("stopping state served", hello.value("state", "") == "stopping");
+    check("port retained on state-only update", hello.value("port", 0) == 9001);
+
+    channel.stop();
+    check("query after stop fails", !RendezvousChannel::query(hello));
+
+    std::printf("%s\n", g_failures == 0 ? "ALL PASS" : "FAILURES");
+    return g_failures == 0 ? 0 : 1;
+}
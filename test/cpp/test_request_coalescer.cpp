@@ -0,0 +1,146 @@
+// In-flight request coalescing: leader election, fan-out, error propagation.
+
+#include "lemon/request_coalescer.h"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <nlohmann/json.hpp>
+
+using json = nlohmann::json;
+using lemon::RequestCoalescer;
+
+static int g_failures = 0;
+
+static void check(const char* name, bool ok) {
+    std::printf("[%s] %s\n", ok ? "PASS" : "FAIL", name);
+    if (!ok) {
+        ++g_failures;
+    }
+}
+
+static json deterministic_request(const std::string& prompt) {
+    return json{{"model", "test"}, {"prompt", prompt}, {"temperature", 0.0}};
+}
+
+static void test_determinism_gate() {
+    check("temperature 0 qualifies",
+          RequestCoalescer::is_deterministic(deterministic_request("hi")));
+    check("missing temperature bypasses",
+          !RequestCoalescer::is_deterministic(json{{"prompt", "hi"}}));
+    check("nonzero temperature bypasses",
+          !RequestCoalescer::is_deterministic(
+              json{{"prompt", "hi"}, {"temperature", 0.7}}));
+    check("streaming bypasses",
+          !RequestCoalescer::is_deterministic(
+              json{{"prompt", "hi"}, {"temperature", 0.0}, {"stream", true}}));
+}
+
+static void test_fan_out() {
+    RequestCoalescer coalescer;
+    const json request = deterministic_request("shared");
+
+    std::mutex gate_mutex;
+    std::condition_variable gate_cv;
+    bool release = false;
+    std::atomic<int> computations{0};
+    std::atomic<int> started{0};
+
+    auto compute = [&] {
+        computations++;
+        started++;
+        std::unique_lock<std::mutex> lock(gate_mutex);
+        gate_cv.wait(lock, [&] { return release; });
+        return json{{"answer", 42}};
+    };
+
+    std::vector<std::thread> workers;
+    std::vector<json> results(4);
+    for (int i = 0; i < 4; ++i) {
+        workers.emplace_back([&, i] { results[i] = coalescer.run("chat", request, compute); });
+    }
+
+    // Wait until the leader is inside compute, then give the followers a
+    // moment to attach before releasing the result.
+    while (started.load() == 0) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    {
+        std::lock_guard<std::mutex> lock(gate_mutex);
+        release = true;
+    }
+    gate_cv.notify_all();
+    for (auto& worker : workers) {
+        worker.join();
+    }
+
+    check("single computation for identical requests", computations.load() == 1);
+    bool all_match = true;
+    for (const auto& result : results) {
+        all_match = all_match && result == json{{"answer", 42}};
+    }
+    check("result fanned out to every waiter", all_match);
+}
+
+static void test_distinct_requests_not_coalesced() {
+    RequestCoalescer coalescer;
+    std::atomic<int> computations{0};
+    auto compute = [&] {
+        computations++;
+        return json{{"ok", true}};
+    };
+    coalescer.run("chat", deterministic_request("a"), compute);
+    coalescer.run("chat", deterministic_request("b"), compute);
+    coalescer.run("completion", deterministic_request("a"), compute);
+    check("distinct prompts and endpoints compute separately",
+          computations.load() == 3);
+}
+
+static void test_sequential_reuse_recomputes() {
+    RequestCoalescer coalescer;
+    std::atomic<int> computations{0};
+    const json request = deterministic_request("again");
+    auto compute = [&] {
+        computations++;
+        return json{{"n", computations.load()}};
+    };
+    json first = coalescer.run("chat", request, compute);
+    json second = coalescer.run("chat", request, compute);
+    check("finished entries are retired, not replayed",
+          computations.load() == 2 && first != second);
+}
+
+static void test_error_propagation() {
+    RequestCoalescer coalescer;
+    bool threw = false;
+    try {
+        coalescer.run("chat", deterministic_request("boom"),
+                      []() -> json { throw std::runtime_error("backend down"); });
+    } catch (const std::runtime_error& e) {
+        threw = std::string(e.what()) == "backend down";
+    }
+    check("leader error rethrown to caller", threw);
+}
+
+int main() {
+    test_determinism_gate();
+    test_fan_out();
+    test_distinct_requests_not_coalesced();
+    test_sequential_reuse_recomputes();
+    test_error_propagation();
+
+    if (g_failures != 0) {
+        std::printf("%d check(s) failed\n", g_failures);
+        return 1;
+    }
+    std::printf("All request coalescer checks passed\n");
+    return 0;
+}
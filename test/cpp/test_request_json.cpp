@@ -0,0 +1,59 @@
+// Standalone test for the hot-path request body parse seam.
+//
+// Compile: g++ -std=c++17 -I src/cpp/include -I <nlohmann-include> test/cpp/test_request_json.cpp -o test_request_json
+
+#include "lemon/request_json.h"
+#include <cstdio>
+
+using lemon::parse_request_json;
+using nlohmann::json;
+
+static int g_failures = 0;
+
+static void check(const char* name, bool ok) {
+    std::printf("[%s] %s\n", ok ? "PASS" : "FAIL", name);
+    if (!ok) ++g_failures;
+}
+
+static void test_valid_body() {
+    json out;
+    check("valid object parses",
+          parse_request_json(R"({"model": "m", "stream": true})", out) &&
+          out["model"] == "m" && out["stream"] == true);
+
+    json scalar;
+    check("valid scalar parses", parse_request_json("42", scalar) && scalar == 42);
+}
+
+static void test_invalid_body() {
+    json out;
+    std::string error;
+    check("truncated body rejected",
+          !parse_request_json(R"({"model": )", out, &error) && !error.empty());
+
+    json garbage;
+    check("garbage rejected without error sink",
+          !parse_request_json("not json", garbage));
+
+    json empty;
+    check("empty body rejected", !parse_request_json("", empty));
+}
+
+static void test_output_never_discarded_on_success() {
+    json out;
+    parse_request_json(R"({"a": [1, 2, 3]})", out);
+    check("successful parse yields usable DOM", !out.is_discarded() && out["a"].size() == 3);
+}
+
+int main() {
+    test_valid_body();
+    test_invalid_body();
+    test_output_never_discarded_on_success();
+
+    if (g_failures > 0) {
+        std::printf("%d check(s) failed\n", g_failures);
+        return 1;
+    }
+    std::printf("All checks passed\n");
+    return 0;
+}
@@ -0,0 +1,190 @@
+// Rerank batcher: passthrough threshold, chunked index remapping, usage
+// merging, top-n ordering, opt-in early termination, error propagation.
+
+#include "lemon/rerank_batcher.h"
+
+#include <atomic>
+#include <cstdio>
+#include <mutex>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using lemon::RerankBatcher;
+using lemon::json;
+
+static int g_failures = 0;
+
+static void check(const char* name, bool ok) {
+    std::printf("[%s] %s\n", ok ? "PASS" : "FAIL", name);
+    if (!ok) {
+        ++g_failures;
+    }
+}
+
+static json make_request(int docs, json extra = json::object()) {
+    json request = {{"model", "reranker"}, {"query", "q"}, {"documents", json::array()}};
+    for (int i = 0; i < docs; ++i) {
+        request["documents"].push_back("doc-" + std::to_string(i));
+    }
+    for (const auto& [key, value] : extra.items()) {
+        request[key] = value;
+    }
+    return request;
+}
+
+// Scores each document by the numeric suffix of its "doc-N" text, so global
+// ordering is knowable regardless of how the batcher chunks the list.
+static json score_by_suffix(const json& chunk) {
+    json results = json::array();
+    const auto& docs = chunk.at("documents");
+    for (size_t i = 0; i < docs.size(); ++i) {
+        const std::string text = docs[i].get<std::string>();
+        const double value = std::stod(text.substr(text.rfind('-') + 1));
+        results.push_back({{"index", i}, {"relevance_score", value}});
+    }
+    return {{"model", "reranker"},
+            {"results", results},
+            {"usage", {{"total_tokens", docs.size()}}}};
+}
+
+static void test_passthrough() {
+    RerankBatcher batcher(8, 2);
+
+    int calls = 0;
+    json seen;
+    json request = make_request(8, {{"top_n", 3}});
+    json response = batcher.reranking(request, [&](const json& chunk) {
+        ++calls;
+        seen = chunk;
+        return json{{"results", json::array()}};
+    });
+
+    check("small request forwarded in one call", calls == 1);
+    check("small request forwarded unchanged", seen == request);
+
+    calls = 0;
+    RerankBatcher disabled(0, 2);
+    disabled.reranking(make_request(100), [&](const json&) {
+        ++calls;
+        return json{{"results", json::array()}};
+    });
+    check("chunk size zero disables chunking", calls == 1);
+}
+
+static void test_chunked_merge() {
+    RerankBatcher batcher(8, 2);
+
+    std::mutex seen_mutex;
+    std::vector<size_t> chunk_sizes;
+    json response = batcher.reranking(make_request(20), [&](const json& chunk) {
+        {
+            std::lock_guard<std::mutex> lock(seen_mutex);
+            chunk_sizes.push_back(chunk.at("documents").size());
+        }
+        return score_by_suffix(chunk);
+    });
+
+    check("all chunks scored", chunk_sizes.size() == 3);
+    check("results cover every document", response["results"].size() == 20);
+    check("usage summed across chunks", response["usage"]["total_tokens"] == 20);
+    check("model preserved", response["model"] == "reranker");
+
+    bool indices_global_and_ordered = true;
+    for (size_t i = 0; i < response["results"].size(); ++i) {
+        const auto& entry = response["results"][i];
+        if (entry["index"] != i || entry["relevance_score"] != double(i)) {
+            indices_global_and_ordered = false;
+        }
+    }
+    check("chunk-local indices remapped to global", indices_global_and_ordered);
+}
+
+static void test_top_n_ordering() {
+    RerankBatcher batcher(8, 2);
+
+    std::atomic<bool> top_n_stripped{true};
+    json response = batcher.reranking(make_request(20, {{"top_n", 3}}),
+                                      [&](const json& chunk) {
+                                          if (chunk.contains("top_n")) {
+                                              top_n_stripped = false;
+                                          }
+                                          return score_by_suffix(chunk);
+                                      });
+
+    check("top_n stripped from chunk requests", top_n_stripped.load());
+    check("top_n truncates results", response["results"].size() == 3);
+    check("top_n results score-ordered",
+          response["results"][0]["index"] == 19 &&
+              response["results"][1]["index"] == 18 &&
+              response["results"][2]["index"] == 17);
+}
+
+static void test_early_stop() {
+    RerankBatcher batcher(8, 1);
+
+    // Best documents are in the first chunk, so the top-2 set is already
+    // stable after the second wave and later chunks are never scored.
+    std::atomic<int> calls{0};
+    json response = batcher.reranking(
+        make_request(64, {{"top_n", 2}, {"early_stop", true}}), [&](const json& chunk) {
+            ++calls;
+            json results = json::array();
+            const auto& docs = chunk.at("documents");
+            for (size_t i = 0; i < docs.size(); ++i) {
+                const std::string text = docs[i].get<std::string>();
+                const double value = std::stod(text.substr(text.rfind('-') + 1));
+                results.push_back({{"index", i}, {"relevance_score", 1000.0 - value}});
+            }
+            return json{{"results", results}};
+        });
+
+    check("early stop skips trailing chunks", calls.load() == 2);
+    check("early stop flagged in response", response.value("early_stopped", false));
+    check("early stop still returns the stable top-n",
+          response["results"].size() == 2 && response["results"][0]["index"] == 0 &&
+              response["results"][1]["index"] == 1);
+
+    calls = 0;
+    json full = batcher.reranking(make_request(64, {{"top_n", 2}}), [&](const json& chunk) {
+        ++calls;
+        return score_by_suffix(chunk);
+    });
+    check("early stop is opt-in", calls.load() == 8 && !full.contains("early_stopped"));
+}
+
+static void test_errors() {
+    RerankBatcher batcher(8, 2);
+
+    json error_response = {{"error", {{"message", "backend down"}}}};
+    json response = batcher.reranking(make_request(20), [&](const json&) {
+        return error_response;
+    });
+    check("backend error response propagated", response == error_response);
+
+    bool threw = false;
+    try {
+        batcher.reranking(make_request(20), [&](const json&) -> json {
+            throw std::runtime_error("connection reset");
+        });
+    } catch (const std::runtime_error& e) {
+        threw = std::string(e.what()) == "connection reset";
+    }
+    check("backend exception rethrown", threw);
+}
+
+int main() {
+    test_passthrough();
+    test_chunked_merge();
+    test_top_n_ordering();
+    test_early_stop();
+    test_errors();
+
+    if (g_failures > 0) {
+        std::printf("%d check(s) failed\n", g_failures);
+        return 1;
+    }
+    std::printf("All checks passed\n");
+    return 0;
+}
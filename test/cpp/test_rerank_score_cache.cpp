@@ -0,0 +1,206 @@
+// Rerank score cache: full hits skip the backend, partial hits forward only
+// uncached documents and merge at original indices, model scoping, top-n
+// after merge, early-stop and disabled-cache bypass, LRU eviction.
+
+#include "lemon/rerank_score_cache.h"
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+using lemon::RerankScoreCache;
+using lemon::json;
+
+static int g_failures = 0;
+
+static void check(const char* name, bool ok) {
+    std::printf("[%s] %s\n", ok ? "PASS" : "FAIL", name);
+    if (!ok) {
+        ++g_failures;
+    }
+}
+
+static json make_request(const std::string& query, std::vector<std::string> docs,
+                         json extra = json::object()) {
+    json request = {{"model", "reranker"}, {"query", query}, {"documents", json::array()}};
+    for (const auto& doc : docs) {
+        request["documents"].push_back(doc);
+    }
+    for (const auto& [key, value] : extra.items()) {
+        request[key] = value;
+    }
+    return request;
+}
+
+// Scores each document by the numeric suffix of its "doc-N" text, so expected
+// scores are knowable regardless of which subset reaches the backend.
+static json score_by_suffix(const json& request) {
+    json results = json::array();
+    const auto& docs = request.at("documents");
+    for (size_t i = 0; i < docs.size(); ++i) {
+        const std::string text = docs[i].get<std::string>();
+        const double value = std::stod(text.substr(text.rfind('-') + 1));
+        results.push_back({{"index", i}, {"relevance_score", value}});
+    }
+    return {{"model", "reranker"},
+            {"results", results},
+            {"usage", {{"total_tokens", docs.size()}}}};
+}
+
+static void test_full_hit_skips_backend() {
+    RerankScoreCache cache(64);
+    int calls = 0;
+    auto backend = [&](const json& r) {
+        ++calls;
+        return score_by_suffix(r);
+    };
+
+    json request = make_request("q", {"doc-3", "doc-1", "doc-2"});
+    json first = cache.reranking(request, "reranker", backend);
+    json second = cache.reranking(request, "reranker", backend);
+
+    check("repeat request is served without a backend call", calls == 1);
+    check("cached results match fresh results",
+          second["results"] == first["results"]);
+    check("cached response keeps the model field",
+          second.value("model", "") == "reranker");
+}
+
+static void test_partial_hit_scores_only_uncached() {
+    RerankScoreCache cache(64);
+    int calls = 0;
+    json last_docs;
+    auto backend = [&](const json& r) {
+        ++calls;
+        last_docs = r.at("documents");
+        return score_by_suffix(r);
+    };
+
+    cache.reranking(make_request("q", {"doc-1", "doc-2"}), "reranker", backend);
+    json merged = cache.reranking(
+        make_request("q", {"doc-2", "doc-9", "doc-1"}), "reranker", backend);
+
+    check("second request reaches the backend once", calls == 2);
+    check("only the uncached document is forwarded",
+          last_docs == json::array({"doc-9"}));
+    check("merged response covers all documents", merged["results"].size() == 3);
+    bool indices_ok = true;
+    for (const auto& entry : merged["results"]) {
+        const size_t index = entry["index"].get<size_t>();
+        const double score = entry["relevance_score"].get<double>();
+        const double expected = index == 0 ? 2.0 : (index == 1 ? 9.0 : 1.0);
+        if (score != expected) {
+            indices_ok = false;
+        }
+    }
+    check("cached scores land at original indices", indices_ok);
+}
+
+static void test_top_n_applied_after_merge() {
+    RerankScoreCache cache(64);
+    auto backend = [&](const json& r) { return score_by_suffix(r); };
+
+    cache.reranking(make_request("q", {"doc-5", "doc-1"}), "reranker", backend);
+    json response = cache.reranking(
+        make_request("q", {"doc-1", "doc-9", "doc-5"}, {{"top_n", 2}}),
+        "reranker", backend);
+
+    check("top_n truncates the merged ranking", response["results"].size() == 2);
+    check("best document ranks first",
+          response["results"][0]["index"].get<size_t>() == 1);
+    check("cached score competes in the ranking",
+          response["results"][1]["index"].get<size_t>() == 2);
+}
+
+static void test_model_scoping() {
+    RerankScoreCache cache(64);
+    int calls = 0;
+    auto backend = [&](const json& r) {
+        ++calls;
+        return score_by_suffix(r);
+    };
+
+    json request = make_request("q", {"doc-1"});
+    cache.reranking(request, "model-a", backend);
+    cache.reranking(request, "model-b", backend);
+
+    check("same pair under another model misses", calls == 2);
+}
+
+static void test_bypass() {
+    RerankScoreCache cache(64);
+    int calls = 0;
+    auto backend = [&](const json& r) {
+        ++calls;
+        return score_by_suffix(r);
+    };
+
+    json early = make_request("q", {"doc-1"}, {{"early_stop", true}, {"top_n", 1}});
+    json passed = cache.reranking(early, "reranker", backend);
+    check("early_stop request passes through untouched",
+          calls == 1 && passed.contains("usage"));
+
+    RerankScoreCache disabled(0);
+    disabled.reranking(make_request("q", {"doc-1"}), "reranker", backend);
+    disabled.reranking(make_request("q", {"doc-1"}), "reranker", backend);
+    check("zero-entry cache always calls the backend", calls == 3);
+
+    cache.reranking(make_request("q", {"doc-1"}), "", backend);
+    cache.reranking(make_request("q", {"doc-1"}), "", backend);
+    check("empty model key bypasses the cache", calls == 5);
+}
+
+static void test_lru_eviction() {
+    RerankScoreCache cache(2);
+    int calls = 0;
+    auto backend = [&](const json& r) {
+        ++calls;
+        return score_by_suffix(r);
+    };
+
+    cache.reranking(make_request("q", {"doc-1"}), "reranker", backend);
+    cache.reranking(make_request("q", {"doc-2"}), "reranker", backend);
+    cache.reranking(make_request("q", {"doc-1"}), "reranker", backend);
+    check("recently used pair stays cached", calls == 2);
+
+    cache.reranking(make_request("q", {"doc-3"}), "reranker", backend);
+    cache.reranking(make_request("q", {"doc-2"}), "reranker", backend);
+    check("least recently used pair is evicted", calls == 4);
+}
+
+static void test_error_response_not_cached() {
+    RerankScoreCache cache(64);
+    int calls = 0;
+    auto backend = [&](const json& r) {
+        ++calls;
+        if (calls == 1) {
+            return json{{"error", "backend busy"}};
+        }
+        return score_by_suffix(r);
+    };
+
+    json request = make_request("q", {"doc-1"});
+    json failed = cache.reranking(request, "reranker", backend);
+    check("error response is returned unchanged", failed.contains("error"));
+
+    json retried = cache.reranking(request, "reranker", backend);
+    check("failed pair is retried, not cached",
+          calls == 2 && retried["results"].size() == 1);
+}
+
+int main() {
+    test_full_hit_skips_backend();
+    test_partial_hit_scores_only_uncached();
+    test_top_n_applied_after_merge();
+    test_model_scoping();
+    test_bypass();
+    test_lru_eviction();
+    test_error_response_not_cached();
+
+    if (g_failures > 0) {
+        std::printf("%d check(s) failed\n", g_failures);
+        return 1;
+    }
+    std::printf("all checks passed\n");
+    return 0;
+}
@@ -0,0 +1,59 @@
+// Reservation semantics for guaranteed-capacity models: option parsing and
+// the error surfaced when a load would violate a reservation.
+
+#include "lemon/error_types.h"
+#include "lemon/reservation_policy.h"
+
+#include <cstdio>
+#include <string>
+
+using lemon::ErrorType::RESERVATION_VIOLATION;
+using lemon::ReservationViolationException;
+using lemon::reservation_enabled;
+using lemon::reservation_has_dedicated_slot;
+using nlohmann::json;
+
+static int failures = 0;
+
+static void check(const char* name, bool ok) {
+    std::printf("[%s] %s\n", ok ? "PASS" : "FAIL", name);
+    if (!ok) ++failures;
+}
+
+int main() {
+    check("absent option means not reserved", !reservation_enabled(json::object()));
+    check("reserved true enables the reservation",
+          reservation_enabled({{"reserved", true}}));
+    check("reserved false stays disabled", !reservation_enabled({{"reserved", false}}));
+    check("non-boolean reserved is ignored",
+          !reservation_enabled({{"reserved", "yes"}}));
+
+    check("dedicated slot requires the reservation",
+          !reservation_has_dedicated_slot({{"reserved_dedicated_slot", true}}));
+    check("reserved model may hold a dedicated slot",
+          reservation_has_dedicated_slot(
+              {{"reserved", true}, {"reserved_dedicated_slot", true}}));
+    check("reserved model defaults to the shared pool",
+          !reservation_has_dedicated_slot({{"reserved", true}}));
+
+    ReservationViolationException e("experiment-model", "flagship-model",
+                                    "pool standard/llm is at its slot limit");
+    check("violation carries its own error type", e.type() == RESERVATION_VIOLATION);
+    const std::string message = e.what();
+    check("violation names the incoming model",
+          message.find("experiment-model") != std::string::npos);
+    check("violation names the reserved model",
+          message.find("flagship-model") != std::string::npos);
+    check("violation explains the constraint",
+          message.find("slot limit") != std::string::npos);
+    const json body = e.to_json();
+    check("violation serializes the error type",
+          body["error"]["type"] == RESERVATION_VIOLATION);
+
+    if (failures) {
+        std::printf("%d FAILURE(S)\n", failures);
+        return 1;
+    }
+    std::printf("ALL PASS (0 failures)\n");
+    return 0;
+}
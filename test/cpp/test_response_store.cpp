@@ -0,0 +1,161 @@
+#include "lemon/response_store.h"
+
+#include <cstdio>
+#include <filesystem>
+#include <string>
+
+using lemon::ResponseStore;
+using nlohmann::json;
+
+namespace fs = std::filesystem;
+
+static int g_failures = 0;
+
+static void check(const char* name, bool ok) {
+    std::printf("[%s] %s\n", ok ? "PASS" : "FAIL", name);
+    if (!ok) ++g_failures;
+}
+
+static std::string temp_root(const char* suffix) {
+    auto root = fs::temp_directory_path() / (std::string("lemon_resp_test_") + suffix);
+    fs::remove_all(root);
+    return root.string();
+}
+
+static json sample_request() {
+    return {{"model", "llama"}, {"input", "hello"}};
+}
+
+static void test_create_and_get_shape() {
+    ResponseStore store(temp_root("create"));
+    std::string id = store.create(sample_request());
+    check("create returns resp_ id", id.rfind("resp_", 0) == 0);
+    check("created record exists", store.exists(id));
+    check("unknown id does not exist", !store.exists("resp_nope"));
+
+    json shape = store.get(id);
+    check("queued status", shape["status"] == "queued");
+    check("object is response", shape["object"] == "response");
+    check("model surfaced", shape["model"] == "llama");
+    check("unknown id returns null", store.get("resp_nope").is_null());
+    check("queued record is not terminal", !store.is_terminal(id));
+}
+
+static void test_lifecycle_and_cancel() {
+    ResponseStore store(temp_root("lifecycle"));
+    std::string id = store.create(sample_request());
+    store.mark_in_progress(id);
+    check("in_progress after mark", store.get(id)["status"] == "in_progress");
+
+    check("append accepted while running", store.append_event(id, "data: {}\n\n"));
+    check("cancel running record", store.cancel(id));
+    check("append refused after cancel", !store.append_event(id, "data: {}\n\n"));
+    check("running record not yet terminal", !store.is_terminal(id));
+
+    store.finalize_from_events(id);
+    check("cancelled once producer finalizes",
+          store.get(id)["status"] == "cancelled");
+    check("cancel of terminal record fails", !store.cancel(id));
+
+    std::string queued = store.create(sample_request());
+    check("cancel queued record", store.cancel(queued));
+    check("queued cancel is immediate", store.get(queued)["status"] == "cancelled");
+}
+
+static void test_finalize_from_events() {
+    ResponseStore store(temp_root("finalize"));
+    std::string id = store.create(sample_request());
+    store.mark_in_progress(id);
+    store.append_event(id, "data: {\"type\":\"response.output_text.delta\"}\n\n");
+    json terminal = {{"type", "response.completed"},
+                     {"response", {{"id", "x"}, {"output", "hi"}}}};
+    store.append_event(id, "data: " + terminal.dump() + "\n\n");
+    store.finalize_from_events(id);
+
+    json shape = store.get(id);
+    check("finalize completes from terminal event", shape["status"] == "completed");
+    check("final response adopted", shape["output"] == "hi");
+
+    std::string no_terminal = store.create(sample_request());
+    store.mark_in_progress(no_terminal);
+    store.append_event(no_terminal, "data: {\"type\":\"delta\"}\n\n");
+    store.finalize_from_events(no_terminal);
+    check("finalize without terminal event fails",
+          store.get(no_terminal)["status"] == "failed");
+}
+
+static void test_events_cursor() {
+    ResponseStore store(temp_root("cursor"));
+    std::string id = store.create(sample_request());
+    store.mark_in_progress(id);
+    store.append_event(id, "one");
+    store.append_event(id, "two");
+
+    size_t cursor = 0;
+    auto chunks = store.events_after(id, cursor, &cursor);
+    check("cursor returns captured chunks",
+          chunks.size() == 2 && chunks[0] == "one" && chunks[1] == "two");
+    check("cursor advances", cursor == 2);
+
+    chunks = store.events_after(id, cursor, &cursor);
+    check("drained cursor returns nothing", chunks.empty() && cursor == 2);
+
+    store.append_event(id, "three");
+    chunks = store.events_after(id, cursor, &cursor);
+    check("cursor picks up new chunks",
+          chunks.size() == 1 && chunks[0] == "three" && cursor == 3);
+}
+
+static void test_eviction_keeps_live_records() {
+    ResponseStore store(temp_root("evict"), 2);
+    std::string a = store.create(sample_request());
+    store.complete(a, {{"id", "a"}});
+    std::string b = store.create(sample_request());
+    store.mark_in_progress(b);
+
+    std::string c = store.create(sample_request());
+    check("oldest terminal record evicted", !store.exists(a));
+    check("live record survives eviction", store.exists(b));
+    check("new record admitted", store.exists(c) && store.size() == 2);
+}
+
+static void test_persistence_round_trip() {
+    const std::string root = temp_root("persist");
+    std::string done_id;
+    std::string running_id;
+    {
+        ResponseStore store(root);
+        done_id = store.create(sample_request());
+        store.complete(done_id, {{"output", "kept"}});
+        running_id = store.create(sample_request());
+        store.mark_in_progress(running_id);
+    }
+
+    ResponseStore reloaded(root);
+    check("terminal record survives restart", reloaded.exists(done_id));
+    check("reloaded response intact",
+          reloaded.get(done_id)["status"] == "completed" &&
+          reloaded.get(done_id)["output"] == "kept");
+    check("in-flight record dropped on restart", !reloaded.exists(running_id));
+
+    check("remove deletes record", reloaded.remove(done_id));
+    check("removed record gone", !reloaded.exists(done_id));
+    check("record file deleted",
+          !fs::exists(fs::path(root) / (done_id + ".json")));
+}
+
+int main() {
+    test_create_and_get_shape();
+    test_lifecycle_and_cancel();
+    test_finalize_from_events();
+    test_events_cursor();
+    test_eviction_keeps_live_records();
+    test_persistence_round_trip();
+
+    if (g_failures == 0) {
+        std::printf("All response store tests passed\n");
+        return 0;
+    }
+    std::printf("%d response store check(s) failed\n", g_failures);
+    return 1;
+}
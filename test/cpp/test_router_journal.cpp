@@ -0,0 +1,157 @@
+// Standalone test for the router decision journal: ring ordering and
+// lapping, time/limit filtering, concurrent writers against a snapshotting
+// reader, and batch persistence to JSONL.
+//
+// Compile: g++ -std=c++17 -I src/cpp/include test/cpp/test_router_journal.cpp \
+//              src/cpp/server/router_journal.cpp \
+//              src/cpp/server/utils/path_utils.cpp -pthread -o test_router_journal
+
+#include "lemon/router_journal.h"
+
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace fs = std::filesystem;
+using lemon::RouterEventKind;
+using lemon::RouterJournal;
+using lemon::router_event_kind_to_string;
+
+static int g_failures = 0;
+
+static void check(const char* name, bool ok) {
+    std::printf("[%s] %s\n", ok ? "PASS" : "FAIL", name);
+    if (!ok) ++g_failures;
+}
+
+static void test_record_and_snapshot() {
+    auto& journal = RouterJournal::instance();
+
+    journal.record(RouterEventKind::Load, "model-a", "recipe llamacpp loaded in 5ms");
+    journal.record(RouterEventKind::SlotEvict, "model-a", "slot limit reached",
+                   "model-b");
+    journal.record(RouterEventKind::MemoryEvict, "model-b",
+                   "predicted footprint 40.00 GB exceeds 8.00 GB available",
+                   "model-c", 8.0);
+
+    const auto events = journal.snapshot();
+    check("snapshot: all events present, oldest first",
+          events.size() == 3 &&
+          std::string(events[0].model) == "model-a" &&
+          events[0].kind == RouterEventKind::Load &&
+          events[2].kind == RouterEventKind::MemoryEvict);
+    check("snapshot: sequence is monotonic",
+          events[0].seq < events[1].seq && events[1].seq < events[2].seq);
+    check("snapshot: trigger and vram captured",
+          std::string(events[1].trigger) == "model-b" &&
+          events[2].vram_free_gb == 8.0);
+
+    const auto limited = journal.snapshot(0, 2);
+    check("snapshot: limit keeps the most recent events",
+          limited.size() == 2 && limited[1].kind == RouterEventKind::MemoryEvict);
+
+    const auto json = RouterJournal::to_json(events[2]);
+    check("to_json: fields serialized",
+          json["kind"] == "memory_evict" && json["model"] == "model-b" &&
+          json["trigger"] == "model-c" && json["vram_free_gb"] == 8.0);
+    const auto load_json = RouterJournal::to_json(events[0]);
+    check("to_json: unknown vram and empty trigger omitted",
+          load_json["vram_free_gb"].is_null() && !load_json.contains("trigger"));
+}
+
+static void test_ring_lapping() {
+    auto& journal = RouterJournal::instance();
+
+    for (size_t i = 0; i < RouterJournal::kCapacity + 50; ++i) {
+        journal.record(RouterEventKind::Load, "lap-" + std::to_string(i), "r");
+    }
+    const auto events = journal.snapshot();
+    check("lapping: capacity bounds the snapshot",
+          events.size() <= RouterJournal::kCapacity);
+    check("lapping: newest event survives",
+          !events.empty() &&
+          std::string(events.back().model) ==
+              "lap-" + std::to_string(RouterJournal::kCapacity + 49));
+}
+
+static void test_time_filter() {
+    auto& journal = RouterJournal::instance();
+
+    journal.record(RouterEventKind::NuclearEvict, "old-model", "r");
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    const int64_t cutoff_ms =
+        std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::system_clock::now().time_since_epoch())
+            .count();
+    journal.record(RouterEventKind::LoadFailed, "new-model", "r");
+
+    const auto events = journal.snapshot(cutoff_ms);
+    bool only_new = !events.empty();
+    for (const auto& event : events) {
+        if (std::string(event.model) == "old-model") only_new = false;
+    }
+    check("time filter: events before the cutoff excluded",
+          only_new && std::string(events.back().model) == "new-model");
+}
+
+static void test_concurrent_writers() {
+    auto& journal = RouterJournal::instance();
+
+    std::vector<std::thread> writers;
+    for (int t = 0; t < 4; ++t) {
+        writers.emplace_back([&journal, t] {
+            for (int i = 0; i < 2000; ++i) {
+                journal.record(RouterEventKind::SlotEvict,
+                               "w" + std::to_string(t), "concurrent");
+            }
+        });
+    }
+    bool valid = true;
+    for (int i = 0; i < 200; ++i) {
+        for (const auto& event : journal.snapshot()) {
+            const std::string kind = router_event_kind_to_string(event.kind);
+            if (kind == "unknown") valid = false;
+        }
+    }
+    for (auto& w : writers) w.join();
+    check("concurrency: snapshots stay well-formed under writer load", valid);
+}
+
+static void test_persistence(const fs::path& dir) {
+    auto& journal = RouterJournal::instance();
+    const std::string path = (dir / "router_events.jsonl").string();
+
+    journal.enable_persistence(path);
+    journal.record(RouterEventKind::Load, "persisted-model", "r");
+    journal.shutdown();
+
+    std::ifstream in(path);
+    size_t lines = 0;
+    bool found = false;
+    std::string line;
+    while (std::getline(in, line)) {
+        ++lines;
+        if (line.find("persisted-model") != std::string::npos) found = true;
+    }
+    check("persistence: events flushed as JSONL on shutdown", lines > 0 && found);
+}
+
+int main() {
+    const fs::path dir = fs::temp_directory_path() / "lemon_router_journal_test";
+    fs::remove_all(dir);
+    fs::create_directories(dir);
+
+    test_record_and_snapshot();
+    test_ring_lapping();
+    test_time_filter();
+    test_concurrent_writers();
+    test_persistence(dir);
+
+    fs::remove_all(dir);
+    std::printf("%s\n", g_failures == 0 ? "ALL PASS" : "FAILURES");
+    return g_failures == 0 ? 0 : 1;
+}
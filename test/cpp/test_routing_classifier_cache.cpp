@@ -0,0 +1,100 @@
+// Routing classifier result cache: feature hashing, hit/miss accounting,
+// LRU refresh and eviction, and per-model key separation.
+
+#include "lemon/routing_classifier_cache.h"
+
+#include <cstdio>
+#include <map>
+#include <string>
+
+using lemon::ClassifierResultCache;
+
+static int g_failures = 0;
+
+static void check(const char* name, bool ok) {
+    std::printf("[%s] %s\n", ok ? "PASS" : "FAIL", name);
+    if (!ok) {
+        ++g_failures;
+    }
+}
+
+static void test_hashing() {
+    const uint64_t a = ClassifierResultCache::hash_features("m", "hello");
+    check("hash is deterministic",
+          a == ClassifierResultCache::hash_features("m", "hello"));
+    check("hash depends on text",
+          a != ClassifierResultCache::hash_features("m", "hello!"));
+    check("hash depends on model",
+          a != ClassifierResultCache::hash_features("m2", "hello"));
+    check("model/text boundary is part of the key",
+          ClassifierResultCache::hash_features("ab", "c") !=
+              ClassifierResultCache::hash_features("a", "bc"));
+}
+
+static void test_hit_miss_and_stats() {
+    ClassifierResultCache cache(8);
+    std::map<std::string, double> scores;
+
+    check("empty cache misses", !cache.lookup("m", "prompt", scores));
+    cache.store("m", "prompt", {{"code", 0.9}, {"chat", 0.1}});
+    check("stored entry hits", cache.lookup("m", "prompt", scores));
+    check("hit returns stored scores",
+          scores.size() == 2 && scores["code"] == 0.9 && scores["chat"] == 0.1);
+    check("same text under another model misses",
+          !cache.lookup("other", "prompt", scores));
+
+    const auto stats = cache.stats();
+    check("stats track hits and misses",
+          stats.hits == 1 && stats.misses == 2 && stats.entries == 1 &&
+              stats.capacity == 8);
+}
+
+static void test_store_overwrites() {
+    ClassifierResultCache cache(8);
+    std::map<std::string, double> scores;
+
+    cache.store("m", "prompt", {{"code", 0.2}});
+    cache.store("m", "prompt", {{"code", 0.8}});
+    check("restore keeps one entry", cache.stats().entries == 1);
+    check("restore overwrites scores",
+          cache.lookup("m", "prompt", scores) && scores["code"] == 0.8);
+}
+
+static void test_lru_eviction() {
+    ClassifierResultCache cache(2);
+    std::map<std::string, double> scores;
+
+    cache.store("m", "a", {{"x", 1.0}});
+    cache.store("m", "b", {{"x", 1.0}});
+    cache.lookup("m", "a", scores);
+    cache.store("m", "c", {{"x", 1.0}});
+
+    check("capacity is enforced", cache.stats().entries == 2);
+    check("lookup refreshes LRU position", cache.lookup("m", "a", scores));
+    check("least recently used entry is evicted", !cache.lookup("m", "b", scores));
+    check("newest entry is retained", cache.lookup("m", "c", scores));
+}
+
+static void test_zero_capacity() {
+    ClassifierResultCache cache(0);
+    std::map<std::string, double> scores;
+
+    cache.store("m", "prompt", {{"x", 1.0}});
+    check("zero-capacity cache stores nothing",
+          !cache.lookup("m", "prompt", scores) && cache.stats().entries == 0);
+}
+
+int main() {
+    test_hashing();
+    test_hit_miss_and_stats();
+    test_store_overwrites();
+    test_lru_eviction();
+    test_zero_capacity();
+
+    if (g_failures > 0) {
+        std::printf("%d check(s) failed\n", g_failures);
+        return 1;
+    }
+    std::printf("All checks passed\n");
+    return 0;
+}
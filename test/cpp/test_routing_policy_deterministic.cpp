@@ -5,7 +5,8 @@
 // route_policy.schema.json: case-insensitive (ASCII) substring, ECMAScript
 // regex, inclusive UTF-8-byte length bounds, and metadata equals/any/exists
 // (scalar vs comma-encoded list, missing-key => exists:false). Also exercises
-// malformed-config rejection and the registry's multi-key implicit-all wiring.
+// the service-backed queue leaf, malformed-config rejection, and the
+// registry's multi-key implicit-all wiring.
 //
 // Compile (standalone):
 //   g++ -std=c++17 -I src/cpp/include -I build/_deps/json-src/include \
@@ -273,6 +274,57 @@ void test_trace_emitted() {
           !ctx.trace.empty() && !ctx.trace[0].score.has_value());
 }
 
+// queue reads live backend stats through ClassifierServices::queue_stats.
+// Every authored bound must hold; missing service, missing stats, or missing
+// fields never match (spill rules fail open to the primary).
+void test_queue() {
+    RouteContext req = make_request("anything");
+
+    auto eval_queue = [&](const json& spec, const json& stats) {
+        ClassifierServices services;
+        services.queue_stats = [stats](const std::string& model) {
+            return model == "big-model" ? stats : json();
+        };
+        ConditionPtr cond = build_leaf("queue", spec);
+        EvalContext ctx{req, services};
+        return cond->evaluate(ctx);
+    };
+
+    const json spec = {{"model", "big-model"}, {"min_waiting", 4}};
+    check("queue waiting at bound matches",
+          eval_queue(spec, {{"running", 8}, {"waiting", 4}}));
+    check("queue waiting below bound no match",
+          !eval_queue(spec, {{"running", 8}, {"waiting", 3}}));
+    check("queue missing field no match", !eval_queue(spec, {{"running", 8}}));
+    check("queue null stats no match", !eval_queue(spec, json()));
+
+    const json both = {{"model", "big-model"},
+                       {"min_waiting", 2},
+                       {"min_kv_cache_usage", 0.9}};
+    check("queue all bounds must hold",
+          !eval_queue(both, {{"waiting", 5}, {"kv_cache_usage", 0.5}}));
+    check("queue all bounds held matches",
+          eval_queue(both, {{"waiting", 5}, {"kv_cache_usage", 0.95}}));
+
+    const json other = {{"model", "other-model"}, {"min_waiting", 1}};
+    check("queue unknown model no match", !eval_queue(other, {{"waiting", 9}}));
+
+    {
+        ClassifierServices services;  // no queue_stats bound
+        ConditionPtr cond = build_leaf("queue", spec);
+        EvalContext ctx{req, services};
+        check("queue unbound service no match", !cond->evaluate(ctx));
+    }
+
+    check("queue missing model rejected",
+          throws_invalid("queue", json{{"min_waiting", 1}}));
+    check("queue no bounds rejected",
+          throws_invalid("queue", json{{"model", "big-model"}}));
+    check("queue negative bound rejected",
+          throws_invalid("queue", json{{"model", "big-model"}, {"min_waiting", -1}}));
+    check("queue non-object rejected", throws_invalid("queue", json::array()));
+}
+
 // The registry isolates each top-level key into its own single-key leaf and
 // ANDs multiple deterministic ops (implicit all). Verify a two-op leaf.
 void test_registry_implicit_all() {
@@ -312,6 +364,7 @@ int main() {
     test_rejections();
     test_regex_redos_rejected();
     test_trace_emitted();
+    test_queue();
     test_registry_implicit_all();
 
     std::printf("\n%s\n", g_failures == 0 ? "ALL PASSED" : "FAILURES PRESENT");
@@ -349,6 +349,9 @@ static void test_schema_parser_key_parity() {
     check_keys("metadata keys match schema",
                lemon::routing_metadata_match_keys(),
                schema_property_keys(schema["$defs"]["metadata_match"]["properties"]));
+    check_keys("queue keys match schema",
+               lemon::routing_queue_match_keys(),
+               schema_property_keys(schema["$defs"]["queue_match"]["properties"]));
 }
 
 int main() {
@@ -0,0 +1,74 @@
+#include "lemon/sampling_profiler.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <thread>
+
+using lemon::SamplingProfiler;
+
+static int g_failures = 0;
+
+static void check(const char* name, bool ok) {
+    std::printf("[%s] %s\n", ok ? "PASS" : "FAIL", name);
+    if (!ok) ++g_failures;
+}
+
+static void test_validation() {
+    check("validation: zero seconds rejected",
+          SamplingProfiler::collect(0, 99).error == SamplingProfiler::Error::BadRequest);
+    check("validation: excessive seconds rejected",
+          SamplingProfiler::collect(3600, 99).error == SamplingProfiler::Error::BadRequest);
+    check("validation: zero hz rejected",
+          SamplingProfiler::collect(1, 0).error == SamplingProfiler::Error::BadRequest);
+}
+
+#ifndef _WIN32
+
+static void test_collect_and_busy() {
+    std::atomic<bool> stop{false};
+    std::thread burner([&stop] {
+        volatile double x = 1.0;
+        while (!stop.load()) {
+            x = x * 1.0000001 + 0.5;
+        }
+    });
+
+    SamplingProfiler::Result concurrent;
+    std::thread second([&concurrent] {
+        std::this_thread::sleep_for(std::chrono::milliseconds(300));
+        concurrent = SamplingProfiler::collect(1, 99);
+    });
+
+    auto result = SamplingProfiler::collect(1, 200);
+    second.join();
+    stop.store(true);
+    burner.join();
+
+    check("collect: succeeds", result.error == SamplingProfiler::Error::None);
+    check("collect: captured samples under CPU load", result.samples > 0);
+    check("collect: profile payload produced", !result.profile.empty());
+    check("collect: payload opens with a sample_type message",
+          !result.profile.empty() && static_cast<unsigned char>(result.profile[0]) == 0x0A);
+    check("collect: concurrent collection refused",
+          concurrent.error == SamplingProfiler::Error::Busy);
+
+    auto again = SamplingProfiler::collect(1, 200);
+    check("collect: usable again after completion",
+          again.error == SamplingProfiler::Error::None);
+}
+
+#endif
+
+int main() {
+    test_validation();
+#ifndef _WIN32
+    test_collect_and_busy();
+#endif
+    if (g_failures) {
+        std::printf("%d FAILURE(S)\n", g_failures);
+        return 1;
+    }
+    std::printf("ALL PASS (0 failures)\n");
+    return 0;
+}
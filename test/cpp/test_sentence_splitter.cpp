@@ -0,0 +1,100 @@
+// Standalone test for the TTS sentence splitter.
+//
+// Compile: g++ -std=c++17 -I src/cpp/include test/cpp/test_sentence_splitter.cpp
+//   -o test_sentence_splitter
+
+#include "lemon/sentence_splitter.h"
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+using lemon::split_sentences;
+
+static int g_failures = 0;
+
+static void check(const char* name, bool ok) {
+    std::printf("[%s] %s\n", ok ? "PASS" : "FAIL", name);
+    if (!ok) ++g_failures;
+}
+
+static std::string join(const std::vector<std::string>& segments) {
+    std::string out;
+    for (const auto& segment : segments) {
+        if (!out.empty()) out += ' ';
+        out += segment;
+    }
+    return out;
+}
+
+static void test_splits_at_sentence_boundaries() {
+    const auto segments = split_sentences(
+        "This is the first full sentence of the text. "
+        "Here comes a second one with enough length. "
+        "And finally a third sentence closes it out.");
+    check("three sentences become three segments", segments.size() == 3);
+    check("first segment ends at the period",
+          !segments.empty() &&
+          segments[0] == "This is the first full sentence of the text.");
+}
+
+static void test_short_fragments_merge_forward() {
+    const auto segments = split_sentences(
+        "Dr. Smith arrived early. The meeting started on time anyway.");
+    check("abbreviation does not split", segments.size() == 2);
+    check("fragment merged into its sentence",
+          !segments.empty() && segments[0] == "Dr. Smith arrived early.");
+}
+
+static void test_short_input_is_one_segment() {
+    const auto segments = split_sentences("Hello there.");
+    check("short input stays whole",
+          segments.size() == 1 && segments[0] == "Hello there.");
+}
+
+static void test_long_unpunctuated_text_hard_splits() {
+    std::string text;
+    for (int i = 0; i < 200; ++i) {
+        text += "word ";
+    }
+    const auto segments = split_sentences(text);
+    check("unpunctuated text still splits", segments.size() > 1);
+    bool bounded = true;
+    for (const auto& segment : segments) {
+        if (segment.size() > 400) bounded = false;
+        if (segment.empty()) bounded = false;
+    }
+    check("hard splits respect max length", bounded);
+    check("hard splits land on whitespace", join(segments) + " " == text);
+}
+
+static void test_no_words_lost() {
+    const std::string text =
+        "One sentence here. Another follows!\nA third on its own line? "
+        "And a trailing fragment";
+    check("joined segments preserve the words",
+          join(split_sentences(text, 1)) ==
+          "One sentence here. Another follows! A third on its own line? "
+          "And a trailing fragment");
+}
+
+static void test_whitespace_only_input() {
+    check("whitespace input yields nothing", split_sentences("  \n \t ").empty());
+    check("empty input yields nothing", split_sentences("").empty());
+}
+
+int main() {
+    test_splits_at_sentence_boundaries();
+    test_short_fragments_merge_forward();
+    test_short_input_is_one_segment();
+    test_long_unpunctuated_text_hard_splits();
+    test_no_words_lost();
+    test_whitespace_only_input();
+
+    if (g_failures > 0) {
+        std::printf("%d check(s) failed\n", g_failures);
+        return 1;
+    }
+    std::printf("All checks passed\n");
+    return 0;
+}
@@ -0,0 +1,91 @@
+#include "lemon/session_store.h"
+
+#include <cstdio>
+#include <string>
+
+using lemon::SessionStore;
+using nlohmann::json;
+
+static int g_failures = 0;
+
+static void check(const char* name, bool ok) {
+    std::printf("[%s] %s\n", ok ? "PASS" : "FAIL", name);
+    if (!ok) ++g_failures;
+}
+
+static json user_message(const std::string& text) {
+    return json::array({{{"role", "user"}, {"content", text}}});
+}
+
+static void test_create_and_get() {
+    SessionStore store;
+    json initial = json::array({{{"role", "system"}, {"content", "be brief"}}});
+    std::string id = store.create("llama", initial, 8);
+    check("create returns an id", !id.empty());
+
+    auto snapshot = store.get(id);
+    check("created session is retrievable", snapshot.has_value());
+    check("model preserved", snapshot && snapshot->model == "llama");
+    check("initial messages preserved",
+          snapshot && snapshot->messages.size() == 1 &&
+          snapshot->messages[0]["role"] == "system");
+    check("unknown id is empty", !store.get("sess-nope").has_value());
+}
+
+static void test_append_accumulates_turns() {
+    SessionStore store;
+    std::string id = store.create("llama", json::array(), 8);
+
+    auto first = store.append(id, user_message("turn 1"));
+    auto second = store.append(id, user_message("turn 2"));
+    check("append returns history", first.has_value() && second.has_value());
+    check("history grows per turn",
+          second && second->messages.size() == 2 && second->turns == 2);
+    check("append to unknown id fails",
+          !store.append("sess-nope", user_message("x")).has_value());
+}
+
+static void test_lru_eviction_under_budget() {
+    SessionStore store;
+    std::string a = store.create("m", json::array(), 2);
+    std::string b = store.create("m", json::array(), 2);
+    store.get(a);
+
+    std::string c = store.create("m", json::array(), 2);
+    check("budget holds", store.size() == 2);
+    check("least recently used session evicted", !store.get(b).has_value());
+    check("recently touched session survives", store.get(a).has_value());
+    check("new session present", store.get(c).has_value());
+
+    store.create("m", json::array(), 1);
+    check("shrinking budget evicts down to it", store.size() == 1);
+}
+
+static void test_remove_and_list() {
+    SessionStore store;
+    std::string a = store.create("m1", json::array(), 8);
+    std::string b = store.create("m2", json::array(), 8);
+    store.append(b, user_message("hello"));
+
+    json sessions = store.list();
+    check("list covers all sessions", sessions.size() == 2);
+    check("most recently used listed first",
+          sessions[0]["id"] == b && sessions[0]["message_count"] == 1);
+
+    check("remove succeeds", store.remove(a));
+    check("remove is idempotent", !store.remove(a));
+    check("removed session is gone", !store.get(a).has_value());
+}
+
+int main() {
+    test_create_and_get();
+    test_append_accumulates_turns();
+    test_lru_eviction_under_budget();
+    test_remove_and_list();
+    if (g_failures) {
+        std::printf("%d FAILURE(S)\n", g_failures);
+        return 1;
+    }
+    std::printf("ALL PASS (0 failures)\n");
+    return 0;
+}
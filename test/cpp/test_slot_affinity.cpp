@@ -0,0 +1,117 @@
+#include "lemon/slot_affinity.h"
+
+#include <cstdio>
+#include <string>
+
+using lemon::SlotAffinity;
+
+static int g_failures = 0;
+
+static void check(const char* name, bool ok) {
+    std::printf("[%s] %s\n", ok ? "PASS" : "FAIL", name);
+    if (!ok) ++g_failures;
+}
+
+static std::string prompt_with_suffix(const std::string& suffix) {
+    return std::string(4096, 'S') + suffix;
+}
+
+static void test_prefix_steering() {
+    SlotAffinity affinity(4);
+
+    int slot_a = affinity.pick_slot(prompt_with_suffix("conversation A, turn 1"));
+    int slot_b = affinity.pick_slot(std::string(4096, 'B') + "conversation B, turn 1");
+    check("distinct conversations land on distinct slots", slot_a != slot_b);
+
+    int slot_a2 = affinity.pick_slot(prompt_with_suffix("conversation A, turn 1 and then turn 2"));
+    check("follow-up turn returns to its slot", slot_a2 == slot_a);
+
+    int slot_b2 = affinity.pick_slot(std::string(4096, 'B') + "conversation B, turn 2");
+    check("other conversation keeps its own slot", slot_b2 == slot_b);
+}
+
+static void test_lru_fallback_on_miss() {
+    SlotAffinity affinity(2);
+
+    int first = affinity.pick_slot(std::string(2048, 'x'));
+    int second = affinity.pick_slot(std::string(2048, 'y'));
+    check("misses spread across slots", first != second);
+
+    // A third unrelated prompt must evict the least recently used slot.
+    int third = affinity.pick_slot(std::string(2048, 'z'));
+    check("third miss evicts the LRU slot", third == first);
+
+    int again = affinity.pick_slot(std::string(2048, 'y'));
+    check("surviving prompt still routes to its slot", again == second);
+}
+
+static void test_short_prompts_degrade_gracefully() {
+    SlotAffinity affinity(2);
+    int a = affinity.pick_slot("short");
+    int b = affinity.pick_slot("short");
+    check("sub-block prompts pick valid slots",
+          a >= 0 && a < 2 && b >= 0 && b < 2);
+}
+
+static void test_reuse_accounting() {
+    const auto before = SlotAffinity::totals();
+
+    SlotAffinity affinity(2);
+    affinity.pick_slot(prompt_with_suffix("accounting turn 1"));
+    affinity.pick_slot(prompt_with_suffix("accounting turn 1, turn 2"));
+
+    const auto after = SlotAffinity::totals();
+    check("requests counted", after.requests == before.requests + 2);
+    check("prefix hit counted", after.prefix_hits >= before.prefix_hits + 1);
+    check("reused characters accumulate",
+          after.prefix_chars_reused >= before.prefix_chars_reused + 4096);
+}
+
+static void test_session_pinning() {
+    SlotAffinity affinity(2);
+
+    int pinned = affinity.pick_slot_for_session("repl-1", prompt_with_suffix("session turn 1"));
+    int other = affinity.pick_slot(std::string(2048, 'o'));
+    check("session and unrelated prompt use distinct slots", pinned != other);
+
+    // The follow-up shares no long prefix fingerprint advantage over the
+    // stolen slot scenario — pinning alone must bring it home.
+    int again = affinity.pick_slot_for_session("repl-1", prompt_with_suffix("session turn 1 then 2"));
+    check("session sticks to its slot", again == pinned);
+
+    // Steal the pinned slot with a plain request bearing the session's prefix.
+    int thief = affinity.pick_slot(prompt_with_suffix("session turn 1 then 2 then 3"));
+    check("plain request may steal the pinned slot", thief == pinned);
+
+    int repinned = affinity.pick_slot_for_session("repl-1", prompt_with_suffix("session turn 1 then 2"));
+    check("stolen session re-pins a valid slot", repinned >= 0 && repinned < 2);
+
+    int second_session = affinity.pick_slot_for_session("repl-2", std::string(2048, 'n') + "fresh");
+    check("second session pins its own slot", second_session != repinned);
+}
+
+static void test_reset_forgets_slots() {
+    SlotAffinity affinity(2);
+    affinity.pick_slot(prompt_with_suffix("pre-reset"));
+
+    const auto before = SlotAffinity::totals();
+    affinity.reset();
+    affinity.pick_slot(prompt_with_suffix("pre-reset"));
+    const auto after = SlotAffinity::totals();
+    check("reset clears cached prefixes", after.prefix_hits == before.prefix_hits);
+}
+
+int main() {
+    test_prefix_steering();
+    test_lru_fallback_on_miss();
+    test_short_prompts_degrade_gracefully();
+    test_reuse_accounting();
+    test_session_pinning();
+    test_reset_forgets_slots();
+    if (g_failures) {
+        std::printf("%d FAILURE(S)\n", g_failures);
+        return 1;
+    }
+    std::printf("ALL PASS (0 failures)\n");
+    return 0;
+}
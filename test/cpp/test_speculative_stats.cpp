@@ -0,0 +1,59 @@
+#include "lemon/speculative_stats.h"
+
+#include <cstdio>
+#include <nlohmann/json.hpp>
+
+using lemon::SpeculativeStats;
+using nlohmann::json;
+
+static int g_failures = 0;
+
+static void check(const char* name, bool ok) {
+    std::printf("[%s] %s\n", ok ? "PASS" : "FAIL", name);
+    if (!ok) ++g_failures;
+}
+
+static void test_record_from_timings() {
+    const auto before = SpeculativeStats::totals();
+
+    SpeculativeStats::record_from_timings(json{{"draft_n", 40}, {"draft_n_accepted", 31}});
+    auto after = SpeculativeStats::totals();
+    check("drafted tokens accumulate", after.drafted == before.drafted + 40);
+    check("accepted tokens accumulate", after.accepted == before.accepted + 31);
+
+    SpeculativeStats::record_from_timings(json{{"prompt_n", 128}, {"predicted_n", 64}});
+    auto unchanged = SpeculativeStats::totals();
+    check("timings without draft fields are ignored",
+          unchanged.drafted == after.drafted && unchanged.accepted == after.accepted);
+
+    SpeculativeStats::record_from_timings(json::array());
+    SpeculativeStats::record_from_timings(json{{"draft_n", "oops"}});
+    auto still = SpeculativeStats::totals();
+    check("malformed timings are ignored",
+          still.drafted == after.drafted && still.accepted == after.accepted);
+
+    SpeculativeStats::record_from_timings(json{{"draft_n", 8}});
+    auto accepted_default = SpeculativeStats::totals();
+    check("missing draft_n_accepted counts as zero accepted",
+          accepted_default.drafted == still.drafted + 8 &&
+          accepted_default.accepted == still.accepted);
+}
+
+static void test_record_skips_empty() {
+    const auto before = SpeculativeStats::totals();
+    SpeculativeStats::record(0, 0);
+    const auto after = SpeculativeStats::totals();
+    check("zero drafted tokens are not recorded",
+          after.drafted == before.drafted && after.accepted == before.accepted);
+}
+
+int main() {
+    test_record_from_timings();
+    test_record_skips_empty();
+    if (g_failures) {
+        std::printf("%d FAILURE(S)\n", g_failures);
+        return 1;
+    }
+    std::printf("ALL PASS (0 failures)\n");
+    return 0;
+}
@@ -0,0 +1,92 @@
+// SSE zstd streaming: encoding negotiation and per-chunk decodability.
+
+#include "lemon/sse_compression.h"
+
+#include <cstdio>
+#include <string>
+#include <zstd.h>
+
+using lemon::SseCompression;
+
+static int g_failures = 0;
+
+static void check(const char* name, bool ok) {
+    std::printf("[%s] %s\n", ok ? "PASS" : "FAIL", name);
+    if (!ok) {
+        ++g_failures;
+    }
+}
+
+static httplib::Request request_with_encoding(const std::string& value) {
+    httplib::Request req;
+    if (!value.empty()) {
+        req.set_header("Accept-Encoding", value);
+    }
+    return req;
+}
+
+static void test_negotiation() {
+    check("zstd accepted",
+          SseCompression::client_accepts_zstd(request_with_encoding("zstd")));
+    check("zstd accepted in list",
+          SseCompression::client_accepts_zstd(request_with_encoding("gzip, zstd;q=0.8, br")));
+    check("case-insensitive",
+          SseCompression::client_accepts_zstd(request_with_encoding("ZSTD")));
+    check("q=0 refused",
+          !SseCompression::client_accepts_zstd(request_with_encoding("zstd;q=0")));
+    check("other encodings refused",
+          !SseCompression::client_accepts_zstd(request_with_encoding("gzip, br")));
+    check("missing header refused",
+          !SseCompression::client_accepts_zstd(request_with_encoding("")));
+}
+
+static void test_round_trip() {
+    std::string wire;
+    httplib::DataSink sink;
+    sink.write = [&wire](const char* data, size_t length) {
+        wire.append(data, length);
+        return true;
+    };
+    sink.is_writable = []() { return true; };
+
+    const std::string event1 = "data: {\"choices\":[{\"delta\":{\"content\":\"Hello\"}}]}\n\n";
+    const std::string event2 = "data: [DONE]\n\n";
+
+    SseCompression::Stream stream;
+    check("first chunk written", stream.write(sink, event1.data(), event1.size()));
+    const size_t after_first = wire.size();
+    check("chunk flushed immediately", after_first > 0);
+    check("second chunk written", stream.write(sink, event2.data(), event2.size()));
+    check("frame finished", stream.finish(sink));
+    check("double finish rejected", !stream.finish(sink));
+
+    ZSTD_DCtx* dctx = ZSTD_createDCtx();
+    std::string decoded(4096, '\0');
+    ZSTD_inBuffer input{wire.data(), wire.size(), 0};
+    ZSTD_outBuffer output{decoded.data(), decoded.size(), 0};
+    const size_t rc = ZSTD_decompressStream(dctx, &output, &input);
+    ZSTD_freeDCtx(dctx);
+    check("decodes without error", !ZSTD_isError(rc));
+    decoded.resize(output.pos);
+    check("round trip matches", decoded == event1 + event2);
+}
+
+static void test_totals_advance() {
+    const auto totals = SseCompression::totals();
+    check("streams counted", totals.streams >= 1);
+    check("input bytes counted", totals.bytes_in > 0);
+    check("output bytes counted", totals.bytes_out > 0);
+}
+
+int main() {
+    test_negotiation();
+    test_round_trip();
+    test_totals_advance();
+
+    if (g_failures != 0) {
+        std::printf("%d check(s) failed\n", g_failures);
+        return 1;
+    }
+    std::printf("All SSE compression checks passed\n");
+    return 0;
+}
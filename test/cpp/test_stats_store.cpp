@@ -0,0 +1,169 @@
+// Stats store: delta append + replay across instances, prompt-token deltas,
+// snapshot compaction under the record budget, torn trailing records, and
+// empty-identity guard.
+
+#include "lemon/stats_store.h"
+
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+using lemon::StatsStore;
+namespace fs = std::filesystem;
+
+static int g_failures = 0;
+
+static void check(const char* name, bool ok) {
+    std::printf("[%s] %s\n", ok ? "PASS" : "FAIL", name);
+    if (!ok) {
+        ++g_failures;
+    }
+}
+
+static StatsStore::ModelIdentity identity(const std::string& model) {
+    return {model, model + ".gguf", "llm", "gpu", "llamacpp"};
+}
+
+static fs::path temp_log(const char* name) {
+    fs::path path = fs::temp_directory_path() / name;
+    fs::remove(path);
+    return path;
+}
+
+static size_t line_count(const fs::path& path) {
+    std::ifstream in(path);
+    std::string line;
+    size_t lines = 0;
+    while (std::getline(in, line)) {
+        ++lines;
+    }
+    return lines;
+}
+
+static void test_replay_roundtrip() {
+    const fs::path path = temp_log("lemon_stats_store_roundtrip.jsonl");
+    {
+        StatsStore store(path);
+        check("fresh log replays empty", store.replay().empty());
+        store.record_request(identity("llama"), 10, 20);
+        store.record_request(identity("llama"), 5, 7);
+        store.record_prompt_tokens(identity("llama"), 12);
+        store.record_request(identity("qwen"), 1, 2);
+        store.flush();
+    }
+
+    StatsStore reopened(path);
+    auto models = reopened.replay();
+    check("replay restores both models", models.size() == 2);
+    for (const auto& model : models) {
+        if (model.identity.model_name == "llama") {
+            check("llama totals survive restart",
+                  model.totals.request_count_total == 2 &&
+                      model.totals.input_tokens_total == 15 &&
+                      model.totals.output_tokens_total == 27 &&
+                      model.totals.prompt_tokens_total == 12);
+            check("identity fields survive restart",
+                  model.identity.checkpoint == "llama.gguf" &&
+                      model.identity.recipe == "llamacpp");
+        } else {
+            check("qwen totals survive restart",
+                  model.totals.request_count_total == 1 &&
+                      model.totals.input_tokens_total == 1 &&
+                      model.totals.output_tokens_total == 2);
+        }
+    }
+    fs::remove(path);
+}
+
+static void test_deltas_accumulate_across_sessions() {
+    const fs::path path = temp_log("lemon_stats_store_sessions.jsonl");
+    for (int session = 0; session < 3; ++session) {
+        StatsStore store(path);
+        store.replay();
+        store.record_request(identity("llama"), 100, 50);
+        store.flush();
+    }
+
+    StatsStore store(path);
+    auto models = store.replay();
+    check("three sessions of deltas sum up",
+          models.size() == 1 && models[0].totals.request_count_total == 3 &&
+              models[0].totals.input_tokens_total == 300);
+    check("one delta record per session", line_count(path) == 3);
+    fs::remove(path);
+}
+
+static void test_flush_without_changes_appends_nothing() {
+    const fs::path path = temp_log("lemon_stats_store_idle.jsonl");
+    StatsStore store(path);
+    store.record_request(identity("llama"), 1, 1);
+    store.flush();
+    store.flush();
+    store.flush();
+    check("idle flushes append nothing", line_count(path) == 1);
+    fs::remove(path);
+}
+
+static void test_compaction() {
+    const fs::path path = temp_log("lemon_stats_store_compact.jsonl");
+    StatsStore store(path, 4);
+    store.replay();
+    for (int i = 0; i < 6; ++i) {
+        store.record_request(identity("llama"), 1, 1);
+        store.flush();
+    }
+    // Compaction fires once the budget of 4 is exceeded (after the 5th
+    // append), leaving the snapshot plus the one delta appended after it.
+    check("over-budget log compacts to a snapshot", line_count(path) == 2);
+
+    auto models = store.replay();
+    check("compacted snapshot keeps the totals",
+          models.size() == 1 && models[0].totals.request_count_total == 6);
+    fs::remove(path);
+}
+
+static void test_torn_trailing_record() {
+    const fs::path path = temp_log("lemon_stats_store_torn.jsonl");
+    {
+        StatsStore store(path);
+        store.record_request(identity("llama"), 10, 10);
+        store.flush();
+    }
+    {
+        std::ofstream out(path, std::ios::app);
+        out << "{\"op\":\"delta\",\"mod";
+    }
+
+    StatsStore store(path);
+    auto models = store.replay();
+    check("torn trailing record is skipped",
+          models.size() == 1 && models[0].totals.request_count_total == 1);
+    fs::remove(path);
+}
+
+static void test_empty_identity_ignored() {
+    const fs::path path = temp_log("lemon_stats_store_empty.jsonl");
+    StatsStore store(path);
+    store.record_request({}, 10, 10);
+    store.record_prompt_tokens({}, 10);
+    store.flush();
+    check("empty model identity records nothing", line_count(path) == 0);
+    fs::remove(path);
+}
+
+int main() {
+    test_replay_roundtrip();
+    test_deltas_accumulate_across_sessions();
+    test_flush_without_changes_appends_nothing();
+    test_compaction();
+    test_torn_trailing_record();
+    test_empty_identity_ignored();
+
+    if (g_failures > 0) {
+        std::printf("%d check(s) failed\n", g_failures);
+        return 1;
+    }
+    std::printf("all checks passed\n");
+    return 0;
+}
@@ -0,0 +1,106 @@
+#include "lemon/stats_windows.h"
+
+#include <chrono>
+#include <cstdio>
+
+using lemon::StatsWindows;
+using nlohmann::json;
+
+static int g_failures = 0;
+
+static void check(const char* name, bool ok) {
+    std::printf("[%s] %s\n", ok ? "PASS" : "FAIL", name);
+    if (!ok) ++g_failures;
+}
+
+static std::chrono::steady_clock::time_point at(uint64_t seconds) {
+    return std::chrono::steady_clock::time_point(std::chrono::seconds(seconds));
+}
+
+static void test_counts_per_window() {
+    StatsWindows stats;
+    stats.record("m", 10, 20, 0.2, at(100000));
+    stats.record("m", 5, 5, 0.4, at(100001));
+
+    json snapshot = stats.to_json(at(100001));
+    check("minute window sums both requests",
+          snapshot["1m"]["m"]["requests"] == 2 &&
+              snapshot["1m"]["m"]["input_tokens"] == 15 &&
+              snapshot["1m"]["m"]["output_tokens"] == 25);
+    check("hour and day windows agree",
+          snapshot["1h"]["m"]["requests"] == 2 &&
+              snapshot["24h"]["m"]["requests"] == 2);
+    check("ttft avg over window",
+          snapshot["1m"]["m"]["ttft"]["count"] == 2 &&
+              snapshot["1m"]["m"]["ttft"]["avg"].get<double>() > 0.29 &&
+              snapshot["1m"]["m"]["ttft"]["avg"].get<double>() < 0.31);
+}
+
+static void test_window_expiry() {
+    StatsWindows stats;
+    stats.record("m", 1, 1, 0.1, at(100000));
+
+    json later = stats.to_json(at(100090));
+    check("request ages out of the minute window",
+          !later["1m"].contains("m") && later["1h"]["m"]["requests"] == 1);
+
+    json next_day = stats.to_json(at(100000 + 25 * 3600));
+    check("request ages out of all windows",
+          !next_day["1m"].contains("m") && !next_day["1h"].contains("m") &&
+              !next_day["24h"].contains("m"));
+}
+
+static void test_ring_reuse_drops_stale_slots() {
+    StatsWindows stats;
+    stats.record("m", 1, 1, 0.1, at(100000));
+    // Same ring slot one full minute later must not double-count.
+    stats.record("m", 1, 1, 0.1, at(100060));
+
+    json snapshot = stats.to_json(at(100060));
+    check("wrapped slot holds only the fresh request",
+          snapshot["1m"]["m"]["requests"] == 1 &&
+              snapshot["1h"]["m"]["requests"] == 2);
+}
+
+static void test_quantiles() {
+    StatsWindows stats;
+    for (int i = 0; i < 95; ++i) {
+        stats.record("m", 1, 1, 0.08, at(100000));
+    }
+    for (int i = 0; i < 5; ++i) {
+        stats.record("m", 1, 1, 15.0, at(100000));
+    }
+
+    json snapshot = stats.to_json(at(100000));
+    const double p50 = snapshot["1m"]["m"]["ttft"]["p50"].get<double>();
+    const double p99 = snapshot["1m"]["m"]["ttft"]["p99"].get<double>();
+    check("p50 lands in the fast bucket", p50 > 0.05 && p50 <= 0.1);
+    check("p99 lands in the slow bucket", p99 > 10.0 && p99 <= 20.0);
+}
+
+static void test_models_tracked_independently() {
+    StatsWindows stats;
+    stats.record("a", 1, 1, 0.1, at(100000));
+    stats.record("b", 2, 2, 0.0, at(100000));
+
+    json snapshot = stats.to_json(at(100000));
+    check("models are separate keys",
+          snapshot["1m"]["a"]["requests"] == 1 &&
+              snapshot["1m"]["b"]["requests"] == 1);
+    check("zero ttft omits the digest",
+          !snapshot["1m"]["b"].contains("ttft"));
+}
+
+int main() {
+    test_counts_per_window();
+    test_window_expiry();
+    test_ring_reuse_drops_stale_slots();
+    test_quantiles();
+    test_models_tracked_independently();
+    if (g_failures) {
+        std::printf("%d FAILURE(S)\n", g_failures);
+        return 1;
+    }
+    std::printf("ALL PASS (0 failures)\n");
+    return 0;
+}
@@ -0,0 +1,100 @@
+// Disk-budget store eviction: score ordering, pin protection, and quota math.
+
+#include "lemon/store_eviction.h"
+
+#include <cstdio>
+#include <string>
+
+using lemon::StoreCandidate;
+using lemon::StoreEvictionPolicy;
+
+static int g_failures = 0;
+
+static void check(const char* name, bool ok) {
+    std::printf("[%s] %s\n", ok ? "PASS" : "FAIL", name);
+    if (!ok) {
+        ++g_failures;
+    }
+}
+
+namespace {
+
+constexpr uint64_t kGb = 1024ull * 1024 * 1024;
+constexpr int64_t kNow = 1'700'000'000;
+constexpr int64_t kDay = 86400;
+
+StoreCandidate make(const std::string& model, uint64_t size_gb, int64_t age_days,
+                    double use_count, bool pinned = false) {
+    StoreCandidate c;
+    c.model = model;
+    c.size_bytes = size_gb * kGb;
+    c.last_used = age_days >= 0 ? kNow - age_days * kDay : 0;
+    c.use_count = use_count;
+    c.pinned = pinned;
+    return c;
+}
+
+}  // namespace
+
+static void test_under_quota_is_noop() {
+    auto plan = StoreEvictionPolicy::plan({make("a", 4, 1, 5.0), make("b", 4, 30, 0.0)},
+                                          10 * kGb, kNow);
+    check("store under quota evicts nothing", plan.empty());
+}
+
+static void test_stale_goes_before_hot() {
+    auto plan = StoreEvictionPolicy::plan(
+        {make("hot", 6, 0, 50.0), make("stale", 6, 60, 1.0)}, 8 * kGb, kNow);
+    check("one eviction suffices", plan.size() == 1);
+    check("stale model evicted before hot one", !plan.empty() && plan[0].model == "stale");
+}
+
+static void test_never_used_loses_ties() {
+    StoreCandidate used = make("used", 5, 30, 1.0);
+    StoreCandidate never = make("never", 5, -1, 0.0);
+    check("never-used scores above an equally sized used model",
+          StoreEvictionPolicy::eviction_score(never, kNow) >
+              StoreEvictionPolicy::eviction_score(used, kNow));
+}
+
+static void test_pinned_survives() {
+    auto plan = StoreEvictionPolicy::plan(
+        {make("pinned", 8, 365, 0.0, true), make("small", 1, 0, 10.0)}, 4 * kGb, kNow);
+    for (const auto& c : plan) {
+        check("pinned candidate never selected", c.model != "pinned");
+    }
+    check("eviction falls through to unpinned data",
+          plan.size() == 1 && plan[0].model == "small");
+}
+
+static void test_stops_at_quota() {
+    auto plan = StoreEvictionPolicy::plan(
+        {make("a", 4, 90, 0.0), make("b", 4, 60, 0.0), make("c", 4, 0, 20.0)},
+        8 * kGb, kNow);
+    check("evicts only enough to fit under quota", plan.size() == 1);
+    check("oldest unused model chosen", !plan.empty() && plan[0].model == "a");
+}
+
+static void test_redownload_cost_dampens_size() {
+    // Same staleness and use: a model 16x larger must not score 16x higher.
+    const double small = StoreEvictionPolicy::eviction_score(make("s", 2, 10, 2.0), kNow);
+    const double large = StoreEvictionPolicy::eviction_score(make("l", 32, 10, 2.0), kNow);
+    check("larger model still scores higher", large > small);
+    check("re-download cost dampens the size factor", large < small * 16.0);
+}
+
+int main() {
+    test_under_quota_is_noop();
+    test_stale_goes_before_hot();
+    test_never_used_loses_ties();
+    test_pinned_survives();
+    test_stops_at_quota();
+    test_redownload_cost_dampens_size();
+
+    if (g_failures > 0) {
+        std::printf("%d check(s) failed\n", g_failures);
+        return 1;
+    }
+    std::printf("all checks passed\n");
+    return 0;
+}
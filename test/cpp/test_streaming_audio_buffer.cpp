@@ -0,0 +1,144 @@
+// SPSC ring semantics for StreamingAudioBuffer: ordering across wraparound,
+// overflow accounting, peek vs clear, and concurrent produce/consume.
+
+#include "lemon/streaming_audio_buffer.h"
+#include <cmath>
+#include <cstdio>
+#include <thread>
+#include <vector>
+
+using lemon::StreamingAudioBuffer;
+
+static int g_failures = 0;
+
+static void check(const char* name, bool ok) {
+    std::printf("[%s] %s\n", ok ? "PASS" : "FAIL", name);
+    if (!ok) ++g_failures;
+}
+
+static std::vector<int16_t> ramp(size_t count, int16_t start) {
+    std::vector<int16_t> samples(count);
+    for (size_t i = 0; i < count; ++i) {
+        samples[i] = static_cast<int16_t>(start + static_cast<int16_t>(i));
+    }
+    return samples;
+}
+
+static void test_append_and_read_back() {
+    StreamingAudioBuffer buffer;
+    buffer.append_raw(ramp(1600, 0));
+
+    check("sample count tracks appends", buffer.sample_count() == 1600);
+    check("duration follows sample rate", buffer.duration_ms() == 100);
+
+    auto samples = buffer.get_samples();
+    bool ordered = samples.size() == 1600;
+    for (size_t i = 0; ordered && i < samples.size(); ++i) {
+        ordered = std::fabs(samples[i] - static_cast<int16_t>(i) / 32768.0f) < 1e-6f;
+    }
+    check("samples read back in order", ordered);
+    check("reads do not consume", buffer.sample_count() == 1600);
+
+    buffer.clear();
+    check("clear empties the buffer", buffer.empty());
+}
+
+static void test_wraparound_keeps_order() {
+    StreamingAudioBuffer buffer;
+
+    // March the ring positions close to capacity, then append across the seam.
+    const size_t chunk = StreamingAudioBuffer::CAPACITY_SAMPLES / 4 * 3;
+    buffer.append_raw(ramp(chunk, 0));
+    buffer.clear();
+
+    buffer.append_raw(ramp(StreamingAudioBuffer::CAPACITY_SAMPLES / 2, 100));
+    auto samples = buffer.get_samples();
+    bool ordered = samples.size() == StreamingAudioBuffer::CAPACITY_SAMPLES / 2;
+    for (size_t i = 0; ordered && i < samples.size(); ++i) {
+        ordered = std::fabs(samples[i] -
+                            static_cast<int16_t>(100 + static_cast<int16_t>(i)) / 32768.0f) < 1e-6f;
+    }
+    check("wraparound preserves order", ordered);
+    check("no overflow below capacity", buffer.overflow_samples() == 0);
+}
+
+static void test_overflow_accounting() {
+    StreamingAudioBuffer buffer;
+    buffer.append_raw(ramp(StreamingAudioBuffer::CAPACITY_SAMPLES, 0));
+    check("fills to capacity", buffer.sample_count() == StreamingAudioBuffer::CAPACITY_SAMPLES);
+
+    buffer.append_raw(ramp(1600, 0));
+    check("full ring drops new samples",
+          buffer.sample_count() == StreamingAudioBuffer::CAPACITY_SAMPLES);
+    check("dropped samples are counted", buffer.overflow_samples() == 1600);
+
+    buffer.clear();
+    buffer.append_raw(ramp(16, 7));
+    check("ring usable after overflow and clear",
+          buffer.sample_count() == 16 && buffer.get_samples().front() > 0.0f);
+}
+
+static void test_recent_samples_peek_tail() {
+    StreamingAudioBuffer buffer;
+    buffer.append_raw(ramp(3200, 0));
+
+    std::vector<float> scratch;
+    const size_t copied = buffer.copy_recent_samples(50, scratch);
+    check("copy_recent_samples returns requested window", copied == 800);
+    check("recent window is the newest audio",
+          std::fabs(scratch.front() - static_cast<int16_t>(2400) / 32768.0f) < 1e-6f);
+
+    const size_t all = buffer.copy_recent_samples(10000, scratch);
+    check("oversized window clamps to available", all == 3200);
+}
+
+static void test_concurrent_producer_consumer() {
+    StreamingAudioBuffer buffer;
+    const int chunks = 2000;
+    const size_t chunk_samples = 160;
+
+    std::thread producer([&buffer]() {
+        auto chunk = ramp(chunk_samples, 1);
+        for (int i = 0; i < chunks; ++i) {
+            buffer.append_raw(chunk);
+        }
+    });
+
+    std::vector<float> scratch;
+    size_t peeks = 0;
+    while (peeks < 1000) {
+        buffer.copy_recent_samples(10, scratch);
+        bool valid = true;
+        for (float s : scratch) {
+            valid = valid && s >= 0.0f && s <= (chunk_samples + 1) / 32768.0f;
+        }
+        if (!valid) {
+            producer.join();
+            check("concurrent peeks see only written data", false);
+            return;
+        }
+        if (!scratch.empty()) {
+            ++peeks;
+        }
+        if (buffer.sample_count() > StreamingAudioBuffer::CAPACITY_SAMPLES / 2) {
+            buffer.clear();
+        }
+    }
+    producer.join();
+    check("concurrent peeks see only written data", true);
+}
+
+int main() {
+    test_append_and_read_back();
+    test_wraparound_keeps_order();
+    test_overflow_accounting();
+    test_recent_samples_peek_tail();
+    test_concurrent_producer_consumer();
+
+    if (g_failures > 0) {
+        std::printf("%d check(s) failed\n", g_failures);
+        return 1;
+    }
+    std::printf("All checks passed\n");
+    return 0;
+}
@@ -0,0 +1,104 @@
+// Tests for the SystemStatsHistory telemetry ring: ordering, the since
+// filter, wraparound at capacity, and the latest/total accessors.
+//
+// Samples are pushed via record() directly so the tests are deterministic
+// and never start the 1 Hz sampler thread.
+
+#include "lemon/system_stats_history.h"
+#include <cstdio>
+
+using lemon::SystemStatsHistory;
+
+static int g_failures = 0;
+
+static void check(const char* name, bool ok) {
+    std::printf("[%s] %s\n", ok ? "PASS" : "FAIL", name);
+    if (!ok) ++g_failures;
+}
+
+static SystemStatsHistory::Sample make_sample(int64_t ts) {
+    SystemStatsHistory::Sample s;
+    s.timestamp = ts;
+    s.vram_gb = static_cast<float>(ts % 100);
+    return s;
+}
+
+static void test_empty_history() {
+    SystemStatsHistory h;
+    SystemStatsHistory::Sample latest;
+    check("empty: snapshot has no samples", h.snapshot().empty());
+    check("empty: latest reports nothing", !h.latest(latest));
+    check("empty: no samples counted", h.total_samples() == 0);
+}
+
+static void test_ordering_and_since_filter() {
+    SystemStatsHistory h;
+    for (int64_t ts = 100; ts < 110; ++ts) {
+        h.record(make_sample(ts));
+    }
+
+    auto all = h.snapshot();
+    bool ordered = all.size() == 10;
+    for (size_t i = 0; ordered && i < all.size(); ++i) {
+        ordered = all[i].timestamp == 100 + static_cast<int64_t>(i);
+    }
+    check("snapshot returns samples oldest first", ordered);
+
+    auto recent = h.snapshot(105);
+    check("since filter keeps samples at or after the cutoff",
+          recent.size() == 5 && recent.front().timestamp == 105);
+
+    SystemStatsHistory::Sample latest;
+    check("latest returns the newest sample",
+          h.latest(latest) && latest.timestamp == 109);
+}
+
+static void test_wraparound_keeps_newest() {
+    SystemStatsHistory h;
+    const int64_t n = static_cast<int64_t>(SystemStatsHistory::kCapacity) + 250;
+    for (int64_t ts = 0; ts < n; ++ts) {
+        h.record(make_sample(ts));
+    }
+
+    auto all = h.snapshot();
+    check("wraparound caps retained samples at capacity",
+          all.size() == SystemStatsHistory::kCapacity);
+    check("wraparound drops the oldest samples",
+          all.front().timestamp == n - static_cast<int64_t>(SystemStatsHistory::kCapacity));
+    check("wraparound keeps the newest sample", all.back().timestamp == n - 1);
+    check("total counts overwritten samples too",
+          h.total_samples() == static_cast<uint64_t>(n));
+}
+
+static void test_device_samples_roundtrip() {
+    SystemStatsHistory h;
+    SystemStatsHistory::Sample s = make_sample(200);
+    s.devices.push_back({"gpu:card1", 42.0, 1.5});
+    s.devices.push_back({"npu:accel0", 7.0, -1.0});
+    h.record(s);
+
+    SystemStatsHistory::Sample latest;
+    check("devices: latest carries per-device readings",
+          h.latest(latest) && latest.devices.size() == 2);
+    check("devices: entries round-trip intact",
+          latest.devices.size() == 2 &&
+              latest.devices[0].device == "gpu:card1" &&
+              latest.devices[0].busy_percent == 42.0 &&
+              latest.devices[0].memory_gb == 1.5 &&
+              latest.devices[1].device == "npu:accel0" &&
+              latest.devices[1].memory_gb == -1.0);
+}
+
+int main() {
+    test_empty_history();
+    test_ordering_and_since_filter();
+    test_wraparound_keeps_newest();
+    test_device_samples_roundtrip();
+
+    if (g_failures == 0) {
+        std::printf("\nAll system stats history tests passed.\n");
+        return 0;
+    }
+    std::printf("\n%d system stats history test(s) FAILED.\n", g_failures);
+    return 1;
+}
@@ -12,6 +12,7 @@
 
 namespace lemon::telemetry {
     std::string standardize_thinking(const std::string& text);
+    std::string strip_thinking(const std::string& text);
     std::string hex_to_bytes(const std::string& hex);
 }
 
@@ -101,6 +102,24 @@ int main() {
              standardize_thinking("<thought>thinking<|turn>"),
              "<think>thinking</think>\n<|turn>");
 
+    // A block is closed once; later transition tags pass through verbatim.
+    check_eq("standardize_thinking: second transition verbatim",
+             standardize_thinking("<think>a<|turn>b<turn|>"),
+             "<think>a</think>\n<|turn>b<turn|>");
+
+    // --- strip_thinking tests ---
+    using lemon::telemetry::strip_thinking;
+    check_eq("strip_thinking: no tags", strip_thinking("Hello world"), "Hello world");
+    check_eq("strip_thinking: trims whitespace", strip_thinking("  hello \n"), "hello");
+    check_eq("strip_thinking: closed <think> block", strip_thinking("<think>reasoning</think>answer"), "answer");
+    check_eq("strip_thinking: closed <|think|> block", strip_thinking("<|think|>reasoning</|think|>answer"), "answer");
+    check_eq("strip_thinking: closed <thought> block", strip_thinking("<thought>reasoning</thought>answer"), "answer");
+    check_eq("strip_thinking: unclosed block drops rest", strip_thinking("pre<think>unclosed reasoning"), "pre");
+    check_eq("strip_thinking: multiple blocks", strip_thinking("a<think>x</think>b<think>y</think>c"), "abc");
+    check_eq("strip_thinking: orphan end tag kept", strip_thinking("a</think>b"), "a</think>b");
+    check_eq("strip_thinking: plain angle brackets kept", strip_thinking("a < b > c"), "a < b > c");
+    check_eq("strip_thinking: mismatched dialect end ignored", strip_thinking("a<think>x</thought>y</think>b"), "ab");
+
     std::printf("===========================================\n");
 
     // --- parse_vllm_metrics_text tests ---
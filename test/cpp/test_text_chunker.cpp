@@ -0,0 +1,124 @@
+// Standalone test for the document chunker behind POST /embeddings/ingest:
+// fixed-window overlap, sentence/paragraph packing, and UTF-8-safe splits.
+//
+// Compile: g++ -std=c++17 -I src/cpp/include test/cpp/test_text_chunker.cpp \
+//              -o test_text_chunker
+
+#include "lemon/utils/text_chunker.h"
+
+#include <cstdio>
+#include <string>
+
+using lemon::utils::chunk_text;
+using lemon::utils::ChunkingOptions;
+using lemon::utils::is_valid_chunking_strategy;
+
+static int g_failures = 0;
+
+static void check(const char* name, bool ok) {
+    std::printf("[%s] %s\n", ok ? "PASS" : "FAIL", name);
+    if (!ok) ++g_failures;
+}
+
+static bool valid_utf8(const std::string& text) {
+    size_t i = 0;
+    while (i < text.size()) {
+        const unsigned char c = static_cast<unsigned char>(text[i]);
+        size_t len = 1;
+        if (c >= 0xF0) len = 4;
+        else if (c >= 0xE0) len = 3;
+        else if (c >= 0xC0) len = 2;
+        else if (c >= 0x80) return false;
+        if (i + len > text.size()) return false;
+        for (size_t j = 1; j < len; ++j) {
+            if ((static_cast<unsigned char>(text[i + j]) & 0xC0) != 0x80) return false;
+        }
+        i += len;
+    }
+    return true;
+}
+
+int main() {
+    check("strategy validation accepts known strategies",
+          is_valid_chunking_strategy("fixed") &&
+          is_valid_chunking_strategy("sentence") &&
+          is_valid_chunking_strategy("paragraph"));
+    check("strategy validation rejects unknown strategy",
+          !is_valid_chunking_strategy("semantic"));
+
+    ChunkingOptions fixed;
+    fixed.strategy = "fixed";
+    fixed.max_chars = 10;
+    fixed.overlap_chars = 4;
+    const std::string text = "abcdefghijklmnopqrstuvwxyz";
+    auto chunks = chunk_text(text, fixed);
+    check("fixed: produces chunks", !chunks.empty());
+    bool sizes_ok = true;
+    for (const auto& c : chunks) {
+        if (c.text.size() > fixed.max_chars) sizes_ok = false;
+    }
+    check("fixed: chunk sizes bounded by max_chars", sizes_ok);
+    check("fixed: first chunk starts at offset 0",
+          chunks.front().offset == 0 && chunks.front().text == "abcdefghij");
+    check("fixed: stride honors overlap",
+          chunks.size() > 1 && chunks[1].offset == 6);
+    check("fixed: last chunk reaches end of text",
+          chunks.back().offset + chunks.back().text.size() == text.size());
+    bool offsets_match = true;
+    for (const auto& c : chunks) {
+        if (text.substr(c.offset, c.text.size()) != c.text) offsets_match = false;
+    }
+    check("fixed: offsets index into source text", offsets_match);
+
+    // Multi-byte code points straddling a window boundary must not be cut.
+    ChunkingOptions utf8_opts;
+    utf8_opts.strategy = "fixed";
+    utf8_opts.max_chars = 5;
+    utf8_opts.overlap_chars = 0;
+    const std::string utf8_text = "ab\xC3\xA9\xC3\xA9\xC3\xA9\xC3\xA9踙d";
+    auto utf8_chunks = chunk_text(utf8_text, utf8_opts);
+    bool all_valid = !utf8_chunks.empty();
+    for (const auto& c : utf8_chunks) {
+        if (!valid_utf8(c.text)) all_valid = false;
+    }
+    check("fixed: never splits inside a UTF-8 sequence", all_valid);
+    std::string reassembled;
+    for (const auto& c : utf8_chunks) reassembled += c.text;
+    check("fixed: zero-overlap chunks reassemble the document",
+          reassembled == utf8_text);
+
+    ChunkingOptions sentence;
+    sentence.strategy = "sentence";
+    sentence.max_chars = 25;
+    auto sent_chunks =
+        chunk_text("One sentence. Two here! A third? And a final one.", sentence);
+    check("sentence: packs sentences up to max_chars", sent_chunks.size() == 3);
+    check("sentence: first chunk holds two short sentences",
+          !sent_chunks.empty() && sent_chunks[0].text == "One sentence. Two here!");
+
+    ChunkingOptions paragraph;
+    paragraph.strategy = "paragraph";
+    paragraph.max_chars = 12;
+    auto para_chunks = chunk_text("first para\n\nsecond para\n\nthird", paragraph);
+    check("paragraph: splits on blank lines", para_chunks.size() == 3);
+    check("paragraph: offsets skip the separators",
+          para_chunks.size() == 3 && para_chunks[1].offset == 12 &&
+          para_chunks[1].text == "second para");
+
+    ChunkingOptions oversized = paragraph;
+    oversized.max_chars = 8;
+    auto hard_split = chunk_text("a paragraph longer than the limit", oversized);
+    bool bounded = !hard_split.empty();
+    for (const auto& c : hard_split) {
+        if (c.text.size() > oversized.max_chars) bounded = false;
+    }
+    check("paragraph: oversized segment hard-splits within bound", bounded);
+
+    check("empty input yields no chunks", chunk_text("", fixed).empty());
+    ChunkingOptions ws = paragraph;
+    auto ws_chunks = chunk_text("   \n\n  \n  ", ws);
+    check("whitespace-only input yields no chunks", ws_chunks.empty());
+
+    std::printf("%s\n", g_failures == 0 ? "ALL PASS" : "FAILURES");
+    return g_failures == 0 ? 0 : 1;
+}
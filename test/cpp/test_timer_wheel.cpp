@@ -0,0 +1,94 @@
+// Shared recurring-timer service: scheduling, descheduling via the tick
+// return value, and the blocking cancel() contract.
+
+#include "lemon/timer_wheel.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <thread>
+
+using lemon::TimerWheel;
+
+static int failures = 0;
+
+static void check(const char* name, bool ok) {
+    std::printf("[%s] %s\n", ok ? "PASS" : "FAIL", name);
+    if (!ok) ++failures;
+}
+
+static bool wait_for(const std::atomic<int>& counter, int target, int timeout_ms) {
+    const auto deadline =
+        std::chrono::steady_clock::now() + std::chrono::milliseconds(timeout_ms);
+    while (std::chrono::steady_clock::now() < deadline) {
+        if (counter.load() >= target) {
+            return true;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    return counter.load() >= target;
+}
+
+int main() {
+    TimerWheel wheel;
+
+    std::atomic<int> ticks{0};
+    const auto id = wheel.schedule_recurring(
+        "recurring", std::chrono::milliseconds(50), [&]() {
+            ++ticks;
+            return true;
+        });
+    check("recurring task fires repeatedly", wait_for(ticks, 3, 2000));
+    check("task is tracked while scheduled", wheel.task_count() == 1);
+
+    wheel.cancel(id);
+    const int after_cancel = ticks.load();
+    std::this_thread::sleep_for(std::chrono::milliseconds(250));
+    check("cancelled task stops firing", ticks.load() == after_cancel);
+    check("cancelled task is removed", wheel.task_count() == 0);
+    wheel.cancel(id);
+    check("cancel of an unknown id is a no-op", wheel.task_count() == 0);
+
+    std::atomic<int> limited{0};
+    wheel.schedule_recurring("self-stopping", std::chrono::milliseconds(30), [&]() {
+        return ++limited < 2;
+    });
+    check("tick returning false deschedules", wait_for(limited, 2, 2000));
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+    check("descheduled task does not fire again", limited.load() == 2);
+    check("descheduled task is removed", wheel.task_count() == 0);
+
+    // cancel() must not return while the task's tick is still running.
+    std::atomic<bool> in_tick{false};
+    std::atomic<bool> tick_done{false};
+    const auto slow_id = wheel.schedule_recurring(
+        "slow", std::chrono::milliseconds(30), [&]() {
+            in_tick = true;
+            std::this_thread::sleep_for(std::chrono::milliseconds(300));
+            tick_done = true;
+            return true;
+        });
+    while (!in_tick.load()) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    wheel.cancel(slow_id);
+    check("cancel waits out an in-flight tick", tick_done.load());
+
+    std::atomic<int> a{0};
+    std::atomic<int> b{0};
+    const auto id_a = wheel.schedule_recurring(
+        "coalesced-a", std::chrono::milliseconds(60), [&]() { ++a; return true; });
+    const auto id_b = wheel.schedule_recurring(
+        "coalesced-b", std::chrono::milliseconds(60), [&]() { ++b; return true; });
+    check("tasks with equal periods share the wheel",
+          wait_for(a, 2, 2000) && wait_for(b, 2, 2000));
+    wheel.cancel(id_a);
+    wheel.cancel(id_b);
+
+    if (failures == 0) {
+        std::printf("All timer wheel tests passed\n");
+        return 0;
+    }
+    std::printf("%d timer wheel test(s) failed\n", failures);
+    return 1;
+}
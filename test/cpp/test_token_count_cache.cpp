@@ -0,0 +1,80 @@
+// Token count LRU: hit/miss behavior, per-model keying, bounded eviction.
+
+#include "lemon/token_count_cache.h"
+
+#include <cstdio>
+#include <string>
+
+using lemon::TokenCountCache;
+
+static int g_failures = 0;
+
+static void check(const char* name, bool ok) {
+    std::printf("[%s] %s\n", ok ? "PASS" : "FAIL", name);
+    if (!ok) {
+        ++g_failures;
+    }
+}
+
+static void test_miss_then_hit() {
+    TokenCountCache cache;
+    check("cold cache misses", !cache.lookup("m", "hello world"));
+    cache.store("m", "hello world", 3);
+    auto hit = cache.lookup("m", "hello world");
+    check("stored count is served", hit && *hit == 3);
+}
+
+static void test_model_scoping() {
+    TokenCountCache cache;
+    cache.store("llama", "same text", 4);
+    cache.store("qwen", "same text", 6);
+    auto a = cache.lookup("llama", "same text");
+    auto b = cache.lookup("qwen", "same text");
+    check("counts are keyed per model", a && *a == 4 && b && *b == 6);
+    check("unknown model misses", !cache.lookup("other", "same text"));
+}
+
+static void test_length_distinguishes_texts() {
+    TokenCountCache cache;
+    cache.store("m", "abc", 1);
+    check("different text misses", !cache.lookup("m", "abcd"));
+}
+
+static void test_restore_updates_count() {
+    TokenCountCache cache;
+    cache.store("m", "text", 5);
+    cache.store("m", "text", 7);
+    auto hit = cache.lookup("m", "text");
+    check("re-store overwrites the count", hit && *hit == 7);
+    check("re-store does not duplicate the entry", cache.size() == 1);
+}
+
+static void test_lru_eviction() {
+    TokenCountCache cache;
+    for (int i = 0; i < 1200; ++i) {
+        cache.store("m", "text-" + std::to_string(i), i);
+        if (i % 10 == 0) {
+            // Keep entry 0 hot so it survives the sweep.
+            cache.lookup("m", "text-0");
+        }
+    }
+    check("cache stays bounded", cache.size() <= 1024);
+    check("hot entry survives eviction", cache.lookup("m", "text-0").has_value());
+    check("cold entry was evicted", !cache.lookup("m", "text-1"));
+    check("recent entry survives", cache.lookup("m", "text-1199").has_value());
+}
+
+int main() {
+    test_miss_then_hit();
+    test_model_scoping();
+    test_length_distinguishes_texts();
+    test_restore_updates_count();
+    test_lru_eviction();
+
+    if (g_failures > 0) {
+        std::printf("%d check(s) failed\n", g_failures);
+        return 1;
+    }
+    std::printf("all checks passed\n");
+    return 0;
+}
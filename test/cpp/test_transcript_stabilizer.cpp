@@ -0,0 +1,99 @@
+// Standalone test for the interim transcript stabilizer.
+//
+// Compile: g++ -std=c++17 -I src/cpp/include test/cpp/test_transcript_stabilizer.cpp -o test_transcript_stabilizer
+
+#include "lemon/transcript_stabilizer.h"
+#include <cstdio>
+#include <string>
+
+using lemon::TranscriptStabilizer;
+using lemon::TranscriptUpdate;
+
+static int g_failures = 0;
+
+static void check(const char* name, bool ok) {
+    std::printf("[%s] %s\n", ok ? "PASS" : "FAIL", name);
+    if (!ok) ++g_failures;
+}
+
+static void test_first_hypothesis_is_all_volatile() {
+    TranscriptStabilizer stabilizer;
+    auto update = stabilizer.update("hello world");
+    check("nothing stable on first hypothesis", update.stable_delta.empty());
+    check("first hypothesis is volatile", update.volatile_suffix == "hello world");
+}
+
+static void test_agreement_commits_at_word_boundary() {
+    TranscriptStabilizer stabilizer;
+    stabilizer.update("hello wor");
+    auto update = stabilizer.update("hello world how");
+
+    check("agreed words become stable", update.stable_delta == "hello ");
+    check("tail stays volatile", update.volatile_suffix == "world how");
+}
+
+static void test_committed_text_never_retracts() {
+    TranscriptStabilizer stabilizer;
+    stabilizer.update("the quick brown");
+    stabilizer.update("the quick brown fox");
+    const size_t committed = stabilizer.committed_length();
+
+    auto update = stabilizer.update("a totally different decode");
+    check("rewrite does not retract committed prefix",
+          stabilizer.committed_length() == committed);
+    check("rewrite produces no stable delta", update.stable_delta.empty());
+}
+
+static void test_identical_hypotheses_commit_fully() {
+    TranscriptStabilizer stabilizer;
+    stabilizer.update("stop");
+    auto update = stabilizer.update("stop");
+    check("repeated hypothesis commits without trailing space",
+          update.stable_delta == "stop" && update.volatile_suffix.empty());
+}
+
+static void test_deltas_concatenate_to_stable_prefix() {
+    TranscriptStabilizer stabilizer;
+    std::string assembled;
+    const char* hypotheses[] = {
+        "the",
+        "the quick",
+        "the quick brown",
+        "the quick brown fox jumps",
+        "the quick brown fox jumps over",
+    };
+    TranscriptUpdate last;
+    for (const char* h : hypotheses) {
+        last = stabilizer.update(h);
+        assembled += last.stable_delta;
+    }
+    check("stable deltas concatenate to the agreed prefix",
+          assembled + last.volatile_suffix == "the quick brown fox jumps over");
+}
+
+static void test_reset_starts_fresh() {
+    TranscriptStabilizer stabilizer;
+    stabilizer.update("one two");
+    stabilizer.update("one two three");
+    stabilizer.reset();
+    check("reset clears committed length", stabilizer.committed_length() == 0);
+    auto update = stabilizer.update("new utterance");
+    check("post-reset hypothesis is volatile again",
+          update.stable_delta.empty() && update.volatile_suffix == "new utterance");
+}
+
+int main() {
+    test_first_hypothesis_is_all_volatile();
+    test_agreement_commits_at_word_boundary();
+    test_committed_text_never_retracts();
+    test_identical_hypotheses_commit_fully();
+    test_deltas_concatenate_to_stable_prefix();
+    test_reset_starts_fresh();
+
+    if (g_failures > 0) {
+        std::printf("%d check(s) failed\n", g_failures);
+        return 1;
+    }
+    std::printf("All checks passed\n");
+    return 0;
+}
@@ -0,0 +1,195 @@
+// Standalone test for the realtime transcription scheduler.
+//
+// Compile: g++ -std=c++17 -pthread -I src/cpp/include
+//   test/cpp/test_transcription_scheduler.cpp
+//   src/cpp/server/transcription_scheduler.cpp -o test_transcription_scheduler
+
+#include "lemon/transcription_scheduler.h"
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using lemon::TranscriptionScheduler;
+
+static int g_failures = 0;
+
+static void check(const char* name, bool ok) {
+    std::printf("[%s] %s\n", ok ? "PASS" : "FAIL", name);
+    if (!ok) ++g_failures;
+}
+
+namespace {
+
+// Runner whose workers block on a gate, so queue contents can be inspected
+// deterministically while jobs are held in flight.
+struct GatedRunner {
+    std::mutex mutex;
+    std::condition_variable cv;
+    bool open = false;
+    std::vector<TranscriptionScheduler::Job> ran;
+
+    TranscriptionScheduler::Runner runner() {
+        return [this](TranscriptionScheduler::Job& job) {
+            std::unique_lock<std::mutex> lock(mutex);
+            cv.wait(lock, [this] { return open; });
+            ran.push_back(job);
+        };
+    }
+
+    void release() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            open = true;
+        }
+        cv.notify_all();
+    }
+
+    size_t ran_count() {
+        std::lock_guard<std::mutex> lock(mutex);
+        return ran.size();
+    }
+};
+
+TranscriptionScheduler::Job make_job(const char* session, uint8_t payload, bool interim) {
+    TranscriptionScheduler::Job job;
+    job.session_id = session;
+    job.wav_data = {payload};
+    job.model = "whisper";
+    job.is_interim = interim;
+    return job;
+}
+
+void wait_until(const std::function<bool()>& condition) {
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (!condition() && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+}
+
+}  // namespace
+
+static void test_jobs_reach_runner() {
+    GatedRunner gate;
+    TranscriptionScheduler scheduler(gate.runner(), 1);
+    gate.release();
+
+    scheduler.submit(make_job("sess_a", 1, false));
+    wait_until([&] { return gate.ran_count() == 1; });
+
+    check("job reaches runner", gate.ran_count() == 1);
+    check("payload survives", !gate.ran.empty() && gate.ran[0].wav_data == std::vector<uint8_t>{1});
+    check("session tag survives", !gate.ran.empty() && gate.ran[0].session_id == "sess_a");
+}
+
+static void test_interims_coalesce_per_session() {
+    GatedRunner gate;
+    TranscriptionScheduler scheduler(gate.runner(), 1);
+
+    // Occupy the single worker so subsequent submits stay queued
+    scheduler.submit(make_job("sess_busy", 0, false));
+    wait_until([&] { return scheduler.queued_jobs() == 0; });
+
+    for (uint8_t i = 1; i <= 5; ++i) {
+        scheduler.submit(make_job("sess_a", i, true));
+    }
+
+    check("newer interim replaces queued one", scheduler.queued_jobs() == 1);
+    check("coalesced submissions are counted", scheduler.coalesced_jobs() == 4);
+
+    gate.release();
+    wait_until([&] { return gate.ran_count() == 2; });
+    check("latest snapshot wins",
+          gate.ran_count() == 2 && gate.ran[1].wav_data == std::vector<uint8_t>{5});
+}
+
+static void test_interims_from_different_sessions_do_not_coalesce() {
+    GatedRunner gate;
+    TranscriptionScheduler scheduler(gate.runner(), 1);
+
+    scheduler.submit(make_job("sess_busy", 0, false));
+    wait_until([&] { return scheduler.queued_jobs() == 0; });
+
+    scheduler.submit(make_job("sess_a", 1, true));
+    scheduler.submit(make_job("sess_b", 2, true));
+
+    check("sessions keep independent interims", scheduler.queued_jobs() == 2);
+    gate.release();
+}
+
+static void test_final_supersedes_queued_interim() {
+    GatedRunner gate;
+    TranscriptionScheduler scheduler(gate.runner(), 1);
+
+    scheduler.submit(make_job("sess_busy", 0, false));
+    wait_until([&] { return scheduler.queued_jobs() == 0; });
+
+    scheduler.submit(make_job("sess_a", 1, true));
+    scheduler.submit(make_job("sess_a", 2, false));
+
+    check("final replaces queued interim", scheduler.queued_jobs() == 1);
+
+    gate.release();
+    wait_until([&] { return gate.ran_count() == 2; });
+    check("only the final runs",
+          gate.ran_count() == 2 && !gate.ran[1].is_interim &&
+          gate.ran[1].wav_data == std::vector<uint8_t>{2});
+}
+
+static void test_drop_session_discards_queued_work() {
+    GatedRunner gate;
+    TranscriptionScheduler scheduler(gate.runner(), 1);
+
+    scheduler.submit(make_job("sess_busy", 0, false));
+    wait_until([&] { return scheduler.queued_jobs() == 0; });
+
+    scheduler.submit(make_job("sess_a", 1, true));
+    scheduler.submit(make_job("sess_a", 2, false));
+    scheduler.submit(make_job("sess_b", 3, true));
+
+    scheduler.drop_session("sess_a");
+    check("drop removes only that session's jobs", scheduler.queued_jobs() == 1);
+
+    gate.release();
+    wait_until([&] { return gate.ran_count() == 2; });
+    check("surviving session still runs",
+          gate.ran_count() == 2 && gate.ran[1].session_id == "sess_b");
+}
+
+static void test_shutdown_discards_queue_without_hanging() {
+    GatedRunner gate;
+    {
+        TranscriptionScheduler scheduler(gate.runner(), 2);
+        scheduler.submit(make_job("sess_a", 1, false));
+        scheduler.submit(make_job("sess_b", 2, false));
+        wait_until([&] { return scheduler.queued_jobs() == 0; });
+        for (uint8_t i = 3; i <= 6; ++i) {
+            scheduler.submit(make_job("sess_q", i, false));
+        }
+        gate.release();
+        scheduler.shutdown();
+        scheduler.submit(make_job("sess_late", 7, false));
+        check("submit after shutdown is a no-op", scheduler.queued_jobs() == 0);
+    }
+    check("in-flight jobs complete before shutdown returns", gate.ran_count() >= 2);
+}
+
+int main() {
+    test_jobs_reach_runner();
+    test_interims_coalesce_per_session();
+    test_interims_from_different_sessions_do_not_coalesce();
+    test_final_supersedes_queued_interim();
+    test_drop_session_discards_queued_work();
+    test_shutdown_discards_queue_without_hanging();
+
+    if (g_failures > 0) {
+        std::printf("%d check(s) failed\n", g_failures);
+        return 1;
+    }
+    std::printf("All checks passed\n");
+    return 0;
+}
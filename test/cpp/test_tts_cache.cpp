@@ -0,0 +1,160 @@
+// Standalone test for the content-addressed TTS result cache.
+//
+// Compile: g++ -std=c++17 -I src/cpp/include test/cpp/test_tts_cache.cpp
+//   src/cpp/server/tts_cache.cpp src/cpp/server/utils/path_utils.cpp
+//   -o test_tts_cache
+
+#include "lemon/tts_cache.h"
+
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <string>
+#include <thread>
+
+#include <nlohmann/json.hpp>
+
+namespace fs = std::filesystem;
+using lemon::TtsCache;
+using nlohmann::json;
+
+static int g_failures = 0;
+
+static void check(const char* name, bool ok) {
+    std::printf("[%s] %s\n", ok ? "PASS" : "FAIL", name);
+    if (!ok) ++g_failures;
+}
+
+static void settle_mtime() {
+    std::this_thread::sleep_for(std::chrono::milliseconds(30));
+}
+
+static json speech_request(const std::string& input,
+                           const std::string& voice = "af_sky",
+                           double speed = 1.0) {
+    return json{{"model", "Kokoro-82M"},
+                {"input", input},
+                {"voice", voice},
+                {"speed", speed}};
+}
+
+static void test_key_stability_and_uniqueness() {
+    const auto request = speech_request("Hello world.");
+    const std::string key = TtsCache::key_for(request, "mp3");
+    check("same request maps to the same key",
+          key == TtsCache::key_for(speech_request("Hello world."), "mp3"));
+    check("key is a fixed-width hex name",
+          key.size() == 32 &&
+          key.find_first_not_of("0123456789abcdef") == std::string::npos);
+    check("input changes the key",
+          key != TtsCache::key_for(speech_request("Goodbye world."), "mp3"));
+    check("voice changes the key",
+          key != TtsCache::key_for(speech_request("Hello world.", "am_adam"), "mp3"));
+    check("speed changes the key",
+          key != TtsCache::key_for(speech_request("Hello world.", "af_sky", 1.5), "mp3"));
+    check("format changes the key",
+          key != TtsCache::key_for(request, "wav"));
+    auto cloned = speech_request("Hello world.");
+    cloned["reference_wav_b64"] = "UklGRg==";
+    check("extension fields change the key",
+          key != TtsCache::key_for(cloned, "mp3"));
+    auto streamed = speech_request("Hello world.");
+    streamed["stream_format"] = "audio";
+    check("transport fields do not change the key",
+          key == TtsCache::key_for(streamed, "mp3"));
+    check("absent optional fields still hash",
+          !TtsCache::key_for(json{{"model", "m"}, {"input", "x"}}, "default").empty());
+}
+
+static void test_hit_miss_roundtrip(const fs::path& dir) {
+    TtsCache cache(dir.string());
+    const std::string key = TtsCache::key_for(speech_request("roundtrip"), "mp3");
+
+    std::string format;
+    std::string audio;
+    check("lookup before store misses", !cache.lookup(key, format, audio));
+
+    cache.store(key, "mp3", "fake-mp3-bytes");
+    check("lookup after store hits", cache.lookup(key, format, audio));
+    check("stored bytes round-trip", audio == "fake-mp3-bytes");
+    check("stored format round-trips", format == "mp3");
+
+    check("other keys still miss",
+          !cache.lookup(TtsCache::key_for(speech_request("other"), "mp3"),
+                        format, audio));
+}
+
+static void test_persistence_across_instances(const fs::path& dir) {
+    const std::string key = TtsCache::key_for(speech_request("persisted"), "wav");
+    {
+        TtsCache cache(dir.string());
+        cache.store(key, "wav", "wav-bytes");
+    }
+    TtsCache reopened(dir.string());
+    std::string format;
+    std::string audio;
+    check("entries survive a new instance",
+          reopened.lookup(key, format, audio) && audio == "wav-bytes" &&
+          format == "wav");
+}
+
+static void test_lru_eviction(const fs::path& dir) {
+    TtsCache cache(dir.string(), 2500);
+    const std::string payload(1000, 'a');
+
+    const std::string key_a = TtsCache::key_for(speech_request("a"), "mp3");
+    const std::string key_b = TtsCache::key_for(speech_request("b"), "mp3");
+    const std::string key_c = TtsCache::key_for(speech_request("c"), "mp3");
+
+    cache.store(key_a, "mp3", payload);
+    settle_mtime();
+    cache.store(key_b, "mp3", payload);
+    settle_mtime();
+
+    std::string format;
+    std::string audio;
+    check("hit refreshes LRU position", cache.lookup(key_a, format, audio));
+    settle_mtime();
+
+    cache.store(key_c, "mp3", payload);
+    check("cache stays within its size bound", cache.size_bytes() <= 2500);
+    check("least recently used entry was evicted",
+          !cache.lookup(key_b, format, audio));
+    check("recently touched entry survives", cache.lookup(key_a, format, audio));
+    check("newest entry survives", cache.lookup(key_c, format, audio));
+}
+
+static void test_oversized_and_empty_clips(const fs::path& dir) {
+    TtsCache cache(dir.string(), 100);
+    const std::string key = TtsCache::key_for(speech_request("huge"), "mp3");
+    cache.store(key, "mp3", std::string(500, 'x'));
+    std::string format;
+    std::string audio;
+    check("clips larger than the cache are not stored",
+          !cache.lookup(key, format, audio));
+    cache.store(key, "mp3", "");
+    check("empty clips are not stored", !cache.lookup(key, format, audio));
+}
+
+int main() {
+    const fs::path root =
+        fs::temp_directory_path() /
+        ("tts_cache_test_" + std::to_string(
+             std::chrono::steady_clock::now().time_since_epoch().count()));
+    fs::create_directories(root);
+
+    test_key_stability_and_uniqueness();
+    test_hit_miss_roundtrip(root / "roundtrip");
+    test_persistence_across_instances(root / "persist");
+    test_lru_eviction(root / "lru");
+    test_oversized_and_empty_clips(root / "bounds");
+
+    fs::remove_all(root);
+
+    if (g_failures > 0) {
+        std::printf("%d check(s) failed\n", g_failures);
+        return 1;
+    }
+    std::printf("All checks passed\n");
+    return 0;
+}
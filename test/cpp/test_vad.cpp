@@ -0,0 +1,168 @@
+// Standalone test for the vectorized VAD energy path.
+//
+// Compile: g++ -std=c++17 -I src/cpp/include test/cpp/test_vad.cpp src/cpp/server/vad.cpp -o test_vad
+
+#include "lemon/vad.h"
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+using lemon::SimpleVAD;
+
+static int g_failures = 0;
+
+static void check(const char* name, bool ok) {
+    std::printf("[%s] %s\n", ok ? "PASS" : "FAIL", name);
+    if (!ok) ++g_failures;
+}
+
+static std::vector<float> tone(size_t count, float amplitude) {
+    std::vector<float> samples(count);
+    for (size_t i = 0; i < count; ++i) {
+        samples[i] = amplitude * std::sin(0.1f * static_cast<float>(i));
+    }
+    return samples;
+}
+
+static void test_simd_matches_scalar() {
+    for (size_t count : {0u, 1u, 3u, 4u, 5u, 15u, 16u, 1600u, 1601u}) {
+        auto samples = tone(count, 0.5f);
+        const float simd = SimpleVAD::sum_squares(samples.data(), count);
+        const float scalar = SimpleVAD::sum_squares_scalar(samples.data(), count);
+        const float tolerance = 1e-4f * (scalar + 1.0f);
+        if (std::fabs(simd - scalar) > tolerance) {
+            std::printf("  count=%zu simd=%f scalar=%f\n", count, simd, scalar);
+            check("simd sum_squares matches scalar", false);
+            return;
+        }
+    }
+    check("simd sum_squares matches scalar", true);
+}
+
+static void test_pointer_overload_matches_vector() {
+    SimpleVAD::Config config;
+    config.min_speech_ms = 100;
+    config.onset_frames = 1;
+
+    SimpleVAD by_vector(config);
+    SimpleVAD by_pointer(config);
+    auto loud = tone(1600, 0.5f);
+
+    for (int i = 0; i < 4; ++i) {
+        auto a = by_vector.process(loud, 16000);
+        auto b = by_pointer.process(loud.data(), loud.size(), 16000);
+        if (a != b) {
+            check("pointer overload matches vector overload", false);
+            return;
+        }
+    }
+    check("pointer overload matches vector overload", true);
+    check("last_rms reflects processed chunk", by_pointer.last_rms() > 0.1f);
+}
+
+static void test_speech_boundary_events() {
+    SimpleVAD::Config config;
+    config.min_speech_ms = 100;
+    config.min_silence_ms = 200;
+    config.onset_frames = 1;
+    config.hangover_frames = 0;
+    SimpleVAD vad(config);
+
+    auto loud = tone(1600, 0.5f);                // 100ms of clear speech
+    std::vector<float> quiet(1600, 0.0f);        // 100ms of silence
+
+    bool saw_start = false;
+    for (int i = 0; i < 4 && !saw_start; ++i) {
+        saw_start = vad.process(loud.data(), loud.size(), 16000) == SimpleVAD::Event::SpeechStart;
+    }
+    check("speech start detected", saw_start && vad.is_speech_active());
+
+    bool saw_end = false;
+    for (int i = 0; i < 6 && !saw_end; ++i) {
+        saw_end = vad.process(quiet.data(), quiet.size(), 16000) == SimpleVAD::Event::SpeechEnd;
+    }
+    check("speech end detected", saw_end && !vad.is_speech_active());
+
+    vad.reset();
+    check("reset clears last_rms", vad.last_rms() == 0.0f);
+}
+
+static void test_endpointing_profiles() {
+    SimpleVAD::Config fast;
+    SimpleVAD::Config balanced;
+    SimpleVAD::Config dictation;
+    check("fast profile resolves",
+          SimpleVAD::config_for_profile("fast", fast));
+    check("balanced profile resolves",
+          SimpleVAD::config_for_profile("balanced", balanced));
+    check("dictation profile resolves",
+          SimpleVAD::config_for_profile("dictation", dictation));
+    check("profiles order endpointing fast < balanced < dictation",
+          fast.min_silence_ms < balanced.min_silence_ms &&
+              balanced.min_silence_ms < dictation.min_silence_ms);
+    check("dictation profile matches the defaults",
+          dictation.min_silence_ms == SimpleVAD::Config{}.min_silence_ms);
+
+    SimpleVAD::Config untouched;
+    untouched.min_silence_ms = 123;
+    check("unknown profile rejected without touching config",
+          !SimpleVAD::config_for_profile("warp", untouched) &&
+              untouched.min_silence_ms == 123);
+}
+
+static void test_speech_ending_precedes_end() {
+    SimpleVAD::Config config;
+    config.min_speech_ms = 100;
+    config.min_silence_ms = 300;
+    config.onset_frames = 1;
+    config.hangover_frames = 1;
+    SimpleVAD vad(config);
+
+    auto loud = tone(1600, 0.5f);
+    std::vector<float> quiet(1600, 0.0f);
+
+    while (vad.process(loud.data(), loud.size(), 16000) != SimpleVAD::Event::SpeechStart) {
+    }
+
+    bool saw_ending_first = false;
+    bool saw_end = false;
+    for (int i = 0; i < 8 && !saw_end; ++i) {
+        auto event = vad.process(quiet.data(), quiet.size(), 16000);
+        if (event == SimpleVAD::Event::SpeechEnding && !saw_end) {
+            saw_ending_first = true;
+        }
+        saw_end = event == SimpleVAD::Event::SpeechEnd;
+    }
+    check("speech ending fires before speech end", saw_ending_first && saw_end);
+
+    // Voice resuming during the silence window must not end the turn.
+    while (vad.process(loud.data(), loud.size(), 16000) != SimpleVAD::Event::SpeechStart) {
+    }
+    vad.process(quiet.data(), quiet.size(), 16000);  // burn hangover
+    bool ending = vad.process(quiet.data(), quiet.size(), 16000) == SimpleVAD::Event::SpeechEnding;
+    bool resumed = vad.process(loud.data(), loud.size(), 16000) == SimpleVAD::Event::None;
+    check("voice after speech ending keeps the turn open",
+          ending && resumed && vad.is_speech_active());
+}
+
+static void test_empty_chunk_is_noop() {
+    SimpleVAD vad;
+    check("empty chunk yields no event",
+          vad.process(nullptr, 0, 16000) == SimpleVAD::Event::None);
+}
+
+int main() {
+    test_simd_matches_scalar();
+    test_pointer_overload_matches_vector();
+    test_speech_boundary_events();
+    test_endpointing_profiles();
+    test_speech_ending_precedes_end();
+    test_empty_chunk_is_noop();
+
+    if (g_failures > 0) {
+        std::printf("%d check(s) failed\n", g_failures);
+        return 1;
+    }
+    std::printf("All checks passed\n");
+    return 0;
+}
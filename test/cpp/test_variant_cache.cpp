@@ -0,0 +1,108 @@
+// Standalone test for lemon::VariantCache.
+
+#include "lemon/variant_cache.h"
+
+#include <chrono>
+#include <cstdio>
+#include <ctime>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <thread>
+
+using lemon::VariantCache;
+namespace fs = std::filesystem;
+
+struct TestResult {
+    int passed = 0;
+    int failed = 0;
+
+    void ok(const std::string& name) {
+        printf("[PASS] %s\n", name.c_str());
+        ++passed;
+    }
+
+    void fail(const std::string& name) {
+        printf("[FAIL] %s\n", name.c_str());
+        ++failed;
+    }
+};
+
+static void check(TestResult& r, bool cond, const std::string& name) {
+    if (cond) {
+        r.ok(name);
+    } else {
+        r.fail(name);
+    }
+}
+
+static fs::path make_temp_dir() {
+    fs::path tmp = fs::temp_directory_path() / "variant_cache_test_";
+    tmp += std::to_string(std::hash<std::string>{}(std::to_string(std::time(nullptr))));
+    fs::create_directories(tmp);
+    return tmp;
+}
+
+int main() {
+    TestResult r;
+
+    const fs::path root = make_temp_dir();
+    const fs::path manifest = root / "variant_cache.json";
+    const auto ttl = std::chrono::seconds(3600);
+
+    const nlohmann::json body = {
+        {"checkpoint", "unsloth/Qwen3-0.6B-GGUF"},
+        {"recipe", "llamacpp"},
+        {"variants", nlohmann::json::array({{{"name", "Q4_K_M"}}})},
+    };
+
+    {
+        VariantCache cache(manifest);
+        check(r, !cache.lookup("huggingface", "unsloth/Qwen3-0.6B-GGUF", ttl).has_value(),
+              "empty cache misses");
+
+        cache.store("huggingface", "unsloth/Qwen3-0.6B-GGUF", body);
+        auto hit = cache.lookup("huggingface", "unsloth/Qwen3-0.6B-GGUF", ttl);
+        check(r, hit.has_value() && *hit == body, "fresh entry is served");
+        check(r, !cache.lookup("modelscope", "unsloth/Qwen3-0.6B-GGUF", ttl).has_value(),
+              "entries are keyed per source");
+        check(r, fs::exists(manifest), "store persists the manifest");
+    }
+
+    {
+        VariantCache cache(manifest);
+        auto hit = cache.lookup("huggingface", "unsloth/Qwen3-0.6B-GGUF", ttl);
+        check(r, hit.has_value() && *hit == body, "entry survives a restart");
+
+        // Timestamps have one-second granularity, so outlive a 1s TTL by a
+        // comfortable margin.
+        std::this_thread::sleep_for(std::chrono::milliseconds(2100));
+        check(r, !cache.lookup("huggingface", "unsloth/Qwen3-0.6B-GGUF",
+                               std::chrono::seconds(1)).has_value(),
+              "expired entry is not served");
+        auto stale = cache.lookup("huggingface", "unsloth/Qwen3-0.6B-GGUF",
+                                  std::chrono::seconds(1), true);
+        check(r, stale.has_value() && *stale == body,
+              "allow_stale serves an expired entry");
+
+        cache.erase("huggingface", "unsloth/Qwen3-0.6B-GGUF");
+        check(r, !cache.lookup("huggingface", "unsloth/Qwen3-0.6B-GGUF", ttl,
+                               true).has_value(),
+              "erase removes the entry");
+    }
+
+    {
+        std::ofstream(manifest, std::ios::trunc) << "{not json";
+        VariantCache cache(manifest);
+        check(r, !cache.lookup("huggingface", "unsloth/Qwen3-0.6B-GGUF", ttl).has_value(),
+              "corrupt manifest is discarded");
+        cache.store("huggingface", "unsloth/Qwen3-0.6B-GGUF", body);
+        auto hit = cache.lookup("huggingface", "unsloth/Qwen3-0.6B-GGUF", ttl);
+        check(r, hit.has_value() && *hit == body, "cache recovers after corruption");
+    }
+
+    fs::remove_all(root);
+
+    printf("\n%d passed, %d failed\n", r.passed, r.failed);
+    return r.failed == 0 ? 0 : 1;
+}
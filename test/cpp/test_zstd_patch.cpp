@@ -0,0 +1,156 @@
+#include "lemon/utils/zstd_patch.h"
+
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <string>
+#include <vector>
+#include <zstd.h>
+
+using lemon::utils::ZstdPatch;
+
+namespace fs = std::filesystem;
+
+static int g_failures = 0;
+
+static void check(const char* name, bool ok) {
+    std::printf("[%s] %s\n", ok ? "PASS" : "FAIL", name);
+    if (!ok) ++g_failures;
+}
+
+static fs::path g_root;
+
+static void write_file(const fs::path& path, const std::string& contents) {
+    std::ofstream file(path, std::ios::binary);
+    file.write(contents.data(), static_cast<std::streamsize>(contents.size()));
+}
+
+static std::string read_file(const fs::path& path) {
+    std::ifstream file(path, std::ios::binary);
+    return std::string(std::istreambuf_iterator<char>(file),
+                       std::istreambuf_iterator<char>());
+}
+
+static std::string make_blob(size_t size, uint64_t seed) {
+    std::mt19937_64 rng(seed);
+    std::string blob(size, '\0');
+    for (auto& byte : blob) {
+        byte = static_cast<char>(rng() & 0xff);
+    }
+    return blob;
+}
+
+static std::string make_patch(const std::string& base, const std::string& target) {
+    ZSTD_CCtx* cctx = ZSTD_createCCtx();
+    ZSTD_CCtx_setParameter(cctx, ZSTD_c_windowLog, 24);
+    ZSTD_CCtx_setParameter(cctx, ZSTD_c_checksumFlag, 1);
+    ZSTD_CCtx_setParameter(cctx, ZSTD_c_enableLongDistanceMatching, 1);
+    ZSTD_CCtx_refPrefix(cctx, base.data(), base.size());
+
+    std::string patch(ZSTD_compressBound(target.size()), '\0');
+    const size_t written = ZSTD_compress2(cctx, patch.data(), patch.size(),
+                                          target.data(), target.size());
+    ZSTD_freeCCtx(cctx);
+    if (ZSTD_isError(written)) {
+        return "";
+    }
+    patch.resize(written);
+    return patch;
+}
+
+static void test_reconstructs_target() {
+    const std::string base = make_blob(2 * 1024 * 1024, 1);
+    std::string target = base;
+    target.replace(512 * 1024, 64, make_blob(64, 2));
+    target += make_blob(16 * 1024, 3);
+
+    const std::string patch = make_patch(base, target);
+    check("patch is a small diff", !patch.empty() && patch.size() < target.size() / 10);
+
+    write_file(g_root / "base.bin", base);
+    write_file(g_root / "patch.zst", patch);
+
+    std::string error;
+    const bool ok = ZstdPatch::apply((g_root / "base.bin").string(),
+                                     (g_root / "patch.zst").string(),
+                                     (g_root / "out.bin").string(), error);
+    check("apply succeeds", ok);
+    check("no error reported", error.empty());
+    check("output matches target", read_file(g_root / "out.bin") == target);
+}
+
+static void test_wrong_base_fails() {
+    const std::string base = make_blob(1024 * 1024, 10);
+    std::string target = base;
+    target.replace(1024, 64, make_blob(64, 11));
+
+    write_file(g_root / "wrong_base.bin", make_blob(1024 * 1024, 12));
+    write_file(g_root / "patch2.zst", make_patch(base, target));
+
+    std::string error;
+    const bool ok = ZstdPatch::apply((g_root / "wrong_base.bin").string(),
+                                     (g_root / "patch2.zst").string(),
+                                     (g_root / "out2.bin").string(), error);
+    check("wrong base fails", !ok);
+    check("wrong base reports error", !error.empty());
+    check("partial output removed", !fs::exists(g_root / "out2.bin"));
+}
+
+static void test_truncated_patch_fails() {
+    const std::string base = make_blob(256 * 1024, 20);
+    std::string target = base + make_blob(4096, 21);
+    std::string patch = make_patch(base, target);
+    patch.resize(patch.size() / 2);
+
+    write_file(g_root / "base3.bin", base);
+    write_file(g_root / "patch3.zst", patch);
+
+    std::string error;
+    const bool ok = ZstdPatch::apply((g_root / "base3.bin").string(),
+                                     (g_root / "patch3.zst").string(),
+                                     (g_root / "out3.bin").string(), error);
+    check("truncated patch fails", !ok);
+    check("truncated output removed", !fs::exists(g_root / "out3.bin"));
+}
+
+static void test_missing_files_fail() {
+    std::string error;
+    check("missing base fails",
+          !ZstdPatch::apply((g_root / "no_such_base").string(),
+                            (g_root / "patch.zst").string(),
+                            (g_root / "out4.bin").string(), error));
+    error.clear();
+    write_file(g_root / "base4.bin", "base");
+    check("missing patch fails",
+          !ZstdPatch::apply((g_root / "base4.bin").string(),
+                            (g_root / "no_such_patch").string(),
+                            (g_root / "out4.bin").string(), error));
+}
+
+static void test_patch_asset_name() {
+    check("patch asset naming",
+          ZstdPatch::patch_asset_name("llama-bin-win.zip", "b8600") ==
+              "llama-bin-win.zip.zstd-patch-from-b8600");
+}
+
+int main() {
+    g_root = fs::temp_directory_path() / "lemon_zstd_patch_test";
+    fs::remove_all(g_root);
+    fs::create_directories(g_root);
+
+    test_reconstructs_target();
+    test_wrong_base_fails();
+    test_truncated_patch_fails();
+    test_missing_files_fail();
+    test_patch_asset_name();
+
+    fs::remove_all(g_root);
+
+    if (g_failures == 0) {
+        std::printf("All zstd patch tests passed\n");
+        return 0;
+    }
+    std::printf("%d zstd patch check(s) failed\n", g_failures);
+    return 1;
+}
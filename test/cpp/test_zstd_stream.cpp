@@ -0,0 +1,137 @@
+// Standalone test for the overlapped zstd decompression pipeline: magic
+// sniffing, round-trips with and without a content-size header (preallocated
+// vs grown output), multi-frame archives, large payloads spanning many
+// pipeline chunks, and cleanup of partial output on malformed input.
+
+#include "lemon/utils/zstd_stream.h"
+
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <string>
+#include <vector>
+#include <zstd.h>
+
+using lemon::utils::ZstdStream;
+
+namespace fs = std::filesystem;
+
+static int g_failures = 0;
+
+static void check(const char* name, bool ok) {
+    std::printf("[%s] %s\n", ok ? "PASS" : "FAIL", name);
+    if (!ok) ++g_failures;
+}
+
+static fs::path g_root;
+
+static void write_file(const fs::path& path, const std::string& contents) {
+    std::ofstream file(path, std::ios::binary);
+    file.write(contents.data(), static_cast<std::streamsize>(contents.size()));
+}
+
+static std::string read_file(const fs::path& path) {
+    std::ifstream file(path, std::ios::binary);
+    return std::string(std::istreambuf_iterator<char>(file),
+                       std::istreambuf_iterator<char>());
+}
+
+static std::string make_blob(size_t size, uint64_t seed) {
+    std::mt19937_64 rng(seed);
+    std::string blob(size, '\0');
+    for (auto& byte : blob) {
+        byte = static_cast<char>(rng() & 0xff);
+    }
+    return blob;
+}
+
+// Simple compression carries the content size in the frame header.
+static std::string compress_simple(const std::string& payload) {
+    std::string out(ZSTD_compressBound(payload.size()), '\0');
+    const size_t written = ZSTD_compress(out.data(), out.size(), payload.data(),
+                                         payload.size(), 3);
+    out.resize(written);
+    return out;
+}
+
+// Streaming compression without a pledged source size omits the content
+// size, exercising the grow-as-written path.
+static std::string compress_streaming(const std::string& payload) {
+    ZSTD_CCtx* cctx = ZSTD_createCCtx();
+    std::string out;
+    std::vector<char> buf(ZSTD_CStreamOutSize());
+    ZSTD_inBuffer input{payload.data(), payload.size(), 0};
+    size_t rc;
+    do {
+        ZSTD_outBuffer output{buf.data(), buf.size(), 0};
+        rc = ZSTD_compressStream2(cctx, &output, &input, ZSTD_e_end);
+        out.append(buf.data(), output.pos);
+    } while (rc != 0);
+    ZSTD_freeCCtx(cctx);
+    return out;
+}
+
+int main() {
+    g_root = fs::temp_directory_path() /
+             ("lemon_zstd_stream_test_" + std::to_string(std::random_device{}()));
+    fs::create_directories(g_root);
+
+    const fs::path src = g_root / "archive.zst";
+    const fs::path dest = g_root / "archive.tar";
+    std::string error;
+
+    {
+        const std::string payload = make_blob(3 * 1024 * 1024 + 17, 1);
+        write_file(src, compress_simple(payload));
+        check("zstd magic recognized", ZstdStream::is_zstd_file(src.string()));
+        check("sized round-trip succeeds",
+              ZstdStream::decompress_file(src.string(), dest.string(), error));
+        check("sized round-trip content matches", read_file(dest) == payload);
+    }
+
+    {
+        const std::string payload = make_blob(5 * 1024 * 1024 + 3, 2);
+        write_file(src, compress_streaming(payload));
+        check("unsized round-trip succeeds",
+              ZstdStream::decompress_file(src.string(), dest.string(), error));
+        check("unsized round-trip content matches", read_file(dest) == payload);
+    }
+
+    {
+        const std::string first = make_blob(2 * 1024 * 1024, 3);
+        const std::string second = make_blob(1024 * 1024 + 9, 4);
+        write_file(src, compress_simple(first) + compress_simple(second));
+        check("multi-frame round-trip succeeds",
+              ZstdStream::decompress_file(src.string(), dest.string(), error));
+        check("multi-frame content matches", read_file(dest) == first + second);
+    }
+
+    {
+        write_file(src, "not a zstd frame at all");
+        check("plain file not sniffed as zstd",
+              !ZstdStream::is_zstd_file(src.string()));
+        check("malformed input fails",
+              !ZstdStream::decompress_file(src.string(), dest.string(), error));
+        check("malformed input reports an error", !error.empty());
+        check("partial output removed", !fs::exists(dest));
+    }
+
+    {
+        std::string truncated = compress_simple(make_blob(1024 * 1024, 5));
+        truncated.resize(truncated.size() / 2);
+        write_file(src, truncated);
+        check("truncated input fails",
+              !ZstdStream::decompress_file(src.string(), dest.string(), error));
+        check("truncated output removed", !fs::exists(dest));
+    }
+
+    check("missing input fails",
+          !ZstdStream::decompress_file((g_root / "nope.zst").string(),
+                                       dest.string(), error));
+
+    fs::remove_all(g_root);
+
+    std::printf("%s\n", g_failures == 0 ? "ALL PASS" : "FAILURES");
+    return g_failures == 0 ? 0 : 1;
+}
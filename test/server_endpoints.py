@@ -165,6 +165,7 @@ class EndpointTests(ServerTestBase):
             "chat/completions",
             "completions",
             "embeddings",
+            "embeddings/ingest",
             "models",
             "models/check-updates",
             "responses",
@@ -176,12 +177,16 @@ class EndpointTests(ServerTestBase):
             "unload",
             "health",
             "stats",
+            "queue",
             "system-info",
             "reranking",
             "audio/transcriptions",
+            "audio/transcriptions/batch",
             "images/generations",
             "install",
             "uninstall",
+            "adapters",
+            "adapters/load",
         ]
 
         session = requests.Session()
@@ -560,6 +565,38 @@ class EndpointTests(ServerTestBase):
         self.assertEqual(bad_format.status_code, 400)
         self.assertIn("format", bad_format.text)
 
+    def test_004b_registry_search_local(self):
+        # Local search hits the in-memory index: works offline and allows
+        # short search-as-you-type queries.
+        short_query = requests.get(
+            f"{self.base_url}/registry/search",
+            params={"query": "qw", "source": "local"},
+            timeout=TIMEOUT_DEFAULT,
+        )
+        self.assertEqual(short_query.status_code, 200)
+        body = short_query.json()
+        self.assertEqual(body["source"], "local")
+        self.assertIsInstance(body["results"], list)
+        for result in body["results"]:
+            self.assertIn("model_name", result)
+            self.assertIn("recipe", result)
+
+        named = requests.get(
+            f"{self.base_url}/registry/search",
+            params={"query": "Qwen", "source": "local"},
+            timeout=TIMEOUT_DEFAULT,
+        )
+        self.assertEqual(named.status_code, 200)
+        names = [r["model_name"] for r in named.json()["results"]]
+        self.assertTrue(any("qwen" in name.lower() for name in names))
+
+        empty_query = requests.get(
+            f"{self.base_url}/registry/search",
+            params={"query": "   ", "source": "local"},
+            timeout=TIMEOUT_DEFAULT,
+        )
+        self.assertEqual(empty_query.status_code, 400)
+
     def test_005_models_retrieve(self):
         """Test retrieving a specific model by ID with extended fields."""
         client = self.get_openai_client()
@@ -2177,6 +2214,17 @@ class EndpointTests(ServerTestBase):
 
         print(f"[OK] /stats endpoint returned: {list(data.keys())}")
 
+    def test_021q_queue_snapshot(self):
+        """Test the /queue endpoint returns the router queue snapshot."""
+        response = requests.get(f"{self.base_url}/queue", timeout=TIMEOUT_DEFAULT)
+        self.assertEqual(response.status_code, 200)
+
+        data = response.json()
+        self.assertIsInstance(data["waiting"], dict)
+        self.assertIsInstance(data["exclusive_transition_waiters"], int)
+
+        print(f"[OK] /queue endpoint returned: {list(data.keys())}")
+
     def test_021s_pull_multi(self):
         # First delete model if it exists to ensure we're actually testing pull
         delete_response = requests.post(
@@ -144,6 +144,41 @@ class EvictionTests(ServerTestBase):
         self.assertIsNotNone(info_after)
         self.assertEqual(info_after.get("status"), "downsized")
 
+    def test_hibernate_idle_timeout_and_resume(self):
+        """Deep idle hibernates the model; a request transparently resumes it."""
+        requests.post(
+            f"{self.base_url}/load",
+            json={
+                "model_name": ENDPOINT_TEST_MODEL,
+                "auto_evict": True,
+                "downsize_idle_timeout": 2,
+                "hibernate_idle_timeout": 5,
+                "evict_idle_timeout": 300,
+            },
+            timeout=TIMEOUT_MODEL_OPERATION,
+        )
+
+        info = self._get_loaded_model_info(ENDPOINT_TEST_MODEL)
+        self.assertIsNotNone(info)
+        self.assertEqual(info.get("status"), "ready")
+
+        # Poll until hibernated (evaluation loop fires every 5s)
+        info_after = self._wait_for_model_status(
+            ENDPOINT_TEST_MODEL, {"hibernated"}, timeout=20
+        )
+        self.assertIsNotNone(info_after)
+        self.assertEqual(info_after.get("status"), "hibernated")
+
+        # A request against a hibernated model must transparently resume it.
+        client = self.get_openai_client()
+        completion = client.chat.completions.create(
+            model=ENDPOINT_TEST_MODEL,
+            messages=self.messages,
+            max_tokens=8,
+        )
+        self.assertTrue(completion.choices)
+        self.assertIsNotNone(completion.choices[0].message.content)
+
     def test_request_interrupts_degradation_and_restores(self):
         """A request against a degraded (downsized) model must transparently
         restore it and succeed — no crash, no failed generation (spec #5)."""